@@ -0,0 +1,77 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/dlib/base64/base64_kernel_1.cpp" "CMakeFiles/dlib.dir/base64/base64_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/base64/base64_kernel_1.cpp.o.d"
+  "/root/repo/dlib/bigint/bigint_kernel_1.cpp" "CMakeFiles/dlib.dir/bigint/bigint_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/bigint/bigint_kernel_1.cpp.o.d"
+  "/root/repo/dlib/bigint/bigint_kernel_2.cpp" "CMakeFiles/dlib.dir/bigint/bigint_kernel_2.cpp.o" "gcc" "CMakeFiles/dlib.dir/bigint/bigint_kernel_2.cpp.o.d"
+  "/root/repo/dlib/bit_stream/bit_stream_kernel_1.cpp" "CMakeFiles/dlib.dir/bit_stream/bit_stream_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/bit_stream/bit_stream_kernel_1.cpp.o.d"
+  "/root/repo/dlib/bsp/bsp.cpp" "CMakeFiles/dlib.dir/bsp/bsp.cpp.o" "gcc" "CMakeFiles/dlib.dir/bsp/bsp.cpp.o.d"
+  "/root/repo/dlib/cuda/cpu_dlib.cpp" "CMakeFiles/dlib.dir/cuda/cpu_dlib.cpp.o" "gcc" "CMakeFiles/dlib.dir/cuda/cpu_dlib.cpp.o.d"
+  "/root/repo/dlib/cuda/tensor_tools.cpp" "CMakeFiles/dlib.dir/cuda/tensor_tools.cpp.o" "gcc" "CMakeFiles/dlib.dir/cuda/tensor_tools.cpp.o.d"
+  "/root/repo/dlib/data_io/image_dataset_metadata.cpp" "CMakeFiles/dlib.dir/data_io/image_dataset_metadata.cpp.o" "gcc" "CMakeFiles/dlib.dir/data_io/image_dataset_metadata.cpp.o.d"
+  "/root/repo/dlib/data_io/mnist.cpp" "CMakeFiles/dlib.dir/data_io/mnist.cpp.o" "gcc" "CMakeFiles/dlib.dir/data_io/mnist.cpp.o.d"
+  "/root/repo/dlib/dir_nav/dir_nav_extensions.cpp" "CMakeFiles/dlib.dir/dir_nav/dir_nav_extensions.cpp.o" "gcc" "CMakeFiles/dlib.dir/dir_nav/dir_nav_extensions.cpp.o.d"
+  "/root/repo/dlib/dir_nav/dir_nav_kernel_1.cpp" "CMakeFiles/dlib.dir/dir_nav/dir_nav_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/dir_nav/dir_nav_kernel_1.cpp.o.d"
+  "/root/repo/dlib/dir_nav/dir_nav_kernel_2.cpp" "CMakeFiles/dlib.dir/dir_nav/dir_nav_kernel_2.cpp.o" "gcc" "CMakeFiles/dlib.dir/dir_nav/dir_nav_kernel_2.cpp.o.d"
+  "/root/repo/dlib/entropy_decoder/entropy_decoder_kernel_1.cpp" "CMakeFiles/dlib.dir/entropy_decoder/entropy_decoder_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/entropy_decoder/entropy_decoder_kernel_1.cpp.o.d"
+  "/root/repo/dlib/entropy_decoder/entropy_decoder_kernel_2.cpp" "CMakeFiles/dlib.dir/entropy_decoder/entropy_decoder_kernel_2.cpp.o" "gcc" "CMakeFiles/dlib.dir/entropy_decoder/entropy_decoder_kernel_2.cpp.o.d"
+  "/root/repo/dlib/entropy_encoder/entropy_encoder_kernel_1.cpp" "CMakeFiles/dlib.dir/entropy_encoder/entropy_encoder_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/entropy_encoder/entropy_encoder_kernel_1.cpp.o.d"
+  "/root/repo/dlib/entropy_encoder/entropy_encoder_kernel_2.cpp" "CMakeFiles/dlib.dir/entropy_encoder/entropy_encoder_kernel_2.cpp.o" "gcc" "CMakeFiles/dlib.dir/entropy_encoder/entropy_encoder_kernel_2.cpp.o.d"
+  "/root/repo/dlib/filtering/kalman_filter.cpp" "CMakeFiles/dlib.dir/filtering/kalman_filter.cpp.o" "gcc" "CMakeFiles/dlib.dir/filtering/kalman_filter.cpp.o.d"
+  "/root/repo/dlib/global_optimization/global_function_search.cpp" "CMakeFiles/dlib.dir/global_optimization/global_function_search.cpp.o" "gcc" "CMakeFiles/dlib.dir/global_optimization/global_function_search.cpp.o.d"
+  "/root/repo/dlib/gui_core/gui_core_kernel_1.cpp" "CMakeFiles/dlib.dir/gui_core/gui_core_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/gui_core/gui_core_kernel_1.cpp.o.d"
+  "/root/repo/dlib/gui_core/gui_core_kernel_2.cpp" "CMakeFiles/dlib.dir/gui_core/gui_core_kernel_2.cpp.o" "gcc" "CMakeFiles/dlib.dir/gui_core/gui_core_kernel_2.cpp.o.d"
+  "/root/repo/dlib/gui_widgets/base_widgets.cpp" "CMakeFiles/dlib.dir/gui_widgets/base_widgets.cpp.o" "gcc" "CMakeFiles/dlib.dir/gui_widgets/base_widgets.cpp.o.d"
+  "/root/repo/dlib/gui_widgets/canvas_drawing.cpp" "CMakeFiles/dlib.dir/gui_widgets/canvas_drawing.cpp.o" "gcc" "CMakeFiles/dlib.dir/gui_widgets/canvas_drawing.cpp.o.d"
+  "/root/repo/dlib/gui_widgets/drawable.cpp" "CMakeFiles/dlib.dir/gui_widgets/drawable.cpp.o" "gcc" "CMakeFiles/dlib.dir/gui_widgets/drawable.cpp.o.d"
+  "/root/repo/dlib/gui_widgets/fonts.cpp" "CMakeFiles/dlib.dir/gui_widgets/fonts.cpp.o" "gcc" "CMakeFiles/dlib.dir/gui_widgets/fonts.cpp.o.d"
+  "/root/repo/dlib/gui_widgets/style.cpp" "CMakeFiles/dlib.dir/gui_widgets/style.cpp.o" "gcc" "CMakeFiles/dlib.dir/gui_widgets/style.cpp.o.d"
+  "/root/repo/dlib/gui_widgets/widgets.cpp" "CMakeFiles/dlib.dir/gui_widgets/widgets.cpp.o" "gcc" "CMakeFiles/dlib.dir/gui_widgets/widgets.cpp.o.d"
+  "/root/repo/dlib/image_loader/jpeg_loader.cpp" "CMakeFiles/dlib.dir/image_loader/jpeg_loader.cpp.o" "gcc" "CMakeFiles/dlib.dir/image_loader/jpeg_loader.cpp.o.d"
+  "/root/repo/dlib/image_loader/png_loader.cpp" "CMakeFiles/dlib.dir/image_loader/png_loader.cpp.o" "gcc" "CMakeFiles/dlib.dir/image_loader/png_loader.cpp.o.d"
+  "/root/repo/dlib/image_saver/save_jpeg.cpp" "CMakeFiles/dlib.dir/image_saver/save_jpeg.cpp.o" "gcc" "CMakeFiles/dlib.dir/image_saver/save_jpeg.cpp.o.d"
+  "/root/repo/dlib/image_saver/save_png.cpp" "CMakeFiles/dlib.dir/image_saver/save_png.cpp.o" "gcc" "CMakeFiles/dlib.dir/image_saver/save_png.cpp.o.d"
+  "/root/repo/dlib/linker/linker_kernel_1.cpp" "CMakeFiles/dlib.dir/linker/linker_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/linker/linker_kernel_1.cpp.o.d"
+  "/root/repo/dlib/logger/extra_logger_headers.cpp" "CMakeFiles/dlib.dir/logger/extra_logger_headers.cpp.o" "gcc" "CMakeFiles/dlib.dir/logger/extra_logger_headers.cpp.o.d"
+  "/root/repo/dlib/logger/logger_config_file.cpp" "CMakeFiles/dlib.dir/logger/logger_config_file.cpp.o" "gcc" "CMakeFiles/dlib.dir/logger/logger_config_file.cpp.o.d"
+  "/root/repo/dlib/logger/logger_kernel_1.cpp" "CMakeFiles/dlib.dir/logger/logger_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/logger/logger_kernel_1.cpp.o.d"
+  "/root/repo/dlib/md5/md5_kernel_1.cpp" "CMakeFiles/dlib.dir/md5/md5_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/md5/md5_kernel_1.cpp.o.d"
+  "/root/repo/dlib/misc_api/misc_api_kernel_1.cpp" "CMakeFiles/dlib.dir/misc_api/misc_api_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/misc_api/misc_api_kernel_1.cpp.o.d"
+  "/root/repo/dlib/misc_api/misc_api_kernel_2.cpp" "CMakeFiles/dlib.dir/misc_api/misc_api_kernel_2.cpp.o" "gcc" "CMakeFiles/dlib.dir/misc_api/misc_api_kernel_2.cpp.o.d"
+  "/root/repo/dlib/server/server_http.cpp" "CMakeFiles/dlib.dir/server/server_http.cpp.o" "gcc" "CMakeFiles/dlib.dir/server/server_http.cpp.o.d"
+  "/root/repo/dlib/server/server_iostream.cpp" "CMakeFiles/dlib.dir/server/server_iostream.cpp.o" "gcc" "CMakeFiles/dlib.dir/server/server_iostream.cpp.o.d"
+  "/root/repo/dlib/server/server_kernel.cpp" "CMakeFiles/dlib.dir/server/server_kernel.cpp.o" "gcc" "CMakeFiles/dlib.dir/server/server_kernel.cpp.o.d"
+  "/root/repo/dlib/server/server_reactor.cpp" "CMakeFiles/dlib.dir/server/server_reactor.cpp.o" "gcc" "CMakeFiles/dlib.dir/server/server_reactor.cpp.o.d"
+  "/root/repo/dlib/sockets/sockets_extensions.cpp" "CMakeFiles/dlib.dir/sockets/sockets_extensions.cpp.o" "gcc" "CMakeFiles/dlib.dir/sockets/sockets_extensions.cpp.o.d"
+  "/root/repo/dlib/sockets/sockets_kernel_1.cpp" "CMakeFiles/dlib.dir/sockets/sockets_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/sockets/sockets_kernel_1.cpp.o.d"
+  "/root/repo/dlib/sockets/sockets_kernel_2.cpp" "CMakeFiles/dlib.dir/sockets/sockets_kernel_2.cpp.o" "gcc" "CMakeFiles/dlib.dir/sockets/sockets_kernel_2.cpp.o.d"
+  "/root/repo/dlib/sockstreambuf/sockstreambuf.cpp" "CMakeFiles/dlib.dir/sockstreambuf/sockstreambuf.cpp.o" "gcc" "CMakeFiles/dlib.dir/sockstreambuf/sockstreambuf.cpp.o.d"
+  "/root/repo/dlib/sockstreambuf/sockstreambuf_unbuffered.cpp" "CMakeFiles/dlib.dir/sockstreambuf/sockstreambuf_unbuffered.cpp.o" "gcc" "CMakeFiles/dlib.dir/sockstreambuf/sockstreambuf_unbuffered.cpp.o.d"
+  "/root/repo/dlib/stack_trace.cpp" "CMakeFiles/dlib.dir/stack_trace.cpp.o" "gcc" "CMakeFiles/dlib.dir/stack_trace.cpp.o.d"
+  "/root/repo/dlib/svm/auto.cpp" "CMakeFiles/dlib.dir/svm/auto.cpp.o" "gcc" "CMakeFiles/dlib.dir/svm/auto.cpp.o.d"
+  "/root/repo/dlib/test_for_odr_violations.cpp" "CMakeFiles/dlib.dir/test_for_odr_violations.cpp.o" "gcc" "CMakeFiles/dlib.dir/test_for_odr_violations.cpp.o.d"
+  "/root/repo/dlib/threads/async.cpp" "CMakeFiles/dlib.dir/threads/async.cpp.o" "gcc" "CMakeFiles/dlib.dir/threads/async.cpp.o.d"
+  "/root/repo/dlib/threads/multithreaded_object_extension.cpp" "CMakeFiles/dlib.dir/threads/multithreaded_object_extension.cpp.o" "gcc" "CMakeFiles/dlib.dir/threads/multithreaded_object_extension.cpp.o.d"
+  "/root/repo/dlib/threads/thread_pool_extension.cpp" "CMakeFiles/dlib.dir/threads/thread_pool_extension.cpp.o" "gcc" "CMakeFiles/dlib.dir/threads/thread_pool_extension.cpp.o.d"
+  "/root/repo/dlib/threads/threaded_object_extension.cpp" "CMakeFiles/dlib.dir/threads/threaded_object_extension.cpp.o" "gcc" "CMakeFiles/dlib.dir/threads/threaded_object_extension.cpp.o.d"
+  "/root/repo/dlib/threads/threads_kernel_1.cpp" "CMakeFiles/dlib.dir/threads/threads_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/threads/threads_kernel_1.cpp.o.d"
+  "/root/repo/dlib/threads/threads_kernel_2.cpp" "CMakeFiles/dlib.dir/threads/threads_kernel_2.cpp.o" "gcc" "CMakeFiles/dlib.dir/threads/threads_kernel_2.cpp.o.d"
+  "/root/repo/dlib/threads/threads_kernel_shared.cpp" "CMakeFiles/dlib.dir/threads/threads_kernel_shared.cpp.o" "gcc" "CMakeFiles/dlib.dir/threads/threads_kernel_shared.cpp.o.d"
+  "/root/repo/dlib/timer/timer.cpp" "CMakeFiles/dlib.dir/timer/timer.cpp.o" "gcc" "CMakeFiles/dlib.dir/timer/timer.cpp.o.d"
+  "/root/repo/dlib/tokenizer/tokenizer_kernel_1.cpp" "CMakeFiles/dlib.dir/tokenizer/tokenizer_kernel_1.cpp.o" "gcc" "CMakeFiles/dlib.dir/tokenizer/tokenizer_kernel_1.cpp.o.d"
+  "/root/repo/dlib/unicode/unicode.cpp" "CMakeFiles/dlib.dir/unicode/unicode.cpp.o" "gcc" "CMakeFiles/dlib.dir/unicode/unicode.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,127 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/dlib.dir/base64/base64_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/base64/base64_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/bigint/bigint_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/bigint/bigint_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/bigint/bigint_kernel_2.cpp.o"
+  "CMakeFiles/dlib.dir/bigint/bigint_kernel_2.cpp.o.d"
+  "CMakeFiles/dlib.dir/bit_stream/bit_stream_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/bit_stream/bit_stream_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/bsp/bsp.cpp.o"
+  "CMakeFiles/dlib.dir/bsp/bsp.cpp.o.d"
+  "CMakeFiles/dlib.dir/cuda/cpu_dlib.cpp.o"
+  "CMakeFiles/dlib.dir/cuda/cpu_dlib.cpp.o.d"
+  "CMakeFiles/dlib.dir/cuda/tensor_tools.cpp.o"
+  "CMakeFiles/dlib.dir/cuda/tensor_tools.cpp.o.d"
+  "CMakeFiles/dlib.dir/data_io/image_dataset_metadata.cpp.o"
+  "CMakeFiles/dlib.dir/data_io/image_dataset_metadata.cpp.o.d"
+  "CMakeFiles/dlib.dir/data_io/mnist.cpp.o"
+  "CMakeFiles/dlib.dir/data_io/mnist.cpp.o.d"
+  "CMakeFiles/dlib.dir/dir_nav/dir_nav_extensions.cpp.o"
+  "CMakeFiles/dlib.dir/dir_nav/dir_nav_extensions.cpp.o.d"
+  "CMakeFiles/dlib.dir/dir_nav/dir_nav_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/dir_nav/dir_nav_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/dir_nav/dir_nav_kernel_2.cpp.o"
+  "CMakeFiles/dlib.dir/dir_nav/dir_nav_kernel_2.cpp.o.d"
+  "CMakeFiles/dlib.dir/entropy_decoder/entropy_decoder_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/entropy_decoder/entropy_decoder_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/entropy_decoder/entropy_decoder_kernel_2.cpp.o"
+  "CMakeFiles/dlib.dir/entropy_decoder/entropy_decoder_kernel_2.cpp.o.d"
+  "CMakeFiles/dlib.dir/entropy_encoder/entropy_encoder_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/entropy_encoder/entropy_encoder_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/entropy_encoder/entropy_encoder_kernel_2.cpp.o"
+  "CMakeFiles/dlib.dir/entropy_encoder/entropy_encoder_kernel_2.cpp.o.d"
+  "CMakeFiles/dlib.dir/filtering/kalman_filter.cpp.o"
+  "CMakeFiles/dlib.dir/filtering/kalman_filter.cpp.o.d"
+  "CMakeFiles/dlib.dir/global_optimization/global_function_search.cpp.o"
+  "CMakeFiles/dlib.dir/global_optimization/global_function_search.cpp.o.d"
+  "CMakeFiles/dlib.dir/gui_core/gui_core_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/gui_core/gui_core_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/gui_core/gui_core_kernel_2.cpp.o"
+  "CMakeFiles/dlib.dir/gui_core/gui_core_kernel_2.cpp.o.d"
+  "CMakeFiles/dlib.dir/gui_widgets/base_widgets.cpp.o"
+  "CMakeFiles/dlib.dir/gui_widgets/base_widgets.cpp.o.d"
+  "CMakeFiles/dlib.dir/gui_widgets/canvas_drawing.cpp.o"
+  "CMakeFiles/dlib.dir/gui_widgets/canvas_drawing.cpp.o.d"
+  "CMakeFiles/dlib.dir/gui_widgets/drawable.cpp.o"
+  "CMakeFiles/dlib.dir/gui_widgets/drawable.cpp.o.d"
+  "CMakeFiles/dlib.dir/gui_widgets/fonts.cpp.o"
+  "CMakeFiles/dlib.dir/gui_widgets/fonts.cpp.o.d"
+  "CMakeFiles/dlib.dir/gui_widgets/style.cpp.o"
+  "CMakeFiles/dlib.dir/gui_widgets/style.cpp.o.d"
+  "CMakeFiles/dlib.dir/gui_widgets/widgets.cpp.o"
+  "CMakeFiles/dlib.dir/gui_widgets/widgets.cpp.o.d"
+  "CMakeFiles/dlib.dir/image_loader/jpeg_loader.cpp.o"
+  "CMakeFiles/dlib.dir/image_loader/jpeg_loader.cpp.o.d"
+  "CMakeFiles/dlib.dir/image_loader/png_loader.cpp.o"
+  "CMakeFiles/dlib.dir/image_loader/png_loader.cpp.o.d"
+  "CMakeFiles/dlib.dir/image_saver/save_jpeg.cpp.o"
+  "CMakeFiles/dlib.dir/image_saver/save_jpeg.cpp.o.d"
+  "CMakeFiles/dlib.dir/image_saver/save_png.cpp.o"
+  "CMakeFiles/dlib.dir/image_saver/save_png.cpp.o.d"
+  "CMakeFiles/dlib.dir/linker/linker_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/linker/linker_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/logger/extra_logger_headers.cpp.o"
+  "CMakeFiles/dlib.dir/logger/extra_logger_headers.cpp.o.d"
+  "CMakeFiles/dlib.dir/logger/logger_config_file.cpp.o"
+  "CMakeFiles/dlib.dir/logger/logger_config_file.cpp.o.d"
+  "CMakeFiles/dlib.dir/logger/logger_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/logger/logger_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/md5/md5_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/md5/md5_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/misc_api/misc_api_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/misc_api/misc_api_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/misc_api/misc_api_kernel_2.cpp.o"
+  "CMakeFiles/dlib.dir/misc_api/misc_api_kernel_2.cpp.o.d"
+  "CMakeFiles/dlib.dir/server/server_http.cpp.o"
+  "CMakeFiles/dlib.dir/server/server_http.cpp.o.d"
+  "CMakeFiles/dlib.dir/server/server_iostream.cpp.o"
+  "CMakeFiles/dlib.dir/server/server_iostream.cpp.o.d"
+  "CMakeFiles/dlib.dir/server/server_kernel.cpp.o"
+  "CMakeFiles/dlib.dir/server/server_kernel.cpp.o.d"
+  "CMakeFiles/dlib.dir/server/server_reactor.cpp.o"
+  "CMakeFiles/dlib.dir/server/server_reactor.cpp.o.d"
+  "CMakeFiles/dlib.dir/sockets/sockets_extensions.cpp.o"
+  "CMakeFiles/dlib.dir/sockets/sockets_extensions.cpp.o.d"
+  "CMakeFiles/dlib.dir/sockets/sockets_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/sockets/sockets_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/sockets/sockets_kernel_2.cpp.o"
+  "CMakeFiles/dlib.dir/sockets/sockets_kernel_2.cpp.o.d"
+  "CMakeFiles/dlib.dir/sockstreambuf/sockstreambuf.cpp.o"
+  "CMakeFiles/dlib.dir/sockstreambuf/sockstreambuf.cpp.o.d"
+  "CMakeFiles/dlib.dir/sockstreambuf/sockstreambuf_unbuffered.cpp.o"
+  "CMakeFiles/dlib.dir/sockstreambuf/sockstreambuf_unbuffered.cpp.o.d"
+  "CMakeFiles/dlib.dir/stack_trace.cpp.o"
+  "CMakeFiles/dlib.dir/stack_trace.cpp.o.d"
+  "CMakeFiles/dlib.dir/svm/auto.cpp.o"
+  "CMakeFiles/dlib.dir/svm/auto.cpp.o.d"
+  "CMakeFiles/dlib.dir/test_for_odr_violations.cpp.o"
+  "CMakeFiles/dlib.dir/test_for_odr_violations.cpp.o.d"
+  "CMakeFiles/dlib.dir/threads/async.cpp.o"
+  "CMakeFiles/dlib.dir/threads/async.cpp.o.d"
+  "CMakeFiles/dlib.dir/threads/multithreaded_object_extension.cpp.o"
+  "CMakeFiles/dlib.dir/threads/multithreaded_object_extension.cpp.o.d"
+  "CMakeFiles/dlib.dir/threads/thread_pool_extension.cpp.o"
+  "CMakeFiles/dlib.dir/threads/thread_pool_extension.cpp.o.d"
+  "CMakeFiles/dlib.dir/threads/threaded_object_extension.cpp.o"
+  "CMakeFiles/dlib.dir/threads/threaded_object_extension.cpp.o.d"
+  "CMakeFiles/dlib.dir/threads/threads_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/threads/threads_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/threads/threads_kernel_2.cpp.o"
+  "CMakeFiles/dlib.dir/threads/threads_kernel_2.cpp.o.d"
+  "CMakeFiles/dlib.dir/threads/threads_kernel_shared.cpp.o"
+  "CMakeFiles/dlib.dir/threads/threads_kernel_shared.cpp.o.d"
+  "CMakeFiles/dlib.dir/timer/timer.cpp.o"
+  "CMakeFiles/dlib.dir/timer/timer.cpp.o.d"
+  "CMakeFiles/dlib.dir/tokenizer/tokenizer_kernel_1.cpp.o"
+  "CMakeFiles/dlib.dir/tokenizer/tokenizer_kernel_1.cpp.o.d"
+  "CMakeFiles/dlib.dir/unicode/unicode.cpp.o"
+  "CMakeFiles/dlib.dir/unicode/unicode.cpp.o.d"
+  "libdlib.a"
+  "libdlib.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dlib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,6 @@
+#ifndef DLIB_REVISION_H
+#define DLIB_MAJOR_VERSION  19
+#define DLIB_MINOR_VERSION  18
+#define DLIB_PATCH_VERSION  99
+#endif
+
@@ -0,0 +1,10 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libjpeg_test.dir/libjpeg_test.cpp.o"
+  "libjpeg_test"
+  "libjpeg_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libjpeg_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
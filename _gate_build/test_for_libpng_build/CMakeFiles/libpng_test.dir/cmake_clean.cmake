@@ -0,0 +1,10 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libpng_test.dir/libpng_test.cpp.o"
+  "libpng_test"
+  "libpng_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libpng_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
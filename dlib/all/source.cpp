@@ -48,6 +48,7 @@
 #include "../server/server_kernel.cpp"
 #include "../server/server_iostream.cpp"
 #include "../server/server_http.cpp"
+#include "../server/server_reactor.cpp"
 #include "../threads/multithreaded_object_extension.cpp"
 #include "../threads/threaded_object_extension.cpp"
 #include "../threads/threads_kernel_1.cpp"
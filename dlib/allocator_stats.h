@@ -0,0 +1,328 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_ALLOCATOR_STATs_Hh_
+#define DLIB_ALLOCATOR_STATs_Hh_
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "assert.h"
+#include "noncopyable.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    struct allocation_site
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object names one place in the code that performs memory allocations.
+                Instances are meant to be function local statics, one per call site, and
+                they register themselves with the global allocator_stats object the first
+                time an allocation from them is sampled.  Most users never create these
+                directly, they use the DLIB_RECORD_SAMPLED_ALLOCATION macro below or just
+                rely on the call sites built into dlib's memory managers.
+        !*/
+
+        explicit allocation_site(
+            const char* name_
+        ) : name(name_) {}
+
+        const char* name;
+        std::atomic<unsigned long long> num_sampled{0};
+        std::atomic<unsigned long long> sampled_bytes{0};
+        std::atomic<bool> registered{false};
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    class allocator_stats : noncopyable
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object is a global registry of sampled memory allocation statistics.
+                It exists so you can quantify allocation hotspots in dlib based programs
+                without reaching for an external profiler.  It is off by default and, when
+                off, the only cost an instrumented allocation pays is a single relaxed
+                atomic load.  When you turn it on with enable() only every Nth allocation
+                is actually recorded (N == the sampling interval), so the overhead stays
+                negligible even on allocation heavy code paths.
+
+                For each sampled allocation it records:
+                    - a histogram over power of two size classes
+                    - a per call site counter and byte total (see allocation_site)
+                    - an estimate of the currently outstanding bytes and the peak thereof.
+                      These are computed by remembering the pointers of sampled
+                      allocations and scaling their sizes by the sampling interval, the
+                      same way sampling heap profilers do.  So they are statistical
+                      estimates, not exact values, and get more accurate as the sampling
+                      interval gets smaller.
+
+                The memory managers in dlib (memory_manager and memory_manager_stateless,
+                and therefore also anything allocating through std_allocator, matrix, or
+                the image types, all of which draw from those managers) are already
+                instrumented.  Allocations made by other means are only seen if you
+                annotate them with DLIB_RECORD_SAMPLED_ALLOCATION.
+
+                Note that sampling is triggered by allocation counts, not bytes, so the
+                statistics are biased towards frequent call sites rather than large ones.
+
+            THREAD SAFETY
+                All the methods of this object are thread safe.
+        !*/
+
+    public:
+
+        struct site_stats
+        {
+            std::string name;
+            unsigned long long num_sampled = 0;
+            unsigned long long sampled_bytes = 0;
+        };
+
+        struct stats_snapshot
+        {
+            unsigned long sampling_interval = 0;
+            unsigned long long num_sampled_allocations = 0;
+            unsigned long long estimated_num_allocations = 0;
+            unsigned long long estimated_current_bytes = 0;
+            unsigned long long estimated_peak_bytes = 0;
+            // size_class_histogram[i] == the number of sampled allocations of size
+            // [2^i, 2^(i+1)) bytes (the first bucket also counts empty allocations).
+            std::vector<unsigned long long> size_class_histogram;
+            // one entry per distinct call site name, sorted by name
+            std::vector<site_stats> call_sites;
+        };
+
+        static allocator_stats& get (
+        )
+        /*!
+            ensures
+                - returns the process wide allocator_stats object.
+        !*/
+        {
+            static allocator_stats stats;
+            return stats;
+        }
+
+        void enable (
+            unsigned long sampling_interval_ = 64
+        )
+        /*!
+            requires
+                - sampling_interval_ > 0
+            ensures
+                - #is_enabled() == true
+                - #get_sampling_interval() == sampling_interval_
+                - From this point on, each thread records every
+                  sampling_interval_'th instrumented allocation it performs.
+        !*/
+        {
+            DLIB_ASSERT(sampling_interval_ > 0,
+                "\t void allocator_stats::enable()"
+                << "\n\t The sampling interval can't be zero."
+                );
+
+            std::lock_guard<std::mutex> lock(m);
+            interval = sampling_interval_;
+            enabled.store(true, std::memory_order_release);
+        }
+
+        void disable (
+        )
+        /*!
+            ensures
+                - #is_enabled() == false
+                - Stops recording allocations.  The statistics collected so far remain
+                  queryable via get_stats() until you call clear().
+        !*/
+        {
+            enabled.store(false, std::memory_order_release);
+        }
+
+        bool is_enabled (
+        ) const
+        {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        unsigned long get_sampling_interval (
+        ) const
+        {
+            std::lock_guard<std::mutex> lock(m);
+            return interval;
+        }
+
+        void clear (
+        )
+        /*!
+            ensures
+                - resets all the collected statistics to zero.  Doesn't change
+                  is_enabled() or get_sampling_interval().
+        !*/
+        {
+            std::lock_guard<std::mutex> lock(m);
+            histogram.assign(histogram.size(), 0);
+            live.clear();
+            num_sampled = 0;
+            estimated_num_allocations = 0;
+            current_bytes = 0;
+            peak_bytes = 0;
+            for (auto* site : sites)
+            {
+                site->num_sampled = 0;
+                site->sampled_bytes = 0;
+            }
+        }
+
+        stats_snapshot get_stats (
+        ) const
+        /*!
+            ensures
+                - returns a consistent snapshot of all the statistics collected so far.
+                  Call sites that share a name (e.g. the same macro expanded in several
+                  template instantiations) are merged into one entry.
+        !*/
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stats_snapshot snap;
+            snap.sampling_interval = interval;
+            snap.num_sampled_allocations = num_sampled;
+            snap.estimated_num_allocations = estimated_num_allocations;
+            snap.estimated_current_bytes = current_bytes;
+            snap.estimated_peak_bytes = peak_bytes;
+            snap.size_class_histogram = histogram;
+
+            std::map<std::string, site_stats> merged;
+            for (auto* site : sites)
+            {
+                auto& s = merged[site->name];
+                s.name = site->name;
+                s.num_sampled += site->num_sampled;
+                s.sampled_bytes += site->sampled_bytes;
+            }
+            for (auto& s : merged)
+                snap.call_sites.push_back(s.second);
+            return snap;
+        }
+
+        void record_allocation (
+            const void* ptr,
+            size_t num_bytes,
+            allocation_site& site
+        )
+        /*!
+            ensures
+                - if (is_enabled() == true) then
+                    - possibly records an allocation of num_bytes bytes at ptr,
+                      attributed to the given call site.  Only every Nth call per thread
+                      is recorded, where N == get_sampling_interval().
+        !*/
+        {
+            if (!enabled.load(std::memory_order_relaxed))
+                return;
+
+            // A cheap per thread countdown so only every Nth allocation takes the lock.
+            thread_local unsigned long countdown = 1;
+            if (--countdown != 0)
+                return;
+
+            std::lock_guard<std::mutex> lock(m);
+            countdown = interval;
+            ++num_sampled;
+            estimated_num_allocations += interval;
+            ++histogram[size_class(num_bytes)];
+
+            site.num_sampled += 1;
+            site.sampled_bytes += num_bytes;
+            if (!site.registered.exchange(true))
+                sites.push_back(&site);
+
+            // Each sampled allocation stands in for interval allocations of about this
+            // size, so scale its contribution to the outstanding byte estimate.
+            const unsigned long long estimated_bytes = (unsigned long long)num_bytes*interval;
+            live[ptr] = estimated_bytes;
+            current_bytes += estimated_bytes;
+            if (current_bytes > peak_bytes)
+                peak_bytes = current_bytes;
+        }
+
+        void record_deallocation (
+            const void* ptr
+        )
+        /*!
+            ensures
+                - if (is_enabled() == true and the allocation of ptr was sampled by
+                  record_allocation()) then
+                    - removes ptr's contribution from the outstanding byte estimate.
+        !*/
+        {
+            if (!enabled.load(std::memory_order_relaxed))
+                return;
+
+            std::lock_guard<std::mutex> lock(m);
+            auto i = live.find(ptr);
+            if (i != live.end())
+            {
+                current_bytes -= i->second;
+                live.erase(i);
+            }
+        }
+
+    private:
+
+        allocator_stats (
+        ) : histogram(sizeof(size_t)*8, 0) {}
+
+        static unsigned long size_class (
+            size_t num_bytes
+        )
+        {
+            unsigned long b = 0;
+            while (num_bytes > 1)
+            {
+                num_bytes >>= 1;
+                ++b;
+            }
+            return b;
+        }
+
+        mutable std::mutex m;
+        std::atomic<bool> enabled{false};
+        unsigned long interval = 64;
+        std::vector<unsigned long long> histogram;
+        std::unordered_map<const void*, unsigned long long> live;
+        std::vector<allocation_site*> sites;
+        unsigned long long num_sampled = 0;
+        unsigned long long estimated_num_allocations = 0;
+        unsigned long long current_bytes = 0;
+        unsigned long long peak_bytes = 0;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    // Use these macros to instrument an allocation call site.  The site_name string is
+    // what shows up in allocator_stats::get_stats().call_sites.  They expand to a single
+    // relaxed atomic load when the statistics are disabled.
+#define DLIB_RECORD_SAMPLED_ALLOCATION(ptr, num_bytes, site_name)                           \
+    do {                                                                                    \
+        static dlib::allocation_site _dlib_sampled_allocation_site(site_name);              \
+        dlib::allocator_stats::get().record_allocation(ptr, num_bytes,                      \
+                                                       _dlib_sampled_allocation_site);      \
+    } while (false)
+
+#define DLIB_RECORD_SAMPLED_DEALLOCATION(ptr)                                               \
+    dlib::allocator_stats::get().record_deallocation(ptr)
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_ALLOCATOR_STATs_Hh_
+
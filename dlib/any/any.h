@@ -6,12 +6,171 @@
 #include "any_abstract.h"
 #include "../algs.h"
 
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <typeinfo>
+#include <utility>
+
+// This is the size, in bytes, of the internal buffer the any and any_function objects
+// use to store their contents.  Objects no bigger than this are kept inside the
+// any/any_function itself rather than on the heap, which avoids a call to new for each
+// construction and copy.  You can #define it to a larger value before including this
+// file if you routinely store bigger objects, but it must have the same value in every
+// translation unit of your program.
+#ifndef DLIB_ANY_SBO_SIZE
+#define DLIB_ANY_SBO_SIZE (4*sizeof(void*))
+#endif
 
 namespace dlib
 {
 
+// ----------------------------------------------------------------------------------------
+
+    namespace any_impl
+    {
+        template <typename derived_type>
+        derived_type* sbo_construct (
+            void* buf,
+            std::size_t size
+        )
+        /*!
+            ensures
+                - default constructs a derived_type object, placing it into the buffer
+                  pointed to by buf if it fits in size bytes and on the heap otherwise,
+                  and returns a pointer to it.  buf must be aligned like max_align_t.
+        !*/
+        {
+            if (sizeof(derived_type) <= size && alignof(derived_type) <= alignof(std::max_align_t))
+                return new(buf) derived_type();
+            else
+                return new derived_type();
+        }
+
+        template <typename derived_type, typename T>
+        derived_type* sbo_construct (
+            void* buf,
+            std::size_t size,
+            const T& val
+        )
+        /*!
+            ensures
+                - just like the above sbo_construct() except the object is constructed
+                  from val rather than default constructed.
+        !*/
+        {
+            if (sizeof(derived_type) <= size && alignof(derived_type) <= alignof(std::max_align_t))
+                return new(buf) derived_type(val);
+            else
+                return new derived_type(val);
+        }
+
+    // ------------------------------------------------------------------------------------
+
+        template <typename base_type, std::size_t sbo_size>
+        class sbo_storage : noncopyable
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is the storage used by the any and any_function objects.  It
+                    holds a pointer to a polymorphic object which lives either in the
+                    internal buffer, when it fits in sbo_size bytes, or on the heap.
+                    base_type must have a virtual destructor and a member of the form:
+                        virtual base_type* copy_to(void* buf, std::size_t size) const;
+                    which copies the object via sbo_construct() using the given buffer.
+
+                CONVENTION
+                    - get() == a pointer to the contained object or 0 if empty.
+                    - is_local() == true if and only if the contained object lives
+                      inside buf rather than on the heap.
+            !*/
+        public:
+
+            sbo_storage() : ptr(0) {}
+
+            ~sbo_storage() { reset(); }
+
+            base_type* get (
+            ) const { return ptr; }
+
+            void reset (
+            )
+            {
+                if (ptr == 0)
+                    return;
+                if (is_local())
+                    ptr->~base_type();
+                else
+                    delete ptr;
+                ptr = 0;
+            }
+
+            template <typename derived_type>
+            derived_type* create (
+            )
+            {
+                reset();
+                derived_type* d = sbo_construct<derived_type>(&buf, sbo_size);
+                ptr = d;
+                return d;
+            }
+
+            template <typename derived_type, typename T>
+            derived_type* create (
+                const T& val
+            )
+            {
+                reset();
+                derived_type* d = sbo_construct<derived_type>(&buf, sbo_size, val);
+                ptr = d;
+                return d;
+            }
+
+            void copy_from (
+                const sbo_storage& item
+            )
+            {
+                if (this == &item)
+                    return;
+                reset();
+                if (item.ptr)
+                    ptr = item.ptr->copy_to(&buf, sbo_size);
+            }
+
+            void swap (
+                sbo_storage& item
+            )
+            {
+                if (is_local() == false && item.is_local() == false)
+                {
+                    std::swap(ptr, item.ptr);
+                    return;
+                }
+
+                // An object living in the internal buffer can't change addresses, so
+                // when either side is stored locally we have to swap by copying.
+                sbo_storage temp;
+                temp.copy_from(*this);
+                copy_from(item);
+                item.copy_from(temp);
+            }
+
+        private:
+
+            bool is_local (
+            ) const
+            {
+                const char* p = reinterpret_cast<const char*>(ptr);
+                const char* b = reinterpret_cast<const char*>(&buf);
+                return b <= p && p < b + sbo_size;
+            }
+
+            base_type* ptr;
+            typename std::aligned_storage<sbo_size, alignof(std::max_align_t)>::type buf;
+        };
+    }
+
 // ----------------------------------------------------------------------------------------
 
     class bad_any_cast : public std::bad_cast 
@@ -38,10 +197,7 @@ namespace dlib
             const any& item
         )
         {
-            if (item.data)
-            {
-                item.data->copy_to(data);
-            }
+            data.copy_from(item.data);
         }
 
         template <typename T>
@@ -50,7 +206,7 @@ namespace dlib
         )
         {
             typedef typename basic_type<T>::type U;
-            data.reset(new derived<U>(item));
+            data.create<derived<U> >(item);
         }
 
         void clear (
@@ -109,8 +265,7 @@ namespace dlib
             derived<U>* d = dynamic_cast<derived<U>*>(data.get());
             if (d == 0)
             {
-                d = new derived<U>();
-                data.reset(d);
+                d = data.create<derived<U> >();
             }
 
             return d->item;
@@ -137,8 +292,9 @@ namespace dlib
         {
             virtual ~base() {}
 
-            virtual void copy_to (
-                std::unique_ptr<base>& dest
+            virtual base* copy_to (
+                void* buf,
+                std::size_t size
             ) const = 0;
         };
 
@@ -149,15 +305,16 @@ namespace dlib
             derived() {}
             derived(const T& val) : item(val) {}
 
-            virtual void copy_to (
-                std::unique_ptr<base>& dest
+            virtual base* copy_to (
+                void* buf,
+                std::size_t size
             ) const
             {
-                dest.reset(new derived<T>(item));
+                return any_impl::sbo_construct<derived<T> >(buf, size, item);
             }
         };
 
-        std::unique_ptr<base> data;
+        any_impl::sbo_storage<base, DLIB_ANY_SBO_SIZE> data;
     };
 
 // ----------------------------------------------------------------------------------------
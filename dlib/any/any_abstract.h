@@ -37,9 +37,13 @@ namespace dlib
                 it is a container which can contain only one object but the object may
                 be of any type.  
 
-                It is somewhat like the type_safe_union except you don't have to declare 
-                the set of possible content types beforehand.  So in some sense this is 
+                It is somewhat like the type_safe_union except you don't have to declare
+                the set of possible content types beforehand.  So in some sense this is
                 like a less type-strict version of the type_safe_union.
+
+                Objects no bigger than DLIB_ANY_SBO_SIZE bytes are stored inside the
+                any object itself, so constructing or copying an any holding such an
+                object never allocates memory.  Bigger objects are stored on the heap.
         !*/
 
     public:
@@ -158,9 +162,13 @@ namespace dlib
         /*!
             ensures
                 - swaps *this and item
-                - does not invalidate pointers or references to the object contained 
-                  inside *this or item.  Moreover, a pointer or reference to the object in 
-                  *this will now refer to the contents of #item and vice versa.
+                - If both contained objects are bigger than DLIB_ANY_SBO_SIZE bytes then
+                  this function does not invalidate pointers or references to them.
+                  Moreover, in that case, a pointer or reference to the object in *this
+                  will now refer to the contents of #item and vice versa.  However,
+                  smaller objects are stored inside the any object itself and are
+                  swapped by copying, so pointers and references to them are
+                  invalidated.
         !*/
 
     };
@@ -30,10 +30,13 @@ namespace dlib
                 - for all T: contains<T>() == false
 
             WHAT THIS OBJECT REPRESENTS
-                This object is a version of dlib::any that is restricted to containing 
+                This object is a version of dlib::any that is restricted to containing
                 elements which are some kind of function object with an operator() which
                 matches the function signature defined by function_type.
 
+                Like dlib::any, function objects no bigger than DLIB_ANY_SBO_SIZE bytes
+                are stored inside the any_function itself, so constructing or copying an
+                any_function holding such an object never allocates memory.
 
                 Here is an example:
                     #include <iostream>
@@ -4,9 +4,9 @@
 #error "You aren't supposed to directly #include this file.  #include <dlib/any.h> instead."  
 #endif
 
-#ifdef _MSC_VER
-// When using visual studio 2012, disable the warning "warning C4180: qualifier applied to function type has no meaning; ignored"
-// that you get about some template expansions applying & to function types. 
+#ifdef _MSC_VER
+// When using visual studio 2012, disable the warning "warning C4180: qualifier applied to function type has no meaning; ignored"
+// that you get about some template expansions applying & to function types. 
 #pragma warning(disable : 4180)
 #endif
 
@@ -40,10 +40,7 @@ any_function (
     const any_function& item
 )
 {
-    if (item.data)
-    {
-        item.data->copy_to(data);
-    }
+    data.copy_from(item.data);
 }
 
 template <typename T>
@@ -52,7 +49,7 @@ any_function (
 )
 {
     typedef typename basic_type<T>::type U;
-    data.reset(new derived<U,function_type>(item));
+    data.template create<derived<U,function_type> >(item);
 }
 
 void clear (
@@ -117,8 +114,7 @@ T& get(
     derived<U,function_type>* d = dynamic_cast<derived<U,function_type>*>(data.get());
     if (d == 0)
     {
-        d = new derived<U,function_type>();
-        data.reset(d);
+        d = data.template create<derived<U,function_type> >();
     }
 
     return d->item;
@@ -140,7 +136,7 @@ void swap (
 }
 
 result_type operator()(DLIB_ANY_FUNCTION_ARG_LIST) const 
-{ validate(); DLIB_ANY_FUNCTION_RETURN data->evaluate(DLIB_ANY_FUNCTION_ARGS); }
+{ validate(); DLIB_ANY_FUNCTION_RETURN data.get()->evaluate(DLIB_ANY_FUNCTION_ARGS); }
 /* !!!!!!!!    ERRORS ON THE ABOVE LINE    !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
     If you are getting an error on the above line then it means you
     have attempted to call a dlib::any_function but you have supplied 
@@ -166,7 +162,7 @@ struct Tbase
 {
     virtual ~Tbase() {}
     virtual result_type evaluate () const = 0;
-    virtual void copy_to ( std::unique_ptr<Tbase>& dest) const = 0;
+    virtual Tbase* copy_to ( void* buf, std::size_t size) const = 0;
 };
 
 template <
@@ -177,7 +173,7 @@ struct Tbase<T (A1)>
 {
     virtual ~Tbase() {}
     virtual T evaluate ( A1) const = 0;
-    virtual void copy_to ( std::unique_ptr<Tbase>& dest) const = 0;
+    virtual Tbase* copy_to ( void* buf, std::size_t size) const = 0;
 };
 
 template <
@@ -188,7 +184,7 @@ struct Tbase<T (A1,A2)>
 {
     virtual ~Tbase() {}
     virtual T evaluate (A1,A2) const = 0;
-    virtual void copy_to ( std::unique_ptr<Tbase>& dest) const = 0;
+    virtual Tbase* copy_to ( void* buf, std::size_t size) const = 0;
 };
 
 template <
@@ -199,7 +195,7 @@ struct Tbase<T (A1,A2,A3)>
 {
     virtual ~Tbase() {}
     virtual T evaluate (A1,A2,A3) const = 0;
-    virtual void copy_to ( std::unique_ptr<Tbase>& dest) const = 0;
+    virtual Tbase* copy_to ( void* buf, std::size_t size) const = 0;
 };
 
 template <
@@ -211,7 +207,7 @@ struct Tbase<T (A1,A2,A3,A4)>
 {
     virtual ~Tbase() {}
     virtual T evaluate (A1,A2,A3,A4) const = 0;
-    virtual void copy_to ( std::unique_ptr<Tbase>& dest) const = 0;
+    virtual Tbase* copy_to ( void* buf, std::size_t size) const = 0;
 };
 
 template <
@@ -223,7 +219,7 @@ struct Tbase<T (A1,A2,A3,A4,A5)>
 {
     virtual ~Tbase() {}
     virtual T evaluate (A1,A2,A3,A4,A5) const = 0;
-    virtual void copy_to ( std::unique_ptr<Tbase>& dest) const = 0;
+    virtual Tbase* copy_to ( void* buf, std::size_t size) const = 0;
 };
 
 template <
@@ -235,7 +231,7 @@ struct Tbase<T (A1,A2,A3,A4,A5,A6)>
 {
     virtual ~Tbase() {}
     virtual T evaluate (A1,A2,A3,A4,A5,A6) const = 0;
-    virtual void copy_to ( std::unique_ptr<Tbase>& dest) const = 0;
+    virtual Tbase* copy_to ( void* buf, std::size_t size) const = 0;
 };
 
 template <
@@ -248,7 +244,7 @@ struct Tbase<T (A1,A2,A3,A4,A5,A6,A7)>
 {
     virtual ~Tbase() {}
     virtual T evaluate (A1,A2,A3,A4,A5,A6,A7) const = 0;
-    virtual void copy_to ( std::unique_ptr<Tbase>& dest) const = 0;
+    virtual Tbase* copy_to ( void* buf, std::size_t size) const = 0;
 };
 
 template <
@@ -261,7 +257,7 @@ struct Tbase<T (A1,A2,A3,A4,A5,A6,A7,A8)>
 {
     virtual ~Tbase() {}
     virtual T evaluate (A1,A2,A3,A4,A5,A6,A7,A8) const = 0;
-    virtual void copy_to ( std::unique_ptr<Tbase>& dest) const = 0;
+    virtual Tbase* copy_to ( void* buf, std::size_t size) const = 0;
 };
 
 template <
@@ -274,7 +270,7 @@ struct Tbase<T (A1,A2,A3,A4,A5,A6,A7,A8,A9)>
 {
     virtual ~Tbase() {}
     virtual T evaluate (A1,A2,A3,A4,A5,A6,A7,A8,A9) const = 0;
-    virtual void copy_to ( std::unique_ptr<Tbase>& dest) const = 0;
+    virtual Tbase* copy_to ( void* buf, std::size_t size) const = 0;
 };
 
 template <
@@ -288,7 +284,7 @@ struct Tbase<T (A1,A2,A3,A4,A5,A6,A7,A8,A9,A10)>
 {
     virtual ~Tbase() {}
     virtual T evaluate (A1,A2,A3,A4,A5,A6,A7,A8,A9,A10) const = 0;
-    virtual void copy_to ( std::unique_ptr<Tbase>& dest) const = 0;
+    virtual Tbase* copy_to ( void* buf, std::size_t size) const = 0;
 };
 
 typedef Tbase<function_type> base;
@@ -318,8 +314,8 @@ static typename disable_if<is_function<T>,const T&>::type deref (const U& item)
     typename funct_type<T>::type item;                      \
     derived() {}                                            \
     derived(const T& val) : item(copy(val)) {}              \
-    virtual void copy_to ( std::unique_ptr<base>& dest) const    \
-    { dest.reset(new derived(deref<T>(item))); }
+    virtual base* copy_to ( void* buf, std::size_t size) const    \
+    { return any_impl::sbo_construct<derived>(buf, size, deref<T>(item)); }
 
 template <typename T, typename FT>
 struct derived : public base
@@ -508,7 +504,7 @@ struct derived<T,result_type (A1,A2,A3,A4,A5,A6,A7,A8,A9,A10)> : public base
     !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
 };
 
-std::unique_ptr<base> data;
+any_impl::sbo_storage<base, DLIB_ANY_SBO_SIZE> data;
 
 #undef DLIB_ANY_FUNCTION_DERIVED_BOILERPLATE
 
@@ -179,6 +179,9 @@ namespace dlib
             size_t new_size
         );
 
+        void shrink_to_fit (
+        );
+
         const T& back (
         ) const;
 
@@ -665,6 +668,33 @@ namespace dlib
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T,
+        typename mem_manager
+        >
+    void array<T,mem_manager>::
+    shrink_to_fit (
+    )
+    {
+        reset();
+        if (this->max_size() == this->size())
+            return;
+
+        array temp;
+        if (this->size() > 0)
+        {
+            temp.set_max_size(this->size());
+            temp.set_size(this->size());
+            for (size_t i = 0; i < this->size(); ++i)
+            {
+                exchange((*this)[i],temp[i]);
+            }
+        }
+        temp.swap(*this);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -216,7 +216,25 @@ namespace dlib
                        If an exception is thrown then it has no effect on *this.
             !*/
 
-            
+            void shrink_to_fit (
+            );
+            /*!
+                ensures
+                    - #size() == size()
+                    - #max_size() == size()
+                    - for all valid i:
+                        - #(*this)[i] == (*this)[i]
+                          (i.e. the elements of *this are unmodified)
+                    - #at_start() == true
+                    - releases any backing memory beyond what is needed to hold the
+                      current contents of this array.  This undoes the over-allocation
+                      performed by resize() and push_back().
+                throws
+                    - std::bad_alloc or any exception thrown by T's constructor.
+                       If an exception is thrown then it has no effect on *this.
+            !*/
+
+
             const T& back (
             ) const;
             /*!
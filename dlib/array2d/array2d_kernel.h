@@ -20,23 +20,29 @@ namespace dlib
 
         /*!
             INITIAL VALUE
-                - nc_ == 0 
-                - nr_ == 0 
-                - data == 0 
+                - nc_ == 0
+                - nr_ == 0
+                - data == 0
+                - capacity_ == 0
                 - at_start_ == true
                 - cur == 0
                 - last == 0
 
             CONVENTION
-                - nc_ == nc() 
-                - nr_ == nc() 
+                - nc_ == nc()
+                - nr_ == nc()
                 - if (data != 0) then
-                    - last == a pointer to the last element in the data array
-                    - data == pointer to an array of nc_*nr_ T objects 
+                    - data == pointer to an array of capacity_ T objects
+                    - capacity_ >= nc_*nr_
+                    - if (size() > 0) then
+                        - last == a pointer to the last element in use in the data array
+                    - else
+                        - last == 0
                 - else
                     - nc_ == 0
                     - nr_ == 0
                     - data == 0
+                    - capacity_ == 0
                     - last == 0
 
 
@@ -130,10 +136,11 @@ namespace dlib
         // -----------------------------------
 
         array2d (
-        ) : 
+        ) :
             data(0),
             nc_(0),
             nr_(0),
+            capacity_(0),
             cur(0),
             last(0),
             at_start_(true)
@@ -143,10 +150,11 @@ namespace dlib
         array2d(
             long rows,
             long cols
-        ) : 
+        ) :
             data(0),
             nc_(0),
             nr_(0),
+            capacity_(0),
             cur(0),
             last(0),
             at_start_(true)
@@ -222,6 +230,38 @@ namespace dlib
             return row(data+row_*nc_, nc_);
         }
 
+        T* row_ptr (
+            long row_
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(row_ < nr() && row_ >= 0,
+                "\tT* array2d::row_ptr(long row_)"
+                << "\n\tThe row index given must be less than the number of rows."
+                << "\n\tthis:     " << this
+                << "\n\trow_:      " << row_
+                << "\n\tnr(): " << nr()
+                );
+
+            return data+row_*nc_;
+        }
+
+        const T* row_ptr (
+            long row_
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(row_ < nr() && row_ >= 0,
+                "\tconst T* array2d::row_ptr(long row_) const"
+                << "\n\tThe row index given must be less than the number of rows."
+                << "\n\tthis:     " << this
+                << "\n\trow_:      " << row_
+                << "\n\tnr(): " << nr()
+                );
+
+            return data+row_*nc_;
+        }
+
         void swap (
             array2d& item
         )
@@ -229,6 +269,7 @@ namespace dlib
             exchange(data,item.data);
             exchange(nr_,item.nr_);
             exchange(nc_,item.nc_);
+            exchange(capacity_,item.capacity_);
             exchange(at_start_,item.at_start_);
             exchange(cur,item.cur);
             exchange(last,item.last);
@@ -244,6 +285,7 @@ namespace dlib
                 nc_ = 0;
                 nr_ = 0;
                 data = 0;
+                capacity_ = 0;
                 at_start_ = true;
                 cur = 0;
                 last = 0;
@@ -255,6 +297,9 @@ namespace dlib
             long cols
         );
 
+        void shrink_to_fit (
+        );
+
         bool at_start (
         ) const { return at_start_; }
 
@@ -305,9 +350,13 @@ namespace dlib
             }
             else if (at_start_)
             {
-                cur = data;
                 at_start_ = false;
-                return (data != 0);
+                if (size() > 0)
+                {
+                    cur = data;
+                    return true;
+                }
+                return false;
             }
             else
             {
@@ -351,6 +400,7 @@ namespace dlib
         T* data;
         long nc_;
         long nr_;
+        size_t capacity_;
 
         typename mem_manager::template rebind<T>::other pool;
         mutable T* cur;
@@ -371,16 +421,38 @@ namespace dlib
     ) { a.swap(b); }   
 
 
-    template <
-        typename T,
-        typename mem_manager
-        >
-    void serialize (
-        const array2d<T,mem_manager>& item, 
-        std::ostream& out 
-    )   
+    namespace impl
     {
-        try
+        template <
+            typename T,
+            typename mem_manager
+            >
+        typename enable_if_c<ser_helper::is_block_serializable<T>::value>::type serialize_array2d (
+            const array2d<T,mem_manager>& item,
+            std::ostream& out
+        )
+        {
+            // Simple arithmetic elements are written with the block streamed format.
+            // Its header lets the reader allocate the array exactly once and then
+            // stream the raw element bytes in large chunks rather than deserializing
+            // one element at a time.
+            ser_helper::write_block_header(out, item.nr(), item.nc(),
+                ser_helper::block_element_code<T>(), true);
+            if (item.size() != 0)
+            {
+                ser_helper::write_block_data(out, reinterpret_cast<const char*>(&item[0][0]),
+                    sizeof(T)*static_cast<size_t>(item.size()));
+            }
+        }
+
+        template <
+            typename T,
+            typename mem_manager
+            >
+        typename disable_if_c<ser_helper::is_block_serializable<T>::value>::type serialize_array2d (
+            const array2d<T,mem_manager>& item,
+            std::ostream& out
+        )
         {
             // The reason the serialization is a little funny is because we are trying to
             // maintain backwards compatibility with an older serialization format used by
@@ -394,9 +466,75 @@ namespace dlib
                 serialize(item.element(),out);
             item.reset();
         }
+
+        template <
+            typename T,
+            typename mem_manager
+            >
+        typename enable_if_c<ser_helper::is_block_serializable<T>::value>::type deserialize_block_array2d (
+            array2d<T,mem_manager>& item,
+            std::istream& in
+        )
+        {
+            long nr, nc;
+            unsigned char element_code, wire_little_endian, wire_row_major;
+            deserialize(nr,in);
+            deserialize(nc,in);
+            deserialize(element_code,in);
+            deserialize(wire_little_endian,in);
+            deserialize(wire_row_major,in);
+
+            item.set_size(nr,nc);
+            if (item.size() == 0)
+                return;
+
+            byte_orderer bo;
+            if (element_code == ser_helper::block_element_code<T>() &&
+                (wire_little_endian != 0) == bo.host_is_little_endian() &&
+                wire_row_major != 0)
+            {
+                // The bytes on the wire are exactly our in-memory representation, so
+                // stream them straight into the array.
+                ser_helper::read_block_data(in, reinterpret_cast<char*>(&item[0][0]),
+                    sizeof(T)*static_cast<size_t>(item.size()));
+            }
+            else
+            {
+                ser_helper::read_block_elements(in, element_code, &item[0][0], nr, nc,
+                    true, wire_row_major != 0, wire_little_endian != 0);
+            }
+        }
+
+        template <
+            typename T,
+            typename mem_manager
+            >
+        typename disable_if_c<ser_helper::is_block_serializable<T>::value>::type deserialize_block_array2d (
+            array2d<T,mem_manager>&,
+            std::istream&
+        )
+        {
+            throw serialization_error("The stream contains block streamed data but the array2d "
+                "doesn't have an arithmetic element type.");
+        }
+    }
+
+    template <
+        typename T,
+        typename mem_manager
+        >
+    void serialize (
+        const array2d<T,mem_manager>& item,
+        std::ostream& out
+    )
+    {
+        try
+        {
+            impl::serialize_array2d(item, out);
+        }
         catch (serialization_error& e)
-        { 
-            throw serialization_error(e.info + "\n   while serializing object of type array2d"); 
+        {
+            throw serialization_error(e.info + "\n   while serializing object of type array2d");
         }
     }
 
@@ -405,14 +543,19 @@ namespace dlib
         typename mem_manager
         >
     void deserialize (
-        array2d<T,mem_manager>& item, 
+        array2d<T,mem_manager>& item,
         std::istream& in
-    )   
+    )
     {
         try
         {
             long nr, nc;
             deserialize(nr,in);
+            if (nr == ser_helper::block_format_tag)
+            {
+                impl::deserialize_block_array2d(item, in);
+                return;
+            }
             deserialize(nc,in);
 
             // this is the newer serialization format
@@ -429,13 +572,13 @@ namespace dlib
             item.set_size(nr,nc);
 
             while (item.move_next())
-                deserialize(item.element(),in); 
+                deserialize(item.element(),in);
             item.reset();
         }
         catch (serialization_error& e)
-        { 
+        {
             item.clear();
-            throw serialization_error(e.info + "\n   while deserializing object of type array2d"); 
+            throw serialization_error(e.info + "\n   while deserializing object of type array2d");
         }
     }
 
@@ -477,20 +620,36 @@ namespace dlib
         nc_ = cols;
         nr_ = rows;
 
+        const size_t new_size = static_cast<size_t>(rows)*static_cast<size_t>(cols);
+
+        // If the backing store is already big enough then just reuse it rather than
+        // going back to the allocator.  This makes repeatedly sizing the same array2d
+        // between video frames free once it has reached its steady state size.
+        if (new_size <= capacity_)
+        {
+            if (new_size > 0)
+                last = data + new_size - 1;
+            else
+                last = 0;
+            return;
+        }
+
         // free any existing memory
         if (data != 0)
         {
             pool.deallocate_array(data);
             data = 0;
+            capacity_ = 0;
         }
 
         // now setup this object to have the new size
         try
         {
-            if (nr_ > 0)
+            if (new_size > 0)
             {
-                data = pool.allocate_array(nr_*nc_);
-                last = data + nr_*nc_ - 1;
+                data = pool.allocate_array(new_size);
+                capacity_ = new_size;
+                last = data + new_size - 1;
             }
         }
         catch (...)
@@ -501,11 +660,48 @@ namespace dlib
             data = 0;
             nc_ = 0;
             nr_ = 0;
+            capacity_ = 0;
             last = 0;
             throw;
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T,
+        typename mem_manager
+        >
+    void array2d<T,mem_manager>::
+    shrink_to_fit (
+    )
+    {
+        if (capacity_ == size())
+            return;
+
+        // set the enumerator back at the start
+        at_start_ = true;
+        cur = 0;
+
+        if (size() == 0)
+        {
+            pool.deallocate_array(data);
+            data = 0;
+            capacity_ = 0;
+            last = 0;
+            return;
+        }
+
+        T* new_data = pool.allocate_array(size());
+        // everything that could throw is done, now update this object
+        for (size_t i = 0; i < size(); ++i)
+            exchange(new_data[i], data[i]);
+        pool.deallocate_array(data);
+        data = new_data;
+        capacity_ = size();
+        last = data + size() - 1;
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <typename T, typename MM>
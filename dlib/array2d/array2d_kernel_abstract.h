@@ -195,13 +195,37 @@ namespace dlib
                 - if (the call to set_size() doesn't change the dimensions of this array) then
                     - all elements in this array retain their values from before this function was called
                 - else
-                    - all elements in this array have initial values for their type
+                    - the values of the elements in this array are undefined.
+                - This function only allocates memory when the new dimensions don't fit
+                  inside the memory already allocated to this object.  In particular,
+                  shrinking an array2d or resizing it between dimensions with the same
+                  total number of elements never touches the allocator, so the backing
+                  store can be reused from call to call.  Use shrink_to_fit() if you
+                  want to release the extra memory.
             throws
-                - std::bad_alloc 
+                - std::bad_alloc
                     If this exception is thrown then #*this will have an initial
                     value for its type.
         !*/
 
+        void shrink_to_fit (
+        );
+        /*!
+            ensures
+                - #nc() == nc()
+                - #nr() == nr()
+                - #at_start() == true
+                - all elements in this array retain their values from before this
+                  function was called
+                - releases any backing memory beyond what is needed to hold the
+                  current contents of this array.  i.e. undoes the memory caching
+                  performed by set_size()
+            throws
+                - std::bad_alloc
+                    If this exception is thrown then this object is unchanged
+                    except that #at_start() == true.
+        !*/
+
         row operator[] (
             long row_index
         );
@@ -220,10 +244,36 @@ namespace dlib
             requires
                 - 0 <= row_index < nr()
             ensures
-                - returns a const row of nc() elements that represents the 
+                - returns a const row of nc() elements that represents the
                   given row_index'th row in *this.
         !*/
 
+        T* row_ptr (
+            long row_index
+        );
+        /*!
+            requires
+                - 0 <= row_index < nr()
+            ensures
+                - returns a pointer to the first element of the given row_index'th row
+                  in *this.  Each row is stored as one contiguous block of memory, so
+                  for all valid c: row_ptr(row_index)[c] == (*this)[row_index][c].
+                  Unlike operator[], the returned pointer carries no per-element bounds
+                  checking, which makes it useful in performance critical loops.
+        !*/
+
+        const T* row_ptr (
+            long row_index
+        ) const;
+        /*!
+            requires
+                - 0 <= row_index < nr()
+            ensures
+                - returns a const pointer to the first element of the given row_index'th
+                  row in *this.  Each row is stored as one contiguous block of memory, so
+                  for all valid c: row_ptr(row_index)[c] == (*this)[row_index][c].
+        !*/
+
         void swap (
             array2d& item
         );
@@ -164,12 +164,35 @@ namespace dlib
 #define DLIB_CASSERT(...) DLIB_WORKAROUND_VISUAL_STUDIO_BUGS(DLIBM_CASSERT_CHOOSER(__VA_ARGS__)(__VA_ARGS__))
 
 
-#ifdef ENABLE_ASSERTS 
+#ifdef ENABLE_ASSERTS
     #define DLIB_ASSERT(...) DLIB_CASSERT(__VA_ARGS__)
     #define DLIB_IF_ASSERT(exp) exp
 #else
     #define DLIB_ASSERT(...) {}
-    #define DLIB_IF_ASSERT(exp) 
+    #define DLIB_IF_ASSERT(exp)
+#endif
+
+// ----------------------------------------------------------------------------------------
+
+    /*!A DLIB_ASSUME
+
+        In debug builds (i.e. when ENABLE_ASSERTS is defined) this macro checks its
+        argument just like DLIB_CASSERT does.  However, in release builds it instead
+        tells the compiler it may take the expression to be true.  This lets the
+        optimizer discard redundant bounds and aliasing computations from inner loops.
+        Therefore, the expression given to DLIB_ASSUME must always be true and must not
+        have any side effects, since it may or may not be evaluated.
+    !*/
+#if defined ENABLE_ASSERTS
+    #define DLIB_ASSUME(_exp) DLIB_CASSERT(_exp, "Violated an assumption given to DLIB_ASSUME()")
+#elif defined(_MSC_VER)
+    #define DLIB_ASSUME(_exp) __assume(_exp)
+#elif defined(__clang__)
+    #define DLIB_ASSUME(_exp) __builtin_assume(_exp)
+#elif defined(__GNUC__)
+    #define DLIB_ASSUME(_exp) {if (!(_exp)) __builtin_unreachable();}
+#else
+    #define DLIB_ASSUME(_exp) {}
 #endif
 
 // ----------------------------------------------------------------------------------------
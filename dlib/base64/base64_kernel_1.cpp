@@ -304,6 +304,64 @@ namespace dlib
         out.pubsync();
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void base64::
+    encode (
+        const std::vector<char>& data,
+        std::vector<char>& encoded
+    ) const
+    {
+        const unsigned char* in = reinterpret_cast<const unsigned char*>(data.data());
+        const unsigned long len = static_cast<unsigned long>(data.size());
+
+        // every 3 input bytes (rounding up at the end) turn into 4 output
+        // characters and a line ending goes in front of every 19th group after
+        // the first.
+        const unsigned long num_groups = (len+2)/3;
+        const unsigned long num_eols = (num_groups == 0) ? 0 : (num_groups-1)/19;
+        const unsigned long eol_size = (eol_style == CRLF) ? 2 : 1;
+
+        encoded.resize(num_groups*4 + num_eols*eol_size);
+        char* out = encoded.data();
+
+        int counter = 19;
+        unsigned long i = 0;
+        for (unsigned long g = 0; g < num_groups; ++g)
+        {
+            if (counter == 0)
+            {
+                counter = 19;
+                // write a line ending
+                if (eol_style == CR || eol_style == CRLF)
+                {
+                    *out = '\r';
+                    ++out;
+                }
+                if (eol_style == LF || eol_style == CRLF)
+                {
+                    *out = '\n';
+                    ++out;
+                }
+            }
+            --counter;
+
+            // encode the next 3 bytes into 4 base64 characters, padding with '='
+            // if we are in the last, partial group
+            const unsigned long remaining = len - i;
+            const unsigned char ch0 = in[i];
+            const unsigned char ch1 = (remaining > 1) ? in[i+1] : 0;
+            const unsigned char ch2 = (remaining > 2) ? in[i+2] : 0;
+
+            out[0] = encode_table[ch0>>2];
+            out[1] = encode_table[((ch0&0x03)<<4)|(ch1>>4)];
+            out[2] = (remaining > 1) ? encode_table[((ch1&0x0f)<<2)|(ch2>>6)] : '=';
+            out[3] = (remaining > 2) ? encode_table[ch2&0x3f] : '=';
+            out += 4;
+            i += 3;
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     void base64::
@@ -395,6 +453,85 @@ namespace dlib
         out.pubsync();
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void base64::
+    decode (
+        const std::vector<char>& encoded,
+        std::vector<char>& data
+    ) const
+    {
+        using namespace std;
+
+        data.clear();
+        data.reserve(encoded.size()/4*3 + 3);
+
+        unsigned char inbuf[4];
+        unsigned char outbuf[3];
+        int inbuf_pos = 0;
+        unsigned char c1, c2, c3, c4, c5, c6;
+
+        for (unsigned long i = 0; i < encoded.size(); ++i)
+        {
+            const unsigned char ch = static_cast<unsigned char>(encoded[i]);
+
+            // ignore any characters that aren't part of the encoding, such as
+            // the line endings the encoder inserts
+            if (decode_table[ch] == bad_value && ch != '=')
+                continue;
+
+            inbuf[inbuf_pos] = ch;
+            ++inbuf_pos;
+
+            // if we have 4 valid characters
+            if (inbuf_pos == 4)
+            {
+                inbuf_pos = 0;
+
+                // this might be the end of the encoded data so we need to figure out if
+                // there was any padding applied.
+                unsigned long outsize = 3;
+                if (inbuf[3] == '=')
+                {
+                    if (inbuf[2] == '=')
+                        outsize = 1;
+                    else
+                        outsize = 2;
+                }
+
+                // decode the incoming characters
+                inbuf[0] = decode_table[inbuf[0]];
+                inbuf[1] = decode_table[inbuf[1]];
+                inbuf[2] = decode_table[inbuf[2]];
+                inbuf[3] = decode_table[inbuf[3]];
+
+                // now pack these guys into bytes rather than 6 bit chunks
+                c1 = inbuf[0]<<2;
+                c2 = inbuf[1]>>4;
+                c3 = inbuf[1]<<4;
+                c4 = inbuf[2]>>2;
+                c5 = inbuf[2]<<6;
+                c6 = inbuf[3];
+
+                outbuf[0] = c1|c2;
+                outbuf[1] = c3|c4;
+                outbuf[2] = c5|c6;
+
+                for (unsigned long j = 0; j < outsize; ++j)
+                    data.push_back(static_cast<char>(outbuf[j]));
+            }
+        }
+
+        if (inbuf_pos != 0)
+        {
+            ostringstream sout;
+            sout << inbuf_pos << " extra characters were found at the end of the encoded data."
+                << "  This may indicate that the data stream has been truncated.";
+            // this happens if we hit EOF in the middle of decoding a 24bit block.
+            throw decode_error(sout.str());
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
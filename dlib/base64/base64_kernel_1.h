@@ -6,6 +6,7 @@
 #include "../algs.h"
 #include "base64_kernel_abstract.h"
 #include <iosfwd>
+#include <vector>
 
 namespace dlib
 {
@@ -64,11 +65,21 @@ namespace dlib
             std::ostream& out
         ) const;
 
+        void encode (
+            const std::vector<char>& data,
+            std::vector<char>& encoded
+        ) const;
+
         void decode (
             std::istream& in,
             std::ostream& out
         ) const;
 
+        void decode (
+            const std::vector<char>& encoded,
+            std::vector<char>& data
+        ) const;
+
     private:
 
         char* encode_table;
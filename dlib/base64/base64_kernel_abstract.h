@@ -5,6 +5,7 @@
 
 #include "../algs.h"
 #include <iosfwd>
+#include <vector>
 
 namespace dlib
 {
@@ -84,7 +85,20 @@ namespace dlib
                     if there was a problem writing to out then this exception will 
                     be thrown.                      
                 - any other exception
-                    this exception may be thrown if there is any other problem                    
+                    this exception may be thrown if there is any other problem
+        !*/
+
+        void encode (
+            const std::vector<char>& data,
+            std::vector<char>& encoded
+        ) const;
+        /*!
+            ensures
+                - #encoded == the base64 encoding of data.  This produces exactly
+                  the same bytes as the stream version of encode() but works
+                  entirely out of in-memory buffers and is therefore a lot faster.
+            throws
+                - std::bad_alloc
         !*/
 
         void decode (
@@ -104,7 +118,24 @@ namespace dlib
                     it from being correctly decoded then this exception is 
                     thrown.  
                 - any other exception
-                    this exception may be thrown if there is any other problem                    
+                    this exception may be thrown if there is any other problem
+        !*/
+
+        void decode (
+            const std::vector<char>& encoded,
+            std::vector<char>& data
+        ) const;
+        /*!
+            ensures
+                - #data == the decoded form of the base64 data in encoded.  Just
+                  like the stream version of decode(), any characters in encoded
+                  that aren't part of the base64 alphabet are ignored.
+            throws
+                - std::bad_alloc
+                - decode_error
+                    if an error was detected in the encoded data that prevented
+                    it from being correctly decoded then this exception is
+                    thrown.
         !*/
 
     private:
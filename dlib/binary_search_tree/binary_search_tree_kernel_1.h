@@ -9,8 +9,10 @@
 #include "../interfaces/enumerable.h"
 #include "../interfaces/remover.h"
 #include "../serialize.h"
+#include <algorithm>
 #include <cstdlib>
 #include <functional>
+#include <vector>
 
 namespace dlib 
 {
@@ -139,6 +141,16 @@ namespace dlib
                 range& r
             );
 
+            void add_sorted (
+                std::vector<domain>& d,
+                std::vector<range>& r
+            );
+
+            void lookup (
+                const std::vector<domain>& d,
+                std::vector<const range*>& results
+            ) const;
+
             void remove (
                 const domain& d,
                 domain& d_copy,
@@ -311,10 +323,38 @@ namespace dlib
                     - the mapping (d --> r) has been added to #t 
                     - #d and #r have initial values for their types
                     - #t is still a binary search tree 
-                    - returns false if the height of the tree has not changed 
+                    - returns false if the height of the tree has not changed
                     - returns true if the height of the tree has grown by one
             !*/
 
+            node* build_sorted_tree (
+                std::vector<domain>& d,
+                std::vector<range>& r,
+                unsigned long first,
+                unsigned long last,
+                short& height
+            );
+            /*!
+                requires
+                    - first <= last <= d.size()
+                    - d.size() == r.size()
+                    - the elements of d in the range [first,last) are in sorted order
+                      according to comp
+                ensures
+                    - if (first == last) then
+                        - #height == 0
+                        - returns 0
+                    - else
+                        - returns the root of a balanced binary search tree containing
+                          the mappings d[i] --> r[i] for all i in the range [first,last),
+                          with every node's balance member set correctly
+                        - the elements of #d and #r in the range [first,last) have
+                          initial values for their types
+                        - #height == the height of the returned tree
+                    - if this function throws then it has deallocated any nodes it had
+                      allocated before rethrowing
+            !*/
+
             bool remove_from_tree (
                 node*& t,
                 const domain& d,
@@ -662,7 +702,56 @@ namespace dlib
         typename range,
         typename mem_manager,
         typename compare
-        >   
+        >
+    void binary_search_tree_kernel_1<domain,range,mem_manager,compare>::
+    add_sorted (
+        std::vector<domain>& d,
+        std::vector<range>& r
+    )
+    {
+        if (tree_size == 0)
+        {
+            // the tree is empty so we can build a perfectly balanced tree directly
+            // from the sorted input in O(d.size()) time.
+            tree_root = build_sorted_tree(d,r,0,d.size(),tree_height);
+            tree_size = d.size();
+        }
+        else
+        {
+            for (unsigned long i = 0; i < d.size(); ++i)
+                add(d[i],r[i]);
+        }
+        // reset the enumerator
+        reset();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename domain,
+        typename range,
+        typename mem_manager,
+        typename compare
+        >
+    void binary_search_tree_kernel_1<domain,range,mem_manager,compare>::
+    lookup (
+        const std::vector<domain>& d,
+        std::vector<const range*>& results
+    ) const
+    {
+        results.resize(d.size());
+        for (unsigned long i = 0; i < d.size(); ++i)
+            results[i] = return_reference(tree_root,d[i]);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename domain,
+        typename range,
+        typename mem_manager,
+        typename compare
+        >
     void binary_search_tree_kernel_1<domain,range,mem_manager,compare>::
     remove (
         const domain& d,
@@ -1657,6 +1746,56 @@ namespace dlib
         return false;
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename domain,
+        typename range,
+        typename mem_manager,
+        typename compare
+        >
+    typename binary_search_tree_kernel_1<domain,range,mem_manager,compare>::node* binary_search_tree_kernel_1<domain,range,mem_manager,compare>::
+    build_sorted_tree (
+        std::vector<domain>& d,
+        std::vector<range>& r,
+        unsigned long first,
+        unsigned long last,
+        short& height
+    )
+    {
+        if (first == last)
+        {
+            height = 0;
+            return 0;
+        }
+
+        // Put the middle element into the root.  Note that the left subtree is
+        // never smaller than the right one, so the balance of every node we make
+        // comes out to either 0 or -1.
+        const unsigned long mid = first + (last-first)/2;
+
+        node& tree = *(pool.allocate());
+        tree.left = 0;
+        tree.right = 0;
+        short left_height = 0, right_height = 0;
+        try
+        {
+            tree.left = build_sorted_tree(d,r,first,mid,left_height);
+            tree.right = build_sorted_tree(d,r,mid+1,last,right_height);
+            exchange(tree.d,d[mid]);
+            exchange(tree.r,r[mid]);
+        }
+        catch (...)
+        {
+            delete_tree(&tree);
+            throw;
+        }
+        tree.balance = static_cast<signed char>(right_height - left_height);
+
+        height = static_cast<short>(std::max(left_height,right_height) + 1);
+        return &tree;
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
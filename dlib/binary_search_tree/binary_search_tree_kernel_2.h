@@ -10,8 +10,9 @@
 #include "../interfaces/remover.h"
 #include "../serialize.h"
 #include <functional>
+#include <vector>
 
-namespace dlib 
+namespace dlib
 {
 
     template <
@@ -141,6 +142,16 @@ namespace dlib
                 range& r
             );
 
+            void add_sorted (
+                std::vector<domain>& d,
+                std::vector<range>& r
+            );
+
+            void lookup (
+                const std::vector<domain>& d,
+                std::vector<const range*>& results
+            ) const;
+
             void remove (
                 const domain& d,
                 domain& d_copy,
@@ -393,10 +404,46 @@ namespace dlib
             ) const;
             /*!
                 ensures
-                    - returns the number of nodes in the longest path from the root of the 
+                    - returns the number of nodes in the longest path from the root of the
                       tree to a leaf
             !*/
 
+            node* build_sorted_tree (
+                std::vector<domain>& d,
+                std::vector<range>& r,
+                unsigned long first,
+                unsigned long last,
+                unsigned long depth,
+                unsigned long bottom_depth,
+                node* parent
+            );
+            /*!
+                requires
+                    - first <= last <= d.size()
+                    - d.size() == r.size()
+                    - the elements of d in the range [first,last) are in sorted order
+                      according to comp
+                    - depth == the depth the root of the returned tree will have in the
+                      finished tree (the overall root has depth 0)
+                    - bottom_depth == the depth of the deepest node in the finished tree
+                ensures
+                    - if (first == last) then
+                        - returns NIL
+                    - else
+                        - returns the root of a balanced binary search tree containing
+                          the mappings d[i] --> r[i] for all i in the range [first,last),
+                          with parent pointers set and every node at depth bottom_depth
+                          colored red and all others (including the root) black.  This
+                          coloring satisfies the red black CONVENTION because the way we
+                          pick the middle element always leaves missing children only in
+                          the bottom two levels of the tree.
+                        - the returned node's parent == parent
+                        - the elements of #d and #r in the range [first,last) have
+                          initial values for their types
+                    - if this function throws then it has deallocated any nodes it had
+                      allocated before rethrowing
+            !*/
+
             void delete_tree (
                 node* t
             );
@@ -605,7 +652,7 @@ namespace dlib
             exchange(tree_root->d,d);
             exchange(tree_root->r,r);
         }
-        else 
+        else
         {
             add_to_tree(tree_root,d,r);
         }
@@ -614,6 +661,59 @@ namespace dlib
         reset();
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename domain,
+        typename range,
+        typename mem_manager,
+        typename compare
+        >
+    void binary_search_tree_kernel_2<domain,range,mem_manager,compare>::
+    add_sorted (
+        std::vector<domain>& d,
+        std::vector<range>& r
+    )
+    {
+        if (tree_size == 0 && d.size() > 0)
+        {
+            // the tree is empty so we can build a balanced tree directly from the
+            // sorted input in O(d.size()) time.  The deepest level of the new tree
+            // has depth floor(log2(d.size())).
+            unsigned long bottom_depth = 0;
+            while ((2ul << bottom_depth) <= d.size())
+                ++bottom_depth;
+            tree_root = build_sorted_tree(d,r,0,d.size(),0,bottom_depth,NIL);
+            tree_size = d.size();
+        }
+        else
+        {
+            for (unsigned long i = 0; i < d.size(); ++i)
+                add(d[i],r[i]);
+        }
+        // reset the enumerator
+        reset();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename domain,
+        typename range,
+        typename mem_manager,
+        typename compare
+        >
+    void binary_search_tree_kernel_2<domain,range,mem_manager,compare>::
+    lookup (
+        const std::vector<domain>& d,
+        std::vector<const range*>& results
+    ) const
+    {
+        results.resize(d.size());
+        for (unsigned long i = 0; i < d.size(); ++i)
+            results[i] = return_reference(tree_root,d[i]);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -1064,6 +1164,57 @@ namespace dlib
         pool.deallocate(t);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename domain,
+        typename range,
+        typename mem_manager,
+        typename compare
+        >
+    typename binary_search_tree_kernel_2<domain,range,mem_manager,compare>::node* binary_search_tree_kernel_2<domain,range,mem_manager,compare>::
+    build_sorted_tree (
+        std::vector<domain>& d,
+        std::vector<range>& r,
+        unsigned long first,
+        unsigned long last,
+        unsigned long depth,
+        unsigned long bottom_depth,
+        node* parent
+    )
+    {
+        if (first == last)
+            return NIL;
+
+        // Put the middle element into the root.  Note that the left subtree is
+        // never smaller than the right one, so missing children only ever show up
+        // in the bottom two levels of the finished tree and the coloring below is
+        // therefore a legal red black coloring.
+        const unsigned long mid = first + (last-first)/2;
+
+        node& tree = *(pool.allocate());
+        tree.parent = parent;
+        tree.left = NIL;
+        tree.right = NIL;
+        // Color the bottom level red and everything above it black.  The root must
+        // always be black though (which only matters here when the whole tree is a
+        // single node).
+        tree.color = (depth == bottom_depth && depth != 0) ? red : black;
+        try
+        {
+            tree.left = build_sorted_tree(d,r,first,mid,depth+1,bottom_depth,&tree);
+            tree.right = build_sorted_tree(d,r,mid+1,last,depth+1,bottom_depth,&tree);
+            exchange(tree.d,d[mid]);
+            exchange(tree.r,r[mid]);
+        }
+        catch (...)
+        {
+            delete_tree(&tree);
+            throw;
+        }
+        return &tree;
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
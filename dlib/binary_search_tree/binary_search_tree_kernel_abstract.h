@@ -9,6 +9,7 @@
 #include "../serialize.h"
 #include "../algs.h"
 #include <functional>
+#include <vector>
 
 namespace dlib 
 {
@@ -145,12 +146,50 @@ namespace dlib
                 - #count(d) == count(d) + 1
                 - #at_start() == true
                 - #size() == size() + 1
-            throws  
-                - std::bad_alloc or any exception thrown by domain's or range's 
+            throws
+                - std::bad_alloc or any exception thrown by domain's or range's
                   constructor.
                     if add() throws then it has no effect
         !*/
 
+        void add_sorted (
+            std::vector<domain>& d,
+            std::vector<range>& r
+        );
+        /*!
+            requires
+                - d.size() == r.size()
+                - the elements of d are in sorted order with respect to compare.
+                  i.e. for all valid i < j: compare()(d[j],d[i]) == false
+            ensures
+                - for all valid i: adds a mapping between d[i] and r[i] to *this,
+                  just as if add(d[i],r[i]) had been called for each i in turn.
+                - the elements of #d and #r have initial values for their types
+                - #size() == size() + d.size()
+                - #at_start() == true
+                - if (size() == 0) then
+                    - this function builds a balanced tree directly from the sorted
+                      input and therefore runs in O(d.size()) time rather than the
+                      O(d.size()*log(d.size())) time that repeated calls to add()
+                      would take.
+            throws
+                - std::bad_alloc or any exception thrown by domain's or range's
+                  constructor.
+                    if this exception is thrown then *this is unusable
+                    until clear() is called and succeeds
+        !*/
+
+        void lookup (
+            const std::vector<domain>& d,
+            std::vector<const range*>& results
+        ) const;
+        /*!
+            ensures
+                - #results.size() == d.size()
+                - for all valid i: #results[i] == (*this)[d[i]]
+                  (i.e. performs a batch of operator[] lookups with a single call)
+        !*/
+
         void remove (
             const domain& d,
             domain& d_copy,
@@ -7,6 +7,7 @@
 #include "binary_search_tree_kernel_abstract.h"
 #include "../algs.h"
 #include "../assert.h"
+#include <vector>
 
 namespace dlib 
 {
@@ -38,6 +39,11 @@ namespace dlib
                 range& r
             );
 
+            void add_sorted (
+                std::vector<domain>& d,
+                std::vector<range>& r
+            );
+
             void remove_any (
                 domain& d,
                 range& r
@@ -116,6 +122,39 @@ namespace dlib
         bst_base::add(d,r);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename bst_base
+        >
+    void binary_search_tree_kernel_c<bst_base>::
+    add_sorted (
+        std::vector<domain>& d,
+        std::vector<range>& r
+    )
+    {
+        DLIB_CASSERT( d.size() == r.size(),
+            "\tvoid binary_search_tree::add_sorted"
+            << "\n\tthe number of domain and range elements given must be the same"
+            << "\n\tthis:       " << this
+            << "\n\td.size():   " << d.size()
+            << "\n\tr.size():   " << r.size()
+            );
+
+        typename bst_base::compare_type comp;
+        for (unsigned long i = 1; i < d.size(); ++i)
+        {
+            DLIB_CASSERT( comp(d[i],d[i-1]) == false,
+                "\tvoid binary_search_tree::add_sorted"
+                << "\n\tthe given elements must be in sorted order"
+                << "\n\tthis: " << this
+                << "\n\ti:    " << i
+                );
+        }
+
+        bst_base::add_sorted(d,r);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -6,6 +6,12 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+#include <new>
+#include <type_traits>
 
 #include "bridge_abstract.h"
 #include "../pipe.h"
@@ -15,6 +21,18 @@
 #include "../sockstreambuf.h"
 #include "../logger.h"
 #include "../algs.h"
+#include "../vectorstream.h"
+#include "../misc_api.h"
+
+#ifdef _WIN32
+#include "../windows_magic.h"
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 
 namespace dlib
@@ -90,6 +108,44 @@ namespace dlib
         const unsigned short port;
     };
 
+    struct listen_on_shared_memory
+    {
+        explicit listen_on_shared_memory (
+            const std::string& name_
+        ) : name(name_)
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(name.size() != 0,
+                "\t listen_on_shared_memory()"
+                << "\n\t The shared memory segment name can't be the empty string."
+                << "\n\t this: " << this
+                );
+        }
+
+    private:
+        friend class bridge;
+        const std::string name;
+    };
+
+    struct connect_to_shared_memory
+    {
+        explicit connect_to_shared_memory (
+            const std::string& name_
+        ) : name(name_)
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(name.size() != 0,
+                "\t connect_to_shared_memory()"
+                << "\n\t The shared memory segment name can't be the empty string."
+                << "\n\t this: " << this
+                );
+        }
+
+    private:
+        friend class bridge;
+        const std::string name;
+    };
+
     template <typename pipe_type>
     struct bridge_transmit_decoration
     {
@@ -557,6 +613,788 @@ namespace dlib
             const unsigned char keepalive_code;
             const unsigned char message_code;
 
+            mutex current_bs_mutex;
+            bridge_status current_bs;
+        };
+
+// ----------------------------------------------------------------------------------------
+
+        struct shm_ring
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is a single producer/single consumer byte ring living inside a
+                    shared memory segment.  bytes_written and bytes_read are free running
+                    counters, so the ring is full when bytes_written-bytes_read==capacity
+                    and empty when the counters are equal.  The writer sets eof when it
+                    will never write again.
+            !*/
+
+            const static unsigned long capacity = 1024*1024;
+
+            shm_ring() : bytes_written(0), bytes_read(0), eof(0) {}
+
+            std::atomic<uint64> bytes_written;
+            std::atomic<uint64> bytes_read;
+            std::atomic<uint32> eof;
+            unsigned char data[capacity];
+        };
+
+        struct shm_layout
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is the layout of the shared memory segment used by the bridge.
+                    The listening end creates the segment and stores magic_value into
+                    magic once the segment is fully constructed.  A connecting end
+                    attaches by atomically changing peer_attached from 0 to 1, which
+                    also guarantees there is never more than one connecting end at a
+                    time.
+            !*/
+
+            const static uint32 magic_value = 0x62726467; // "brdg"
+
+            shm_layout() : magic(0), peer_attached(0) {}
+
+            std::atomic<uint32> magic;
+            std::atomic<uint32> peer_attached;
+            shm_ring to_connecter;  // written by the listening end
+            shm_ring to_listener;   // written by the connecting end
+        };
+
+        class shm_segment : noncopyable
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This object maps the named shared memory segment holding a
+                    shm_layout into this process, either creating the segment or
+                    attaching to one made by another process.  The creating process
+                    removes the segment name from the system when this object is
+                    destructed or close()ed.
+            !*/
+        public:
+
+            shm_segment() : seg(0), is_owner(false)
+            {
+#ifdef _WIN32
+                handle = NULL;
+#endif
+            }
+
+            ~shm_segment() { close(); }
+
+            shm_layout* get() const { return seg; }
+
+#ifdef _WIN32
+            bool create (
+                const std::string& name
+            )
+            {
+                handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                            0, (DWORD)sizeof(shm_layout), ("Local\\dlib_bridge_"+name).c_str());
+                if (handle == NULL)
+                    return false;
+                if (GetLastError() == ERROR_ALREADY_EXISTS)
+                {
+                    CloseHandle(handle);
+                    handle = NULL;
+                    return false;
+                }
+                void* ptr = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(shm_layout));
+                if (ptr == NULL)
+                {
+                    CloseHandle(handle);
+                    handle = NULL;
+                    return false;
+                }
+                seg = new(ptr) shm_layout;
+                seg->magic.store(shm_layout::magic_value, std::memory_order_release);
+                is_owner = true;
+                return true;
+            }
+
+            bool open_existing (
+                const std::string& name
+            )
+            {
+                handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, ("Local\\dlib_bridge_"+name).c_str());
+                if (handle == NULL)
+                    return false;
+                void* ptr = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(shm_layout));
+                if (ptr == NULL)
+                {
+                    CloseHandle(handle);
+                    handle = NULL;
+                    return false;
+                }
+                seg = reinterpret_cast<shm_layout*>(ptr);
+                if (seg->magic.load(std::memory_order_acquire) != shm_layout::magic_value)
+                {
+                    close();
+                    return false;
+                }
+                is_owner = false;
+                return true;
+            }
+
+            void close ()
+            {
+                if (seg)
+                {
+                    UnmapViewOfFile(seg);
+                    seg = 0;
+                }
+                if (handle)
+                {
+                    CloseHandle(handle);
+                    handle = NULL;
+                }
+                is_owner = false;
+            }
+#else
+            bool create (
+                const std::string& name
+            )
+            {
+                shm_name = "/dlib_bridge_" + name;
+                // Remove any stale segment left behind by a crashed process.
+                shm_unlink(shm_name.c_str());
+                int fd = shm_open(shm_name.c_str(), O_CREAT|O_EXCL|O_RDWR, 0600);
+                if (fd == -1)
+                    return false;
+                if (ftruncate(fd, sizeof(shm_layout)) == -1)
+                {
+                    ::close(fd);
+                    shm_unlink(shm_name.c_str());
+                    return false;
+                }
+                void* ptr = mmap(0, sizeof(shm_layout), PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if (ptr == MAP_FAILED)
+                {
+                    shm_unlink(shm_name.c_str());
+                    return false;
+                }
+                seg = new(ptr) shm_layout;
+                seg->magic.store(shm_layout::magic_value, std::memory_order_release);
+                is_owner = true;
+                return true;
+            }
+
+            bool open_existing (
+                const std::string& name
+            )
+            {
+                shm_name = "/dlib_bridge_" + name;
+                int fd = shm_open(shm_name.c_str(), O_RDWR, 0600);
+                if (fd == -1)
+                    return false;
+                struct stat st;
+                if (fstat(fd, &st) == -1 || st.st_size < (off_t)sizeof(shm_layout))
+                {
+                    ::close(fd);
+                    return false;
+                }
+                void* ptr = mmap(0, sizeof(shm_layout), PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if (ptr == MAP_FAILED)
+                    return false;
+                seg = reinterpret_cast<shm_layout*>(ptr);
+                if (seg->magic.load(std::memory_order_acquire) != shm_layout::magic_value)
+                {
+                    close();
+                    return false;
+                }
+                is_owner = false;
+                return true;
+            }
+
+            void close ()
+            {
+                if (seg)
+                {
+                    munmap(seg, sizeof(shm_layout));
+                    if (is_owner)
+                        shm_unlink(shm_name.c_str());
+                    seg = 0;
+                }
+                is_owner = false;
+            }
+#endif
+
+        private:
+#ifdef _WIN32
+            HANDLE handle;
+#else
+            std::string shm_name;
+#endif
+            shm_layout* seg;
+            bool is_owner;
+        };
+
+// ----------------------------------------------------------------------------------------
+
+        template <
+            typename transmit_pipe_type,
+            typename receive_pipe_type
+            >
+        class impl_shm_bridge : public impl_bridge_base, private noncopyable, private multithreaded_object
+        {
+            /*!
+                CONVENTION
+                    - if (is_listener) then
+                        - this object created the shared memory segment and waits for a
+                          peer to attach to it when not connected.
+                    - else
+                        - this object is supposed to be attempting to attach to the
+                          segment when not connected.
+                        - attached == true only while we hold the segment's
+                          peer_attached slot.
+
+                    - get_bridge_status() == current_bs
+            !*/
+        public:
+
+            impl_shm_bridge (
+                const std::string& name_,
+                bool is_listener_,
+                transmit_pipe_type* transmit_pipe_,
+                receive_pipe_type* receive_pipe_
+            ) :
+                s(m),
+                receive_thread_active(false),
+                transmit_thread_active(false),
+                name(name_),
+                is_listener(is_listener_),
+                attached(false),
+                transmit_pipe(transmit_pipe_),
+                receive_pipe(receive_pipe_),
+                dlog("dlib.bridge")
+            {
+                if (is_listener && !segment.create(name))
+                {
+                    throw socket_error("Unable to create shared memory segment '" + name + "'.");
+                }
+
+                register_thread(*this, &impl_shm_bridge::transmit_thread);
+                register_thread(*this, &impl_shm_bridge::receive_thread);
+                register_thread(*this, &impl_shm_bridge::connect_thread);
+
+                start();
+            }
+
+            ~impl_shm_bridge()
+            {
+                // tell the threads to terminate
+                stop();
+
+                // save current pipe enabled status so we can restore it to however
+                // it was before this destructor ran.
+                bool transmit_enabled = true;
+                bool receive_enabled = true;
+
+                // make any calls blocked on a pipe return immediately.
+                if (transmit_pipe)
+                {
+                    transmit_enabled = transmit_pipe->is_dequeue_enabled();
+                    transmit_pipe->disable_dequeue();
+                }
+                if (receive_pipe)
+                {
+                    receive_enabled = receive_pipe->is_enqueue_enabled();
+                    receive_pipe->disable_enqueue();
+                }
+
+                {
+                    auto_mutex lock(m);
+                    s.broadcast();
+                }
+
+                // wait for all the threads to terminate.
+                wait();
+
+                if (transmit_pipe && transmit_enabled)
+                    transmit_pipe->enable_dequeue();
+                if (receive_pipe && receive_enabled)
+                    receive_pipe->enable_enqueue();
+            }
+
+            bridge_status get_bridge_status (
+            ) const
+            {
+                auto_mutex lock(current_bs_mutex);
+                return current_bs;
+            }
+
+        private:
+
+            template <typename pipe_type>
+            typename enable_if<is_convertible<bridge_status, typename pipe_type::type> >::type  enqueue_bridge_status (
+                pipe_type* p,
+                const bridge_status& status
+            )
+            {
+                if (p)
+                {
+                    typename pipe_type::type temp(status);
+                    p->enqueue(temp);
+                }
+            }
+
+            template <typename pipe_type>
+            typename disable_if<is_convertible<bridge_status, typename pipe_type::type> >::type  enqueue_bridge_status (
+                pipe_type* ,
+                const bridge_status&
+            )
+            {
+            }
+
+            shm_ring& out_ring() { return is_listener ? segment.get()->to_connecter : segment.get()->to_listener; }
+            shm_ring& in_ring()  { return is_listener ? segment.get()->to_listener  : segment.get()->to_connecter; }
+
+            bool session_is_over ()
+            {
+                return should_stop() || in_ring().eof.load(std::memory_order_relaxed) != 0;
+            }
+
+            static void reset_ring (shm_ring& ring)
+            {
+                ring.bytes_written.store(0, std::memory_order_relaxed);
+                ring.bytes_read.store(0, std::memory_order_relaxed);
+                ring.eof.store(0, std::memory_order_release);
+            }
+
+            bool ring_write (
+                const char* buf,
+                unsigned long num
+            )
+            /*!
+                ensures
+                    - Copies num bytes into the outgoing ring, blocking while the ring
+                      is full.  Returns false, without necessarily having written
+                      everything, if the session ends or this object is being destructed
+                      before space becomes available.
+            !*/
+            {
+                shm_ring& out = out_ring();
+                unsigned long spin = 0;
+                while (num != 0)
+                {
+                    const uint64 written = out.bytes_written.load(std::memory_order_relaxed);
+                    const uint64 read    = out.bytes_read.load(std::memory_order_acquire);
+                    const unsigned long space = static_cast<unsigned long>(shm_ring::capacity - (written - read));
+                    if (space == 0)
+                    {
+                        if (session_is_over())
+                            return false;
+                        // Spin for a moment in case the reader is about to catch up, since
+                        // that keeps the same-host latency low, but don't burn a core while
+                        // the ring stays full.
+                        if (++spin > 1000)
+                            dlib::sleep(1);
+                        continue;
+                    }
+                    spin = 0;
+                    const unsigned long pos = static_cast<unsigned long>(written % shm_ring::capacity);
+                    const unsigned long chunk = std::min(std::min(num, space), shm_ring::capacity - pos);
+                    std::memcpy(out.data + pos, buf, chunk);
+                    out.bytes_written.store(written + chunk, std::memory_order_release);
+                    buf += chunk;
+                    num -= chunk;
+                }
+                return true;
+            }
+
+            bool ring_read (
+                char* buf,
+                unsigned long num
+            )
+            /*!
+                ensures
+                    - Copies num bytes out of the incoming ring into buf, blocking while
+                      the ring is empty.  Returns false, without necessarily having
+                      filled buf, if the peer closed the ring and no data remains or
+                      this object is being destructed.
+            !*/
+            {
+                shm_ring& in = in_ring();
+                unsigned long spin = 0;
+                while (num != 0)
+                {
+                    const uint64 written = in.bytes_written.load(std::memory_order_acquire);
+                    const uint64 read    = in.bytes_read.load(std::memory_order_relaxed);
+                    const unsigned long avail = static_cast<unsigned long>(written - read);
+                    if (avail == 0)
+                    {
+                        // Note that we check eof after sampling the write counter so we
+                        // never throw away messages sent just before the peer closed.
+                        if (in.eof.load(std::memory_order_acquire))
+                        {
+                            if (in.bytes_written.load(std::memory_order_acquire) == read)
+                                return false;
+                            continue;
+                        }
+                        if (should_stop())
+                            return false;
+                        if (++spin > 1000)
+                            dlib::sleep(1);
+                        continue;
+                    }
+                    spin = 0;
+                    const unsigned long pos = static_cast<unsigned long>(read % shm_ring::capacity);
+                    const unsigned long chunk = std::min(std::min(num, avail), shm_ring::capacity - pos);
+                    std::memcpy(buf, in.data + pos, chunk);
+                    in.bytes_read.store(read + chunk, std::memory_order_release);
+                    buf += chunk;
+                    num -= chunk;
+                }
+                return true;
+            }
+
+            template <typename T>
+            typename enable_if_c<std::is_trivially_copyable<T>::value, bool>::type send_item (
+                const T& item
+            )
+            {
+                // Trivially copyable objects go over the ring as raw bytes.  This is safe
+                // because both ends are on the same host and use the same type for the
+                // pipe contents.
+                const uint32 len = sizeof(T);
+                return ring_write(reinterpret_cast<const char*>(&len), sizeof(len)) &&
+                       ring_write(reinterpret_cast<const char*>(&item), sizeof(T));
+            }
+
+            template <typename T>
+            typename disable_if_c<std::is_trivially_copyable<T>::value, bool>::type send_item (
+                const T& item
+            )
+            {
+                tbuf.clear();
+                vectorstream out(tbuf);
+                serialize(item, out);
+                const uint32 len = static_cast<uint32>(tbuf.size());
+                return ring_write(reinterpret_cast<const char*>(&len), sizeof(len)) &&
+                       ring_write(tbuf.data(), len);
+            }
+
+            template <typename T>
+            typename enable_if_c<std::is_trivially_copyable<T>::value, bool>::type recv_item (
+                T& item
+            )
+            {
+                uint32 len;
+                if (!ring_read(reinterpret_cast<char*>(&len), sizeof(len)))
+                    return false;
+                if (len != sizeof(T))
+                    throw serialization_error("Message with an unexpected size arrived over a shared memory bridge.");
+                return ring_read(reinterpret_cast<char*>(&item), sizeof(T));
+            }
+
+            template <typename T>
+            typename disable_if_c<std::is_trivially_copyable<T>::value, bool>::type recv_item (
+                T& item
+            )
+            {
+                uint32 len;
+                if (!ring_read(reinterpret_cast<char*>(&len), sizeof(len)))
+                    return false;
+                rbuf.resize(len);
+                if (len != 0 && !ring_read(rbuf.data(), len))
+                    return false;
+                vectorstream in(rbuf);
+                deserialize(item, in);
+                return true;
+            }
+
+            void connect_thread (
+            )
+            {
+                while (!should_stop())
+                {
+                    if (is_listener)
+                    {
+                        // wait for a peer to attach to our segment
+                        shm_layout* seg = segment.get();
+                        while (seg->peer_attached.load(std::memory_order_acquire) == 0 && !should_stop())
+                        {
+                            auto_mutex lock(m);
+                            s.wait_or_timeout(10);
+                        }
+                        if (should_stop())
+                            break;
+                    }
+                    else
+                    {
+                        if (!segment.get() && !segment.open_existing(name))
+                        {
+                            // The segment doesn't exist yet.  So pause for a little bit
+                            // before making another attempt, just like a failed TCP
+                            // connect.
+                            auto_mutex lock(m);
+                            if (should_stop())
+                                break;
+                            s.wait_or_timeout(200);
+                            continue;
+                        }
+                        // Don't grab the segment while it still reflects a previous
+                        // session the listener hasn't cleaned up yet.
+                        if (segment.get()->to_connecter.eof.load(std::memory_order_acquire) != 0 ||
+                            segment.get()->to_listener.eof.load(std::memory_order_acquire) != 0)
+                        {
+                            auto_mutex lock(m);
+                            if (should_stop())
+                                break;
+                            s.wait_or_timeout(10);
+                            continue;
+                        }
+                        uint32 expected = 0;
+                        if (!segment.get()->peer_attached.compare_exchange_strong(expected, 1))
+                        {
+                            // some other process is already connected to the listener
+                            auto_mutex lock(m);
+                            if (should_stop())
+                                break;
+                            s.wait_or_timeout(200);
+                            continue;
+                        }
+                        attached = true;
+                    }
+
+                    dlog << LINFO << "Established new shared memory connection on '" << name << "'.";
+
+                    bridge_status temp_bs;
+                    {   auto_mutex lock(current_bs_mutex);
+                        current_bs.is_connected = true;
+                        current_bs.foreign_port = 0;
+                        current_bs.foreign_ip = "shm://" + name;
+                        temp_bs = current_bs;
+                    }
+                    enqueue_bridge_status(receive_pipe, temp_bs);
+
+
+                    {
+                        auto_mutex lock(m);
+                        receive_thread_active = true;
+                        transmit_thread_active = true;
+
+                        s.broadcast();
+
+                        // Wait for the transmit and receive threads to end before we continue.
+                        // This way we don't invalidate the segment while it is in use.
+                        while (receive_thread_active || transmit_thread_active)
+                            s.wait();
+                    }
+
+                    dlog << LINFO << "Closed shared memory connection on '" << name << "'.";
+                    {   auto_mutex lock(current_bs_mutex);
+                        current_bs.is_connected = false;
+                        temp_bs = current_bs;
+                    }
+                    enqueue_bridge_status(receive_pipe, temp_bs);
+
+                    // Tell the peer the session is over and recycle the segment so a new
+                    // session can start.
+                    out_ring().eof.store(1, std::memory_order_release);
+                    if (is_listener)
+                    {
+                        // wait for the peer to let go of the segment, then make the rings
+                        // fresh for the next connection
+                        shm_layout* seg = segment.get();
+                        while (seg->peer_attached.load(std::memory_order_acquire) != 0 && !should_stop())
+                        {
+                            auto_mutex lock(m);
+                            s.wait_or_timeout(10);
+                        }
+                        if (should_stop())
+                            break;
+                        reset_ring(seg->to_connecter);
+                        reset_ring(seg->to_listener);
+                    }
+                    else
+                    {
+                        segment.get()->peer_attached.store(0, std::memory_order_release);
+                        attached = false;
+                        segment.close();
+                    }
+                }
+
+                // Unblock a connected peer before we go away.
+                if (segment.get())
+                {
+                    out_ring().eof.store(1, std::memory_order_release);
+                    if (attached)
+                    {
+                        segment.get()->peer_attached.store(0, std::memory_order_release);
+                        attached = false;
+                    }
+                }
+            }
+
+            void receive_thread (
+            )
+            {
+                while (true)
+                {
+                    // wait until we have a connection
+                    {   auto_mutex lock(m);
+                        while (!receive_thread_active && !should_stop())
+                        {
+                            s.wait();
+                        }
+
+                        if (should_stop())
+                            break;
+                    }
+
+
+                    try
+                    {
+                        if (receive_pipe)
+                        {
+                            typename receive_pipe_type::type item;
+                            // This isn't necessary but doing it avoids a warning about
+                            // item being uninitialized sometimes.
+                            assign_zero_if_built_in_scalar_type(item);
+
+                            while (recv_item(item))
+                            {
+                                receive_pipe->enqueue(item);
+                            }
+                        }
+                        else
+                        {
+                            // Since we don't have a receive pipe to put messages into we
+                            // will just read the messages from the ring and ignore them.
+                            uint32 len;
+                            while (ring_read(reinterpret_cast<char*>(&len), sizeof(len)))
+                            {
+                                rbuf.resize(len);
+                                if (len != 0 && !ring_read(rbuf.data(), len))
+                                    break;
+                            }
+                        }
+                    }
+                    catch (std::bad_alloc& )
+                    {
+                        dlog << LERROR << "std::bad_alloc thrown while deserializing message from shared memory segment '" << name << "'";
+                    }
+                    catch (dlib::serialization_error& e)
+                    {
+                        dlog << LERROR << "dlib::serialization_error thrown while deserializing message from shared memory segment '" << name
+                            << "'.\nThe exception error message is: \n" << e.what();
+                    }
+                    catch (std::exception& e)
+                    {
+                        dlog << LERROR << "std::exception thrown while deserializing message from shared memory segment '" << name
+                            << "'.\nThe exception error message is: \n" << e.what();
+                    }
+
+
+                    // make sure the transmit thread also ends this session
+                    in_ring().eof.store(1, std::memory_order_release);
+                    auto_mutex lock(m);
+                    receive_thread_active = false;
+                    s.broadcast();
+                }
+
+                auto_mutex lock(m);
+                receive_thread_active = false;
+                s.broadcast();
+            }
+
+            void transmit_thread (
+            )
+            {
+                while (true)
+                {
+                    // wait until we have a connection
+                    {   auto_mutex lock(m);
+                        while (!transmit_thread_active && !should_stop())
+                        {
+                            s.wait();
+                        }
+
+                        if (should_stop())
+                            break;
+                    }
+
+
+                    try
+                    {
+                        typename transmit_pipe_type::type item;
+                        // This isn't necessary but doing it avoids a warning about
+                        // item being uninitialized sometimes.
+                        assign_zero_if_built_in_scalar_type(item);
+
+                        while (!session_is_over())
+                        {
+                            if (transmit_pipe)
+                            {
+                                if (transmit_pipe->dequeue_or_timeout(item,1000))
+                                {
+                                    if (!send_item(item))
+                                        break;
+                                    continue;
+                                }
+
+                                if (transmit_pipe->is_enabled() && transmit_pipe->is_dequeue_enabled())
+                                    continue;
+                            }
+
+                            // Pause for about a second.  Note that we use a wait_or_timeout() call rather
+                            // than sleep() here because we want to wake up immediately if this object is
+                            // being destructed rather than hang for a second.  Unlike the TCP transport
+                            // there is no need for keepalives here, the eof flag tells us when the peer
+                            // is gone.
+                            auto_mutex lock(m);
+                            if (should_stop())
+                                break;
+
+                            s.wait_or_timeout(1000);
+                        }
+                    }
+                    catch (std::bad_alloc& )
+                    {
+                        dlog << LERROR << "std::bad_alloc thrown while serializing message to shared memory segment '" << name << "'";
+                    }
+                    catch (dlib::serialization_error& e)
+                    {
+                        dlog << LERROR << "dlib::serialization_error thrown while serializing message to shared memory segment '" << name
+                            << "'.\nThe exception error message is: \n" << e.what();
+                    }
+                    catch (std::exception& e)
+                    {
+                        dlog << LERROR << "std::exception thrown while serializing message to shared memory segment '" << name
+                            << "'.\nThe exception error message is: \n" << e.what();
+                    }
+
+
+                    // make sure the receive thread also ends this session
+                    out_ring().eof.store(1, std::memory_order_release);
+                    auto_mutex lock(m);
+                    transmit_thread_active = false;
+                    s.broadcast();
+                }
+
+                auto_mutex lock(m);
+                transmit_thread_active = false;
+                s.broadcast();
+            }
+
+            mutex m;
+            signaler s;
+            bool receive_thread_active;
+            bool transmit_thread_active;
+            const std::string name;
+            const bool is_listener;
+            bool attached;
+            shm_segment segment;
+            transmit_pipe_type* const transmit_pipe;
+            receive_pipe_type* const receive_pipe;
+            logger dlog;
+            std::vector<char> tbuf;
+            std::vector<char> rbuf;
+
             mutex current_bs_mutex;
             bridge_status current_bs;
         };
@@ -647,6 +1485,64 @@ namespace dlib
         ) { pimpl.reset(); pimpl.reset(new impl_brns::impl_bridge<T,T>(network_parameters.ip, network_parameters.port, &transmit_pipe.p, 0)); }
 
 
+
+
+        template < typename T, typename R >
+        void reconfigure (
+            listen_on_shared_memory network_parameters,
+            bridge_transmit_decoration<T> transmit_pipe,
+            bridge_receive_decoration<R> receive_pipe
+        ) { pimpl.reset(); pimpl.reset(new impl_brns::impl_shm_bridge<T,R>(network_parameters.name, true, &transmit_pipe.p, &receive_pipe.p)); }
+
+        template < typename T, typename R >
+        void reconfigure (
+            listen_on_shared_memory network_parameters,
+            bridge_receive_decoration<R> receive_pipe,
+            bridge_transmit_decoration<T> transmit_pipe
+        ) { pimpl.reset(); pimpl.reset(new impl_brns::impl_shm_bridge<T,R>(network_parameters.name, true, &transmit_pipe.p, &receive_pipe.p)); }
+
+        template < typename T >
+        void reconfigure (
+            listen_on_shared_memory network_parameters,
+            bridge_transmit_decoration<T> transmit_pipe
+        ) { pimpl.reset(); pimpl.reset(new impl_brns::impl_shm_bridge<T,T>(network_parameters.name, true, &transmit_pipe.p, 0)); }
+
+        template < typename R >
+        void reconfigure (
+            listen_on_shared_memory network_parameters,
+            bridge_receive_decoration<R> receive_pipe
+        ) { pimpl.reset(); pimpl.reset(new impl_brns::impl_shm_bridge<R,R>(network_parameters.name, true, 0, &receive_pipe.p)); }
+
+
+
+
+        template < typename T, typename R >
+        void reconfigure (
+            connect_to_shared_memory network_parameters,
+            bridge_transmit_decoration<T> transmit_pipe,
+            bridge_receive_decoration<R> receive_pipe
+        ) { pimpl.reset(); pimpl.reset(new impl_brns::impl_shm_bridge<T,R>(network_parameters.name, false, &transmit_pipe.p, &receive_pipe.p)); }
+
+        template < typename T, typename R >
+        void reconfigure (
+            connect_to_shared_memory network_parameters,
+            bridge_receive_decoration<R> receive_pipe,
+            bridge_transmit_decoration<T> transmit_pipe
+        ) { pimpl.reset(); pimpl.reset(new impl_brns::impl_shm_bridge<T,R>(network_parameters.name, false, &transmit_pipe.p, &receive_pipe.p)); }
+
+        template < typename T >
+        void reconfigure (
+            connect_to_shared_memory network_parameters,
+            bridge_transmit_decoration<T> transmit_pipe
+        ) { pimpl.reset(); pimpl.reset(new impl_brns::impl_shm_bridge<T,T>(network_parameters.name, false, &transmit_pipe.p, 0)); }
+
+        template < typename R >
+        void reconfigure (
+            connect_to_shared_memory network_parameters,
+            bridge_receive_decoration<R> receive_pipe
+        ) { pimpl.reset(); pimpl.reset(new impl_brns::impl_shm_bridge<R,R>(network_parameters.name, false, 0, &receive_pipe.p)); }
+
+
         bridge_status get_bridge_status (
         ) const
         {
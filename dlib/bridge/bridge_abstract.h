@@ -52,6 +52,36 @@ namespace dlib
         !*/
     };
 
+    struct listen_on_shared_memory
+    {
+        explicit listen_on_shared_memory (
+            const std::string& name
+        );
+        /*!
+            requires
+                - name.size() != 0
+            ensures
+                - this object will represent a request to create a shared memory
+                  segment with the given name and wait for another process on this
+                  host to connect to it.
+        !*/
+    };
+
+    struct connect_to_shared_memory
+    {
+        explicit connect_to_shared_memory (
+            const std::string& name
+        );
+        /*!
+            requires
+                - name.size() != 0
+            ensures
+                - this object will represent a request to connect to the shared memory
+                  segment with the given name created by a bridge in another process
+                  on this host via listen_on_shared_memory.
+        !*/
+    };
+
     template <
         typename pipe_type
         >
@@ -134,7 +164,26 @@ namespace dlib
 
                 Additionally, a bridge object will periodically send bytes with
                 a value of 0 to ensure the TCP connection remains alive.  These
-                are just read and ignored.  
+                are just read and ignored.
+
+            SHARED MEMORY TRANSPORT
+                When both ends of a bridge live on the same host you can use the
+                listen_on_shared_memory and connect_to_shared_memory objects instead
+                of a TCP connection.  In that case the pipe contents move through a
+                lock-free ring buffer in a named shared memory segment, which avoids
+                the loopback networking stack entirely and therefore has much lower
+                latency.  Moreover, objects with a trivially copyable type are
+                copied into the ring as raw bytes, bypassing the serialize() routines
+                completely.  Note that this means the shared memory message format,
+                unlike the TCP one, is only meaningful between processes built for
+                the same architecture, and that both ends must use pipes holding the
+                same type.  Other than that, the bridge behaves identically to the
+                TCP version: the listening end accepts one connection at a time and
+                goes back to waiting for a new peer when the connection is dropped,
+                while the connecting end retries until the segment exists.  In
+                bridge_status objects produced by a shared memory bridge the
+                foreign_ip field is set to "shm://" followed by the segment name and
+                foreign_port is always 0.
         !*/
 
     public:
@@ -155,7 +204,8 @@ namespace dlib
         ); 
         /*!
             requires
-                - T is of type connect_to_ip_and_port or listen_on_port
+                - T is of type connect_to_ip_and_port, listen_on_port,
+                  connect_to_shared_memory, or listen_on_shared_memory
                 - U and V are of type bridge_transmit_decoration or bridge_receive_decoration,
                   however, U and V must be of different types (i.e. one is a receive type and 
                   another a transmit type).
@@ -173,7 +223,8 @@ namespace dlib
         ); 
         /*!
             requires
-                - T is of type connect_to_ip_and_port or listen_on_port
+                - T is of type connect_to_ip_and_port, listen_on_port,
+                  connect_to_shared_memory, or listen_on_shared_memory
                 - U is of type bridge_transmit_decoration or bridge_receive_decoration.
             ensures
                 - this object is properly initialized
@@ -336,6 +387,106 @@ namespace dlib
                   except that there is no transmit pipe.
         !*/
 
+
+
+        template < typename T, typename R >
+        void reconfigure (
+            listen_on_shared_memory network_parameters,
+            bridge_transmit_decoration<T> transmit_pipe,
+            bridge_receive_decoration<R> receive_pipe
+        ); 
+        /*!
+            ensures
+                - This object will create the shared memory segment named by
+                  network_parameters and begin waiting for another process to connect
+                  to it.  Any previous bridge state is cleared out.  Other than moving
+                  the data through shared memory rather than a TCP connection (see the
+                  SHARED MEMORY TRANSPORT discussion above), this behaves just like
+                  the listen_on_port version of reconfigure().
+            throws
+                - socket_error
+                  This exception is thrown if we are unable to create the shared
+                  memory segment.
+        !*/
+        template < typename T, typename R >
+        void reconfigure (
+            listen_on_shared_memory network_parameters,
+            bridge_receive_decoration<R> receive_pipe,
+            bridge_transmit_decoration<T> transmit_pipe
+        ); 
+        /*!
+            ensures
+                - performs reconfigure(network_parameters, transmit_pipe, receive_pipe)
+        !*/
+        template < typename T >
+        void reconfigure (
+            listen_on_shared_memory network_parameters,
+            bridge_transmit_decoration<T> transmit_pipe
+        );
+        /*!
+            ensures
+                - This function is identical to the above two reconfigure() functions 
+                  except that there is no receive pipe.
+        !*/
+        template < typename R >
+        void reconfigure (
+            listen_on_shared_memory network_parameters,
+            bridge_receive_decoration<R> receive_pipe
+        );
+        /*!
+            ensures
+                - This function is identical to the above three reconfigure() functions 
+                  except that there is no transmit pipe.
+        !*/
+
+
+
+        template <typename T, typename R>
+        void reconfigure (
+            connect_to_shared_memory network_parameters,
+            bridge_transmit_decoration<T> transmit_pipe,
+            bridge_receive_decoration<R> receive_pipe
+        ); 
+        /*!
+            ensures
+                - This object will begin attempting to connect to the shared memory
+                  segment named by network_parameters.  Any previous bridge state is
+                  cleared out.  Other than moving the data through shared memory
+                  rather than a TCP connection (see the SHARED MEMORY TRANSPORT
+                  discussion above), this behaves just like the connect_to_ip_and_port
+                  version of reconfigure().
+        !*/
+        template <typename T, typename R>
+        void reconfigure (
+            connect_to_shared_memory network_parameters,
+            bridge_receive_decoration<R> receive_pipe,
+            bridge_transmit_decoration<T> transmit_pipe
+        ); 
+        /*!
+            ensures
+                - performs reconfigure(network_parameters, transmit_pipe, receive_pipe)
+        !*/
+        template <typename T>
+        void reconfigure (
+            connect_to_shared_memory network_parameters,
+            bridge_transmit_decoration<T> transmit_pipe
+        );
+        /*!
+            ensures
+                - This function is identical to the above two reconfigure() functions 
+                  except that there is no receive pipe.
+        !*/
+        template <typename R>
+        void reconfigure (
+            connect_to_shared_memory network_parameters,
+            bridge_receive_decoration<R> receive_pipe
+        );
+        /*!
+            ensures
+                - This function is identical to the above three reconfigure() functions 
+                  except that there is no transmit pipe.
+        !*/
+
     };
 
 // ---------------------------------------------------------------------------------------- 
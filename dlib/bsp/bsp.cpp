@@ -208,6 +208,8 @@ namespace dlib
     close_all_connections_gracefully(
     )
     {
+        flush_pending_messages();
+
         if (node_id() != 0)
         {
             _cons.reset();
@@ -280,6 +282,8 @@ namespace dlib
                 throw dlib::socket_error(sout.str());
             }
         }
+
+        graceful_close_completed = true;
     }
 
 // ----------------------------------------------------------------------------------------
@@ -287,10 +291,16 @@ namespace dlib
     bsp_context::
     ~bsp_context()
     {
-        _cons.reset();
-        while (_cons.move_next())
+        // Leave the connections open if they belong to a persistent session and this
+        // job ended normally.  If the job didn't close gracefully then something threw
+        // and we have to shut the connections down anyway to unblock the read threads.
+        if (!keep_connections_alive || !graceful_close_completed)
         {
-            _cons.element().value()->con->shutdown();
+            _cons.reset();
+            while (_cons.move_next())
+            {
+                _cons.element().value()->con->shutdown();
+            }
         }
 
         msg_buffer.disable();
@@ -304,12 +314,18 @@ namespace dlib
     bsp_context::
     bsp_context(
         unsigned long node_id_,
-        impl1::map_id_to_con& cons_
+        impl1::map_id_to_con& cons_,
+        bool keep_connections_alive_
     ) :
         outstanding_messages(0),
         num_waiting_nodes(0),
         num_terminated_nodes(0),
         current_epoch(1),
+        batching_enabled(false),
+        graceful_close_completed(false),
+        keep_connections_alive(keep_connections_alive_),
+        pending_msgs(cons_.size()+1),
+        pending_counts(cons_.size()+1, 0),
         _cons(cons_),
         _node_id(node_id_)
     {
@@ -333,8 +349,13 @@ namespace dlib
     receive_data (
         std::shared_ptr<std::vector<char> >& item,
         unsigned long& sending_node_id
-    ) 
+    )
     {
+        // Any batched up sends have to go on the wire before we tell the control node
+        // we are waiting, otherwise it could decide the superstep is over while
+        // messages are still sitting in our local buffers.
+        flush_pending_messages();
+
         notify_control_node(impl2::IN_WAITING_STATE);
 
         while (true)
@@ -480,6 +501,21 @@ namespace dlib
         if (_cons[target_node_id]->terminated)
             throw socket_error("Attempt to send a message to a node that has terminated.");
 
+        if (batching_enabled)
+        {
+            // Just buffer the message locally.  It goes on the wire, along with any
+            // other messages for this destination, the next time
+            // flush_pending_messages() runs.  Note that the bytes we buffer are
+            // exactly what would have been written below, so receivers can't tell the
+            // difference between batched and unbatched senders.
+            vectorstream sout(pending_msgs[target_node_id]);
+            serialize(MESSAGE_HEADER, sout);
+            serialize(current_epoch, sout);
+            serialize(item, sout);
+            ++pending_counts[target_node_id];
+            return;
+        }
+
         serialize(MESSAGE_HEADER, _cons[target_node_id]->stream);
         serialize(current_epoch, _cons[target_node_id]->stream);
         serialize(item, _cons[target_node_id]->stream);
@@ -488,6 +524,103 @@ namespace dlib
         notify_control_node(SENT_MESSAGE);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void bsp_context::
+    flush_pending_messages(
+    )
+    {
+        unsigned long total = 0;
+        for (unsigned long i = 0; i < pending_msgs.size(); ++i)
+        {
+            if (pending_msgs[i].size() == 0)
+                continue;
+
+            _cons[i]->stream.write(&pending_msgs[i][0], pending_msgs[i].size());
+            _cons[i]->stream.flush();
+            pending_msgs[i].clear();
+
+            total += pending_counts[i];
+            pending_counts[i] = 0;
+        }
+
+        if (total == 0)
+            return;
+
+        // Now account for all the messages we just sent.  This is what
+        // notify_control_node(SENT_MESSAGE) does, except we coalesce all the
+        // notification bytes into a single flush.
+        if (node_id() == 0)
+        {
+            outstanding_messages += total;
+        }
+        else
+        {
+            for (unsigned long i = 0; i < total; ++i)
+                serialize(impl2::SENT_MESSAGE, _cons[0]->stream);
+            _cons[0]->stream.flush();
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+//                          IMPLEMENTATION OF bsp_session OBJECT MEMBERS
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+
+    bsp_session::
+    bsp_session (
+        const std::vector<network_address>& hosts
+    )
+    {
+        impl1::connect_all(cons, hosts, 0);
+        impl1::send_out_connection_orders(cons, hosts);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    bsp_session::
+    ~bsp_session (
+    )
+    {
+        // Tell the other nodes the session is over.  If a job failed then the sockets
+        // might already be dead, in which case the other nodes will see their
+        // connections drop, so it doesn't matter that we can't reach them.
+        try
+        {
+            cons.reset();
+            while (cons.move_next())
+            {
+                dlib::serialize(impl1::SESSION_TERMINATE, cons.element().value()->stream);
+                cons.element().value()->stream.flush();
+            }
+        }
+        catch (std::exception&)
+        {
+        }
+
+        cons.reset();
+        while (cons.move_next())
+        {
+            cons.element().value()->con->shutdown();
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void bsp_session::
+    prepare_for_next_job (
+    )
+    {
+        cons.reset();
+        while (cons.move_next())
+        {
+            dlib::serialize(impl1::SESSION_NEW_JOB, cons.element().value()->stream);
+            cons.element().value()->stream.flush();
+            cons.element().value()->terminated = false;
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
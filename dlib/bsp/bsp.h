@@ -5,8 +5,11 @@
 
 #include "bsp_abstract.h"
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <queue>
+#include <utility>
 #include <vector>
 
 #include "../sockets.h"
@@ -205,6 +208,15 @@ namespace dlib
             }
         }
 
+    // ------------------------------------------------------------------------------------
+
+        // These bytes are sent from the control node to the other nodes between the jobs
+        // of a persistent session to tell them if another job is coming or if the whole
+        // session is over.  They deliberately don't overlap with the per-message control
+        // bytes defined in impl2 inside bsp.cpp.
+        const char SESSION_NEW_JOB   = 8;
+        const char SESSION_TERMINATE = 9;
+
     // ------------------------------------------------------------------------------------
 
         struct msg_data
@@ -418,6 +430,19 @@ namespace dlib
         unsigned long number_of_nodes (
         ) const { return _cons.size()+1; }
 
+        void enable_message_batching (
+        ) { batching_enabled = true; }
+
+        void disable_message_batching (
+        )
+        {
+            flush_pending_messages();
+            batching_enabled = false;
+        }
+
+        bool message_batching_enabled (
+        ) const { return batching_enabled; }
+
         void receive (
         )
         {
@@ -486,7 +511,8 @@ namespace dlib
 
         bsp_context(
             unsigned long node_id_,
-            impl1::map_id_to_con& cons_
+            impl1::map_id_to_con& cons_,
+            bool keep_connections_alive_ = false
         );
 
         void close_all_connections_gracefully();
@@ -520,7 +546,22 @@ namespace dlib
                 - target_node_id < number_of_nodes()
                 - target_node_id != node_id()
             ensures
-                - sends a copy of item to the node with the given id.
+                - sends a copy of item to the node with the given id.  If message
+                  batching is enabled then the message might just be buffered locally.
+                  In that case it is put on the wire by the next call to
+                  flush_pending_messages().
+        !*/
+
+        void flush_pending_messages(
+        );
+        /*!
+            ensures
+                - any messages buffered by send_data() while message batching was
+                  enabled are written to their destination connections, one buffer
+                  flush per destination, and the control node is told about all of
+                  them.  This must happen before we tell the control node we are
+                  entering the waiting state, otherwise it could declare the superstep
+                  over while messages are still sitting in our buffers.
         !*/
 
 
@@ -530,6 +571,11 @@ namespace dlib
         unsigned long num_waiting_nodes;
         unsigned long num_terminated_nodes;
         dlib::uint64 current_epoch;
+        bool batching_enabled;
+        bool graceful_close_completed;
+        const bool keep_connections_alive;
+        std::vector<std::vector<char> > pending_msgs;
+        std::vector<unsigned long> pending_counts;
 
         impl1::thread_safe_message_queue msg_buffer;
 
@@ -599,6 +645,20 @@ namespace dlib
             ARG4 arg4
         );
 
+    // -----------------------------------
+
+        friend class bsp_session;
+
+        template <
+            typename funct_type,
+            typename ...Args
+            >
+        friend void bsp_listen_persistent (
+            unsigned short listening_port,
+            funct_type funct,
+            Args... args
+        );
+
     // -----------------------------------
 
         template <
@@ -1031,6 +1091,234 @@ namespace dlib
     }
 // ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+
+    class bsp_session : noncopyable
+    {
+        /*!
+            CONVENTION
+                - number_of_nodes() == cons.size()+1
+                - cons == the connections to all the hosts given to the constructor.
+                  They are established once, when the constructor runs, and stay open
+                  until this object is destructed.
+                - Whenever a job isn't running, the other nodes are sitting in
+                  bsp_listen_persistent() waiting for a SESSION_NEW_JOB or
+                  SESSION_TERMINATE byte from us.
+        !*/
+    public:
+
+        explicit bsp_session (
+            const std::vector<network_address>& hosts
+        );
+
+        ~bsp_session (
+        );
+
+        unsigned long number_of_nodes (
+        ) const { return cons.size()+1; }
+
+        template <
+            typename funct_type,
+            typename ...Args
+            >
+        void run (
+            funct_type funct,
+            Args... args
+        )
+        {
+            prepare_for_next_job();
+            bsp_context obj(0, cons, true);
+            funct(obj, args...);
+            obj.close_all_connections_gracefully();
+        }
+
+    private:
+
+        void prepare_for_next_job (
+        );
+        /*!
+            ensures
+                - tells all the other nodes that another job is starting and resets the
+                  termination flags on all the connections so the new job starts from a
+                  clean state.
+        !*/
+
+        impl1::map_id_to_con cons;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename funct_type,
+        typename ...Args
+        >
+    void bsp_listen_persistent (
+        unsigned short listening_port,
+        funct_type funct,
+        Args... args
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_CASSERT(listening_port != 0,
+            "\t void bsp_listen_persistent()"
+            << "\n\t Invalid arguments were given to this function."
+            );
+
+        impl1::map_id_to_con cons;
+        unsigned long node_id;
+        listen_and_connect_all(node_id, cons, listening_port, impl1::null_notify);
+
+        while (true)
+        {
+            // Wait for the control node to start the next job.  Note that no read
+            // threads exist while we sit between jobs (they all exit when a job's
+            // graceful close finishes), so we can read the session control byte
+            // directly off the stream.
+            char next_action;
+            dlib::deserialize(next_action, cons[0]->stream);
+            if (next_action == impl1::SESSION_TERMINATE)
+                break;
+            else if (next_action != impl1::SESSION_NEW_JOB)
+                throw socket_error("bsp_listen_persistent(): got an invalid control byte between jobs.");
+
+            cons.reset();
+            while (cons.move_next())
+                cons.element().value()->terminated = false;
+
+            bsp_context obj(node_id, cons, true);
+            funct(obj, args...);
+            obj.close_all_connections_gracefully();
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline void bsp_work_queue_master (
+        bsp_context& bsp,
+        long begin,
+        long end,
+        long min_chunk_size = 1
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_CASSERT(begin <= end && min_chunk_size >= 1,
+            "\t void bsp_work_queue_master()"
+            << "\n\t Invalid arguments were given to this function."
+            << "\n\t begin:          " << begin
+            << "\n\t end:            " << end
+            << "\n\t min_chunk_size: " << min_chunk_size
+            );
+
+        // Each worker's most recently reported processing rate in items per second,
+        // or -1 if the worker hasn't finished a chunk yet.
+        std::vector<double> rates(bsp.number_of_nodes(), -1);
+
+        unsigned long num_active = bsp.number_of_nodes()-1;
+        long next = begin;
+        while (num_active > 0)
+        {
+            // wait for a worker to ask for more work
+            double rate;
+            unsigned long sender;
+            bsp.receive(rate, sender);
+            if (rate > 0)
+                rates[sender] = rate;
+
+            const long remaining = end - next;
+            if (remaining <= 0)
+            {
+                // tell the worker there is nothing left
+                bsp.send(std::make_pair(end,end), sender);
+                --num_active;
+                continue;
+            }
+
+            // Guided self-scheduling: hand out a fraction of the remaining work so
+            // chunks shrink toward the end of the job and no single slow node can
+            // hold the last big chunk.  Once we have rate reports we scale each
+            // worker's share by its observed speed so fast nodes pull bigger chunks.
+            double share = 1.0/num_active;
+            double total_rate = 0;
+            bool have_all_rates = true;
+            for (unsigned long i = 1; i < rates.size(); ++i)
+            {
+                if (rates[i] > 0)
+                    total_rate += rates[i];
+                else
+                    have_all_rates = false;
+            }
+            if (have_all_rates && total_rate > 0)
+                share = rates[sender]/total_rate;
+
+            long chunk = static_cast<long>(remaining*share/4 + 0.5);
+            chunk = std::max(chunk, min_chunk_size);
+            chunk = std::min(chunk, remaining);
+
+            bsp.send(std::make_pair(next, next+chunk), sender);
+            next += chunk;
+        }
+
+        // Release all the workers at once.  They wait for this byte after draining
+        // the queue, which guarantees nothing a worker sends to us after
+        // bsp_work_queue_worker() returns can race with the rate report messages
+        // handled above.
+        const char queue_done = 1;
+        bsp.broadcast(queue_done);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename funct_type
+        >
+    void bsp_work_queue_worker (
+        bsp_context& bsp,
+        unsigned long master_node_id,
+        funct_type process_chunk
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_CASSERT(master_node_id < bsp.number_of_nodes() &&
+                     master_node_id != bsp.node_id(),
+            "\t void bsp_work_queue_worker()"
+            << "\n\t Invalid arguments were given to this function."
+            << "\n\t master_node_id:        " << master_node_id
+            << "\n\t bsp.node_id():         " << bsp.node_id()
+            << "\n\t bsp.number_of_nodes(): " << bsp.number_of_nodes()
+            );
+
+        double rate = 0;
+        while (true)
+        {
+            // ask the master for a chunk, reporting how fast we worked the last one
+            bsp.send(rate, master_node_id);
+            std::pair<long,long> chunk;
+            bsp.receive(chunk);
+            if (chunk.first == chunk.second)
+            {
+                // wait for the master to finish with every worker before returning
+                char queue_done;
+                bsp.receive(queue_done);
+                break;
+            }
+
+            const auto t1 = std::chrono::steady_clock::now();
+            process_chunk(chunk.first, chunk.second);
+            const auto t2 = std::chrono::steady_clock::now();
+
+            const double seconds = std::chrono::duration<double>(t2-t1).count();
+            const double new_rate = (chunk.second-chunk.first)/std::max(seconds, 1e-9);
+            // smooth the rate estimate a little so one noisy chunk doesn't swing
+            // the master's chunk sizing around.
+            if (rate > 0)
+                rate = 0.7*new_rate + 0.3*rate;
+            else
+                rate = new_rate;
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
 
 }
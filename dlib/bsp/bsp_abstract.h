@@ -102,13 +102,48 @@ namespace dlib
         !*/
 
         unsigned long number_of_nodes (
-        ) const; 
+        ) const;
         /*!
             ensures
                 - returns the number of processing nodes participating in the BSP
                   computation.
         !*/
 
+        void enable_message_batching (
+        );
+        /*!
+            ensures
+                - #message_batching_enabled() == true
+                - After this call, messages given to send() or broadcast() are buffered
+                  locally, one buffer per destination node, rather than immediately
+                  written to the network.  All the buffered messages for a destination
+                  go out together, in a single network flush, the next time this node
+                  calls one of the receive methods (or when it finishes its BSP
+                  computation).  This greatly reduces the per-packet overhead of jobs
+                  which send many small messages during a superstep.
+                - Batching doesn't change what messages are delivered or their relative
+                  order, only when they are put on the wire.  A program that is correct
+                  without batching is still correct with it since the buffers are
+                  always flushed before this node blocks waiting for messages.
+        !*/
+
+        void disable_message_batching (
+        );
+        /*!
+            ensures
+                - #message_batching_enabled() == false
+                - any currently buffered messages are immediately written to the
+                  network.
+        !*/
+
+        bool message_batching_enabled (
+        ) const;
+        /*!
+            ensures
+                - returns true if messages are being batched as described by
+                  enable_message_batching() and false otherwise.  The default is false.
+        !*/
+
         template <typename T>
         bool try_receive (
             T& item
@@ -903,6 +938,193 @@ namespace dlib
               bsp_connect().
     !*/
 
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+
+    class bsp_session : noncopyable
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object represents a persistent version of bsp_connect().  Each call
+                to bsp_connect() establishes TCP connections between all the processing
+                nodes, runs one BSP computation, and then tears the connections down.
+                For iterative workloads which run many BSP jobs over the same set of
+                hosts (e.g. a parameter sweep) that connection setup can dominate the
+                runtime.  A bsp_session instead connects the node mesh once, in its
+                constructor, and then lets you run any number of BSP jobs over those
+                same connections via run().  The other nodes must be executing
+                bsp_listen_persistent() rather than bsp_listen().
+
+                Note that if a job ends by an exception then the state of the
+                connections is unspecified and the session should be destructed rather
+                than used to run further jobs.
+        !*/
+
+    public:
+
+        explicit bsp_session (
+            const std::vector<network_address>& hosts
+        );
+        /*!
+            ensures
+                - Establishes connections to all the given hosts, which must be
+                  machines running the bsp_listen_persistent() routine, and organizes
+                  them into a node mesh of hosts.size()+1 processing nodes in exactly
+                  the way bsp_connect() does.  The local machine is the processing node
+                  with a node ID of 0.
+                - #number_of_nodes() == hosts.size()+1
+            throws
+                - dlib::socket_error
+                    This exception is thrown if we can't connect to all the hosts.
+        !*/
+
+        ~bsp_session (
+        );
+        /*!
+            ensures
+                - Tells all the other nodes that the session is over, causing their
+                  calls to bsp_listen_persistent() to return, and closes all the
+                  connections.
+        !*/
+
+        unsigned long number_of_nodes (
+        ) const;
+        /*!
+            ensures
+                - returns the number of processing nodes participating in BSP
+                  computations run on this session.
+        !*/
+
+        template <
+            typename funct_type,
+            typename ...Args
+            >
+        void run (
+            funct_type funct,
+            Args... args
+        );
+        /*!
+            requires
+                - let CONTEXT be an instance of a bsp_context object.  Then:
+                    - funct(CONTEXT,args...) must be a valid expression
+                      (i.e. funct must be a function or function object)
+            ensures
+                - Runs one BSP computation over the session's node mesh, just like
+                  bsp_connect(hosts,funct,args...) would, except that the connections
+                  established by this object's constructor are reused rather than
+                  created and torn down for the job.
+                - Each node taking part in the job executes the function it gave to
+                  bsp_listen_persistent(), so each call to run() corresponds to one
+                  iteration of the loop inside bsp_listen_persistent() on each host.
+                - This call blocks until the BSP computation has completed on all
+                  processing nodes.
+            throws
+                - dlib::socket_error
+                    This exception is thrown if there is an error which prevents the
+                    BSP job from executing.
+                - Any exception thrown by funct() will be propagated out of this call
+                  to run().
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename funct_type,
+        typename ...Args
+        >
+    void bsp_listen_persistent (
+        unsigned short listening_port,
+        funct_type funct,
+        Args... args
+    );
+    /*!
+        requires
+            - listening_port != 0
+            - let CONTEXT be an instance of a bsp_context object.  Then:
+                - funct(CONTEXT,args...) must be a valid expression
+                  (i.e. funct must be a function or function object)
+        ensures
+            - This function listens on TCP port listening_port for a connection from a
+              bsp_session and then participates in every BSP job run on that session.
+              That is, each time the session's run() routine is called, this node
+              executes funct(CONTEXT,args...), which is expected to carry out this
+              node's portion of that BSP computation.
+            - The connections established when the session starts are kept open and
+              reused for all the jobs.
+            - This call blocks until the bsp_session on the other end is destructed.
+        throws
+            - dlib::socket_error
+                This exception is thrown if there is an error which prevents a BSP
+                job from executing.
+            - Any exception thrown by funct() will be propagated out of this call to
+              bsp_listen_persistent().
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    void bsp_work_queue_master (
+        bsp_context& bsp,
+        long begin,
+        long end,
+        long min_chunk_size = 1
+    );
+    /*!
+        requires
+            - begin <= end
+            - min_chunk_size >= 1
+            - every node other than bsp.node_id() is executing
+              bsp_work_queue_worker() with master_node_id == bsp.node_id().
+        ensures
+            - Dynamically distributes the work items in the half open range
+              [begin,end) over the worker nodes.  Rather than a static partition,
+              workers pull chunks from this master as they finish, so fast nodes end
+              up processing more of the range and no one waits on the slowest node at
+              a barrier.
+            - Chunk sizes follow guided self-scheduling: each chunk is about a
+              quarter of a worker's fair share of the remaining work, so chunks
+              shrink as the job drains.  Once every worker has reported a processing
+              rate the shares are weighted by the observed rates, giving faster
+              nodes proportionally bigger chunks.  No chunk is smaller than
+              min_chunk_size items (except possibly the last one).
+            - Does not return until every worker has been told the queue is empty,
+              and no worker's call to bsp_work_queue_worker() returns before that
+              point.  So once this function returns the workers are free to send
+              unrelated messages (e.g. their results) without racing the queue
+              protocol.
+            - Every item in [begin,end) is handed out exactly once.
+        throws
+            - dlib::socket_error
+                This exception is thrown if there is an error which prevents the
+                work queue from executing.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename funct_type
+        >
+    void bsp_work_queue_worker (
+        bsp_context& bsp,
+        unsigned long master_node_id,
+        funct_type process_chunk
+    );
+    /*!
+        requires
+            - master_node_id < bsp.number_of_nodes()
+            - master_node_id != bsp.node_id()
+            - the node with id master_node_id is executing bsp_work_queue_master().
+            - process_chunk(begin, end) must be a valid expression for long values
+              begin < end (i.e. process_chunk must be a function or function object
+              taking the bounds of a half open chunk of work items).
+        ensures
+            - Repeatedly pulls chunks of work from the master node and calls
+              process_chunk(chunk_begin, chunk_end) on each until the master reports
+              that the queue is empty, then returns.
+            - Each chunk is timed and the resulting items/second rate is reported
+              back to the master, which uses it to size this node's next chunk.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
 
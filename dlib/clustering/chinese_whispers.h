@@ -5,8 +5,12 @@
 
 #include "chinese_whispers_abstract.h"
 #include <vector>
+#include <atomic>
 #include "../rand.h"
+#include "../flat_map.h"
+#include "../small_vector.h"
 #include "../graph_utils/edge_list_graphs.h"
+#include "../threads.h"
 
 namespace dlib
 {
@@ -39,13 +43,18 @@ namespace dlib
             labels[i] = i;
 
 
+        // Count how many times each label happens amongst a node's neighbors.  A
+        // neighborhood only ever contains a handful of distinct labels, so a sorted
+        // flat map with inline storage keeps this inner loop free of the tree node
+        // allocations a std::map would do on every iteration.
+        flat_map<unsigned long, double, std::less<unsigned long>,
+                 small_vector<std::pair<unsigned long,double>,16>> labels_to_counts;
         for (unsigned long iter = 0; iter < neighbors.size()*num_iterations; ++iter)
         {
             // Pick a random node.
             const unsigned long idx = rnd.get_random_64bit_number()%neighbors.size();
 
-            // Count how many times each label happens amongst our neighbors.
-            std::map<unsigned long, double> labels_to_counts;
+            labels_to_counts.clear();
             const unsigned long end = neighbors[idx].second;
             for (unsigned long i = neighbors[idx].first; i != end; ++i)
             {
@@ -53,10 +62,9 @@ namespace dlib
             }
 
             // find the most common label
-            std::map<unsigned long, double>::iterator i;
             double best_score = -std::numeric_limits<double>::infinity();
             unsigned long best_label = labels[idx];
-            for (i = labels_to_counts.begin(); i != labels_to_counts.end(); ++i)
+            for (auto i = labels_to_counts.begin(); i != labels_to_counts.end(); ++i)
             {
                 if (i->second > best_score)
                 {
@@ -87,6 +95,119 @@ namespace dlib
         return label_remap.size();
     }
 
+// ----------------------------------------------------------------------------------------
+
+    inline unsigned long chinese_whispers_threaded (
+        const std::vector<ordered_sample_pair>& edges,
+        std::vector<unsigned long>& labels,
+        const unsigned long num_iterations,
+        dlib::rand& rnd
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT(is_ordered_by_index(edges),
+                    "\t unsigned long chinese_whispers_threaded()"
+                    << "\n\t Invalid inputs were given to this function"
+        );
+
+        labels.clear();
+        if (edges.size() == 0)
+            return 0;
+
+        // Since the edges are sorted by index1(), find_neighbor_ranges() gives us a
+        // CSR style adjacency structure.  Each node's neighbors are a contiguous run
+        // of the edges array, so walking them is cache friendly.
+        std::vector<std::pair<unsigned long, unsigned long> > neighbors;
+        find_neighbor_ranges(edges, neighbors);
+
+        // Initialize the labels, each node gets a different label.  We use one atomic
+        // per node so worker threads can read their neighbors' labels while other
+        // workers are updating them.  All the accesses are relaxed since seeing a
+        // slightly stale label is harmless, it's no different than the serial
+        // algorithm visiting the nodes in some other order.
+        std::vector<std::atomic<unsigned long> > atomic_labels(neighbors.size());
+        for (unsigned long i = 0; i < atomic_labels.size(); ++i)
+            atomic_labels[i].store(i, std::memory_order_relaxed);
+
+        std::vector<unsigned long> order(neighbors.size());
+        for (unsigned long i = 0; i < order.size(); ++i)
+            order[i] = i;
+
+        for (unsigned long iter = 0; iter < num_iterations; ++iter)
+        {
+            // Randomize the order we visit the nodes in this pass.
+            for (unsigned long i = order.size(); i > 1; --i)
+                std::swap(order[i-1], order[rnd.get_random_64bit_number()%i]);
+
+            parallel_for_blocked(0, (long)order.size(), [&](long begin, long end)
+            {
+                // Accumulate neighbor label counts into a flat vector rather than a
+                // std::map.  The number of distinct labels among a node's neighbors
+                // is small, so a linear scan is faster than all the tree node
+                // allocations and pointer chasing a map would do, and the inline
+                // storage means each worker never touches the heap at all.
+                small_vector<std::pair<unsigned long, double>, 16> labels_to_counts;
+                for (long j = begin; j < end; ++j)
+                {
+                    const unsigned long idx = order[j];
+
+                    labels_to_counts.clear();
+                    const unsigned long stop = neighbors[idx].second;
+                    for (unsigned long i = neighbors[idx].first; i != stop; ++i)
+                    {
+                        const unsigned long label = atomic_labels[edges[i].index2()].load(std::memory_order_relaxed);
+                        unsigned long k = 0;
+                        for (; k < labels_to_counts.size(); ++k)
+                        {
+                            if (labels_to_counts[k].first == label)
+                            {
+                                labels_to_counts[k].second += edges[i].distance();
+                                break;
+                            }
+                        }
+                        if (k == labels_to_counts.size())
+                            labels_to_counts.push_back(std::make_pair(label, edges[i].distance()));
+                    }
+
+                    // find the most common label
+                    double best_score = -std::numeric_limits<double>::infinity();
+                    unsigned long best_label = atomic_labels[idx].load(std::memory_order_relaxed);
+                    for (unsigned long k = 0; k < labels_to_counts.size(); ++k)
+                    {
+                        if (labels_to_counts[k].second > best_score)
+                        {
+                            best_score = labels_to_counts[k].second;
+                            best_label = labels_to_counts[k].first;
+                        }
+                    }
+
+                    atomic_labels[idx].store(best_label, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        labels.resize(atomic_labels.size());
+        for (unsigned long i = 0; i < labels.size(); ++i)
+            labels[i] = atomic_labels[i].load(std::memory_order_relaxed);
+
+        // Remap the labels into a contiguous range.  First we find the
+        // mapping.
+        std::map<unsigned long,unsigned long> label_remap;
+        for (unsigned long i = 0; i < labels.size(); ++i)
+        {
+            const unsigned long next_id = label_remap.size();
+            if (label_remap.count(labels[i]) == 0)
+                label_remap[labels[i]] = next_id;
+        }
+        // now apply the mapping to all the labels.
+        for (unsigned long i = 0; i < labels.size(); ++i)
+        {
+            labels[i] = label_remap[labels[i]];
+        }
+
+        return label_remap.size();
+    }
+
 // ----------------------------------------------------------------------------------------
 
     inline unsigned long chinese_whispers (
@@ -127,6 +248,46 @@ namespace dlib
         return chinese_whispers(edges, labels, num_iterations, rnd);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    inline unsigned long chinese_whispers_threaded (
+        const std::vector<sample_pair>& edges,
+        std::vector<unsigned long>& labels,
+        const unsigned long num_iterations,
+        dlib::rand& rnd
+    )
+    {
+        std::vector<ordered_sample_pair> oedges;
+        convert_unordered_to_ordered(edges, oedges);
+        std::sort(oedges.begin(), oedges.end(), &order_by_index<ordered_sample_pair>);
+
+        return chinese_whispers_threaded(oedges, labels, num_iterations, rnd);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline unsigned long chinese_whispers_threaded (
+        const std::vector<sample_pair>& edges,
+        std::vector<unsigned long>& labels,
+        const unsigned long num_iterations = 100
+    )
+    {
+        dlib::rand rnd;
+        return chinese_whispers_threaded(edges, labels, num_iterations, rnd);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline unsigned long chinese_whispers_threaded (
+        const std::vector<ordered_sample_pair>& edges,
+        std::vector<unsigned long>& labels,
+        const unsigned long num_iterations = 100
+    )
+    {
+        dlib::rand rnd;
+        return chinese_whispers_threaded(edges, labels, num_iterations, rnd);
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
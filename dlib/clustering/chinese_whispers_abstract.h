@@ -89,6 +89,76 @@ namespace dlib
               where rnd is a default initialized dlib::rand object.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    unsigned long chinese_whispers_threaded (
+        const std::vector<ordered_sample_pair>& edges,
+        std::vector<unsigned long>& labels,
+        const unsigned long num_iterations,
+        dlib::rand& rnd
+    );
+    /*!
+        requires
+            - is_ordered_by_index(edges) == true
+        ensures
+            - This function is a multi-threaded version of the chinese_whispers()
+              routine defined at the top of this file.  It produces the same kind of
+              output and interprets its arguments the same way, but each pass over the
+              graph is split across the threads in dlib::default_thread_pool().  So on
+              large graphs (e.g. millions of edges) it runs much faster.
+            - Note that chinese whispers is a randomized algorithm, and moreover, the
+              threads read each other's label updates as they happen.  So while this
+              function finds the same clusters as the serial version it will not
+              generally produce bitwise identical label sequences, not even from run
+              to run.
+            - The algorithm performs exactly num_iterations passes over the graph
+              before terminating.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    unsigned long chinese_whispers_threaded (
+        const std::vector<sample_pair>& edges,
+        std::vector<unsigned long>& labels,
+        const unsigned long num_iterations,
+        dlib::rand& rnd
+    );
+    /*!
+        ensures
+            - This function is identical to the above chinese_whispers_threaded()
+              routine except that it operates on a vector of sample_pair objects
+              instead of ordered_sample_pairs.  Therefore, this is simply a
+              convenience routine.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    unsigned long chinese_whispers_threaded (
+        const std::vector<ordered_sample_pair>& edges,
+        std::vector<unsigned long>& labels,
+        const unsigned long num_iterations = 100
+    );
+    /*!
+        requires
+            - is_ordered_by_index(edges) == true
+        ensures
+            - performs: return chinese_whispers_threaded(edges, labels, num_iterations, rnd)
+              where rnd is a default initialized dlib::rand object.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    unsigned long chinese_whispers_threaded (
+        const std::vector<sample_pair>& edges,
+        std::vector<unsigned long>& labels,
+        const unsigned long num_iterations = 100
+    );
+    /*!
+        ensures
+            - performs: return chinese_whispers_threaded(edges, labels, num_iterations, rnd)
+              where rnd is a default initialized dlib::rand object.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -8,6 +8,7 @@
 #include "../graph_utils/edge_list_graphs.h"
 #include "../matrix.h"
 #include "../rand.h"
+#include "../threads.h"
 
 namespace dlib
 {
@@ -16,9 +17,108 @@ namespace dlib
 
     namespace impl
     {
+        struct newman_csr_graph
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is a compressed sparse row view of an edge list graph.  It
+                    exists because the power iteration inside newman_cluster_split()
+                    multiplies by the graph's adjacency matrix over and over, and
+                    iterating a CSR layout is much cheaper than walking a vector of
+                    ordered_sample_pair objects.  It also lets us split the matrix
+                    vector multiply across rows since each row's output is disjoint.
+
+                CONVENTION
+                    - row_offsets.size() == the number of nodes in the graph + 1
+                    - the values and column indices for the edges leaving node i are
+                      stored in values[j] and col_indices[j] for all j in the range
+                      [row_offsets[i], row_offsets[i+1]).
+            !*/
+
+            std::vector<unsigned long> row_offsets;
+            std::vector<unsigned long> col_indices;
+            std::vector<double> values;
+
+            void load (
+                const std::vector<ordered_sample_pair>& edges,
+                const unsigned long num_nodes
+            )
+            /*!
+                requires
+                    - max_index_plus_one(edges) <= num_nodes
+                    - edges must be sorted according to order_by_index()
+                ensures
+                    - #*this represents the same graph as edges.  Note that this
+                      function reuses whatever capacity the buffers in *this already
+                      have, so repeated calls don't reallocate unless the graph grows.
+            !*/
+            {
+                row_offsets.resize(num_nodes+1);
+                col_indices.resize(edges.size());
+                values.resize(edges.size());
+
+                // Since the edges are sorted by index1 we can fill in the CSR arrays
+                // with a single pass.
+                unsigned long cur_row = 0;
+                row_offsets[0] = 0;
+                for (unsigned long k = 0; k < edges.size(); ++k)
+                {
+                    while (cur_row < edges[k].index1())
+                        row_offsets[++cur_row] = k;
+                    col_indices[k] = edges[k].index2();
+                    values[k] = edges[k].distance();
+                }
+                while (cur_row < num_nodes)
+                    row_offsets[++cur_row] = edges.size();
+            }
+        };
+
+    // -------------------------------------------------------------------------------------
+
+        inline void newman_matrix_vector_multiply (
+            const newman_csr_graph& A,
+            const matrix<double,0,1>& v,
+            matrix<double,0,1>& result
+        )
+        /*!
+            requires
+                - v.size() == A.row_offsets.size()-1
+            ensures
+                - #result == A*v
+        !*/
+        {
+            const long num_rows = static_cast<long>(A.row_offsets.size())-1;
+            result.set_size(num_rows);
+
+            auto multiply_row = [&](long r)
+            {
+                double temp = 0;
+                for (unsigned long j = A.row_offsets[r]; j < A.row_offsets[r+1]; ++j)
+                    temp += A.values[j]*v(A.col_indices[j]);
+                result(r) = temp;
+            };
+
+            // Each row of the output is computed independently, so for big graphs we
+            // can hand blocks of rows to different threads.  For small graphs the
+            // threading overhead exceeds the cost of just doing the multiply, and the
+            // recursive splitting in newman_cluster_helper() produces a lot of small
+            // graphs, so those stay on the calling thread.
+            if (A.values.size() >= 200000)
+            {
+                parallel_for(0, num_rows, multiply_row);
+            }
+            else
+            {
+                for (long r = 0; r < num_rows; ++r)
+                    multiply_row(r);
+            }
+        }
+
+    // -------------------------------------------------------------------------------------
+
         inline double newman_cluster_split (
             dlib::rand& rnd,
-            const std::vector<ordered_sample_pair>& edges,
+            const newman_csr_graph& A,
             const matrix<double,0,1>& node_degrees, // k from the Newman paper
             const matrix<double,0,1>& Bdiag,        // diag(B) from the Newman paper
             const double& edge_sum,                 // m from the Newman paper
@@ -28,9 +128,8 @@ namespace dlib
         )
         /*!
             requires
-                - node_degrees.size() == max_index_plus_one(edges)
-                - Bdiag.size() == max_index_plus_one(edges)
-                - edges must be sorted according to order_by_index()
+                - node_degrees.size() == A.row_offsets.size()-1
+                - Bdiag.size() == A.row_offsets.size()-1
             ensures
                 - This routine splits a graph into two subgraphs using the Newman 
                   clustering method.  
@@ -62,9 +161,9 @@ namespace dlib
 
                 // any number larger than power_iter_eps
                 double iteration_change = power_iter_eps*2+1; 
-                for (unsigned long i = 0; i < max_iterations && iteration_change > power_iter_eps; ++i) 
+                for (unsigned long i = 0; i < max_iterations && iteration_change > power_iter_eps; ++i)
                 {
-                    sparse_matrix_vector_multiply(edges, labels, Bv);
+                    newman_matrix_vector_multiply(A, labels, Bv);
                     Bv -= dot(node_degrees, labels)/(2*edge_sum) * node_degrees;
 
                     if (offset != 0)
@@ -105,7 +204,7 @@ namespace dlib
 
 
             // compute B*labels, store result in Bv.
-            sparse_matrix_vector_multiply(edges, labels, Bv);
+            newman_matrix_vector_multiply(A, labels, Bv);
             Bv -= dot(node_degrees, labels)/(2*edge_sum) * node_degrees;
 
             // Do some label refinement.  In this step we swap labels if it
@@ -114,7 +213,6 @@ namespace dlib
             while(flipped_label)
             {
                 flipped_label = false;
-                unsigned long idx = 0;
                 for (long i = 0; i < labels.size(); ++i)
                 {
                     const double val = -2*labels(i);
@@ -124,24 +222,16 @@ namespace dlib
                     if (increase > 0)
                     {
                         labels(i) *= -1;
-                        while (idx < edges.size() && edges[idx].index1() == (unsigned long)i)
+                        for (unsigned long idx = A.row_offsets[i]; idx < A.row_offsets[i+1]; ++idx)
                         {
-                            const long j = edges[idx].index2();
-                            Bv(j) += val*edges[idx].distance();
-                            ++idx;
+                            const long j = A.col_indices[idx];
+                            Bv(j) += val*A.values[idx];
                         }
 
                         Bv -= (val*node_degrees(i)/(2*edge_sum))*node_degrees;
 
                         flipped_label = true;
                     }
-                    else
-                    {
-                        while (idx < edges.size() && edges[idx].index1() == (unsigned long)i)
-                        {
-                            ++idx;
-                        }
-                    }
                 }
             }
 
@@ -155,6 +245,7 @@ namespace dlib
 
         inline unsigned long newman_cluster_helper (
             dlib::rand& rnd,
+            newman_csr_graph& A,
             const std::vector<ordered_sample_pair>& edges,
             const matrix<double,0,1>& node_degrees, // k from the Newman paper
             const matrix<double,0,1>& Bdiag,        // diag(B) from the Newman paper
@@ -165,12 +256,19 @@ namespace dlib
             const unsigned long max_iterations
         )
         /*!
+            requires
+                - edges must be sorted according to order_by_index()
             ensures
                 - returns the number of clusters the data was split into
+                - A is used as scratch space.  Passing the same object down the
+                  recursion lets every level reuse its buffers instead of
+                  reallocating them.
         !*/
         {
+            A.load(edges, node_degrees.size());
+
             matrix<double,0,1> l;
-            const double modularity = newman_cluster_split(rnd,edges,node_degrees,Bdiag,edge_sum,l,eps,max_iterations);
+            const double modularity = newman_cluster_split(rnd,A,node_degrees,Bdiag,edge_sum,l,eps,max_iterations);
 
 
             // We need to collapse the node index values down to contiguous values.  So
@@ -239,7 +337,7 @@ namespace dlib
 
                 unsigned long num_left_clusters;
                 std::vector<unsigned long> left_labels;
-                num_left_clusters = newman_cluster_helper(rnd,split_edges,left_node_degrees,left_Bdiag,
+                num_left_clusters = newman_cluster_helper(rnd,A,split_edges,left_node_degrees,left_Bdiag,
                                                           edge_sum,left_labels,modularity_threshold,
                                                           eps, max_iterations);
 
@@ -262,7 +360,7 @@ namespace dlib
 
                 unsigned long num_right_clusters;
                 std::vector<unsigned long> right_labels;
-                num_right_clusters = newman_cluster_helper(rnd,split_edges,right_node_degrees,right_Bdiag,
+                num_right_clusters = newman_cluster_helper(rnd,A,split_edges,right_node_degrees,right_Bdiag,
                                                            edge_sum,right_labels,modularity_threshold,
                                                            eps, max_iterations);
 
@@ -332,7 +430,8 @@ namespace dlib
 
 
         dlib::rand rnd;
-        return impl::newman_cluster_helper(rnd,edges,node_degrees,Bdiag,edge_sum,labels,0,eps,max_iterations);
+        impl::newman_csr_graph A;
+        return impl::newman_cluster_helper(rnd,A,edges,node_degrees,Bdiag,edge_sum,labels,0,eps,max_iterations);
     }
 
 // ----------------------------------------------------------------------------------------
@@ -4,8 +4,11 @@
 #define DLIB_SPECTRAL_CLUSTEr_H_
 
 #include "spectral_cluster_abstract.h"
+#include <algorithm>
+#include <numeric>
 #include <vector>
 #include "../matrix.h"
+#include "../rand.h"
 #include "../svm/kkmeans.h"
 
 namespace dlib
@@ -74,6 +77,109 @@ namespace dlib
         return assignments;
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename kernel_type,
+        typename vector_type
+        >
+    std::vector<unsigned long> spectral_cluster (
+        const kernel_type& k,
+        const vector_type& samples,
+        const unsigned long num_clusters,
+        const unsigned long num_basis_samples
+    )
+    {
+        DLIB_CASSERT(num_clusters > 0 && num_basis_samples >= num_clusters,
+            "\t std::vector<unsigned long> spectral_cluster(k,samples,num_clusters,num_basis_samples)"
+            << "\n\t Invalid arguments were given to this function."
+            << "\n\t num_clusters:      " << num_clusters
+            << "\n\t num_basis_samples: " << num_basis_samples
+            );
+
+        const long n = samples.size();
+        // If we are allowed enough basis samples to represent everything exactly then
+        // there is no point in the approximation.
+        if ((long)num_basis_samples >= n)
+            return spectral_cluster(k, samples, num_clusters);
+
+        if (num_clusters == 1)
+        {
+            // nothing to do, just assign everything to the 0 cluster.
+            return std::vector<unsigned long>(samples.size(), 0);
+        }
+
+        const long m = num_basis_samples;
+
+        // Randomly select m landmark samples.  The seed is fixed so calling this
+        // function twice on the same data gives the same clustering.
+        dlib::rand rnd;
+        std::vector<long> idx(n);
+        std::iota(idx.begin(), idx.end(), 0);
+        for (long i = 0; i < m; ++i)
+            std::swap(idx[i], idx[i + rnd.get_random_32bit_number()%(n-i)]);
+        idx.resize(m);
+        std::sort(idx.begin(), idx.end());
+
+        // Compute the kernel matrix between all samples and the landmarks.  As in the
+        // exact version above, self similarities are zeroed.
+        matrix<double> C(n, m);
+        for (long r = 0; r < n; ++r)
+            for (long c = 0; c < m; ++c)
+                C(r,c) = (r == idx[c]) ? 0 : (double)k(samples[r], samples[idx[c]]);
+        const matrix<double> W = rowm(C, mat(idx));
+
+        // The Nystrom approximation of the similarity matrix is K ~= C*pinv(W)*trans(C).
+        // Get pinv(W) and pinv(sqrtm(W)) from W's eigendecomposition, dropping the tiny
+        // (or negative, since the diagonal was zeroed) eigenvalues the pseudo-inverse
+        // would blow up.
+        eigenvalue_decomposition<matrix<double> > eig(make_symmetric(W));
+        const matrix<double> V = eig.get_pseudo_v();
+        const matrix<double,0,1> eigs = eig.get_real_eigenvalues();
+        const double eps_thresh = max(abs(eigs))*std::numeric_limits<double>::epsilon()*m;
+        matrix<double,0,1> inv_eigs(m), inv_sqrt_eigs(m);
+        for (long i = 0; i < m; ++i)
+        {
+            inv_eigs(i) = (eigs(i) > eps_thresh) ? 1/eigs(i) : 0;
+            inv_sqrt_eigs(i) = (eigs(i) > eps_thresh) ? 1/std::sqrt(eigs(i)) : 0;
+        }
+
+        // Approximate each sample's degree, i.e. the row sums of the full similarity
+        // matrix, and normalize C the same way the exact version normalizes K.
+        matrix<double,0,1> D = C*(V*diagm(inv_eigs)*(trans(V)*(trans(C)*ones_matrix<double>(n,1))));
+        for (long i = 0; i < n; ++i)
+            D(i) = (D(i) > 0) ? 1/std::sqrt(D(i)) : 0;
+
+        // The top eigenvectors of diagm(D)*K*diagm(D) are the top left singular
+        // vectors of L since diagm(D)*K*diagm(D) ~= L*trans(L).
+        matrix<double> L = diagm(D)*C*V*diagm(inv_sqrt_eigs);
+        matrix<double> u,w,v;
+        svd_fast(L, u, w, v, std::min<unsigned long>(num_clusters+100, m), 5);
+        // Pick out the eigenvectors associated with the largest eigenvalues.
+        rsort_columns(u,w);
+        u = colm(u, range(0,num_clusters-1));
+        // Now build the normalized spectral vectors, one for each input vector.
+        std::vector<matrix<double,0,1> > spec_samps, centers;
+        for (long r = 0; r < u.nr(); ++r)
+        {
+            spec_samps.push_back(trans(rowm(u,r)));
+            const double len = length(spec_samps.back());
+            if (len != 0)
+                spec_samps.back() /= len;
+        }
+        // Finally do the K-means clustering
+        pick_initial_centers(num_clusters, centers, spec_samps);
+        find_clusters_using_kmeans(spec_samps, centers);
+        // And then compute the cluster assignments based on the output of K-means.
+        std::vector<unsigned long> assignments;
+        for (unsigned long i = 0; i < spec_samps.size(); ++i)
+            assignments.push_back(nearest_center(centers, spec_samps[i]));
+
+        return assignments;
+    }
+
+// ----------------------------------------------------------------------------------------
+
 }
 
 #endif // DLIB_SPECTRAL_CLUSTEr_H_
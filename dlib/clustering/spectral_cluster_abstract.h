@@ -36,6 +36,44 @@ namespace dlib
               k(samples[i],samples[j]).  This means that k() should output a number >= 0
               and the number should be larger for samples that are more similar.
     !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename kernel_type,
+        typename vector_type
+        >
+    std::vector<unsigned long> spectral_cluster (
+        const kernel_type& k,
+        const vector_type& samples,
+        const unsigned long num_clusters,
+        const unsigned long num_basis_samples
+    );
+    /*!
+        requires
+            - samples must be something with an interface compatible with std::vector.
+            - The following expression must evaluate to a double or float:
+                k(samples[i], samples[j])
+            - num_clusters > 0
+            - num_basis_samples >= num_clusters
+        ensures
+            - This function is identical to the above spectral_cluster() routine except
+              that it uses the Nystrom approximation of the kernel matrix instead of the
+              full matrix.  That is, num_basis_samples randomly selected samples serve
+              as landmarks, only the similarities between each sample and the landmarks
+              are computed, and the spectral embedding is recovered from that n x
+              num_basis_samples matrix with svd_fast().  So the runtime and memory use
+              scale with samples.size()*num_basis_samples rather than
+              samples.size()^2, making spectral clustering usable on very large
+              datasets.  Larger values of num_basis_samples give a more accurate
+              approximation of the exact clustering at greater computational cost.
+            - if (num_basis_samples >= samples.size()) then
+                - performs: return spectral_cluster(k, samples, num_clusters)
+                  (i.e. the exact algorithm is used since there is no reduction)
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
 }
 
 #endif // DLIB_SPECTRAL_CLUSTEr_ABSTRACT_H_
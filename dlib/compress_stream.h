@@ -54,6 +54,10 @@ namespace dlib
         typedef entropy_encoder_model<257,entropy_encoder::kernel_2a>::kernel_2d fce2d;
         typedef entropy_decoder_model<257,entropy_decoder::kernel_2a>::kernel_2d fcd2d;
 
+        // batched model update versions used by kernel_2b
+        typedef entropy_encoder_model<257,entropy_encoder::kernel_2a>::kernel_2e fce2e;
+        typedef entropy_decoder_model<257,entropy_decoder::kernel_2a>::kernel_2e fcd2e;
+
         typedef sliding_buffer<unsigned char>::kernel_1a sliding_buffer1;
         typedef lz77_buffer::kernel_2a lz77_buffer2a;
 
@@ -72,6 +76,12 @@ namespace dlib
         typedef entropy_encoder_model<32257,entropy_encoder::kernel_2a>::kernel_1b fce_index;
         typedef entropy_decoder_model<32257,entropy_decoder::kernel_2a>::kernel_1b fcd_index;
 
+        typedef entropy_encoder_model<513,entropy_encoder::kernel_2a>::kernel_1d fce_length_b;
+        typedef entropy_decoder_model<513,entropy_decoder::kernel_2a>::kernel_1d fcd_length_b;
+
+        typedef entropy_encoder_model<32257,entropy_encoder::kernel_2a>::kernel_1d fce_index_b;
+        typedef entropy_decoder_model<32257,entropy_decoder::kernel_2a>::kernel_1d fcd_index_b;
+
     public:
         
         //----------- kernels ---------------
@@ -111,10 +121,16 @@ namespace dlib
 
 
 
-        // kernel_2a        
+        // kernel_2a
         typedef      compress_stream_kernel_2 <fce2,fcd2,lz77_buffer2a,sliding_buffer1,fce_length,fcd_length,fce_index,fcd_index,crc32::kernel_1a>
                      kernel_2a;
 
+        // kernel_2b
+        // This is kernel_2a but with table-batched entropy model updates.  It
+        // compresses slightly worse but is a lot faster.
+        typedef      compress_stream_kernel_2 <fce2e,fcd2e,lz77_buffer2a,sliding_buffer1,fce_length_b,fcd_length_b,fce_index_b,fcd_index_b,crc32::kernel_1a>
+                     kernel_2b;
+
 
 
 
@@ -129,5 +145,7 @@ namespace dlib
     };
 }
 
+#include "compress_stream/compressed_serialization.h"
+
 #endif // DLIB_COMPRESS_STREAm_
 
@@ -7,7 +7,9 @@
 #include <iostream>
 #include <streambuf>
 #include <cstdio>
+#include <vector>
 #include "compress_stream_kernel_abstract.h"
+#include "../vectorstream.h"
 
 namespace dlib
 {
@@ -81,6 +83,16 @@ namespace dlib
             std::ostream& out
         ) const;
 
+        void compress (
+            const std::vector<char>& data,
+            std::vector<char>& compressed_data
+        ) const;
+
+        void decompress (
+            const std::vector<char>& compressed_data,
+            std::vector<char>& data
+        ) const;
+
     private:
 
         // restricted functions
@@ -244,6 +256,155 @@ namespace dlib
 
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename fce,
+        typename fcd,
+        typename crc32
+        >
+    void compress_stream_kernel_1<fce,fcd,crc32>::
+    compress (
+        const std::vector<char>& data,
+        std::vector<char>& compressed_data
+    ) const
+    {
+        compressed_data.clear();
+        vectorstream out(compressed_data);
+
+        typename fce::entropy_encoder_type coder;
+        coder.set_stream(out);
+
+        fce model(coder);
+
+        crc32 crc;
+
+        unsigned long count = 0;
+
+        // Note that this loop must produce exactly the same stream of calls to
+        // model and coder as the istream version of compress() above.  The only
+        // difference is that here we pull the input bytes straight out of the
+        // vector rather than going through a streambuf.
+        for (unsigned long i = 0; i < data.size(); ++i)
+        {
+            // write out a known value every 20000 symbols
+            if (count == 20000)
+            {
+                count = 0;
+                coder.encode(1500,1501,8000);
+            }
+            ++count;
+
+            const unsigned char symbol = static_cast<unsigned char>(data[i]);
+            model.encode(symbol);
+            crc.add(symbol);
+        }
+
+        // we have hit the end of the input so encode the marker symbol
+        if (count == 20000)
+        {
+            count = 0;
+            coder.encode(1500,1501,8000);
+        }
+        ++count;
+
+        model.encode(eof_symbol);
+
+        // now write the checksum
+        unsigned long checksum = crc.get_checksum();
+        unsigned char byte1 = static_cast<unsigned char>((checksum>>24)&0xFF);
+        unsigned char byte2 = static_cast<unsigned char>((checksum>>16)&0xFF);
+        unsigned char byte3 = static_cast<unsigned char>((checksum>>8)&0xFF);
+        unsigned char byte4 = static_cast<unsigned char>((checksum)&0xFF);
+
+        model.encode(byte1);
+        model.encode(byte2);
+        model.encode(byte3);
+        model.encode(byte4);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename fce,
+        typename fcd,
+        typename crc32
+        >
+    void compress_stream_kernel_1<fce,fcd,crc32>::
+    decompress (
+        const std::vector<char>& compressed_data,
+        std::vector<char>& data
+    ) const
+    {
+        data.clear();
+        // We have to copy the input since vectorstream needs a non-const vector
+        // to sit on top of.
+        std::vector<char> temp(compressed_data);
+        vectorstream in(temp);
+
+        typename fcd::entropy_decoder_type coder;
+        coder.set_stream(in);
+
+        fcd model(coder);
+
+        unsigned long symbol;
+        unsigned long count = 0;
+
+        crc32 crc;
+
+        // decode until we hit the marker symbol
+        while (true)
+        {
+            // make sure this is the value we expect
+            if (count == 20000)
+            {
+                if (coder.get_target(8000) != 1500)
+                {
+                    throw decompression_error("Error detected in compressed data stream.");
+                }
+                count = 0;
+                coder.decode(1500,1501);
+            }
+            ++count;
+
+            // decode the next symbol
+            model.decode(symbol);
+            if (symbol != eof_symbol)
+            {
+                crc.add(static_cast<unsigned char>(symbol));
+                data.push_back(static_cast<char>(symbol));
+                continue;
+            }
+            else
+            {
+                // we read eof from the encoded data.  now we just have to check the checksum and we are done.
+                unsigned char byte1;
+                unsigned char byte2;
+                unsigned char byte3;
+                unsigned char byte4;
+
+                model.decode(symbol); byte1 = static_cast<unsigned char>(symbol);
+                model.decode(symbol); byte2 = static_cast<unsigned char>(symbol);
+                model.decode(symbol); byte3 = static_cast<unsigned char>(symbol);
+                model.decode(symbol); byte4 = static_cast<unsigned char>(symbol);
+
+                unsigned long checksum = byte1;
+                checksum <<= 8;
+                checksum |= byte2;
+                checksum <<= 8;
+                checksum |= byte3;
+                checksum <<= 8;
+                checksum |= byte4;
+
+                if (checksum != crc.get_checksum())
+                    throw decompression_error("Error detected in compressed data stream.");
+
+                break;
+            }
+        } // while (true)
+
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
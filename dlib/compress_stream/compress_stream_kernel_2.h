@@ -6,7 +6,9 @@
 #include "../algs.h"
 #include <iostream>
 #include <streambuf>
+#include <vector>
 #include "compress_stream_kernel_abstract.h"
+#include "../vectorstream.h"
 
 namespace dlib
 {
@@ -111,6 +113,32 @@ namespace dlib
             std::ostream& out
         ) const;
 
+        void compress (
+            const std::vector<char>& data,
+            std::vector<char>& compressed_data
+        ) const
+        {
+            compressed_data.clear();
+            // We have to copy the input since vectorstream needs a non-const
+            // vector to sit on top of.
+            std::vector<char> temp(data);
+            vectorstream in(temp);
+            vectorstream out(compressed_data);
+            compress(in,out);
+        }
+
+        void decompress (
+            const std::vector<char>& compressed_data,
+            std::vector<char>& data
+        ) const
+        {
+            data.clear();
+            std::vector<char> temp(compressed_data);
+            vectorstream in(temp);
+            vectorstream out(data);
+            decompress(in,out);
+        }
+
     private:
 
         // restricted functions
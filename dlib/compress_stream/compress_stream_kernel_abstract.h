@@ -5,6 +5,7 @@
 
 #include "../algs.h"
 #include <iosfwd>
+#include <vector>
 
 namespace dlib
 {
@@ -76,7 +77,43 @@ namespace dlib
                     it from being correctly decompressed then this exception is 
                     thrown.  
                 - any other exception
-                    this exception may be thrown if there is any other problem                    
+                    this exception may be thrown if there is any other problem
+        !*/
+
+        void compress (
+            const std::vector<char>& data,
+            std::vector<char>& compressed_data
+        ) const;
+        /*!
+            ensures
+                - compresses all the data in the given data vector and stores the
+                  result in #compressed_data.  This produces exactly the same
+                  compressed bytes as the stream version of compress() but works
+                  entirely out of in-memory buffers.
+            throws
+                - std::bad_alloc
+                - any other exception
+                    this exception may be thrown if there is any other problem
+        !*/
+
+        void decompress (
+            const std::vector<char>& compressed_data,
+            std::vector<char>& data
+        ) const;
+        /*!
+            ensures
+                - decompresses the single block of compressed data contained in
+                  compressed_data and stores the result in #data.  Any bytes in
+                  compressed_data following the end of the compressed block are
+                  ignored.
+            throws
+                - std::bad_alloc
+                - decompression_error
+                    if an error was detected in the compressed data that prevented
+                    it from being correctly decompressed then this exception is
+                    thrown.
+                - any other exception
+                    this exception may be thrown if there is any other problem
         !*/
 
 
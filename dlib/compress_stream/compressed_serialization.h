@@ -0,0 +1,302 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_COMPRESSED_SERIALIZATIOn_H_
+#define DLIB_COMPRESSED_SERIALIZATIOn_H_
+
+#include "compressed_serialization_abstract.h"
+#include "../compress_stream.h"
+#include "../crc32.h"
+#include "../serialize.h"
+#include "../algs.h"
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        namespace compressed_serialization
+        {
+            typedef dlib::compress_stream::kernel_1ea compressor_type;
+
+            // The 8 byte header written at the front of every compressed serialization
+            // stream.  The trailing digit is a format version number.
+            const char magic[8] = {'D','C','S','E','R','L','Z','1'};
+
+        // ------------------------------------------------------------------------------------
+
+            class framing_streambuf : public std::streambuf
+            {
+                /*!
+                    INITIAL VALUE
+                        - buf.size() == chunk size given to the constructor
+                        - the put area covers all of buf
+
+                    WHAT THIS OBJECT REPRESENTS
+                        This object is an output streambuf which accumulates bytes into a
+                        fixed size buffer and, each time the buffer fills up, compresses
+                        its contents and writes them to the wrapped ostream as a single
+                        frame.  Each frame is laid out as:
+                            - the size of the compressed payload (via dlib::serialize)
+                            - the CRC-32 checksum of the compressed payload (via dlib::serialize)
+                            - the compressed payload bytes
+                        A frame with a payload size of 0 marks the end of the stream and
+                        is emitted by close().  Since each frame is self-contained a
+                        reader can decode frames as they arrive rather than waiting for
+                        the whole stream.
+                !*/
+            public:
+                framing_streambuf (
+                    std::ostream& out_,
+                    std::size_t chunk_size
+                ) :
+                    out(out_)
+                {
+                    buf.resize(chunk_size);
+                    setp(&buf[0], &buf[0] + buf.size());
+                }
+
+                void close (
+                )
+                {
+                    flush_frame();
+                    // write the end of stream marker
+                    serialize(static_cast<unsigned long>(0), out);
+                }
+
+            protected:
+
+                int_type overflow (
+                    int_type c
+                )
+                {
+                    flush_frame();
+                    if (c != traits_type::eof())
+                    {
+                        *pptr() = traits_type::to_char_type(c);
+                        pbump(1);
+                    }
+                    return traits_type::not_eof(c);
+                }
+
+                int sync (
+                )
+                {
+                    flush_frame();
+                    return 0;
+                }
+
+            private:
+
+                void flush_frame (
+                )
+                {
+                    const std::size_t num = static_cast<std::size_t>(pptr() - pbase());
+                    if (num == 0)
+                        return;
+
+                    std::istringstream sin(std::string(pbase(), num));
+                    std::ostringstream sout;
+                    compressor_type compressor;
+                    compressor.compress(sin, sout);
+
+                    const std::string& payload = sout.str();
+                    crc32 crc(payload);
+
+                    serialize(static_cast<unsigned long>(payload.size()), out);
+                    serialize(crc.get_checksum(), out);
+                    out.write(payload.data(), payload.size());
+                    if (!out)
+                        throw serialization_error("Error writing compressed frame to output stream.");
+
+                    setp(&buf[0], &buf[0] + buf.size());
+                }
+
+                std::ostream& out;
+                std::vector<char> buf;
+            };
+
+        // ------------------------------------------------------------------------------------
+
+            class deframing_streambuf : public std::streambuf
+            {
+                /*!
+                    INITIAL VALUE
+                        - reached_end == false
+                        - the get area is empty
+
+                    WHAT THIS OBJECT REPRESENTS
+                        This object is an input streambuf which reads frames written by
+                        framing_streambuf from the wrapped istream, one at a time as the
+                        caller consumes bytes.  Each frame's checksum is verified before
+                        it is decompressed, so corruption is detected on the frame where
+                        it occurs instead of at the end of the stream.
+                !*/
+            public:
+                deframing_streambuf (
+                    std::istream& in_
+                ) :
+                    in(in_),
+                    reached_end(false)
+                {
+                }
+
+                void drain (
+                )
+                /*!
+                    ensures
+                        - reads frames up to and including the end of stream marker so
+                          that the wrapped istream is left positioned just past this
+                          compressed stream.
+                !*/
+                {
+                    while (load_frame())
+                    {
+                        setg(0,0,0);
+                    }
+                }
+
+            protected:
+
+                int_type underflow (
+                )
+                {
+                    if (gptr() == egptr())
+                    {
+                        if (!load_frame())
+                            return traits_type::eof();
+                    }
+                    return traits_type::to_int_type(*gptr());
+                }
+
+            private:
+
+                bool load_frame (
+                )
+                {
+                    if (reached_end)
+                        return false;
+
+                    unsigned long payload_size;
+                    deserialize(payload_size, in);
+                    if (payload_size == 0)
+                    {
+                        reached_end = true;
+                        return false;
+                    }
+
+                    unsigned long expected_crc;
+                    deserialize(expected_crc, in);
+
+                    std::string payload(payload_size, '\0');
+                    in.read(&payload[0], payload_size);
+                    if (!in || static_cast<unsigned long>(in.gcount()) != payload_size)
+                        throw serialization_error("Unexpected end of stream while reading a compressed frame.");
+
+                    crc32 crc(payload);
+                    if (crc.get_checksum() != expected_crc)
+                        throw serialization_error("CRC mismatch in compressed frame, the stream is corrupt.");
+
+                    std::istringstream sin(payload);
+                    std::ostringstream sout;
+                    compressor_type compressor;
+                    try
+                    {
+                        compressor.decompress(sin, sout);
+                    }
+                    catch (compressor_type::decompression_error& e)
+                    {
+                        throw serialization_error(std::string("Error decompressing frame: ") + e.info);
+                    }
+
+                    buf = sout.str();
+                    setg(&buf[0], &buf[0], &buf[0] + buf.size());
+                    return buf.size() != 0 || load_frame();
+                }
+
+                std::istream& in;
+                bool reached_end;
+                std::string buf;
+            };
+
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    void serialize_compressed (
+        const T& item,
+        std::ostream& out,
+        std::size_t chunk_size = 1024*1024
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT(chunk_size > 0,
+            "\t void serialize_compressed()"
+            << "\n\t chunk_size must be greater than 0"
+            );
+
+        using namespace impl::compressed_serialization;
+        try
+        {
+            out.write(magic, sizeof(magic));
+            if (!out)
+                throw serialization_error("Error writing header to output stream.");
+
+            framing_streambuf framer(out, chunk_size);
+            std::ostream framed_out(&framer);
+            serialize(item, framed_out);
+            framer.close();
+        }
+        catch (serialization_error& e)
+        {
+            throw serialization_error(e.info + "\n   while performing serialize_compressed()");
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    void deserialize_compressed (
+        T& item,
+        std::istream& in
+    )
+    {
+        using namespace impl::compressed_serialization;
+        try
+        {
+            char header[sizeof(magic)];
+            in.read(header, sizeof(header));
+            if (!in || std::string(header, sizeof(header)) != std::string(magic, sizeof(magic)))
+                throw serialization_error("The stream does not contain compressed serialized data.");
+
+            deframing_streambuf deframer(in);
+            std::istream framed_in(&deframer);
+            deserialize(item, framed_in);
+            // Skip past any remaining frames and the end of stream marker so in is left
+            // positioned at whatever data follows this compressed stream.
+            deframer.drain();
+        }
+        catch (serialization_error& e)
+        {
+            throw serialization_error(e.info + "\n   while performing deserialize_compressed()");
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_COMPRESSED_SERIALIZATIOn_H_
+
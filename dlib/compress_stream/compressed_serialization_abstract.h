@@ -0,0 +1,76 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_COMPRESSED_SERIALIZATIOn_ABSTRACT_H_
+#ifdef DLIB_COMPRESSED_SERIALIZATIOn_ABSTRACT_H_
+
+#include "../serialize.h"
+#include <iosfwd>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    void serialize_compressed (
+        const T& item,
+        std::ostream& out,
+        std::size_t chunk_size = 1024*1024
+    );
+    /*!
+        requires
+            - T implements the dlib serialization protocol (i.e. serialize(item,out) is
+              a valid expression)
+            - chunk_size > 0
+        ensures
+            - Writes a compressed copy of the regular serialized form of item to out.
+              The serialized bytes are broken into chunks of at most chunk_size bytes
+              and each chunk is compressed with dlib::compress_stream and written as a
+              self-contained frame containing its size and a CRC-32 checksum of the
+              compressed payload.  No temporary file or full in-memory copy of the
+              compressed stream is made, so item can be arbitrarily large.
+            - The resulting stream can be read back with deserialize_compressed().
+              Since each frame carries its own checksum and can be decompressed on its
+              own, a reader can decode the stream incrementally, e.g. while it is still
+              arriving over a network connection.
+        throws
+            - serialization_error
+                This exception is thrown if there is some problem which prevents us
+                from successfully writing item to the output stream.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    void deserialize_compressed (
+        T& item,
+        std::istream& in
+    );
+    /*!
+        requires
+            - T implements the dlib serialization protocol (i.e. deserialize(item,in)
+              is a valid expression)
+        ensures
+            - Reads a stream previously written by serialize_compressed() from in and
+              stores the decoded object into item.  Frames are read and decompressed
+              one at a time as deserialization consumes bytes, so only one chunk is
+              held in memory at once.
+        throws
+            - serialization_error
+                This exception is thrown if there is some problem which prevents us
+                from successfully deserializing item from the input stream.  In
+                particular, this happens if the stream does not begin with the header
+                written by serialize_compressed(), if it is truncated, or if a frame's
+                checksum does not match its payload (i.e. the stream is corrupt).
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_COMPRESSED_SERIALIZATIOn_ABSTRACT_H_
+
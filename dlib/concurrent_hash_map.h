@@ -0,0 +1,40 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_CONCURRENT_HASH_MAp_
+#define DLIB_CONCURRENT_HASH_MAp_
+
+#include "concurrent_hash_map/concurrent_hash_map_kernel_1.h"
+
+#include "hash_map.h"
+#include "algs.h"
+#include <functional>
+
+namespace dlib
+{
+
+    template <
+        typename domain,
+        typename range,
+        unsigned long expnum,
+        typename mem_manager = default_memory_manager,
+        typename compare = std::less<domain>
+        >
+    class concurrent_hash_map
+    {
+        concurrent_hash_map() {}
+
+        typedef typename hash_map<domain,range,expnum,mem_manager,compare>::kernel_1a
+                shard_map_1;
+
+    public:
+
+        //----------- kernels ---------------
+
+        // kernel_1a
+        typedef     concurrent_hash_map_kernel_1<domain,range,shard_map_1,mem_manager>
+                    kernel_1a;
+
+    };
+}
+
+#endif // DLIB_CONCURRENT_HASH_MAp_
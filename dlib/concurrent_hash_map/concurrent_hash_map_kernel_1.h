@@ -0,0 +1,268 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_CONCURRENT_HASH_MAP_KERNEl_1_
+#define DLIB_CONCURRENT_HASH_MAP_KERNEl_1_
+
+#include "concurrent_hash_map_kernel_abstract.h"
+#include "../algs.h"
+#include "../general_hash/general_hash.h"
+#include "../threads.h"
+#include "../assert.h"
+#include "../serialize.h"
+
+namespace dlib
+{
+
+    template <
+        typename domain,
+        typename range,
+        typename shard_map,
+        typename mem_manager = default_memory_manager
+        >
+    class concurrent_hash_map_kernel_1
+    {
+
+        /*!
+            REQUIREMENTS ON shard_map
+                shard_map is instantiated with domain and range and
+                implements hash_map/hash_map_kernel_abstract.h
+
+            INITIAL VALUE
+                - for all valid i: shards[i].map.size() == 0
+
+            CONVENTION
+                - an element with key d is stored in shards[get_shard_idx(d)].map
+                - shards[i].m guards shards[i].map.  Readers take a read lock and
+                  writers take a write lock, so operations on elements that hash to
+                  different shards never contend with each other.
+                - get_shard_idx() uses the high bits of the hash while the shard maps
+                  bucket on the low bits, so sharding doesn't degrade the bucket
+                  distribution within each shard.
+        !*/
+
+
+        public:
+
+            typedef domain domain_type;
+            typedef range range_type;
+            typedef mem_manager mem_manager_type;
+
+            concurrent_hash_map_kernel_1(
+            )
+            {}
+
+            virtual ~concurrent_hash_map_kernel_1(
+            )
+            {}
+
+            void clear(
+            )
+            {
+                for (unsigned long i = 0; i < num_shards; ++i)
+                {
+                    auto_mutex lock(shards[i].m);
+                    shards[i].map.clear();
+                }
+            }
+
+            void add (
+                domain& d,
+                range& r
+            )
+            {
+                shard_type& s = shards[get_shard_idx(d)];
+                auto_mutex lock(s.m);
+                if (s.map.is_in_domain(d))
+                    s.map.destroy(d);
+                s.map.add(d,r);
+            }
+
+            bool is_in_domain (
+                const domain& d
+            ) const
+            {
+                const shard_type& s = shards[get_shard_idx(d)];
+                auto_mutex_readonly lock(s.m);
+                return s.map.is_in_domain(d);
+            }
+
+            bool try_get (
+                const domain& d,
+                range& r
+            ) const
+            {
+                const shard_type& s = shards[get_shard_idx(d)];
+                auto_mutex_readonly lock(s.m);
+                if (!s.map.is_in_domain(d))
+                    return false;
+                r = s.map[d];
+                return true;
+            }
+
+            bool remove (
+                const domain& d,
+                domain& d_copy,
+                range& r
+            )
+            {
+                shard_type& s = shards[get_shard_idx(d)];
+                auto_mutex lock(s.m);
+                if (!s.map.is_in_domain(d))
+                    return false;
+                s.map.remove(d,d_copy,r);
+                return true;
+            }
+
+            bool destroy (
+                const domain& d
+            )
+            {
+                shard_type& s = shards[get_shard_idx(d)];
+                auto_mutex lock(s.m);
+                if (!s.map.is_in_domain(d))
+                    return false;
+                s.map.destroy(d);
+                return true;
+            }
+
+            size_t size (
+            ) const
+            {
+                size_t num = 0;
+                for (unsigned long i = 0; i < num_shards; ++i)
+                {
+                    auto_mutex_readonly lock(shards[i].m);
+                    num += shards[i].map.size();
+                }
+                return num;
+            }
+
+            void swap (
+                concurrent_hash_map_kernel_1& item
+            )
+            {
+                for (unsigned long i = 0; i < num_shards; ++i)
+                    shards[i].map.swap(item.shards[i].map);
+            }
+
+            friend void serialize (
+                const concurrent_hash_map_kernel_1& item,
+                std::ostream& out
+            )
+            {
+                try
+                {
+                    // Take write locks on every shard so we serialize a consistent
+                    // snapshot.  Write locks rather than read locks because enumerating
+                    // a shard map mutates its enumerator state.
+                    for (unsigned long i = 0; i < num_shards; ++i)
+                        item.shards[i].m.lock();
+
+                    try
+                    {
+                        serialize(item.unlocked_size(), out);
+                        for (unsigned long i = 0; i < num_shards; ++i)
+                        {
+                            item.shards[i].map.reset();
+                            while (item.shards[i].map.move_next())
+                            {
+                                serialize(item.shards[i].map.element().key(), out);
+                                serialize(item.shards[i].map.element().value(), out);
+                            }
+                        }
+                    }
+                    catch (...)
+                    {
+                        for (unsigned long i = 0; i < num_shards; ++i)
+                            item.shards[i].m.unlock();
+                        throw;
+                    }
+                    for (unsigned long i = 0; i < num_shards; ++i)
+                        item.shards[i].m.unlock();
+                }
+                catch (serialization_error& e)
+                {
+                    throw serialization_error(e.info + "\n   while serializing object of type concurrent_hash_map_kernel_1");
+                }
+            }
+
+            friend void deserialize (
+                concurrent_hash_map_kernel_1& item,
+                std::istream& in
+            )
+            {
+                try
+                {
+                    item.clear();
+                    size_t size;
+                    deserialize(size,in);
+                    domain d;
+                    range r;
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        deserialize(d,in);
+                        deserialize(r,in);
+                        item.add(d,r);
+                    }
+                }
+                catch (serialization_error& e)
+                {
+                    item.clear();
+                    throw serialization_error(e.info + "\n   while deserializing object of type concurrent_hash_map_kernel_1");
+                }
+            }
+
+        private:
+
+            const static unsigned long num_shards = 32;
+
+            struct shard_type
+            {
+                mutable read_write_mutex m;
+                shard_map map;
+            };
+
+            unsigned long get_shard_idx (
+                const domain& d
+            ) const
+            {
+                // The shard maps bucket on the low bits of this same hash, so pick the
+                // shard with the high bits to keep the two choices independent.
+                return (hash(d) >> 27)%num_shards;
+            }
+
+            size_t unlocked_size (
+            ) const
+            {
+                size_t num = 0;
+                for (unsigned long i = 0; i < num_shards; ++i)
+                    num += shards[i].map.size();
+                return num;
+            }
+
+            // member data
+            general_hash<domain> hash;
+            shard_type shards[num_shards];
+
+            // restricted functions
+            concurrent_hash_map_kernel_1(concurrent_hash_map_kernel_1&);
+            concurrent_hash_map_kernel_1& operator= ( concurrent_hash_map_kernel_1&);
+
+    };
+
+    template <
+        typename domain,
+        typename range,
+        typename shard_map,
+        typename mem_manager
+        >
+    inline void swap (
+        concurrent_hash_map_kernel_1<domain,range,shard_map,mem_manager>& a,
+        concurrent_hash_map_kernel_1<domain,range,shard_map,mem_manager>& b
+    ) { a.swap(b); }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_CONCURRENT_HASH_MAP_KERNEl_1_
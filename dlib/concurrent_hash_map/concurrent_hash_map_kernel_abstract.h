@@ -0,0 +1,260 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_CONCURRENT_HASH_MAP_KERNEl_ABSTRACT_
+#ifdef DLIB_CONCURRENT_HASH_MAP_KERNEl_ABSTRACT_
+
+#include "../general_hash/general_hash.h"
+#include "../algs.h"
+#include "../serialize.h"
+
+namespace dlib
+{
+
+    template <
+        typename domain,
+        typename range,
+        typename shard_map,
+        typename mem_manager = default_memory_manager
+        >
+    class concurrent_hash_map_kernel_abstract
+    {
+
+        /*!
+            REQUIREMENTS ON domain
+                domain must be comparable by compare where compare is a functor compatible with std::less,
+                hashable by general_hash (general_hash is defined in dlib/general_hash) and
+                domain must be swappable by a global swap() and
+                domain must have a default constructor
+
+            REQUIREMENTS ON range
+                range must be swappable by a global swap(),
+                range must be copyable by operator= and
+                range must have a default constructor
+
+            REQUIREMENTS ON shard_map
+                shard_map is instantiated with domain and range and
+                implements hash_map/hash_map_kernel_abstract.h
+
+            REQUIREMENTS ON mem_manager
+                must be an implementation of memory_manager/memory_manager_kernel_abstract.h or
+                must be an implementation of memory_manager_global/memory_manager_global_kernel_abstract.h or
+                must be an implementation of memory_manager_stateless/memory_manager_stateless_kernel_abstract.h
+
+            THREAD SAFETY
+                Unlike the other containers in this library, this object is thread safe.
+                You may call any of its member functions from many threads at once without
+                serializing access yourself.  Internally, the elements are spread over a
+                fixed number of shards, each guarded by its own read_write_mutex, so
+                operations on elements that hash to different shards run concurrently and
+                lookups on the same shard share a read lock.  This makes it suitable for
+                read-mostly caches in multi-threaded pipelines, where a single mutex
+                around a regular map would serialize everything.
+
+                The exceptions are swap(), serialize(), and deserialize().  swap() and
+                deserialize() require that no other thread is touching either object
+                while they run.  serialize() may run concurrently with other operations
+                and writes a consistent snapshot of the map.
+
+            POINTERS AND REFERENCES TO INTERNAL DATA
+                No member function hands out pointers or references to the elements.  It
+                can't, since another thread could remove an element at any time.  This is
+                why lookups copy the mapped value out via try_get() rather than returning
+                a reference like hash_map's operator[] does, and it is also why this
+                object doesn't implement the enumerable interface.
+
+            WHAT THIS OBJECT REPRESENTS
+                concurrent_hash_map contains items of type domain and range.  It is a
+                thread safe mapping of unique items of domain onto items of range, i.e.
+                a striped/sharded version of hash_map.
+        !*/
+
+        public:
+
+            typedef domain domain_type;
+            typedef range range_type;
+            typedef mem_manager mem_manager_type;
+
+            concurrent_hash_map_kernel_abstract(
+            );
+            /*!
+                ensures
+                    - #*this is properly initialized
+                throws
+                    - std::bad_alloc or any exception thrown by domain's or range's
+                      constructor.
+            !*/
+
+            virtual ~concurrent_hash_map_kernel_abstract(
+            );
+            /*!
+                ensures
+                    - all memory associated with *this has been released
+            !*/
+
+            void clear(
+            );
+            /*!
+                ensures
+                    - #size() == 0 (with respect to elements present when clear() began;
+                      other threads may add new elements while clear() runs)
+                throws
+                    - std::bad_alloc or any exception thrown by domain's or range's
+                      constructor.
+                        if this exception is thrown then *this is unusable
+                        until clear() is called and succeeds
+            !*/
+
+            void add (
+                domain& d,
+                range& r
+            );
+            /*!
+                ensures
+                    - #is_in_domain(d) == true (until some thread removes it)
+                    - the map associates d with r, replacing any value d was previously
+                      associated with.  Note that unlike hash_map's add(), it is fine to
+                      add a key that is already in the map.  With concurrent writers
+                      there would be no way for a caller to guarantee otherwise.
+                    - #d and #r have initial values for their types (their values are
+                      consumed by swapping, just like the other containers in this
+                      library)
+                throws
+                    - std::bad_alloc or any exception thrown by domain's or range's
+                      constructor.
+                        if add() throws then it has no effect
+            !*/
+
+            bool is_in_domain (
+                const domain& d
+            ) const;
+            /*!
+                ensures
+                    - returns whether or not an element equivalent to d was in the map at
+                      some point during this call.  Of course, another thread may have
+                      added or removed it by the time the caller looks at the result.
+            !*/
+
+            bool try_get (
+                const domain& d,
+                range& r
+            ) const;
+            /*!
+                ensures
+                    - if (an element equivalent to d is in the map) then
+                        - #r == a copy of the value associated with d
+                        - returns true
+                    - else
+                        - #r is unchanged
+                        - returns false
+                throws
+                    - any exception thrown by range's operator=.
+                        if this exception is thrown then try_get() has no effect
+            !*/
+
+            bool remove (
+                const domain& d,
+                domain& d_copy,
+                range& r
+            );
+            /*!
+                requires
+                    - &d != &d_copy (i.e. d and d_copy cannot be the same variable)
+                ensures
+                    - if (an element equivalent to d was in the map) then
+                        - that element has been removed
+                        - #d_copy is equivalent to d
+                        - #r == the value the map associated with d
+                        - returns true
+                    - else
+                        - returns false
+                throws
+                    - any exception thrown by domain's or range's constructor.
+                        if this exception is thrown then remove() has no effect
+            !*/
+
+            bool destroy (
+                const domain& d
+            );
+            /*!
+                ensures
+                    - if (an element equivalent to d was in the map) then
+                        - that element has been removed
+                        - returns true
+                    - else
+                        - returns false
+                throws
+                    - any exception thrown by domain's or range's constructor.
+                        if this exception is thrown then destroy() has no effect
+            !*/
+
+            size_t size (
+            ) const;
+            /*!
+                ensures
+                    - returns the number of elements in the map.  With concurrent writers
+                      this is of course just a momentary snapshot.
+            !*/
+
+            void swap (
+                concurrent_hash_map_kernel_abstract& item
+            );
+            /*!
+                requires
+                    - no other thread is accessing *this or item
+                ensures
+                    - swaps *this and item
+            !*/
+
+    };
+
+    template <
+        typename domain,
+        typename range,
+        typename shard_map,
+        typename mem_manager
+        >
+    inline void swap (
+        concurrent_hash_map_kernel_abstract<domain,range,shard_map,mem_manager>& a,
+        concurrent_hash_map_kernel_abstract<domain,range,shard_map,mem_manager>& b
+    ) { a.swap(b); }
+    /*!
+        requires
+            - no other thread is accessing a or b
+        ensures
+            - swaps a and b
+    !*/
+
+    template <
+        typename domain,
+        typename range,
+        typename shard_map,
+        typename mem_manager
+        >
+    void serialize (
+        const concurrent_hash_map_kernel_abstract<domain,range,shard_map,mem_manager>& item,
+        std::ostream& out
+    );
+    /*!
+        provides serialization support.  It is safe to call while other threads are
+        using item; a consistent snapshot of the map is written.
+    !*/
+
+    template <
+        typename domain,
+        typename range,
+        typename shard_map,
+        typename mem_manager
+        >
+    void deserialize (
+        concurrent_hash_map_kernel_abstract<domain,range,shard_map,mem_manager>& item,
+        std::istream& in
+    );
+    /*!
+        requires
+            - no other thread is accessing item
+        provides deserialization support
+    !*/
+
+}
+
+#endif // DLIB_CONCURRENT_HASH_MAP_KERNEl_ABSTRACT_
@@ -7,6 +7,7 @@
 #include "conditioning_class/conditioning_class_kernel_2.h"
 #include "conditioning_class/conditioning_class_kernel_3.h"
 #include "conditioning_class/conditioning_class_kernel_4.h"
+#include "conditioning_class/conditioning_class_kernel_5.h"
 #include "conditioning_class/conditioning_class_kernel_c.h"
 
 
@@ -67,12 +68,29 @@ namespace dlib
         typedef      conditioning_class_kernel_c<kernel_4c>
                      kernel_4c_c;
 
-        // kernel_4d        
+        // kernel_4d
         typedef      conditioning_class_kernel_4<alphabet_size,10000000,mm>
                      kernel_4d;
         typedef      conditioning_class_kernel_c<kernel_4d>
                      kernel_4d_c;
 
+        // -------- kernel_5 ---------
+
+        // The update batch sizes scale with the alphabet so the O(alphabet_size)
+        // table rebuilds amortize to a constant cost per update.
+
+        // kernel_5a
+        typedef      conditioning_class_kernel_5<alphabet_size,16+alphabet_size/8>
+                     kernel_5a;
+        typedef      conditioning_class_kernel_c<kernel_5a>
+                     kernel_5a_c;
+
+        // kernel_5b
+        typedef      conditioning_class_kernel_5<alphabet_size,16+alphabet_size/2>
+                     kernel_5b;
+        typedef      conditioning_class_kernel_c<kernel_5b>
+                     kernel_5b_c;
+
     };
 }
 
@@ -0,0 +1,410 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_CONDITIONING_CLASS_KERNEl_5_
+#define DLIB_CONDITIONING_CLASS_KERNEl_5_
+
+#include "conditioning_class_kernel_abstract.h"
+#include "../assert.h"
+#include "../algs.h"
+
+namespace dlib
+{
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    class conditioning_class_kernel_5
+    {
+        /*!
+            REQUIREMENTS ON batch_size
+                0 < batch_size
+
+            INITIAL VALUE
+                total == 1
+                counts == pointer to an array of alphabet_size unsigned shorts
+                for all i except i == alphabet_size-1: counts[i] == 0
+                counts[alphabet_size-1] == 1
+                cum == pointer to an array of alphabet_size+1 unsigned shorts
+                for all i: cum[i] == sum of counts[0] though counts[i-1]
+                num_pending == 0
+
+            CONVENTION
+                get_total() == total
+                get_count(symbol) == counts[symbol]
+                cum[i] == sum of counts[0] though counts[i-1], so in particular
+                cum[0] == 0 and cum[alphabet_size] == total
+
+                pending_symbols[i],pending_amounts[i] for i < num_pending == the
+                increment_count() calls that haven't been folded into counts and
+                cum yet.
+
+                get_memory_usage() == global_state.memory_usage
+
+            NOTE
+                This is the table-batched version of the conditioning class.  It keeps
+                a cumulative frequency table so get_range() runs in constant time and
+                get_symbol() is a binary search rather than the linear scans the other
+                table based kernels do.  To pay for the table it doesn't apply
+                increment_count() updates right away.  Instead they are buffered and
+                folded into the visible counts, batch_size updates at a time.  So
+                unlike the other kernels, get_count() and get_total() lag the calls to
+                increment_count() by up to batch_size updates.  This is fine for the
+                entropy coder models since the encoding and decoding sides always see
+                identical (if slightly stale) statistics, but it does cost a small
+                amount of compression ratio in exchange for the speed.
+        !*/
+
+    public:
+
+        class global_state_type
+        {
+        public:
+            global_state_type () : memory_usage(0) {}
+        private:
+            unsigned long memory_usage;
+
+            friend class conditioning_class_kernel_5<alphabet_size,batch_size>;
+        };
+
+        conditioning_class_kernel_5 (
+            global_state_type& global_state_
+        );
+
+        ~conditioning_class_kernel_5 (
+        );
+
+        void clear(
+        );
+
+        bool increment_count (
+            unsigned long symbol,
+            unsigned short amount = 1
+        );
+
+        unsigned long get_count (
+            unsigned long symbol
+        ) const;
+
+        unsigned long get_total (
+        ) const;
+
+        unsigned long get_range (
+            unsigned long symbol,
+            unsigned long& low_count,
+            unsigned long& high_count,
+            unsigned long& total_count
+        ) const;
+
+        void get_symbol (
+            unsigned long target,
+            unsigned long& symbol,
+            unsigned long& low_count,
+            unsigned long& high_count
+        ) const;
+
+        unsigned long get_memory_usage (
+        ) const;
+
+        global_state_type& get_global_state (
+        );
+
+        static unsigned long get_alphabet_size (
+        );
+
+
+    private:
+
+        void apply_pending_updates (
+        );
+        /*!
+            ensures
+                - #num_pending == 0
+                - all the buffered updates have been added to counts and total,
+                  halving all the counts first whenever the total would have gone
+                  over 65535, just like conditioning_class_kernel_1 does.
+                - #cum == the cumulative counts for #counts
+        !*/
+
+        // restricted functions
+        conditioning_class_kernel_5(conditioning_class_kernel_5<alphabet_size,batch_size>&);        // copy constructor
+        conditioning_class_kernel_5& operator=(conditioning_class_kernel_5<alphabet_size,batch_size>&);    // assignment operator
+
+        // data members
+        unsigned short total;
+        unsigned short* counts;
+        unsigned short* cum;
+        unsigned long num_pending;
+        unsigned short pending_symbols[batch_size];
+        unsigned short pending_amounts[batch_size];
+        global_state_type& global_state;
+
+    };
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+    // member function definitions
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    conditioning_class_kernel_5<alphabet_size,batch_size>::
+    conditioning_class_kernel_5 (
+        global_state_type& global_state_
+    ) :
+        total(1),
+        counts(new unsigned short[alphabet_size]),
+        cum(new unsigned short[alphabet_size+1]),
+        num_pending(0),
+        global_state(global_state_)
+    {
+        COMPILE_TIME_ASSERT( 1 < alphabet_size && alphabet_size < 65536 );
+        COMPILE_TIME_ASSERT( 0 < batch_size );
+
+        for (unsigned long i = 0; i < alphabet_size-1; ++i)
+            counts[i] = 0;
+        counts[alphabet_size-1] = 1;
+
+        for (unsigned long i = 0; i < alphabet_size; ++i)
+            cum[i] = 0;
+        cum[alphabet_size] = 1;
+
+        // update memory usage
+        global_state.memory_usage += sizeof(unsigned short)*(2*alphabet_size+1) +
+                                     sizeof(conditioning_class_kernel_5);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    conditioning_class_kernel_5<alphabet_size,batch_size>::
+    ~conditioning_class_kernel_5 (
+    )
+    {
+        delete [] counts;
+        delete [] cum;
+        // update memory usage
+        global_state.memory_usage -= sizeof(unsigned short)*(2*alphabet_size+1) +
+                                     sizeof(conditioning_class_kernel_5);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    void conditioning_class_kernel_5<alphabet_size,batch_size>::
+    clear(
+    )
+    {
+        total = 1;
+        num_pending = 0;
+
+        for (unsigned long i = 0; i < alphabet_size-1; ++i)
+            counts[i] = 0;
+        counts[alphabet_size-1] = 1;
+
+        for (unsigned long i = 0; i < alphabet_size; ++i)
+            cum[i] = 0;
+        cum[alphabet_size] = 1;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    unsigned long conditioning_class_kernel_5<alphabet_size,batch_size>::
+    get_memory_usage(
+    ) const
+    {
+        return global_state.memory_usage;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    typename conditioning_class_kernel_5<alphabet_size,batch_size>::global_state_type& conditioning_class_kernel_5<alphabet_size,batch_size>::
+    get_global_state(
+    )
+    {
+        return global_state;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    bool conditioning_class_kernel_5<alphabet_size,batch_size>::
+    increment_count (
+        unsigned long symbol,
+        unsigned short amount
+    )
+    {
+        pending_symbols[num_pending] = static_cast<unsigned short>(symbol);
+        pending_amounts[num_pending] = amount;
+        ++num_pending;
+        if (num_pending == batch_size)
+            apply_pending_updates();
+        return true;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    void conditioning_class_kernel_5<alphabet_size,batch_size>::
+    apply_pending_updates (
+    )
+    {
+        for (unsigned long i = 0; i < num_pending; ++i)
+        {
+            const unsigned short amount = pending_amounts[i];
+
+            // if we are going over a total of 65535 then scale down all counts by 2
+            if (static_cast<unsigned long>(total)+static_cast<unsigned long>(amount) >= 65536)
+            {
+                total = 0;
+                for (unsigned long j = 0; j < alphabet_size; ++j)
+                {
+                    counts[j] >>= 1;
+                    total += counts[j];
+                }
+                // make sure it is at least one
+                if (counts[alphabet_size-1]==0)
+                {
+                    ++total;
+                    counts[alphabet_size-1] = 1;
+                }
+            }
+            counts[pending_symbols[i]] += amount;
+            total += amount;
+        }
+        num_pending = 0;
+
+        // rebuild the cumulative count table
+        unsigned short sum = 0;
+        for (unsigned long i = 0; i < alphabet_size; ++i)
+        {
+            cum[i] = sum;
+            sum += counts[i];
+        }
+        cum[alphabet_size] = sum;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    unsigned long conditioning_class_kernel_5<alphabet_size,batch_size>::
+    get_count (
+        unsigned long symbol
+    ) const
+    {
+        return counts[symbol];
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    unsigned long conditioning_class_kernel_5<alphabet_size,batch_size>::
+    get_alphabet_size (
+    )
+    {
+        return alphabet_size;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    unsigned long conditioning_class_kernel_5<alphabet_size,batch_size>::
+    get_total (
+    ) const
+    {
+        return total;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    unsigned long conditioning_class_kernel_5<alphabet_size,batch_size>::
+    get_range (
+        unsigned long symbol,
+        unsigned long& low_count,
+        unsigned long& high_count,
+        unsigned long& total_count
+    ) const
+    {
+        if (counts[symbol] == 0)
+            return 0;
+
+        low_count = cum[symbol];
+        high_count = cum[symbol+1];
+        total_count = total;
+        return counts[symbol];
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        unsigned long alphabet_size,
+        unsigned long batch_size
+        >
+    void conditioning_class_kernel_5<alphabet_size,batch_size>::
+    get_symbol (
+        unsigned long target,
+        unsigned long& symbol,
+        unsigned long& low_count,
+        unsigned long& high_count
+    ) const
+    {
+        // binary search for the largest symbol with cum[symbol] <= target.  Symbols
+        // with a count of zero have empty ranges so they can never be the result.
+        unsigned long low = 0;
+        unsigned long high = alphabet_size;
+        while (high - low > 1)
+        {
+            const unsigned long mid = (low+high)/2;
+            if (cum[mid] <= target)
+                low = mid;
+            else
+                high = mid;
+        }
+
+        symbol = low;
+        low_count = cum[low];
+        high_count = cum[low+1];
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_CONDITIONING_CLASS_KERNEl_5_
+
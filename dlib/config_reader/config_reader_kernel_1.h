@@ -144,6 +144,15 @@ namespace dlib
             const std::string& config_file
         );
 
+        void load_from_buffer (
+            const char* begin,
+            const char* end
+        );
+
+        void load_from_buffer (
+            const std::string& data
+        );
+
         bool is_key_defined (
             const std::string& key
         ) const;
@@ -222,6 +231,29 @@ namespace dlib
                 - config_reader_error
         !*/
 
+        static void parse_config_buffer (
+            config_reader_kernel_1& cr,
+            const char*& next,
+            const char* end,
+            unsigned long& line_number,
+            const bool top_of_recursion = true
+        );
+        /*!
+            requires
+                - [next, end) is a valid range of characters
+                - line_number == 1
+                - cr == *this
+                - top_of_recursion == true
+            ensures
+                - parses the characters in the range [next, end) and puts the result
+                  into cr.  This routine accepts exactly the same config file syntax
+                  as parse_config_file() but scans the buffer directly instead of
+                  going through a tokenizer, so it makes just one pass over the data
+                  and only allocates the final key and value strings.
+            throws
+                - config_reader_error
+        !*/
+
         map_string_string key_table;
         map_string_void block_table;
 
@@ -322,6 +354,48 @@ namespace dlib
         load_from(fin);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename map_string_string,
+        typename map_string_void,
+        typename tokenizer
+        >
+    void config_reader_kernel_1<map_string_string,map_string_void,tokenizer>::
+    load_from_buffer(
+        const char* begin,
+        const char* end
+    )
+    {
+        clear();
+
+        unsigned long line_number = 1;
+        try
+        {
+            parse_config_buffer(*this,begin,end,line_number);
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename map_string_string,
+        typename map_string_void,
+        typename tokenizer
+        >
+    void config_reader_kernel_1<map_string_string,map_string_void,tokenizer>::
+    load_from_buffer(
+        const std::string& data
+    )
+    {
+        load_from_buffer(data.data(), data.data()+data.size());
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -501,7 +575,178 @@ namespace dlib
                 seen_identifier = true;
                 identifier = token;
             }
-        } // while (true) 
+        } // while (true)
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename map_string_string,
+        typename map_string_void,
+        typename tokenizer
+        >
+    void config_reader_kernel_1<map_string_string,map_string_void,tokenizer>::
+    parse_config_buffer(
+        config_reader_kernel_1<map_string_string,map_string_void,tokenizer>& cr,
+        const char*& next,
+        const char* end,
+        unsigned long& line_number,
+        const bool top_of_recursion
+    )
+    {
+        bool in_comment = false;
+        bool seen_identifier = false;
+        std::string identifier;
+        while (true)
+        {
+            // hitting the end of the buffer is just like hitting END_OF_FILE in
+            // parse_config_file()
+            if (next == end)
+            {
+                if (top_of_recursion)
+                    break;
+                throw config_reader_error(line_number);
+            }
+
+            const char ch = *next;
+
+            // ignore white space
+            if (ch == ' ' || ch == '\t' || ch == '\r')
+            {
+                ++next;
+                continue;
+            }
+
+            // basically ignore end of lines
+            if (ch == '\n')
+            {
+                ++next;
+                ++line_number;
+                in_comment = false;
+                continue;
+            }
+
+            // we are in a comment still so ignore this
+            if (in_comment)
+            {
+                ++next;
+                continue;
+            }
+
+            // if this is the start of a comment
+            if (ch == '#')
+            {
+                ++next;
+                in_comment = true;
+                continue;
+            }
+
+            // if this is the case then we have just finished parsing a block so we
+            // should quit this function
+            if (ch == '}' && !top_of_recursion)
+            {
+                ++next;
+                break;
+            }
+
+            if (seen_identifier)
+            {
+                seen_identifier = false;
+                // the next character should be either a '=' or a '{'
+                if (ch != '=' && ch != '{')
+                    throw config_reader_error(line_number);
+
+                if (ch == '=')
+                {
+                    ++next;
+                    // first discard any leading white space
+                    while (next != end && (*next == ' ' || *next == '\t' || *next == '\r'))
+                        ++next;
+
+                    // The value runs until the end of the line or an unescaped '#'
+                    // or '}'.  Copy it over a run at a time rather than a character
+                    // at a time.
+                    std::string value;
+                    while (next != end && *next != '\n')
+                    {
+                        const char* run = next;
+                        while (next != end && *next != '\n' && *next != '\\' &&
+                               *next != '#' && *next != '}')
+                            ++next;
+                        value.append(run, next);
+
+                        if (next == end || *next == '\n' || *next == '#' || *next == '}')
+                            break;
+
+                        // *next is a '\\'.  It only escapes '#' and '}' characters.
+                        if (next+1 != end && (*(next+1) == '#' || *(next+1) == '}'))
+                        {
+                            value += *(next+1);
+                            next += 2;
+                        }
+                        else
+                        {
+                            value += '\\';
+                            ++next;
+                        }
+                    }
+
+                    // strip of any tailing white space from value
+                    std::string::size_type pos = value.find_last_not_of(" \t\r\n");
+                    if (pos == std::string::npos)
+                        value.clear();
+                    else
+                        value.erase(pos+1);
+
+                    // make sure this key isn't already in the key_table
+                    if (cr.key_table.is_in_domain(identifier))
+                        throw config_reader_error(line_number,true);
+
+                    // add this key/value pair to the key_table
+                    cr.key_table.add(identifier,value);
+
+                }
+                else  // when ch == '{'
+                {
+                    ++next;
+                    // make sure this identifier isn't already in the block_table
+                    if (cr.block_table.is_in_domain(identifier))
+                        throw config_reader_error(line_number,true);
+
+                    config_reader_kernel_1* new_cr = new config_reader_kernel_1;
+                    void* vtemp = new_cr;
+                    try { cr.block_table.add(identifier,vtemp); }
+                    catch (...) { delete new_cr; throw; }
+
+                    // now parse this block
+                    parse_config_buffer(*new_cr,next,end,line_number,false);
+                }
+            }
+            else
+            {
+                // the next thing should be an identifier but if it isn't this is an
+                // error.  Identifiers are the same ones load_from() configures the
+                // tokenizer with: a letter followed by letters, numbers, or "_-."
+                // characters.
+                if (!(('a' <= ch && ch <= 'z') || ('A' <= ch && ch <= 'Z')))
+                    throw config_reader_error(line_number);
+
+                const char* start = next;
+                ++next;
+                while (next != end)
+                {
+                    const char c = *next;
+                    if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') ||
+                        ('0' <= c && c <= '9') || c == '_' || c == '-' || c == '.')
+                        ++next;
+                    else
+                        break;
+                }
+
+                seen_identifier = true;
+                identifier.assign(start, next);
+            }
+        } // while (true)
     }
 
 // ----------------------------------------------------------------------------------------
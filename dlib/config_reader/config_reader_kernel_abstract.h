@@ -262,6 +262,40 @@ namespace dlib
                     revert to its initial value.
         !*/
 
+        void load_from_buffer (
+            const char* begin,
+            const char* end
+        );
+        /*!
+            requires
+                - [begin, end) is a valid range of characters
+            ensures
+                - parses the config file contained in the character range [begin, end).
+                  This is identical to calling load_from() with a stream containing
+                  those characters except that the parse is done in a single pass
+                  directly over the buffer.  So it is much faster for large config
+                  files since no tokenizer or intermediate token strings are involved.
+                - before the load is performed, the previous state of the config file
+                  reader is erased.  So after the load the config file reader will contain
+                  only information from the given config file.
+                - This object will represent the top most block of the config file.
+            throws
+                - std::bad_alloc
+                    If this exception is thrown then *this is unusable
+                    until clear() is called and succeeds
+                - config_reader_error
+                    If this exception is thrown then this object will
+                    revert to its initial value.
+        !*/
+
+        void load_from_buffer (
+            const std::string& data
+        );
+        /*!
+            ensures
+                - performs: load_from_buffer(data.data(), data.data()+data.size())
+        !*/
+
         bool is_key_defined (
             const std::string& key_name
         ) const;
@@ -258,8 +258,10 @@ namespace dlib
             M[0] = A*initial_state + C;
             for (unsigned long i = 1; i < horizon; ++i)
                 M[i] = A*M[i-1] + C;
+            // Q and R are diagonal so apply them with pointwise multiplies rather than
+            // forming diagm() matrices, which would cost O(S^2) per time step.
             for (unsigned long i = 0; i < horizon; ++i)
-                M[i] = diagm(Q)*(M[i]-target[i]);
+                M[i] = pointwise_multiply(Q, M[i]-target[i]);
             for (long i = (long)horizon-2; i >= 0; --i)
                 M[i] += trans(A)*M[i+1];
             for (unsigned long i = 0; i < horizon; ++i)
@@ -276,11 +278,11 @@ namespace dlib
                 for (unsigned long i = 1; i < horizon; ++i)
                     M[i] = A*M[i-1] + B*controls[i];
                 for (unsigned long i = 0; i < horizon; ++i)
-                    M[i] = diagm(Q)*M[i];
+                    M[i] = pointwise_multiply(Q, M[i]);
                 for (long i = (long)horizon-2; i >= 0; --i)
                     M[i] += trans(A)*M[i+1];
                 for (unsigned long i = 0; i < horizon; ++i)
-                    df[i] = MM[i] + trans(B)*M[i] + diagm(R)*controls[i];
+                    df[i] = MM[i] + trans(B)*M[i] + pointwise_multiply(R, controls[i]);
 
 
 
@@ -94,6 +94,20 @@ namespace dlib
                   concatenated with item.
         !*/
 
+        void add (
+            const char* data,
+            unsigned long num
+        );
+        /*!
+            requires
+                - data == a pointer to num bytes
+            ensures
+                - #get_checksum() == The checksum of all items added to *this previously
+                  concatenated with the num bytes pointed to by data.
+                - This is the fastest way to checksum a large block of memory.  It
+                  processes many bytes per step rather than working a byte at a time.
+        !*/
+
         unsigned long get_checksum (
         ) const;
         /*!
@@ -9,6 +9,8 @@
 #include "tensor_tools.h"
 #include "../image_transforms/interpolation.h"
 #include "../threads.h"
+#include "../simd.h"
+#include <cstdint>
 
 namespace dlib
 {
@@ -1671,6 +1673,402 @@ namespace dlib
             }
         }
 
+    // ------------------------------------------------------------------------------------
+
+        void extract_image_chips (
+            tensor& chips,
+            const tensor& img,
+            const tensor& tforms
+        )
+        {
+            DLIB_CASSERT(is_same_object(chips, img)==false);
+            DLIB_CASSERT(img.num_samples() == 1);
+            DLIB_CASSERT(chips.k() == img.k());
+            DLIB_CASSERT(tforms.num_samples() == chips.num_samples());
+            DLIB_CASSERT(tforms.size() == static_cast<size_t>(chips.num_samples())*6);
+
+            if (chips.size() == 0)
+                return;
+
+            const float* const s = img.host();
+            const float* const t = tforms.host();
+            float* const d = chips.host();
+            const long snr = img.nr();
+            const long snc = img.nc();
+
+            parallel_for(0, chips.num_samples(), [&](long n)
+            {
+                const float* const tform = t + n*6;
+                for (long k = 0; k < chips.k(); ++k)
+                {
+                    const float* const schan = s + k*snr*snc;
+                    float* dptr = d + (n*chips.k() + k)*chips.nr()*chips.nc();
+                    for (long r = 0; r < chips.nr(); ++r)
+                    {
+                        for (long c = 0; c < chips.nc(); ++c)
+                        {
+                            const float x = tform[0]*c + tform[1]*r + tform[2];
+                            const float y = tform[3]*c + tform[4]*r + tform[5];
+
+                            float val = 0;
+                            if (0 <= x && x <= snc-1 && 0 <= y && y <= snr-1)
+                            {
+                                const long left = static_cast<long>(std::floor(x));
+                                const long top  = static_cast<long>(std::floor(y));
+                                const long right  = std::min(left+1, snc-1);
+                                const long bottom = std::min(top+1, snr-1);
+                                const float lr_frac = x - left;
+                                const float tb_frac = y - top;
+
+                                const float tl = schan[top*snc+left];
+                                const float tr = schan[top*snc+right];
+                                const float bl = schan[bottom*snc+left];
+                                const float br = schan[bottom*snc+right];
+
+                                val = (1-tb_frac)*((1-lr_frac)*tl + lr_frac*tr) +
+                                         tb_frac *((1-lr_frac)*bl + lr_frac*br);
+                            }
+                            *dptr++ = val;
+                        }
+                    }
+                }
+            });
+        }
+
+    // ------------------------------------------------------------------------------------
+
+        void disturb_colors (
+            tensor& img,
+            const tensor& params,
+            float gamma_magnitude,
+            float color_magnitude
+        )
+        {
+            DLIB_CASSERT(params.size() == static_cast<size_t>(img.num_samples())*(img.k()+1));
+            DLIB_CASSERT(gamma_magnitude >= 0);
+            DLIB_CASSERT(0 <= color_magnitude && color_magnitude < 1);
+
+            if (img.size() == 0)
+                return;
+
+            const float* const p = params.host();
+            float* const d = img.host();
+            const size_t chan_size = img.nr()*img.nc();
+
+            parallel_for(0, img.num_samples(), [&](long n)
+            {
+                const float* const pn = p + n*(img.k()+1);
+                const float gamma = std::max(0.0f, 1 + gamma_magnitude*(pn[0]-0.5f));
+
+                // pick a random scale for each channel, normalized so the largest
+                // scale is 1.  This matches what dlib::random_color_transform does to
+                // rgb images.
+                float max_scale = 0;
+                for (long k = 0; k < img.k(); ++k)
+                    max_scale = std::max(max_scale, 1 - pn[1+k]*color_magnitude);
+
+                for (long k = 0; k < img.k(); ++k)
+                {
+                    const float scale = (1 - pn[1+k]*color_magnitude)/(255*max_scale);
+                    float* v = d + (n*img.k() + k)*chan_size;
+                    for (size_t i = 0; i < chan_size; ++i)
+                    {
+                        const float val = std::min(std::max(v[i], 0.0f), 255.0f);
+                        v[i] = 255*std::pow(val*scale, gamma);
+                    }
+                }
+            });
+        }
+
+    // ------------------------------------------------------------------------------------
+
+        void flip_images_left_right (
+            tensor& img,
+            const tensor& params,
+            float probability
+        )
+        {
+            DLIB_CASSERT(params.size() == static_cast<size_t>(img.num_samples()));
+            DLIB_CASSERT(0 <= probability && probability <= 1);
+
+            if (img.size() == 0)
+                return;
+
+            const float* const p = params.host();
+            float* const d = img.host();
+            const long nr = img.nr();
+            const long nc = img.nc();
+
+            parallel_for(0, img.num_samples(), [&](long n)
+            {
+                if (p[n] >= probability)
+                    return;
+
+                for (long k = 0; k < img.k(); ++k)
+                {
+                    float* plane = d + (n*img.k() + k)*nr*nc;
+                    for (long r = 0; r < nr; ++r)
+                    {
+                        float* row = plane + r*nc;
+                        for (long c = 0; c < nc/2; ++c)
+                            std::swap(row[c], row[nc-1-c]);
+                    }
+                }
+            });
+        }
+
+    // ------------------------------------------------------------------------------------
+
+        void crop_images (
+            tensor& dest,
+            const tensor& src,
+            const tensor& params,
+            float min_scale
+        )
+        {
+            DLIB_CASSERT(is_same_object(dest, src)==false);
+            DLIB_CASSERT(dest.num_samples() == src.num_samples());
+            DLIB_CASSERT(dest.k() == src.k());
+            DLIB_CASSERT(params.size() == static_cast<size_t>(src.num_samples())*3);
+            DLIB_CASSERT(0 < min_scale && min_scale <= 1);
+
+            if (dest.size() == 0)
+                return;
+
+            const float* const p = params.host();
+            const float* const s = src.host();
+            float* const d = dest.host();
+            const long snr = src.nr();
+            const long snc = src.nc();
+
+            parallel_for(0, dest.num_samples(), [&](long n)
+            {
+                const float* const pn = p + n*3;
+                const float scale = min_scale + pn[0]*(1-min_scale);
+                const float h = scale*snr;
+                const float w = scale*snc;
+                const float y0 = pn[1]*(snr-h);
+                const float x0 = pn[2]*(snc-w);
+                const float y_scale = dest.nr() > 1 ? (h-1)/(dest.nr()-1) : 0;
+                const float x_scale = dest.nc() > 1 ? (w-1)/(dest.nc()-1) : 0;
+
+                for (long k = 0; k < dest.k(); ++k)
+                {
+                    const float* const schan = s + (n*src.k() + k)*snr*snc;
+                    float* dptr = d + (n*dest.k() + k)*dest.nr()*dest.nc();
+                    for (long r = 0; r < dest.nr(); ++r)
+                    {
+                        const float y = std::min(std::max(y0 + r*y_scale, 0.0f), (float)(snr-1));
+                        const long top = static_cast<long>(std::floor(y));
+                        const long bottom = std::min(top+1, snr-1);
+                        const float tb_frac = y - top;
+                        for (long c = 0; c < dest.nc(); ++c)
+                        {
+                            const float x = std::min(std::max(x0 + c*x_scale, 0.0f), (float)(snc-1));
+                            const long left = static_cast<long>(std::floor(x));
+                            const long right = std::min(left+1, snc-1);
+                            const float lr_frac = x - left;
+
+                            const float tl = schan[top*snc+left];
+                            const float tr = schan[top*snc+right];
+                            const float bl = schan[bottom*snc+left];
+                            const float br = schan[bottom*snc+right];
+
+                            *dptr++ = (1-tb_frac)*((1-lr_frac)*tl + lr_frac*tr) +
+                                         tb_frac *((1-lr_frac)*bl + lr_frac*br);
+                        }
+                    }
+                }
+            });
+        }
+
+    // ------------------------------------------------------------------------------------
+
+        void find_greater_than (
+            std::vector<std::pair<size_t,float>>& idxs_and_vals,
+            const tensor& t,
+            size_t begin,
+            size_t end,
+            float thresh
+        )
+        {
+            DLIB_CASSERT(begin <= end && end <= t.size());
+
+            idxs_and_vals.clear();
+            const float* const d = t.host();
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (d[i] > thresh)
+                    idxs_and_vals.emplace_back(i, d[i]);
+            }
+        }
+
+    // ------------------------------------------------------------------------------------
+
+        void gather (
+            std::vector<float>& vals,
+            const tensor& t,
+            const std::vector<size_t>& idxs
+        )
+        {
+#ifdef ENABLE_ASSERTS
+            for (auto idx : idxs)
+                DLIB_ASSERT(idx < t.size());
+#endif
+
+            const float* const d = t.host();
+            vals.resize(idxs.size());
+            for (size_t i = 0; i < idxs.size(); ++i)
+                vals[i] = d[idxs[i]];
+        }
+
+    // ------------------------------------------------------------------------------------
+
+        namespace
+        {
+            // Flatten a 4D tensor around the axis being reduced.  outer counts the
+            // dimensions before the axis, mid is the axis itself, and inner counts
+            // the dimensions after it, so src element (o,m,i) lives at linear index
+            // (o*mid + m)*inner + i.
+            void axis_extents (
+                const tensor& dest,
+                const tensor& src,
+                long axis,
+                size_t& outer,
+                size_t& mid,
+                size_t& inner
+            )
+            {
+                DLIB_CASSERT(0 <= axis && axis <= 3);
+                DLIB_CASSERT(is_same_object(dest, src) == false);
+                const long sdims[4] = {src.num_samples(), src.k(), src.nr(), src.nc()};
+                const long ddims[4] = {dest.num_samples(), dest.k(), dest.nr(), dest.nc()};
+                outer = 1;
+                inner = 1;
+                for (long i = 0; i < 4; ++i)
+                {
+                    DLIB_CASSERT(ddims[i] == (i == axis ? 1 : sdims[i]),
+                        "dest must have the same dimensions as src except the reduced axis must be 1."
+                        << "\n\t axis: " << axis
+                        << "\n\t i:    " << i);
+                    if (i < axis)
+                        outer *= sdims[i];
+                    else if (i > axis)
+                        inner *= sdims[i];
+                }
+                mid = sdims[axis];
+            }
+        }
+
+        void sum_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        )
+        {
+            size_t outer, mid, inner;
+            axis_extents(dest, src, axis, outer, mid, inner);
+
+            const float* const s = src.host();
+            float* d = dest.host_write_only();
+            for (size_t o = 0; o < outer; ++o)
+            {
+                for (size_t i = 0; i < inner; ++i)
+                {
+                    const float* p = s + o*mid*inner + i;
+                    float acc = 0;
+                    for (size_t m = 0; m < mid; ++m, p += inner)
+                        acc += *p;
+                    d[o*inner + i] = acc;
+                }
+            }
+        }
+
+        void mean_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        )
+        {
+            size_t outer, mid, inner;
+            axis_extents(dest, src, axis, outer, mid, inner);
+
+            const float scale = 1.0f/mid;
+            const float* const s = src.host();
+            float* d = dest.host_write_only();
+            for (size_t o = 0; o < outer; ++o)
+            {
+                for (size_t i = 0; i < inner; ++i)
+                {
+                    const float* p = s + o*mid*inner + i;
+                    float acc = 0;
+                    for (size_t m = 0; m < mid; ++m, p += inner)
+                        acc += *p;
+                    d[o*inner + i] = acc*scale;
+                }
+            }
+        }
+
+        void max_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        )
+        {
+            size_t outer, mid, inner;
+            axis_extents(dest, src, axis, outer, mid, inner);
+
+            const float* const s = src.host();
+            float* d = dest.host_write_only();
+            for (size_t o = 0; o < outer; ++o)
+            {
+                for (size_t i = 0; i < inner; ++i)
+                {
+                    const float* p = s + o*mid*inner + i;
+                    float best = *p;
+                    for (size_t m = 1; m < mid; ++m)
+                    {
+                        p += inner;
+                        if (*p > best)
+                            best = *p;
+                    }
+                    d[o*inner + i] = best;
+                }
+            }
+        }
+
+        void argmax_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        )
+        {
+            size_t outer, mid, inner;
+            axis_extents(dest, src, axis, outer, mid, inner);
+
+            const float* const s = src.host();
+            float* d = dest.host_write_only();
+            for (size_t o = 0; o < outer; ++o)
+            {
+                for (size_t i = 0; i < inner; ++i)
+                {
+                    const float* p = s + o*mid*inner + i;
+                    float best = *p;
+                    size_t best_idx = 0;
+                    for (size_t m = 1; m < mid; ++m)
+                    {
+                        p += inner;
+                        if (*p > best)
+                        {
+                            best = *p;
+                            best_idx = m;
+                        }
+                    }
+                    d[o*inner + i] = best_idx;
+                }
+            }
+        }
+
     // ------------------------------------------------------------------------------------
     // ------------------------------------------------------------------------------------
     // ------------------------------------------------------------------------------------
@@ -2009,6 +2407,458 @@ namespace dlib
             }
         }
 
+        namespace
+        {
+            /*
+                The Winograd F(2x2,3x3) algorithm computes each 2x2 output tile of a
+                3x3 stride 1 convolution from a 4x4 input tile using 16 multiplies
+                where the direct method needs 36, a 2.25x arithmetic reduction.  The
+                scheme is the standard one from "Fast Algorithms for Convolutional
+                Neural Networks" by Lavin and Gray: transform the filters once with
+                G*g*G', transform each input tile with B'*d*B, multiply pointwise,
+                and map back with A'*m*A.  Summing over input channels commutes with
+                the transforms, so the channel sums become 16 independent KxCxP
+                matrix multiplies (P = number of tiles), which we hand to the same
+                matrix code the im2col path uses.
+            */
+
+            void winograd3x3_transform_filters (
+                const tensor& filters,
+                std::vector<matrix<float> >& U
+            )
+            {
+                const long K = filters.num_samples();
+                const long C = filters.k();
+                U.resize(16);
+                for (auto& u : U)
+                    u.set_size(K,C);
+
+                const float* g = filters.host();
+                for (long k = 0; k < K; ++k)
+                {
+                    for (long c = 0; c < C; ++c)
+                    {
+                        const float* g9 = g + (k*C + c)*9;
+                        // q = G*g  (4x3)
+                        float q[4][3];
+                        for (int j = 0; j < 3; ++j)
+                        {
+                            q[0][j] = g9[j];
+                            q[1][j] = 0.5f*(g9[j] + g9[3+j] + g9[6+j]);
+                            q[2][j] = 0.5f*(g9[j] - g9[3+j] + g9[6+j]);
+                            q[3][j] = g9[6+j];
+                        }
+                        // u = q*G'  (4x4)
+                        for (int i = 0; i < 4; ++i)
+                        {
+                            U[i*4+0](k,c) = q[i][0];
+                            U[i*4+1](k,c) = 0.5f*(q[i][0] + q[i][1] + q[i][2]);
+                            U[i*4+2](k,c) = 0.5f*(q[i][0] - q[i][1] + q[i][2]);
+                            U[i*4+3](k,c) = q[i][2];
+                        }
+                    }
+                }
+            }
+
+            void conv_winograd3x3 (
+                const bool add_to_output,
+                tensor& output,
+                const tensor& data,
+                const tensor& filters,
+                long padding_y,
+                long padding_x,
+                const float* biases // nullptr if there is no fused bias add
+            )
+            {
+                const long C = data.k();
+                const long K = filters.num_samples();
+                const long nr = data.nr();
+                const long nc = data.nc();
+                const long out_nr = output.nr();
+                const long out_nc = output.nc();
+                const long tiles_r = (out_nr+1)/2;
+                const long tiles_c = (out_nc+1)/2;
+                const long P = tiles_r*tiles_c;
+
+                std::vector<matrix<float> > U;
+                winograd3x3_transform_filters(filters, U);
+
+                // The transformed filters U are shared read-only state, but everything
+                // else is per-sample, so the samples are processed in parallel with
+                // each worker keeping its own transform scratch buffers.
+                data.host();
+                output.host();
+                parallel_for_blocked(0, data.num_samples(), [&](long nbegin, long nend)
+                {
+                std::vector<matrix<float> > V(16), M(16);
+                for (auto& v : V)
+                    v.set_size(C,P);
+
+                for (long n = nbegin; n < nend; ++n)
+                {
+                    const float* din = data.host() + n*C*nr*nc;
+
+                    // transform the input tiles: V[xi](c,p) = (B'*d*B)[xi]
+                    for (long c = 0; c < C; ++c)
+                    {
+                        const float* dc = din + c*nr*nc;
+                        long p = 0;
+                        for (long tr = 0; tr < tiles_r; ++tr)
+                        {
+                            for (long tc = 0; tc < tiles_c; ++tc, ++p)
+                            {
+                                const long top = 2*tr - padding_y;
+                                const long left = 2*tc - padding_x;
+                                float d[4][4];
+                                if (0 <= top && top+4 <= nr && 0 <= left && left+4 <= nc)
+                                {
+                                    for (int y = 0; y < 4; ++y)
+                                        for (int x = 0; x < 4; ++x)
+                                            d[y][x] = dc[(top+y)*nc + left+x];
+                                }
+                                else
+                                {
+                                    // tile overlaps the zero padded border
+                                    for (int y = 0; y < 4; ++y)
+                                    {
+                                        const long yy = top+y;
+                                        for (int x = 0; x < 4; ++x)
+                                        {
+                                            const long xx = left+x;
+                                            if (0 <= yy && yy < nr && 0 <= xx && xx < nc)
+                                                d[y][x] = dc[yy*nc + xx];
+                                            else
+                                                d[y][x] = 0;
+                                        }
+                                    }
+                                }
+
+                                // t = B'*d
+                                float t[4][4];
+                                for (int j = 0; j < 4; ++j)
+                                {
+                                    t[0][j] = d[0][j] - d[2][j];
+                                    t[1][j] = d[1][j] + d[2][j];
+                                    t[2][j] = d[2][j] - d[1][j];
+                                    t[3][j] = d[1][j] - d[3][j];
+                                }
+                                // v = t*B
+                                for (int i = 0; i < 4; ++i)
+                                {
+                                    V[i*4+0](c,p) = t[i][0] - t[i][2];
+                                    V[i*4+1](c,p) = t[i][1] + t[i][2];
+                                    V[i*4+2](c,p) = t[i][2] - t[i][1];
+                                    V[i*4+3](c,p) = t[i][1] - t[i][3];
+                                }
+                            }
+                        }
+                    }
+
+                    // the channel sums: 16 GEMMs, one per transform element
+                    for (int xi = 0; xi < 16; ++xi)
+                        M[xi] = U[xi]*V[xi];
+
+                    // inverse transform each tile back into the output
+                    float* out = output.host() + n*K*out_nr*out_nc;
+                    for (long k = 0; k < K; ++k)
+                    {
+                        const float bias = biases ? biases[k] : 0;
+                        float* ok = out + k*out_nr*out_nc;
+                        long p = 0;
+                        for (long tr = 0; tr < tiles_r; ++tr)
+                        {
+                            for (long tc = 0; tc < tiles_c; ++tc, ++p)
+                            {
+                                // t = A'*m
+                                float t[2][4];
+                                for (int j = 0; j < 4; ++j)
+                                {
+                                    const float m0 = M[0*4+j](k,p);
+                                    const float m1 = M[1*4+j](k,p);
+                                    const float m2 = M[2*4+j](k,p);
+                                    const float m3 = M[3*4+j](k,p);
+                                    t[0][j] = m0 + m1 + m2;
+                                    t[1][j] = m1 - m2 - m3;
+                                }
+                                // y = t*A
+                                float y[2][2];
+                                for (int i = 0; i < 2; ++i)
+                                {
+                                    y[i][0] = t[i][0] + t[i][1] + t[i][2];
+                                    y[i][1] = t[i][1] - t[i][2] - t[i][3];
+                                }
+
+                                // the last row/column of tiles can hang off the edge
+                                // of the output when its size is odd.
+                                const long r = 2*tr;
+                                const long c = 2*tc;
+                                for (int i = 0; i < 2; ++i)
+                                {
+                                    if (r+i >= out_nr)
+                                        break;
+                                    for (int j = 0; j < 2; ++j)
+                                    {
+                                        if (c+j >= out_nc)
+                                            break;
+                                        if (add_to_output)
+                                            ok[(r+i)*out_nc + c+j] += y[i][j] + bias;
+                                        else
+                                            ok[(r+i)*out_nc + c+j] = y[i][j] + bias;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+                });
+            }
+        }
+
+        namespace
+        {
+            /*
+                The int8 convolution path does dynamic symmetric quantization: each
+                filter gets its own scale (max|w|/127) computed from the float
+                weights, and each input sample gets one scale (max|x|/127) computed
+                on the fly.  The quantized input bytes are stored with a +128 offset
+                so they fit in unsigned chars, which the integer dot product kernels
+                like, and the offset is removed afterwards with the precomputed sum
+                of each quantized filter since
+                    dot(xq+128, wq) == dot(xq, wq) + 128*sum(wq).
+                The accumulation is exact integer math, so the only error relative
+                to the float path is the quantization of the operands themselves.
+            */
+
+            inline int32_t dot_u8s8 (
+                const unsigned char* a,
+                const int8_t* b,
+                long n
+            )
+            {
+                long i = 0;
+                int32_t acc = 0;
+#ifdef DLIB_HAVE_AVX2
+                __m256i acc8 = _mm256_setzero_si256();
+                for (; i+16 <= n; i += 16)
+                {
+                    // widen both operands to int16 and use the 16 bit multiply-add.
+                    // The products fit int16 (255*127) and the sums accumulate in
+                    // int32, so nothing can saturate.
+                    const __m256i av = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(a+i)));
+                    const __m256i bv = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(b+i)));
+                    acc8 = _mm256_add_epi32(acc8, _mm256_madd_epi16(av,bv));
+                }
+                int32_t lanes[8];
+                _mm256_storeu_si256((__m256i*)lanes, acc8);
+                acc = lanes[0]+lanes[1]+lanes[2]+lanes[3]+lanes[4]+lanes[5]+lanes[6]+lanes[7];
+#endif
+                for (; i < n; ++i)
+                    acc += (int32_t)a[i]*(int32_t)b[i];
+                return acc;
+            }
+
+            inline int8_t quantize_value (
+                float val,
+                float inv_scale
+            )
+            {
+                const long q = std::lround(val*inv_scale);
+                return (int8_t)std::max<long>(-127, std::min<long>(127, q));
+            }
+
+            void img2col_u8 (
+                matrix<unsigned char>& output,
+                const tensor& data,
+                long n,
+                long filter_nr,
+                long filter_nc,
+                long stride_y,
+                long stride_x,
+                long padding_y,
+                long padding_x,
+                float inv_scale
+            )
+            {
+                const auto d = data.host() + data.k()*data.nr()*data.nc()*n;
+                const rectangle boundary = get_rect(data);
+
+                const long out_nr = 1+(data.nr()+2*padding_y-filter_nr)/stride_y;
+                const long out_nc = 1+(data.nc()+2*padding_x-filter_nc)/stride_x;
+
+                output.set_size(out_nr*out_nc,
+                                data.k()*filter_nr*filter_nc);
+                DLIB_CASSERT(output.size() != 0);
+                unsigned char* t = &output(0,0);
+
+                const long max_r = data.nr() + padding_y-(filter_nr-1);
+                const long max_c = data.nc() + padding_x-(filter_nc-1);
+                for (long r = -padding_y; r < max_r; r+=stride_y)
+                {
+                    for (long c = -padding_x; c < max_c; c+=stride_x)
+                    {
+                        for (long k = 0; k < data.k(); ++k)
+                        {
+                            for (long y = 0; y < filter_nr; ++y)
+                            {
+                                for (long x = 0; x < filter_nc; ++x)
+                                {
+                                    const long xx = c+x;
+                                    const long yy = r+y;
+                                    if (boundary.contains(xx,yy))
+                                        *t = (unsigned char)(quantize_value(d[(k*data.nr() + yy)*data.nc() + xx], inv_scale) + 128);
+                                    else
+                                        *t = 128; // quantized zero
+                                    ++t;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            void conv_int8 (
+                const bool add_to_output,
+                tensor& output,
+                const tensor& data,
+                const tensor& filters,
+                long stride_y,
+                long stride_x,
+                long padding_y,
+                long padding_x,
+                const float* biases // nullptr if there is no fused bias add
+            )
+            {
+                const long K = filters.num_samples();
+                const long crs = filters.k()*filters.nr()*filters.nc();
+
+                // quantize the filters, one scale per output channel
+                std::vector<int8_t> wq(K*crs);
+                std::vector<float> wscale(K);
+                std::vector<int32_t> woffset(K);
+                const float* w = filters.host();
+                for (long k = 0; k < K; ++k)
+                {
+                    float mx = 0;
+                    for (long i = 0; i < crs; ++i)
+                        mx = std::max(mx, std::abs(w[k*crs+i]));
+                    wscale[k] = (mx != 0) ? mx/127 : 1;
+                    const float inv = 1/wscale[k];
+                    int32_t sum = 0;
+                    for (long i = 0; i < crs; ++i)
+                    {
+                        wq[k*crs+i] = quantize_value(w[k*crs+i], inv);
+                        sum += wq[k*crs+i];
+                    }
+                    woffset[k] = 128*sum;
+                }
+
+                // quantization scales and dot products only touch their own sample,
+                // so this also parallelizes cleanly over samples.
+                data.host();
+                output.host();
+                parallel_for_blocked(0, data.num_samples(), [&](long nbegin, long nend)
+                {
+                matrix<unsigned char> temp;
+                for (long n = nbegin; n < nend; ++n)
+                {
+                    // one dynamic scale per input sample
+                    const float* x = data.host() + n*data.k()*data.nr()*data.nc();
+                    float mx = 0;
+                    for (long i = 0; i < data.k()*data.nr()*data.nc(); ++i)
+                        mx = std::max(mx, std::abs(x[i]));
+                    const float ascale = (mx != 0) ? mx/127 : 1;
+
+                    img2col_u8(temp, data, n, filters.nr(), filters.nc(), stride_y, stride_x, padding_y, padding_x, 1/ascale);
+
+                    const long P = temp.nr();
+                    float* out = output.host() + n*K*P;
+                    for (long k = 0; k < K; ++k)
+                    {
+                        const int8_t* wrow = &wq[k*crs];
+                        const float out_scale = ascale*wscale[k];
+                        const int32_t correction = woffset[k];
+                        const float bias = biases ? biases[k] : 0;
+                        for (long p = 0; p < P; ++p)
+                        {
+                            const float val = (dot_u8s8(&temp(p,0), wrow, crs) - correction)*out_scale + bias;
+                            if (add_to_output)
+                                out[k*P + p] += val;
+                            else
+                                out[k*P + p] = val;
+                        }
+                    }
+                }
+                });
+            }
+        }
+
+        namespace
+        {
+            void conv_dispatch (
+                const bool add_to_output,
+                tensor& output,
+                const tensor& data,
+                const tensor& filters,
+                const float* biases, // nullptr if there is no fused bias add
+                long stride_y,
+                long stride_x,
+                long padding_y,
+                long padding_x,
+                bool use_int8
+            )
+            {
+                if (use_int8)
+                {
+                    conv_int8(add_to_output, output, data, filters, stride_y, stride_x, padding_y, padding_x, biases);
+                    return;
+                }
+
+                // 3x3 stride 1 convolutions dominate most nets, so they get the Winograd
+                // treatment instead of being lowered to im2col+GEMM.
+                if (filters.nr() == 3 && filters.nc() == 3 && stride_y == 1 && stride_x == 1)
+                {
+                    conv_winograd3x3(add_to_output, output, data, filters, padding_y, padding_x, biases);
+                    return;
+                }
+
+                // Each sample's output depends only on that sample's input, so the
+                // im2col+GEMM lowering runs in parallel over samples.  Touch the host
+                // pointers up front so the worker threads never race to sync them.
+                data.host();
+                filters.host();
+                output.host();
+                parallel_for_blocked(0, data.num_samples(), [&](long nbegin, long nend)
+                {
+                    matrix<float> temp;
+                    for (long n = nbegin; n < nend; ++n)
+                    {
+                        img2col(temp, data, n, filters.nr(), filters.nc(), stride_y, stride_x, padding_y, padding_x);
+
+                        if (add_to_output)
+                            output.add_to_sample(n, mat(filters)*trans(temp));
+                        else
+                            output.set_sample(n, mat(filters)*trans(temp));
+
+                        if (biases)
+                        {
+                            // add the biases to this sample's output while it is still warm
+                            // in cache instead of making a separate pass over the whole
+                            // tensor later.
+                            const long K = filters.num_samples();
+                            const long P = temp.nr();
+                            float* out = output.host() + n*K*P;
+                            for (long k = 0; k < K; ++k)
+                            {
+                                const float bias = biases[k];
+                                for (long p = 0; p < P; ++p)
+                                    out[k*P + p] += bias;
+                            }
+                        }
+                    }
+                });
+            }
+        }
+
         void tensor_conv::operator() (
             const bool add_to_output,
             resizable_tensor& output,
@@ -2046,16 +2896,52 @@ namespace dlib
             DLIB_CASSERT(output.nc() == 1+(data.nc()+2*last_padding_x-filters.nc())/last_stride_x);
 
 
-            matrix<float> temp;
-            for (long n = 0; n < data.num_samples(); ++n)
-            {
-                img2col(temp, data, n, filters.nr(), filters.nc(), last_stride_y, last_stride_x, last_padding_y, last_padding_x);
+            conv_dispatch(add_to_output, output, data, filters, nullptr,
+                          last_stride_y, last_stride_x, last_padding_y, last_padding_x, use_int8);
+        }
 
-                if (add_to_output)
-                    output.add_to_sample(n, mat(filters)*trans(temp));
-                else 
-                    output.set_sample(n, mat(filters)*trans(temp));
-            }
+        void tensor_conv::operator() (
+            const bool add_to_output,
+            resizable_tensor& output,
+            const tensor& data,
+            const tensor& filters,
+            const tensor& biases
+        )
+        {
+            DLIB_CASSERT(last_stride_y > 0 && last_stride_x > 0, "You must call setup() before calling this function.");
+            output.set_size(data.num_samples(),
+                            filters.num_samples(),
+                            1+(data.nr()+2*last_padding_y-filters.nr())/last_stride_y,
+                            1+(data.nc()+2*last_padding_x-filters.nc())/last_stride_x);
+            (*this)(add_to_output, static_cast<tensor&>(output),data,filters,biases);
+        }
+
+        void tensor_conv::operator() (
+            const bool add_to_output,
+            tensor& output,
+            const tensor& data,
+            const tensor& filters,
+            const tensor& biases
+        )
+        {
+            DLIB_CASSERT(is_same_object(output,data) == false);
+            DLIB_CASSERT(is_same_object(output,filters) == false);
+            DLIB_CASSERT(filters.k() == data.k());
+            DLIB_CASSERT(biases.size() == (size_t)filters.num_samples());
+            DLIB_CASSERT(last_stride_y > 0 && last_stride_x > 0, "You must call setup() before calling this function.");
+            DLIB_CASSERT(filters.nr() <= data.nr() + 2*last_padding_y,
+                "Filter windows must be small enough to fit into the padded image.");
+            DLIB_CASSERT(filters.nc() <= data.nc() + 2*last_padding_x,
+                "Filter windows must be small enough to fit into the padded image.");
+
+            DLIB_CASSERT(output.num_samples() == data.num_samples());
+            DLIB_CASSERT(output.k() == filters.num_samples());
+            DLIB_CASSERT(output.nr() == 1+(data.nr()+2*last_padding_y-filters.nr())/last_stride_y);
+            DLIB_CASSERT(output.nc() == 1+(data.nc()+2*last_padding_x-filters.nc())/last_stride_x);
+
+
+            conv_dispatch(add_to_output, output, data, filters, biases.host(),
+                          last_stride_y, last_stride_x, last_padding_y, last_padding_x, use_int8);
         }
 
     // ------------------------------------------------------------------------------------
@@ -2068,19 +2954,28 @@ namespace dlib
             tensor& data_gradient
         )
         {
-            matrix<float> temp;
             if (!add_to_output)
                 data_gradient = 0;
-            for (long n = 0; n < gradient_input.num_samples(); ++n)
+
+            // col2img only writes into the n-th sample of data_gradient, so the
+            // samples can be processed on different threads without any locking.
+            gradient_input.host();
+            filters.host();
+            data_gradient.host();
+            parallel_for_blocked(0, gradient_input.num_samples(), [&](long nbegin, long nend)
             {
-                auto gi = mat(gradient_input.host()+gradient_input.k()*gradient_input.nr()*gradient_input.nc()*n,
-                              gradient_input.k(),
-                              gradient_input.nr()*gradient_input.nc());
-                                    
+                matrix<float> temp;
+                for (long n = nbegin; n < nend; ++n)
+                {
+                    auto gi = mat(gradient_input.host()+gradient_input.k()*gradient_input.nr()*gradient_input.nc()*n,
+                                  gradient_input.k(),
+                                  gradient_input.nr()*gradient_input.nc());
 
-                temp = trans(gi)*mat(filters);
-                col2img(temp, data_gradient, n, filters.nr(), filters.nc(), last_stride_y, last_stride_x, last_padding_y, last_padding_x);
-            }
+
+                    temp = trans(gi)*mat(filters);
+                    col2img(temp, data_gradient, n, filters.nr(), filters.nc(), last_stride_y, last_stride_x, last_padding_y, last_padding_x);
+                }
+            });
         }
 
     // ------------------------------------------------------------------------------------
@@ -2093,27 +2988,70 @@ namespace dlib
             tensor& filters_gradient
         )
         {
-            matrix<float> temp;
-            for (long n = 0; n < gradient_input.num_samples(); ++n)
+            const long num_samples = gradient_input.num_samples();
+            thread_pool& tp = default_thread_pool();
+            const long num_blocks = std::min<long>(tp.num_threads_in_pool()+1, num_samples);
+            if (num_blocks < 2)
             {
-                auto gi = mat(gradient_input.host()+gradient_input.k()*gradient_input.nr()*gradient_input.nc()*n,
-                              gradient_input.k(),
-                              gradient_input.nr()*gradient_input.nc());
+                matrix<float> temp;
+                for (long n = 0; n < num_samples; ++n)
+                {
+                    auto gi = mat(gradient_input.host()+gradient_input.k()*gradient_input.nr()*gradient_input.nc()*n,
+                                  gradient_input.k(),
+                                  gradient_input.nr()*gradient_input.nc());
 
 
-                img2col(temp, data, n, filters_gradient.nr(), filters_gradient.nc(), last_stride_y, last_stride_x, last_padding_y, last_padding_x);
-                if (n == 0)
-                {
-                    if (add_to_output)
-                        filters_gradient += gi*temp;
+                    img2col(temp, data, n, filters_gradient.nr(), filters_gradient.nc(), last_stride_y, last_stride_x, last_padding_y, last_padding_x);
+                    if (n == 0)
+                    {
+                        if (add_to_output)
+                            filters_gradient += gi*temp;
+                        else
+                            filters_gradient = gi*temp;
+                    }
                     else
-                        filters_gradient = gi*temp;
+                    {
+                        filters_gradient += gi*temp;
+                    }
                 }
-                else
+                return;
+            }
+
+            // Unlike the data gradient, every sample contributes to the same filter
+            // gradient, so each thread accumulates a fixed contiguous range of samples
+            // into its own partial sum and the partials are reduced in block order
+            // afterwards.  The block boundaries only depend on the sample count, so
+            // the result doesn't depend on how the tasks get scheduled.
+            gradient_input.host();
+            data.host();
+            std::vector<matrix<float> > partials(num_blocks);
+            parallel_for(tp, 0, num_blocks, [&](long i)
+            {
+                const long nbegin = i*num_samples/num_blocks;
+                const long nend = (i+1)*num_samples/num_blocks;
+                matrix<float> temp;
+                matrix<float>& partial = partials[i];
+                for (long n = nbegin; n < nend; ++n)
                 {
-                    filters_gradient += gi*temp;
+                    auto gi = mat(gradient_input.host()+gradient_input.k()*gradient_input.nr()*gradient_input.nc()*n,
+                                  gradient_input.k(),
+                                  gradient_input.nr()*gradient_input.nc());
+
+
+                    img2col(temp, data, n, filters_gradient.nr(), filters_gradient.nc(), last_stride_y, last_stride_x, last_padding_y, last_padding_x);
+                    if (n == nbegin)
+                        partial = gi*temp;
+                    else
+                        partial += gi*temp;
                 }
-            }
+            });
+
+            if (add_to_output)
+                filters_gradient += partials[0];
+            else
+                filters_gradient = partials[0];
+            for (long i = 1; i < num_blocks; ++i)
+                filters_gradient += partials[i];
         }
 
      // ------------------------------------------------------------------------------------
@@ -353,6 +353,78 @@ namespace dlib
             const tensor& gradient_input
         ) { resize_bilinear_gradient(grad, grad.nc(), grad.nr()*grad.nc(), gradient_input, gradient_input.nc(), gradient_input.nr()*gradient_input.nc()); }
 
+    // -----------------------------------------------------------------------------------
+
+        void extract_image_chips (
+            tensor& chips,
+            const tensor& img,
+            const tensor& tforms
+        );
+
+    // -----------------------------------------------------------------------------------
+
+        void disturb_colors (
+            tensor& img,
+            const tensor& params,
+            float gamma_magnitude,
+            float color_magnitude
+        );
+
+        void flip_images_left_right (
+            tensor& img,
+            const tensor& params,
+            float probability
+        );
+
+        void crop_images (
+            tensor& dest,
+            const tensor& src,
+            const tensor& params,
+            float min_scale
+        );
+
+    // -----------------------------------------------------------------------------------
+
+        void find_greater_than (
+            std::vector<std::pair<size_t,float>>& idxs_and_vals,
+            const tensor& t,
+            size_t begin,
+            size_t end,
+            float thresh
+        );
+
+        void gather (
+            std::vector<float>& vals,
+            const tensor& t,
+            const std::vector<size_t>& idxs
+        );
+
+    // -----------------------------------------------------------------------------------
+
+        void sum_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        );
+
+        void mean_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        );
+
+        void max_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        );
+
+        void argmax_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        );
+
     // -----------------------------------------------------------------------------------
 
         class pooling
@@ -441,9 +513,28 @@ namespace dlib
                 last_stride_y = stride_y;
                 last_stride_x = stride_x;
                 last_padding_y = padding_y;
-                last_padding_x = padding_x;            
+                last_padding_x = padding_x;
             }
 
+            void enable_int8 (
+                bool val
+            ) { use_int8 = val; }
+            /*!
+                ensures
+                    - if (val == true) then
+                        - subsequent calls to operator() quantize the filters and input
+                          to 8 bits (symmetric, per filter scales for the weights and a
+                          per sample scale for the data) and convolve with integer
+                          arithmetic, writing dequantized float results.  This is meant
+                          for inference with trained nets.  Outputs will differ from
+                          the float path by the quantization error.
+                    - else
+                        - operator() uses the normal float path.
+            !*/
+
+            bool int8_enabled (
+            ) const { return use_int8; }
+
              void operator() (
                 const bool add_to_output,
                 resizable_tensor& output,
@@ -458,6 +549,31 @@ namespace dlib
                 const tensor& filters
             );
 
+             void operator() (
+                const bool add_to_output,
+                resizable_tensor& output,
+                const tensor& data,
+                const tensor& filters,
+                const tensor& biases
+            );
+            /*!
+                requires
+                    - biases.size() == filters.num_samples()
+                ensures
+                    - Equivalent to calling operator() without biases and then adding
+                      biases(k) to every element of output channel k, except the bias is
+                      applied while each output chunk is still in cache rather than in a
+                      second pass over the tensor.
+            !*/
+
+             void operator() (
+                const bool add_to_output,
+                tensor& output,
+                const tensor& data,
+                const tensor& filters,
+                const tensor& biases
+            );
+
             void get_gradient_for_data (
                 const bool add_to_output,
                 const tensor& gradient_input, 
@@ -478,6 +594,7 @@ namespace dlib
             long last_stride_x = 0;
             long last_padding_y = 0;
             long last_padding_x = 0;
+            bool use_int8 = false;
         };
 
     // -----------------------------------------------------------------------------------
@@ -7,6 +7,7 @@
 
 #include "cuda_data_ptr.h"
 #include "cuda_utils.h"
+#include <cstring>
 
 namespace dlib
 {
@@ -63,6 +64,60 @@ namespace dlib
             });
         }
 
+    // ------------------------------------------------------------------------------------
+
+        namespace
+        {
+            // Transfers smaller than this go straight through cudaMemcpy() since for
+            // them the cost of an extra host memcpy outweighs the benefit of a pinned
+            // DMA transfer.
+            const size_t pinned_staging_threshold = 4096;
+
+            class pinned_buffer_pool
+            {
+            public:
+                // not copyable
+                pinned_buffer_pool(const pinned_buffer_pool&) = delete;
+                pinned_buffer_pool& operator=(const pinned_buffer_pool&) = delete;
+
+                pinned_buffer_pool() = default;
+
+                std::shared_ptr<void> get (
+                    size_t size
+                )
+                {
+                    // If we don't have a buffer already then make one, or if it's too
+                    // small, make a bigger one.  Otherwise we just recycle the one we
+                    // already have since pinned allocations are expensive.
+                    if (!buffer || buffer_size < size)
+                    {
+                        void* data = nullptr;
+                        CHECK_CUDA(cudaMallocHost(&data, size));
+                        // Note that we don't throw exceptions from the deleter since
+                        // it is invariably called in destructors.
+                        buffer.reset(data, [](void* ptr){
+                            auto err = cudaFreeHost(ptr);
+                            if(err!=cudaSuccess)
+                                std::cerr << "cudaFreeHost() failed. Reason: " << cudaGetErrorString(err) << std::endl;
+                        });
+                        buffer_size = size;
+                    }
+                    return buffer;
+                }
+
+            private:
+
+                std::shared_ptr<void> buffer;
+                size_t buffer_size = 0;
+            };
+        }
+
+        std::shared_ptr<void> pinned_host_buffer(size_t size)
+        {
+            thread_local pinned_buffer_pool pool;
+            return pool.get(size);
+        }
+
     // ------------------------------------------------------------------------------------
 
         void memcpy(
@@ -72,10 +127,23 @@ namespace dlib
         )
         {
             DLIB_ASSERT(num <= src.size());
-            if (src.size() != 0)
+            if (num == 0)
+                return;
+
+            if (num < pinned_staging_threshold)
             {
                 CHECK_CUDA(cudaMemcpy(dest, src.data(),  num, cudaMemcpyDefault));
+                return;
             }
+
+            // Stage the transfer through a recycled pinned buffer.  One full speed DMA
+            // into pinned memory followed by a host memcpy is faster than letting
+            // cudaMemcpy() chunk the transfer through its own internal staging
+            // buffers, and it doesn't serialize transfers issued by other streams.
+            auto staging = pinned_host_buffer(num);
+            CHECK_CUDA(cudaMemcpyAsync(staging.get(), src.data(), num, cudaMemcpyDefault, 0));
+            CHECK_CUDA(cudaStreamSynchronize(0));
+            std::memcpy(dest, staging.get(), num);
         }
 
     // ------------------------------------------------------------------------------------
@@ -91,28 +159,89 @@ namespace dlib
     // ------------------------------------------------------------------------------------
 
         void memcpy(
-            cuda_data_void_ptr dest, 
+            cuda_data_void_ptr dest,
             const void* src,
             const size_t num
         )
         {
             DLIB_ASSERT(num <= dest.size());
-            if (dest.size() != 0)
+            if (num == 0)
+                return;
+
+            if (num < pinned_staging_threshold)
             {
                 CHECK_CUDA(cudaMemcpy(dest.data(), src, num, cudaMemcpyDefault));
+                return;
             }
+
+            auto staging = pinned_host_buffer(num);
+            std::memcpy(staging.get(), src, num);
+            CHECK_CUDA(cudaMemcpyAsync(dest.data(), staging.get(), num, cudaMemcpyDefault, 0));
+            // Wait for the DMA to finish before returning since the staging buffer
+            // will be recycled by the next transfer on this thread.
+            CHECK_CUDA(cudaStreamSynchronize(0));
         }
 
     // ------------------------------------------------------------------------------------
 
         void memcpy(
-            cuda_data_void_ptr dest, 
+            cuda_data_void_ptr dest,
             const void* src
         )
         {
             memcpy(dest,src,dest.size());
         }
 
+    // ------------------------------------------------------------------------------------
+
+        void memcpy_async(
+            void* dest,
+            const cuda_data_void_ptr& src,
+            const size_t num
+        )
+        {
+            DLIB_ASSERT(num <= src.size());
+            if (num != 0)
+            {
+                CHECK_CUDA(cudaMemcpyAsync(dest, src.data(), num, cudaMemcpyDefault, 0));
+            }
+        }
+
+    // ------------------------------------------------------------------------------------
+
+        void memcpy_async(
+            void* dest,
+            const cuda_data_void_ptr& src
+        )
+        {
+            memcpy_async(dest, src, src.size());
+        }
+
+    // ------------------------------------------------------------------------------------
+
+        void memcpy_async(
+            cuda_data_void_ptr dest,
+            const void* src,
+            const size_t num
+        )
+        {
+            DLIB_ASSERT(num <= dest.size());
+            if (num != 0)
+            {
+                CHECK_CUDA(cudaMemcpyAsync(dest.data(), src, num, cudaMemcpyDefault, 0));
+            }
+        }
+
+    // ------------------------------------------------------------------------------------
+
+        void memcpy_async(
+            cuda_data_void_ptr dest,
+            const void* src
+        )
+        {
+            memcpy_async(dest, src, dest.size());
+        }
+
     // ------------------------------------------------------------------------------------
 
         class cudnn_device_buffer
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <vector>
+#include <type_traits>
 
 namespace dlib
 {
@@ -145,7 +146,7 @@ namespace dlib
         !*/
 
         void memcpy(
-            cuda_data_void_ptr dest, 
+            cuda_data_void_ptr dest,
             const void* src,
             const size_t num
         );
@@ -158,6 +159,90 @@ namespace dlib
                   the first num bytes of src to dest.
         !*/
 
+    // ------------------------------------------------------------------------------------
+
+        std::shared_ptr<void> pinned_host_buffer(size_t size);
+        /*!
+            ensures
+                - Returns a pointer to at least size bytes of page-locked (i.e. pinned)
+                  host memory.  Transfers between this memory and the GPU can DMA at
+                  full speed and don't serialize transfers issued by other streams the
+                  way transfers out of pageable memory do.
+                - The buffer is thread local, so each host thread gets its own buffer
+                  and no locking is needed to use it.  It is also recycled.  That is,
+                  the underlying allocation happens once and subsequent calls with a
+                  size <= the largest size previously requested on this thread return
+                  the same buffer rather than triggering another expensive pinned
+                  allocation.
+                - The buffer is alive at least as long as either the returned pointer
+                  or the calling thread exists.  Note, however, that the memcpy()
+                  routines in this file recycle the same buffer for their staging, so
+                  the contents of the returned buffer are only safe from modification
+                  by this thread's memcpy() calls while you hold no interleaved
+                  transfers.
+        !*/
+
+    // ------------------------------------------------------------------------------------
+
+        void memcpy_async(
+            void* dest,
+            const cuda_data_void_ptr& src
+        );
+        /*!
+            requires
+                - dest == a pointer to at least src.size() bytes of pinned host memory,
+                  e.g. memory obtained from pinned_host_buffer().
+            ensures
+                - begins copying the GPU data from src into dest and returns
+                  immediately.  The copy is performed on the default CUDA stream, so it
+                  is complete only once the default stream has been synchronized.
+        !*/
+
+        void memcpy_async(
+            void* dest,
+            const cuda_data_void_ptr& src,
+            const size_t num
+        );
+        /*!
+            requires
+                - dest == a pointer to at least num bytes of pinned host memory, e.g.
+                  memory obtained from pinned_host_buffer().
+                - num <= src.size()
+            ensures
+                - just like the above memcpy_async() except it copies only the first
+                  num bytes of src to dest.
+        !*/
+
+        void memcpy_async(
+            cuda_data_void_ptr dest,
+            const void* src
+        );
+        /*!
+            requires
+                - src == a pointer to at least dest.size() bytes of pinned host memory,
+                  e.g. memory obtained from pinned_host_buffer().
+            ensures
+                - begins copying the host data from src to the GPU memory buffer dest
+                  and returns immediately.  The copy is performed on the default CUDA
+                  stream, so src must not be modified until the default stream has been
+                  synchronized.
+        !*/
+
+        void memcpy_async(
+            cuda_data_void_ptr dest,
+            const void* src,
+            const size_t num
+        );
+        /*!
+            requires
+                - src == a pointer to at least num bytes of pinned host memory, e.g.
+                  memory obtained from pinned_host_buffer().
+                - num <= dest.size()
+            ensures
+                - just like the above memcpy_async() except it copies only the first
+                  num bytes of src to dest.
+        !*/
+
     // ------------------------------------------------------------------------------------
     // ------------------------------------------------------------------------------------
     // ------------------------------------------------------------------------------------
@@ -189,6 +274,20 @@ namespace dlib
                 pdata = cuda_data_void_ptr(n*sizeof(T));
             }
 
+            template <
+                typename U = typename std::remove_const<T>::type,
+                typename = typename std::enable_if<!std::is_same<U,T>::value>::type
+                >
+            cuda_data_ptr(
+                const cuda_data_ptr<U>& other
+            ) : num(other.num), pdata(other.pdata) {}
+            /*!
+                ensures
+                    - *this is a const view of the data referenced by other.  I.e. this
+                      constructor lets you convert a cuda_data_ptr<T> into a
+                      cuda_data_ptr<const T>.  Both objects reference the same memory.
+            !*/
+
             T* data() { return (T*)pdata.data(); }
             const T* data() const { return (T*)pdata.data(); }
 
@@ -201,7 +300,7 @@ namespace dlib
 
 
             friend void memcpy(
-                std::vector<T>& dest,
+                std::vector<typename std::remove_const<T>::type>& dest,
                 const cuda_data_ptr& src
             )
             {
@@ -224,26 +323,95 @@ namespace dlib
 
             friend void memcpy(
                 cuda_data_ptr& dest,
-                const float* src
+                const T* src
             )
             {
                 memcpy(dest.pdata, src);
             }
 
             friend void memcpy(
-                float* dest, 
+                typename std::remove_const<T>::type* dest,
                 const cuda_data_ptr& src
             )
             {
                 memcpy(dest, src.pdata);
             }
 
+            friend void memcpy_async(
+                cuda_data_ptr& dest,
+                const T* src
+            )
+            {
+                memcpy_async(dest.pdata, src);
+            }
+
+            friend void memcpy_async(
+                typename std::remove_const<T>::type* dest,
+                const cuda_data_ptr& src
+            )
+            {
+                memcpy_async(dest, src.pdata);
+            }
+
         private:
 
+            template <typename U>
+            friend class cuda_data_ptr;
+
+            template <typename U>
+            friend cuda_data_ptr<U> static_pointer_cast(const cuda_data_void_ptr& ptr);
+            template <typename U>
+            friend cuda_data_ptr<U> static_pointer_cast(const cuda_data_void_ptr& ptr, size_t num);
+
             size_t num = 0;
             cuda_data_void_ptr pdata;
         };
 
+    // ------------------------------------------------------------------------------------
+
+        template <typename T>
+        cuda_data_ptr<T> static_pointer_cast(const cuda_data_void_ptr& ptr)
+        /*!
+            requires
+                - ptr.size() is a multiple of sizeof(T)
+            ensures
+                - returns a typed view of the memory referenced by ptr.  That is, returns
+                  a cuda_data_ptr<T> that references the same memory as ptr and has
+                  size() == ptr.size()/sizeof(T).  No data is copied.
+        !*/
+        {
+            DLIB_CASSERT(ptr.size() % sizeof(T) == 0,
+                "The size of the given buffer doesn't match the size of the underlying type."
+                << "\n\t ptr.size(): " << ptr.size()
+                << "\n\t sizeof(T):  " << sizeof(T));
+            cuda_data_ptr<T> result;
+            result.num = ptr.size()/sizeof(T);
+            result.pdata = ptr;
+            return result;
+        }
+
+        template <typename T>
+        cuda_data_ptr<T> static_pointer_cast(const cuda_data_void_ptr& ptr, size_t num)
+        /*!
+            requires
+                - num*sizeof(T) <= ptr.size()
+            ensures
+                - returns a typed view of the first num*sizeof(T) bytes of the memory
+                  referenced by ptr.  That is, returns a cuda_data_ptr<T> that references
+                  the same memory as ptr and has size() == num.  No data is copied.
+        !*/
+        {
+            DLIB_CASSERT(num*sizeof(T) <= ptr.size(),
+                "The given buffer is too small to hold num T objects."
+                << "\n\t ptr.size():    " << ptr.size()
+                << "\n\t num:           " << num
+                << "\n\t num*sizeof(T): " << num*sizeof(T));
+            cuda_data_ptr<T> result;
+            result.num = num;
+            result.pdata = ptr;
+            return result;
+        }
+
     // ------------------------------------------------------------------------------------
 
         cuda_data_void_ptr device_global_buffer(size_t size);
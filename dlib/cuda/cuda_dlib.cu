@@ -1566,6 +1566,450 @@ namespace dlib
             }
         }
 
+    // ----------------------------------------------------------------------------------------
+
+        __global__ void _cuda_extract_image_chips(size_t dsize, size_t dchip_size, size_t dchan_size, size_t dnc,
+                                                  float* d, int snr, int snc, const float* s, const float* tforms)
+        {
+            for(auto i : grid_stride_range(0, dsize))
+            {
+                const int n = i/dchip_size;
+                const int channel = (i%dchip_size)/dchan_size;
+                const int idx = i%dchan_size;
+                const int r = idx/dnc;
+                const int c = idx%dnc;
+
+                const float* const tform = tforms + n*6;
+                const float x = tform[0]*c + tform[1]*r + tform[2];
+                const float y = tform[3]*c + tform[4]*r + tform[5];
+
+                float val = 0;
+                if (0 <= x && x <= snc-1 && 0 <= y && y <= snr-1)
+                {
+                    const int left = static_cast<int>(::floor(x));
+                    const int top  = static_cast<int>(::floor(y));
+                    const int right  = ::min(left+1, snc-1);
+                    const int bottom = ::min(top+1, snr-1);
+                    const float lr_frac = x - left;
+                    const float tb_frac = y - top;
+
+                    const float* const schan = s + channel*snr*snc;
+                    const float tl = schan[top*snc+left];
+                    const float tr = schan[top*snc+right];
+                    const float bl = schan[bottom*snc+left];
+                    const float br = schan[bottom*snc+right];
+
+                    val = (1-tb_frac)*((1-lr_frac)*tl + lr_frac*tr) +
+                             tb_frac *((1-lr_frac)*bl + lr_frac*br);
+                }
+                d[i] = val;
+            }
+        }
+
+        void extract_image_chips (
+            tensor& chips,
+            const tensor& img,
+            const tensor& tforms
+        )
+        {
+            DLIB_CASSERT(is_same_object(chips, img)==false);
+            DLIB_CASSERT(img.num_samples() == 1);
+            DLIB_CASSERT(chips.k() == img.k());
+            DLIB_CASSERT(tforms.num_samples() == chips.num_samples());
+            DLIB_CASSERT(tforms.size() == static_cast<size_t>(chips.num_samples())*6);
+
+            if (chips.size() == 0)
+                return;
+
+            launch_kernel(_cuda_extract_image_chips, max_jobs(chips.size()),
+                    chips.size(), chips.k()*chips.nr()*chips.nc(), chips.nr()*chips.nc(), chips.nc(),
+                    chips.device_write_only(), img.nr(), img.nc(), img.device(), tforms.device());
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+        __global__ void _cuda_disturb_colors(size_t size, size_t sample_size, size_t chan_size,
+                                             float* d, const float* params, int k,
+                                             float gamma_magnitude, float color_magnitude)
+        {
+            for (auto i : grid_stride_range(0, size))
+            {
+                const int n = i/sample_size;
+                const int channel = (i%sample_size)/chan_size;
+
+                const float* const pn = params + n*(k+1);
+                const float gamma = ::max(0.0f, 1 + gamma_magnitude*(pn[0]-0.5f));
+
+                float max_scale = 0;
+                for (int j = 0; j < k; ++j)
+                    max_scale = ::max(max_scale, 1 - pn[1+j]*color_magnitude);
+                const float scale = (1 - pn[1+channel]*color_magnitude)/(255*max_scale);
+
+                const float val = ::min(::max(d[i], 0.0f), 255.0f);
+                d[i] = 255*::pow(val*scale, gamma);
+            }
+        }
+
+        void disturb_colors (
+            tensor& img,
+            const tensor& params,
+            float gamma_magnitude,
+            float color_magnitude
+        )
+        {
+            DLIB_CASSERT(params.size() == static_cast<size_t>(img.num_samples())*(img.k()+1));
+            DLIB_CASSERT(gamma_magnitude >= 0);
+            DLIB_CASSERT(0 <= color_magnitude && color_magnitude < 1);
+
+            if (img.size() == 0)
+                return;
+
+            launch_kernel(_cuda_disturb_colors, max_jobs(img.size()),
+                    img.size(), img.k()*img.nr()*img.nc(), img.nr()*img.nc(),
+                    img.device(), params.device(), (int)img.k(), gamma_magnitude, color_magnitude);
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+        __global__ void _cuda_flip_images_left_right(size_t size, size_t half_sample_size,
+                                                     size_t half_nc, size_t nc,
+                                                     float* d, const float* params, float probability)
+        {
+            // each i names one column swap in the left half of some row
+            for (auto i : grid_stride_range(0, size))
+            {
+                const int n = i/half_sample_size;
+                if (params[n] >= probability)
+                    continue;
+
+                const int row_idx = (i%half_sample_size)/half_nc;
+                const int c = i%half_nc;
+
+                float* const row = d + (n*half_sample_size/half_nc + row_idx)*nc;
+                const float temp = row[c];
+                row[c] = row[nc-1-c];
+                row[nc-1-c] = temp;
+            }
+        }
+
+        void flip_images_left_right (
+            tensor& img,
+            const tensor& params,
+            float probability
+        )
+        {
+            DLIB_CASSERT(params.size() == static_cast<size_t>(img.num_samples()));
+            DLIB_CASSERT(0 <= probability && probability <= 1);
+
+            const size_t half_nc = img.nc()/2;
+            const size_t size = img.num_samples()*img.k()*img.nr()*half_nc;
+            if (size == 0)
+                return;
+
+            launch_kernel(_cuda_flip_images_left_right, max_jobs(size),
+                    size, img.k()*img.nr()*half_nc, half_nc, (size_t)img.nc(),
+                    img.device(), params.device(), probability);
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+        __global__ void _cuda_crop_images(size_t dsize, size_t dsample_size, size_t dchan_size,
+                                          size_t dnr, size_t dnc, float* d, int snr, int snc,
+                                          const float* s, int k, const float* params, float min_scale)
+        {
+            for (auto i : grid_stride_range(0, dsize))
+            {
+                const int n = i/dsample_size;
+                const int channel = (i%dsample_size)/dchan_size;
+                const int idx = i%dchan_size;
+                const int r = idx/dnc;
+                const int c = idx%dnc;
+
+                const float* const pn = params + n*3;
+                const float scale = min_scale + pn[0]*(1-min_scale);
+                const float h = scale*snr;
+                const float w = scale*snc;
+                const float y0 = pn[1]*(snr-h);
+                const float x0 = pn[2]*(snc-w);
+                const float y_scale = dnr > 1 ? (h-1)/(dnr-1) : 0;
+                const float x_scale = dnc > 1 ? (w-1)/(dnc-1) : 0;
+
+                const float y = ::min(::max(y0 + r*y_scale, 0.0f), (float)(snr-1));
+                const float x = ::min(::max(x0 + c*x_scale, 0.0f), (float)(snc-1));
+                const int top = static_cast<int>(::floor(y));
+                const int left = static_cast<int>(::floor(x));
+                const int bottom = ::min(top+1, snr-1);
+                const int right = ::min(left+1, snc-1);
+                const float tb_frac = y - top;
+                const float lr_frac = x - left;
+
+                const float* const schan = s + (n*k + channel)*snr*snc;
+                const float tl = schan[top*snc+left];
+                const float tr = schan[top*snc+right];
+                const float bl = schan[bottom*snc+left];
+                const float br = schan[bottom*snc+right];
+
+                d[i] = (1-tb_frac)*((1-lr_frac)*tl + lr_frac*tr) +
+                          tb_frac *((1-lr_frac)*bl + lr_frac*br);
+            }
+        }
+
+        void crop_images (
+            tensor& dest,
+            const tensor& src,
+            const tensor& params,
+            float min_scale
+        )
+        {
+            DLIB_CASSERT(is_same_object(dest, src)==false);
+            DLIB_CASSERT(dest.num_samples() == src.num_samples());
+            DLIB_CASSERT(dest.k() == src.k());
+            DLIB_CASSERT(params.size() == static_cast<size_t>(src.num_samples())*3);
+            DLIB_CASSERT(0 < min_scale && min_scale <= 1);
+
+            if (dest.size() == 0)
+                return;
+
+            launch_kernel(_cuda_crop_images, max_jobs(dest.size()),
+                    dest.size(), dest.k()*dest.nr()*dest.nc(), dest.nr()*dest.nc(),
+                    (size_t)dest.nr(), (size_t)dest.nc(), dest.device_write_only(),
+                    (int)src.nr(), (int)src.nc(), src.device(), (int)src.k(),
+                    params.device(), min_scale);
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+        __global__ void _cuda_find_greater_than(const float* d, size_t begin, size_t end, float thresh,
+            size_t* idx_out, float* val_out, unsigned int* count)
+        {
+            for (auto i : grid_stride_range(begin, end))
+            {
+                const float val = d[i];
+                if (val > thresh)
+                {
+                    const unsigned int slot = atomicAdd(count, 1);
+                    idx_out[slot] = i;
+                    val_out[slot] = val;
+                }
+            }
+        }
+
+        void find_greater_than (
+            std::vector<std::pair<size_t,float>>& idxs_and_vals,
+            const tensor& t,
+            size_t begin,
+            size_t end,
+            float thresh
+        )
+        {
+            DLIB_CASSERT(begin <= end && end <= t.size());
+
+            idxs_and_vals.clear();
+            if (begin == end)
+                return;
+
+            // The compaction happens entirely on the device so only the elements that
+            // pass the threshold ever cross the bus, rather than the whole tensor.
+            // Scratch layout: a counter, then max_hits indices, then max_hits values.
+            const size_t max_hits = end - begin;
+            const size_t idx_offset = sizeof(size_t); // keep the size_t array aligned
+            const size_t val_offset = idx_offset + max_hits*sizeof(size_t);
+            auto buf = device_global_buffer(val_offset + max_hits*sizeof(float));
+
+            const unsigned int zero = 0;
+            memcpy(buf, &zero, sizeof(zero));
+
+            launch_kernel(_cuda_find_greater_than, max_jobs(max_hits),
+                    t.device(), begin, end, thresh,
+                    (size_t*)(buf+idx_offset).data(),
+                    (float*)(buf+val_offset).data(),
+                    (unsigned int*)buf.data());
+
+            unsigned int num_hits = 0;
+            memcpy(&num_hits, buf, sizeof(num_hits));
+
+            std::vector<size_t> idxs(num_hits);
+            std::vector<float> vals(num_hits);
+            if (num_hits != 0)
+            {
+                memcpy(idxs.data(), buf+idx_offset, num_hits*sizeof(size_t));
+                memcpy(vals.data(), buf+val_offset, num_hits*sizeof(float));
+            }
+
+            idxs_and_vals.reserve(idxs.size());
+            for (size_t i = 0; i < idxs.size(); ++i)
+                idxs_and_vals.emplace_back(idxs[i], vals[i]);
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+        __global__ void _cuda_gather(float* vals, size_t num, const size_t* idxs, const float* d)
+        {
+            for (auto i : grid_stride_range(0, num))
+                vals[i] = d[idxs[i]];
+        }
+
+        void gather (
+            std::vector<float>& vals,
+            const tensor& t,
+            const std::vector<size_t>& idxs
+        )
+        {
+#ifdef ENABLE_ASSERTS
+            for (auto idx : idxs)
+                DLIB_ASSERT(idx < t.size());
+#endif
+
+            vals.resize(idxs.size());
+            if (idxs.size() == 0)
+                return;
+
+            // Scratch layout: the indices followed by the gathered values.
+            const size_t val_offset = idxs.size()*sizeof(size_t);
+            auto buf = device_global_buffer(val_offset + idxs.size()*sizeof(float));
+
+            memcpy(buf, idxs.data(), val_offset);
+
+            launch_kernel(_cuda_gather, max_jobs(idxs.size()),
+                    (float*)(buf+val_offset).data(), idxs.size(), (const size_t*)buf.data(), t.device());
+
+            memcpy(vals.data(), buf+val_offset, idxs.size()*sizeof(float));
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+        namespace
+        {
+            // Flatten a 4D tensor around the axis being reduced.  outer counts the
+            // dimensions before the axis, mid is the axis itself, and inner counts
+            // the dimensions after it, so src element (o,m,i) lives at linear index
+            // (o*mid + m)*inner + i.
+            void axis_extents (
+                const tensor& dest,
+                const tensor& src,
+                long axis,
+                size_t& outer,
+                size_t& mid,
+                size_t& inner
+            )
+            {
+                DLIB_CASSERT(0 <= axis && axis <= 3);
+                DLIB_CASSERT(is_same_object(dest, src) == false);
+                const long sdims[4] = {src.num_samples(), src.k(), src.nr(), src.nc()};
+                const long ddims[4] = {dest.num_samples(), dest.k(), dest.nr(), dest.nc()};
+                outer = 1;
+                inner = 1;
+                for (long i = 0; i < 4; ++i)
+                {
+                    DLIB_CASSERT(ddims[i] == (i == axis ? 1 : sdims[i]),
+                        "dest must have the same dimensions as src except the reduced axis must be 1."
+                        << "\n\t axis: " << axis
+                        << "\n\t i:    " << i);
+                    if (i < axis)
+                        outer *= sdims[i];
+                    else if (i > axis)
+                        inner *= sdims[i];
+                }
+                mid = sdims[axis];
+            }
+        }
+
+        __global__ void _cuda_sum_axis(float* d, const float* s, size_t n, size_t mid, size_t inner, float scale)
+        {
+            for (auto i : grid_stride_range(0, n))
+            {
+                const float* p = s + (i/inner)*mid*inner + i%inner;
+                float acc = 0;
+                for (size_t m = 0; m < mid; ++m, p += inner)
+                    acc += *p;
+                d[i] = acc*scale;
+            }
+        }
+
+        __global__ void _cuda_max_axis(float* d, const float* s, size_t n, size_t mid, size_t inner)
+        {
+            for (auto i : grid_stride_range(0, n))
+            {
+                const float* p = s + (i/inner)*mid*inner + i%inner;
+                float best = *p;
+                for (size_t m = 1; m < mid; ++m)
+                {
+                    p += inner;
+                    if (*p > best)
+                        best = *p;
+                }
+                d[i] = best;
+            }
+        }
+
+        __global__ void _cuda_argmax_axis(float* d, const float* s, size_t n, size_t mid, size_t inner)
+        {
+            for (auto i : grid_stride_range(0, n))
+            {
+                const float* p = s + (i/inner)*mid*inner + i%inner;
+                float best = *p;
+                size_t best_idx = 0;
+                for (size_t m = 1; m < mid; ++m)
+                {
+                    p += inner;
+                    if (*p > best)
+                    {
+                        best = *p;
+                        best_idx = m;
+                    }
+                }
+                d[i] = best_idx;
+            }
+        }
+
+        void sum_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        )
+        {
+            size_t outer, mid, inner;
+            axis_extents(dest, src, axis, outer, mid, inner);
+            launch_kernel(_cuda_sum_axis, max_jobs(dest.size()),
+                    dest.device_write_only(), src.device(), outer*inner, mid, inner, 1.0f);
+        }
+
+        void mean_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        )
+        {
+            size_t outer, mid, inner;
+            axis_extents(dest, src, axis, outer, mid, inner);
+            launch_kernel(_cuda_sum_axis, max_jobs(dest.size()),
+                    dest.device_write_only(), src.device(), outer*inner, mid, inner, 1.0f/mid);
+        }
+
+        void max_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        )
+        {
+            size_t outer, mid, inner;
+            axis_extents(dest, src, axis, outer, mid, inner);
+            launch_kernel(_cuda_max_axis, max_jobs(dest.size()),
+                    dest.device_write_only(), src.device(), outer*inner, mid, inner);
+        }
+
+        void argmax_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        )
+        {
+            size_t outer, mid, inner;
+            axis_extents(dest, src, axis, outer, mid, inner);
+            launch_kernel(_cuda_argmax_axis, max_jobs(dest.size()),
+                    dest.device_write_only(), src.device(), outer*inner, mid, inner);
+        }
+
     // ----------------------------------------------------------------------------------------
 
         __global__ void _cuda_copy_tensor_add_to (float* dest, size_t size,  const float* src,  size_t dest_stride, size_t src_stride, size_t block_size)
@@ -1689,6 +2133,59 @@ namespace dlib
             loss = scale*floss;
         }
 
+    // ----------------------------------------------------------------------------------------
+
+        __global__ void _cuda_compute_loss_multiclass_log_per_pixel_weighted(float* loss_out, float* g, const uint16_t* truth, const float* weights, size_t n, size_t plane_size, size_t sample_size, size_t nk, const float scale)
+        {
+            float loss = 0;
+            for(auto i : grid_stride_range(0, n))
+            {
+                const size_t k = (i/plane_size)%nk;
+                const size_t idx = (i%plane_size) + plane_size*(i/sample_size);
+
+                const size_t y = truth[idx];
+                const float weight = weights[idx];
+
+                if (k == y)
+                {
+                    loss -= weight*cuda_safe_log(g[i]);
+                    g[i] = weight*scale*(g[i] - 1);
+                }
+                else
+                {
+                    g[i] = weight*scale*g[i];
+                }
+            }
+
+            warp_reduce_atomic_add(*loss_out, loss);
+        }
+
+
+        void compute_loss_multiclass_log_per_pixel_weighted::
+        do_work(
+            float* loss_cuda_work_buffer,
+            const uint16_t* truth_buffer,
+            const float* weights_buffer,
+            const tensor& subnetwork_output,
+            tensor& gradient,
+            double& loss
+        )
+        {
+            CHECK_CUDA(cudaMemset(loss_cuda_work_buffer, 0, sizeof(float)));
+            softmax(gradient, subnetwork_output);
+
+            // The loss we output is the weighted average loss over the mini-batch, and also over each element of the matrix output.
+            const double scale = 1.0 / (subnetwork_output.num_samples() * subnetwork_output.nr() * subnetwork_output.nc());
+
+
+            launch_kernel(_cuda_compute_loss_multiclass_log_per_pixel_weighted, max_jobs(gradient.size()),
+                loss_cuda_work_buffer, gradient.device(), truth_buffer, weights_buffer, gradient.size(), gradient.nr()*gradient.nc(), gradient.nr()*gradient.nc()*gradient.k(), gradient.k(), scale);
+
+            float floss;
+            CHECK_CUDA(cudaMemcpy(&floss, loss_cuda_work_buffer,  sizeof(float), cudaMemcpyDefault));
+            loss = scale*floss;
+        }
+
     // ----------------------------------------------------------------------------------------
 
     }
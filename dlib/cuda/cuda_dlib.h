@@ -398,6 +398,78 @@ namespace dlib
             const tensor& gradient_input
         ) { resize_bilinear_gradient(grad, grad.nc(), grad.nr()*grad.nc(), gradient_input, gradient_input.nc(), gradient_input.nr()*gradient_input.nc()); }
 
+    // ----------------------------------------------------------------------------------------
+
+        void extract_image_chips (
+            tensor& chips,
+            const tensor& img,
+            const tensor& tforms
+        );
+
+    // ----------------------------------------------------------------------------------------
+
+        void disturb_colors (
+            tensor& img,
+            const tensor& params,
+            float gamma_magnitude,
+            float color_magnitude
+        );
+
+        void flip_images_left_right (
+            tensor& img,
+            const tensor& params,
+            float probability
+        );
+
+        void crop_images (
+            tensor& dest,
+            const tensor& src,
+            const tensor& params,
+            float min_scale
+        );
+
+    // ----------------------------------------------------------------------------------------
+
+        void find_greater_than (
+            std::vector<std::pair<size_t,float>>& idxs_and_vals,
+            const tensor& t,
+            size_t begin,
+            size_t end,
+            float thresh
+        );
+
+        void gather (
+            std::vector<float>& vals,
+            const tensor& t,
+            const std::vector<size_t>& idxs
+        );
+
+    // ----------------------------------------------------------------------------------------
+
+        void sum_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        );
+
+        void mean_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        );
+
+        void max_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        );
+
+        void argmax_axis (
+            tensor& dest,
+            const tensor& src,
+            long axis
+        );
+
     // ----------------------------------------------------------------------------------------
 
         void copy_tensor(
@@ -464,7 +536,80 @@ namespace dlib
                 tensor& gradient,
                 double& loss
             );
-            
+
+            mutable cuda_data_void_ptr buf;
+        };
+
+    // ----------------------------------------------------------------------------------------
+
+        class compute_loss_multiclass_log_per_pixel_weighted
+        {
+            /*!
+                The point of this class is to compute the loss computed by
+                loss_multiclass_log_per_pixel_weighted, but to do so with CUDA.
+            !*/
+        public:
+
+            compute_loss_multiclass_log_per_pixel_weighted(
+            )
+            {
+            }
+
+            template <
+                typename const_label_iterator
+                >
+            void operator() (
+                const_label_iterator truth,
+                const tensor& subnetwork_output,
+                tensor& gradient,
+                double& loss
+            ) const
+            {
+                const size_t bytes_per_plane = subnetwork_output.nr()*subnetwork_output.nc()*sizeof(uint16_t);
+                const size_t weight_bytes_per_plane = subnetwork_output.nr()*subnetwork_output.nc()*sizeof(float);
+                // Allocate a cuda buffer to store all the truth images and their weights
+                // and also one float for the scalar loss output.
+                buf = device_global_buffer(subnetwork_output.num_samples()*(bytes_per_plane+weight_bytes_per_plane) + sizeof(float));
+
+                cuda_data_void_ptr loss_buf = buf;
+                buf = buf+sizeof(float);
+
+                cuda_data_void_ptr weights_buf = buf + subnetwork_output.num_samples()*bytes_per_plane;
+
+                // copy the truth labels and weights into cuda buffers.
+                matrix<uint16_t> labels(subnetwork_output.nr(), subnetwork_output.nc());
+                matrix<float> weights(subnetwork_output.nr(), subnetwork_output.nc());
+                for (long i = 0; i < subnetwork_output.num_samples(); ++i, ++truth)
+                {
+                    DLIB_ASSERT(truth->nr() == subnetwork_output.nr());
+                    DLIB_ASSERT(truth->nc() == subnetwork_output.nc());
+                    for (long r = 0; r < subnetwork_output.nr(); ++r)
+                    {
+                        for (long c = 0; c < subnetwork_output.nc(); ++c)
+                        {
+                            labels(r,c) = truth->operator()(r,c).label;
+                            weights(r,c) = truth->operator()(r,c).weight;
+                        }
+                    }
+                    memcpy(buf + i*bytes_per_plane, &labels(0,0), bytes_per_plane);
+                    memcpy(weights_buf + i*weight_bytes_per_plane, &weights(0,0), weight_bytes_per_plane);
+                }
+
+                do_work(static_cast<float*>(loss_buf.data()), static_cast<uint16_t*>(buf.data()),
+                    static_cast<float*>(weights_buf.data()), subnetwork_output, gradient, loss);
+            }
+
+        private:
+
+            static void do_work(
+                float* loss_cuda_work_buffer,
+                const uint16_t* truth_buffer,
+                const float* weights_buffer,
+                const tensor& subnetwork_output,
+                tensor& gradient,
+                double& loss
+            );
+
             mutable cuda_data_void_ptr buf;
         };
 
@@ -0,0 +1,304 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include "cuda_utils.h"
+#include "cuda_fhog.h"
+#include "cuda_dlib.h"
+
+namespace dlib
+{
+    namespace cuda
+    {
+
+    // ----------------------------------------------------------------------------------------
+
+        __device__ void fhog_gradient (
+            const float* img,
+            size_t img_nc,
+            int y,
+            int x,
+            float& grad_x,
+            float& grad_y
+        )
+        {
+            // Note the casts to int.  The CPU code reads pixel intensities through
+            // (int)get_pixel_intensity() so non-integer intensities get truncated.  We
+            // do the same so the outputs match bit for bit on integer valued images.
+            grad_x = (float)((int)img[y*img_nc + x+1] - (int)img[y*img_nc + x-1]);
+            grad_y = (float)((int)img[(y+1)*img_nc + x] - (int)img[(y-1)*img_nc + x]);
+        }
+
+        __device__ int fhog_snap_orientation (
+            float grad_x,
+            float grad_y
+        )
+        {
+            // unit vectors used to compute gradient orientation
+            const float dir_x[9] = { 1.0000f, 0.9397f, 0.7660f, 0.500f, 0.1736f, -0.1736f, -0.5000f, -0.7660f, -0.9397f };
+            const float dir_y[9] = { 0.0000f, 0.3420f, 0.6428f, 0.8660f, 0.9848f, 0.9848f, 0.8660f, 0.6428f, 0.3420f };
+
+            float best_dot = 0;
+            int best_o = 0;
+            for (int o = 0; o < 9; ++o)
+            {
+                const float dot = grad_x*dir_x[o] + grad_y*dir_y[o];
+                if (dot > best_dot)
+                {
+                    best_dot = dot;
+                    best_o = o;
+                }
+                else if (-dot > best_dot)
+                {
+                    best_dot = -dot;
+                    best_o = o+9;
+                }
+            }
+            return best_o;
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+        __global__ void _cuda_fhog_hist (
+            float* hist,        // 18 planes, each pnr by pnc (1 cell of padding all around)
+            const float* img,
+            size_t img_nc,
+            int cell_size,
+            size_t pnr,
+            size_t pnc,
+            int visible_nr,
+            int visible_nc
+        )
+        {
+            // Each thread computes all 18 orientation bins for one padded histogram
+            // cell by gathering over the 2*cell_size wide window of pixels whose
+            // bilinear interpolation weights touch that cell.  The CPU code scatters
+            // each pixel into its 4 neighboring cells instead, but a scatter on the
+            // GPU would need atomics, so we gather and recompute each gradient for
+            // the (up to) 4 cells that see it.
+            for (auto i : grid_stride_range(0, pnr*pnc))
+            {
+                const long r = i/pnc;
+                const long c = i%pnc;
+
+                float h[18];
+                for (int o = 0; o < 18; ++o)
+                    h[o] = 0;
+
+                // A pixel at row y votes into padded rows iyp+1 and iyp+2 where
+                // iyp = floor((y+0.5)/cell_size - 0.5), so padded row r hears from
+                // pixels with iyp == r-1 or iyp == r-2.
+                const int ylo = ::max(1, (int)::ceilf((r-1.5f)*cell_size - 0.5f));
+                const int yhi = ::min(visible_nr, (int)::ceilf((r+0.5f)*cell_size - 0.5f));
+                const int xlo = ::max(1, (int)::ceilf((c-1.5f)*cell_size - 0.5f));
+                const int xhi = ::min(visible_nc, (int)::ceilf((c+0.5f)*cell_size - 0.5f));
+
+                for (int y = ylo; y < yhi; ++y)
+                {
+                    const float yp = ((float)y+0.5f)/(float)cell_size - 0.5f;
+                    const int iyp = (int)::floorf(yp);
+                    const float vy0 = yp - iyp;
+                    // weight this row of pixels gives to padded row r
+                    const float wy = (iyp == r-1) ? 1.0f-vy0 : vy0;
+                    for (int x = xlo; x < xhi; ++x)
+                    {
+                        const float xp = ((float)x+0.5f)/(float)cell_size - 0.5f;
+                        const int ixp = (int)::floorf(xp);
+                        const float vx0 = xp - ixp;
+                        const float wx = (ixp == c-1) ? 1.0f-vx0 : vx0;
+
+                        float grad_x, grad_y;
+                        fhog_gradient(img, img_nc, y, x, grad_x, grad_y);
+                        const float v = ::sqrtf(grad_x*grad_x + grad_y*grad_y);
+                        h[fhog_snap_orientation(grad_x, grad_y)] += wy*wx*v;
+                    }
+                }
+
+                for (int o = 0; o < 18; ++o)
+                    hist[o*pnr*pnc + i] = h[o];
+            }
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+        __global__ void _cuda_fhog_norm (
+            float* norm,        // cells_nr by cells_nc
+            const float* hist,
+            size_t cells_nr,
+            size_t cells_nc,
+            size_t pnr,
+            size_t pnc
+        )
+        {
+            // compute energy in each cell by summing over orientations
+            for (auto i : grid_stride_range(0, cells_nr*cells_nc))
+            {
+                const long r = i/cells_nc;
+                const long c = i%cells_nc;
+                const float* hh = hist + (r+1)*pnc + (c+1);
+                float sum = 0;
+                for (int o = 0; o < 9; ++o)
+                {
+                    const float t = hh[o*pnr*pnc] + hh[(o+9)*pnr*pnc];
+                    sum += t*t;
+                }
+                norm[i] = sum;
+            }
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+        __global__ void _cuda_fhog_features (
+            float* hog,         // 31 planes, each out_nr by out_nc
+            const float* hist,
+            const float* norm,
+            size_t hog_nr,
+            size_t hog_nc,
+            size_t cells_nc,
+            size_t pnr,
+            size_t pnc,
+            size_t out_nr,
+            size_t out_nc,
+            int padding_rows_offset,
+            int padding_cols_offset
+        )
+        {
+            const float eps = 0.0001;
+            for (auto i : grid_stride_range(0, hog_nr*hog_nc))
+            {
+                const long y = i/hog_nc;
+                const long x = i%hog_nc;
+
+                const float* nb = norm + y*cells_nc + x;
+                // energies of the 4 blocks around this cell, same lane order as the
+                // simd4f version in fhog.h
+                float nn[4];
+                nn[0] = 0.2f*::sqrtf(nb[cells_nc+1] + nb[cells_nc+2] + nb[2*cells_nc+1] + nb[2*cells_nc+2] + eps);
+                nn[1] = 0.2f*::sqrtf(nb[1]          + nb[2]          + nb[cells_nc+1]   + nb[cells_nc+2]   + eps);
+                nn[2] = 0.2f*::sqrtf(nb[cells_nc]   + nb[cells_nc+1] + nb[2*cells_nc]   + nb[2*cells_nc+1] + eps);
+                nn[3] = 0.2f*::sqrtf(nb[0]          + nb[1]          + nb[cells_nc]     + nb[cells_nc+1]   + eps);
+                float n[4];
+                float t[4] = {0,0,0,0};
+                for (int k = 0; k < 4; ++k)
+                    n[k] = 0.1f/nn[k];
+
+                const float* hh = hist + (y+2)*pnc + (x+2);
+                float* out = hog + (y+padding_rows_offset)*out_nc + (x+padding_cols_offset);
+
+                // contrast-sensitive features
+                for (int o = 0; o < 18; ++o)
+                {
+                    const float val = hh[o*pnr*pnc];
+                    float sum = 0;
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        const float hv = ::fminf(val, nn[k])*n[k];
+                        sum += hv;
+                        t[k] += hv;
+                    }
+                    out[o*out_nr*out_nc] = sum;
+                }
+
+                // contrast-insensitive features
+                for (int o = 0; o < 9; ++o)
+                {
+                    const float val = hh[o*pnr*pnc] + hh[(o+9)*pnr*pnc];
+                    float sum = 0;
+                    for (int k = 0; k < 4; ++k)
+                        sum += ::fminf(val, nn[k])*n[k];
+                    out[(o+18)*out_nr*out_nc] = sum;
+                }
+
+                // texture features
+                for (int k = 0; k < 4; ++k)
+                    out[(27+k)*out_nr*out_nc] = t[k]*2*0.2357f;
+            }
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+        void extract_fhog_features (
+            resizable_tensor& hog,
+            const tensor& img,
+            int cell_size,
+            int filter_rows_padding,
+            int filter_cols_padding
+        )
+        {
+            DLIB_CASSERT(img.num_samples() == 1 && img.k() == 1 &&
+                         cell_size > 1 &&
+                         filter_rows_padding > 0 &&
+                         filter_cols_padding > 0,
+                "\t void extract_fhog_features()"
+                << "\n\t Invalid inputs were given to this function. "
+                << "\n\t img.num_samples():   " << img.num_samples()
+                << "\n\t img.k():             " << img.k()
+                << "\n\t cell_size:           " << cell_size
+                << "\n\t filter_rows_padding: " << filter_rows_padding
+                << "\n\t filter_cols_padding: " << filter_cols_padding
+                );
+
+            const long cells_nr = (long)((float)img.nr()/(float)cell_size + 0.5);
+            const long cells_nc = (long)((float)img.nc()/(float)cell_size + 0.5);
+
+            const long hog_nr = std::max(cells_nr-2, 0L);
+            const long hog_nc = std::max(cells_nc-2, 0L);
+            if (hog_nr == 0 || hog_nc == 0)
+            {
+                hog.clear();
+                return;
+            }
+
+            // histogram cells get 1 cell of zero padding all around, just like the CPU
+            // version, so the feature kernel doesn't need boundary checks.
+            const long pnr = cells_nr+2;
+            const long pnc = cells_nc+2;
+            resizable_tensor hist(1, 18, pnr, pnc);
+            resizable_tensor norm(1, 1, cells_nr, cells_nc);
+
+            const int padding_rows_offset = (filter_rows_padding-1)/2;
+            const int padding_cols_offset = (filter_cols_padding-1)/2;
+            hog.set_size(1, 31, hog_nr+filter_rows_padding-1, hog_nc+filter_cols_padding-1);
+            // zero the padding border
+            set_tensor(hog, 0);
+
+            const int visible_nr = std::min(cells_nr*cell_size, img.nr())-1;
+            const int visible_nc = std::min(cells_nc*cell_size, img.nc())-1;
+
+            launch_kernel(_cuda_fhog_hist, max_jobs(pnr*pnc),
+                hist.device_write_only(), img.device(), (size_t)img.nc(),
+                cell_size, (size_t)pnr, (size_t)pnc, visible_nr, visible_nc);
+
+            launch_kernel(_cuda_fhog_norm, max_jobs(cells_nr*cells_nc),
+                norm.device_write_only(), hist.device(),
+                (size_t)cells_nr, (size_t)cells_nc, (size_t)pnr, (size_t)pnc);
+
+            launch_kernel(_cuda_fhog_features, max_jobs(hog_nr*hog_nc),
+                hog.device(), hist.device(), norm.device(),
+                (size_t)hog_nr, (size_t)hog_nc, (size_t)cells_nc,
+                (size_t)pnr, (size_t)pnc, (size_t)hog.nr(), (size_t)hog.nc(),
+                padding_rows_offset, padding_cols_offset);
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+        void pyramid_down (
+            resizable_tensor& dest,
+            const tensor& src,
+            unsigned int N
+        )
+        {
+            DLIB_CASSERT(N > 3 && is_same_object(dest, src) == false,
+                "\t void pyramid_down()"
+                << "\n\t Invalid inputs were given to this function. "
+                << "\n\t N: " << N
+                << "\n\t is_same_object(dest, src): " << is_same_object(dest, src)
+                );
+
+            dest.set_size(src.num_samples(), src.k(), ((N-1)*src.nr())/N, ((N-1)*src.nc())/N);
+            resize_bilinear(dest, src);
+        }
+
+    // ----------------------------------------------------------------------------------------
+
+    }
+}
@@ -0,0 +1,83 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_DNN_CuDA_FHOG_H_
+#define DLIB_DNN_CuDA_FHOG_H_
+
+#include "tensor.h"
+
+namespace dlib
+{
+    namespace cuda
+    {
+
+#ifdef DLIB_USE_CUDA
+
+    // ----------------------------------------------------------------------------------------
+
+        void extract_fhog_features (
+            resizable_tensor& hog,
+            const tensor& img,
+            int cell_size = 8,
+            int filter_rows_padding = 1,
+            int filter_cols_padding = 1
+        );
+        /*!
+            requires
+                - img.num_samples() == 1
+                - img.k() == 1 (i.e. img is a grayscale image on the device)
+                - cell_size > 1
+                - filter_rows_padding > 0
+                - filter_cols_padding > 0
+            ensures
+                - Computes the same 31 channel FHOG features as the CPU routine
+                  extract_fhog_features() defined in dlib/image_transforms/fhog.h,
+                  except that all the work happens on the GPU and both the input
+                  image and the output features stay in device memory.
+                - #hog.num_samples() == 1
+                - #hog.k() == 31
+                - Channel i of #hog holds the same values, in the same row/column
+                  layout, as hog[i] does after calling the CPU
+                  extract_fhog_features(img, hog, cell_size, filter_rows_padding,
+                  filter_cols_padding) with a dlib::array<array2d<float>> output.
+                  In particular the padding border cells are zeroed just like
+                  they are by the CPU version.
+                - if (the input image is too small to give any feature cells) then
+                    - #hog.size() == 0
+        !*/
+
+    // ----------------------------------------------------------------------------------------
+
+        void pyramid_down (
+            resizable_tensor& dest,
+            const tensor& src,
+            unsigned int N
+        );
+        /*!
+            requires
+                - N > 3
+                - is_same_object(dest, src) == false
+            ensures
+                - Downsamples src by a factor of (N-1)/N using bilinear
+                  interpolation, just like the generic dlib::pyramid_down<N>
+                  template does on the CPU (for N > 3 pyramid_down is a plain
+                  bilinear resize, which is why this routine requires N > 3.  The
+                  N==2 and N==3 pyramids apply additional smoothing filters and
+                  don't have device side versions).
+                - #dest.num_samples() == src.num_samples()
+                - #dest.k() == src.k()
+                - #dest.nr() == ((N-1)*src.nr())/N
+                - #dest.nc() == ((N-1)*src.nc())/N
+                - This allows an entire FHOG scan pyramid to be computed on the
+                  GPU by alternating calls to this function and
+                  extract_fhog_features(), with only the resulting feature maps
+                  (or detections computed from them) copied back to the host.
+        !*/
+
+    // ----------------------------------------------------------------------------------------
+
+#endif // DLIB_USE_CUDA
+
+    }
+}
+
+#endif // DLIB_DNN_CuDA_FHOG_H_
@@ -8,13 +8,18 @@
 #include "cudnn_dlibapi.h"
 #include "tensor.h"
 #include <cudnn.h>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
 #include <string>
 #include <vector>
 #include "cuda_utils.h"
 #include "cpu_dlib.h"
 #include "cuda_dlib.h"
 #include "tensor_tools.h"
+#include "../serialize.h"
 
 static const char* cudnn_get_error_string(cudnnStatus_t s)
 {
@@ -696,11 +701,152 @@ namespace dlib
         }
 
     // ------------------------------------------------------------------------------------
+    // ------------------------------------------------------------------------------------
+
+        namespace
+        {
+        /*
+            These functions implement the algorithm cache used by the convolution
+            autotuning mode (see enable_dnn_conv_autotuning()).  The cache maps a string
+            describing the GPU model and the convolution shape to the three algorithm
+            numbers that benchmarked fastest for that shape, so each shape only has to
+            be benchmarked once per cache file lifetime.
+        */
+
+            std::mutex& conv_autotune_mutex (
+            )
+            {
+                static std::mutex m;
+                return m;
+            }
+
+            std::map<std::string,std::vector<int>>& conv_autotune_table (
+            )
+            {
+                // The first time the table is touched we pull in whatever a previous run
+                // saved to the cache file.  A missing or unreadable file just means we
+                // start over with an empty cache, since the cache is purely an
+                // optimization.
+                static std::map<std::string,std::vector<int>> table = []()
+                {
+                    std::map<std::string,std::vector<int>> t;
+                    const std::string filename = dnn_conv_autotune_cache_filename();
+                    if (filename.size() != 0)
+                    {
+                        try
+                        {
+                            std::ifstream fin(filename.c_str(), std::ios::binary);
+                            if (fin)
+                                deserialize(t, fin);
+                        }
+                        catch (serialization_error&)
+                        {
+                            t.clear();
+                        }
+                    }
+                    return t;
+                }();
+                return table;
+            }
+
+            std::string conv_autotune_key (
+                long data_num_samples, long data_k, long data_nr, long data_nc,
+                long filters_num_samples, long filters_nr, long filters_nc,
+                int stride_y, int stride_x,
+                int padding_y, int padding_x
+            )
+            {
+                int device = 0;
+                CHECK_CUDA(cudaGetDevice(&device));
+                cudaDeviceProp props;
+                CHECK_CUDA(cudaGetDeviceProperties(&props, device));
+
+                std::ostringstream sout;
+                sout << props.name
+                     << " data:" << data_num_samples << "x" << data_k << "x" << data_nr << "x" << data_nc
+                     << " filters:" << filters_num_samples << "x" << filters_nr << "x" << filters_nc
+                     << " stride:" << stride_y << "x" << stride_x
+                     << " padding:" << padding_y << "x" << padding_x
+                     << " fastest:" << dnn_prefer_fastest_algorithms();
+                return sout.str();
+            }
+
+            bool lookup_conv_autotune_cache (
+                const std::string& key,
+                int& forward_algo,
+                int& backward_data_algo,
+                int& backward_filters_algo
+            )
+            {
+                std::lock_guard<std::mutex> lock(conv_autotune_mutex());
+                auto i = conv_autotune_table().find(key);
+                if (i == conv_autotune_table().end() || i->second.size() != 3)
+                    return false;
+                forward_algo = i->second[0];
+                backward_data_algo = i->second[1];
+                backward_filters_algo = i->second[2];
+                return true;
+            }
+
+            void update_conv_autotune_cache (
+                const std::string& key,
+                int forward_algo,
+                int backward_data_algo,
+                int backward_filters_algo
+            )
+            {
+                std::lock_guard<std::mutex> lock(conv_autotune_mutex());
+                auto& table = conv_autotune_table();
+                table[key] = {forward_algo, backward_data_algo, backward_filters_algo};
+                const std::string filename = dnn_conv_autotune_cache_filename();
+                if (filename.size() != 0)
+                {
+                    // The cache is advisory, so if the file can't be written we just
+                    // carry on with the in-memory copy.
+                    try
+                    {
+                        std::ofstream fout(filename.c_str(), std::ios::binary);
+                        if (fout)
+                            serialize(table, fout);
+                    }
+                    catch (serialization_error&)
+                    {
+                    }
+                }
+            }
+
+            template <typename perf_type>
+            int pick_best_benchmarked_algo (
+                const perf_type* perf,
+                int count
+            )
+            {
+                // cudnnFind*Algorithm() returns its results sorted from fastest to
+                // slowest, so take the first one that actually ran.  When the user asked
+                // for the smallest algorithms, prefer the fastest one that needs no
+                // workspace.
+                if (!dnn_prefer_fastest_algorithms())
+                {
+                    for (int i = 0; i < count; ++i)
+                    {
+                        if (perf[i].status == CUDNN_STATUS_SUCCESS && perf[i].memory == 0)
+                            return (int)perf[i].algo;
+                    }
+                }
+                for (int i = 0; i < count; ++i)
+                {
+                    if (perf[i].status == CUDNN_STATUS_SUCCESS)
+                        return (int)perf[i].algo;
+                }
+                return -1;
+            }
+        }
+
     // ------------------------------------------------------------------------------------
 
         tensor_conv::
         tensor_conv(
-        ) : 
+        ) :
             filter_handle(nullptr),
             conv_handle(nullptr),
             forward_algo(0),
@@ -838,20 +984,91 @@ namespace dlib
                 tensor_descriptor dest_desc;
                 dest_desc.set_size(out_num_samples,out_k,out_nr,out_nc);
 
+                // When autotuning is enabled we pick algorithms by benchmarking the
+                // candidate kernels on this exact shape rather than trusting cuDNN's
+                // heuristic, since the heuristic sometimes picks kernels well off the
+                // fastest.  The winners are cached, keyed by GPU model and shape, so
+                // the benchmarking only happens the first time a shape is seen.
+                int tuned_forward = -1;
+                int tuned_backward_data = -1;
+                int tuned_backward_filters = -1;
+                if (dnn_conv_autotuning_enabled())
+                {
+                    const std::string key = conv_autotune_key(
+                        data_num_samples, data_k, data_nr, data_nc,
+                        filters_num_samples, filters_nr, filters_nc,
+                        stride_y, stride_x, padding_y, padding_x);
+                    if (!lookup_conv_autotune_cache(key, tuned_forward, tuned_backward_data, tuned_backward_filters))
+                    {
+                        const int max_algos = 8;
+                        int num_algos;
+
+                        cudnnConvolutionFwdAlgoPerf_t forward_perf[max_algos];
+                        CHECK_CUDNN(cudnnFindConvolutionForwardAlgorithm(
+                                context(),
+                                descriptor(data),
+                                (const cudnnFilterDescriptor_t)filter_handle,
+                                (const cudnnConvolutionDescriptor_t)conv_handle,
+                                descriptor(dest_desc),
+                                max_algos,
+                                &num_algos,
+                                forward_perf));
+                        tuned_forward = pick_best_benchmarked_algo(forward_perf, num_algos);
+
+                        cudnnConvolutionBwdDataAlgoPerf_t backward_data_perf[max_algos];
+                        CHECK_CUDNN(cudnnFindConvolutionBackwardDataAlgorithm(
+                                context(),
+                                (const cudnnFilterDescriptor_t)filter_handle,
+                                descriptor(dest_desc),
+                                (const cudnnConvolutionDescriptor_t)conv_handle,
+                                descriptor(data),
+                                max_algos,
+                                &num_algos,
+                                backward_data_perf));
+                        tuned_backward_data = pick_best_benchmarked_algo(backward_data_perf, num_algos);
+
+                        cudnnConvolutionBwdFilterAlgoPerf_t backward_filters_perf[max_algos];
+                        CHECK_CUDNN(cudnnFindConvolutionBackwardFilterAlgorithm(
+                                context(),
+                                descriptor(data),
+                                descriptor(dest_desc),
+                                (const cudnnConvolutionDescriptor_t)conv_handle,
+                                (const cudnnFilterDescriptor_t)filter_handle,
+                                max_algos,
+                                &num_algos,
+                                backward_filters_perf));
+                        tuned_backward_filters = pick_best_benchmarked_algo(backward_filters_perf, num_algos);
+
+                        if (tuned_forward != -1 && tuned_backward_data != -1 && tuned_backward_filters != -1)
+                            update_conv_autotune_cache(key, tuned_forward, tuned_backward_data, tuned_backward_filters);
+                    }
+                }
+                const bool use_tuned_algos = tuned_forward != -1 &&
+                                             tuned_backward_data != -1 &&
+                                             tuned_backward_filters != -1;
+
                 // Pick which forward algorithm we will use and allocate the necessary
                 // workspace buffer.
                 cudnnConvolutionFwdAlgo_t forward_best_algo;
-                CHECK_CUDNN(cudnnGetConvolutionForwardAlgorithm(
-                        context(), 
-                        descriptor(data),
-                        (const cudnnFilterDescriptor_t)filter_handle,
-                        (const cudnnConvolutionDescriptor_t)conv_handle,
-                        descriptor(dest_desc),
-                        dnn_prefer_fastest_algorithms()?CUDNN_CONVOLUTION_FWD_PREFER_FASTEST:CUDNN_CONVOLUTION_FWD_NO_WORKSPACE,
-                        std::numeric_limits<size_t>::max(),
-                        &forward_best_algo));
-                // forward_algo = forward_best_algo;
-                CHECK_CUDNN(cudnnGetConvolutionForwardWorkspaceSize( 
+                if (use_tuned_algos)
+                {
+                    forward_best_algo = (cudnnConvolutionFwdAlgo_t)tuned_forward;
+                    forward_algo = forward_best_algo;
+                }
+                else
+                {
+                    CHECK_CUDNN(cudnnGetConvolutionForwardAlgorithm(
+                            context(),
+                            descriptor(data),
+                            (const cudnnFilterDescriptor_t)filter_handle,
+                            (const cudnnConvolutionDescriptor_t)conv_handle,
+                            descriptor(dest_desc),
+                            dnn_prefer_fastest_algorithms()?CUDNN_CONVOLUTION_FWD_PREFER_FASTEST:CUDNN_CONVOLUTION_FWD_NO_WORKSPACE,
+                            std::numeric_limits<size_t>::max(),
+                            &forward_best_algo));
+                    // forward_algo = forward_best_algo;
+                }
+                CHECK_CUDNN(cudnnGetConvolutionForwardWorkspaceSize(
                         context(),
                         descriptor(data),
                         (const cudnnFilterDescriptor_t)filter_handle,
@@ -863,15 +1080,22 @@ namespace dlib
                 // Pick which backward data algorithm we will use and allocate the
                 // necessary workspace buffer.
                 cudnnConvolutionBwdDataAlgo_t backward_data_best_algo;
-                CHECK_CUDNN(cudnnGetConvolutionBackwardDataAlgorithm(
-                        context(),
-                        (const cudnnFilterDescriptor_t)filter_handle,
-                        descriptor(dest_desc),
-                        (const cudnnConvolutionDescriptor_t)conv_handle,
-                        descriptor(data),
-                        dnn_prefer_fastest_algorithms()?CUDNN_CONVOLUTION_BWD_DATA_PREFER_FASTEST:CUDNN_CONVOLUTION_BWD_DATA_NO_WORKSPACE,
-                        std::numeric_limits<size_t>::max(),
-                        &backward_data_best_algo));
+                if (use_tuned_algos)
+                {
+                    backward_data_best_algo = (cudnnConvolutionBwdDataAlgo_t)tuned_backward_data;
+                }
+                else
+                {
+                    CHECK_CUDNN(cudnnGetConvolutionBackwardDataAlgorithm(
+                            context(),
+                            (const cudnnFilterDescriptor_t)filter_handle,
+                            descriptor(dest_desc),
+                            (const cudnnConvolutionDescriptor_t)conv_handle,
+                            descriptor(data),
+                            dnn_prefer_fastest_algorithms()?CUDNN_CONVOLUTION_BWD_DATA_PREFER_FASTEST:CUDNN_CONVOLUTION_BWD_DATA_NO_WORKSPACE,
+                            std::numeric_limits<size_t>::max(),
+                            &backward_data_best_algo));
+                }
                 backward_data_algo = backward_data_best_algo;
 
                 CHECK_CUDNN(cudnnGetConvolutionBackwardDataWorkspaceSize(
@@ -886,27 +1110,43 @@ namespace dlib
                 // Pick which backward filters algorithm we will use and allocate the
                 // necessary workspace buffer.
                 cudnnConvolutionBwdFilterAlgo_t backward_filters_best_algo;
-                CHECK_CUDNN(cudnnGetConvolutionBackwardFilterAlgorithm(
-                        context(),
-                        descriptor(data),
-                        descriptor(dest_desc),
-                        (const cudnnConvolutionDescriptor_t)conv_handle,
-                        (const cudnnFilterDescriptor_t)filter_handle,
-                        dnn_prefer_fastest_algorithms()?CUDNN_CONVOLUTION_BWD_FILTER_PREFER_FASTEST:CUDNN_CONVOLUTION_BWD_FILTER_NO_WORKSPACE,
-                        std::numeric_limits<size_t>::max(),
-                        &backward_filters_best_algo));
-                // cuDNN 5.1 has a bug that causes
-                // cudnnGetConvolutionBackwardFilterAlgorithm() to pick the winograd
-                // algorithm even for cases where cuDNN doesn't support it, leading to
-                // incorrect outputs.  So here we check if we are in a case where winograd
-                // isn't supported and manually overrule
-                // cudnnGetConvolutionBackwardFilterAlgorithm() by picking a safe
-                // algorithm.
-                if (dnn_prefer_fastest_algorithms() && 
-                    !(stride_x == 1 && stride_y == 1 && ((filters_nr==3&&filters_nc==3) || (filters_nr==5&&filters_nc==5)))
-                    )
+                if (use_tuned_algos)
+                {
+                    backward_filters_best_algo = (cudnnConvolutionBwdFilterAlgo_t)tuned_backward_filters;
+                    // The cuDNN 5.1 winograd bug described below produces incorrect
+                    // outputs no matter how the algorithm got picked, so overrule a
+                    // benchmarked winograd choice on the shapes it can't handle.
+                    if (backward_filters_best_algo == CUDNN_CONVOLUTION_BWD_FILTER_ALGO_WINOGRAD &&
+                        !(stride_x == 1 && stride_y == 1 && ((filters_nr==3&&filters_nc==3) || (filters_nr==5&&filters_nc==5)))
+                        )
+                    {
+                        backward_filters_best_algo = CUDNN_CONVOLUTION_BWD_FILTER_ALGO_0;
+                    }
+                }
+                else
                 {
-                    backward_filters_best_algo = CUDNN_CONVOLUTION_BWD_FILTER_ALGO_0;
+                    CHECK_CUDNN(cudnnGetConvolutionBackwardFilterAlgorithm(
+                            context(),
+                            descriptor(data),
+                            descriptor(dest_desc),
+                            (const cudnnConvolutionDescriptor_t)conv_handle,
+                            (const cudnnFilterDescriptor_t)filter_handle,
+                            dnn_prefer_fastest_algorithms()?CUDNN_CONVOLUTION_BWD_FILTER_PREFER_FASTEST:CUDNN_CONVOLUTION_BWD_FILTER_NO_WORKSPACE,
+                            std::numeric_limits<size_t>::max(),
+                            &backward_filters_best_algo));
+                    // cuDNN 5.1 has a bug that causes
+                    // cudnnGetConvolutionBackwardFilterAlgorithm() to pick the winograd
+                    // algorithm even for cases where cuDNN doesn't support it, leading to
+                    // incorrect outputs.  So here we check if we are in a case where winograd
+                    // isn't supported and manually overrule
+                    // cudnnGetConvolutionBackwardFilterAlgorithm() by picking a safe
+                    // algorithm.
+                    if (dnn_prefer_fastest_algorithms() &&
+                        !(stride_x == 1 && stride_y == 1 && ((filters_nr==3&&filters_nc==3) || (filters_nr==5&&filters_nc==5)))
+                        )
+                    {
+                        backward_filters_best_algo = CUDNN_CONVOLUTION_BWD_FILTER_ALGO_0;
+                    }
                 }
                 backward_filters_algo = backward_filters_best_algo;
 
@@ -9,13 +9,147 @@
 
 #include "gpu_data.h"
 #include <iostream>
+#include <mutex>
 #include "cuda_utils.h"
 #include <cstring>
 #include <cuda.h>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace dlib
 {
 
+// ----------------------------------------------------------------------------------------
+
+    namespace
+    {
+        std::mutex& host_buffer_policy_mutex()
+        {
+            static std::mutex m;
+            return m;
+        }
+
+        host_buffer_policy& host_buffer_policy_storage()
+        {
+            static host_buffer_policy policy;
+            return policy;
+        }
+    }
+
+    void set_host_buffer_policy(const host_buffer_policy& policy)
+    {
+        std::lock_guard<std::mutex> lock(host_buffer_policy_mutex());
+        host_buffer_policy_storage() = policy;
+    }
+
+    host_buffer_policy get_host_buffer_policy()
+    {
+        std::lock_guard<std::mutex> lock(host_buffer_policy_mutex());
+        return host_buffer_policy_storage();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    namespace
+    {
+#ifdef __linux__
+        void bind_to_numa_node (
+            void* ptr,
+            size_t bytes,
+            int node
+        )
+        {
+            // Ask the kernel to prefer placing these pages on the requested node.  We
+            // use MPOL_PREFERRED rather than a strict binding so that allocation still
+            // succeeds if the node is out of memory, and we ignore any error since
+            // NUMA placement is purely a performance hint.
+            const int MPOL_PREFERRED_ = 1;
+            unsigned long nodemask = 1ul << node;
+            syscall(SYS_mbind, ptr, bytes, MPOL_PREFERRED_, &nodemask,
+                    sizeof(nodemask)*8, 0);
+        }
+#endif
+
+        // Allocates bytes of pinned host memory, honoring the current
+        // host_buffer_policy when the platform allows it and falling back to a plain
+        // cudaMallocHost() when it doesn't.  The returned pointer owns the memory and
+        // releases it, whichever way it was allocated, when the last reference dies.
+        std::shared_ptr<float> allocate_host_buffer (
+            size_t bytes
+        )
+        {
+            const host_buffer_policy policy = get_host_buffer_policy();
+
+#ifdef __linux__
+            if (policy.numa_node >= 0 || policy.use_huge_pages)
+            {
+                // round up to whole 2MB pages so MAP_HUGETLB can be used
+                const size_t huge_page_size = 2*1024*1024;
+                size_t len = bytes;
+                int flags = MAP_PRIVATE|MAP_ANONYMOUS;
+                if (policy.use_huge_pages)
+                {
+                    len = (bytes + huge_page_size-1)/huge_page_size*huge_page_size;
+                    flags |= MAP_HUGETLB;
+                }
+
+                void* data = mmap(nullptr, len, PROT_READ|PROT_WRITE, flags, -1, 0);
+                if (data == MAP_FAILED && policy.use_huge_pages)
+                {
+                    // No huge pages available right now.  Fall back to normal pages
+                    // but ask for transparent huge pages, which gets us the same TLB
+                    // benefit when the kernel can manage it.
+                    len = bytes;
+                    data = mmap(nullptr, len, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+                    if (data != MAP_FAILED)
+                        madvise(data, len, MADV_HUGEPAGE);
+#endif
+                }
+
+                if (data != MAP_FAILED)
+                {
+                    if (policy.numa_node >= 0)
+                        bind_to_numa_node(data, len, policy.numa_node);
+
+                    // Now pin the pages so cudaMemcpyAsync() can DMA straight out of
+                    // them, just like cudaMallocHost() memory.
+                    if (cudaHostRegister(data, len, cudaHostRegisterDefault) == cudaSuccess)
+                    {
+                        const size_t mapped_len = len;
+                        return std::shared_ptr<float>((float*)data, [mapped_len](float* ptr){
+                            auto err = cudaHostUnregister(ptr);
+                            if(err!=cudaSuccess)
+                                std::cerr << "cudaHostUnregister() failed. Reason: " << cudaGetErrorString(err) << std::endl;
+                            munmap(ptr, mapped_len);
+                        });
+                    }
+
+                    // Couldn't pin this memory, so give it back and fall through to
+                    // the plain cudaMallocHost() path.
+                    cudaGetLastError();
+                    munmap(data, len);
+                }
+            }
+#endif // __linux__
+
+            void* data;
+            CHECK_CUDA(cudaMallocHost(&data, bytes));
+            // Note that we don't throw exceptions since the free calls are invariably
+            // called in destructors.  They also shouldn't fail anyway unless someone
+            // is resetting the GPU card in the middle of their program.
+            return std::shared_ptr<float>((float*)data, [](float* ptr){
+                auto err = cudaFreeHost(ptr);
+                if(err!=cudaSuccess)
+                    std::cerr << "cudaFreeHost() failed. Reason: " << cudaGetErrorString(err) << std::endl;
+            });
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     void memcpy (
@@ -204,17 +338,9 @@ namespace dlib
                 data_host.reset();
                 data_device.reset();
 
-                void* data;
-                CHECK_CUDA(cudaMallocHost(&data, new_size*sizeof(float)));
-                // Note that we don't throw exceptions since the free calls are invariably
-                // called in destructors.  They also shouldn't fail anyway unless someone
-                // is resetting the GPU card in the middle of their program.
-                data_host.reset((float*)data, [](float* ptr){
-                    auto err = cudaFreeHost(ptr);
-                    if(err!=cudaSuccess)
-                        std::cerr << "cudaFreeHost() failed. Reason: " << cudaGetErrorString(err) << std::endl;
-                });
+                data_host = allocate_host_buffer(new_size*sizeof(float));
 
+                void* data;
                 CHECK_CUDA(cudaMalloc(&data, new_size*sizeof(float)));
                 data_device.reset((float*)data, [](float* ptr){
                     auto err = cudaFree(ptr);
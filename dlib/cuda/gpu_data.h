@@ -14,7 +14,34 @@ namespace dlib
 
 // ----------------------------------------------------------------------------------------
 
-    class gpu_data 
+    struct host_buffer_policy
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object describes how gpu_data objects should allocate their pinned
+                host side buffers.  See set_host_buffer_policy() for details.
+        !*/
+
+        // The NUMA node host buffers should be placed on, or -1 to let the OS place
+        // them wherever it likes.
+        int numa_node = -1;
+
+        // If true then host buffers are backed by huge (2MB) pages when the OS can
+        // provide them.
+        bool use_huge_pages = false;
+    };
+
+#ifdef DLIB_USE_CUDA
+    void set_host_buffer_policy(const host_buffer_policy& policy);
+    host_buffer_policy get_host_buffer_policy();
+#else
+    inline void set_host_buffer_policy(const host_buffer_policy&) {}
+    inline host_buffer_policy get_host_buffer_policy() { return host_buffer_policy(); }
+#endif
+
+// ----------------------------------------------------------------------------------------
+
+    class gpu_data
     {
         /*!
             CONVENTION
@@ -11,7 +11,61 @@ namespace dlib
 
 // ----------------------------------------------------------------------------------------
 
-    class gpu_data 
+    struct host_buffer_policy
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object describes how gpu_data objects (and therefore tensor and
+                resizable_tensor objects, which store their memory in gpu_data) should
+                allocate their pinned host side buffers.
+
+                On a multi-socket machine, setting numa_node lets you keep a data
+                loading thread, its staging buffers, and the GPU it feeds all on the
+                same socket so host-to-device copies don't cross the inter-socket
+                link.  Setting use_huge_pages backs the buffers with 2MB pages, which
+                reduces TLB pressure when staging large batches.
+
+                Both fields are strictly performance hints.  If the platform can't
+                honor them (e.g. no huge pages are available, or the build isn't on
+                Linux) then allocation silently falls back to a plain cudaMallocHost()
+                and everything still works.
+        !*/
+
+        // The NUMA node host buffers should be placed on, or -1 to let the OS place
+        // them wherever it likes.
+        int numa_node = -1;
+
+        // If true then host buffers are backed by huge (2MB) pages when the OS can
+        // provide them.
+        bool use_huge_pages = false;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    void set_host_buffer_policy(
+        const host_buffer_policy& policy
+    );
+    /*!
+        ensures
+            - #get_host_buffer_policy() == policy
+            - Host buffers allocated by gpu_data after this call honor the given
+              policy.  Buffers that already exist are unaffected.
+            - A thread that wants its tensors on a particular NUMA node should call
+              this before allocating them, typically once at startup.
+            - If DLIB_USE_CUDA is not #defined then this function does nothing.
+    !*/
+
+    host_buffer_policy get_host_buffer_policy(
+    );
+    /*!
+        ensures
+            - returns the policy most recently given to set_host_buffer_policy(), or a
+              default constructed host_buffer_policy if it was never called.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    class gpu_data
     {
         /*!
             WHAT THIS OBJECT REPRESENTS
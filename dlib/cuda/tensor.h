@@ -9,6 +9,7 @@
 #include "cudnn_dlibapi.h"
 #include "gpu_data.h"
 #include "../byte_orderer.h"
+#include "../fp16.h"
 #include <memory>
 #include "../any.h"
 
@@ -492,6 +493,58 @@ namespace dlib
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    inline void serialize_fp16(const tensor& item, std::ostream& out)
+    {
+        int version = 1;
+        serialize(version, out);
+        serialize(item.num_samples(), out);
+        serialize(item.k(), out);
+        serialize(item.nr(), out);
+        serialize(item.nc(), out);
+        byte_orderer bo;
+        auto sbuf = out.rdbuf();
+        for (auto d : item)
+        {
+            // Write the data as 2 byte little endian IEEE half precision floats.  This
+            // makes the output half the size of the regular tensor serialization at the
+            // cost of rounding each value to the nearest half precision float, which is
+            // fine for storing trained network parameters.
+            uint16 h = float_to_fp16(d);
+            bo.host_to_little(h);
+            sbuf->sputn((char*)&h, sizeof(h));
+        }
+    }
+
+    inline void deserialize_fp16(resizable_tensor& item, std::istream& in)
+    {
+        int version;
+        deserialize(version, in);
+        if (version != 1)
+            throw serialization_error("Unexpected version found while deserializing a half precision dlib::resizable_tensor.");
+
+        long long num_samples=0, k=0, nr=0, nc=0;
+        deserialize(num_samples, in);
+        deserialize(k, in);
+        deserialize(nr, in);
+        deserialize(nc, in);
+        item.set_size(num_samples, k, nr, nc);
+        byte_orderer bo;
+        auto sbuf = in.rdbuf();
+        for (auto& d : item)
+        {
+            uint16 h;
+            if (sbuf->sgetn((char*)&h,sizeof(h)) != sizeof(h))
+            {
+                in.setstate(std::ios::badbit);
+                throw serialization_error("Error reading data while deserializing a half precision dlib::resizable_tensor.");
+            }
+            bo.little_to_host(h);
+            d = fp16_to_float(h);
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     inline double dot(
@@ -569,6 +569,19 @@ namespace dlib
         serialize to/from any combination of tenor and resizable_tensor objects.
     !*/
 
+    void serialize_fp16(const tensor& item, std::ostream& out);
+    void deserialize_fp16(resizable_tensor& item, std::istream& in);
+    /*!
+        provides half precision serialization support for tensor and resizable_tensor.
+        These routines behave like serialize()/deserialize() above except that each
+        element is stored as a 2 byte IEEE 754 binary16 value instead of a 4 byte
+        float.  The output is therefore half the size, at the cost of rounding each
+        element to the nearest half precision value (about 3 decimal digits).  This is
+        a useful way to store trained network parameters, which tolerate this rounding
+        well.  Note that the formats are not interchangeable: a tensor written with
+        serialize_fp16() must be read back with deserialize_fp16().
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     double dot(
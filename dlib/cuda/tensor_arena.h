@@ -0,0 +1,174 @@
+// Copyright (C) 2015  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_DNn_TENSOR_ARENA_H_
+#define DLIB_DNn_TENSOR_ARENA_H_
+
+#include "tensor_arena_abstract.h"
+#include "tensor.h"
+#include <algorithm>
+#include <vector>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class tensor_arena
+    {
+        /*!
+            CONVENTION
+                - requests.size() == num_tensors()
+                - if (is_planned()) then
+                    - slab.size() == slab_size()
+                    - for all valid i: requests[i].offset is the offset into slab, in
+                      floats, where tensor i's memory begins.  The planner guarantees
+                      that two tensors only share memory if their [first_use,last_use]
+                      intervals don't intersect.
+        !*/
+    public:
+
+        tensor_arena() = default;
+
+        size_t add_tensor (
+            long long n,
+            long long k,
+            long long nr,
+            long long nc,
+            unsigned long first_use,
+            unsigned long last_use
+        )
+        {
+            DLIB_CASSERT(n >= 0 && k >= 0 && nr >= 0 && nc >= 0);
+            DLIB_CASSERT(first_use <= last_use,
+                "first_use: " << first_use << "\n" <<
+                "last_use:  " << last_use);
+
+            request temp;
+            temp.a = alias_tensor(n,k,nr,nc);
+            temp.first_use = first_use;
+            temp.last_use = last_use;
+            temp.offset = 0;
+            requests.push_back(temp);
+            planned = false;
+            return requests.size()-1;
+        }
+
+        size_t num_tensors (
+        ) const { return requests.size(); }
+
+        bool is_planned (
+        ) const { return planned; }
+
+        void plan (
+        )
+        {
+            // Place the big tensors first.  Greedily assigning each tensor the lowest
+            // offset that doesn't collide with an already placed tensor of overlapping
+            // lifetime gives a tight packing in practice and never does worse than
+            // giving every tensor its own allocation.
+            std::vector<size_t> order(requests.size());
+            for (size_t i = 0; i < order.size(); ++i)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+            { return requests[a].a.size() > requests[b].a.size(); });
+
+            size_t total = 0;
+            std::vector<size_t> placed;
+            placed.reserve(requests.size());
+            for (size_t i : order)
+            {
+                request& req = requests[i];
+                // Tensors of zero size never touch the slab so they can all live at
+                // offset 0.
+                if (req.a.size() == 0)
+                {
+                    req.offset = 0;
+                    continue;
+                }
+
+                // Find the lowest offset where req doesn't overlap, in both memory and
+                // lifetime, any tensor placed so far.  Bumping the candidate offset
+                // past each conflicting tensor and rescanning terminates because every
+                // bump moves the offset strictly forward.
+                size_t offset = 0;
+                bool conflicted = true;
+                while (conflicted)
+                {
+                    conflicted = false;
+                    for (size_t j : placed)
+                    {
+                        const request& other = requests[j];
+                        if (req.last_use < other.first_use || other.last_use < req.first_use)
+                            continue;
+                        if (offset+req.a.size() <= other.offset || other.offset+other.a.size() <= offset)
+                            continue;
+                        offset = other.offset + other.a.size();
+                        conflicted = true;
+                    }
+                }
+                req.offset = offset;
+                total = std::max(total, offset+req.a.size());
+                placed.push_back(i);
+            }
+
+            slab.set_size(total);
+            planned = true;
+        }
+
+        size_t slab_size (
+        ) const
+        {
+            DLIB_CASSERT(is_planned());
+            return slab.size();
+        }
+
+        alias_tensor_instance operator[] (
+            size_t idx
+        )
+        {
+            DLIB_CASSERT(is_planned());
+            DLIB_CASSERT(idx < num_tensors(),
+                "idx:           " << idx << "\n" <<
+                "num_tensors(): " << num_tensors());
+            return requests[idx].a(slab, requests[idx].offset);
+        }
+
+        alias_tensor_const_instance operator[] (
+            size_t idx
+        ) const
+        {
+            DLIB_CASSERT(is_planned());
+            DLIB_CASSERT(idx < num_tensors(),
+                "idx:           " << idx << "\n" <<
+                "num_tensors(): " << num_tensors());
+            return requests[idx].a(slab, requests[idx].offset);
+        }
+
+        void clear (
+        )
+        {
+            requests.clear();
+            slab.clear();
+            planned = false;
+        }
+
+    private:
+
+        struct request
+        {
+            alias_tensor a;
+            unsigned long first_use;
+            unsigned long last_use;
+            size_t offset;
+        };
+
+        std::vector<request> requests;
+        resizable_tensor slab;
+        bool planned = false;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_DNn_TENSOR_ARENA_H_
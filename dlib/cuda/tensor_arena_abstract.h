@@ -0,0 +1,163 @@
+// Copyright (C) 2015  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_DNn_TENSOR_ARENA_ABSTRACT_H_
+#ifdef DLIB_DNn_TENSOR_ARENA_ABSTRACT_H_
+
+#include "tensor_abstract.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class tensor_arena
+    {
+        /*!
+            INITIAL VALUE
+                - num_tensors() == 0
+                - is_planned() == false
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a planning allocator for tensors.  A network that
+                evaluates many layers allocates a tensor for each layer output, but at
+                any point during the evaluation only the tensors that are still going
+                to be read need to be resident in memory.  Giving each tensor its own
+                gpu_data allocation wastes memory and, on the GPU, fragments the
+                device heap.  This object instead takes a declaration of each tensor's
+                shape along with the interval of execution steps during which it is
+                alive and packs all of them into a single shared gpu_data slab, only
+                letting two tensors share memory when their lifetimes don't overlap.
+
+                Typical usage looks like:
+                    tensor_arena arena;
+                    // step numbers give each tensor's first and last use
+                    auto t0 = arena.add_tensor(n,k,nr,nc, 0, 1);
+                    auto t1 = arena.add_tensor(n,k,nr,nc, 1, 2);
+                    auto t2 = arena.add_tensor(n,k,nr,nc, 2, 3);
+                    arena.plan();
+                    auto out0 = arena[t0];  // a tensor you can read and write
+                    ...
+                Here t0 and t2 have disjoint lifetimes, so arena[t0] and arena[t2]
+                will normally end up on the same piece of memory and slab_size() will
+                be about 2 tensors worth of floats rather than 3.
+
+                Note that the tensors returned by operator[] alias the arena's
+                internal memory.  They are valid only as long as this object exists
+                and neither plan() nor clear() has been called again.
+        !*/
+    public:
+
+        tensor_arena(
+        );
+        /*!
+            ensures
+                - #num_tensors() == 0
+                - #is_planned() == false
+        !*/
+
+        size_t add_tensor (
+            long long n,
+            long long k,
+            long long nr,
+            long long nc,
+            unsigned long first_use,
+            unsigned long last_use
+        );
+        /*!
+            requires
+                - n >= 0, k >= 0, nr >= 0, nc >= 0
+                - first_use <= last_use
+            ensures
+                - Declares a tensor with the given dimensions that is alive during the
+                  execution steps first_use through last_use, inclusive.  The step
+                  numbers are in whatever units the caller likes (e.g. layer indices),
+                  all that matters is that two tensors with intersecting
+                  [first_use,last_use] intervals are never given the same memory.
+                - #num_tensors() == num_tensors() + 1
+                - #is_planned() == false
+                - returns the index of the new tensor, i.e. num_tensors().  You use
+                  this index with operator[] after calling plan().
+        !*/
+
+        size_t num_tensors (
+        ) const;
+        /*!
+            ensures
+                - returns the number of tensors that have been declared via
+                  add_tensor().
+        !*/
+
+        bool is_planned (
+        ) const;
+        /*!
+            ensures
+                - returns true if plan() has been called since the last call to
+                  add_tensor() or clear(), and false otherwise.
+        !*/
+
+        void plan (
+        );
+        /*!
+            ensures
+                - #is_planned() == true
+                - Assigns every declared tensor a location in a single shared memory
+                  slab such that tensors with intersecting lifetime intervals never
+                  overlap in memory, then allocates the slab.  Tensors with disjoint
+                  lifetimes are packed onto the same memory where possible, so
+                  #slab_size() is usually much smaller than the sum of the declared
+                  tensor sizes.
+                - Any tensors previously obtained from operator[] are invalidated.
+        !*/
+
+        size_t slab_size (
+        ) const;
+        /*!
+            requires
+                - is_planned() == true
+            ensures
+                - returns the total number of floats of backing memory the plan uses.
+        !*/
+
+        alias_tensor_instance operator[] (
+            size_t idx
+        );
+        /*!
+            requires
+                - is_planned() == true
+                - idx < num_tensors()
+            ensures
+                - returns a tensor with the dimensions given in the idx-th call to
+                  add_tensor() whose memory lives inside this object's shared slab.
+                - The returned tensor aliases this object.  It is valid until this
+                  object is destructed or plan() or clear() is called.
+        !*/
+
+        alias_tensor_const_instance operator[] (
+            size_t idx
+        ) const;
+        /*!
+            requires
+                - is_planned() == true
+                - idx < num_tensors()
+            ensures
+                - returns a const view of the tensor returned by the non-const version
+                  of this function.
+        !*/
+
+        void clear (
+        );
+        /*!
+            ensures
+                - #num_tensors() == 0
+                - #is_planned() == false
+                - frees the memory slab, invalidating any tensors previously obtained
+                  from operator[].
+        !*/
+
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_DNn_TENSOR_ARENA_ABSTRACT_H_
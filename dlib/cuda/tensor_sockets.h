@@ -0,0 +1,241 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_DNn_TENSOR_SOCKETS_H_
+#define DLIB_DNn_TENSOR_SOCKETS_H_
+
+#include "tensor_sockets_abstract.h"
+#include "tensor.h"
+#include <algorithm>
+#include <vector>
+#include "../sockets.h"
+#include "../serialize.h"
+#include "../byte_orderer.h"
+#include "../uintn.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+    /*
+        These functions send tensors and matrices over a connection with size-prefixed
+        framing.  Each object is one frame: a little endian uint64 giving the number of
+        payload bytes that follow, then a small fixed header describing the shape, then
+        the raw element bytes in host memory order.  Unlike going through a vectorstream
+        and a sockstreambuf, the element bytes move between the socket and the object's
+        own memory directly, so sending or receiving a tensor is single-copy.
+    */
+
+        inline void write_to_connection (
+            connection& con,
+            const char* buf,
+            size_t num
+        )
+        {
+            while (num != 0)
+            {
+                const long chunk = (long)std::min<size_t>(num, 1024*1024);
+                const long status = con.write(buf, chunk);
+                if (status != chunk)
+                    throw serialization_error("Error writing to a dlib::connection while serializing an object.");
+                buf += status;
+                num -= status;
+            }
+        }
+
+        inline void read_from_connection (
+            connection& con,
+            char* buf,
+            size_t num
+        )
+        {
+            while (num != 0)
+            {
+                const long status = con.read(buf, (long)std::min<size_t>(num, 1024*1024));
+                if (status <= 0)
+                    throw serialization_error("Error reading from a dlib::connection while deserializing an object.");
+                buf += status;
+                num -= status;
+            }
+        }
+
+        template <typename T>
+        void write_connection_value (
+            connection& con,
+            T value
+        )
+        {
+            byte_orderer bo;
+            bo.host_to_little(value);
+            write_to_connection(con, reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <typename T>
+        T read_connection_value (
+            connection& con
+        )
+        {
+            T value;
+            read_from_connection(con, reinterpret_cast<char*>(&value), sizeof(value));
+            byte_orderer bo;
+            bo.little_to_host(value);
+            return value;
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline void serialize (
+        const tensor& item,
+        connection& con
+    )
+    {
+        using namespace impl;
+        byte_orderer bo;
+        const uint64 payload_size = 4*sizeof(int64) + 1 + item.size()*sizeof(float);
+        write_connection_value<uint64>(con, payload_size);
+        write_connection_value<int64>(con, item.num_samples());
+        write_connection_value<int64>(con, item.k());
+        write_connection_value<int64>(con, item.nr());
+        write_connection_value<int64>(con, item.nc());
+        write_connection_value<uint8>(con, bo.host_is_little_endian() ? 1 : 0);
+        static_assert(sizeof(float)==4, "This serialization code assumes floats are 4 bytes");
+        write_to_connection(con, reinterpret_cast<const char*>(item.host()), item.size()*sizeof(float));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline void deserialize (
+        resizable_tensor& item,
+        connection& con
+    )
+    {
+        using namespace impl;
+        byte_orderer bo;
+        const uint64 payload_size = read_connection_value<uint64>(con);
+        const int64 num_samples = read_connection_value<int64>(con);
+        const int64 k = read_connection_value<int64>(con);
+        const int64 nr = read_connection_value<int64>(con);
+        const int64 nc = read_connection_value<int64>(con);
+        const uint8 wire_little_endian = read_connection_value<uint8>(con);
+        if (num_samples < 0 || k < 0 || nr < 0 || nc < 0 ||
+            payload_size != 4*sizeof(int64) + 1 + (uint64)(num_samples*k*nr*nc)*sizeof(float))
+        {
+            throw serialization_error("Corrupt frame found while deserializing a dlib::resizable_tensor from a connection.");
+        }
+
+        item.set_size(num_samples, k, nr, nc);
+        // Read the element bytes straight into the tensor's host memory.
+        float* const data = item.host_write_only();
+        read_from_connection(con, reinterpret_cast<char*>(data), item.size()*sizeof(float));
+        if ((wire_little_endian != 0) != bo.host_is_little_endian())
+            ser_helper::swap_block_bytes(reinterpret_cast<char*>(data), sizeof(float), item.size());
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T,
+        long NR,
+        long NC,
+        typename MM,
+        typename L
+        >
+    void serialize (
+        const matrix<T,NR,NC,MM,L>& item,
+        connection& con
+    )
+    {
+        using namespace impl;
+        COMPILE_TIME_ASSERT(ser_helper::is_block_serializable<T>::value);
+        byte_orderer bo;
+        const bool row_major = is_same_type<L,row_major_layout>::value;
+        const uint64 payload_size = 2*sizeof(int64) + 3 + (uint64)item.size()*sizeof(T);
+        write_connection_value<uint64>(con, payload_size);
+        write_connection_value<int64>(con, item.nr());
+        write_connection_value<int64>(con, item.nc());
+        write_connection_value<uint8>(con, ser_helper::block_element_code<T>());
+        write_connection_value<uint8>(con, bo.host_is_little_endian() ? 1 : 0);
+        write_connection_value<uint8>(con, row_major ? 1 : 0);
+        if (item.size() != 0)
+            write_to_connection(con, reinterpret_cast<const char*>(&item(0,0)), item.size()*sizeof(T));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T,
+        long NR,
+        long NC,
+        typename MM,
+        typename L
+        >
+    void deserialize (
+        matrix<T,NR,NC,MM,L>& item,
+        connection& con
+    )
+    {
+        using namespace impl;
+        COMPILE_TIME_ASSERT(ser_helper::is_block_serializable<T>::value);
+        byte_orderer bo;
+        const uint64 payload_size = read_connection_value<uint64>(con);
+        const int64 nr = read_connection_value<int64>(con);
+        const int64 nc = read_connection_value<int64>(con);
+        const uint8 element_code = read_connection_value<uint8>(con);
+        const uint8 wire_little_endian = read_connection_value<uint8>(con);
+        const uint8 wire_row_major = read_connection_value<uint8>(con);
+        if (nr < 0 || nc < 0 ||
+            payload_size != 2*sizeof(int64) + 3 + (uint64)(nr*nc)*sizeof(T))
+        {
+            throw serialization_error("Corrupt frame found while deserializing a dlib::matrix from a connection.");
+        }
+        if (element_code != ser_helper::block_element_code<T>())
+            throw serialization_error("Wrong matrix element type found while deserializing a dlib::matrix from a connection.");
+        if ((NR != 0 && nr != NR) || (NC != 0 && nc != NC))
+            throw serialization_error("Wrong matrix size found while deserializing a dlib::matrix from a connection.");
+
+        item.set_size(nr, nc);
+        if (item.size() == 0)
+            return;
+
+        const bool row_major = is_same_type<L,row_major_layout>::value;
+        const bool swap = (wire_little_endian != 0) != bo.host_is_little_endian();
+        if ((wire_row_major != 0) == row_major || nr == 1 || nc == 1)
+        {
+            // Layouts agree, so read the element bytes straight into the matrix.
+            char* const data = reinterpret_cast<char*>(&item(0,0));
+            read_from_connection(con, data, item.size()*sizeof(T));
+            if (swap)
+                ser_helper::swap_block_bytes(data, sizeof(T), item.size());
+        }
+        else
+        {
+            // The sender used the other storage layout, so we have to scatter the
+            // elements as they arrive.
+            std::vector<T> buf(std::min<size_t>(item.size(), ser_helper::block_format_chunk_bytes/sizeof(T)));
+            size_t idx = 0;
+            size_t remaining = item.size();
+            while (remaining != 0)
+            {
+                const size_t count = std::min(remaining, buf.size());
+                read_from_connection(con, reinterpret_cast<char*>(buf.data()), count*sizeof(T));
+                if (swap)
+                    ser_helper::swap_block_bytes(reinterpret_cast<char*>(buf.data()), sizeof(T), count);
+                for (size_t i = 0; i < count; ++i, ++idx)
+                {
+                    const long r = wire_row_major ? idx/nc : idx%nr;
+                    const long c = wire_row_major ? idx%nc : idx/nr;
+                    item(r,c) = buf[i];
+                }
+                remaining -= count;
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_DNn_TENSOR_SOCKETS_H_
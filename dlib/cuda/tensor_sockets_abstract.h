@@ -0,0 +1,107 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_DNn_TENSOR_SOCKETS_ABSTRACT_H_
+#ifdef DLIB_DNn_TENSOR_SOCKETS_ABSTRACT_H_
+
+#include "tensor_abstract.h"
+#include "../matrix/matrix_abstract.h"
+#include "../sockets/sockets_kernel_abstract.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    void serialize (
+        const tensor& item,
+        connection& con
+    );
+    /*!
+        ensures
+            - writes item to the given connection as one size-prefixed frame.  The
+              element bytes are written straight from the tensor's host memory, so no
+              intermediate buffers or streams are involved.
+        throws
+            - dlib::serialization_error
+                This exception is thrown if the connection returns an error or is closed
+                before the whole frame has been written.
+    !*/
+
+    void deserialize (
+        resizable_tensor& item,
+        connection& con
+    );
+    /*!
+        ensures
+            - reads one frame written by the above serialize() routine from the given
+              connection and stores it in #item.  The element bytes are read straight
+              into the tensor's host_write_only() memory, so receiving a tensor is
+              single-copy.
+        throws
+            - dlib::serialization_error
+                This exception is thrown if the connection returns an error or is closed
+                before the whole frame has been read, or if the frame is corrupt.  In
+                these cases #item has an unspecified value.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T,
+        long NR,
+        long NC,
+        typename MM,
+        typename L
+        >
+    void serialize (
+        const matrix<T,NR,NC,MM,L>& item,
+        connection& con
+    );
+    /*!
+        requires
+            - T is a built-in integral type other than bool, or is float or double
+        ensures
+            - writes item to the given connection as one size-prefixed frame.  The
+              element bytes are written straight from the matrix's own memory, so no
+              intermediate buffers or streams are involved.
+        throws
+            - dlib::serialization_error
+                This exception is thrown if the connection returns an error or is closed
+                before the whole frame has been written.
+    !*/
+
+    template <
+        typename T,
+        long NR,
+        long NC,
+        typename MM,
+        typename L
+        >
+    void deserialize (
+        matrix<T,NR,NC,MM,L>& item,
+        connection& con
+    );
+    /*!
+        requires
+            - T is a built-in integral type other than bool, or is float or double
+        ensures
+            - reads one frame written by the above serialize() routine from the given
+              connection and stores it in #item.  The sender and receiver must use the
+              same element type T, but may use different storage layouts and byte
+              orders.  When the layouts and byte orders agree, which is the common
+              case, the element bytes are read straight into the matrix's memory and
+              the transfer is single-copy.
+        throws
+            - dlib::serialization_error
+                This exception is thrown if the connection returns an error or is closed
+                before the whole frame has been read, if the frame is corrupt, or if
+                the frame doesn't contain a matrix with element type T of a size
+                capable of being stored in #item.  In these cases #item has an
+                unspecified value.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_DNn_TENSOR_SOCKETS_ABSTRACT_H_
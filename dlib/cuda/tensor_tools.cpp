@@ -5,7 +5,9 @@
 
 #include "tensor_tools.h"
 #include "../string.h"
+#include "../threads.h"
 #include <atomic>
+#include <mutex>
 
 namespace dlib
 {
@@ -17,6 +19,27 @@ namespace dlib
             static std::atomic<bool> var(true);
             return var;
         }
+
+        std::atomic<bool>& dnn_conv_autotuning (
+        )
+        {
+            static std::atomic<bool> var(false);
+            return var;
+        }
+
+        std::mutex& dnn_conv_autotune_cache_filename_mutex (
+        )
+        {
+            static std::mutex m;
+            return m;
+        }
+
+        std::string& dnn_conv_autotune_cache_filename_storage (
+        )
+        {
+            static std::string var;
+            return var;
+        }
     }
 
     bool dnn_prefer_fastest_algorithms (
@@ -36,6 +59,36 @@ namespace dlib
     {
         dnn_prefer_fastest_algo() = false;
     }
+
+    bool dnn_conv_autotuning_enabled (
+    )
+    {
+        return dnn_conv_autotuning();
+    }
+
+    std::string dnn_conv_autotune_cache_filename (
+    )
+    {
+        std::lock_guard<std::mutex> lock(dnn_conv_autotune_cache_filename_mutex());
+        return dnn_conv_autotune_cache_filename_storage();
+    }
+
+    void enable_dnn_conv_autotuning (
+        const std::string& cache_filename
+    )
+    {
+        {
+            std::lock_guard<std::mutex> lock(dnn_conv_autotune_cache_filename_mutex());
+            dnn_conv_autotune_cache_filename_storage() = cache_filename;
+        }
+        dnn_conv_autotuning() = true;
+    }
+
+    void disable_dnn_conv_autotuning (
+    )
+    {
+        dnn_conv_autotuning() = false;
+    }
 }
 
 namespace dlib { namespace tt
@@ -215,28 +268,78 @@ namespace dlib { namespace tt
 #ifdef DLIB_USE_CUDA
         cuda::gemm(beta, dest, alpha, lhs, trans_lhs, rhs, trans_rhs);
 #else
-        if (beta != 0)
+        const long M = dest.num_samples();
+        const long N = dest.size()/M;
+        const long K = trans_lhs ? lhs.num_samples() : lhs.size()/lhs.num_samples();
+
+        thread_pool& tp = default_thread_pool();
+        const long num_blocks = std::min<long>(tp.num_threads_in_pool()+1, M);
+
+        // Only thread multiplies big enough for the row blocks to dwarf the task
+        // dispatch overhead.  Small ones run exactly as before.
+        if (num_blocks < 2 || M*N*K < 1000000)
         {
-            if (trans_lhs && trans_rhs)
-                dest = alpha*trans(mat(lhs))*trans(mat(rhs)) + beta*mat(dest);
-            else if (!trans_lhs && trans_rhs)
-                dest = alpha*mat(lhs)*trans(mat(rhs)) + beta*mat(dest);
-            else if (trans_lhs && !trans_rhs)
-                dest = alpha*trans(mat(lhs))*mat(rhs) + beta*mat(dest);
+            if (beta != 0)
+            {
+                if (trans_lhs && trans_rhs)
+                    dest = alpha*trans(mat(lhs))*trans(mat(rhs)) + beta*mat(dest);
+                else if (!trans_lhs && trans_rhs)
+                    dest = alpha*mat(lhs)*trans(mat(rhs)) + beta*mat(dest);
+                else if (trans_lhs && !trans_rhs)
+                    dest = alpha*trans(mat(lhs))*mat(rhs) + beta*mat(dest);
+                else
+                    dest = alpha*mat(lhs)*mat(rhs) + beta*mat(dest);
+            }
             else
-                dest = alpha*mat(lhs)*mat(rhs) + beta*mat(dest);
+            {
+                if (trans_lhs && trans_rhs)
+                    dest = alpha*trans(mat(lhs))*trans(mat(rhs));
+                else if (!trans_lhs && trans_rhs)
+                    dest = alpha*mat(lhs)*trans(mat(rhs));
+                else if (trans_lhs && !trans_rhs)
+                    dest = alpha*trans(mat(lhs))*mat(rhs);
+                else
+                    dest = alpha*mat(lhs)*mat(rhs);
+            }
+            return;
         }
-        else
+
+        // Split dest's rows across the default thread pool.  Each thread computes a
+        // disjoint row block of the product, so the result is bit for bit identical
+        // to the serial computation no matter how the tasks get scheduled.
+        float* const d = dest.host();
+        lhs.host();
+        rhs.host();
+        parallel_for(tp, 0, num_blocks, [&](long i)
         {
-            if (trans_lhs && trans_rhs)
-                dest = alpha*trans(mat(lhs))*trans(mat(rhs));
-            else if (!trans_lhs && trans_rhs)
-                dest = alpha*mat(lhs)*trans(mat(rhs));
-            else if (trans_lhs && !trans_rhs)
-                dest = alpha*trans(mat(lhs))*mat(rhs);
+            const long rbegin = i*M/num_blocks;
+            const long rend = (i+1)*M/num_blocks;
+            const auto rows = range(rbegin, rend-1);
+            auto dblock = set_ptrm(d + rbegin*N, rend-rbegin, N);
+            if (beta != 0)
+            {
+                const auto dold = mat(d + rbegin*N, rend-rbegin, N);
+                if (trans_lhs && trans_rhs)
+                    dblock = alpha*trans(colm(mat(lhs),rows))*trans(mat(rhs)) + beta*dold;
+                else if (!trans_lhs && trans_rhs)
+                    dblock = alpha*rowm(mat(lhs),rows)*trans(mat(rhs)) + beta*dold;
+                else if (trans_lhs && !trans_rhs)
+                    dblock = alpha*trans(colm(mat(lhs),rows))*mat(rhs) + beta*dold;
+                else
+                    dblock = alpha*rowm(mat(lhs),rows)*mat(rhs) + beta*dold;
+            }
             else
-                dest = alpha*mat(lhs)*mat(rhs);
-        }
+            {
+                if (trans_lhs && trans_rhs)
+                    dblock = alpha*trans(colm(mat(lhs),rows))*trans(mat(rhs));
+                else if (!trans_lhs && trans_rhs)
+                    dblock = alpha*rowm(mat(lhs),rows)*trans(mat(rhs));
+                else if (trans_lhs && !trans_rhs)
+                    dblock = alpha*trans(colm(mat(lhs),rows))*mat(rhs);
+                else
+                    dblock = alpha*rowm(mat(lhs),rows)*mat(rhs);
+            }
+        });
 #endif
     }
 
@@ -944,6 +1047,154 @@ namespace dlib { namespace tt
 #endif
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void extract_image_chips (
+        tensor& chips,
+        const tensor& img,
+        const tensor& tforms
+    )
+    {
+#ifdef DLIB_USE_CUDA
+        cuda::extract_image_chips(chips, img, tforms);
+#else
+        cpu::extract_image_chips(chips, img, tforms);
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void disturb_colors (
+        tensor& img,
+        tensor_rand& rnd,
+        double gamma_magnitude,
+        double color_magnitude
+    )
+    {
+        resizable_tensor params(img.num_samples()*(img.k()+1));
+        rnd.fill_uniform(params);
+#ifdef DLIB_USE_CUDA
+        cuda::disturb_colors(img, params, gamma_magnitude, color_magnitude);
+#else
+        cpu::disturb_colors(img, params, gamma_magnitude, color_magnitude);
+#endif
+    }
+
+    void random_flip_images_left_right (
+        tensor& img,
+        tensor_rand& rnd,
+        double probability
+    )
+    {
+        resizable_tensor params(img.num_samples());
+        rnd.fill_uniform(params);
+#ifdef DLIB_USE_CUDA
+        cuda::flip_images_left_right(img, params, probability);
+#else
+        cpu::flip_images_left_right(img, params, probability);
+#endif
+    }
+
+    void random_crop_images (
+        tensor& dest,
+        const tensor& src,
+        tensor_rand& rnd,
+        double min_scale
+    )
+    {
+        resizable_tensor params(src.num_samples()*3);
+        rnd.fill_uniform(params);
+#ifdef DLIB_USE_CUDA
+        cuda::crop_images(dest, src, params, min_scale);
+#else
+        cpu::crop_images(dest, src, params, min_scale);
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void find_greater_than (
+        std::vector<std::pair<size_t,float>>& idxs_and_vals,
+        const tensor& t,
+        size_t begin,
+        size_t end,
+        float thresh
+    )
+    {
+#ifdef DLIB_USE_CUDA
+        cuda::find_greater_than(idxs_and_vals, t, begin, end, thresh);
+#else
+        cpu::find_greater_than(idxs_and_vals, t, begin, end, thresh);
+#endif
+    }
+
+    void gather (
+        std::vector<float>& vals,
+        const tensor& t,
+        const std::vector<size_t>& idxs
+    )
+    {
+#ifdef DLIB_USE_CUDA
+        cuda::gather(vals, t, idxs);
+#else
+        cpu::gather(vals, t, idxs);
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void sum_axis (
+        tensor& dest,
+        const tensor& src,
+        long axis
+    )
+    {
+#ifdef DLIB_USE_CUDA
+        cuda::sum_axis(dest, src, axis);
+#else
+        cpu::sum_axis(dest, src, axis);
+#endif
+    }
+
+    void mean_axis (
+        tensor& dest,
+        const tensor& src,
+        long axis
+    )
+    {
+#ifdef DLIB_USE_CUDA
+        cuda::mean_axis(dest, src, axis);
+#else
+        cpu::mean_axis(dest, src, axis);
+#endif
+    }
+
+    void max_axis (
+        tensor& dest,
+        const tensor& src,
+        long axis
+    )
+    {
+#ifdef DLIB_USE_CUDA
+        cuda::max_axis(dest, src, axis);
+#else
+        cpu::max_axis(dest, src, axis);
+#endif
+    }
+
+    void argmax_axis (
+        tensor& dest,
+        const tensor& src,
+        long axis
+    )
+    {
+#ifdef DLIB_USE_CUDA
+        cuda::argmax_axis(dest, src, axis);
+#else
+        cpu::argmax_axis(dest, src, axis);
+#endif
+    }
+
 // ------------------------------------------------------------------------------------
 
     void copy_tensor(
@@ -20,6 +20,32 @@ namespace dlib
     bool dnn_prefer_fastest_algorithms();
     void set_dnn_prefer_fastest_algorithms();
     void set_dnn_prefer_smallest_algorithms();
+
+    bool dnn_conv_autotuning_enabled();
+    std::string dnn_conv_autotune_cache_filename();
+    void enable_dnn_conv_autotuning(
+        const std::string& cache_filename = ""
+    );
+    /*!
+        ensures
+            - #dnn_conv_autotuning_enabled() == true
+            - #dnn_conv_autotune_cache_filename() == cache_filename
+            - When using CUDA, convolution algorithms are selected by benchmarking the
+              candidate cuDNN kernels on the actual layer shapes the first time each
+              shape is seen, rather than by asking cuDNN's heuristic which kernel it
+              expects to be fastest.  The winning {shape, algorithm} choices are
+              remembered for the rest of the process, and if cache_filename != ""
+              they are also saved to that file, keyed by GPU model, so later runs on
+              the same GPU skip the benchmarking entirely.
+    !*/
+    void disable_dnn_conv_autotuning();
+    /*!
+        ensures
+            - #dnn_conv_autotuning_enabled() == false
+            - convolution algorithms are selected by cuDNN's heuristic, as controlled
+              by set_dnn_prefer_fastest_algorithms() and
+              set_dnn_prefer_smallest_algorithms().
+    !*/
 }
 
 namespace dlib { namespace tt
@@ -985,6 +1011,49 @@ namespace dlib { namespace tt
                 - #output.nc() == 1+(data.nc() + 2*padding_x - filters.nc())/stride_x
         !*/
 
+        void operator() (
+            const bool add_to_output,
+            resizable_tensor& output,
+            const tensor& data,
+            const tensor& filters,
+            const tensor& biases
+        )
+        {
+#ifdef DLIB_USE_CUDA
+            impl(add_to_output,output,data,filters);
+            add(1,output,1,biases);
+#else
+            impl(add_to_output,output,data,filters,biases);
+#endif
+        }
+        /*!
+            requires
+                - same as the version of operator() without biases, and also:
+                - biases.size() == filters.num_samples()
+            ensures
+                - Equivalent to calling operator() without biases followed by
+                  add(1,output,1,biases), i.e. convolves and then adds biases(k) to
+                  every element of output channel k.  On the CPU the bias add is fused
+                  into the convolution kernels so the output tensor isn't traversed a
+                  second time.
+        !*/
+
+        void operator() (
+            const bool add_to_output,
+            tensor& output,
+            const tensor& data,
+            const tensor& filters,
+            const tensor& biases
+        )
+        {
+#ifdef DLIB_USE_CUDA
+            impl(add_to_output,output,data,filters);
+            add(1,output,1,biases);
+#else
+            impl(add_to_output,output,data,filters,biases);
+#endif
+        }
+
         void get_gradient_for_data (
             const bool add_to_output,
             const tensor& gradient_input, 
@@ -1082,9 +1151,29 @@ namespace dlib { namespace tt
                   particular, the reason the tensors are input into setup() is just to
                   observe their sizes.  setup() doesn't do anything with the contents of
                   the tensors, or store any kind of references to the data or filter
-                  tensors. 
+                  tensors.
         !*/
-       
+
+        void enable_int8 (
+            bool val
+        )
+        {
+#ifdef DLIB_USE_CUDA
+            (void)val; // cuDNN runs the float path, the int8 mode is CPU only.
+#else
+            impl.enable_int8(val);
+#endif
+        }
+        /*!
+            ensures
+                - When compiled without CUDA support, if val==true then subsequent calls
+                  to operator() run the convolution with dynamically quantized int8
+                  weights and inputs instead of floats.  This is an inference
+                  optimization; the outputs differ from the float path by the
+                  quantization error.  When compiled with CUDA this is a no-op since
+                  the convolutions run on the GPU.
+        !*/
+
     private:
 #ifdef DLIB_USE_CUDA
         cuda::tensor_conv impl;
@@ -1531,6 +1620,208 @@ namespace dlib { namespace tt
               as DEST.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    void extract_image_chips (
+        tensor& chips,
+        const tensor& img,
+        const tensor& tforms
+    );
+    /*!
+        requires
+            - is_same_object(chips, img) == false
+            - img.num_samples() == 1
+            - chips.k() == img.k()
+            - tforms.num_samples() == chips.num_samples()
+            - tforms.size() == chips.num_samples()*6
+        ensures
+            - Warps chips.num_samples() image chips out of img, one per sample of chips.
+              The 6 values in the nth sample of tforms define the affine transform
+              mapping a pixel location (c,r) in that chip to a location (x,y) in img:
+                x == tforms[n*6+0]*c + tforms[n*6+1]*r + tforms[n*6+2]
+                y == tforms[n*6+3]*c + tforms[n*6+4]*r + tforms[n*6+5]
+            - Each output pixel is the bilinear interpolation of img at the mapped
+              location, done independently for each of the k channels.  Locations that
+              map outside img produce 0.
+            - When compiled with CUDA the warping runs entirely on the device, so a
+              batch of chips can be cut from an already uploaded frame without any
+              per-chip host work or host to device copies.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    void disturb_colors (
+        tensor& img,
+        tensor_rand& rnd,
+        double gamma_magnitude = 0.5,
+        double color_magnitude = 0.2
+    );
+    /*!
+        requires
+            - img contains pixel values in the range [0,255] (i.e. images that have
+              not yet been mean/variance normalized).
+            - gamma_magnitude >= 0
+            - 0 <= color_magnitude < 1
+        ensures
+            - Applies a random color transform to each sample of img, just like
+              dlib::disturb_colors() does to individual images: each sample gets a
+              random gamma correction of magnitude gamma_magnitude and each of its
+              channels a random scaling of magnitude color_magnitude, with the scales
+              normalized so the brightest channel keeps its full range.  Values are
+              clamped to [0,255] before the transform is applied.
+            - The random numbers are drawn from rnd.  When compiled with CUDA they
+              are generated by cuRAND and the transform runs entirely on the device,
+              so batches can be augmented between to_tensor() and forward() without
+              any host work.
+    !*/
+
+    void random_flip_images_left_right (
+        tensor& img,
+        tensor_rand& rnd,
+        double probability = 0.5
+    );
+    /*!
+        requires
+            - 0 <= probability <= 1
+        ensures
+            - Each sample of img is, independently and with the given probability,
+              mirrored left to right in place.  All k channels of a sample are
+              flipped together.
+            - The random numbers are drawn from rnd.  When compiled with CUDA they
+              are generated by cuRAND and the flipping runs entirely on the device.
+    !*/
+
+    void random_crop_images (
+        tensor& dest,
+        const tensor& src,
+        tensor_rand& rnd,
+        double min_scale
+    );
+    /*!
+        requires
+            - is_same_object(dest, src) == false
+            - dest.num_samples() == src.num_samples()
+            - dest.k() == src.k()
+            - 0 < min_scale <= 1
+        ensures
+            - For each sample, picks a random axis aligned window of src with the
+              same aspect ratio as src and a scale chosen uniformly from
+              [min_scale,1], positioned uniformly at random inside the image.  The
+              window is then bilinearly resized to dest.nr() by dest.nc() and written
+              to the corresponding sample of dest.  Setting min_scale == 1 makes this
+              a plain bilinear resize of every sample.
+            - The random numbers are drawn from rnd.  When compiled with CUDA they
+              are generated by cuRAND and the cropping runs entirely on the device.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    void find_greater_than (
+        std::vector<std::pair<size_t,float>>& idxs_and_vals,
+        const tensor& t,
+        size_t begin,
+        size_t end,
+        float thresh
+    );
+    /*!
+        requires
+            - begin <= end <= t.size()
+        ensures
+            - #idxs_and_vals == the index and value of every element i of t with
+              begin <= i < end and t.host()[i] > thresh.  The order of the elements
+              in #idxs_and_vals is unspecified.
+            - When compiled with CUDA the filtering runs on the device and only the
+              elements that pass the threshold are copied back to the host.  This is
+              much faster than calling t.host() when most elements fail the test,
+              e.g. when thresholding detector score maps.
+    !*/
+
+    void gather (
+        std::vector<float>& vals,
+        const tensor& t,
+        const std::vector<size_t>& idxs
+    );
+    /*!
+        requires
+            - for all valid i: idxs[i] < t.size()
+        ensures
+            - #vals.size() == idxs.size()
+            - #vals[i] == t.host()[idxs[i]]
+            - When compiled with CUDA the gather runs on the device and only the
+              selected elements are copied back to the host.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    void sum_axis (
+        tensor& dest,
+        const tensor& src,
+        long axis
+    );
+    /*!
+        requires
+            - 0 <= axis <= 3
+            - dest has the same dimensions as src, except that the dimension
+              indicated by axis (0 == num_samples(), 1 == k(), 2 == nr(), 3 == nc())
+              is 1.
+            - is_same_object(dest, src) == false
+        ensures
+            - Sums src along the indicated axis and stores the result in dest.  E.g.
+              if axis == 1 then #dest(n,0,r,c) == sum over all k of src(n,k,r,c).
+            - When compiled with CUDA the reduction runs entirely on the device, so
+              loss layers can use it without copying tensors back to the host.
+    !*/
+
+    void mean_axis (
+        tensor& dest,
+        const tensor& src,
+        long axis
+    );
+    /*!
+        requires
+            - 0 <= axis <= 3
+            - dest has the same dimensions as src, except that the dimension
+              indicated by axis is 1.
+            - is_same_object(dest, src) == false
+        ensures
+            - Identical to sum_axis() except that each output is divided by the size
+              of the reduced axis, giving the mean along that axis.
+    !*/
+
+    void max_axis (
+        tensor& dest,
+        const tensor& src,
+        long axis
+    );
+    /*!
+        requires
+            - 0 <= axis <= 3
+            - dest has the same dimensions as src, except that the dimension
+              indicated by axis is 1.
+            - is_same_object(dest, src) == false
+        ensures
+            - Identical to sum_axis() except that each output is the maximum value
+              along the reduced axis rather than the sum.
+    !*/
+
+    void argmax_axis (
+        tensor& dest,
+        const tensor& src,
+        long axis
+    );
+    /*!
+        requires
+            - 0 <= axis <= 3
+            - dest has the same dimensions as src, except that the dimension
+              indicated by axis is 1.
+            - is_same_object(dest, src) == false
+        ensures
+            - Each output element of dest is the position, along the indicated axis,
+              of the maximum value in the corresponding slice of src.  The position
+              is stored as a float since tensors only hold floats.  Ties go to the
+              smallest position.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     class multi_device_tensor_averager
@@ -1538,7 +1829,10 @@ namespace dlib { namespace tt
         /*!
             WHAT THIS OBJECT REPRESENTS
                 This object is a tool for very quickly averaging a bunch of tensors
-                together.
+                together.  When the tensors live on GPUs that can directly access each
+                other it reduces and rebroadcasts along a binary tree, so the number of
+                serialized transfer steps grows with log2(num_devices) rather than
+                num_devices.
         !*/
     public:
 
@@ -1562,6 +1856,7 @@ namespace dlib { namespace tt
         {
             using namespace ::dlib::cuda;
             accessible_groups.clear();
+            tree_groups.clear();
             epa.clear();
             if (items.size() < 1)
                 return;
@@ -1587,9 +1882,39 @@ namespace dlib { namespace tt
             }
             for (auto&& g : accessible_groups)
             {
-                for (size_t i = 1; i < g.size(); ++i)
+                // Within a group we prefer a binary tree reduction since its rounds
+                // of pairwise transfers run on different devices and therefore
+                // overlap, giving O(log n) serialized steps instead of the O(n) you
+                // get when device g[0] pulls from everyone in turn.  That needs every
+                // tree pair to be able to talk directly, which grouping by
+                // accessibility to g[0] alone doesn't guarantee, so check and fall
+                // back to the hub pattern if the topology doesn't cooperate.
+                bool tree_ok = g.size() > 2;
+                for (size_t d = 1; d < g.size() && tree_ok; d *= 2)
+                {
+                    for (size_t i = 0; i+d < g.size(); i += 2*d)
+                    {
+                        if (!can_access_peer(*g[i], *g[i+d]))
+                        {
+                            tree_ok = false;
+                            break;
+                        }
+                    }
+                }
+                tree_groups.push_back(tree_ok);
+
+                if (tree_ok)
                 {
-                    epa.emplace_back(new enable_peer_access(*g[0], *g[i]));
+                    for (size_t d = 1; d < g.size(); d *= 2)
+                    {
+                        for (size_t i = 0; i+d < g.size(); i += 2*d)
+                            epa.emplace_back(new enable_peer_access(*g[i], *g[i+d]));
+                    }
+                }
+                else
+                {
+                    for (size_t i = 1; i < g.size(); ++i)
+                        epa.emplace_back(new enable_peer_access(*g[0], *g[i]));
                 }
             }
         }
@@ -1619,16 +1944,40 @@ namespace dlib { namespace tt
 
 
             // First we average things within each group
-            for (auto&& g : accessible_groups)
+            for (size_t gi = 0; gi < accessible_groups.size(); ++gi)
             {
-                raii_set_device set_dev(*g[0]);
-                if (g.size() == 1)
+                auto&& g = accessible_groups[gi];
+                if (tree_groups[gi])
+                {
+                    // Binary tree reduction.  Each round launches its pairwise sums
+                    // on different devices, so the transfers in a round overlap and
+                    // only the log2(n) rounds are serialized.  The syncs between
+                    // rounds are needed because the next round reads sums across
+                    // devices.
+                    for (size_t d = 1; d < g.size(); d *= 2)
+                    {
+                        for (size_t i = 0; i+d < g.size(); i += 2*d)
+                        {
+                            raii_set_device set_dev(*g[i]);
+                            tt::affine_transform(*g[i], *g[i], *g[i+d], 1, 1);
+                        }
+                        for (size_t i = 0; i+d < g.size(); i += 2*d)
+                            device_synchronize(*g[i]);
+                    }
+                    raii_set_device set_dev(*g[0]);
                     tt::affine_transform(*g[0], *g[0], scale);
-                else 
-                    tt::affine_transform(*g[0], *g[0], *g[1], scale, scale);
+                }
+                else
+                {
+                    raii_set_device set_dev(*g[0]);
+                    if (g.size() == 1)
+                        tt::affine_transform(*g[0], *g[0], scale);
+                    else
+                        tt::affine_transform(*g[0], *g[0], *g[1], scale, scale);
 
-                for (size_t i = 2; i < g.size(); ++i)
-                    tt::affine_transform(*g[0], *g[0], *g[i], 1, scale);
+                    for (size_t i = 2; i < g.size(); ++i)
+                        tt::affine_transform(*g[0], *g[0], *g[i], 1, scale);
+                }
             }
 
             if (accessible_groups.size() > 1)
@@ -1654,17 +2003,43 @@ namespace dlib { namespace tt
 
             // Now propagate averages back out to each element using point to point
             // communication inside a group.
-            for (auto&& g : accessible_groups)
+            for (size_t gi = 0; gi < accessible_groups.size(); ++gi)
             {
-                raii_set_device set_dev(*g[0]);
-                for (size_t i = 1; i < g.size(); ++i)
-                    memcpy(*g[i], *g[0]); 
+                auto&& g = accessible_groups[gi];
+                if (tree_groups[gi])
+                {
+                    // walk the reduction tree in reverse so each round's copies fan
+                    // out from devices that already have the average and overlap
+                    // with each other.
+                    size_t top = 1;
+                    while (top*2 < g.size())
+                        top *= 2;
+                    for (size_t d = top; d >= 1; d /= 2)
+                    {
+                        for (size_t i = 0; i+d < g.size(); i += 2*d)
+                        {
+                            raii_set_device set_dev(*g[i]);
+                            memcpy(*g[i+d], *g[i]);
+                        }
+                        for (size_t i = 0; i+d < g.size(); i += 2*d)
+                            device_synchronize(*g[i]);
+                        if (d == 1)
+                            break;
+                    }
+                }
+                else
+                {
+                    raii_set_device set_dev(*g[0]);
+                    for (size_t i = 1; i < g.size(); ++i)
+                        memcpy(*g[i], *g[0]);
+                }
             }
         }
 
     private:
         std::vector<std::unique_ptr<::dlib::cuda::enable_peer_access>> epa;
         std::vector<std::vector<tensor*>> accessible_groups;
+        std::vector<bool> tree_groups;
         float scale;
 
         resizable_tensor accum_buffer;
@@ -9,6 +9,8 @@
 
 #ifndef DLIB_ISO_CPP_ONLY
 #include "data_io/load_image_dataset.h"
+#include "data_io/parallel_file_loader.h"
+#include "data_io/streaming_image_dataset.h"
 #endif
 
 #endif // DLIB_DATA_Io_HEADER
@@ -11,6 +11,8 @@
 #include "../algs.h"
 #include "../matrix.h"
 #include "../string.h"
+#include "../uintn.h"
+#include "../serialize.h"
 #include "../svm/sparse_vector.h"
 #include <vector>
 
@@ -268,6 +270,138 @@ namespace dlib
 
     }
 
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+
+    template <typename sample_type, typename label_type, typename alloc1, typename alloc2>
+    typename disable_if<is_matrix<sample_type>,void>::type save_binary_sample_data (
+        const std::string& file_name,
+        const std::vector<sample_type, alloc1>& samples,
+        const std::vector<label_type, alloc2>& labels
+    )
+    {
+        typedef typename sample_type::value_type pair_type;
+        typedef typename basic_type<typename pair_type::first_type>::type key_type;
+
+        // You must use unsigned integral key types in your sparse vectors
+        COMPILE_TIME_ASSERT(is_unsigned_type<key_type>::value);
+
+        // make sure requires clause is not broken
+        DLIB_ASSERT(samples.size() == labels.size(),
+            "\t void save_binary_sample_data()"
+            << "\n\t You have to have labels for each sample and vice versa"
+            << "\n\t samples.size(): " << samples.size()
+            << "\n\t labels.size():  " << labels.size()
+            );
+
+        using namespace std;
+        ofstream fout(file_name.c_str(), ios::binary);
+
+        if (!fout)
+            throw sample_data_io_error("Unable to open file " + file_name);
+
+        serialize(std::string("dlib binary sample data v1"), fout);
+        serialize(labels, fout);
+
+        // Write out an index giving the number of non-zero elements in each row.  This
+        // lets a reader compute the byte offset of any row up front, and also lets it
+        // size its read buffers without any scanning.
+        const uint64 num = samples.size();
+        fout.write(reinterpret_cast<const char*>(&num), sizeof(num));
+        std::vector<uint64> row_sizes(samples.size());
+        for (unsigned long i = 0; i < samples.size(); ++i)
+            row_sizes[i] = samples[i].size();
+        fout.write(reinterpret_cast<const char*>(row_sizes.data()), row_sizes.size()*sizeof(uint64));
+
+        // Now write each row as an array of keys followed by an array of values.  Keys
+        // and values are stored as fixed width uint64 and double in the machine's native
+        // byte order, so loading them back is just bulk reads rather than parsing.
+        std::vector<uint64> keys;
+        std::vector<double> values;
+        for (unsigned long i = 0; i < samples.size(); ++i)
+        {
+            keys.resize(samples[i].size());
+            values.resize(samples[i].size());
+            unsigned long j = 0;
+            for (typename sample_type::const_iterator k = samples[i].begin(); k != samples[i].end(); ++k)
+            {
+                keys[j] = k->first;
+                values[j] = k->second;
+                ++j;
+            }
+            fout.write(reinterpret_cast<const char*>(keys.data()), keys.size()*sizeof(uint64));
+            fout.write(reinterpret_cast<const char*>(values.data()), values.size()*sizeof(double));
+
+            if (!fout)
+                throw sample_data_io_error("Error while writing to file " + file_name);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename sample_type, typename label_type, typename alloc1, typename alloc2>
+    typename disable_if<is_matrix<sample_type>,void>::type load_binary_sample_data (
+        const std::string& file_name,
+        std::vector<sample_type, alloc1>& samples,
+        std::vector<label_type, alloc2>& labels
+    )
+    {
+        typedef typename sample_type::value_type pair_type;
+        typedef typename basic_type<typename pair_type::first_type>::type key_type;
+        typedef typename pair_type::second_type value_type;
+
+        // You must use unsigned integral key types in your sparse vectors
+        COMPILE_TIME_ASSERT(is_unsigned_type<key_type>::value);
+
+        samples.clear();
+        labels.clear();
+
+        using namespace std;
+        ifstream fin(file_name.c_str(), ios::binary);
+
+        if (!fin)
+            throw sample_data_io_error("Unable to open file " + file_name);
+
+        try
+        {
+            std::string magic;
+            deserialize(magic, fin);
+            if (magic != "dlib binary sample data v1")
+                throw sample_data_io_error("The file " + file_name + " doesn't contain binary sample data.");
+            deserialize(labels, fin);
+        }
+        catch (serialization_error& e)
+        {
+            throw sample_data_io_error("Error while reading file " + file_name + ": " + e.what());
+        }
+
+        uint64 num = 0;
+        fin.read(reinterpret_cast<char*>(&num), sizeof(num));
+        std::vector<uint64> row_sizes(static_cast<size_t>(num));
+        fin.read(reinterpret_cast<char*>(row_sizes.data()), row_sizes.size()*sizeof(uint64));
+        if (!fin || num != labels.size())
+            throw sample_data_io_error("Error while reading file " + file_name);
+
+        samples.resize(static_cast<size_t>(num));
+        std::vector<uint64> keys;
+        std::vector<double> values;
+        for (unsigned long i = 0; i < samples.size(); ++i)
+        {
+            keys.resize(static_cast<size_t>(row_sizes[i]));
+            values.resize(static_cast<size_t>(row_sizes[i]));
+            fin.read(reinterpret_cast<char*>(keys.data()), keys.size()*sizeof(uint64));
+            fin.read(reinterpret_cast<char*>(values.data()), values.size()*sizeof(double));
+            if (!fin)
+                throw sample_data_io_error("Error while reading file " + file_name);
+
+            for (unsigned long j = 0; j < keys.size(); ++j)
+            {
+                samples[i].insert(samples[i].end(),
+                    std::make_pair(static_cast<key_type>(keys[j]), static_cast<value_type>(values[j])));
+            }
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
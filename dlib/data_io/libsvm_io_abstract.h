@@ -99,6 +99,74 @@ namespace dlib
                 This exception is thrown if there is any problem saving data to file
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sample_type,
+        typename label_type,
+        typename alloc1,
+        typename alloc2
+        >
+    void save_binary_sample_data (
+        const std::string& file_name,
+        const std::vector<sample_type, alloc1>& samples,
+        const std::vector<label_type, alloc2>& labels
+    );
+    /*!
+        requires
+            - sample_type must be an STL container
+            - sample_type::value_type == std::pair<T,U> where T is some kind of
+              unsigned integral type
+            - label_type must be serializable via dlib's serialize()
+            - samples.size() == labels.size()
+        ensures
+            - saves the data to the given file in a binary format that
+              load_binary_sample_data() can read back without any text parsing.  The file
+              starts with an index giving the number of non-zero elements in each row,
+              followed by each row's keys and values stored as fixed width integers and
+              doubles.  So loading it is just a few bulk reads per row, which is much
+              faster than parsing a libsvm formatted text file.  If you repeatedly load a
+              big libsvm formatted dataset, load it once with load_libsvm_formatted_data()
+              and save a copy with this function, then load the copy from then on.
+            - Note that the file is written in the machine's native byte order, so it is
+              meant as a locally cached copy of a dataset rather than as a portable
+              interchange format.  Use save_libsvm_formatted_data() or dlib's serialize()
+              when you need portability.
+        throws
+            - sample_data_io_error
+                This exception is thrown if there is any problem saving data to file
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sample_type,
+        typename label_type,
+        typename alloc1,
+        typename alloc2
+        >
+    void load_binary_sample_data (
+        const std::string& file_name,
+        std::vector<sample_type, alloc1>& samples,
+        std::vector<label_type, alloc2>& labels
+    );
+    /*!
+        requires
+            - sample_type must be an STL container
+            - sample_type::value_type == std::pair<T,U> where T is some kind of
+              unsigned integral type
+            - label_type must be serializable via dlib's serialize()
+        ensures
+            - attempts to read a file of the given name that should have been written by
+              save_binary_sample_data().  We turn the data into sparse vectors and store
+              it in samples.
+            - #labels.size() == #samples.size()
+            - for all valid i: #labels[i] is the label for #samples[i]
+        throws
+            - sample_data_io_error
+                This exception is thrown if there is any problem loading data from file
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <typename sample_type, typename alloc>
@@ -11,6 +11,7 @@
 #include <vector>
 #include "../geometry.h"
 #include "image_dataset_metadata.h"
+#include "parallel_file_loader.h"
 #include <string>
 #include <set>
 #include "../image_processing/full_object_detection.h"
@@ -126,7 +127,10 @@ namespace dlib
         typedef typename array_type::value_type image_type;
 
 
-        image_type img;
+        // First figure out which images we are going to load and what their boxes are.
+        std::vector<unsigned long> to_load;
+        std::vector<std::vector<rectangle> > all_rects, all_ignored;
+        std::vector<double> min_rect_sizes;
         std::vector<rectangle> rects, ignored;
         for (unsigned long i = 0; i < data.images.size(); ++i)
         {
@@ -151,8 +155,23 @@ namespace dlib
 
             if (!source.should_skip_empty_images() || rects.size() != 0)
             {
-                load_image(img, data.images[i].filename);
-                if (rects.size() != 0)  
+                to_load.push_back(i);
+                all_rects.push_back(rects);
+                all_ignored.push_back(ignored);
+                min_rect_sizes.push_back(min_rect_size);
+            }
+        }
+
+        // Now decode and shrink the images on all the cores, appending the results in
+        // their original order.
+        load_files_in_parallel<image_type>(to_load.size(),
+            [&](unsigned long k, image_type& img)
+            {
+                load_image(img, data.images[to_load[k]].filename);
+                std::vector<rectangle>& rects = all_rects[k];
+                std::vector<rectangle>& ignored = all_ignored[k];
+                double min_rect_size = min_rect_sizes[k];
+                if (rects.size() != 0)
                 {
                     // if shrinking the image would still result in the smallest box being
                     // bigger than the box area threshold then shrink the image.
@@ -177,11 +196,13 @@ namespace dlib
                             r = pyr.rect_down(r);
                     }
                 }
-                images.push_back(img);
-                object_locations.push_back(rects);
-                ignored_rects.push_back(ignored);
-            }
-        }
+            },
+            [&](unsigned long k, image_type& img)
+            {
+                images.push_back(std::move(img));
+                object_locations.push_back(std::move(all_rects[k]));
+                ignored_rects.push_back(std::move(all_ignored[k]));
+            });
 
         return ignored_rects;
     }
@@ -225,7 +246,10 @@ namespace dlib
 
         typedef typename array_type::value_type image_type;
 
-        image_type img;
+        // First figure out which images we are going to load and what their boxes are.
+        std::vector<unsigned long> to_load;
+        std::vector<std::vector<mmod_rect> > all_rects;
+        std::vector<double> min_rect_sizes;
         std::vector<mmod_rect> rects;
         for (unsigned long i = 0; i < data.images.size(); ++i)
         {
@@ -251,8 +275,21 @@ namespace dlib
 
             if (!source.should_skip_empty_images() || impl::num_non_ignored_boxes(rects) != 0)
             {
-                load_image(img, data.images[i].filename);
-                if (rects.size() != 0)  
+                to_load.push_back(i);
+                all_rects.push_back(rects);
+                min_rect_sizes.push_back(min_rect_size);
+            }
+        }
+
+        // Now decode and shrink the images on all the cores, appending the results in
+        // their original order.
+        load_files_in_parallel<image_type>(to_load.size(),
+            [&](unsigned long k, image_type& img)
+            {
+                load_image(img, data.images[to_load[k]].filename);
+                std::vector<mmod_rect>& rects = all_rects[k];
+                double min_rect_size = min_rect_sizes[k];
+                if (rects.size() != 0)
                 {
                     // if shrinking the image would still result in the smallest box being
                     // bigger than the box area threshold then shrink the image.
@@ -273,10 +310,12 @@ namespace dlib
                             r.rect = pyr.rect_down(r.rect);
                     }
                 }
+            },
+            [&](unsigned long k, image_type& img)
+            {
                 images.push_back(std::move(img));
-                object_locations.push_back(std::move(rects));
-            }
-        }
+                object_locations.push_back(std::move(all_rects[k]));
+            });
     }
 
 // ----------------------------------------------------------------------------------------
@@ -387,9 +426,13 @@ namespace dlib
             parts_list.push_back(*i);
         }
 
+        // First figure out which images we are going to load and what their boxes are.
         std::vector<std::vector<rectangle> > ignored_rects;
+        std::vector<unsigned long> to_load;
+        std::vector<std::vector<full_object_detection> > all_dets;
+        std::vector<std::vector<rectangle> > all_ignored;
+        std::vector<double> min_rect_sizes;
         std::vector<rectangle> ignored;
-        image_type img;
         std::vector<full_object_detection> object_dets;
         for (unsigned long i = 0; i < data.images.size(); ++i)
         {
@@ -424,8 +467,23 @@ namespace dlib
 
             if (!source.should_skip_empty_images() || object_dets.size() != 0)
             {
-                load_image(img, data.images[i].filename);
-                if (object_dets.size() != 0)  
+                to_load.push_back(i);
+                all_dets.push_back(object_dets);
+                all_ignored.push_back(ignored);
+                min_rect_sizes.push_back(min_rect_size);
+            }
+        }
+
+        // Now decode and shrink the images on all the cores, appending the results in
+        // their original order.
+        load_files_in_parallel<image_type>(to_load.size(),
+            [&](unsigned long idx, image_type& img)
+            {
+                load_image(img, data.images[to_load[idx]].filename);
+                std::vector<full_object_detection>& object_dets = all_dets[idx];
+                std::vector<rectangle>& ignored = all_ignored[idx];
+                double min_rect_size = min_rect_sizes[idx];
+                if (object_dets.size() != 0)
                 {
                     // if shrinking the image would still result in the smallest box being
                     // bigger than the box area threshold then shrink the image.
@@ -462,11 +520,13 @@ namespace dlib
                         }
                     }
                 }
-                images.push_back(img);
-                object_locations.push_back(object_dets);
-                ignored_rects.push_back(ignored);
-            }
-        }
+            },
+            [&](unsigned long idx, image_type& img)
+            {
+                images.push_back(std::move(img));
+                object_locations.push_back(std::move(all_dets[idx]));
+                ignored_rects.push_back(std::move(all_ignored[idx]));
+            });
 
 
         return ignored_rects;
@@ -0,0 +1,103 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_PARALLEL_FiLE_LOADER_Hh_
+#define DLIB_PARALLEL_FiLE_LOADER_Hh_
+
+#include "parallel_file_loader_abstract.h"
+#include "../image_io.h"
+#include "../threads.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_type,
+        typename load_funct,
+        typename consume_funct
+        >
+    void load_files_in_parallel (
+        unsigned long num_files,
+        load_funct load,
+        consume_funct consume,
+        unsigned long num_threads = 0,
+        unsigned long max_files_in_flight = 0
+    )
+    {
+        if (num_threads == 0)
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        if (max_files_in_flight == 0)
+            max_files_in_flight = 2*num_threads;
+
+        // Decoded files sit in a ring of max_files_in_flight slots.  Workers fill the
+        // slots in parallel while we hand finished slots to consume() in file order, so
+        // at most max_files_in_flight decoded files are ever in memory at once no
+        // matter how large the file list is.  Note that the slots are declared before
+        // the thread pool so they outlive any tasks still running if consume() throws.
+        std::vector<image_type> slots(std::min<unsigned long>(max_files_in_flight, std::max(num_files,1ul)));
+        std::vector<dlib::uint64> tasks(slots.size());
+        thread_pool tp(num_threads);
+
+        try
+        {
+            unsigned long submitted = 0;
+            for (; submitted < std::min<unsigned long>(slots.size(), num_files); ++submitted)
+            {
+                auto& slot = slots[submitted%slots.size()];
+                tasks[submitted%slots.size()] = tp.add_task_by_value([&load,&slot,submitted](){ load(submitted, slot); });
+            }
+
+            for (unsigned long i = 0; i < num_files; ++i)
+            {
+                tp.wait_for_task(tasks[i%slots.size()]);
+                consume(i, slots[i%slots.size()]);
+                if (submitted < num_files)
+                {
+                    auto& slot = slots[submitted%slots.size()];
+                    tasks[submitted%slots.size()] = tp.add_task_by_value([&load,&slot,submitted](){ load(submitted, slot); });
+                    ++submitted;
+                }
+            }
+        }
+        catch (...)
+        {
+            // Let any outstanding loads finish, swallowing their errors, so nothing is
+            // still touching the slots when we rethrow the first error.
+            while (true)
+            {
+                try { tp.wait_for_all_tasks(); break; }
+                catch (...) { }
+            }
+            throw;
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename array_type
+        >
+    void load_images_in_parallel (
+        array_type& images,
+        const std::vector<std::string>& filenames,
+        unsigned long num_threads = 0
+    )
+    {
+        typedef typename array_type::value_type image_type;
+        images.clear();
+        load_files_in_parallel<image_type>(filenames.size(),
+            [&](unsigned long i, image_type& img) { load_image(img, filenames[i]); },
+            [&](unsigned long, image_type& img) { images.push_back(std::move(img)); },
+            num_threads);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_PARALLEL_FiLE_LOADER_Hh_
@@ -0,0 +1,84 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_PARALLEL_FiLE_LOADER_ABSTRACT_Hh_
+#ifdef DLIB_PARALLEL_FiLE_LOADER_ABSTRACT_Hh_
+
+#include <string>
+#include <vector>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_type,
+        typename load_funct,
+        typename consume_funct
+        >
+    void load_files_in_parallel (
+        unsigned long num_files,
+        load_funct load,
+        consume_funct consume,
+        unsigned long num_threads = 0,
+        unsigned long max_files_in_flight = 0
+    );
+    /*!
+        requires
+            - image_type is default constructable
+            - load(i, img) is a valid expression for unsigned long i < num_files and
+              image_type img.  Moreover, it must be safe to call load() from multiple
+              threads at once so long as each call gets a different i.
+            - consume(i, img) is a valid expression for unsigned long i < num_files and
+              image_type img.
+        ensures
+            - Runs a bounded parallel load pipeline over num_files files.  In
+              particular, this function calls load(i, img) for all i in [0, num_files)
+              on a pool of num_threads threads and then calls consume(i, img) for each
+              loaded img, in order of increasing i, on the calling thread.  Each img
+              given to consume() is the one filled in by load() for the same i, and
+              consume() may take its contents (e.g. by std::move).
+            - At most max_files_in_flight loaded files are held in memory at any one
+              time, so datasets much larger than RAM can be streamed through this
+              function.
+            - if (num_threads == 0) then
+                - the number of threads the hardware supports is used.
+            - if (max_files_in_flight == 0) then
+                - a value of 2 times the number of threads is used.
+        throws
+            - Any exception thrown by load() or consume().  The first such exception is
+              rethrown to the caller once all in-flight loads have stopped.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename array_type
+        >
+    void load_images_in_parallel (
+        array_type& images,
+        const std::vector<std::string>& filenames,
+        unsigned long num_threads = 0
+    );
+    /*!
+        requires
+            - array_type == an array of images capable of holding images loaded by
+              load_image(), e.g. a dlib::array or std::vector of array2d or matrix
+              objects.
+        ensures
+            - #images.size() == filenames.size()
+            - #images[i] == the image in the file filenames[i], as loaded by
+              load_image().  The files are decoded on a pool of num_threads threads, so
+              loading a large dataset uses all the cores instead of just one.
+            - if (num_threads == 0) then
+                - the number of threads the hardware supports is used.
+        throws
+            - image_load_error
+                This exception is thrown if any file can't be loaded.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_PARALLEL_FiLE_LOADER_ABSTRACT_Hh_
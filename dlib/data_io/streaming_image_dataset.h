@@ -0,0 +1,286 @@
+// Copyright (C) 2016  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_STREAMING_IMAGE_DaTASET_Hh_
+#define DLIB_STREAMING_IMAGE_DaTASET_Hh_
+
+#include "streaming_image_dataset_abstract.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <limits>
+#include "../matrix.h"
+#include "../pixel.h"
+#include "../pipe.h"
+#include "../rand.h"
+#include "../image_io.h"
+#include "../dir_nav.h"
+#include "image_dataset_metadata.h"
+#include "load_image_dataset.h"
+#include "../image_processing/full_object_detection.h"
+#include "../image_transforms/image_pyramid.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        inline bool path_is_absolute (
+            const std::string& filename
+        )
+        {
+            if (filename.size() == 0)
+                return false;
+            if (filename[0] == '/' || filename[0] == '\\')
+                return true;
+            // windows drive letter
+            if (filename.size() > 1 && filename[1] == ':')
+                return true;
+            return false;
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_type = matrix<rgb_pixel>
+        >
+    class streaming_image_dataset : noncopyable
+    {
+        /*!
+            CONVENTION
+                - entries contains one element for each image we will hand out, in the
+                  order they appear in the metadata file.  Each element holds the
+                  absolute path of the image file along with its already filtered
+                  object boxes, so the loader thread never needs to touch the metadata
+                  or the current directory again.
+                - queue is the bounded prefetch window.  The loader thread decodes
+                  images and pushes them into queue, looping over the dataset forever
+                  in a freshly randomized order each epoch, and get_next_image() pops
+                  them out.  So at most queue.max_size()+1 decoded images are in
+                  memory at any moment.
+                - if the loader thread throws then the exception is stored in eptr and
+                  queue is disabled, which makes the next call to get_next_image()
+                  rethrow it.
+        !*/
+    public:
+
+        explicit streaming_image_dataset (
+            const image_dataset_file& source,
+            unsigned long prefetch_window = 64
+        ) :
+            queue(prefetch_window)
+        {
+            DLIB_CASSERT(prefetch_window > 0);
+
+            using namespace dlib::image_dataset_metadata;
+            dataset data;
+            load_image_dataset_metadata(data, source.get_filename());
+
+            // The metadata file might contain file paths which are relative to its own
+            // folder.  Unlike load_image_dataset() we can't just chdir there since the
+            // loader thread runs for as long as this object exists, so resolve the
+            // paths up front instead.
+            std::string parent = get_parent_directory(file(source.get_filename())).full_name();
+            if (parent.size() != 0 && parent[parent.size()-1] != directory::get_separator())
+                parent += directory::get_separator();
+
+            box_area_thresh = source.box_area_thresh();
+
+            for (unsigned long i = 0; i < data.images.size(); ++i)
+            {
+                entry e;
+                e.min_rect_size = std::numeric_limits<double>::infinity();
+                for (unsigned long j = 0; j < data.images[i].boxes.size(); ++j)
+                {
+                    if (source.should_load_box(data.images[i].boxes[j]))
+                    {
+                        if (data.images[i].boxes[j].ignore)
+                        {
+                            e.boxes.push_back(ignored_mmod_rect(data.images[i].boxes[j].rect));
+                        }
+                        else
+                        {
+                            e.boxes.push_back(mmod_rect(data.images[i].boxes[j].rect));
+                            e.min_rect_size = std::min<double>(e.min_rect_size, e.boxes.back().rect.area());
+                        }
+                        e.boxes.back().label = data.images[i].boxes[j].label;
+                    }
+                }
+
+                if (!source.should_skip_empty_images() || impl::num_non_ignored_boxes(e.boxes) != 0)
+                {
+                    if (impl::path_is_absolute(data.images[i].filename))
+                        e.filename = data.images[i].filename;
+                    else
+                        e.filename = parent + data.images[i].filename;
+                    entries.push_back(std::move(e));
+                }
+            }
+
+            loader = std::thread([this]() { load_loop(); });
+        }
+
+        explicit streaming_image_dataset (
+            const std::string& filename,
+            unsigned long prefetch_window = 64
+        ) :
+            streaming_image_dataset(image_dataset_file(filename), prefetch_window)
+        {
+        }
+
+        ~streaming_image_dataset (
+        )
+        {
+            queue.disable();
+            if (loader.joinable())
+                loader.join();
+        }
+
+        unsigned long size (
+        ) const
+        {
+            return entries.size();
+        }
+
+        void get_next_image (
+            image_type& img,
+            std::vector<mmod_rect>& boxes
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(size() != 0,
+                "\t void streaming_image_dataset::get_next_image()"
+                << "\n\t You can't ask for images from an empty dataset."
+            );
+
+            sample s;
+            if (!queue.dequeue(s))
+            {
+                std::lock_guard<std::mutex> lock(eptr_mutex);
+                if (eptr != nullptr)
+                    std::rethrow_exception(eptr);
+                throw error("streaming_image_dataset: attempt to read from a disabled dataset.");
+            }
+            img = std::move(s.image);
+            boxes = std::move(s.boxes);
+        }
+
+        template <
+            typename array_type
+            >
+        void get_next_images (
+            array_type& images,
+            std::vector<std::vector<mmod_rect> >& object_locations,
+            unsigned long num
+        )
+        {
+            images.clear();
+            object_locations.clear();
+
+            image_type img;
+            std::vector<mmod_rect> boxes;
+            for (unsigned long i = 0; i < num; ++i)
+            {
+                get_next_image(img, boxes);
+                images.push_back(std::move(img));
+                object_locations.push_back(std::move(boxes));
+            }
+        }
+
+    private:
+
+        struct entry
+        {
+            std::string filename;
+            std::vector<mmod_rect> boxes;
+            double min_rect_size;
+        };
+
+        struct sample
+        {
+            image_type image;
+            std::vector<mmod_rect> boxes;
+        };
+
+        void load_loop (
+        )
+        {
+            try
+            {
+                if (entries.size() == 0)
+                    return;
+
+                dlib::rand rnd;
+                std::vector<unsigned long> order(entries.size());
+                for (unsigned long i = 0; i < order.size(); ++i)
+                    order[i] = i;
+
+                sample s;
+                while (true)
+                {
+                    // Visit the images in a new random order each epoch.
+                    for (unsigned long i = order.size(); i > 1; --i)
+                        std::swap(order[i-1], order[rnd.get_random_64bit_number()%i]);
+
+                    for (unsigned long i = 0; i < order.size(); ++i)
+                    {
+                        const entry& e = entries[order[i]];
+                        load_image(s.image, e.filename);
+                        s.boxes = e.boxes;
+
+                        double min_rect_size = e.min_rect_size;
+                        if (s.boxes.size() != 0)
+                        {
+                            // if shrinking the image would still result in the smallest box being
+                            // bigger than the box area threshold then shrink the image.
+                            while(min_rect_size/2/2 > box_area_thresh)
+                            {
+                                pyramid_down<2> pyr;
+                                pyr(s.image);
+                                min_rect_size *= (1.0/2.0)*(1.0/2.0);
+                                for (auto&& r : s.boxes)
+                                    r.rect = pyr.rect_down(r.rect);
+                            }
+                            while(min_rect_size*(2.0/3.0)*(2.0/3.0) > box_area_thresh)
+                            {
+                                pyramid_down<3> pyr;
+                                pyr(s.image);
+                                min_rect_size *= (2.0/3.0)*(2.0/3.0);
+                                for (auto&& r : s.boxes)
+                                    r.rect = pyr.rect_down(r.rect);
+                            }
+                        }
+
+                        if (!queue.enqueue(s))
+                            return;
+                    }
+                }
+            }
+            catch (...)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(eptr_mutex);
+                    eptr = std::current_exception();
+                }
+                queue.disable();
+            }
+        }
+
+        std::vector<entry> entries;
+        double box_area_thresh;
+        dlib::pipe<sample> queue;
+        std::thread loader;
+        std::mutex eptr_mutex;
+        std::exception_ptr eptr;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_STREAMING_IMAGE_DaTASET_Hh_
+
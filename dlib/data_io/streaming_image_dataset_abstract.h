@@ -0,0 +1,152 @@
+// Copyright (C) 2016  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_STREAMING_IMAGE_DaTASET_ABSTRACT_Hh_
+#ifdef DLIB_STREAMING_IMAGE_DaTASET_ABSTRACT_Hh_
+
+#include <string>
+#include <vector>
+#include "load_image_dataset_abstract.h"
+#include "../matrix.h"
+#include "../pixel.h"
+#include "../image_processing/full_object_detection_abstract.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_type = matrix<rgb_pixel>
+        >
+    class streaming_image_dataset : noncopyable
+    {
+        /*!
+            REQUIREMENTS ON image_type
+                - image_type == an image object that implements the interface defined in
+                  dlib/image_processing/generic_image.h and is usable with load_image().
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a streaming alternative to the load_image_dataset()
+                routine that loads object detection datasets in the XML format produced
+                by the imglab tool.  Where load_image_dataset() decodes every image in
+                the dataset into RAM up front, this object only parses the metadata up
+                front and then decodes images on demand from a background thread,
+                keeping at most a bounded number of decoded images in memory at a time.
+                This means you can train on datasets much larger than RAM, e.g. by
+                periodically refilling the working set of images you feed to a
+                random_cropper with get_next_images().
+
+                The images are handed out in a random order which is reshuffled each
+                time the dataset is cycled.  The object box filtering options given by
+                the image_dataset_file argument (boxes_match_label(),
+                skip_empty_images(), shrink_big_images(), etc.) are honored exactly as
+                they are by the mmod_rect version of load_image_dataset().
+
+            THREAD SAFETY
+                It is not safe for multiple threads to make concurrent calls on a
+                single instance of this object.  However, the background decoding
+                thread is managed internally and is always safe.
+        !*/
+
+    public:
+
+        explicit streaming_image_dataset (
+            const image_dataset_file& source,
+            unsigned long prefetch_window = 64
+        );
+        /*!
+            requires
+                - prefetch_window > 0
+            ensures
+                - Parses the XML metadata file given by source.get_filename() and
+                  applies the box filtering options encoded in source, exactly as the
+                  mmod_rect version of load_image_dataset() would.
+                - #size() == the number of images this object will cycle through.
+                - Starts a background thread that decodes images from disk and buffers
+                  up to prefetch_window of them ahead of the consumer.  Image decoding
+                  therefore overlaps with whatever work the caller does between calls
+                  to get_next_image().
+            throws
+                - dlib::image_dataset_metadata::dataset_load_error
+                  This exception is thrown if there is an error loading the metadata
+                  file.
+        !*/
+
+        explicit streaming_image_dataset (
+            const std::string& filename,
+            unsigned long prefetch_window = 64
+        );
+        /*!
+            requires
+                - prefetch_window > 0
+            ensures
+                - performs: streaming_image_dataset(image_dataset_file(filename), prefetch_window)
+        !*/
+
+        ~streaming_image_dataset (
+        );
+        /*!
+            ensures
+                - stops the background decoding thread and frees all resources.
+        !*/
+
+        unsigned long size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of images in the dataset, after any
+                  skip_empty_images() filtering.  Note that this object hands out
+                  images forever, cycling through the dataset, so this is the length
+                  of one epoch rather than a bound on the number of calls you can
+                  make to get_next_image().
+        !*/
+
+        void get_next_image (
+            image_type& img,
+            std::vector<mmod_rect>& boxes
+        );
+        /*!
+            requires
+                - size() != 0
+            ensures
+                - #img == the next decoded image from the dataset and #boxes == the
+                  object boxes for that image, with any shrink_big_images() rescaling
+                  already applied to both.
+                - Blocks until an image is available from the prefetch window.  Since
+                  decoding runs ahead in a background thread this normally returns
+                  immediately.
+            throws
+                - if the background thread encountered an error (e.g. an unreadable
+                  image file) then that exception is rethrown here.
+        !*/
+
+        template <
+            typename array_type
+            >
+        void get_next_images (
+            array_type& images,
+            std::vector<std::vector<mmod_rect> >& object_locations,
+            unsigned long num
+        );
+        /*!
+            requires
+                - size() != 0
+                - array_type == an array of image_type objects (e.g. a dlib::array or
+                  std::vector of them)
+            ensures
+                - Fills images and object_locations with the next num images from the
+                  dataset, as if by num calls to get_next_image().  This is a
+                  convenience for periodically refilling a working set of images, for
+                  example one being sampled by a random_cropper.
+                - #images.size() == num
+                - #object_locations.size() == num
+        !*/
+
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_STREAMING_IMAGE_DaTASET_ABSTRACT_Hh_
+
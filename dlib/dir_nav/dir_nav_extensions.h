@@ -6,9 +6,16 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include "dir_nav_extensions_abstract.h"
 #include "../dir_nav.h"
 #include "../string.h"
+#include "../noncopyable.h"
 
 namespace dlib
 {
@@ -63,6 +70,152 @@ namespace dlib
         return result;
     }
 
+// ----------------------------------------------------------------------------------------
+
+    class directory_tree_walker : noncopyable
+    {
+        /*!
+            CONVENTION
+                - pending_dirs contains the directories, paired with their remaining
+                  depths, that still need to be scanned.
+                - num_scanning == the number of worker threads currently scanning a
+                  directory popped from pending_dirs.
+                - the walk is finished when pending_dirs.empty() && num_scanning == 0.
+                - should_stop == true only once this object is being destructed.
+        !*/
+    public:
+
+        template <typename T>
+        directory_tree_walker (
+            const directory& top_of_tree,
+            const T& add_file,
+            unsigned long max_depth = 30,
+            unsigned long num_threads = 4
+        ) :
+            filter(add_file),
+            num_scanning(0),
+            should_stop(false)
+        {
+            pending_dirs.push_back(std::make_pair(top_of_tree, max_depth));
+            if (num_threads == 0)
+                num_threads = 1;
+            for (unsigned long i = 0; i < num_threads; ++i)
+                workers.emplace_back(&directory_tree_walker::worker_loop, this);
+        }
+
+        ~directory_tree_walker (
+        )
+        {
+            {
+                std::unique_lock<std::mutex> lock(m);
+                should_stop = true;
+            }
+            dirs_ready.notify_all();
+            files_ready.notify_all();
+            for (auto& t : workers)
+                t.join();
+        }
+
+        bool get_next_file (
+            file& f
+        )
+        {
+            std::unique_lock<std::mutex> lock(m);
+            while (found_files.empty() && !walk_finished())
+                files_ready.wait(lock);
+
+            if (found_files.empty())
+                return false;
+
+            f = found_files.front();
+            found_files.pop_front();
+            return true;
+        }
+
+    private:
+
+        bool walk_finished (
+        ) const
+        {
+            // requires the caller to hold a lock on m
+            return pending_dirs.empty() && num_scanning == 0;
+        }
+
+        void worker_loop (
+        )
+        {
+            std::vector<file> temp_files;
+            std::vector<directory> temp_dirs;
+
+            std::unique_lock<std::mutex> lock(m);
+            while (!should_stop)
+            {
+                if (pending_dirs.empty())
+                {
+                    if (num_scanning == 0)
+                    {
+                        // The walk is over, so make sure everyone waiting finds out.
+                        files_ready.notify_all();
+                        dirs_ready.notify_all();
+                        return;
+                    }
+                    // some other thread might still discover more subdirectories
+                    dirs_ready.wait(lock);
+                    continue;
+                }
+
+                const directory dir = pending_dirs.front().first;
+                const unsigned long depth = pending_dirs.front().second;
+                pending_dirs.pop_front();
+                ++num_scanning;
+                lock.unlock();
+
+                // Hit the file system without holding the lock so the other workers
+                // and the consumer can keep going while we wait on these calls.
+                temp_files.clear();
+                temp_dirs.clear();
+                try
+                {
+                    dir.get_files(temp_files);
+                    if (depth > 0)
+                        dir.get_dirs(temp_dirs);
+                }
+                catch (const directory::listing_error&)
+                {
+                    // Just skip directories that disappear or can't be listed mid
+                    // walk.
+                    temp_files.clear();
+                    temp_dirs.clear();
+                }
+
+                lock.lock();
+                for (unsigned long i = 0; i < temp_files.size(); ++i)
+                {
+                    if (filter(temp_files[i]))
+                        found_files.push_back(temp_files[i]);
+                }
+                for (unsigned long i = 0; i < temp_dirs.size(); ++i)
+                    pending_dirs.push_back(std::make_pair(temp_dirs[i], depth-1));
+                --num_scanning;
+
+                if (!temp_dirs.empty() || walk_finished())
+                    dirs_ready.notify_all();
+                if (!temp_files.empty() || walk_finished())
+                    files_ready.notify_all();
+            }
+        }
+
+        std::function<bool(const file&)> filter;
+        std::deque<std::pair<directory,unsigned long> > pending_dirs;
+        std::deque<file> found_files;
+        unsigned long num_scanning;
+        bool should_stop;
+        std::mutex m;
+        std::condition_variable dirs_ready;
+        std::condition_variable files_ready;
+        std::vector<std::thread> workers;
+    };
+
 // ----------------------------------------------------------------------------------------
 
     class match_ending
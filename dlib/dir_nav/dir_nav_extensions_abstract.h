@@ -47,6 +47,74 @@ namespace dlib
               so on...
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    class directory_tree_walker : noncopyable
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object performs the same search as the above
+                get_files_in_directory_tree() function except that it does the walk on
+                a group of background threads and hands out the files it finds while
+                the walk is still in progress.  This lets the caller overlap the
+                directory enumeration with whatever processing it does on each file,
+                which matters when walking very large directory trees.
+
+            THREAD SAFETY
+                It is not safe to call get_next_file() from more than one thread at a
+                time.  However, it doesn't matter which thread calls it.
+        !*/
+
+    public:
+
+        template <typename T>
+        directory_tree_walker (
+            const directory& top_of_tree,
+            const T& add_file,
+            unsigned long max_depth = 30,
+            unsigned long num_threads = 4
+        );
+        /*!
+            requires
+                - add_file must be a function object with the following prototype:
+                    bool add_file (file f);
+                - add_file must be safe to call from multiple threads at once.
+            ensures
+                - begins a recursive search through the directory top_of_tree and all
+                  its sub-directories (up to the given max depth), using
+                  max(num_threads,1) background threads.  All files found are examined
+                  by passing them to add_file() and the ones for which it returns true
+                  are made available via get_next_file().
+                - The max_depth argument has the same interpretation as in
+                  get_files_in_directory_tree().
+                - Directories that can't be listed, e.g. because they were deleted
+                  during the walk, are skipped rather than causing an error.
+        !*/
+
+        ~directory_tree_walker (
+        );
+        /*!
+            ensures
+                - stops the walk and joins all the background threads.  Any files not
+                  yet retrieved with get_next_file() are discarded.
+        !*/
+
+        bool get_next_file (
+            file& f
+        );
+        /*!
+            ensures
+                - if (the walk has found, or will yet find, another file accepted by
+                  add_file) then
+                    - blocks until such a file is available, assigns it to #f, and
+                      returns true.
+                - else
+                    - returns false.  So a false return means the entire directory
+                      tree has been searched and all matching files handed out.
+                - Note that files are not returned in any particular order.
+        !*/
+    };
+
 // ----------------------------------------------------------------------------------------
 
     class match_ending
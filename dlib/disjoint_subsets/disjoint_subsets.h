@@ -53,31 +53,18 @@ namespace dlib
                 << "\n\t this: " << this
                 );
 
-            if (items[item].parent == item)
+            // Walk up to the root of item's tree, doing path splitting as we go.  That
+            // is, each node we pass gets repointed at its grandparent, which halves
+            // the length of the path for later queries while needing only a single
+            // pass over the path instead of the two used by classic path compression.
+            unsigned long x = item;
+            while (items[x].parent != x)
             {
-                return item;
-            }
-            else
-            {
-                // find root of item
-                unsigned long x = item;
-                do
-                {
-                    x = items[x].parent;
-                } while (items[x].parent != x);
-
-                // do path compression
-                const unsigned long root = x;
-                x = item;
-                while (items[x].parent != x)
-                {
-                    const unsigned long prev = x;
-                    x = items[x].parent;
-                    items[prev].parent = root;
-                }
-
-                return root;
+                const unsigned long next = items[x].parent;
+                items[x].parent = items[next].parent;
+                x = next;
             }
+            return x;
         }
 
         unsigned long merge_sets (
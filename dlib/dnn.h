@@ -10,6 +10,7 @@
 #endif
 
 #include "cuda/tensor.h"
+#include "cuda/tensor_arena.h"
 #include "dnn/input.h"
 
 // Problem:    Visual Studio's vcpkgsrv.exe constantly uses a single CPU core,
@@ -31,6 +32,7 @@
 #include "cuda/tensor_tools.h"
 #include "dnn/utilities.h"
 #include "dnn/validation.h"
+#include "dnn/inference_batcher.h"
 
 #endif // DLIB_DNn_
 
@@ -0,0 +1,159 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_DNn_INFERENCE_BATCHER_H_
+#define DLIB_DNn_INFERENCE_BATCHER_H_
+
+#include "inference_batcher_abstract.h"
+#include "core.h"
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../pipe.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename net_type
+        >
+    class dnn_inference_batcher
+    {
+        /*!
+            CONVENTION
+                - requests flow through q to the one worker thread, which gathers them
+                  into batches of at most max_batch_size, waiting at most
+                  max_latency_ms from the time a batch's first request is dequeued for
+                  more requests to arrive, then runs a single forward pass and
+                  fulfills the promises.
+        !*/
+
+    public:
+
+        typedef typename net_type::input_type input_type;
+        typedef typename net_type::output_label_type output_label_type;
+
+        explicit dnn_inference_batcher (
+            net_type net_,
+            size_t max_batch_size_ = 128,
+            unsigned long max_latency_ms_ = 5
+        ) :
+            net(std::move(net_)),
+            max_batch_size(max_batch_size_),
+            max_latency_ms(max_latency_ms_),
+            q(max_batch_size_*4)
+        {
+            DLIB_CASSERT(max_batch_size > 0);
+            worker = std::thread(&dnn_inference_batcher::worker_loop, this);
+        }
+
+        ~dnn_inference_batcher (
+        )
+        {
+            // Let everything already enqueued run to completion, then shut the worker
+            // down.
+            q.wait_until_empty();
+            q.disable();
+            worker.join();
+        }
+
+        size_t get_max_batch_size (
+        ) const { return max_batch_size; }
+
+        unsigned long get_max_latency (
+        ) const { return max_latency_ms; }
+
+        std::future<output_label_type> enqueue (
+            input_type sample
+        )
+        {
+            auto req = std::make_shared<request>();
+            req->sample = std::move(sample);
+            auto fut = req->result.get_future();
+            q.enqueue(req);
+            return fut;
+        }
+
+        output_label_type operator() (
+            input_type sample
+        )
+        {
+            return enqueue(std::move(sample)).get();
+        }
+
+    private:
+
+        struct request
+        {
+            input_type sample;
+            std::promise<output_label_type> result;
+        };
+
+        void worker_loop (
+        )
+        {
+            std::shared_ptr<request> req;
+            std::vector<std::shared_ptr<request>> batch;
+            std::vector<input_type> samples;
+            while (q.dequeue(req))
+            {
+                batch.clear();
+                batch.push_back(req);
+
+                // Wait up to max_latency_ms for more requests so the GPU gets a nicely
+                // sized batch, but never hold a request longer than that.
+                const auto deadline = std::chrono::steady_clock::now() +
+                                      std::chrono::milliseconds(max_latency_ms);
+                while (batch.size() < max_batch_size)
+                {
+                    const auto now = std::chrono::steady_clock::now();
+                    if (now >= deadline)
+                        break;
+                    const unsigned long ms_left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline-now).count() + 1;
+                    if (!q.dequeue_or_timeout(req, ms_left))
+                        break;
+                    batch.push_back(req);
+                }
+
+                samples.clear();
+                for (auto& r : batch)
+                    samples.push_back(std::move(r->sample));
+
+                try
+                {
+                    std::vector<output_label_type> results = net(samples, samples.size());
+                    for (size_t i = 0; i < batch.size(); ++i)
+                        batch[i]->result.set_value(std::move(results[i]));
+                }
+                catch (...)
+                {
+                    // Hand the error to everyone who was in this batch.
+                    for (auto& r : batch)
+                    {
+                        try { r->result.set_exception(std::current_exception()); }
+                        catch (...) { }
+                    }
+                }
+            }
+        }
+
+        net_type net;
+        const size_t max_batch_size;
+        const unsigned long max_latency_ms;
+        dlib::pipe<std::shared_ptr<request>> q;
+        std::thread worker;
+
+        // restricted functions
+        dnn_inference_batcher(const dnn_inference_batcher&);        // copy constructor
+        dnn_inference_batcher& operator=(const dnn_inference_batcher&);    // assignment operator
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_DNn_INFERENCE_BATCHER_H_
@@ -0,0 +1,111 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_DNn_INFERENCE_BATCHER_ABSTRACT_H_
+#ifdef DLIB_DNn_INFERENCE_BATCHER_ABSTRACT_H_
+
+#include "core_abstract.h"
+#include <future>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename net_type
+        >
+    class dnn_inference_batcher
+    {
+        /*!
+            REQUIREMENTS ON net_type
+                - net_type is an add_loss_layer network, i.e. something with the
+                  interface of the add_loss_layer object defined in core_abstract.h.
+
+            WHAT THIS OBJECT REPRESENTS
+                This object wraps a network and turns it into a thread safe inference
+                service that performs dynamic batching.  Many threads can enqueue()
+                samples concurrently; a single worker thread gathers the outstanding
+                samples into batches, runs one forward pass per batch, and fulfills a
+                future for each sample.  This keeps a GPU busy with well sized batches
+                even when each client only ever has one sample at a time, which is much
+                faster than having each client run its own forward pass.
+
+                A batch is dispatched as soon as it contains get_max_batch_size()
+                samples, or once get_max_latency() milliseconds have passed since the
+                batch was started, whichever comes first.  So no request ever waits
+                more than roughly the maximum latency for stragglers.
+        !*/
+
+    public:
+
+        typedef typename net_type::input_type input_type;
+        typedef typename net_type::output_label_type output_label_type;
+
+        explicit dnn_inference_batcher (
+            net_type net,
+            size_t max_batch_size = 128,
+            unsigned long max_latency_ms = 5
+        );
+        /*!
+            requires
+                - max_batch_size > 0
+            ensures
+                - #get_max_batch_size() == max_batch_size
+                - #get_max_latency() == max_latency_ms
+                - This object takes ownership of net and starts the worker thread that
+                  will run all the forward passes.
+        !*/
+
+        ~dnn_inference_batcher (
+        );
+        /*!
+            ensures
+                - All samples enqueued before the destructor was called are processed
+                  and their futures completed, then the worker thread is stopped.  It
+                  is not legal to call enqueue() once the destructor has started.
+        !*/
+
+        size_t get_max_batch_size (
+        ) const;
+        /*!
+            ensures
+                - returns the largest number of samples that will ever be put through
+                  the network in one forward pass.
+        !*/
+
+        unsigned long get_max_latency (
+        ) const;
+        /*!
+            ensures
+                - returns the maximum number of milliseconds the worker will wait for
+                  additional samples before running a partially filled batch.
+        !*/
+
+        std::future<output_label_type> enqueue (
+            input_type sample
+        );
+        /*!
+            ensures
+                - Queues sample for processing and returns a future that will
+                  eventually hold net(sample)'s output label.  If the forward pass
+                  throws, the exception is delivered through the future instead.  This
+                  function is safe to call from many threads at once and returns
+                  without waiting for the forward pass.
+        !*/
+
+        output_label_type operator() (
+            input_type sample
+        );
+        /*!
+            ensures
+                - performs: return enqueue(sample).get()
+                  (i.e. this is the blocking convenience form of enqueue())
+        !*/
+
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_DNn_INFERENCE_BATCHER_ABSTRACT_H_
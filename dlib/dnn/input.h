@@ -8,8 +8,13 @@
 #include "../array2d.h"
 #include "../pixel.h"
 #include "../image_processing.h"
+#include "../image_transforms/interpolation.h"
+#include "../cuda/tensor_tools.h"
 #include <sstream>
 #include <array>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include "../cuda/tensor_tools.h"
 
 
@@ -303,10 +308,242 @@ namespace dlib
         avg_blue(item.get_avg_blue())
     {}
 
+// ----------------------------------------------------------------------------------------
+
+    inline void extract_image_chips (
+        const tensor& img,
+        const std::vector<chip_details>& chip_locations,
+        resizable_tensor& chips
+    )
+    {
+        DLIB_CASSERT(img.num_samples() == 1);
+        DLIB_CASSERT(chip_locations.size() > 0);
+#ifdef ENABLE_ASSERTS
+        for (unsigned long i = 0; i < chip_locations.size(); ++i)
+        {
+            DLIB_CASSERT(chip_locations[i].size() != 0 &&
+                         chip_locations[i].rect.is_empty() == false,
+            "\t void extract_image_chips()"
+            << "\n\t Invalid inputs were given to this function."
+            << "\n\t chip_locations["<<i<<"].size():          " << chip_locations[i].size()
+            << "\n\t chip_locations["<<i<<"].rect.is_empty(): " << chip_locations[i].rect.is_empty()
+            );
+            DLIB_CASSERT(chip_locations[i].rows == chip_locations[0].rows &&
+                         chip_locations[i].cols == chip_locations[0].cols,
+            "\t void extract_image_chips()"
+            << "\n\t All chips placed into a single tensor must have the same dimensions."
+            );
+        }
+#endif
+
+        chips.set_size(chip_locations.size(), img.k(), chip_locations[0].rows, chip_locations[0].cols);
+
+        // Build the affine transform that maps a pixel location in each chip to its
+        // source location in img.  This is the same mapping extract_image_chips() uses,
+        // except that here the warp always samples img directly rather than an image
+        // pyramid level.
+        resizable_tensor tforms(chip_locations.size(), 6);
+        float* t = tforms.host();
+        std::vector<dlib::vector<double,2> > from, to;
+        for (unsigned long i = 0; i < chip_locations.size(); ++i)
+        {
+            const chip_details& loc = chip_locations[i];
+            from.clear();
+            to.clear();
+            from.push_back(point(0,0));            to.push_back(rotate_point<double>(center(loc.rect),loc.rect.tl_corner(),loc.angle));
+            from.push_back(point(loc.cols-1,0));   to.push_back(rotate_point<double>(center(loc.rect),loc.rect.tr_corner(),loc.angle));
+            from.push_back(point(0,loc.rows-1));   to.push_back(rotate_point<double>(center(loc.rect),loc.rect.bl_corner(),loc.angle));
+            const point_transform_affine trns = find_affine_transform(from,to);
+            *t++ = trns.get_m()(0,0);  *t++ = trns.get_m()(0,1);  *t++ = trns.get_b().x();
+            *t++ = trns.get_m()(1,0);  *t++ = trns.get_m()(1,1);  *t++ = trns.get_b().y();
+        }
+
+        tt::extract_image_chips(chips, img, tforms);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    struct yuv_image
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                A non-owning view of a YUV 4:2:0 camera frame, either semi-planar
+                (NV12, one full resolution Y plane followed by an interleaved UV
+                plane) or planar (I420, separate half resolution U and V planes).
+                The pointed to memory must stay valid while the view is in use.
+        !*/
+
+        enum layout_type
+        {
+            NV12,   // u points at the interleaved UV plane, v is ignored.
+            I420    // u and v point at separate half resolution planes.
+        };
+
+        const unsigned char* y = nullptr;
+        const unsigned char* u = nullptr;
+        const unsigned char* v = nullptr;
+        long nr = 0;
+        long nc = 0;
+        long y_stride = 0;   // in bytes, between consecutive rows of the Y plane
+        long uv_stride = 0;  // in bytes, between consecutive rows of the chroma plane(s)
+        layout_type layout = NV12;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    class input_yuv_image
+    {
+    public:
+        typedef yuv_image input_type;
+
+        input_yuv_image (
+        ) :
+            avg_red(122.782),
+            avg_green(117.001),
+            avg_blue(104.298)
+        {
+        }
+
+        input_yuv_image (
+            float avg_red_,
+            float avg_green_,
+            float avg_blue_
+        ) : avg_red(avg_red_), avg_green(avg_green_), avg_blue(avg_blue_)
+        {}
+
+        float get_avg_red()   const { return avg_red; }
+        float get_avg_green() const { return avg_green; }
+        float get_avg_blue()  const { return avg_blue; }
+
+        bool image_contained_point ( const tensor& data, const point& p) const { return get_rect(data).contains(p); }
+        drectangle tensor_space_to_image_space ( const tensor& /*data*/, drectangle r) const { return r; }
+        drectangle image_space_to_tensor_space ( const tensor& /*data*/, double /*scale*/, drectangle r ) const { return r; }
+
+        template <typename forward_iterator>
+        void to_tensor (
+            forward_iterator ibegin,
+            forward_iterator iend,
+            resizable_tensor& data
+        ) const
+        {
+            DLIB_CASSERT(std::distance(ibegin,iend) > 0);
+            const long nr = ibegin->nr;
+            const long nc = ibegin->nc;
+            // make sure all the input frames have the same dimensions and that 4:2:0
+            // subsampling makes sense for them.
+            for (auto i = ibegin; i != iend; ++i)
+            {
+                DLIB_CASSERT(i->nr==nr && i->nc==nc,
+                    "\t input_yuv_image::to_tensor()"
+                    << "\n\t All frames given to to_tensor() must have the same dimensions."
+                    << "\n\t nr: " << nr
+                    << "\n\t nc: " << nc
+                    << "\n\t i->nr: " << i->nr
+                    << "\n\t i->nc: " << i->nc
+                );
+                DLIB_CASSERT(i->nr%2==0 && i->nc%2==0,
+                    "\t input_yuv_image::to_tensor()"
+                    << "\n\t 4:2:0 frames must have even dimensions."
+                    << "\n\t i->nr: " << i->nr
+                    << "\n\t i->nc: " << i->nc
+                );
+                DLIB_CASSERT(i->y != nullptr && i->u != nullptr &&
+                             (i->layout == yuv_image::NV12 || i->v != nullptr),
+                    "\t input_yuv_image::to_tensor()"
+                    << "\n\t The frame planes must be set."
+                );
+            }
+
+            // initialize data to the right size to contain the stuff in the iterator range.
+            data.set_size(std::distance(ibegin,iend), 3, nr, nc);
+
+            const size_t offset = nr*nc;
+            auto ptr = data.host();
+            for (auto i = ibegin; i != iend; ++i)
+            {
+                float* const rplane = ptr;
+                float* const gplane = ptr + offset;
+                float* const bplane = ptr + 2*offset;
+                for (long r = 0; r < nr; ++r)
+                {
+                    const unsigned char* yrow = i->y + r*i->y_stride;
+                    const unsigned char* urow;
+                    const unsigned char* vrow;
+                    if (i->layout == yuv_image::NV12)
+                    {
+                        urow = i->u + (r/2)*i->uv_stride;
+                        vrow = urow + 1;
+                    }
+                    else
+                    {
+                        urow = i->u + (r/2)*i->uv_stride;
+                        vrow = i->v + (r/2)*i->uv_stride;
+                    }
+                    const long uv_step = (i->layout == yuv_image::NV12) ? 2 : 1;
+
+                    // Do the BT.601 conversion and the input normalization in one
+                    // pass, two pixels at a time since each chroma sample covers
+                    // them both.
+                    for (long c = 0; c < nc; c += 2)
+                    {
+                        const float u0 = urow[(c/2)*uv_step] - 128.0f;
+                        const float v0 = vrow[(c/2)*uv_step] - 128.0f;
+                        const float roff = ( 1.402f*v0               - avg_red)/256.0f;
+                        const float goff = (-0.344136f*u0 - 0.714136f*v0 - avg_green)/256.0f;
+                        const float boff = ( 1.772f*u0               - avg_blue)/256.0f;
+                        for (long k = 0; k < 2; ++k)
+                        {
+                            const float yv = yrow[c+k]/256.0f;
+                            rplane[r*nc+c+k] = yv + roff;
+                            gplane[r*nc+c+k] = yv + goff;
+                            bplane[r*nc+c+k] = yv + boff;
+                        }
+                    }
+                }
+                ptr += 3*offset;
+            }
+        }
+
+        friend void serialize(const input_yuv_image& item, std::ostream& out)
+        {
+            serialize("input_yuv_image", out);
+            serialize(item.avg_red, out);
+            serialize(item.avg_green, out);
+            serialize(item.avg_blue, out);
+        }
+
+        friend void deserialize(input_yuv_image& item, std::istream& in)
+        {
+            std::string version;
+            deserialize(version, in);
+            if (version != "input_yuv_image")
+                throw serialization_error("Unexpected version found while deserializing dlib::input_yuv_image.");
+            deserialize(item.avg_red, in);
+            deserialize(item.avg_green, in);
+            deserialize(item.avg_blue, in);
+        }
+
+        friend std::ostream& operator<<(std::ostream& out, const input_yuv_image& item)
+        {
+            out << "input_yuv_image("<<item.avg_red<<","<<item.avg_green<<","<<item.avg_blue<<")";
+            return out;
+        }
+
+        friend void to_xml(const input_yuv_image& item, std::ostream& out)
+        {
+            out << "<input_yuv_image r='"<<item.avg_red<<"' g='"<<item.avg_green<<"' b='"<<item.avg_blue<<"'/>";
+        }
+
+    private:
+        float avg_red;
+        float avg_green;
+        float avg_blue;
+    };
+
 // ----------------------------------------------------------------------------------------
 
     template <typename T, long NR, long NC, typename MM, typename L>
-    class input<matrix<T,NR,NC,MM,L>> 
+    class input<matrix<T,NR,NC,MM,L>>
     {
     public:
         typedef matrix<T,NR,NC,MM,L> input_type;
@@ -919,6 +1156,190 @@ namespace dlib
         float avg_blue;
     };
 
+// ----------------------------------------------------------------------------------------
+
+    template <typename SUBLAYER>
+    class input_cached
+    {
+        /*!
+            CONVENTION
+                - cache maps sample ids to per-sample tensors produced by sub's
+                  to_tensor().  lru lists the cached entries, most recently used
+                  first, and cache_bytes is the total size of their buffers.  These
+                  are only touched while cache_mutex is locked.
+        !*/
+    public:
+        typedef std::pair<unsigned long long, typename SUBLAYER::input_type> input_type;
+
+        input_cached (
+        ) : max_cache_bytes(1024*1024*1024), cache_bytes(0) {}
+
+        explicit input_cached (
+            const SUBLAYER& sub_,
+            size_t max_cache_size_bytes_ = 1024*1024*1024
+        ) : sub(sub_), max_cache_bytes(max_cache_size_bytes_), cache_bytes(0) {}
+
+        input_cached (
+            const input_cached& item
+        ) : sub(item.sub), max_cache_bytes(item.max_cache_bytes), cache_bytes(0) {}
+
+        input_cached& operator= (
+            const input_cached& item
+        )
+        {
+            sub = item.sub;
+            max_cache_bytes = item.max_cache_bytes;
+            clear_cache();
+            return *this;
+        }
+
+        const SUBLAYER& get_sublayer (
+        ) const { return sub; }
+
+        size_t get_max_cache_size_bytes (
+        ) const { return max_cache_bytes; }
+
+        void set_max_cache_size_bytes (
+            size_t max_bytes
+        )
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            max_cache_bytes = max_bytes;
+            evict();
+        }
+
+        size_t get_cache_size_bytes (
+        ) const
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            return cache_bytes;
+        }
+
+        void clear_cache (
+        )
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            cache.clear();
+            lru.clear();
+            cache_bytes = 0;
+        }
+
+        template <typename forward_iterator>
+        void to_tensor (
+            forward_iterator ibegin,
+            forward_iterator iend,
+            resizable_tensor& data
+        ) const
+        {
+            DLIB_CASSERT(std::distance(ibegin,iend) > 0);
+            std::lock_guard<std::mutex> lock(cache_mutex);
+
+            // Find (or build) the per-sample tensor for every element of the batch.
+            std::vector<const resizable_tensor*> samples;
+            for (auto i = ibegin; i != iend; ++i)
+            {
+                auto hit = cache.find(i->first);
+                if (hit == cache.end())
+                {
+                    lru.emplace_front();
+                    entry& e = lru.front();
+                    e.id = i->first;
+                    sub.to_tensor(&i->second, &i->second+1, e.data);
+                    cache_bytes += e.data.size()*sizeof(float);
+                    cache[i->first] = lru.begin();
+                }
+                else
+                {
+                    // move the entry to the front of the LRU list
+                    lru.splice(lru.begin(), lru, hit->second);
+                }
+                samples.push_back(&lru.front().data);
+            }
+
+            const auto k  = samples[0]->k();
+            const auto nr = samples[0]->nr();
+            const auto nc = samples[0]->nc();
+            for (auto s : samples)
+            {
+                DLIB_CASSERT(s->num_samples() == 1 && s->k() == k && s->nr() == nr && s->nc() == nc,
+                    "\t input_cached::to_tensor()"
+                    << "\n\t All samples given to to_tensor() must map to tensors with the same dimensions.");
+            }
+
+            // Assemble the batch by copying the cached tensors into slices of data.
+            // When dlib is built with CUDA these copies happen device-to-device, so a
+            // cache hit skips both the decode and the host-to-device transfer.
+            data.set_size(samples.size(), k, nr, nc);
+            alias_tensor slice(1, k, nr, nc);
+            for (size_t i = 0; i < samples.size(); ++i)
+            {
+                auto dest = slice(data, i*slice.size());
+                memcpy(dest, *samples[i]);
+            }
+
+            // Only evict after the batch is assembled so entries used above can't be
+            // deleted out from under us.
+            evict();
+        }
+
+        friend void serialize(const input_cached& item, std::ostream& out)
+        {
+            serialize("input_cached", out);
+            serialize(item.sub, out);
+        }
+
+        friend void deserialize(input_cached& item, std::istream& in)
+        {
+            std::string version;
+            deserialize(version, in);
+            if (version != "input_cached")
+                throw serialization_error("Unexpected version found while deserializing dlib::input_cached.");
+            deserialize(item.sub, in);
+            item.clear_cache();
+        }
+
+        friend std::ostream& operator<<(std::ostream& out, const input_cached& item)
+        {
+            out << "input_cached<" << item.sub << ">";
+            return out;
+        }
+
+        friend void to_xml(const input_cached& item, std::ostream& out)
+        {
+            out << "<input_cached>";
+            to_xml(item.sub, out);
+            out << "</input_cached>";
+        }
+
+    private:
+
+        struct entry
+        {
+            unsigned long long id;
+            resizable_tensor data;
+        };
+
+        void evict (
+        ) const
+        {
+            while (cache_bytes > max_cache_bytes && lru.size() > 1)
+            {
+                entry& e = lru.back();
+                cache_bytes -= e.data.size()*sizeof(float);
+                cache.erase(e.id);
+                lru.pop_back();
+            }
+        }
+
+        SUBLAYER sub;
+        size_t max_cache_bytes;
+
+        mutable std::mutex cache_mutex;
+        mutable std::unordered_map<unsigned long long, typename std::list<entry>::iterator> cache;
+        mutable std::list<entry> lru;
+        mutable size_t cache_bytes;
+    };
+
 // ----------------------------------------------------------------------------------------
 
 }
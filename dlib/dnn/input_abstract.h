@@ -271,6 +271,168 @@ namespace dlib
 
     };
 
+// ----------------------------------------------------------------------------------------
+
+    struct yuv_image
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                A non-owning view of a YUV 4:2:0 camera frame, either semi-planar
+                (NV12, one full resolution Y plane followed by an interleaved UV
+                plane) or planar (I420, separate half resolution U and V planes).
+                This is the raw layout video capture APIs hand out, so frames can be
+                wrapped in this struct and fed to input_yuv_image without copying or
+                converting them first.  The pointed to memory must stay valid while
+                the view is in use.
+        !*/
+
+        enum layout_type
+        {
+            NV12,   // u points at the interleaved UV plane, v is ignored.
+            I420    // u and v point at separate half resolution planes.
+        };
+
+        const unsigned char* y = nullptr;
+        const unsigned char* u = nullptr;
+        const unsigned char* v = nullptr;
+        long nr = 0;
+        long nc = 0;
+        long y_stride = 0;   // in bytes, between consecutive rows of the Y plane
+        long uv_stride = 0;  // in bytes, between consecutive rows of the chroma plane(s)
+        layout_type layout = NV12;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    class input_yuv_image
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This input layer works directly with YUV 4:2:0 video frames described
+                by yuv_image views.  It behaves like input_rgb_image, producing the
+                same 3 channel RGB tensor, except that the BT.601 colorspace
+                conversion is fused into the normalization pass of to_tensor().  That
+                means camera frames don't need a separate YUV to RGB conversion stage
+                before being handed to a network.
+        !*/
+    public:
+        typedef yuv_image input_type;
+
+        input_yuv_image (
+        );
+        /*!
+            ensures
+                - #get_avg_red()   == 122.782
+                - #get_avg_green() == 117.001
+                - #get_avg_blue()  == 104.298
+        !*/
+
+        input_yuv_image (
+            float avg_red,
+            float avg_green,
+            float avg_blue
+        );
+        /*!
+            ensures
+                - #get_avg_red() == avg_red
+                - #get_avg_green() == avg_green
+                - #get_avg_blue() == avg_blue
+        !*/
+
+        float get_avg_red(
+        ) const;
+        /*!
+            ensures
+                - returns the value subtracted from the red color channel.
+        !*/
+
+        float get_avg_green(
+        ) const;
+        /*!
+            ensures
+                - returns the value subtracted from the green color channel.
+        !*/
+
+        float get_avg_blue(
+        ) const;
+        /*!
+            ensures
+                - returns the value subtracted from the blue color channel.
+        !*/
+
+        template <typename forward_iterator>
+        void to_tensor (
+            forward_iterator ibegin,
+            forward_iterator iend,
+            resizable_tensor& data
+        ) const;
+        /*!
+            requires
+                - [ibegin, iend) is an iterator range over input_type objects.
+                - std::distance(ibegin,iend) > 0
+                - The input range should contain frames that all have the same
+                  dimensions, with even numbers of rows and columns, and with their
+                  plane pointers set.
+            ensures
+                - Converts the iterator range into a tensor and stores it into #data,
+                  exactly as input_rgb_image::to_tensor() would if given the BT.601
+                  RGB conversion of each frame.  In particular, if the input frames
+                  have R rows and C columns then we will have:
+                    - #data.num_samples() == std::distance(ibegin,iend)
+                    - #data.nr() == R
+                    - #data.nc() == C
+                    - #data.k() == 3
+                  Each color channel is normalized by having its average value
+                  subtracted (according to get_avg_red(), get_avg_green(), or
+                  get_avg_blue()) and then is divided by 256.0.
+        !*/
+
+
+        // Provided for compatibility with input_rgb_image_pyramid's interface
+        bool image_contained_point ( const tensor& data, const point& p) const { return get_rect(data).contains(p); }
+        drectangle tensor_space_to_image_space ( const tensor& /*data*/, drectangle r) const { return r; }
+        drectangle image_space_to_tensor_space ( const tensor& /*data*/, double /*scale*/, drectangle r ) const { return r; }
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    void extract_image_chips (
+        const tensor& img,
+        const std::vector<chip_details>& chip_locations,
+        resizable_tensor& chips
+    );
+    /*!
+        requires
+            - img.num_samples() == 1
+            - chip_locations.size() > 0
+            - for all valid i:
+                - chip_locations[i].rect.is_empty() == false
+                - chip_locations[i].size() != 0
+                - chip_locations[i].rows == chip_locations[0].rows
+                - chip_locations[i].cols == chip_locations[0].cols
+        ensures
+            - This function is the tensor analog of the image based
+              extract_image_chips() routine.  It cuts a batch of scaled and rotated
+              chips directly out of an image that has already been converted into a
+              tensor, e.g. by an input layer's to_tensor().  When dlib is compiled
+              with CUDA the warping happens entirely on the GPU, so a whole frame can
+              be uploaded once and then any number of chips extracted from it without
+              per-chip host work or host to device copies.
+            - #chips.num_samples() == chip_locations.size()
+            - #chips.k() == img.k()
+            - #chips.nr() == chip_locations[0].rows
+            - #chips.nc() == chip_locations[0].cols
+            - The ith sample of #chips contains the contents of
+              chip_locations[i].rect in img, rotated counter-clockwise by
+              chip_locations[i].angle radians around the center of that rectangle and
+              bilinearly interpolated into the chip dimensions, exactly as described
+              for extract_image_chips().  Pixels sampled from outside img are 0.
+            - Unlike extract_image_chips(), no image pyramid is used.  Chips
+              downscaled by large factors are plain bilinear decimations of img, so
+              this function is best suited to chips near their source resolution,
+              like the aligned face crops fed to a loss_metric network.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -608,6 +770,123 @@ namespace dlib
 
     };
 
+// ----------------------------------------------------------------------------------------
+
+    template <typename SUBLAYER>
+    class input_cached
+    {
+        /*!
+            REQUIREMENTS ON SUBLAYER
+                SUBLAYER must be an object that implements the EXAMPLE_INPUT_LAYER
+                interface defined at the top of this file (e.g. input_rgb_image).
+                All the samples given to an instance of this layer must map to
+                tensors with identical dimensions (as is the case for fixed size
+                training crops).
+
+            WHAT THIS OBJECT REPRESENTS
+                This is an input layer that wraps another input layer and caches the
+                per-sample tensors it produces.  Each sample is a
+                std::pair<unsigned long long, SUBLAYER::input_type> where the first
+                element is a user-assigned id that uniquely identifies the sample.
+                The first time an id is seen its image is converted with the
+                sublayer's to_tensor() and the resulting tensor is kept; later
+                batches containing the same id just copy the cached tensor into the
+                output batch.  When dlib is compiled with CUDA the cached tensors
+                live on the GPU, so a cache hit skips both the image decode/convert
+                work and the host-to-device copy.  This makes repeated training
+                epochs over a dataset that fits in memory dramatically cheaper.
+
+                The cache is bounded: once it holds more than
+                get_max_cache_size_bytes() of tensor data the least recently used
+                entries are evicted.
+
+            THREAD SAFETY
+                to_tensor() and the cache accessors may be called concurrently from
+                multiple threads.  Note that copies of this object share the
+                sublayer settings but not the cache contents.
+        !*/
+    public:
+        typedef std::pair<unsigned long long, typename SUBLAYER::input_type> input_type;
+
+        input_cached (
+        );
+        /*!
+            ensures
+                - #get_sublayer() == SUBLAYER()
+                - #get_max_cache_size_bytes() == 1024*1024*1024
+                - #get_cache_size_bytes() == 0
+        !*/
+
+        explicit input_cached (
+            const SUBLAYER& sub,
+            size_t max_cache_size_bytes = 1024*1024*1024
+        );
+        /*!
+            ensures
+                - #get_sublayer() == sub
+                - #get_max_cache_size_bytes() == max_cache_size_bytes
+                - #get_cache_size_bytes() == 0
+        !*/
+
+        const SUBLAYER& get_sublayer (
+        ) const;
+        /*!
+            ensures
+                - returns the input layer used to convert individual samples into
+                  tensors.
+        !*/
+
+        size_t get_max_cache_size_bytes (
+        ) const;
+        /*!
+            ensures
+                - returns the bound, in bytes of tensor data, on the sample cache.
+        !*/
+
+        void set_max_cache_size_bytes (
+            size_t max_bytes
+        );
+        /*!
+            ensures
+                - #get_max_cache_size_bytes() == max_bytes
+                - evicts least recently used entries until the cache fits the new
+                  bound.
+        !*/
+
+        size_t get_cache_size_bytes (
+        ) const;
+        /*!
+            ensures
+                - returns the number of bytes of tensor data currently cached.
+        !*/
+
+        void clear_cache (
+        );
+        /*!
+            ensures
+                - #get_cache_size_bytes() == 0
+        !*/
+
+        template <typename forward_iterator>
+        void to_tensor (
+            forward_iterator ibegin,
+            forward_iterator iend,
+            resizable_tensor& data
+        ) const;
+        /*!
+            requires
+                - [ibegin, iend) is an iterator range over input_type objects.
+                - std::distance(ibegin,iend) > 0
+            ensures
+                - #data contains exactly what
+                  get_sublayer().to_tensor(images...,data) would have produced for
+                  the images in the given samples, except that samples whose id was
+                  seen before are copied from the cache instead of being converted
+                  again.  Therefore, a given id must always be paired with the same
+                  image.
+        !*/
+    };
+
 // ----------------------------------------------------------------------------------------
 
 }
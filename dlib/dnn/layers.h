@@ -107,6 +107,9 @@ namespace dlib
         void set_bias_learning_rate_multiplier(double val) { bias_learning_rate_multiplier = val; }
         void set_bias_weight_decay_multiplier(double val)  { bias_weight_decay_multiplier  = val; }
 
+        void set_int8_inference(bool val) { use_int8_inference = val; }
+        bool int8_inference() const       { return use_int8_inference; }
+
         inline dpoint map_input_to_output (
             dpoint p
         ) const
@@ -127,7 +130,7 @@ namespace dlib
 
         con_ (
             const con_& item
-        ) : 
+        ) :
             params(item.params),
             filters(item.filters),
             biases(item.biases),
@@ -137,7 +140,8 @@ namespace dlib
             bias_weight_decay_multiplier(item.bias_weight_decay_multiplier),
             num_filters_(item.num_filters_),
             padding_y_(item.padding_y_),
-            padding_x_(item.padding_x_)
+            padding_x_(item.padding_x_),
+            use_int8_inference(item.use_int8_inference)
         {
             // this->conv is non-copyable and basically stateless, so we have to write our
             // own copy to avoid trying to copy it and getting an error.
@@ -162,6 +166,7 @@ namespace dlib
             bias_learning_rate_multiplier = item.bias_learning_rate_multiplier;
             bias_weight_decay_multiplier = item.bias_weight_decay_multiplier;
             num_filters_ = item.num_filters_;
+            use_int8_inference = item.use_int8_inference;
             return *this;
         }
 
@@ -195,12 +200,12 @@ namespace dlib
                        _stride_x,
                        padding_y_,
                        padding_x_);
+            conv.enable_int8(use_int8_inference);
             conv(false, output,
                 sub.get_output(),
-                filters(params,0));
-
-            tt::add(1,output,1,biases(params,filters.size()));
-        } 
+                filters(params,0),
+                biases(params,filters.size()));
+        }
 
         template <typename SUBNET>
         void backward(const tensor& gradient_input, SUBNET& sub, tensor& params_grad)
@@ -329,6 +334,9 @@ namespace dlib
         int padding_y_;
         int padding_x_;
 
+        // Runtime inference setting, deliberately not serialized.
+        bool use_int8_inference = false;
+
     };
 
     template <
@@ -2045,6 +2053,21 @@ namespace dlib
 
         layer_mode get_mode() const { return mode; }
 
+        alias_tensor_const_instance get_gamma() const { return gamma(params,0); }
+        alias_tensor_const_instance get_beta() const { return beta(params,gamma.size()); }
+
+        void disable()
+        {
+            // Make the layer an identity transform.  The params are set accordingly,
+            // rather than just relying on the disabled flag, so serializing and then
+            // deserializing the network still gives correct (if unfused) behavior.
+            gamma(params,0) = 1;
+            beta(params,gamma.size()) = 0;
+            disabled = true;
+        }
+
+        bool is_disabled() const { return disabled; }
+
         inline dpoint map_input_to_output (const dpoint& p) const { return p; }
         inline dpoint map_output_to_input (const dpoint& p) const { return p; }
 
@@ -2072,13 +2095,21 @@ namespace dlib
 
         void forward_inplace(const tensor& input, tensor& output)
         {
+            if (disabled)
+            {
+                // this layer has been fused into the layer below it
+                if (!is_same_object(input, output))
+                    memcpy(output, input);
+                return;
+            }
+
             auto g = gamma(params,0);
             auto b = beta(params,gamma.size());
             if (mode == FC_MODE)
                 tt::affine_transform(output, input, g, b);
             else
                 tt::affine_transform_conv(output, input, g, b);
-        } 
+        }
 
         void backward_inplace(
             const tensor& gradient_input, 
@@ -2175,9 +2206,12 @@ namespace dlib
         }
 
     private:
-        resizable_tensor params, empty_params; 
+        resizable_tensor params, empty_params;
         alias_tensor gamma, beta;
         layer_mode mode;
+        // Set by fuse_layers() after this layer's transform has been folded into the
+        // layer below it.  Deliberately not serialized, see disable().
+        bool disabled = false;
     };
 
     template <typename SUBNET>
@@ -3448,6 +3482,112 @@ namespace dlib
         >
     using extract = add_layer<extract_<offset,k,nr,nc>, SUBNET>;
 
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        class visitor_int8_inference
+        {
+        public:
+            visitor_int8_inference(bool enabled_) : enabled(enabled_) {}
+
+            // Layers that have a set_int8_inference() member get it called, everything
+            // else is left alone.
+            template <typename T>
+            auto set(T& l, int) const -> decltype(l.set_int8_inference(true), void())
+            {
+                l.set_int8_inference(enabled);
+            }
+            template <typename T>
+            void set(T&, long) const {}
+
+            template<typename input_layer_type>
+            void operator()(size_t , input_layer_type& ) const
+            {
+                // ignore other layers
+            }
+
+            template <typename T, typename U, typename E>
+            void operator()(size_t , add_layer<T,U,E>& l) const
+            {
+                set(l.layer_details(), 0);
+            }
+
+        private:
+            bool enabled;
+        };
+    }
+
+    template <typename net_type>
+    void set_int8_inference (
+        net_type& net,
+        bool enabled = true
+    )
+    {
+        visit_layers(net, impl::visitor_int8_inference(enabled));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        class visitor_fuse_layers
+        {
+        public:
+            template <typename input_layer_type>
+            void operator()(size_t , input_layer_type& ) const
+            {
+                // ignore other layers
+            }
+
+            template <typename T, typename U, typename E>
+            void operator()(size_t , add_layer<T,U,E>& ) const
+            {
+                // ignore other layers
+            }
+
+            // an affine_ sitting directly on top of a con_: fold the scale and shift
+            // into the convolution's filters and biases.
+            template <
+                long nf, long nr, long nc, int sy, int sx, int py, int px,
+                typename U, typename E, typename E2
+                >
+            void operator()(size_t , add_layer<affine_, add_layer<con_<nf,nr,nc,sy,sx,py,px>,U,E>, E2>& l) const
+            {
+                auto& aff = l.layer_details();
+                auto& conv = l.subnet().layer_details();
+                if (aff.get_mode() != CONV_MODE || aff.is_disabled())
+                    return;
+
+                tensor& params = conv.get_layer_params();
+                if (params.size() == 0)
+                    return; // the network hasn't been run yet, nothing to fuse
+
+                const long num_filters = conv.num_filters();
+                const long fsize = (params.size() - num_filters)/num_filters;
+                const float* g = aff.get_gamma().get().host();
+                const float* b = aff.get_beta().get().host();
+                float* w = params.host();
+                for (long k = 0; k < num_filters; ++k)
+                {
+                    for (long i = 0; i < fsize; ++i)
+                        w[k*fsize + i] *= g[k];
+                    float& bias = w[num_filters*fsize + k];
+                    bias = g[k]*bias + b[k];
+                }
+                aff.disable();
+            }
+        };
+    }
+
+    template <typename net_type>
+    void fuse_layers (
+        net_type& net
+    )
+    {
+        visit_layers(net, impl::visitor_fuse_layers());
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -895,7 +895,7 @@ namespace dlib
 
         void set_bias_weight_decay_multiplier(
             double val
-        ); 
+        );
         /*!
             requires
                 - val >= 0
@@ -903,13 +903,38 @@ namespace dlib
                 - #get_bias_weight_decay_multiplier() == val
         !*/
 
+        void set_int8_inference(
+            bool val
+        );
+        /*!
+            ensures
+                - #int8_inference() == val
+                - if (val == true) then
+                    - forward() quantizes the filters and input to 8 bits and convolves
+                      with integer arithmetic, writing dequantized float results.  This
+                      is an inference time optimization for trained networks.  Outputs
+                      will differ slightly from the float path due to quantization
+                      error, and training should be done with int8_inference() == false.
+                      Note that this setting only applies when dlib is running the
+                      convolution on the CPU.  It is not serialized along with the
+                      network.
+        !*/
+
+        bool int8_inference(
+        ) const;
+        /*!
+            ensures
+                - returns true if forward() will run the quantized 8 bit convolution
+                  path and false if it will use the normal float path.
+        !*/
+
         template <typename SUBNET> void setup (const SUBNET& sub);
         template <typename SUBNET> void forward(const SUBNET& sub, resizable_tensor& output);
         template <typename SUBNET> void backward(const tensor& gradient_input, SUBNET& sub, tensor& params_grad);
         dpoint map_input_to_output(dpoint p) const;
         dpoint map_output_to_input(dpoint p) const;
-        const tensor& get_layer_params() const; 
-        tensor& get_layer_params(); 
+        const tensor& get_layer_params() const;
+        tensor& get_layer_params();
         /*!
             These functions are implemented as described in the EXAMPLE_COMPUTATIONAL_LAYER_ interface.
         !*/
@@ -1686,10 +1711,45 @@ namespace dlib
         !*/
 
         layer_mode get_mode(
-        ) const; 
+        ) const;
+        /*!
+            ensures
+                - returns the mode of this layer, either CONV_MODE or FC_MODE.
+        !*/
+
+        alias_tensor_const_instance get_gamma(
+        ) const;
         /*!
             ensures
-                - returns the mode of this layer, either CONV_MODE or FC_MODE.  
+                - returns the A tensor of this layer's y = A*x + B transformation.
+        !*/
+
+        alias_tensor_const_instance get_beta(
+        ) const;
+        /*!
+            ensures
+                - returns the B tensor of this layer's y = A*x + B transformation.
+        !*/
+
+        void disable(
+        );
+        /*!
+            ensures
+                - #is_disabled() == true
+                - This layer becomes an identity transform: forward_inplace() just
+                  passes its input through.  This is used by fuse_layers() after the
+                  layer's transform has been folded into the layer below it.  The
+                  layer's parameters are also set to A=1, B=0, so serializing and then
+                  deserializing the network still computes the right thing (the
+                  disabled flag itself is not serialized, so a reloaded network runs
+                  the, now identity, transform until fuse_layers() is called again).
+        !*/
+
+        bool is_disabled(
+        ) const;
+        /*!
+            ensures
+                - returns true if disable() has been called on this layer.
         !*/
 
         template <typename SUBNET> void setup (const SUBNET& sub);
@@ -2729,6 +2789,47 @@ namespace dlib
         >
     using extract = add_layer<extract_<offset,k,nr,nc>, SUBNET>;
 
+// ----------------------------------------------------------------------------------------
+
+    template <typename net_type>
+    void set_int8_inference (
+        net_type& net,
+        bool enabled = true
+    );
+    /*!
+        requires
+            - net_type is an object of type add_layer, add_loss_layer, add_skip_layer, or
+              add_tag_layer.
+        ensures
+            - Visits each layer in net and, for every layer whose layer details object
+              has a set_int8_inference() member function (e.g. con_), calls
+              layer_details().set_int8_inference(enabled).  Layers without that member
+              are left unmodified.  See con_::set_int8_inference() for what the setting
+              does.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename net_type>
+    void fuse_layers (
+        net_type& net
+    );
+    /*!
+        requires
+            - net_type is an object of type add_layer, add_loss_layer, add_skip_layer, or
+              add_tag_layer.
+            - net has been run at least once, i.e. its parameters are allocated.
+        ensures
+            - Fuses adjacent layers where doing so doesn't change the network's output.
+              Currently this means every affine_ layer in CONV_MODE sitting directly on
+              top of a con_ layer has its scale and shift folded into the convolution's
+              filters and biases, after which the affine_ layer is disabled (see
+              affine_::disable()).  Combined with the convolution's fused bias add,
+              this collapses the usual con->affine sequence into a single pass over
+              the activation tensor.  This is an inference time optimization; don't
+              train a network after fusing it.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
 }
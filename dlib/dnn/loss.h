@@ -1104,11 +1104,13 @@ namespace dlib
 
                 // Do non-max suppression
                 final_dets.clear();
+                box_overlap_index suppressed(options.overlaps_nms);
                 for (unsigned long i = 0; i < dets_accum.size(); ++i)
                 {
-                    if (overlaps_any_box_nms(final_dets, dets_accum[i].rect_bbr))
+                    if (suppressed.overlaps_any(dets_accum[i].rect_bbr))
                         continue;
 
+                    suppressed.add(dets_accum[i].rect_bbr);
                     final_dets.push_back(mmod_rect(dets_accum[i].rect_bbr,
                                                    dets_accum[i].detection_confidence,
                                                    options.detector_windows[dets_accum[i].tensor_channel].label));
@@ -1470,49 +1472,68 @@ namespace dlib
                 DLIB_CASSERT(output_tensor.k() == (long)options.detector_windows.size());
             }
 
-            const float* out_data = output_tensor.host() + output_tensor.k()*output_tensor.nr()*output_tensor.nc()*i;
-            // scan the final layer and output the positive scoring locations
+            const size_t sample_offset = (size_t)output_tensor.k()*output_tensor.nr()*output_tensor.nc()*i;
+            const size_t num_score_cells = options.detector_windows.size()*(size_t)output_tensor.nr()*output_tensor.nc();
+
+            // Find the positive scoring locations.  When compiled with CUDA the
+            // thresholding runs on the device, so only the above threshold cells are
+            // copied back to the host rather than the entire output tensor.
+            std::vector<std::pair<size_t,float>> hits;
+            tt::find_greater_than(hits, output_tensor, sample_offset, sample_offset+num_score_cells, adjust_threshold);
+
             dets_accum.clear();
-            for (long k = 0; k < (long)options.detector_windows.size(); ++k)
+            std::vector<size_t> bbr_idxs;
+            for (auto& hit : hits)
             {
-                for (long r = 0; r < output_tensor.nr(); ++r)
-                {
-                    for (long c = 0; c < output_tensor.nc(); ++c)
-                    {
-                        double score = out_data[(k*output_tensor.nr() + r)*output_tensor.nc() + c];
-                        if (score > adjust_threshold)
-                        {
-                            dpoint p = output_tensor_to_input_tensor(net, point(c,r));
-                            drectangle rect = centered_drect(p, options.detector_windows[k].width, options.detector_windows[k].height);
-                            rect = input_layer(net).tensor_space_to_image_space(input_tensor,rect);
+                const size_t idx = hit.first - sample_offset;
+                const long k = idx/(output_tensor.nr()*output_tensor.nc());
+                const long r = (idx/output_tensor.nc())%output_tensor.nr();
+                const long c = idx%output_tensor.nc();
 
-                            dets_accum.push_back(intermediate_detection(rect, score, (k*output_tensor.nr() + r)*output_tensor.nc() + c, k));
+                dpoint p = output_tensor_to_input_tensor(net, point(c,r));
+                drectangle rect = centered_drect(p, options.detector_windows[k].width, options.detector_windows[k].height);
+                rect = input_layer(net).tensor_space_to_image_space(input_tensor,rect);
 
-                            if (options.use_bounding_box_regression)
-                            {
-                                const auto offset = options.detector_windows.size() + k*4;
-                                dets_accum.back().tensor_offset_dx = ((offset+0)*output_tensor.nr() + r)*output_tensor.nc() + c;
-                                dets_accum.back().tensor_offset_dy = ((offset+1)*output_tensor.nr() + r)*output_tensor.nc() + c;
-                                dets_accum.back().tensor_offset_dw = ((offset+2)*output_tensor.nr() + r)*output_tensor.nc() + c;
-                                dets_accum.back().tensor_offset_dh = ((offset+3)*output_tensor.nr() + r)*output_tensor.nc() + c;
-
-                                // apply BBR to dets_accum.back()
-                                double dx = out_data[dets_accum.back().tensor_offset_dx];
-                                double dy = out_data[dets_accum.back().tensor_offset_dy];
-                                double dw = out_data[dets_accum.back().tensor_offset_dw];
-                                double dh = out_data[dets_accum.back().tensor_offset_dh];
-                                dw = std::exp(dw);
-                                dh = std::exp(dh);
-                                double w = rect.width()-1;
-                                double h = rect.height()-1;
-                                rect = translate_rect(rect, dpoint(dx*w,dy*h));
-                                rect = centered_drect(rect, w*dw+1, h*dh+1);
-                                dets_accum.back().rect_bbr = rect;
-                            }
-                        }
-                    }
+                dets_accum.push_back(intermediate_detection(rect, hit.second, idx, k));
+
+                if (options.use_bounding_box_regression)
+                {
+                    const auto offset = options.detector_windows.size() + k*4;
+                    dets_accum.back().tensor_offset_dx = ((offset+0)*output_tensor.nr() + r)*output_tensor.nc() + c;
+                    dets_accum.back().tensor_offset_dy = ((offset+1)*output_tensor.nr() + r)*output_tensor.nc() + c;
+                    dets_accum.back().tensor_offset_dw = ((offset+2)*output_tensor.nr() + r)*output_tensor.nc() + c;
+                    dets_accum.back().tensor_offset_dh = ((offset+3)*output_tensor.nr() + r)*output_tensor.nc() + c;
+
+                    bbr_idxs.push_back(sample_offset + dets_accum.back().tensor_offset_dx);
+                    bbr_idxs.push_back(sample_offset + dets_accum.back().tensor_offset_dy);
+                    bbr_idxs.push_back(sample_offset + dets_accum.back().tensor_offset_dw);
+                    bbr_idxs.push_back(sample_offset + dets_accum.back().tensor_offset_dh);
                 }
             }
+
+            if (options.use_bounding_box_regression)
+            {
+                // Pull back just the regression outputs for the detections we found
+                // and apply BBR to each of them.
+                std::vector<float> bbr_vals;
+                tt::gather(bbr_vals, output_tensor, bbr_idxs);
+                for (size_t j = 0; j < dets_accum.size(); ++j)
+                {
+                    double dx = bbr_vals[4*j+0];
+                    double dy = bbr_vals[4*j+1];
+                    double dw = bbr_vals[4*j+2];
+                    double dh = bbr_vals[4*j+3];
+                    dw = std::exp(dw);
+                    dh = std::exp(dh);
+                    drectangle rect = dets_accum[j].rect;
+                    double w = rect.width()-1;
+                    double h = rect.height()-1;
+                    rect = translate_rect(rect, dpoint(dx*w,dy*h));
+                    rect = centered_drect(rect, w*dw+1, h*dh+1);
+                    dets_accum[j].rect_bbr = rect;
+                }
+            }
+
             std::sort(dets_accum.rbegin(), dets_accum.rend());
         }
 
@@ -2736,6 +2757,12 @@ namespace dlib
                              "output size = " << output_tensor.nr() << " x " << output_tensor.nc());
             }
 
+#ifdef DLIB_USE_CUDA
+            double loss;
+            cuda_compute(truth, output_tensor, grad, loss);
+            return loss;
+#else
+
             tt::softmax(grad, output_tensor);
 
             // The loss we output is the weighted average loss over the mini-batch, and also over each element of the matrix output.
@@ -2772,6 +2799,7 @@ namespace dlib
                 }
             }
             return loss;
+#endif
         }
 
         friend void serialize(const loss_multiclass_log_per_pixel_weighted_& , std::ostream& out)
@@ -2805,6 +2833,9 @@ namespace dlib
             return ((sample * t.k() + k) * t.nr() + row) * t.nc() + column;
         }
 
+#ifdef DLIB_USE_CUDA
+        cuda::compute_loss_multiclass_log_per_pixel_weighted cuda_compute;
+#endif
     };
 
     template <typename SUBNET>
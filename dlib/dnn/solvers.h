@@ -5,11 +5,40 @@
 
 #include "solvers_abstract.h"
 #include "../cuda/tensor.h"
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <vector>
 #include "layers.h"
 
 namespace dlib
 {
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        template <typename layer_type>
+        auto sparse_gradient_rows (
+            const layer_type& l,
+            special_
+        ) -> decltype(&l.get_sparse_gradient_rows())
+        {
+            return &l.get_sparse_gradient_rows();
+        }
+
+        template <typename layer_type>
+        const std::vector<unsigned long>* sparse_gradient_rows (
+            const layer_type&,
+            general_
+        )
+        {
+            return nullptr;
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
     class sgd
     {
     public:
@@ -44,15 +73,22 @@ namespace dlib
             const tensor& params = l.get_layer_params();
 
             DLIB_CASSERT(params.size() != 0);
+
+            const double lr = learning_rate*get_learning_rate_multiplier(l);
+            const double wd = weight_decay*get_weight_decay_multiplier(l);
+
+            // Layers that report which parameter rows their gradients touched get a
+            // sparse update that only visits those rows.
+            const std::vector<unsigned long>* rows = impl::sparse_gradient_rows(l, special_());
+            if (rows)
+                return compute_sparse_update(lr, wd, params, params_grad, *rows);
+
             if (v.size() == 0)
             {
                 v.copy_size(params_grad);
                 v = 0;
             }
 
-            const double lr = learning_rate*get_learning_rate_multiplier(l);
-            const double wd = weight_decay*get_weight_decay_multiplier(l);
-            
             //perform: v = momentum*mat(v) - wd*lr*mat(params) - lr*mat(params_grad);
             tt::affine_transform(v, v, params, params_grad, momentum, -wd*lr, -lr);
 
@@ -121,21 +157,39 @@ namespace dlib
 
         friend void serialize(const sgd& item, std::ostream& out)
         {
-            serialize("sgd2", out);
+            serialize("sgd3", out);
             serialize(item.v, out);
             serialize(item.weight_decay, out);
             serialize(item.momentum, out);
+            serialize(item.sparse_step, out);
+            serialize(item.row_last_seen, out);
+            serialize(item.prev_rows, out);
+            serialize(item.step_count, out);
         }
 
         friend void deserialize(sgd& item, std::istream& in)
         {
             std::string version;
             deserialize(version, in);
-            if (version != "sgd2")
+            if (version != "sgd2" && version != "sgd3")
                 throw serialization_error("Unexpected version found while deserializing dlib::sgd.");
             deserialize(item.v, in);
             deserialize(item.weight_decay, in);
             deserialize(item.momentum, in);
+            if (version == "sgd3")
+            {
+                deserialize(item.sparse_step, in);
+                deserialize(item.row_last_seen, in);
+                deserialize(item.prev_rows, in);
+                deserialize(item.step_count, in);
+            }
+            else
+            {
+                item.sparse_step.clear();
+                item.row_last_seen.clear();
+                item.prev_rows.clear();
+                item.step_count = 0;
+            }
         }
 
         friend std::ostream& operator<< (std::ostream& out, const sgd& item)
@@ -184,10 +238,75 @@ namespace dlib
             }
         }
 
+        const tensor& compute_sparse_update (
+            const double lr,
+            const double wd,
+            const tensor& params,
+            const tensor& params_grad,
+            const std::vector<unsigned long>& rows
+        )
+        /*!
+            ensures
+                - Computes the sgd step for just the given parameter rows, leaving the
+                  returned step tensor zero everywhere else.  The momentum a row missed
+                  while it went untouched is caught up by decaying its momentum buffer
+                  by momentum^k, and the weight decay skipped on those steps is applied
+                  in one shot via (1-wd*lr)^k, where k is the number of solver steps
+                  since the row was last touched.
+        !*/
+        {
+            const size_t num_rows = params.num_samples();
+            const size_t row_len = params.size()/num_rows;
+
+            if (v.size() == 0)
+            {
+                v.copy_size(params_grad);
+                v = 0;
+                sparse_step.copy_size(params_grad);
+                sparse_step = 0;
+            }
+            if (row_last_seen.size() != num_rows)
+                row_last_seen.assign(num_rows, step_count);
+            ++step_count;
+
+            float* step = sparse_step.host();
+            // Clear the rows written by the previous call.  Everything else is still
+            // zero, so we never have to touch the full tensor.
+            for (auto r : prev_rows)
+                std::memset(step + r*row_len, 0, row_len*sizeof(float));
+            prev_rows = rows;
+
+            const float* p = params.host();
+            const float* g = params_grad.host();
+            float* pv = v.host();
+            for (auto r : rows)
+            {
+                DLIB_CASSERT(r < num_rows);
+                const unsigned long k = step_count - row_last_seen[r];
+                row_last_seen[r] = step_count;
+                const float mom_k = static_cast<float>(std::pow(momentum, (double)k));
+                const float decay_k = static_cast<float>(std::pow(1-wd*lr, (double)k));
+                for (size_t j = 0; j < row_len; ++j)
+                {
+                    const size_t idx = r*row_len + j;
+                    pv[idx] = mom_k*pv[idx] - lr*g[idx];
+                    step[idx] = pv[idx] + (decay_k-1)*p[idx];
+                }
+            }
+
+            return sparse_step;
+        }
+
         resizable_tensor v;
         float weight_decay;
         float momentum;
 
+        // state used only by compute_sparse_update()
+        resizable_tensor sparse_step;
+        std::vector<unsigned long> row_last_seen;
+        std::vector<unsigned long> prev_rows;
+        unsigned long step_count = 0;
+
     };
 
 // ----------------------------------------------------------------------------------------
@@ -230,6 +349,18 @@ namespace dlib
         {
             const tensor& params = l.get_layer_params();
             DLIB_CASSERT(params.size() != 0);
+
+            // Layers that report which parameter rows their gradients touched get a
+            // sparse update that only visits those rows.
+            const std::vector<unsigned long>* rows = impl::sparse_gradient_rows(l, special_());
+            if (rows)
+            {
+                return compute_sparse_update(
+                    learning_rate*get_learning_rate_multiplier(l),
+                    weight_decay*get_weight_decay_multiplier(l),
+                    params, params_grad, *rows);
+            }
+
             if (v.size() == 0)
             {
                 m.copy_size(params_grad);
@@ -241,10 +372,10 @@ namespace dlib
 
             ++t;
 
-            
+
             tt::compute_adam_update(0, params.size(), s, m, v, t,
                 learning_rate*get_learning_rate_multiplier(l),
-                weight_decay*get_weight_decay_multiplier(l), 
+                weight_decay*get_weight_decay_multiplier(l),
                 momentum1, momentum2, params, params_grad);
 
             return s;
@@ -313,7 +444,7 @@ namespace dlib
 
         friend void serialize(const adam& item, std::ostream& out)
         {
-            serialize("adam2", out);
+            serialize("adam3", out);
             serialize(item.m, out);
             serialize(item.v, out);
             serialize(item.s, out);
@@ -321,13 +452,15 @@ namespace dlib
             serialize(item.momentum1, out);
             serialize(item.momentum2, out);
             serialize(item.t, out);
+            serialize(item.row_step, out);
+            serialize(item.prev_rows, out);
         }
 
         friend void deserialize(adam& item, std::istream& in)
         {
             std::string version;
             deserialize(version, in);
-            if (version != "adam2")
+            if (version != "adam2" && version != "adam3")
                 throw serialization_error("Unexpected version found while deserializing dlib::adam.");
             deserialize(item.m, in);
             deserialize(item.v, in);
@@ -336,6 +469,16 @@ namespace dlib
             deserialize(item.momentum1, in);
             deserialize(item.momentum2, in);
             deserialize(item.t, in);
+            if (version == "adam3")
+            {
+                deserialize(item.row_step, in);
+                deserialize(item.prev_rows, in);
+            }
+            else
+            {
+                item.row_step.clear();
+                item.prev_rows.clear();
+            }
         }
 
         friend std::ostream& operator<< (std::ostream& out, const adam& item)
@@ -388,6 +531,68 @@ namespace dlib
                     momentum1, momentum2, params, params_grad);
             }
         }
+
+        const tensor& compute_sparse_update (
+            const double lr,
+            const double wd,
+            const tensor& params,
+            const tensor& params_grad,
+            const std::vector<unsigned long>& rows
+        )
+        /*!
+            ensures
+                - Computes the adam step for just the given parameter rows, leaving the
+                  returned step tensor zero everywhere else.  The first and second
+                  moment estimates of untouched rows are left frozen (i.e. the lazy
+                  adam variant) and each row keeps its own update counter so its bias
+                  correction is based on how often that row has actually been updated.
+        !*/
+        {
+            const size_t num_rows = params.num_samples();
+            const size_t row_len = params.size()/num_rows;
+
+            if (v.size() == 0)
+            {
+                m.copy_size(params_grad);
+                m = 0;
+                v.copy_size(params_grad);
+                v = 0;
+                s.copy_size(params_grad);
+                s = 0;
+            }
+            if (row_step.size() != num_rows)
+                row_step.assign(num_rows, 0);
+
+            float* step = s.host();
+            // Clear the rows written by the previous call.  Everything else is still
+            // zero, so we never have to touch the full tensor.
+            for (auto r : prev_rows)
+                std::memset(step + r*row_len, 0, row_len*sizeof(float));
+            prev_rows = rows;
+
+            const float eps = 1e-8;
+            const float* p = params.host();
+            const float* g = params_grad.host();
+            float* pm = m.host();
+            float* pv = v.host();
+            for (auto r : rows)
+            {
+                DLIB_CASSERT(r < num_rows);
+                const float tr = ++row_step[r];
+                const float alpha = lr*std::sqrt(1-std::pow(momentum2,tr))/(1-std::pow(momentum1,tr));
+                for (size_t j = 0; j < row_len; ++j)
+                {
+                    const size_t idx = r*row_len + j;
+                    const float grad = wd*p[idx] + g[idx];
+                    pm[idx] = momentum1*pm[idx] + (1-momentum1)*grad;
+                    pv[idx] = momentum2*pv[idx] + (1-momentum2)*grad*grad;
+                    step[idx] = -alpha*pm[idx]/(std::sqrt(pv[idx])+eps);
+                }
+            }
+
+            return s;
+        }
+
         resizable_tensor m;
         resizable_tensor v;
         resizable_tensor s;
@@ -395,6 +600,10 @@ namespace dlib
         float momentum1;
         float momentum2;
         float t;
+
+        // state used only by compute_sparse_update()
+        std::vector<unsigned long> row_step;
+        std::vector<unsigned long> prev_rows;
     };
 
 // ----------------------------------------------------------------------------------------
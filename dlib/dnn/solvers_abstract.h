@@ -92,6 +92,22 @@ namespace dlib
                 respectively, to determine the values it will use during each step.  It is
                 also overloaded to allow additional learning rate multipliers to be applied
                 to fc_ and con_ bias parameters.
+
+                Layers with very large but sparsely used parameter tensors (e.g.
+                embedding tables where a mini-batch touches only a small fraction of
+                the rows) can opt into sparse updates by defining a member function:
+                    const std::vector<unsigned long>& get_sparse_gradient_rows() const;
+                that lists the parameter rows (i.e. indices in the range
+                [0, get_layer_params().num_samples())) touched by the most recent
+                gradient computation.  When a layer defines this function the solver
+                only visits the listed rows and the returned step tensor is zero
+                everywhere else.  The momentum a row missed while untouched is caught
+                up by decaying its momentum term by momentum^k, and the weight decay
+                skipped over those k steps is applied in one shot via (1-wd*lr)^k,
+                where k is the number of solver steps since the row was last touched.
+                On the sparse path the weight decay is therefore decoupled from the
+                momentum term, so the parameter trajectory differs slightly from the
+                dense update even when every row is touched every step.
         !*/
     public:
 
@@ -151,6 +167,13 @@ namespace dlib
                 respectively, to determine the values it will use during each step.  It is
                 also overloaded to allow additional learning rate multipliers to be applied
                 to fc_ and con_ bias parameters.
+
+                Like the sgd solver above, layers that define
+                get_sparse_gradient_rows() get sparse updates that only visit the
+                reported rows.  For adam this is the "lazy adam" variant: the first and
+                second moment estimates of untouched rows are left frozen and each row
+                keeps its own update counter, so its bias correction reflects how often
+                that row has actually been updated.
         !*/
 
     public:
@@ -22,6 +22,7 @@
 #include <future>
 #include <exception>
 #include <mutex>
+#include <thread>
 #include "../dir_nav.h"
 #include "../md5.h"
 
@@ -133,6 +134,12 @@ namespace dlib
         ~dnn_trainer(
         )
         {
+            if (prefetch_pipe)
+                prefetch_pipe->disable();
+            if (prefetch_thread.joinable())
+                prefetch_thread.join();
+            if (sync_writer_thread.joinable())
+                sync_writer_thread.join();
             job_pipe.disable();
             stop();
             wait();
@@ -243,6 +250,71 @@ namespace dlib
             ++train_one_step_calls;
         }
 
+        template <
+            typename generator_type
+            >
+        void start_prefetching (
+            generator_type gen,
+            size_t queue_depth = 2
+        )
+        {
+            DLIB_CASSERT(queue_depth > 0);
+            DLIB_CASSERT(!prefetch_thread.joinable(),
+                "You can only call start_prefetching() once per dnn_trainer.");
+
+            prefetch_pipe.reset(new dlib::pipe<job_t>(queue_depth));
+            prefetch_thread = std::thread([this, gen]() mutable
+            {
+                try
+                {
+                    std::vector<input_type> data;
+                    std::vector<training_label_type> labels;
+                    job_t pjob;
+                    while (gen(data, labels))
+                    {
+                        DLIB_CASSERT(data.size() > 0 && data.size() == labels.size());
+                        convert_to_job(pjob, false, data.begin(), data.end(), labels.begin());
+                        if (!prefetch_pipe->enqueue(pjob))
+                            return;
+                        data.clear();
+                        labels.clear();
+                    }
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(eptr_mutex);
+                    eptr = std::current_exception();
+                }
+                // Enqueue an empty job to mark the end of the data.  Real jobs always
+                // have job.t.size() != 0.
+                job_t end_marker;
+                prefetch_pipe->enqueue(end_marker);
+            });
+        }
+
+        bool train_one_step (
+        )
+        {
+            DLIB_CASSERT(prefetch_pipe,
+                "You must call start_prefetching() before calling this version of train_one_step().");
+
+            job_t pjob;
+            if (!prefetch_pipe->dequeue(pjob) || pjob.t.size() == 0)
+            {
+                // the generator is exhausted (or it threw, in which case the next
+                // statement rethrows for it).
+                propagate_exception();
+                return false;
+            }
+
+            print_periodic_verbose_status();
+            sync_to_disk();
+            propagate_exception();
+            job_pipe.enqueue(pjob);
+            ++train_one_step_calls;
+            return true;
+        }
+
         void test_one_step (
             const std::vector<input_type>& data,
             const std::vector<training_label_type>& labels 
@@ -411,6 +483,7 @@ namespace dlib
             std::chrono::seconds time_between_syncs_ = std::chrono::minutes(15)
         )
         {
+            wait_for_sync_writer();
             last_sync_time = std::chrono::system_clock::now();
             sync_filename = filename;
             time_between_syncs = time_between_syncs_;
@@ -1026,6 +1099,9 @@ namespace dlib
                 do_it_now)
             {
                 wait_for_thread_to_pause();
+                // Also make sure any previous checkpoint has finished writing before we
+                // read or replace the sync files.
+                wait_for_sync_writer();
 
                 // compact network before saving to disk.
                 this->net.clean(); 
@@ -1060,7 +1136,33 @@ namespace dlib
                 {
 
                     const std::string filename = oldest_syncfile();
-                    serialize(filename) << *this;
+
+                    // Serialize into a memory buffer while the training thread is
+                    // paused and hand the buffer to a background thread to push to
+                    // disk.  That way training only stalls for the device-to-host
+                    // copies rather than for the disk I/O, which is what takes
+                    // seconds on big networks.  The two sync files rotate, so even if
+                    // we crash mid-write the other file still holds a complete state.
+                    auto state = std::make_shared<std::string>();
+                    {
+                        std::ostringstream sout;
+                        serialize(*this, sout);
+                        *state = sout.str();
+                    }
+                    sync_writer_thread = std::thread([this, filename, state]()
+                    {
+                        try
+                        {
+                            std::ofstream fout(filename, std::ios::binary);
+                            fout.write(state->data(), state->size());
+                            if (!fout)
+                                throw serialization_error("Error writing dnn_trainer state to " + filename);
+                        }
+                        catch (...)
+                        {
+                            sync_writer_eptr = std::current_exception();
+                        }
+                    });
 
                     if (verbose)
                         std::cout << "Saved state to " << filename << std::endl;
@@ -1069,6 +1171,25 @@ namespace dlib
                 last_sync_time = std::chrono::system_clock::now();
                 main_iteration_counter_at_last_disk_sync = main_iteration_counter;
                 updated_net_since_last_sync = false;
+
+                // Forced syncs promise the state is on disk when we return.
+                if (do_it_now)
+                    wait_for_sync_writer();
+            }
+        }
+
+        // Wait for any background checkpoint write to finish and rethrow anything it
+        // threw.  This must be called before reading or replacing the sync files.
+        void wait_for_sync_writer (
+        )
+        {
+            if (sync_writer_thread.joinable())
+                sync_writer_thread.join();
+            if (sync_writer_eptr)
+            {
+                auto err = sync_writer_eptr;
+                sync_writer_eptr = nullptr;
+                std::rethrow_exception(err);
             }
         }
 
@@ -1167,20 +1288,20 @@ namespace dlib
             typename data_iterator,
             typename label_iterator
             >
-        void send_job (
+        void convert_to_job (
+            job_t& dest,
             bool test_only,
-            data_iterator dbegin, 
+            data_iterator dbegin,
             data_iterator dend,
             label_iterator lbegin
         )
         {
-            propagate_exception();
             size_t num = std::distance(dbegin, dend);
             size_t devs = devices.size();
-            job.t.resize(devs);
-            job.labels.resize(devs);
-            job.have_data.resize(devs);
-            job.test_only = test_only;
+            dest.t.resize(devs);
+            dest.labels.resize(devs);
+            dest.have_data.resize(devs);
+            dest.test_only = test_only;
 
             // chop the data into devs blocks, each of about block_size elements.
             size_t block_size = (num+devs-1)/devs;
@@ -1195,17 +1316,32 @@ namespace dlib
 
                 if (start < stop)
                 {
-                    devices[i]->net.to_tensor(dbegin+start, dbegin+stop, job.t[i]);
-                    job.labels[i].assign(lbegin+start, lbegin+stop);
-                    job.have_data[i] = true;
+                    devices[i]->net.to_tensor(dbegin+start, dbegin+stop, dest.t[i]);
+                    dest.labels[i].assign(lbegin+start, lbegin+stop);
+                    dest.have_data[i] = true;
                 }
                 else
                 {
-                    job.have_data[i] = false;
+                    dest.have_data[i] = false;
                 }
             }
 
             dlib::cuda::set_device(prev_dev);
+        }
+
+        template <
+            typename data_iterator,
+            typename label_iterator
+            >
+        void send_job (
+            bool test_only,
+            data_iterator dbegin,
+            data_iterator dend,
+            label_iterator lbegin
+        )
+        {
+            propagate_exception();
+            convert_to_job(job, test_only, dbegin, dend, lbegin);
             job_pipe.enqueue(job);
         }
 
@@ -1269,6 +1405,8 @@ namespace dlib
         std::vector<std::shared_ptr<device_data>> devices;
         dlib::pipe<job_t> job_pipe;
         job_t job;
+        std::unique_ptr<dlib::pipe<job_t>> prefetch_pipe;
+        std::thread prefetch_thread;
 
 
         running_stats<double> rs;
@@ -1292,6 +1430,8 @@ namespace dlib
         std::atomic<double> learning_rate_shrink;
         std::chrono::time_point<std::chrono::system_clock> last_sync_time;
         std::string sync_filename;
+        std::thread sync_writer_thread;
+        std::exception_ptr sync_writer_eptr = nullptr;
         std::chrono::seconds time_between_syncs;
         unsigned long epoch_iteration;
         size_t epoch_pos;
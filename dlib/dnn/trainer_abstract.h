@@ -366,6 +366,12 @@ namespace dlib
                   disk.  This way, you will always have a backup file if the write to disk
                   gets corrupted or is incomplete.  Moreover, when loading, we will always
                   load from the newest of the two possible files.
+                - Periodic saves happen asynchronously.  The trainer snapshots its state
+                  into a memory buffer and a background thread writes the buffer to
+                  disk, so training isn't stalled waiting on disk I/O.  Final syncs,
+                  such as the one performed when train() returns or when you call
+                  get_net(force_flush_to_disk::yes), wait for the write to complete
+                  before returning.
         !*/
 
         const std::string& get_synchronization_file (
@@ -542,7 +548,54 @@ namespace dlib
                   accessing the network.
                 - #get_train_one_step_calls() == get_train_one_step_calls() + 1.
         !*/
-        
+
+        template <
+            typename generator_type
+            >
+        void start_prefetching (
+            generator_type gen,
+            size_t queue_depth = 2
+        );
+        /*!
+            requires
+                - queue_depth > 0
+                - start_prefetching() has not been called on this object before.
+                - gen is a function object callable as
+                    bool gen(std::vector<input_type>& data, std::vector<training_label_type>& labels)
+                  Each call that returns true must leave data.size() > 0 and
+                  data.size() == labels.size().  A call returning false means there are
+                  no more mini-batches.
+            ensures
+                - Starts a background thread that repeatedly calls gen to obtain
+                  mini-batches and converts each of them into the trainer's internal
+                  tensor format ahead of time.  Up to queue_depth converted
+                  mini-batches are buffered.  This means the relatively expensive
+                  to_tensor() conversion (and, when CUDA is in use, the copy into
+                  page-locked staging memory) happens concurrently with network
+                  updates rather than stalling between them.  You consume the
+                  prefetched mini-batches by calling the argument free version of
+                  train_one_step() defined below.
+                - gen is invoked only from the background thread, so it may read from
+                  disk or do other slow work without holding up training.
+        !*/
+
+        bool train_one_step (
+        );
+        /*!
+            requires
+                - start_prefetching() has been called.
+            ensures
+                - If a prefetched mini-batch is available (or becomes available) then
+                  performs one stochastic gradient update step based on it, just like
+                  the other versions of train_one_step() defined above, and returns
+                  true.  In that case #get_train_one_step_calls() ==
+                  get_train_one_step_calls() + 1.
+                - Otherwise, i.e. the generator given to start_prefetching() has run
+                  out of data, returns false.
+                - If the generator threw an exception then that exception is rethrown
+                  from this function.
+        !*/
+
         double get_average_loss (
         ) const;
         /*!
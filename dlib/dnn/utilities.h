@@ -7,6 +7,8 @@
 #include "utilities_abstract.h"
 #include "../geometry.h"
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 
 namespace dlib
 {
@@ -263,7 +265,7 @@ namespace dlib
     template <typename net_type>
     inline dpoint output_tensor_to_input_tensor(
         const net_type& net,
-        dpoint p  
+        dpoint p
     )
     {
         impl::visitor_net_map_output_to_input temp(p);
@@ -271,6 +273,143 @@ namespace dlib
         return p;
     }
 
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        template <typename T, typename U>
+        void propagate_shapes_for_report (
+            add_loss_layer<T,U>& net,
+            const tensor& x
+        )
+        {
+            net.subnet().forward(x);
+        }
+
+        template <typename net_type>
+        void propagate_shapes_for_report (
+            net_type& net,
+            const tensor& x
+        )
+        {
+            net.forward(x);
+        }
+
+        class visitor_net_memory_report
+        {
+        public:
+
+            visitor_net_memory_report(
+                std::ostream& out_,
+                size_t& output_bytes_,
+                size_t& parameter_bytes_
+            ) : out(out_), output_bytes(output_bytes_), parameter_bytes(parameter_bytes_) {}
+
+            template<typename input_layer_type>
+            void operator()(size_t idx, const input_layer_type& l)
+            {
+                out << "layer<" << std::setw(3) << idx << ">  " << l << "\n";
+            }
+
+            template <typename T, typename U>
+            void operator()(size_t idx, const add_loss_layer<T,U>& l)
+            {
+                out << "layer<" << std::setw(3) << idx << ">  " << l.loss_details() << "\n";
+            }
+
+            template <typename T, typename U, typename E>
+            void operator()(size_t idx, const add_layer<T,U,E>& l)
+            {
+                const size_t pbytes = l.layer_details().get_layer_params().size()*sizeof(float);
+                parameter_bytes += pbytes;
+
+                try
+                {
+                    const tensor& t = l.get_output();
+                    const size_t obytes = t.size()*sizeof(float);
+                    output_bytes += obytes;
+
+                    std::ostringstream shape;
+                    shape << t.num_samples() << "x" << t.k() << "x" << t.nr() << "x" << t.nc();
+                    out << "layer<" << std::setw(3) << idx << ">  output "
+                        << std::setw(16) << std::left << shape.str() << std::right
+                        << std::setw(12) << obytes << " bytes"
+                        << "  params " << std::setw(12) << pbytes << " bytes"
+                        << "  " << l.layer_details() << "\n";
+                }
+                catch (const error&)
+                {
+                    // get_output() is disabled because an in-place layer is stacked on
+                    // this one.  The two layers share a single output tensor which is
+                    // counted when the in-place layer itself is visited, so this layer
+                    // adds no memory of its own.
+                    out << "layer<" << std::setw(3) << idx << ">  output "
+                        << std::setw(16) << std::left << "(shared)" << std::right
+                        << std::setw(12) << 0 << " bytes"
+                        << "  params " << std::setw(12) << pbytes << " bytes"
+                        << "  " << l.layer_details() << "\n";
+                }
+            }
+
+            template <unsigned long ID, typename U, typename E>
+            void operator()(size_t idx, const add_tag_layer<ID,U,E>& )
+            {
+                // Tag layers alias their subnetwork's output tensor so they don't use
+                // any additional memory.
+                out << "layer<" << std::setw(3) << idx << ">  tag" << ID << "\n";
+            }
+
+            template <template<typename> class T, typename U>
+            void operator()(size_t idx, const add_skip_layer<T,U>& )
+            {
+                out << "layer<" << std::setw(3) << idx << ">  skip" << (tag_id<T>::id) << "\n";
+            }
+
+        private:
+
+            std::ostream& out;
+            size_t& output_bytes;
+            size_t& parameter_bytes;
+        };
+    }
+
+    template <typename net_type>
+    void net_memory_report (
+        const net_type& net,
+        std::ostream& out
+    )
+    {
+        size_t output_bytes = 0;
+        size_t parameter_bytes = 0;
+        visit_layers(net, impl::visitor_net_memory_report(out, output_bytes, parameter_bytes));
+        // dlib keeps every layer's output tensor alive (they are reused as caches and
+        // are needed by back propagation), so the outputs all exist concurrently.
+        out << "total layer output bytes:   " << output_bytes << "\n";
+        out << "total parameter bytes:      " << parameter_bytes << "\n";
+        out << "peak inference bytes:       " << output_bytes+parameter_bytes << "\n";
+        // During training each output and parameter tensor is paired with an equally
+        // sized gradient tensor.
+        out << "peak training bytes:        " << 2*(output_bytes+parameter_bytes) << "\n";
+    }
+
+    template <typename net_type>
+    void net_memory_report (
+        net_type& net,
+        const typename net_type::input_type& x,
+        size_t batch_size,
+        std::ostream& out
+    )
+    {
+        // Run a forward pass at the deployment batch size so every layer's output
+        // tensor takes on its production shape.  Only the dimensions of x matter,
+        // the values it holds are irrelevant.
+        std::vector<typename net_type::input_type> batch(batch_size, x);
+        resizable_tensor temp;
+        net.to_tensor(batch.data(), batch.data()+batch.size(), temp);
+        impl::propagate_shapes_for_report(net, temp);
+        net_memory_report(net, out);
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -118,6 +118,55 @@ namespace dlib
               in the input tensor?
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <typename net_type>
+    void net_memory_report (
+        const net_type& net,
+        std::ostream& out
+    );
+    /*!
+        requires
+            - net_type is an object of type add_layer, add_loss_layer, add_skip_layer, or
+              add_tag_layer.
+            - A tensor has been propagated through net so that every layer's output
+              tensor has taken on the shape it will have in production (e.g. by using
+              the overload of this function defined below).
+        ensures
+            - Prints a human readable memory report for net to out.  For each
+              computational layer the report gives the shape of its output tensor, the
+              bytes that tensor occupies, and the bytes used by the layer's parameters.
+              Layers whose output is aliased by an in-place layer stacked on top of
+              them are reported as sharing that layer's tensor and contribute no bytes
+              of their own.  After the per-layer rows it prints the total output and
+              parameter bytes along with the resulting peak concurrent bytes.  All of
+              the output tensors exist at the same time in dlib, so the peak during
+              inference is their sum plus the parameters, and during training each of
+              these tensors is additionally paired with an equally sized gradient
+              tensor.
+    !*/
+
+    template <typename net_type>
+    void net_memory_report (
+        net_type& net,
+        const typename net_type::input_type& x,
+        size_t batch_size,
+        std::ostream& out
+    );
+    /*!
+        requires
+            - net_type is an object of type add_layer, add_loss_layer, add_skip_layer, or
+              add_tag_layer.
+            - batch_size > 0
+        ensures
+            - Propagates a batch of batch_size copies of x through net so that every
+              layer's output tensor takes on the shape implied by inputs of x's
+              dimensions and then performs net_memory_report(net, out) as defined
+              above.  The contents of x are irrelevant, only its dimensions matter, so
+              you can use a default constructed input of the production size to see
+              what a deployment will cost before you have a GPU to run it on.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -65,25 +65,29 @@ namespace dlib
 
 
 
-        unsigned char ch;
+        // Note that we read with sbumpc() rather than sgetn() because sbumpc()
+        // reads straight out of the streambuf's get area when bytes are
+        // available there, avoiding a virtual function call per byte.
+        std::streambuf::int_type temp = streambuf->sbumpc();
+        if (temp != std::streambuf::traits_type::eof())
+            target = static_cast<unsigned char>(temp);
 
-        
-        streambuf->sgetn((char*)&ch,1);
-        target = ch;
-        
         target <<= 8;
-        if (streambuf->sgetn((char*)&ch,1))
-            target += ch;
+        temp = streambuf->sbumpc();
+        if (temp != std::streambuf::traits_type::eof())
+            target += static_cast<unsigned char>(temp);
 
 
         target <<= 8;
-        if (streambuf->sgetn((char*)&ch,1))
-            target += ch;
+        temp = streambuf->sbumpc();
+        if (temp != std::streambuf::traits_type::eof())
+            target += static_cast<unsigned char>(temp);
 
 
         target <<= 8;
-        if (streambuf->sgetn((char*)&ch,1))
-            target += ch;
+        temp = streambuf->sbumpc();
+        if (temp != std::streambuf::traits_type::eof())
+            target += static_cast<unsigned char>(temp);
     }
 
 // ----------------------------------------------------------------------------------------
@@ -160,11 +164,16 @@ namespace dlib
             else
             {
                 unsigned char buf;
-                if (streambuf->sgetn(reinterpret_cast<char*>(&buf),1)==0)
+                std::streambuf::int_type temp = streambuf->sbumpc();
+                if (temp != std::streambuf::traits_type::eof())
+                {
+                    buf = static_cast<unsigned char>(temp);
+                }
+                else
                 {
                     // if there isn't anything else in the streambuffer then just
-                    // make buf zero.  
-                    buf = 0;      
+                    // make buf zero.
+                    buf = 0;
                 }
 
                 // also roll off the bits in target
@@ -32,6 +32,7 @@ namespace dlib
         typedef typename conditioning_class<alphabet_size+1>::kernel_4b cc4b;
         typedef typename conditioning_class<alphabet_size+1>::kernel_4c cc4c;
         typedef typename conditioning_class<alphabet_size+1>::kernel_4d cc4d;
+        typedef typename conditioning_class<alphabet_size+1>::kernel_5a cc5;
 
     public:
         
@@ -47,6 +48,9 @@ namespace dlib
         typedef     entropy_decoder_model_kernel_1<alphabet_size,entropy_decoder,cc3>
                     kernel_1c;
 
+        typedef     entropy_decoder_model_kernel_1<alphabet_size,entropy_decoder,cc5>
+                    kernel_1d;
+
         // --------------------
 
         // kernel_2      
@@ -62,6 +66,9 @@ namespace dlib
         typedef     entropy_decoder_model_kernel_2<alphabet_size,entropy_decoder,cc2,cc4b>
                     kernel_2d;
 
+        typedef     entropy_decoder_model_kernel_2<alphabet_size,entropy_decoder,cc5,cc5>
+                    kernel_2e;
+
         // --------------------
 
         // kernel_3       
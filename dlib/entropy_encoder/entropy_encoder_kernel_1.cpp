@@ -21,7 +21,8 @@ namespace dlib
         low(initial_low),
         high(initial_high),
         buf(0),
-        buf_used(0)
+        buf_used(0),
+        out_buf_count(0)
     {
     }
 
@@ -125,13 +126,10 @@ namespace dlib
                 // if buf is full then write it out
                 if (buf_used == 8)
                 {
-                    if (streambuf->sputn(reinterpret_cast<char*>(&buf),1)==0)
-                    {
-                        throw std::ios_base::failure("error occurred in the entropy_encoder object");
-                    }
+                    write_byte(buf);
                     buf = 0;
                     buf_used = 0;
-                }   
+                }
 
 
                 // write the high order bit from low into buf
@@ -188,39 +186,18 @@ namespace dlib
             low <<= (8-buf_used);
         }
 
-        if (streambuf->sputn(reinterpret_cast<char*>(&buf),1) == 0)
-            throw std::ios_base::failure("error occurred in the entropy_encoder object");
-
-
-
-        buf = static_cast<unsigned char>((low >> 24)&0xFF);
-        if (streambuf->sputn(reinterpret_cast<char*>(&buf),1) == 0)
-            throw std::ios_base::failure("error occurred in the entropy_encoder object");
-
-
-
-
-        buf = static_cast<unsigned char>((low >> 16)&0xFF);
-        if (streambuf->sputn(reinterpret_cast<char*>(&buf),1)==0)
-            throw std::ios_base::failure("error occurred in the entropy_encoder object");
-
-
-
-        buf = static_cast<unsigned char>((low >> 8)&0xFF);
-        if (streambuf->sputn(reinterpret_cast<char*>(&buf),1)==0)
-            throw std::ios_base::failure("error occurred in the entropy_encoder object");
-
-
+        write_byte(buf);
+        write_byte(static_cast<unsigned char>((low >> 24)&0xFF));
+        write_byte(static_cast<unsigned char>((low >> 16)&0xFF));
+        write_byte(static_cast<unsigned char>((low >> 8)&0xFF));
 
         if (buf_used != 0)
         {
-            buf = static_cast<unsigned char>((low)&0xFF);
-            if (streambuf->sputn(reinterpret_cast<char*>(&buf),1)==0)
-                throw std::ios_base::failure("error occurred in the entropy_encoder object");
+            write_byte(static_cast<unsigned char>((low)&0xFF));
         }
-    
 
-        
+        empty_buffer();
+
         // make sure the stream buffer flushes to its I/O channel
         streambuf->pubsync();
 
@@ -232,6 +209,35 @@ namespace dlib
         high = initial_high;
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void entropy_encoder_kernel_1::
+    write_byte (
+        unsigned char buf
+    )
+    {
+        if (out_buf_count == sizeof(out_buf))
+            empty_buffer();
+        out_buf[out_buf_count++] = buf;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void entropy_encoder_kernel_1::
+    empty_buffer (
+    )
+    {
+        if (out_buf_count != 0)
+        {
+            if (streambuf->sputn(reinterpret_cast<char*>(out_buf),out_buf_count) != static_cast<std::streamsize>(out_buf_count))
+            {
+                out_buf_count = 0;
+                throw std::ios_base::failure("error occurred in the entropy_encoder object");
+            }
+            out_buf_count = 0;
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -21,6 +21,7 @@ namespace dlib
                 out      == 0
                 buf_used == 0
                 buf      == 0
+                out_buf_count == 0
                 initial_low      == 0x00000001  (slightly more than zero)
                 initial_high     == 0xffffffff  (slightly less than one, 0.99999999976717)
                 low      == initial_low
@@ -34,9 +35,13 @@ namespace dlib
                 else
                     false     == stream_is_set()
 
-                buf      == used to accumulate bits before writing them to out.  
-                buf_used == the number of low order bits in buf that are currently 
+                buf      == used to accumulate bits before writing them to out.
+                buf_used == the number of low order bits in buf that are currently
                             in use
+                out_buf_count == the number of encoded bytes in out_buf that haven't
+                            been written to streambuf yet.  We accumulate output in
+                            out_buf so we can hand it to the streambuf in blocks
+                            rather than making one virtual sputn() call per byte.
                 low      == the low end of the range used for arithmetic encoding.
                             this number is used as a 32bit fixed point real number. 
                             the point is fixed just before the first bit, so it is
@@ -90,7 +95,28 @@ namespace dlib
         );
         /*!
             requires
-                out != 0 (i.e.  there is a stream object to flush the data to 
+                out != 0 (i.e.  there is a stream object to flush the data to
+        !*/
+
+        void write_byte (
+            unsigned char buf
+        );
+        /*!
+            requires
+                - out != 0
+            ensures
+                - appends buf to out_buf, emptying out_buf into streambuf first if
+                  it is full.
+        !*/
+
+        void empty_buffer (
+        );
+        /*!
+            requires
+                - out != 0
+            ensures
+                - #out_buf_count == 0
+                - all the bytes that were in out_buf have been written to streambuf
         !*/
 
         // restricted functions
@@ -106,9 +132,11 @@ namespace dlib
         unsigned char buf; 
         uint32 buf_used; 
         std::streambuf* streambuf;
+        unsigned char out_buf[1024];
+        unsigned int out_buf_count;
+
+    };
 
-    };   
-   
 }
 
 #ifdef NO_MAKEFILE
@@ -19,7 +19,8 @@ namespace dlib
         initial_high(0xffffffff),
         out(0),
         low(initial_low),
-        high(initial_high)
+        high(initial_high),
+        out_buf_count(0)
     {
     }
 
@@ -168,12 +169,9 @@ namespace dlib
                     low = 1;
 
                 // write buf to the output stream
-                if (streambuf->sputn(reinterpret_cast<char*>(&buf),1)==0)
-                {
-                    throw std::ios_base::failure("error occurred in the entropy_encoder object");
-                }                   
-                
-            } 
+                write_byte(buf);
+
+            }
 
         } // while (true)
 
@@ -188,35 +186,13 @@ namespace dlib
 
         // flush low to the output stream
 
+        write_byte(static_cast<unsigned char>((low >> 24)&0xFF));
+        write_byte(static_cast<unsigned char>((low >> 16)&0xFF));
+        write_byte(static_cast<unsigned char>((low >> 8)&0xFF));
+        write_byte(static_cast<unsigned char>((low)&0xFF));
 
-        unsigned char buf;
-
-
-        buf = static_cast<unsigned char>((low >> 24)&0xFF);
-        if (streambuf->sputn(reinterpret_cast<char*>(&buf),1) == 0)
-            throw std::ios_base::failure("error occurred in the entropy_encoder object");
-
-
-
+        empty_buffer();
 
-        buf = static_cast<unsigned char>((low >> 16)&0xFF);
-        if (streambuf->sputn(reinterpret_cast<char*>(&buf),1)==0)
-            throw std::ios_base::failure("error occurred in the entropy_encoder object");
-
-
-
-        buf = static_cast<unsigned char>((low >> 8)&0xFF);
-        if (streambuf->sputn(reinterpret_cast<char*>(&buf),1)==0)
-            throw std::ios_base::failure("error occurred in the entropy_encoder object");
-
-
-        buf = static_cast<unsigned char>((low)&0xFF);
-        if (streambuf->sputn(reinterpret_cast<char*>(&buf),1)==0)
-            throw std::ios_base::failure("error occurred in the entropy_encoder object");
-        
-    
-
-        
         // make sure the stream buffer flushes to its I/O channel
         streambuf->pubsync();
 
@@ -226,6 +202,35 @@ namespace dlib
         high = initial_high;
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void entropy_encoder_kernel_2::
+    write_byte (
+        unsigned char buf
+    )
+    {
+        if (out_buf_count == sizeof(out_buf))
+            empty_buffer();
+        out_buf[out_buf_count++] = buf;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void entropy_encoder_kernel_2::
+    empty_buffer (
+    )
+    {
+        if (out_buf_count != 0)
+        {
+            if (streambuf->sputn(reinterpret_cast<char*>(out_buf),out_buf_count) != static_cast<std::streamsize>(out_buf_count))
+            {
+                out_buf_count = 0;
+                throw std::ios_base::failure("error occurred in the entropy_encoder object");
+            }
+            out_buf_count = 0;
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
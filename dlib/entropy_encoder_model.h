@@ -35,6 +35,7 @@ namespace dlib
         typedef typename conditioning_class<alphabet_size+1>::kernel_4b cc4b;
         typedef typename conditioning_class<alphabet_size+1>::kernel_4c cc4c;
         typedef typename conditioning_class<alphabet_size+1>::kernel_4d cc4d;
+        typedef typename conditioning_class<alphabet_size+1>::kernel_5a cc5;
 
 
     public:
@@ -57,6 +58,11 @@ namespace dlib
         typedef     entropy_encoder_model_kernel_c<kernel_1c>
                     kernel_1c_c;
 
+        typedef     entropy_encoder_model_kernel_1<alphabet_size,entropy_encoder,cc5>
+                    kernel_1d;
+        typedef     entropy_encoder_model_kernel_c<kernel_1d>
+                    kernel_1d_c;
+
         // --------------------
 
         // kernel_2        
@@ -80,6 +86,11 @@ namespace dlib
         typedef     entropy_encoder_model_kernel_c<kernel_2d>
                     kernel_2d_c;
 
+        typedef     entropy_encoder_model_kernel_2<alphabet_size,entropy_encoder,cc5,cc5>
+                    kernel_2e;
+        typedef     entropy_encoder_model_kernel_c<kernel_2e>
+                    kernel_2e_c;
+
         // --------------------
 
         // kernel_3        
@@ -0,0 +1,8 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_FLAT_MAp_TOP_
+#define DLIB_FLAT_MAp_TOP_
+
+#include "flat_map/flat_map.h"
+
+#endif // DLIB_FLAT_MAp_TOP_
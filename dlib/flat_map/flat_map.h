@@ -0,0 +1,206 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_FLAT_MAp_H_
+#define DLIB_FLAT_MAp_H_
+
+#include "flat_map_abstract.h"
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "../serialize.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename K,
+        typename V,
+        typename compare = std::less<K>,
+        typename container = std::vector<std::pair<K,V>>
+        >
+    class flat_map
+    {
+        /*!
+            CONVENTION
+                - items holds the map's elements sorted by their first field according
+                  to comp, with no duplicate keys.
+        !*/
+    public:
+
+        typedef K key_type;
+        typedef V mapped_type;
+        typedef std::pair<K,V> value_type;
+        typedef typename container::iterator iterator;
+        typedef typename container::const_iterator const_iterator;
+
+        flat_map (
+        ) = default;
+
+        explicit flat_map (
+            const compare& comp_
+        ) : comp(comp_)
+        {
+        }
+
+        size_t size (
+        ) const { return items.size(); }
+
+        bool empty (
+        ) const { return items.empty(); }
+
+        void clear (
+        ) { items.clear(); }
+
+        void reserve (
+            size_t new_capacity
+        ) { items.reserve(new_capacity); }
+
+        iterator begin (
+        ) { return items.begin(); }
+
+        const_iterator begin (
+        ) const { return items.begin(); }
+
+        iterator end (
+        ) { return items.end(); }
+
+        const_iterator end (
+        ) const { return items.end(); }
+
+        iterator lower_bound (
+            const K& key
+        )
+        {
+            return std::lower_bound(items.begin(), items.end(), key,
+                [this](const value_type& item, const K& k) { return comp(item.first, k); });
+        }
+
+        const_iterator lower_bound (
+            const K& key
+        ) const
+        {
+            return std::lower_bound(items.begin(), items.end(), key,
+                [this](const value_type& item, const K& k) { return comp(item.first, k); });
+        }
+
+        iterator find (
+            const K& key
+        )
+        {
+            auto i = lower_bound(key);
+            if (i != items.end() && !comp(key, i->first))
+                return i;
+            return items.end();
+        }
+
+        const_iterator find (
+            const K& key
+        ) const
+        {
+            auto i = lower_bound(key);
+            if (i != items.end() && !comp(key, i->first))
+                return i;
+            return items.end();
+        }
+
+        size_t count (
+            const K& key
+        ) const
+        {
+            return find(key) == items.end() ? 0 : 1;
+        }
+
+        V& operator[] (
+            const K& key
+        )
+        {
+            auto i = lower_bound(key);
+            if (i == items.end() || comp(key, i->first))
+                i = items.insert(i, value_type(key, V()));
+            return i->second;
+        }
+
+        std::pair<iterator,bool> insert (
+            value_type item
+        )
+        {
+            auto i = lower_bound(item.first);
+            if (i != items.end() && !comp(item.first, i->first))
+                return std::make_pair(i, false);
+            i = items.insert(i, std::move(item));
+            return std::make_pair(i, true);
+        }
+
+        iterator erase (
+            const_iterator pos
+        )
+        {
+            return items.erase(pos);
+        }
+
+        size_t erase (
+            const K& key
+        )
+        {
+            auto i = find(key);
+            if (i == items.end())
+                return 0;
+            items.erase(i);
+            return 1;
+        }
+
+        template <typename k, typename v, typename c, typename s>
+        friend void serialize (
+            const flat_map<k,v,c,s>& item,
+            std::ostream& out
+        );
+
+        template <typename k, typename v, typename c, typename s>
+        friend void deserialize (
+            flat_map<k,v,c,s>& item,
+            std::istream& in
+        );
+
+    private:
+        container items;
+        compare comp;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename k, typename v, typename c, typename s>
+    void serialize (
+        const flat_map<k,v,c,s>& item,
+        std::ostream& out
+    )
+    {
+        try
+        {
+            serialize(item.items, out);
+        }
+        catch (serialization_error& e)
+        { throw serialization_error(e.info + "\n   while serializing object of type flat_map"); }
+    }
+
+    template <typename k, typename v, typename c, typename s>
+    void deserialize (
+        flat_map<k,v,c,s>& item,
+        std::istream& in
+    )
+    {
+        try
+        {
+            deserialize(item.items, in);
+        }
+        catch (serialization_error& e)
+        { throw serialization_error(e.info + "\n   while deserializing object of type flat_map"); }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_FLAT_MAp_H_
@@ -0,0 +1,212 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_FLAT_MAp_ABSTRACT_H_
+#ifdef DLIB_FLAT_MAp_ABSTRACT_H_
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include "../serialize.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename K,
+        typename V,
+        typename compare = std::less<K>,
+        typename container = std::vector<std::pair<K,V>>
+        >
+    class flat_map
+    {
+        /*!
+            REQUIREMENTS ON K and compare
+                compare must impose a strict weak ordering on objects of type K.
+
+            REQUIREMENTS ON container
+                container must be a random access sequence of std::pair<K,V> with a
+                std::vector style interface (begin/end, insert, erase, reserve).  The
+                default is std::vector, but dlib::small_vector can be used instead to
+                keep small maps entirely free of heap allocation.
+
+            INITIAL VALUE
+                - size() == 0
+
+            WHAT THIS OBJECT REPRESENTS
+                This object maps keys to values just like std::map, except that the
+                elements are kept sorted in one contiguous array rather than in a
+                node based tree.  Lookups are binary searches over that array, so
+                they touch adjacent memory instead of chasing pointers, and
+                inserting an element never allocates a tree node.  Insertion and
+                erasure shift later elements, making them O(size()), so this
+                container is meant for the small, frequently rebuilt maps that show
+                up in hot loops rather than for large long-lived ones.
+
+                Iterators are the underlying container's iterators.  Iterating from
+                begin() to end() visits the elements in ascending key order.  Any
+                insertion or erasure can invalidate all iterators.
+        !*/
+    public:
+
+        typedef K key_type;
+        typedef V mapped_type;
+        typedef std::pair<K,V> value_type;
+        typedef typename container::iterator iterator;
+        typedef typename container::const_iterator const_iterator;
+
+        flat_map (
+        ) = default;
+        /*!
+            ensures
+                - this object is properly initialized
+        !*/
+
+        explicit flat_map (
+            const compare& comp
+        );
+        /*!
+            ensures
+                - this object is properly initialized and orders its keys with comp.
+        !*/
+
+        size_t size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of elements in this map.
+        !*/
+
+        bool empty (
+        ) const;
+        /*!
+            ensures
+                - returns size() == 0
+        !*/
+
+        void clear (
+        );
+        /*!
+            ensures
+                - #size() == 0
+        !*/
+
+        void reserve (
+            size_t new_capacity
+        );
+        /*!
+            ensures
+                - the underlying container reserves storage for new_capacity
+                  elements, so inserts won't reallocate until that many are present.
+        !*/
+
+        iterator begin();
+        const_iterator begin() const;
+        iterator end();
+        const_iterator end() const;
+        /*!
+            ensures
+                - iterate the elements in ascending key order.
+        !*/
+
+        iterator lower_bound (
+            const K& key
+        );
+        const_iterator lower_bound (
+            const K& key
+        ) const;
+        /*!
+            ensures
+                - returns an iterator to the first element whose key is not less than
+                  key, or end() if there is no such element.
+        !*/
+
+        iterator find (
+            const K& key
+        );
+        const_iterator find (
+            const K& key
+        ) const;
+        /*!
+            ensures
+                - if this map contains an element with the given key then returns an
+                  iterator to it, otherwise returns end().
+        !*/
+
+        size_t count (
+            const K& key
+        ) const;
+        /*!
+            ensures
+                - returns 1 if this map contains an element with the given key and 0
+                  otherwise.
+        !*/
+
+        V& operator[] (
+            const K& key
+        );
+        /*!
+            ensures
+                - if this map doesn't contain an element with the given key then one
+                  is inserted with a default constructed value.
+                - returns a reference to the value associated with key.
+        !*/
+
+        std::pair<iterator,bool> insert (
+            value_type item
+        );
+        /*!
+            ensures
+                - if this map doesn't contain an element with item's key then item is
+                  inserted and this function returns a pair of an iterator to the new
+                  element and true.  Otherwise nothing is modified and it returns a
+                  pair of an iterator to the existing element and false.
+        !*/
+
+        iterator erase (
+            const_iterator pos
+        );
+        /*!
+            requires
+                - pos points at an element of this map.
+            ensures
+                - removes the element pos points at.
+                - returns an iterator to the element that followed it.
+        !*/
+
+        size_t erase (
+            const K& key
+        );
+        /*!
+            ensures
+                - if this map contains an element with the given key then it is
+                  removed and 1 is returned, otherwise 0 is returned.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename k, typename v, typename c, typename s>
+    void serialize (
+        const flat_map<k,v,c,s>& item,
+        std::ostream& out
+    );
+    /*!
+        provides serialization support
+    !*/
+
+    template <typename k, typename v, typename c, typename s>
+    void deserialize (
+        flat_map<k,v,c,s>& item,
+        std::istream& in
+    );
+    /*!
+        provides deserialization support
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_FLAT_MAp_ABSTRACT_H_
@@ -0,0 +1,130 @@
+// Copyright (C) 2013  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_FP16_Hh_
+#define DLIB_FP16_Hh_
+
+#include <cstring>
+#include "uintn.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    inline uint16 float_to_fp16 (
+        const float val
+    )
+    /*!
+        ensures
+            - returns the IEEE 754 binary16 (i.e. half precision) encoding of val.
+              The conversion rounds to nearest, ties to even.  Values too large for
+              a half become infinity, values too small become a signed zero, and
+              subnormal halves are produced for values near the bottom of the half
+              precision range.  NaN inputs map to a NaN half.
+    !*/
+    {
+        uint32 f;
+        std::memcpy(&f, &val, sizeof(f));
+        const uint32 sign = (f >> 16) & 0x8000;
+        const uint32 exponent = (f >> 23) & 0xff;
+        uint32 mantissa = f & 0x7fffff;
+
+        // infinity and NaN
+        if (exponent == 0xff)
+            return static_cast<uint16>(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+        // rebias the exponent from float's 127 to half's 15
+        const int new_exp = static_cast<int>(exponent) - 127 + 15;
+
+        // too large to represent, return infinity
+        if (new_exp >= 0x1f)
+            return static_cast<uint16>(sign | 0x7c00);
+
+        if (new_exp <= 0)
+        {
+            // too small for even a subnormal half, return a signed zero
+            if (new_exp < -10)
+                return static_cast<uint16>(sign);
+
+            // encode as a subnormal half, rounding to nearest even.  Note that a
+            // rounding carry out of the mantissa lands in the exponent field and
+            // yields the smallest normal half, which is exactly right.
+            mantissa |= 0x800000;
+            const int shift = 14 - new_exp;
+            uint32 half_mant = mantissa >> shift;
+            const uint32 rem = mantissa & ((1u << shift) - 1);
+            const uint32 halfway = 1u << (shift - 1);
+            if (rem > halfway || (rem == halfway && (half_mant & 1)))
+                ++half_mant;
+            return static_cast<uint16>(sign | half_mant);
+        }
+
+        // normal numbers, round to nearest even.  As above, a rounding carry
+        // propagates into the exponent field and produces the correct result,
+        // including overflow to infinity.
+        uint16 h = static_cast<uint16>(sign | (new_exp << 10) | (mantissa >> 13));
+        const uint32 rem = mantissa & 0x1fff;
+        if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+            ++h;
+        return h;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline float fp16_to_float (
+        const uint16 val
+    )
+    /*!
+        ensures
+            - interprets val as an IEEE 754 binary16 value and returns it as a float.
+              This conversion is exact since every half precision value is exactly
+              representable as a float.
+    !*/
+    {
+        const uint32 sign = static_cast<uint32>(val & 0x8000) << 16;
+        const uint32 exponent = (val >> 10) & 0x1f;
+        uint32 mantissa = val & 0x3ff;
+
+        uint32 f;
+        if (exponent == 0)
+        {
+            if (mantissa == 0)
+            {
+                // signed zero
+                f = sign;
+            }
+            else
+            {
+                // subnormal half, normalize it into a normal float
+                int e = -1;
+                do
+                {
+                    ++e;
+                    mantissa <<= 1;
+                } while ((mantissa & 0x400) == 0);
+                mantissa &= 0x3ff;
+                f = sign | ((127 - 15 - e) << 23) | (mantissa << 13);
+            }
+        }
+        else if (exponent == 0x1f)
+        {
+            // infinity and NaN
+            f = sign | 0x7f800000 | (mantissa << 13);
+        }
+        else
+        {
+            f = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+        }
+
+        float out;
+        std::memcpy(&out, &f, sizeof(out));
+        return out;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_FP16_Hh_
+
+
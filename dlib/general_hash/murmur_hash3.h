@@ -8,6 +8,11 @@
 #include <utility>
 #include <string.h>
 
+#if defined(__AES__) && defined(__SSE2__) && !defined(DLIB_DO_NOT_USE_SIMD)
+#define DLIB_HAVE_AES_NI
+#include <wmmintrin.h>
+#endif
+
 namespace dlib
 {
     //-----------------------------------------------------------------------------
@@ -478,10 +483,241 @@ namespace dlib
 
 // ----------------------------------------------------------------------------------------
 
-    inline std::pair<uint64,uint64> murmur_hash3_128bit_3 ( 
-        uint64 k1, 
+    class murmur_hash3_128bit_stream
+    {
+        /*!
+            INITIAL VALUE
+                - h1 == seed
+                - h2 == seed
+                - total_len == 0
+                - buf_size == 0
+
+            CONVENTION
+                - h1 and h2 == the MurmurHash3_x64_128 state after absorbing all the
+                  complete 16 byte blocks given to add() so far.
+                - buf == the trailing total_len%16 bytes which don't yet form a
+                  complete block.
+                - buf_size == total_len%16
+                - total_len == the total number of bytes given to add() since the
+                  last call to clear().
+        !*/
+    public:
+
+        murmur_hash3_128bit_stream (
+            const uint64 seed = 0
+        )
+        {
+            clear(seed);
+        }
+
+        void clear (
+            const uint64 seed = 0
+        )
+        {
+            h1 = seed;
+            h2 = seed;
+            total_len = 0;
+            buf_size = 0;
+        }
+
+        uint64 size (
+        ) const { return total_len; }
+
+        void add (
+            const void* key,
+            size_t len
+        )
+        {
+            const uint8* data = (const uint8*)key;
+            total_len += len;
+
+            // top off any partially filled block left over from the last add()
+            if (buf_size != 0)
+            {
+                const size_t to_copy = (16-buf_size < len) ? 16-buf_size : len;
+                memcpy(buf+buf_size, data, to_copy);
+                buf_size += static_cast<unsigned int>(to_copy);
+                data += to_copy;
+                len -= to_copy;
+                if (buf_size == 16)
+                {
+                    absorb_block(buf);
+                    buf_size = 0;
+                }
+            }
+
+            while (len >= 16)
+            {
+                absorb_block(data);
+                data += 16;
+                len -= 16;
+            }
+
+            if (len != 0)
+            {
+                memcpy(buf, data, len);
+                buf_size = static_cast<unsigned int>(len);
+            }
+        }
+
+        std::pair<uint64,uint64> get_hash (
+        ) const
+        {
+            // Run the tail and finalization steps on copies of the state so more
+            // bytes can still be added afterwards.
+            uint64 hh1 = h1;
+            uint64 hh2 = h2;
+
+            const uint64 c1 = DLIB_BIG_CONSTANT(0x87c37b91114253d5);
+            const uint64 c2 = DLIB_BIG_CONSTANT(0x4cf5ad432745937f);
+
+            uint64 k1 = 0;
+            uint64 k2 = 0;
+
+            switch(buf_size)
+            {
+                case 15: k2 ^= uint64(buf[14]) << 48; DLIB_FALLTHROUGH; // fall through
+                case 14: k2 ^= uint64(buf[13]) << 40; DLIB_FALLTHROUGH; // fall through
+                case 13: k2 ^= uint64(buf[12]) << 32; DLIB_FALLTHROUGH; // fall through
+                case 12: k2 ^= uint64(buf[11]) << 24; DLIB_FALLTHROUGH; // fall through
+                case 11: k2 ^= uint64(buf[10]) << 16; DLIB_FALLTHROUGH; // fall through
+                case 10: k2 ^= uint64(buf[ 9]) << 8; DLIB_FALLTHROUGH; // fall through
+                case  9: k2 ^= uint64(buf[ 8]) << 0;
+                         k2 *= c2; k2  = DLIB_ROTL64(k2,33); k2 *= c1; hh2 ^= k2; DLIB_FALLTHROUGH; // fall through
+
+                case  8: k1 ^= uint64(buf[ 7]) << 56; DLIB_FALLTHROUGH; // fall through
+                case  7: k1 ^= uint64(buf[ 6]) << 48; DLIB_FALLTHROUGH; // fall through
+                case  6: k1 ^= uint64(buf[ 5]) << 40; DLIB_FALLTHROUGH; // fall through
+                case  5: k1 ^= uint64(buf[ 4]) << 32; DLIB_FALLTHROUGH; // fall through
+                case  4: k1 ^= uint64(buf[ 3]) << 24; DLIB_FALLTHROUGH; // fall through
+                case  3: k1 ^= uint64(buf[ 2]) << 16; DLIB_FALLTHROUGH; // fall through
+                case  2: k1 ^= uint64(buf[ 1]) << 8; DLIB_FALLTHROUGH; // fall through
+                case  1: k1 ^= uint64(buf[ 0]) << 0;
+                         k1 *= c1; k1  = DLIB_ROTL64(k1,31); k1 *= c2; hh1 ^= k1;
+            };
+
+            hh1 ^= total_len; hh2 ^= total_len;
+
+            hh1 += hh2;
+            hh2 += hh1;
+
+            hh1 = murmur_fmix(hh1);
+            hh2 = murmur_fmix(hh2);
+
+            hh1 += hh2;
+            hh2 += hh1;
+
+            return std::make_pair(hh1,hh2);
+        }
+
+    private:
+
+        void absorb_block (
+            const uint8* block
+        )
+        {
+            const uint64 c1 = DLIB_BIG_CONSTANT(0x87c37b91114253d5);
+            const uint64 c2 = DLIB_BIG_CONSTANT(0x4cf5ad432745937f);
+
+            bool is_little_endian = true;
+            uint32 endian_test = 1;
+            if (*reinterpret_cast<unsigned char*>(&endian_test) != 1)
+                is_little_endian = false;
+
+            uint64 k1, k2;
+            const uint64* blocks = (const uint64*)block;
+            if (is_little_endian)
+            {
+                k1 = murmur_getblock(blocks,0);
+                k2 = murmur_getblock(blocks,1);
+            }
+            else
+            {
+                k1 = murmur_getblock_byte_swap(blocks,0);
+                k2 = murmur_getblock_byte_swap(blocks,1);
+            }
+
+            k1 *= c1; k1  = DLIB_ROTL64(k1,31); k1 *= c2; h1 ^= k1;
+
+            h1 = DLIB_ROTL64(h1,27); h1 += h2; h1 = h1*5+0x52dce729;
+
+            k2 *= c2; k2  = DLIB_ROTL64(k2,33); k2 *= c1; h2 ^= k2;
+
+            h2 = DLIB_ROTL64(h2,31); h2 += h1; h2 = h2*5+0x38495ab5;
+        }
+
+        uint64 h1;
+        uint64 h2;
+        uint64 total_len;
+        unsigned int buf_size;
+        uint8 buf[16];
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    inline std::pair<uint64,uint64> fast_hash_128bit (
+        const void* key,
+        const size_t len,
+        const uint64 seed = 0
+    )
+    {
+#ifdef DLIB_HAVE_AES_NI
+        const uint8* data = (const uint8*)key;
+        size_t n = len;
+
+        const uint64 c1 = DLIB_BIG_CONSTANT(0x87c37b91114253d5);
+        const uint64 c2 = DLIB_BIG_CONSTANT(0x4cf5ad432745937f);
+
+        __m128i s0 = _mm_set_epi64x(seed ^ c1, seed + c2);
+        __m128i s1 = _mm_set_epi64x(seed + c1, seed ^ c2);
+
+        while (n >= 32)
+        {
+            s0 = _mm_aesenc_si128(s0, _mm_loadu_si128((const __m128i*)data));
+            s1 = _mm_aesenc_si128(s1, _mm_loadu_si128((const __m128i*)(data+16)));
+            data += 32;
+            n -= 32;
+        }
+        if (n >= 16)
+        {
+            s0 = _mm_aesenc_si128(s0, _mm_loadu_si128((const __m128i*)data));
+            data += 16;
+            n -= 16;
+        }
+        if (n != 0)
+        {
+            uint8 tmp[16] = {0};
+            memcpy(tmp, data, n);
+            s1 = _mm_aesenc_si128(s1, _mm_loadu_si128((const __m128i*)tmp));
+        }
+
+        // Mix in the total length so inputs that differ only by trailing zero bytes
+        // don't collide with each other, then run a few extra rounds so every input
+        // byte avalanches into the whole output.
+        s0 = _mm_aesenc_si128(s0, _mm_set_epi64x(len, seed));
+        __m128i t = _mm_aesenc_si128(s0, s1);
+        t = _mm_aesenc_si128(t, s0);
+        t = _mm_aesenc_si128(t, s1);
+
+        uint64 out[2];
+        _mm_storeu_si128((__m128i*)out, t);
+        return std::make_pair(out[0], out[1]);
+#else
+        // No hardware AES support, so just use murmur hash.  Note that this gives a
+        // different value than the AES code path, which is fine since this function
+        // doesn't promise a portable hash value.
+        murmur_hash3_128bit_stream hasher(seed);
+        hasher.add(key, len);
+        return hasher.get_hash();
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline std::pair<uint64,uint64> murmur_hash3_128bit_3 (
+        uint64 k1,
         uint64 k2,
-        uint64 k3 
+        uint64 k3
     )
     {
         uint64 h1 = k3;
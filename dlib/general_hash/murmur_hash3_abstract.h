@@ -101,7 +101,101 @@ namespace dlib
 
 // ----------------------------------------------------------------------------------------
 
-    std::pair<uint64,uint64> murmur_hash3_128bit_3 ( 
+    class murmur_hash3_128bit_stream
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object is an incremental version of the murmur_hash3_128bit()
+                function defined above.  It lets you hash a block of data which isn't
+                all in memory at once by feeding it in chunks to add().  The resulting
+                hash is identical to what murmur_hash3_128bit() would have produced
+                had the concatenation of all the chunks been hashed in one call.
+        !*/
+    public:
+
+        murmur_hash3_128bit_stream (
+            const uint64 seed = 0
+        );
+        /*!
+            ensures
+                - this object is properly initialized
+                - #size() == 0
+                - Each value of seed results in a different hash function being used.
+        !*/
+
+        void clear (
+            const uint64 seed = 0
+        );
+        /*!
+            ensures
+                - resets this object to its initial value, that is, puts it back in
+                  the state it was in right after construction with the given seed.
+                - #size() == 0
+        !*/
+
+        uint64 size (
+        ) const;
+        /*!
+            ensures
+                - returns the total number of bytes given to add() since the last
+                  call to clear().
+        !*/
+
+        void add (
+            const void* key,
+            size_t len
+        );
+        /*!
+            requires
+                - key == a pointer to a block of memory len bytes long
+            ensures
+                - appends the len bytes pointed to by key to the stream of data being
+                  hashed.
+                - #size() == size() + len
+        !*/
+
+        std::pair<uint64,uint64> get_hash (
+        ) const;
+        /*!
+            ensures
+                - returns a 128bit hash (as two 64bit numbers) of all the bytes given
+                  to add() since the last call to clear().  The returned value is
+                  exactly the value murmur_hash3_128bit(data,size(),seed) would
+                  return if data pointed to all those bytes stored contiguously.
+                - calling get_hash() doesn't modify the stream state.  So you can keep
+                  calling add() afterwards to hash a longer prefix of your data.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    std::pair<uint64,uint64> fast_hash_128bit (
+        const void* key,
+        const size_t len,
+        const uint64 seed = 0
+    );
+    /*!
+        requires
+            - key == a pointer to a block of memory len bytes long
+        ensures
+            - returns a 128bit hash (as two 64bit numbers) of the len bytes pointed to
+              by key.
+            - Each value of seed results in a different hash function being used.
+            - When dlib is compiled with hardware AES support (e.g. -maes on gcc and
+              clang) this function hashes large buffers at close to memory bandwidth
+              by using AES-NI instructions.  Otherwise it falls back to murmur hash.
+            - WARNING: unlike murmur_hash3_128bit(), the value returned by this
+              function is NOT portable.  It differs between machines with and without
+              hardware AES support, and it may change between dlib versions.  So only
+              use it for transient in-memory things like hash tables or deduplication
+              and never for hashes that get written to disk or sent over a network.
+            - This is not a cryptographic hash function, AES instructions are just
+              used as a fast mixing primitive.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    std::pair<uint64,uint64> murmur_hash3_128bit_3 (
         uint64 k1, 
         uint64 k2,
         uint64 k3 
@@ -4,6 +4,7 @@
 #define DLIB_GEOMETRy_HEADER
 
 #include "geometry/rectangle.h"
+#include "geometry/rectangle_batch.h"
 #include "geometry/drectangle.h"
 #include "geometry/vector.h"
 #include "geometry/border_enumerator.h"
@@ -11,6 +11,7 @@
 #include "../optimization/optimization.h"
 #include "rectangle.h"
 #include "drectangle.h"
+#include "../simd.h"
 #include <vector>
 #include <cmath>
 
@@ -272,6 +273,62 @@ namespace dlib
         return point_transform_affine(lhs.get_m()*rhs.get_m(), lhs.get_m()*rhs.get_b()+lhs.get_b());
     }
 
+// ----------------------------------------------------------------------------------------
+
+    inline void transform_points (
+        const point_transform_affine& tform,
+        const std::vector<dlib::vector<float,2> >& points,
+        std::vector<dlib::vector<float,2> >& result
+    )
+    {
+        result.resize(points.size());
+
+        const float m00 = (float)tform.get_m()(0,0), m01 = (float)tform.get_m()(0,1);
+        const float m10 = (float)tform.get_m()(1,0), m11 = (float)tform.get_m()(1,1);
+        const float b0  = (float)tform.get_b().x(),  b1  = (float)tform.get_b().y();
+
+        // Apply the transform 8 points at a time.  The points are stored as
+        // interleaved x,y pairs, which the simd registers can't operate on directly,
+        // so each block is deinterleaved into small x and y buffers first.  Even with
+        // that copying this runs a good deal faster than transforming one point at a
+        // time through the double precision operator().
+        size_t i = 0;
+        float xs[8], ys[8], rx[8], ry[8];
+        for (; i + 8 <= points.size(); i += 8)
+        {
+            for (int k = 0; k < 8; ++k)
+            {
+                xs[k] = points[i+k].x();
+                ys[k] = points[i+k].y();
+            }
+            simd8f xv, yv;
+            xv.load(xs);
+            yv.load(ys);
+            const simd8f ox = m00*xv + m01*yv + b0;
+            const simd8f oy = m10*xv + m11*yv + b1;
+            ox.store(rx);
+            oy.store(ry);
+            for (int k = 0; k < 8; ++k)
+                result[i+k] = dlib::vector<float,2>(rx[k], ry[k]);
+        }
+        for (; i < points.size(); ++i)
+        {
+            const float x = points[i].x();
+            const float y = points[i].y();
+            result[i] = dlib::vector<float,2>(m00*x + m01*y + b0, m10*x + m11*y + b1);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline void transform_points (
+        const point_transform_affine& tform,
+        std::vector<dlib::vector<float,2> >& points
+    )
+    {
+        transform_points(tform, points, points);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     inline point_transform_affine inv (
@@ -92,13 +92,44 @@ namespace dlib
 
     // ----------------------------------------------------------------------------------------
 
+    void transform_points (
+        const point_transform_affine& tform,
+        const std::vector<dlib::vector<float,2> >& points,
+        std::vector<dlib::vector<float,2> >& result
+    );
+    /*!
+        ensures
+            - #result.size() == points.size()
+            - for all valid i:
+                - #result[i] == tform(points[i]), except the arithmetic is performed in
+                  single precision.
+            - This function applies the transform to all the points in one SIMD sweep,
+              so it is much faster than calling tform() on each point individually.
+              Use it when you have a batch of float points to push through one affine
+              transform, e.g. mapping feature pixel locations in a shape_predictor.
+    !*/
+
+    // ----------------------------------------------------------------------------------------
+
+    void transform_points (
+        const point_transform_affine& tform,
+        std::vector<dlib::vector<float,2> >& points
+    );
+    /*!
+        ensures
+            - performs: transform_points(tform, points, points)
+              (i.e. the points are transformed in place)
+    !*/
+
+    // ----------------------------------------------------------------------------------------
+
     point_transform_affine inv (
         const point_transform_affine& trans
     );
     /*!
         ensures
             - If trans is an invertible transformation then this function returns a new
-              transformation that is the inverse of trans. 
+              transformation that is the inverse of trans.
     !*/
 
 // ----------------------------------------------------------------------------------------
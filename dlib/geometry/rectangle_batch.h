@@ -0,0 +1,221 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_RECTANGLE_BaTCH_Hh_
+#define DLIB_RECTANGLE_BaTCH_Hh_
+
+#include "rectangle_batch_abstract.h"
+#include <vector>
+#include "rectangle.h"
+#include "../algs.h"
+#include "../uintn.h"
+#include "../simd.h"
+#include "../matrix.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class rectangle_batch
+    {
+        /*!
+            CONVENTION
+                - num == size()
+                - lefts, tops, rights, and bottoms hold the rectangle coordinates in
+                  structure-of-arrays form, padded out to a multiple of 8 elements with
+                  empty rectangles so the SIMD loops below can always read whole
+                  registers.
+        !*/
+    public:
+
+        rectangle_batch (
+        ) = default;
+
+        explicit rectangle_batch (
+            const std::vector<rectangle>& rects
+        )
+        {
+            assign(rects);
+        }
+
+        void assign (
+            const std::vector<rectangle>& rects
+        )
+        {
+            num = rects.size();
+            const size_t padded = ((num+7)/8)*8;
+            // Pad with empty rectangles so the extra lanes never contribute any area.
+            lefts.assign(padded, 0);
+            tops.assign(padded, 0);
+            rights.assign(padded, -1);
+            bottoms.assign(padded, -1);
+            for (size_t i = 0; i < num; ++i)
+            {
+                // make sure requires clause is not broken
+                DLIB_ASSERT(std::numeric_limits<int32>::min() <= rects[i].left()   && rects[i].left()   <= std::numeric_limits<int32>::max() &&
+                            std::numeric_limits<int32>::min() <= rects[i].top()    && rects[i].top()    <= std::numeric_limits<int32>::max() &&
+                            std::numeric_limits<int32>::min() <= rects[i].right()  && rects[i].right()  <= std::numeric_limits<int32>::max() &&
+                            std::numeric_limits<int32>::min() <= rects[i].bottom() && rects[i].bottom() <= std::numeric_limits<int32>::max(),
+                    "\t void rectangle_batch::assign()"
+                    << "\n\t All the rectangle coordinates must fit in a 32bit integer."
+                    << "\n\t i: " << i
+                );
+                lefts[i]   = static_cast<int32>(rects[i].left());
+                tops[i]    = static_cast<int32>(rects[i].top());
+                rights[i]  = static_cast<int32>(rects[i].right());
+                bottoms[i] = static_cast<int32>(rects[i].bottom());
+            }
+        }
+
+        size_t size (
+        ) const { return num; }
+
+        rectangle operator[] (
+            size_t idx
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(idx < size(),
+                "\t rectangle rectangle_batch::operator[](idx)"
+                << "\n\t idx:    " << idx
+                << "\n\t size(): " << size()
+            );
+            return rectangle(lefts[idx], tops[idx], rights[idx], bottoms[idx]);
+        }
+
+        const int32* left (
+        ) const { return lefts.data(); }
+
+        const int32* top (
+        ) const { return tops.data(); }
+
+        const int32* right (
+        ) const { return rights.data(); }
+
+        const int32* bottom (
+        ) const { return bottoms.data(); }
+
+    private:
+
+        size_t num = 0;
+        std::vector<int32> lefts;
+        std::vector<int32> tops;
+        std::vector<int32> rights;
+        std::vector<int32> bottoms;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    inline void batch_area (
+        const rectangle_batch& rects,
+        std::vector<float>& areas
+    )
+    {
+        areas.resize(rects.size());
+        const simd8i zero(0);
+        const simd8i one(1);
+        float tmp[8];
+        for (size_t i = 0; i < rects.size(); i += 8)
+        {
+            simd8i l, t, r, b;
+            l.load(rects.left()+i);
+            t.load(rects.top()+i);
+            r.load(rects.right()+i);
+            b.load(rects.bottom()+i);
+            const simd8f w(max(r-l+one, zero));
+            const simd8f h(max(b-t+one, zero));
+            const simd8f area = w*h;
+            if (i+8 <= rects.size())
+            {
+                area.store(&areas[i]);
+            }
+            else
+            {
+                area.store(tmp);
+                for (size_t k = i; k < rects.size(); ++k)
+                    areas[k] = tmp[k-i];
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline void batch_contains (
+        const rectangle_batch& rects,
+        const point& p,
+        std::vector<unsigned char>& result
+    )
+    {
+        result.resize(rects.size());
+        const simd8i x(static_cast<int32>(p.x()));
+        const simd8i y(static_cast<int32>(p.y()));
+        const simd8i zero(0);
+        const simd8i one(1);
+        int32 tmp[8];
+        for (size_t i = 0; i < rects.size(); i += 8)
+        {
+            simd8i l, t, r, b;
+            l.load(rects.left()+i);
+            t.load(rects.top()+i);
+            r.load(rects.right()+i);
+            b.load(rects.bottom()+i);
+            const simd8i hit = (l<=x) & (x<=r) & (t<=y) & (y<=b);
+            select(hit, one, zero).store(tmp);
+            const size_t stop = std::min<size_t>(i+8, rects.size());
+            for (size_t k = i; k < stop; ++k)
+                result[k] = static_cast<unsigned char>(tmp[k-i]);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline matrix<float> intersection_over_union_matrix (
+        const rectangle_batch& a,
+        const rectangle_batch& b
+    )
+    {
+        matrix<float> iou(a.size(), b.size());
+        const simd8i zero(0);
+        const simd8i one(1);
+        const simd8f zerof(0);
+        float tmp[8];
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            const simd8i al(a.left()[i]);
+            const simd8i at(a.top()[i]);
+            const simd8i ar(a.right()[i]);
+            const simd8i ab(a.bottom()[i]);
+            for (size_t j = 0; j < b.size(); j += 8)
+            {
+                simd8i bl, bt, br, bb;
+                bl.load(b.left()+j);
+                bt.load(b.top()+j);
+                br.load(b.right()+j);
+                bb.load(b.bottom()+j);
+                const simd8f iw(max(min(ar,br)-max(al,bl)+one, zero));
+                const simd8f ih(max(min(ab,bb)-max(at,bt)+one, zero));
+                const simd8f inner = iw*ih;
+                // Match box_intersection_over_union(), which divides by the area of
+                // the smallest rectangle containing both boxes.
+                const simd8f outer = simd8f(max(ar,br)-min(al,bl)+one)*simd8f(max(ab,bb)-min(at,bt)+one);
+                const simd8f vals = select(inner>zerof, inner/outer, zerof);
+                if (j+8 <= b.size())
+                {
+                    vals.store(&iou(i,j));
+                }
+                else
+                {
+                    vals.store(tmp);
+                    for (size_t k = j; k < b.size(); ++k)
+                        iou(i,k) = tmp[k-j];
+                }
+            }
+        }
+        return iou;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_RECTANGLE_BaTCH_Hh_
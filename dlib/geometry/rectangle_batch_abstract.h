@@ -0,0 +1,145 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_RECTANGLE_BaTCH_ABSTRACT_Hh_
+#ifdef DLIB_RECTANGLE_BaTCH_ABSTRACT_Hh_
+
+#include <vector>
+#include "rectangle_abstract.h"
+#include "../matrix.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class rectangle_batch
+    {
+        /*!
+            INITIAL VALUE
+                - size() == 0
+
+            WHAT THIS OBJECT REPRESENTS
+                This object holds a set of rectangles in structure-of-arrays form,
+                i.e. the left, top, right, and bottom coordinates each live in their
+                own contiguous array.  This layout lets the batch geometry routines
+                below process 8 rectangles at a time with SIMD instructions, which is
+                much faster than calling the scalar rectangle functions in a loop when
+                you have to evaluate many boxes (e.g. when associating detections to
+                tracks).
+
+                Note that the coordinates are stored as 32bit integers, so all the
+                rectangles given to this object must have coordinates that fit in a
+                32bit integer.
+        !*/
+    public:
+
+        rectangle_batch (
+        ) = default;
+        /*!
+            ensures
+                - this object is properly initialized
+        !*/
+
+        explicit rectangle_batch (
+            const std::vector<rectangle>& rects
+        );
+        /*!
+            requires
+                - all the coordinates in rects fit in a 32bit integer.
+            ensures
+                - #size() == rects.size()
+                - for all valid i: (*this)[i] == rects[i]
+        !*/
+
+        void assign (
+            const std::vector<rectangle>& rects
+        );
+        /*!
+            requires
+                - all the coordinates in rects fit in a 32bit integer.
+            ensures
+                - #size() == rects.size()
+                - for all valid i: (*this)[i] == rects[i]
+        !*/
+
+        size_t size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of rectangles in this batch.
+        !*/
+
+        rectangle operator[] (
+            size_t idx
+        ) const;
+        /*!
+            requires
+                - idx < size()
+            ensures
+                - returns the idx-th rectangle in this batch.
+        !*/
+
+        const int32* left (
+        ) const;
+        const int32* top (
+        ) const;
+        const int32* right (
+        ) const;
+        const int32* bottom (
+        ) const;
+        /*!
+            ensures
+                - returns a pointer to the coordinate array in question.  Each array
+                  holds size() coordinates, padded out to a multiple of 8 elements
+                  with empty rectangles so SIMD code can always read whole registers.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    void batch_area (
+        const rectangle_batch& rects,
+        std::vector<float>& areas
+    );
+    /*!
+        ensures
+            - #areas.size() == rects.size()
+            - for all valid i: #areas[i] == rects[i].area()
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    void batch_contains (
+        const rectangle_batch& rects,
+        const point& p,
+        std::vector<unsigned char>& result
+    );
+    /*!
+        ensures
+            - #result.size() == rects.size()
+            - for all valid i: #result[i] == (rects[i].contains(p) ? 1 : 0)
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    matrix<float> intersection_over_union_matrix (
+        const rectangle_batch& a,
+        const rectangle_batch& b
+    );
+    /*!
+        ensures
+            - returns a matrix M such that:
+                - M.nr() == a.size()
+                - M.nc() == b.size()
+                - for all valid (r,c):
+                    - M(r,c) == box_intersection_over_union(a[r], b[c])
+                      (i.e. the area of the intersection divided by the area of the
+                      smallest rectangle containing both boxes, or 0 if they don't
+                      intersect)
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_RECTANGLE_BaTCH_ABSTRACT_Hh_
@@ -5,7 +5,9 @@
 
 #include "global_optimization/upper_bound_function.h"
 #include "global_optimization/global_function_search.h"
+#include "global_optimization/global_function_search_distributed.h"
 #include "global_optimization/find_max_global.h"
+#include "global_optimization/find_max_global_batched.h"
 
 #endif // DLIB_GLOBAL_OPTIMIZATIOn_HEADER
 
@@ -0,0 +1,194 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_FiND_GLOBAL_MAXIMUM_BATCHED_hH_
+#define DLIB_FiND_GLOBAL_MAXIMUM_BATCHED_hH_
+
+#include "find_max_global_batched_abstract.h"
+
+#ifdef DLIB_USE_CUDA
+
+#include "find_max_global.h"
+#include "../cuda/cuda_data_ptr.h"
+
+namespace dlib
+{
+    namespace impl
+    {
+        template <
+            typename funct
+            >
+        function_evaluation find_max_global_batched (
+            funct& f,
+            function_spec spec,
+            const max_function_calls num,
+            const size_t eval_batch_size,
+            const std::chrono::nanoseconds max_runtime,
+            double solver_epsilon,
+            double ymult
+        )
+        {
+            DLIB_CASSERT(eval_batch_size != 0);
+
+            // Search any parameter with bounds spanning many orders of magnitude on a log
+            // scale, just like find_max_global() does.
+            std::vector<bool> log_scale;
+            for (long j = 0; j < spec.lower.size(); ++j)
+            {
+                if (!spec.is_integer_variable[j] && spec.lower(j) > 0 && spec.upper(j)/spec.lower(j) >= 1000)
+                {
+                    log_scale.push_back(true);
+                    spec.lower(j) = std::log(spec.lower(j));
+                    spec.upper(j) = std::log(spec.upper(j));
+                }
+                else
+                {
+                    log_scale.push_back(false);
+                }
+            }
+
+            global_function_search opt(spec);
+            opt.set_solver_epsilon(solver_epsilon);
+
+            using namespace std::chrono;
+            const auto time_to_stop = steady_clock::now() + max_runtime;
+
+            std::vector<double> host_xs;
+            std::vector<double> host_ys;
+            cuda::cuda_data_ptr<double> xs, ys;
+
+            for (size_t i = 0; i < num.max_calls && steady_clock::now() < time_to_stop; )
+            {
+                const size_t batch_size = std::min<size_t>(eval_batch_size, num.max_calls - i);
+
+                // Ask the optimizer for a whole batch of candidate points and pack them,
+                // one candidate per row, into a single host buffer.
+                std::vector<function_evaluation_request> requests;
+                requests.reserve(batch_size);
+                host_xs.clear();
+                for (size_t k = 0; k < batch_size; ++k)
+                {
+                    requests.emplace_back(opt.get_next_x());
+                    matrix<double,0,1> x = requests.back().x();
+                    // Undo any log-scaling that was applied to the variables before we
+                    // hand them to the objective function.
+                    for (long j = 0; j < x.size(); ++j)
+                    {
+                        if (log_scale[j])
+                            x(j) = std::exp(x(j));
+                        host_xs.push_back(x(j));
+                    }
+                }
+
+                // One upload, one batched evaluation on the device, one download.  This
+                // is the whole point of this routine: the objective function never has to
+                // bounce individual candidates over PCIe.
+                memcpy(xs, host_xs);
+                if (ys.size() != batch_size)
+                    ys = cuda::cuda_data_ptr<double>(batch_size);
+                const cuda::cuda_data_ptr<const double> xs_view = xs;
+                f(xs_view, ys);
+                memcpy(host_ys, ys);
+                DLIB_CASSERT(host_ys.size() == batch_size);
+
+                for (size_t k = 0; k < batch_size; ++k)
+                    requests[k].set(ymult*host_ys[k]);
+
+                i += batch_size;
+            }
+
+            matrix<double,0,1> x;
+            double y;
+            size_t function_idx;
+            opt.get_best_function_eval(x,y,function_idx);
+            // Undo any log-scaling that was applied to the variables before we output them.
+            for (long j = 0; j < x.size(); ++j)
+            {
+                if (log_scale[j])
+                    x(j) = std::exp(x(j));
+            }
+            return function_evaluation(x,y/ymult);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename funct
+        >
+    function_evaluation find_max_global_batched (
+        funct f,
+        const matrix<double,0,1>& bound1,
+        const matrix<double,0,1>& bound2,
+        const std::vector<bool>& is_integer_variable,
+        const max_function_calls num,
+        const size_t eval_batch_size,
+        const std::chrono::nanoseconds max_runtime = FOREVER,
+        double solver_epsilon = 0
+    )
+    {
+        return impl::find_max_global_batched(f, function_spec(bound1, bound2, is_integer_variable),
+            num, eval_batch_size, max_runtime, solver_epsilon, +1);
+    }
+
+    template <
+        typename funct
+        >
+    function_evaluation find_min_global_batched (
+        funct f,
+        const matrix<double,0,1>& bound1,
+        const matrix<double,0,1>& bound2,
+        const std::vector<bool>& is_integer_variable,
+        const max_function_calls num,
+        const size_t eval_batch_size,
+        const std::chrono::nanoseconds max_runtime = FOREVER,
+        double solver_epsilon = 0
+    )
+    {
+        return impl::find_max_global_batched(f, function_spec(bound1, bound2, is_integer_variable),
+            num, eval_batch_size, max_runtime, solver_epsilon, -1);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename funct
+        >
+    function_evaluation find_max_global_batched (
+        funct f,
+        const matrix<double,0,1>& bound1,
+        const matrix<double,0,1>& bound2,
+        const max_function_calls num,
+        const size_t eval_batch_size,
+        const std::chrono::nanoseconds max_runtime = FOREVER,
+        double solver_epsilon = 0
+    )
+    {
+        return impl::find_max_global_batched(f, function_spec(bound1, bound2),
+            num, eval_batch_size, max_runtime, solver_epsilon, +1);
+    }
+
+    template <
+        typename funct
+        >
+    function_evaluation find_min_global_batched (
+        funct f,
+        const matrix<double,0,1>& bound1,
+        const matrix<double,0,1>& bound2,
+        const max_function_calls num,
+        const size_t eval_batch_size,
+        const std::chrono::nanoseconds max_runtime = FOREVER,
+        double solver_epsilon = 0
+    )
+    {
+        return impl::find_max_global_batched(f, function_spec(bound1, bound2),
+            num, eval_batch_size, max_runtime, solver_epsilon, -1);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_USE_CUDA
+
+#endif // DLIB_FiND_GLOBAL_MAXIMUM_BATCHED_hH_
+
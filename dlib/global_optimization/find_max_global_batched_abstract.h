@@ -0,0 +1,140 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_FiND_GLOBAL_MAXIMUM_BATCHED_ABSTRACT_hH_
+#ifdef DLIB_FiND_GLOBAL_MAXIMUM_BATCHED_ABSTRACT_hH_
+
+#include "find_max_global_abstract.h"
+#include "../cuda/cuda_data_ptr.h"
+#include "../matrix.h"
+#include <chrono>
+#include <vector>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename funct
+        >
+    function_evaluation find_max_global_batched (
+        funct f,
+        const matrix<double,0,1>& bound1,
+        const matrix<double,0,1>& bound2,
+        const std::vector<bool>& is_integer_variable,
+        const max_function_calls num,
+        const size_t eval_batch_size,
+        const std::chrono::nanoseconds max_runtime = FOREVER,
+        double solver_epsilon = 0
+    );
+    /*!
+        requires
+            - eval_batch_size != 0
+            - bound1.size() == bound2.size() == is_integer_variable.size()
+            - for all valid i: bound1(i) != bound2(i)
+            - solver_epsilon >= 0
+            - f must be a function object with a signature compatible with:
+                void f(
+                    const cuda::cuda_data_ptr<const double>& xs,
+                    cuda::cuda_data_ptr<double>& ys
+                )
+              where xs holds a batch of ys.size() candidate points, packed one after
+              another so that candidate k occupies xs[k*bound1.size()] through
+              xs[(k+1)*bound1.size()-1], and f() writes the objective function value of
+              candidate k into ys[k].  Both buffers live on the currently selected CUDA
+              device, so a GPU-accelerated objective can evaluate the whole batch without
+              ever copying individual candidates between the host and the device.
+        ensures
+            - This function performs the same global optimization as the single function
+              version of find_max_global() except that candidate points are handed to the
+              objective function in device resident batches of at most eval_batch_size
+              points instead of one matrix<double,0,1> at a time.  Use it when the
+              objective function runs on the GPU and the per call PCIe round trip of the
+              host based interface would dominate the runtime.
+            - For each batch, this routine uploads all the candidate points to the device
+              with a single copy, calls f() once, and downloads all the scores with a
+              single copy.
+            - Note that the batch is drawn from the solver before any of its scores are
+              known, so very large values of eval_batch_size trade search quality for
+              throughput.  Values in the tens are usually a good compromise.
+            - The total number of calls to the objective function's underlying evaluation
+              is bounded by num.max_calls, and the search stops early once max_runtime has
+              elapsed.
+            - Variables with bounds spanning many orders of magnitude are searched on a
+              log scale, exactly as find_max_global() does.
+            - returns the best function_evaluation found.  Note that the reported x comes
+              from the solver's bookkeeping, so it is unaffected by any scaling f() might
+              apply internally.
+    !*/
+
+    template <
+        typename funct
+        >
+    function_evaluation find_min_global_batched (
+        funct f,
+        const matrix<double,0,1>& bound1,
+        const matrix<double,0,1>& bound2,
+        const std::vector<bool>& is_integer_variable,
+        const max_function_calls num,
+        const size_t eval_batch_size,
+        const std::chrono::nanoseconds max_runtime = FOREVER,
+        double solver_epsilon = 0
+    );
+    /*!
+        requires
+            - The same requirements as find_max_global_batched().
+        ensures
+            - This function is identical to find_max_global_batched() except that it
+              finds the minimum of the objective function rather than the maximum.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename funct
+        >
+    function_evaluation find_max_global_batched (
+        funct f,
+        const matrix<double,0,1>& bound1,
+        const matrix<double,0,1>& bound2,
+        const max_function_calls num,
+        const size_t eval_batch_size,
+        const std::chrono::nanoseconds max_runtime = FOREVER,
+        double solver_epsilon = 0
+    );
+    /*!
+        requires
+            - The same requirements as the above find_max_global_batched() routine.
+        ensures
+            - performs: return find_max_global_batched(std::move(f), bound1, bound2,
+              std::vector<bool>(bound1.size(),false), num, eval_batch_size, max_runtime,
+              solver_epsilon);
+    !*/
+
+    template <
+        typename funct
+        >
+    function_evaluation find_min_global_batched (
+        funct f,
+        const matrix<double,0,1>& bound1,
+        const matrix<double,0,1>& bound2,
+        const max_function_calls num,
+        const size_t eval_batch_size,
+        const std::chrono::nanoseconds max_runtime = FOREVER,
+        double solver_epsilon = 0
+    );
+    /*!
+        requires
+            - The same requirements as the above find_min_global_batched() routine.
+        ensures
+            - performs: return find_min_global_batched(std::move(f), bound1, bound2,
+              std::vector<bool>(bound1.size(),false), num, eval_batch_size, max_runtime,
+              solver_epsilon);
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_FiND_GLOBAL_MAXIMUM_BATCHED_ABSTRACT_hH_
+
@@ -415,7 +415,40 @@ namespace dlib
 
 // ----------------------------------------------------------------------------------------
 
-    namespace gopt_impl 
+    void serialize (
+        const function_spec& item,
+        std::ostream& out
+    )
+    {
+        int version = 1;
+        serialize(version, out);
+        serialize(item.lower, out);
+        serialize(item.upper, out);
+        serialize(item.is_integer_variable, out);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void deserialize (
+        function_spec& item,
+        std::istream& in
+    )
+    {
+        int version = 0;
+        deserialize(version, in);
+        if (version != 1)
+            throw serialization_error("Unexpected version found while deserializing dlib::function_spec.");
+        matrix<double,0,1> lower, upper;
+        std::vector<bool> is_integer_variable;
+        deserialize(lower, in);
+        deserialize(upper, in);
+        deserialize(is_integer_variable, in);
+        item = function_spec(std::move(lower), std::move(upper), std::move(is_integer_variable));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    namespace gopt_impl
     {
         upper_bound_function funct_info::build_upper_bound_with_all_function_evals (
         ) const
@@ -942,6 +975,83 @@ namespace dlib
         return false;
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void serialize (
+        const global_function_search& item,
+        std::ostream& out
+    )
+    {
+        // Lock the search state so it's safe to serialize even while other threads are
+        // reporting results via function_evaluation_request::set().
+        std::unique_lock<std::mutex> lock;
+        if (item.m)
+            lock = std::unique_lock<std::mutex>(*item.m);
+
+        int version = 1;
+        serialize(version, out);
+        serialize(item.rnd, out);
+        serialize(item.pure_random_search_probability, out);
+        serialize(item.min_trust_region_epsilon, out);
+        serialize(item.relative_noise_magnitude, out);
+        serialize(item.num_random_samples, out);
+        serialize(item.do_trust_region_step, out);
+        serialize(item.next_request_id, out);
+        serialize(item.functions.size(), out);
+        for (auto& f : item.functions)
+        {
+            // Note that we don't save the outstanding evaluation requests since they
+            // refer to live function_evaluation_request objects that can't exist in a
+            // deserialized copy.  When the search is restored it will simply be as if
+            // those requests were never issued.
+            serialize(f->spec, out);
+            serialize(f->ub.get_points(), out);
+            serialize(f->best_x, out);
+            serialize(f->best_objective_value, out);
+            serialize(f->radius, out);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void deserialize (
+        global_function_search& item,
+        std::istream& in
+    )
+    {
+        int version = 0;
+        deserialize(version, in);
+        if (version != 1)
+            throw serialization_error("Unexpected version found while deserializing dlib::global_function_search.");
+
+        global_function_search temp;
+        temp.m = std::make_shared<std::mutex>();
+        deserialize(temp.rnd, in);
+        deserialize(temp.pure_random_search_probability, in);
+        deserialize(temp.min_trust_region_epsilon, in);
+        deserialize(temp.relative_noise_magnitude, in);
+        deserialize(temp.num_random_samples, in);
+        deserialize(temp.do_trust_region_step, in);
+        deserialize(temp.next_request_id, in);
+        size_t num_functions = 0;
+        deserialize(num_functions, in);
+        temp.functions.reserve(num_functions);
+        for (size_t i = 0; i < num_functions; ++i)
+        {
+            function_spec spec({0},{1});
+            deserialize(spec, in);
+            auto f = std::make_shared<gopt_impl::funct_info>(spec, i, temp.m);
+            std::vector<function_evaluation> evals;
+            deserialize(evals, in);
+            f->ub = upper_bound_function(evals, temp.relative_noise_magnitude);
+            deserialize(f->best_x, in);
+            deserialize(f->best_objective_value, in);
+            deserialize(f->radius, in);
+            temp.functions.push_back(std::move(f));
+        }
+        item = std::move(temp);
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
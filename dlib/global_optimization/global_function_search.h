@@ -34,6 +34,16 @@ namespace dlib
         std::vector<bool> is_integer_variable;
     };
 
+    void serialize (
+        const function_spec& item,
+        std::ostream& out
+    );
+
+    void deserialize (
+        function_spec& item,
+        std::istream& in
+    );
+
 // ----------------------------------------------------------------------------------------
 
     namespace gopt_impl 
@@ -210,6 +220,16 @@ namespace dlib
             size_t num
         );
 
+        friend void serialize (
+            const global_function_search& item,
+            std::ostream& out
+        );
+
+        friend void deserialize (
+            global_function_search& item,
+            std::istream& in
+        );
+
     private:
 
         std::shared_ptr<gopt_impl::funct_info> best_function(
@@ -66,6 +66,22 @@ namespace dlib
         std::vector<bool> is_integer_variable;
     };
 
+    void serialize (
+        const function_spec& item,
+        std::ostream& out
+    );
+    /*!
+        provides serialization support
+    !*/
+
+    void deserialize (
+        function_spec& item,
+        std::istream& in
+    );
+    /*!
+        provides deserialization support
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     class function_evaluation_request
@@ -596,11 +612,46 @@ namespace dlib
             requires
                 - num > 0
             ensures
-                - #get_monte_carlo_upper_bound_sample_num() == num 
+                - #get_monte_carlo_upper_bound_sample_num() == num
         !*/
 
     };
 
+    void serialize (
+        const global_function_search& item,
+        std::ostream& out
+    );
+    /*!
+        ensures
+            - Saves the entire state of the search to the given output stream.  That is,
+              all the function specs, every function evaluation seen so far, the state of
+              the trust regions, the random number generator, and all the parameter
+              settings are written to out.  This makes it possible to checkpoint a long
+              running optimization to disk and resume it later, even in another process,
+              by using deserialize().
+            - It is safe to call this function while other threads are reporting results
+              via function_evaluation_request::set().
+            - Note that outstanding function evaluation requests (i.e. requests obtained
+              from get_next_x() whose set() methods haven't been called yet) are not
+              saved.  When the search is restored it will be as if those requests were
+              never issued.
+    !*/
+
+    void deserialize (
+        global_function_search& item,
+        std::istream& in
+    );
+    /*!
+        ensures
+            - #item == the global_function_search state saved to the given input stream by
+              serialize().  The restored object will continue the optimization from the
+              point where serialize() was called.
+        throws
+            - serialization_error
+              This exception is thrown if there is some problem restoring the object from
+              the input stream.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
 }
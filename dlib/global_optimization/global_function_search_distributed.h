@@ -0,0 +1,274 @@
+// Copyright (C) 2017  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_GLOBAL_FuNCTION_SEARCH_DISTRIBUTED_Hh_
+#define DLIB_GLOBAL_FuNCTION_SEARCH_DISTRIBUTED_Hh_
+
+#include "global_function_search_distributed_abstract.h"
+#include "global_function_search.h"
+#include "../bridge.h"
+#include "../pipe.h"
+#include "../threads.h"
+#include "../type_safe_union.h"
+#include "../uintn.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    namespace gopt_impl
+    {
+        struct remote_eval_request
+        {
+            uint64 request_id = 0;
+            uint64 function_idx = 0;
+            matrix<double,0,1> x;
+
+            friend void serialize (const remote_eval_request& item, std::ostream& out)
+            {
+                dlib::serialize(item.request_id, out);
+                dlib::serialize(item.function_idx, out);
+                serialize(item.x, out);
+            }
+
+            friend void deserialize (remote_eval_request& item, std::istream& in)
+            {
+                dlib::deserialize(item.request_id, in);
+                dlib::deserialize(item.function_idx, in);
+                deserialize(item.x, in);
+            }
+        };
+
+    // ------------------------------------------------------------------------------------
+
+        struct remote_eval_result
+        {
+            uint64 request_id = 0;
+            double y = 0;
+
+            friend void serialize (const remote_eval_result& item, std::ostream& out)
+            {
+                dlib::serialize(item.request_id, out);
+                dlib::serialize(item.y, out);
+            }
+
+            friend void deserialize (remote_eval_result& item, std::istream& in)
+            {
+                dlib::deserialize(item.request_id, in);
+                dlib::deserialize(item.y, in);
+            }
+        };
+
+    } // end namespace gopt_impl
+
+// ----------------------------------------------------------------------------------------
+
+    class global_function_search_worker : noncopyable, private threaded_object
+    {
+    public:
+
+        global_function_search_worker (
+            const std::function<double(size_t, const matrix<double,0,1>&)>& f_,
+            unsigned short port
+        ) :
+            f(f_), in(4), out(4)
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(f_ != nullptr && port != 0,
+                "\t global_function_search_worker()"
+                << "\n\t Invalid arguments were given to this function"
+                << "\n\t (f_ != nullptr): " << (f_ != nullptr)
+                << "\n\t port: " << port
+                << "\n\t this: " << this
+                );
+
+            b.reconfigure(listen_on_port(port), receive(in), transmit(out));
+            start();
+        }
+
+        ~global_function_search_worker (
+        )
+        {
+            in.disable();
+            out.disable();
+            wait();
+        }
+
+    private:
+
+        // The result direction is sent through a type_safe_union so that the controller
+        // can receive bridge_status objects through the same pipe.  Both ends must list
+        // remote_eval_result first for the serialized type index to match.
+        typedef type_safe_union<gopt_impl::remote_eval_result> tsu_out;
+
+        void thread (
+        )
+        {
+            gopt_impl::remote_eval_request req;
+            while (in.dequeue(req))
+            {
+                tsu_out temp;
+                gopt_impl::remote_eval_result& result = temp.get<gopt_impl::remote_eval_result>();
+                result.request_id = req.request_id;
+                result.y = f(static_cast<size_t>(req.function_idx), req.x);
+                out.enqueue(temp);
+            }
+        }
+
+        std::function<double(size_t, const matrix<double,0,1>&)> f;
+        pipe<gopt_impl::remote_eval_request> in;
+        pipe<tsu_out> out;
+        bridge b;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    class global_function_search_controller : noncopyable
+    {
+    public:
+
+        explicit global_function_search_controller (
+            global_function_search& search_
+        ) : search(search_) {}
+
+        void add_worker (
+            const network_address& addr
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(addr.port != 0,
+                "\t void global_function_search_controller::add_worker()"
+                << "\n\t The worker address must include a non-zero port number."
+                << "\n\t addr: " << addr
+                << "\n\t this: " << this
+                );
+
+            workers.emplace_back(new worker_connection);
+            auto& w = *workers.back();
+            w.b.reconfigure(connect_to(addr), receive(w.in), transmit(w.out));
+        }
+
+        size_t num_workers (
+        ) const
+        {
+            return workers.size();
+        }
+
+        void execute (
+            size_t num_evaluations
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(num_workers() != 0 && search.num_functions() != 0,
+                "\t void global_function_search_controller::execute()"
+                << "\n\t You must add at least one worker and give the search some functions."
+                << "\n\t num_workers():          " << num_workers()
+                << "\n\t search.num_functions(): " << search.num_functions()
+                << "\n\t this: " << this
+                );
+
+            size_t num_issued = 0;
+            std::vector<std::thread> threads;
+            for (auto& w : workers)
+            {
+                worker_connection* wc = w.get();
+                threads.emplace_back([&,wc]() { drive_worker(*wc, num_evaluations, num_issued); });
+            }
+            for (auto& t : threads)
+                t.join();
+        }
+
+    private:
+
+        struct worker_connection
+        {
+            worker_connection() : in(4), out(4) {}
+
+            pipe<type_safe_union<gopt_impl::remote_eval_result, bridge_status>> in;
+            pipe<gopt_impl::remote_eval_request> out;
+            bridge b;
+        };
+
+        void drive_worker (
+            worker_connection& w,
+            const size_t num_evaluations,
+            size_t& num_issued
+        )
+        {
+            while (true)
+            {
+                std::unique_ptr<function_evaluation_request> req;
+                gopt_impl::remote_eval_request msg;
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    if (num_issued == num_evaluations)
+                        return;
+                    ++num_issued;
+                    req.reset(new function_evaluation_request(search.get_next_x()));
+                    msg.request_id = ++next_request_id;
+                }
+                msg.function_idx = req->function_idx();
+                msg.x = req->x();
+
+                auto send_request = [&]() { auto temp = msg; w.out.enqueue(temp); };
+                send_request();
+
+                bool saw_disconnect = false;
+                type_safe_union<gopt_impl::remote_eval_result, bridge_status> resp;
+                while (w.in.dequeue(resp))
+                {
+                    if (resp.contains<bridge_status>())
+                    {
+                        // If the TCP connection dropped after we handed the request to the
+                        // bridge then the worker may never have seen it.  So once the
+                        // bridge reconnects we send the request again.  The worker might
+                        // end up evaluating it twice but the duplicate result is discarded
+                        // by the request_id check below.
+                        if (!resp.get<bridge_status>().is_connected)
+                        {
+                            saw_disconnect = true;
+                        }
+                        else if (saw_disconnect)
+                        {
+                            saw_disconnect = false;
+                            send_request();
+                        }
+                        continue;
+                    }
+
+                    const auto& result = resp.get<gopt_impl::remote_eval_result>();
+                    // ignore stale results from requests that were resent
+                    if (result.request_id != msg.request_id)
+                        continue;
+
+                    // function_evaluation_request::set() does its own synchronization with
+                    // the global_function_search, so no lock is needed here.
+                    req->set(result.y);
+                    break;
+                }
+
+                // If the pipe was disabled before we got our answer then we are shutting
+                // down.  Destructing req simply makes it as if the request was never
+                // issued.
+                if (!req->has_been_evaluated())
+                    return;
+            }
+        }
+
+        global_function_search& search;
+        std::mutex m;
+        uint64 next_request_id = 0;
+        std::vector<std::unique_ptr<worker_connection>> workers;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_GLOBAL_FuNCTION_SEARCH_DISTRIBUTED_Hh_
+
@@ -0,0 +1,168 @@
+// Copyright (C) 2017  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_GLOBAL_FuNCTION_SEARCH_DISTRIBUTED_ABSTRACT_Hh_
+#ifdef DLIB_GLOBAL_FuNCTION_SEARCH_DISTRIBUTED_ABSTRACT_Hh_
+
+#include "global_function_search_abstract.h"
+#include "../bridge/bridge_abstract.h"
+#include <functional>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class global_function_search_worker
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object runs on a remote machine and evaluates objective functions on
+                behalf of a global_function_search_controller.  It listens on a TCP port
+                for function evaluation requests, runs the user supplied function on each
+                request, and sends the results back.  Together with the
+                global_function_search_controller it makes the parallelism already present
+                in the global_function_search API (i.e. calling get_next_x() multiple
+                times and reporting the results back asynchronously via
+                function_evaluation_request::set()) work across a network of machines
+                rather than just across the threads of one process.
+
+                Note that the worker evaluates one request at a time.  If you want to use
+                multiple cores of a machine then simply run multiple worker processes on
+                it, each listening on its own port, and add each of them to the
+                controller.
+
+                The network protocol is the dlib::bridge protocol.  Each request is a
+                serialized (request_id, function_idx, x) tuple and each reply is a
+                serialized (request_id, y) pair.
+        !*/
+
+    public:
+
+        global_function_search_worker (
+            const std::function<double(size_t, const matrix<double,0,1>&)>& f,
+            unsigned short port
+        );
+        /*!
+            requires
+                - f != nullptr
+                - port != 0
+            ensures
+                - This object will listen on the given TCP port for incoming connections
+                  from a global_function_search_controller.  Once connected, each time the
+                  controller asks for function_idx to be evaluated at some point x, this
+                  object calls f(function_idx, x) and sends the resulting value back to
+                  the controller.
+                - The function evaluations happen in another thread, so this constructor
+                  returns immediately.  This object will keep servicing requests until it
+                  is destructed.
+        !*/
+
+        ~global_function_search_worker (
+        );
+        /*!
+            ensures
+                - Stops servicing evaluation requests and blocks until any currently
+                  running function evaluation has finished.
+        !*/
+
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    class global_function_search_controller
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object farms the function evaluations requested by a
+                global_function_search out to a set of remote
+                global_function_search_worker instances.  That is, it runs the
+                get_next_x()/set() loop for you, except that the objective functions are
+                evaluated on the remote machines rather than locally.  For example:
+
+                    global_function_search opt({spec_F, spec_G});
+
+                    global_function_search_controller controller(opt);
+                    controller.add_worker(network_address("some.machine.com:1234"));
+                    controller.add_worker(network_address("another.machine.com:1234"));
+
+                    // Run 100 function evaluations, spread across the workers.
+                    controller.execute(100);
+
+                    // Now interrogate opt in the usual way, e.g. via
+                    // opt.get_best_function_eval().
+
+                Each worker is given one outstanding evaluation request at a time, so with
+                N workers there will be up to N function evaluations in flight at once.
+                Since the controller just drives the normal global_function_search API you
+                can also checkpoint a long running search by periodically serializing the
+                global_function_search object between calls to execute().
+
+                If the connection to a worker is lost the controller automatically
+                reconnects and resends the outstanding request, so transient network
+                failures or worker restarts don't lose evaluations.  However, if a worker
+                stays down forever then execute() will wait forever for it.
+
+            THREAD SAFETY
+                You shouldn't let more than one thread touch a
+                global_function_search_controller at the same time.  Moreover, while a
+                call to execute() is running you shouldn't touch the underlying
+                global_function_search from any other thread.
+        !*/
+
+    public:
+
+        explicit global_function_search_controller (
+            global_function_search& search
+        );
+        /*!
+            ensures
+                - #num_workers() == 0
+                - This object will hold a reference to search.  Therefore, search must
+                  outlive this object.
+        !*/
+
+        void add_worker (
+            const network_address& addr
+        );
+        /*!
+            requires
+                - addr.port != 0
+            ensures
+                - #num_workers() == num_workers() + 1
+                - This object will attempt to connect to the global_function_search_worker
+                  listening on addr and will use it to perform function evaluations.  Note
+                  that the connection is established in the background, so this function
+                  returns immediately even if the worker isn't reachable yet.
+        !*/
+
+        size_t num_workers (
+        ) const;
+        /*!
+            ensures
+                - returns the number of workers added via add_worker().
+        !*/
+
+        void execute (
+            size_t num_evaluations
+        );
+        /*!
+            requires
+                - num_workers() != 0
+                - search.num_functions() != 0, where search is the global_function_search
+                  given to this object's constructor.
+            ensures
+                - Pulls num_evaluations function evaluation requests from the
+                  global_function_search via get_next_x(), evaluates them on the remote
+                  workers, and reports each result back via
+                  function_evaluation_request::set().  Blocks until all num_evaluations
+                  results have been received.
+        !*/
+
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_GLOBAL_FuNCTION_SEARCH_DISTRIBUTED_ABSTRACT_Hh_
+
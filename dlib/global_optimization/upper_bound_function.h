@@ -23,6 +23,24 @@ namespace dlib
         double y = std::numeric_limits<double>::quiet_NaN();
     };
 
+    inline void serialize (
+        const function_evaluation& item,
+        std::ostream& out
+    )
+    {
+        serialize(item.x, out);
+        serialize(item.y, out);
+    }
+
+    inline void deserialize (
+        function_evaluation& item,
+        std::istream& in
+    )
+    {
+        deserialize(item.x, in);
+        deserialize(item.y, in);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     class upper_bound_function
@@ -29,6 +29,22 @@ namespace dlib
         double y = std::numeric_limits<double>::quiet_NaN();
     };
 
+    void serialize (
+        const function_evaluation& item,
+        std::ostream& out
+    );
+    /*!
+        provides serialization support
+    !*/
+
+    void deserialize (
+        function_evaluation& item,
+        std::istream& in
+    );
+    /*!
+        provides deserialization support
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     class upper_bound_function
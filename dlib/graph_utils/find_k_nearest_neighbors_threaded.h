@@ -0,0 +1,221 @@
+// Copyright (C) 2013  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_FIND_K_NEAREST_NEIGHBOrS_THREADED_Hh_
+#define DLIB_FIND_K_NEAREST_NEIGHBOrS_THREADED_Hh_
+
+#include "find_k_nearest_neighbors_threaded_abstract.h"
+#include "../threads.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "sample_pair.h"
+#include "ordered_sample_pair.h"
+#include "edge_list_graphs.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        template <
+            typename vector_type,
+            typename distance_function_type
+            >
+        class scan_find_k_nearest_neighbors_tile
+        {
+        public:
+            scan_find_k_nearest_neighbors_tile (
+                const vector_type& samples_,
+                const distance_function_type& dist_funct_,
+                const unsigned long k_,
+                const std::vector<unsigned long>& blocks_,
+                const std::vector<std::pair<unsigned long,unsigned long> >& tiles_,
+                std::vector<ordered_sample_pair>& edges_
+            ) :
+                samples(samples_),
+                dist_funct(dist_funct_),
+                k(k_),
+                blocks(blocks_),
+                tiles(tiles_),
+                edges(edges_)
+            {
+                edges.clear();
+                edges.reserve(samples.size()*k);
+            }
+
+            mutex m;
+            const vector_type& samples;
+            const distance_function_type& dist_funct;
+            const unsigned long k;
+            const std::vector<unsigned long>& blocks;
+            const std::vector<std::pair<unsigned long,unsigned long> >& tiles;
+            std::vector<ordered_sample_pair>& edges;
+
+            void operator() (long t) const
+            {
+                const unsigned long a = tiles[t].first;
+                const unsigned long b = tiles[t].second;
+                const unsigned long a_begin = blocks[a],   a_end = blocks[a+1];
+                const unsigned long b_begin = blocks[b],   b_end = blocks[b+1];
+
+                // Maintain the k best edges seen so far for each row covered by this
+                // tile, using the same k-slot replacement scheme as the serial
+                // find_k_nearest_neighbors().  The rows of block a come first and, if
+                // this isn't a diagonal tile, the rows of block b follow them.
+                const unsigned long num_rows = (a_end-a_begin) + ((a==b) ? 0 : (b_end-b_begin));
+                std::vector<sample_pair> best(num_rows*k,
+                    sample_pair(samples.size(),samples.size(),std::numeric_limits<double>::infinity()));
+                std::vector<double> worst_dists(num_rows, std::numeric_limits<double>::infinity());
+
+                for (unsigned long i = a_begin; i < a_end; ++i)
+                {
+                    const unsigned long slot_i = i - a_begin;
+                    const std::vector<sample_pair>::iterator begin_i = best.begin() + slot_i*k;
+                    const std::vector<sample_pair>::iterator end_i = begin_i + k;
+
+                    for (unsigned long j = ((a==b) ? i+1 : b_begin); j < b_end; ++j)
+                    {
+                        const unsigned long slot_j = (a==b) ? (j - a_begin) : (a_end-a_begin) + (j - b_begin);
+
+                        const double dist = dist_funct(samples[i], samples[j]);
+
+                        if (dist < worst_dists[slot_i])
+                        {
+                            *iterator_of_worst(begin_i, end_i) = sample_pair(i, j, dist);
+                            worst_dists[slot_i] = iterator_of_worst(begin_i, end_i)->distance();
+                        }
+
+                        if (dist < worst_dists[slot_j])
+                        {
+                            const std::vector<sample_pair>::iterator begin_j = best.begin() + slot_j*k;
+                            const std::vector<sample_pair>::iterator end_j = begin_j + k;
+                            *iterator_of_worst(begin_j, end_j) = sample_pair(i, j, dist);
+                            worst_dists[slot_j] = iterator_of_worst(begin_j, end_j)->distance();
+                        }
+                    }
+                }
+
+                // Now dump the surviving candidate edges into the shared output.  We add
+                // each edge in both directions so the merge step can gather all the
+                // candidates for a node in one contiguous range.
+                auto_mutex lock(m);
+                for (unsigned long i = 0; i < best.size(); ++i)
+                {
+                    if (best[i].index1() < samples.size())
+                    {
+                        edges.push_back(ordered_sample_pair(best[i].index1(), best[i].index2(), best[i].distance()));
+                        edges.push_back(ordered_sample_pair(best[i].index2(), best[i].index1(), best[i].distance()));
+                    }
+                }
+            }
+        };
+
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename vector_type,
+        typename distance_function_type,
+        typename alloc
+        >
+    void find_k_nearest_neighbors (
+        const vector_type& samples,
+        const distance_function_type& dist_funct,
+        const unsigned long k,
+        const unsigned long num_threads,
+        std::vector<sample_pair, alloc>& out
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT(k > 0,
+            "\t void find_k_nearest_neighbors()"
+            << "\n\t Invalid inputs were given to this function."
+            << "\n\t samples.size(): " << samples.size()
+            << "\n\t k:              " << k
+            );
+
+        out.clear();
+
+        if (samples.size() <= 1)
+        {
+            return;
+        }
+
+        // Partition the samples into blocks and process one tile of the upper triangle
+        // of the distance matrix per task.  Each pair of samples is therefore visited by
+        // exactly one task, just like the serial algorithm, and using a few more blocks
+        // than threads keeps the pool busy when tiles finish at uneven rates.
+        const unsigned long num_blocks = std::min<unsigned long>(samples.size(),
+                                                                 2*std::max<unsigned long>(num_threads,1));
+        std::vector<unsigned long> blocks(num_blocks+1);
+        for (unsigned long i = 0; i <= num_blocks; ++i)
+            blocks[i] = i*samples.size()/num_blocks;
+
+        std::vector<std::pair<unsigned long,unsigned long> > tiles;
+        tiles.reserve(num_blocks*(num_blocks+1)/2);
+        for (unsigned long a = 0; a < num_blocks; ++a)
+        {
+            for (unsigned long b = a; b < num_blocks; ++b)
+                tiles.push_back(std::make_pair(a,b));
+        }
+
+        std::vector<ordered_sample_pair> edges;
+        typedef impl::scan_find_k_nearest_neighbors_tile<vector_type,distance_function_type> scan_type;
+        scan_type temp(samples, dist_funct, k, blocks, tiles, edges);
+        parallel_for(num_threads, 0, tiles.size(), temp);
+
+        // A node's true k nearest neighbors are each the k best within some tile, so
+        // they all survived the per-tile filter.  All that is left is to merge the
+        // per-tile candidates down to the k best unique edges per node.
+        std::sort(edges.begin(), edges.end(), &order_by_index<ordered_sample_pair>);
+
+        std::vector<sample_pair, alloc> temp_out;
+        temp_out.reserve(samples.size()*k);
+
+        std::vector<ordered_sample_pair>::iterator beg, itr;
+        itr = edges.begin();
+        while (itr != edges.end())
+        {
+            // first find the bounding range for all the edges connected to node itr->index1()
+            beg = itr;
+            while (itr != edges.end() && itr->index1() == beg->index1())
+                ++itr;
+
+            // If the node has more than k edges then sort them by distance so that
+            // we will end up with the k best.
+            if (static_cast<unsigned long>(itr - beg) > k)
+            {
+                std::sort(beg, itr, &order_by_distance_and_index<ordered_sample_pair>);
+            }
+
+            // take the k best unique edges from the range [beg,itr)
+            temp_out.push_back(sample_pair(beg->index1(), beg->index2(), beg->distance()));
+            unsigned long prev_index2 = beg->index2();
+            ++beg;
+            unsigned long count = 1;
+            for (; beg != itr && count < k; ++beg)
+            {
+                if (beg->index2() != prev_index2)
+                {
+                    temp_out.push_back(sample_pair(beg->index1(), beg->index2(), beg->distance()));
+                    ++count;
+                }
+                prev_index2 = beg->index2();
+            }
+        }
+
+        remove_duplicate_edges(temp_out);
+        temp_out.swap(out);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_FIND_K_NEAREST_NEIGHBOrS_THREADED_Hh_
+
+
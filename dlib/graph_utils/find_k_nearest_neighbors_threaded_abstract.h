@@ -0,0 +1,60 @@
+// Copyright (C) 2013  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_FIND_K_NEAREST_NEIGHBOrS_THREADED_ABSTRACT_Hh_
+#ifdef DLIB_FIND_K_NEAREST_NEIGHBOrS_THREADED_ABSTRACT_Hh_
+
+#include "sample_pair_abstract.h"
+#include "edge_list_graphs_abstract.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename vector_type,
+        typename distance_function_type,
+        typename alloc
+        >
+    void find_k_nearest_neighbors (
+        const vector_type& samples,
+        const distance_function_type& dist_funct,
+        const unsigned long k,
+        const unsigned long num_threads,
+        std::vector<sample_pair, alloc>& out
+    );
+    /*!
+        requires
+            - k > 0
+            - dist_funct is threadsafe.  This means that it must be safe for multiple
+              threads to invoke the member functions of dist_funct at the same time.
+            - dist_funct(samples[i], samples[j]) must be a valid expression that
+              evaluates to a floating point number
+            - vector_type is any container that looks like a std::vector or dlib::array.
+        ensures
+            - This function is identical to the version of find_k_nearest_neighbors()
+              defined in dlib/graph_utils/edge_list_graphs_abstract.h except that it
+              uses num_threads concurrent threads of processing.  You should set this
+              value equal to the number of processing cores on your computer for
+              maximum speed.  In particular, the distance matrix is tiled into blocks,
+              each block is scanned by the thread pool while maintaining the k best
+              edges per node seen within that block, and the per-block results are then
+              merged.  Every pair of samples is still considered exactly once, so the
+              output is the exact k nearest neighbors graph, not an approximation.
+            - #out == a set of sample_pair objects that represent all the k nearest
+              neighbors in samples according to the given distance function dist_funct.
+            - Note that samples with an infinite distance between them are considered
+              to be not connected at all.
+            - contains_duplicate_pairs(#out) == false
+            - for all valid i:
+                - #out[i].distance() == dist_funct(samples[#out[i].index1()], samples[#out[i].index2()])
+                - #out[i].distance() < std::numeric_limits<double>::infinity()
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_FIND_K_NEAREST_NEIGHBOrS_THREADED_ABSTRACT_Hh_
+
+
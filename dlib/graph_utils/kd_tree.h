@@ -0,0 +1,368 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_KD_TREe_Hh_
+#define DLIB_KD_TREe_Hh_
+
+#include "kd_tree_abstract.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "../algs.h"
+#include "../serialize.h"
+#include "../threads.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sample_type
+        >
+    class kd_tree
+    {
+        /*!
+            INITIAL VALUE
+                - size() == 0
+                - dims == 0
+                - nodes.size() == 0
+                - pts.size() == 0
+                - original_idx.size() == 0
+
+            CONVENTION
+                - size() == num_points
+                - if (size() != 0) then
+                    - dims == the dimensionality of the samples given to build()
+                    - pts.size() == num_points*dims
+                    - pts holds the samples in a dense row-major layout, reordered so
+                      that the points inside each leaf occupy a contiguous block.
+                    - original_idx[p] == the index, in the sample vector given to
+                      build(), of the point stored at pts[p*dims].
+                    - nodes holds the tree in preorder.  nodes[0] is the root.  For an
+                      internal node n, its left child is n+1 and its right child is
+                      nodes[n].right.  Points in the left subtree have coordinate
+                      nodes[n].split_dim <= nodes[n].split and points in the right
+                      subtree have that coordinate >= nodes[n].split.
+                    - a node n is a leaf if and only if nodes[n].split_dim == dims.  A
+                      leaf directly owns the points pts[p*dims] for all
+                      nodes[n].begin <= p < nodes[n].end.
+        !*/
+
+    public:
+        typedef typename sample_type::type scalar_type;
+
+        kd_tree (
+        ) : dims(0), num_points(0) {}
+
+        void clear (
+        )
+        {
+            nodes.clear();
+            pts.clear();
+            original_idx.clear();
+            dims = 0;
+            num_points = 0;
+        }
+
+        unsigned long size (
+        ) const { return num_points; }
+
+        template <typename vector_of_samples>
+        void build (
+            const vector_of_samples& samples
+        )
+        {
+            clear();
+            if (samples.size() == 0)
+                return;
+
+            dims = samples[0].size();
+#ifdef ENABLE_ASSERTS
+            for (unsigned long i = 0; i < samples.size(); ++i)
+            {
+                DLIB_ASSERT((unsigned long)samples[i].size() == dims,
+                    "\t void kd_tree::build()"
+                    << "\n\t All samples must have the same dimensionality."
+                    << "\n\t dims:              " << dims
+                    << "\n\t samples[i].size(): " << samples[i].size()
+                    << "\n\t i:                 " << i
+                    );
+            }
+#endif
+
+            num_points = samples.size();
+            original_idx.resize(num_points);
+            for (unsigned long i = 0; i < num_points; ++i)
+                original_idx[i] = i;
+
+            nodes.reserve(2*(num_points/leaf_size + 1));
+            build_subtree(samples, 0, num_points);
+
+            // Now that the leaf assignment is known, copy the samples into a flat
+            // array grouped by leaf so leaf scans walk memory sequentially.
+            pts.resize(num_points*dims);
+            for (unsigned long p = 0; p < num_points; ++p)
+            {
+                for (unsigned long d = 0; d < dims; ++d)
+                    pts[p*dims + d] = samples[original_idx[p]](d);
+            }
+        }
+
+        unsigned long nearest_neighbor (
+            const sample_type& query
+        ) const
+        {
+            scalar_type dist_squared;
+            return nearest_neighbor(query, dist_squared);
+        }
+
+        unsigned long nearest_neighbor (
+            const sample_type& query,
+            scalar_type& dist_squared
+        ) const
+        {
+            DLIB_ASSERT(size() != 0 && (unsigned long)query.size() == dims,
+                "\t unsigned long kd_tree::nearest_neighbor()"
+                << "\n\t Invalid inputs were given to this function."
+                << "\n\t size():       " << size()
+                << "\n\t dims:         " << dims
+                << "\n\t query.size(): " << query.size()
+                );
+
+            scalar_type best = std::numeric_limits<scalar_type>::max();
+            unsigned long best_idx = 0;
+
+            // Pending far subtrees along with a lower bound on the distance from the
+            // query to anything inside them.  The tree depth is bounded by the number
+            // of bits in num_points so this stack can't overflow.
+            struct stack_entry { unsigned long n; scalar_type bound; };
+            stack_entry stack[8*sizeof(unsigned long)];
+            unsigned long top = 0;
+
+            unsigned long n = 0;
+            while (true)
+            {
+                // Descend to the leaf containing the query, queuing up the subtrees
+                // on the far side of each split as we go.
+                while (nodes[n].split_dim != dims)
+                {
+                    const scalar_type diff = query(nodes[n].split_dim) - nodes[n].split;
+                    unsigned long near_child = n+1;
+                    unsigned long far_child = nodes[n].right;
+                    if (diff >= 0)
+                        std::swap(near_child, far_child);
+                    // Every point in the far subtree is at least |diff| away from the
+                    // query along the split dimension.
+                    stack[top].n = far_child;
+                    stack[top].bound = diff*diff;
+                    ++top;
+                    n = near_child;
+                }
+
+                // Scan the leaf.  The points are contiguous so this loop vectorizes.
+                const scalar_type* x = &pts[nodes[n].begin*dims];
+                for (unsigned long p = nodes[n].begin; p < nodes[n].end; ++p)
+                {
+                    scalar_type d = 0;
+                    for (unsigned long j = 0; j < dims; ++j)
+                    {
+                        const scalar_type temp = query(j) - x[j];
+                        d += temp*temp;
+                    }
+                    x += dims;
+                    if (d < best)
+                    {
+                        best = d;
+                        best_idx = original_idx[p];
+                    }
+                }
+
+                // Find the next pending subtree that could still hold something
+                // closer than the best point found so far.
+                do
+                {
+                    if (top == 0)
+                    {
+                        dist_squared = best;
+                        return best_idx;
+                    }
+                    --top;
+                } while (stack[top].bound >= best);
+                n = stack[top].n;
+            }
+        }
+
+        template <typename vector_of_samples>
+        void nearest_neighbors (
+            const vector_of_samples& queries,
+            std::vector<unsigned long>& indices
+        ) const
+        {
+            DLIB_ASSERT(size() != 0,
+                "\t void kd_tree::nearest_neighbors()"
+                << "\n\t You can't query an empty tree."
+                );
+
+            indices.resize(queries.size());
+            dlib::parallel_for(0, queries.size(), [&](long i)
+            {
+                indices[i] = nearest_neighbor(queries[i]);
+            });
+        }
+
+        void swap (
+            kd_tree& item
+        )
+        {
+            nodes.swap(item.nodes);
+            pts.swap(item.pts);
+            original_idx.swap(item.original_idx);
+            std::swap(dims, item.dims);
+            std::swap(num_points, item.num_points);
+        }
+
+        friend void serialize (
+            const kd_tree& item,
+            std::ostream& out
+        )
+        {
+            int version = 1;
+            dlib::serialize(version, out);
+            dlib::serialize(item.dims, out);
+            dlib::serialize(item.num_points, out);
+            dlib::serialize(item.pts, out);
+            dlib::serialize(item.original_idx, out);
+            dlib::serialize(item.nodes.size(), out);
+            for (unsigned long i = 0; i < item.nodes.size(); ++i)
+            {
+                dlib::serialize(item.nodes[i].split_dim, out);
+                dlib::serialize(item.nodes[i].split, out);
+                dlib::serialize(item.nodes[i].right, out);
+                dlib::serialize(item.nodes[i].begin, out);
+                dlib::serialize(item.nodes[i].end, out);
+            }
+        }
+
+        friend void deserialize (
+            kd_tree& item,
+            std::istream& in
+        )
+        {
+            int version = 0;
+            dlib::deserialize(version, in);
+            if (version != 1)
+                throw serialization_error("Unexpected version found while deserializing dlib::kd_tree.");
+            dlib::deserialize(item.dims, in);
+            dlib::deserialize(item.num_points, in);
+            dlib::deserialize(item.pts, in);
+            dlib::deserialize(item.original_idx, in);
+            size_t num_nodes = 0;
+            dlib::deserialize(num_nodes, in);
+            item.nodes.resize(num_nodes);
+            for (unsigned long i = 0; i < num_nodes; ++i)
+            {
+                dlib::deserialize(item.nodes[i].split_dim, in);
+                dlib::deserialize(item.nodes[i].split, in);
+                dlib::deserialize(item.nodes[i].right, in);
+                dlib::deserialize(item.nodes[i].begin, in);
+                dlib::deserialize(item.nodes[i].end, in);
+            }
+        }
+
+    private:
+
+        struct node
+        {
+            unsigned long split_dim;
+            scalar_type split;
+            unsigned long right;
+            unsigned long begin;
+            unsigned long end;
+        };
+
+        template <typename vector_of_samples>
+        unsigned long build_subtree (
+            const vector_of_samples& samples,
+            const unsigned long begin,
+            const unsigned long end
+        )
+        /*!
+            requires
+                - begin < end
+            ensures
+                - builds, in preorder, the subtree holding the points
+                  original_idx[begin] through original_idx[end-1], permuting that range
+                  of original_idx so each leaf's points are contiguous.
+                - returns the index of the subtree's root in nodes.
+        !*/
+        {
+            const unsigned long i = nodes.size();
+            nodes.push_back(node());
+            nodes[i].begin = begin;
+            nodes[i].end = end;
+            nodes[i].right = 0;
+            nodes[i].split_dim = dims;
+
+            if (end - begin <= leaf_size)
+                return i;
+
+            // Split on the dimension with the widest spread.
+            unsigned long best_dim = 0;
+            scalar_type best_spread = 0;
+            for (unsigned long d = 0; d < dims; ++d)
+            {
+                scalar_type lower = samples[original_idx[begin]](d);
+                scalar_type upper = lower;
+                for (unsigned long p = begin+1; p < end; ++p)
+                {
+                    const scalar_type val = samples[original_idx[p]](d);
+                    lower = std::min(lower, val);
+                    upper = std::max(upper, val);
+                }
+                if (upper - lower > best_spread)
+                {
+                    best_spread = upper - lower;
+                    best_dim = d;
+                }
+            }
+            // All the points are identical, so there is nothing to split on.
+            if (best_spread == 0)
+                return i;
+
+            const unsigned long mid = begin + (end-begin)/2;
+            std::nth_element(original_idx.begin()+begin,
+                             original_idx.begin()+mid,
+                             original_idx.begin()+end,
+                             [&](unsigned long a, unsigned long b)
+                             { return samples[a](best_dim) < samples[b](best_dim); });
+
+            nodes[i].split_dim = best_dim;
+            nodes[i].split = samples[original_idx[mid]](best_dim);
+            build_subtree(samples, begin, mid);
+            const unsigned long right = build_subtree(samples, mid, end);
+            nodes[i].right = right;
+            return i;
+        }
+
+        const static unsigned long leaf_size = 32;
+
+        std::vector<node> nodes;
+        std::vector<scalar_type> pts;
+        std::vector<unsigned long> original_idx;
+        unsigned long dims;
+        unsigned long num_points;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename sample_type>
+    void swap (
+        kd_tree<sample_type>& a,
+        kd_tree<sample_type>& b
+    ) { a.swap(b); }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_KD_TREe_Hh_
@@ -0,0 +1,180 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_KD_TREe_ABSTRACT_Hh_
+#ifdef DLIB_KD_TREe_ABSTRACT_Hh_
+
+#include <vector>
+#include "../matrix.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sample_type
+        >
+    class kd_tree
+    {
+        /*!
+            REQUIREMENTS ON sample_type
+                Must be a dlib::matrix capable of representing column vectors with a
+                float or double element type.
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a static kd-tree over a set of column vectors.  It
+                supports exact nearest neighbor queries in Euclidean distance.  Once
+                built, the tree is immutable; to index a different point set call
+                build() again.
+
+                Unlike the approximate LSH based tools in
+                find_k_nearest_neighbors_lsh.h, queries against this object always
+                return the true nearest neighbor.  The tree stores its nodes in a
+                contiguous array and groups each leaf's points into a dense block of
+                memory, so the brute force scan at the leaves runs over sequential
+                memory and typically vectorizes.  For a few thousand points of modest
+                dimensionality (e.g. assigning samples to the centers produced by
+                kkmeans) a query inspects only a small fraction of the point set
+                rather than scanning all of it.
+
+                Note that kd-trees lose their advantage over a linear scan as the
+                dimensionality grows.  Beyond a few tens of dimensions you should
+                expect queries to visit most of the tree.
+
+            THREAD SAFETY
+                It is safe for multiple threads to make concurrent calls to the const
+                query functions of this object.  However, build(), clear(), and swap()
+                must not run concurrently with any other member function.
+        !*/
+
+    public:
+        typedef typename sample_type::type scalar_type;
+
+        kd_tree (
+        );
+        /*!
+            ensures
+                - #size() == 0
+        !*/
+
+        void clear (
+        );
+        /*!
+            ensures
+                - #size() == 0
+                - returns all memory held by this object to the system
+        !*/
+
+        unsigned long size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of points indexed by this tree
+        !*/
+
+        template <typename vector_of_samples>
+        void build (
+            const vector_of_samples& samples
+        );
+        /*!
+            requires
+                - vector_of_samples == a type with an interface compatible with
+                  std::vector that contains sample_type objects.
+                - all the vectors in samples have the same dimensionality
+            ensures
+                - #size() == samples.size()
+                - Builds a kd-tree over the given points.  Queries made against this
+                  object return indices into samples.
+                - This function copies the points, so samples does not need to outlive
+                  this object.
+        !*/
+
+        unsigned long nearest_neighbor (
+            const sample_type& query
+        ) const;
+        /*!
+            requires
+                - size() != 0
+                - query.size() == the dimensionality of the points given to build()
+            ensures
+                - returns the index of the point nearest to query, in Euclidean
+                  distance, among the samples given to build().  Ties are broken
+                  arbitrarily.
+        !*/
+
+        unsigned long nearest_neighbor (
+            const sample_type& query,
+            scalar_type& dist_squared
+        ) const;
+        /*!
+            requires
+                - size() != 0
+                - query.size() == the dimensionality of the points given to build()
+            ensures
+                - returns nearest_neighbor(query)
+                - #dist_squared == the squared Euclidean distance between query and
+                  the returned point.
+        !*/
+
+        template <typename vector_of_samples>
+        void nearest_neighbors (
+            const vector_of_samples& queries,
+            std::vector<unsigned long>& indices
+        ) const;
+        /*!
+            requires
+                - size() != 0
+                - vector_of_samples == a type with an interface compatible with
+                  std::vector that contains sample_type objects.
+                - all the vectors in queries have the same dimensionality as the
+                  points given to build()
+            ensures
+                - #indices.size() == queries.size()
+                - #indices[i] == nearest_neighbor(queries[i])
+                - The queries are processed in parallel using the
+                  default_thread_pool() when more than one CPU core is available.
+        !*/
+
+        void swap (
+            kd_tree& item
+        );
+        /*!
+            ensures
+                - swaps *this and item
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename sample_type>
+    void swap (
+        kd_tree<sample_type>& a,
+        kd_tree<sample_type>& b
+    ) { a.swap(b); }
+    /*!
+        provides a global swap function
+    !*/
+
+    template <typename sample_type>
+    void serialize (
+        const kd_tree<sample_type>& item,
+        std::ostream& out
+    );
+    /*!
+        provides serialization support
+    !*/
+
+    template <typename sample_type>
+    void deserialize (
+        kd_tree<sample_type>& item,
+        std::istream& in
+    );
+    /*!
+        provides deserialization support
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_KD_TREe_ABSTRACT_Hh_
@@ -5,6 +5,8 @@
 
 #include "graph_utils.h"
 #include "graph_utils/find_k_nearest_neighbors_lsh.h"
+#include "graph_utils/find_k_nearest_neighbors_threaded.h"
+#include "graph_utils/kd_tree.h"
 
 #endif // DLIB_GRAPH_UTILs_THREADED_H_ 
 
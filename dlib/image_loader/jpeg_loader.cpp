@@ -17,6 +17,7 @@
 #   include <jpeglib.h>
 #endif
 #include <sstream>
+#include <cstring>
 #include <setjmp.h>
 
 namespace dlib
@@ -27,7 +28,7 @@ namespace dlib
     jpeg_loader::
     jpeg_loader( const char* filename ) : height_( 0 ), width_( 0 ), output_components_(0)
     {
-        read_image( check_file( filename ), NULL, 0L );
+        read_image( check_file( filename ), NULL, 0L, entire_image() );
     }
 
 // ----------------------------------------------------------------------------------------
@@ -35,7 +36,7 @@ namespace dlib
     jpeg_loader::
     jpeg_loader( const std::string& filename ) : height_( 0 ), width_( 0 ), output_components_(0)
     {
-        read_image( check_file( filename.c_str() ), NULL, 0L );
+        read_image( check_file( filename.c_str() ), NULL, 0L, entire_image() );
     }
 
 // ----------------------------------------------------------------------------------------
@@ -43,15 +44,47 @@ namespace dlib
     jpeg_loader::
     jpeg_loader( const dlib::file& f ) : height_( 0 ), width_( 0 ), output_components_(0)
     {
-        read_image( check_file( f.full_name().c_str() ), NULL, 0L );
+        read_image( check_file( f.full_name().c_str() ), NULL, 0L, entire_image() );
     }
 
 // ----------------------------------------------------------------------------------------
-    
+
     jpeg_loader::
     jpeg_loader( unsigned char* imgbuffer, size_t imgbuffersize ) : height_( 0 ), width_( 0 ), output_components_(0)
     {
-        read_image( NULL, imgbuffer, imgbuffersize );
+        read_image( NULL, imgbuffer, imgbuffersize, entire_image() );
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    jpeg_loader::
+    jpeg_loader( const char* filename, const rectangle& roi ) : height_( 0 ), width_( 0 ), output_components_(0)
+    {
+        read_image( check_file( filename ), NULL, 0L, roi );
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    jpeg_loader::
+    jpeg_loader( const std::string& filename, const rectangle& roi ) : height_( 0 ), width_( 0 ), output_components_(0)
+    {
+        read_image( check_file( filename.c_str() ), NULL, 0L, roi );
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    jpeg_loader::
+    jpeg_loader( const dlib::file& f, const rectangle& roi ) : height_( 0 ), width_( 0 ), output_components_(0)
+    {
+        read_image( check_file( f.full_name().c_str() ), NULL, 0L, roi );
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    jpeg_loader::
+    jpeg_loader( unsigned char* imgbuffer, size_t imgbuffersize, const rectangle& roi ) : height_( 0 ), width_( 0 ), output_components_(0)
+    {
+        read_image( NULL, imgbuffer, imgbuffersize, roi );
     }
 
 // ----------------------------------------------------------------------------------------
@@ -113,7 +146,7 @@ namespace dlib
 
 // ----------------------------------------------------------------------------------------
 
-    void jpeg_loader::read_image( FILE * file, unsigned char* imgbuffer, size_t imgbuffersize )
+    void jpeg_loader::read_image( FILE * file, unsigned char* imgbuffer, size_t imgbuffersize, const rectangle& roi )
     {
         
         jpeg_decompress_struct cinfo;
@@ -145,11 +178,9 @@ namespace dlib
 
         jpeg_start_decompress(&cinfo);
 
-        height_ = cinfo.output_height;
-        width_ = cinfo.output_width;
         output_components_ = cinfo.output_components;
 
-        if (output_components_ != 1 && 
+        if (output_components_ != 1 &&
             output_components_ != 3 &&
             output_components_ != 4)
         {
@@ -160,23 +191,88 @@ namespace dlib
             throw image_load_error(sout.str());
         }
 
-        std::vector<unsigned char*> rows;
-        rows.resize(height_);
+        const rectangle img_area(0, 0, cinfo.output_width-1, cinfo.output_height-1);
+        const rectangle area = img_area.intersect(roi);
+        if (area.is_empty())
+        {
+            if (file != NULL) fclose(file);
+            jpeg_destroy_decompress(&cinfo);
+            throw image_load_error("jpeg_loader: region of interest doesn't intersect the image");
+        }
+
+        height_ = area.height();
+        width_ = area.width();
+
+        if (area == img_area)
+        {
+            // decoding the whole image, so read the scanlines straight into the image
+            // buffer.
+            std::vector<unsigned char*> rows;
+            rows.resize(height_);
 
-        // size the image buffer
-        data.resize(height_*width_*output_components_);
+            // size the image buffer
+            data.resize(height_*width_*output_components_);
 
-        // setup pointers to each row
-        for (unsigned long i = 0; i < rows.size(); ++i)
-            rows[i] = &data[i*width_*output_components_];
+            // setup pointers to each row
+            for (unsigned long i = 0; i < rows.size(); ++i)
+                rows[i] = &data[i*width_*output_components_];
 
-        // read the data into the buffer
-        while (cinfo.output_scanline < cinfo.output_height)
+            // read the data into the buffer
+            while (cinfo.output_scanline < cinfo.output_height)
+            {
+                jpeg_read_scanlines(&cinfo, &rows[cinfo.output_scanline], 100);
+            }
+
+            jpeg_finish_decompress(&cinfo);
+        }
+        else
         {
-            jpeg_read_scanlines(&cinfo, &rows[cinfo.output_scanline], 100);
+            // Decoding just a region of the image.  The number of bytes into a decoded
+            // scanline where the region begins.
+            unsigned long row_offset = area.left()*output_components_;
+
+#if defined(LIBJPEG_TURBO_VERSION_NUMBER) && LIBJPEG_TURBO_VERSION_NUMBER >= 1005000
+            // libjpeg-turbo can avoid decoding the DCT blocks outside the columns we
+            // want and can skip over the rows above the region without running the
+            // IDCT on them.  jpeg_crop_scanline() may widen the cropped region to an
+            // iMCU boundary, so recompute where our columns begin within the decoded
+            // scanlines.
+            if (area.left() != img_area.left() || area.right() != img_area.right())
+            {
+                JDIMENSION xoff = area.left();
+                JDIMENSION xwidth = area.width();
+                jpeg_crop_scanline(&cinfo, &xoff, &xwidth);
+                row_offset = (area.left()-xoff)*output_components_;
+            }
+            if (area.top() != 0)
+                jpeg_skip_scanlines(&cinfo, area.top());
+#endif
+
+            std::vector<unsigned char> scratch(cinfo.output_width*output_components_);
+            unsigned char* srow = &scratch[0];
+
+            // Decode and discard any rows above the region that couldn't be skipped
+            // outright.
+            while (cinfo.output_scanline < (JDIMENSION)area.top())
+                jpeg_read_scanlines(&cinfo, &srow, 1);
+
+            // size the image buffer
+            data.resize(height_*width_*output_components_);
+
+            // now read the rows we are keeping, copying out just the columns we want.
+            for (unsigned long r = 0; r < height_; ++r)
+            {
+                jpeg_read_scanlines(&cinfo, &srow, 1);
+                std::memcpy(&data[r*width_*output_components_], srow+row_offset, width_*output_components_);
+            }
+
+            // Everything below the region is never decoded at all.
+            if (cinfo.output_scanline < cinfo.output_height)
+                jpeg_abort_decompress(&cinfo);
+            else
+                jpeg_finish_decompress(&cinfo);
         }
 
-        jpeg_finish_decompress(&cinfo);
         jpeg_destroy_decompress(&cinfo);
 
         if (file != NULL) fclose(file);
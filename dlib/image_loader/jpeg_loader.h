@@ -4,11 +4,13 @@
 #define DLIB_JPEG_IMPORT
 
 #include <vector>
+#include <limits>
 
 #include "jpeg_loader_abstract.h"
 #include "image_loader.h"
 #include "../pixel.h"
 #include "../dir_nav.h"
+#include "../geometry/rectangle.h"
 #include "../test_for_odr_violations.h"
 
 namespace dlib
@@ -23,6 +25,11 @@ namespace dlib
         jpeg_loader( const dlib::file& f );
         jpeg_loader( unsigned char* imgbuffer, size_t buffersize );
 
+        jpeg_loader( const char* filename, const rectangle& roi );
+        jpeg_loader( const std::string& filename, const rectangle& roi );
+        jpeg_loader( const dlib::file& f, const rectangle& roi );
+        jpeg_loader( unsigned char* imgbuffer, size_t buffersize, const rectangle& roi );
+
         bool is_gray() const;
         bool is_rgb() const;
         bool is_rgba() const;
@@ -78,7 +85,8 @@ namespace dlib
         }
         
         FILE * check_file(const char* filename );
-        void read_image( FILE *file, unsigned char* imgbuffer, size_t imgbuffersize );
+        void read_image( FILE *file, unsigned char* imgbuffer, size_t imgbuffersize, const rectangle& roi );
+        static rectangle entire_image() { return rectangle(0, 0, std::numeric_limits<long>::max(), std::numeric_limits<long>::max()); }
         unsigned long height_; 
         unsigned long width_;
         unsigned long output_components_;
@@ -109,6 +117,30 @@ namespace dlib
         jpeg_loader(imgbuff, imgbuffsize).get_image(image);
     }
 
+    template <
+        typename image_type
+        >
+    void load_jpeg (
+        image_type& image,
+        const std::string& file_name,
+        const rectangle& roi
+    )
+    {
+        jpeg_loader(file_name, roi).get_image(image);
+    }
+    template <
+        typename image_type
+        >
+    void load_jpeg (
+        image_type& image,
+        unsigned char* imgbuff,
+        size_t imgbuffsize,
+        const rectangle& roi
+    )
+    {
+        jpeg_loader(imgbuff, imgbuffsize, roi).get_image(image);
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -65,7 +65,7 @@ namespace dlib
                   us from loading the given JPEG file.
         !*/
 
-        jpeg_loader( 
+        jpeg_loader(
             unsigned char* imgbuffer,
             size_t buffersize
         );
@@ -78,6 +78,53 @@ namespace dlib
                   us from loading the given JPEG buffer.
         !*/
 
+        jpeg_loader(
+            const char* filename,
+            const rectangle& roi
+        );
+        jpeg_loader(
+            const std::string& filename,
+            const rectangle& roi
+        );
+        jpeg_loader(
+            const dlib::file& f,
+            const rectangle& roi
+        );
+        /*!
+            ensures
+                - loads just the part of the JPEG file with the given file name that
+                  falls inside roi into this object.  That is, this object will contain
+                  the sub-image with upper left corner (roi.left(),roi.top()), clipped
+                  so it fits inside the image.  Decoding only a region is cheaper than
+                  decoding the whole image and then cropping since the pixels below the
+                  region are never decoded at all and, when dlib is linked against
+                  libjpeg-turbo, neither are the pixels above it or in the columns
+                  outside it.
+            throws
+                - std::bad_alloc
+                - image_load_error
+                  This exception is thrown if there is some error that prevents
+                  us from loading the given JPEG file, or if roi doesn't intersect
+                  the image.
+        !*/
+
+        jpeg_loader(
+            unsigned char* imgbuffer,
+            size_t buffersize,
+            const rectangle& roi
+        );
+        /*!
+            ensures
+                - loads just the part of the JPEG in memory imgbuffer of size buffersize
+                  that falls inside roi into this object, exactly like the file based
+                  region of interest constructors above.
+            throws
+                - image_load_error
+                  This exception is thrown if there is some error that prevents
+                  us from loading the given JPEG buffer, or if roi doesn't intersect
+                  the image.
+        !*/
+
         ~jpeg_loader(
         );
         /*!
@@ -149,11 +196,44 @@ namespace dlib
     /*!
         requires
             - image_type == an image object that implements the interface defined in
-              dlib/image_processing/generic_image.h 
+              dlib/image_processing/generic_image.h
         ensures
             - performs: jpeg_loader(imgbuff, imgbuffsize).get_image(image);
     !*/
 
+    template <
+        typename image_type
+        >
+    void load_jpeg (
+        image_type& image,
+        const std::string& file_name,
+        const rectangle& roi
+    );
+    /*!
+        requires
+            - image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+        ensures
+            - performs: jpeg_loader(file_name, roi).get_image(image);
+    !*/
+
+    template <
+        typename image_type
+        >
+    void load_jpeg (
+        image_type& image,
+        unsigned char* imgbuff,
+        size_t imgbuffsize,
+        const rectangle& roi
+    );
+    /*!
+        requires
+            - image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+        ensures
+            - performs: jpeg_loader(imgbuff, imgbuffsize, roi).get_image(image);
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -5,6 +5,8 @@
 
 #include "load_image_abstract.h"
 #include "../string.h"
+#include "../geometry/rectangle.h"
+#include "../image_processing/generic_image.h"
 #include "png_loader.h"
 #include "jpeg_loader.h"
 #include "image_loader.h"
@@ -218,6 +220,46 @@ namespace dlib
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <typename image_type>
+    void load_image (
+        image_type& image,
+        const std::string& file_name,
+        const rectangle& roi
+    )
+    {
+        const image_file_type::type im_type = image_file_type::read_type(file_name);
+
+#ifdef DLIB_JPEG_SUPPORT
+        if (im_type == image_file_type::JPG)
+        {
+            // JPEG files support decoding just the region of interest, so we never
+            // have to pay for decoding the pixels outside it.
+            load_jpeg(image, file_name, roi);
+            return;
+        }
+#endif
+
+        // The other formats don't have a native way to decode just part of the image,
+        // so decode the whole thing and keep only the part the caller asked for.
+        image_type temp;
+        load_image(temp, file_name);
+
+        const rectangle area = get_rect(temp).intersect(roi);
+        if (area.is_empty())
+            throw image_load_error("load_image: region of interest doesn't intersect the image in file " + file_name);
+
+        const_image_view<image_type> src(temp);
+        image_view<image_type> dst(image);
+        dst.set_size(area.height(), area.width());
+        for (long r = 0; r < dst.nr(); ++r)
+        {
+            for (long c = 0; c < dst.nc(); ++c)
+                dst[r][c] = src[r+area.top()][c+area.left()];
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
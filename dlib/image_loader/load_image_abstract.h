@@ -30,6 +30,31 @@ namespace dlib
                 us from loading the given image file.
     !*/
 
+    template <typename image_type>
+    void load_image (
+        image_type& image,
+        const std::string& file_name,
+        const rectangle& roi
+    );
+    /*!
+        requires
+            - image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+        ensures
+            - This function loads just the part of the image in file_name that falls
+              inside roi into image.  That is, #image will contain the sub-image with
+              upper left corner (roi.left(),roi.top()), clipped so it fits inside the
+              image in the file.  The result is identical to loading the whole image
+              and then cropping out roi.
+            - For JPEG files the region is decoded natively, so you only pay for
+              decoding the pixels you keep.  For the other supported formats the whole
+              image is decoded and then cropped.
+        throws
+            - image_load_error
+                This exception is thrown if there is some error that prevents us from
+                loading the given image file, or if roi doesn't intersect the image.
+    !*/
+
 }
 
 #endif // DLIB_LOAd_IMAGE_ABSTRACT_ 
@@ -21,7 +21,9 @@
 #include "image_processing/scan_fhog_pyramid.h"
 #include "image_processing/shape_predictor.h"
 #include "image_processing/shape_predictor_trainer.h"
+#include "image_processing/mapped_shape_predictor.h"
 #include "image_processing/correlation_tracker.h"
+#include "image_processing/raw_image_view.h"
 
 #endif // DLIB_IMAGE_PROCESSInG_H_h_
 
@@ -5,6 +5,9 @@
 
 #include "box_overlap_testing_abstract.h"
 #include "../geometry.h"
+#include "../uintn.h"
+#include <algorithm>
+#include <unordered_map>
 #include <vector>
 
 namespace dlib
@@ -29,11 +32,23 @@ namespace dlib
     inline double box_intersection_over_union (
         const rectangle& a,
         const rectangle& b
-    ) 
+    )
     {
         return box_intersection_over_union(drectangle(a),drectangle(b));
     }
 
+// ----------------------------------------------------------------------------------------
+
+    inline matrix<float> box_intersection_over_union (
+        const std::vector<rectangle>& a,
+        const std::vector<rectangle>& b
+    )
+    {
+        // Evaluating all the pairs through the SIMD batch kernel is much faster than
+        // calling the scalar version in a double loop.
+        return intersection_over_union_matrix(rectangle_batch(a), rectangle_batch(b));
+    }
+
 // ----------------------------------------------------------------------------------------
 
     inline double box_percent_covered (
@@ -140,6 +155,170 @@ namespace dlib
         item = test_box_overlap(iou_thresh, percent_covered_thresh);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    class box_overlap_index
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object is a tool for quickly testing a query rectangle against a
+                growing set of rectangles with a test_box_overlap predicate.  It is
+                meant to replace linear scans over the accepted boxes in non-max
+                suppression loops, making suppression over dense detection grids run in
+                near linear time.
+
+                It works by recording each added rectangle in the cells of a uniform
+                grid it covers.  Since test_box_overlap() can only be true for boxes
+                that intersect, a query only has to test the boxes sharing grid cells
+                with it rather than the whole set.  Boxes much bigger than the grid
+                cells are kept in a short side list that is always checked, so a few
+                huge boxes can't blow up the number of cell entries.
+        !*/
+    public:
+
+        box_overlap_index (
+        ) = default;
+
+        explicit box_overlap_index (
+            const test_box_overlap& tester_
+        ) : tester(tester_) {}
+
+        void clear (
+        )
+        {
+            boxes.clear();
+            big_boxes.clear();
+            cells.clear();
+            last_seen.clear();
+            query_count = 0;
+            cell_size = 0;
+        }
+
+        const test_box_overlap& get_overlap_tester (
+        ) const { return tester; }
+
+        size_t size (
+        ) const { return boxes.size(); }
+
+        void add (
+            const rectangle& rect
+        )
+        {
+            const unsigned long idx = boxes.size();
+            boxes.push_back(rect);
+            last_seen.push_back(0);
+
+            if (cell_size == 0)
+            {
+                // Size the grid cells like the first box we see.  Boxes fed to the
+                // same suppression loop tend to have similar scales, so most boxes
+                // will land in only a handful of cells.
+                cell_size = std::max<long>(1, (rect.width() + rect.height())/2);
+            }
+
+            long l, t, r, b;
+            cell_bounds(rect, l, t, r, b);
+            // Boxes much bigger than the grid cells would have to be recorded in a
+            // huge number of cells, so keep them in a side list we always check.
+            if (r-l >= 8 || b-t >= 8)
+            {
+                big_boxes.push_back(idx);
+                return;
+            }
+
+            for (long y = t; y <= b; ++y)
+            {
+                for (long x = l; x <= r; ++x)
+                    cells[cell_key(x,y)].push_back(idx);
+            }
+        }
+
+        bool overlaps_any (
+            const rectangle& rect
+        ) const
+        {
+            if (boxes.size() == 0)
+                return false;
+
+            for (auto idx : big_boxes)
+            {
+                if (tester(boxes[idx], rect))
+                    return true;
+            }
+
+            if (++query_count == 0)
+            {
+                // the query counter wrapped around, so reset the markers
+                std::fill(last_seen.begin(), last_seen.end(), 0);
+                query_count = 1;
+            }
+
+            long l, t, r, b;
+            cell_bounds(rect, l, t, r, b);
+            for (long y = t; y <= b; ++y)
+            {
+                for (long x = l; x <= r; ++x)
+                {
+                    const auto i = cells.find(cell_key(x,y));
+                    if (i == cells.end())
+                        continue;
+
+                    for (auto idx : i->second)
+                    {
+                        // don't test a box against the same query more than once
+                        if (last_seen[idx] == query_count)
+                            continue;
+                        last_seen[idx] = query_count;
+
+                        if (tester(boxes[idx], rect))
+                            return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+    private:
+
+        static uint64 cell_key (
+            long x,
+            long y
+        )
+        {
+            return (static_cast<uint64>(static_cast<uint32>(x))<<32) | static_cast<uint32>(y);
+        }
+
+        long grid_coord (
+            long x
+        ) const
+        {
+            // floor division so negative coordinates map to their own cells
+            return (x >= 0) ? x/cell_size : (x - cell_size + 1)/cell_size;
+        }
+
+        void cell_bounds (
+            const rectangle& rect,
+            long& l,
+            long& t,
+            long& r,
+            long& b
+        ) const
+        {
+            l = grid_coord(rect.left());
+            t = grid_coord(rect.top());
+            r = grid_coord(rect.right());
+            b = grid_coord(rect.bottom());
+        }
+
+        test_box_overlap tester;
+        long cell_size = 0;
+        std::vector<rectangle> boxes;
+        std::vector<unsigned long> big_boxes;
+        std::unordered_map<uint64, std::vector<unsigned long> > cells;
+        mutable std::vector<unsigned long> last_seen;
+        mutable unsigned long query_count = 0;
+    };
+
 // ----------------------------------------------------------------------------------------
 
     inline test_box_overlap find_tight_overlap_tester (
@@ -32,6 +32,26 @@ namespace dlib
               boxes are empty then returns 0.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    inline matrix<float> box_intersection_over_union (
+        const std::vector<rectangle>& a,
+        const std::vector<rectangle>& b
+    );
+    /*!
+        requires
+            - all the coordinates in a and b fit in a 32bit integer.
+        ensures
+            - returns a matrix M such that:
+                - M.nr() == a.size()
+                - M.nc() == b.size()
+                - for all valid (r,c):
+                    - M(r,c) == box_intersection_over_union(a[r], b[c])
+              This does the same thing as calling the scalar version on every pair of
+              boxes, except that the pairs are evaluated 8 at a time with SIMD
+              instructions.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     inline double box_percent_covered (
@@ -150,6 +170,86 @@ namespace dlib
         provides deserialization support
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    class box_overlap_index
+    {
+        /*!
+            INITIAL VALUE
+                - size() == 0
+                - get_overlap_tester() == test_box_overlap()
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a tool for quickly testing a query rectangle against a
+                growing set of rectangles with a test_box_overlap predicate.  It gives
+                the same answers as scanning the whole set with overlaps_any_box() but
+                does it by indexing the added rectangles in a uniform spatial grid, so
+                only the rectangles near the query are actually tested.  This makes the
+                non-max suppression loops in tools like object_detector and loss_mmod
+                run in near linear time even when there are very many candidate boxes.
+        !*/
+
+    public:
+
+        box_overlap_index (
+        );
+        /*!
+            ensures
+                - #get_overlap_tester() == test_box_overlap()
+        !*/
+
+        explicit box_overlap_index (
+            const test_box_overlap& tester
+        );
+        /*!
+            ensures
+                - #get_overlap_tester() == tester
+        !*/
+
+        void clear (
+        );
+        /*!
+            ensures
+                - #size() == 0
+                - #get_overlap_tester() == get_overlap_tester()
+                  (i.e. clear() removes the indexed rectangles but keeps the tester)
+        !*/
+
+        const test_box_overlap& get_overlap_tester (
+        ) const;
+        /*!
+            ensures
+                - returns the overlap tester used by overlaps_any().
+        !*/
+
+        size_t size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of rectangles that have been add()ed.
+        !*/
+
+        void add (
+            const rectangle& rect
+        );
+        /*!
+            ensures
+                - #size() == size() + 1
+                - rect is added to the set of indexed rectangles.
+        !*/
+
+        bool overlaps_any (
+            const rectangle& rect
+        ) const;
+        /*!
+            ensures
+                - if (there is an add()ed rectangle R such that get_overlap_tester()(R,rect) == true) then
+                    - returns true
+                - else
+                    - returns false
+        !*/
+    };
+
 // ----------------------------------------------------------------------------------------
 
     test_box_overlap find_tight_overlap_tester (
@@ -64,7 +64,7 @@ namespace dlib
 
             point_transform_affine tform = inv(make_chip(img, p, F));
             for (unsigned long i = 0; i < F.size(); ++i)
-                fft_inplace(F[i]);
+                plan.fft_inplace(F[i]);
             make_target_location_image(tform(center(p)), G);
             A.resize(F.size());
             for (unsigned long i = 0; i < F.size(); ++i)
@@ -78,7 +78,7 @@ namespace dlib
             // now do the scale space stuff
             make_scale_space(img, Fs);
             for (unsigned long i = 0; i < Fs.size(); ++i)
-                fft_inplace(Fs[i]);
+                plan.fft_inplace(Fs[i]);
             make_scale_target_location_image(get_num_scale_levels()/2, Gs);
             Bs.set_size(0);
             As.resize(Fs.size());
@@ -133,14 +133,14 @@ namespace dlib
 
             const point_transform_affine tform = make_chip(img, guess, F);
             for (unsigned long i = 0; i < F.size(); ++i)
-                fft_inplace(F[i]);
+                plan.fft_inplace(F[i]);
 
             // use the current filter to predict the object's location
             G = 0;
             for (unsigned long i = 0; i < F.size(); ++i)
                 G += pointwise_multiply(F[i],conj(A[i]));
             G = pointwise_multiply(G, reciprocal(B+get_regularizer_space()));
-            ifft_inplace(G);
+            plan.ifft_inplace(G);
             const dlib::vector<double,2> pp = max_point_interpolated(real(G));
 
 
@@ -184,12 +184,12 @@ namespace dlib
             // Now predict the scale change
             make_scale_space(img, Fs);
             for (unsigned long i = 0; i < Fs.size(); ++i)
-                fft_inplace(Fs[i]);
+                plan.fft_inplace(Fs[i]);
             Gs = 0;
             for (unsigned long i = 0; i < Fs.size(); ++i)
                 Gs += pointwise_multiply(Fs[i],conj(As[i]));
             Gs = pointwise_multiply(Gs, reciprocal(Bs+get_regularizer_scale()));
-            ifft_inplace(Gs);
+            plan.ifft_inplace(Gs);
             const double pos = max_point_interpolated(real(Gs)).y();
 
             // update the rectangle's scale
@@ -236,37 +236,52 @@ namespace dlib
         {
             typedef typename image_traits<image_type>::pixel_type pixel_type;
 
-            // Make an image pyramid and put it into the chips array.
             const long chip_size = get_scale_window_size();
             drectangle ppp = position*std::pow(get_scale_pyramid_alpha(), -(double)get_num_scale_levels()/2);
-            dlib::array<array2d<pixel_type> > chips;
+
+            // All the scale levels are concentric, so rather than resampling the
+            // source image once per level we pull the largest level's region out of
+            // the source in a single pass and then sample every level from that base
+            // chip.  The base is oversampled 2x so that the second round of bilinear
+            // interpolation loses almost nothing, and even the smallest level still
+            // has well over chip_size pixels across the region it covers.
+            const double total_ratio = std::pow(get_scale_pyramid_alpha(), (double)get_num_scale_levels()-1);
+            const drectangle biggest = ppp*total_ratio;
+            const long base_size = (long)std::ceil(2*chip_size*total_ratio);
+
+            array2d<pixel_type> base(base_size, base_size), chip(chip_size, chip_size);
             std::vector<dlib::vector<double,2> > from_points, to_points;
             from_points.push_back(point(0,0));
+            from_points.push_back(point(base_size-1,0));
+            from_points.push_back(point(base_size-1,base_size-1));
+            to_points.push_back(biggest.tl_corner());
+            to_points.push_back(biggest.tr_corner());
+            to_points.push_back(biggest.br_corner());
+            const point_transform_affine base_to_img = find_affine_transform(from_points, to_points);
+            transform_image(img, base, interpolate_bilinear(), base_to_img);
+            const point_transform_affine img_to_base = inv(base_to_img);
+
+            from_points.clear();
+            from_points.push_back(point(0,0));
             from_points.push_back(point(chip_size-1,0));
             from_points.push_back(point(chip_size-1,chip_size-1));
+
+            // Extract HOG for each scale level.  The hog buffers stick around
+            // between frames so they are only ever allocated once.
+            hogs.resize(get_num_scale_levels());
             for (unsigned long i = 0; i < get_num_scale_levels(); ++i)
             {
-                array2d<pixel_type> chip(chip_size,chip_size);
-
-                // pull box into chip
+                // pull this level's region out of the base chip
                 to_points.clear();
-                to_points.push_back(ppp.tl_corner());
-                to_points.push_back(ppp.tr_corner());
-                to_points.push_back(ppp.br_corner());
-                transform_image(img,chip,interpolate_bilinear(),find_affine_transform(from_points, to_points));
-
-                chips.push_back(chip);
+                to_points.push_back(img_to_base(ppp.tl_corner()));
+                to_points.push_back(img_to_base(ppp.tr_corner()));
+                to_points.push_back(img_to_base(ppp.br_corner()));
+                transform_image(base,chip,interpolate_bilinear(),find_affine_transform(from_points, to_points));
                 ppp *= get_scale_pyramid_alpha();
-            }
 
-
-            // extract HOG for each chip
-            dlib::array<dlib::array<array2d<float> > > hogs(chips.size());
-            for (unsigned long i = 0; i < chips.size(); ++i)
-            {
-                extract_fhog_features(chips[i], hogs[i], 4);
+                extract_fhog_features(chip, hogs[i], 4);
                 hogs[i].resize(32);
-                assign_image(hogs[i][31], chips[i]);
+                assign_image(hogs[i][31], chip);
                 assign_image(hogs[i][31], mat(hogs[i][31])/255.0);
             }
 
@@ -333,7 +348,7 @@ namespace dlib
                     g(r,c) = std::exp(-dist/3.0);
                 }
             }
-            fft_inplace(g);
+            plan.fft_inplace(g);
             g = conj(g);
         }
 
@@ -349,7 +364,7 @@ namespace dlib
                 double dist = std::pow((i-scale),2.0);
                 g(i) = std::exp(-dist/1.000);
             }
-            fft_inplace(g);
+            plan.fft_inplace(g);
             g = conj(g);
         }
 
@@ -384,10 +399,16 @@ namespace dlib
         matrix<double> mask;
         std::vector<double> scale_cos_mask;
 
-        // G and Gs do not logically contribute to the state of this object.  They are
-        // here just so we can void reallocating them over and over.
+        // G, Gs, hogs, and plan do not logically contribute to the state of this
+        // object.  They are here just so we can avoid reallocating them over and
+        // over.  In particular, plan caches the FFT twiddle factors and scratch
+        // buffer across frames rather than recomputing them inside every transform,
+        // and hogs holds the per-scale HOG feature buffers reused by
+        // make_scale_space() on every frame.
         matrix<std::complex<double> > G;
         matrix<std::complex<double>,0,1> Gs;
+        mutable dlib::array<dlib::array<array2d<float> > > hogs;
+        mutable fft_plan<double> plan;
 
         unsigned long filter_size;
         unsigned long num_scale_levels;
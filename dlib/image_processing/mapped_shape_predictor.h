@@ -0,0 +1,340 @@
+// Copyright (C) 2014  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_MAPPED_SHAPE_PREDICToR_H_
+#define DLIB_MAPPED_SHAPE_PREDICToR_H_
+
+#include "mapped_shape_predictor_abstract.h"
+#include "shape_predictor.h"
+#include "../uintn.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        // The on-disk record for one split node.  The whole model file is a flat dump
+        // of these records and float arrays so a read-only mapping of the file can be
+        // used directly, without any per-node parsing or allocation.
+        struct mapped_split_feature
+        {
+            uint32 idx1;
+            uint32 idx2;
+            float thresh;
+        };
+
+        const char mapped_shape_predictor_magic[8] = {'S','P','M','M','A','P','0','1'};
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline void save_mapped_shape_predictor (
+        const shape_predictor& sp,
+        const std::string& filename
+    )
+    {
+        using namespace impl;
+        std::ofstream out(filename.c_str(), std::ios::binary);
+        if (!out)
+            throw serialization_error("Unable to open " + filename + " for writing.");
+
+        auto write_u32 = [&](uint32 val) { out.write((const char*)&val, sizeof(val)); };
+
+        out.write(mapped_shape_predictor_magic, sizeof(mapped_shape_predictor_magic));
+
+        const matrix<float,0,1>& initial_shape = sp.get_initial_shape();
+        const std::vector<std::vector<impl::regression_tree> >& forests = sp.get_forests();
+        const std::vector<std::vector<unsigned long> >& anchor_idx = sp.get_anchor_idx();
+        const std::vector<std::vector<dlib::vector<float,2> > >& deltas = sp.get_deltas();
+
+        write_u32(static_cast<uint32>(initial_shape.size()));
+        out.write((const char*)&initial_shape(0), sizeof(float)*initial_shape.size());
+
+        write_u32(static_cast<uint32>(forests.size()));
+        for (unsigned long iter = 0; iter < forests.size(); ++iter)
+        {
+            write_u32(static_cast<uint32>(anchor_idx[iter].size()));
+            for (unsigned long i = 0; i < anchor_idx[iter].size(); ++i)
+                write_u32(static_cast<uint32>(anchor_idx[iter][i]));
+            for (unsigned long i = 0; i < deltas[iter].size(); ++i)
+            {
+                const float vals[2] = {deltas[iter][i].x(), deltas[iter][i].y()};
+                out.write((const char*)vals, sizeof(vals));
+            }
+
+            write_u32(static_cast<uint32>(forests[iter].size()));
+            for (unsigned long i = 0; i < forests[iter].size(); ++i)
+            {
+                const impl::regression_tree& tree = forests[iter][i];
+                write_u32(static_cast<uint32>(tree.splits.size()));
+                for (unsigned long j = 0; j < tree.splits.size(); ++j)
+                {
+                    mapped_split_feature s;
+                    s.idx1 = static_cast<uint32>(tree.splits[j].idx1);
+                    s.idx2 = static_cast<uint32>(tree.splits[j].idx2);
+                    s.thresh = tree.splits[j].thresh;
+                    out.write((const char*)&s, sizeof(s));
+                }
+                for (unsigned long j = 0; j < tree.leaf_values.size(); ++j)
+                    out.write((const char*)&tree.leaf_values[j](0), sizeof(float)*tree.leaf_values[j].size());
+            }
+        }
+
+        if (!out)
+            throw serialization_error("Error while writing mapped shape_predictor model to " + filename);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class mapped_shape_predictor : noncopyable
+    {
+        /*!
+            CONVENTION
+                - if (data != 0) then a model file is loaded and:
+                    - data points at the start of the file contents.  When the platform
+                      supports it this is a read-only memory mapping of the file, so the
+                      pages holding the trees are shared between all processes that map
+                      the same model and are only faulted in as they are touched.
+                    - the trees vector holds pointers into data, one element per tree.
+                - forests, anchor_idx, deltas, and initial_shape mirror the layout used
+                  by shape_predictor except that the tree nodes and leaf values live in
+                  the mapping rather than on the heap.
+        !*/
+    public:
+
+        mapped_shape_predictor (
+        ) : data(0), data_size(0), mapped(false) {}
+
+        explicit mapped_shape_predictor (
+            const std::string& filename
+        ) : data(0), data_size(0), mapped(false)
+        {
+            load(filename);
+        }
+
+        ~mapped_shape_predictor (
+        )
+        {
+            unload();
+        }
+
+        void load (
+            const std::string& filename
+        )
+        {
+            using namespace impl;
+            unload();
+            map_file(filename);
+
+            try
+            {
+                const char* p = data;
+                const char* const end = data + data_size;
+
+                if (data_size < sizeof(mapped_shape_predictor_magic) ||
+                    std::memcmp(p, mapped_shape_predictor_magic, sizeof(mapped_shape_predictor_magic)) != 0)
+                    throw serialization_error("The file " + filename + " is not a dlib mapped shape_predictor model.");
+                p += sizeof(mapped_shape_predictor_magic);
+
+                const uint32 shape_size = read_u32(p,end);
+                initial_shape.set_size(shape_size);
+                std::memcpy(&initial_shape(0), need(p,end,sizeof(float)*shape_size), sizeof(float)*shape_size);
+
+                const uint32 num_cascades = read_u32(p,end);
+                anchor_idx.resize(num_cascades);
+                deltas.resize(num_cascades);
+                forests.resize(num_cascades);
+                for (uint32 iter = 0; iter < num_cascades; ++iter)
+                {
+                    const uint32 num_pixels = read_u32(p,end);
+                    anchor_idx[iter].resize(num_pixels);
+                    deltas[iter].resize(num_pixels);
+                    for (uint32 i = 0; i < num_pixels; ++i)
+                        anchor_idx[iter][i] = read_u32(p,end);
+                    for (uint32 i = 0; i < num_pixels; ++i)
+                    {
+                        float vals[2];
+                        std::memcpy(vals, need(p,end,sizeof(vals)), sizeof(vals));
+                        deltas[iter][i] = dlib::vector<float,2>(vals[0], vals[1]);
+                    }
+
+                    const uint32 num_trees = read_u32(p,end);
+                    forests[iter].resize(num_trees);
+                    for (uint32 i = 0; i < num_trees; ++i)
+                    {
+                        tree_view& tree = forests[iter][i];
+                        tree.num_splits = read_u32(p,end);
+                        tree.splits = (const mapped_split_feature*)need(p,end,sizeof(mapped_split_feature)*tree.num_splits);
+                        tree.leaf_values = (const float*)need(p,end,sizeof(float)*(tree.num_splits+1)*shape_size);
+                    }
+                }
+            }
+            catch (...)
+            {
+                unload();
+                throw;
+            }
+        }
+
+        unsigned long num_parts (
+        ) const
+        {
+            return initial_shape.size()/2;
+        }
+
+        bool is_loaded (
+        ) const { return data != 0; }
+
+        template <typename image_type>
+        full_object_detection operator()(
+            const image_type& img,
+            const rectangle& rect
+        ) const
+        {
+            using namespace impl;
+            matrix<float,0,1> current_shape = initial_shape;
+            matrix<float,0,1> leaf;
+            std::vector<float> feature_pixel_values;
+            for (unsigned long iter = 0; iter < forests.size(); ++iter)
+            {
+                extract_feature_pixel_values(img, rect, current_shape, initial_shape,
+                                             anchor_idx[iter], deltas[iter], feature_pixel_values);
+                // evaluate all the trees at this level of the cascade.
+                for (unsigned long i = 0; i < forests[iter].size(); ++i)
+                {
+                    const tree_view& tree = forests[iter][i];
+                    unsigned long idx = 0;
+                    while (idx < tree.num_splits)
+                    {
+                        const mapped_split_feature& s = tree.splits[idx];
+                        if (feature_pixel_values[s.idx1] - feature_pixel_values[s.idx2] > s.thresh)
+                            idx = left_child(idx);
+                        else
+                            idx = right_child(idx);
+                    }
+                    idx -= tree.num_splits;
+                    const float* leaf_vals = tree.leaf_values + idx*current_shape.size();
+                    for (long j = 0; j < current_shape.size(); ++j)
+                        current_shape(j) += leaf_vals[j];
+                }
+            }
+
+            // convert the current_shape into a full_object_detection
+            const point_transform_affine tform_to_img = unnormalizing_tform(rect);
+            std::vector<point> parts(current_shape.size()/2);
+            for (unsigned long i = 0; i < parts.size(); ++i)
+                parts[i] = tform_to_img(location(current_shape, i));
+            return full_object_detection(rect, parts);
+        }
+
+    private:
+
+        struct tree_view
+        {
+            const impl::mapped_split_feature* splits;
+            const float* leaf_values;
+            uint32 num_splits;
+        };
+
+        static uint32 read_u32 (const char*& p, const char* end)
+        {
+            uint32 val;
+            std::memcpy(&val, need(p,end,sizeof(val)), sizeof(val));
+            return val;
+        }
+
+        static const char* need (const char*& p, const char* end, size_t num)
+        {
+            if (num > static_cast<size_t>(end-p))
+                throw serialization_error("Unexpected end of file while loading mapped shape_predictor model.");
+            const char* temp = p;
+            p += num;
+            return temp;
+        }
+
+        void map_file (
+            const std::string& filename
+        )
+        {
+#ifndef _WIN32
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd != -1)
+            {
+                struct stat st;
+                if (::fstat(fd, &st) == 0 && st.st_size > 0)
+                {
+                    void* ptr = ::mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+                    if (ptr != MAP_FAILED)
+                    {
+                        ::close(fd);
+                        data = (const char*)ptr;
+                        data_size = st.st_size;
+                        mapped = true;
+                        return;
+                    }
+                }
+                ::close(fd);
+            }
+#endif
+            // No mmap support (or the mapping failed), fall back to reading the whole
+            // file into a private buffer.  Loading is still one bulk read but the
+            // pages are no longer shared between processes.
+            std::ifstream in(filename.c_str(), std::ios::binary);
+            if (!in)
+                throw serialization_error("Unable to open " + filename);
+            in.seekg(0, std::ios::end);
+            buffer.resize(static_cast<size_t>(in.tellg()));
+            in.seekg(0);
+            in.read(&buffer[0], buffer.size());
+            if (!in)
+                throw serialization_error("Error while reading " + filename);
+            data = &buffer[0];
+            data_size = buffer.size();
+            mapped = false;
+        }
+
+        void unload (
+        )
+        {
+#ifndef _WIN32
+            if (mapped && data != 0)
+                ::munmap((void*)data, data_size);
+#endif
+            data = 0;
+            data_size = 0;
+            mapped = false;
+            buffer.clear();
+            buffer.shrink_to_fit();
+            forests.clear();
+            anchor_idx.clear();
+            deltas.clear();
+            initial_shape.set_size(0);
+        }
+
+        const char* data;
+        size_t data_size;
+        bool mapped;
+        std::vector<char> buffer;
+
+        matrix<float,0,1> initial_shape;
+        std::vector<std::vector<tree_view> > forests;
+        std::vector<std::vector<unsigned long> > anchor_idx;
+        std::vector<std::vector<dlib::vector<float,2> > > deltas;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_MAPPED_SHAPE_PREDICToR_H_
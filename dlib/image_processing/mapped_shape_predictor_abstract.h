@@ -0,0 +1,118 @@
+// Copyright (C) 2014  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_MAPPED_SHAPE_PREDICToR_ABSTRACT_H_
+#ifdef DLIB_MAPPED_SHAPE_PREDICToR_ABSTRACT_H_
+
+#include "shape_predictor_abstract.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    void save_mapped_shape_predictor (
+        const shape_predictor& sp,
+        const std::string& filename
+    );
+    /*!
+        ensures
+            - Writes sp to the file with the given name using the flat mapped model
+              format understood by mapped_shape_predictor.  Unlike the normal
+              serialization format, this format stores the regression trees as raw
+              arrays so a loader can point directly at the bytes of the file instead
+              of parsing and heap-allocating each tree node.
+            - The file is written using the native byte order and so should be read
+              back on a machine with the same byte order.
+        throws
+            - serialization_error if there is a problem writing to the file.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    class mapped_shape_predictor : noncopyable
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object is a drop-in replacement for shape_predictor's detection
+                interface that reads its model from a file written by
+                save_mapped_shape_predictor().  Rather than deserializing every tree
+                into heap-allocated objects, it memory maps the file read-only and
+                evaluates the trees directly out of the mapping.  This makes loading a
+                large model nearly instantaneous (just the cost of faulting in pages
+                as they are used) and allows many processes to share a single
+                physical copy of the model.
+
+                On platforms without mmap() the file is read into a private buffer in
+                one bulk read, which is still much faster than regular
+                deserialization but does not share pages between processes.
+        !*/
+
+    public:
+
+        mapped_shape_predictor (
+        );
+        /*!
+            ensures
+                - #is_loaded() == false
+        !*/
+
+        explicit mapped_shape_predictor (
+            const std::string& filename
+        );
+        /*!
+            ensures
+                - performs load(filename)
+        !*/
+
+        void load (
+            const std::string& filename
+        );
+        /*!
+            ensures
+                - Maps the model in the file with the given name into this object.
+                  The file must have been created by save_mapped_shape_predictor().
+                - #is_loaded() == true
+            throws
+                - serialization_error if the file can't be opened or doesn't contain
+                  a valid mapped shape_predictor model.  In this case #is_loaded()
+                  == false.
+        !*/
+
+        bool is_loaded (
+        ) const;
+        /*!
+            ensures
+                - returns true if this object contains a model and can be used to
+                  predict shapes.
+        !*/
+
+        unsigned long num_parts (
+        ) const;
+        /*!
+            ensures
+                - returns the number of parts in the shapes predicted by this object.
+        !*/
+
+        template <typename image_type>
+        full_object_detection operator()(
+            const image_type& img,
+            const rectangle& rect
+        ) const;
+        /*!
+            requires
+                - is_loaded() == true
+                - image_type == an image object that implements the interface defined
+                  in dlib/image_processing/generic_image.h
+            ensures
+                - Runs the shape prediction algorithm on the part of the image
+                  contained in the given bounding rectangle and returns the same
+                  result shape_predictor::operator() would return for the model the
+                  file was created from.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_MAPPED_SHAPE_PREDICToR_ABSTRACT_H_
@@ -8,6 +8,8 @@
 #include <vector>
 #include "box_overlap_testing.h"
 #include "full_object_detection.h"
+#include "../small_vector.h"
+#include "../threads/parallel_for_extension.h"
 
 namespace dlib
 {
@@ -177,6 +179,97 @@ namespace dlib
             double adjust_threshold = 0
         );
 
+        template <
+            typename image_array_type
+            >
+        std::vector<std::vector<rect_detection> > batch_detect (
+            const image_array_type& imgs,
+            double adjust_threshold = 0
+        ) const;
+
+        class detection_context
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This object holds the mutable scratch state (i.e. the scanner and
+                    its loaded feature pyramid) needed to run a detection pass.  The
+                    immutable model, that is, the weight vectors and preprocessed
+                    filter banks, stays inside the object_detector and is shared
+                    read-only by every context.  So to run one detector on N threads
+                    you give each thread its own detection_context rather than a deep
+                    copy of the whole detector.
+            !*/
+        public:
+            explicit detection_context (
+                const object_detector& detector
+            )
+            {
+                scanner.copy_configuration(detector.scanner);
+            }
+        private:
+            friend class object_detector;
+            image_scanner_type scanner;
+        };
+
+        template <
+            typename image_type
+            >
+        std::vector<rectangle> detect (
+            detection_context& ctx,
+            const image_type& img,
+            double adjust_threshold = 0
+        ) const;
+
+        template <
+            typename image_type
+            >
+        void detect (
+            detection_context& ctx,
+            const image_type& img,
+            std::vector<rect_detection>& final_dets,
+            double adjust_threshold = 0
+        ) const;
+
+        template <
+            typename image_type
+            >
+        void detect (
+            detection_context& ctx,
+            const image_type& img,
+            std::vector<std::pair<double, rectangle> >& final_dets,
+            double adjust_threshold = 0
+        ) const;
+
+        template <
+            typename image_type
+            >
+        void detect (
+            detection_context& ctx,
+            const image_type& img,
+            std::vector<full_detection>& final_dets,
+            double adjust_threshold = 0
+        ) const;
+
+        template <
+            typename image_type
+            >
+        void load (
+            detection_context& ctx,
+            const image_type& img
+        ) const;
+
+        void detect (
+            detection_context& ctx,
+            std::vector<rect_detection>& final_dets,
+            double adjust_threshold = 0
+        ) const;
+
+        void detect (
+            detection_context& ctx,
+            std::vector<std::pair<double, rectangle> >& final_dets,
+            double adjust_threshold = 0
+        ) const;
+
         template <typename T>
         friend void serialize (
             const object_detector<T>& item,
@@ -191,18 +284,21 @@ namespace dlib
 
     private:
 
-        bool overlaps_any_box (
-            const std::vector<rect_detection>& rects,
-            const dlib::rectangle& rect
-        ) const
-        {
-            for (unsigned long i = 0; i < rects.size(); ++i)
-            {
-                if (boxes_overlap(rects[i].rect, rect))
-                    return true;
-            }
-            return false;
-        }
+        template <
+            typename image_type
+            >
+        void detect_impl (
+            image_scanner_type& scanner_,
+            const image_type& img,
+            std::vector<rect_detection>& final_dets,
+            double adjust_threshold
+        ) const;
+
+        void detect_on_loaded_scanner (
+            image_scanner_type& scanner_,
+            std::vector<rect_detection>& final_dets,
+            double adjust_threshold
+        ) const;
 
         test_box_overlap boxes_overlap;
         std::vector<processed_weight_vector<image_scanner_type> > w;
@@ -424,19 +520,37 @@ namespace dlib
         typename image_type
         >
     void object_detector<image_scanner_type>::
-    operator() (
+    detect_impl (
+        image_scanner_type& scanner_,
         const image_type& img,
         std::vector<rect_detection>& final_dets,
         double adjust_threshold
-    ) 
+    ) const
+    {
+        scanner_.load(img);
+        detect_on_loaded_scanner(scanner_, final_dets, adjust_threshold);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type
+        >
+    void object_detector<image_scanner_type>::
+    detect_on_loaded_scanner (
+        image_scanner_type& scanner_,
+        std::vector<rect_detection>& final_dets,
+        double adjust_threshold
+    ) const
     {
-        scanner.load(img);
         std::vector<std::pair<double, rectangle> > dets;
-        std::vector<rect_detection> dets_accum;
+        // Typical frames produce a few detections at most, so inline storage keeps
+        // this temporary off the heap.
+        small_vector<rect_detection,32> dets_accum;
         for (unsigned long i = 0; i < w.size(); ++i)
         {
-            const double thresh = w[i].w(scanner.get_num_dimensions());
-            scanner.detect(w[i].get_detect_argument(), dets, thresh + adjust_threshold);
+            const double thresh = w[i].w(scanner_.get_num_dimensions());
+            scanner_.detect(w[i].get_detect_argument(), dets, thresh + adjust_threshold);
             for (unsigned long j = 0; j < dets.size(); ++j)
             {
                 rect_detection temp;
@@ -451,15 +565,212 @@ namespace dlib
         final_dets.clear();
         if (w.size() > 1)
             std::sort(dets_accum.rbegin(), dets_accum.rend());
+        box_overlap_index suppressed(boxes_overlap);
         for (unsigned long i = 0; i < dets_accum.size(); ++i)
         {
-            if (overlaps_any_box(final_dets, dets_accum[i].rect))
+            if (suppressed.overlaps_any(dets_accum[i].rect))
                 continue;
 
+            suppressed.add(dets_accum[i].rect);
             final_dets.push_back(dets_accum[i]);
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type
+        >
+    template <
+        typename image_type
+        >
+    void object_detector<image_scanner_type>::
+    operator() (
+        const image_type& img,
+        std::vector<rect_detection>& final_dets,
+        double adjust_threshold
+    )
+    {
+        detect_impl(scanner, img, final_dets, adjust_threshold);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type
+        >
+    template <
+        typename image_array_type
+        >
+    std::vector<std::vector<rect_detection> > object_detector<image_scanner_type>::
+    batch_detect (
+        const image_array_type& imgs,
+        double adjust_threshold
+    ) const
+    {
+        std::vector<std::vector<rect_detection> > results(imgs.size());
+        // Each image is independent, so scan them in parallel.  Every task gets its
+        // own scanner (copy_configuration() copies only the scanner's settings, not
+        // any loaded image data) while the weight vectors in w are shared read-only.
+        parallel_for(0, imgs.size(), [&](long i)
+        {
+            image_scanner_type local_scanner;
+            local_scanner.copy_configuration(scanner);
+            detect_impl(local_scanner, imgs[i], results[i], adjust_threshold);
+        });
+        return results;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type
+        >
+    template <
+        typename image_type
+        >
+    void object_detector<image_scanner_type>::
+    detect (
+        detection_context& ctx,
+        const image_type& img,
+        std::vector<rect_detection>& final_dets,
+        double adjust_threshold
+    ) const
+    {
+        detect_impl(ctx.scanner, img, final_dets, adjust_threshold);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type
+        >
+    template <
+        typename image_type
+        >
+    std::vector<rectangle> object_detector<image_scanner_type>::
+    detect (
+        detection_context& ctx,
+        const image_type& img,
+        double adjust_threshold
+    ) const
+    {
+        std::vector<rect_detection> dets;
+        detect_impl(ctx.scanner, img, dets, adjust_threshold);
+
+        std::vector<rectangle> final_dets(dets.size());
+        for (unsigned long i = 0; i < dets.size(); ++i)
+            final_dets[i] = dets[i].rect;
+
+        return final_dets;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type
+        >
+    template <
+        typename image_type
+        >
+    void object_detector<image_scanner_type>::
+    detect (
+        detection_context& ctx,
+        const image_type& img,
+        std::vector<std::pair<double, rectangle> >& final_dets,
+        double adjust_threshold
+    ) const
+    {
+        std::vector<rect_detection> dets;
+        detect_impl(ctx.scanner, img, dets, adjust_threshold);
+
+        final_dets.resize(dets.size());
+        for (unsigned long i = 0; i < dets.size(); ++i)
+            final_dets[i] = std::make_pair(dets[i].detection_confidence,dets[i].rect);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type
+        >
+    template <
+        typename image_type
+        >
+    void object_detector<image_scanner_type>::
+    load (
+        detection_context& ctx,
+        const image_type& img
+    ) const
+    {
+        ctx.scanner.load(img);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type
+        >
+    void object_detector<image_scanner_type>::
+    detect (
+        detection_context& ctx,
+        std::vector<rect_detection>& final_dets,
+        double adjust_threshold
+    ) const
+    {
+        detect_on_loaded_scanner(ctx.scanner, final_dets, adjust_threshold);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type
+        >
+    void object_detector<image_scanner_type>::
+    detect (
+        detection_context& ctx,
+        std::vector<std::pair<double, rectangle> >& final_dets,
+        double adjust_threshold
+    ) const
+    {
+        std::vector<rect_detection> dets;
+        detect_on_loaded_scanner(ctx.scanner, dets, adjust_threshold);
+
+        final_dets.resize(dets.size());
+        for (unsigned long i = 0; i < dets.size(); ++i)
+            final_dets[i] = std::make_pair(dets[i].detection_confidence,dets[i].rect);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type
+        >
+    template <
+        typename image_type
+        >
+    void object_detector<image_scanner_type>::
+    detect (
+        detection_context& ctx,
+        const image_type& img,
+        std::vector<full_detection>& final_dets,
+        double adjust_threshold
+    ) const
+    {
+        std::vector<rect_detection> dets;
+        detect_impl(ctx.scanner, img, dets, adjust_threshold);
+
+        final_dets.resize(dets.size());
+
+        // convert all the rectangle detections into full_object_detections.
+        for (unsigned long i = 0; i < dets.size(); ++i)
+        {
+            final_dets[i].detection_confidence = dets[i].detection_confidence;
+            final_dets[i].weight_index = dets[i].weight_index;
+            final_dets[i].rect = ctx.scanner.get_full_object_detection(dets[i].rect, w[dets[i].weight_index].w);
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -291,7 +291,201 @@ namespace dlib
             ensures
                 - This function is identical to the above operator() routine, except that
                   it returns a std::vector<rectangle> which contains just the bounding
-                  boxes of all the detections. 
+                  boxes of all the detections.
+        !*/
+
+        template <
+            typename image_array_type
+            >
+        std::vector<std::vector<rect_detection> > batch_detect (
+            const image_array_type& imgs,
+            double adjust_threshold = 0
+        ) const;
+        /*!
+            requires
+                - imgs is an array of images (e.g. a dlib::array or std::vector of
+                  images) where each element can be accepted by
+                  image_scanner_type::load()
+            ensures
+                - Performs object detection on every image in imgs and returns the
+                  results.  In particular, we return an array R such that:
+                    - R.size() == imgs.size()
+                    - R[i] == the detections obtained by running the rect_detection
+                      version of operator() on imgs[i].  The same adjust_threshold
+                      semantics apply.
+                - The images are processed in parallel using the default dlib thread
+                  pool, so independent images (e.g. frames from different cameras) can
+                  be scanned concurrently by a single detector object.  The weight
+                  vectors in this object are shared by all the parallel scans rather
+                  than copied, only the scanner configuration is duplicated per task.
+                - Unlike operator(), this function does not modify #get_scanner().  So
+                  you can't use get_scanner().get_feature_vector() afterwards.  Since
+                  this function is const it is safe to call it from multiple threads
+                  simultaneously.
+        !*/
+
+        class detection_context
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This object holds the mutable scratch state needed to run a
+                    detection pass, that is, a scanner and the feature pyramid it
+                    loads from each image.  The immutable model (the weight vectors
+                    and any preprocessed filter banks) stays inside the
+                    object_detector and is shared read-only by every context.
+                    Therefore, to run one detector on N threads you give each thread
+                    its own detection_context instead of a deep copy of the whole
+                    detector, which avoids duplicating the model N times.
+            !*/
+        public:
+            explicit detection_context (
+                const object_detector& detector
+            );
+            /*!
+                ensures
+                    - #*this is a context usable with the detect() routines of the
+                      given detector.  The context contains a scanner initialized via
+                      copy_configuration() from detector.get_scanner(), so only the
+                      scanner's settings are copied, not the detector's weight
+                      vectors or filter banks.
+            !*/
+        };
+
+        template <
+            typename image_type
+            >
+        std::vector<rectangle> detect (
+            detection_context& ctx,
+            const image_type& img,
+            double adjust_threshold = 0
+        ) const;
+        /*!
+            requires
+                - img == an object which can be accepted by image_scanner_type::load()
+                - ctx was constructed from a detector with the same scanner
+                  configuration as this one.
+            ensures
+                - performs exactly the same detection as the operator() routine with
+                  the same arguments, except that all mutable state is kept in ctx and
+                  this detector is only read from.  Since this function is const it is
+                  safe for many threads to share one detector so long as each thread
+                  uses its own detection_context.
+                - Unlike operator(), this function does not modify #get_scanner().
+        !*/
+
+        template <
+            typename image_type
+            >
+        void detect (
+            detection_context& ctx,
+            const image_type& img,
+            std::vector<rect_detection>& dets,
+            double adjust_threshold = 0
+        ) const;
+        /*!
+            requires
+                - img == an object which can be accepted by image_scanner_type::load()
+                - ctx was constructed from a detector with the same scanner
+                  configuration as this one.
+            ensures
+                - This function is identical to the std::vector<rect_detection>
+                  version of operator() except that all mutable state is kept in ctx,
+                  making it safe to call concurrently from many threads as long as
+                  each thread uses its own detection_context.
+        !*/
+
+        template <
+            typename image_type
+            >
+        void detect (
+            detection_context& ctx,
+            const image_type& img,
+            std::vector<std::pair<double, rectangle> >& dets,
+            double adjust_threshold = 0
+        ) const;
+        /*!
+            requires
+                - img == an object which can be accepted by image_scanner_type::load()
+                - ctx was constructed from a detector with the same scanner
+                  configuration as this one.
+            ensures
+                - This function is identical to the std::vector<std::pair<double,
+                  rectangle> > version of operator() except that all mutable state is
+                  kept in ctx, making it safe to call concurrently from many threads
+                  as long as each thread uses its own detection_context.
+        !*/
+
+        template <
+            typename image_type
+            >
+        void detect (
+            detection_context& ctx,
+            const image_type& img,
+            std::vector<full_detection>& dets,
+            double adjust_threshold = 0
+        ) const;
+        /*!
+            requires
+                - img == an object which can be accepted by image_scanner_type::load()
+                - ctx was constructed from a detector with the same scanner
+                  configuration as this one.
+            ensures
+                - This function is identical to the std::vector<full_detection>
+                  version of operator() except that all mutable state is kept in ctx,
+                  making it safe to call concurrently from many threads as long as
+                  each thread uses its own detection_context.
+        !*/
+
+        template <
+            typename image_type
+            >
+        void load (
+            detection_context& ctx,
+            const image_type& img
+        ) const;
+        /*!
+            requires
+                - img == an object which can be accepted by image_scanner_type::load()
+                - ctx was constructed from a detector with the same scanner
+                  configuration as this one.
+            ensures
+                - loads img into ctx's scanner, computing the feature pyramid that the
+                  detect() routines below score against.  The loaded features depend
+                  only on the scanner configuration and img, not on this detector's
+                  weight vectors.  So a context loaded once can be scored by any
+                  number of detectors sharing the same scanner configuration, which is
+                  much faster than having each detector recompute the features.
+        !*/
+
+        void detect (
+            detection_context& ctx,
+            std::vector<rect_detection>& dets,
+            double adjust_threshold = 0
+        ) const;
+        /*!
+            requires
+                - load(ctx, img) has been called for some image img.
+            ensures
+                - This function is identical to the std::vector<rect_detection>
+                  version of detect() taking an image, except that it scores the
+                  features already loaded into ctx rather than recomputing them.  In
+                  particular, detect(ctx, img, dets, t) is equivalent to load(ctx,
+                  img) followed by detect(ctx, dets, t).
+        !*/
+
+        void detect (
+            detection_context& ctx,
+            std::vector<std::pair<double, rectangle> >& dets,
+            double adjust_threshold = 0
+        ) const;
+        /*!
+            requires
+                - load(ctx, img) has been called for some image img.
+            ensures
+                - This function is identical to the std::vector<std::pair<double,
+                  rectangle> > version of detect() taking an image, except that it
+                  scores the features already loaded into ctx rather than recomputing
+                  them.
         !*/
 
         template <
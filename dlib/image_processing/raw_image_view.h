@@ -0,0 +1,190 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_RAW_IMAGE_VIEw_H_
+#define DLIB_RAW_IMAGE_VIEw_H_
+
+#include "raw_image_view_abstract.h"
+#include "../algs.h"
+#include "../pixel.h"
+#include "../matrix/matrix_mat.h"
+#include "generic_image.h"
+
+namespace dlib
+{
+
+    template <
+        typename pixel_type
+        >
+    class raw_image_view
+    {
+    public:
+        typedef pixel_type type;
+        typedef default_memory_manager mem_manager_type;
+
+        raw_image_view() : _data(0), _widthStep(0), _nr(0), _nc(0) {}
+
+        raw_image_view (
+            void* data,
+            long nr,
+            long nc,
+            long width_step
+        ) :
+            _data(static_cast<char*>(data)),
+            _widthStep(width_step),
+            _nr(nr),
+            _nc(nc)
+        {
+            DLIB_ASSERT(nr >= 0 && nc >= 0 && (nr == 0 || nc == 0 || data != 0),
+                "\traw_image_view::raw_image_view(data,nr,nc,width_step)"
+                << "\n\t Invalid inputs were given to this function."
+                << "\n\t nr:   " << nr
+                << "\n\t nc:   " << nc
+                << "\n\t data: " << data
+                );
+            DLIB_ASSERT(width_step >= static_cast<long>(nc*sizeof(pixel_type)),
+                "\traw_image_view::raw_image_view(data,nr,nc,width_step)"
+                << "\n\t The row stride can't be smaller than a row of pixels."
+                << "\n\t width_step:            " << width_step
+                << "\n\t nc*sizeof(pixel_type): " << nc*sizeof(pixel_type)
+                );
+        }
+
+        raw_image_view (
+            void* data,
+            long nr,
+            long nc
+        ) : raw_image_view(data, nr, nc, static_cast<long>(nc*sizeof(pixel_type)))
+        {}
+
+        size_t size () const { return static_cast<size_t>(_nr*_nc); }
+
+        inline pixel_type* operator[](const long row )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(0 <= row && row < nr(),
+                "\tpixel_type* raw_image_view::operator[](row)"
+                << "\n\t you have asked for an out of bounds row "
+                << "\n\t row:  " << row
+                << "\n\t nr(): " << nr()
+                << "\n\t this:  " << this
+                );
+
+            return reinterpret_cast<pixel_type*>( _data + _widthStep*row);
+        }
+
+        inline const pixel_type* operator[](const long row ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(0 <= row && row < nr(),
+                "\tconst pixel_type* raw_image_view::operator[](row)"
+                << "\n\t you have asked for an out of bounds row "
+                << "\n\t row:  " << row
+                << "\n\t nr(): " << nr()
+                << "\n\t this:  " << this
+                );
+
+            return reinterpret_cast<const pixel_type*>( _data + _widthStep*row);
+        }
+
+        inline const pixel_type& operator()(const long row, const long column) const
+        {
+            DLIB_ASSERT(0 <= column && column < nc(),
+                "\tconst pixel_type& raw_image_view::operator()(row,column)"
+                << "\n\t you have asked for an out of bounds column "
+                << "\n\t column: " << column
+                << "\n\t nc(): " << nc()
+                << "\n\t this:  " << this
+                );
+
+            return (*this)[row][column];
+        }
+
+        inline pixel_type& operator()(const long row, const long column)
+        {
+            DLIB_ASSERT(0 <= column && column < nc(),
+                "\tpixel_type& raw_image_view::operator()(row,column)"
+                << "\n\t you have asked for an out of bounds column "
+                << "\n\t column: " << column
+                << "\n\t nc(): " << nc()
+                << "\n\t this:  " << this
+                );
+
+            return (*this)[row][column];
+        }
+
+        long nr() const { return _nr; }
+        long nc() const { return _nc; }
+        long width_step() const { return _widthStep; }
+
+    private:
+
+        char* _data;
+        long _widthStep;
+        long _nr;
+        long _nc;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    const matrix_op<op_array2d_to_mat<raw_image_view<T> > > mat (
+        const raw_image_view<T>& m
+    )
+    {
+        typedef op_array2d_to_mat<raw_image_view<T> > op;
+        return matrix_op<op>(op(m));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+// Define the global functions that make raw_image_view a proper "generic image" according
+// to generic_image.h
+    template <typename T>
+    struct image_traits<raw_image_view<T> >
+    {
+        typedef T pixel_type;
+    };
+
+    template <typename T>
+    inline long num_rows( const raw_image_view<T>& img) { return img.nr(); }
+    template <typename T>
+    inline long num_columns( const raw_image_view<T>& img) { return img.nc(); }
+
+    template <typename T>
+    inline void* image_data(
+        raw_image_view<T>& img
+    )
+    {
+        if (img.size() != 0)
+            return &img[0][0];
+        else
+            return 0;
+    }
+
+    template <typename T>
+    inline const void* image_data(
+        const raw_image_view<T>& img
+    )
+    {
+        if (img.size() != 0)
+            return &img[0][0];
+        else
+            return 0;
+    }
+
+    template <typename T>
+    inline long width_step(
+        const raw_image_view<T>& img
+    )
+    {
+        return img.width_step();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_RAW_IMAGE_VIEw_H_
+
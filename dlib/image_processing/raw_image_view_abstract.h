@@ -0,0 +1,191 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_RAW_IMAGE_VIEw_ABSTRACT_H_
+#ifdef DLIB_RAW_IMAGE_VIEw_ABSTRACT_H_
+
+#include "../algs.h"
+#include "../pixel.h"
+
+namespace dlib
+{
+
+    template <
+        typename pixel_type
+        >
+    class raw_image_view
+    {
+        /*!
+            REQUIREMENTS ON pixel_type
+                pixel_type just needs to be something that matches the pixel memory
+                layout of the buffer you are going to wrap.  For example, you might
+                use unsigned char, bgr_pixel, or rgb_pixel depending on what your
+                capture device produces.
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a simple zero-copy wrapper that turns a raw pointer to
+                interleaved pixel data, such as a BGR frame handed out by a V4L2 or
+                GStreamer capture pipeline, into something that implements dlib's
+                generic image interface (see generic_image.h).  That means you can
+                feed the wrapped buffer directly to routines like assign_image(),
+                resize_image(), or extract_fhog_features() without first copying it
+                into an array2d or matrix.
+
+                The wrapped buffer may have a row stride larger than
+                nc()*sizeof(pixel_type), which is common for camera frames whose
+                rows are padded out to alignment boundaries.
+
+                Note that this object does NOT take ownership of the buffer you give
+                to it.  This means it is up to you to make sure the buffer is freed
+                at some point, and an instance of this object can only be used as
+                long as the buffer it references remains valid, since a
+                raw_image_view just points at the buffer's memory directly.
+        !*/
+
+    public:
+        typedef pixel_type type;
+        typedef default_memory_manager mem_manager_type;
+
+        raw_image_view (
+        );
+        /*!
+            ensures
+                - #nr() == 0
+                - #nc() == 0
+                - This object doesn't reference any memory.  You must assign another
+                  raw_image_view to it before it can be used.
+        !*/
+
+        raw_image_view (
+            void* data,
+            long nr,
+            long nc,
+            long width_step
+        );
+        /*!
+            requires
+                - nr >= 0 && nc >= 0
+                - if (nr != 0 && nc != 0) then
+                    - data points to a buffer of at least nr*width_step bytes holding
+                      the image, with the pixel at row r and column c located at
+                      (char*)data + r*width_step + c*sizeof(pixel_type)
+                - width_step >= nc*sizeof(pixel_type)
+            ensures
+                - #nr() == nr
+                - #nc() == nc
+                - #width_step() == width_step
+                - using the operator[] on this object you will be able to access the
+                  pixels inside the given buffer.
+        !*/
+
+        raw_image_view (
+            void* data,
+            long nr,
+            long nc
+        );
+        /*!
+            requires
+                - nr >= 0 && nc >= 0
+                - if (nr != 0 && nc != 0) then
+                    - data points to a buffer of nr rows of nc pixels with no padding
+                      between rows.
+            ensures
+                - performs: raw_image_view(data, nr, nc, nc*sizeof(pixel_type))
+        !*/
+
+        long nr(
+        ) const;
+        /*!
+            ensures
+                - returns the number of rows in this image
+        !*/
+
+        long nc(
+        ) const;
+        /*!
+            ensures
+                - returns the number of columns in this image
+        !*/
+
+        size_t size(
+        ) const;
+        /*!
+            ensures
+                - returns nr()*nc()
+                  (i.e. returns the number of pixels in this image)
+        !*/
+
+        long width_step(
+        ) const;
+        /*!
+            ensures
+                - returns the size of one row of the image, in bytes.
+        !*/
+
+        pixel_type* operator[](
+            long row
+        );
+        /*!
+            requires
+                - 0 <= row < nr()
+            ensures
+                - returns a pointer to the first pixel in the given row
+        !*/
+
+        const pixel_type* operator[](
+            long row
+        ) const;
+        /*!
+            requires
+                - 0 <= row < nr()
+            ensures
+                - returns a pointer to the first pixel in the given row
+        !*/
+
+        const pixel_type& operator()(
+            long row,
+            long column
+        ) const;
+        /*!
+            requires
+                - 0 <= row < nr()
+                - 0 <= column < nc()
+            ensures
+                - returns a const reference to the pixel at the given row and column
+        !*/
+
+        pixel_type& operator()(
+            long row,
+            long column
+        );
+        /*!
+            requires
+                - 0 <= row < nr()
+                - 0 <= column < nc()
+            ensures
+                - returns a reference to the pixel at the given row and column
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    const matrix_exp mat (
+        const raw_image_view<T>& img
+    );
+    /*!
+        ensures
+            - returns a matrix R such that:
+                - R.nr() == img.nr()
+                - R.nc() == img.nc()
+                - for all valid r and c:
+                  R(r,c) == img[r][c]
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_RAW_IMAGE_VIEw_ABSTRACT_H_
+
@@ -8,6 +8,7 @@
 #include "../image_transforms.h"
 #include "../array.h"
 #include "../array2d.h"
+#include "../threads/async.h"
 #include "object_detector.h"
 
 namespace dlib
@@ -92,6 +93,13 @@ namespace dlib
             const image_type& img
         );
 
+        template <
+            typename pyramid_pixel_type
+            >
+        void load (
+            frame_pyramid<Pyramid_type,pyramid_pixel_type>& img_pyr
+        );
+
         inline bool is_loaded_with_image (
         ) const;
 
@@ -332,13 +340,56 @@ namespace dlib
         }
 
         unsigned long get_fhog_window_height (
-        ) const 
+        ) const
         {
             unsigned long width, height;
             compute_fhog_window_size(width, height);
             return height;
         }
 
+        typedef array<array2d<float> > fhog_image;
+
+        unsigned long get_num_loaded_pyramid_levels (
+        ) const { return feats.size(); }
+
+        const fhog_image& get_loaded_pyramid_level (
+            unsigned long level
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(level < get_num_loaded_pyramid_levels(),
+                "\t const fhog_image& scan_fhog_pyramid::get_loaded_pyramid_level()"
+                << "\n\t Invalid inputs were given to this function "
+                << "\n\t level:                            " << level
+                << "\n\t get_num_loaded_pyramid_levels():  " << get_num_loaded_pyramid_levels()
+                << "\n\t this: " << this
+                );
+
+            return feats[level];
+        }
+
+        rectangle image_to_feat_space (
+            const rectangle& rect,
+            unsigned long level
+        ) const
+        {
+            unsigned long width, height;
+            compute_fhog_window_size(width, height);
+            pyramid_type pyr;
+            return fe.image_to_feats(pyr.rect_down(rect,level), cell_size, height, width);
+        }
+
+        rectangle feat_to_image_space (
+            const rectangle& rect,
+            unsigned long level
+        ) const
+        {
+            unsigned long width, height;
+            compute_fhog_window_size(width, height);
+            pyramid_type pyr;
+            return pyr.rect_up(fe.feats_to_image(rect, cell_size, height, width), level);
+        }
+
         template <typename T, typename U>
         friend void serialize (
             const scan_fhog_pyramid<T,U>& item,
@@ -381,8 +432,6 @@ namespace dlib
             return (r1.intersect(r2).area())/(double)(r1 + r2).area();
         }
 
-        typedef array<array2d<float> > fhog_image;
-
         feature_extractor_type fe;
         array<fhog_image> feats;
         int cell_size;
@@ -590,27 +639,107 @@ namespace dlib
 
 
 
-            // build our feature pyramid
-            fe(img, feats[0], cell_size,filter_rows_padding,filter_cols_padding);
-            DLIB_ASSERT(feats[0].size() == fe.get_num_planes(), 
-                "Invalid feature extractor used with dlib::scan_fhog_pyramid.  The output does not have the \n"
-                "indicated number of planes.");
+            // Build our feature pyramid.  The downsampling steps form a chain, but the
+            // feature extraction for a level depends only on that level's downsampled
+            // image.  So we run the downsampling chain on this thread and hand each
+            // level's feature extraction to the thread pool as soon as its image is
+            // ready, overlapping the extraction of level N with the downsampling of
+            // level N+1.
+            thread_pool& tp = default_thread_pool();
+
+            typedef typename image_traits<image_type>::pixel_type pixel_type;
+            // Unlike a serial build, which can ping-pong between two temporary
+            // images, every level's image has to stay alive until its extraction
+            // task has run.  pimages[0] is unused since level 0 reads img directly.
+            array<array2d<pixel_type> > pimages;
+            if (pimages.max_size() < levels)
+                pimages.set_max_size(levels);
+            pimages.set_size(levels);
+
+            tp.add_task_by_value([&]()
+            { fe(img, feats[0], cell_size,filter_rows_padding,filter_cols_padding); });
 
             if (feats.size() > 1)
             {
-                typedef typename image_traits<image_type>::pixel_type pixel_type;
-                array2d<pixel_type> temp1, temp2;
-                pyr(img, temp1);
-                fe(temp1, feats[1], cell_size,filter_rows_padding,filter_cols_padding);
-                swap(temp1,temp2);
+                pyr(img, pimages[1]);
+                tp.add_task_by_value([&]()
+                { fe(pimages[1], feats[1], cell_size,filter_rows_padding,filter_cols_padding); });
 
                 for (unsigned long i = 2; i < feats.size(); ++i)
                 {
-                    pyr(temp2, temp1);
-                    fe(temp1, feats[i], cell_size,filter_rows_padding,filter_cols_padding);
-                    swap(temp1,temp2);
+                    pyr(pimages[i-1], pimages[i]);
+                    tp.add_task_by_value([&,i]()
+                    { fe(pimages[i], feats[i], cell_size,filter_rows_padding,filter_cols_padding); });
                 }
             }
+
+            tp.wait_for_all_tasks();
+
+            DLIB_ASSERT(feats[0].size() == fe.get_num_planes(),
+                "Invalid feature extractor used with dlib::scan_fhog_pyramid.  The output does not have the \n"
+                "indicated number of planes.");
+        }
+
+        template <
+            typename pyramid_type,
+            typename pixel_type,
+            typename feature_extractor_type
+            >
+        void create_fhog_pyramid (
+            frame_pyramid<pyramid_type,pixel_type>& img_pyr,
+            const feature_extractor_type& fe,
+            array<array<array2d<float> > >& feats,
+            int cell_size,
+            int filter_rows_padding,
+            int filter_cols_padding,
+            unsigned long min_pyramid_layer_width,
+            unsigned long min_pyramid_layer_height,
+            unsigned long max_pyramid_levels
+        )
+        {
+            if (img_pyr.num_levels() == 0)
+            {
+                array2d<pixel_type> empty_img;
+                create_fhog_pyramid<pyramid_type>(empty_img, fe, feats, cell_size,
+                    filter_rows_padding, filter_cols_padding, min_pyramid_layer_width,
+                    min_pyramid_layer_height, max_pyramid_levels);
+                return;
+            }
+
+            unsigned long levels = 0;
+            rectangle rect = get_rect(img_pyr.get_level(0));
+
+            // figure out how many pyramid levels we should be using based on the image size
+            const pyramid_type& pyr = img_pyr.get_pyramid_down();
+            do
+            {
+                rect = pyr.rect_down(rect);
+                ++levels;
+            } while (rect.width() >= min_pyramid_layer_width && rect.height() >= min_pyramid_layer_height &&
+                levels < max_pyramid_levels);
+            levels = std::min<unsigned long>(levels, img_pyr.num_levels());
+
+            if (feats.max_size() < levels)
+                feats.set_max_size(levels);
+            feats.set_size(levels);
+
+            // This is just like the version of create_fhog_pyramid() defined above
+            // except the downsampled images come from the given frame_pyramid, which
+            // caches them so other pipeline stages processing the same frame don't
+            // have to downsample it again.  Make sure every level we need is in the
+            // cache, then hand each level's feature extraction to the thread pool.
+            img_pyr.get_level(levels-1);
+            thread_pool& tp = default_thread_pool();
+            for (unsigned long i = 0; i < levels; ++i)
+            {
+                tp.add_task_by_value([&,i]()
+                { fe(img_pyr.get_level(i), feats[i], cell_size,filter_rows_padding,filter_cols_padding); });
+            }
+            tp.wait_for_all_tasks();
+
+            DLIB_ASSERT(feats[0].size() == fe.get_num_planes(),
+                "Invalid feature extractor used with dlib::scan_fhog_pyramid.  The output does not have the \n"
+                "indicated number of planes.");
         }
     }
 
@@ -635,6 +764,27 @@ namespace dlib
             max_pyramid_levels);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename Pyramid_type,
+        typename feature_extractor_type
+        >
+    template <
+        typename pyramid_pixel_type
+        >
+    void scan_fhog_pyramid<Pyramid_type,feature_extractor_type>::
+    load (
+        frame_pyramid<Pyramid_type,pyramid_pixel_type>& img_pyr
+    )
+    {
+        unsigned long width, height;
+        compute_fhog_window_size(width,height);
+        impl::create_fhog_pyramid<Pyramid_type>(img_pyr, fe, feats, cell_size, height,
+            width, min_pyramid_layer_width, min_pyramid_layer_height,
+            max_pyramid_levels);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -278,6 +278,23 @@ namespace dlib
                   locations.  Call detect() to do this.
         !*/
 
+        template <
+            typename pyramid_pixel_type
+            >
+        void load (
+            frame_pyramid<Pyramid_type,pyramid_pixel_type>& img_pyr
+        );
+        /*!
+            ensures
+                - This function is identical to the load() defined above except that it
+                  reads the pyramid levels of the frame from img_pyr instead of
+                  downsampling the image itself.  Any levels it uses are left in
+                  img_pyr's cache, so a frame_pyramid shared between this object and
+                  other pipeline stages (e.g. extract_image_chips()) is only
+                  downsampled once per frame.
+                - #is_loaded_with_image() == true
+        !*/
+
         const feature_extractor_type& get_feature_extractor(
         ) const;
         /*!
@@ -376,11 +393,71 @@ namespace dlib
                 - Returns the height of the HOG scanning window in terms of HOG cell blocks.  
                   Note that this is a function of get_detection_window_height(), get_cell_size(), 
                   and get_padding() and is therefore not something you set directly. 
-                - #get_fhog_window_height() is approximately equal to the number of HOG cells 
+                - #get_fhog_window_height() is approximately equal to the number of HOG cells
                   that fit into get_detection_window_height() pixels plus 2*get_padding()
                   since we include additional padding around each window to add context.
         !*/
 
+        typedef array<array2d<float> > fhog_image;
+
+        unsigned long get_num_loaded_pyramid_levels (
+        ) const;
+        /*!
+            ensures
+                - if (is_loaded_with_image()) then
+                    - returns the number of pyramid levels in the feature pyramid
+                      computed by the last call to load().
+                - else
+                    - returns 0
+        !*/
+
+        const fhog_image& get_loaded_pyramid_level (
+            unsigned long level
+        ) const;
+        /*!
+            requires
+                - level < get_num_loaded_pyramid_levels()
+            ensures
+                - returns the planes of HOG features computed by load() for the
+                  indicated pyramid level.  Level 0 corresponds to the original
+                  image and each successive level is a downsampled version of the
+                  previous one (downsampled by pyramid_type).  The returned planes
+                  are exactly what get_feature_extractor() produced, including
+                  get_fhog_window_height() rows and get_fhog_window_width() columns
+                  of zero padding around the border.  This allows other parts of a
+                  vision pipeline which also need HOG features for the current
+                  frame to reuse the ones computed here rather than extracting
+                  them a second time.  Use image_to_feat_space() and
+                  feat_to_image_space() to map between locations in the original
+                  image and cells in these feature planes.
+                - The returned reference is invalidated by any subsequent call to
+                  load() or to a member function that unloads the image.
+        !*/
+
+        rectangle image_to_feat_space (
+            const rectangle& rect,
+            unsigned long level
+        ) const;
+        /*!
+            ensures
+                - maps rect from the coordinate system of the original image given
+                  to load() into the HOG cell grid of pyramid level level (i.e. the
+                  coordinate system of the planes returned by
+                  get_loaded_pyramid_level(level)) and returns the result.
+        !*/
+
+        rectangle feat_to_image_space (
+            const rectangle& rect,
+            unsigned long level
+        ) const;
+        /*!
+            ensures
+                - performs the inverse mapping of image_to_feat_space().  That is,
+                  maps rect from the HOG cell grid of pyramid level level back into
+                  the coordinate system of the original image and returns the
+                  result.
+        !*/
+
         void set_padding (
             unsigned long new_padding
         );
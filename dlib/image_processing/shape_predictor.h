@@ -10,6 +10,7 @@
 #include "../geometry.h"
 #include "../pixel.h"
 #include "../statistics.h"
+#include "../threads.h"
 #include <utility>
 
 namespace dlib
@@ -267,12 +268,19 @@ namespace dlib
             const rectangle area = get_rect(img_);
 
             const_image_view<image_type> img(img_);
+
+            // Compute the points in the current shape corresponding to each pixel and
+            // then map them all from the normalized shape space into pixel space in
+            // one vectorized sweep.
+            std::vector<dlib::vector<float,2> > pts(reference_pixel_deltas.size());
+            for (unsigned long i = 0; i < pts.size(); ++i)
+                pts[i] = tform*reference_pixel_deltas[i] + location(current_shape, reference_pixel_anchor_idx[i]);
+            transform_points(tform_to_img, pts);
+
             feature_pixel_values.resize(reference_pixel_deltas.size());
             for (unsigned long i = 0; i < feature_pixel_values.size(); ++i)
             {
-                // Compute the point in the current shape corresponding to the i-th pixel and
-                // then map it from the normalized shape space into pixel space.
-                point p = tform_to_img(tform*reference_pixel_deltas[i] + location(current_shape, reference_pixel_anchor_idx[i]));
+                const point p = pts[i];
                 if (area.contains(p))
                     feature_pixel_values[i] = get_pixel_intensity(img[p.y()][p.x()]);
                 else
@@ -335,6 +343,18 @@ namespace dlib
             return num;
         }
 
+        const matrix<float,0,1>& get_initial_shape (
+        ) const { return initial_shape; }
+
+        const std::vector<std::vector<impl::regression_tree> >& get_forests (
+        ) const { return forests; }
+
+        const std::vector<std::vector<unsigned long> >& get_anchor_idx (
+        ) const { return anchor_idx; }
+
+        const std::vector<std::vector<dlib::vector<float,2> > >& get_deltas (
+        ) const { return deltas; }
+
         template <typename image_type>
         full_object_detection operator()(
             const image_type& img,
@@ -397,6 +417,56 @@ namespace dlib
             return full_object_detection(rect, parts);
         }
 
+        template <typename image_type>
+        std::vector<full_object_detection> operator()(
+            const image_type& img,
+            const std::vector<rectangle>& rects
+        ) const
+        {
+            using namespace impl;
+            std::vector<full_object_detection> dets;
+            dets.reserve(rects.size());
+            if (rects.size() == 0)
+                return dets;
+
+            std::vector<matrix<float,0,1> > current_shapes(rects.size(), initial_shape);
+
+            // Walk the cascade in lockstep across all the boxes rather than running
+            // each box through the whole cascade by itself.  All the boxes come from
+            // the same image, and each cascade level reads its own anchor/delta
+            // tables and regression trees, so processing a level across every box
+            // keeps those tables and the relevant parts of the image hot in cache.
+            // The boxes are independent within a level, so we also split them over
+            // the default thread pool.
+            for (unsigned long iter = 0; iter < forests.size(); ++iter)
+            {
+                parallel_for_blocked(0, (long)rects.size(), [&](long begin, long end)
+                {
+                    std::vector<float> feature_pixel_values;
+                    for (long j = begin; j < end; ++j)
+                    {
+                        extract_feature_pixel_values(img, rects[j], current_shapes[j], initial_shape,
+                                                     anchor_idx[iter], deltas[iter], feature_pixel_values);
+                        unsigned long leaf_idx;
+                        // evaluate all the trees at this level of the cascade.
+                        for (unsigned long i = 0; i < forests[iter].size(); ++i)
+                            current_shapes[j] += forests[iter][i](feature_pixel_values, leaf_idx);
+                    }
+                });
+            }
+
+            // convert the current_shapes into full_object_detections
+            for (unsigned long j = 0; j < rects.size(); ++j)
+            {
+                const point_transform_affine tform_to_img = unnormalizing_tform(rects[j]);
+                std::vector<point> parts(current_shapes[j].size()/2);
+                for (unsigned long i = 0; i < parts.size(); ++i)
+                    parts[i] = tform_to_img(location(current_shapes[j], i));
+                dets.push_back(full_object_detection(rects[j], parts));
+            }
+            return dets;
+        }
+
         friend void serialize (const shape_predictor& item, std::ostream& out);
 
         friend void deserialize (shape_predictor& item, std::istream& in);
@@ -111,6 +111,29 @@ namespace dlib
                   where the 3d argument is discarded.
         !*/
 
+        template <typename image_type>
+        std::vector<full_object_detection> operator()(
+            const image_type& img,
+            const std::vector<rectangle>& rects
+        ) const;
+        /*!
+            requires
+                - image_type == an image object that implements the interface defined in
+                  dlib/image_processing/generic_image.h
+            ensures
+                - Runs the shape prediction algorithm on every rectangle in rects.  So
+                  this returns a std::vector DETS such that:
+                    - DETS.size() == rects.size()
+                    - for all valid i:
+                        - DETS[i] == (*this)(img, rects[i])
+                - This function produces exactly the same predictions as calling the
+                  single rectangle operator() on each element of rects.  However, it
+                  walks the cascade in lockstep across all the rectangles and splits
+                  the work over dlib::default_thread_pool().  So when you have many
+                  boxes in one image (e.g. many faces in a frame) it is much faster
+                  than making one call per box.
+        !*/
+
     };
 
     void serialize (const shape_predictor& item, std::ostream& out);
@@ -9,6 +9,8 @@
 #include "../threads.h"
 #include "../data_io/image_dataset_metadata.h"
 #include "box_overlap_testing.h"
+#include <fstream>
+#include <cstdio>
 
 namespace dlib
 {
@@ -45,6 +47,7 @@ namespace dlib
             _verbose = false;
             _num_threads = 0;
             _padding_mode = landmark_relative;
+            _num_fine_tuning_cascades = 1;
         }
 
         unsigned long get_cascade_depth (
@@ -238,6 +241,24 @@ namespace dlib
             _num_threads = num;
         }
 
+        unsigned long get_num_fine_tuning_cascades (
+        ) const { return _num_fine_tuning_cascades; }
+        void set_num_fine_tuning_cascades (
+            unsigned long num
+        )
+        {
+            _num_fine_tuning_cascades = num;
+        }
+
+        const std::string& get_checkpoint_file (
+        ) const { return _checkpoint_filename; }
+        void set_checkpoint_file (
+            const std::string& filename
+        )
+        {
+            _checkpoint_filename = filename;
+        }
+
         template <typename image_array>
         shape_predictor train (
             const image_array& images,
@@ -245,54 +266,7 @@ namespace dlib
         ) const
         {
             using namespace impl;
-            DLIB_CASSERT(images.size() == objects.size() && images.size() > 0,
-                "\t shape_predictor shape_predictor_trainer::train()"
-                << "\n\t Invalid inputs were given to this function. "
-                << "\n\t images.size():  " << images.size() 
-                << "\n\t objects.size(): " << objects.size() 
-            );
-            // make sure the objects agree on the number of parts and that there is at
-            // least one full_object_detection. 
-            unsigned long num_parts = 0;
-            std::vector<int> part_present;
-            for (unsigned long i = 0; i < objects.size(); ++i)
-            {
-                for (unsigned long j = 0; j < objects[i].size(); ++j)
-                {
-                    if (num_parts == 0)
-                    {
-                        num_parts = objects[i][j].num_parts();
-                        DLIB_CASSERT(objects[i][j].num_parts() != 0,
-                            "\t shape_predictor shape_predictor_trainer::train()"
-                            << "\n\t You can't give objects that don't have any parts to the trainer."
-                        );
-                        part_present.resize(num_parts);
-                    }
-                    else
-                    {
-                        DLIB_CASSERT(objects[i][j].num_parts() == num_parts,
-                            "\t shape_predictor shape_predictor_trainer::train()"
-                            << "\n\t All the objects must agree on the number of parts. "
-                            << "\n\t objects["<<i<<"]["<<j<<"].num_parts(): " << objects[i][j].num_parts()
-                            << "\n\t num_parts:  " << num_parts 
-                        );
-                    }
-                    for (unsigned long p = 0; p < objects[i][j].num_parts(); ++p)
-                    {
-                        if (objects[i][j].part(p) != OBJECT_PART_NOT_PRESENT)
-                            part_present[p] = 1;
-                    }
-                }
-            }
-            DLIB_CASSERT(num_parts != 0,
-                "\t shape_predictor shape_predictor_trainer::train()"
-                << "\n\t You must give at least one full_object_detection if you want to train a shape model and it must have parts."
-            );
-            DLIB_CASSERT(sum(mat(part_present)) == (long)num_parts,
-                "\t shape_predictor shape_predictor_trainer::train()"
-                << "\n\t Each part must appear at least once in this training data.  That is, "
-                << "\n\t you can't have a part that is always set to OBJECT_PART_NOT_PRESENT."
-            );
+            check_training_inputs(images.size(), objects);
 
             // creating thread pool. if num_threads <= 1, trainer should work in caller thread
             thread_pool tp(_num_threads > 1 ? _num_threads : 0);
@@ -306,16 +280,28 @@ namespace dlib
 
             std::vector<training_sample<feature_type>> samples;
             const matrix<float,0,1> initial_shape = populate_training_sample_shapes(objects, samples);
-            const std::vector<std::vector<dlib::vector<float,2> > > pixel_coordinates = randomly_sample_pixel_coordinates(initial_shape);
+            const std::vector<std::vector<dlib::vector<float,2> > > pixel_coordinates = randomly_sample_pixel_coordinates(initial_shape, get_cascade_depth());
 
-            unsigned long trees_fit_so_far = 0;
+            std::vector<std::vector<impl::regression_tree> > forests(get_cascade_depth());
+            unsigned long start_cascade = 0;
+            if (_checkpoint_filename.size() != 0)
+            {
+                std::ifstream fin(_checkpoint_filename.c_str(), std::ios::binary);
+                if (fin)
+                {
+                    start_cascade = load_checkpoint(fin, initial_shape, forests, samples);
+                    if (_verbose)
+                        std::cout << "Resuming training from checkpoint at cascade " << start_cascade << std::endl;
+                }
+            }
+
+            unsigned long trees_fit_so_far = start_cascade*get_num_trees_per_cascade_level();
             console_progress_indicator pbar(get_cascade_depth()*get_num_trees_per_cascade_level());
             if (_verbose)
                 std::cout << "Fitting trees..." << std::endl;
 
-            std::vector<std::vector<impl::regression_tree> > forests(get_cascade_depth());
             // Now start doing the actual training by filling in the forests
-            for (unsigned long cascade = 0; cascade < get_cascade_depth(); ++cascade)
+            for (unsigned long cascade = start_cascade; cascade < get_cascade_depth(); ++cascade)
             {
                 // Each cascade uses a different set of pixels for its features.  We compute
                 // their representations relative to the initial shape first.
@@ -343,6 +329,128 @@ namespace dlib
                         pbar.print_status(trees_fit_so_far);
                     }
                 }
+
+                if (_checkpoint_filename.size() != 0)
+                    save_checkpoint(cascade+1, initial_shape, forests, samples);
+            }
+
+            if (_verbose)
+                std::cout << "Training complete                          " << std::endl;
+
+            return shape_predictor(initial_shape, forests, pixel_coordinates);
+        }
+
+        template <typename image_array>
+        shape_predictor train (
+            const image_array& images,
+            const std::vector<std::vector<full_object_detection> >& objects,
+            const shape_predictor& base_model
+        ) const
+        {
+            using namespace impl;
+            const unsigned long num_parts = check_training_inputs(images.size(), objects);
+            DLIB_CASSERT(base_model.num_parts() == num_parts,
+                "\t shape_predictor shape_predictor_trainer::train()"
+                << "\n\t The base model must have the same number of parts as the training data. "
+                << "\n\t base_model.num_parts(): " << base_model.num_parts()
+                << "\n\t num_parts:              " << num_parts
+            );
+
+            // creating thread pool. if num_threads <= 1, trainer should work in caller thread
+            thread_pool tp(_num_threads > 1 ? _num_threads : 0);
+
+            // determining the type of features used for this type of images
+            typedef typename std::remove_const<typename std::remove_reference<decltype(images[0])>::type>::type image_type;
+            typedef typename image_traits<image_type>::pixel_type pixel_type;
+            typedef typename pixel_traits<pixel_type>::basic_pixel_type feature_type;
+
+            rnd.set_seed(get_random_seed());
+
+            std::vector<training_sample<feature_type>> samples;
+            populate_training_sample_shapes(objects, samples);
+            // All the feature encodings have to stay relative to the base model's
+            // initial shape rather than the mean shape of the new dataset since that is
+            // the shape the base model's forests were trained against.
+            const matrix<float,0,1>& initial_shape = base_model.get_initial_shape();
+
+            // Recover the feature pool pixel locations for each of the base model's
+            // cascades from its shape relative encodings.
+            std::vector<std::vector<dlib::vector<float,2> > > pixel_coordinates(base_model.get_forests().size());
+            for (unsigned long i = 0; i < pixel_coordinates.size(); ++i)
+            {
+                const std::vector<unsigned long>& banchor = base_model.get_anchor_idx()[i];
+                const std::vector<dlib::vector<float,2> >& bdeltas = base_model.get_deltas()[i];
+                pixel_coordinates[i].resize(banchor.size());
+                for (unsigned long j = 0; j < banchor.size(); ++j)
+                    pixel_coordinates[i][j] = location(initial_shape, banchor[j]) + bdeltas[j];
+            }
+
+            std::vector<std::vector<impl::regression_tree> > forests = base_model.get_forests();
+
+            unsigned long trees_processed_so_far = 0;
+            unsigned long total_trees = get_num_fine_tuning_cascades()*get_num_trees_per_cascade_level();
+            for (unsigned long cascade = 0; cascade < forests.size(); ++cascade)
+                total_trees += forests[cascade].size();
+            console_progress_indicator pbar(total_trees);
+            if (_verbose)
+                std::cout << "Reweighting trees..." << std::endl;
+
+            // First pass: keep the base model's splits but refit every leaf value
+            // against the new dataset.  This is cheap since no split search happens.
+            for (unsigned long cascade = 0; cascade < forests.size(); ++cascade)
+            {
+                std::vector<unsigned long> anchor_idx;
+                std::vector<dlib::vector<float,2> > deltas;
+                create_shape_relative_encoding(initial_shape, pixel_coordinates[cascade], anchor_idx, deltas);
+
+                parallel_for(tp, 0, samples.size(), [&](unsigned long i)
+                {
+                    impl::extract_feature_pixel_values(images[samples[i].image_idx], samples[i].rect,
+                                                 samples[i].current_shape, initial_shape, anchor_idx,
+                                                 deltas, samples[i].feature_pixel_values);
+                }, 1);
+
+                for (unsigned long i = 0; i < forests[cascade].size(); ++i)
+                {
+                    refit_tree_leaves(tp, forests[cascade][i], samples);
+
+                    if (_verbose)
+                    {
+                        ++trees_processed_so_far;
+                        pbar.print_status(trees_processed_so_far);
+                    }
+                }
+            }
+
+            // Second pass: grow additional cascades against whatever residual error
+            // remains, exactly like train() does.
+            const std::vector<std::vector<dlib::vector<float,2> > > new_pixel_coordinates =
+                randomly_sample_pixel_coordinates(initial_shape, get_num_fine_tuning_cascades());
+            for (unsigned long cascade = 0; cascade < new_pixel_coordinates.size(); ++cascade)
+            {
+                std::vector<unsigned long> anchor_idx;
+                std::vector<dlib::vector<float,2> > deltas;
+                create_shape_relative_encoding(initial_shape, new_pixel_coordinates[cascade], anchor_idx, deltas);
+
+                parallel_for(tp, 0, samples.size(), [&](unsigned long i)
+                {
+                    impl::extract_feature_pixel_values(images[samples[i].image_idx], samples[i].rect,
+                                                 samples[i].current_shape, initial_shape, anchor_idx,
+                                                 deltas, samples[i].feature_pixel_values);
+                }, 1);
+
+                forests.push_back(std::vector<impl::regression_tree>());
+                pixel_coordinates.push_back(new_pixel_coordinates[cascade]);
+                for (unsigned long i = 0; i < get_num_trees_per_cascade_level(); ++i)
+                {
+                    forests.back().push_back(make_regression_tree(tp, samples, pixel_coordinates.back()));
+
+                    if (_verbose)
+                    {
+                        ++trees_processed_so_far;
+                        pbar.print_status(trees_processed_so_far);
+                    }
+                }
             }
 
             if (_verbose)
@@ -353,6 +461,69 @@ namespace dlib
 
     private:
 
+        static unsigned long check_training_inputs (
+            size_t num_images,
+            const std::vector<std::vector<full_object_detection> >& objects
+        )
+        /*!
+            ensures
+                - validates the training data given to train(), throwing the usual fatal
+                  error messages if it is malformed.
+                - returns the number of parts each object annotation has.
+        !*/
+        {
+            DLIB_CASSERT(num_images == objects.size() && num_images > 0,
+                "\t shape_predictor shape_predictor_trainer::train()"
+                << "\n\t Invalid inputs were given to this function. "
+                << "\n\t images.size():  " << num_images
+                << "\n\t objects.size(): " << objects.size()
+            );
+            // make sure the objects agree on the number of parts and that there is at
+            // least one full_object_detection.
+            unsigned long num_parts = 0;
+            std::vector<int> part_present;
+            for (unsigned long i = 0; i < objects.size(); ++i)
+            {
+                for (unsigned long j = 0; j < objects[i].size(); ++j)
+                {
+                    if (num_parts == 0)
+                    {
+                        num_parts = objects[i][j].num_parts();
+                        DLIB_CASSERT(objects[i][j].num_parts() != 0,
+                            "\t shape_predictor shape_predictor_trainer::train()"
+                            << "\n\t You can't give objects that don't have any parts to the trainer."
+                        );
+                        part_present.resize(num_parts);
+                    }
+                    else
+                    {
+                        DLIB_CASSERT(objects[i][j].num_parts() == num_parts,
+                            "\t shape_predictor shape_predictor_trainer::train()"
+                            << "\n\t All the objects must agree on the number of parts. "
+                            << "\n\t objects["<<i<<"]["<<j<<"].num_parts(): " << objects[i][j].num_parts()
+                            << "\n\t num_parts:  " << num_parts
+                        );
+                    }
+                    for (unsigned long p = 0; p < objects[i][j].num_parts(); ++p)
+                    {
+                        if (objects[i][j].part(p) != OBJECT_PART_NOT_PRESENT)
+                            part_present[p] = 1;
+                    }
+                }
+            }
+            DLIB_CASSERT(num_parts != 0,
+                "\t shape_predictor shape_predictor_trainer::train()"
+                << "\n\t You must give at least one full_object_detection if you want to train a shape model and it must have parts."
+            );
+            DLIB_CASSERT(sum(mat(part_present)) == (long)num_parts,
+                "\t shape_predictor shape_predictor_trainer::train()"
+                << "\n\t Each part must appear at least once in this training data.  That is, "
+                << "\n\t you can't have a part that is always set to OBJECT_PART_NOT_PRESENT."
+            );
+
+            return num_parts;
+        }
+
         static void object_to_shape (
             const full_object_detection& obj,
             matrix<float,0,1>& shape,
@@ -467,9 +638,14 @@ namespace dlib
                     }
                 }, 1);
 
-                // now calculate the total result from separate blocks
+                // now calculate the total result from separate blocks.  Note that a
+                // block that got no samples leaves its accumulator empty, and adding
+                // an empty matrix would wipe the sum rather than leave it alone.
                 for (unsigned long i = 0; i < block_sums.size(); ++i)
-                    sums[0] += block_sums[i];
+                {
+                    if (block_sums[i].size() != 0)
+                        sums[0] += block_sums[i];
+                }
             }
             else
             {
@@ -497,14 +673,15 @@ namespace dlib
             }
 
             // Now all the parts contain the ranges for the leaves so we can use them to
-            // compute the average leaf values.
-            matrix<float,0,1> present_counts(samples[0].target_shape.size());
+            // compute the average leaf values.  Each leaf owns a disjoint range of
+            // samples so the leaves can all be processed in parallel.
             tree.leaf_values.resize(parts.size());
-            for (unsigned long i = 0; i < parts.size(); ++i)
+            parallel_for(tp, 0, parts.size(), [&](unsigned long i)
             {
                 // Get the present counts for each dimension so we can divide each
                 // dimension by the number of observations we have on it to find the mean
                 // displacement in each leaf.
+                matrix<float,0,1> present_counts(samples[0].target_shape.size());
                 present_counts = 0;
                 for (unsigned long j = parts[i].first; j < parts[i].second; ++j)
                     present_counts += samples[j].present;
@@ -516,7 +693,7 @@ namespace dlib
                     tree.leaf_values[i] = zeros_matrix(samples[0].target_shape);
 
                 // now adjust the current shape based on these predictions
-                parallel_for(tp, parts[i].first, parts[i].second, [&](unsigned long j)
+                for (unsigned long j = parts[i].first; j < parts[i].second; ++j)
                 {
                     samples[j].current_shape += tree.leaf_values[i];
                     // For parts that aren't present in the training data, we just make
@@ -529,12 +706,173 @@ namespace dlib
                         if (samples[j].present(k) == 0)
                             samples[j].target_shape(k) = samples[j].current_shape(k);
                     }
-                }, 1);
-            }
+                }
+            }, 1);
 
             return tree;
         }
 
+        template<typename feature_type>
+        void refit_tree_leaves (
+            thread_pool& tp,
+            impl::regression_tree& tree,
+            std::vector<training_sample<feature_type>>& samples
+        ) const
+        /*!
+            ensures
+                - Keeps tree.splits exactly as they are but recomputes tree.leaf_values
+                  from samples, using the same average residual rule
+                  make_regression_tree() uses.  Leaves that don't receive any samples
+                  keep their old values.
+                - Updates the current shapes of samples by the new leaf values, just
+                  like make_regression_tree() does when it builds a tree.
+        !*/
+        {
+            using namespace impl;
+            // Partition the samples by walking the existing splits in breadth first
+            // order, exactly like make_regression_tree() partitions them as it
+            // generates the splits.
+            std::deque<std::pair<unsigned long, unsigned long> > parts;
+            parts.push_back(std::make_pair(0, (unsigned long)samples.size()));
+            for (unsigned long i = 0; i < tree.splits.size(); ++i)
+            {
+                std::pair<unsigned long,unsigned long> range = parts.front();
+                parts.pop_front();
+                const unsigned long mid = partition_samples(tree.splits[i], samples, range.first, range.second);
+                parts.push_back(std::make_pair(range.first, mid));
+                parts.push_back(std::make_pair(mid, range.second));
+            }
+
+            // Each leaf owns a disjoint range of samples so the leaves can all be
+            // processed in parallel.
+            parallel_for(tp, 0, parts.size(), [&](unsigned long i)
+            {
+                if (parts[i].second != parts[i].first)
+                {
+                    matrix<float,0,1> present_counts(samples[0].target_shape.size());
+                    present_counts = 0;
+                    matrix<float,0,1> sum = zeros_matrix(samples[0].target_shape);
+                    for (unsigned long j = parts[i].first; j < parts[i].second; ++j)
+                    {
+                        sum += samples[j].target_shape - samples[j].current_shape;
+                        present_counts += samples[j].present;
+                    }
+                    tree.leaf_values[i] = pointwise_multiply(dlib::reciprocal(present_counts), sum*get_nu());
+                }
+                // Leaves that never fire on this dataset keep whatever values they
+                // learned before so that queries landing in them at runtime still get
+                // a sensible prediction.
+
+                // now adjust the current shape based on these predictions
+                for (unsigned long j = parts[i].first; j < parts[i].second; ++j)
+                {
+                    samples[j].current_shape += tree.leaf_values[i];
+                    // For parts that aren't present in the training data, we just make
+                    // sure that the target shape always matches and therefore gives zero
+                    // error.  So this makes the algorithm simply ignore non-present
+                    // landmarks.
+                    for (long k = 0; k < samples[j].present.size(); ++k)
+                    {
+                        // if this part is not present
+                        if (samples[j].present(k) == 0)
+                            samples[j].target_shape(k) = samples[j].current_shape(k);
+                    }
+                }
+            }, 1);
+        }
+
+        template<typename feature_type>
+        void save_checkpoint (
+            unsigned long next_cascade,
+            const matrix<float,0,1>& initial_shape,
+            const std::vector<std::vector<impl::regression_tree> >& forests,
+            const std::vector<training_sample<feature_type>>& samples
+        ) const
+        /*!
+            ensures
+                - writes everything needed to resume training at cascade next_cascade to
+                  the file get_checkpoint_file().
+        !*/
+        {
+            // Write to a temporary file and then rename it so an interrupted save
+            // can't leave a truncated checkpoint behind.
+            const std::string temp_filename = _checkpoint_filename + ".tmp";
+            {
+                std::ofstream fout(temp_filename.c_str(), std::ios::binary);
+                int version = 1;
+                dlib::serialize(version, fout);
+                dlib::serialize(next_cascade, fout);
+                dlib::serialize(initial_shape, fout);
+                // only save the cascades completed so far so that a resumed run with a
+                // deeper cascade setting can pick up where this one left off.
+                const std::vector<std::vector<impl::regression_tree> > completed(forests.begin(), forests.begin()+next_cascade);
+                dlib::serialize(completed, fout);
+                dlib::serialize((unsigned long)samples.size(), fout);
+                for (unsigned long i = 0; i < samples.size(); ++i)
+                {
+                    dlib::serialize(samples[i].current_shape, fout);
+                    dlib::serialize(samples[i].target_shape, fout);
+                }
+                dlib::serialize(rnd, fout);
+                if (!fout)
+                    throw serialization_error("Error writing shape_predictor_trainer checkpoint to the file " + temp_filename);
+            }
+            std::rename(temp_filename.c_str(), _checkpoint_filename.c_str());
+        }
+
+        template<typename feature_type>
+        unsigned long load_checkpoint (
+            std::istream& in,
+            const matrix<float,0,1>& initial_shape,
+            std::vector<std::vector<impl::regression_tree> >& forests,
+            std::vector<training_sample<feature_type>>& samples
+        ) const
+        /*!
+            requires
+                - in contains a checkpoint written by save_checkpoint()
+            ensures
+                - restores the forests, per-sample shapes, and random number generator
+                  state recorded in the checkpoint.
+                - returns the cascade index training should resume at.
+            throws
+                - serialization_error if the checkpoint doesn't match the current
+                  training dataset and parameters.
+        !*/
+        {
+            int version = 0;
+            dlib::deserialize(version, in);
+            if (version != 1)
+                throw serialization_error("Unexpected version found while deserializing a shape_predictor_trainer checkpoint.");
+
+            unsigned long next_cascade = 0;
+            matrix<float,0,1> saved_shape;
+            std::vector<std::vector<impl::regression_tree> > saved_forests;
+            unsigned long num_samples = 0;
+            dlib::deserialize(next_cascade, in);
+            dlib::deserialize(saved_shape, in);
+            dlib::deserialize(saved_forests, in);
+            dlib::deserialize(num_samples, in);
+            if (saved_shape.size() != initial_shape.size() ||
+                max(abs(saved_shape - initial_shape)) != 0 ||
+                num_samples != samples.size() ||
+                saved_forests.size() != next_cascade ||
+                next_cascade > get_cascade_depth())
+            {
+                throw serialization_error("The checkpoint file given to shape_predictor_trainer::train() doesn't "
+                    "match the current training dataset and parameters.");
+            }
+
+            saved_forests.resize(get_cascade_depth());
+            forests.swap(saved_forests);
+            for (unsigned long i = 0; i < samples.size(); ++i)
+            {
+                dlib::deserialize(samples[i].current_shape, in);
+                dlib::deserialize(samples[i].target_shape, in);
+            }
+            dlib::deserialize(rnd, in);
+            return next_cascade;
+        }
+
         impl::split_feature randomly_generate_split_feature (
             const std::vector<dlib::vector<float,2> >& pixel_coordinates
         ) const
@@ -581,32 +919,50 @@ namespace dlib
             for (unsigned long i = 0; i < num_test_splits; ++i)
                 feats.push_back(randomly_generate_split_feature(pixel_coordinates));
 
-            std::vector<matrix<float,0,1> > left_sums(num_test_splits);
-            std::vector<unsigned long> left_cnt(num_test_splits);
-
             const unsigned long num_workers = std::max(1UL, tp.num_threads_in_pool());
-            const unsigned long block_size = std::max(1UL, (num_test_splits + num_workers - 1) / num_workers);
+            const unsigned long block_size = std::max(1UL, (end - begin + num_workers - 1) / num_workers);
+
+            // Now compute the sums of vectors that go left for each feature.  We
+            // parallelize over blocks of samples rather than over the candidate
+            // features since there are typically only a handful of candidates but
+            // arbitrarily many samples.  Each worker fills its own accumulators for
+            // every candidate and we reduce them afterwards, so no state is shared
+            // between threads.
+            std::vector<std::vector<matrix<float,0,1> > > block_left_sums(num_workers, std::vector<matrix<float,0,1> >(num_test_splits));
+            std::vector<std::vector<unsigned long> > block_left_cnt(num_workers, std::vector<unsigned long>(num_test_splits, 0));
 
-            // now compute the sums of vectors that go left for each feature
             parallel_for(tp, 0, num_workers, [&](unsigned long block)
             {
-                const unsigned long block_begin = block * block_size;
-                const unsigned long block_end   = std::min(block_begin + block_size, num_test_splits);
+                const unsigned long block_begin = begin + block * block_size;
+                const unsigned long block_end   = std::min(block_begin + block_size, end);
 
-                for (unsigned long j = begin; j < end; ++j)
+                for (unsigned long j = block_begin; j < block_end; ++j)
                 {
-                    for (unsigned long i = block_begin; i < block_end; ++i)
+                    for (unsigned long i = 0; i < num_test_splits; ++i)
                     {
                         if ((float)samples[j].feature_pixel_values[feats[i].idx1] - (float)samples[j].feature_pixel_values[feats[i].idx2] > feats[i].thresh)
                         {
-                            left_sums[i] += samples[j].diff_shape;
-                            ++left_cnt[i];
+                            block_left_sums[block][i] += samples[j].diff_shape;
+                            ++block_left_cnt[block][i];
                         }
                     }
                 }
 
             }, 1);
 
+            // reduce the per-worker accumulators
+            std::vector<matrix<float,0,1> > left_sums(num_test_splits);
+            std::vector<unsigned long> left_cnt(num_test_splits);
+            for (unsigned long block = 0; block < num_workers; ++block)
+            {
+                for (unsigned long i = 0; i < num_test_splits; ++i)
+                {
+                    if (block_left_sums[block][i].size() != 0)
+                        left_sums[i] += block_left_sums[block][i];
+                    left_cnt[i] += block_left_cnt[block][i];
+                }
+            }
+
             // now figure out which feature is the best
             double best_score = -1;
             unsigned long best_feat = 0;
@@ -777,7 +1133,8 @@ namespace dlib
         }
 
         std::vector<std::vector<dlib::vector<float,2> > > randomly_sample_pixel_coordinates (
-            const matrix<float,0,1>& initial_shape
+            const matrix<float,0,1>& initial_shape,
+            const unsigned long num_cascades
         ) const
         {
             const double padding = get_feature_pool_region_padding();
@@ -803,8 +1160,8 @@ namespace dlib
             max_y += padding;
 
             std::vector<std::vector<dlib::vector<float,2> > > pixel_coordinates;
-            pixel_coordinates.resize(get_cascade_depth());
-            for (unsigned long i = 0; i < get_cascade_depth(); ++i)
+            pixel_coordinates.resize(num_cascades);
+            for (unsigned long i = 0; i < num_cascades; ++i)
                 randomly_sample_pixel_coordinates(pixel_coordinates[i], min_x, min_y, max_x, max_y);
             return pixel_coordinates;
         }
@@ -826,6 +1183,8 @@ namespace dlib
         unsigned long _num_threads;
         padding_mode_t _padding_mode;
         double _oversampling_translation_jitter;
+        unsigned long _num_fine_tuning_cascades;
+        std::string _checkpoint_filename;
     };
 
 // ----------------------------------------------------------------------------------------
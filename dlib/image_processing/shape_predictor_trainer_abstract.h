@@ -40,7 +40,9 @@ namespace dlib
                 - #get_feature_pool_region_padding() == 0
                 - #get_random_seed() == ""
                 - #get_num_threads() == 0
-                - #get_padding_mode() == landmark_relative 
+                - #get_padding_mode() == landmark_relative
+                - #get_num_fine_tuning_cascades() == 1
+                - #get_checkpoint_file() == ""
                 - This object will not be verbose
         !*/
 
@@ -346,6 +348,51 @@ namespace dlib
                 - #get_num_threads() == num
         !*/
 
+        unsigned long get_num_fine_tuning_cascades (
+        ) const;
+        /*!
+            ensures
+                - returns the number of new cascades appended to a base model when you
+                  fine-tune it with the three argument version of train().  A value of 0
+                  means fine-tuning only refits the leaf values of the base model's
+                  existing trees.
+        !*/
+
+        void set_num_fine_tuning_cascades (
+            unsigned long num
+        );
+        /*!
+            ensures
+                - #get_num_fine_tuning_cascades() == num
+        !*/
+
+        const std::string& get_checkpoint_file (
+        ) const;
+        /*!
+            ensures
+                - returns the name of the file train() periodically saves its state to,
+                  or "" if checkpointing is disabled.
+        !*/
+
+        void set_checkpoint_file (
+            const std::string& filename
+        );
+        /*!
+            ensures
+                - #get_checkpoint_file() == filename
+                - If filename != "" then train() will save its complete state to this
+                  file each time it finishes a cascade.  Moreover, if the file already
+                  exists when train() is called then train() will resume from the state
+                  recorded in it rather than starting over, so an interrupted training
+                  run only loses the partially completed cascade it was working on.
+                  The resumed run produces exactly the same shape_predictor an
+                  uninterrupted run would have produced since the state includes the
+                  random number generator.  Note that the checkpoint is only valid for
+                  the same training dataset and random seed it was created with, and
+                  train() will throw a serialization_error if given a checkpoint that
+                  doesn't match.
+        !*/
+
         void be_verbose (
         );
         /*!
@@ -392,6 +439,44 @@ namespace dlib
                   have training instances with missing parts then set the part positions
                   equal to OBJECT_PART_NOT_PRESENT and this algorithm will basically ignore
                   those missing parts.
+                - if (get_checkpoint_file() != "") then
+                    - The state of the training process is saved to get_checkpoint_file()
+                      after each cascade is completed, and if that file already exists
+                      when train() is called then training resumes from the state in it
+                      (see set_checkpoint_file()).
+        !*/
+
+        template <typename image_array>
+        shape_predictor train (
+            const image_array& images,
+            const std::vector<std::vector<full_object_detection> >& objects,
+            const shape_predictor& base_model
+        ) const;
+        /*!
+            requires
+                - all the requirements of the two argument version of train() above.
+                - base_model.num_parts() == the number of parts in the objects
+                  annotations.
+                - base_model was trained on data annotated the same way as objects.
+            ensures
+                - Fine-tunes base_model against the given dataset rather than training a
+                  new model from scratch.  This is much faster than a full training run
+                  and is useful when you have added some new images to a large dataset
+                  and don't want to redo all the training.  In particular, this routine:
+                    - Keeps all of base_model's trees and their split features but
+                      refits each tree's leaf values against the given dataset, using
+                      the same average residual rule a normal training run uses.  This
+                      skips the expensive split search, so it costs only a feature
+                      extraction and a tree traversal per tree.  Leaves no training
+                      sample lands in keep their old values.
+                    - Then appends get_num_fine_tuning_cascades() new cascades, trained
+                      exactly like the cascades of a normal training run, to soak up
+                      whatever residual error remains.
+                - The returned model uses base_model's initial shape, so you should pass
+                  the full augmented dataset to this function, not just the new images,
+                  or the refit leaves will forget what they learned from the rest of the
+                  data.
+                - returns the fine-tuned shape_predictor.
         !*/
     };
 
@@ -26,6 +26,7 @@
 #include "image_transforms/lbp.h"
 #include "image_transforms/random_color_transform.h"
 #include "image_transforms/random_cropper.h"
+#include "image_transforms/tiled_image.h"
 
 #endif // DLIB_IMAGE_TRANSFORMs_
 
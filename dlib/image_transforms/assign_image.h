@@ -6,6 +6,8 @@
 #include "../pixel.h"
 #include "assign_image_abstract.h"
 #include "../statistics.h"
+#include "../simd.h"
+#include <limits>
 
 namespace dlib
 {
@@ -177,6 +179,185 @@ namespace dlib
         impl_assign_image_scaled(dest, mat(src),thresh);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        template <
+            typename dest_pixel_type,
+            typename src_pixel_type
+            >
+        typename disable_if_c<pixel_traits<src_pixel_type>::rgb || pixel_traits<src_pixel_type>::rgb_alpha>::type
+        assign_pixel_affine (
+            dest_pixel_type& dest,
+            const src_pixel_type& src,
+            const double gain,
+            const double offset,
+            const double lower,
+            const double upper
+        )
+        {
+            const double val = gain*get_pixel_intensity(src) + offset;
+            assign_pixel(dest, std::min(std::max(val, lower), upper));
+        }
+
+        template <
+            typename dest_pixel_type,
+            typename src_pixel_type
+            >
+        typename enable_if_c<pixel_traits<src_pixel_type>::rgb>::type
+        assign_pixel_affine (
+            dest_pixel_type& dest,
+            const src_pixel_type& src,
+            const double gain,
+            const double offset,
+            const double lower,
+            const double upper
+        )
+        {
+            // apply the transform to each color channel independently
+            rgb_pixel temp;
+            assign_pixel(temp.red,   std::min(std::max(gain*src.red   + offset, lower), upper));
+            assign_pixel(temp.green, std::min(std::max(gain*src.green + offset, lower), upper));
+            assign_pixel(temp.blue,  std::min(std::max(gain*src.blue  + offset, lower), upper));
+            assign_pixel(dest, temp);
+        }
+
+        template <
+            typename dest_pixel_type,
+            typename src_pixel_type
+            >
+        typename enable_if_c<pixel_traits<src_pixel_type>::rgb_alpha>::type
+        assign_pixel_affine (
+            dest_pixel_type& dest,
+            const src_pixel_type& src,
+            const double gain,
+            const double offset,
+            const double lower,
+            const double upper
+        )
+        {
+            // apply the transform to each color channel independently, leaving the
+            // alpha channel untouched
+            rgb_alpha_pixel temp;
+            assign_pixel(temp.red,   std::min(std::max(gain*src.red   + offset, lower), upper));
+            assign_pixel(temp.green, std::min(std::max(gain*src.green + offset, lower), upper));
+            assign_pixel(temp.blue,  std::min(std::max(gain*src.blue  + offset, lower), upper));
+            temp.alpha = src.alpha;
+            assign_pixel(dest, temp);
+        }
+
+        template <
+            typename dest_image_type,
+            typename src_image_type
+            >
+        void impl_assign_image_affine (
+            image_view<dest_image_type>& dest,
+            const const_image_view<src_image_type>& src,
+            const double gain,
+            const double offset,
+            const double lower,
+            const double upper
+        )
+        {
+            for (long r = 0; r < src.nr(); ++r)
+            {
+                for (long c = 0; c < src.nc(); ++c)
+                {
+                    assign_pixel_affine(dest[r][c], src[r][c], gain, offset, lower, upper);
+                }
+            }
+        }
+
+        template <
+            typename dest_image_type,
+            typename src_image_type
+            >
+        typename enable_if_c<is_same_type<typename image_traits<dest_image_type>::pixel_type,float>::value &&
+                             is_same_type<typename image_traits<src_image_type>::pixel_type,float>::value>::type
+        impl_assign_image_affine_dispatch (
+            image_view<dest_image_type>& dest,
+            const const_image_view<src_image_type>& src,
+            const double gain,
+            const double offset,
+            const double lower,
+            const double upper
+        )
+        {
+            // Both images hold flat rows of floats so we can stream each row through
+            // simd registers and fuse the multiply, add, and clamp into one pass.
+            const simd8f g((float)gain);
+            const simd8f o((float)offset);
+            const simd8f lo((float)lower);
+            const simd8f hi((float)upper);
+            for (long r = 0; r < src.nr(); ++r)
+            {
+                long c = 0;
+                for (; c < src.nc()-7; c+=8)
+                {
+                    simd8f p;
+                    p.load(&src[r][c]);
+                    p = min(max(p*g+o, lo), hi);
+                    p.store(&dest[r][c]);
+                }
+                for (; c < src.nc(); ++c)
+                {
+                    const float val = (float)gain*src[r][c] + (float)offset;
+                    dest[r][c] = std::min(std::max(val, (float)lower), (float)upper);
+                }
+            }
+        }
+
+        template <
+            typename dest_image_type,
+            typename src_image_type
+            >
+        typename disable_if_c<is_same_type<typename image_traits<dest_image_type>::pixel_type,float>::value &&
+                              is_same_type<typename image_traits<src_image_type>::pixel_type,float>::value>::type
+        impl_assign_image_affine_dispatch (
+            image_view<dest_image_type>& dest,
+            const const_image_view<src_image_type>& src,
+            const double gain,
+            const double offset,
+            const double lower,
+            const double upper
+        )
+        {
+            impl_assign_image_affine(dest, src, gain, offset, lower, upper);
+        }
+    }
+
+    template <
+        typename dest_image_type,
+        typename src_image_type
+        >
+    void assign_image_affine (
+        dest_image_type& dest_,
+        const src_image_type& src_,
+        const double gain,
+        const double offset,
+        const double lower = -std::numeric_limits<double>::infinity(),
+        const double upper = std::numeric_limits<double>::infinity()
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT( lower <= upper,
+            "\tvoid assign_image_affine()"
+            << "\n\t You have given an invalid clipping range."
+            << "\n\t lower: " << lower
+            << "\n\t upper: " << upper
+            );
+
+        // Transforming an image in place is fine since each output pixel depends only
+        // on the input pixel at the same location.
+        if (!is_same_object(dest_, src_))
+            set_image_size(dest_, num_rows(src_), num_columns(src_));
+
+        image_view<dest_image_type> dest(dest_);
+        const_image_view<src_image_type> src(src_);
+        impl::impl_assign_image_affine_dispatch(dest, src, gain, offset, lower, upper);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -88,6 +88,48 @@ namespace dlib
                       The scaled pixel is then stored in dest_img[r][c].
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename dest_image_type,
+        typename src_image_type
+        >
+    void assign_image_affine (
+        dest_image_type& dest_img,
+        const src_image_type& src_img,
+        const double gain,
+        const double offset,
+        const double lower = -std::numeric_limits<double>::infinity(),
+        const double upper = std::numeric_limits<double>::infinity()
+    );
+    /*!
+        requires
+            - src_image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+            - dest_image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+            - lower <= upper
+        ensures
+            - #dest_img.nc() == src_img.nc()
+            - #dest_img.nr() == src_img.nr()
+            - Applies the affine transform gain*P + offset to each pixel P of src_img,
+              clamps the result to the range [lower, upper], and stores it into dest_img
+              using assign_pixel().  The multiply, add, and clamp all happen in a single
+              pass over the image, so this is a faster way to perform normalization
+              chains such as assign_image(out, (mat(in) - mean)*scale) which would
+              otherwise touch the image once per operation.
+            - if (src_img contains RGB or RGB-alpha pixels) then
+                - the transform is applied to each color channel independently and the
+                  alpha channel, when present, is copied through unmodified.
+            - else
+                - the transform is applied to get_pixel_intensity(src_img[r][c]).
+            - Note that storing the clamped value into dest_img still saturates to the
+              destination pixel's dynamic range, just like assign_pixel() always does.
+              The lower and upper arguments simply allow a tighter clipping range.
+            - It is safe for dest_img and src_img to be the same object, in which case
+              the transform happens in place.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <
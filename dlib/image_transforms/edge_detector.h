@@ -7,6 +7,9 @@
 #include "../pixel.h"
 #include "../array2d.h"
 #include "../geometry.h"
+#include "../matrix.h"
+#include "../simd.h"
+#include "../threads.h"
 #include <vector>
 #include "../image_keypoint/build_separable_poly_filters.h"
 
@@ -295,6 +298,154 @@ namespace dlib
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename in_image_type,
+        typename out_image_type
+        >
+    void sobel_edge_map (
+        const in_image_type& in_img_,
+        out_image_type& out_img_
+    )
+    {
+        DLIB_ASSERT( !is_same_object(in_img_,out_img_),
+            "\tvoid sobel_edge_map(in_img_, out_img_)"
+            << "\n\t out_img can't be the same as the input image."
+            << "\n\t is_same_object(in_img_,out_img_): " << is_same_object(in_img_,out_img_)
+            );
+
+        const_image_view<in_image_type> in_img(in_img_);
+        image_view<out_image_type> out_img(out_img_);
+
+        // if there isn't any input image then don't do anything
+        if (in_img.size() == 0)
+        {
+            out_img.clear();
+            return;
+        }
+
+        out_img.set_size(in_img.nr(), in_img.nc());
+        zero_border_pixels(out_img,1,1);
+
+        const long nr = in_img.nr();
+        const long nc = in_img.nc();
+        // if the whole output is border pixels then we are already done
+        if (nr < 3 || nc < 3)
+            return;
+
+        auto process_rows = [&](long row_begin, long row_end)
+        {
+            // Rolling row buffers, indexed by absolute row number mod 3, holding the
+            // input intensities, the two sobel gradients, and the squared gradient
+            // magnitude.  This lets us fuse the gradient computation with the
+            // non-maximum suppression without ever materializing a full gradient image.
+            matrix<float> inten(3,nc), horz(3,nc), vert(3,nc), val(3,nc);
+
+            long next_intensity_row = std::max(row_begin-2, 0L);
+            auto load_intensity_rows_through = [&](long r)
+            {
+                for (; next_intensity_row <= std::min(r,nr-1); ++next_intensity_row)
+                {
+                    float* buf = &inten(next_intensity_row%3, 0);
+                    for (long c = 0; c < nc; ++c)
+                        buf[c] = (float)get_pixel_intensity(in_img[next_intensity_row][c]);
+                }
+            };
+
+            auto compute_gradient_row = [&](long g)
+            {
+                float* h = &horz(g%3,0);
+                float* v = &vert(g%3,0);
+                float* m = &val(g%3,0);
+                // gradients on the border are defined to be 0
+                if (g <= 0 || g >= nr-1)
+                {
+                    for (long c = 0; c < nc; ++c)
+                    {
+                        h[c] = 0;
+                        v[c] = 0;
+                        m[c] = 0;
+                    }
+                    return;
+                }
+                load_intensity_rows_through(g+1);
+                const float* top = &inten((g-1)%3,0);
+                const float* mid = &inten(g%3,0);
+                const float* bot = &inten((g+1)%3,0);
+                h[0] = v[0] = m[0] = 0;
+                h[nc-1] = v[nc-1] = m[nc-1] = 0;
+                long c = 1;
+                for (; c+8 <= nc-1; c += 8)
+                {
+                    simd8f tl,tm,tr, ml,mr, bl,bm,br;
+                    tl.load(top+c-1); tm.load(top+c); tr.load(top+c+1);
+                    ml.load(mid+c-1);                 mr.load(mid+c+1);
+                    bl.load(bot+c-1); bm.load(bot+c); br.load(bot+c+1);
+                    const simd8f hh = (tr-tl) + 2.0f*(mr-ml) + (br-bl);
+                    const simd8f vv = (bl-tl) + 2.0f*(bm-tm) + (br-tr);
+                    const simd8f mm = hh*hh + vv*vv;
+                    hh.store(h+c);
+                    vv.store(v+c);
+                    mm.store(m+c);
+                }
+                for (; c < nc-1; ++c)
+                {
+                    const float hh = (top[c+1]-top[c-1]) + 2*(mid[c+1]-mid[c-1]) + (bot[c+1]-bot[c-1]);
+                    const float vv = (bot[c-1]-top[c-1]) + 2*(bot[c]-top[c]) + (bot[c+1]-top[c+1]);
+                    h[c] = hh;
+                    v[c] = vv;
+                    m[c] = hh*hh + vv*vv;
+                }
+            };
+
+            auto nms_row = [&](long r)
+            {
+                const float* m0 = &val((r-1)%3,0);
+                const float* m1 = &val(r%3,0);
+                const float* m2 = &val((r+1)%3,0);
+                const float* h = &horz(r%3,0);
+                const float* v = &vert(r%3,0);
+                const unsigned char zero = 0;
+                for (long c = 1; c < nc-1; ++c)
+                {
+                    const float cur = m1[c];
+                    // Quantize the orientation in integer arithmetic, just like the two
+                    // pass pipeline does for integer pixel types.
+                    const char ori = edge_orientation((long)v[c], (long)h[c]);
+                    bool suppressed;
+                    switch (ori)
+                    {
+                        case '-':  suppressed = (m0[c]   > cur || m2[c]   > cur); break;
+                        case '|':  suppressed = (m1[c-1] > cur || m1[c+1] > cur); break;
+                        case '/':  suppressed = (m0[c-1] > cur || m2[c+1] > cur); break;
+                        default:   suppressed = (m2[c-1] > cur || m0[c+1] > cur); break; // '\'
+                    }
+                    if (suppressed)
+                        assign_pixel(out_img[r][c], zero);
+                    else
+                        assign_pixel(out_img[r][c], std::sqrt((double)cur));
+                }
+            };
+
+            compute_gradient_row(row_begin-1);
+            compute_gradient_row(row_begin);
+            for (long r = row_begin; r < row_end; ++r)
+            {
+                compute_gradient_row(r+1);
+                nms_row(r);
+            }
+        };
+
+        // Tile the rows onto the default thread pool, but only when the image is big
+        // enough for the threading overhead to pay for itself.  Each tile recomputes at
+        // most two gradient rows already handled by its neighbor.
+        if ((nr-2)*nc < 128*128)
+            process_rows(1, nr-1);
+        else
+            parallel_for_blocked(1, nr-1, process_rows);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
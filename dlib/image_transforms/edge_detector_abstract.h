@@ -104,7 +104,40 @@ namespace dlib
                 - else
                     - performs assign_pixel(#out_img[r][c], 0)
     !*/
-    
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename in_image_type,
+        typename out_image_type
+        >
+    void sobel_edge_map (
+        const in_image_type& in_img,
+        out_image_type& out_img
+    );
+    /*!
+        requires
+            - in_image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+            - out_image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+            - is_same_object(in_img, out_img) == false
+        ensures
+            - #out_img.nr() == in_img.nr()
+            - #out_img.nc() == in_img.nc()
+            - Computes the same non-maximum suppressed edge map you would get by running
+              sobel_edge_detector() on in_img and handing the two gradient images to
+              suppress_non_maximum_edges(), but fuses the gradient computation, squared
+              magnitude, orientation quantization, and suppression tests into a single
+              row-tiled sweep over the image that never materializes the intermediate
+              gradient images.  Large images are processed in parallel on the default
+              thread pool.
+            - For images with 8 bit pixels the output is identical to the two pass
+              pipeline described above.  For wider integer or floating point pixel types
+              the internal arithmetic is carried out in single precision floats, so the
+              output can differ from the two pass pipeline by floating point rounding.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -5,9 +5,11 @@
 
 #include "../pixel.h"
 #include "equalize_histogram_abstract.h"
+#include <algorithm>
 #include <vector>
 #include "../enable_if.h"
 #include "../matrix.h"
+#include "../threads.h"
 
 namespace dlib
 {
@@ -163,7 +165,7 @@ namespace dlib
     }
 
     template <
-        typename image_type 
+        typename image_type
         >
     void equalize_histogram (
         image_type& img
@@ -172,6 +174,206 @@ namespace dlib
         equalize_histogram(img,img);
     }
 
+// ---------------------------------------------------------------------------------------
+
+    template <
+        typename in_image_type,
+        typename out_image_type
+        >
+    void equalize_histogram_adaptive (
+        const in_image_type& in_img_,
+        out_image_type& out_img_,
+        double clip_limit = 4.0,
+        unsigned long tiles_nr = 8,
+        unsigned long tiles_nc = 8
+    )
+    {
+        const_image_view<in_image_type> in_img(in_img_);
+        image_view<out_image_type> out_img(out_img_);
+
+        typedef typename image_traits<in_image_type>::pixel_type in_pixel_type;
+        typedef typename image_traits<out_image_type>::pixel_type out_pixel_type;
+
+        COMPILE_TIME_ASSERT( pixel_traits<in_pixel_type>::has_alpha == false );
+        COMPILE_TIME_ASSERT( pixel_traits<out_pixel_type>::has_alpha == false );
+
+        COMPILE_TIME_ASSERT( pixel_traits<in_pixel_type>::is_unsigned == true );
+        COMPILE_TIME_ASSERT( pixel_traits<out_pixel_type>::is_unsigned == true );
+
+        typedef typename pixel_traits<in_pixel_type>::basic_pixel_type in_image_basic_pixel_type;
+        COMPILE_TIME_ASSERT( sizeof(in_image_basic_pixel_type) <= 2);
+
+        DLIB_ASSERT(clip_limit >= 1 && tiles_nr >= 1 && tiles_nc >= 1,
+            "\tvoid equalize_histogram_adaptive()"
+            << "\n\t Invalid inputs were given to this function."
+            << "\n\t clip_limit: " << clip_limit
+            << "\n\t tiles_nr:   " << tiles_nr
+            << "\n\t tiles_nc:   " << tiles_nc
+            );
+
+        // if there isn't any input image then don't do anything
+        if (in_img.size() == 0)
+        {
+            out_img.clear();
+            return;
+        }
+
+        out_img.set_size(in_img.nr(),in_img.nc());
+
+        const long nr = in_img.nr();
+        const long nc = in_img.nc();
+
+        // never use more tiles than there are pixels to put in them
+        const long tr = static_cast<long>(std::min<unsigned long>(tiles_nr, nr));
+        const long tc = static_cast<long>(std::min<unsigned long>(tiles_nc, nc));
+
+        const long num_bins = static_cast<long>(pixel_traits<in_pixel_type>::max())+1;
+        const double out_max = pixel_traits<out_pixel_type>::max();
+
+        // Build one clipped equalization lookup table per tile.  Each tile is
+        // independent so this parallelizes cleanly.
+        std::vector<std::vector<float> > luts(tr*tc);
+        parallel_for(0, tr*tc, [&](long t)
+        {
+            const long ty = t/tc;
+            const long tx = t%tc;
+            const long first_row = ty*nr/tr;
+            const long last_row  = (ty+1)*nr/tr;
+            const long first_col = tx*nc/tc;
+            const long last_col  = (tx+1)*nc/tc;
+
+            std::vector<unsigned long> hist(num_bins, 0);
+            for (long r = first_row; r < last_row; ++r)
+            {
+                for (long c = first_col; c < last_col; ++c)
+                    ++hist[get_pixel_intensity(in_img[r][c])];
+            }
+
+            const unsigned long area = (last_row-first_row)*(last_col-first_col);
+
+            // Clip the histogram and spread the clipped mass uniformly over all
+            // the bins.  This is what limits how much any one intensity can be
+            // stretched and therefore how much noise gets amplified.
+            const unsigned long clip = std::max<unsigned long>(1,
+                static_cast<unsigned long>(clip_limit*area/num_bins));
+            unsigned long excess = 0;
+            for (long i = 0; i < num_bins; ++i)
+            {
+                if (hist[i] > clip)
+                {
+                    excess += hist[i] - clip;
+                    hist[i] = clip;
+                }
+            }
+            const unsigned long bonus = excess/num_bins;
+            const unsigned long leftover = excess%num_bins;
+            for (long i = 0; i < num_bins; ++i)
+                hist[i] += bonus + (static_cast<unsigned long>(i) < leftover ? 1 : 0);
+
+            // turn the histogram into a scaled cumulative distribution function
+            std::vector<float>& lut = luts[t];
+            lut.resize(num_bins);
+            const double scale = out_max/area;
+            unsigned long sum = 0;
+            for (long i = 0; i < num_bins; ++i)
+            {
+                sum += hist[i];
+                lut[i] = static_cast<float>(sum*scale);
+            }
+        });
+
+        // centers of the tiles, used to interpolate between neighboring tiles
+        std::vector<double> center_r(tr), center_c(tc);
+        for (long ty = 0; ty < tr; ++ty)
+            center_r[ty] = (ty*nr/tr + (ty+1)*nr/tr - 1)/2.0;
+        for (long tx = 0; tx < tc; ++tx)
+            center_c[tx] = (tx*nc/tc + (tx+1)*nc/tc - 1)/2.0;
+
+        // Precompute, for every column, which two tile columns it falls between
+        // and how much weight the right one gets.
+        std::vector<long> tx0(nc), tx1(nc);
+        std::vector<float> wx(nc);
+        for (long c = 0; c < nc; ++c)
+        {
+            if (c <= center_c[0])
+            {
+                tx0[c] = tx1[c] = 0;
+                wx[c] = 0;
+            }
+            else if (c >= center_c[tc-1])
+            {
+                tx0[c] = tx1[c] = tc-1;
+                wx[c] = 0;
+            }
+            else
+            {
+                long k = 0;
+                while (c >= center_c[k+1])
+                    ++k;
+                tx0[c] = k;
+                tx1[c] = k+1;
+                wx[c] = static_cast<float>((c-center_c[k])/(center_c[k+1]-center_c[k]));
+            }
+        }
+
+        // Now map every pixel through a bilinear blend of the four surrounding
+        // tile tables.  Rows are independent of each other.
+        parallel_for(0, nr, [&](long r)
+        {
+            long ty0, ty1;
+            float wy;
+            if (r <= center_r[0])
+            {
+                ty0 = ty1 = 0;
+                wy = 0;
+            }
+            else if (r >= center_r[tr-1])
+            {
+                ty0 = ty1 = tr-1;
+                wy = 0;
+            }
+            else
+            {
+                long k = 0;
+                while (r >= center_r[k+1])
+                    ++k;
+                ty0 = k;
+                ty1 = k+1;
+                wy = static_cast<float>((r-center_r[k])/(center_r[k+1]-center_r[k]));
+            }
+
+            for (long c = 0; c < nc; ++c)
+            {
+                const unsigned long p = get_pixel_intensity(in_img[r][c]);
+                const std::vector<float>& lut00 = luts[ty0*tc + tx0[c]];
+                const std::vector<float>& lut01 = luts[ty0*tc + tx1[c]];
+                const std::vector<float>& lut10 = luts[ty1*tc + tx0[c]];
+                const std::vector<float>& lut11 = luts[ty1*tc + tx1[c]];
+
+                const float top    = lut00[p] + (lut01[p]-lut00[p])*wx[c];
+                const float bottom = lut10[p] + (lut11[p]-lut10[p])*wx[c];
+                const float value  = top + (bottom-top)*wy;
+
+                assign_pixel(out_img[r][c], in_img[r][c]);
+                assign_pixel_intensity(out_img[r][c],
+                    static_cast<unsigned long>(value + 0.5f));
+            }
+        });
+    }
+
+    template <
+        typename image_type
+        >
+    void equalize_histogram_adaptive (
+        image_type& img,
+        double clip_limit = 4.0,
+        unsigned long tiles_nr = 8,
+        unsigned long tiles_nc = 8
+    )
+    {
+        equalize_histogram_adaptive(img,img,clip_limit,tiles_nr,tiles_nc);
+    }
+
 // ---------------------------------------------------------------------------------------
 
 }
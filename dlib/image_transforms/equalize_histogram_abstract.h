@@ -39,7 +39,7 @@ namespace dlib
     !*/
 
     template <
-        typename image_type 
+        typename image_type
         >
     void equalize_histogram (
         image_type& img
@@ -51,6 +51,71 @@ namespace dlib
             - calls equalize_histogram(img,img);
     !*/
 
+// ---------------------------------------------------------------------------------------
+
+    template <
+        typename in_image_type,
+        typename out_image_type
+        >
+    void equalize_histogram_adaptive (
+        const in_image_type& in_img,
+        out_image_type& out_img,
+        double clip_limit = 4.0,
+        unsigned long tiles_nr = 8,
+        unsigned long tiles_nc = 8
+    );
+    /*!
+        requires
+            - in_image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+            - out_image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+            - Let pixel_type be the type of pixel in either input or output images, then we
+              must have:
+                - pixel_traits<pixel_type>::has_alpha == false
+                - pixel_traits<pixel_type>::is_unsigned == true
+            - For the input image pixel type, we have the additional requirement that:
+                - pixel_traits<pixel_type>::max() <= 65535
+            - clip_limit >= 1
+            - tiles_nr >= 1
+            - tiles_nc >= 1
+        ensures
+            - #out_img == the adaptively histogram equalized version of in_img.  That
+              is, this function performs contrast limited adaptive histogram
+              equalization (CLAHE).  The image is divided into a grid of
+              tiles_nr by tiles_nc tiles and a histogram equalization transform is
+              computed for each tile.  Each output pixel is then mapped through a
+              bilinear blend of the transforms of the four tiles nearest to it, which
+              avoids visible seams at tile borders.  Unlike equalize_histogram(),
+              which uses one global transform, this adapts the contrast enhancement
+              to each local region of the image.
+            - Each tile's histogram is clipped at clip_limit times the uniform bin
+              count before the transform is computed, with the clipped mass spread
+              evenly over all bins.  Larger values of clip_limit therefore allow
+              stronger contrast amplification while smaller values suppress noise in
+              flat regions.  A clip_limit of 1 produces no contrast change at all.
+            - #out_img.nc() == in_img.nc()
+            - #out_img.nr() == in_img.nr()
+            - This function spreads its work over the default thread pool, with each
+              tile and each image row processed independently.
+    !*/
+
+    template <
+        typename image_type
+        >
+    void equalize_histogram_adaptive (
+        image_type& img,
+        double clip_limit = 4.0,
+        unsigned long tiles_nr = 8,
+        unsigned long tiles_nc = 8
+    );
+    /*!
+        requires
+            - it is valid to call equalize_histogram_adaptive(img,img,clip_limit,tiles_nr,tiles_nc)
+        ensures
+            - calls equalize_histogram_adaptive(img,img,clip_limit,tiles_nr,tiles_nc);
+    !*/
+
 // ---------------------------------------------------------------------------------------
 
     template <
@@ -291,7 +291,8 @@ namespace dlib
         }
 
         template <typename image_type>
-        inline typename dlib::disable_if_c<pixel_traits<typename image_type::pixel_type>::rgb>::type get_gradient (
+        inline typename dlib::disable_if_c<pixel_traits<typename image_type::pixel_type>::rgb ||
+                                           is_same_type<typename image_type::pixel_type,unsigned char>::value>::type get_gradient (
             int r,
             int c,
             const image_type& img,
@@ -300,7 +301,7 @@ namespace dlib
             simd4f& len
         )
         {
-            simd4i left((int)get_pixel_intensity(img[r][c-1]), 
+            simd4i left((int)get_pixel_intensity(img[r][c-1]),
                         (int)get_pixel_intensity(img[r][c]),
                         (int)get_pixel_intensity(img[r][c+1]),
                         (int)get_pixel_intensity(img[r][c+2]));
@@ -327,7 +328,8 @@ namespace dlib
         // ------------------------------------------------------------------------------------
 
         template <typename image_type>
-        inline typename dlib::disable_if_c<pixel_traits<typename image_type::pixel_type>::rgb>::type get_gradient(
+        inline typename dlib::disable_if_c<pixel_traits<typename image_type::pixel_type>::rgb ||
+                                           is_same_type<typename image_type::pixel_type,unsigned char>::value>::type get_gradient(
             int r,
             int c,
             const image_type& img,
@@ -375,7 +377,59 @@ namespace dlib
 
             len = (grad_x*grad_x + grad_y*grad_y);
         }
-        
+
+        // ------------------------------------------------------------------------------------
+
+        // For plain 8bit grayscale images (what most monochrome cameras output) each row
+        // of pixels is just a contiguous array of bytes.  So rather than gathering the
+        // pixels one at a time like the generic versions above do, we load each group of
+        // neighboring pixels with a single byte load that zero extends them into the
+        // simd lanes.
+
+        template <typename image_type>
+        inline typename dlib::enable_if_c<is_same_type<typename image_type::pixel_type,unsigned char>::value>::type get_gradient (
+            int r,
+            int c,
+            const image_type& img,
+            simd4f& grad_x,
+            simd4f& grad_y,
+            simd4f& len
+        )
+        {
+            simd4i left, right, top, bottom;
+            left.load(&img[r][c-1]);
+            right.load(&img[r][c+1]);
+            top.load(&img[r-1][c]);
+            bottom.load(&img[r+1][c]);
+
+            grad_x = right-left;
+            grad_y = bottom-top;
+
+            len = (grad_x*grad_x + grad_y*grad_y);
+        }
+
+        template <typename image_type>
+        inline typename dlib::enable_if_c<is_same_type<typename image_type::pixel_type,unsigned char>::value>::type get_gradient (
+            int r,
+            int c,
+            const image_type& img,
+            simd8f& grad_x,
+            simd8f& grad_y,
+            simd8f& len
+        )
+        {
+            simd8i left, right, top, bottom;
+            left.load(&img[r][c-1]);
+            right.load(&img[r][c+1]);
+            top.load(&img[r-1][c]);
+            bottom.load(&img[r+1][c]);
+
+            grad_x = right-left;
+            grad_y = bottom-top;
+
+            len = (grad_x*grad_x + grad_y*grad_y);
+        }
+
         // ------------------------------------------------------------------------------------
 
         template <typename T, typename mm1, typename mm2>
@@ -958,11 +1012,14 @@ namespace dlib
             // compute energy in each block by summing over orientations
             for (int r = 0; r < cells_nr; ++r)
             {
+                const matrix<float,18,1>* hrow = hist.row_ptr(r+1);
+                float* nrow = norm.row_ptr(r);
                 for (int c = 0; c < cells_nc; ++c)
                 {
-                    for (int o = 0; o < 9; o++) 
+                    for (int o = 0; o < 9; o++)
                     {
-                        norm[r][c] += (hist[r+1][c+1](o) + hist[r+1][c+1](o+9)) * (hist[r+1][c+1](o) + hist[r+1][c+1](o+9));
+                        const float temp = hrow[c+1](o) + hrow[c+1](o+9);
+                        nrow[c] += temp*temp;
                     }
                 }
             }
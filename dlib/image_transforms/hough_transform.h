@@ -7,8 +7,10 @@
 #include "../image_processing/generic_image.h"
 #include "../geometry.h"
 #include "../algs.h"
+#include "../threads.h"
 #include "assign_image.h"
 #include <limits>
+#include <mutex>
 
 namespace dlib
 {
@@ -290,11 +292,42 @@ namespace dlib
             himg.set_size(size(), size());
             assign_all_pixels(himg, 0);
 
-            auto record_hit = [&](const point& hough_point, const point& /*img_point*/, const in_pixel_type& val)
+            const rectangle area = box.intersect(get_rect(img));
+
+            thread_pool& tp = default_thread_pool();
+            if (tp.num_threads_in_pool() > 1 && area.height() >= 32)
             {
-                himg[hough_point.y()][hough_point.x()] += val;
-            };
-            perform_generic_hough_transform(img_, box, record_hit);
+                // Tile-parallel voting: each worker accumulates the votes from a band
+                // of image rows into its own accumulator and the accumulators are then
+                // summed into himg.  The merge is a simple pass over contiguous arrays
+                // so the compiler can vectorize it.
+                std::mutex m;
+                parallel_for_blocked(tp, area.top(), area.bottom()+1, [&](long top, long bottom)
+                {
+                    matrix<out_pixel_type> acc(size(), size());
+                    acc = 0;
+                    auto record_hit = [&](const point& hough_point, const point& /*img_point*/, const in_pixel_type& val)
+                    {
+                        acc(hough_point.y(), hough_point.x()) += val;
+                    };
+                    perform_hough_voting(img, box, record_hit, top, bottom-1);
+
+                    std::lock_guard<std::mutex> lock(m);
+                    for (long r = 0; r < acc.nr(); ++r)
+                    {
+                        for (long c = 0; c < acc.nc(); ++c)
+                            himg[r][c] += acc(r,c);
+                    }
+                });
+            }
+            else
+            {
+                auto record_hit = [&](const point& hough_point, const point& /*img_point*/, const in_pixel_type& val)
+                {
+                    himg[hough_point.y()][hough_point.x()] += val;
+                };
+                perform_hough_voting(img, box, record_hit, area.top(), area.bottom());
+            }
         }
 
         template <
@@ -409,15 +442,22 @@ namespace dlib
             DLIB_CASSERT(angle_nms_thresh >= 0)
             DLIB_CASSERT(radius_nms_thresh >= 0)
 
-            std::vector<std::pair<double,point>> initial_lines;
-            for (long r = 0; r < himg.nr(); ++r)
+            // Scan for cells above threshold.  Each row goes into its own bucket so the
+            // rows can be scanned in parallel while initial_lines still comes out in
+            // the same row-major order a serial scan would produce.
+            std::vector<std::vector<std::pair<double,point>>> row_lines(himg.nr());
+            parallel_for(0, himg.nr(), [&](long r)
             {
                 for (long c = 0; c < himg.nc(); ++c)
                 {
                     if (himg[r][c] >= hough_count_threshold)
-                        initial_lines.emplace_back(himg[r][c], point(c,r));
+                        row_lines[r].emplace_back(himg[r][c], point(c,r));
                 }
-            }
+            });
+
+            std::vector<std::pair<double,point>> initial_lines;
+            for (auto& row : row_lines)
+                initial_lines.insert(initial_lines.end(), row.begin(), row.end());
 
 
             std::vector<point> final_lines;
@@ -488,11 +528,51 @@ namespace dlib
             const_image_view<in_image_type> img(img_);
 
 
+            const rectangle area = box.intersect(get_rect(img));
+            perform_hough_voting(img, box, record_hit, area.top(), area.bottom());
+        }
+
+        template <
+            typename in_image_type,
+            typename record_hit_function_type
+            >
+        void perform_generic_hough_transform (
+            const in_image_type& img_,
+            record_hit_function_type record_hit
+        ) const
+        {
+            rectangle box(0,0, num_columns(img_)-1, num_rows(img_)-1);
+            perform_generic_hough_transform(img_, box, record_hit);
+        }
+
+    private:
+
+        template <
+            typename in_image_type,
+            typename record_hit_function_type
+            >
+        void perform_hough_voting (
+            const const_image_view<in_image_type>& img,
+            const rectangle& box,
+            record_hit_function_type& record_hit,
+            const long row_top,
+            const long row_bottom
+        ) const
+        /*!
+            requires
+                - [row_top, row_bottom] is contained inside box.intersect(get_rect(img))
+                  or is an empty range.
+            ensures
+                - performs the voting loop of perform_generic_hough_transform() for the
+                  image rows row_top though row_bottom.  Breaking the rows out like this
+                  lets operator() vote on bands of the image in parallel.
+        !*/
+        {
             const rectangle area = box.intersect(get_rect(img));
 
             const long max_n8 = (size()/8)*8;
             const long max_n4 = (size()/4)*4;
-            for (long r = area.top(); r <= area.bottom(); ++r)
+            for (long r = row_top; r <= row_bottom; ++r)
             {
                 const int32* ysin_base = &ysin_theta(r-box.top(),0);
                 for (long c = area.left(); c <= area.right(); ++c)
@@ -565,21 +645,6 @@ namespace dlib
             }
         }
 
-        template <
-            typename in_image_type,
-            typename record_hit_function_type
-            >
-        void perform_generic_hough_transform (
-            const in_image_type& img_,
-            record_hit_function_type record_hit
-        ) const
-        {
-            rectangle box(0,0, num_columns(img_)-1, num_rows(img_)-1);
-            perform_generic_hough_transform(img_, box, record_hit);
-        }
-        
-    private:
-
         unsigned long _size;
         unsigned long even_size; // equal to _size if _size is even, otherwise equal to _size-1.
         matrix<int32> xcos_theta, ysin_theta;
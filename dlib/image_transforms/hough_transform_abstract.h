@@ -172,6 +172,10 @@ namespace dlib
                   y-axis the distance of the line from the center of the box.  The
                   conversion between Hough coordinates and angle and pixel distance can be
                   obtained by calling get_line_properties().
+                - On larger inputs the voting is performed in parallel using the
+                  default_thread_pool(), with each worker accumulating a band of image
+                  rows into its own accumulator.  For images with integer pixel types
+                  the output is identical to a serial transform.
         !*/
 
         template <
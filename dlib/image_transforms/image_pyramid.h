@@ -7,7 +7,11 @@
 #include "../pixel.h"
 #include "../array2d.h"
 #include "../geometry.h"
+#include "../simd.h"
+#include "../array.h"
 #include "spatial_filtering.h"
+#include "assign_image.h"
+#include <vector>
 
 namespace dlib
 {
@@ -237,38 +241,27 @@ namespace dlib
                 typedef typename image_traits<U>::pixel_type U_pix;
                 const static bool value = pixel_traits<T_pix>::rgb && pixel_traits<U_pix>::rgb;
             };
-        public:
 
+            template <typename T, typename U>
+            struct both_views_are_8bit_gray
+            {
+                const static bool value = is_same_type<typename T::pixel_type,unsigned char>::value &&
+                                          is_same_type<typename U::pixel_type,unsigned char>::value;
+            };
+
+            // This is the general purpose form of the grayscale downsampler.  It
+            // handles any non-RGB pixel type.
             template <
-                typename in_image_type,
-                typename out_image_type
+                typename image_view_type1,
+                typename image_view_type2
                 >
-            typename disable_if<both_images_rgb<in_image_type,out_image_type> >::type operator() (
-                const in_image_type& original_,
-                out_image_type& down_
+            typename disable_if<both_views_are_8bit_gray<image_view_type1,image_view_type2> >::type
+            downsample_gray (
+                const image_view_type1& original,
+                image_view_type2& down
             ) const
             {
-                // make sure requires clause is not broken
-                DLIB_ASSERT( is_same_object(original_, down_) == false, 
-                            "\t void pyramid_down_2_1::operator()"
-                            << "\n\t is_same_object(original_, down_): " << is_same_object(original_, down_) 
-                            << "\n\t this:                           " << this
-                            );
-
-                typedef typename image_traits<in_image_type>::pixel_type in_pixel_type;
-                typedef typename image_traits<out_image_type>::pixel_type out_pixel_type;
-                COMPILE_TIME_ASSERT( pixel_traits<in_pixel_type>::has_alpha == false );
-                COMPILE_TIME_ASSERT( pixel_traits<out_pixel_type>::has_alpha == false );
-
-                const_image_view<in_image_type> original(original_);
-                image_view<out_image_type> down(down_);
-
-                if (original.nr() <= 8 || original.nc() <= 8)
-                {
-                    down.clear();
-                    return;
-                }
-
+                typedef typename image_view_type1::pixel_type in_pixel_type;
                 typedef typename pixel_traits<in_pixel_type>::basic_pixel_type bp_type;
                 typedef typename promote<bp_type>::type ptype;
                 array2d<ptype> temp_img;
@@ -303,7 +296,7 @@ namespace dlib
                         pix2 *= 4;
                         pix3 *= 6;
                         pix4 *= 4;
-                        
+
                         assign_pixel(temp_img[r][c], pix1 + pix2 + pix3 + pix4 + pix5);
                         oc += 2;
                     }
@@ -316,11 +309,11 @@ namespace dlib
                 {
                     for (long c = 0; c < temp_img.nc(); ++c)
                     {
-                        ptype temp = temp_img[r-2][c] + 
-                                    temp_img[r-1][c]*4 +  
-                                    temp_img[r  ][c]*6 +  
-                                    temp_img[r+1][c]*4 +  
-                                    temp_img[r+2][c];  
+                        ptype temp = temp_img[r-2][c] +
+                                    temp_img[r-1][c]*4 +
+                                    temp_img[r  ][c]*6 +
+                                    temp_img[r+1][c]*4 +
+                                    temp_img[r+2][c];
 
                         assign_pixel(down[dr][c],temp/256);
                     }
@@ -329,14 +322,131 @@ namespace dlib
 
             }
 
-        private:
-            struct rgbptype 
+            // This overload is a SIMD fixed point fast path for 8 bit grayscale
+            // images.  It computes exactly the same integer filter responses as the
+            // general version above, just 8 pixels at a time.
+            template <
+                typename image_view_type1,
+                typename image_view_type2
+                >
+            typename enable_if<both_views_are_8bit_gray<image_view_type1,image_view_type2> >::type
+            downsample_gray (
+                const image_view_type1& original,
+                image_view_type2& down
+            ) const
             {
-                uint16 red;
-                uint16 green;
-                uint16 blue;
-            };
+                array2d<int32> temp_img;
+                temp_img.set_size(original.nr(), (original.nc()-3)/2);
+                down.set_size((original.nr()-3)/2, (original.nc()-3)/2);
+
+                // Apply the row filter.  We compute the filter response at every
+                // column and then keep every other result.  That does twice the
+                // arithmetic we strictly need, but it lets us use unit stride SIMD
+                // loads, which is much faster than gathering the strided columns one
+                // at a time.  All the multiplies are powers of two times a pixel plus
+                // 2*pixel, so they are done with shifts.
+                std::vector<int32> row_filt(original.nc());
+                const long last = original.nc()-4;
+                for (long r = 0; r < temp_img.nr(); ++r)
+                {
+                    const unsigned char* orow = &original[r][0];
+                    long x = 0;
+                    for (; x+8 <= last; x += 8)
+                    {
+                        simd8i pix1, pix2, pix3, pix4, pix5;
+                        pix1.load(orow+x);
+                        pix2.load(orow+x+1);
+                        pix3.load(orow+x+2);
+                        pix4.load(orow+x+3);
+                        pix5.load(orow+x+4);
+                        // pix1 + 4*pix2 + 6*pix3 + 4*pix4 + pix5
+                        simd8i sum = pix1 + ((pix2+pix4)<<2) + (pix3<<2) + (pix3<<1) + pix5;
+                        sum.store(&row_filt[x]);
+                    }
+                    for (; x < last; ++x)
+                        row_filt[x] = orow[x] + 4*orow[x+1] + 6*orow[x+2] + 4*orow[x+3] + orow[x+4];
+
+                    int32* trow = &temp_img[r][0];
+                    for (long c = 0; c < temp_img.nc(); ++c)
+                        trow[c] = row_filt[2*c];
+                }
+
+                // Apply the column filter.  The rows of temp_img are contiguous
+                // int32s, so this one vectorizes directly.
+                long dr = 0;
+                int32 buf[8];
+                for (long r = 2; r < temp_img.nr()-2; r += 2)
+                {
+                    const int32* trow1 = &temp_img[r-2][0];
+                    const int32* trow2 = &temp_img[r-1][0];
+                    const int32* trow3 = &temp_img[r][0];
+                    const int32* trow4 = &temp_img[r+1][0];
+                    const int32* trow5 = &temp_img[r+2][0];
+                    unsigned char* drow = &down[dr][0];
+                    long c = 0;
+                    for (; c+8 <= temp_img.nc(); c += 8)
+                    {
+                        simd8i pix1, pix2, pix3, pix4, pix5;
+                        pix1.load(trow1+c);
+                        pix2.load(trow2+c);
+                        pix3.load(trow3+c);
+                        pix4.load(trow4+c);
+                        pix5.load(trow5+c);
+                        simd8i temp = (pix1 + ((pix2+pix4)<<2) + (pix3<<2) + (pix3<<1) + pix5) >> 8;
+                        temp.store(buf);
+                        drow[c+0] = static_cast<unsigned char>(buf[0]);
+                        drow[c+1] = static_cast<unsigned char>(buf[1]);
+                        drow[c+2] = static_cast<unsigned char>(buf[2]);
+                        drow[c+3] = static_cast<unsigned char>(buf[3]);
+                        drow[c+4] = static_cast<unsigned char>(buf[4]);
+                        drow[c+5] = static_cast<unsigned char>(buf[5]);
+                        drow[c+6] = static_cast<unsigned char>(buf[6]);
+                        drow[c+7] = static_cast<unsigned char>(buf[7]);
+                    }
+                    for (; c < temp_img.nc(); ++c)
+                    {
+                        const int32 temp = trow1[c] + trow2[c]*4 + trow3[c]*6 + trow4[c]*4 + trow5[c];
+                        drow[c] = static_cast<unsigned char>(temp/256);
+                    }
+                    ++dr;
+                }
+            }
+
         public:
+
+            template <
+                typename in_image_type,
+                typename out_image_type
+                >
+            typename disable_if<both_images_rgb<in_image_type,out_image_type> >::type operator() (
+                const in_image_type& original_,
+                out_image_type& down_
+            ) const
+            {
+                // make sure requires clause is not broken
+                DLIB_ASSERT( is_same_object(original_, down_) == false,
+                            "\t void pyramid_down_2_1::operator()"
+                            << "\n\t is_same_object(original_, down_): " << is_same_object(original_, down_)
+                            << "\n\t this:                           " << this
+                            );
+
+                typedef typename image_traits<in_image_type>::pixel_type in_pixel_type;
+                typedef typename image_traits<out_image_type>::pixel_type out_pixel_type;
+                COMPILE_TIME_ASSERT( pixel_traits<in_pixel_type>::has_alpha == false );
+                COMPILE_TIME_ASSERT( pixel_traits<out_pixel_type>::has_alpha == false );
+
+                const_image_view<in_image_type> original(original_);
+                image_view<out_image_type> down(down_);
+
+                if (original.nr() <= 8 || original.nc() <= 8)
+                {
+                    down.clear();
+                    return;
+                }
+
+                downsample_gray(original, down);
+            }
+
         // ------------------------------------------
         //       OVERLOAD FOR RGB TO RGB IMAGES
         // ------------------------------------------
@@ -370,8 +480,15 @@ namespace dlib
                     return;
                 }
 
-                array2d<rgbptype> temp_img;
-                temp_img.set_size(original.nr(), (original.nc()-3)/2);
+                // We store the horizontally filtered image as three separate int32
+                // color planes so the column filter below can run over contiguous
+                // memory with SIMD fixed point arithmetic.
+                array2d<int32> temp_red, temp_green, temp_blue;
+                const long temp_nr = original.nr();
+                const long temp_nc = (original.nc()-3)/2;
+                temp_red.set_size(temp_nr, temp_nc);
+                temp_green.set_size(temp_nr, temp_nc);
+                temp_blue.set_size(temp_nr, temp_nc);
                 down.set_size((original.nr()-3)/2, (original.nc()-3)/2);
 
 
@@ -382,51 +499,20 @@ namespace dlib
                 // one step.
 
                 // apply row filter
-                for (long r = 0; r < temp_img.nr(); ++r)
+                for (long r = 0; r < temp_nr; ++r)
                 {
                     long oc = 0;
-                    for (long c = 0; c < temp_img.nc(); ++c)
+                    for (long c = 0; c < temp_nc; ++c)
                     {
-                        rgbptype pix1;
-                        rgbptype pix2;
-                        rgbptype pix3;
-                        rgbptype pix4;
-                        rgbptype pix5;
-
-                        pix1.red = original[r][oc].red;
-                        pix2.red = original[r][oc+1].red;
-                        pix3.red = original[r][oc+2].red;
-                        pix4.red = original[r][oc+3].red;
-                        pix5.red = original[r][oc+4].red;
-                        pix1.green = original[r][oc].green;
-                        pix2.green = original[r][oc+1].green;
-                        pix3.green = original[r][oc+2].green;
-                        pix4.green = original[r][oc+3].green;
-                        pix5.green = original[r][oc+4].green;
-                        pix1.blue = original[r][oc].blue;
-                        pix2.blue = original[r][oc+1].blue;
-                        pix3.blue = original[r][oc+2].blue;
-                        pix4.blue = original[r][oc+3].blue;
-                        pix5.blue = original[r][oc+4].blue;
-
-                        pix2.red *= 4;
-                        pix3.red *= 6;
-                        pix4.red *= 4;
-
-                        pix2.green *= 4;
-                        pix3.green *= 6;
-                        pix4.green *= 4;
-
-                        pix2.blue *= 4;
-                        pix3.blue *= 6;
-                        pix4.blue *= 4;
-                        
-                        rgbptype temp;
-                        temp.red = pix1.red + pix2.red + pix3.red + pix4.red + pix5.red;
-                        temp.green = pix1.green + pix2.green + pix3.green + pix4.green + pix5.green;
-                        temp.blue = pix1.blue + pix2.blue + pix3.blue + pix4.blue + pix5.blue;
-
-                        temp_img[r][c] = temp;
+                        const in_pixel_type& pix1 = original[r][oc];
+                        const in_pixel_type& pix2 = original[r][oc+1];
+                        const in_pixel_type& pix3 = original[r][oc+2];
+                        const in_pixel_type& pix4 = original[r][oc+3];
+                        const in_pixel_type& pix5 = original[r][oc+4];
+
+                        temp_red[r][c]   = pix1.red   + pix2.red*4   + pix3.red*6   + pix4.red*4   + pix5.red;
+                        temp_green[r][c] = pix1.green + pix2.green*4 + pix3.green*6 + pix4.green*4 + pix5.green;
+                        temp_blue[r][c]  = pix1.blue  + pix2.blue*4  + pix3.blue*6  + pix4.blue*4  + pix5.blue;
 
                         oc += 2;
                     }
@@ -435,30 +521,64 @@ namespace dlib
 
                 // apply column filter
                 long dr = 0;
-                for (long r = 2; r < temp_img.nr()-2; r += 2)
+                int32 red[8], green[8], blue[8];
+                for (long r = 2; r < temp_nr-2; r += 2)
                 {
-                    for (long c = 0; c < temp_img.nc(); ++c)
+                    out_pixel_type* drow = &down[dr][0];
+                    long c = 0;
+                    for (; c+8 <= temp_nc; c += 8)
                     {
-                        rgbptype temp;
-                        temp.red = temp_img[r-2][c].red + 
-                                temp_img[r-1][c].red*4 +  
-                                temp_img[r  ][c].red*6 +  
-                                temp_img[r+1][c].red*4 +  
-                                temp_img[r+2][c].red;  
-                        temp.green = temp_img[r-2][c].green + 
-                                    temp_img[r-1][c].green*4 +  
-                                    temp_img[r  ][c].green*6 +  
-                                    temp_img[r+1][c].green*4 +  
-                                    temp_img[r+2][c].green;  
-                        temp.blue = temp_img[r-2][c].blue + 
-                                    temp_img[r-1][c].blue*4 +  
-                                    temp_img[r  ][c].blue*6 +  
-                                    temp_img[r+1][c].blue*4 +  
-                                    temp_img[r+2][c].blue;  
-
-                        down[dr][c].red = temp.red/256;
-                        down[dr][c].green = temp.green/256;
-                        down[dr][c].blue = temp.blue/256;
+                        simd8i pix1, pix2, pix3, pix4, pix5;
+
+                        pix1.load(&temp_red[r-2][c]);
+                        pix2.load(&temp_red[r-1][c]);
+                        pix3.load(&temp_red[r  ][c]);
+                        pix4.load(&temp_red[r+1][c]);
+                        pix5.load(&temp_red[r+2][c]);
+                        // pix1 + 4*pix2 + 6*pix3 + 4*pix4 + pix5, then /256
+                        simd8i temp = (pix1 + ((pix2+pix4)<<2) + (pix3<<2) + (pix3<<1) + pix5) >> 8;
+                        temp.store(red);
+
+                        pix1.load(&temp_green[r-2][c]);
+                        pix2.load(&temp_green[r-1][c]);
+                        pix3.load(&temp_green[r  ][c]);
+                        pix4.load(&temp_green[r+1][c]);
+                        pix5.load(&temp_green[r+2][c]);
+                        temp = (pix1 + ((pix2+pix4)<<2) + (pix3<<2) + (pix3<<1) + pix5) >> 8;
+                        temp.store(green);
+
+                        pix1.load(&temp_blue[r-2][c]);
+                        pix2.load(&temp_blue[r-1][c]);
+                        pix3.load(&temp_blue[r  ][c]);
+                        pix4.load(&temp_blue[r+1][c]);
+                        pix5.load(&temp_blue[r+2][c]);
+                        temp = (pix1 + ((pix2+pix4)<<2) + (pix3<<2) + (pix3<<1) + pix5) >> 8;
+                        temp.store(blue);
+
+                        for (long k = 0; k < 8; ++k)
+                        {
+                            drow[c+k].red   = static_cast<unsigned char>(red[k]);
+                            drow[c+k].green = static_cast<unsigned char>(green[k]);
+                            drow[c+k].blue  = static_cast<unsigned char>(blue[k]);
+                        }
+                    }
+                    for (; c < temp_nc; ++c)
+                    {
+                        drow[c].red = static_cast<unsigned char>((temp_red[r-2][c] +
+                                      temp_red[r-1][c]*4 +
+                                      temp_red[r  ][c]*6 +
+                                      temp_red[r+1][c]*4 +
+                                      temp_red[r+2][c])/256);
+                        drow[c].green = static_cast<unsigned char>((temp_green[r-2][c] +
+                                        temp_green[r-1][c]*4 +
+                                        temp_green[r  ][c]*6 +
+                                        temp_green[r+1][c]*4 +
+                                        temp_green[r+2][c])/256);
+                        drow[c].blue = static_cast<unsigned char>((temp_blue[r-2][c] +
+                                       temp_blue[r-1][c]*4 +
+                                       temp_blue[r  ][c]*6 +
+                                       temp_blue[r+1][c]*4 +
+                                       temp_blue[r+2][c])/256);
                     }
                     ++dr;
                 }
@@ -1021,6 +1141,139 @@ namespace dlib
         nc = 0;
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename pyramid_type,
+        typename pixel_type = unsigned char
+        >
+    class frame_pyramid : noncopyable
+    {
+        /*!
+            INITIAL VALUE
+                - levels.size() == 0
+                - max_num_levels == 0
+
+            CONVENTION
+                - max_num_levels == num_levels()
+                - levels.size() == num_levels_in_cache()
+                - levels.size() <= max_num_levels
+                - for all valid i: levels[i] == level i of the image pyramid of the
+                  most recently loaded frame.  That is, levels[0] is a copy of the
+                  frame itself and levels[i] == pyr(levels[i-1]).  Levels are
+                  appended to this array the first time get_level() asks for them.
+        !*/
+
+    public:
+
+        typedef pyramid_type pyramid_down_type;
+
+        frame_pyramid (
+        ) : max_num_levels(0) {}
+
+        template <
+            typename image_type
+            >
+        void load (
+            const image_type& img
+        )
+        {
+            levels.clear();
+            max_num_levels = 0;
+
+            long nr = num_rows(img);
+            long nc = num_columns(img);
+            if (nr*nc == 0)
+                return;
+
+            levels.resize(1);
+            assign_image(levels[0], img);
+
+            // Figure out how many levels the pyramid of this frame can contain.  We
+            // stop once downsampling would produce an empty image.  We also stop once
+            // the image is 8 pixels or less on a side since some of the pyramid_down
+            // objects refuse to downsample such tiny images.
+            max_num_levels = 1;
+            while (nr > 8 && nc > 8)
+            {
+                find_pyramid_down_output_image_size(pyr, nr, nc);
+                if (nr*nc == 0)
+                    break;
+                ++max_num_levels;
+            }
+        }
+
+        void clear (
+        )
+        {
+            levels.clear();
+            max_num_levels = 0;
+        }
+
+        unsigned long num_levels (
+        ) const { return max_num_levels; }
+
+        unsigned long num_levels_in_cache (
+        ) const { return levels.size(); }
+
+        const array2d<pixel_type>& get_level (
+            unsigned long level
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(level < num_levels(),
+                "\t const array2d<pixel_type>& frame_pyramid::get_level()"
+                << "\n\t Invalid inputs were given to this function."
+                << "\n\t level:        " << level
+                << "\n\t num_levels(): " << num_levels()
+                << "\n\t this:         " << this
+                );
+
+            // compute and cache any levels between the deepest one computed so far
+            // and the one being requested.
+            while (levels.size() <= level)
+            {
+                array2d<pixel_type> temp;
+                pyr(levels.back(), temp);
+                levels.push_back(temp);
+            }
+            return levels[level];
+        }
+
+        const pyramid_type& get_pyramid_down (
+        ) const { return pyr; }
+
+    // -----------------------------
+
+        template <typename T>
+        vector<double,2> point_down (
+            const vector<T,2>& p,
+            unsigned int levels_ = 1
+        ) const { return pyr.point_down(p, levels_); }
+
+        template <typename T>
+        vector<double,2> point_up (
+            const vector<T,2>& p,
+            unsigned int levels_ = 1
+        ) const { return pyr.point_up(p, levels_); }
+
+        drectangle rect_down (
+            const drectangle& rect,
+            unsigned int levels_ = 1
+        ) const { return pyr.rect_down(rect, levels_); }
+
+        drectangle rect_up (
+            const drectangle& rect,
+            unsigned int levels_ = 1
+        ) const { return pyr.rect_up(rect, levels_); }
+
+    private:
+
+        pyramid_type pyr;
+        dlib::array<array2d<pixel_type> > levels;
+        unsigned long max_num_levels;
+    };
+
 // ----------------------------------------------------------------------------------------
     
     namespace impl
@@ -228,6 +228,169 @@ namespace dlib
               image and stores it back into #nr and #nc.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename pyramid_type,
+        typename pixel_type = unsigned char
+        >
+    class frame_pyramid : noncopyable
+    {
+        /*!
+            REQUIREMENTS ON pyramid_type
+                - Must be one of the pyramid_down objects defined in this file, or an
+                  object with a compatible interface.
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a cache of the image pyramid of a single frame.  Video
+                processing pipelines often contain several stages (e.g. object
+                detection, image chip extraction, optical flow) that each build their
+                own image pyramid of the same frame.  This object lets those stages
+                share one pyramid instead: you load() the frame once and each stage
+                reads whatever levels it needs via get_level().  Levels are computed
+                lazily the first time they are requested and then held until the next
+                call to load() or clear(), so no level is downsampled more than once
+                per frame no matter how many stages consume it.
+
+                Coordinates are mapped between levels exactly as they are by
+                pyramid_type.  In particular, get_level(i) contains the image you
+                would get by applying pyramid_type's operator() to the frame i times,
+                and the point_down(), point_up(), rect_down(), and rect_up() members
+                forward to an instance of pyramid_type.
+
+            THREAD SAFETY
+                It is not safe to call load(), clear(), or get_level() concurrently
+                from multiple threads.  However, once a level has been computed it is
+                safe for many threads to read it at the same time.
+        !*/
+
+    public:
+
+        typedef pyramid_type pyramid_down_type;
+
+        frame_pyramid (
+        );
+        /*!
+            ensures
+                - #num_levels() == 0
+                - #num_levels_in_cache() == 0
+        !*/
+
+        template <
+            typename image_type
+            >
+        void load (
+            const image_type& img
+        );
+        /*!
+            requires
+                - image_type == an image object that implements the interface defined
+                  in dlib/image_processing/generic_image.h
+                - pixel_traits<typename image_traits<image_type>::pixel_type>::has_alpha == false
+                - it must be valid to assign pixels in img to pixels of type pixel_type.
+            ensures
+                - #get_level(0) == a copy of img, converted to pixel_type pixels.
+                - #num_levels() == the number of levels the pyramid of img contains.
+                  Roughly speaking, this is the number of times pyramid_type's
+                  operator() can be applied to img before the result becomes an empty
+                  image, plus one for img itself.  The pyramid stops growing once a
+                  level is 8 pixels or less on a side since images that small can't
+                  be meaningfully downsampled further.  If img is empty then
+                  #num_levels() == 0.
+                - #num_levels_in_cache() == min(1, #num_levels())
+        !*/
+
+        void clear (
+        );
+        /*!
+            ensures
+                - #num_levels() == 0
+                - #num_levels_in_cache() == 0
+                - frees the memory used by all cached pyramid levels.
+        !*/
+
+        unsigned long num_levels (
+        ) const;
+        /*!
+            ensures
+                - returns the number of levels in the pyramid of the most recently
+                  loaded frame.  get_level() may be asked for any level less than
+                  this number.
+        !*/
+
+        unsigned long num_levels_in_cache (
+        ) const;
+        /*!
+            ensures
+                - returns the number of pyramid levels that have been computed so
+                  far.  Calling get_level(i) with i >= num_levels_in_cache() will
+                  cause more levels to be computed.
+        !*/
+
+        const array2d<pixel_type>& get_level (
+            unsigned long level
+        );
+        /*!
+            requires
+                - level < num_levels()
+            ensures
+                - returns level number level of the image pyramid of the most
+                  recently loaded frame.  get_level(0) is the frame itself and
+                  get_level(i) is the result of applying pyramid_type's operator()
+                  to get_level(i-1).
+                - #num_levels_in_cache() == max(num_levels_in_cache(), level+1)
+                - The returned reference remains valid until load() or clear() is
+                  called.
+        !*/
+
+        const pyramid_type& get_pyramid_down (
+        ) const;
+        /*!
+            ensures
+                - returns the pyramid_type object used to downsample the levels of
+                  this pyramid.
+        !*/
+
+        template <typename T>
+        vector<double,2> point_down (
+            const vector<T,2>& p,
+            unsigned int levels = 1
+        ) const;
+        /*!
+            ensures
+                - returns get_pyramid_down().point_down(p, levels)
+        !*/
+
+        template <typename T>
+        vector<double,2> point_up (
+            const vector<T,2>& p,
+            unsigned int levels = 1
+        ) const;
+        /*!
+            ensures
+                - returns get_pyramid_down().point_up(p, levels)
+        !*/
+
+        drectangle rect_down (
+            const drectangle& rect,
+            unsigned int levels = 1
+        ) const;
+        /*!
+            ensures
+                - returns get_pyramid_down().rect_down(rect, levels)
+        !*/
+
+        drectangle rect_up (
+            const drectangle& rect,
+            unsigned int levels = 1
+        ) const;
+        /*!
+            ensures
+                - returns get_pyramid_down().rect_up(rect, levels)
+        !*/
+
+    };
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -12,6 +12,7 @@
 #include "../matrix.h"
 #include "../pixel.h"
 #include "../noncopyable.h"
+#include <vector>
 
 namespace dlib
 {
@@ -61,6 +62,72 @@ namespace dlib
 
         }
 
+        template <typename image_type>
+        void update (
+            const image_type& img_,
+            const rectangle& rect_
+        )
+        {
+            const_image_view<image_type> img(img_);
+
+            // make sure requires clause is not broken
+            DLIB_ASSERT(img.nr() == nr() && img.nc() == nc(),
+                "\tvoid integral_image_generic::update(img, rect)"
+                << "\n\tYou must give an image with the same dimensions as the loaded one"
+                << "\n\timg.nr(): " << img.nr()
+                << "\n\timg.nc(): " << img.nc()
+                << "\n\tnr():     " << nr()
+                << "\n\tnc():     " << nc()
+            );
+
+            const rectangle rect = rect_.intersect(get_rect(*this));
+            if (rect.is_empty())
+                return;
+
+            T pixel;
+
+            // Every entry at or below and to the right of rect's top left corner
+            // depends on the changed pixels, so those are the ones we recompute.  For
+            // the rows containing rect we rebuild the table from the pixel data.
+            for (long r = rect.top(); r <= rect.bottom(); ++r)
+            {
+                // remember the old values of the last of these rows so we can turn
+                // them into per column deltas for the rows below rect.
+                if (r == rect.bottom())
+                {
+                    row_buffer.resize(nc() - rect.left());
+                    for (long c = rect.left(); c < nc(); ++c)
+                        row_buffer[c - rect.left()] = int_img[r][c];
+                }
+
+                for (long c = rect.left(); c < nc(); ++c)
+                {
+                    assign_pixel(pixel, img[r][c]);
+                    T temp = pixel;
+                    if (c > 0)
+                        temp += int_img[r][c-1];
+                    if (r > 0)
+                        temp += int_img[r-1][c];
+                    if (r > 0 && c > 0)
+                        temp -= int_img[r-1][c-1];
+                    int_img[r][c] = temp;
+                }
+            }
+
+            // The pixels below rect didn't change, so each of those entries just
+            // shifts by however much the entry at the bottom of its column inside
+            // rect's rows shifted.  So apply those deltas rather than rereading
+            // pixels.
+            for (long c = rect.left(); c < nc(); ++c)
+                row_buffer[c - rect.left()] = int_img[rect.bottom()][c] - row_buffer[c - rect.left()];
+
+            for (long r = rect.bottom()+1; r < nr(); ++r)
+            {
+                for (long c = rect.left(); c < nc(); ++c)
+                    int_img[r][c] += row_buffer[c - rect.left()];
+            }
+        }
+
         value_type get_sum_of_area (
             const rectangle& rect
         ) const
@@ -103,6 +170,7 @@ namespace dlib
     private:
 
         array2d<T> int_img;
+        std::vector<T> row_buffer; // scratch space used by update()
     };
 
 
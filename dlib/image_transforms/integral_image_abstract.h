@@ -68,7 +68,31 @@ namespace dlib
                 - #nr() == img.nr()
                 - #nc() == img.nc()
                 - #*this will now contain an "integral image" representation of the
-                  given input image.  
+                  given input image.
+        !*/
+
+        template <typename image_type>
+        void update (
+            const image_type& img,
+            const rectangle& rect
+        );
+        /*!
+            requires
+                - image_type == an image object that implements the interface defined in
+                  dlib/image_processing/generic_image.h
+                - Let P denote the type of pixel in img, then we require:
+                    - pixel_traits<P>::has_alpha == false
+                - img.nr() == nr() && img.nc() == nc()
+                - img is identical to the image given to the last call to load() except
+                  possibly for the pixels inside rect.
+            ensures
+                - #*this == the integral image of img.  That is, this function produces
+                  the same result as calling load(img).
+                - This function only recomputes the parts of the integral image that
+                  depend on the pixels inside rect (i.e. the entries at or below and to
+                  the right of rect's top left corner, the others are unchanged).  So
+                  when only a small region of a large image changes between frames this
+                  is much faster than calling load().
         !*/
 
         value_type get_sum_of_area (
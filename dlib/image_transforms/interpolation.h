@@ -15,6 +15,7 @@
 #include "../image_processing/full_object_detection.h"
 #include <limits>
 #include <array>
+#include <vector>
 #include "../rand.h"
 
 namespace dlib
@@ -484,6 +485,35 @@ namespace dlib
         void operator() ( pixel_type& ) const { }
     };
 
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        template <typename funct>
+        void tile_rows (
+            long r_begin,
+            long r_end,
+            long nc,
+            const funct& process_rows
+        )
+        /*!
+            requires
+                - r_begin <= r_end
+                - process_rows(rb, re) processes the output rows in the range [rb, re) and
+                  calls on disjoint row ranges are safe to run concurrently.
+            ensures
+                - calls process_rows over all of [r_begin, r_end), splitting the rows into
+                  tiles that run on the default thread pool when the image is large enough
+                  for the threading overhead to pay for itself.
+        !*/
+        {
+            if ((r_end-r_begin)*nc < 128*128 || r_end-r_begin < 2)
+                process_rows(r_begin, r_end);
+            else
+                parallel_for_blocked(r_begin, r_end, process_rows);
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -516,14 +546,19 @@ namespace dlib
         const_image_view<image_type1> imgv(in_img);
         image_view<image_type2> out_imgv(out_img);
 
-        for (long r = area.top(); r <= area.bottom(); ++r)
+        // Each output pixel depends only on its own mapped location, so tiling the rows
+        // across threads can't change the results.
+        impl::tile_rows(area.top(), area.bottom()+1, area.width(), [&](long r_begin, long r_end)
         {
-            for (long c = area.left(); c <= area.right(); ++c)
+            for (long r = r_begin; r < r_end; ++r)
             {
-                if (!interp(imgv, map_point(dlib::vector<double,2>(c,r)), out_imgv[r][c]))
-                    set_background(out_imgv[r][c]);
+                for (long c = area.left(); c <= area.right(); ++c)
+                {
+                    if (!interp(imgv, map_point(dlib::vector<double,2>(c,r)), out_imgv[r][c]))
+                        set_background(out_imgv[r][c]);
+                }
             }
-        }
+        });
     }
 
 // ----------------------------------------------------------------------------------------
@@ -666,6 +701,39 @@ namespace dlib
             const double x_scale;
             const double y_scale;
         };
+
+        struct resize_row_weights
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This holds the per output row portion of a bilinear image resize: the
+                    indices of the two input rows each output row blends together and the
+                    blending fraction between them.  The weights are accumulated up front,
+                    exactly the way the serial resize loops used to compute them, so that
+                    tiling the rows across threads doesn't change any outputs.
+            !*/
+
+            resize_row_weights(
+                double y_scale,
+                long out_nr,
+                long in_nr
+            ) :
+                tops(out_nr), bottoms(out_nr), tb_fracs(out_nr)
+            {
+                double y = -y_scale;
+                for (long r = 0; r < out_nr; ++r)
+                {
+                    y += y_scale;
+                    tops[r]     = static_cast<long>(std::floor(y));
+                    bottoms[r]  = std::min(tops[r]+1, in_nr-1);
+                    tb_fracs[r] = y - tops[r];
+                }
+            }
+
+            std::vector<long> tops;
+            std::vector<long> bottoms;
+            std::vector<double> tb_fracs;
+        };
     }
 
     template <
@@ -726,59 +794,66 @@ namespace dlib
         typedef typename image_traits<image_type2>::pixel_type U;
         const double x_scale = (in_img.nc()-1)/(double)std::max<long>((out_img.nc()-1),1);
         const double y_scale = (in_img.nr()-1)/(double)std::max<long>((out_img.nr()-1),1);
-        double y = -y_scale;
-        for (long r = 0; r < out_img.nr(); ++r)
+
+        // Precompute the vertical interpolation weights for every output row.  Doing this
+        // serially up front means the arithmetic is identical no matter how the rows get
+        // tiled across threads below.
+        const impl::resize_row_weights rw(y_scale, out_img.nr(), in_img.nr());
+
+        impl::tile_rows(0, out_img.nr(), out_img.nc(), [&](long r_begin, long r_end)
         {
-            y += y_scale;
-            const long top    = static_cast<long>(std::floor(y));
-            const long bottom = std::min(top+1, in_img.nr()-1);
-            const double tb_frac = y - top;
-            double x = -x_scale;
-            if (pixel_traits<U>::grayscale)
+            for (long r = r_begin; r < r_end; ++r)
             {
-                for (long c = 0; c < out_img.nc(); ++c)
+                const long top       = rw.tops[r];
+                const long bottom    = rw.bottoms[r];
+                const double tb_frac = rw.tb_fracs[r];
+                double x = -x_scale;
+                if (pixel_traits<U>::grayscale)
                 {
-                    x += x_scale;
-                    const long left   = static_cast<long>(std::floor(x));
-                    const long right  = std::min(left+1, in_img.nc()-1);
-                    const double lr_frac = x - left;
+                    for (long c = 0; c < out_img.nc(); ++c)
+                    {
+                        x += x_scale;
+                        const long left   = static_cast<long>(std::floor(x));
+                        const long right  = std::min(left+1, in_img.nc()-1);
+                        const double lr_frac = x - left;
 
-                    double tl = 0, tr = 0, bl = 0, br = 0;
+                        double tl = 0, tr = 0, bl = 0, br = 0;
 
-                    assign_pixel(tl, in_img[top][left]);
-                    assign_pixel(tr, in_img[top][right]);
-                    assign_pixel(bl, in_img[bottom][left]);
-                    assign_pixel(br, in_img[bottom][right]);
+                        assign_pixel(tl, in_img[top][left]);
+                        assign_pixel(tr, in_img[top][right]);
+                        assign_pixel(bl, in_img[bottom][left]);
+                        assign_pixel(br, in_img[bottom][right]);
 
-                    double temp = (1-tb_frac)*((1-lr_frac)*tl + lr_frac*tr) + 
-                        tb_frac*((1-lr_frac)*bl + lr_frac*br);
+                        double temp = (1-tb_frac)*((1-lr_frac)*tl + lr_frac*tr) +
+                            tb_frac*((1-lr_frac)*bl + lr_frac*br);
 
-                    assign_pixel(out_img[r][c], temp);
+                        assign_pixel(out_img[r][c], temp);
+                    }
                 }
-            }
-            else
-            {
-                for (long c = 0; c < out_img.nc(); ++c)
+                else
                 {
-                    x += x_scale;
-                    const long left   = static_cast<long>(std::floor(x));
-                    const long right  = std::min(left+1, in_img.nc()-1);
-                    const double lr_frac = x - left;
-
-                    const T tl = in_img[top][left];
-                    const T tr = in_img[top][right];
-                    const T bl = in_img[bottom][left];
-                    const T br = in_img[bottom][right];
-
-                    T temp;
-                    assign_pixel(temp, 0);
-                    vector_to_pixel(temp, 
-                        (1-tb_frac)*((1-lr_frac)*pixel_to_vector<double>(tl) + lr_frac*pixel_to_vector<double>(tr)) + 
-                            tb_frac*((1-lr_frac)*pixel_to_vector<double>(bl) + lr_frac*pixel_to_vector<double>(br)));
-                    assign_pixel(out_img[r][c], temp);
+                    for (long c = 0; c < out_img.nc(); ++c)
+                    {
+                        x += x_scale;
+                        const long left   = static_cast<long>(std::floor(x));
+                        const long right  = std::min(left+1, in_img.nc()-1);
+                        const double lr_frac = x - left;
+
+                        const T tl = in_img[top][left];
+                        const T tr = in_img[top][right];
+                        const T bl = in_img[bottom][left];
+                        const T br = in_img[bottom][right];
+
+                        T temp;
+                        assign_pixel(temp, 0);
+                        vector_to_pixel(temp,
+                            (1-tb_frac)*((1-lr_frac)*pixel_to_vector<double>(tl) + lr_frac*pixel_to_vector<double>(tr)) +
+                                tb_frac*((1-lr_frac)*pixel_to_vector<double>(bl) + lr_frac*pixel_to_vector<double>(br)));
+                        assign_pixel(out_img[r][c], temp);
+                    }
                 }
             }
-        }
+        });
     }
 
 // ----------------------------------------------------------------------------------------
@@ -821,84 +896,100 @@ namespace dlib
         typedef typename image_traits<image_type>::pixel_type T;
         const double x_scale = (in_img.nc()-1)/(double)std::max<long>((out_img.nc()-1),1);
         const double y_scale = (in_img.nr()-1)/(double)std::max<long>((out_img.nr()-1),1);
-        double y = -y_scale;
-        for (long r = 0; r < out_img.nr(); ++r)
+
+        // Precompute the vertical interpolation weights for every output row.  Doing this
+        // serially up front means the arithmetic is identical no matter how the rows get
+        // tiled across threads below.
+        const impl::resize_row_weights rw(y_scale, out_img.nr(), in_img.nr());
+
+        impl::tile_rows(0, out_img.nr(), out_img.nc(), [&](long r_begin, long r_end)
         {
-            y += y_scale;
-            const long top    = static_cast<long>(std::floor(y));
-            const long bottom = std::min(top+1, in_img.nr()-1);
-            const double tb_frac = y - top;
-            double x = -4*x_scale;
-
-            const simd4f _tb_frac = tb_frac;
-            const simd4f _inv_tb_frac = 1-tb_frac;
-            const simd4f _x_scale = 4*x_scale;
-            simd4f _x(x, x+x_scale, x+2*x_scale, x+3*x_scale);
-            long c = 0;
-            for (;; c+=4)
+            for (long r = r_begin; r < r_end; ++r)
             {
-                _x += _x_scale;
-                simd4i left = simd4i(_x);
-
-                simd4f _lr_frac = _x-left;
-                simd4f _inv_lr_frac = 1-_lr_frac; 
-                simd4i right = left+1;
-
-                simd4f tlf = _inv_tb_frac*_inv_lr_frac;
-                simd4f trf = _inv_tb_frac*_lr_frac;
-                simd4f blf = _tb_frac*_inv_lr_frac;
-                simd4f brf = _tb_frac*_lr_frac;
-
-                int32 fleft[4];
-                int32 fright[4];
-                left.store(fleft);
-                right.store(fright);
-
-                if (fright[3] >= in_img.nc())
-                    break;
-                simd4f tl(in_img[top][fleft[0]],     in_img[top][fleft[1]],     in_img[top][fleft[2]],     in_img[top][fleft[3]]);
-                simd4f tr(in_img[top][fright[0]],    in_img[top][fright[1]],    in_img[top][fright[2]],    in_img[top][fright[3]]);
-                simd4f bl(in_img[bottom][fleft[0]],  in_img[bottom][fleft[1]],  in_img[bottom][fleft[2]],  in_img[bottom][fleft[3]]);
-                simd4f br(in_img[bottom][fright[0]], in_img[bottom][fright[1]], in_img[bottom][fright[2]], in_img[bottom][fright[3]]);
-
-                simd4f out = simd4f(tlf*tl + trf*tr + blf*bl + brf*br);
-                float fout[4];
-                out.store(fout);
-
-                const auto convert_to_output_type = [](float value)
+                const long top       = rw.tops[r];
+                const long bottom    = rw.bottoms[r];
+                const double tb_frac = rw.tb_fracs[r];
+                double x = -8*x_scale;
+
+                const simd8f _tb_frac = tb_frac;
+                const simd8f _inv_tb_frac = 1-tb_frac;
+                const simd8f _x_scale = 8*x_scale;
+                simd8f _x(x,           x+x_scale,   x+2*x_scale, x+3*x_scale,
+                          x+4*x_scale, x+5*x_scale, x+6*x_scale, x+7*x_scale);
+                long c = 0;
+                for (;; c+=8)
                 {
-                    if (std::is_integral<T>::value)
-                        return static_cast<T>(value + 0.5);
-                    else
-                        return static_cast<T>(value);
-                };
-
-                out_img[r][c]   = convert_to_output_type(fout[0]);
-                out_img[r][c+1] = convert_to_output_type(fout[1]);
-                out_img[r][c+2] = convert_to_output_type(fout[2]);
-                out_img[r][c+3] = convert_to_output_type(fout[3]);
-            }
-            x = -x_scale + c*x_scale;
-            for (; c < out_img.nc(); ++c)
-            {
-                x += x_scale;
-                const long left   = static_cast<long>(std::floor(x));
-                const long right  = std::min(left+1, in_img.nc()-1);
-                const float lr_frac = x - left;
+                    _x += _x_scale;
+                    simd8i left = simd8i(_x);
+
+                    simd8f _lr_frac = _x-left;
+                    simd8f _inv_lr_frac = 1-_lr_frac;
+                    simd8i right = left+1;
+
+                    simd8f tlf = _inv_tb_frac*_inv_lr_frac;
+                    simd8f trf = _inv_tb_frac*_lr_frac;
+                    simd8f blf = _tb_frac*_inv_lr_frac;
+                    simd8f brf = _tb_frac*_lr_frac;
+
+                    int32 fleft[8];
+                    int32 fright[8];
+                    left.store(fleft);
+                    right.store(fright);
+
+                    if (fright[7] >= in_img.nc())
+                        break;
+                    simd8f tl(in_img[top][fleft[0]],     in_img[top][fleft[1]],     in_img[top][fleft[2]],     in_img[top][fleft[3]],
+                              in_img[top][fleft[4]],     in_img[top][fleft[5]],     in_img[top][fleft[6]],     in_img[top][fleft[7]]);
+                    simd8f tr(in_img[top][fright[0]],    in_img[top][fright[1]],    in_img[top][fright[2]],    in_img[top][fright[3]],
+                              in_img[top][fright[4]],    in_img[top][fright[5]],    in_img[top][fright[6]],    in_img[top][fright[7]]);
+                    simd8f bl(in_img[bottom][fleft[0]],  in_img[bottom][fleft[1]],  in_img[bottom][fleft[2]],  in_img[bottom][fleft[3]],
+                              in_img[bottom][fleft[4]],  in_img[bottom][fleft[5]],  in_img[bottom][fleft[6]],  in_img[bottom][fleft[7]]);
+                    simd8f br(in_img[bottom][fright[0]], in_img[bottom][fright[1]], in_img[bottom][fright[2]], in_img[bottom][fright[3]],
+                              in_img[bottom][fright[4]], in_img[bottom][fright[5]], in_img[bottom][fright[6]], in_img[bottom][fright[7]]);
+
+                    simd8f out = simd8f(tlf*tl + trf*tr + blf*bl + brf*br);
+                    float fout[8];
+                    out.store(fout);
+
+                    const auto convert_to_output_type = [](float value)
+                    {
+                        if (std::is_integral<T>::value)
+                            return static_cast<T>(value + 0.5);
+                        else
+                            return static_cast<T>(value);
+                    };
+
+                    out_img[r][c]   = convert_to_output_type(fout[0]);
+                    out_img[r][c+1] = convert_to_output_type(fout[1]);
+                    out_img[r][c+2] = convert_to_output_type(fout[2]);
+                    out_img[r][c+3] = convert_to_output_type(fout[3]);
+                    out_img[r][c+4] = convert_to_output_type(fout[4]);
+                    out_img[r][c+5] = convert_to_output_type(fout[5]);
+                    out_img[r][c+6] = convert_to_output_type(fout[6]);
+                    out_img[r][c+7] = convert_to_output_type(fout[7]);
+                }
+                x = -x_scale + c*x_scale;
+                for (; c < out_img.nc(); ++c)
+                {
+                    x += x_scale;
+                    const long left   = static_cast<long>(std::floor(x));
+                    const long right  = std::min(left+1, in_img.nc()-1);
+                    const float lr_frac = x - left;
 
-                float tl = 0, tr = 0, bl = 0, br = 0;
+                    float tl = 0, tr = 0, bl = 0, br = 0;
 
-                assign_pixel(tl, in_img[top][left]);
-                assign_pixel(tr, in_img[top][right]);
-                assign_pixel(bl, in_img[bottom][left]);
-                assign_pixel(br, in_img[bottom][right]);
+                    assign_pixel(tl, in_img[top][left]);
+                    assign_pixel(tr, in_img[top][right]);
+                    assign_pixel(bl, in_img[bottom][left]);
+                    assign_pixel(br, in_img[bottom][right]);
 
-                float temp = (1-tb_frac)*((1-lr_frac)*tl + lr_frac*tr) + 
-                    tb_frac*((1-lr_frac)*bl + lr_frac*br);
+                    float temp = (1-tb_frac)*((1-lr_frac)*tl + lr_frac*tr) +
+                        tb_frac*((1-lr_frac)*bl + lr_frac*br);
 
-                assign_pixel(out_img[r][c], temp);
+                    assign_pixel(out_img[r][c], temp);
+                }
             }
-        }
+        });
     }
 
 // ----------------------------------------------------------------------------------------
@@ -930,99 +1021,106 @@ namespace dlib
         typedef typename image_traits<image_type1>::pixel_type T;
         const double x_scale = (in_img.nc()-1)/(double)std::max<long>((out_img.nc()-1),1);
         const double y_scale = (in_img.nr()-1)/(double)std::max<long>((out_img.nr()-1),1);
-        double y = -y_scale;
-        for (long r = 0; r < out_img.nr(); ++r)
+
+        // Precompute the vertical interpolation weights for every output row.  Doing this
+        // serially up front means the arithmetic is identical no matter how the rows get
+        // tiled across threads below.
+        const impl::resize_row_weights rw(y_scale, out_img.nr(), in_img.nr());
+
+        impl::tile_rows(0, out_img.nr(), out_img.nc(), [&](long r_begin, long r_end)
         {
-            y += y_scale;
-            const long top    = static_cast<long>(std::floor(y));
-            const long bottom = std::min(top+1, in_img.nr()-1);
-            const double tb_frac = y - top;
-            double x = -4*x_scale;
-
-            const simd4f _tb_frac = tb_frac;
-            const simd4f _inv_tb_frac = 1-tb_frac;
-            const simd4f _x_scale = 4*x_scale;
-            simd4f _x(x, x+x_scale, x+2*x_scale, x+3*x_scale);
-            long c = 0;
-            for (;; c+=4)
+            for (long r = r_begin; r < r_end; ++r)
             {
-                _x += _x_scale;
-                simd4i left = simd4i(_x);
-                simd4f lr_frac = _x-left;
-                simd4f _inv_lr_frac = 1-lr_frac; 
-                simd4i right = left+1;
-
-                simd4f tlf = _inv_tb_frac*_inv_lr_frac;
-                simd4f trf = _inv_tb_frac*lr_frac;
-                simd4f blf = _tb_frac*_inv_lr_frac;
-                simd4f brf = _tb_frac*lr_frac;
-
-                int32 fleft[4];
-                int32 fright[4];
-                left.store(fleft);
-                right.store(fright);
-
-                if (fright[3] >= in_img.nc())
-                    break;
-                simd4f tl(in_img[top][fleft[0]].red,     in_img[top][fleft[1]].red,     in_img[top][fleft[2]].red,     in_img[top][fleft[3]].red);
-                simd4f tr(in_img[top][fright[0]].red,    in_img[top][fright[1]].red,    in_img[top][fright[2]].red,    in_img[top][fright[3]].red);
-                simd4f bl(in_img[bottom][fleft[0]].red,  in_img[bottom][fleft[1]].red,  in_img[bottom][fleft[2]].red,  in_img[bottom][fleft[3]].red);
-                simd4f br(in_img[bottom][fright[0]].red, in_img[bottom][fright[1]].red, in_img[bottom][fright[2]].red, in_img[bottom][fright[3]].red);
-
-                simd4i out = simd4i(tlf*tl + trf*tr + blf*bl + brf*br);
-                int32 fout[4];
-                out.store(fout);
-
-                out_img[r][c].red   = static_cast<unsigned char>(fout[0]);
-                out_img[r][c+1].red = static_cast<unsigned char>(fout[1]);
-                out_img[r][c+2].red = static_cast<unsigned char>(fout[2]);
-                out_img[r][c+3].red = static_cast<unsigned char>(fout[3]);
-
-
-                tl = simd4f(in_img[top][fleft[0]].green,    in_img[top][fleft[1]].green,    in_img[top][fleft[2]].green,    in_img[top][fleft[3]].green);
-                tr = simd4f(in_img[top][fright[0]].green,   in_img[top][fright[1]].green,   in_img[top][fright[2]].green,   in_img[top][fright[3]].green);
-                bl = simd4f(in_img[bottom][fleft[0]].green, in_img[bottom][fleft[1]].green, in_img[bottom][fleft[2]].green, in_img[bottom][fleft[3]].green);
-                br = simd4f(in_img[bottom][fright[0]].green, in_img[bottom][fright[1]].green, in_img[bottom][fright[2]].green, in_img[bottom][fright[3]].green);
-                out = simd4i(tlf*tl + trf*tr + blf*bl + brf*br);
-                out.store(fout);
-                out_img[r][c].green   = static_cast<unsigned char>(fout[0]);
-                out_img[r][c+1].green = static_cast<unsigned char>(fout[1]);
-                out_img[r][c+2].green = static_cast<unsigned char>(fout[2]);
-                out_img[r][c+3].green = static_cast<unsigned char>(fout[3]);
-
-
-                tl = simd4f(in_img[top][fleft[0]].blue,     in_img[top][fleft[1]].blue,     in_img[top][fleft[2]].blue,     in_img[top][fleft[3]].blue);
-                tr = simd4f(in_img[top][fright[0]].blue,    in_img[top][fright[1]].blue,    in_img[top][fright[2]].blue,    in_img[top][fright[3]].blue);
-                bl = simd4f(in_img[bottom][fleft[0]].blue,  in_img[bottom][fleft[1]].blue,  in_img[bottom][fleft[2]].blue,  in_img[bottom][fleft[3]].blue);
-                br = simd4f(in_img[bottom][fright[0]].blue, in_img[bottom][fright[1]].blue, in_img[bottom][fright[2]].blue, in_img[bottom][fright[3]].blue);
-                out = simd4i(tlf*tl + trf*tr + blf*bl + brf*br);
-                out.store(fout);
-                out_img[r][c].blue   = static_cast<unsigned char>(fout[0]);
-                out_img[r][c+1].blue = static_cast<unsigned char>(fout[1]);
-                out_img[r][c+2].blue = static_cast<unsigned char>(fout[2]);
-                out_img[r][c+3].blue = static_cast<unsigned char>(fout[3]);
-            }
-            x = -x_scale + c*x_scale;
-            for (; c < out_img.nc(); ++c)
-            {
-                x += x_scale;
-                const long left   = static_cast<long>(std::floor(x));
-                const long right  = std::min(left+1, in_img.nc()-1);
-                const double lr_frac = x - left;
-
-                const T tl = in_img[top][left];
-                const T tr = in_img[top][right];
-                const T bl = in_img[bottom][left];
-                const T br = in_img[bottom][right];
-
-                T temp;
-                assign_pixel(temp, 0);
-                vector_to_pixel(temp, 
-                    (1-tb_frac)*((1-lr_frac)*pixel_to_vector<double>(tl) + lr_frac*pixel_to_vector<double>(tr)) + 
-                    tb_frac*((1-lr_frac)*pixel_to_vector<double>(bl) + lr_frac*pixel_to_vector<double>(br)));
-                assign_pixel(out_img[r][c], temp);
+                const long top       = rw.tops[r];
+                const long bottom    = rw.bottoms[r];
+                const double tb_frac = rw.tb_fracs[r];
+                double x = -4*x_scale;
+
+                const simd4f _tb_frac = tb_frac;
+                const simd4f _inv_tb_frac = 1-tb_frac;
+                const simd4f _x_scale = 4*x_scale;
+                simd4f _x(x, x+x_scale, x+2*x_scale, x+3*x_scale);
+                long c = 0;
+                for (;; c+=4)
+                {
+                    _x += _x_scale;
+                    simd4i left = simd4i(_x);
+                    simd4f lr_frac = _x-left;
+                    simd4f _inv_lr_frac = 1-lr_frac;
+                    simd4i right = left+1;
+
+                    simd4f tlf = _inv_tb_frac*_inv_lr_frac;
+                    simd4f trf = _inv_tb_frac*lr_frac;
+                    simd4f blf = _tb_frac*_inv_lr_frac;
+                    simd4f brf = _tb_frac*lr_frac;
+
+                    int32 fleft[4];
+                    int32 fright[4];
+                    left.store(fleft);
+                    right.store(fright);
+
+                    if (fright[3] >= in_img.nc())
+                        break;
+                    simd4f tl(in_img[top][fleft[0]].red,     in_img[top][fleft[1]].red,     in_img[top][fleft[2]].red,     in_img[top][fleft[3]].red);
+                    simd4f tr(in_img[top][fright[0]].red,    in_img[top][fright[1]].red,    in_img[top][fright[2]].red,    in_img[top][fright[3]].red);
+                    simd4f bl(in_img[bottom][fleft[0]].red,  in_img[bottom][fleft[1]].red,  in_img[bottom][fleft[2]].red,  in_img[bottom][fleft[3]].red);
+                    simd4f br(in_img[bottom][fright[0]].red, in_img[bottom][fright[1]].red, in_img[bottom][fright[2]].red, in_img[bottom][fright[3]].red);
+
+                    simd4i out = simd4i(tlf*tl + trf*tr + blf*bl + brf*br);
+                    int32 fout[4];
+                    out.store(fout);
+
+                    out_img[r][c].red   = static_cast<unsigned char>(fout[0]);
+                    out_img[r][c+1].red = static_cast<unsigned char>(fout[1]);
+                    out_img[r][c+2].red = static_cast<unsigned char>(fout[2]);
+                    out_img[r][c+3].red = static_cast<unsigned char>(fout[3]);
+
+
+                    tl = simd4f(in_img[top][fleft[0]].green,    in_img[top][fleft[1]].green,    in_img[top][fleft[2]].green,    in_img[top][fleft[3]].green);
+                    tr = simd4f(in_img[top][fright[0]].green,   in_img[top][fright[1]].green,   in_img[top][fright[2]].green,   in_img[top][fright[3]].green);
+                    bl = simd4f(in_img[bottom][fleft[0]].green, in_img[bottom][fleft[1]].green, in_img[bottom][fleft[2]].green, in_img[bottom][fleft[3]].green);
+                    br = simd4f(in_img[bottom][fright[0]].green, in_img[bottom][fright[1]].green, in_img[bottom][fright[2]].green, in_img[bottom][fright[3]].green);
+                    out = simd4i(tlf*tl + trf*tr + blf*bl + brf*br);
+                    out.store(fout);
+                    out_img[r][c].green   = static_cast<unsigned char>(fout[0]);
+                    out_img[r][c+1].green = static_cast<unsigned char>(fout[1]);
+                    out_img[r][c+2].green = static_cast<unsigned char>(fout[2]);
+                    out_img[r][c+3].green = static_cast<unsigned char>(fout[3]);
+
+
+                    tl = simd4f(in_img[top][fleft[0]].blue,     in_img[top][fleft[1]].blue,     in_img[top][fleft[2]].blue,     in_img[top][fleft[3]].blue);
+                    tr = simd4f(in_img[top][fright[0]].blue,    in_img[top][fright[1]].blue,    in_img[top][fright[2]].blue,    in_img[top][fright[3]].blue);
+                    bl = simd4f(in_img[bottom][fleft[0]].blue,  in_img[bottom][fleft[1]].blue,  in_img[bottom][fleft[2]].blue,  in_img[bottom][fleft[3]].blue);
+                    br = simd4f(in_img[bottom][fright[0]].blue, in_img[bottom][fright[1]].blue, in_img[bottom][fright[2]].blue, in_img[bottom][fright[3]].blue);
+                    out = simd4i(tlf*tl + trf*tr + blf*bl + brf*br);
+                    out.store(fout);
+                    out_img[r][c].blue   = static_cast<unsigned char>(fout[0]);
+                    out_img[r][c+1].blue = static_cast<unsigned char>(fout[1]);
+                    out_img[r][c+2].blue = static_cast<unsigned char>(fout[2]);
+                    out_img[r][c+3].blue = static_cast<unsigned char>(fout[3]);
+                }
+                x = -x_scale + c*x_scale;
+                for (; c < out_img.nc(); ++c)
+                {
+                    x += x_scale;
+                    const long left   = static_cast<long>(std::floor(x));
+                    const long right  = std::min(left+1, in_img.nc()-1);
+                    const double lr_frac = x - left;
+
+                    const T tl = in_img[top][left];
+                    const T tr = in_img[top][right];
+                    const T bl = in_img[bottom][left];
+                    const T br = in_img[bottom][right];
+
+                    T temp;
+                    assign_pixel(temp, 0);
+                    vector_to_pixel(temp,
+                        (1-tb_frac)*((1-lr_frac)*pixel_to_vector<double>(tl) + lr_frac*pixel_to_vector<double>(tr)) +
+                        tb_frac*((1-lr_frac)*pixel_to_vector<double>(bl) + lr_frac*pixel_to_vector<double>(br)));
+                    assign_pixel(out_img[r][c], temp);
+                }
             }
-        }
+        });
     }
 
 // ----------------------------------------------------------------------------------------
@@ -1929,15 +2027,14 @@ namespace dlib
         for (unsigned long i = 1; i < levels.size(); ++i)
             pyr(levels[i-1],levels[i]);
 
-        std::vector<dlib::vector<double,2> > from, to;
-
-        // now pull out the chips
+        // now pull out the chips.  Each chip only touches its own output image and reads
+        // from the shared pyramid, so they can all be extracted in parallel.
         chips.resize(chip_locations.size());
-        for (unsigned long i = 0; i < chips.size(); ++i)
+        dlib::parallel_for(0, chips.size(), [&](long i)
         {
             // If the chip doesn't have any rotation or scaling then use the basic version
             // of chip extraction that just does a fast copy.
-            if (chip_locations[i].angle == 0 && 
+            if (chip_locations[i].angle == 0 &&
                 chip_locations[i].rows == chip_locations[i].rect.height() &&
                 chip_locations[i].cols == chip_locations[i].rect.width())
             {
@@ -1958,8 +2055,7 @@ namespace dlib
 
                 // find the appropriate transformation that maps from the chip to the input
                 // image
-                from.clear();
-                to.clear();
+                std::vector<dlib::vector<double,2> > from, to;
                 from.push_back(get_rect(chips[i]).tl_corner());  to.push_back(rotate_point<double>(center(rect),rect.tl_corner(),chip_locations[i].angle));
                 from.push_back(get_rect(chips[i]).tr_corner());  to.push_back(rotate_point<double>(center(rect),rect.tr_corner(),chip_locations[i].angle));
                 from.push_back(get_rect(chips[i]).bl_corner());  to.push_back(rotate_point<double>(center(rect),rect.bl_corner(),chip_locations[i].angle));
@@ -1971,7 +2067,7 @@ namespace dlib
                 else
                     transform_image(levels[level],chips[i],interp,trns);
             }
-        }
+        });
     }
 
 // ----------------------------------------------------------------------------------------
@@ -1989,6 +2085,113 @@ namespace dlib
         extract_image_chips(img, chip_locations, chips, interpolate_bilinear());
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename pyramid_type,
+        typename pixel_type,
+        typename image_type2,
+        typename interpolation_type
+        >
+    void extract_image_chips (
+        frame_pyramid<pyramid_type,pixel_type>& img_pyr,
+        const std::vector<chip_details>& chip_locations,
+        dlib::array<image_type2>& chips,
+        const interpolation_type& interp
+    )
+    {
+        // make sure requires clause is not broken
+#ifdef ENABLE_ASSERTS
+        DLIB_CASSERT(img_pyr.num_levels() != 0,
+            "\t void extract_image_chips()"
+            << "\n\t Invalid inputs were given to this function."
+            << "\n\t img_pyr.num_levels(): " << img_pyr.num_levels()
+            );
+        for (unsigned long i = 0; i < chip_locations.size(); ++i)
+        {
+            DLIB_CASSERT(chip_locations[i].size() != 0 &&
+                         chip_locations[i].rect.is_empty() == false,
+            "\t void extract_image_chips()"
+            << "\n\t Invalid inputs were given to this function."
+            << "\n\t chip_locations["<<i<<"].size():            " << chip_locations[i].size()
+            << "\n\t chip_locations["<<i<<"].rect.is_empty(): " << chip_locations[i].rect.is_empty()
+            );
+        }
+#endif
+
+        const pyramid_type& pyr = img_pyr.get_pyramid_down();
+
+        // This is just like the version of extract_image_chips() defined above except
+        // that instead of building a new image pyramid here we pull levels out of the
+        // given frame_pyramid, which caches them across calls.  So first figure out
+        // which pyramid level each chip will be extracted from and make sure all of
+        // those levels are in the cache before we go multi-threaded below.
+        std::vector<unsigned long> chip_levels(chip_locations.size());
+        unsigned long max_level = 0;
+        for (unsigned long i = 0; i < chip_locations.size(); ++i)
+        {
+            unsigned long level = 0;
+            drectangle rect = chip_locations[i].rect;
+            while (level+1 < img_pyr.num_levels() && pyr.rect_down(rect).area() > chip_locations[i].size())
+            {
+                rect = pyr.rect_down(rect);
+                ++level;
+            }
+            chip_levels[i] = level;
+            max_level = std::max(max_level, level);
+        }
+        img_pyr.get_level(max_level);
+
+        // now pull out the chips.  Each chip only touches its own output image and
+        // reads from the shared pyramid, so they can all be extracted in parallel.
+        chips.resize(chip_locations.size());
+        dlib::parallel_for(0, chips.size(), [&](long i)
+        {
+            // If the chip doesn't have any rotation or scaling then use the basic version
+            // of chip extraction that just does a fast copy.
+            if (chip_locations[i].angle == 0 &&
+                chip_locations[i].rows == chip_locations[i].rect.height() &&
+                chip_locations[i].cols == chip_locations[i].rect.width())
+            {
+                impl::basic_extract_image_chip(img_pyr.get_level(0), chip_locations[i].rect, chips[i]);
+            }
+            else
+            {
+                set_image_size(chips[i], chip_locations[i].rows, chip_locations[i].cols);
+
+                const unsigned long level = chip_levels[i];
+                const drectangle rect = pyr.rect_down(drectangle(chip_locations[i].rect), level);
+
+                // find the appropriate transformation that maps from the chip to the
+                // pyramid level it is extracted from
+                std::vector<dlib::vector<double,2> > from, to;
+                from.push_back(get_rect(chips[i]).tl_corner());  to.push_back(rotate_point<double>(center(rect),rect.tl_corner(),chip_locations[i].angle));
+                from.push_back(get_rect(chips[i]).tr_corner());  to.push_back(rotate_point<double>(center(rect),rect.tr_corner(),chip_locations[i].angle));
+                from.push_back(get_rect(chips[i]).bl_corner());  to.push_back(rotate_point<double>(center(rect),rect.bl_corner(),chip_locations[i].angle));
+                point_transform_affine trns = find_affine_transform(from,to);
+
+                // now extract the actual chip
+                transform_image(img_pyr.get_level(level),chips[i],interp,trns);
+            }
+        });
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename pyramid_type,
+        typename pixel_type,
+        typename image_type2
+        >
+    void extract_image_chips(
+        frame_pyramid<pyramid_type,pixel_type>& img_pyr,
+        const std::vector<chip_details>& chip_locations,
+        dlib::array<image_type2>& chips
+    )
+    {
+        extract_image_chips(img_pyr, chip_locations, chips, interpolate_bilinear());
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -219,12 +219,17 @@ namespace dlib
               area with an interpolated copy of in_img.  
             - This function does not change the size of out_img.
             - Only pixels inside the region defined by area in out_img are modified.
-            - For all locations r and c such that area.contains(c,r) but have no corresponding 
+            - For all locations r and c such that area.contains(c,r) but have no corresponding
               locations in in_img:
                 - set_background(out_img[r][c]) is invoked
                   (i.e. some parts of out_img might correspond to areas outside in_img and
                   therefore can't supply interpolated values.  In these cases, these
                   pixels can be assigned a value by the supplied set_background() routine)
+            - When area is large this function will process tiles of rows in parallel
+              using the default thread pool.  This means interp, map_point, and
+              set_background must be safe to call concurrently from multiple threads,
+              which is the case for all the routines dlib supplies for use with this
+              function.
     !*/
 
 // ----------------------------------------------------------------------------------------
@@ -385,6 +390,8 @@ namespace dlib
                 - #out_img.nc() == out_img.nc()
             - uses the supplied interpolation routine interp to perform the necessary
               pixel interpolation.
+            - When out_img is large this function will process tiles of rows in parallel
+              using the default thread pool.
     !*/
 
 // ----------------------------------------------------------------------------------------
@@ -1202,6 +1209,8 @@ namespace dlib
                   chip_locations[i].angle radians, around the center of
                   chip_locations[i].rect, before the chip was extracted. 
             - Any pixels in an image chip that go outside img are set to 0 (i.e. black).
+            - The chips are extracted in parallel using the default_thread_pool() when
+              more than one CPU core is available.
     !*/
 
     template <
@@ -1219,6 +1228,58 @@ namespace dlib
               above-defined extract_image_chips() function using bilinear interpolation.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename pyramid_type,
+        typename pixel_type,
+        typename image_type2,
+        typename interpolation_type
+        >
+    void extract_image_chips (
+        frame_pyramid<pyramid_type,pixel_type>& img_pyr,
+        const std::vector<chip_details>& chip_locations,
+        dlib::array<image_type2>& chips,
+        const interpolation_type& interp
+    );
+    /*!
+        requires
+            - img_pyr.num_levels() != 0
+            - image_type2 == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+            - for all valid i:
+                - chip_locations[i].rect.is_empty() == false
+                - chip_locations[i].size() != 0
+            - interpolation_type == interpolate_nearest_neighbor, interpolate_bilinear,
+              interpolate_quadratic, or a type with a compatible interface.
+        ensures
+            - This function behaves just like the version of extract_image_chips()
+              defined above, operating on the frame loaded into img_pyr, except that
+              instead of building a temporary image pyramid internally it reads
+              whatever pyramid levels it needs from img_pyr.  When several pipeline
+              stages process the same frame, sharing a frame_pyramid between them this
+              way avoids downsampling the frame multiple times.
+            - Any pyramid levels this function uses are left in img_pyr's cache, so
+              subsequent calls against the same frame will not recompute them.
+    !*/
+
+    template <
+        typename pyramid_type,
+        typename pixel_type,
+        typename image_type2
+        >
+    void extract_image_chips (
+        frame_pyramid<pyramid_type,pixel_type>& img_pyr,
+        const std::vector<chip_details>& chip_locations,
+        dlib::array<image_type2>& chips
+    );
+    /*!
+        requires
+            - it is valid to call extract_image_chips(img_pyr,chip_locations,chips,interpolate_bilinear())
+        ensures
+            - calls extract_image_chips(img_pyr,chip_locations,chips,interpolate_bilinear())
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <
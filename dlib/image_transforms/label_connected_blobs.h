@@ -5,8 +5,15 @@
 
 #include "label_connected_blobs_abstract.h"
 #include "../geometry.h"
+#include "../disjoint_subsets.h"
+#include "../threads.h"
+#include "../matrix.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <stack>
 #include <vector>
+#include <unordered_map>
 #include "thresholding.h"
 #include "assign_image.h"
 #include <queue>
@@ -198,6 +205,295 @@ namespace dlib
         return next;
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_type,
+        typename label_image_type,
+        typename background_functor_type,
+        typename neighbors_functor_type,
+        typename connected_functor_type
+        >
+    unsigned long label_connected_blobs_union_find (
+        const image_type& img_,
+        const background_functor_type& is_background,
+        const neighbors_functor_type&  get_neighbors,
+        const connected_functor_type&  is_connected,
+        label_image_type& label_img_
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT(is_same_object(img_, label_img_) == false,
+            "\t unsigned long label_connected_blobs_union_find()"
+            << "\n\t The input image and output label image can't be the same object."
+            );
+
+        const_image_view<image_type> img(img_);
+        image_view<label_image_type> label_img(label_img_);
+
+        label_img.set_size(img.nr(), img.nc());
+        if (img.size() == 0)
+            return 0;
+
+        const long nr = img.nr();
+        const long nc = img.nc();
+        const rectangle area = get_rect(img);
+
+        // Find the neighborhood offsets that precede a pixel in raster scan order.
+        // Those are the only ones the labeling passes need to look at since a link
+        // between a pixel and one of its later neighbors gets recorded when the scan
+        // reaches that later pixel.  We probe the functor at the origin and symmetrize
+        // the offsets so asymmetric neighborhoods still produce the connectivity
+        // promised by label_connected_blobs().
+        std::vector<point> prior_offsets;
+        long min_offset_y = 0;
+        {
+            std::vector<point> window;
+            get_neighbors(point(0,0), window);
+            const unsigned long num = window.size();
+            for (unsigned long i = 0; i < num; ++i)
+                window.push_back(-window[i]);
+            for (auto& off : window)
+            {
+                if (off.y() < 0 || (off.y() == 0 && off.x() < 0))
+                {
+                    if (std::find(prior_offsets.begin(), prior_offsets.end(), off) == prior_offsets.end())
+                    {
+                        prior_offsets.push_back(off);
+                        min_offset_y = std::min(min_offset_y, off.y());
+                    }
+                }
+            }
+        }
+
+        disjoint_subsets sets;
+        sets.set_size(static_cast<unsigned long>(img.size()));
+
+        // Cut the image into horizontal bands, one per worker, and have the first pass
+        // label each band on its own.  The bands never follow links that cross a band
+        // boundary, so they touch disjoint ranges of the union-find structure and don't
+        // need any locking.
+        const long num_bands = std::max<long>(1, std::min<long>(nr,
+            (nr*nc < 128*128) ? 1 : default_thread_pool().num_threads_in_pool()+1));
+
+        auto label_band = [&](long band)
+        {
+            const long r_begin = band*nr/num_bands;
+            const long r_end   = (band+1)*nr/num_bands;
+            for (long r = r_begin; r < r_end; ++r)
+            {
+                for (long c = 0; c < nc; ++c)
+                {
+                    const point p(c,r);
+                    if (is_background(img,p))
+                        continue;
+                    const unsigned long idx = static_cast<unsigned long>(r*nc + c);
+                    for (auto& off : prior_offsets)
+                    {
+                        const point q = p + off;
+                        if (q.y() < r_begin || !area.contains(q))
+                            continue;
+                        if (!is_background(img,q) && is_connected(img,p,q))
+                        {
+                            const unsigned long a = sets.find_set(idx);
+                            const unsigned long b = sets.find_set(static_cast<unsigned long>(q.y()*nc + q.x()));
+                            if (a != b)
+                                sets.merge_sets(a,b);
+                        }
+                    }
+                }
+            }
+        };
+
+        if (num_bands == 1)
+            label_band(0);
+        else
+            parallel_for(0, num_bands, label_band);
+
+        // Now stitch the bands back together by redoing just the links that cross band
+        // boundaries.  Only the first few rows of each band can have such links.
+        for (long band = 1; band < num_bands; ++band)
+        {
+            const long r_begin = band*nr/num_bands;
+            const long r_end   = std::min((band+1)*nr/num_bands, r_begin - min_offset_y);
+            for (long r = r_begin; r < r_end; ++r)
+            {
+                for (long c = 0; c < nc; ++c)
+                {
+                    const point p(c,r);
+                    if (is_background(img,p))
+                        continue;
+                    const unsigned long idx = static_cast<unsigned long>(r*nc + c);
+                    for (auto& off : prior_offsets)
+                    {
+                        const point q = p + off;
+                        if (q.y() >= r_begin || !area.contains(q))
+                            continue;
+                        if (!is_background(img,q) && is_connected(img,p,q))
+                        {
+                            const unsigned long a = sets.find_set(idx);
+                            const unsigned long b = sets.find_set(static_cast<unsigned long>(q.y()*nc + q.x()));
+                            if (a != b)
+                                sets.merge_sets(a,b);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Finally, flatten the union-find roots into contiguous blob labels.  Handing
+        // out labels in raster order of each blob's first pixel makes the output
+        // identical to what label_connected_blobs() produces.
+        std::unordered_map<unsigned long, unsigned long> root_to_label;
+        unsigned long next = 1;
+        for (long r = 0; r < nr; ++r)
+        {
+            for (long c = 0; c < nc; ++c)
+            {
+                if (is_background(img,point(c,r)))
+                {
+                    label_img[r][c] = 0;
+                    continue;
+                }
+                const unsigned long root = sets.find_set(static_cast<unsigned long>(r*nc + c));
+                auto i = root_to_label.find(root);
+                if (i == root_to_label.end())
+                    i = root_to_label.emplace(root, next++).first;
+                label_img[r][c] = i->second;
+            }
+        }
+
+        return next;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        inline void distance_transform_1d (
+            const double* f,
+            const long n,
+            double* d,
+            long* v,
+            double* z
+        )
+        /*!
+            requires
+                - f, d, and v point to buffers of length at least n
+                - z points to a buffer of length at least n+1
+                - n > 0
+            ensures
+                - for all 0 <= q < n: d[q] == min over all p of (q-p)^2 + f[p]
+                  (i.e. the 1-D squared distance transform of Felzenszwalb and
+                  Huttenlocher)
+        !*/
+        {
+            const double inf = std::numeric_limits<double>::infinity();
+            long k = 0;
+            v[0] = 0;
+            z[0] = -inf;
+            z[1] = inf;
+            for (long q = 1; q < n; ++q)
+            {
+                double s = ((f[q]+q*q) - (f[v[k]]+v[k]*v[k]))/(2*q - 2*v[k]);
+                while (s <= z[k])
+                {
+                    --k;
+                    s = ((f[q]+q*q) - (f[v[k]]+v[k]*v[k]))/(2*q - 2*v[k]);
+                }
+                ++k;
+                v[k] = q;
+                z[k] = s;
+                z[k+1] = inf;
+            }
+
+            k = 0;
+            for (long q = 0; q < n; ++q)
+            {
+                while (z[k+1] < q)
+                    ++k;
+                d[q] = (q-v[k])*(q-v[k]) + f[v[k]];
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename in_image_type,
+        typename out_image_type
+        >
+    void euclidean_distance_transform (
+        const in_image_type& img_,
+        out_image_type& dist_
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT(is_same_object(img_, dist_) == false,
+            "\t void euclidean_distance_transform()"
+            << "\n\t The input image and output image can't be the same object."
+            );
+
+        const_image_view<in_image_type> img(img_);
+        image_view<out_image_type> dist(dist_);
+
+        dist.set_size(img.nr(), img.nc());
+        if (img.size() == 0)
+            return;
+
+        const long nr = img.nr();
+        const long nc = img.nc();
+        const bool run_serially = nr*nc < 128*128;
+
+        // Squared distances computed along the columns, used as the input costs for
+        // the row pass.
+        matrix<double> coldist(nr,nc);
+
+        // First compute, for every pixel, the squared distance to the nearest
+        // background pixel in its own column.
+        auto process_cols = [&](long c_begin, long c_end)
+        {
+            std::vector<double> f(nr), d(nr), z(nr+1);
+            std::vector<long> v(nr);
+            // Use a big finite value rather than a true infinity for "no background in
+            // sight" so the parabola intersection arithmetic in distance_transform_1d
+            // never computes inf-inf.
+            const double inf = 1e20;
+            for (long c = c_begin; c < c_end; ++c)
+            {
+                for (long r = 0; r < nr; ++r)
+                    f[r] = (get_pixel_intensity(img[r][c]) == 0) ? 0 : inf;
+                impl::distance_transform_1d(f.data(), nr, d.data(), v.data(), z.data());
+                for (long r = 0; r < nr; ++r)
+                    coldist(r,c) = d[r];
+            }
+        };
+
+        // Then combine the column distances across each row.
+        auto process_rows = [&](long r_begin, long r_end)
+        {
+            std::vector<double> d(nc), z(nc+1);
+            std::vector<long> v(nc);
+            for (long r = r_begin; r < r_end; ++r)
+            {
+                impl::distance_transform_1d(&coldist(r,0), nc, d.data(), v.data(), z.data());
+                for (long c = 0; c < nc; ++c)
+                    assign_pixel(dist[r][c], std::sqrt(d[c]));
+            }
+        };
+
+        if (run_serially)
+        {
+            process_cols(0, nc);
+            process_rows(0, nr);
+        }
+        else
+        {
+            parallel_for_blocked(0, nc, process_cols);
+            parallel_for_blocked(0, nr, process_rows);
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -209,6 +209,71 @@ namespace dlib
               called with points outside the image.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_type,
+        typename label_image_type,
+        typename background_functor_type,
+        typename neighbors_functor_type,
+        typename connected_functor_type
+        >
+    unsigned long label_connected_blobs_union_find (
+        const image_type& img,
+        const background_functor_type& is_background,
+        const neighbors_functor_type&  get_neighbors,
+        const connected_functor_type&  is_connected,
+        label_image_type& label_img
+    );
+    /*!
+        requires
+            - the same requirements as label_connected_blobs() defined above
+        ensures
+            - performs exactly the same computation as label_connected_blobs() and
+              produces an identical #label_img and return value.  However, this version
+              uses a two-pass union-find algorithm that labels horizontal bands of the
+              image in parallel and then merges the labels across the band boundaries.
+              On large images it is therefore much faster than label_connected_blobs(),
+              which does a serial flood fill.  On small images it runs serially since
+              spreading such little work over multiple threads isn't worth the
+              overhead.
+            - is_background(), get_neighbors(), and is_connected() may be invoked
+              concurrently from multiple threads, so they must be safe to call that
+              way.  The stateless functors defined above all qualify.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename in_image_type,
+        typename out_image_type
+        >
+    void euclidean_distance_transform (
+        const in_image_type& img,
+        out_image_type& dist
+    );
+    /*!
+        requires
+            - in_image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+            - out_image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h and it must contain float, double,
+              or long double pixels.
+            - is_same_object(img, dist) == false
+        ensures
+            - Computes the exact euclidean distance transform of img using the
+              O(pixels) two-pass algorithm of Felzenszwalb and Huttenlocher, running
+              the row and column passes in parallel on large images.
+            - #dist.nr() == img.nr()
+            - #dist.nc() == img.nc()
+            - for all valid r and c:
+                - #dist[r][c] == the euclidean distance from the pixel img[r][c] to the
+                  nearest pixel of img with a value of 0.  In particular, this means
+                  that pixels which are themselves 0 get a distance of 0.
+            - if (img contains no pixels with a value of 0) then
+                - all the output pixels are set to a very large value (about 1e10).
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -3,10 +3,14 @@
 #ifndef DLIB_MORPHOLOGICAL_OPERATIONs_
 #define DLIB_MORPHOLOGICAL_OPERATIONs_
 
+#include <cstring>
+#include <vector>
+
 #include "../pixel.h"
 #include "thresholding.h"
 #include "morphological_operations_abstract.h"
 #include "assign_image.h"
+#include "../threads.h"
 
 namespace dlib
 {
@@ -66,6 +70,210 @@ namespace dlib
             return true;
         }
 
+        template <
+            long M,
+            long N
+            >
+        bool is_all_on (
+            const unsigned char (&structuring_element)[M][N]
+        )
+        /*!
+            ensures
+                - returns true if every element of structuring_element is on_pixel.
+        !*/
+        {
+            for (long m = 0; m < M; ++m)
+            {
+                for (long n = 0; n < N; ++n)
+                {
+                    if (structuring_element[m][n] != on_pixel)
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        template <bool take_max>
+        inline unsigned char pick_extreme (
+            const unsigned char a,
+            const unsigned char b
+        )
+        {
+            return take_max ? std::max(a,b) : std::min(a,b);
+        }
+
+        template <bool take_max>
+        void sliding_extreme_line (
+            const unsigned char* in,
+            unsigned char* out,
+            unsigned char* s,
+            unsigned char* p,
+            const long n,
+            const long rad
+        )
+        /*!
+            requires
+                - in, out, s, and p all point to buffers of n elements
+                - rad >= 0
+            ensures
+                - for all 0 <= i < n:
+                    - #out[i] == the max (or min if !take_max) of in[] over the window
+                      [i-rad, i+rad], where positions outside [0, n) count as off_pixel.
+        !*/
+        {
+            // This is the van Herk/Gil-Werman sliding window algorithm.  The line is
+            // split into blocks the size of the window and s and p get running
+            // extremes from each block's start and towards each block's end,
+            // respectively.  Any window then spans at most two adjacent blocks and
+            // its extreme is just pick_extreme(p[window start], s[window end]),
+            // giving a constant cost per pixel no matter how big the window is.
+            if (rad == 0)
+            {
+                std::memcpy(out, in, n);
+                return;
+            }
+            const long w = 2*rad+1;
+            for (long i = 0; i < n; ++i)
+                s[i] = (i%w == 0) ? in[i] : pick_extreme<take_max>(s[i-1], in[i]);
+            for (long i = n-1; i >= 0; --i)
+                p[i] = (i == n-1 || (i+1)%w == 0) ? in[i] : pick_extreme<take_max>(p[i+1], in[i]);
+
+            const long last_block = ((n-1)/w)*w;
+            for (long i = 0; i < n; ++i)
+            {
+                const long lo = i-rad;
+                const long hi = i+rad;
+                if (lo < 0)
+                    out[i] = pick_extreme<take_max>(off_pixel, s[std::min(hi, n-1)]);
+                else if (hi >= n)
+                {
+                    // If lo is in the block containing n-1 then p[lo] already spans
+                    // [lo, n-1] by itself.  Mixing in s[n-1] there would wrongly pull
+                    // in elements before lo.
+                    if (lo >= last_block)
+                        out[i] = pick_extreme<take_max>(off_pixel, p[lo]);
+                    else
+                        out[i] = pick_extreme<take_max>(off_pixel, pick_extreme<take_max>(p[lo], s[n-1]));
+                }
+                else
+                    out[i] = pick_extreme<take_max>(p[lo], s[hi]);
+            }
+        }
+
+        template <
+            bool take_max,
+            typename in_view_type,
+            typename out_view_type
+            >
+        void rect_extreme_filter (
+            const in_view_type& in_img,
+            out_view_type& out_img,
+            const long row_rad,
+            const long col_rad
+        )
+        /*!
+            requires
+                - in_img contains a grayscale binary image
+                - out_img has the same dimensions as in_img
+                - is_same_object(in_img, out_img) == false
+                - row_rad >= 0 && col_rad >= 0
+            ensures
+                - #out_img == the sliding max (or min if !take_max) of in_img over a
+                  (2*row_rad+1) x (2*col_rad+1) rectangular window centered on each
+                  pixel, with positions outside the image counting as off_pixel.  For
+                  binary images this is exactly binary dilation (or erosion) by an
+                  all-on rectangular structuring element.
+        !*/
+        {
+            const long nr = in_img.nr();
+            const long nc = in_img.nc();
+
+            // Tiles of rows are processed in parallel when the image is big enough
+            // for the threading overhead to pay for itself.
+            const bool run_parallel = nr >= 2 && nr*nc >= 128*128;
+            auto for_rows = [&](auto&& f)
+            {
+                if (run_parallel)
+                    parallel_for_blocked(0, nr, f);
+                else
+                    f(0, nr);
+            };
+
+            // horizontal pass
+            array2d<unsigned char> temp(nr, nc);
+            for_rows([&](long r_begin, long r_end)
+            {
+                std::vector<unsigned char> line(nc), s(nc), p(nc);
+                for (long r = r_begin; r < r_end; ++r)
+                {
+                    for (long c = 0; c < nc; ++c)
+                        line[c] = static_cast<unsigned char>(in_img[r][c]);
+                    sliding_extreme_line<take_max>(&line[0], &temp[r][0], &s[0], &p[0], nc, col_rad);
+                }
+            });
+
+            // Vertical pass.  Same recurrences as the line routine but marching down
+            // the image operating on whole rows at a time, so the inner loops stay
+            // dense and vectorize.
+            const long w = 2*row_rad+1;
+            array2d<unsigned char> s(nr, nc), p(nr, nc);
+            for (long r = 0; r < nr; ++r)
+            {
+                if (r%w == 0)
+                    std::memcpy(&s[r][0], &temp[r][0], nc);
+                else
+                    for (long c = 0; c < nc; ++c)
+                        s[r][c] = pick_extreme<take_max>(s[r-1][c], temp[r][c]);
+            }
+            for (long r = nr-1; r >= 0; --r)
+            {
+                if (r == nr-1 || (r+1)%w == 0)
+                    std::memcpy(&p[r][0], &temp[r][0], nc);
+                else
+                    for (long c = 0; c < nc; ++c)
+                        p[r][c] = pick_extreme<take_max>(p[r+1][c], temp[r][c]);
+            }
+
+            const long last_block = ((nr-1)/w)*w;
+            for_rows([&](long r_begin, long r_end)
+            {
+                for (long r = r_begin; r < r_end; ++r)
+                {
+                    const long lo = r-row_rad;
+                    const long hi = r+row_rad;
+                    if (lo < 0)
+                    {
+                        const unsigned char* srow = &s[std::min(hi, nr-1)][0];
+                        for (long c = 0; c < nc; ++c)
+                            assign_pixel(out_img[r][c], pick_extreme<take_max>(off_pixel, srow[c]));
+                    }
+                    else if (hi >= nr)
+                    {
+                        // same block handling as in sliding_extreme_line()
+                        const unsigned char* prow = &p[lo][0];
+                        if (lo >= last_block)
+                        {
+                            for (long c = 0; c < nc; ++c)
+                                assign_pixel(out_img[r][c], pick_extreme<take_max>(off_pixel, prow[c]));
+                        }
+                        else
+                        {
+                            const unsigned char* srow = &s[nr-1][0];
+                            for (long c = 0; c < nc; ++c)
+                                assign_pixel(out_img[r][c], pick_extreme<take_max>(off_pixel, pick_extreme<take_max>(prow[c], srow[c])));
+                        }
+                    }
+                    else
+                    {
+                        const unsigned char* prow = &p[lo][0];
+                        const unsigned char* srow = &s[hi][0];
+                        for (long c = 0; c < nc; ++c)
+                            assign_pixel(out_img[r][c], pick_extreme<take_max>(prow[c], srow[c]));
+                    }
+                }
+            });
+        }
+
     }
 
 // ----------------------------------------------------------------------------------------
@@ -117,6 +325,15 @@ namespace dlib
 
         out_img.set_size(in_img.nr(),in_img.nc());
 
+        // An all-on rectangular structuring element is separable, so in that
+        // case use the sliding window filter.  Its cost per pixel is constant
+        // rather than proportional to M*N.
+        if (is_all_on(structuring_element) && M*N >= 9)
+        {
+            rect_extreme_filter<true>(in_img, out_img, M/2, N/2);
+            return;
+        }
+
         // apply the filter to the image
         for (long r = 0; r < in_img.nr(); ++r)
         {
@@ -193,6 +410,16 @@ namespace dlib
 
         out_img.set_size(in_img.nr(),in_img.nc());
 
+        // An all-on rectangular structuring element is separable, so in that
+        // case use the sliding window filter.  Note that treating everything
+        // outside the image as off_pixel is exactly what the general loop below
+        // does too.
+        if (is_all_on(structuring_element) && M*N >= 9)
+        {
+            rect_extreme_filter<false>(in_img, out_img, M/2, N/2);
+            return;
+        }
+
         // apply the filter to the image
         for (long r = 0; r < in_img.nr(); ++r)
         {
@@ -38,10 +38,13 @@ namespace dlib
             - all pixels in structuring_element are set to either on_pixel or off_pixel
               (i.e. it must be a binary image)
         ensures
-            - Does a binary dilation of in_img using the given structuring element and 
+            - Does a binary dilation of in_img using the given structuring element and
               stores the result in out_img.
             - #out_img.nc() == in_img.nc()
             - #out_img.nr() == in_img.nr()
+            - If the structuring element is entirely on_pixel then a sliding window
+              algorithm whose runtime is independent of M and N is used, so large
+              rectangular structuring elements are cheap.
     !*/
 
 // ----------------------------------------------------------------------------------------
@@ -72,10 +75,13 @@ namespace dlib
             - all pixels in structuring_element are set to either on_pixel or off_pixel
               (i.e. it must be a binary image)
         ensures
-            - Does a binary erosion of in_img using the given structuring element and 
+            - Does a binary erosion of in_img using the given structuring element and
               stores the result in out_img.
             - #out_img.nc() == in_img.nc()
             - #out_img.nr() == in_img.nr()
+            - If the structuring element is entirely on_pixel then a sliding window
+              algorithm whose runtime is independent of M and N is used, so large
+              rectangular structuring elements are cheap.
     !*/
 
 // ----------------------------------------------------------------------------------------
@@ -5,9 +5,16 @@
 
 #include "random_cropper_abstract.h"
 #include "../threads.h"
+#include <cmath>
+#include <deque>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <sstream>
+#include <utility>
 #include <vector>
 #include "interpolation.h"
+#include "../any.h"
 #include "../image_processing/full_object_detection.h"
 #include "../rand.h"
 
@@ -26,6 +33,26 @@ namespace dlib
 
         std::mutex rnd_mutex;
         dlib::rand rnd;
+
+        // The crop cache stores finished crops keyed by the source image and which of
+        // a bounded set of per-image crop variants was drawn, so that mostly static
+        // datasets don't redo the same interpolation work epoch after epoch.  The
+        // crops are held behind shared_ptrs inside dlib::any objects since this class
+        // doesn't know what image type its callers use.
+        typedef std::pair<const void*,long> crop_cache_key;
+        struct crop_cache_entry
+        {
+            any crop;
+            std::vector<mmod_rect> rects;
+        };
+        bool use_crop_cache = false;
+        size_t crop_cache_max_size = 10000;
+        size_t crop_cache_variants_per_image = 64;
+        size_t crop_cache_hit_count = 0;
+        size_t crop_cache_miss_count = 0;
+        std::map<crop_cache_key,crop_cache_entry> crop_cache;
+        std::deque<crop_cache_key> crop_cache_order;
+        mutable std::mutex cache_mutex;
     public:
 
         void set_seed (
@@ -99,9 +126,60 @@ namespace dlib
         void set_max_object_size (
             double value
         ) 
-        { 
+        {
             DLIB_CASSERT(0 < value);
-            max_object_size = value; 
+            max_object_size = value;
+        }
+
+        bool crop_cache_enabled (
+        ) const { return use_crop_cache; }
+
+        void enable_crop_cache (
+            size_t max_size,
+            size_t variants_per_image = 64
+        )
+        {
+            DLIB_CASSERT(0 < max_size && 0 < variants_per_image);
+            use_crop_cache = true;
+            crop_cache_max_size = max_size;
+            crop_cache_variants_per_image = variants_per_image;
+        }
+
+        size_t get_crop_cache_variants_per_image (
+        ) const { return crop_cache_variants_per_image; }
+
+        void disable_crop_cache (
+        )
+        {
+            use_crop_cache = false;
+            clear_crop_cache();
+        }
+
+        size_t get_crop_cache_max_size (
+        ) const { return crop_cache_max_size; }
+
+        size_t get_crop_cache_hits (
+        ) const
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            return crop_cache_hit_count;
+        }
+
+        size_t get_crop_cache_misses (
+        ) const
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            return crop_cache_miss_count;
+        }
+
+        void clear_crop_cache (
+        )
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            crop_cache.clear();
+            crop_cache_order.clear();
+            crop_cache_hit_count = 0;
+            crop_cache_miss_count = 0;
         }
 
         template <
@@ -189,7 +267,51 @@ namespace dlib
             DLIB_CASSERT(num_rows(img)*num_columns(img) != 0);
             chip_details crop_plan;
             bool should_flip_crop;
-            make_crop_plan(img, rects, crop_plan, should_flip_crop);
+            crop_cache_key key;
+            if (use_crop_cache)
+            {
+                // Pick one of the bounded set of crop variants for this image and see
+                // if we already made it.
+                long variant;
+                {
+                    std::lock_guard<std::mutex> lock(rnd_mutex);
+                    variant = (long)rnd.get_integer(crop_cache_variants_per_image);
+                }
+                key = crop_cache_key(&img, variant);
+                std::shared_ptr<image_type2> hit;
+                {
+                    std::lock_guard<std::mutex> lock(cache_mutex);
+                    auto i = crop_cache.find(key);
+                    if (i != crop_cache.end() && i->second.crop.contains<std::shared_ptr<image_type2>>())
+                    {
+                        hit = i->second.crop.cast_to<std::shared_ptr<image_type2>>();
+                        crop_rects = i->second.rects;
+                        ++crop_cache_hit_count;
+                    }
+                    else
+                    {
+                        ++crop_cache_miss_count;
+                    }
+                }
+                // Cached entries are never modified once inserted, so it's safe to
+                // copy from the crop outside the lock.
+                if (hit)
+                {
+                    assign_image(crop, *hit);
+                    return;
+                }
+                // Derive the crop plan deterministically from the image and variant
+                // so that drawing the same variant again always reproduces this crop.
+                std::ostringstream seed;
+                seed << &img << ":" << variant;
+                dlib::rand vrnd(seed.str());
+                make_crop_plan(img, rects, crop_plan, should_flip_crop, vrnd);
+            }
+            else
+            {
+                std::lock_guard<std::mutex> lock(rnd_mutex);
+                make_crop_plan(img, rects, crop_plan, should_flip_crop, rnd);
+            }
 
             extract_image_chip(img, crop_plan, crop);
             const rectangle_transform tform = get_mapping_to_chip(crop_plan);
@@ -221,11 +343,31 @@ namespace dlib
             if (should_flip_crop)
             {
                 image_type2 temp;
-                flip_image_left_right(crop, temp); 
+                flip_image_left_right(crop, temp);
                 swap(crop,temp);
                 for (auto&& rect : crop_rects)
                     rect.rect = impl::flip_rect_left_right(rect.rect, get_rect(crop));
             }
+
+            if (use_crop_cache)
+            {
+                auto stored = std::make_shared<image_type2>();
+                assign_image(*stored, crop);
+                std::lock_guard<std::mutex> lock(cache_mutex);
+                if (crop_cache.count(key) == 0)
+                {
+                    // evict the oldest entries to keep the cache bounded
+                    while (crop_cache.size() >= crop_cache_max_size && !crop_cache_order.empty())
+                    {
+                        crop_cache.erase(crop_cache_order.front());
+                        crop_cache_order.pop_front();
+                    }
+                    crop_cache_entry& entry = crop_cache[key];
+                    entry.crop = stored;
+                    entry.rects = crop_rects;
+                    crop_cache_order.push_back(key);
+                }
+            }
         }
 
     private:
@@ -235,14 +377,14 @@ namespace dlib
             const image_type1& img,
             const std::vector<mmod_rect>& rects,
             chip_details& crop_plan,
-            bool& should_flip_crop
+            bool& should_flip_crop,
+            dlib::rand& rnd
         )
         {
-            std::lock_guard<std::mutex> lock(rnd_mutex);
             rectangle crop_rect;
             if (has_non_ignored_box(rects) && rnd.get_random_double() >= background_crops_fraction)
             {
-                auto rect = rects[randomly_pick_rect(rects)].rect;
+                auto rect = rects[randomly_pick_rect(rects, rnd)].rect;
 
                 // perturb the location of the crop by a small fraction of the object's size.
                 const point rand_translate = dpoint(rnd.get_double_in_range(-translate_amount,translate_amount)*std::max(rect.height(),rect.width()), 
@@ -278,7 +420,7 @@ namespace dlib
             }
             else
             {
-                crop_rect = make_random_cropping_rect(img);
+                crop_rect = make_random_cropping_rect(img, rnd);
             }
             should_flip_crop = randomly_flip && rnd.get_random_double() > 0.5;
             const double angle = rnd.get_double_in_range(-max_rotation_degrees, max_rotation_degrees)*pi/180;
@@ -298,8 +440,9 @@ namespace dlib
         }
 
         size_t randomly_pick_rect (
-            const std::vector<mmod_rect>& rects
-        ) 
+            const std::vector<mmod_rect>& rects,
+            dlib::rand& rnd
+        )
         {
             DLIB_CASSERT(has_non_ignored_box(rects));
             size_t idx = rnd.get_integer(rects.size());
@@ -310,7 +453,8 @@ namespace dlib
 
         template <typename image_type>
         rectangle make_random_cropping_rect(
-            const image_type& img_
+            const image_type& img_,
+            dlib::rand& rnd
         )
         {
             const_image_view<image_type> img(img_);
@@ -350,6 +494,9 @@ namespace dlib
         out << "  max_object_size:             " << item.get_max_object_size() << endl;
         out << "  background_crops_fraction:   " << item.get_background_crops_fraction() << endl;
         out << "  translate_amount:            " << item.get_translate_amount() << endl;
+        out << "  crop_cache_enabled:          " << std::boolalpha << item.crop_cache_enabled() << endl;
+        if (item.crop_cache_enabled())
+            out << "  crop_cache_max_size:         " << item.get_crop_cache_max_size() << endl;
         return out;
     }
 
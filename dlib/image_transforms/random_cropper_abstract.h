@@ -40,6 +40,7 @@ namespace dlib
                 - #get_max_object_size() == 0.7
                 - #get_background_crops_fraction() == 0.5
                 - #get_translate_amount() == 0.1
+                - #crop_cache_enabled() == false
         !*/
 
         void set_seed (
@@ -191,14 +192,89 @@ namespace dlib
 
         void set_max_object_size (
             double value
-        ); 
+        );
         /*!
             requires
-                - 0 < value 
+                - 0 < value
             ensures
                 - #get_max_object_size() == value
         !*/
 
+        bool crop_cache_enabled (
+        ) const;
+        /*!
+            ensures
+                - returns true if this object caches the crops it produces and false
+                  otherwise.
+        !*/
+
+        void enable_crop_cache (
+            size_t max_size,
+            size_t variants_per_image = 64
+        );
+        /*!
+            requires
+                - 0 < max_size
+                - 0 < variants_per_image
+            ensures
+                - #crop_cache_enabled() == true
+                - #get_crop_cache_max_size() == max_size
+                - #get_crop_cache_variants_per_image() == variants_per_image
+                - Subsequent crops are cached in RAM and reused when the same crop
+                  comes up again.  While the cache is enabled, each image yields one of
+                  variants_per_image possible crops, each derived deterministically
+                  from the image and the variant number, so after every variant has
+                  been made once further requests are served from the cache.  This
+                  bounds the augmentation diversity per image but avoids redoing the
+                  same interpolation work every epoch when training on a mostly static
+                  dataset.  The cache never holds more than max_size crops, with the
+                  oldest entries evicted first.
+        !*/
+
+        size_t get_crop_cache_variants_per_image (
+        ) const;
+        /*!
+            ensures
+                - returns the number of distinct crops each image can produce while the
+                  crop cache is enabled.
+        !*/
+
+        void disable_crop_cache (
+        );
+        /*!
+            ensures
+                - #crop_cache_enabled() == false
+                - #get_crop_cache_hits() == 0
+                - #get_crop_cache_misses() == 0
+                - any cached crops are freed.
+        !*/
+
+        size_t get_crop_cache_max_size (
+        ) const;
+        /*!
+            ensures
+                - returns the maximum number of crops the crop cache will hold.
+        !*/
+
+        size_t get_crop_cache_hits (
+        ) const;
+        size_t get_crop_cache_misses (
+        ) const;
+        /*!
+            ensures
+                - returns the number of crop requests that were served from the cache
+                  and the number that had to be made from scratch, respectively.
+        !*/
+
+        void clear_crop_cache (
+        );
+        /*!
+            ensures
+                - #get_crop_cache_hits() == 0
+                - #get_crop_cache_misses() == 0
+                - any cached crops are freed.
+        !*/
+
         template <
             typename array_type
             >
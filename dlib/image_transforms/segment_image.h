@@ -10,6 +10,8 @@
 #include "../disjoint_subsets.h"
 #include "assign_image.h"
 #include "../set.h"
+#include "../threads/async.h"
+#include <algorithm>
 
 namespace dlib
 {
@@ -249,78 +251,157 @@ namespace dlib
         
     // ----------------------------------------------------------------------------------------
 
-        // This is the general purpose version of get_pixel_edges().  It handles all pixel types.
+        // This builds the edges generated by the pixels in rows rbegin to rend-1.  It
+        // produces exactly the edges the serial border/interior scan used to make for
+        // those rows, just grouped by row so that disjoint row ranges can be handed to
+        // different threads.
         template <typename in_image_type, typename T>
-        typename disable_if<uint8_or_uint16_pixels<in_image_type> >::type 
-        get_pixel_edges (
+        void get_pixel_edges_for_rows (
             const in_image_type& in_img,
-            std::vector<segment_image_edge_data_T<T> >& sorted_edges
+            const long rbegin,
+            const long rend,
+            std::vector<segment_image_edge_data_T<T> >& edges
         )
-        {   
+        {
             const rectangle area = get_rect(in_img);
-            sorted_edges.reserve(area.area()*4);
 
             typedef typename in_image_type::pixel_type ptype;
             edge_diff_funct<ptype> edge_diff;
             typedef T diff_type;
             typedef segment_image_edge_data_T<T> segment_image_edge_data;
 
-            border_enumerator be(get_rect(in_img), 1);
-
-            // now build a sorted list of all the edges
-            be.reset();
-            while(be.move_next())
+            for (long r = rbegin; r < rend; ++r)
             {
-                const point p = be.element();
-                const long r = p.y();
-                const long c = p.x();
-                const ptype& pix = in_img[r][c];
-                if (area.contains(c-1,r))
+                for (long c = 0; c < in_img.nc(); ++c)
                 {
-                    const diff_type diff = edge_diff(pix, in_img[r  ][c-1]);
-                    sorted_edges.push_back(segment_image_edge_data(area,p,point(c-1,r),diff));
+                    const point p(c,r);
+                    const ptype& pix = in_img[r][c];
+                    if (r == 0 || r+1 == in_img.nr() || c == 0 || c+1 == in_img.nc())
+                    {
+                        // border pixels generate edges to all their neighbors
+                        if (area.contains(c-1,r))
+                        {
+                            const diff_type diff = edge_diff(pix, in_img[r  ][c-1]);
+                            edges.push_back(segment_image_edge_data(area,p,point(c-1,r),diff));
+                        }
+                        if (area.contains(c+1,r))
+                        {
+                            const diff_type diff = edge_diff(pix, in_img[r  ][c+1]);
+                            edges.push_back(segment_image_edge_data(area,p,point(c+1,r),diff));
+                        }
+                        if (area.contains(c  ,r-1))
+                        {
+                            const diff_type diff = edge_diff(pix, in_img[r-1][c  ]);
+                            edges.push_back( segment_image_edge_data(area,p,point(c  ,r-1),diff));
+                        }
+                        if (area.contains(c  ,r+1))
+                        {
+                            const diff_type diff = edge_diff(pix, in_img[r+1][c  ]);
+                            edges.push_back( segment_image_edge_data(area,p,point(c  ,r+1),diff));
+                        }
+                    }
+                    else
+                    {
+                        // Interior pixels only generate their "forward" edges, which
+                        // covers every interior edge exactly once and doesn't require
+                        // any boundary checking if statements.
+                        diff_type diff;
+
+                        diff = edge_diff(pix, in_img[r  ][c+1]);
+                        edges.push_back( segment_image_edge_data(area,p,point(c+1,r),diff));
+                        diff = edge_diff(pix, in_img[r+1][c+1]);
+                        edges.push_back( segment_image_edge_data(area,p,point(c+1,r+1),diff));
+                        diff = edge_diff(pix, in_img[r+1][c  ]);
+                        edges.push_back( segment_image_edge_data(area,p,point(c  ,r+1),diff));
+                        diff = edge_diff(pix, in_img[r-1][c+1]);
+                        edges.push_back( segment_image_edge_data(area,p,point(c+1,r-1),diff));
+                    }
                 }
+            }
+        }
 
-                if (area.contains(c+1,r))
-                {
-                    const diff_type diff = edge_diff(pix, in_img[r  ][c+1]);
-                    sorted_edges.push_back(segment_image_edge_data(area,p,point(c+1,r),diff));
-                }
+    // ----------------------------------------------------------------------------------------
 
-                if (area.contains(c  ,r-1))
-                {
-                    const diff_type diff = edge_diff(pix, in_img[r-1][c  ]);
-                    sorted_edges.push_back( segment_image_edge_data(area,p,point(c  ,r-1),diff));
-                }
-                if (area.contains(c  ,r+1))
+        // This is the general purpose version of get_pixel_edges().  It handles all pixel types.
+        template <typename in_image_type, typename T>
+        typename disable_if<uint8_or_uint16_pixels<in_image_type> >::type
+        get_pixel_edges (
+            const in_image_type& in_img,
+            std::vector<segment_image_edge_data_T<T> >& sorted_edges
+        )
+        {
+            typedef segment_image_edge_data_T<T> segment_image_edge_data;
+            sorted_edges.clear();
+
+            // Each row of pixels generates its edges independently of every other row,
+            // so on big images we build the graph in parallel over row ranges.  Each
+            // range is sorted on its own thread and the sorted runs are then merged
+            // pairwise, also in parallel.  The chunk boundaries only depend on the
+            // image size, so the output doesn't depend on how the tasks happen to get
+            // scheduled.
+            thread_pool& tp = default_thread_pool();
+            const long num_chunks = std::min<long>(tp.num_threads_in_pool()+1, in_img.nr()/64);
+            if (num_chunks < 2)
+            {
+                sorted_edges.reserve(get_rect(in_img).area()*4);
+                get_pixel_edges_for_rows(in_img, 0, in_img.nr(), sorted_edges);
+                std::sort(sorted_edges.begin(), sorted_edges.end());
+                return;
+            }
+
+            std::vector<std::vector<segment_image_edge_data> > chunks(num_chunks);
+            for (long i = 0; i < num_chunks; ++i)
+            {
+                const long rbegin = i*in_img.nr()/num_chunks;
+                const long rend = (i+1)*in_img.nr()/num_chunks;
+                tp.add_task_by_value([&,rbegin,rend,i]()
                 {
-                    const diff_type diff = edge_diff(pix, in_img[r+1][c  ]);
-                    sorted_edges.push_back( segment_image_edge_data(area,p,point(c  ,r+1),diff));
-                }
+                    get_pixel_edges_for_rows(in_img, rbegin, rend, chunks[i]);
+                    std::sort(chunks[i].begin(), chunks[i].end());
+                });
             }
-            // same thing as the above loop but now we do it on the interior of the image and therefore
-            // don't have to include the boundary checking if statements used above.
-            for (long r = 1; r+1 < in_img.nr(); ++r)
+            tp.wait_for_all_tasks();
+
+            // concatenate the sorted runs into sorted_edges, recording where each run
+            // begins and ends.
+            std::vector<size_t> bounds;
+            bounds.push_back(0);
+            for (auto& chunk : chunks)
+                bounds.push_back(bounds.back() + chunk.size());
+            sorted_edges.resize(bounds.back());
+            for (long i = 0; i < num_chunks; ++i)
             {
-                for (long c = 1; c+1 < in_img.nc(); ++c)
+                tp.add_task_by_value([&,i]()
                 {
-                    const point p(c,r);
-                    const ptype& pix = in_img[r][c];
-                    diff_type diff;
+                    std::copy(chunks[i].begin(), chunks[i].end(), sorted_edges.begin()+bounds[i]);
+                });
+            }
+            tp.wait_for_all_tasks();
 
-                    diff = edge_diff(pix, in_img[r  ][c+1]);
-                    sorted_edges.push_back( segment_image_edge_data(area,p,point(c+1,r),diff));
-                    diff = edge_diff(pix, in_img[r+1][c+1]);
-                    sorted_edges.push_back( segment_image_edge_data(area,p,point(c+1,r+1),diff));
-                    diff = edge_diff(pix, in_img[r+1][c  ]);
-                    sorted_edges.push_back( segment_image_edge_data(area,p,point(c  ,r+1),diff));
-                    diff = edge_diff(pix, in_img[r-1][c+1]);
-                    sorted_edges.push_back( segment_image_edge_data(area,p,point(c+1,r-1),diff));
+            // now merge adjacent pairs of runs until only one sorted run remains
+            while (bounds.size() > 2)
+            {
+                std::vector<size_t> next_bounds;
+                next_bounds.push_back(bounds[0]);
+                for (size_t i = 0; i+2 < bounds.size(); i += 2)
+                {
+                    const size_t first = bounds[i];
+                    const size_t mid   = bounds[i+1];
+                    const size_t last  = bounds[i+2];
+                    tp.add_task_by_value([&,first,mid,last]()
+                    {
+                        std::inplace_merge(sorted_edges.begin()+first,
+                                           sorted_edges.begin()+mid,
+                                           sorted_edges.begin()+last);
+                    });
+                    next_bounds.push_back(last);
                 }
+                // if there was an odd number of runs the last one just passes through
+                if (next_bounds.back() != bounds.back())
+                    next_bounds.push_back(bounds.back());
+                tp.wait_for_all_tasks();
+                bounds.swap(next_bounds);
             }
-
-            std::sort(sorted_edges.begin(), sorted_edges.end());
-
         }
 
     // ------------------------------------------------------------------------------------
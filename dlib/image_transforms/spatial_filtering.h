@@ -11,7 +11,9 @@
 #include "../matrix.h"
 #include "../geometry/border_enumerator.h"
 #include "../simd.h"
+#include "../threads.h"
 #include <limits>
+#include <vector>
 #include "assign_image.h"
 
 namespace dlib
@@ -33,7 +35,8 @@ namespace dlib
             const matrix_exp<EXP>& filter_,
             T scale,
             bool use_abs,
-            bool add_to
+            bool add_to,
+            thread_pool* tp = 0
         )
         {
             const_temp_matrix<EXP> filter(filter_);
@@ -76,8 +79,9 @@ namespace dlib
             if (!add_to)
                 zero_border_pixels(out_img_, non_border); 
 
-            // apply the filter to the image
-            for (long r = first_row; r < last_row; ++r)
+            // apply the filter to the image.  Each row is independent of the others so
+            // we can process them in parallel when given a thread pool.
+            auto filter_row = [&](long r)
             {
                 for (long c = first_col; c < last_col; ++c)
                 {
@@ -111,6 +115,16 @@ namespace dlib
                         assign_pixel(out_img[r][c], temp + out_img[r][c]);
                     }
                 }
+            };
+
+            if (tp)
+            {
+                parallel_for(*tp, first_row, last_row, filter_row);
+            }
+            else
+            {
+                for (long r = first_row; r < last_row; ++r)
+                    filter_row(r);
             }
 
             return non_border;
@@ -127,7 +141,8 @@ namespace dlib
             const in_image_type& in_img_,
             out_image_type& out_img_,
             const matrix_exp<EXP>& filter_,
-            bool add_to
+            bool add_to,
+            thread_pool* tp = 0
         )
         {
 
@@ -167,8 +182,9 @@ namespace dlib
             if (!add_to)
                 zero_border_pixels(out_img_, non_border); 
 
-            // apply the filter to the image
-            for (long r = first_row; r < last_row; ++r)
+            // apply the filter to the image.  Each row is independent of the others so
+            // we can process them in parallel when given a thread pool.
+            auto filter_row = [&](long r)
             {
                 long c = first_col;
                 for (; c < last_col-7; c+=8)
@@ -233,6 +249,16 @@ namespace dlib
                         out_img[r][c] += temp;
                     }
                 }
+            };
+
+            if (tp)
+            {
+                parallel_for(*tp, first_row, last_row, filter_row);
+            }
+            else
+            {
+                for (long r = first_row; r < last_row; ++r)
+                    filter_row(r);
             }
 
             return non_border;
@@ -481,10 +507,12 @@ namespace dlib
 
             array2d<ptype> temp_img;
             temp_img.set_size(in_img.nr(), in_img.nc());
+            DLIB_ASSUME(first_col >= 0 && last_col <= temp_img.nc());
 
             // apply the row filter
             for (long r = 0; r < in_img.nr(); ++r)
             {
+                ptype* trow = temp_img.row_ptr(r);
                 for (long c = first_col; c < last_col; ++c)
                 {
                     ptype p;
@@ -495,11 +523,11 @@ namespace dlib
                         p = get_pixel_intensity(in_img[r][c-first_col+n]);
                         temp += p*row_filter(n);
                     }
-                    temp_img[r][c] = temp;
+                    trow[c] = temp;
                 }
             }
 
-            // apply the column filter 
+            // apply the column filter
             for (long r = first_row; r < last_row; ++r)
             {
                 for (long c = first_col; c < last_col; ++c)
@@ -507,7 +535,7 @@ namespace dlib
                     ptype temp = 0;
                     for (long m = 0; m < col_filter.size(); ++m)
                     {
-                        temp += temp_img[r-first_row+m][c]*col_filter(m);
+                        temp += temp_img.row_ptr(r-first_row+m)[c]*col_filter(m);
                     }
 
                     temp /= scale;
@@ -902,6 +930,154 @@ namespace dlib
         return spatially_filter_image_separable(in_img,out_img,row_filter,col_filter,1);
     }
 
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename EXP
+        >
+    bool find_separable_filter (
+        const matrix_exp<EXP>& filter_,
+        matrix<typename EXP::type,0,1>& row_filter,
+        matrix<typename EXP::type,0,1>& col_filter
+    )
+    {
+        const_temp_matrix<EXP> filter(filter_);
+        typedef typename EXP::type T;
+
+        DLIB_ASSERT(filter.size() != 0,
+            "\tbool find_separable_filter()"
+            << "\n\t You can't give an empty filter."
+            << "\n\t filter.nr(): "<< filter.nr()
+            << "\n\t filter.nc(): "<< filter.nc()
+        );
+
+        // A filter is separable when it's the outer product of two vectors, i.e. when it
+        // has rank 1.  Find the largest magnitude element and use its row and column as
+        // the candidate factorization, pivoting on the largest element for numerical
+        // stability.
+        long mr = 0, mc = 0;
+        T best = 0;
+        for (long r = 0; r < filter.nr(); ++r)
+        {
+            for (long c = 0; c < filter.nc(); ++c)
+            {
+                const T temp = std::abs(filter(r,c));
+                if (temp > best)
+                {
+                    best = temp;
+                    mr = r;
+                    mc = c;
+                }
+            }
+        }
+        // an all zero filter isn't usefully separable
+        if (best == 0)
+            return false;
+
+        col_filter = colm(filter, mc);
+        row_filter = trans(rowm(filter, mr))/filter(mr,mc);
+
+        // Accept the factorization only if it reproduces the filter to within rounding
+        // error.
+        const T tol = 100*std::numeric_limits<T>::epsilon()*best;
+        for (long r = 0; r < filter.nr(); ++r)
+        {
+            for (long c = 0; c < filter.nc(); ++c)
+            {
+                if (std::abs(filter(r,c) - col_filter(r)*row_filter(c)) > tol)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename in_image_type,
+        typename out_image_type,
+        typename EXP,
+        typename T
+        >
+    typename enable_if_c<pixel_traits<typename image_traits<out_image_type>::pixel_type>::grayscale &&
+                         is_float_filtering2<in_image_type,out_image_type,EXP>::value,rectangle>::type
+    spatially_filter_image (
+        thread_pool& tp,
+        const in_image_type& in_img,
+        out_image_type& out_img,
+        const matrix_exp<EXP>& filter,
+        T scale,
+        bool use_abs = false,
+        bool add_to = false
+    )
+    {
+        // If the filter is the outer product of two vectors then run the much cheaper
+        // separable version instead of doing the full 2D filtering.
+        matrix<typename EXP::type,0,1> row_filter, col_filter;
+        if (filter.nr() > 1 && filter.nc() > 1 && find_separable_filter(filter, row_filter, col_filter))
+            return spatially_filter_image_separable(in_img, out_img, row_filter, col_filter, scale, use_abs, add_to);
+
+        if (use_abs == false)
+        {
+            if (scale == 1)
+                return impl::float_spatially_filter_image(in_img, out_img, filter, add_to, &tp);
+            else
+                return impl::float_spatially_filter_image(in_img, out_img, filter/scale, add_to, &tp);
+        }
+        else
+        {
+            return impl::grayscale_spatially_filter_image(in_img, out_img, filter, scale, true, add_to, &tp);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename in_image_type,
+        typename out_image_type,
+        typename EXP,
+        typename T
+        >
+    typename enable_if_c<pixel_traits<typename image_traits<out_image_type>::pixel_type>::grayscale &&
+                         !is_float_filtering2<in_image_type,out_image_type,EXP>::value,rectangle>::type
+    spatially_filter_image (
+        thread_pool& tp,
+        const in_image_type& in_img,
+        out_image_type& out_img,
+        const matrix_exp<EXP>& filter,
+        T scale,
+        bool use_abs = false,
+        bool add_to = false
+    )
+    {
+        // If the filter is the outer product of two vectors then run the much cheaper
+        // separable version instead of doing the full 2D filtering.
+        matrix<typename EXP::type,0,1> row_filter, col_filter;
+        if (filter.nr() > 1 && filter.nc() > 1 && find_separable_filter(filter, row_filter, col_filter))
+            return spatially_filter_image_separable(in_img, out_img, row_filter, col_filter, scale, use_abs, add_to);
+
+        return impl::grayscale_spatially_filter_image(in_img,out_img,filter,scale,use_abs,add_to,&tp);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename in_image_type,
+        typename out_image_type,
+        typename EXP
+        >
+    rectangle spatially_filter_image (
+        thread_pool& tp,
+        const in_image_type& in_img,
+        out_image_type& out_img,
+        const matrix_exp<EXP>& filter
+    )
+    {
+        return spatially_filter_image(tp,in_img,out_img,filter,1);
+    }
+
 // ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
@@ -1256,6 +1432,296 @@ namespace dlib
 
     }
 
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        template <
+            typename in_image_type,
+            typename out_image_type,
+            typename ptype
+            >
+        typename enable_if_c<pixel_traits<typename image_traits<out_image_type>::pixel_type>::grayscale,rectangle>::type
+        fused_separable_blur (
+            const in_image_type& in_img_,
+            out_image_type& out_img_,
+            const matrix<ptype,0,1>& filt,
+            ptype scale,
+            std::vector<char>& scratch
+        )
+        {
+            COMPILE_TIME_ASSERT( pixel_traits<typename image_traits<in_image_type>::pixel_type>::has_alpha == false );
+            COMPILE_TIME_ASSERT( pixel_traits<typename image_traits<out_image_type>::pixel_type>::has_alpha == false );
+
+            const_image_view<in_image_type> in_img(in_img_);
+            image_view<out_image_type> out_img(out_img_);
+
+            // if there isn't any input image then don't do anything
+            if (in_img.size() == 0)
+            {
+                out_img.clear();
+                return rectangle();
+            }
+
+            out_img.set_size(in_img.nr(),in_img.nc());
+
+            const long w = filt.size();
+            const long nc = in_img.nc();
+            const long first_row = w/2;
+            const long first_col = w/2;
+            const long last_row = in_img.nr() - ((w-1)/2);
+            const long last_col = nc - ((w-1)/2);
+
+            const rectangle non_border = rectangle(first_col, first_row, last_col-1, last_row-1);
+            zero_border_pixels(out_img, non_border);
+
+            // The row filtered rows live in a ring of w slots, so we do the horizontal
+            // and vertical passes in one sweep over the image and only ever keep w+2
+            // rows of intermediate values rather than a whole temporary image.  The
+            // scratch buffer is grown once and reused from call to call.
+            const size_t needed = sizeof(ptype)*(size_t)(w+2)*nc;
+            if (scratch.size() < needed)
+                scratch.resize(needed);
+            ptype* const ring = reinterpret_cast<ptype*>(&scratch[0]);
+            ptype* const row_in = ring + w*nc;
+            ptype* const col_acc = row_in + nc;
+
+            for (long r = 0; r < in_img.nr(); ++r)
+            {
+                // apply the row filter to row r, putting the result into its ring slot
+                ptype* const ring_row = ring + (r%w)*nc;
+                for (long c = 0; c < nc; ++c)
+                    row_in[c] = get_pixel_intensity(in_img[r][c]);
+                for (long c = first_col; c < last_col; ++c)
+                    ring_row[c] = 0;
+                for (long n = 0; n < w; ++n)
+                {
+                    const ptype fv = filt(n);
+                    for (long c = first_col; c < last_col; ++c)
+                        ring_row[c] += row_in[c-first_col+n]*fv;
+                }
+
+                // Once w rows are in the ring the column filter window ending at row r
+                // is complete, so emit that output row.
+                const long out_r = r - (w-1) + first_row;
+                if (out_r >= first_row && out_r < last_row)
+                {
+                    for (long c = first_col; c < last_col; ++c)
+                        col_acc[c] = 0;
+                    for (long m = 0; m < w; ++m)
+                    {
+                        const ptype fv = filt(m);
+                        const ptype* const trow = ring + ((out_r-first_row+m)%w)*nc;
+                        for (long c = first_col; c < last_col; ++c)
+                            col_acc[c] += trow[c]*fv;
+                    }
+                    for (long c = first_col; c < last_col; ++c)
+                        assign_pixel(out_img[out_r][c], col_acc[c]/scale);
+                }
+            }
+            return non_border;
+        }
+
+        template <
+            typename in_image_type,
+            typename out_image_type,
+            typename ptype
+            >
+        typename disable_if_c<pixel_traits<typename image_traits<out_image_type>::pixel_type>::grayscale,rectangle>::type
+        fused_separable_blur (
+            const in_image_type& in_img_,
+            out_image_type& out_img_,
+            const matrix<ptype,0,1>& filt,
+            ptype scale,
+            std::vector<char>& scratch
+        )
+        {
+            COMPILE_TIME_ASSERT( pixel_traits<typename image_traits<in_image_type>::pixel_type>::has_alpha == false );
+            COMPILE_TIME_ASSERT( pixel_traits<typename image_traits<out_image_type>::pixel_type>::has_alpha == false );
+
+            const_image_view<in_image_type> in_img(in_img_);
+            image_view<out_image_type> out_img(out_img_);
+
+            // if there isn't any input image then don't do anything
+            if (in_img.size() == 0)
+            {
+                out_img.clear();
+                return rectangle();
+            }
+
+            out_img.set_size(in_img.nr(),in_img.nc());
+
+            typedef typename image_traits<in_image_type>::pixel_type pixel_type;
+            const long num = pixel_traits<pixel_type>::num;
+
+            const long w = filt.size();
+            const long nc = in_img.nc();
+            const long first_row = w/2;
+            const long first_col = w/2;
+            const long last_row = in_img.nr() - ((w-1)/2);
+            const long last_col = nc - ((w-1)/2);
+
+            const rectangle non_border = rectangle(first_col, first_row, last_col-1, last_row-1);
+            zero_border_pixels(out_img, non_border);
+
+            // Same single sweep ring buffer scheme as the grayscale version above, just
+            // with the color channels stored interleaved so a shift by one pixel is a
+            // shift by num elements.
+            const size_t needed = sizeof(ptype)*(size_t)(w+2)*nc*num;
+            if (scratch.size() < needed)
+                scratch.resize(needed);
+            ptype* const ring = reinterpret_cast<ptype*>(&scratch[0]);
+            ptype* const row_in = ring + w*nc*num;
+            ptype* const col_acc = row_in + nc*num;
+
+            for (long r = 0; r < in_img.nr(); ++r)
+            {
+                // apply the row filter to row r, putting the result into its ring slot
+                ptype* const ring_row = ring + (r%w)*nc*num;
+                for (long c = 0; c < nc; ++c)
+                {
+                    const matrix<ptype,pixel_traits<pixel_type>::num,1> p = pixel_to_vector<ptype>(in_img[r][c]);
+                    for (long k = 0; k < num; ++k)
+                        row_in[c*num+k] = p(k);
+                }
+                for (long j = first_col*num; j < last_col*num; ++j)
+                    ring_row[j] = 0;
+                for (long n = 0; n < w; ++n)
+                {
+                    const ptype fv = filt(n);
+                    for (long j = first_col*num; j < last_col*num; ++j)
+                        ring_row[j] += row_in[j+(n-first_col)*num]*fv;
+                }
+
+                // Once w rows are in the ring the column filter window ending at row r
+                // is complete, so emit that output row.
+                const long out_r = r - (w-1) + first_row;
+                if (out_r >= first_row && out_r < last_row)
+                {
+                    for (long j = first_col*num; j < last_col*num; ++j)
+                        col_acc[j] = 0;
+                    for (long m = 0; m < w; ++m)
+                    {
+                        const ptype fv = filt(m);
+                        const ptype* const trow = ring + ((out_r-first_row+m)%w)*nc*num;
+                        for (long j = first_col*num; j < last_col*num; ++j)
+                            col_acc[j] += trow[j]*fv;
+                    }
+                    for (long c = first_col; c < last_col; ++c)
+                    {
+                        matrix<ptype,pixel_traits<pixel_type>::num,1> temp;
+                        for (long k = 0; k < num; ++k)
+                            temp(k) = col_acc[c*num+k]/scale;
+                        pixel_type p;
+                        vector_to_pixel(p, temp);
+                        assign_pixel(out_img[out_r][c], p);
+                    }
+                }
+            }
+            return non_border;
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class gaussian_blur_filter
+    {
+    public:
+
+        explicit gaussian_blur_filter (
+            double sigma_ = 1,
+            int max_size_ = 1001
+        ) :
+            sigma(sigma_),
+            max_size(max_size_)
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(sigma > 0 && max_size > 0 && (max_size%2)==1,
+                "\t gaussian_blur_filter::gaussian_blur_filter()"
+                << "\n\t Invalid inputs were given to this function."
+                << "\n\t sigma:    " << sigma
+                << "\n\t max_size: " << max_size
+            );
+
+            // Build the kernel once up front.  filt_quantized holds the same values
+            // create_gaussian_filter<T>() produces for integer T.
+            filt_real = create_gaussian_filter<double>(sigma, max_size);
+            filt_quantized = round(filt_real/filt_real(0));
+        }
+
+        double get_sigma (
+        ) const { return sigma; }
+
+        int get_max_size (
+        ) const { return max_size; }
+
+        template <
+            typename in_image_type,
+            typename out_image_type
+            >
+        rectangle operator() (
+            const in_image_type& in_img,
+            out_image_type& out_img
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(is_same_object(in_img, out_img) == false,
+                "\t rectangle gaussian_blur_filter::operator()"
+                << "\n\t Invalid inputs were given to this function."
+                << "\n\t is_same_object(in_img,out_img): " << is_same_object(in_img,out_img)
+                << "\n\t this: " << this
+            );
+
+            // This is the same type and kernel selection logic used by gaussian_blur(),
+            // so the output is the same.  The difference is that the kernel is already
+            // built and the filtering happens in one fused sweep using the ring buffer.
+            if (sigma < 18)
+            {
+                typedef typename pixel_traits<typename image_traits<out_image_type>::pixel_type>::basic_pixel_type type;
+                typedef typename promote<type>::type ptype;
+                if (is_float_type<ptype>::value)
+                    return blur_with<ptype>(in_img, out_img, filt_real);
+                else
+                    return blur_with<ptype>(in_img, out_img, filt_quantized);
+            }
+            else
+            {
+                // For large sigma we need to use a type with a lot of precision to
+                // avoid numerical problems.  So we use double here.
+                return blur_with<double>(in_img, out_img, filt_real);
+            }
+        }
+
+    private:
+
+        template <
+            typename ptype,
+            typename in_image_type,
+            typename out_image_type
+            >
+        rectangle blur_with (
+            const in_image_type& in_img,
+            out_image_type& out_img,
+            const matrix<double,0,1>& f
+        ) const
+        {
+            const matrix<ptype,0,1> filt = matrix_cast<ptype>(f);
+            ptype scale = sum(filt);
+            scale = scale*scale;
+            return impl::fused_separable_blur(in_img, out_img, filt, scale, scratch);
+        }
+
+        double sigma;
+        int max_size;
+        matrix<double,0,1> filt_real;
+        matrix<double,0,1> filt_quantized;
+
+        // This is just scratch space that doesn't contribute to the state of this
+        // object.  Note that its use makes operator() not threadsafe, so each thread
+        // should use its own gaussian_blur_filter.
+        mutable std::vector<char> scratch;
+    };
+
 // ----------------------------------------------------------------------------------------
 
     namespace impl
@@ -71,6 +71,48 @@ namespace dlib
                   you can use this form of the function it can give a decent speed boost.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename in_image_type,
+        typename out_image_type,
+        typename EXP,
+        typename T
+        >
+    rectangle spatially_filter_image (
+        thread_pool& tp,
+        const in_image_type& in_img,
+        out_image_type& out_img,
+        const matrix_exp<EXP>& filter,
+        T scale = 1,
+        bool use_abs = false,
+        bool add_to = false
+    );
+    /*!
+        requires
+            - in_image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+            - out_image_type == an image object that implements the interface defined in
+              dlib/image_processing/generic_image.h
+            - out_img contains grayscale pixels.
+            - in_img and out_img do not contain pixels with an alpha channel.  That is,
+              pixel_traits::has_alpha is false for the pixels in these objects.
+            - is_same_object(in_img, out_img) == false
+            - T must be some scalar type
+            - filter.size() != 0
+            - scale != 0
+        ensures
+            - This function is identical to the above spatially_filter_image() routine
+              except that it uses the given thread pool to filter blocks of image rows in
+              parallel.  So for large filters on large images it runs a good deal faster,
+              at no cost in accuracy since the output is identical either way.
+            - Additionally, if the filter is the outer product of two vectors (i.e.
+              find_separable_filter(filter, row_filter, col_filter) returns true) then
+              this function applies the two vectors with
+              spatially_filter_image_separable() rather than running the full 2D filter,
+              which is a large speedup for big filters like Gaussians.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -140,6 +182,39 @@ namespace dlib
                   you can use this form of the function it can give a decent speed boost.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename EXP
+        >
+    bool find_separable_filter (
+        const matrix_exp<EXP>& filter,
+        matrix<typename EXP::type,0,1>& row_filter,
+        matrix<typename EXP::type,0,1>& col_filter
+    );
+    /*!
+        requires
+            - filter.size() != 0
+        ensures
+            - Checks if filter is separable, that is, if it can be written as the outer
+              product of two vectors.  Filters like Gaussians have this property and
+              applying the two vectors with spatially_filter_image_separable() is much
+              cheaper than applying the full 2D filter.
+            - if (filter is separable) then
+                - returns true
+                - for all valid r and c:
+                    - filter(r,c) == #col_filter(r)*#row_filter(c)
+                      (to within rounding error)
+                - Therefore, spatially_filter_image_separable(in_img,out_img,#row_filter,#col_filter)
+                  produces the same output as spatially_filter_image(in_img,out_img,filter).
+            - else
+                - returns false
+            - Note that the separability test compares against a tolerance scaled by
+              EXP::type's machine epsilon.  So for integer filters the factorization has
+              to be exact, which means integer filters that are separable only in real
+              arithmetic will be rejected.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -384,14 +459,89 @@ namespace dlib
               inside the image are set to zero.
             - #out_img.nc() == in_img.nc()
             - #out_img.nr() == in_img.nr()
-            - returns a rectangle which indicates what pixels in #out_img are considered 
+            - returns a rectangle which indicates what pixels in #out_img are considered
               non-border pixels and therefore contain output from the filter.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    class gaussian_blur_filter
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object performs the same job as the gaussian_blur() routine defined
+                above but is meant to be kept around and applied many times, such as
+                once per video frame.  It builds the Gaussian kernel once in its
+                constructor and filters with a single fused sweep over the image that
+                keeps only a small ring buffer of row filtered rows, rather than
+                computing the kernel and allocating a whole temporary image on every
+                call.  The output is identical to gaussian_blur() for integer pixel
+                types and equal up to floating point rounding otherwise.
+
+            THREAD SAFETY
+                operator() uses scratch space inside this object, so it is not safe for
+                multiple threads to use one gaussian_blur_filter at the same time.
+                Give each thread its own instance instead.
+        !*/
+    public:
+
+        explicit gaussian_blur_filter (
+            double sigma = 1,
+            int max_size = 1001
+        );
+        /*!
+            requires
+                - sigma > 0
+                - max_size > 0
+                - max_size is an odd number
+            ensures
+                - #get_sigma() == sigma
+                - #get_max_size() == max_size
+        !*/
+
+        double get_sigma (
+        ) const;
+        /*!
+            ensures
+                - returns the width of the Gaussian filter applied by this object.
+        !*/
+
+        int get_max_size (
+        ) const;
+        /*!
+            ensures
+                - returns the upper limit on the spatial size of the filter, as
+                  described in gaussian_blur().
+        !*/
+
+        template <
+            typename in_image_type,
+            typename out_image_type
+            >
+        rectangle operator() (
+            const in_image_type& in_img,
+            out_image_type& out_img
+        ) const;
+        /*!
+            requires
+                - in_image_type == an image object that implements the interface defined in
+                  dlib/image_processing/generic_image.h
+                - out_image_type == an image object that implements the interface defined in
+                  dlib/image_processing/generic_image.h
+                - in_img and out_img do not contain pixels with an alpha channel.  That is,
+                  pixel_traits::has_alpha is false for the pixels in these objects.
+                - is_same_object(in_img, out_img) == false
+            ensures
+                - performs: return gaussian_blur(in_img, out_img, get_sigma(), get_max_size())
+                  (except that the kernel is not rebuilt and no temporary image is
+                  allocated, so repeated calls are faster)
+        !*/
+    };
+
 // ----------------------------------------------------------------------------------------
 
     template <
-        typename image_type1, 
+        typename image_type1,
         typename image_type2
         >
     void sum_filter (
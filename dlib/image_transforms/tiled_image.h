@@ -0,0 +1,293 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_TILED_IMAGe_Hh_
+#define DLIB_TILED_IMAGe_Hh_
+
+#include "tiled_image_abstract.h"
+#include "../algs.h"
+#include "../assert.h"
+#include "../geometry.h"
+#include "../pixel.h"
+#include "../image_processing/generic_image.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        inline void tiled_image_seek (
+            std::FILE* fp,
+            unsigned long long offset
+        )
+        /*!
+            ensures
+                - moves fp's file position to the given absolute byte offset, using a
+                  64 bit seek so files bigger than 2GB work.
+        !*/
+        {
+#ifdef WIN32
+            _fseeki64(fp, static_cast<long long>(offset), SEEK_SET);
+#else
+            std::fseek(fp, static_cast<long>(offset), SEEK_SET);
+#endif
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename pixel_type
+        >
+    class tiled_image : noncopyable
+    {
+        /*!
+            INITIAL VALUE
+                - rows == 0
+                - cols == 0
+                - fp == 0
+
+            CONVENTION
+                - nr() == rows
+                - nc() == cols
+                - if (rows != 0) then
+                    - fp == an open stdio file holding the pixels in row major order,
+                      sizeof(pixel_type) bytes each, with no header.  The file may be
+                      shorter than rows*cols pixels; anything past its end reads as
+                      zero bytes.
+        !*/
+
+    public:
+
+        tiled_image (
+        ) :
+            fp(0),
+            rows(0),
+            cols(0)
+        {}
+
+        ~tiled_image (
+        )
+        {
+            clear();
+        }
+
+        void clear (
+        )
+        {
+            if (fp)
+                std::fclose(fp);
+            fp = 0;
+            rows = 0;
+            cols = 0;
+        }
+
+        void set_size (
+            long rows_,
+            long cols_
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(rows_ > 0 && cols_ > 0,
+                "\t void tiled_image::set_size(rows, cols)"
+                << "\n\t Invalid inputs were given to this function"
+                << "\n\t rows: " << rows_
+                << "\n\t cols: " << cols_
+                );
+
+            clear();
+            fp = std::tmpfile();
+            if (fp == 0)
+                throw error("tiled_image: unable to create temporary backing file");
+            rows = rows_;
+            cols = cols_;
+        }
+
+        void set_size (
+            long rows_,
+            long cols_,
+            const std::string& filename
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(rows_ > 0 && cols_ > 0,
+                "\t void tiled_image::set_size(rows, cols, filename)"
+                << "\n\t Invalid inputs were given to this function"
+                << "\n\t rows: " << rows_
+                << "\n\t cols: " << cols_
+                );
+
+            clear();
+            fp = std::fopen(filename.c_str(), "wb+");
+            if (fp == 0)
+                throw error("tiled_image: unable to open backing file " + filename);
+            rows = rows_;
+            cols = cols_;
+        }
+
+        long nr (
+        ) const { return rows; }
+
+        long nc (
+        ) const { return cols; }
+
+        template <
+            typename image_type
+            >
+        void load_block (
+            const rectangle& block,
+            image_type& img
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(rectangle(0,0,cols-1,rows-1).contains(block) || block.is_empty(),
+                "\t void tiled_image::load_block(block, img)"
+                << "\n\t The given block must fit inside the image"
+                << "\n\t block: " << block
+                << "\n\t nr():  " << nr()
+                << "\n\t nc():  " << nc()
+                );
+
+            set_image_size(img, block.height(), block.width());
+            if (block.is_empty())
+                return;
+
+            image_view<image_type> view(img);
+            std::vector<pixel_type> rowbuf(block.width());
+            for (long r = 0; r < (long)block.height(); ++r)
+            {
+                const unsigned long long offset =
+                    (static_cast<unsigned long long>(block.top()+r)*cols + block.left())*sizeof(pixel_type);
+                impl::tiled_image_seek(fp, offset);
+                const size_t got = std::fread(&rowbuf[0], sizeof(pixel_type), rowbuf.size(), fp);
+                // anything past the end of the backing file reads as zeros
+                if (got < rowbuf.size())
+                    std::memset(&rowbuf[got], 0, sizeof(pixel_type)*(rowbuf.size()-got));
+                for (long c = 0; c < (long)block.width(); ++c)
+                    assign_pixel(view[r][c], rowbuf[c]);
+            }
+        }
+
+        template <
+            typename image_type
+            >
+        void save_block (
+            const rectangle& block,
+            const image_type& img
+        )
+        {
+            const_image_view<image_type> view(img);
+
+            // make sure requires clause is not broken
+            DLIB_ASSERT((rectangle(0,0,cols-1,rows-1).contains(block) &&
+                         view.nr() == (long)block.height() &&
+                         view.nc() == (long)block.width()) || block.is_empty(),
+                "\t void tiled_image::save_block(block, img)"
+                << "\n\t The given block must fit inside the image and match img's dimensions"
+                << "\n\t block:     " << block
+                << "\n\t nr():      " << nr()
+                << "\n\t nc():      " << nc()
+                << "\n\t view.nr(): " << view.nr()
+                << "\n\t view.nc(): " << view.nc()
+                );
+
+            if (block.is_empty())
+                return;
+
+            std::vector<pixel_type> rowbuf(block.width());
+            for (long r = 0; r < (long)block.height(); ++r)
+            {
+                for (long c = 0; c < (long)block.width(); ++c)
+                    assign_pixel(rowbuf[c], view[r][c]);
+                const unsigned long long offset =
+                    (static_cast<unsigned long long>(block.top()+r)*cols + block.left())*sizeof(pixel_type);
+                impl::tiled_image_seek(fp, offset);
+                if (std::fwrite(&rowbuf[0], sizeof(pixel_type), rowbuf.size(), fp) != rowbuf.size())
+                    throw error("tiled_image: error writing to backing file");
+            }
+        }
+
+    private:
+
+        std::FILE* fp;
+        long rows;
+        long cols;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename in_pixel_type,
+        typename out_pixel_type,
+        typename funct_type
+        >
+    void process_tiles (
+        const tiled_image<in_pixel_type>& src,
+        tiled_image<out_pixel_type>& dest,
+        const funct_type& funct,
+        long tile_size = 2048,
+        long halo = 0
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT(dest.nr() == src.nr() && dest.nc() == src.nc() &&
+                    tile_size > 0 && halo >= 0,
+            "\t void process_tiles()"
+            << "\n\t Invalid inputs were given to this function"
+            << "\n\t src.nr():  " << src.nr()
+            << "\n\t src.nc():  " << src.nc()
+            << "\n\t dest.nr(): " << dest.nr()
+            << "\n\t dest.nc(): " << dest.nc()
+            << "\n\t tile_size: " << tile_size
+            << "\n\t halo:      " << halo
+            );
+
+        const rectangle area(0, 0, src.nc()-1, src.nr()-1);
+        array2d<in_pixel_type> window;
+        array2d<out_pixel_type> window_out;
+        array2d<out_pixel_type> tile_out;
+        for (long r = 0; r < src.nr(); r += tile_size)
+        {
+            for (long c = 0; c < src.nc(); c += tile_size)
+            {
+                const rectangle tile(c, r,
+                                     std::min(c+tile_size, src.nc())-1,
+                                     std::min(r+tile_size, src.nr())-1);
+                const rectangle win = grow_rect(tile, halo).intersect(area);
+
+                src.load_block(win, window);
+                funct(window, window_out);
+                DLIB_CASSERT(window_out.nr() == window.nr() && window_out.nc() == window.nc(),
+                    "\t void process_tiles()"
+                    << "\n\t The given function must output an image with the same dimensions as its input"
+                    << "\n\t window.nr():     " << window.nr()
+                    << "\n\t window.nc():     " << window.nc()
+                    << "\n\t window_out.nr(): " << window_out.nr()
+                    << "\n\t window_out.nc(): " << window_out.nc()
+                    );
+
+                // Write back just the tile's interior, dropping the halo.
+                const long roff = tile.top()-win.top();
+                const long coff = tile.left()-win.left();
+                tile_out.set_size(tile.height(), tile.width());
+                for (long i = 0; i < tile_out.nr(); ++i)
+                {
+                    for (long j = 0; j < tile_out.nc(); ++j)
+                        tile_out[i][j] = window_out[roff+i][coff+j];
+                }
+                dest.save_block(tile, tile_out);
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_TILED_IMAGe_Hh_
+
@@ -0,0 +1,222 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_TILED_IMAGe_ABSTRACT_Hh_
+#ifdef DLIB_TILED_IMAGe_ABSTRACT_Hh_
+
+#include "../geometry.h"
+#include "../pixel.h"
+#include <string>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename pixel_type
+        >
+    class tiled_image : noncopyable
+    {
+        /*!
+            REQUIREMENTS ON pixel_type
+                - pixel_traits<pixel_type> must be defined
+
+            INITIAL VALUE
+                - nr() == 0
+                - nc() == 0
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a 2D image of pixels which lives in a file on disk
+                rather than in RAM.  It exists so that dlib's image processing
+                pipelines can work on images far too big to load into memory (e.g.
+                100000x100000 pixel aerial imagery).  You never touch the whole
+                image at once.  Instead, you move rectangular blocks of it between
+                the file and ordinary in-memory image objects with load_block() and
+                save_block().  The in-memory blocks are regular generic images, so
+                all of dlib's existing image processing routines can run on them
+                unmodified.  See also process_tiles() below, which automates
+                running a routine over an entire tiled_image one block at a time.
+
+                The backing file holds the pixels in row major order with no
+                header.  Parts of the image which have never been written read
+                back as zero filled pixels.
+        !*/
+
+    public:
+
+        tiled_image (
+        );
+        /*!
+            ensures
+                - #*this is properly initialized
+        !*/
+
+        ~tiled_image (
+        );
+        /*!
+            ensures
+                - any resources associated with *this have been released.  If the
+                  backing file was a temporary it is deleted.
+        !*/
+
+        void clear (
+        );
+        /*!
+            ensures
+                - #*this has its initial value
+                - closes the backing file.  If it was a temporary it is deleted.
+        !*/
+
+        void set_size (
+            long rows,
+            long cols
+        );
+        /*!
+            requires
+                - rows > 0
+                - cols > 0
+            ensures
+                - #nr() == rows
+                - #nc() == cols
+                - the image is backed by a newly created temporary file which is
+                  automatically deleted when *this is cleared or destructed.
+                - all pixels initially read back as zero filled.
+            throws
+                - dlib::error
+                    if the temporary file can't be created.
+        !*/
+
+        void set_size (
+            long rows,
+            long cols,
+            const std::string& filename
+        );
+        /*!
+            requires
+                - rows > 0
+                - cols > 0
+            ensures
+                - #nr() == rows
+                - #nc() == cols
+                - the image is backed by the file with the given name.  The file
+                  is created, or truncated if it already exists, and is left on
+                  disk when *this is cleared or destructed.
+                - all pixels initially read back as zero filled.
+            throws
+                - dlib::error
+                    if the file can't be opened.
+        !*/
+
+        long nr (
+        ) const;
+        /*!
+            ensures
+                - returns the number of rows in this image
+        !*/
+
+        long nc (
+        ) const;
+        /*!
+            ensures
+                - returns the number of columns in this image
+        !*/
+
+        template <
+            typename image_type
+            >
+        void load_block (
+            const rectangle& block,
+            image_type& img
+        ) const;
+        /*!
+            requires
+                - image_type == an image object that implements the interface
+                  defined in dlib/image_processing/generic_image.h
+                - block.is_empty() == true || get_rect(*this).contains(block) == true
+                  (i.e. the block must fit inside the image)
+                - pixel_traits<typename image_traits<image_type>::pixel_type> is defined
+            ensures
+                - #img.nr() == block.height()
+                - #img.nc() == block.width()
+                - #img contains a copy of the given rectangular block of this
+                  image, converted via assign_pixel().  That is, for all valid
+                  r and c:
+                    - #img[r][c] == the pixel at row block.top()+r and column
+                      block.left()+c of this image.
+        !*/
+
+        template <
+            typename image_type
+            >
+        void save_block (
+            const rectangle& block,
+            const image_type& img
+        );
+        /*!
+            requires
+                - image_type == an image object that implements the interface
+                  defined in dlib/image_processing/generic_image.h
+                - block.is_empty() == true || all of the following are true:
+                    - get_rect(*this).contains(block) == true
+                    - num_rows(img) == block.height()
+                    - num_columns(img) == block.width()
+                - pixel_traits<typename image_traits<image_type>::pixel_type> is defined
+            ensures
+                - writes img into the given rectangular block of this image,
+                  converting via assign_pixel().  That is, for all valid r and c,
+                  the pixel at row block.top()+r and column block.left()+c of
+                  this image is set to img[r][c].
+            throws
+                - dlib::error
+                    if writing to the backing file fails.
+        !*/
+
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename in_pixel_type,
+        typename out_pixel_type,
+        typename funct_type
+        >
+    void process_tiles (
+        const tiled_image<in_pixel_type>& src,
+        tiled_image<out_pixel_type>& dest,
+        const funct_type& funct,
+        long tile_size = 2048,
+        long halo = 0
+    );
+    /*!
+        requires
+            - src.nr() == dest.nr()
+            - src.nc() == dest.nc()
+            - tile_size > 0
+            - halo >= 0
+            - funct is callable as funct(in, out) where in is a
+              const array2d<in_pixel_type>& and out is an array2d<out_pixel_type>&,
+              and after the call out has the same dimensions as in.
+        ensures
+            - Runs funct over src one tile at a time and stores the results into
+              dest, so that pixel-local image processing routines can be applied
+              to images much bigger than RAM.  In particular:
+                - src is partitioned into tiles of at most tile_size by tile_size
+                  pixels.  For each tile, the tile grown by halo pixels on every
+                  side (and clipped to the image boundary) is read into memory,
+                  funct is invoked on it, and only the tile's interior of funct's
+                  output is written back to dest.  The halo pixels exist solely to
+                  give funct the neighborhood context it needs at tile borders.
+            - If funct's output at each pixel depends only on input pixels within
+              halo of that pixel (e.g. spatially_filter_image() with a filter of
+              radius <= halo, or threshold_image() with halo == 0) then dest ends
+              up exactly as if funct had been run on the whole of src at once.
+            - At most one window of (tile_size+2*halo)^2 input pixels and its
+              output are resident in memory at any time.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_TILED_IMAGe_ABSTRACT_Hh_
+
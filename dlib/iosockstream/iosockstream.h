@@ -100,7 +100,10 @@ namespace dlib
             {
                 if (buf)
                 {
-                    dlib::timeout t(*con,&connection::shutdown,timeout);
+                    // All the iosockstreams share one timeout service so that having
+                    // thousands of connections open doesn't create thousands of
+                    // watchdog timers.
+                    dlib::shared_timeout t(*con,&connection::shutdown,timeout);
 
                     // This will flush the sockstreambuf and also destroy it.
                     buf.reset();
@@ -133,7 +136,7 @@ namespace dlib
             auto_mutex lock(class_mutex);
             if (con)
             {
-                con_timeout.reset(new dlib::timeout(*this,&iosockstream::terminate_connection,timeout,con));
+                con_timeout.reset(new dlib::shared_timeout(*this,&iosockstream::terminate_connection,timeout,con));
             }
         }
 
@@ -154,7 +157,7 @@ namespace dlib
             thecon->shutdown();
         }
 
-        std::unique_ptr<timeout> con_timeout;
+        std::unique_ptr<shared_timeout> con_timeout;
         rmutex class_mutex; 
         std::shared_ptr<connection> con;
         std::unique_ptr<sockstreambuf> buf;
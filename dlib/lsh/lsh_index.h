@@ -0,0 +1,277 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_LSH_INDeX_Hh_
+#define DLIB_LSH_INDeX_Hh_
+
+#include "lsh_index_abstract.h"
+#include "hashes.h"
+#include "../algs.h"
+#include "../serialize.h"
+#include "../graph_utils/function_objects.h"
+#include <vector>
+#include <queue>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sample_type,
+        typename distance_function_type = cosine_distance
+        >
+    class lsh_index
+    {
+        /*!
+            CONVENTION
+                - size() == items.size()
+                - contains(id) == (items.count(id) != 0)
+                - get_hash_function() == hash_function_type(seed)
+                - for each element (id,item) of items:
+                    - item.hash == get_hash_function()(item.samp)
+                    - for all valid t: tables[t][bucket_key(item.hash,t)] contains id
+                - Every id in a bucket of tables refers to an element of items.  So the
+                  buckets never contain stale ids for removed samples.
+                - next_id is larger than every id in items, so ids are never reused.
+        !*/
+
+    public:
+
+        typedef hash_similar_angles_128 hash_function_type;
+        typedef typename hash_function_type::result_type hash_type;
+
+        lsh_index (
+        ) = default;
+
+        explicit lsh_index (
+            const distance_function_type& dist_funct_,
+            const uint64 seed_ = 0
+        ) : dist_funct(dist_funct_), seed(seed_) {}
+
+        const distance_function_type& get_distance_function (
+        ) const { return dist_funct; }
+
+        hash_function_type get_hash_function (
+        ) const { return hash_function_type(seed); }
+
+        size_t size (
+        ) const { return items.size(); }
+
+        bool contains (
+            unsigned long id
+        ) const { return items.count(id) != 0; }
+
+        const sample_type& operator[] (
+            unsigned long id
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(contains(id),
+                "\t const sample_type& lsh_index::operator[](id)"
+                << "\n\t You can't ask for a sample that isn't in the index."
+                << "\n\t id:     " << id
+                << "\n\t size(): " << size()
+                << "\n\t this:   " << this
+                );
+
+            return items.find(id)->second.samp;
+        }
+
+        unsigned long add (
+            const sample_type& samp
+        )
+        {
+            const unsigned long id = next_id++;
+            item_type& item = items[id];
+            item.samp = samp;
+            item.hash = get_hash_function()(samp);
+            for (unsigned long t = 0; t < num_tables; ++t)
+                tables[t][bucket_key(item.hash,t)].push_back(id);
+            return id;
+        }
+
+        void remove (
+            unsigned long id
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(contains(id),
+                "\t void lsh_index::remove(id)"
+                << "\n\t You can't remove a sample that isn't in the index."
+                << "\n\t id:     " << id
+                << "\n\t size(): " << size()
+                << "\n\t this:   " << this
+                );
+
+            const auto i = items.find(id);
+            for (unsigned long t = 0; t < num_tables; ++t)
+            {
+                const auto key = bucket_key(i->second.hash,t);
+                std::vector<unsigned long>& bucket = tables[t][key];
+                // The order of the ids within a bucket doesn't matter, so swap the id
+                // we are removing to the back and pop it.
+                *std::find(bucket.begin(), bucket.end(), id) = bucket.back();
+                bucket.pop_back();
+                if (bucket.empty())
+                    tables[t].erase(key);
+            }
+            items.erase(i);
+        }
+
+        void query (
+            const sample_type& samp,
+            const unsigned long k,
+            std::vector<std::pair<unsigned long,double> >& results,
+            const unsigned long k_oversample = 20
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(k > 0 && k_oversample > 0,
+                "\t void lsh_index::query()"
+                << "\n\t Invalid inputs were given to this function."
+                << "\n\t k:            " << k
+                << "\n\t k_oversample: " << k_oversample
+                );
+
+            results.clear();
+            if (items.size() == 0)
+                return;
+
+            const hash_type h = get_hash_function()(samp);
+            const unsigned long k_hash = k*k_oversample;
+
+            // Scan the bucket samp falls into in each table and find the candidates
+            // with the k_hash best hash distances.
+            std::priority_queue<std::pair<unsigned int, unsigned long> > best_hashes;
+            unsigned int worst_distance = std::numeric_limits<unsigned int>::max();
+            std::unordered_set<unsigned long> seen;
+            const hash_function_type hash_funct = get_hash_function();
+            for (unsigned long t = 0; t < num_tables; ++t)
+            {
+                const auto bucket = tables[t].find(bucket_key(h,t));
+                if (bucket == tables[t].end())
+                    continue;
+
+                for (const unsigned long id : bucket->second)
+                {
+                    // skip ids we already got from another table
+                    if (!seen.insert(id).second)
+                        continue;
+
+                    const unsigned int dist = hash_funct.distance(h, items.find(id)->second.hash);
+                    if (dist < worst_distance || best_hashes.size() < k_hash)
+                    {
+                        if (best_hashes.size() >= k_hash)
+                            best_hashes.pop();
+                        best_hashes.push(std::make_pair(dist, id));
+                        worst_distance = best_hashes.top().first;
+                    }
+                }
+            }
+
+            // Now figure out which of the candidates are actually the k best matches
+            // according to dist_funct().
+            std::priority_queue<std::pair<double, unsigned long> > best_samples;
+            while (best_hashes.size() != 0)
+            {
+                const unsigned long id = best_hashes.top().second;
+                best_hashes.pop();
+
+                const double dist = dist_funct(samp, items.find(id)->second.samp);
+                if (dist < std::numeric_limits<double>::infinity())
+                {
+                    if (best_samples.size() < k)
+                        best_samples.push(std::make_pair(dist, id));
+                    else if (dist < best_samples.top().first)
+                    {
+                        best_samples.pop();
+                        best_samples.push(std::make_pair(dist, id));
+                    }
+                }
+            }
+
+            // Finally, put the matches into results, best match first.
+            results.resize(best_samples.size());
+            for (size_t i = results.size(); i != 0; --i)
+            {
+                results[i-1] = std::make_pair(best_samples.top().second, best_samples.top().first);
+                best_samples.pop();
+            }
+        }
+
+        friend void serialize (const lsh_index& item, std::ostream& out)
+        {
+            serialize("lsh_index", out);
+            serialize(item.seed, out);
+            serialize(item.next_id, out);
+            serialize(item.items.size(), out);
+            for (const auto& i : item.items)
+            {
+                serialize(i.first, out);
+                serialize(i.second.samp, out);
+                serialize(i.second.hash, out);
+            }
+        }
+
+        friend void deserialize (lsh_index& item, std::istream& in)
+        {
+            check_serialized_version("lsh_index", in);
+            deserialize(item.seed, in);
+            deserialize(item.next_id, in);
+            size_t num;
+            deserialize(num, in);
+            item.items.clear();
+            for (unsigned long t = 0; t < num_tables; ++t)
+                item.tables[t].clear();
+            for (size_t i = 0; i < num; ++i)
+            {
+                unsigned long id;
+                deserialize(id, in);
+                item_type& it = item.items[id];
+                deserialize(it.samp, in);
+                deserialize(it.hash, in);
+                for (unsigned long t = 0; t < num_tables; ++t)
+                    item.tables[t][bucket_key(it.hash,t)].push_back(id);
+            }
+        }
+
+    private:
+
+        // We key the hash tables on the 8 16-bit slices of the 128-bit hash code.  By
+        // the pigeonhole principle, any two codes within hamming distance 7 of each
+        // other agree exactly on at least one slice and therefore land in the same
+        // bucket of at least one table.
+        const static unsigned long num_tables = 8;
+
+        static uint32 bucket_key (
+            const hash_type& h,
+            unsigned long t
+        )
+        {
+            const uint64 word = t < 4 ? h.first : h.second;
+            return static_cast<uint32>((word >> 16*(t&3)) & 0xffff);
+        }
+
+        struct item_type
+        {
+            sample_type samp;
+            hash_type hash;
+        };
+
+        distance_function_type dist_funct;
+        uint64 seed = 0;
+        unsigned long next_id = 0;
+        std::unordered_map<unsigned long, item_type> items;
+        std::unordered_map<uint32, std::vector<unsigned long> > tables[num_tables];
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_LSH_INDeX_Hh_
+
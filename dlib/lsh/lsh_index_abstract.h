@@ -0,0 +1,204 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_LSH_INDeX_ABSTRACT_Hh_
+#ifdef DLIB_LSH_INDeX_ABSTRACT_Hh_
+
+#include "hashes_abstract.h"
+#include "../graph_utils/function_objects_abstract.h"
+#include <vector>
+#include <utility>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sample_type,
+        typename distance_function_type = cosine_distance
+        >
+    class lsh_index
+    {
+        /*!
+            REQUIREMENTS ON sample_type
+                Must be a type hashable by hash_similar_angles_128 (e.g. a dlib matrix
+                expression or a sparse vector) that is copyable and serializable.
+
+            REQUIREMENTS ON distance_function_type
+                Must be a function object with an interface compatible with the
+                cosine_distance object.  It must also be default constructable.
+
+            INITIAL VALUE
+                - size() == 0
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is an online approximate nearest neighbor index.  It does
+                the same kind of locality sensitive hashing based search as
+                find_k_nearest_neighbors_lsh() but incrementally.  That is, instead of
+                hashing and scanning an entire dataset each time, you add and remove
+                samples one at a time and can run queries at any point, with each query
+                only touching the samples whose hash codes collide with the query.
+
+                Internally, each sample is hashed with hash_similar_angles_128 and
+                stored in 8 hash tables, each keyed on a different 16-bit slice of the
+                128-bit hash code.  Any two samples whose codes are within hamming
+                distance 7 of each other agree on at least one slice, so close samples
+                are guaranteed to share a bucket with the query.  A query gathers the
+                candidates from its 8 buckets, keeps the k*k_oversample of them with
+                the smallest hash distances, and finally ranks those according to the
+                given distance function.  Like all LSH methods, the results are
+                therefore approximate: a true near neighbor whose hash code differs
+                from the query's in every slice won't be found.
+        !*/
+
+    public:
+
+        typedef hash_similar_angles_128 hash_function_type;
+        typedef hash_function_type::result_type hash_type;
+
+        lsh_index (
+        );
+        /*!
+            ensures
+                - #size() == 0
+                - #get_distance_function() == distance_function_type()
+                - #get_hash_function() == hash_similar_angles_128(0)
+        !*/
+
+        explicit lsh_index (
+            const distance_function_type& dist_funct,
+            const uint64 seed = 0
+        );
+        /*!
+            ensures
+                - #size() == 0
+                - #get_distance_function() == dist_funct
+                - #get_hash_function() == hash_similar_angles_128(seed)
+        !*/
+
+        const distance_function_type& get_distance_function (
+        ) const;
+        /*!
+            ensures
+                - returns the function used to measure the true distance between
+                  samples when ranking query results.
+        !*/
+
+        hash_function_type get_hash_function (
+        ) const;
+        /*!
+            ensures
+                - returns the locality sensitive hash function used to bucket the
+                  samples.
+        !*/
+
+        size_t size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of samples currently in the index.
+        !*/
+
+        bool contains (
+            unsigned long id
+        ) const;
+        /*!
+            ensures
+                - if (the index contains a sample with the given id) then
+                    - returns true
+                - else
+                    - returns false
+        !*/
+
+        const sample_type& operator[] (
+            unsigned long id
+        ) const;
+        /*!
+            requires
+                - contains(id) == true
+            ensures
+                - returns the sample with the given id.
+        !*/
+
+        unsigned long add (
+            const sample_type& samp
+        );
+        /*!
+            ensures
+                - adds samp to the index and returns an id that uniquely identifies it.
+                - #contains(returned id) == true
+                - (*this)[returned id] == samp
+                - #size() == size() + 1
+                - Ids are never reused, so the returned id is distinct from that of
+                  every sample ever added to this object, even removed ones.
+        !*/
+
+        void remove (
+            unsigned long id
+        );
+        /*!
+            requires
+                - contains(id) == true
+            ensures
+                - #contains(id) == false
+                - #size() == size() - 1
+                - The sample will never appear in the results of subsequent queries.
+        !*/
+
+        void query (
+            const sample_type& samp,
+            const unsigned long k,
+            std::vector<std::pair<unsigned long,double> >& results,
+            const unsigned long k_oversample = 20
+        ) const;
+        /*!
+            requires
+                - k > 0
+                - k_oversample > 0
+            ensures
+                - Finds the samples in the index closest to samp, as measured by
+                  get_distance_function(), and stores them into #results in order of
+                  increasing distance.  For each element of #results, .first is the id
+                  of the found sample and .second is its distance to samp.
+                - #results.size() <= k
+                - Only samples whose hash codes collide with samp's in at least one
+                  hash table are considered, and samples whose distance to samp is
+                  infinity are never returned.  So #results.size() can be less than k
+                  even when size() >= k.  In particular, samples completely dissimilar
+                  to samp generally won't be returned at all.
+                - The larger k_oversample is, the more candidate samples are ranked
+                  with get_distance_function() and therefore the more accurate the
+                  results will be, at the cost of a slower query.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sample_type,
+        typename distance_function_type
+        >
+    void serialize (
+        const lsh_index<sample_type,distance_function_type>& item,
+        std::ostream& out
+    );
+    template <
+        typename sample_type,
+        typename distance_function_type
+        >
+    void deserialize (
+        lsh_index<sample_type,distance_function_type>& item,
+        std::istream& in
+    );
+    /*!
+        provides serialization support.  Note that the distance function object itself
+        is not serialized, so after deserialization the index uses whatever distance
+        function the target object already had.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_LSH_INDeX_ABSTRACT_Hh_
+
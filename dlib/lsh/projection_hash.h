@@ -6,6 +6,9 @@
 #include "projection_hash_abstract.h"
 #include "../matrix.h"
 #include "../rand.h"
+#include <algorithm>
+#include <queue>
+#include <utility>
 #include <vector>
 
 namespace dlib
@@ -66,6 +69,114 @@ namespace dlib
             return do_hash(proj*matrix_cast<double>(v) + offset);
         }
 
+        template <typename EXP>
+        void operator() (
+            const matrix_exp<EXP>& vects,
+            std::vector<unsigned long>& hashes
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(vects.nr() == get_projection_matrix().nc() &&
+                        vects.nr() > 0,
+                "\t void projection_hash::operator()(vects, hashes)"
+                << "\n\t Invalid arguments were given to this function."
+                << "\n\t get_projection_matrix().nc(): " << get_projection_matrix().nc()
+                << "\n\t vects.nr():                   " << vects.nr()
+                );
+
+            // Hash all the queries with one matrix multiply rather than doing a tiny
+            // matrix-vector product for each one.
+            const matrix<double> prods = proj*matrix_cast<double>(vects);
+
+            hashes.resize(prods.nc());
+            for (long j = 0; j < prods.nc(); ++j)
+            {
+                unsigned long h = 0;
+                for (long i = 0; i < prods.nr(); ++i)
+                {
+                    h <<= 1;
+                    if (prods(i,j) + offset(i) > 0)
+                        h |= 1;
+                }
+                hashes[j] = h;
+            }
+        }
+
+        template <typename EXP>
+        void multi_probe (
+            const matrix_exp<EXP>& v,
+            const unsigned long num_probes,
+            std::vector<unsigned long>& hashes
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(is_col_vector(v) &&
+                        v.size() == get_projection_matrix().nc() &&
+                        v.size() > 0 &&
+                        num_probes > 0,
+                "\t void projection_hash::multi_probe(v, num_probes, hashes)"
+                << "\n\t Invalid arguments were given to this function."
+                << "\n\t is_col_vector(v):             " << is_col_vector(v)
+                << "\n\t get_projection_matrix().nc(): " << get_projection_matrix().nc()
+                << "\n\t v.size():                     " << v.size()
+                << "\n\t num_probes:                   " << num_probes
+                );
+
+            const matrix<double,0,1> z = proj*matrix_cast<double>(v) + offset;
+            const unsigned long base = do_hash(z);
+
+            hashes.clear();
+            hashes.push_back(base);
+            if (hashes.size() >= num_probes)
+                return;
+
+            // Rank the hash bits by how close their projection is to the quantization
+            // boundary.  Flipping the bit for z(i) moves the query into a neighboring
+            // bucket at a "cost" of |z(i)|, so the most promising alternative buckets
+            // are the ones reachable by flipping sets of bits with the smallest total
+            // cost.  We enumerate those sets in order of increasing cost with a heap,
+            // in the style of Lv et al., "Multi-Probe LSH: Efficient Indexing for
+            // High-Dimensional Similarity Search", VLDB 2007.
+            std::vector<std::pair<double,unsigned long> > flips(z.size());
+            for (long i = 0; i < z.size(); ++i)
+                flips[i] = std::make_pair(std::abs(z(i)), 1UL<<(z.size()-1-i));
+            std::sort(flips.begin(), flips.end());
+
+            // Each heap entry is a set of positions in flips, sorted in ascending
+            // order and keyed by the total cost of flipping all its bits.  Shifting a
+            // set's largest position up by one or extending the set with the next
+            // position generates every non-empty set exactly once, and always at a
+            // cost no smaller than its parent's.
+            typedef std::pair<double, std::vector<unsigned long> > probe_set;
+            std::priority_queue<probe_set, std::vector<probe_set>, std::greater<probe_set> > heap;
+            heap.push(probe_set(flips[0].first, std::vector<unsigned long>(1,0)));
+
+            while (hashes.size() < num_probes && heap.empty() == false)
+            {
+                const probe_set e = heap.top();
+                heap.pop();
+
+                unsigned long bucket = base;
+                for (unsigned long i = 0; i < e.second.size(); ++i)
+                    bucket ^= flips[e.second[i]].second;
+                hashes.push_back(bucket);
+
+                const unsigned long m = e.second.back();
+                if (m+1 < flips.size())
+                {
+                    probe_set shifted = e;
+                    shifted.first += flips[m+1].first - flips[m].first;
+                    shifted.second.back() = m+1;
+                    heap.push(shifted);
+
+                    probe_set extended = e;
+                    extended.first += flips[m+1].first;
+                    extended.second.push_back(m+1);
+                    heap.push(extended);
+                }
+            }
+        }
+
     private:
 
         template <typename EXP>
@@ -91,6 +91,51 @@ namespace dlib
                 - hashes v into the range [0, num_hash_bins()) using the method
                   discussed in the WHAT THIS OBJECT REPRESENTS section.
         !*/
+
+        template <typename EXP>
+        void operator() (
+            const matrix_exp<EXP>& vects,
+            std::vector<unsigned long>& hashes
+        ) const;
+        /*!
+            requires
+                - vects.nr() == get_projection_matrix().nc()
+                - vects.nr() > 0
+            ensures
+                - Interprets each column of vects as one vector to be hashed and
+                  hashes them all.  In particular:
+                    - #hashes.size() == vects.nc()
+                    - for all valid j: #hashes[j] == (*this)(colm(vects,j))
+                - This is equivalent to calling the single vector operator() on each
+                  column but much faster for large batches since all the projections
+                  are computed with a single matrix multiply.
+        !*/
+
+        template <typename EXP>
+        void multi_probe (
+            const matrix_exp<EXP>& v,
+            const unsigned long num_probes,
+            std::vector<unsigned long>& hashes
+        ) const;
+        /*!
+            requires
+                - is_col_vector(v) == true
+                - v.size() == get_projection_matrix().nc()
+                - v.size() > 0
+                - num_probes > 0
+            ensures
+                - #hashes.size() == min(num_probes, num_hash_bins())
+                - #hashes[0] == (*this)(v)
+                - The remaining elements of #hashes are the distinct hash bins a
+                  slightly perturbed version of v is most likely to fall into,
+                  ordered from most to least likely.  Each bin is obtained by
+                  flipping some set of hash bits of #hashes[0], and bins are ranked
+                  by the total distance of the flipped bits' projections from their
+                  quantization boundaries, as in the multi-probe LSH method of Lv et
+                  al., VLDB 2007.  Searching these bins in addition to #hashes[0]
+                  therefore finds most of the near neighbors a single-bucket lookup
+                  would miss, without needing more hash tables.
+        !*/
     };
 
 // ----------------------------------------------------------------------------------------
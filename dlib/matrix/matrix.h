@@ -13,6 +13,7 @@
 #include "../memory_manager.h"
 #include "../is_kind.h"
 #include "matrix_data_layout.h"
+#include "matrix_scratch_arena.h"
 #include "matrix_assign_fwd.h"
 #include "matrix_op.h"
 #include <utility>
@@ -139,7 +140,11 @@ namespace dlib
         const static long cost = ((tmax<LHS::NC,RHS::NR>::value!=0)? ((lhs_cost+rhs_cost)*tmax<LHS::NC,RHS::NR>::value):(10000));
     };
 
-    template <typename T, bool is_ref> struct conditional_matrix_temp { typedef typename T::matrix_type type; };
+    // Note that the temporaries use the scratch_memory_manager so that, when a
+    // matrix_scratch_context is active on the calling thread, they come out of its
+    // thread local buffer rather than the heap.
+    template <typename T, bool is_ref> struct conditional_matrix_temp
+    { typedef matrix<typename T::type, T::NR, T::NC, scratch_memory_manager<char>, typename T::layout_type> type; };
     template <typename T> struct conditional_matrix_temp<T,true>      { typedef T& type; };
 
     template <
@@ -1758,6 +1763,40 @@ namespace dlib
                 return 0;
         }
 
+        T* row_ptr (
+            long r
+        )
+        {
+            // This function is only defined for matrices that use a row major layout
+            // since for them each row is stored as one contiguous block of memory.
+            COMPILE_TIME_ASSERT((is_same_type<layout,row_major_layout>::value));
+            DLIB_ASSERT(r >= 0 && r < nr(),
+                "\tT* matrix::row_ptr(r)"
+                << "\n\tYou must give a valid row index"
+                << "\n\tr:    " << r
+                << "\n\tnr(): " << nr()
+                << "\n\tthis: " << this
+                );
+            return &data(r,0);
+        }
+
+        const T* row_ptr (
+            long r
+        ) const
+        {
+            // This function is only defined for matrices that use a row major layout
+            // since for them each row is stored as one contiguous block of memory.
+            COMPILE_TIME_ASSERT((is_same_type<layout,row_major_layout>::value));
+            DLIB_ASSERT(r >= 0 && r < nr(),
+                "\tconst T* matrix::row_ptr(r)"
+                << "\n\tYou must give a valid row index"
+                << "\n\tr:    " << r
+                << "\n\tnr(): " << nr()
+                << "\n\tthis: " << this
+                );
+            return &data(r,0);
+        }
+
     private:
         struct literal_assign_helper
         {
@@ -1862,19 +1901,44 @@ namespace dlib
         matrix<T,NR,NC,mm,l>& b
     ) { a.swap(b); }
 
-    template <
-        typename T,
-        long NR,
-        long NC,
-        typename mm,
-        typename l
-        >
-    void serialize (
-        const matrix<T,NR,NC,mm,l>& item, 
-        std::ostream& out
-    )
+    namespace impl
     {
-        try
+        template <
+            typename T,
+            long NR,
+            long NC,
+            typename mm,
+            typename l
+            >
+        typename enable_if_c<ser_helper::is_block_serializable<T>::value>::type serialize_matrix (
+            const matrix<T,NR,NC,mm,l>& item,
+            std::ostream& out
+        )
+        {
+            // Simple arithmetic elements are written with the block streamed format.
+            // Its header lets the reader allocate the matrix exactly once and then
+            // stream the raw element bytes in large chunks rather than deserializing
+            // one element at a time.
+            ser_helper::write_block_header(out, item.nr(), item.nc(),
+                ser_helper::block_element_code<T>(), is_same_type<l,row_major_layout>::value);
+            if (item.size() != 0)
+            {
+                ser_helper::write_block_data(out, reinterpret_cast<const char*>(&item(0,0)),
+                    sizeof(T)*static_cast<size_t>(item.size()));
+            }
+        }
+
+        template <
+            typename T,
+            long NR,
+            long NC,
+            typename mm,
+            typename l
+            >
+        typename disable_if_c<ser_helper::is_block_serializable<T>::value>::type serialize_matrix (
+            const matrix<T,NR,NC,mm,l>& item,
+            std::ostream& out
+        )
         {
             // The reason the serialization is a little funny is because we are trying to
             // maintain backwards compatibility with an older serialization format used by
@@ -1890,6 +1954,87 @@ namespace dlib
                 }
             }
         }
+
+        template <
+            typename T,
+            long NR,
+            long NC,
+            typename mm,
+            typename l
+            >
+        typename enable_if_c<ser_helper::is_block_serializable<T>::value>::type deserialize_block_matrix (
+            matrix<T,NR,NC,mm,l>& item,
+            std::istream& in
+        )
+        {
+            long nr, nc;
+            unsigned char element_code, wire_little_endian, wire_row_major;
+            deserialize(nr,in);
+            deserialize(nc,in);
+            deserialize(element_code,in);
+            deserialize(wire_little_endian,in);
+            deserialize(wire_row_major,in);
+
+            if (NR != 0 && nr != NR)
+                throw serialization_error("Error while deserializing a dlib::matrix.  Invalid rows");
+            if (NC != 0 && nc != NC)
+                throw serialization_error("Error while deserializing a dlib::matrix.  Invalid columns");
+
+            item.set_size(nr,nc);
+            if (item.size() == 0)
+                return;
+
+            byte_orderer bo;
+            const bool row_major = is_same_type<l,row_major_layout>::value;
+            if (element_code == ser_helper::block_element_code<T>() &&
+                (wire_little_endian != 0) == bo.host_is_little_endian() &&
+                (wire_row_major != 0) == row_major)
+            {
+                // The bytes on the wire are exactly our in-memory representation, so
+                // stream them straight into the matrix.
+                ser_helper::read_block_data(in, reinterpret_cast<char*>(&item(0,0)),
+                    sizeof(T)*static_cast<size_t>(item.size()));
+            }
+            else
+            {
+                ser_helper::read_block_elements(in, element_code, &item(0,0), nr, nc,
+                    row_major, wire_row_major != 0, wire_little_endian != 0);
+            }
+        }
+
+        template <
+            typename T,
+            long NR,
+            long NC,
+            typename mm,
+            typename l
+            >
+        typename disable_if_c<ser_helper::is_block_serializable<T>::value>::type deserialize_block_matrix (
+            matrix<T,NR,NC,mm,l>&,
+            std::istream&
+        )
+        {
+            throw serialization_error("Error while deserializing a dlib::matrix.  The stream contains "
+                "block streamed data but the matrix doesn't have an arithmetic element type.");
+        }
+    }
+
+    template <
+        typename T,
+        long NR,
+        long NC,
+        typename mm,
+        typename l
+        >
+    void serialize (
+        const matrix<T,NR,NC,mm,l>& item,
+        std::ostream& out
+    )
+    {
+        try
+        {
+            impl::serialize_matrix(item, out);
+        }
         catch (serialization_error& e)
         {
             throw serialization_error(e.info + "\n   while serializing dlib::matrix");
@@ -1904,15 +2049,20 @@ namespace dlib
         typename l
         >
     void deserialize (
-        matrix<T,NR,NC,mm,l>& item, 
+        matrix<T,NR,NC,mm,l>& item,
         std::istream& in
     )
     {
         try
         {
             long nr, nc;
-            deserialize(nr,in); 
-            deserialize(nc,in); 
+            deserialize(nr,in);
+            if (nr == ser_helper::block_format_tag)
+            {
+                impl::deserialize_block_matrix(item, in);
+                return;
+            }
+            deserialize(nc,in);
 
             // this is the newer serialization format
             if (nr < 0 || nc < 0)
@@ -1959,7 +2109,7 @@ namespace dlib
         serialize(item.nr(), out);
         serialize(item.nc(), out);
         if (item.size() != 0)
-            out.write((char*)&item(0,0), sizeof(item(0,0))*item.size());
+            ser_helper::write_block_data(out, (char*)&item(0,0), sizeof(item(0,0))*item.size());
     }
 
     template <
@@ -1980,7 +2130,7 @@ namespace dlib
         deserialize(nc, in);
         item.set_size(nr,nc);
         if (item.size() != 0)
-            in.read((char*)&item(0,0), sizeof(item(0,0))*item.size());
+            ser_helper::read_block_data(in, (char*)&item(0,0), sizeof(item(0,0))*item.size());
     }
 
 // ----------------------------------------------------------------------------------------
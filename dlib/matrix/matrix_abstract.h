@@ -425,6 +425,36 @@ namespace dlib
                 - returns (*this)(0,0)
         !*/
 
+        T* row_ptr (
+            long r
+        );
+        /*!
+            requires
+                - layout == row_major_layout
+                - 0 <= r < nr()
+            ensures
+                - returns a pointer to the first element of the r'th row of *this.
+                  Since this matrix uses a row major layout, each row is stored as one
+                  contiguous block of memory.  So for all valid c:
+                  row_ptr(r)[c] == (*this)(r,c).  Unlike operator(), the returned
+                  pointer carries no per-element bounds checking, which makes it useful
+                  in performance critical loops.
+        !*/
+
+        const T* row_ptr (
+            long r
+        ) const;
+        /*!
+            requires
+                - layout == row_major_layout
+                - 0 <= r < nr()
+            ensures
+                - returns a const pointer to the first element of the r'th row of
+                  *this.  Since this matrix uses a row major layout, each row is stored
+                  as one contiguous block of memory.  So for all valid c:
+                  row_ptr(r)[c] == (*this)(r,c).
+        !*/
+
         long nr(
         ) const;
         /*!
@@ -11,6 +11,8 @@
 #include "matrix_default_mul.h"
 #include "matrix_conj_trans.h"
 #include "matrix_mat.h"
+#include "../simd.h"
+#include <algorithm>
 
 namespace dlib
 {
@@ -344,7 +346,9 @@ namespace dlib
                 {
                     if (add_to)
                     {
-                        typename dest_exp::matrix_type temp(dest.nr(),dest.nc());
+                        typedef typename dest_exp::matrix_type dmat;
+                        matrix<typename dmat::type, dmat::NR, dmat::NC,
+                            scratch_memory_manager<char>, typename dmat::layout_type> temp(dest.nr(),dest.nc());
                         zero_matrix(temp);
 
                         if (transpose == false)
@@ -714,7 +718,7 @@ namespace dlib
         {
             if (src.aliases(dest.m))
             {
-                matrix<T,NR,NC,MM,L> temp(dest.nr(),dest.nc());
+                matrix<T,NR,NC,scratch_memory_manager<char>,L> temp(dest.nr(),dest.nc());
                 matrix_assign_blas_proxy(temp,src,1,false, false);
                 matrix_assign_default(dest,temp);
             }
@@ -723,12 +727,12 @@ namespace dlib
                 matrix_assign_blas_proxy(dest,src,1,false, false);
             }
         }
-            
+
     // ------------------------------------------------------------------------------------
 
         template <
             typename T,
-            typename src_exp 
+            typename src_exp
             >
         void matrix_assign_blas (
             assignable_ptr_matrix<T>& dest,
@@ -737,7 +741,7 @@ namespace dlib
         {
             if (src.aliases(mat(dest.ptr,dest.height,dest.width)))
             {
-                matrix<T> temp(dest.nr(),dest.nc());
+                matrix<T,0,0,scratch_memory_manager<char> > temp(dest.nr(),dest.nc());
                 matrix_assign_blas_proxy(temp,src,1,false, false);
                 matrix_assign_default(dest,temp);
             }
@@ -760,7 +764,7 @@ namespace dlib
         {
             if (src.aliases(dest.m))
             {
-                matrix<T,NR,NC,MM,L> temp(dest.nr(),dest.nc());
+                matrix<T,NR,NC,scratch_memory_manager<char>,L> temp(dest.nr(),dest.nc());
                 matrix_assign_blas_proxy(temp,src,1,false, false);
                 matrix_assign_default(dest,temp);
             }
@@ -783,7 +787,7 @@ namespace dlib
         {
             if (src.aliases(dest.m))
             {
-                matrix<T,NR,NC,MM,L> temp(dest.nr(),dest.nc());
+                matrix<T,NR,NC,scratch_memory_manager<char>,L> temp(dest.nr(),dest.nc());
                 matrix_assign_blas_proxy(temp,src,1,false, false);
                 matrix_assign_default(dest,temp);
             }
@@ -968,6 +972,201 @@ namespace dlib
         blas_bindings::matrix_assign_blas(dest,src);
     }
 
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+
+    // ------------------------------------------------------------------------------------
+
+#ifdef DLIB_HAVE_AVX
+        inline void transpose_block_8x8 (
+            const float* src,
+            long src_stride,
+            float* dest,
+            long dest_stride
+        )
+        /*!
+            requires
+                - src points to an 8x8 block of floats with rows src_stride apart.
+                - dest points to an 8x8 block of floats with rows dest_stride apart.
+                - the blocks don't overlap
+            ensures
+                - writes the transpose of the src block into the dest block.  The whole
+                  transpose happens in registers, so each of the 16 cache lines involved
+                  is touched exactly once.
+        !*/
+        {
+            simd8f r0, r1, r2, r3, r4, r5, r6, r7;
+            r0.load(src + 0*src_stride);
+            r1.load(src + 1*src_stride);
+            r2.load(src + 2*src_stride);
+            r3.load(src + 3*src_stride);
+            r4.load(src + 4*src_stride);
+            r5.load(src + 5*src_stride);
+            r6.load(src + 6*src_stride);
+            r7.load(src + 7*src_stride);
+
+            // interleave pairs of rows, then pairs of pairs, then swap 128 bit lanes.
+            const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+            const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+            const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+            const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+            const __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+            const __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+            const __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+            const __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+            const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1,0,1,0));
+            const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3,2,3,2));
+            const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1,0,1,0));
+            const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3,2,3,2));
+            const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1,0,1,0));
+            const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3,2,3,2));
+            const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1,0,1,0));
+            const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3,2,3,2));
+
+            const simd8f o0 = _mm256_permute2f128_ps(s0, s4, 0x20);
+            const simd8f o1 = _mm256_permute2f128_ps(s1, s5, 0x20);
+            const simd8f o2 = _mm256_permute2f128_ps(s2, s6, 0x20);
+            const simd8f o3 = _mm256_permute2f128_ps(s3, s7, 0x20);
+            const simd8f o4 = _mm256_permute2f128_ps(s0, s4, 0x31);
+            const simd8f o5 = _mm256_permute2f128_ps(s1, s5, 0x31);
+            const simd8f o6 = _mm256_permute2f128_ps(s2, s6, 0x31);
+            const simd8f o7 = _mm256_permute2f128_ps(s3, s7, 0x31);
+
+            o0.store(dest + 0*dest_stride);
+            o1.store(dest + 1*dest_stride);
+            o2.store(dest + 2*dest_stride);
+            o3.store(dest + 3*dest_stride);
+            o4.store(dest + 4*dest_stride);
+            o5.store(dest + 5*dest_stride);
+            o6.store(dest + 6*dest_stride);
+            o7.store(dest + 7*dest_stride);
+        }
+#endif // DLIB_HAVE_AVX
+
+    // ------------------------------------------------------------------------------------
+
+        template <
+            typename EXP1,
+            typename EXP2
+            >
+        void physical_transpose (
+            EXP1& dest,
+            const EXP2& src
+        )
+        /*!
+            requires
+                - dest.nr() == src.nc()
+                - dest.nc() == src.nr()
+                - src and dest don't alias each other
+            ensures
+                - #dest == trans(src)
+        !*/
+        {
+            // Walk the matrices a block at a time rather than letting one of them get
+            // accessed with a large stride.  The blocks are sized so a source block and
+            // a destination block fit into L1 cache together.
+            const long bs = 64;
+            for (long rb = 0; rb < src.nr(); rb += bs)
+            {
+                const long rend = std::min(rb+bs, src.nr());
+                for (long cb = 0; cb < src.nc(); cb += bs)
+                {
+                    const long cend = std::min(cb+bs, src.nc());
+                    for (long r = rb; r < rend; ++r)
+                    {
+                        for (long c = cb; c < cend; ++c)
+                        {
+                            dest(c,r) = src(r,c);
+                        }
+                    }
+                }
+            }
+        }
+
+#ifdef DLIB_HAVE_AVX
+        template <
+            long NR, long NC,
+            long NR2, long NC2,
+            typename MM, typename MM2
+            >
+        void physical_transpose (
+            matrix<float,NR,NC,MM,row_major_layout>& dest,
+            const matrix<float,NR2,NC2,MM2,row_major_layout>& src
+        )
+        {
+            if (src.size() == 0)
+                return;
+
+            const long src_stride = src.nc();
+            const long dest_stride = dest.nc();
+            const float* const s = &src(0,0);
+            float* const d = &dest(0,0);
+
+            // the portion of the matrix coverable by whole 8x8 tiles
+            const long nr8 = src.nr() - src.nr()%8;
+            const long nc8 = src.nc() - src.nc()%8;
+
+            const long bs = 64;
+            for (long rb = 0; rb < nr8; rb += bs)
+            {
+                const long rend = std::min(rb+bs, nr8);
+                for (long cb = 0; cb < nc8; cb += bs)
+                {
+                    const long cend = std::min(cb+bs, nc8);
+                    for (long r = rb; r < rend; r += 8)
+                    {
+                        for (long c = cb; c < cend; c += 8)
+                        {
+                            transpose_block_8x8(s + r*src_stride + c, src_stride,
+                                                d + c*dest_stride + r, dest_stride);
+                        }
+                    }
+                }
+            }
+
+            // transpose the ragged edges not covered by the 8x8 tiles
+            for (long r = 0; r < src.nr(); ++r)
+            {
+                for (long c = nc8; c < src.nc(); ++c)
+                    dest(c,r) = src(r,c);
+            }
+            for (long r = nr8; r < src.nr(); ++r)
+            {
+                for (long c = 0; c < nc8; ++c)
+                    dest(c,r) = src(r,c);
+            }
+        }
+#endif // DLIB_HAVE_AVX
+
+    // ------------------------------------------------------------------------------------
+
+    }
+
+    template <
+        typename T, long NR, long NC, typename MM, typename L,
+        long NR2, long NC2, typename MM2, typename L2
+        >
+    inline void matrix_assign_big (
+        matrix<T,NR,NC,MM,L>& dest,
+        const matrix_op<op_trans<matrix<T,NR2,NC2,MM2,L2> > >& src
+    )
+    /*!
+        This overload catches assignments of the form:
+            dest = trans(M);
+        where M is an already materialized matrix.  Evaluating the lazy trans()
+        expression with the default row-by-row loop would stride through one of the
+        matrices with a stride of a whole row, which for big matrices means a cache
+        miss per element.  So instead we run a cache blocked physical transpose.
+    !*/
+    {
+        impl::physical_transpose(dest, src.op.m);
+    }
+
 // ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
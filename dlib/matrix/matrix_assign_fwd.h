@@ -13,6 +13,10 @@
 #include "../enable_if.h"
 #include "matrix_data_layout.h"
 #include "../algs.h"
+#ifndef DLIB_ISO_CPP_ONLY
+#include <thread>
+#include "../threads/parallel_for_extension.h"
+#endif
 
 namespace dlib
 {
@@ -53,11 +57,28 @@ namespace dlib
         template < typename EXP, typename enable = void >
         struct has_column_major_layout { static const bool value = false; };
         template < typename EXP >
-        struct has_column_major_layout<EXP, typename enable_if<is_same_type<typename EXP::layout_type, column_major_layout> >::type > 
+        struct has_column_major_layout<EXP, typename enable_if<is_same_type<typename EXP::layout_type, column_major_layout> >::type >
         { static const bool value = true; };
 
 
-        
+#ifndef DLIB_ISO_CPP_ONLY
+        template < typename EXP >
+        inline bool should_parallelize_assign (
+            const EXP& src
+        )
+        /*!
+            ensures
+                - returns true if an elementwise assignment of src is expensive enough
+                  that splitting it over the default_thread_pool() will pay for the
+                  scheduling overhead.  The estimate multiplies the number of elements
+                  by the expression's compile time per-element cost.
+        !*/
+        {
+            const double cost = static_cast<double>(src.size())*EXP::cost;
+            return cost >= 1e7 && std::thread::hardware_concurrency() > 1;
+        }
+#endif
+
     }
 
 // ----------------------------------------------------------------------------------------
@@ -84,6 +105,22 @@ namespace dlib
             - #dest == src
     !*/
     {
+#ifndef DLIB_ISO_CPP_ONLY
+        // For large expressions, split the rows over the thread pool.  This is safe
+        // because the caller guarantees src doesn't destructively alias dest, which
+        // means each output element depends on no other output element.
+        if (src.nr() > 1 && ma::should_parallelize_assign(src))
+        {
+            parallel_for(0, src.nr(), [&](long r)
+            {
+                for (long c = 0; c < src.nc(); ++c)
+                {
+                    dest(r,c) = src(r,c);
+                }
+            });
+            return;
+        }
+#endif
         for (long r = 0; r < src.nr(); ++r)
         {
             for (long c = 0; c < src.nc(); ++c)
@@ -96,7 +133,7 @@ namespace dlib
 // ----------------------------------------------------------------------------------------
 
     template <typename EXP1, typename EXP2>
-    inline typename enable_if<ma::has_column_major_layout<EXP1> >::type  
+    inline typename enable_if<ma::has_column_major_layout<EXP1> >::type
     matrix_assign_default (
         EXP1& dest,
         const EXP2& src
@@ -110,6 +147,20 @@ namespace dlib
             - #dest == src
     !*/
     {
+#ifndef DLIB_ISO_CPP_ONLY
+        // Same as above but split over columns since the data is column major.
+        if (src.nc() > 1 && ma::should_parallelize_assign(src))
+        {
+            parallel_for(0, src.nc(), [&](long c)
+            {
+                for (long r = 0; r < src.nr(); ++r)
+                {
+                    dest(r,c) = src(r,c);
+                }
+            });
+            return;
+        }
+#endif
         for (long c = 0; c < src.nc(); ++c)
         {
             for (long r = 0; r < src.nr(); ++r)
@@ -3,10 +3,15 @@
 #ifndef DLIB_MATRIx_DEFAULT_MULTIPLY_
 #define DLIB_MATRIx_DEFAULT_MULTIPLY_
 
+#include <vector>
 #include "../geometry/rectangle.h"
 #include "matrix.h"
 #include "matrix_utilities.h"
 #include "../enable_if.h"
+#include "../simd.h"
+#ifndef DLIB_ISO_CPP_ONLY
+#include "../threads/parallel_for_extension.h"
+#endif
 
 namespace dlib
 {
@@ -19,6 +24,287 @@ namespace dlib
         struct matrix_is_vector { static const bool value = false; };
         template < typename EXP >
         struct matrix_is_vector<EXP, typename enable_if_c<EXP::NR==1 || EXP::NC==1>::type > { static const bool value = true; };
+
+    // --------------------------------------------------------------------------------
+
+        /*
+            The functions below implement a register blocked GEMM on packed panels of
+            float data, following the usual Goto-style decomposition.  The ISA used by
+            the inner kernel is whatever dlib's simd8f wrapper compiles down to for the
+            current build (AVX, SSE, NEON, or plain scalar code), just like the rest of
+            dlib's SIMD code.
+        */
+
+        // The microkernel computes a GEMM_MR by GEMM_NR tile of the output, where
+        // GEMM_NR is two simd8f registers wide so the whole accumulator tile stays in
+        // registers.  GEMM_KC and GEMM_MC size the packed panels so the B panel sits
+        // in L2 cache and the A block in L1 while the kernel runs over them.
+        const long GEMM_MR = 4;
+        const long GEMM_NR = 16;
+        const long GEMM_KC = 256;
+        const long GEMM_MC = 96;
+        const long GEMM_JC = 512;
+
+        template <typename EXP>
+        inline void pack_a_panels (
+            std::vector<float>& Ap,
+            const EXP& lhs,
+            long i0, long mc,
+            long k0, long kc
+        )
+        /*!
+            Packs the mc by kc block of lhs with its top left corner at (i0,k0) into
+            row panels of GEMM_MR rows each, stored so the microkernel reads GEMM_MR
+            consecutive floats per k step.  Ragged bottom panels are zero padded.
+        !*/
+        {
+            const long num_panels = (mc+GEMM_MR-1)/GEMM_MR;
+            Ap.resize(num_panels*kc*GEMM_MR);
+            float* p = &Ap[0];
+            for (long ip = 0; ip < num_panels; ++ip)
+            {
+                const long rbase = i0 + ip*GEMM_MR;
+                for (long k = 0; k < kc; ++k)
+                {
+                    for (long ii = 0; ii < GEMM_MR; ++ii)
+                    {
+                        const long r = rbase + ii;
+                        *p++ = (r < i0+mc) ? lhs(r, k0+k) : 0;
+                    }
+                }
+            }
+        }
+
+        template <typename EXP>
+        inline void pack_b_panels (
+            std::vector<float>& Bp,
+            const EXP& rhs,
+            long k0, long kc,
+            long j0, long nc
+        )
+        /*!
+            Packs the kc by nc block of rhs with its top left corner at (k0,j0) into
+            column panels of GEMM_NR columns each, stored so the microkernel reads
+            GEMM_NR consecutive floats per k step.  Ragged right panels are zero
+            padded.
+        !*/
+        {
+            const long num_panels = (nc+GEMM_NR-1)/GEMM_NR;
+            Bp.resize(num_panels*kc*GEMM_NR);
+            float* p = &Bp[0];
+            for (long jp = 0; jp < num_panels; ++jp)
+            {
+                const long cbase = j0 + jp*GEMM_NR;
+                for (long k = 0; k < kc; ++k)
+                {
+                    for (long jj = 0; jj < GEMM_NR; ++jj)
+                    {
+                        const long c = cbase + jj;
+                        *p++ = (c < j0+nc) ? rhs(k0+k, c) : 0;
+                    }
+                }
+            }
+        }
+
+        inline void gemm_microkernel (
+            const float* Ap,
+            const float* Bp,
+            long kc,
+            float* Ct
+        )
+        /*!
+            requires
+                - Ap points to a packed kc by GEMM_MR A panel
+                - Bp points to a packed kc by GEMM_NR B panel
+                - Ct points to a GEMM_MR by GEMM_NR row major tile
+            ensures
+                - #Ct == the product of the two panels
+        !*/
+        {
+            simd8f acc[GEMM_MR][2];
+            for (long ii = 0; ii < GEMM_MR; ++ii)
+            {
+                acc[ii][0] = 0;
+                acc[ii][1] = 0;
+            }
+
+            for (long k = 0; k < kc; ++k)
+            {
+                simd8f b0, b1;
+                b0.load(Bp + k*GEMM_NR);
+                b1.load(Bp + k*GEMM_NR + 8);
+                for (long ii = 0; ii < GEMM_MR; ++ii)
+                {
+                    const simd8f a(Ap[k*GEMM_MR + ii]);
+                    acc[ii][0] += a*b0;
+                    acc[ii][1] += a*b1;
+                }
+            }
+
+            for (long ii = 0; ii < GEMM_MR; ++ii)
+            {
+                acc[ii][0].store(Ct + ii*GEMM_NR);
+                acc[ii][1].store(Ct + ii*GEMM_NR + 8);
+            }
+        }
+
+        template <typename matrix_dest_type, typename EXP1, typename EXP2>
+        struct has_float_gemm_path
+        {
+            const static bool value = is_same_type<typename matrix_dest_type::type,float>::value &&
+                                      is_same_type<typename EXP1::type,float>::value &&
+                                      is_same_type<typename EXP2::type,float>::value;
+        };
+
+        template <
+            typename matrix_dest_type,
+            typename EXP1,
+            typename EXP2
+            >
+        typename enable_if_c<has_float_gemm_path<matrix_dest_type,EXP1,EXP2>::value>::type
+        matrix_multiply_blocked (
+            matrix_dest_type& dest,
+            const EXP1& lhs,
+            const EXP2& rhs
+        )
+        {
+            const long M = lhs.nr();
+            const long N = rhs.nc();
+            const long K = lhs.nc();
+
+            std::vector<float> Bp;
+            for (long k0 = 0; k0 < K; k0 += GEMM_KC)
+            {
+                const long kc = std::min(GEMM_KC, K-k0);
+                for (long j0 = 0; j0 < N; j0 += GEMM_JC)
+                {
+                    const long nc = std::min(GEMM_JC, N-j0);
+                    pack_b_panels(Bp, rhs, k0, kc, j0, nc);
+
+                    // Each row block writes to a disjoint set of rows in dest, so
+                    // different blocks can safely be processed by different threads.
+                    // They all read the same packed B panel.
+                    auto process_row_block = [&](long i0)
+                    {
+                        const long mc = std::min(GEMM_MC, M-i0);
+                        std::vector<float> Ap;
+                        pack_a_panels(Ap, lhs, i0, mc, k0, kc);
+
+                        const long num_a_panels = (mc+GEMM_MR-1)/GEMM_MR;
+                        const long num_b_panels = (nc+GEMM_NR-1)/GEMM_NR;
+                        float Ct[GEMM_MR*GEMM_NR];
+                        for (long ip = 0; ip < num_a_panels; ++ip)
+                        {
+                            for (long jp = 0; jp < num_b_panels; ++jp)
+                            {
+                                gemm_microkernel(&Ap[ip*kc*GEMM_MR], &Bp[jp*kc*GEMM_NR], kc, Ct);
+
+                                // accumulate the valid part of the tile into dest
+                                const long rmax = std::min(GEMM_MR, mc-ip*GEMM_MR);
+                                const long cmax = std::min(GEMM_NR, nc-jp*GEMM_NR);
+                                for (long ii = 0; ii < rmax; ++ii)
+                                {
+                                    for (long jj = 0; jj < cmax; ++jj)
+                                        dest(i0+ip*GEMM_MR+ii, j0+jp*GEMM_NR+jj) += Ct[ii*GEMM_NR+jj];
+                                }
+                            }
+                        }
+                    };
+
+                    const long num_row_blocks = (M+GEMM_MC-1)/GEMM_MC;
+
+#ifndef DLIB_ISO_CPP_ONLY
+                    // Only spread the work over the thread pool when the multiply is
+                    // big enough to amortize the scheduling overhead.
+                    const double flops = static_cast<double>(M)*kc*nc;
+                    if (num_row_blocks > 1 && flops >= 1e7 && std::thread::hardware_concurrency() > 1)
+                    {
+                        parallel_for(0, num_row_blocks, [&](long block)
+                        {
+                            process_row_block(block*GEMM_MC);
+                        });
+                    }
+                    else
+#endif
+                    {
+                        for (long block = 0; block < num_row_blocks; ++block)
+                            process_row_block(block*GEMM_MC);
+                    }
+                }
+            }
+        }
+
+        template <
+            typename matrix_dest_type,
+            typename EXP1,
+            typename EXP2
+            >
+        typename disable_if_c<has_float_gemm_path<matrix_dest_type,EXP1,EXP2>::value>::type
+        matrix_multiply_blocked (
+            matrix_dest_type& dest,
+            const EXP1& lhs,
+            const EXP2& rhs
+        )
+        {
+            const long bs = 90;
+
+            // Process one row strip of blocks from the lhs matrix.  Each strip writes
+            // to a disjoint set of rows in dest, so different strips can safely be
+            // processed by different threads.
+            auto process_row_strip = [&](long r)
+            {
+                for (long c = 0; c < lhs.nc(); c+=bs)
+                {
+                    // make a rect for the block from lhs
+                    rectangle lhs_block(c, r, std::min(c+bs-1,lhs.nc()-1), std::min(r+bs-1,lhs.nr()-1));
+
+                    // now loop over all the rhs blocks we have to multiply with the current lhs block
+                    for (long i = 0; i < rhs.nc(); i += bs)
+                    {
+                        // make a rect for the block from rhs
+                        rectangle rhs_block(i, c, std::min(i+bs-1,rhs.nc()-1), std::min(c+bs-1,rhs.nr()-1));
+
+                        // make a target rect in res
+                        rectangle res_block(rhs_block.left(),lhs_block.top(), rhs_block.right(), lhs_block.bottom());
+
+                        // This loop is optimized assuming that the data is laid out in
+                        // row major order in memory.
+                        for (long r = lhs_block.top(); r <= lhs_block.bottom(); ++r)
+                        {
+                            for (long c = lhs_block.left(); c<= lhs_block.right(); ++c)
+                            {
+                                const typename EXP2::type temp = lhs(r,c);
+                                for (long i = rhs_block.left(); i <= rhs_block.right(); ++i)
+                                {
+                                    dest(r,i) += rhs(c,i)*temp;
+                                }
+                            }
+                        }
+                    }
+                }
+            };
+
+            const long num_row_strips = (lhs.nr()+bs-1)/bs;
+
+#ifndef DLIB_ISO_CPP_ONLY
+            // Only spread the work over the thread pool when the multiply is big
+            // enough to amortize the scheduling overhead.
+            const double flops = static_cast<double>(lhs.nr())*lhs.nc()*rhs.nc();
+            if (num_row_strips > 1 && flops >= 1e7 && std::thread::hardware_concurrency() > 1)
+            {
+                parallel_for(0, num_row_strips, [&](long strip)
+                {
+                    process_row_strip(strip*bs);
+                });
+            }
+            else
+#endif
+            {
+                // Loop over all the blocks in the lhs matrix
+                for (long strip = 0; strip < num_row_strips; ++strip)
+                    process_row_strip(strip*bs);
+            }
+        }
     }
 
 // ------------------------------------------------------------------------------------
@@ -85,45 +371,11 @@ namespace dlib
         else
         {
             // if the lhs and rhs matrices are big enough we should use a cache friendly
-            // algorithm that computes the matrix multiply in blocks.  
-
-
-            // Loop over all the blocks in the lhs matrix
-            for (long r = 0; r < lhs.nr(); r+=bs)
-            {
-                for (long c = 0; c < lhs.nc(); c+=bs)
-                {
-                    // make a rect for the block from lhs 
-                    rectangle lhs_block(c, r, std::min(c+bs-1,lhs.nc()-1), std::min(r+bs-1,lhs.nr()-1));
-
-                    // now loop over all the rhs blocks we have to multiply with the current lhs block
-                    for (long i = 0; i < rhs.nc(); i += bs)
-                    {
-                        // make a rect for the block from rhs 
-                        rectangle rhs_block(i, c, std::min(i+bs-1,rhs.nc()-1), std::min(c+bs-1,rhs.nr()-1));
-
-                        // make a target rect in res
-                        rectangle res_block(rhs_block.left(),lhs_block.top(), rhs_block.right(), lhs_block.bottom());
-
-                        // This loop is optimized assuming that the data is laid out in 
-                        // row major order in memory.
-                        for (long r = lhs_block.top(); r <= lhs_block.bottom(); ++r)
-                        {
-                            for (long c = lhs_block.left(); c<= lhs_block.right(); ++c)
-                            {
-                                const typename EXP2::type temp = lhs(r,c);
-                                for (long i = rhs_block.left(); i <= rhs_block.right(); ++i)
-                                {
-                                    dest(r,i) += rhs(c,i)*temp;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+            // algorithm that computes the matrix multiply in blocks.  When everything
+            // is float this uses the packed panel GEMM with the SIMD microkernel,
+            // otherwise it uses the generic blocked loops.
+            ma::matrix_multiply_blocked(dest, lhs, rhs);
         }
-
-
     }
 
 // ------------------------------------------------------------------------------------
@@ -5,12 +5,16 @@
 #ifndef DLIB_MATRIX_EIGENVALUE_DECOMPOSITION_H
 #define DLIB_MATRIX_EIGENVALUE_DECOMPOSITION_H
 
-#include "matrix.h" 
+#include "matrix.h"
 #include "matrix_utilities.h"
 #include "matrix_subexp.h"
 #include <algorithm>
 #include <complex>
 #include <cmath>
+#include <vector>
+#ifndef DLIB_ISO_CPP_ONLY
+#include "../threads/parallel_for_extension.h"
+#endif
 
 #ifdef DLIB_USE_LAPACK
 #include "lapack/geev.h"
@@ -427,7 +431,15 @@ namespace dlib
 
         // Householder reduction to tridiagonal form.
 
-        for (long i = n-1; i > 0; i--) 
+#ifndef DLIB_ISO_CPP_ONLY
+        // For large matrices the O(n^3) update loops below are spread over the
+        // default thread pool.  The parallel variants accumulate each output
+        // element in exactly the order the serial code does, so the results are
+        // identical to the serial path.
+        const bool use_threads = n >= 350 && std::thread::hardware_concurrency() > 1;
+#endif
+
+        for (long i = n-1; i > 0; i--)
         {
 
             // Scale to avoid under/overflow.
@@ -474,17 +486,44 @@ namespace dlib
 
                 // Apply similarity transformation to remaining columns.
 
-                for (long j = 0; j < i; j++) 
+#ifndef DLIB_ISO_CPP_ONLY
+                if (use_threads && i >= 256)
                 {
-                    f = d(j);
-                    V(j,i) = f;
-                    g = e(j) + V(j,j) * f;
-                    for (long k = j+1; k <= i-1; k++) 
+                    // This computes the same e(j) values as the serial loop below,
+                    // with the products accumulated in the same order, but each
+                    // e(j) is built up independently so the rows can be spread
+                    // over the thread pool.
+                    parallel_for(0, i, [&](long j)
                     {
-                        g += V(k,j) * d(k);
-                        e(k) += V(k,j) * f;
+                        V(j,i) = d(j);
+                        type sum = 0;
+                        for (long k = 0; k < j; k++)
+                        {
+                            sum += V(j,k) * d(k);
+                        }
+                        sum += V(j,j) * d(j);
+                        for (long k = j+1; k <= i-1; k++)
+                        {
+                            sum += V(k,j) * d(k);
+                        }
+                        e(j) = sum;
+                    });
+                }
+                else
+#endif
+                {
+                    for (long j = 0; j < i; j++)
+                    {
+                        f = d(j);
+                        V(j,i) = f;
+                        g = e(j) + V(j,j) * f;
+                        for (long k = j+1; k <= i-1; k++)
+                        {
+                            g += V(k,j) * d(k);
+                            e(k) += V(k,j) * f;
+                        }
+                        e(j) = g;
                     }
-                    e(j) = g;
                 }
                 f = 0.0;
                 for (long j = 0; j < i; j++) 
@@ -497,16 +536,42 @@ namespace dlib
                 {
                     e(j) -= hh * d(j);
                 }
-                for (long j = 0; j < i; j++) 
+#ifndef DLIB_ISO_CPP_ONLY
+                if (use_threads && i >= 256)
                 {
-                    f = d(j);
-                    g = e(j);
-                    for (long k = j; k <= i-1; k++) 
+                    // Each column update only reads d and e and writes its own
+                    // column of V, so the columns can be processed concurrently.
+                    // The d(j) updates happen afterwards since the column updates
+                    // read d.
+                    parallel_for(0, i, [&](long j)
+                    {
+                        const type fj = d(j);
+                        const type gj = e(j);
+                        for (long k = j; k <= i-1; k++)
+                        {
+                            V(k,j) -= (fj * e(k) + gj * d(k));
+                        }
+                    });
+                    for (long j = 0; j < i; j++)
                     {
-                        V(k,j) -= (f * e(k) + g * d(k));
+                        d(j) = V(i-1,j);
+                        V(i,j) = 0.0;
+                    }
+                }
+                else
+#endif
+                {
+                    for (long j = 0; j < i; j++)
+                    {
+                        f = d(j);
+                        g = e(j);
+                        for (long k = j; k <= i-1; k++)
+                        {
+                            V(k,j) -= (f * e(k) + g * d(k));
+                        }
+                        d(j) = V(i-1,j);
+                        V(i,j) = 0.0;
                     }
-                    d(j) = V(i-1,j);
-                    V(i,j) = 0.0;
                 }
             }
             d(i) = h;
@@ -519,23 +584,38 @@ namespace dlib
             V(n-1,i) = V(i,i);
             V(i,i) = 1.0;
             type h = d(i+1);
-            if (h != 0.0) 
+            if (h != 0.0)
             {
-                for (long k = 0; k <= i; k++) 
+                for (long k = 0; k <= i; k++)
                 {
                     d(k) = V(k,i+1) / h;
                 }
-                for (long j = 0; j <= i; j++) 
+
+                // Each iteration of this loop only touches column j of V, so the
+                // columns can be processed concurrently.
+                auto accumulate_column = [&](long j)
                 {
                     type g = 0.0;
-                    for (long k = 0; k <= i; k++) 
+                    for (long k = 0; k <= i; k++)
                     {
                         g += V(k,i+1) * V(k,j);
                     }
-                    for (long k = 0; k <= i; k++) 
+                    for (long k = 0; k <= i; k++)
                     {
                         V(k,j) -= g * d(k);
                     }
+                };
+
+#ifndef DLIB_ISO_CPP_ONLY
+                if (use_threads && i >= 256)
+                {
+                    parallel_for(0, i+1, accumulate_column);
+                }
+                else
+#endif
+                {
+                    for (long j = 0; j <= i; j++)
+                        accumulate_column(j);
                 }
             }
             for (long k = 0; k <= i; k++) 
@@ -577,6 +657,16 @@ namespace dlib
         type f = 0.0;
         type tst1 = 0.0;
         const type eps = std::numeric_limits<type>::epsilon();
+
+#ifndef DLIB_ISO_CPP_ONLY
+        // For large matrices the Givens rotations of each QL sweep are applied
+        // to the eigenvector matrix with the rows spread over the default
+        // thread pool.  Within a row the rotations are applied in exactly the
+        // order the serial code uses, so the results are identical.
+        const bool use_threads = n >= 350 && std::thread::hardware_concurrency() > 1;
+        std::vector<type> rot_c, rot_s;
+#endif
+
         for (long l = 0; l < n; l++) 
         {
 
@@ -636,7 +726,15 @@ namespace dlib
                     type el1 = e(l+1);
                     type s = 0.0;
                     type s2 = 0.0;
-                    for (long i = m-1; i >= l; i--) 
+#ifndef DLIB_ISO_CPP_ONLY
+                    const bool parallel_sweep = use_threads && (m-l)*n >= 100000;
+                    if (parallel_sweep)
+                    {
+                        rot_c.resize(m-l);
+                        rot_s.resize(m-l);
+                    }
+#endif
+                    for (long i = m-1; i >= l; i--)
                     {
                         c3 = c2;
                         c2 = c;
@@ -652,13 +750,43 @@ namespace dlib
 
                         // Accumulate transformation.
 
-                        for (long k = 0; k < n; k++) 
+#ifndef DLIB_ISO_CPP_ONLY
+                        if (parallel_sweep)
+                        {
+                            // remember the rotation and apply the whole sweep to V
+                            // below, one row at a time
+                            rot_c[i-l] = c;
+                            rot_s[i-l] = s;
+                            continue;
+                        }
+#endif
+                        for (long k = 0; k < n; k++)
                         {
                             h = V(k,i+1);
                             V(k,i+1) = s * V(k,i) + c * h;
                             V(k,i) = c * V(k,i) - s * h;
                         }
                     }
+
+#ifndef DLIB_ISO_CPP_ONLY
+                    if (parallel_sweep)
+                    {
+                        // Each row of V is rotated independently of the others, and
+                        // applying the rotations row by row in the same i order
+                        // performs the same arithmetic as the loop above.
+                        parallel_for(0, n, [&](long k)
+                        {
+                            for (long i = m-1; i >= l; i--)
+                            {
+                                const type ci = rot_c[i-l];
+                                const type si = rot_s[i-l];
+                                const type temp = V(k,i+1);
+                                V(k,i+1) = si * V(k,i) + ci * temp;
+                                V(k,i) = ci * V(k,i) - si * temp;
+                            }
+                        });
+                    }
+#endif
                     p = -s * s2 * c3 * el1 * e(l) / dl1;
                     e(l) = s * p;
                     d(l) = c * p;
@@ -839,6 +839,119 @@ namespace dlib
 
 #endif // DLIB_USE_MKL_FFT
 
+// ----------------------------------------------------------------------------------------
+
+    template <typename T>
+    class fft_plan
+    {
+        /*!
+            The point of this object is to let callers that transform matrices over and
+            over (e.g. once per video frame) hang onto the twiddle factors and scratch
+            buffer between calls instead of recomputing and reallocating them inside
+            every fft_inplace()/ifft_inplace() call.
+        !*/
+    public:
+
+        fft_plan() {}
+
+        template < long NR, long NC, typename MM, typename L >
+        void fft_inplace (
+            matrix<std::complex<T>,NR,NC,MM,L>& data
+        ) { transform(data, false); }
+
+        template < long NR, long NC, typename MM, typename L >
+        void ifft_inplace (
+            matrix<std::complex<T>,NR,NC,MM,L>& data
+        ) { transform(data, true); }
+
+    private:
+
+        // Note that, just like the global fft_inplace() routines, we select the 1D
+        // code path based on the compile time dimensions.  A dynamically sized matrix
+        // that happens to have one row still goes down the 2D path so the outputs of
+        // this object are bit for bit identical to the global routines.
+        template < long NR, long NC, typename MM, typename L >
+        typename enable_if_c<NR==1||NC==1>::type transform (
+            matrix<std::complex<T>,NR,NC,MM,L>& data,
+            bool do_backward_fft
+        )
+        {
+#ifdef DLIB_USE_MKL_FFT
+            // MKL manages its own transform setup so just forward to the MKL backed
+            // routines (the generic templates below them handle non-double matrices).
+            if (do_backward_fft)
+                dlib::ifft_inplace(data);
+            else
+                dlib::fft_inplace(data);
+#else
+            // make sure requires clause is not broken
+            DLIB_CASSERT(is_power_of_two(data.nr()) && is_power_of_two(data.nc()),
+                "\t void fft_plan::fft_inplace(data)"
+                << "\n\t The number of rows and columns must be powers of two."
+                << "\n\t data.nr(): "<< data.nr()
+                << "\n\t data.nc(): "<< data.nc()
+                << "\n\t is_power_of_two(data.nr()): " << is_power_of_two(data.nr())
+                << "\n\t is_power_of_two(data.nc()): " << is_power_of_two(data.nc())
+                );
+
+            impl::fft1d_inplace(data, do_backward_fft, cs1d);
+#endif
+        }
+
+        template < long NR, long NC, typename MM, typename L >
+        typename disable_if_c<NR==1||NC==1>::type transform (
+            matrix<std::complex<T>,NR,NC,MM,L>& data,
+            bool do_backward_fft
+        )
+        {
+#ifdef DLIB_USE_MKL_FFT
+            if (do_backward_fft)
+                dlib::ifft_inplace(data);
+            else
+                dlib::fft_inplace(data);
+#else
+            // make sure requires clause is not broken
+            DLIB_CASSERT(is_power_of_two(data.nr()) && is_power_of_two(data.nc()),
+                "\t void fft_plan::fft_inplace(data)"
+                << "\n\t The number of rows and columns must be powers of two."
+                << "\n\t data.nr(): "<< data.nr()
+                << "\n\t data.nc(): "<< data.nc()
+                << "\n\t is_power_of_two(data.nr()): " << is_power_of_two(data.nr())
+                << "\n\t is_power_of_two(data.nc()): " << is_power_of_two(data.nc())
+                );
+
+            if (data.size() == 0)
+                return;
+
+            // This is the same algorithm as impl::fft2d_inplace() except the twiddle
+            // factors and row/column buffer persist across calls.
+
+            // Compute transform row by row
+            for (long r = 0; r < data.nr(); ++r)
+            {
+                buff = matrix_cast<std::complex<double> >(rowm(data,r));
+                impl::fft1d_inplace(buff, do_backward_fft, cs2d);
+                set_rowm(data,r) = matrix_cast<std::complex<T> >(buff);
+            }
+
+            // Compute transform column by column
+            for (long c = 0; c < data.nc(); ++c)
+            {
+                buff = matrix_cast<std::complex<double> >(colm(data,c));
+                impl::fft1d_inplace(buff, do_backward_fft, cs2d);
+                set_colm(data,c) = matrix_cast<std::complex<T> >(buff);
+            }
+#endif
+        }
+
+        // cs1d is used for 1D transforms while cs2d and buff are used by the 2D code
+        // path, which does its row and column passes in double precision just like
+        // impl::fft2d_inplace().
+        impl::twiddles<T> cs1d;
+        impl::twiddles<double> cs2d;
+        matrix<std::complex<double> > buff;
+    };
+
 // ----------------------------------------------------------------------------------------
 }
 
@@ -106,10 +106,69 @@ namespace dlib
             - This function is identical to ifft() except that it does the inverse FFT
               in-place.  That is, after this function executes we will have:
                 - #data == ifft(data)*data.size()
-                - Note that the output needs to be divided by data.size() to complete the 
-                  inverse transformation.  
+                - Note that the output needs to be divided by data.size() to complete the
+                  inverse transformation.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    class fft_plan
+    {
+        /*!
+            REQUIREMENTS ON T
+                T must be either double, float, or long double.
+
+            WHAT THIS OBJECT REPRESENTS
+                This object computes the same transforms as the global fft_inplace()
+                and ifft_inplace() routines but keeps the twiddle factors and scratch
+                buffer those routines need alive between calls.  So if you transform
+                matrices over and over, like a tracker does once per video frame, keep
+                one fft_plan around and run your transforms through it to avoid paying
+                the transform setup cost every time.  A single plan handles any
+                power of two size, caching the setup for each size it encounters.
+
+                Note that this object is not thread safe.  Give each thread its own
+                plan.
+        !*/
+    public:
+
+        fft_plan(
+        );
+        /*!
+            ensures
+                - this object is properly initialized
+        !*/
+
+        template < long NR, long NC, typename MM, typename L >
+        void fft_inplace (
+            matrix<std::complex<T>,NR,NC,MM,L>& data
+        );
+        /*!
+            requires
+                - is_power_of_two(data.nr()) == true
+                - is_power_of_two(data.nc()) == true
+            ensures
+                - #data == fft(data)
+                  (i.e. behaves exactly like the global fft_inplace(data))
+        !*/
+
+        template < long NR, long NC, typename MM, typename L >
+        void ifft_inplace (
+            matrix<std::complex<T>,NR,NC,MM,L>& data
+        );
+        /*!
+            requires
+                - is_power_of_two(data.nr()) == true
+                - is_power_of_two(data.nc()) == true
+            ensures
+                - #data == ifft(data)*data.size()
+                  (i.e. behaves exactly like the global ifft_inplace(data))
+        !*/
+    };
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -23,8 +23,13 @@
 #endif
 
 #include "../threads.h"
+#include "../serialize.h"
+#include "../byte_orderer.h"
+#include "../noncopyable.h"
 
+#include <fstream>
 #include <iostream>
+#include <vector>
 
 namespace dlib
 {
@@ -833,6 +838,367 @@ convergence:
         simpl::svd_fast(false, A,u,w,v,l,q);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sparse_vector_type
+        >
+    class sparse_matrix_file_writer : noncopyable
+    {
+    public:
+        explicit sparse_matrix_file_writer (
+            const std::string& filename
+        ) :
+            fout(filename.c_str(), std::ios::binary)
+        {
+            if (!fout)
+                throw error("sparse_matrix_file_writer: unable to open the file " + filename + " for writing.");
+
+            // Reserve space for the header.  close() comes back and fills it in once
+            // the final row and column counts are known.
+            const char header[16] = {0};
+            fout.write(header, sizeof(header));
+        }
+
+        ~sparse_matrix_file_writer (
+        )
+        {
+            try { close(); } catch (...) {}
+        }
+
+        void add_row (
+            const sparse_vector_type& row
+        )
+        {
+            serialize(row, fout);
+            ++num_rows;
+            if (row.size() != 0)
+                num_cols = std::max<uint64>(num_cols, row.rbegin()->first + 1);
+        }
+
+        unsigned long size (
+        ) const { return static_cast<unsigned long>(num_rows); }
+
+        void close (
+        )
+        {
+            if (!fout.is_open())
+                return;
+
+            byte_orderer bo;
+            uint64 temp = num_rows;
+            bo.host_to_little(temp);
+            fout.seekp(0);
+            fout.write(reinterpret_cast<char*>(&temp), sizeof(temp));
+            temp = num_cols;
+            bo.host_to_little(temp);
+            fout.write(reinterpret_cast<char*>(&temp), sizeof(temp));
+            if (!fout)
+                throw error("sparse_matrix_file_writer: error occurred while writing the file header.");
+            fout.close();
+        }
+
+    private:
+
+        std::ofstream fout;
+        uint64 num_rows = 0;
+        uint64 num_cols = 0;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sparse_vector_type
+        >
+    class sparse_matrix_file_reader : noncopyable
+    {
+    public:
+        explicit sparse_matrix_file_reader (
+            const std::string& filename_
+        ) :
+            filename(filename_),
+            fin(filename_.c_str(), std::ios::binary)
+        {
+            if (!fin)
+                throw error("sparse_matrix_file_reader: unable to open the file " + filename + " for reading.");
+
+            byte_orderer bo;
+            uint64 temp;
+            fin.read(reinterpret_cast<char*>(&temp), sizeof(temp));
+            bo.little_to_host(temp);
+            num_rows = static_cast<unsigned long>(temp);
+            fin.read(reinterpret_cast<char*>(&temp), sizeof(temp));
+            bo.little_to_host(temp);
+            num_cols = static_cast<unsigned long>(temp);
+            if (!fin)
+                throw error("sparse_matrix_file_reader: the file " + filename + " does not contain a valid header.");
+        }
+
+        unsigned long nr (
+        ) const { return num_rows; }
+
+        unsigned long nc (
+        ) const { return num_cols; }
+
+        void reset (
+        )
+        {
+            fin.clear();
+            fin.seekg(16);
+            rows_read = 0;
+        }
+
+        bool read_block (
+            std::vector<sparse_vector_type>& block,
+            unsigned long max_rows
+        )
+        {
+            block.clear();
+            while (block.size() < max_rows && rows_read < num_rows)
+            {
+                sparse_vector_type row;
+                try
+                {
+                    deserialize(row, fin);
+                }
+                catch (serialization_error& e)
+                {
+                    throw serialization_error("Error reading row " + cast_to_string(rows_read) +
+                        " from the sparse matrix file " + filename + ": " + e.info);
+                }
+                block.push_back(std::move(row));
+                ++rows_read;
+            }
+            return block.size() != 0;
+        }
+
+    private:
+
+        const std::string filename;
+        std::ifstream fin;
+        unsigned long num_rows = 0;
+        unsigned long num_cols = 0;
+        unsigned long rows_read = 0;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sparse_vector_type,
+        typename T,
+        typename MM,
+        typename L
+        >
+    void find_matrix_range (
+        sparse_matrix_file_reader<sparse_vector_type>& A,
+        unsigned long l,
+        matrix<T,0,0,MM,L>& Q,
+        unsigned long q,
+        unsigned long rows_per_block
+    )
+    /*!
+        requires
+            - A.nr() >= l
+            - rows_per_block > 0
+        ensures
+            - This function is identical to the above overload of find_matrix_range()
+              that takes a std::vector of sparse vectors, except that it streams the
+              rows of A from disk in blocks of at most rows_per_block rows.  So it
+              never holds more than rows_per_block rows of A in RAM at once, no matter
+              how large the matrix on disk is.  Each subspace iteration makes two more
+              sequential passes over the file.
+    !*/
+    {
+        DLIB_ASSERT(A.nr() >= l && rows_per_block > 0, "Invalid inputs were given to this function.");
+        Q.set_size(A.nr(), l);
+
+        std::vector<sparse_vector_type> block;
+
+        // Compute Q = A*gaussian_randm(), one block of rows at a time.
+        A.reset();
+        long row_offset = 0;
+        while (A.read_block(block, rows_per_block))
+        {
+            parallel_for(0, block.size(), [&](long r)
+            {
+                for (long c = 0; c < Q.nc(); ++c)
+                {
+                    Q(row_offset+r,c) = dot(block[r], gaussian_randm(std::numeric_limits<long>::max(), 1, c));
+                }
+            });
+            row_offset += block.size();
+        }
+
+        orthogonalize(Q);
+
+        // Do some extra iterations of the power method to make sure we get Q into the
+        // span of the most important singular vectors of A.
+        if (q != 0)
+        {
+            const unsigned long n = A.nc();
+            for (unsigned long itr = 0; itr < q; ++itr)
+            {
+                matrix<T,0,0,MM> Z(n,l);
+                Z = 0;
+                // Compute Z = trans(A)*Q
+                A.reset();
+                row_offset = 0;
+                while (A.read_block(block, rows_per_block))
+                {
+                    for (unsigned long m = 0; m < block.size(); ++m)
+                    {
+                        for (unsigned long r = 0; r < l; ++r)
+                        {
+                            for (auto& i : block[m])
+                            {
+                                const auto c = i.first;
+                                const auto val = i.second;
+
+                                Z(c,r) += Q(row_offset+m,r)*val;
+                            }
+                        }
+                    }
+                    row_offset += block.size();
+                }
+
+                orthogonalize(Z);
+
+                // Compute Q = A*Z
+                A.reset();
+                row_offset = 0;
+                while (A.read_block(block, rows_per_block))
+                {
+                    parallel_for(0, block.size(), [&](long r)
+                    {
+                        for (long c = 0; c < Q.nc(); ++c)
+                        {
+                            Q(row_offset+r,c) = dot(block[r], colm(Z,c));
+                        }
+                    });
+                    row_offset += block.size();
+                }
+
+                Z.set_size(0,0); // free RAM
+                orthogonalize(Q);
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    namespace simpl
+    {
+        template <
+            typename sparse_vector_type,
+            typename T,
+            long Unr, long Unc,
+            long Wnr, long Wnc,
+            long Vnr, long Vnc,
+            typename MM,
+            typename L
+            >
+        void svd_fast (
+            bool compute_u,
+            sparse_matrix_file_reader<sparse_vector_type>& A,
+            matrix<T,Unr,Unc,MM,L>& u,
+            matrix<T,Wnr,Wnc,MM,L>& w,
+            matrix<T,Vnr,Vnc,MM,L>& v,
+            unsigned long l,
+            unsigned long q,
+            unsigned long rows_per_block
+        )
+        {
+            const long n = A.nc();
+            const unsigned long k = std::min(l, std::min<unsigned long>(A.nr(),n));
+
+            DLIB_ASSERT(l > 0 && A.nr() > 0 && n > 0 && rows_per_block > 0,
+                "\t void svd_fast()"
+                << "\n\t Invalid inputs were given to this function."
+                << "\n\t l: " << l
+                << "\n\t n (i.e. A.nc()): " << n
+                << "\n\t A.nr(): " << A.nr()
+                << "\n\t rows_per_block: " << rows_per_block
+                );
+
+            matrix<T,0,0,MM,L> Q;
+            find_matrix_range(A, k, Q, q, rows_per_block);
+
+            // Compute trans(B) = trans(Q)*A with one last sequential pass over the
+            // file.  As in the in-memory version above, we store B transposed so the
+            // square matrix coming out of svd3() has size kxk rather than the
+            // potentially much larger nxn.
+            matrix<T,0,0,MM> B(n,k);
+            B = 0;
+            std::vector<sparse_vector_type> block;
+            A.reset();
+            long row_offset = 0;
+            while (A.read_block(block, rows_per_block))
+            {
+                for (unsigned long m = 0; m < block.size(); ++m)
+                {
+                    for (unsigned long r = 0; r < k; ++r)
+                    {
+                        for (auto& i : block[m])
+                        {
+                            const auto c = i.first;
+                            const auto val = i.second;
+
+                            B(c,r) += Q(row_offset+m,r)*val;
+                        }
+                    }
+                }
+                row_offset += block.size();
+            }
+
+            svd3(B, v,w,u);
+            if (compute_u)
+                u = Q*u;
+        }
+    }
+
+    template <
+        typename sparse_vector_type,
+        typename T,
+        long Unr, long Unc,
+        long Wnr, long Wnc,
+        long Vnr, long Vnc,
+        typename MM,
+        typename L
+        >
+    void svd_fast (
+        sparse_matrix_file_reader<sparse_vector_type>& A,
+        matrix<T,Unr,Unc,MM,L>& u,
+        matrix<T,Wnr,Wnc,MM,L>& w,
+        matrix<T,Vnr,Vnc,MM,L>& v,
+        unsigned long l,
+        unsigned long q = 1,
+        unsigned long rows_per_block = 10000
+    )
+    {
+        simpl::svd_fast(true, A,u,w,v,l,q,rows_per_block);
+    }
+
+    template <
+        typename sparse_vector_type,
+        typename T,
+        long Wnr, long Wnc,
+        long Vnr, long Vnc,
+        typename MM,
+        typename L
+        >
+    void svd_fast (
+        sparse_matrix_file_reader<sparse_vector_type>& A,
+        matrix<T,Wnr,Wnc,MM,L>& w,
+        matrix<T,Vnr,Vnc,MM,L>& v,
+        unsigned long l,
+        unsigned long q = 1,
+        unsigned long rows_per_block = 10000
+    )
+    {
+        matrix<T,0,0,MM,L> u;
+        simpl::svd_fast(false, A,u,w,v,l,q,rows_per_block);
+    }
+
 // ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
 
@@ -858,9 +1224,50 @@ convergence:
                 );
             typedef typename matrix_exp<EXP>::type type;
 
+            // Dynamically sized matrices that happen to be small at runtime can use the
+            // same unrolled formulas as the compile time sized specializations below,
+            // which avoids the LU decomposition and its temporary heap storage.
+            if (matrix_exp<EXP>::NR == 0 && m.nr() <= 4)
+            {
+                switch (m.nr())
+                {
+                    case 1: return small_inv<1>(m);
+                    case 2: return small_inv<2>(m);
+                    case 3: return small_inv<3>(m);
+                    case 4: return small_inv<4>(m);
+                }
+            }
+
             lu_decomposition<EXP> lu(m);
             return lu.solve(identity_matrix<type>(m.nr()));
         }
+
+    private:
+
+        template <long K>
+        static const typename matrix_exp<EXP>::matrix_type small_inv (
+            const matrix_exp<EXP>& m
+        )
+        /*!
+            requires
+                - m.nr() == m.nc() == K
+            ensures
+                - returns inv(m), computed with the fully unrolled K by K formulas
+        !*/
+        {
+            typedef typename matrix_exp<EXP>::type type;
+            typedef matrix<type,K,K,typename EXP::mem_manager_type> small_matrix;
+            small_matrix t;
+            for (long r = 0; r < K; ++r)
+                for (long c = 0; c < K; ++c)
+                    t(r,c) = m(r,c);
+            const small_matrix ti = inv_helper<small_matrix,K>::inv(t);
+            typename matrix_exp<EXP>::matrix_type ret(m);
+            for (long r = 0; r < K; ++r)
+                for (long c = 0; c < K; ++c)
+                    ret(r,c) = ti(r,c);
+            return ret;
+        }
     };
 
     template <
@@ -1533,8 +1940,49 @@ escape_banded_detection:
                 "\tconst matrix_exp::type det(const matrix_exp& m)"
                 << "\n\tYou can only apply det() to a square matrix"
                 << "\n\tm.nr(): " << m.nr()
-                << "\n\tm.nc(): " << m.nc() 
+                << "\n\tm.nc(): " << m.nc()
                 );
+            typedef typename matrix_exp<EXP>::type type;
+
+            // Just like in inv(), dynamically sized matrices that are small at runtime
+            // get unrolled formulas instead of an LU decomposition.
+            if (matrix_exp<EXP>::NR == 0 && m.nr() <= 4)
+            {
+                switch (m.nr())
+                {
+                    case 1:
+                        return m(0,0);
+
+                    case 2:
+                        return m(0,0)*m(1,1) - m(0,1)*m(1,0);
+
+                    case 3:
+                        return m(0,0)*(m(1,1)*m(2,2) - m(1,2)*m(2,1)) -
+                               m(0,1)*(m(1,0)*m(2,2) - m(1,2)*m(2,0)) +
+                               m(0,2)*(m(1,0)*m(2,1) - m(1,1)*m(2,0));
+
+                    case 4:
+                    {
+                        // Expand in terms of 2x2 subdeterminants of the top and bottom
+                        // halves of the matrix.
+                        const type s0 = m(0,0)*m(1,1) - m(1,0)*m(0,1);
+                        const type s1 = m(0,0)*m(1,2) - m(1,0)*m(0,2);
+                        const type s2 = m(0,0)*m(1,3) - m(1,0)*m(0,3);
+                        const type s3 = m(0,1)*m(1,2) - m(1,1)*m(0,2);
+                        const type s4 = m(0,1)*m(1,3) - m(1,1)*m(0,3);
+                        const type s5 = m(0,2)*m(1,3) - m(1,2)*m(0,3);
+
+                        const type c5 = m(2,2)*m(3,3) - m(3,2)*m(2,3);
+                        const type c4 = m(2,1)*m(3,3) - m(3,1)*m(2,3);
+                        const type c3 = m(2,1)*m(3,2) - m(3,1)*m(2,2);
+                        const type c2 = m(2,0)*m(3,3) - m(3,0)*m(2,3);
+                        const type c1 = m(2,0)*m(3,2) - m(3,0)*m(2,2);
+                        const type c0 = m(2,0)*m(3,1) - m(3,0)*m(2,1);
+
+                        return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+                    }
+                }
+            }
 
             return lu_decomposition<EXP>(m).det();
         }
@@ -1669,22 +2117,26 @@ escape_banded_detection:
 
 // ----------------------------------------------------------------------------------------
 
+    namespace impl
+    {
     template <
-        typename EXP 
+        typename EXP
         >
-    dlib::vector<double,2> max_point_interpolated (
-        const matrix_exp<EXP>& m
+    dlib::vector<double,2> refine_max_point (
+        const matrix_exp<EXP>& m,
+        const point& p
     )
+    /*!
+        requires
+            - m.size() > 0
+            - get_rect(m).contains(p) == true
+            - p == the location of the maximum element of m
+        ensures
+            - returns the location of the maximum of m to subpixel accuracy, obtained
+              by fitting a quadratic surface to the 3x3 neighborhood around p (or a
+              1-D quadratic when m is a row or column vector).
+    !*/
     {
-        DLIB_ASSERT(m.size() > 0, 
-            "\tdlib::vector<double,2> point max_point_interpolated(const matrix_exp& m)"
-            << "\n\tm can't be empty"
-            << "\n\tm.size():   " << m.size() 
-            << "\n\tm.nr():     " << m.nr() 
-            << "\n\tm.nc():     " << m.nc() 
-            );
-        const point p = max_point(m);
-
         // If this is a column vector then just do interpolation along a line.
         if (m.nc()==1)
         {
@@ -1797,6 +2249,72 @@ escape_banded_detection:
         else
             return vector<double,2>(p)+dlib::clamp(delta, -1, 1);
     }
+    }
+
+    template <
+        typename EXP
+        >
+    dlib::vector<double,2> max_point_interpolated (
+        const matrix_exp<EXP>& m
+    )
+    {
+        DLIB_ASSERT(m.size() > 0,
+            "\tdlib::vector<double,2> point max_point_interpolated(const matrix_exp& m)"
+            << "\n\tm can't be empty"
+            << "\n\tm.size():   " << m.size()
+            << "\n\tm.nr():     " << m.nr()
+            << "\n\tm.nc():     " << m.nc()
+            );
+        const point p = max_point(m);
+        return impl::refine_max_point(m, p);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T,
+        long NR,
+        long NC,
+        typename MM,
+        typename L
+        >
+    std::vector<dlib::vector<double,2> > max_points_interpolated (
+        const std::vector<matrix<T,NR,NC,MM,L> >& maps
+    )
+    {
+        std::vector<dlib::vector<double,2> > peaks;
+        peaks.reserve(maps.size());
+        for (unsigned long i = 0; i < maps.size(); ++i)
+        {
+            const matrix<T,NR,NC,MM,L>& m = maps[i];
+            DLIB_ASSERT(m.size() > 0,
+                "\tstd::vector<dlib::vector<double,2>> max_points_interpolated()"
+                << "\n\t The response maps can't be empty."
+                << "\n\t i: " << i
+                );
+
+            // Find the argmax with one tight scan over the map.  Since we have the
+            // concrete matrix rather than a general expression the inner loop runs
+            // over contiguous memory, which is what matters when grinding through a
+            // pile of small response maps.
+            point best(0,0);
+            T best_val = m(0,0);
+            for (long r = 0; r < m.nr(); ++r)
+            {
+                for (long c = 0; c < m.nc(); ++c)
+                {
+                    if (m(r,c) > best_val)
+                    {
+                        best_val = m(r,c);
+                        best = point(c,r);
+                    }
+                }
+            }
+
+            peaks.push_back(impl::refine_max_point(m, best));
+        }
+        return peaks;
+    }
 
 // ----------------------------------------------------------------------------------------
 
@@ -264,6 +264,193 @@ namespace dlib
         This function is identical to the above svd_fast() except it doesn't compute u.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sparse_vector_type
+        >
+    class sparse_matrix_file_writer : noncopyable
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object writes a sparse matrix to a disk file, one row at a time.
+                The resulting file can then be read back with a
+                sparse_matrix_file_reader and fed to the out-of-core version of
+                svd_fast().  It is meant for matrices which are too large to hold in
+                RAM, since rows can be appended incrementally and never need to exist
+                in memory all at once.
+        !*/
+
+    public:
+
+        explicit sparse_matrix_file_writer (
+            const std::string& filename
+        );
+        /*!
+            ensures
+                - opens the file with the given name for writing, overwriting any
+                  previous contents.
+            throws
+                - dlib::error if the file can't be opened.
+        !*/
+
+        ~sparse_matrix_file_writer (
+        );
+        /*!
+            ensures
+                - calls close(), ignoring any exceptions it throws.
+        !*/
+
+        void add_row (
+            const sparse_vector_type& row
+        );
+        /*!
+            requires
+                - row is a sparse vector.  See dlib/svm/sparse_vector_abstract.h for a
+                  definition of what constitutes a sparse vector.
+            ensures
+                - appends row to the file as the next row of the matrix.
+                - #size() == size() + 1
+        !*/
+
+        unsigned long size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of rows written so far.
+        !*/
+
+        void close (
+        );
+        /*!
+            ensures
+                - finalizes the file header and closes the file.  After this call the
+                  file is ready to be read by a sparse_matrix_file_reader.  It is safe
+                  to call close() multiple times.
+            throws
+                - dlib::error if an I/O error occurs while finalizing the file.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sparse_vector_type
+        >
+    class sparse_matrix_file_reader : noncopyable
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object reads a sparse matrix from a file created by
+                sparse_matrix_file_writer.  It provides sequential access to blocks of
+                rows so that algorithms such as the out-of-core version of svd_fast()
+                can stream over the matrix without ever loading it entirely into RAM.
+        !*/
+
+    public:
+
+        explicit sparse_matrix_file_reader (
+            const std::string& filename
+        );
+        /*!
+            ensures
+                - opens the file with the given name for reading.
+            throws
+                - dlib::error if the file can't be opened or doesn't begin with a
+                  valid header.
+        !*/
+
+        unsigned long nr (
+        ) const;
+        /*!
+            ensures
+                - returns the number of rows in the matrix stored in the file.
+        !*/
+
+        unsigned long nc (
+        ) const;
+        /*!
+            ensures
+                - returns the number of columns in the matrix stored in the file.
+                  This is the max_index_plus_one() value over all the rows.
+        !*/
+
+        void reset (
+        );
+        /*!
+            ensures
+                - the next call to read_block() will start reading from the first row
+                  of the matrix again.
+        !*/
+
+        bool read_block (
+            std::vector<sparse_vector_type>& block,
+            unsigned long max_rows
+        );
+        /*!
+            requires
+                - max_rows > 0
+            ensures
+                - reads the next max_rows rows of the matrix into #block, or fewer if
+                  fewer rows remain.
+                - returns true if #block.size() != 0, i.e. if any rows were read.
+            throws
+                - dlib::serialization_error if the file is corrupt.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sparse_vector_type,
+        typename T
+        >
+    void svd_fast (
+        sparse_matrix_file_reader<sparse_vector_type>& A,
+        matrix<T>& u,
+        matrix<T>& w,
+        matrix<T>& v,
+        unsigned long l,
+        unsigned long q = 1,
+        unsigned long rows_per_block = 10000
+    );
+    /*!
+        requires
+            - l > 0
+            - A.nr() > 0
+            - A.nc() > 0
+            - rows_per_block > 0
+        ensures
+            - computes the same singular value decomposition as the above svd_fast()
+              that takes a std::vector of sparse vectors, except that A is streamed
+              from disk rather than held in RAM.  The rows of A are read sequentially
+              in blocks of at most rows_per_block rows, and each subspace iteration
+              makes two additional passes over the file.  Therefore, the RAM used by
+              this routine is limited to the projection matrices, which are of size
+              A.nr()*k and A.nc()*k, plus at most rows_per_block rows of A, no matter
+              how large the matrix on disk is.
+            - In the definitions given in the documentation for the above svd_fast():
+                - Let m = A.nr()
+                - Let n = A.nc()
+                - Let k = min(l, min(m,n))
+    !*/
+
+    template <
+        typename sparse_vector_type,
+        typename T
+        >
+    void svd_fast (
+        sparse_matrix_file_reader<sparse_vector_type>& A,
+        matrix<T>& w,
+        matrix<T>& v,
+        unsigned long l,
+        unsigned long q = 1,
+        unsigned long rows_per_block = 10000
+    );
+    /*!
+        This function is identical to the above svd_fast() except it doesn't compute u.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -5,9 +5,12 @@
 #ifndef DLIB_MATRIX_QR_DECOMPOSITION_H
 #define DLIB_MATRIX_QR_DECOMPOSITION_H
 
-#include "matrix.h" 
+#include "matrix.h"
 #include "matrix_utilities.h"
 #include "matrix_subexp.h"
+#ifndef DLIB_ISO_CPP_ONLY
+#include "../threads/parallel_for_extension.h"
+#endif
 
 #ifdef DLIB_USE_LAPACK
 #include "lapack/geqrf.h"
@@ -145,44 +148,67 @@ namespace dlib
 
 #else
         Rdiag.set_size(n);
-        long i=0, j=0, k=0;
+        long i=0, k=0;
+
+#ifndef DLIB_ISO_CPP_ONLY
+        // Applying each Householder transformation to the remaining columns is
+        // the O(m*n^2) part of the decomposition and every column update is
+        // independent, so for large matrices spread the columns over the default
+        // thread pool.  The arithmetic done for a column doesn't depend on how
+        // the columns are partitioned, so the results are identical to the
+        // serial path.
+        const bool use_threads = static_cast<double>(m)*n*n >= 1e7 &&
+                                 std::thread::hardware_concurrency() > 1;
+#endif
 
         // Main loop.
-        for (k = 0; k < n; k++) 
+        for (k = 0; k < n; k++)
         {
             // Compute 2-norm of k-th column without under/overflow.
             type nrm = 0;
-            for (i = k; i < m; i++) 
+            for (i = k; i < m; i++)
             {
                 nrm = hypot(nrm,QR_(i,k));
             }
 
-            if (nrm != 0.0) 
+            if (nrm != 0.0)
             {
                 // Form k-th Householder vector.
-                if (QR_(k,k) < 0) 
+                if (QR_(k,k) < 0)
                 {
                     nrm = -nrm;
                 }
-                for (i = k; i < m; i++) 
+                for (i = k; i < m; i++)
                 {
                     QR_(i,k) /= nrm;
                 }
                 QR_(k,k) += 1.0;
 
                 // Apply transformation to remaining columns.
-                for (j = k+1; j < n; j++) 
+                auto apply_to_column = [&](long j)
                 {
-                    type s = 0.0; 
-                    for (i = k; i < m; i++) 
+                    type s = 0.0;
+                    for (long i = k; i < m; i++)
                     {
                         s += QR_(i,k)*QR_(i,j);
                     }
                     s = -s/QR_(k,k);
-                    for (i = k; i < m; i++) 
+                    for (long i = k; i < m; i++)
                     {
                         QR_(i,j) += s*QR_(i,k);
                     }
+                };
+
+#ifndef DLIB_ISO_CPP_ONLY
+                if (use_threads && n-k-1 > 1)
+                {
+                    parallel_for(k+1, n, apply_to_column);
+                }
+                else
+#endif
+                {
+                    for (long j = k+1; j < n; j++)
+                        apply_to_column(j);
                 }
             }
             Rdiag(k) = -nrm;
@@ -0,0 +1,226 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_MATRIx_SCRATCH_ARENA_H_
+#define DLIB_MATRIx_SCRATCH_ARENA_H_
+
+#include "matrix_scratch_arena_abstract.h"
+#include "../noncopyable.h"
+#include "../assert.h"
+#include <cstddef>
+#include <type_traits>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        class matrix_scratch_arena : noncopyable
+        {
+            /*!
+                CONVENTION
+                    - if (depth > 0) then
+                        - a matrix_scratch_context is active on this thread and
+                          allocate() hands out blocks from buf.
+                    - buf == an array of cap bytes, or 0.
+                    - top == the number of bytes of buf currently handed out.
+                    - outstanding == the number of blocks handed out but not yet
+                      returned.
+                    - Each block begins with a 16 byte header holding the values of top
+                      before and after the block was handed out.  Blocks only ever back
+                      temporary matrices made during expression evaluation, and those
+                      are destructed in the reverse of the order they are constructed.
+                      That stack discipline is what lets deallocate() just roll top
+                      back.
+            !*/
+        public:
+
+            matrix_scratch_arena() = default;
+
+            ~matrix_scratch_arena()
+            {
+                delete [] buf;
+            }
+
+            void enter_scope (
+                size_t min_bytes
+            )
+            {
+                // Never resize while blocks are outstanding, their memory is in buf.
+                if (depth == 0 && outstanding == 0 && cap < min_bytes)
+                {
+                    delete [] buf;
+                    buf = 0;
+                    cap = 0;
+                    buf = new char[min_bytes];
+                    cap = min_bytes;
+                }
+                ++depth;
+            }
+
+            void exit_scope (
+            )
+            {
+                if (depth > 0)
+                    --depth;
+                if (depth == 0 && outstanding == 0)
+                    top = 0;
+            }
+
+            void* allocate (
+                size_t bytes
+            )
+            {
+                if (depth == 0 || buf == 0)
+                    return 0;
+                // round the payload up so blocks stay 16 byte aligned
+                const size_t payload = (bytes + alignment-1) & ~(alignment-1);
+                const size_t block = header_size + payload;
+                if (payload < bytes || top + block < top || top + block > cap)
+                    return 0;
+                char* p = buf + top;
+                reinterpret_cast<size_t*>(p)[0] = top;
+                reinterpret_cast<size_t*>(p)[1] = top + block;
+                top += block;
+                ++outstanding;
+                return p + header_size;
+            }
+
+            bool deallocate (
+                void* ptr
+            )
+            {
+                char* p = static_cast<char*>(ptr);
+                if (p < buf || buf + cap <= p)
+                    return false;
+
+                const size_t block_start = reinterpret_cast<size_t*>(p - header_size)[0];
+                const size_t block_end   = reinterpret_cast<size_t*>(p - header_size)[1];
+                DLIB_ASSERT(block_end == top,
+                    "\t bool matrix_scratch_arena::deallocate(ptr)"
+                    << "\n\t Scratch blocks must be returned in stack order."
+                    << "\n\t block_end: " << block_end
+                    << "\n\t top:       " << top
+                    );
+                if (block_end == top)
+                    top = block_start;
+                // else: a block outlived one handed out before it.  Leave top alone so
+                // nothing gets handed out twice; the space is reclaimed when the
+                // earlier block is returned.
+                --outstanding;
+                return true;
+            }
+
+            static matrix_scratch_arena& get (
+            )
+            {
+                thread_local matrix_scratch_arena arena;
+                return arena;
+            }
+
+        private:
+
+            const static size_t alignment = 16;
+            const static size_t header_size = 16;
+
+            char* buf = 0;
+            size_t cap = 0;
+            size_t top = 0;
+            unsigned long depth = 0;
+            unsigned long outstanding = 0;
+        };
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    class scratch_memory_manager
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This is a memory manager (in the sense of
+                dlib/memory_manager_stateless) that pulls arrays from the thread local
+                matrix scratch arena whenever a matrix_scratch_context is active on the
+                calling thread, and otherwise just uses new/delete.  The matrix
+                expression code uses it for the temporary matrices it makes when
+                materializing costly subexpressions.
+        !*/
+    public:
+
+        typedef T type;
+        const static bool is_stateless = true;
+
+        template <typename U>
+        struct rebind {
+            typedef scratch_memory_manager<U> other;
+        };
+
+        T* allocate (
+        )
+        {
+            return new T;
+        }
+
+        void deallocate (
+            T* item
+        )
+        {
+            delete item;
+        }
+
+        T* allocate_array (
+            size_t size
+        )
+        {
+            // Only trivial types can live in the arena since its blocks are handed
+            // out and returned as raw bytes.
+            if (std::is_trivial<T>::value)
+            {
+                void* p = impl::matrix_scratch_arena::get().allocate(size*sizeof(T));
+                if (p)
+                    return static_cast<T*>(p);
+            }
+            return new T[size];
+        }
+
+        void deallocate_array (
+            T* item
+        )
+        {
+            if (std::is_trivial<T>::value && impl::matrix_scratch_arena::get().deallocate(item))
+                return;
+            delete [] item;
+        }
+
+        void swap (scratch_memory_manager&)
+        {}
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    class matrix_scratch_context : noncopyable
+    {
+    public:
+
+        explicit matrix_scratch_context (
+            size_t num_bytes = 1024*1024
+        )
+        {
+            impl::matrix_scratch_arena::get().enter_scope(num_bytes);
+        }
+
+        ~matrix_scratch_context (
+        )
+        {
+            impl::matrix_scratch_arena::get().exit_scope();
+        }
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_MATRIx_SCRATCH_ARENA_H_
@@ -0,0 +1,68 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_MATRIx_SCRATCH_ARENA_ABSTRACT_
+#ifdef DLIB_MATRIx_SCRATCH_ARENA_ABSTRACT_
+
+#include "../noncopyable.h"
+#include <cstddef>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class matrix_scratch_context : noncopyable
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object is an RAII scope during which the matrix expression code
+                draws the temporary matrices it makes (e.g. when materializing a costly
+                subexpression inside a product, or when an expression aliases its
+                destination) from a preallocated thread local buffer instead of the
+                heap.  The buffer is handed out like a stack and is reset when the
+                outermost matrix_scratch_context on the thread is destructed, so code
+                that evaluates the same kinds of expressions every iteration (a
+                tracking or rendering loop, say) can wrap each iteration in one of
+                these objects and pay for the temporaries' heap allocations only once.
+
+                If a temporary doesn't fit in the buffer it simply falls back to the
+                heap, and when no matrix_scratch_context is active nothing changes at
+                all.  Therefore, using this object never changes the results of any
+                matrix expression, just where the intermediate values briefly live.
+
+            THREAD SAFETY
+                The buffer is thread local, so each thread that wants scratch backed
+                temporaries must create its own matrix_scratch_context.  Scopes may be
+                nested; the buffer is reset when the outermost one ends.
+        !*/
+
+    public:
+
+        explicit matrix_scratch_context (
+            size_t num_bytes = 1024*1024
+        );
+        /*!
+            ensures
+                - For the lifetime of this object, temporary matrices created during
+                  matrix expression evaluation on the calling thread are allocated from
+                  a thread local buffer of at least num_bytes bytes whenever they fit.
+                - If this is the only matrix_scratch_context on the calling thread then
+                  the buffer is grown to num_bytes bytes if it was smaller.  Nested
+                  scopes reuse the existing buffer and leave its size alone.
+        !*/
+
+        ~matrix_scratch_context (
+        );
+        /*!
+            ensures
+                - If this was the outermost matrix_scratch_context on the calling
+                  thread then the thread's scratch buffer is reset, making its whole
+                  capacity available to the next scope.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_MATRIx_SCRATCH_ARENA_ABSTRACT_
@@ -4,6 +4,8 @@
 #define DLIB_SYMMETRIC_MATRIX_CAcHE_Hh_
 
 #include "symmetric_matrix_cache_abstract.h"
+#include <cstdio>
+#include <memory>
 #include <vector>
 #include "../matrix.h"
 #include "../algs.h"
@@ -17,13 +19,16 @@ namespace dlib
     template <typename M, typename cache_element_type>
     struct op_symm_cache : basic_op_m<M>
     {
-        inline op_symm_cache( 
+        inline op_symm_cache(
             const M& m_,
-            long max_size_megabytes_
-        ) : 
+            long max_size_megabytes_,
+            bool disk_backed_ = false
+        ) :
             basic_op_m<M>(m_),
             max_size_megabytes(max_size_megabytes_),
-            is_initialized(false)
+            is_initialized(false),
+            disk_backed(disk_backed_),
+            spill_end(0)
         {
             lookup.assign(this->m.nr(), -1);
 
@@ -36,7 +41,9 @@ namespace dlib
             basic_op_m<M>(item.m),
             diag_cache(item.diag_cache),
             max_size_megabytes(item.max_size_megabytes),
-            is_initialized(false)
+            is_initialized(false),
+            disk_backed(item.disk_backed),
+            spill_end(0)
         {
             lookup.assign(this->m.nr(), -1);
         }
@@ -46,9 +53,10 @@ namespace dlib
         const static long cost = M::cost + 3;
 
         inline const_ret_type apply ( long r, long c) const
-        { 
+        {
             if (lookup[c] != -1)
             {
+                recently_used[lookup[c]] = true;
                 return cache[lookup[c]](r);
             }
             else if (r == c)
@@ -58,6 +66,7 @@ namespace dlib
             else if (lookup[r] != -1)
             {
                 // the matrix is symmetric so this is legit
+                recently_used[lookup[r]] = true;
                 return cache[lookup[r]](c);
             }
             else
@@ -83,14 +92,9 @@ namespace dlib
 
             // find where this column is in the cache
             long idx = lookup[i];
-            if (idx == next)
-            {
-                // if this column was the next to be replaced
-                // then make sure that doesn't happen
-                next = (next + 1)%cache.size();
-            }
+            recently_used[idx] = true;
 
-            return std::make_pair(&cache[idx](0), &references[idx]); 
+            return std::make_pair(&cache[idx](0), &references[idx]);
         }
 
         const type* diag() const { init(); return &diag_cache(0); }
@@ -132,6 +136,9 @@ namespace dlib
                 cache.set_size(size);
 
                 rlookup.assign(size,-1);
+                recently_used.assign(size,false);
+                if (disk_backed)
+                    spill_offset.assign(this->m.nr(),-1);
                 next = 0;
 
                 is_initialized = true;
@@ -141,33 +148,76 @@ namespace dlib
         void make_sure_next_is_unreferenced (
         ) const
         {
-            if (references[next] != 0)
+            // Advance the clock hand to a column that is neither referenced nor recently
+            // used.  Recently used columns get their use bit cleared and a second chance,
+            // so the column we end up evicting is always one that hasn't been touched for
+            // about a full sweep of the cache (i.e. this approximates LRU eviction).  Two
+            // passes are enough to find such a column unless everything is referenced.
+            for (unsigned long examined = 0; examined < 2*references.size(); ++examined)
             {
-                // find an unreferenced element of the cache
-                unsigned long i;
-                for (i = 1; i < references.size(); ++i)
+                if (references[next] == 0)
                 {
-                    const unsigned long idx = (next+i)%references.size();
-                    if (references[idx] == 0)
-                    {
-                        next = idx;
-                        break;
-                    }
+                    if (!recently_used[next])
+                        return;
+                    recently_used[next] = false;
                 }
+                next = (next + 1)%references.size();
+            }
 
-                // if all elements of the cache are referenced then make the cache bigger
-                // and use the new element.
-                if (references[next] != 0)
-                {
-                    cache.resize(cache.size()+1);
+            // All elements of the cache are referenced so make the cache bigger and use
+            // the new element.
+            cache.resize(cache.size()+1);
 
-                    next = references.size();
-                    references.resize(references.size()+1);
-                    references[next] = 0;
+            next = references.size();
+            references.resize(references.size()+1);
+            references[next] = 0;
+
+            recently_used.push_back(false);
+            rlookup.push_back(-1);
+        }
+
+        void spill_column_to_disk (
+            long c,
+            long idx
+        ) const
+        /*!
+            requires
+                - disk_backed == true
+                - cache[idx] == the cached column c of the matrix
+            ensures
+                - if (column c isn't already stored in the spill file) then
+                    - writes cache[idx] to the spill file so a later cache miss on column
+                      c can read it back instead of recomputing it.
+                - if (the spill file can't be created) then
+                    - #disk_backed == false and misses just recompute columns.
+        !*/
+        {
+            if (spill_offset[c] != -1)
+                return;
 
-                    rlookup.push_back(-1);
+            if (!spill_file)
+            {
+                std::FILE* f = std::tmpfile();
+                if (f == 0)
+                {
+                    // We can't get a temporary file so fall back to recomputing evicted
+                    // columns like the non-disk-backed cache does.
+                    disk_backed = false;
+                    return;
                 }
+                spill_file.reset(f, [](std::FILE* p) { std::fclose(p); });
             }
+
+            const long len = this->m.nr();
+            if (std::fseek(spill_file.get(), spill_end, SEEK_SET) != 0 ||
+                std::fwrite(&cache[idx](0), sizeof(type), len, spill_file.get()) != (size_t)len)
+            {
+                // disk full or similar.  Stop spilling, what is already on disk stays valid.
+                disk_backed = false;
+                return;
+            }
+            spill_offset[c] = spill_end;
+            spill_end += len*sizeof(type);
         }
 
         inline void add_col_to_cache(
@@ -179,14 +229,30 @@ namespace dlib
 
             // if the lookup table is pointing to cache[next] then clear lookup[next]
             if (rlookup[next] != -1)
+            {
+                if (disk_backed)
+                    spill_column_to_disk(rlookup[next], next);
                 lookup[rlookup[next]] = -1;
+            }
 
             // make the lookup table so that it says c is now cached at the spot indicated by next
             lookup[c] = next;
             rlookup[next] = c;
 
-            // compute this column in the matrix and store it in the cache
-            cache[next] = matrix_cast<cache_element_type>(colm(this->m,c));
+            // load this column into the cache, reading it back from the spill file if we
+            // evicted it previously, and computing it from the matrix otherwise.
+            if (spill_offset.size() != 0 && spill_offset[c] != -1 &&
+                std::fseek(spill_file.get(), spill_offset[c], SEEK_SET) == 0)
+            {
+                cache[next].set_size(this->m.nr());
+                if (std::fread(&cache[next](0), sizeof(type), this->m.nr(), spill_file.get()) != (size_t)this->m.nr())
+                    cache[next] = matrix_cast<cache_element_type>(colm(this->m,c));
+            }
+            else
+            {
+                cache[next] = matrix_cast<cache_element_type>(colm(this->m,c));
+            }
+            recently_used[next] = true;
 
             next = (next + 1)%cache.size();
         }
@@ -213,10 +279,21 @@ namespace dlib
                     - lookup[rlookup[x]] == x
                     - cache[x] == the cached column rlookup[x] of the matrix
 
-                - next == the next element in the cache table to use to cache something 
+                - next == the clock hand, i.e. the next element in the cache table to
+                  consider for eviction.
                 - references[i] == the number of outstanding references to cache element cache[i]
-
-                - diag_reference_count == the number of outstanding references to diag_cache. 
+                - recently_used[i] == true if cache element i has been accessed since the
+                  clock hand last swept past it.
+
+                - if (disk_backed) then
+                    - evicted columns are saved to spill_file so they can be read back
+                      instead of recomputed.
+                - if (spill_offset[c] != -1) then
+                    - spill_file != nullptr
+                    - column c is stored in spill_file at offset spill_offset[c]
+                - spill_end == the offset in spill_file where the next spilled column goes
+
+                - diag_reference_count == the number of outstanding references to diag_cache.
                   (this isn't really needed.  It's just here so that we can reuse the matrix
                   expression from colm() to implement diag())
         !*/
@@ -227,10 +304,15 @@ namespace dlib
         matrix<type,0,1,typename M::mem_manager_type> diag_cache;
         mutable std::vector<long> lookup;
         mutable std::vector<long> rlookup;
+        mutable std::vector<bool> recently_used;
         mutable long next;
 
         const long max_size_megabytes;
         mutable bool is_initialized;
+        mutable bool disk_backed;
+        mutable std::shared_ptr<std::FILE> spill_file;
+        mutable std::vector<long> spill_offset;
+        mutable long spill_end;
         mutable long diag_reference_count;
 
     };
@@ -241,23 +323,24 @@ namespace dlib
         >
     const matrix_op<op_symm_cache<EXP,cache_element_type> >  symmetric_matrix_cache (
         const matrix_exp<EXP>& m,
-        long max_size_megabytes
+        long max_size_megabytes,
+        bool disk_backed = false
     )
     {
         // Don't check that m is symmetric since doing so would be extremely onerous for the
         // kinds of matrices intended for use with the symmetric_matrix_cache.  Check everything
         // else though.
-        DLIB_ASSERT(m.size() > 0 && m.nr() == m.nc() && max_size_megabytes >= 0, 
+        DLIB_ASSERT(m.size() > 0 && m.nr() == m.nc() && max_size_megabytes >= 0,
             "\tconst matrix_exp symmetric_matrix_cache(const matrix_exp& m, max_size_megabytes)"
             << "\n\t You have given invalid arguments to this function"
             << "\n\t m.nr():             " << m.nr()
-            << "\n\t m.nc():             " << m.nc() 
-            << "\n\t m.size():           " << m.size() 
-            << "\n\t max_size_megabytes: " << max_size_megabytes 
+            << "\n\t m.nc():             " << m.nc()
+            << "\n\t m.size():           " << m.size()
+            << "\n\t max_size_megabytes: " << max_size_megabytes
             );
 
         typedef op_symm_cache<EXP,cache_element_type> op;
-        return matrix_op<op>(op(m.ref(), max_size_megabytes));
+        return matrix_op<op>(op(m.ref(), max_size_megabytes, disk_backed));
     }
 
 // ----------------------------------------------------------------------------------------
@@ -15,7 +15,8 @@ namespace dlib
         >
     const matrix_exp symmetric_matrix_cache (
         const matrix_exp& m,
-        long max_size_megabytes
+        long max_size_megabytes,
+        bool disk_backed = false
     );
     /*!
         requires
@@ -43,6 +44,18 @@ namespace dlib
                   retrieved from the cache, or if this is not possible, then an entire
                   column of m is loaded into a part of the cache which hasn't been used
                   recently and the needed element returned.
+                - if (disk_backed == true) then
+                    - Whenever a column is evicted from the in-memory cache it is saved
+                      to a temporary file, and a later cache miss on that column reads
+                      it back from the file rather than recomputing it from m.  This is
+                      useful when evaluating a column of m is more expensive than a disk
+                      read, e.g. a kernel_matrix() over a large number of samples, since
+                      it lets problems much bigger than max_size_megabytes run within a
+                      fixed memory budget.  Each distinct column is written at most
+                      once, so the file never exceeds the size of the full matrix.  The
+                      file is deleted when the matrix expression is destructed, and if
+                      it can't be created then the cache quietly falls back to
+                      recomputing evicted columns.
                 - diag(m) is always loaded into the cache and is stored separately from 
                   the cached columns.  That means accesses to the diagonal elements of m
                   are always fast.
@@ -220,7 +220,7 @@ namespace dlib
             HH (c, d, a, b, x[15], S33, 0x1fa27cf8); // 47
             HH (b, c, d, a, x[ 2], S34, 0xc4ac5665); // 48
 
-            // Round 4 
+            // Round 4
             II (a, b, c, d, x[ 0], S41, 0xf4292244); // 49
             II (d, a, b, c, x[ 7], S42, 0x432aff97); // 50
             II (c, d, a, b, x[14], S43, 0xab9423a7); // 51
@@ -239,7 +239,106 @@ namespace dlib
             II (b, c, d, a, x[ 9], S44, 0xeb86d391); // 64
         }
 
-    } 
+    // ------------------------------------------------------------------------------------
+
+        void process_blocks (
+            uint32& a,
+            uint32& b,
+            uint32& c,
+            uint32& d,
+            const unsigned char* data,
+            unsigned long num_blocks
+        )
+        /*!
+            requires
+                - data == pointer to num_blocks*64 bytes
+            ensures
+                - folds the given 64 byte blocks into the a,b,c,d digest state
+        !*/
+        {
+            // an array of 16 words
+            uint32 x[16];
+
+            for (unsigned long i = 0; i < num_blocks; ++i)
+            {
+                // copy a block of 16 words from data into x
+                for (unsigned long j = 0; j < 16; ++j)
+                {
+                    x[j] = (
+                        (static_cast<uint32>(data[4*j + 3]) << 24) |
+                        (static_cast<uint32>(data[4*j + 2]) << 16) |
+                        (static_cast<uint32>(data[4*j + 1]) << 8 ) |
+                        (static_cast<uint32>(data[4*j    ])      )
+                        );
+                }
+
+                uint32 aa = a;
+                uint32 bb = b;
+                uint32 cc = c;
+                uint32 dd = d;
+
+                scramble_block(a,b,c,d,x);
+
+                a = a + aa;
+                b = b + bb;
+                c = c + cc;
+                d = d + dd;
+
+                data += 64;
+            }
+        }
+
+    // ------------------------------------------------------------------------------------
+
+        unsigned long make_final_blocks (
+            unsigned char* temp,
+            const unsigned char* tail,
+            unsigned long tail_size,
+            uint64 total_len
+        )
+        /*!
+            requires
+                - temp == pointer to 128 bytes
+                - tail == pointer to the tail_size bytes left over after taking all
+                  the complete 64 byte blocks out of a message of total_len bytes
+                - tail_size < 64
+            ensures
+                - fills temp with the last of the message followed by the md5
+                  padding and the 64 bit message bit length
+                - returns the number of 64 byte blocks written to temp (1 or 2)
+        !*/
+        {
+            unsigned char* temp2 = temp;
+            for (unsigned long i = 0; i < tail_size; ++i)
+            {
+                *temp2 = tail[i];
+                ++temp2;
+            }
+
+            // apply padding.  If there isn't room for the 8 length bytes after the
+            // mandatory 0x80 byte then pad out to a second block.
+            const unsigned long total = (tail_size < 56) ? 64 : 128;
+            unsigned char* end = temp + total - 8;
+            *temp2 = static_cast<unsigned char>(0x80);
+            ++temp2;
+            while (temp2 != end)
+            {
+                *temp2 = 0;
+                ++temp2;
+            }
+
+            // append the number of bits in the original message
+            const uint64 num_bits = total_len*8;
+            for (unsigned long i = 0; i < 8; ++i)
+            {
+                *temp2 = static_cast<unsigned char>((num_bits>>(8*i))&0xFF);
+                ++temp2;
+            }
+
+            return total/64;
+        }
+
+    }
 
 // ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
@@ -280,111 +379,21 @@ namespace dlib
         using namespace md5_stuff;
 
 
-
-
-        // make a temp version of input with enough space for padding and len appended
-        unsigned long extra_len = 64-len%64;
-        if (extra_len <= 8)
-            extra_len += 64;
-        unsigned char* temp = new unsigned char[extra_len + len];
-
-        // number of 16 word blocks
-        const unsigned long N = (extra_len + len)/64;
-
-        const unsigned char* input2 = input;
-        unsigned char* temp2 = temp;
-        unsigned char* end = temp+len;
-
-        // copy input into temp
-        while (temp2 != end)
-        {
-            *temp2 = *input2;
-            ++temp2;
-            ++input2;
-        }
-
-        // pad temp
-        end += extra_len-8;
-        *temp2 = static_cast<unsigned char>(0x80);
-        ++temp2;
-        while (temp2 != end)
-        {
-            *temp2 = 0;
-            ++temp2;
-        }
-
-        // make len the number of bits in the original message
-        // but first multiply len by 8 and since len is only 32 bits the number might
-        // overflow so we will carry out the multiplication manually and end up with
-        // the result in the base 65536 number with three digits
-        // result = low + high*65536 + upper*65536*65536
-        unsigned long low = len & 0xFFFF;
-        unsigned long high = len >> 16;
-        unsigned long upper;
-        unsigned long tmp;
-        tmp = low * 8;
-        low = tmp & 0xFFFF;
-        tmp = high * 8 + (tmp>>16);
-        high = tmp & 0xFFFF;
-        upper = tmp >> 16;
-        
-
-        // append the length
-        *temp2 = static_cast<unsigned char>(low&0xFF);
-        ++temp2;
-        *temp2 = static_cast<unsigned char>((low>>8)&0xFF);
-        ++temp2;
-        *temp2 = static_cast<unsigned char>((high)&0xFF);
-        ++temp2;
-        *temp2 = static_cast<unsigned char>((high>>8)&0xFF);
-        ++temp2;
-        *temp2 = static_cast<unsigned char>((upper)&0xFF);;
-        ++temp2;
-        *temp2 = static_cast<unsigned char>((upper>>8)&0xFF);;
-        ++temp2;
-        *temp2 = 0;
-        ++temp2;
-        *temp2 = 0;
-        
-
         uint32 a = 0x67452301;
         uint32 b = 0xefcdab89;
         uint32 c = 0x98badcfe;
         uint32 d = 0x10325476;
 
 
-        // an array of 16 words
-        uint32 x[16];
-
-        for (unsigned long i = 0; i < N; ++i)
-        {
-    
-            // copy a block of 16 words from m into x
-            for (unsigned long j = 0; j < 16; ++j)
-            {
-                x[j] = (
-                    (static_cast<uint32>(temp[4*(j + 16*i) + 3]) << 24) |
-                    (static_cast<uint32>(temp[4*(j + 16*i) + 2]) << 16) |
-                    (static_cast<uint32>(temp[4*(j + 16*i) + 1]) << 8 ) |
-                    (static_cast<uint32>(temp[4*(j + 16*i)    ])      )
-                    );               
-            }
-
-            uint32 aa = a;
-            uint32 bb = b;
-            uint32 cc = c;
-            uint32 dd = d;
-
-
-            scramble_block(a,b,c,d,x);
-
+        // feed all the complete 64 byte blocks straight out of the input buffer.
+        // Only the last partial block and the padding ever get staged through a
+        // temporary buffer.
+        const unsigned long num_blocks = len/64;
+        process_blocks(a,b,c,d,input,num_blocks);
 
-            a = a + aa;
-            b = b + bb;
-            c = c + cc;
-            d = d + dd;
-
-        }
+        unsigned char temp[128];
+        const unsigned long num_final = make_final_blocks(temp, input + num_blocks*64, len%64, len);
+        process_blocks(a,b,c,d,temp,num_final);
 
 
         // put a, b, c, and d into output
@@ -407,8 +416,6 @@ namespace dlib
         output[13]  = static_cast<unsigned char>((d>>8) &0xFF);
         output[14]  = static_cast<unsigned char>((d>>16)&0xFF);
         output[15]  = static_cast<unsigned char>((d>>24)&0xFF);
-
-        delete [] temp;
     }
 
 // ----------------------------------------------------------------------------------------
@@ -445,144 +452,41 @@ namespace dlib
         using namespace md5_stuff;
 
 
-                
-
         uint32 a = 0x67452301;
         uint32 b = 0xefcdab89;
         uint32 c = 0x98badcfe;
         uint32 d = 0x10325476;
 
 
+        uint64 len = 0;
 
-        unsigned long len = 0;
-
-        // an array of 16 words
-        uint32 x[16];
-        unsigned char temp[64];
-
+        // Pull big chunks out of the stream at a time rather than one 64 byte
+        // block per sgetn() call.  The buffer is a whole number of blocks so we
+        // only ever have a partial block when we hit the end of the stream.
+        unsigned char buf[4096];
+        unsigned char temp[128];
 
-
-        bool write_length = false;
-        bool at_end = false;
         std::streambuf& inputbuf = *input.rdbuf();
-        while(!at_end)
+        while (true)
         {
-            int num = inputbuf.sgetn(reinterpret_cast<char*>(temp),64);
+            const long num = static_cast<long>(inputbuf.sgetn(reinterpret_cast<char*>(buf),sizeof(buf)));
             len += num;
 
-            // if we hit the end of the stream then pad and add length
-            if (num < 64)
+            if (num == static_cast<long>(sizeof(buf)))
             {
-                at_end = true;
-                unsigned char* temp2 = temp;
-                unsigned char* end;
-                if (num < 56)
-                    end = temp+56;
-                else
-                    end = temp+64;
-
-                temp2 += num;
-
-                // apply padding
-                *temp2 = 0x80;
-                ++temp2;
-                while (temp2 != end)
-                {
-                    *temp2 = 0;
-                    ++temp2;
-                }
-
-
-                if (num < 56)
-                {
-                    write_length = true;
-                    // make len the number of bits in the original message
-                    // but first multiply len by 8 and since len is only 32 bits the number might
-                    // overflow so we will carry out the multiplication manually and end up with
-                    // the result in the base 65536 number with three digits
-                    // result = low + high*65536 + upper*65536*65536
-                    unsigned long low = len & 0xFFFF;
-                    unsigned long high = len >> 16;
-                    unsigned long upper;
-                    unsigned long tmp;
-                    tmp = low * 8;
-                    low = tmp & 0xFFFF;
-                    tmp = high * 8 + (tmp>>16);
-                    high = tmp & 0xFFFF;
-                    upper = tmp >> 16;
-
-
-                    // append the length
-                    *temp2 = static_cast<unsigned char>(low&0xFF);
-                    ++temp2;
-                    *temp2 = static_cast<unsigned char>((low>>8)&0xFF);
-                    ++temp2;
-                    *temp2 = static_cast<unsigned char>((high)&0xFF);
-                    ++temp2;
-                    *temp2 = static_cast<unsigned char>((high>>8)&0xFF);
-                    ++temp2;
-                    *temp2 = static_cast<unsigned char>((upper)&0xFF);;
-                    ++temp2;
-                    *temp2 = static_cast<unsigned char>((upper>>8)&0xFF);;
-                    ++temp2;
-                    *temp2 = 0;
-                    ++temp2;
-                    *temp2 = 0;
-                }
-
-
+                process_blocks(a,b,c,d,buf,sizeof(buf)/64);
             }
-
-
-            // copy a block of 16 words from m into x
-            for (unsigned long i = 0; i < 16; ++i)
+            else
             {
-                x[i] = (
-                    (static_cast<uint32>(temp[4*i + 3]) << 24) |
-                    (static_cast<uint32>(temp[4*i + 2]) << 16) |
-                    (static_cast<uint32>(temp[4*i + 1]) << 8 ) |
-                    (static_cast<uint32>(temp[4*i    ])      )
-                    );               
+                // we hit the end of the stream, so process what is left and then
+                // pad and add the length
+                const unsigned long num_blocks = num/64;
+                process_blocks(a,b,c,d,buf,num_blocks);
+
+                const unsigned long num_final = make_final_blocks(temp, buf + num_blocks*64, num%64, len);
+                process_blocks(a,b,c,d,temp,num_final);
+                break;
             }
-            
-
-            uint32 aa = a;
-            uint32 bb = b;
-            uint32 cc = c;
-            uint32 dd = d;
-
-
-            scramble_block(a,b,c,d,x);
-
-
-            a = a + aa;
-            b = b + bb;
-            c = c + cc;
-            d = d + dd;
-
-        }
-
-        if (!write_length)
-        {
-            uint64 temp = len*8;
-
-            uint32 aa = a;
-            uint32 bb = b;
-            uint32 cc = c;
-            uint32 dd = d;
-
-            std::memset(x, 0, sizeof(x));
-            x[15] = (temp>>32);
-            x[14] = (temp&0xFFFFFFFF);
-
-            scramble_block(a,b,c,d,x);
-
-
-            a = a + aa;
-            b = b + bb;
-            c = c + cc;
-            d = d + dd;
-
         }
 
 
@@ -6,6 +6,7 @@
 #include "../algs.h"
 #include "memory_manager_kernel_abstract.h"
 #include "../assert.h"
+#include "../allocator_stats.h"
 #include <new>
 
 
@@ -95,6 +96,7 @@ namespace dlib
         {
             T* temp = new T[size];
             ++allocations;
+            DLIB_RECORD_SAMPLED_ALLOCATION(temp, size*sizeof(T), "memory_manager::allocate_array");
             return temp;
         }
 
@@ -103,12 +105,13 @@ namespace dlib
         )
         {
             --allocations;
+            DLIB_RECORD_SAMPLED_DEALLOCATION(item);
             delete [] item;
         }
 
         T* allocate (
-        ) 
-        {              
+        )
+        {
             T* temp;
             if (next != 0)
             {
@@ -148,14 +151,16 @@ namespace dlib
             }
 
             ++allocations;
+            DLIB_RECORD_SAMPLED_ALLOCATION(temp, sizeof(T), "memory_manager::allocate");
             return temp;
         }
 
         void deallocate (
             T* item
-        ) 
-        { 
-            --allocations;  
+        )
+        {
+            --allocations;
+            DLIB_RECORD_SAMPLED_DEALLOCATION(item);
             item->~T();
 
             if (pool_size >= max_pool_size)
@@ -240,6 +245,7 @@ namespace dlib
         {
             T* temp = new T[size];
             ++allocations;
+            DLIB_RECORD_SAMPLED_ALLOCATION(temp, size*sizeof(T), "memory_manager::allocate_array");
             return temp;
         }
 
@@ -248,23 +254,26 @@ namespace dlib
         )
         {
             --allocations;
+            DLIB_RECORD_SAMPLED_DEALLOCATION(item);
             delete [] item;
         }
 
         T* allocate (
-        ) 
-        {              
+        )
+        {
             T* temp = new T;
             ++allocations;
+            DLIB_RECORD_SAMPLED_ALLOCATION(temp, sizeof(T), "memory_manager::allocate");
             return temp;
         }
 
         void deallocate (
             T* item
-        ) 
-        { 
+        )
+        {
+            DLIB_RECORD_SAMPLED_DEALLOCATION(item);
             delete item;
-            --allocations;  
+            --allocations;
         }
 
         void swap (
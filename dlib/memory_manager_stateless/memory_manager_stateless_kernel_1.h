@@ -4,6 +4,7 @@
 #define DLIB_MEMORY_MANAGER_STATELESs_1_
 
 #include "memory_manager_stateless_kernel_abstract.h"
+#include "../allocator_stats.h"
 #include <memory>
 
 namespace dlib
@@ -37,27 +38,33 @@ namespace dlib
             T* allocate (
             )
             {
-                return new T; 
+                T* temp = new T;
+                DLIB_RECORD_SAMPLED_ALLOCATION(temp, sizeof(T), "memory_manager_stateless::allocate");
+                return temp;
             }
 
             void deallocate (
                 T* item
             )
             {
+                DLIB_RECORD_SAMPLED_DEALLOCATION(item);
                 delete item;
             }
 
             T* allocate_array (
                 size_t size
-            ) 
-            { 
-                return new T[size];
+            )
+            {
+                T* temp = new T[size];
+                DLIB_RECORD_SAMPLED_ALLOCATION(temp, size*sizeof(T), "memory_manager_stateless::allocate_array");
+                return temp;
             }
 
             void deallocate_array (
                 T* item
-            ) 
-            { 
+            )
+            {
+                DLIB_RECORD_SAMPLED_DEALLOCATION(item);
                 delete [] item;
             }
 
@@ -68,6 +75,8 @@ namespace dlib
                 T* item
             )
             {
+                // ownership leaves this memory manager, so stop tracking the pointer
+                DLIB_RECORD_SAMPLED_DEALLOCATION(item);
                 return std::unique_ptr<T>(item);
             }
 
@@ -75,6 +84,7 @@ namespace dlib
                 T* item
             )
             {
+                DLIB_RECORD_SAMPLED_DEALLOCATION(item);
                 return std::unique_ptr<T[]>(item);
             }
 
@@ -142,9 +142,54 @@ namespace dlib
         double get_momentum (
         ) const { return momentum; }
 
+        struct batch_context
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is the scratch space used by the batched operator().  Letting
+                    the caller own it means repeated batch evaluations reuse the same
+                    layer activation buffers rather than allocating new ones each call.
+            !*/
+            matrix<double> z, tmp1, tmp2;
+        };
+
+        template <typename EXP>
+        void operator() (
+            const matrix_exp<EXP>& in,
+            matrix<double>& out,
+            batch_context& context
+        ) const
+        {
+            const long num = in.nr();
+
+            // Lay one sample out per row with the bias in the last column.  Then each
+            // layer is a single matrix multiply over the whole batch rather than one
+            // matrix-vector multiply per sample.
+            context.z.set_size(num, input_nodes+1);
+            set_subm(context.z, 0, 0, num, input_nodes) = matrix_cast<double>(in);
+            set_colm(context.z, input_nodes) = -1;
+
+            context.tmp1 = sigmoid(context.z*trans(w1));
+            // insert the bias
+            set_colm(context.tmp1, first_hidden_nodes) = -1;
+
+            if (second_hidden_nodes == 0)
+            {
+                out = sigmoid(context.tmp1*trans(w3));
+            }
+            else
+            {
+                context.tmp2 = sigmoid(context.tmp1*trans(w2));
+                // insert the bias
+                set_colm(context.tmp2, second_hidden_nodes) = -1;
+
+                out = sigmoid(context.tmp2*trans(w3));
+            }
+        }
+
         template <typename EXP>
         const matrix<double> operator() (
-            const matrix_exp<EXP>& in 
+            const matrix_exp<EXP>& in
         ) const
         {
             for (long i = 0; i < in.nr(); ++i)
@@ -125,7 +125,7 @@ namespace dlib
 
         template <typename EXP>
         const matrix<double> operator() (
-            const matrix_exp<EXP>& in 
+            const matrix_exp<EXP>& in
         ) const;
         /*!
             requires
@@ -138,6 +138,39 @@ namespace dlib
                   of 0.0 to 1.0
         !*/
 
+        struct batch_context
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is the scratch space used by the batched version of
+                    operator().  It holds the layer activations for a whole batch.
+                    Letting the caller own it means repeated batch evaluations reuse
+                    the same buffers rather than allocating new ones on each call.
+            !*/
+        };
+
+        template <typename EXP>
+        void operator() (
+            const matrix_exp<EXP>& in,
+            matrix<double>& out,
+            batch_context& context
+        ) const;
+        /*!
+            requires
+                - in.nc() == input_layer_nodes()
+                - EXP::type == double
+            ensures
+                - interprets each row of in as one input sample and evaluates the
+                  whole batch at once, computing each layer with a single matrix
+                  multiply rather than one matrix-vector multiply per sample.
+                - #out.nr() == in.nr()
+                - #out.nc() == output_layer_nodes()
+                - for all valid i:
+                    - rowm(#out,i) == trans((*this)(trans(rowm(in,i))))
+                - #context holds the scratch buffers used for the evaluation and can
+                  be reused by later calls to avoid reallocation.
+        !*/
+
         template <typename EXP1, typename EXP2>
         void train (
             const matrix_exp<EXP1>& example_in,
@@ -61,9 +61,29 @@ namespace dlib
         {
         }
 
+        template <typename EXP>
+        void operator() (
+            const matrix_exp<EXP>& in,
+            matrix<double>& out,
+            typename mlp_base::batch_context& context
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_CASSERT(in.nc() == this->input_layer_nodes(),
+                    "\tvoid mlp::operator()(matrix_exp, matrix, batch_context)"
+                    << "\n\tthe input matrix dimensions are not correct"
+                    << "\n\tin.nr():             " << in.nr()
+                    << "\n\tin.nc():             " << in.nc()
+                    << "\n\tinput_layer_nodes(): " << this->input_layer_nodes()
+                    << "\n\tthis:                " << this
+            );
+
+            mlp_base::operator()(in, out, context);
+        }
+
         template <typename EXP>
         const matrix<double> operator() (
-            const matrix_exp<EXP>& in 
+            const matrix_exp<EXP>& in
         ) const
         {
             // make sure requires clause is not broken
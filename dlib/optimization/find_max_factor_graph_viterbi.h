@@ -6,7 +6,6 @@
 #include "find_max_factor_graph_viterbi_abstract.h"
 #include <vector>
 #include "../matrix.h"
-#include "../array2d.h"
 
 
 namespace dlib
@@ -53,174 +52,199 @@ namespace dlib
 
 // ----------------------------------------------------------------------------------------
 
-    template <
-        typename map_problem
-        >
-    void find_max_factor_graph_viterbi (
-        const map_problem& prob,
-        std::vector<unsigned long>& map_assignment
-    )
+    namespace impl
     {
-        using namespace dlib::impl;
-        const unsigned long order = prob.order();
-        const unsigned long num_states = prob.num_states();
-
-
-        DLIB_ASSERT(prob.num_states() > 0,
-            "\t void find_max_factor_graph_viterbi()"
-            << "\n\t The nodes in a factor graph have to be able to take on more than 0 states."
-            );
-        DLIB_ASSERT(std::pow(num_states,(double)order) < std::numeric_limits<unsigned long>::max(),
-            "\t void find_max_factor_graph_viterbi()"
-            << "\n\t The order is way too large for this algorithm to handle."
-            << "\n\t order:      " << order
-            << "\n\t num_states: " << num_states 
-            << "\n\t std::pow(num_states,order):                " << std::pow(num_states,(double)order) 
-            << "\n\t std::numeric_limits<unsigned long>::max(): " << std::numeric_limits<unsigned long>::max() 
-            );
-
-        if (prob.number_of_nodes() == 0)
+        template <
+            typename map_problem
+            >
+        void find_max_factor_graph_viterbi (
+            const map_problem& prob,
+            std::vector<unsigned long>& map_assignment,
+            std::vector<viterbi_data>& trellis
+        )
+        /*!
+            This function is identical to the find_max_factor_graph_viterbi() routine defined
+            below except that the caller supplies the trellis buffer.  Batch decoding loops
+            can hand the same buffer to every call so the DP table lives in one contiguous
+            allocation that is reused from sequence to sequence instead of being reallocated
+            each time.
+        !*/
         {
-            map_assignment.clear();
-            return;
-        }
+            using namespace dlib::impl;
+            const unsigned long order = prob.order();
+            const unsigned long num_states = prob.num_states();
 
-        if (order == 0)
-        {
-            map_assignment.resize(prob.number_of_nodes());
-            for (unsigned long i = 0; i < map_assignment.size(); ++i)
+
+            DLIB_ASSERT(prob.num_states() > 0,
+                "\t void find_max_factor_graph_viterbi()"
+                << "\n\t The nodes in a factor graph have to be able to take on more than 0 states."
+                );
+            DLIB_ASSERT(std::pow(num_states,(double)order) < std::numeric_limits<unsigned long>::max(),
+                "\t void find_max_factor_graph_viterbi()"
+                << "\n\t The order is way too large for this algorithm to handle."
+                << "\n\t order:      " << order
+                << "\n\t num_states: " << num_states 
+                << "\n\t std::pow(num_states,order):                " << std::pow(num_states,(double)order) 
+                << "\n\t std::numeric_limits<unsigned long>::max(): " << std::numeric_limits<unsigned long>::max() 
+                );
+
+            if (prob.number_of_nodes() == 0)
             {
-                matrix<unsigned long,1,1> node_state;
-                unsigned long best_state = 0;
-                double best_val = -std::numeric_limits<double>::infinity();
-                for (unsigned long s = 0; s < num_states; ++s)
+                map_assignment.clear();
+                return;
+            }
+
+            if (order == 0)
+            {
+                map_assignment.resize(prob.number_of_nodes());
+                for (unsigned long i = 0; i < map_assignment.size(); ++i)
                 {
-                    node_state(0) = s;
-                    const double temp = prob.factor_value(i,node_state);
-                    if (temp > best_val)
+                    matrix<unsigned long,1,1> node_state;
+                    unsigned long best_state = 0;
+                    double best_val = -std::numeric_limits<double>::infinity();
+                    for (unsigned long s = 0; s < num_states; ++s)
                     {
-                        best_val = temp;
-                        best_state = s;
+                        node_state(0) = s;
+                        const double temp = prob.factor_value(i,node_state);
+                        if (temp > best_val)
+                        {
+                            best_val = temp;
+                            best_state = s;
+                        }
                     }
+                    map_assignment[i] = best_state;
                 }
-                map_assignment[i] = best_state;
+                return;
             }
-            return;
-        }
 
 
-        const unsigned long trellis_size = static_cast<unsigned long>(std::pow(num_states,(double)order)); 
-        unsigned long init_ring_size = 1; 
+            const unsigned long trellis_size = static_cast<unsigned long>(std::pow(num_states,(double)order)); 
+            unsigned long init_ring_size = 1; 
 
-        array2d<impl::viterbi_data> trellis;
-        trellis.set_size(prob.number_of_nodes(), trellis_size);
+            trellis.assign(prob.number_of_nodes()*trellis_size, viterbi_data());
 
 
-        for (unsigned long node = 0; node < prob.number_of_nodes(); ++node)
-        {
-
-            if (node < order)
+            for (unsigned long node = 0; node < prob.number_of_nodes(); ++node)
             {
-                matrix<unsigned long,1,0> node_states;
-                node_states.set_size(std::min<int>(node, order) + 1);
-                node_states = 0;
 
-                unsigned long idx = 0;
-                if (node == 0)
+                if (node < order)
                 {
-                    do 
+                    matrix<unsigned long,1,0> node_states;
+                    node_states.set_size(std::min<int>(node, order) + 1);
+                    node_states = 0;
+
+                    unsigned long idx = 0;
+                    if (node == 0)
                     {
-                        trellis[node][idx].val = prob.factor_value(node,node_states);
-                        ++idx;
-                    } while(advance_state(node_states,num_states));
+                        do 
+                        {
+                            trellis[node*trellis_size + idx].val = prob.factor_value(node,node_states);
+                            ++idx;
+                        } while(advance_state(node_states,num_states));
+                    }
+                    else
+                    {
+                        init_ring_size *= num_states;
+                        do 
+                        {
+                            const unsigned long back_index = idx%init_ring_size;
+                            trellis[node*trellis_size + idx].val = prob.factor_value(node,node_states) + trellis[(node-1)*trellis_size + back_index].val;
+                            trellis[node*trellis_size + idx].back_index = back_index;
+                            ++idx;
+                        } while(advance_state(node_states,num_states));
+
+                    }
                 }
-                else
+                else if (order == 1)
                 {
-                    init_ring_size *= num_states;
-                    do 
-                    {
-                        const unsigned long back_index = idx%init_ring_size;
-                        trellis[node][idx].val = prob.factor_value(node,node_states) + trellis[node-1][back_index].val;
-                        trellis[node][idx].back_index = back_index;
-                        ++idx;
-                    } while(advance_state(node_states,num_states));
+                    /*
+                        WHAT'S THE DEAL WITH THIS PREPROCESSOR MACRO?
+                            Well, if we can declare the dimensions of node_states as a compile
+                            time constant then this function runs significantly faster.  So this macro
+                            is here to let us do that.  It just lets us avoid replicating this code
+                            block in the following if statements for different order sizes.
+                    */
+#define DLIB_FMFGV_WORK                                                                                                   \
+                    node_states = 0;                                                                                            \
+                    unsigned long count = 0;                                                                                    \
+                    for (unsigned long i = 0; i < trellis_size; ++i)                                                            \
+                    {                                                                                                           \
+                        unsigned long back_index = 0;                                                                           \
+                        double best_score = -std::numeric_limits<double>::infinity();                                           \
+                        for (unsigned long s = 0; s < num_states; ++s)                                                          \
+                        {                                                                                                       \
+                            const double temp = prob.factor_value(node,node_states) + trellis[(node-1)*trellis_size + count%trellis_size].val;  \
+                            if (temp > best_score)                                                                              \
+                            {                                                                                                   \
+                                best_score = temp;                                                                              \
+                                back_index = count%trellis_size;                                                                \
+                            }                                                                                                   \
+                            advance_state(node_states,num_states);                                                              \
+                            ++count;                                                                                            \
+                        }                                                                                                       \
+                        trellis[node*trellis_size + i].val = best_score;                                                                      \
+                        trellis[node*trellis_size + i].back_index = back_index;                                                               \
+                    }
 
+                    matrix<unsigned long,1,2> node_states;
+                    DLIB_FMFGV_WORK
                 }
-            }
-            else if (order == 1)
-            {
-                /*
-                    WHAT'S THE DEAL WITH THIS PREPROCESSOR MACRO?
-                        Well, if we can declare the dimensions of node_states as a compile
-                        time constant then this function runs significantly faster.  So this macro
-                        is here to let us do that.  It just lets us avoid replicating this code
-                        block in the following if statements for different order sizes.
-                */
-#define DLIB_FMFGV_WORK                                                                                                     \
-                node_states = 0;                                                                                            \
-                unsigned long count = 0;                                                                                    \
-                for (unsigned long i = 0; i < trellis_size; ++i)                                                            \
-                {                                                                                                           \
-                    unsigned long back_index = 0;                                                                           \
-                    double best_score = -std::numeric_limits<double>::infinity();                                           \
-                    for (unsigned long s = 0; s < num_states; ++s)                                                          \
-                    {                                                                                                       \
-                        const double temp = prob.factor_value(node,node_states) + trellis[node-1][count%trellis_size].val;  \
-                        if (temp > best_score)                                                                              \
-                        {                                                                                                   \
-                            best_score = temp;                                                                              \
-                            back_index = count%trellis_size;                                                                \
-                        }                                                                                                   \
-                        advance_state(node_states,num_states);                                                              \
-                        ++count;                                                                                            \
-                    }                                                                                                       \
-                    trellis[node][i].val = best_score;                                                                      \
-                    trellis[node][i].back_index = back_index;                                                               \
+                else if (order == 2)
+                {
+                    matrix<unsigned long,1,3> node_states;
+                    DLIB_FMFGV_WORK
+                }
+                else if (order == 3)
+                {
+                    matrix<unsigned long,1,4> node_states;
+                    DLIB_FMFGV_WORK
+                }
+                else 
+                {
+                    // The general case, here we don't define the size of node_states at compile time.
+                    matrix<unsigned long,1,0> node_states(order+1);
+                    DLIB_FMFGV_WORK
                 }
-
-                matrix<unsigned long,1,2> node_states;
-                DLIB_FMFGV_WORK
-            }
-            else if (order == 2)
-            {
-                matrix<unsigned long,1,3> node_states;
-                DLIB_FMFGV_WORK
             }
-            else if (order == 3)
+
+
+            map_assignment.resize(prob.number_of_nodes());
+            // Figure out which state of the last node has the biggest value. 
+            unsigned long back_index = 0;
+            double best_val = -std::numeric_limits<double>::infinity();
+            const unsigned long last = prob.number_of_nodes()-1;
+            for (unsigned long i = 0; i < trellis_size; ++i)
             {
-                matrix<unsigned long,1,4> node_states;
-                DLIB_FMFGV_WORK
+                if (trellis[last*trellis_size + i].val > best_val)
+                {
+                    best_val = trellis[last*trellis_size + i].val;
+                    back_index = i;
+                }
             }
-            else 
+            // Follow the back links to find the decoding.
+            for (long node = map_assignment.size()-1; node >= 0; --node)
             {
-                // The general case, here we don't define the size of node_states at compile time.
-                matrix<unsigned long,1,0> node_states(order+1);
-                DLIB_FMFGV_WORK
+                map_assignment[node] = back_index/init_ring_size;
+                back_index = trellis[node*trellis_size + back_index].back_index;
+                if (node < (long)order)
+                    init_ring_size /= num_states;
             }
-        }
 
-
-        map_assignment.resize(prob.number_of_nodes());
-        // Figure out which state of the last node has the biggest value. 
-        unsigned long back_index = 0;
-        double best_val = -std::numeric_limits<double>::infinity();
-        for (long i = 0; i < trellis.nc(); ++i)
-        {
-            if (trellis[trellis.nr()-1][i].val > best_val)
-            {
-                best_val = trellis[trellis.nr()-1][i].val;
-                back_index = i;
-            }
-        }
-        // Follow the back links to find the decoding.
-        for (long node = map_assignment.size()-1; node >= 0; --node)
-        {
-            map_assignment[node] = back_index/init_ring_size;
-            back_index = trellis[node][back_index].back_index;
-            if (node < (long)order)
-                init_ring_size /= num_states;
         }
+    }
+
+// ----------------------------------------------------------------------------------------
 
+    template <
+        typename map_problem
+        >
+    void find_max_factor_graph_viterbi (
+        const map_problem& prob,
+        std::vector<unsigned long>& map_assignment
+    )
+    {
+        std::vector<impl::viterbi_data> trellis;
+        impl::find_max_factor_graph_viterbi(prob, map_assignment, trellis);
     }
 
 // ----------------------------------------------------------------------------------------
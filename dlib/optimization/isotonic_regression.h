@@ -4,12 +4,34 @@
 #define DLIB_ISOTONIC_ReGRESSION_H_
 
 #include "isotonic_regression_abstract.h"
+#include "../algs.h"
 #include <vector>
 #include <utility>
 #include <cstddef>
+#include <algorithm>
 
 namespace dlib
 {
+    namespace impl
+    {
+        struct isotonic_block
+        {
+            isotonic_block(double val) : num(1), avg(val) {}
+            isotonic_block(size_t n, double val) : num(n), avg(val) {}
+
+            size_t num;
+            double avg;
+
+            inline isotonic_block operator+(const isotonic_block& rhs) const
+            {
+                return isotonic_block(num+rhs.num,
+                    (num*avg + rhs.num*rhs.avg)/(num+rhs.num));
+            }
+        };
+    }
+
+// ----------------------------------------------------------------------------------------
+
     class isotonic_regression
     {
     public:
@@ -143,25 +165,178 @@ namespace dlib
 
 
 
-        struct block_t
+        typedef impl::isotonic_block block_t;
+
+        inline block_t& prev_block() { return blocks[blocks.size()-2]; }
+        inline block_t& current_block() { return blocks.back(); }
+
+        std::vector<block_t> blocks;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    class running_isotonic_regression
+    {
+    public:
+
+        void clear (
+        )
         {
-            block_t(double val) : num(1), avg(val) {}
-            block_t(size_t n, double val) : num(n), avg(val) {}
+            values.clear();
+            blocks.clear();
+        }
 
-            size_t num;
-            double avg;
+        size_t size (
+        ) const { return values.size(); }
 
-            inline block_t operator+(const block_t& rhs) const
+        void insert (
+            size_t idx,
+            double val
+        )
+        {
+            DLIB_ASSERT(idx <= size(),
+                "\t void running_isotonic_regression::insert(idx,val)"
+                << "\n\t idx:    " << idx
+                << "\n\t size(): " << size()
+                );
+
+            values.insert(values.begin()+idx, val);
+            refit(idx);
+        }
+
+        void add (
+            double val
+        ) { insert(size(), val); }
+
+        void remove (
+            size_t idx
+        )
+        {
+            DLIB_ASSERT(idx < size(),
+                "\t void running_isotonic_regression::remove(idx)"
+                << "\n\t idx:    " << idx
+                << "\n\t size(): " << size()
+                );
+
+            values.erase(values.begin()+idx);
+            refit(idx);
+        }
+
+        double raw_value (
+            size_t idx
+        ) const
+        {
+            DLIB_ASSERT(idx < size(),
+                "\t double running_isotonic_regression::raw_value(idx)"
+                << "\n\t idx:    " << idx
+                << "\n\t size(): " << size()
+                );
+
+            return values[idx];
+        }
+
+        double fitted_value (
+            size_t idx
+        ) const
+        {
+            DLIB_ASSERT(idx < size(),
+                "\t double running_isotonic_regression::fitted_value(idx)"
+                << "\n\t idx:    " << idx
+                << "\n\t size(): " << size()
+                );
+
+            size_t start = 0;
+            for (auto& block : blocks)
             {
-                return block_t(num+rhs.num,
-                    (num*avg + rhs.num*rhs.avg)/(num+rhs.num));
+                if (idx < start + block.num)
+                    return block.avg;
+                start += block.num;
             }
-        };
+            // can't get here because the blocks always cover all the values
+            return blocks.back().avg;
+        }
 
-        inline block_t& prev_block() { return blocks[blocks.size()-2]; }
-        inline block_t& current_block() { return blocks.back(); }
+        void get_fitted_values (
+            std::vector<double>& out
+        ) const
+        {
+            out.clear();
+            out.reserve(values.size());
+            for (auto& block : blocks)
+                out.insert(out.end(), block.num, block.avg);
+        }
+
+    private:
+
+        typedef impl::isotonic_block block_t;
+
+        void refit (
+            size_t idx
+        )
+        {
+            /*
+                This is the pool adjacent violators algorithm again, but restarted in
+                the middle.  Two facts about PAV make that possible.  First, no merge
+                ever crosses a boundary of the final block partition, so the blocks in
+                front of the one containing idx are exactly the stack the left-to-right
+                pass had when it reached that block, and we can resume from there.
+                Second, a block's average only decreases as it absorbs blocks to its
+                right, so once the resumed pass lines up with an old block boundary and
+                the top of the stack doesn't exceed that old block's average, no merge
+                can reach backwards across it and all the remaining old blocks can be
+                reused as is.
+            */
+
+            // Find the block containing idx, keeping track of where it starts and how
+            // many values the old partition covered.
+            size_t bidx = 0;
+            size_t start = 0;
+            while (bidx < blocks.size() && start + blocks[bidx].num <= idx)
+            {
+                start += blocks[bidx].num;
+                ++bidx;
+            }
+            size_t old_total = start;
+            for (size_t i = bidx; i < blocks.size(); ++i)
+                old_total += blocks[i].num;
+
+            // where the first reusable old block begins in the updated values array
+            const long shift = (long)values.size() - (long)old_total;
+            size_t tail_pos = 0;
+            if (bidx < blocks.size())
+                tail_pos = start + blocks[bidx].num + shift;
+
+            old_tail.assign(blocks.begin() + std::min(bidx+1, blocks.size()), blocks.end());
+            blocks.erase(blocks.begin()+bidx, blocks.end());
+
+            size_t tail_i = 0;
+            for (size_t p = start; p < values.size(); ++p)
+            {
+                while (tail_i < old_tail.size() && tail_pos < p)
+                {
+                    tail_pos += old_tail[tail_i].num;
+                    ++tail_i;
+                }
+                if (tail_i < old_tail.size() && tail_pos == p &&
+                    (blocks.empty() || blocks.back().avg <= old_tail[tail_i].avg))
+                {
+                    blocks.insert(blocks.end(), old_tail.begin()+tail_i, old_tail.end());
+                    return;
+                }
+
+                blocks.emplace_back(values[p]);
+                while (blocks.size() > 1 && blocks[blocks.size()-2].avg > blocks.back().avg)
+                {
+                    // merge the last two blocks.
+                    blocks[blocks.size()-2] = blocks[blocks.size()-2] + blocks.back();
+                    blocks.pop_back();
+                }
+            }
+        }
 
+        std::vector<double> values;
         std::vector<block_t> blocks;
+        std::vector<block_t> old_tail;
     };
 }
 
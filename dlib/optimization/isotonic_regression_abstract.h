@@ -120,6 +120,115 @@ namespace dlib
         !*/
 
     };
+
+// ----------------------------------------------------------------------------------------
+
+    class running_isotonic_regression
+    {
+        /*!
+            INITIAL VALUE
+                - size() == 0
+
+            WHAT THIS OBJECT REPRESENTS
+                This object performs the same 1-D isotonic regression as
+                isotonic_regression, but it keeps the sequence of values and the fitted
+                step function inside itself so that individual values can be inserted
+                and removed without refitting everything.  An edit only refits the part
+                of the step function it can actually influence, which for localized
+                edits is typically a small neighborhood of the edit rather than the
+                whole sequence.  This is useful for things like streaming score
+                calibration over a sliding window, where each update changes only a few
+                of many thousands of values.
+
+                At all times, the fitted values are exactly what
+                isotonic_regression would produce if run on the current sequence of
+                raw values.
+        !*/
+
+    public:
+
+        void clear (
+        );
+        /*!
+            ensures
+                - #size() == 0
+        !*/
+
+        size_t size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of values in the sequence.
+        !*/
+
+        void insert (
+            size_t idx,
+            double val
+        );
+        /*!
+            requires
+                - idx <= size()
+            ensures
+                - #size() == size() + 1
+                - #raw_value(idx) == val
+                - values at positions >= idx shift one position to the right.
+                - the fitted step function is updated accordingly.
+        !*/
+
+        void add (
+            double val
+        );
+        /*!
+            ensures
+                - performs insert(size(), val)
+        !*/
+
+        void remove (
+            size_t idx
+        );
+        /*!
+            requires
+                - idx < size()
+            ensures
+                - #size() == size() - 1
+                - the value at position idx is removed from the sequence and values at
+                  positions > idx shift one position to the left.
+                - the fitted step function is updated accordingly.
+        !*/
+
+        double raw_value (
+            size_t idx
+        ) const;
+        /*!
+            requires
+                - idx < size()
+            ensures
+                - returns the value at position idx of the sequence, as given to
+                  insert() or add().
+        !*/
+
+        double fitted_value (
+            size_t idx
+        ) const;
+        /*!
+            requires
+                - idx < size()
+            ensures
+                - returns the isotonic regression output at position idx.  That is,
+                  running isotonic_regression on the raw values and looking at element
+                  idx of its output would give exactly this value.
+        !*/
+
+        void get_fitted_values (
+            std::vector<double>& out
+        ) const;
+        /*!
+            ensures
+                - #out.size() == size()
+                - for all valid i: #out[i] == fitted_value(i)
+        !*/
+
+    };
 }
 
 #endif // DLIB_ISOTONIC_ReGRESSION_ABSTRACT_H_
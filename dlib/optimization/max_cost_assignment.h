@@ -5,6 +5,8 @@
 
 #include "max_cost_assignment_abstract.h"
 #include "../matrix.h"
+#include "../threads/thread_pool_extension.h"
+#include "../threads/parallel_for_extension.h"
 #include <vector>
 #include <deque>
 
@@ -73,210 +75,320 @@ namespace dlib
 
 // ----------------------------------------------------------------------------------------
 
-    template <typename EXP>
-    std::vector<long> max_cost_assignment (
-        const matrix_exp<EXP>& cost_
-    )                         
+    template <typename type>
+    class max_cost_assignment_solver
     {
-        const_temp_matrix<EXP> cost(cost_);
-        typedef typename EXP::type type;
-        // This algorithm only works if the elements of the cost matrix can be reliably 
-        // compared using operator==. However, comparing for equality with floating point
-        // numbers is not a stable operation. So you need to use an integer cost matrix.
-        COMPILE_TIME_ASSERT(std::numeric_limits<type>::is_integer);
-        DLIB_ASSERT(cost.nr() == cost.nc(),
-            "\t std::vector<long> max_cost_assignment(cost)"
-            << "\n\t cost.nr(): " << cost.nr()
-            << "\n\t cost.nc(): " << cost.nc()
-            );
+        /*!
+            CONVENTION
+                - All the member vectors are just the working arrays of the Hungarian
+                  algorithm.  They hold whatever was left over from the last call to
+                  operator() and exist only so repeated solves can reuse their heap
+                  allocations instead of allocating fresh ones each time.
+                - xy holds the assignment returned by the last call to operator().
+                - ly holds the column dual variables from the last solve.  They are
+                  only read again if the user asks for a warm started solve.
+        !*/
+    public:
 
-        using namespace dlib::impl;
-        /*
-            I based the implementation of this algorithm on the description of the
-            Hungarian algorithm on the following websites:
-                http://www.math.uwo.ca/~mdawes/courses/344/kuhn-munkres.pdf
-                http://www.topcoder.com/tc?module=Static&d1=tutorials&d2=hungarianAlgorithm
+        template <typename EXP>
+        const std::vector<long>& operator() (
+            const matrix_exp<EXP>& cost_
+        )
+        {
+            return solve(cost_, false);
+        }
 
-            Note that this is the fast O(n^3) version of the algorithm.
-        */
+        template <typename EXP>
+        const std::vector<long>& solve_warm_started (
+            const matrix_exp<EXP>& cost_
+        )
+        {
+            return solve(cost_, true);
+        }
 
-        if (cost.size() == 0)
-            return std::vector<long>();
+    private:
 
-        std::vector<type> lx, ly;
-        std::vector<long> xy;
-        std::vector<long> yx;
-        std::vector<char> S, T;
-        std::vector<type> slack;
-        std::vector<long> slackx;
-        std::vector<long> aug_path;
+        template <typename EXP>
+        const std::vector<long>& solve (
+            const matrix_exp<EXP>& cost_,
+            const bool warm_start
+        )
+        {
+            const_temp_matrix<EXP> cost(cost_);
+            // This algorithm only works if the elements of the cost matrix can be reliably
+            // compared using operator==. However, comparing for equality with floating point
+            // numbers is not a stable operation. So you need to use an integer cost matrix.
+            COMPILE_TIME_ASSERT(std::numeric_limits<type>::is_integer);
+            COMPILE_TIME_ASSERT((is_same_type<typename EXP::type,type>::value));
+            DLIB_ASSERT(cost.nr() == cost.nc(),
+                "\t const std::vector<long>& max_cost_assignment_solver::operator()(cost)"
+                << "\n\t cost.nr(): " << cost.nr()
+                << "\n\t cost.nc(): " << cost.nc()
+                );
 
+            using namespace dlib::impl;
+            /*
+                I based the implementation of this algorithm on the description of the
+                Hungarian algorithm on the following websites:
+                    http://www.math.uwo.ca/~mdawes/courses/344/kuhn-munkres.pdf
+                    http://www.topcoder.com/tc?module=Static&d1=tutorials&d2=hungarianAlgorithm
 
+                Note that this is the fast O(n^3) version of the algorithm.
+            */
 
+            if (cost.size() == 0)
+            {
+                xy.clear();
+                return xy;
+            }
 
-        // Initially, nothing is matched. 
-        xy.assign(cost.nc(), -1);
-        yx.assign(cost.nc(), -1);
-        /*
-            We maintain the following invariant:
-                Vertex x is matched to vertex xy[x] and
-                vertex y is matched to vertex yx[y].
+            // Initially, nothing is matched.
+            xy.assign(cost.nc(), -1);
+            yx.assign(cost.nc(), -1);
+            /*
+                We maintain the following invariant:
+                    Vertex x is matched to vertex xy[x] and
+                    vertex y is matched to vertex yx[y].
 
-                A value of -1 means a vertex isn't matched to anything.  Moreover,
-                x corresponds to rows of the cost matrix and y corresponds to the
-                columns of the cost matrix.  So we are matching X to Y.
-        */
+                    A value of -1 means a vertex isn't matched to anything.  Moreover,
+                    x corresponds to rows of the cost matrix and y corresponds to the
+                    columns of the cost matrix.  So we are matching X to Y.
+            */
 
 
-        // Create an initial feasible labeling.  Moreover, in the following
-        // code we will always have: 
-        //     for all valid x and y:  lx[x] + ly[y] >= cost(x,y)
-        lx.resize(cost.nc());
-        ly.assign(cost.nc(),0);
-        for (long x = 0; x < cost.nr(); ++x)
-            lx[x] = max(rowm(cost,x));
+            // Create an initial feasible labeling.  Moreover, in the following
+            // code we will always have:
+            //     for all valid x and y:  lx[x] + ly[y] >= cost(x,y)
+            // When warm starting we keep the column duals from the previous solve,
+            // since for a similar cost matrix they are already close to optimal and
+            // fewer labeling updates will be needed.  Any ly gives a feasible
+            // labeling once lx is recomputed against it, so this doesn't change the
+            // solution, just how fast we get there.
+            lx.resize(cost.nc());
+            if (warm_start && ly.size() == static_cast<unsigned long>(cost.nc()))
+            {
+                // Recompute lx against the retained ly.  The guard against ly[y]
+                // exceeding cost(x,y) keeps this safe for unsigned cost types; the
+                // resulting lx is never smaller than required so the labeling stays
+                // feasible either way.
+                for (long x = 0; x < cost.nr(); ++x)
+                {
+                    type m = 0;
+                    for (long y = 0; y < cost.nc(); ++y)
+                    {
+                        if (cost(x,y) > ly[y])
+                            m = std::max<type>(m, static_cast<type>(cost(x,y) - ly[y]));
+                    }
+                    lx[x] = m;
+                }
+            }
+            else
+            {
+                ly.assign(cost.nc(),0);
+                for (long x = 0; x < cost.nr(); ++x)
+                    lx[x] = max(rowm(cost,x));
+            }
 
-        // Now grow the match set by picking edges from the equality subgraph until
-        // we have a complete matching.
-        for (long match_size = 0; match_size < cost.nc(); ++match_size)
-        {
-            std::deque<long> q;
+            // Now grow the match set by picking edges from the equality subgraph until
+            // we have a complete matching.
+            for (long match_size = 0; match_size < cost.nc(); ++match_size)
+            {
+                q.clear();
 
-            // Empty out the S and T sets
-            S.assign(cost.nc(), false);
-            T.assign(cost.nc(), false);
+                // Empty out the S and T sets
+                S.assign(cost.nc(), false);
+                T.assign(cost.nc(), false);
 
-            // clear out old slack values
-            slack.assign(cost.nc(), std::numeric_limits<type>::max());
-            slackx.resize(cost.nc());
-            /*
-                slack and slackx are maintained such that we always
-                have the following (once they get initialized by compute_slack() below):
-                    - for all y:
-                        - let x == slackx[y]
-                        - slack[y] == lx[x] + ly[y] - cost(x,y)
-            */
+                // clear out old slack values
+                slack.assign(cost.nc(), std::numeric_limits<type>::max());
+                slackx.resize(cost.nc());
+                /*
+                    slack and slackx are maintained such that we always
+                    have the following (once they get initialized by compute_slack() below):
+                        - for all y:
+                            - let x == slackx[y]
+                            - slack[y] == lx[x] + ly[y] - cost(x,y)
+                */
 
-            aug_path.assign(cost.nc(), -1);
+                aug_path.assign(cost.nc(), -1);
 
-            for (long x = 0; x < cost.nc(); ++x)
-            {
-                // If x is not matched to anything
-                if (xy[x] == -1)
+                for (long x = 0; x < cost.nc(); ++x)
                 {
-                    q.push_back(x);
-                    S[x] = true;
+                    // If x is not matched to anything
+                    if (xy[x] == -1)
+                    {
+                        q.push_back(x);
+                        S[x] = true;
 
-                    compute_slack(x, slack, slackx, cost, lx, ly);
-                    break;
+                        compute_slack(x, slack, slackx, cost, lx, ly);
+                        break;
+                    }
                 }
-            }
 
 
-            long x_start = 0;
-            long y_start = 0;
+                long x_start = 0;
+                long y_start = 0;
 
-            // Find an augmenting path.  
-            bool found_augmenting_path = false;
-            while (!found_augmenting_path)
-            {
-                while (q.size() > 0 && !found_augmenting_path)
+                // Find an augmenting path.
+                bool found_augmenting_path = false;
+                while (!found_augmenting_path)
                 {
-                    const long x = q.front();
-                    q.pop_front();
-                    for (long y = 0; y < cost.nc(); ++y)
+                    while (q.size() > 0 && !found_augmenting_path)
                     {
-                        if (cost(x,y) == lx[x] + ly[y] && !T[y])
+                        const long x = q.front();
+                        q.pop_front();
+                        for (long y = 0; y < cost.nc(); ++y)
                         {
-                            // if vertex y isn't matched with anything
-                            if (yx[y] == -1) 
+                            if (cost(x,y) == lx[x] + ly[y] && !T[y])
                             {
-                                y_start = y;
-                                x_start = x;
-                                found_augmenting_path = true;
-                                break;
-                            }
-
-                            T[y] = true;
-                            q.push_back(yx[y]);
+                                // if vertex y isn't matched with anything
+                                if (yx[y] == -1)
+                                {
+                                    y_start = y;
+                                    x_start = x;
+                                    found_augmenting_path = true;
+                                    break;
+                                }
+
+                                T[y] = true;
+                                q.push_back(yx[y]);
 
-                            aug_path[yx[y]] = x;
-                            S[yx[y]] = true;
-                            compute_slack(yx[y], slack, slackx, cost, lx, ly);
+                                aug_path[yx[y]] = x;
+                                S[yx[y]] = true;
+                                compute_slack(yx[y], slack, slackx, cost, lx, ly);
+                            }
                         }
                     }
-                }
 
-                if (found_augmenting_path)
-                    break;
+                    if (found_augmenting_path)
+                        break;
 
 
-                // Since we didn't find an augmenting path we need to improve the 
-                // feasible labeling stored in lx and ly.  We also need to keep the
-                // slack updated accordingly.
-                type delta = std::numeric_limits<type>::max();
-                for (unsigned long i = 0; i < T.size(); ++i)
-                {
-                    if (!T[i])
-                        delta = std::min(delta, slack[i]);
-                }
-                for (unsigned long i = 0; i < T.size(); ++i)
-                {
-                    if (S[i])
-                        lx[i] -= delta;
+                    // Since we didn't find an augmenting path we need to improve the
+                    // feasible labeling stored in lx and ly.  We also need to keep the
+                    // slack updated accordingly.
+                    type delta = std::numeric_limits<type>::max();
+                    for (unsigned long i = 0; i < T.size(); ++i)
+                    {
+                        if (!T[i])
+                            delta = std::min(delta, slack[i]);
+                    }
+                    for (unsigned long i = 0; i < T.size(); ++i)
+                    {
+                        if (S[i])
+                            lx[i] -= delta;
 
-                    if (T[i])
-                        ly[i] += delta;
-                    else
-                        slack[i] -= delta;
-                }
+                        if (T[i])
+                            ly[i] += delta;
+                        else
+                            slack[i] -= delta;
+                    }
 
 
 
-                q.clear();
-                for (long y = 0; y < cost.nc(); ++y)
-                {
-                    if (!T[y] && slack[y] == 0)
+                    q.clear();
+                    for (long y = 0; y < cost.nc(); ++y)
                     {
-                        // if vertex y isn't matched with anything
-                        if (yx[y] == -1)
-                        {
-                            x_start = slackx[y];
-                            y_start = y;
-                            found_augmenting_path = true;
-                            break;
-                        }
-                        else
+                        if (!T[y] && slack[y] == 0)
                         {
-                            T[y] = true;
-                            if (!S[yx[y]])
+                            // if vertex y isn't matched with anything
+                            if (yx[y] == -1)
                             {
-                                q.push_back(yx[y]);
-
-                                aug_path[yx[y]] = slackx[y];
-                                S[yx[y]] = true;
-                                compute_slack(yx[y], slack, slackx, cost, lx, ly);
+                                x_start = slackx[y];
+                                y_start = y;
+                                found_augmenting_path = true;
+                                break;
+                            }
+                            else
+                            {
+                                T[y] = true;
+                                if (!S[yx[y]])
+                                {
+                                    q.push_back(yx[y]);
+
+                                    aug_path[yx[y]] = slackx[y];
+                                    S[yx[y]] = true;
+                                    compute_slack(yx[y], slack, slackx, cost, lx, ly);
+                                }
                             }
                         }
                     }
+                } // end while (!found_augmenting_path)
+
+                // Flip the edges along the augmenting path.  This means we will add one more
+                // item to our matching.
+                for (long cx = x_start, cy = y_start, ty;
+                     cx != -1;
+                     cx = aug_path[cx], cy = ty)
+                {
+                    ty = xy[cx];
+                    yx[cy] = cx;
+                    xy[cx] = cy;
                 }
-            } // end while (!found_augmenting_path)
 
-            // Flip the edges along the augmenting path.  This means we will add one more
-            // item to our matching.
-            for (long cx = x_start, cy = y_start, ty; 
-                 cx != -1; 
-                 cx = aug_path[cx], cy = ty)
-            {
-                ty = xy[cx];
-                yx[cy] = cx;
-                xy[cx] = cy;
             }
 
+
+            return xy;
         }
 
+        std::vector<type> lx, ly;
+        std::vector<long> xy;
+        std::vector<long> yx;
+        std::vector<char> S, T;
+        std::vector<type> slack;
+        std::vector<long> slackx;
+        std::vector<long> aug_path;
+        std::deque<long> q;
+    };
+
+// ----------------------------------------------------------------------------------------
 
-        return xy;
+    template <typename EXP>
+    std::vector<long> max_cost_assignment (
+        const matrix_exp<EXP>& cost
+    )
+    {
+        DLIB_ASSERT(cost.nr() == cost.nc(),
+            "\t std::vector<long> max_cost_assignment(cost)"
+            << "\n\t cost.nr(): " << cost.nr()
+            << "\n\t cost.nc(): " << cost.nc()
+            );
+
+        max_cost_assignment_solver<typename EXP::type> solver;
+        return solver(cost);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T, long NR, long NC, typename MM, typename L>
+    void max_cost_assignment (
+        thread_pool& tp,
+        const std::vector<matrix<T,NR,NC,MM,L> >& costs,
+        std::vector<std::vector<long> >& assignments
+    )
+    {
+#ifdef ENABLE_ASSERTS
+        for (unsigned long i = 0; i < costs.size(); ++i)
+        {
+            DLIB_ASSERT(costs[i].nr() == costs[i].nc(),
+                "\t void max_cost_assignment(tp,costs,assignments)"
+                << "\n\t i:             " << i
+                << "\n\t costs[i].nr(): " << costs[i].nr()
+                << "\n\t costs[i].nc(): " << costs[i].nc()
+                );
+        }
+#endif
+
+        assignments.resize(costs.size());
+        // Each block of problems shares one solver so its working arrays get reused
+        // from solve to solve rather than reallocated.
+        parallel_for_blocked(tp, 0, (long)costs.size(), [&](long begin, long end)
+        {
+            max_cost_assignment_solver<T> solver;
+            for (long i = begin; i < end; ++i)
+                assignments[i] = solver(costs[i]);
+        });
     }
 
 // ----------------------------------------------------------------------------------------
@@ -4,6 +4,7 @@
 #ifdef DLIB_MAX_COST_ASSIgNMENT_ABSTRACT_Hh_
 
 #include "../matrix.h"
+#include "../threads/thread_pool_extension_abstract.h"
 #include <vector>
 
 namespace dlib
@@ -51,10 +52,89 @@ namespace dlib
                       elements of A which are equal.  
                     - A.size() == cost.nr()
 
-            - This function implements the O(N^3) version of the Hungarian algorithm 
+            - This function implements the O(N^3) version of the Hungarian algorithm
               where N is the number of rows in the cost matrix.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <typename type>
+    class max_cost_assignment_solver
+    {
+        /*!
+            REQUIREMENTS ON type
+                type must be some integer type (e.g. int)
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is simply the max_cost_assignment() routine packaged up as
+                a function object that keeps the algorithm's working arrays between
+                calls.  Calling max_cost_assignment() allocates those arrays every
+                time, which is wasteful if you solve many small assignment problems
+                in a row (e.g. matching detections to tracks once per video frame).
+                Reusing one of these objects makes such repeated solves allocation
+                free after the first call.
+        !*/
+
+    public:
+
+        template <typename EXP>
+        const std::vector<long>& operator() (
+            const matrix_exp<EXP>& cost
+        );
+        /*!
+            requires
+                - EXP::type == type
+                - cost.nr() == cost.nc()
+            ensures
+                - returns max_cost_assignment(cost).  The returned reference points
+                  into this object and is invalidated by the next call to
+                  operator() or solve_warm_started().
+        !*/
+
+        template <typename EXP>
+        const std::vector<long>& solve_warm_started (
+            const matrix_exp<EXP>& cost
+        );
+        /*!
+            requires
+                - EXP::type == type
+                - cost.nr() == cost.nc()
+            ensures
+                - returns max_cost_assignment(cost), exactly like operator().
+                  However, the solve is warm started from the dual variables left
+                  behind by this object's previous solve, provided that solve had the
+                  same dimensions as cost.  When consecutive cost matrices are
+                  similar, as happens when re-associating a slowly changing set of
+                  objects every video frame, the warm start greatly reduces the
+                  number of labeling updates the Hungarian algorithm performs.  The
+                  returned assignment is optimal either way, warm starting only
+                  affects the runtime.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T, long NR, long NC, typename MM, typename L>
+    void max_cost_assignment (
+        thread_pool& tp,
+        const std::vector<matrix<T,NR,NC,MM,L> >& costs,
+        std::vector<std::vector<long> >& assignments
+    );
+    /*!
+        requires
+            - T == some integer type (e.g. int)
+            - for all valid i:
+                - costs[i].nr() == costs[i].nc()
+        ensures
+            - Solves all the given assignment problems, using the threads in tp to
+              work on many of them at once.  Aside from ordering, the problems are
+              independent, so the results are identical to calling
+              max_cost_assignment() on each element of costs in turn.
+            - #assignments.size() == costs.size()
+            - for all valid i:
+                - #assignments[i] == max_cost_assignment(costs[i])
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
 }
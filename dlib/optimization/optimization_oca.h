@@ -50,6 +50,49 @@ namespace dlib
 
     };
 
+// ----------------------------------------------------------------------------------------
+
+    template <typename matrix_type>
+    struct oca_cutting_plane_state
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object holds the set of cutting planes built up by a run of the
+                oca solver.  Passing it back into oca warm-starts the next solve from
+                these planes, which greatly reduces the number of iterations needed
+                when the underlying problem has only changed slightly (e.g. a nightly
+                retrain on a dataset with a few percent churn).
+        !*/
+
+        typedef typename matrix_type::type scalar_type;
+
+        std::vector<matrix_type> planes;
+        std::vector<scalar_type> bs;
+
+        bool empty() const { return planes.size() == 0; }
+        void clear() { planes.clear(); bs.clear(); }
+    };
+
+    template <typename matrix_type>
+    void serialize (const oca_cutting_plane_state<matrix_type>& item, std::ostream& out)
+    {
+        int version = 1;
+        serialize(version, out);
+        serialize(item.planes, out);
+        serialize(item.bs, out);
+    }
+
+    template <typename matrix_type>
+    void deserialize (oca_cutting_plane_state<matrix_type>& item, std::istream& in)
+    {
+        int version = 0;
+        deserialize(version, in);
+        if (version != 1)
+            throw serialization_error("Unexpected version found while deserializing dlib::oca_cutting_plane_state.");
+        deserialize(item.planes, in);
+        deserialize(item.bs, in);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     class oca
@@ -135,6 +178,21 @@ namespace dlib
             return oca_impl(problem, w, empty_prior, false, num_nonnegative, force_weight_to_1, 0);
         }
 
+        template <
+            typename matrix_type
+            >
+        typename matrix_type::type operator() (
+            const oca_problem<matrix_type>& problem,
+            matrix_type& w,
+            oca_cutting_plane_state<matrix_type>& state,
+            unsigned long num_nonnegative = 0,
+            unsigned long force_weight_to_1 = std::numeric_limits<unsigned long>::max()
+        ) const
+        {
+            matrix_type empty_prior;
+            return oca_impl(problem, w, empty_prior, false, num_nonnegative, force_weight_to_1, 0, &state);
+        }
+
         template <
             typename matrix_type
             >
@@ -185,7 +243,8 @@ namespace dlib
             bool have_prior,
             unsigned long num_nonnegative,
             unsigned long force_weight_to_1,
-            const double lasso_lambda
+            const double lasso_lambda,
+            oca_cutting_plane_state<matrix_type>* state = 0
         ) const
         {
             const unsigned long num_dims = problem.get_num_dimensions();
@@ -247,8 +306,40 @@ namespace dlib
                 d.set_size(num_nonnegative);
             d = lasso_lambda*ones_matrix(d);
 
+            // If we were given cutting planes from a previous run on a similar problem
+            // then seed the solver with them rather than starting from nothing.  Stale
+            // planes that stay inactive get discarded by the usual miss_count pruning.
+            const bool warm_started = state != 0 && !state->empty() &&
+                                      (unsigned long)state->planes[0].size() == num_dims;
+            if (warm_started)
+            {
+                for (unsigned long i = 0; i < state->planes.size(); ++i)
+                {
+                    new_plane = state->planes[i];
+                    if (force_weight_to_1 < (unsigned long)new_plane.size())
+                        set_rowm(new_plane, range(force_weight_to_1, new_plane.size()-1)) = 0;
+                    bs.push_back(state->bs[i]);
+                    planes.add(planes.size(), new_plane);
+                    miss_count.push_back(0);
+                }
+                // All the dual weight goes on the first plane so that sum(alpha) == C
+                // holds.  The first QP solve redistributes it over the seeded planes.
+                alpha = zeros_matrix<scalar_type>(planes.size(),1);
+                alpha(0) = C;
+
+                K.set_size(planes.size(), planes.size());
+                for (unsigned long r = 0; r < planes.size(); ++r)
+                {
+                    for (unsigned long c = r; c < planes.size(); ++c)
+                    {
+                        K(r,c) = dot(planes[r], planes[c]);
+                        K(c,r) = K(r,c);
+                    }
+                }
+            }
+
             scalar_type R_lower_bound;
-            if (problem.risk_has_lower_bound(R_lower_bound))
+            if (!warm_started && problem.risk_has_lower_bound(R_lower_bound))
             {
                 // The flat lower bounding plane is always good to have if we know
                 // what it is.
@@ -409,6 +500,16 @@ namespace dlib
             if (force_weight_to_1 < (unsigned long)w.size())
                 w(force_weight_to_1) = 1;
 
+            // Save the final cutting plane set so the caller can warm start a future
+            // solve from it.
+            if (state != 0)
+            {
+                state->clear();
+                for (unsigned long i = 0; i < planes.size(); ++i)
+                    state->planes.push_back(planes[i]);
+                state->bs = bs;
+            }
+
             return cur_obj;
         }
 
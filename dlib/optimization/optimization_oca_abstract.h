@@ -124,6 +124,54 @@ namespace dlib
 
     };
 
+// ----------------------------------------------------------------------------------------
+
+    template <typename matrix_type>
+    struct oca_cutting_plane_state
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object holds the set of cutting planes accumulated by a run of
+                the oca solver below.  If you solve a sequence of closely related
+                problems (e.g. nightly retrains where only a small fraction of the
+                training data changed) then handing the state from one solve to the
+                next warm-starts the solver, typically cutting the number of
+                iterations needed to converge by a large factor.
+
+                This object is serializable via the usual serialize()/deserialize()
+                routines, so the plane set can be stored on disk between runs.
+        !*/
+
+        typedef typename matrix_type::type scalar_type;
+
+        std::vector<matrix_type> planes;
+        std::vector<scalar_type> bs;
+
+        bool empty() const;
+        /*!
+            ensures
+                - returns true if this object contains no cutting planes
+        !*/
+
+        void clear();
+        /*!
+            ensures
+                - #empty() == true
+        !*/
+    };
+
+    template <typename matrix_type>
+    void serialize (const oca_cutting_plane_state<matrix_type>& item, std::ostream& out);
+    /*!
+        provides serialization support
+    !*/
+
+    template <typename matrix_type>
+    void deserialize (oca_cutting_plane_state<matrix_type>& item, std::istream& in);
+    /*!
+        provides deserialization support
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     class oca
@@ -215,6 +263,35 @@ namespace dlib
                           values of 0.
         !*/
 
+        template <
+            typename matrix_type
+            >
+        typename matrix_type::type operator() (
+            const oca_problem<matrix_type>& problem,
+            matrix_type& w,
+            oca_cutting_plane_state<matrix_type>& state,
+            unsigned long num_nonnegative = 0,
+            unsigned long force_weight_to_1 = std::numeric_limits<unsigned long>::max()
+        ) const;
+        /*!
+            requires
+                - problem.get_c() > 0
+                - problem.get_num_dimensions() > 0
+            ensures
+                - This function is identical to the above operator() routine except
+                  that it additionally warm-starts the solver and records its final
+                  solver state.  In particular:
+                    - if (state contains planes whose dimensionality matches
+                      problem.get_num_dimensions()) then
+                        - the solver is seeded with those cutting planes before the
+                          first iteration.  Planes that are no longer relevant are
+                          discarded by the usual inactive plane pruning.
+                    - else
+                        - the solve starts from scratch, just like the routine above.
+                - #state == the set of cutting planes active at the end of this
+                  solve, suitable for warm-starting a later call.
+        !*/
+
         template <
             typename matrix_type
             >
@@ -0,0 +1,277 @@
+// Copyright (C) 2006  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_LOCKFREE_PIPe_1_
+#define DLIB_LOCKFREE_PIPe_1_
+
+#include "lockfree_pipe_abstract.h"
+#include "../algs.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    class lockfree_pipe : noncopyable
+    {
+        /*!
+            INITIAL VALUE
+                - enqueue_pos == 0
+                - dequeue_pos == 0
+                - enabled == true
+                - cells[i].sequence == i for all valid i
+
+            CONVENTION
+                This is the bounded MPMC ring buffer of Dmitry Vyukov.  Each cell
+                carries a sequence number.  A cell is ready for the producer whose
+                ticket is pos when sequence == pos and ready for the consumer whose
+                ticket is pos when sequence == pos+1.  After use, producers set
+                sequence = pos+1 and consumers set sequence = pos+buffer_size.  The
+                positions only ever increase, with pos&mask giving the cell index.
+
+                Threads never take a mutex.  When the queue is full/empty they spin
+                with exponential backoff (pause, yield, then short sleeps) while
+                polling the enabled flag.
+        !*/
+
+        static_assert(std::is_nothrow_move_constructible<T>::value &&
+                      std::is_nothrow_move_assignable<T>::value,
+            "lockfree_pipe requires a type with non-throwing move operations");
+
+    public:
+        typedef T type;
+
+        explicit lockfree_pipe (
+            size_t maximum_size
+        ) :
+            enqueue_pos(0),
+            dequeue_pos(0),
+            enabled(true)
+        {
+            // round the size up to a power of 2 so masking can be used instead of modulo.
+            size_t size = 2;
+            while (size < maximum_size)
+                size *= 2;
+            buffer_size = size;
+            mask = size-1;
+            cells.reset(new cell_type[size]);
+            for (size_t i = 0; i < size; ++i)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        ~lockfree_pipe (
+        )
+        {
+            disable();
+        }
+
+        void enable (
+        ) { enabled.store(true, std::memory_order_release); }
+
+        void disable (
+        ) { enabled.store(false, std::memory_order_release); }
+
+        bool is_enabled (
+        ) const { return enabled.load(std::memory_order_acquire); }
+
+        size_t max_size (
+        ) const { return buffer_size; }
+
+        size_t size (
+        ) const
+        {
+            const size_t e = enqueue_pos.load(std::memory_order_acquire);
+            const size_t d = dequeue_pos.load(std::memory_order_acquire);
+            return (e > d) ? e-d : 0;
+        }
+
+        bool enqueue (
+            T&& item
+        )
+        {
+            return enqueue_loop(item, false, 0);
+        }
+
+        bool enqueue (
+            T& item
+        )
+        {
+            return enqueue_loop(item, false, 0);
+        }
+
+        bool enqueue_or_timeout (
+            T&& item,
+            unsigned long timeout
+        )
+        {
+            return enqueue_loop(item, true, timeout);
+        }
+
+        bool enqueue_or_timeout (
+            T& item,
+            unsigned long timeout
+        )
+        {
+            return enqueue_loop(item, true, timeout);
+        }
+
+        bool dequeue (
+            T& item
+        )
+        {
+            return dequeue_loop(item, false, 0);
+        }
+
+        bool dequeue_or_timeout (
+            T& item,
+            unsigned long timeout
+        )
+        {
+            return dequeue_loop(item, true, timeout);
+        }
+
+    private:
+
+        struct cell_type
+        {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        // Try to claim one cell for an enqueue.  Returns 1 on success, 0 if the
+        // queue looked full, and repeats internally on races with other producers.
+        bool try_enqueue (
+            T& item
+        )
+        {
+            size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell_type& cell = cells[pos&mask];
+                const size_t seq = cell.sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t dif = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+                if (dif == 0)
+                {
+                    if (enqueue_pos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed))
+                    {
+                        cell.data = std::move(item);
+                        cell.sequence.store(pos+1, std::memory_order_release);
+                        return true;
+                    }
+                    // lost the race, pos was reloaded by compare_exchange_weak
+                }
+                else if (dif < 0)
+                {
+                    // the cell is still occupied by an item a consumer hasn't taken
+                    // yet, i.e. the queue is full.
+                    return false;
+                }
+                else
+                {
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool try_dequeue (
+            T& item
+        )
+        {
+            size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell_type& cell = cells[pos&mask];
+                const size_t seq = cell.sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t dif = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos+1);
+                if (dif == 0)
+                {
+                    if (dequeue_pos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed))
+                    {
+                        item = std::move(cell.data);
+                        cell.sequence.store(pos+buffer_size, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (dif < 0)
+                {
+                    // the queue is empty
+                    return false;
+                }
+                else
+                {
+                    pos = dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        template <typename op_type>
+        bool wait_loop (
+            const op_type& op,
+            bool has_timeout,
+            unsigned long timeout
+        )
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+            unsigned long spins = 0;
+            for (;;)
+            {
+                if (!is_enabled())
+                    return false;
+                if (op())
+                    return true;
+                if (has_timeout && std::chrono::steady_clock::now() >= deadline)
+                    return false;
+
+                // back off: busy spin a bit, then yield, then sleep in small steps so a
+                // blocked thread doesn't burn a whole core forever.
+                ++spins;
+                if (spins < 64)
+                    ; // spin
+                else if (spins < 256)
+                    std::this_thread::yield();
+                else
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+
+        bool enqueue_loop (
+            T& item,
+            bool has_timeout,
+            unsigned long timeout
+        )
+        {
+            return wait_loop([&]() { return try_enqueue(item); }, has_timeout, timeout);
+        }
+
+        bool dequeue_loop (
+            T& item,
+            bool has_timeout,
+            unsigned long timeout
+        )
+        {
+            return wait_loop([&]() { return try_dequeue(item); }, has_timeout, timeout);
+        }
+
+        std::unique_ptr<cell_type[]> cells;
+        size_t buffer_size;
+        size_t mask;
+
+        // keep the producer and consumer cursors on their own cache lines
+        alignas(64) std::atomic<size_t> enqueue_pos;
+        alignas(64) std::atomic<size_t> dequeue_pos;
+        alignas(64) std::atomic<bool> enabled;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_LOCKFREE_PIPe_1_
@@ -0,0 +1,175 @@
+// Copyright (C) 2006  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_LOCKFREE_PIPe_ABSTRACT_
+#ifdef DLIB_LOCKFREE_PIPe_ABSTRACT_
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    class lockfree_pipe : noncopyable
+    {
+        /*!
+            REQUIREMENTS ON T
+                T must have non-throwing move construction and move assignment
+                (this is checked at compile time).
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a bounded first-in-first-out queue connecting any
+                number of producer threads to any number of consumer threads, just
+                like dlib::pipe.  Unlike dlib::pipe, no mutex or signaler is ever
+                taken: all queue operations are implemented with atomic compare and
+                swap on a ring buffer, and threads that find the queue full or empty
+                spin with exponential backoff instead of parking on a kernel
+                primitive.  This makes it the right choice for very high message
+                rates between pipeline stages, where the mutex handoff in
+                dlib::pipe would dominate.  For low rate or mostly idle queues
+                dlib::pipe remains preferable since its blocked threads consume no
+                CPU at all.
+
+                It supports the core subset of the dlib::pipe interface: enqueue,
+                dequeue, the _or_timeout variants, size, max_size, and
+                enable/disable.  Items are always moved in and out of the queue.
+
+            THREAD SAFETY
+                All methods of this class may be called concurrently from any number
+                of threads.
+        !*/
+
+    public:
+
+        typedef T type;
+
+        explicit lockfree_pipe (
+            size_t maximum_size
+        );
+        /*!
+            requires
+                - maximum_size > 0
+            ensures
+                - #is_enabled() == true
+                - #size() == 0
+                - #max_size() == the smallest power of 2 >= maximum_size.  (The
+                  capacity is rounded up so ring indices can be computed by masking.)
+        !*/
+
+        ~lockfree_pipe (
+        );
+        /*!
+            ensures
+                - any threads blocked in enqueue() or dequeue() will return false.
+                  Note that, just like dlib::pipe, you must ensure no threads are
+                  still touching this object when it is destructed.
+        !*/
+
+        void enable (
+        );
+        /*!
+            ensures
+                - #is_enabled() == true
+        !*/
+
+        void disable (
+        );
+        /*!
+            ensures
+                - #is_enabled() == false
+                - all current and future calls to enqueue() or dequeue() and their
+                  timeout variants return false without transferring an item.
+        !*/
+
+        bool is_enabled (
+        ) const;
+        /*!
+            ensures
+                - returns true if this pipe is currently enabled
+        !*/
+
+        size_t max_size (
+        ) const;
+        /*!
+            ensures
+                - returns the maximum number of objects this pipe can hold
+        !*/
+
+        size_t size (
+        ) const;
+        /*!
+            ensures
+                - returns an estimate of the number of objects currently in the pipe.
+                  The value is exact when no other threads are concurrently modifying
+                  the pipe.
+        !*/
+
+        bool enqueue (
+            T&& item
+        );
+        /*!
+            ensures
+                - if (this pipe is enabled) then
+                    - blocks (spinning) until there is room, then moves item into the
+                      pipe and returns true.
+                - else
+                    - returns false
+        !*/
+
+        bool enqueue (
+            T& item
+        );
+        /*!
+            ensures
+                - same as the above enqueue() except item is moved from an lvalue, so
+                  #item has a valid but unspecified value afterwards.
+        !*/
+
+        bool enqueue_or_timeout (
+            T&& item,
+            unsigned long timeout
+        );
+        /*!
+            ensures
+                - same as enqueue() except that it gives up and returns false if
+                  timeout milliseconds pass before room becomes available.
+        !*/
+
+        bool enqueue_or_timeout (
+            T& item,
+            unsigned long timeout
+        );
+        /*!
+            ensures
+                - same as the above enqueue_or_timeout() but moving from an lvalue.
+        !*/
+
+        bool dequeue (
+            T& item
+        );
+        /*!
+            ensures
+                - if (this pipe is enabled) then
+                    - blocks (spinning) until an item is available, moves it into
+                      #item, and returns true.
+                - else
+                    - returns false
+        !*/
+
+        bool dequeue_or_timeout (
+            T& item,
+            unsigned long timeout
+        );
+        /*!
+            ensures
+                - same as dequeue() except that it gives up and returns false if
+                  timeout milliseconds pass before an item becomes available.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_LOCKFREE_PIPe_ABSTRACT_
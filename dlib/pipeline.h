@@ -0,0 +1,18 @@
+// Copyright (C) 2016  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#ifdef DLIB_ALL_SOURCE_END
+#include "dlib_basic_cpp_build_tutorial.txt"
+#endif
+
+#ifndef DLIB_PIPELINe_
+#define DLIB_PIPELINe_
+
+// This lives in its own header rather than in threads.h because it depends on
+// pipe.h, which itself depends on threads.h.
+#include "threads.h"
+#include "pipe.h"
+#include "threads/pipeline_extension.h"
+
+#endif // DLIB_PIPELINe_
+
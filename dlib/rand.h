@@ -4,6 +4,7 @@
 #define DLIB_RANd_
 
 #include "rand/rand_kernel_1.h"
+#include "rand/philox_rand.h"
 
 #endif // DLIB_RANd_
 
@@ -0,0 +1,364 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_PHILOX_RANd_Hh_
+#define DLIB_PHILOX_RANd_Hh_
+
+#include <cmath>
+#include <limits>
+#include "../algs.h"
+#include "../serialize.h"
+#include "../uintn.h"
+#include "philox_rand_abstract.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class philox_rand
+    {
+        /*!
+            INITIAL VALUE
+                - seed_ == 0
+                - stream_ == 0
+                - block_ == 0
+                - next_ == 4
+                - has_gaussian == false
+
+            CONVENTION
+                - This is the Philox-4x32-10 counter based generator of Salmon et al.,
+                  "Parallel Random Numbers: As Easy as 1, 2, 3".  The 64 bit key is
+                  seed_ and the 128 bit counter is (position, stream_), where position
+                  is the 64 bit index of a block of 4 outputs.  So every
+                  (seed,stream,position) triple deterministically names 4 random 32 bit
+                  numbers and distinct streams never overlap.
+                - buf holds the outputs of block number block_-1 and next_ of them have
+                  already been handed out.  If next_ == 4 then the next block to
+                  generate is block_.
+                - get_seed() == seed_
+                - get_stream() == stream_
+        !*/
+
+    public:
+
+        philox_rand (
+        )
+        {
+            set_seed(0);
+        }
+
+        explicit philox_rand (
+            uint64 seed_value
+        )
+        {
+            set_seed(seed_value);
+        }
+
+        philox_rand (
+            uint64 seed_value,
+            uint64 stream_value
+        )
+        {
+            set_seed(seed_value, stream_value);
+        }
+
+        void clear (
+        )
+        {
+            set_seed(0);
+        }
+
+        void set_seed (
+            uint64 seed_value,
+            uint64 stream_value = 0
+        )
+        {
+            max_val =  0xFFFFFF;
+            max_val *= 0x1000000;
+            max_val += 0xFFFFFF;
+            max_val += 0.05;
+
+            seed_ = seed_value;
+            stream_ = stream_value;
+            block_ = 0;
+            next_ = 4;
+            has_gaussian = false;
+            next_gaussian = 0;
+        }
+
+        uint64 get_seed (
+        ) const { return seed_; }
+
+        uint64 get_stream (
+        ) const { return stream_; }
+
+        philox_rand split (
+            uint64 substream
+        ) const
+        {
+            // Mix the parent's stream with the substream id so nested splits give
+            // distinct streams no matter how the ids are chosen.
+            return philox_rand(seed_, mix64(stream_ ^ mix64(substream)));
+        }
+
+        void set_counter (
+            uint64 counter
+        )
+        {
+            has_gaussian = false;
+            next_gaussian = 0;
+            block_ = counter/4;
+            next_ = 4;
+            if (counter%4 != 0)
+            {
+                generate(block_++, buf);
+                next_ = counter%4;
+            }
+        }
+
+        uint64 get_counter (
+        ) const
+        {
+            if (next_ == 4)
+                return block_*4;
+            else
+                return (block_-1)*4 + next_;
+        }
+
+        inline uint32 get_random_32bit_number (
+        )
+        {
+            if (next_ == 4)
+            {
+                generate(block_++, buf);
+                next_ = 0;
+            }
+            return buf[next_++];
+        }
+
+        inline uint64 get_random_64bit_number (
+        )
+        {
+            const uint64 lhs = get_random_32bit_number();
+            const uint64 rhs = get_random_32bit_number();
+            return (lhs<<32)|rhs;
+        }
+
+        float get_random_float (
+        )
+        {
+            return to_float(get_random_32bit_number());
+        }
+
+        double get_random_double (
+        )
+        {
+            uint32 temp;
+
+            temp = get_random_32bit_number();
+            temp &= 0xFFFFFF;
+
+            double val = static_cast<double>(temp);
+
+            val *= 0x1000000;
+
+            temp = get_random_32bit_number();
+            temp &= 0xFFFFFF;
+
+            val += temp;
+
+            val /= max_val;
+
+            if (val < 1.0)
+            {
+                return val;
+            }
+            else
+            {
+                // return a value slightly less than 1.0
+                return 1.0 - std::numeric_limits<double>::epsilon();
+            }
+        }
+
+        double get_random_gaussian (
+        )
+        {
+            if (has_gaussian)
+            {
+                has_gaussian = false;
+                return next_gaussian;
+            }
+
+            double x1, x2, w;
+
+            const double rndmax = std::numeric_limits<dlib::uint32>::max();
+
+            // Generate a pair of Gaussian random numbers using the Box-Muller transformation.
+            do
+            {
+                const double rnd1 = get_random_32bit_number()/rndmax;
+                const double rnd2 = get_random_32bit_number()/rndmax;
+
+                x1 = 2.0 * rnd1 - 1.0;
+                x2 = 2.0 * rnd2 - 1.0;
+                w = x1 * x1 + x2 * x2;
+            } while ( w >= 1.0 );
+
+            w = std::sqrt( (-2.0 * std::log( w ) ) / w );
+            next_gaussian = x2 * w;
+            has_gaussian = true;
+            return x1 * w;
+        }
+
+        void get_random_floats (
+            float* buffer,
+            size_t num
+        )
+        {
+            size_t i = 0;
+
+            // First hand out anything already buffered so the result is identical to
+            // calling get_random_float() num times.
+            while (i < num && next_ != 4)
+                buffer[i++] = to_float(buf[next_++]);
+
+            // Then convert whole blocks straight out of the generator.  Each block
+            // depends only on its counter value, so these iterations are independent
+            // of one another and the compiler is free to vectorize and pipeline them.
+            while (num - i >= 4)
+            {
+                uint32 vals[4];
+                generate(block_++, vals);
+                buffer[i+0] = to_float(vals[0]);
+                buffer[i+1] = to_float(vals[1]);
+                buffer[i+2] = to_float(vals[2]);
+                buffer[i+3] = to_float(vals[3]);
+                i += 4;
+            }
+
+            while (i < num)
+                buffer[i++] = get_random_float();
+        }
+
+        void swap (
+            philox_rand& item
+        )
+        {
+            exchange(seed_, item.seed_);
+            exchange(stream_, item.stream_);
+            exchange(block_, item.block_);
+            exchange(next_, item.next_);
+            for (int i = 0; i < 4; ++i)
+                exchange(buf[i], item.buf[i]);
+            exchange(has_gaussian, item.has_gaussian);
+            exchange(next_gaussian, item.next_gaussian);
+            exchange(max_val, item.max_val);
+        }
+
+        friend void serialize (
+            const philox_rand& item,
+            std::ostream& out
+        )
+        {
+            int version = 1;
+            dlib::serialize(version, out);
+            dlib::serialize(item.seed_, out);
+            dlib::serialize(item.stream_, out);
+            dlib::serialize(item.block_, out);
+            dlib::serialize(item.next_, out);
+            for (int i = 0; i < 4; ++i)
+                dlib::serialize(item.buf[i], out);
+            dlib::serialize(item.has_gaussian, out);
+            dlib::serialize(item.next_gaussian, out);
+        }
+
+        friend void deserialize (
+            philox_rand& item,
+            std::istream& in
+        )
+        {
+            int version = 0;
+            dlib::deserialize(version, in);
+            if (version != 1)
+                throw serialization_error("Unexpected version found while deserializing dlib::philox_rand.");
+            dlib::deserialize(item.seed_, in);
+            dlib::deserialize(item.stream_, in);
+            dlib::deserialize(item.block_, in);
+            dlib::deserialize(item.next_, in);
+            for (int i = 0; i < 4; ++i)
+                dlib::deserialize(item.buf[i], in);
+            dlib::deserialize(item.has_gaussian, in);
+            dlib::deserialize(item.next_gaussian, in);
+        }
+
+    private:
+
+        static float to_float (
+            uint32 val
+        )
+        {
+            const float scale = 1.0f/0x1000000;
+            return static_cast<float>(val&0xFFFFFF)*scale;
+        }
+
+        static uint64 mix64 (
+            uint64 x
+        )
+        {
+            // This is the finalizer from splitmix64.  It is a bijection, so distinct
+            // inputs always produce distinct outputs.
+            x += 0x9E3779B97F4A7C15ULL;
+            x = (x ^ (x>>30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x>>27)) * 0x94D049BB133111EBULL;
+            return x ^ (x>>31);
+        }
+
+        void generate (
+            uint64 position,
+            uint32 out[4]
+        ) const
+        {
+            uint32 k0 = static_cast<uint32>(seed_);
+            uint32 k1 = static_cast<uint32>(seed_>>32);
+            out[0] = static_cast<uint32>(position);
+            out[1] = static_cast<uint32>(position>>32);
+            out[2] = static_cast<uint32>(stream_);
+            out[3] = static_cast<uint32>(stream_>>32);
+
+            for (int round = 0; round < 10; ++round)
+            {
+                const uint64 p0 = static_cast<uint64>(0xD2511F53)*out[0];
+                const uint64 p1 = static_cast<uint64>(0xCD9E8D57)*out[2];
+                const uint32 r1 = out[1];
+                const uint32 r3 = out[3];
+                out[0] = static_cast<uint32>(p1>>32) ^ r1 ^ k0;
+                out[1] = static_cast<uint32>(p1);
+                out[2] = static_cast<uint32>(p0>>32) ^ r3 ^ k1;
+                out[3] = static_cast<uint32>(p0);
+                k0 += 0x9E3779B9;
+                k1 += 0xBB67AE85;
+            }
+        }
+
+        double max_val;
+
+        uint64 seed_;
+        uint64 stream_;
+        uint64 block_;
+        unsigned int next_;
+        uint32 buf[4];
+
+        bool has_gaussian;
+        double next_gaussian;
+    };
+
+    inline void swap (
+        philox_rand& a,
+        philox_rand& b
+    ) { a.swap(b); }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_PHILOX_RANd_Hh_
@@ -0,0 +1,237 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_PHILOX_RANd_ABSTRACT_Hh_
+#ifdef DLIB_PHILOX_RANd_ABSTRACT_Hh_
+
+#include "../uintn.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class philox_rand
+    {
+        /*!
+            INITIAL VALUE
+                - get_seed() == 0
+                - get_stream() == 0
+                - get_counter() == 0
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is the Philox-4x32-10 counter based random number
+                generator (Salmon et al., "Parallel Random Numbers: As Easy as
+                1, 2, 3").  Unlike dlib::rand, which evolves a large hidden state,
+                every output of this generator is a pure function of the triple
+                (seed, stream, counter).  That buys you two things:
+
+                    - Parallel streams: generators with the same seed but different
+                      stream ids produce statistically independent sequences that are
+                      guaranteed never to overlap.  So you can hand stream i to worker
+                      thread i and the combined program output is reproducible no
+                      matter how the threads are scheduled.
+
+                    - Random access: set_counter() jumps to any position in a stream
+                      in constant time, so a sequence can be replayed or consumed out
+                      of order.
+
+                The generator passes the same statistical test batteries as the
+                Mersenne Twister while holding only a few words of state.
+
+            THREAD SAFETY
+                It is not safe for multiple threads to use a single instance of this
+                object concurrently.  Instead, give each thread its own instance,
+                e.g. via split() or distinct stream ids.
+        !*/
+
+    public:
+
+        philox_rand (
+        );
+        /*!
+            ensures
+                - #*this is properly initialized
+        !*/
+
+        explicit philox_rand (
+            uint64 seed_value
+        );
+        /*!
+            ensures
+                - #get_seed() == seed_value
+                - #get_stream() == 0
+                - #get_counter() == 0
+        !*/
+
+        philox_rand (
+            uint64 seed_value,
+            uint64 stream_value
+        );
+        /*!
+            ensures
+                - #get_seed() == seed_value
+                - #get_stream() == stream_value
+                - #get_counter() == 0
+        !*/
+
+        void clear (
+        );
+        /*!
+            ensures
+                - #*this has its initial value
+        !*/
+
+        void set_seed (
+            uint64 seed_value,
+            uint64 stream_value = 0
+        );
+        /*!
+            ensures
+                - #get_seed() == seed_value
+                - #get_stream() == stream_value
+                - #get_counter() == 0
+        !*/
+
+        uint64 get_seed (
+        ) const;
+        /*!
+            ensures
+                - returns the seed used by this generator.
+        !*/
+
+        uint64 get_stream (
+        ) const;
+        /*!
+            ensures
+                - returns the id of the stream this generator draws from.  Generators
+                  with the same seed but different stream ids produce non-overlapping
+                  sequences.
+        !*/
+
+        philox_rand split (
+            uint64 substream
+        ) const;
+        /*!
+            ensures
+                - returns a new generator G such that:
+                    - G.get_seed() == get_seed()
+                    - G.get_counter() == 0
+                    - G.get_stream() is a mix of get_stream() and substream.  The mix
+                      is a fixed bijection, so splitting the same generator with
+                      distinct substream ids always yields distinct streams, and
+                      splits can be nested (e.g. one split per epoch, then one per
+                      worker) while remaining reproducible.
+                - does not modify *this in any way.
+        !*/
+
+        void set_counter (
+            uint64 counter
+        );
+        /*!
+            ensures
+                - #get_counter() == counter
+                - Positions this generator so the next call to
+                  get_random_32bit_number() returns the counter-th number of this
+                  stream.  This runs in constant time regardless of the distance
+                  jumped.
+        !*/
+
+        uint64 get_counter (
+        ) const;
+        /*!
+            ensures
+                - returns the number of 32 bit random numbers this generator has
+                  handed out so far, i.e. the current position within the stream.
+        !*/
+
+        uint32 get_random_32bit_number (
+        );
+        /*!
+            ensures
+                - returns a random 32 bit number
+                - #get_counter() == get_counter() + 1
+        !*/
+
+        uint64 get_random_64bit_number (
+        );
+        /*!
+            ensures
+                - returns a random 64 bit number
+        !*/
+
+        float get_random_float (
+        );
+        /*!
+            ensures
+                - returns a random float number N where:  0.0 <= N < 1.0.
+        !*/
+
+        double get_random_double (
+        );
+        /*!
+            ensures
+                - returns a random double number N where:  0.0 <= N < 1.0.
+        !*/
+
+        double get_random_gaussian (
+        );
+        /*!
+            ensures
+                - returns a random number sampled from a Gaussian distribution
+                  with mean 0 and standard deviation 1.
+        !*/
+
+        void get_random_floats (
+            float* buffer,
+            size_t num
+        );
+        /*!
+            requires
+                - buffer points to at least num floats
+            ensures
+                - fills buffer with num random floats, each in the range [0,1).  The
+                  result is identical to calling get_random_float() num times, but
+                  the fill runs over whole counter blocks at once, so the iterations
+                  are independent and vectorize.
+        !*/
+
+        void swap (
+            philox_rand& item
+        );
+        /*!
+            ensures
+                - swaps *this and item
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    inline void swap (
+        philox_rand& a,
+        philox_rand& b
+    ) { a.swap(b); }
+    /*!
+        provides a global swap function
+    !*/
+
+    void serialize (
+        const philox_rand& item,
+        std::ostream& out
+    );
+    /*!
+        provides serialization support
+    !*/
+
+    void deserialize (
+        philox_rand& item,
+        std::istream& in
+    );
+    /*!
+        provides deserialization support
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_PHILOX_RANd_ABSTRACT_Hh_
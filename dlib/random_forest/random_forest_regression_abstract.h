@@ -198,7 +198,10 @@ namespace dlib
                     - trees[i].size()+leaves[i].size() > the maximal left or right index values in trees[i].
                       (i.e. each left or right value must index to some existing internal tree node or leaf node).
             ensures
-                - #get_internal_tree_nodes() == trees_
+                - #get_internal_tree_nodes() represents the same trees as trees_.  Note
+                  that the nodes within each tree are reordered into a breadth first
+                  layout, which makes prediction more cache friendly but doesn't change
+                  the function the trees compute.
                 - #get_tree_leaves() == leaves_
                 - #get_feature_extractor() == fe_
         !*/
@@ -242,7 +245,24 @@ namespace dlib
             ensures
                 - Maps x to a real value and returns the value.  To do this, we find the
                   get_num_trees() leaf values associated with x and then return the average
-                  of these leaf values.   
+                  of these leaf values.
+        !*/
+
+        std::vector<double> operator() (
+            const std::vector<sample_type>& x
+        ) const;
+        /*!
+            requires
+                - get_num_trees() > 0
+            ensures
+                - returns a vector R such that:
+                    - R.size() == x.size()
+                    - for all valid i: R[i] == (*this)(x[i])
+                  That is, this is just like calling the single sample operator() on each
+                  element of x.  However, this version advances a small batch of samples
+                  through each tree together and prefetches the tree nodes the batch is
+                  about to visit, which hides much of the memory latency that dominates
+                  forest prediction.  So it's the faster way to evaluate many samples.
         !*/
     };
 
@@ -141,6 +141,7 @@
 
 #include "algs.h"
 #include "assert.h"
+#include <algorithm>
 #include <iomanip>
 #include <cstddef>
 #include <iostream>
@@ -687,11 +688,214 @@ namespace dlib
         serialize_floating_point(item,out);
     }
 
-    inline void deserialize ( long double& item, std::istream& in) 
-    { 
+    inline void deserialize ( long double& item, std::istream& in)
+    {
         deserialize_floating_point(item,in);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    namespace ser_helper
+    {
+        /*
+            The functions below implement the block streamed wire format used by the
+            matrix and array2d serialization routines when their elements are simple
+            arithmetic types.  The format begins with block_format_tag, which tells a
+            reader it isn't looking at one of the older element-by-element formats
+            (those always start with a row count or its negation, and no real matrix
+            can have block_format_tag rows).  After the tag comes a header giving the
+            dimensions, the element encoding, the byte order, and whether the elements
+            follow in row major order.  The header lets the reader allocate its storage
+            exactly once and then stream the raw element bytes in large fixed size
+            chunks, rather than deserializing one element at a time.
+        */
+
+        // This is a fixed value rather than an expression involving
+        // std::numeric_limits<long> so the tag bytes are identical on platforms
+        // where long is 32 bits and files port between 32 and 64 bit builds.
+        const long block_format_tag = -2147483647; // == -(2^31-1)
+        const size_t block_format_chunk_bytes = 256*1024;
+
+        template <typename T>
+        struct is_block_serializable
+        {
+            const static bool value = (std::is_integral<T>::value && !is_same_type<T,bool>::value) ||
+                                      is_same_type<T,float>::value ||
+                                      is_same_type<T,double>::value;
+        };
+
+        template <typename T>
+        inline unsigned char block_element_code (
+        )
+        /*!
+            ensures
+                - returns a byte describing how elements of type T appear on the wire.
+                  The low 4 bits give sizeof(T) and the next two bits say if the type
+                  is signed and if it is floating point.
+        !*/
+        {
+            return static_cast<unsigned char>(sizeof(T)) |
+                   (std::is_signed<T>::value ? 0x10 : 0) |
+                   (std::is_floating_point<T>::value ? 0x20 : 0);
+        }
+
+        inline void write_block_header (
+            std::ostream& out,
+            long nr,
+            long nc,
+            unsigned char element_code,
+            bool row_major
+        )
+        {
+            serialize(block_format_tag, out);
+            serialize(nr, out);
+            serialize(nc, out);
+            serialize(element_code, out);
+            byte_orderer bo;
+            const unsigned char little_endian = bo.host_is_little_endian();
+            serialize(little_endian, out);
+            const unsigned char rm = row_major;
+            serialize(rm, out);
+        }
+
+        inline void write_block_data (
+            std::ostream& out,
+            const char* data,
+            size_t num_bytes
+        )
+        {
+            for (size_t pos = 0; pos < num_bytes; pos += block_format_chunk_bytes)
+            {
+                out.write(data+pos, std::min<size_t>(block_format_chunk_bytes, num_bytes-pos));
+                if (!out)
+                    throw serialization_error("Error writing block streamed data to the output stream.");
+            }
+        }
+
+        inline void read_block_data (
+            std::istream& in,
+            char* data,
+            size_t num_bytes
+        )
+        {
+            for (size_t pos = 0; pos < num_bytes; pos += block_format_chunk_bytes)
+            {
+                in.read(data+pos, std::min<size_t>(block_format_chunk_bytes, num_bytes-pos));
+                if (!in)
+                    throw serialization_error("Error reading block streamed data from the input stream.");
+            }
+        }
+
+        inline void swap_block_bytes (
+            char* data,
+            size_t element_size,
+            size_t num_elements
+        )
+        {
+            for (size_t i = 0; i < num_elements; ++i, data += element_size)
+                std::reverse(data, data+element_size);
+        }
+
+        template <typename W, typename T>
+        void read_block_elements_as (
+            std::istream& in,
+            T* dest,
+            long nr,
+            long nc,
+            bool dest_row_major,
+            bool wire_row_major,
+            bool swap
+        )
+        /*!
+            requires
+                - dest points at nr*nc elements laid out contiguously in the order
+                  indicated by dest_row_major.
+            ensures
+                - reads nr*nc elements of wire type W from in, byte swapping them if
+                  swap is true, and assigns them into dest, reordering between row and
+                  column major as needed.
+        !*/
+        {
+            const size_t total = static_cast<size_t>(nr)*static_cast<size_t>(nc);
+            std::vector<W> buf(std::min<size_t>(total, std::max<size_t>(1,block_format_chunk_bytes/sizeof(W))));
+            size_t k = 0;
+            while (k < total)
+            {
+                const size_t count = std::min<size_t>(buf.size(), total-k);
+                read_block_data(in, reinterpret_cast<char*>(buf.data()), count*sizeof(W));
+                if (swap)
+                    swap_block_bytes(reinterpret_cast<char*>(buf.data()), sizeof(W), count);
+                if (dest_row_major == wire_row_major)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                        dest[k+i] = static_cast<T>(buf[i]);
+                }
+                else
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        // convert the wire's linear index into the destination's
+                        const size_t idx = k+i;
+                        const size_t r = wire_row_major ? idx/nc : idx%nr;
+                        const size_t c = wire_row_major ? idx%nc : idx/nr;
+                        dest[dest_row_major ? r*nc+c : c*nr+r] = static_cast<T>(buf[i]);
+                    }
+                }
+                k += count;
+            }
+        }
+
+        template <typename T>
+        void read_block_elements (
+            std::istream& in,
+            unsigned char element_code,
+            T* dest,
+            long nr,
+            long nc,
+            bool dest_row_major,
+            bool wire_row_major,
+            bool wire_little_endian
+        )
+        /*!
+            requires
+                - dest points at nr*nc elements laid out contiguously in the order
+                  indicated by dest_row_major.
+            ensures
+                - reads nr*nc block streamed elements encoded as indicated by
+                  element_code and wire_little_endian from in and assigns them into
+                  dest, converting the element type and storage order as needed.
+            throws
+                - serialization_error if element_code doesn't name a type this
+                  function knows how to decode.
+        !*/
+        {
+            byte_orderer bo;
+            const bool swap = (wire_little_endian != bo.host_is_little_endian());
+            if (element_code == block_element_code<int8>())
+                read_block_elements_as<int8>(in, dest, nr, nc, dest_row_major, wire_row_major, swap);
+            else if (element_code == block_element_code<uint8>())
+                read_block_elements_as<uint8>(in, dest, nr, nc, dest_row_major, wire_row_major, swap);
+            else if (element_code == block_element_code<int16>())
+                read_block_elements_as<int16>(in, dest, nr, nc, dest_row_major, wire_row_major, swap);
+            else if (element_code == block_element_code<uint16>())
+                read_block_elements_as<uint16>(in, dest, nr, nc, dest_row_major, wire_row_major, swap);
+            else if (element_code == block_element_code<int32>())
+                read_block_elements_as<int32>(in, dest, nr, nc, dest_row_major, wire_row_major, swap);
+            else if (element_code == block_element_code<uint32>())
+                read_block_elements_as<uint32>(in, dest, nr, nc, dest_row_major, wire_row_major, swap);
+            else if (element_code == block_element_code<int64>())
+                read_block_elements_as<int64>(in, dest, nr, nc, dest_row_major, wire_row_major, swap);
+            else if (element_code == block_element_code<uint64>())
+                read_block_elements_as<uint64>(in, dest, nr, nc, dest_row_major, wire_row_major, swap);
+            else if (element_code == block_element_code<float>())
+                read_block_elements_as<float>(in, dest, nr, nc, dest_row_major, wire_row_major, swap);
+            else if (element_code == block_element_code<double>())
+                read_block_elements_as<double>(in, dest, nr, nc, dest_row_major, wire_row_major, swap);
+            else
+                throw serialization_error("Unsupported element type code found in block streamed data.");
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 // prototypes
 
@@ -1126,6 +1330,202 @@ namespace dlib
         { throw serialization_error(e.info + "\n   while deserializing object of type std::vector"); }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    /*!A compressed_ints information !*/
+    template <typename T>
+    struct compressed_ints_t
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This is a type decoration used to indicate that a std::vector of integers
+                should be serialized with a delta coded variable length format instead of
+                the default elementwise format.  Consecutive values are subtracted and the
+                differences are zig-zag varint encoded, so long runs of similar or
+                monotonically increasing numbers (e.g. sorted ids or offsets) take only a
+                byte or two each on disk.  The encoded bytes are also moved to and from
+                the stream in bulk rather than with one stream call per element.
+
+                You use this object like this:
+                   serialize("yourfile.dat") << compressed_ints(yourvector);
+                   deserialize("yourfile.dat") >> compressed_ints(yourvector);
+                or
+                   serialize(compressed_ints(yourvector), out);
+                   deserialize(compressed_ints(yourvector), in);
+
+                The vector's contents always round-trip exactly no matter what values it
+                holds.  Only the on disk size depends on how smooth the data is.  Note,
+                however, that the format is different from the default std::vector format,
+                so both ends have to agree about which one is in the file.
+        !*/
+        compressed_ints_t(T& item_) : item(item_) {}
+        T& item;
+    };
+
+    // This function just makes a compressed_ints_t that wraps a vector.
+    template <typename T>
+    compressed_ints_t<typename std::remove_reference<T>::type> compressed_ints(T&& item)
+    {
+        return compressed_ints_t<typename std::remove_reference<T>::type>(item);
+    }
+
+    namespace ser_helper
+    {
+        inline void append_varint (
+            std::vector<unsigned char>& buf,
+            uint64 v
+        )
+        {
+            while (v >= 0x80)
+            {
+                buf.push_back(static_cast<unsigned char>((v&0x7F) | 0x80));
+                v >>= 7;
+            }
+            buf.push_back(static_cast<unsigned char>(v));
+        }
+
+        inline bool read_varint (
+            const unsigned char* data,
+            size_t size,
+            size_t& pos,
+            uint64& v
+        )
+        /*!
+            ensures
+                - if (a varint could be decoded from data starting at pos) then
+                    - #v == the decoded value and #pos is advanced past it
+                    - returns false
+                - else
+                    - returns true
+        !*/
+        {
+            v = 0;
+            for (unsigned int shift = 0; shift < 64; shift += 7)
+            {
+                if (pos == size)
+                    return true;
+                const unsigned char ch = data[pos++];
+                v |= static_cast<uint64>(ch&0x7F) << shift;
+                if ((ch&0x80) == 0)
+                    return false;
+            }
+            return true;
+        }
+
+        // Map signed values to unsigned ones so that numbers of small magnitude, of
+        // either sign, become small unsigned numbers and therefore short varints.
+        inline uint64 zigzag (int64 v)
+        {
+            return (static_cast<uint64>(v) << 1) ^ (v < 0 ? ~static_cast<uint64>(0) : 0);
+        }
+
+        inline int64 unzigzag (uint64 v)
+        {
+            const uint64 half = v >> 1;
+            return (v&1) ? static_cast<int64>(~half) : static_cast<int64>(half);
+        }
+    }
+
+    template <typename T, typename alloc>
+    void serialize (
+        const compressed_ints_t<const std::vector<T,alloc>>& item_,
+        std::ostream& out
+    )
+    {
+        COMPILE_TIME_ASSERT(std::is_integral<T>::value && sizeof(T) <= 8);
+        try
+        {
+            const std::vector<T,alloc>& item = item_.item;
+
+            // Delta code the values, packing each difference into as few bytes as it
+            // needs.  Everything is buffered up so it hits the stream in one write.
+            std::vector<unsigned char> buf;
+            buf.reserve(item.size() + 16);
+            uint64 prev = 0;
+            for (auto x : item)
+            {
+                // Sign extend signed values so small negative numbers still turn into
+                // small deltas.
+                const uint64 cur = std::numeric_limits<T>::is_signed ? static_cast<uint64>(static_cast<int64>(x))
+                                                                     : static_cast<uint64>(x);
+                ser_helper::append_varint(buf, ser_helper::zigzag(static_cast<int64>(cur - prev)));
+                prev = cur;
+            }
+
+            serialize(static_cast<uint64>(item.size()), out);
+            serialize(buf, out);
+        }
+        catch (serialization_error& e)
+        { throw serialization_error(e.info + "\n   while serializing object of type compressed_ints"); }
+    }
+
+    template <typename T, typename alloc>
+    void serialize (
+        const compressed_ints_t<std::vector<T,alloc>>& item_,
+        std::ostream& out
+    )
+    {
+        // Move the const from outside the vector to inside the compressed_ints_t template
+        // so all serializes funnel into the one overload above.
+        const std::vector<T,alloc>& temp = item_.item;
+        serialize(compressed_ints(temp), out);
+    }
+
+    template <typename T, typename alloc>
+    void deserialize (
+        const compressed_ints_t<std::vector<T,alloc>>& item_,
+        std::istream& in
+    )
+    {
+        COMPILE_TIME_ASSERT(std::is_integral<T>::value && sizeof(T) <= 8);
+        try
+        {
+            std::vector<T,alloc>& item = item_.item;
+
+            uint64 size;
+            deserialize(size, in);
+            std::vector<unsigned char> buf;
+            deserialize(buf, in);
+            if (!in)
+                throw serialization_error("Error reading delta coded integer data from the input stream.");
+
+            // every element takes at least one encoded byte
+            if (size > buf.size())
+                throw serialization_error("Corrupt delta coded integer data.");
+
+            item.clear();
+            item.reserve(static_cast<size_t>(size));
+            uint64 prev = 0;
+            size_t pos = 0;
+            for (uint64 i = 0; i < size; ++i)
+            {
+                uint64 d;
+                if (ser_helper::read_varint(buf.data(), buf.size(), pos, d))
+                    throw serialization_error("Corrupt delta coded integer data.");
+                prev += static_cast<uint64>(ser_helper::unzigzag(d));
+
+                if (std::numeric_limits<T>::is_signed)
+                {
+                    const int64 val = static_cast<int64>(prev);
+                    if (val < static_cast<int64>(std::numeric_limits<T>::min()) ||
+                        val > static_cast<int64>(std::numeric_limits<T>::max()))
+                        throw serialization_error("Deserialized integer is too big to fit into the target vector's value type.");
+                    item.push_back(static_cast<T>(val));
+                }
+                else
+                {
+                    if (prev > static_cast<uint64>(std::numeric_limits<T>::max()))
+                        throw serialization_error("Deserialized integer is too big to fit into the target vector's value type.");
+                    item.push_back(static_cast<T>(prev));
+                }
+            }
+            if (pos != buf.size())
+                throw serialization_error("Corrupt delta coded integer data.");
+        }
+        catch (serialization_error& e)
+        { throw serialization_error(e.info + "\n   while deserializing object of type compressed_ints"); }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <typename T, typename alloc>
@@ -1596,6 +1996,12 @@ namespace dlib
             return doit(std::move(item));
         }
 
+        template <typename T>
+        inline proxy_deserialize& operator>>(compressed_ints_t<T>&& item)
+        {
+            return doit(std::move(item));
+        }
+
     private:
         template <typename T>
         inline proxy_deserialize& doit(T&& item)
@@ -5,6 +5,9 @@
 
 #include "server_kernel.h"
 #include "../string.h"
+#include "../misc_api.h"
+
+#include <algorithm>
 
 namespace dlib
 {
@@ -22,7 +25,9 @@ namespace dlib
         thread_count_signaler(thread_count_mutex),
         max_connections(1000),
         thread_count_zero(thread_count_mutex),
-        graceful_close_timeout(500)
+        graceful_close_timeout(500),
+        connection_rate_limit(0),
+        connection_burst_limit(10)
     {
     }
 
@@ -50,12 +55,70 @@ namespace dlib
     void server::
     set_graceful_close_timeout (
         unsigned long timeout
-    ) 
+    )
     {
         auto_mutex lock(max_connections_mutex);
         graceful_close_timeout = timeout;
     }
 
+// ----------------------------------------------------------------------------------------
+
+    double server::
+    get_connection_rate_limit (
+    ) const
+    {
+        auto_mutex lock(max_connections_mutex);
+        return connection_rate_limit;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server::
+    set_connection_rate_limit (
+        double connections_per_second
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_CASSERT(
+            connections_per_second >= 0 ,
+            "\tvoid server::set_connection_rate_limit"
+            << "\n\tconnections_per_second == " << connections_per_second
+            << "\n\tthis: " << this
+            );
+
+        auto_mutex lock(max_connections_mutex);
+        connection_rate_limit = connections_per_second;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    double server::
+    get_connection_burst_limit (
+    ) const
+    {
+        auto_mutex lock(max_connections_mutex);
+        return connection_burst_limit;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server::
+    set_connection_burst_limit (
+        double burst
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_CASSERT(
+            burst >= 1 ,
+            "\tvoid server::set_connection_burst_limit"
+            << "\n\tburst == " << burst
+            << "\n\tthis: " << this
+            );
+
+        auto_mutex lock(max_connections_mutex);
+        connection_burst_limit = burst;
+    }
+
 // ----------------------------------------------------------------------------------------
 
 
@@ -105,10 +168,12 @@ namespace dlib
         max_connections_mutex.lock();
         listening_port_mutex.lock();
         listening_ip_mutex.lock();
-        listening_ip = "";        
+        listening_ip = "";
         listening_port = 0;
         max_connections = 1000;
         graceful_close_timeout = 500;
+        connection_rate_limit = 0;
+        connection_burst_limit = 10;
         listening_port_mutex.unlock();
         listening_ip_mutex.unlock();
         max_connections_mutex.unlock();
@@ -116,12 +181,9 @@ namespace dlib
 
         // tell all the connections to shut down
         cons_mutex.lock();
-        connection* temp;
-        while (cons.size() > 0)
-        {
-            cons.remove_any(temp);
-            temp->shutdown();
-        }
+        for (connection* con : cons)
+            con->shutdown();
+        cons.clear();
         cons_mutex.unlock();
 
 
@@ -204,10 +266,12 @@ namespace dlib
                 max_connections_mutex.lock();
                 listening_port_mutex.lock();
                 listening_ip_mutex.lock();
-                listening_ip = "";        
+                listening_ip = "";
                 listening_port = 0;
                 max_connections = 1000;
                 graceful_close_timeout = 500;
+                connection_rate_limit = 0;
+                connection_burst_limit = 10;
                 listening_port_mutex.unlock();
                 listening_ip_mutex.unlock();
                 max_connections_mutex.unlock();
@@ -278,14 +342,16 @@ namespace dlib
 
         int status = 0;
 
+        timestamper ts;
         connection* client;
         bool exit = false;
+        unsigned long accept_timeout = 1000;
         while ( true )
         {
 
 
             // accept the next connection
-            status = sock->accept(client,1000);
+            status = sock->accept(client,accept_timeout);
 
 
             // if there was an error then quit the loop
@@ -297,10 +363,10 @@ namespace dlib
             shutting_down_mutex.lock();
             // if we are shutting down then signal that we should quit the loop
             exit = shutting_down;
-            shutting_down_mutex.unlock();  
+            shutting_down_mutex.unlock();
 
 
-            // if we should be shutting down 
+            // if we should be shutting down
             if (exit)
             {
                 // if a connection was opened then close it
@@ -314,20 +380,63 @@ namespace dlib
             // if the accept timed out
             if (status == TIMEOUT)
             {
-                continue;       
+                accept_timeout = 1000;
+                continue;
             }
 
+            // We just accepted a connection, so there may well be more of them queued up
+            // in the listening socket's backlog.  Use a short timeout on the next accept
+            // so we drain the backlog as fast as possible rather than interleaving each
+            // accept with the bookkeeping below.  (A timeout of 0 would mean block
+            // forever, so 1ms is the closest we can get to polling.)
+            accept_timeout = 1;
 
 
+            // if a per source rate limit is set then see if this source has exceeded it
+            const double rate_limit = get_connection_rate_limit();
+            if (rate_limit > 0)
+            {
+                const double burst_limit = get_connection_burst_limit();
+                const uint64 now = ts.get_timestamp();
+                token_bucket& bucket = rate_buckets[client->get_foreign_ip()];
+                if (bucket.last_update == 0)
+                    bucket.tokens = burst_limit;
+                else
+                    bucket.tokens = std::min(burst_limit, bucket.tokens + rate_limit*(now-bucket.last_update)/1000000.0);
+                bucket.last_update = now;
+
+                // Keep the bucket table from growing without bound during a connection
+                // storm by dropping buckets that have fully refilled.  Sources we haven't
+                // heard from in a while behave identically with or without their bucket.
+                if (rate_buckets.size() >= 10000)
+                {
+                    for (auto i = rate_buckets.begin(); i != rate_buckets.end();)
+                    {
+                        if (now - i->second.last_update >= burst_limit/rate_limit*1000000.0)
+                            i = rate_buckets.erase(i);
+                        else
+                            ++i;
+                    }
+                }
+
+                if (bucket.tokens < 1)
+                {
+                    sdlog << LDEBUG << "refusing connection from " << client->get_foreign_ip()
+                        << ": source exceeded its connection rate limit";
+                    delete client;
+                    continue;
+                }
+                bucket.tokens -= 1;
+            }
 
 
             // add this new connection to cons
             cons_mutex.lock();
-            connection* client_temp = client;
-            try{cons.add(client_temp);}
+            try{cons.insert(client);}
             catch(...)
-            { 
+            {
                 sock.reset();
+                rate_buckets.clear();
                 delete client;
                 cons_mutex.unlock();
 
@@ -352,9 +461,10 @@ namespace dlib
                             *client,
                             get_graceful_close_timeout() 
                             );
-            } catch (...) 
+            } catch (...)
             {
                 sock.reset();
+                rate_buckets.clear();
                 delete client;
                 running_mutex.lock();
                 running = false;
@@ -371,14 +481,11 @@ namespace dlib
                 delete temp;
                 // close the listening socket
                 sock.reset();
+                rate_buckets.clear();
 
                 // close the new connection and remove it from cons
                 cons_mutex.lock();
-                connection* ctemp;
-                if (cons.is_member(client))
-                {
-                    cons.remove(client,ctemp);
-                }
+                cons.erase(client);
                 delete client;
                 cons_mutex.unlock();
 
@@ -445,6 +552,7 @@ namespace dlib
 
         // close the socket
         sock.reset();
+        rate_buckets.clear();
 
         // signal that the listener has closed
         running_mutex.lock();
@@ -566,9 +674,7 @@ namespace dlib
 
         // remove this connection from cons and close it
         p.the_server.cons_mutex.lock();
-        connection* temp;
-        if (p.the_server.cons.is_member(&p.new_connection))
-            p.the_server.cons.remove(&p.new_connection,temp);
+        p.the_server.cons.erase(&p.new_connection);
         p.the_server.cons_mutex.unlock();
 
         try{ close_gracefully(&p.new_connection, p.graceful_close_timeout); } 
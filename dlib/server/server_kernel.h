@@ -7,12 +7,14 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "../threads.h"
 #include "../sockets.h"
 #include "../algs.h"
-#include "../set.h"
 #include "../logger.h"
+#include "../uintn.h"
 
 
 namespace dlib
@@ -45,10 +47,14 @@ namespace dlib
                 thread_count_mutex      == a mutex
                 thread_count_signaler   == a signaler associated with thread_count_mutex
                 thread_count_zero       == a signaler associated with thread_count_mutex
-                max_connections         == 1000 
-                max_connections_mutex   == a mutex for max_connections and graceful_close_timeout
-                graceful_close_timeout  == 500 
-             
+                max_connections         == 1000
+                max_connections_mutex   == a mutex for max_connections, graceful_close_timeout,
+                                           connection_rate_limit, and connection_burst_limit
+                graceful_close_timeout  == 500
+                connection_rate_limit   == 0
+                connection_burst_limit  == 10
+                rate_buckets.size()     == 0
+
             CONVENTION
                 listening_port          == get_listening_port()
                 listening_ip            == get_listening_ip()
@@ -77,10 +83,25 @@ namespace dlib
                                            zero
                 max_connections         == get_max_connections()
                 max_connections_mutex   == a mutex for max_connections
+                connection_rate_limit   == get_connection_rate_limit()
+                connection_burst_limit  == get_connection_burst_limit()
+                rate_buckets            == a map from source IP addresses to their token
+                                           bucket states.  It is only touched by the
+                                           thread running start_accepting_connections()
+                                           so it needs no mutex.
         !*/
-        
 
-        typedef set<connection*>::kernel_1a set_of_connections;
+
+        typedef std::unordered_set<connection*> set_of_connections;
+
+        // This structure holds the token bucket state for one source IP address.  Tokens
+        // accumulate at get_connection_rate_limit() tokens per second, up to
+        // get_connection_burst_limit() tokens, and accepting a connection costs one token.
+        struct token_bucket
+        {
+            double tokens = 0;
+            uint64 last_update = 0;
+        };
 
         // this structure is used to pass parameters to new threads
         struct param
@@ -158,6 +179,20 @@ namespace dlib
             unsigned long get_graceful_close_timeout (
             ) const;
 
+            void set_connection_rate_limit (
+                double connections_per_second
+            );
+
+            double get_connection_rate_limit (
+            ) const;
+
+            void set_connection_burst_limit (
+                double burst
+            );
+
+            double get_connection_burst_limit (
+            ) const;
+
         private:
 
             void start_async_helper (
@@ -213,6 +248,9 @@ namespace dlib
             std::unique_ptr<thread_function> async_start_thread;
             std::unique_ptr<listener> sock;
             unsigned long graceful_close_timeout;
+            double connection_rate_limit;
+            double connection_burst_limit;
+            std::unordered_map<std::string,token_bucket> rate_buckets;
 
 
             // restricted functions
@@ -19,7 +19,9 @@ namespace dlib
                 get_listening_port()         == 0
                 is_running()                 == false
                 get_max_connections()        == 1000
-                get_graceful_close_timeout() == 500 
+                get_graceful_close_timeout() == 500
+                get_connection_rate_limit()  == 0
+                get_connection_burst_limit() == 10
 
 
             CALLBACK FUNCTIONS
@@ -56,6 +58,15 @@ namespace dlib
                 open connections drops below get_max_connections().  This means connections
                 will just wait to be serviced, rather than being outright refused.
 
+                In addition to the global connection cap the server can enforce a per
+                source rate limit (see set_connection_rate_limit()).  Each source IP
+                address gets a token bucket holding at most get_connection_burst_limit()
+                tokens which refills at get_connection_rate_limit() tokens per second.
+                Accepting a connection costs one token and a connection from a source
+                whose bucket is empty is closed immediately without ever being given to
+                on_connect().  This lets a server ride out a connection storm from a few
+                misbehaving sources while still servicing everyone else.
+
             THREAD SAFETY
                 All member functions are thread-safe.
         !*/
@@ -265,6 +276,47 @@ namespace dlib
                       connection.  This is the timeout value given to close_gracefully().
             !*/
 
+            void set_connection_rate_limit (
+                double connections_per_second
+            );
+            /*!
+                requires
+                    - connections_per_second >= 0
+                ensures
+                    - #get_connection_rate_limit() == connections_per_second
+            !*/
+
+            double get_connection_rate_limit (
+            ) const;
+            /*!
+                ensures
+                    - returns the long run average number of connections per second the
+                      server will accept from a single source IP address.  A source that
+                      connects faster than this has its excess connections closed
+                      immediately, without them being given to on_connect().
+                    - returns 0 if no per source rate limit is enforced
+            !*/
+
+            void set_connection_burst_limit (
+                double burst
+            );
+            /*!
+                requires
+                    - burst >= 1
+                ensures
+                    - #get_connection_burst_limit() == burst
+            !*/
+
+            double get_connection_burst_limit (
+            ) const;
+            /*!
+                ensures
+                    - returns the number of connections a single source IP address may
+                      open in quick succession before the rate limit of
+                      get_connection_rate_limit() connections per second kicks in.  This
+                      value is irrelevant when get_connection_rate_limit() == 0.
+            !*/
+
         private:
 
             virtual void on_connect (
@@ -0,0 +1,1054 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_SERVER_REACTOR_CPp_
+#define DLIB_SERVER_REACTOR_CPp_
+
+#include "server_reactor.h"
+
+#ifndef _WIN32
+
+#include "../string.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+#include <sys/event.h>
+#include <sys/time.h>
+#else
+#include <poll.h>
+#endif
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+//                              event_poller member functions
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+
+    namespace impl_reactor
+    {
+
+#if defined(__linux__)
+
+        event_poller::
+        event_poller (
+        )
+        {
+            queue_fd = epoll_create1(0);
+            if (queue_fd == -1)
+                throw dlib::socket_error("Unable to create epoll event queue.");
+        }
+
+        event_poller::
+        ~event_poller (
+        )
+        {
+            ::close(queue_fd);
+        }
+
+        void event_poller::
+        add (
+            int fd,
+            uint64 id
+        )
+        {
+            epoll_event ev;
+            ev.events = EPOLLIN;
+            ev.data.u64 = id;
+            epoll_ctl(queue_fd, EPOLL_CTL_ADD, fd, &ev);
+        }
+
+        void event_poller::
+        set_writable (
+            int fd,
+            uint64 id,
+            bool want_write
+        )
+        {
+            epoll_event ev;
+            ev.events = want_write ? (EPOLLIN|EPOLLOUT) : EPOLLIN;
+            ev.data.u64 = id;
+            epoll_ctl(queue_fd, EPOLL_CTL_MOD, fd, &ev);
+        }
+
+        void event_poller::
+        remove (
+            int fd
+        )
+        {
+            // Note that the event argument must be non-null for the sake of
+            // pre-2.6.9 Linux kernels even though it is ignored.
+            epoll_event ev;
+            ev.events = 0;
+            ev.data.u64 = 0;
+            epoll_ctl(queue_fd, EPOLL_CTL_DEL, fd, &ev);
+        }
+
+        unsigned long event_poller::
+        wait (
+            std::vector<event>& events,
+            unsigned long timeout_ms
+        )
+        {
+            events.clear();
+            epoll_event evs[128];
+            const int num = epoll_wait(queue_fd, evs, sizeof(evs)/sizeof(evs[0]), timeout_ms);
+            for (int i = 0; i < num; ++i)
+            {
+                event e;
+                e.id       = evs[i].data.u64;
+                e.readable = (evs[i].events&(EPOLLIN|EPOLLHUP)) != 0;
+                e.writable = (evs[i].events&EPOLLOUT) != 0;
+                e.error    = (evs[i].events&(EPOLLERR|EPOLLHUP)) != 0;
+                events.push_back(e);
+            }
+            return events.size();
+        }
+
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+
+        event_poller::
+        event_poller (
+        )
+        {
+            queue_fd = kqueue();
+            if (queue_fd == -1)
+                throw dlib::socket_error("Unable to create kqueue event queue.");
+        }
+
+        event_poller::
+        ~event_poller (
+        )
+        {
+            ::close(queue_fd);
+        }
+
+        void event_poller::
+        add (
+            int fd,
+            uint64 id
+        )
+        {
+            struct kevent ev;
+            EV_SET(&ev, fd, EVFILT_READ, EV_ADD, 0, 0, reinterpret_cast<void*>(static_cast<uintptr_t>(id)));
+            kevent(queue_fd, &ev, 1, 0, 0, 0);
+        }
+
+        void event_poller::
+        set_writable (
+            int fd,
+            uint64 id,
+            bool want_write
+        )
+        {
+            struct kevent ev;
+            EV_SET(&ev, fd, EVFILT_WRITE, want_write?EV_ADD:EV_DELETE, 0, 0, reinterpret_cast<void*>(static_cast<uintptr_t>(id)));
+            // this can fail with ENOENT when want_write==false and the write filter
+            // was never added, which is fine.
+            kevent(queue_fd, &ev, 1, 0, 0, 0);
+        }
+
+        void event_poller::
+        remove (
+            int fd
+        )
+        {
+            struct kevent evs[2];
+            EV_SET(&evs[0], fd, EVFILT_READ,  EV_DELETE, 0, 0, 0);
+            EV_SET(&evs[1], fd, EVFILT_WRITE, EV_DELETE, 0, 0, 0);
+            kevent(queue_fd, &evs[0], 1, 0, 0, 0);
+            kevent(queue_fd, &evs[1], 1, 0, 0, 0);
+        }
+
+        unsigned long event_poller::
+        wait (
+            std::vector<event>& events,
+            unsigned long timeout_ms
+        )
+        {
+            events.clear();
+            struct kevent evs[128];
+            struct timespec ts;
+            ts.tv_sec  = timeout_ms/1000;
+            ts.tv_nsec = (timeout_ms%1000)*1000000;
+            const int num = kevent(queue_fd, 0, 0, evs, sizeof(evs)/sizeof(evs[0]), &ts);
+            for (int i = 0; i < num; ++i)
+            {
+                event e;
+                e.id       = static_cast<uint64>(reinterpret_cast<uintptr_t>(evs[i].udata));
+                e.readable = evs[i].filter == EVFILT_READ || (evs[i].flags&EV_EOF) != 0;
+                e.writable = evs[i].filter == EVFILT_WRITE;
+                e.error    = (evs[i].flags&EV_ERROR) != 0;
+                events.push_back(e);
+            }
+            return events.size();
+        }
+
+#else // generic POSIX fallback built on poll()
+
+        event_poller::
+        event_poller (
+        )
+        {
+        }
+
+        event_poller::
+        ~event_poller (
+        )
+        {
+        }
+
+        void event_poller::
+        add (
+            int fd,
+            uint64 id
+        )
+        {
+            auto_mutex lock(fds_mutex);
+            fd_info info;
+            info.id = id;
+            info.want_write = false;
+            fds[fd] = info;
+        }
+
+        void event_poller::
+        set_writable (
+            int fd,
+            uint64 id,
+            bool want_write
+        )
+        {
+            auto_mutex lock(fds_mutex);
+            fd_info info;
+            info.id = id;
+            info.want_write = want_write;
+            fds[fd] = info;
+        }
+
+        void event_poller::
+        remove (
+            int fd
+        )
+        {
+            auto_mutex lock(fds_mutex);
+            fds.erase(fd);
+        }
+
+        unsigned long event_poller::
+        wait (
+            std::vector<event>& events,
+            unsigned long timeout_ms
+        )
+        {
+            events.clear();
+            std::vector<pollfd> pfds;
+            std::vector<uint64> ids;
+            {
+                auto_mutex lock(fds_mutex);
+                for (std::map<int,fd_info>::const_iterator i = fds.begin(); i != fds.end(); ++i)
+                {
+                    pollfd p;
+                    p.fd = i->first;
+                    p.events = POLLIN | (i->second.want_write?POLLOUT:0);
+                    p.revents = 0;
+                    pfds.push_back(p);
+                    ids.push_back(i->second.id);
+                }
+            }
+
+            // Note that unlike the epoll and kqueue backends, sockets registered
+            // while we are blocked here won't be noticed until the next call to
+            // wait().  The reactor calls wait() with a short timeout so this just
+            // adds a little latency.
+            if (pfds.size() == 0)
+            {
+                dlib::sleep(timeout_ms);
+                return 0;
+            }
+
+            const int num = poll(&pfds[0], pfds.size(), timeout_ms);
+            if (num <= 0)
+                return 0;
+
+            for (unsigned long i = 0; i < pfds.size(); ++i)
+            {
+                if (pfds[i].revents == 0)
+                    continue;
+                event e;
+                e.id       = ids[i];
+                e.readable = (pfds[i].revents&(POLLIN|POLLHUP)) != 0;
+                e.writable = (pfds[i].revents&POLLOUT) != 0;
+                e.error    = (pfds[i].revents&(POLLERR|POLLHUP|POLLNVAL)) != 0;
+                events.push_back(e);
+            }
+            return events.size();
+        }
+
+#endif
+
+    }
+
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+//                              server_reactor member functions
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+
+    const logger server_reactor::sdlog("dlib.server");
+
+// ----------------------------------------------------------------------------------------
+
+    server_reactor::
+    server_reactor (
+    ) :
+        listening_port(0),
+        running(false),
+        shutting_down(false),
+        num_threads(4),
+        max_connections(10000),
+        next_id(1),
+        running_signaler(running_mutex)
+    {
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    server_reactor::
+    ~server_reactor (
+    )
+    {
+        clear();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    clear (
+    )
+    {
+        // signal that we are shutting down
+        shutting_down_mutex.lock();
+        shutting_down = true;
+        shutting_down_mutex.unlock();
+
+        // tell all the connections to shut down.  Their on_connection_closed()
+        // callbacks run on the worker pool before the pool is destroyed below.
+        {
+            auto_mutex lock(cons_mutex);
+            for (std::map<connection_id,conn_ptr>::iterator i = cons.begin(); i != cons.end(); ++i)
+            {
+                auto_mutex lock2(i->second->m);
+                abort_connection(i->second);
+            }
+        }
+
+        // wait for the main loop to terminate
+        running_mutex.lock();
+        while (running == true)
+        {
+            running_signaler.wait();
+        }
+        running_mutex.unlock();
+
+        // signal that the shutdown is complete
+        shutting_down_mutex.lock();
+        shutting_down = false;
+        shutting_down_mutex.unlock();
+
+        // set everything back to its default value
+        settings_mutex.lock();
+        listening_port_mutex.lock();
+        listening_ip_mutex.lock();
+        listening_ip = "";
+        listening_port = 0;
+        max_connections = 10000;
+        num_threads = 4;
+        listening_ip_mutex.unlock();
+        listening_port_mutex.unlock();
+        settings_mutex.unlock();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    start_async_helper (
+    )
+    {
+        try
+        {
+            run_main_loop();
+        }
+        catch (std::exception& e)
+        {
+            sdlog << LERROR << e.what();
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    start_async (
+    )
+    {
+        auto_mutex lock(running_mutex);
+        if (running)
+            return;
+
+        // Any exceptions likely to be thrown by the server are going to be
+        // thrown when trying to bind the port.  So calling this here rather
+        // than in the thread we are about to make will cause start_async()
+        // to report errors back to the user in a very straight forward way.
+        open_listening_socket();
+
+        async_start_thread.reset(new thread_function(make_mfp(*this,&server_reactor::start_async_helper)));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    start (
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_CASSERT(
+              this->is_running() == false,
+            "\tvoid server_reactor::start"
+            << "\n\tis_running() == " << this->is_running()
+            << "\n\tthis: " << this
+            );
+
+        run_main_loop();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    open_listening_socket (
+    )
+    {
+        if (!sock)
+        {
+            int status = create_listener(sock,listening_port,listening_ip);
+            const int port_used = listening_port;
+
+            // if there was an error then clear this object
+            if (status < 0)
+            {
+                settings_mutex.lock();
+                listening_port_mutex.lock();
+                listening_ip_mutex.lock();
+                listening_ip = "";
+                listening_port = 0;
+                max_connections = 10000;
+                num_threads = 4;
+                listening_ip_mutex.unlock();
+                listening_port_mutex.unlock();
+                settings_mutex.unlock();
+            }
+
+            // throw an exception for the error
+            if (status == PORTINUSE)
+            {
+                throw dlib::socket_error(
+                    EPORT_IN_USE,
+                    "error occurred in server_reactor::start()\nport " + cast_to_string(port_used) + " already in use"
+                );
+            }
+            else if (status == OTHER_ERROR)
+            {
+                throw dlib::socket_error(
+                    "error occurred in server_reactor::start()\nunable to create listener"
+                );
+            }
+        }
+
+        running_mutex.lock();
+        running = true;
+        running_mutex.unlock();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    run_main_loop (
+    )
+    {
+        open_listening_socket();
+
+        // determine the listening port
+        bool port_assigned = false;
+        listening_port_mutex.lock();
+        if (listening_port == 0)
+        {
+            port_assigned = true;
+            listening_port = sock->get_listening_port();
+        }
+        listening_port_mutex.unlock();
+        if (port_assigned)
+            on_listening_port_assigned();
+
+        {
+            auto_mutex lock(settings_mutex);
+            poller.reset(new impl_reactor::event_poller());
+            workers.reset(new thread_pool(num_threads));
+        }
+
+        reactor.reset(new thread_function(make_mfp(*this,&server_reactor::reactor_thread)));
+
+        // accept connections in this thread until clear() is called
+        accept_thread();
+
+        // close the listening socket
+        sock.reset();
+
+        // wait for the reactor thread to terminate.  It notices should_shutdown()
+        // within one poller timeout.
+        reactor.reset();
+
+        // shut down any connections that got accepted while we were already
+        // shutting down, so every connection gets its closed callback.
+        {
+            auto_mutex lock(cons_mutex);
+            for (std::map<connection_id,conn_ptr>::iterator i = cons.begin(); i != cons.end(); ++i)
+            {
+                auto_mutex lock2(i->second->m);
+                abort_connection(i->second);
+            }
+        }
+
+        // wait for all the outstanding handler tasks to finish
+        workers.reset();
+
+        {
+            auto_mutex lock(cons_mutex);
+            cons.clear();
+        }
+        poller.reset();
+
+        // signal that the server has stopped
+        running_mutex.lock();
+        running = false;
+        running_signaler.broadcast();
+        running_mutex.unlock();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    accept_thread (
+    )
+    {
+        while (true)
+        {
+            // accept the next connection
+            std::unique_ptr<connection> new_con;
+            const int status = sock->accept(new_con, 1000);
+
+            // if there was an error then quit the loop
+            if (status == OTHER_ERROR)
+            {
+                break;
+            }
+
+            // if we are shutting down then quit the loop.  Note that new_con's
+            // destructor closes any connection we just accepted.
+            if (should_shutdown())
+            {
+                break;
+            }
+
+            // if the accept timed out
+            if (status == TIMEOUT)
+            {
+                continue;
+            }
+
+            // make sure we aren't at the max connection limit
+            {
+                auto_mutex lock(settings_mutex);
+                auto_mutex lock2(cons_mutex);
+                if (max_connections != 0 && cons.size() >= static_cast<size_t>(max_connections))
+                {
+                    sdlog << LINFO << "max connections reached, dropping connection from " << new_con->get_foreign_ip();
+                    continue;
+                }
+            }
+
+            // the reactor requires non-blocking sockets
+            const int fd = new_con->get_socket_descriptor();
+            const int flags = fcntl(fd, F_GETFL, 0);
+            if (flags == -1 || fcntl(fd, F_SETFL, flags|O_NONBLOCK) == -1)
+            {
+                sdlog << LWARN << "unable to put accepted connection into non-blocking mode";
+                continue;
+            }
+
+            conn_ptr sp = std::make_shared<conn_state>();
+            sp->fd = fd;
+            sp->foreign_ip = new_con->get_foreign_ip();
+            sp->foreign_port = new_con->get_foreign_port();
+            sp->con = std::move(new_con);
+            {
+                auto_mutex lock(cons_mutex);
+                sp->id = next_id++;
+                cons[sp->id] = sp;
+            }
+
+            // queue the on_connection_opened() callback, then let the reactor
+            // watch the socket.
+            {
+                auto_mutex lock(sp->m);
+                schedule_handler(sp);
+            }
+            poller->add(sp->fd, sp->id);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    reactor_thread (
+    )
+    {
+        std::vector<impl_reactor::event_poller::event> events;
+        while (!should_shutdown())
+        {
+            poller->wait(events, 100);
+            for (unsigned long i = 0; i < events.size(); ++i)
+            {
+                conn_ptr sp = lookup(events[i].id);
+                if (!sp)
+                    continue;
+
+                if (events[i].writable)
+                {
+                    auto_mutex lock(sp->m);
+                    if (!sp->close_done)
+                        flush_outbuf(sp);
+                }
+
+                if (events[i].readable || events[i].error)
+                    handle_readable(sp);
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    handle_readable (
+        conn_ptr& sp
+    )
+    {
+        char buf[4096];
+        auto_mutex lock(sp->m);
+        if (sp->peer_closed || sp->close_done)
+            return;
+
+        while (true)
+        {
+            const long num = ::recv(sp->fd, buf, sizeof(buf), 0);
+            if (num > 0)
+            {
+                sp->inbuf.insert(sp->inbuf.end(), buf, buf+num);
+                continue;
+            }
+
+            if (num < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    break;
+            }
+
+            // The peer closed the connection or the socket died.  Stop reading and
+            // close our end once anything still buffered for output is flushed.
+            sp->peer_closed = true;
+            if (sp->outbuf_sent == sp->outbuf.size())
+                abort_connection(sp);
+            else
+                sp->close_when_flushed = true;
+            break;
+        }
+
+        if (sp->inbuf.size() != 0)
+            schedule_handler(sp);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    flush_outbuf (
+        conn_ptr& sp
+    )
+    {
+        while (sp->outbuf_sent < sp->outbuf.size())
+        {
+            const long num = ::send(sp->fd, &sp->outbuf[sp->outbuf_sent], sp->outbuf.size()-sp->outbuf_sent, 0);
+            if (num > 0)
+            {
+                sp->outbuf_sent += num;
+                continue;
+            }
+
+            if (num < 0 && errno == EINTR)
+                continue;
+
+            if (num < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                // ask the reactor to tell us when the socket can take more data
+                if (!sp->want_write)
+                {
+                    sp->want_write = true;
+                    poller->set_writable(sp->fd, sp->id, true);
+                }
+                return;
+            }
+
+            // the connection is dead
+            abort_connection(sp);
+            return;
+        }
+
+        // everything is flushed
+        sp->outbuf.clear();
+        sp->outbuf_sent = 0;
+        if (sp->want_write)
+        {
+            sp->want_write = false;
+            poller->set_writable(sp->fd, sp->id, false);
+        }
+
+        if (sp->close_when_flushed)
+            abort_connection(sp);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    abort_connection (
+        conn_ptr& sp
+    )
+    {
+        if (!sp->close_done)
+        {
+            sp->close_done = true;
+            sp->peer_closed = true;
+            if (poller)
+                poller->remove(sp->fd);
+            sp->con->shutdown();
+        }
+        sp->outbuf.clear();
+        sp->outbuf_sent = 0;
+        schedule_handler(sp);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    schedule_handler (
+        conn_ptr& sp
+    )
+    {
+        if (sp->handler_scheduled || !workers)
+            return;
+
+        sp->handler_scheduled = true;
+        server_reactor* self = this;
+        conn_ptr conn = sp;
+        workers->add_task_by_value([self,conn]() { self->process_handler_events(conn); });
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    process_handler_events (
+        conn_ptr sp
+    )
+    {
+        while (true)
+        {
+            enum { do_nothing, do_opened, do_data, do_closed } action = do_nothing;
+            std::vector<char> data;
+            {
+                auto_mutex lock(sp->m);
+                if (!sp->opened_reported)
+                {
+                    sp->opened_reported = true;
+                    action = do_opened;
+                }
+                else if (sp->inbuf.size() != 0)
+                {
+                    data.swap(sp->inbuf);
+                    action = do_data;
+                }
+                else if (sp->close_done && !sp->closed_reported)
+                {
+                    sp->closed_reported = true;
+                    action = do_closed;
+                }
+                else
+                {
+                    sp->handler_scheduled = false;
+                    return;
+                }
+            }
+
+            try
+            {
+                if (action == do_opened)
+                {
+                    on_connection_opened(sp->id, sp->foreign_ip, sp->foreign_port);
+                }
+                else if (action == do_data)
+                {
+                    on_data(sp->id, data);
+                }
+                else
+                {
+                    on_connection_closed(sp->id);
+                    auto_mutex lock(cons_mutex);
+                    cons.erase(sp->id);
+                    return;
+                }
+            }
+            catch (std::exception& e)
+            {
+                sdlog << LERROR << "exception thrown in server_reactor callback: " << e.what();
+                auto_mutex lock(sp->m);
+                abort_connection(sp);
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    write (
+        connection_id id,
+        const char* buf,
+        size_t num
+    )
+    {
+        conn_ptr sp = lookup(id);
+        if (!sp)
+            return;
+
+        auto_mutex lock(sp->m);
+        if (sp->peer_closed || sp->close_when_flushed || sp->close_done)
+            return;
+
+        sp->outbuf.insert(sp->outbuf.end(), buf, buf+num);
+        flush_outbuf(sp);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    write (
+        connection_id id,
+        const std::string& data
+    )
+    {
+        write(id, data.data(), data.size());
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    close_connection (
+        connection_id id
+    )
+    {
+        conn_ptr sp = lookup(id);
+        if (!sp)
+            return;
+
+        auto_mutex lock(sp->m);
+        if (sp->outbuf_sent < sp->outbuf.size())
+            sp->close_when_flushed = true;
+        else
+            abort_connection(sp);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    server_reactor::conn_ptr server_reactor::
+    lookup (
+        connection_id id
+    ) const
+    {
+        auto_mutex lock(cons_mutex);
+        std::map<connection_id,conn_ptr>::const_iterator i = cons.find(id);
+        if (i != cons.end())
+            return i->second;
+        return conn_ptr();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    bool server_reactor::
+    should_shutdown (
+    ) const
+    {
+        auto_mutex lock(shutting_down_mutex);
+        return shutting_down;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    bool server_reactor::
+    is_running (
+    ) const
+    {
+        auto_mutex lock(running_mutex);
+        return running;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    const std::string server_reactor::
+    get_listening_ip (
+    ) const
+    {
+        auto_mutex lock(listening_ip_mutex);
+        return listening_ip;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    int server_reactor::
+    get_listening_port (
+    ) const
+    {
+        auto_mutex lock(listening_port_mutex);
+        return listening_port;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    set_listening_port (
+        int port
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_CASSERT(
+            ( port >= 0 &&
+              this->is_running() == false ),
+            "\tvoid server_reactor::set_listening_port"
+            << "\n\tport         == " << port
+            << "\n\tis_running() == " << this->is_running()
+            << "\n\tthis: " << this
+            );
+
+        auto_mutex lock(listening_port_mutex);
+        listening_port = port;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    set_listening_ip (
+        const std::string& ip
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_CASSERT(
+            ( ( is_ip_address(ip) || ip == "" ) &&
+              this->is_running() == false ),
+            "\tvoid server_reactor::set_listening_ip"
+            << "\n\tip           == " << ip
+            << "\n\tis_running() == " << this->is_running()
+            << "\n\tthis: " << this
+            );
+
+        auto_mutex lock(listening_ip_mutex);
+        listening_ip = ip;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    unsigned long server_reactor::
+    get_num_threads (
+    ) const
+    {
+        auto_mutex lock(settings_mutex);
+        return num_threads;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    set_num_threads (
+        unsigned long num
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_CASSERT(
+            ( num > 0 &&
+              this->is_running() == false ),
+            "\tvoid server_reactor::set_num_threads"
+            << "\n\tnum          == " << num
+            << "\n\tis_running() == " << this->is_running()
+            << "\n\tthis: " << this
+            );
+
+        auto_mutex lock(settings_mutex);
+        num_threads = num;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    int server_reactor::
+    get_max_connections (
+    ) const
+    {
+        auto_mutex lock(settings_mutex);
+        return max_connections;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void server_reactor::
+    set_max_connections (
+        int max
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_CASSERT(
+            max >= 0 ,
+            "\tvoid server_reactor::set_max_connections"
+            << "\n\tmax == " << max
+            << "\n\tthis: " << this
+            );
+
+        auto_mutex lock(settings_mutex);
+        max_connections = max;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    size_t server_reactor::
+    number_of_connections (
+    ) const
+    {
+        auto_mutex lock(cons_mutex);
+        return cons.size();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // _WIN32
+
+#endif // DLIB_SERVER_REACTOR_CPp_
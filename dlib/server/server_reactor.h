@@ -0,0 +1,414 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_SERVER_REACTOr_H_
+#define DLIB_SERVER_REACTOr_H_
+
+#include "server_reactor_abstract.h"
+
+// This component drives its sockets with the operating system's scalable event
+// notification facility, so it is only available on POSIX systems.
+#ifndef _WIN32
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../threads.h"
+#include "../sockets.h"
+#include "../algs.h"
+#include "../logger.h"
+#include "../uintn.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl_reactor
+    {
+        class event_poller : noncopyable
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is a thin wrapper around the operating system's scalable socket
+                    readiness facility (epoll on Linux, kqueue on the BSDs and macOS,
+                    and poll() elsewhere).  Each registered socket carries a 64bit id
+                    that comes back in the events reported by wait().  All the member
+                    functions are safe to call concurrently with a wait() in progress
+                    on another thread.
+            !*/
+        public:
+
+            struct event
+            {
+                uint64 id;
+                bool readable;
+                bool writable;
+                bool error;
+            };
+
+            event_poller();
+            /*!
+                ensures
+                    - creates the underlying kernel event queue
+                throws
+                    - dlib::socket_error if the event queue can't be created.
+            !*/
+
+            ~event_poller();
+
+            void add (
+                int fd,
+                uint64 id
+            );
+            /*!
+                ensures
+                    - registers fd for read readiness events tagged with the given id.
+            !*/
+
+            void set_writable (
+                int fd,
+                uint64 id,
+                bool want_write
+            );
+            /*!
+                requires
+                    - add(fd,id) has been called
+                ensures
+                    - if (want_write) then
+                        - wait() will also report write readiness for fd
+                    - else
+                        - wait() only reports read readiness for fd
+            !*/
+
+            void remove (
+                int fd
+            );
+            /*!
+                ensures
+                    - fd is no longer registered with this object.
+            !*/
+
+            unsigned long wait (
+                std::vector<event>& events,
+                unsigned long timeout_ms
+            );
+            /*!
+                ensures
+                    - blocks until at least one registered socket becomes ready or
+                      timeout_ms milliseconds pass.
+                    - #events == the ready sockets (possibly none on timeout)
+                    - returns #events.size()
+            !*/
+
+        private:
+#if defined(__linux__)
+            int queue_fd;
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+            int queue_fd;
+#else
+            // fallback backend built on poll()
+            struct fd_info
+            {
+                uint64 id;
+                bool want_write;
+            };
+            std::map<int,fd_info> fds;
+            mutex fds_mutex;
+#endif
+        };
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class server_reactor
+    {
+
+        /*!
+            INITIAL VALUE
+                - listening_port == 0
+                - listening_ip == ""
+                - running == false
+                - shutting_down == false
+                - num_threads == 4
+                - max_connections == 10000
+                - cons.size() == 0
+                - next_id == 1
+
+            CONVENTION
+                - listening_port == get_listening_port()
+                - listening_ip == get_listening_ip()
+                - running == is_running()
+                - num_threads == get_num_threads()
+                - max_connections == get_max_connections()
+                - cons == a map from connection id to the state of every open
+                  connection.
+                - For each connection, at most one handler task is queued on workers at
+                  a time (the handler_scheduled flag).  This is what serializes the
+                  on_data()/on_connection_opened()/on_connection_closed() callbacks for
+                  a connection.
+                - The reactor thread is the only thread that reads from sockets.  Writes
+                  happen directly in write() when the socket can take them and are
+                  otherwise finished by the reactor thread when the socket becomes
+                  writable again.
+        !*/
+
+        struct conn_state
+        {
+            conn_state() :
+                fd(-1),
+                id(0),
+                foreign_port(0),
+                outbuf_sent(0),
+                want_write(false),
+                handler_scheduled(false),
+                opened_reported(false),
+                peer_closed(false),
+                closed_reported(false),
+                close_when_flushed(false),
+                close_done(false)
+            {}
+
+            int fd;
+            uint64 id;
+            std::string foreign_ip;
+            unsigned short foreign_port;
+            std::vector<char> inbuf;    // bytes read off the socket, waiting for on_data()
+            std::vector<char> outbuf;   // bytes waiting to be written to the socket
+            size_t outbuf_sent;         // how much of outbuf has already been written
+            bool want_write;            // true when the poller watches for writability
+            bool handler_scheduled;     // true when a handler task is queued or running
+            bool opened_reported;       // on_connection_opened() has been called
+            bool peer_closed;           // the socket is dead, no more reads or writes
+            bool closed_reported;       // on_connection_closed() has been called
+            bool close_when_flushed;    // close the socket once outbuf drains
+            bool close_done;            // socket shut down and removed from the poller
+            std::unique_ptr<connection> con;
+            mutex m;
+        };
+
+        typedef std::shared_ptr<conn_state> conn_ptr;
+
+    public:
+
+        typedef uint64 connection_id;
+
+        server_reactor(
+        );
+
+        virtual ~server_reactor(
+        );
+
+        void clear(
+        );
+
+        void start (
+        );
+
+        void start_async (
+        );
+
+        bool is_running (
+        ) const;
+
+        const std::string get_listening_ip (
+        ) const;
+
+        int get_listening_port (
+        ) const;
+
+        void set_listening_port (
+            int port
+        );
+
+        void set_listening_ip (
+            const std::string& ip
+        );
+
+        unsigned long get_num_threads (
+        ) const;
+
+        void set_num_threads (
+            unsigned long num
+        );
+
+        int get_max_connections (
+        ) const;
+
+        void set_max_connections (
+            int max
+        );
+
+        size_t number_of_connections (
+        ) const;
+
+        void write (
+            connection_id id,
+            const char* buf,
+            size_t num
+        );
+
+        void write (
+            connection_id id,
+            const std::string& data
+        );
+
+        void close_connection (
+            connection_id id
+        );
+
+    private:
+
+        virtual void on_data (
+            connection_id id,
+            std::vector<char>& data
+        )=0;
+
+        virtual void on_connection_opened (
+            connection_id ,
+            const std::string& ,
+            unsigned short
+        ) {}
+
+        virtual void on_connection_closed (
+            connection_id
+        ) {}
+
+        virtual void on_listening_port_assigned (
+        ) {}
+
+        void open_listening_socket (
+        );
+
+        void start_async_helper (
+        );
+
+        void run_main_loop (
+        );
+        /*!
+            ensures
+                - opens the listening socket, spins up the reactor thread and worker
+                  pool, then accepts connections in the calling thread until clear()
+                  is called.  Tears everything back down before returning.
+        !*/
+
+        void accept_thread (
+        );
+
+        void reactor_thread (
+        );
+
+        void handle_readable (
+            conn_ptr& sp
+        );
+        /*!
+            ensures
+                - drains the socket into sp->inbuf and schedules a handler task if
+                  anything arrived.  Begins closing the connection if the socket hit
+                  EOF or died.
+        !*/
+
+        void flush_outbuf (
+            conn_ptr& sp
+        );
+        /*!
+            requires
+                - sp->m is locked
+                - sp->close_done == false
+            ensures
+                - writes as much of sp->outbuf to the socket as it will take and asks
+                  the poller for writability notifications if some of it is left over.
+        !*/
+
+        void process_handler_events (
+            conn_ptr sp
+        );
+        /*!
+            ensures
+                - runs on a worker thread.  Calls on_connection_opened(), on_data(),
+                  and finally on_connection_closed() for this connection as the
+                  corresponding events become available, then clears the connection's
+                  handler_scheduled flag.
+        !*/
+
+        void schedule_handler (
+            conn_ptr& sp
+        );
+        /*!
+            requires
+                - sp->m is locked
+            ensures
+                - if (no handler task is queued or running for this connection) then
+                    - queues one on the worker pool
+        !*/
+
+        void abort_connection (
+            conn_ptr& sp
+        );
+        /*!
+            requires
+                - sp->m is locked
+            ensures
+                - the socket is shut down, removed from the poller, and a handler task
+                  is scheduled so on_connection_closed() gets called.
+        !*/
+
+        conn_ptr lookup (
+            connection_id id
+        ) const;
+        /*!
+            ensures
+                - if (id refers to an open connection) then
+                    - returns its state
+                - else
+                    - returns an empty pointer
+        !*/
+
+        bool should_shutdown (
+        ) const;
+
+        const static logger sdlog;
+
+        // data members
+        int listening_port;
+        std::string listening_ip;
+        bool running;
+        bool shutting_down;
+        unsigned long num_threads;
+        int max_connections;
+        uint64 next_id;
+        std::map<connection_id,conn_ptr> cons;
+
+        mutable mutex listening_port_mutex;
+        mutable mutex listening_ip_mutex;
+        mutable rmutex running_mutex;
+        rsignaler running_signaler;
+        mutable mutex shutting_down_mutex;
+        mutable mutex cons_mutex;
+        mutable mutex settings_mutex;
+
+        std::unique_ptr<impl_reactor::event_poller> poller;
+        std::unique_ptr<thread_pool> workers;
+        std::unique_ptr<listener> sock;
+        std::unique_ptr<thread_function> async_start_thread;
+        std::unique_ptr<thread_function> reactor;
+
+        // restricted functions
+        server_reactor(server_reactor&);
+        server_reactor& operator= (
+            server_reactor&
+            );
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#ifdef NO_MAKEFILE
+#include "server_reactor.cpp"
+#endif
+
+#endif // _WIN32
+
+#endif // DLIB_SERVER_REACTOr_H_
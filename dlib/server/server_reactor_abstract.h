@@ -0,0 +1,342 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_SERVER_REACTOr_ABSTRACT_
+#ifdef DLIB_SERVER_REACTOr_ABSTRACT_
+
+#include <string>
+#include <vector>
+#include "../uintn.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class server_reactor
+    {
+        /*!
+            INITIAL VALUE
+                get_listening_ip()    == ""
+                get_listening_port()  == 0
+                is_running()          == false
+                get_num_threads()     == 4
+                get_max_connections() == 10000
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is an event driven TCP server.  Where the server object
+                dedicates a thread to each open connection, this one multiplexes all
+                of its connections onto a single reactor thread using the operating
+                system's scalable readiness facility (epoll on Linux and kqueue on
+                macOS and the BSDs).  That means the per connection cost is just a
+                little bookkeeping rather than a thread stack, so one process can
+                comfortably hold tens of thousands of mostly idle connections.
+
+                To use it, inherit from it and implement on_data(), which is handed
+                each chunk of bytes as it arrives.  Replies are sent with write()
+                and connections are ended with close_connection().  The callbacks
+                run on a small fixed pool of worker threads (get_num_threads() of
+                them), so slow request processing doesn't stall the reactor.  For
+                any one connection the callbacks are serialized: you will never get
+                two overlapping calls for the same connection, and
+                on_connection_opened() always comes first and
+                on_connection_closed() always comes last.  Callbacks for different
+                connections do run concurrently, so anything they share must be
+                protected in the usual way.
+
+                Note that unlike the server object there is no iostream per
+                connection.  on_data() gives you raw bytes with no framing, exactly
+                as recv() produced them, and it is up to your protocol to decide
+                when a full message has arrived.
+
+                This component is only available on POSIX systems.  On Windows it
+                isn't defined and you should use the server object instead.
+
+            THREAD SAFETY
+                All the member functions may be called from any thread, including
+                from inside the on_data() callback.
+        !*/
+
+    public:
+
+        typedef uint64 connection_id;
+        /*!
+            Each connection accepted by this object is identified by a unique
+            connection_id.  Ids are never reused during the lifetime of a
+            server_reactor instance.
+        !*/
+
+        server_reactor(
+        );
+        /*!
+            ensures
+                - #*this is properly initialized
+            throws
+                - std::bad_alloc
+                - dlib::thread_error
+        !*/
+
+        virtual ~server_reactor(
+        );
+        /*!
+            requires
+                - is not called from any of this object's callbacks
+            ensures
+                - all resources associated with *this have been released
+                - Note that, just like the server object, your derived class
+                  destructor runs before the one defined here.  So if handler
+                  callbacks might still be running you should call clear() in your
+                  own destructor to avoid them executing on a half destructed
+                  object.
+        !*/
+
+        void clear(
+        );
+        /*!
+            requires
+                - is not called from any of this object's callbacks
+            ensures
+                - #*this has its initial value
+                - all open connections are shut down and each gets a final call to
+                  on_connection_closed()
+                - blocks until the server has stopped and all callbacks have
+                  finished
+            throws
+                - std::bad_alloc or dlib::thread_error
+                    If either of these exceptions are thrown then the server will
+                    still be shut down but its state may not be properly cleared.
+        !*/
+
+        void start (
+        );
+        /*!
+            requires
+                - is_running() == false
+            ensures
+                - starts accepting connections and dispatching callbacks
+                - blocks until clear() is called
+            throws
+                - dlib::socket_error
+                    This exception is thrown if there is some problem that prevents
+                    us from creating the listening socket or if the port is in use.
+                - std::bad_alloc or dlib::thread_error
+        !*/
+
+        void start_async (
+        );
+        /*!
+            ensures
+                - starts the server just like start() would but does it in a
+                  background thread and returns right away.  Calling clear() shuts
+                  it back down.
+                - if (is_running() == true) then
+                    - this call has no effect
+            throws
+                - dlib::socket_error
+                    This exception is thrown if there is some problem that prevents
+                    us from creating the listening socket or if the port is in use.
+                - std::bad_alloc or dlib::thread_error
+        !*/
+
+        bool is_running (
+        ) const;
+        /*!
+            ensures
+                - returns true if this object is accepting connections, false
+                  otherwise
+        !*/
+
+        const std::string get_listening_ip (
+        ) const;
+        /*!
+            ensures
+                - returns the local ip to listen for incoming connections on.  The
+                  empty string means listen on all interfaces.
+        !*/
+
+        int get_listening_port (
+        ) const;
+        /*!
+            ensures
+                - returns the local port number to listen for incoming connections
+                  on.  A value of 0 means a port number will be assigned by the
+                  operating system when the server starts.
+        !*/
+
+        void set_listening_port (
+            int port
+        );
+        /*!
+            requires
+                - port >= 0
+                - is_running() == false
+            ensures
+                - #get_listening_port() == port
+        !*/
+
+        void set_listening_ip (
+            const std::string& ip
+        );
+        /*!
+            requires
+                - is_ip_address(ip) == true or ip == ""
+                - is_running() == false
+            ensures
+                - #get_listening_ip() == ip
+        !*/
+
+        unsigned long get_num_threads (
+        ) const;
+        /*!
+            ensures
+                - returns the number of worker threads the callbacks run on
+        !*/
+
+        void set_num_threads (
+            unsigned long num
+        );
+        /*!
+            requires
+                - num > 0
+                - is_running() == false
+            ensures
+                - #get_num_threads() == num
+        !*/
+
+        int get_max_connections (
+        ) const;
+        /*!
+            ensures
+                - returns the maximum number of connections the server will accept
+                  at a time
+                - 0 means it will accept any number of connections
+        !*/
+
+        void set_max_connections (
+            int max
+        );
+        /*!
+            requires
+                - max >= 0
+            ensures
+                - #get_max_connections() == max
+        !*/
+
+        size_t number_of_connections (
+        ) const;
+        /*!
+            ensures
+                - returns the number of connections currently open
+        !*/
+
+        void write (
+            connection_id id,
+            const char* buf,
+            size_t num
+        );
+        /*!
+            requires
+                - buf points to num valid bytes of memory
+            ensures
+                - queues the given bytes for transmission to the given connection.
+                  As much as possible is written to the socket immediately and the
+                  rest is buffered and sent as the socket drains, so this call
+                  never blocks on a slow client.
+                - if (id doesn't refer to an open connection) then
+                    - this call has no effect
+        !*/
+
+        void write (
+            connection_id id,
+            const std::string& data
+        );
+        /*!
+            ensures
+                - performs write(id, data.data(), data.size())
+        !*/
+
+        void close_connection (
+            connection_id id
+        );
+        /*!
+            ensures
+                - closes the given connection once everything previously passed to
+                  write() for it has been transmitted.  on_connection_closed() will
+                  be called for it.
+                - if (id doesn't refer to an open connection) then
+                    - this call has no effect
+        !*/
+
+    private:
+
+        virtual void on_data (
+            connection_id id,
+            std::vector<char>& data
+        )=0;
+        /*!
+            requires
+                - data.size() > 0
+                - is called when bytes arrive on a connection.  data holds
+                  everything that has arrived since the last call for this
+                  connection.  No framing is applied, so a single logical message
+                  may be split across calls and several may be packed into one.
+                - runs on one of the worker threads
+                - calls for the same connection never overlap, calls for different
+                  connections can
+            ensures
+                - does not block for long periods of time.  Every call that blocks
+                  occupies one of the get_num_threads() worker threads, and if all
+                  of them are blocked no callbacks run at all.
+            throws
+                - does not throw any exceptions.  If an exception does leave this
+                  callback then it is logged and the offending connection is
+                  closed.
+        !*/
+
+        virtual void on_connection_opened (
+            connection_id id,
+            const std::string& foreign_ip,
+            unsigned short foreign_port
+        ) {}
+        /*!
+            requires
+                - is called when a new connection is accepted, before any calls to
+                  on_data() for it
+                - runs on one of the worker threads
+            ensures
+                - the same restrictions as on_data() apply
+        !*/
+
+        virtual void on_connection_closed (
+            connection_id id
+        ) {}
+        /*!
+            requires
+                - is called after a connection is closed, whether by the remote
+                  host, by close_connection(), or by clear().  It is the last
+                  callback for that connection and its id is invalid afterwards.
+                - runs on one of the worker threads
+            ensures
+                - the same restrictions as on_data() apply
+        !*/
+
+        virtual void on_listening_port_assigned (
+        ) {}
+        /*!
+            requires
+                - is called if get_listening_port() == 0 when the server starts and
+                  the operating system has just picked a port number, which
+                  get_listening_port() now returns.
+            ensures
+                - the same restrictions as on_data() apply
+        !*/
+
+        // restricted functions
+        server_reactor(server_reactor&);        // copy constructor
+        server_reactor& operator=(server_reactor&);    // assignment operator
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_SERVER_REACTOr_ABSTRACT_
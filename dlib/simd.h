@@ -7,6 +7,8 @@
 #include "simd/simd4i.h"
 #include "simd/simd8f.h"
 #include "simd/simd8i.h"
+#include "simd/simd16f.h"
+#include "simd/simd16i.h"
 
 #endif // DLIB_SIMd_Hh_
 
@@ -0,0 +1,410 @@
+// Copyright (C) 2013  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_sIMD16F_Hh_
+#define DLIB_sIMD16F_Hh_
+
+#include "simd_check.h"
+#include "simd8f.h"
+#include "simd16i.h"
+
+namespace dlib
+{
+#ifdef DLIB_HAVE_AVX512F
+    class simd16f
+    {
+    public:
+        typedef float type;
+
+        inline simd16f() {}
+        inline simd16f(const simd8f& low, const simd8f& high)
+        {
+            // Only the f64x4 insert/extract forms exist in plain AVX-512F (the
+            // f32x8 forms need AVX-512DQ), so move the halves around as doubles.
+            x = _mm512_castpd_ps(_mm512_insertf64x4(
+                    _mm512_castps_pd(_mm512_castps256_ps512(low)),_mm256_castps_pd(high),1));
+        }
+        inline simd16f(float f) { x = _mm512_set1_ps(f); }
+        inline simd16f(float r0,  float r1,  float r2,  float r3,
+                       float r4,  float r5,  float r6,  float r7,
+                       float r8,  float r9,  float r10, float r11,
+                       float r12, float r13, float r14, float r15)
+        { x = _mm512_setr_ps(r0,r1,r2,r3,r4,r5,r6,r7,r8,r9,r10,r11,r12,r13,r14,r15); }
+
+        inline simd16f(const simd16i& val):x(_mm512_cvtepi32_ps(val)) {}
+        inline simd16f(const __m512& val):x(val) {}
+        inline simd16f& operator=(const __m512& val)
+        {
+            x = val;
+            return *this;
+        }
+        inline operator __m512() const { return x; }
+
+        // truncate to 32bit integers
+        inline operator __m512i() const { return _mm512_cvttps_epi32(x); }
+
+        inline void load_aligned(const type* ptr)  { x = _mm512_load_ps(ptr); }
+        inline void store_aligned(type* ptr) const { _mm512_store_ps(ptr, x); }
+        inline void load(const type* ptr)          { x = _mm512_loadu_ps(ptr); }
+        inline void store(type* ptr)         const { _mm512_storeu_ps(ptr, x); }
+
+        inline simd16f& operator=(const simd16i& rhs) { *this = simd16f(rhs); return *this; }
+        inline simd16f& operator=(const float& val)
+        {
+            *this = simd16f(val);
+            return *this;
+        }
+
+        inline unsigned int size() const { return 16; }
+        inline float operator[](unsigned int idx) const
+        {
+            float temp[16];
+            store(temp);
+            return temp[idx];
+        }
+
+        inline simd8f low() const { return _mm512_castps512_ps256(x); }
+        inline simd8f high() const { return _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(x),1)); }
+
+    private:
+        __m512 x;
+    };
+
+
+    class simd16f_bool
+    {
+    public:
+        typedef float type;
+
+        inline simd16f_bool() {}
+        inline simd16f_bool(const __mmask16& val):x(val) {}
+
+        inline simd16f_bool& operator=(const __mmask16& val)
+        {
+            x = val;
+            return *this;
+        }
+
+        inline operator __mmask16() const { return x; }
+
+
+    private:
+        __mmask16 x;
+    };
+
+#else
+    class simd16f
+    {
+    public:
+        typedef float type;
+
+        inline simd16f() {}
+        inline simd16f(const simd8f& low_, const simd8f& high_): _low(low_),_high(high_){}
+        inline simd16f(float f) :_low(f),_high(f) {}
+        inline simd16f(float r0,  float r1,  float r2,  float r3,
+                       float r4,  float r5,  float r6,  float r7,
+                       float r8,  float r9,  float r10, float r11,
+                       float r12, float r13, float r14, float r15) :
+            _low(r0,r1,r2,r3,r4,r5,r6,r7), _high(r8,r9,r10,r11,r12,r13,r14,r15) {}
+        inline simd16f(const simd16i& val) : _low(val.low()), _high(val.high()) { }
+
+        // truncate to 32bit integers
+        inline operator simd16i::rawarray() const
+        {
+            simd16i::rawarray temp;
+            temp.low = simd8i(_low);
+            temp.high = simd8i(_high);
+            return temp;
+        }
+
+        inline void load_aligned(const type* ptr)  { _low.load_aligned(ptr); _high.load_aligned(ptr+8); }
+        inline void store_aligned(type* ptr) const { _low.store_aligned(ptr); _high.store_aligned(ptr+8); }
+        inline void load(const type* ptr)          { _low.load(ptr); _high.load(ptr+8); }
+        inline void store(type* ptr)         const { _low.store(ptr); _high.store(ptr+8); }
+
+        inline unsigned int size() const { return 16; }
+        inline float operator[](unsigned int idx) const
+        {
+            if (idx < 8)
+                return _low[idx];
+            else
+                return _high[idx-8];
+        }
+
+        inline const simd8f& low() const { return _low; }
+        inline const simd8f& high() const { return _high; }
+
+    private:
+        simd8f _low, _high;
+    };
+
+    class simd16f_bool
+    {
+    public:
+        typedef float type;
+
+        inline simd16f_bool() {}
+        inline simd16f_bool(const simd8f_bool& low_, const simd8f_bool& high_): _low(low_),_high(high_){}
+
+
+        inline const simd8f_bool& low() const { return _low; }
+        inline const simd8f_bool& high() const { return _high; }
+    private:
+        simd8f_bool _low,_high;
+    };
+#endif
+
+// ----------------------------------------------------------------------------------------
+
+    inline std::ostream& operator<<(std::ostream& out, const simd16f& item)
+    {
+        float temp[16];
+        item.store(temp);
+        out << "(";
+        for (int i = 0; i < 16; ++i)
+        {
+            if (i != 0)
+                out << ", ";
+            out << temp[i];
+        }
+        out << ")";
+        return out;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f operator+ (const simd16f& lhs, const simd16f& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_add_ps(lhs, rhs);
+#else
+        return simd16f(lhs.low()+rhs.low(),
+                       lhs.high()+rhs.high());
+#endif
+    }
+    inline simd16f& operator+= (simd16f& lhs, const simd16f& rhs)
+    { lhs = lhs + rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f operator- (const simd16f& lhs, const simd16f& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_sub_ps(lhs, rhs);
+#else
+        return simd16f(lhs.low()-rhs.low(),
+                       lhs.high()-rhs.high());
+#endif
+    }
+    inline simd16f& operator-= (simd16f& lhs, const simd16f& rhs)
+    { lhs = lhs - rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f operator* (const simd16f& lhs, const simd16f& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_mul_ps(lhs, rhs);
+#else
+        return simd16f(lhs.low()*rhs.low(),
+                       lhs.high()*rhs.high());
+#endif
+    }
+    inline simd16f& operator*= (simd16f& lhs, const simd16f& rhs)
+    { lhs = lhs * rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f operator/ (const simd16f& lhs, const simd16f& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_div_ps(lhs, rhs);
+#else
+        return simd16f(lhs.low()/rhs.low(),
+                       lhs.high()/rhs.high());
+#endif
+    }
+    inline simd16f& operator/= (simd16f& lhs, const simd16f& rhs)
+    { lhs = lhs / rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f_bool operator== (const simd16f& lhs, const simd16f& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_cmp_ps_mask(lhs, rhs, 0);
+#else
+        return simd16f_bool(lhs.low() ==rhs.low(),
+                       lhs.high()==rhs.high());
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f_bool operator!= (const simd16f& lhs, const simd16f& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_cmp_ps_mask(lhs, rhs, 4);
+#else
+        return simd16f_bool(lhs.low() !=rhs.low(),
+                       lhs.high()!=rhs.high());
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f_bool operator< (const simd16f& lhs, const simd16f& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_cmp_ps_mask(lhs, rhs, 1);
+#else
+        return simd16f_bool(lhs.low() <rhs.low(),
+                       lhs.high()<rhs.high());
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f_bool operator> (const simd16f& lhs, const simd16f& rhs)
+    {
+        return rhs < lhs;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f_bool operator<= (const simd16f& lhs, const simd16f& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_cmp_ps_mask(lhs, rhs, 2);
+#else
+        return simd16f_bool(lhs.low() <=rhs.low(),
+                       lhs.high()<=rhs.high());
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f_bool operator>= (const simd16f& lhs, const simd16f& rhs)
+    {
+        return rhs <= lhs;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f min (const simd16f& lhs, const simd16f& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_min_ps(lhs, rhs);
+#else
+        return simd16f(min(lhs.low(), rhs.low()),
+                       min(lhs.high(),rhs.high()));
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f max (const simd16f& lhs, const simd16f& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_max_ps(lhs, rhs);
+#else
+        return simd16f(max(lhs.low(), rhs.low()),
+                       max(lhs.high(),rhs.high()));
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f reciprocal (const simd16f& item)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_rcp14_ps(item);
+#else
+        return simd16f(reciprocal(item.low()),
+                       reciprocal(item.high()));
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f reciprocal_sqrt (const simd16f& item)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_rsqrt14_ps(item);
+#else
+        return simd16f(reciprocal_sqrt(item.low()),
+                       reciprocal_sqrt(item.high()));
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline float sum(const simd16f& item)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_reduce_add_ps(item);
+#else
+        return sum(item.low()+item.high());
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline float dot(const simd16f& lhs, const simd16f& rhs)
+    {
+        return sum(lhs*rhs);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f sqrt(const simd16f& item)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_sqrt_ps(item);
+#else
+        return simd16f(sqrt(item.low()),
+                       sqrt(item.high()));
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f ceil(const simd16f& item)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_roundscale_ps(item, 0x0A);
+#else
+        return simd16f(ceil(item.low()),
+                       ceil(item.high()));
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16f floor(const simd16f& item)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_roundscale_ps(item, 0x09);
+#else
+        return simd16f(floor(item.low()),
+                       floor(item.high()));
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    // perform cmp ? a : b
+    inline simd16f select(const simd16f_bool& cmp, const simd16f& a, const simd16f& b)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_mask_blend_ps(cmp, b, a);
+#else
+        return simd16f(select(cmp.low(),  a.low(),  b.low()),
+                       select(cmp.high(), a.high(), b.high()));
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_sIMD16F_Hh_
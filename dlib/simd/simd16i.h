@@ -0,0 +1,360 @@
+// Copyright (C) 2013  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_sIMD16I_Hh_
+#define DLIB_sIMD16I_Hh_
+
+#include "simd_check.h"
+#include "simd8i.h"
+#include "../uintn.h"
+
+namespace dlib
+{
+
+#ifdef DLIB_HAVE_AVX512F
+    class simd16i
+    {
+    public:
+        typedef int32 type;
+
+        inline simd16i() {}
+        inline simd16i(int32 f) { x = _mm512_set1_epi32(f); }
+        inline simd16i(int32 r0,  int32 r1,  int32 r2,  int32 r3,
+                       int32 r4,  int32 r5,  int32 r6,  int32 r7,
+                       int32 r8,  int32 r9,  int32 r10, int32 r11,
+                       int32 r12, int32 r13, int32 r14, int32 r15 )
+        { x = _mm512_setr_epi32(r0,r1,r2,r3,r4,r5,r6,r7,r8,r9,r10,r11,r12,r13,r14,r15); }
+
+        inline simd16i(const __m512i& val):x(val) {}
+
+        inline simd16i(const simd8i& low, const simd8i& high)
+        {
+            x = _mm512_inserti64x4(_mm512_castsi256_si512(low),high,1);
+        }
+
+        inline simd16i& operator=(const __m512i& val)
+        {
+            x = val;
+            return *this;
+        }
+
+        inline operator __m512i() const { return x; }
+
+        inline void load_aligned(const type* ptr)  { x = _mm512_load_si512((const __m512i*)ptr); }
+        inline void store_aligned(type* ptr) const { _mm512_store_si512((__m512i*)ptr, x); }
+        inline void load(const type* ptr)          { x = _mm512_loadu_si512((const __m512i*)ptr); }
+        inline void store(type* ptr)         const { _mm512_storeu_si512((__m512i*)ptr, x); }
+
+        inline simd8i low() const { return _mm512_castsi512_si256(x); }
+        inline simd8i high() const { return _mm512_extracti64x4_epi64(x,1); }
+
+        inline unsigned int size() const { return 16; }
+        inline int32 operator[](unsigned int idx) const
+        {
+            int32 temp[16];
+            store(temp);
+            return temp[idx];
+        }
+
+    private:
+        __m512i x;
+    };
+#else
+    class simd16i
+    {
+    public:
+        typedef int32 type;
+
+        inline simd16i() {}
+        inline simd16i(const simd8i& low_, const simd8i& high_): _low(low_),_high(high_){}
+        inline simd16i(int32 f) :_low(f),_high(f) {}
+        inline simd16i(int32 r0,  int32 r1,  int32 r2,  int32 r3,
+                       int32 r4,  int32 r5,  int32 r6,  int32 r7,
+                       int32 r8,  int32 r9,  int32 r10, int32 r11,
+                       int32 r12, int32 r13, int32 r14, int32 r15 ) :
+            _low(r0,r1,r2,r3,r4,r5,r6,r7), _high(r8,r9,r10,r11,r12,r13,r14,r15) {}
+
+        struct rawarray
+        {
+            simd8i low, high;
+        };
+        inline simd16i(const rawarray& a)
+        {
+            _low = a.low;
+            _high = a.high;
+        }
+
+        inline void load_aligned(const type* ptr)  { _low.load_aligned(ptr); _high.load_aligned(ptr+8); }
+        inline void store_aligned(type* ptr) const { _low.store_aligned(ptr); _high.store_aligned(ptr+8); }
+        inline void load(const type* ptr)          { _low.load(ptr); _high.load(ptr+8); }
+        inline void store(type* ptr)         const { _low.store(ptr); _high.store(ptr+8); }
+
+        inline unsigned int size() const { return 16; }
+        inline int32 operator[](unsigned int idx) const
+        {
+            if (idx < 8)
+                return _low[idx];
+            else
+                return _high[idx-8];
+        }
+
+        inline const simd8i& low() const { return _low; }
+        inline const simd8i& high() const { return _high; }
+
+    private:
+        simd8i _low, _high;
+    };
+
+#endif
+
+// ----------------------------------------------------------------------------------------
+
+    inline std::ostream& operator<<(std::ostream& out, const simd16i& item)
+    {
+        int32 temp[16];
+        item.store(temp);
+        out << "(";
+        for (int i = 0; i < 16; ++i)
+        {
+            if (i != 0)
+                out << ", ";
+            out << temp[i];
+        }
+        out << ")";
+        return out;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator+ (const simd16i& lhs, const simd16i& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_add_epi32(lhs, rhs);
+#else
+        return simd16i(lhs.low()+rhs.low(),
+                       lhs.high()+rhs.high());
+#endif
+    }
+    inline simd16i& operator+= (simd16i& lhs, const simd16i& rhs)
+    { lhs = lhs + rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator- (const simd16i& lhs, const simd16i& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_sub_epi32(lhs, rhs);
+#else
+        return simd16i(lhs.low()-rhs.low(),
+                       lhs.high()-rhs.high());
+#endif
+    }
+    inline simd16i& operator-= (simd16i& lhs, const simd16i& rhs)
+    { lhs = lhs - rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator* (const simd16i& lhs, const simd16i& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_mullo_epi32(lhs, rhs);
+#else
+        return simd16i(lhs.low()*rhs.low(),
+                       lhs.high()*rhs.high());
+#endif
+    }
+    inline simd16i& operator*= (simd16i& lhs, const simd16i& rhs)
+    { lhs = lhs * rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator& (const simd16i& lhs, const simd16i& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_and_si512(lhs, rhs);
+#else
+        return simd16i(lhs.low()&rhs.low(),
+                       lhs.high()&rhs.high());
+#endif
+    }
+    inline simd16i& operator&= (simd16i& lhs, const simd16i& rhs)
+    { lhs = lhs & rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator| (const simd16i& lhs, const simd16i& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_or_si512(lhs, rhs);
+#else
+        return simd16i(lhs.low()|rhs.low(),
+                       lhs.high()|rhs.high());
+#endif
+    }
+    inline simd16i& operator|= (simd16i& lhs, const simd16i& rhs)
+    { lhs = lhs | rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator^ (const simd16i& lhs, const simd16i& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_xor_si512(lhs, rhs);
+#else
+        return simd16i(lhs.low()^rhs.low(),
+                       lhs.high()^rhs.high());
+#endif
+    }
+    inline simd16i& operator^= (simd16i& lhs, const simd16i& rhs)
+    { lhs = lhs ^ rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator~ (const simd16i& lhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_xor_si512(lhs, _mm512_set1_epi32(-1));
+#else
+        return simd16i(~lhs.low(),
+                       ~lhs.high());
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator<< (const simd16i& lhs, const int& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_sll_epi32(lhs, _mm_cvtsi32_si128(rhs));
+#else
+        return simd16i(lhs.low()<<rhs,
+                       lhs.high()<<rhs);
+#endif
+    }
+    inline simd16i& operator<<= (simd16i& lhs, const int& rhs)
+    { lhs = lhs << rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator>> (const simd16i& lhs, const int& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_sra_epi32(lhs, _mm_cvtsi32_si128(rhs));
+#else
+        return simd16i(lhs.low()>>rhs,
+                       lhs.high()>>rhs);
+#endif
+    }
+    inline simd16i& operator>>= (simd16i& lhs, const int& rhs)
+    { lhs = lhs >> rhs; return lhs; }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator== (const simd16i& lhs, const simd16i& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_maskz_set1_epi32(_mm512_cmpeq_epi32_mask(lhs, rhs), -1);
+#else
+        return simd16i(lhs.low()==rhs.low(),
+                       lhs.high()==rhs.high());
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator!= (const simd16i& lhs, const simd16i& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_maskz_set1_epi32(_mm512_cmpneq_epi32_mask(lhs, rhs), -1);
+#else
+        return simd16i(lhs.low()!=rhs.low(),
+                       lhs.high()!=rhs.high());
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator> (const simd16i& lhs, const simd16i& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_maskz_set1_epi32(_mm512_cmpgt_epi32_mask(lhs, rhs), -1);
+#else
+        return simd16i(lhs.low()>rhs.low(),
+                       lhs.high()>rhs.high());
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator< (const simd16i& lhs, const simd16i& rhs)
+    {
+        return rhs > lhs;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator<= (const simd16i& lhs, const simd16i& rhs)
+    {
+        return ~(lhs > rhs);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i operator>= (const simd16i& lhs, const simd16i& rhs)
+    {
+        return rhs <= lhs;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i min (const simd16i& lhs, const simd16i& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_min_epi32(lhs, rhs);
+#else
+        return simd16i(min(lhs.low(),rhs.low()),
+                       min(lhs.high(),rhs.high()));
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline simd16i max (const simd16i& lhs, const simd16i& rhs)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_max_epi32(lhs, rhs);
+#else
+        return simd16i(max(lhs.low(),rhs.low()),
+                       max(lhs.high(),rhs.high()));
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    inline int32 sum(const simd16i& item)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        return _mm512_reduce_add_epi32(item);
+#else
+        return sum(item.low()+item.high());
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    // perform cmp ? a : b
+    inline simd16i select(const simd16i& cmp, const simd16i& a, const simd16i& b)
+    {
+#ifdef DLIB_HAVE_AVX512F
+        // bitwise blend: (cmp&a)|(~cmp&b)
+        return _mm512_ternarylogic_epi32(cmp, a, b, 0xca);
+#else
+        return simd16i(select(cmp.low(),  a.low(),  b.low()),
+                       select(cmp.high(), a.high(), b.high()));
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_sIMD16I_Hh_
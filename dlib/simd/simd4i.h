@@ -5,6 +5,7 @@
 
 #include "simd_check.h"
 #include "../uintn.h"
+#include <cstring>
 
 namespace dlib
 {
@@ -33,6 +34,20 @@ namespace dlib
         inline void load(const type* ptr)          { x = _mm_loadu_si128((const __m128i*)ptr); }
         inline void store(type* ptr)         const { _mm_storeu_si128((__m128i*)ptr, x); }
 
+        // load 4 unsigned chars and zero extend them into the 4 int32 lanes
+        inline void load(const unsigned char* ptr)
+        {
+            int32 temp;
+            std::memcpy(&temp, ptr, 4);
+#ifdef DLIB_HAVE_SSE41
+            x = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(temp));
+#else
+            x = _mm_cvtsi32_si128(temp);
+            x = _mm_unpacklo_epi8(x, _mm_setzero_si128());
+            x = _mm_unpacklo_epi16(x, _mm_setzero_si128());
+#endif
+        }
+
         inline unsigned int size() const { return 4; }
         inline int32 operator[](unsigned int idx) const 
         {
@@ -80,6 +95,15 @@ namespace dlib
         inline void store_aligned(int32* ptr) const { vec_st(x.v, 0, ptr); }
         inline void load(const int32* ptr) { x.v = vec_vsx_ld(0, ptr); }
         inline void store(int32* ptr) const { vec_vsx_st(x.v, 0, ptr); }
+
+        // load 4 unsigned chars and zero extend them into the 4 int32 lanes
+        inline void load(const unsigned char* ptr)
+        {
+            x.x[0] = ptr[0];
+            x.x[1] = ptr[1];
+            x.x[2] = ptr[2];
+            x.x[3] = ptr[3];
+        }
         
 
         struct rawarray
@@ -120,6 +144,15 @@ namespace dlib
         inline void load(const type* ptr)          { x = vld1q_s32(ptr); }
         inline void store(type* ptr)         const { vst1q_s32(ptr, x); }
 
+        // load 4 unsigned chars and zero extend them into the 4 int32 lanes
+        inline void load(const unsigned char* ptr)
+        {
+            uint32 temp;
+            std::memcpy(&temp, ptr, 4);
+            uint16x4_t wide = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(temp))));
+            x = vreinterpretq_s32_u32(vmovl_u16(wide));
+        }
+
         inline unsigned int size() const { return 4; }
         inline int32 operator[](unsigned int idx) const
         {
@@ -173,6 +206,15 @@ namespace dlib
             x[3] = ptr[3];
         }
 
+        // load 4 unsigned chars and zero extend them into the 4 int32 lanes
+        inline void load(const unsigned char* ptr)
+        {
+            x[0] = ptr[0];
+            x[1] = ptr[1];
+            x[2] = ptr[2];
+            x[3] = ptr[3];
+        }
+
         inline void store(type* ptr) const
         {
             ptr[0] = x[0];
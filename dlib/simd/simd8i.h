@@ -41,6 +41,19 @@ namespace dlib
         inline void load(const type* ptr)          { x = _mm256_loadu_si256((const __m256i*)ptr); }
         inline void store(type* ptr)         const { _mm256_storeu_si256((__m256i*)ptr, x); }
 
+        // load 8 unsigned chars and zero extend them into the 8 int32 lanes
+        inline void load(const unsigned char* ptr)
+        {
+#ifdef DLIB_HAVE_AVX2
+            x = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)ptr));
+#else
+            simd4i lo, hi;
+            lo.load(ptr);
+            hi.load(ptr+4);
+            *this = simd8i(lo,hi);
+#endif
+        }
+
         inline simd4i low() const { return _mm256_castsi256_si128(x); }
         inline simd4i high() const { return _mm256_extractf128_si256(x,1); }
 
@@ -82,6 +95,9 @@ namespace dlib
         inline void load(const type* ptr)          { _low.load(ptr); _high.load(ptr+4); }
         inline void store(type* ptr)         const { _low.store(ptr); _high.store(ptr+4); }
 
+        // load 8 unsigned chars and zero extend them into the 8 int32 lanes
+        inline void load(const unsigned char* ptr) { _low.load(ptr); _high.load(ptr+4); }
+
         inline unsigned int size() const { return 8; }
         inline int32 operator[](unsigned int idx) const 
         {
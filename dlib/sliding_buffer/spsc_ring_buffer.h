@@ -0,0 +1,178 @@
+// Copyright (C) 2016  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_SPSC_RING_BUFFEr_
+#define DLIB_SPSC_RING_BUFFEr_
+
+// C++11 things don't work in old versions of visual studio
+#if !defined( _MSC_VER) ||  _MSC_VER >= 1900
+
+#include "spsc_ring_buffer_abstract.h"
+#include "../algs.h"
+#include "../assert.h"
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class spsc_ring_buffer : noncopyable
+    {
+        /*!
+            INITIAL VALUE
+                - head == 0
+                - tail == 0
+                - buffer.size() == some power of two >= the requested capacity
+                - mask == buffer.size()-1
+
+            CONVENTION
+                - capacity() == buffer.size()
+                - head and tail are free running byte counters.  The producer only
+                  writes tail and the consumer only writes head, so the object is safe
+                  to use from one producer thread and one consumer thread without any
+                  locks.  They live on separate cache lines so the two threads don't
+                  false share.
+                - tail-head == the number of unread bytes in the ring.
+                - byte i of the stream lives at buffer[i&mask].
+        !*/
+
+    public:
+
+        explicit spsc_ring_buffer (
+            unsigned long min_capacity
+        )
+        {
+            DLIB_ASSERT(min_capacity > 0,
+                "\tspsc_ring_buffer::spsc_ring_buffer(min_capacity)"
+                << "\n\t min_capacity must be non-zero"
+                );
+
+            unsigned long cap = 1;
+            while (cap < min_capacity)
+                cap *= 2;
+            buffer.resize(cap);
+            mask = cap-1;
+            head = 0;
+            tail = 0;
+        }
+
+        unsigned long capacity (
+        ) const { return static_cast<unsigned long>(buffer.size()); }
+
+        unsigned long size (
+        ) const
+        {
+            return static_cast<unsigned long>(tail.load(std::memory_order_acquire) -
+                                              head.load(std::memory_order_acquire));
+        }
+
+        unsigned long space (
+        ) const { return capacity() - size(); }
+
+        void clear (
+        )
+        /*!
+            This method is NOT safe to call while another thread is reading or
+            writing.  It exists so a ring can be reused between capture sessions.
+        !*/
+        {
+            head = 0;
+            tail = 0;
+        }
+
+        void set_capacity (
+            unsigned long min_capacity
+        )
+        /*!
+            Like clear(), this is NOT safe to call while another thread is reading or
+            writing.  Any unread bytes are discarded.
+        !*/
+        {
+            DLIB_ASSERT(min_capacity > 0,
+                "\tvoid spsc_ring_buffer::set_capacity(min_capacity)"
+                << "\n\t min_capacity must be non-zero"
+                );
+
+            unsigned long cap = 1;
+            while (cap < min_capacity)
+                cap *= 2;
+            buffer.resize(cap);
+            buffer.shrink_to_fit();
+            mask = cap-1;
+            head = 0;
+            tail = 0;
+        }
+
+        unsigned long write (
+            const char* data,
+            unsigned long num
+        )
+        {
+            // Only the producer thread may call this.  tail is ours, so a relaxed
+            // load sees our own last store.  The acquire on head pairs with the
+            // consumer's release so we never overwrite bytes it hasn't read yet.
+            const unsigned long long t = tail.load(std::memory_order_relaxed);
+            const unsigned long long h = head.load(std::memory_order_acquire);
+            const unsigned long space_left = static_cast<unsigned long>(capacity() - (t-h));
+            if (num > space_left)
+                num = space_left;
+            if (num == 0)
+                return 0;
+
+            // copy in at most two contiguous spans
+            const unsigned long offset = static_cast<unsigned long>(t)&mask;
+            const unsigned long first = std::min<unsigned long>(num, capacity()-offset);
+            std::memcpy(&buffer[offset], data, first);
+            if (num != first)
+                std::memcpy(&buffer[0], data+first, num-first);
+
+            tail.store(t+num, std::memory_order_release);
+            return num;
+        }
+
+        unsigned long read (
+            char* data,
+            unsigned long num
+        )
+        {
+            // Only the consumer thread may call this.  The acquire on tail pairs
+            // with the producer's release so the bytes we copy out are visible.
+            const unsigned long long h = head.load(std::memory_order_relaxed);
+            const unsigned long long t = tail.load(std::memory_order_acquire);
+            const unsigned long available = static_cast<unsigned long>(t-h);
+            if (num > available)
+                num = available;
+            if (num == 0)
+                return 0;
+
+            // copy out at most two contiguous spans
+            const unsigned long offset = static_cast<unsigned long>(h)&mask;
+            const unsigned long first = std::min<unsigned long>(num, capacity()-offset);
+            std::memcpy(data, &buffer[offset], first);
+            if (num != first)
+                std::memcpy(data+first, &buffer[0], num-first);
+
+            head.store(h+num, std::memory_order_release);
+            return num;
+        }
+
+    private:
+
+        std::vector<char> buffer;
+        unsigned long mask;
+
+        // The producer owns tail and the consumer owns head.  Keep them on separate
+        // cache lines so the two threads don't ping the same line back and forth.
+        alignas(64) std::atomic<unsigned long long> head;
+        alignas(64) std::atomic<unsigned long long> tail;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // _MSC_VER
+
+#endif // DLIB_SPSC_RING_BUFFEr_
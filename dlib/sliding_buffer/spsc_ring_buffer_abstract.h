@@ -0,0 +1,131 @@
+// Copyright (C) 2016  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_SPSC_RING_BUFFER_ABSTRACt_
+#ifdef DLIB_SPSC_RING_BUFFER_ABSTRACt_
+
+#include "../algs.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class spsc_ring_buffer : noncopyable
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object is a fixed capacity byte ring designed to move a stream of
+                bytes from exactly one producer thread to exactly one consumer thread
+                without locks or allocation on the hot path.  The producer calls
+                write() and the consumer calls read(); both operate on bulk spans and
+                copy at most two contiguous runs per call.  The head and tail indices
+                are kept on separate cache lines so the two threads don't contend on
+                the same line.
+
+                Unlike sliding_buffer, which is a single threaded enumerable container
+                of elements, this object is a transport primitive: bytes written by
+                the producer come out of read() in FIFO order and are then gone.
+
+            THREAD SAFETY
+                - One thread may call write(), and one other thread may call read(),
+                  concurrently and without any external locking.
+                - size(), space(), and capacity() may be called from either of those
+                  two threads.
+                - clear() and set_capacity() are NOT thread safe.  They may only be
+                  called while no other thread is touching the object.
+        !*/
+
+    public:
+
+        explicit spsc_ring_buffer (
+            unsigned long min_capacity
+        );
+        /*!
+            requires
+                - min_capacity > 0
+            ensures
+                - #capacity() == the smallest power of two >= min_capacity
+                - #size() == 0
+        !*/
+
+        unsigned long capacity (
+        ) const;
+        /*!
+            ensures
+                - returns the maximum number of unread bytes the ring can hold.
+        !*/
+
+        unsigned long size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of bytes that have been written but not yet
+                  read.  When called from the consumer thread this is a lower bound
+                  (the producer may be adding more), and from the producer thread it
+                  is an upper bound.
+        !*/
+
+        unsigned long space (
+        ) const;
+        /*!
+            ensures
+                - returns capacity() - size(), with the symmetric caveats.
+        !*/
+
+        void clear (
+        );
+        /*!
+            requires
+                - no other thread is currently calling any method on *this.
+            ensures
+                - #size() == 0
+        !*/
+
+        void set_capacity (
+            unsigned long min_capacity
+        );
+        /*!
+            requires
+                - min_capacity > 0
+                - no other thread is currently calling any method on *this.
+            ensures
+                - #capacity() == the smallest power of two >= min_capacity
+                - #size() == 0 (any unread bytes are discarded)
+        !*/
+
+        unsigned long write (
+            const char* data,
+            unsigned long num
+        );
+        /*!
+            requires
+                - data points to at least num valid bytes.
+                - only one thread ever calls write().
+            ensures
+                - copies as many of the num bytes as fit into the ring, in order,
+                  and returns the number copied (which is 0 when the ring is full).
+                - never blocks and never allocates.
+        !*/
+
+        unsigned long read (
+            char* data,
+            unsigned long num
+        );
+        /*!
+            requires
+                - data points to space for at least num bytes.
+                - only one thread ever calls read().
+            ensures
+                - copies up to num of the oldest unread bytes into data, removes them
+                  from the ring, and returns the number copied (which is 0 when the
+                  ring is empty).
+                - never blocks and never allocates.
+        !*/
+
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_SPSC_RING_BUFFER_ABSTRACt_
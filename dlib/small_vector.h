@@ -0,0 +1,8 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_SMALL_VECTOr_TOP_
+#define DLIB_SMALL_VECTOr_TOP_
+
+#include "small_vector/small_vector.h"
+
+#endif // DLIB_SMALL_VECTOr_TOP_
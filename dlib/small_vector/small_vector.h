@@ -0,0 +1,431 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_SMALL_VECTOr_H_
+#define DLIB_SMALL_VECTOr_H_
+
+#include "small_vector_abstract.h"
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include "../assert.h"
+#include "../serialize.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T,
+        size_t N
+        >
+    class small_vector
+    {
+        /*!
+            CONVENTION
+                - data_ points at either inline_storage or a heap buffer.
+                - size_ == size()
+                - capacity_ == capacity() and capacity_ >= N always.
+                - elements data_[0] through data_[size_-1] are constructed, everything
+                  else in the buffer is raw storage.
+        !*/
+    public:
+        static_assert(N > 0, "small_vector requires at least one inline element.");
+
+        typedef T value_type;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        small_vector (
+        ) : data_(inline_data()), size_(0), capacity_(N)
+        {
+        }
+
+        explicit small_vector (
+            size_t initial_size,
+            const T& value = T()
+        ) : small_vector()
+        {
+            resize(initial_size, value);
+        }
+
+        small_vector (
+            std::initializer_list<T> items
+        ) : small_vector()
+        {
+            reserve(items.size());
+            for (auto& item : items)
+                push_back(item);
+        }
+
+        small_vector (
+            const small_vector& rhs
+        ) : small_vector()
+        {
+            reserve(rhs.size_);
+            for (size_t i = 0; i < rhs.size_; ++i)
+                new (data_+i) T(rhs.data_[i]);
+            size_ = rhs.size_;
+        }
+
+        small_vector (
+            small_vector&& rhs
+        ) : small_vector()
+        {
+            move_from(rhs);
+        }
+
+        small_vector& operator= (
+            const small_vector& rhs
+        )
+        {
+            if (this != &rhs)
+            {
+                clear();
+                reserve(rhs.size_);
+                for (size_t i = 0; i < rhs.size_; ++i)
+                    new (data_+i) T(rhs.data_[i]);
+                size_ = rhs.size_;
+            }
+            return *this;
+        }
+
+        small_vector& operator= (
+            small_vector&& rhs
+        )
+        {
+            if (this != &rhs)
+            {
+                clear();
+                if (data_ != inline_data())
+                {
+                    ::operator delete(data_);
+                    data_ = inline_data();
+                    capacity_ = N;
+                }
+                move_from(rhs);
+            }
+            return *this;
+        }
+
+        ~small_vector (
+        )
+        {
+            clear();
+            if (data_ != inline_data())
+                ::operator delete(data_);
+        }
+
+        size_t size (
+        ) const { return size_; }
+
+        bool empty (
+        ) const { return size_ == 0; }
+
+        size_t capacity (
+        ) const { return capacity_; }
+
+        bool is_inline (
+        ) const { return data_ == inline_data(); }
+
+        void clear (
+        )
+        {
+            while (size_ != 0)
+                data_[--size_].~T();
+        }
+
+        void reserve (
+            size_t new_capacity
+        )
+        {
+            if (new_capacity <= capacity_)
+                return;
+
+            // Grow geometrically so repeated push_back() calls stay amortized
+            // constant time once we have spilled to the heap.
+            new_capacity = std::max(new_capacity, 2*capacity_);
+            T* const new_data = static_cast<T*>(::operator new(new_capacity*sizeof(T)));
+            for (size_t i = 0; i < size_; ++i)
+            {
+                new (new_data+i) T(std::move(data_[i]));
+                data_[i].~T();
+            }
+            if (data_ != inline_data())
+                ::operator delete(data_);
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
+
+        void resize (
+            size_t new_size,
+            const T& value = T()
+        )
+        {
+            if (new_size < size_)
+            {
+                while (size_ != new_size)
+                    data_[--size_].~T();
+            }
+            else
+            {
+                reserve(new_size);
+                while (size_ != new_size)
+                    new (data_+size_++) T(value);
+            }
+        }
+
+        void push_back (
+            const T& value
+        )
+        {
+            emplace_back(value);
+        }
+
+        void push_back (
+            T&& value
+        )
+        {
+            emplace_back(std::move(value));
+        }
+
+        template <typename... Args>
+        T& emplace_back (
+            Args&&... args
+        )
+        {
+            if (size_ == capacity_)
+                reserve(size_+1);
+            new (data_+size_) T(std::forward<Args>(args)...);
+            return data_[size_++];
+        }
+
+        void pop_back (
+        )
+        {
+            DLIB_ASSERT(size_ != 0,
+                "\t void small_vector::pop_back()"
+                << "\n\t You can't pop an element from an empty vector."
+                << "\n\t this: " << this
+            );
+            data_[--size_].~T();
+        }
+
+        iterator insert (
+            const_iterator pos,
+            T value
+        )
+        {
+            DLIB_ASSERT(begin() <= pos && pos <= end(),
+                "\t iterator small_vector::insert()"
+                << "\n\t The given iterator doesn't point into this vector."
+                << "\n\t this: " << this
+            );
+            const size_t index = pos - data_;
+            if (size_ == capacity_)
+                reserve(size_+1);
+            if (index < size_)
+            {
+                new (data_+size_) T(std::move(data_[size_-1]));
+                for (size_t i = size_-1; i > index; --i)
+                    data_[i] = std::move(data_[i-1]);
+                data_[index] = std::move(value);
+            }
+            else
+            {
+                new (data_+size_) T(std::move(value));
+            }
+            ++size_;
+            return data_+index;
+        }
+
+        iterator erase (
+            const_iterator pos
+        )
+        {
+            DLIB_ASSERT(begin() <= pos && pos < end(),
+                "\t iterator small_vector::erase()"
+                << "\n\t The given iterator doesn't point at an element of this vector."
+                << "\n\t this: " << this
+            );
+            const size_t index = pos - data_;
+            for (size_t i = index; i+1 < size_; ++i)
+                data_[i] = std::move(data_[i+1]);
+            data_[--size_].~T();
+            return data_+index;
+        }
+
+        T& operator[] (
+            size_t idx
+        )
+        {
+            DLIB_ASSERT(idx < size_,
+                "\t T& small_vector::operator[](idx)"
+                << "\n\t idx is out of range."
+                << "\n\t idx:    " << idx
+                << "\n\t size(): " << size_
+                << "\n\t this:   " << this
+            );
+            return data_[idx];
+        }
+
+        const T& operator[] (
+            size_t idx
+        ) const
+        {
+            DLIB_ASSERT(idx < size_,
+                "\t const T& small_vector::operator[](idx)"
+                << "\n\t idx is out of range."
+                << "\n\t idx:    " << idx
+                << "\n\t size(): " << size_
+                << "\n\t this:   " << this
+            );
+            return data_[idx];
+        }
+
+        T& front (
+        ) { return (*this)[0]; }
+
+        const T& front (
+        ) const { return (*this)[0]; }
+
+        T& back (
+        ) { return (*this)[size_-1]; }
+
+        const T& back (
+        ) const { return (*this)[size_-1]; }
+
+        T* data (
+        ) { return data_; }
+
+        const T* data (
+        ) const { return data_; }
+
+        iterator begin (
+        ) { return data_; }
+
+        const_iterator begin (
+        ) const { return data_; }
+
+        iterator end (
+        ) { return data_+size_; }
+
+        const_iterator end (
+        ) const { return data_+size_; }
+
+        reverse_iterator rbegin (
+        ) { return reverse_iterator(end()); }
+
+        const_reverse_iterator rbegin (
+        ) const { return const_reverse_iterator(end()); }
+
+        reverse_iterator rend (
+        ) { return reverse_iterator(begin()); }
+
+        const_reverse_iterator rend (
+        ) const { return const_reverse_iterator(begin()); }
+
+    private:
+
+        T* inline_data (
+        ) { return reinterpret_cast<T*>(inline_storage); }
+
+        const T* inline_data (
+        ) const { return reinterpret_cast<const T*>(inline_storage); }
+
+        void move_from (
+            small_vector& rhs
+        )
+        {
+            if (rhs.data_ != rhs.inline_data())
+            {
+                // steal the heap buffer
+                data_ = rhs.data_;
+                size_ = rhs.size_;
+                capacity_ = rhs.capacity_;
+                rhs.data_ = rhs.inline_data();
+                rhs.size_ = 0;
+                rhs.capacity_ = N;
+            }
+            else
+            {
+                for (size_t i = 0; i < rhs.size_; ++i)
+                    new (data_+i) T(std::move(rhs.data_[i]));
+                size_ = rhs.size_;
+                rhs.clear();
+            }
+        }
+
+        alignas(T) char inline_storage[N*sizeof(T)];
+        T* data_;
+        size_t size_;
+        size_t capacity_;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T, size_t N, size_t M>
+    bool operator== (
+        const small_vector<T,N>& a,
+        const small_vector<T,M>& b
+    )
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+
+    template <typename T, size_t N, size_t M>
+    bool operator!= (
+        const small_vector<T,N>& a,
+        const small_vector<T,M>& b
+    )
+    {
+        return !(a == b);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T, size_t N>
+    void serialize (
+        const small_vector<T,N>& item,
+        std::ostream& out
+    )
+    {
+        try
+        {
+            const unsigned long size = static_cast<unsigned long>(item.size());
+
+            serialize(size,out);
+            for (unsigned long i = 0; i < item.size(); ++i)
+                serialize(item[i],out);
+        }
+        catch (serialization_error& e)
+        { throw serialization_error(e.info + "\n   while serializing object of type small_vector"); }
+    }
+
+    template <typename T, size_t N>
+    void deserialize (
+        small_vector<T,N>& item,
+        std::istream& in
+    )
+    {
+        try
+        {
+            unsigned long size;
+            deserialize(size,in);
+            item.resize(size);
+            for (unsigned long i = 0; i < size; ++i)
+                deserialize(item[i],in);
+        }
+        catch (serialization_error& e)
+        { throw serialization_error(e.info + "\n   while deserializing object of type small_vector"); }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_SMALL_VECTOr_H_
@@ -0,0 +1,294 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_SMALL_VECTOr_ABSTRACT_H_
+#ifdef DLIB_SMALL_VECTOr_ABSTRACT_H_
+
+#include <cstddef>
+#include <iterator>
+#include "../serialize.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T,
+        size_t N
+        >
+    class small_vector
+    {
+        /*!
+            REQUIREMENTS ON T
+                T must be copy constructible or move constructible.
+
+            REQUIREMENTS ON N
+                N > 0
+
+            INITIAL VALUE
+                - size() == 0
+                - capacity() == N
+                - is_inline() == true
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a dynamically sized array, like std::vector, except
+                that the first N elements are stored inline inside the object itself.
+                No heap allocation happens until more than N elements are added, so
+                small collections built in hot loops cost nothing in allocator
+                traffic.  Once the vector spills to the heap it grows geometrically
+                like std::vector does.
+
+                Iterators are plain pointers into contiguous storage.  As with
+                std::vector, any operation that grows the vector past its capacity
+                invalidates all iterators, and insert() and erase() invalidate
+                iterators at or after the affected position.  Unlike std::vector,
+                moving a small_vector whose elements are stored inline moves the
+                elements individually, so iterators never outlive a move.
+        !*/
+    public:
+
+        typedef T value_type;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        small_vector (
+        );
+        /*!
+            ensures
+                - this object is properly initialized
+        !*/
+
+        explicit small_vector (
+            size_t initial_size,
+            const T& value = T()
+        );
+        /*!
+            ensures
+                - #size() == initial_size
+                - all elements of this vector are copies of value.
+        !*/
+
+        small_vector (
+            std::initializer_list<T> items
+        );
+        /*!
+            ensures
+                - #size() == items.size()
+                - the elements of this vector are copies of the elements of items, in
+                  the same order.
+        !*/
+
+        size_t size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of elements in this vector.
+        !*/
+
+        bool empty (
+        ) const;
+        /*!
+            ensures
+                - returns size() == 0
+        !*/
+
+        size_t capacity (
+        ) const;
+        /*!
+            ensures
+                - returns the number of elements this vector can hold without
+                  allocating.  This is always at least N.
+        !*/
+
+        bool is_inline (
+        ) const;
+        /*!
+            ensures
+                - returns true if the elements are stored inside this object rather
+                  than in a heap buffer.
+        !*/
+
+        void clear (
+        );
+        /*!
+            ensures
+                - #size() == 0
+                - the capacity is unchanged, so no storage is released.
+        !*/
+
+        void reserve (
+            size_t new_capacity
+        );
+        /*!
+            ensures
+                - #capacity() >= new_capacity
+                - the elements of this vector are unchanged.
+        !*/
+
+        void resize (
+            size_t new_size,
+            const T& value = T()
+        );
+        /*!
+            ensures
+                - #size() == new_size
+                - any elements appended by this call are copies of value.
+        !*/
+
+        void push_back (
+            const T& value
+        );
+        /*!
+            ensures
+                - appends a copy of value onto the end of this vector.
+                - #size() == size() + 1
+        !*/
+
+        template <typename... Args>
+        T& emplace_back (
+            Args&&... args
+        );
+        /*!
+            ensures
+                - constructs a new element at the end of this vector, in place, from
+                  the given arguments.
+                - #size() == size() + 1
+                - returns a reference to the new element.
+        !*/
+
+        void pop_back (
+        );
+        /*!
+            requires
+                - size() != 0
+            ensures
+                - removes the last element of this vector.
+                - #size() == size() - 1
+        !*/
+
+        iterator insert (
+            const_iterator pos,
+            T value
+        );
+        /*!
+            requires
+                - begin() <= pos <= end()
+            ensures
+                - inserts value before pos, shifting later elements up by one.
+                - #size() == size() + 1
+                - returns an iterator pointing at the inserted element.
+        !*/
+
+        iterator erase (
+            const_iterator pos
+        );
+        /*!
+            requires
+                - begin() <= pos < end()
+            ensures
+                - removes the element pos points at, shifting later elements down by
+                  one.
+                - #size() == size() - 1
+                - returns an iterator pointing at the element that followed the
+                  erased one.
+        !*/
+
+        T& operator[] (
+            size_t idx
+        );
+        /*!
+            requires
+                - idx < size()
+            ensures
+                - returns a reference to the idx-th element of this vector.
+        !*/
+
+        const T& operator[] (
+            size_t idx
+        ) const;
+        /*!
+            requires
+                - idx < size()
+            ensures
+                - returns a const reference to the idx-th element of this vector.
+        !*/
+
+        T& front();
+        const T& front() const;
+        T& back();
+        const T& back() const;
+        /*!
+            requires
+                - size() != 0
+            ensures
+                - return references to the first and last elements, as in std::vector.
+        !*/
+
+        T* data();
+        const T* data() const;
+        iterator begin();
+        const_iterator begin() const;
+        iterator end();
+        const_iterator end() const;
+        reverse_iterator rbegin();
+        const_reverse_iterator rbegin() const;
+        reverse_iterator rend();
+        const_reverse_iterator rend() const;
+        /*!
+            ensures
+                - the usual contiguous iterator interface, as in std::vector.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T, size_t N, size_t M>
+    bool operator== (
+        const small_vector<T,N>& a,
+        const small_vector<T,M>& b
+    );
+    /*!
+        ensures
+            - returns true if a and b contain equal elements in the same order.  Note
+              that the inline capacities don't have to match.
+    !*/
+
+    template <typename T, size_t N, size_t M>
+    bool operator!= (
+        const small_vector<T,N>& a,
+        const small_vector<T,M>& b
+    );
+    /*!
+        ensures
+            - returns !(a == b)
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T, size_t N>
+    void serialize (
+        const small_vector<T,N>& item,
+        std::ostream& out
+    );
+    /*!
+        provides serialization support.  The format is identical to that of a
+        std::vector holding the same elements, so the two can be swapped without
+        breaking saved files.
+    !*/
+
+    template <typename T, size_t N>
+    void deserialize (
+        small_vector<T,N>& item,
+        std::istream& in
+    );
+    /*!
+        provides deserialization support
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_SMALL_VECTOr_ABSTRACT_H_
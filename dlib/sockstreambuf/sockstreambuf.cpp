@@ -56,6 +56,26 @@ namespace dlib
             pbump(static_cast<int>(num));
             return num;
         }
+        else if (num >= out_buffer_size)
+        {
+            // The write is at least a whole out_buffer in size, so buffering it gains
+            // nothing.  Flush whatever is already buffered, so bytes still reach the
+            // socket in order, and then hand the caller's buffer straight to the
+            // socket.  This way big writes, like serialized tensors or images, don't
+            // get memcpyed through out_buffer on their way out.
+            if (flush_out_buffer() == EOF)
+            {
+                // the write was not successful so return that 0 bytes were written
+                return 0;
+            }
+
+            if (con.write(s,num) != num)
+            {
+                // the write was not successful so return that 0 bytes were written
+                return 0;
+            }
+            return num;
+        }
         else
         {
             std::memcpy(pptr(),s,static_cast<size_t>(space_left));
@@ -69,21 +89,9 @@ namespace dlib
                 return 0;
             }
 
-            if (num_left < out_buffer_size)
-            {
-                std::memcpy(pptr(),s,static_cast<size_t>(num_left));
-                pbump(num_left);
-                return num;
-            }
-            else
-            {
-                if (con.write(s,num_left) != num_left)
-                {
-                    // the write was not successful so return that 0 bytes were written
-                    return 0;
-                } 
-                return num;
-            }
+            std::memcpy(pptr(),s,static_cast<size_t>(num_left));
+            pbump(num_left);
+            return num;
         }
     }
 
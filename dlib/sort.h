@@ -4,7 +4,11 @@
 #define DLIB_SORt_
 
 #include "algs.h"
+#include <algorithm>
 #include <functional>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace dlib
 {
@@ -162,6 +166,67 @@ namespace dlib
             - sorts using an insertion sort algorithm
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T,
+        typename compare
+        >
+    void psort_array (
+        T& array,
+        unsigned long left,
+        unsigned long right,
+        const compare& comp,
+        unsigned long num_threads = 0
+    );
+    /*!
+        requires
+            - T implements operator[]
+            - the items in array must be comparable by comp where comp is a function
+              object with the same syntax as std::less<>
+            - the items in array must be swappable by a global swap()
+            - the items in array must be default constructable
+            - comp must be safe to invoke concurrently from multiple threads
+            - left and right are within the bounds of array
+              i.e. array[left] and array[right] are valid elements
+            - left <= right
+        ensures
+            - for all elements in #array between and including left and right the
+              ith element is < the i+1 element
+            - sorts using a parallel merge sort that splits the range across multiple
+              threads and merges the sorted runs.  Small ranges are simply handed to
+              qsort_array() since threading them would cost more than it saves.
+            - if (num_threads == 0) then
+                - uses however many threads the hardware can run concurrently
+            - else
+                - uses at most num_threads threads
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    void psort_array (
+        T& array,
+        unsigned long left,
+        unsigned long right
+    );
+    /*!
+        requires
+            - T implements operator[]
+            - the items in array must be comparable by std::less
+            - the items in array must be swappable by a global swap()
+            - the items in array must be default constructable
+            - left and right are within the bounds of array
+              i.e. array[left] and array[right] are valid elements
+            - left <= right
+        ensures
+            - for all elements in #array between and including left and right the
+              ith element is < the i+1 element
+            - sorts using a parallel merge sort
+    !*/
+
 // ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
 //                            IMPLEMENTATION DETAILS
@@ -338,6 +403,107 @@ namespace dlib
             }
         }
 
+// ----------------------------------------------------------------------------------------
+
+        template <
+            typename T,
+            typename compare
+            >
+        void merge_sorted_runs (
+            T& array,
+            const unsigned long left,
+            const unsigned long mid,
+            const unsigned long right,
+            const compare& comp
+        )
+        /*!
+            requires
+                - T implements operator[]
+                - the items in array must be comparable by comp
+                - the items in array must be swappable by a global swap() and default
+                  constructable
+                - left <= mid < right and all are within the bounds of array
+                - the ranges [left,mid] and [mid+1,right] are each sorted according
+                  to comp
+            ensures
+                - the range [left,right] in #array is sorted according to comp
+                - only moves elements via swap, using a temporary buffer the size of
+                  the left run
+        !*/
+        {
+            typedef typename std::remove_const<
+                typename std::remove_reference<decltype(array[left])>::type>::type value_type;
+
+            // swap the left run into a buffer, then merge the buffer and the right
+            // run back into the array.  The write position can never overtake the
+            // read position in the right run so this is safe to do in place.
+            std::vector<value_type> buf(mid-left+1);
+            for (unsigned long i = 0; i < buf.size(); ++i)
+                exchange(buf[i], array[left+i]);
+
+            unsigned long i = 0;
+            unsigned long j = mid+1;
+            unsigned long k = left;
+            while (i < buf.size() && j <= right)
+            {
+                if (comp(array[j], buf[i]))
+                    exchange(array[k++], array[j++]);
+                else
+                    exchange(array[k++], buf[i++]);
+            }
+            while (i < buf.size())
+                exchange(array[k++], buf[i++]);
+        }
+
+// ----------------------------------------------------------------------------------------
+
+        template <
+            typename T,
+            typename compare
+            >
+        void psort_array_main (
+            T& array,
+            const unsigned long left,
+            const unsigned long right,
+            const compare& comp,
+            const unsigned long num_threads
+        )
+        /*!
+            requires
+                - same as psort_array() except that num_threads > 0
+            ensures
+                - the range [left,right] in #array is sorted according to comp
+                - recursively splits the range in half, sorting the halves on up to
+                  num_threads threads and merging the results
+        !*/
+        {
+            // Below this size the cost of a thread launch and the merge buffer
+            // outweighs the parallelism, so just sort serially.
+            const unsigned long min_parallel_size = 10000;
+            if (num_threads < 2 || right-left < min_parallel_size)
+            {
+                qsort_array(array, left, right, comp);
+                return;
+            }
+
+            const unsigned long mid = left + (right-left)/2;
+            std::thread helper([&]()
+            {
+                psort_array_main(array, left, mid, comp, num_threads/2);
+            });
+            try
+            {
+                psort_array_main(array, mid+1, right, comp, num_threads-num_threads/2);
+            }
+            catch (...)
+            {
+                helper.join();
+                throw;
+            }
+            helper.join();
+            merge_sorted_runs(array, left, mid, right, comp);
+        }
+
 // ----------------------------------------------------------------------------------------
     }
 // ----------------------------------------------------------------------------------------
@@ -482,6 +648,46 @@ namespace dlib
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T,
+        typename compare
+        >
+    void psort_array (
+        T& array,
+        const unsigned long left,
+        const unsigned long right,
+        const compare& comp,
+        unsigned long num_threads
+    )
+    {
+        DLIB_ASSERT (left <= right,
+                "\tvoid psort_array()"
+                << "\n\tleft:          " << left
+                << "\n\tright:         " << right );
+
+        if (num_threads == 0)
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+        sort_helpers::psort_array_main(array, left, right, comp, num_threads);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    void psort_array (
+        T& array,
+        unsigned long left,
+        unsigned long right
+    )
+    {
+        using namespace sort_helpers;
+        psort_array(array, left, right, comp(array[left]));
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
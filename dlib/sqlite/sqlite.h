@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <limits>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -42,6 +43,10 @@ namespace dlib
         };
     }
 
+// --------------------------------------------------------------------------------------------
+
+    class statement;
+
 // --------------------------------------------------------------------------------------------
 
     class database : noncopyable
@@ -69,6 +74,8 @@ namespace dlib
             const std::string& file
         )
         {
+            // any cached statements belong to the old connection
+            stmt_cache.clear();
             filename = file;
             sqlite3* ptr = 0;
             int status = sqlite3_open(file.c_str(), &ptr);
@@ -96,6 +103,10 @@ namespace dlib
             const std::string& sql_statement
         );
 
+        inline statement& get_prepared_statement (
+            const std::string& sql_statement
+        );
+
         int64 last_insert_rowid (
         ) const
         {
@@ -108,6 +119,7 @@ namespace dlib
 
         std::string filename;
         std::shared_ptr<sqlite3> db;
+        std::map<std::string, std::shared_ptr<statement> > stmt_cache;
     };
 
 // --------------------------------------------------------------------------------------------
@@ -617,6 +629,26 @@ namespace dlib
         statement(*this, sql_statement).exec();
     }
 
+// --------------------------------------------------------------------------------------------
+
+    statement& database::
+    get_prepared_statement (
+        const std::string& sql_statement
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT(is_open() == true,
+                    "\t statement& database::get_prepared_statement()"
+                    << "\n\t The database must be opened before calling this routine."
+                    << "\n\t this: " << this
+        );
+
+        std::shared_ptr<statement>& st = stmt_cache[sql_statement];
+        if (!st)
+            st = std::make_shared<statement>(*this, sql_statement);
+        return *st;
+    }
+
 // --------------------------------------------------------------------------------------------
 
 }
@@ -117,6 +117,23 @@ namespace dlib
                 - executes the supplied SQL statement against this database
         !*/
 
+        statement& get_prepared_statement (
+            const std::string& sql_statement
+        );
+        /*!
+            requires
+                - is_open() == true
+            ensures
+                - returns a statement for executing sql_statement against this database.
+                  The statement is compiled the first time a given SQL string is passed
+                  to this routine and then cached, keyed on the exact SQL text, so
+                  repeatedly executing the same parameterized statement skips the SQL
+                  compilation step.  This matters when doing a lot of small operations,
+                  such as writing many rows one INSERT at a time.
+                - The returned reference, and any bindings made on it, stay valid until
+                  either this database object is destructed or open() is called.
+        !*/
+
         int64 last_insert_rowid (
         ) const;
         /*!
@@ -47,6 +47,27 @@ namespace dlib
 
 // ----------------------------------------------------------------------------------------
 
+    template <
+        typename bind_funct
+        >
+    void exec_batched (
+        database& db,
+        const std::string& sql_statement,
+        unsigned long num_rows,
+        bind_funct bind_row
+    )
+    {
+        transaction trans(db);
+        statement& st = db.get_prepared_statement(sql_statement);
+        for (unsigned long row = 0; row < num_rows; ++row)
+        {
+            bind_row(st, row);
+            st.exec();
+        }
+        trans.commit();
+    }
+
+// ----------------------------------------------------------------------------------------
 
     template <
         typename T
@@ -54,6 +54,39 @@ namespace dlib
 
     };
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename bind_funct
+        >
+    void exec_batched (
+        database& db,
+        const std::string& sql_statement,
+        unsigned long num_rows,
+        bind_funct bind_row
+    );
+    /*!
+        requires
+            - db.is_open() == true
+            - bind_row must be a function object with a signature compatible with:
+                void bind_row(statement& st, unsigned long row)
+              which binds the parameters of sql_statement for the given row index.
+        ensures
+            - Executes sql_statement num_rows times inside a single database
+              transaction, calling bind_row(st, row) before each execution with row
+              counting up from 0 to num_rows-1.  The statement is compiled once via
+              db.get_prepared_statement() and reused for every row.
+            - This is the fast way to bulk load rows into a table.  Executing each
+              INSERT as its own implicit transaction forces a filesystem sync per row,
+              which limits throughput to a few thousand rows per second, while one
+              big transaction with a reused prepared statement runs orders of
+              magnitude faster.
+            - If an exception is thrown by bind_row or the statement execution then
+              the whole transaction is rolled back and none of the rows are written.
+        throws
+            - sqlite_error or any exception thrown by bind_row
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -5,6 +5,7 @@
 
 #include "static_map/static_map_kernel_1.h"
 #include "static_map/static_map_kernel_c.h"
+#include "static_map/mapped_static_map.h"
 
 #include <functional>
 
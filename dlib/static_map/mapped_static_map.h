@@ -0,0 +1,340 @@
+// Copyright (C) 2005  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_MAPPED_STATIC_MAp_H_
+#define DLIB_MAPPED_STATIC_MAp_H_
+
+#include "mapped_static_map_abstract.h"
+#include "../interfaces/map_pair.h"
+#include "../interfaces/enumerable.h"
+#include "../algs.h"
+#include "../uintn.h"
+#include "../noncopyable.h"
+#include "../serialize.h"
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        const char mapped_static_map_magic[8] = {'S','M','M','M','A','P','0','1'};
+
+        // The key and value arrays both start on 16 byte boundaries within the file so
+        // a page aligned mapping of it keeps them suitably aligned for any normal type.
+        inline size_t mapped_static_map_align (
+            size_t num
+        ) { return (num+15)&~static_cast<size_t>(15); }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename domain,
+        typename range
+        >
+    void save_mapped_static_map (
+        const enumerable<map_pair<domain,range> >& items,
+        const std::string& filename
+    )
+    {
+        using namespace impl;
+        static_assert(std::is_trivially_copyable<domain>::value && std::is_trivially_copyable<range>::value,
+            "save_mapped_static_map() only works with trivially copyable key and value types.");
+
+        std::ofstream out(filename.c_str(), std::ios::binary);
+        if (!out)
+            throw serialization_error("Unable to open " + filename + " for writing.");
+
+        out.write(mapped_static_map_magic, sizeof(mapped_static_map_magic));
+        uint64 temp = items.size();
+        out.write((const char*)&temp, sizeof(temp));
+        temp = sizeof(domain);
+        out.write((const char*)&temp, sizeof(temp));
+        temp = sizeof(range);
+        out.write((const char*)&temp, sizeof(temp));
+
+        // Write all the keys followed by all the values so a reader can binary search
+        // the keys without pulling the value pages into memory.  We make two passes
+        // over items rather than buffering everything since the map might be huge.
+        items.reset();
+        while (items.move_next())
+            out.write((const char*)&items.element().key(), sizeof(domain));
+
+        const size_t keys_end = 32 + sizeof(domain)*items.size();
+        for (size_t i = keys_end; i < mapped_static_map_align(keys_end); ++i)
+            out.put('\0');
+
+        items.reset();
+        while (items.move_next())
+            out.write((const char*)&items.element().value(), sizeof(range));
+        items.reset();
+
+        if (!out)
+            throw serialization_error("Error while writing mapped static_map to " + filename);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename domain,
+        typename range,
+        typename compare = std::less<domain>
+        >
+    class mapped_static_map : noncopyable
+    {
+        /*!
+            CONVENTION
+                - is_loaded() == (data != 0)
+                - size() == map_size
+                - if (is_loaded()) then
+                    - data points at the start of the file contents.  When the platform
+                      supports it this is a read-only memory mapping of the file, so the
+                      pages holding the arrays are shared between every process that maps
+                      the same file and are faulted in only as lookups touch them.
+                    - d points at the array of map_size keys inside the mapping, sorted
+                      ascending according to compare.
+                    - r points at the array of map_size values inside the mapping.
+                    - for every i: operator[](d[i]) == r+i
+        !*/
+
+        static_assert(std::is_trivially_copyable<domain>::value && std::is_trivially_copyable<range>::value,
+            "mapped_static_map only works with trivially copyable key and value types.");
+        static_assert(alignof(domain) <= 16 && alignof(range) <= 16,
+            "mapped_static_map only supports key and value types with alignment of at most 16.");
+
+    public:
+        typedef domain domain_type;
+        typedef range range_type;
+        typedef compare compare_type;
+
+        mapped_static_map (
+        ) : data(0), data_size(0), mapped(false), map_size(0), d(0), r(0) {}
+
+        explicit mapped_static_map (
+            const std::string& filename
+        ) : data(0), data_size(0), mapped(false), map_size(0), d(0), r(0)
+        {
+            load(filename);
+        }
+
+        ~mapped_static_map (
+        )
+        {
+            unload();
+        }
+
+        void load (
+            const std::string& filename
+        )
+        {
+            using namespace impl;
+            unload();
+            map_file(filename);
+
+            try
+            {
+                if (data_size < 32 ||
+                    std::memcmp(data, mapped_static_map_magic, sizeof(mapped_static_map_magic)) != 0)
+                    throw serialization_error("The file " + filename + " is not a dlib mapped static_map.");
+
+                uint64 size, dsize, rsize;
+                std::memcpy(&size,  data+8,  sizeof(size));
+                std::memcpy(&dsize, data+16, sizeof(dsize));
+                std::memcpy(&rsize, data+24, sizeof(rsize));
+                if (dsize != sizeof(domain) || rsize != sizeof(range))
+                    throw serialization_error("The key or value type stored in " + filename +
+                        " doesn't match the types this mapped_static_map was instantiated with.");
+
+                const size_t keys_begin = 32;
+                const size_t values_begin = mapped_static_map_align(keys_begin + sizeof(domain)*size);
+                if (values_begin + sizeof(range)*size > data_size)
+                    throw serialization_error("Unexpected end of file while loading mapped static_map from " + filename);
+
+                map_size = static_cast<size_t>(size);
+                d = (const domain*)(data + keys_begin);
+                r = (const range*)(data + values_begin);
+            }
+            catch (...)
+            {
+                unload();
+                throw;
+            }
+        }
+
+        bool is_loaded (
+        ) const { return data != 0; }
+
+        size_t size (
+        ) const { return map_size; }
+
+        const range* operator[] (
+            const domain& d_item
+        ) const
+        {
+            unsigned long pos;
+            if (binary_search(d_item,pos))
+                return r+pos;
+            else
+                return 0;
+        }
+
+        const domain& key (
+            size_t idx
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(idx < size(),
+                "\t const domain& mapped_static_map::key(idx)"
+                << "\n\t idx must be less than size()"
+                << "\n\t idx:    " << idx
+                << "\n\t size(): " << size()
+                << "\n\t this:   " << this
+                );
+
+            return d[idx];
+        }
+
+        const range& value (
+            size_t idx
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(idx < size(),
+                "\t const range& mapped_static_map::value(idx)"
+                << "\n\t idx must be less than size()"
+                << "\n\t idx:    " << idx
+                << "\n\t size(): " << size()
+                << "\n\t this:   " << this
+                );
+
+            return r[idx];
+        }
+
+    private:
+
+        bool binary_search (
+            const domain& item,
+            unsigned long& pos
+        ) const
+        /*!
+            ensures
+                - if (there is an item in d equivalent to item) then
+                    - returns true
+                    - d[#pos] is equivalent item
+                - else
+                    - returns false
+        !*/
+        {
+            unsigned long high = map_size;
+            unsigned long low = 0;
+            unsigned long p = map_size;
+            unsigned long idx;
+            while (p > 0)
+            {
+                p = (high-low)>>1;
+                idx = p+low;
+                if (comp(item , d[idx]))
+                {
+                    high = idx;
+                }
+                else if (comp(d[idx] , item))
+                {
+                    low = idx;
+                }
+                else
+                {
+                    pos = idx;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void map_file (
+            const std::string& filename
+        )
+        {
+#ifndef _WIN32
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd != -1)
+            {
+                struct stat st;
+                if (::fstat(fd, &st) == 0 && st.st_size > 0)
+                {
+                    void* ptr = ::mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+                    if (ptr != MAP_FAILED)
+                    {
+                        ::close(fd);
+                        data = (const char*)ptr;
+                        data_size = st.st_size;
+                        mapped = true;
+                        return;
+                    }
+                }
+                ::close(fd);
+            }
+#endif
+            // No mmap support (or the mapping failed), fall back to reading the whole
+            // file into a private buffer.  Loading is still one bulk read but the
+            // pages are no longer shared between processes.
+            std::ifstream in(filename.c_str(), std::ios::binary);
+            if (!in)
+                throw serialization_error("Unable to open " + filename);
+            in.seekg(0, std::ios::end);
+            buffer.resize(static_cast<size_t>(in.tellg()));
+            in.seekg(0);
+            in.read(&buffer[0], buffer.size());
+            if (!in)
+                throw serialization_error("Error while reading " + filename);
+            data = &buffer[0];
+            data_size = buffer.size();
+            mapped = false;
+        }
+
+        void unload (
+        )
+        {
+#ifndef _WIN32
+            if (mapped && data != 0)
+                ::munmap((void*)data, data_size);
+#endif
+            data = 0;
+            data_size = 0;
+            mapped = false;
+            buffer.clear();
+            buffer.shrink_to_fit();
+            map_size = 0;
+            d = 0;
+            r = 0;
+        }
+
+        const char* data;
+        size_t data_size;
+        bool mapped;
+        std::vector<char> buffer;
+
+        size_t map_size;
+        const domain* d;
+        const range* r;
+        compare comp;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_MAPPED_STATIC_MAp_H_
@@ -0,0 +1,182 @@
+// Copyright (C) 2005  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_MAPPED_STATIC_MAP_ABSTRACt_H_
+#ifdef DLIB_MAPPED_STATIC_MAP_ABSTRACt_H_
+
+#include "../interfaces/map_pair.h"
+#include "../interfaces/enumerable.h"
+#include <functional>
+#include <string>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename domain,
+        typename range
+        >
+    void save_mapped_static_map (
+        const enumerable<map_pair<domain,range> >& items,
+        const std::string& filename
+    );
+    /*!
+        requires
+            - domain and range are trivially copyable types
+            - items enumerates its elements in ascending order according to the compare
+              function the reader will be instantiated with.  (This is the case for
+              static_map and dlib::map objects, so you can pass one of those directly.)
+        ensures
+            - writes the contents of items to the file named by filename in the flat
+              binary layout read by mapped_static_map.  The file holds a small header
+              followed by the sorted array of keys and then the array of values, each
+              stored as raw in-memory bytes, so it can be memory mapped and used in
+              place without any parsing.
+            - #items.at_start() == true
+        throws
+            - serialization_error
+                This exception is thrown if the file can't be created or written.  Note
+                that the file is written in the native byte order and struct layout, so
+                it is only readable on machines with the same representation that wrote
+                it (which is what you want for a memory mapped file).
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename domain,
+        typename range,
+        typename compare = std::less<domain>
+        >
+    class mapped_static_map : noncopyable
+    {
+        /*!
+            REQUIREMENTS ON domain and range
+                Both must be trivially copyable types with an alignment of at most 16
+                (i.e. simple structs or fundamental types whose bytes can be used
+                directly out of a file).
+
+            INITIAL VALUE
+                - is_loaded() == false
+                - size() == 0
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a read-only view of a static_map that has been written to
+                a file with save_mapped_static_map().  Rather than deserializing the map
+                into freshly allocated memory the way static_map's deserialize() does,
+                it memory maps the file and binary searches the key array in place.
+                This means opening a file takes a constant amount of time regardless of
+                its size, only the pages actually touched by lookups are read from disk,
+                and every process that opens the same file shares a single copy of it in
+                the operating system's page cache.  This is the tool to use when many
+                worker processes all need the same large lookup table.
+
+                On platforms without memory mapping the whole file is read into a
+                private buffer instead, so the object still works everywhere, just
+                without the page sharing.
+
+            THREAD SAFETY
+                Once loaded, all the const member functions of this object can be called
+                concurrently without synchronization.
+        !*/
+
+    public:
+        typedef domain domain_type;
+        typedef range range_type;
+        typedef compare compare_type;
+
+        mapped_static_map (
+        );
+        /*!
+            ensures
+                - #*this is properly initialized
+        !*/
+
+        explicit mapped_static_map (
+            const std::string& filename
+        );
+        /*!
+            ensures
+                - #*this is properly initialized
+                - performs load(filename)
+        !*/
+
+        ~mapped_static_map (
+        );
+        /*!
+            ensures
+                - any memory mapping held by this object is released
+        !*/
+
+        void load (
+            const std::string& filename
+        );
+        /*!
+            ensures
+                - opens the file named by filename, which must have been created by
+                  save_mapped_static_map() with the same domain and range types.
+                - #is_loaded() == true
+                - #size() == the number of key/value pairs stored in the file
+            throws
+                - serialization_error
+                    This exception is thrown if the file can't be opened, isn't a
+                    mapped static_map file, or stores key or value types of a different
+                    size than domain and range.  If this exception is thrown then
+                    #is_loaded() == false.
+        !*/
+
+        bool is_loaded (
+        ) const;
+        /*!
+            ensures
+                - returns true if a file has been successfully load()ed and false
+                  otherwise
+        !*/
+
+        size_t size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of key/value pairs in this map
+        !*/
+
+        const range* operator[] (
+            const domain& d
+        ) const;
+        /*!
+            ensures
+                - if (there is an element in this map equivalent to d) then
+                    - returns a pointer to the value associated with d
+                - else
+                    - returns 0
+        !*/
+
+        const domain& key (
+            size_t idx
+        ) const;
+        /*!
+            requires
+                - idx < size()
+            ensures
+                - returns the idx-th key in this map.  The keys are stored in ascending
+                  order according to compare, so key(0) is the smallest key.
+        !*/
+
+        const range& value (
+            size_t idx
+        ) const;
+        /*!
+            requires
+                - idx < size()
+            ensures
+                - returns the value associated with key(idx)
+        !*/
+
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_MAPPED_STATIC_MAP_ABSTRACt_H_
@@ -12,6 +12,7 @@
 #include "statistics/average_precision.h"
 #include "statistics/vector_normalizer_frobmetric.h"
 #include "statistics/lda.h"
+#include "statistics/pairwise_distances.h"
 
 #endif // DLIB_STATISTICs_H_ 
 
@@ -0,0 +1,141 @@
+// Copyright (C) 2015  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_PAIRWISE_DISTANCEs_H_
+#define DLIB_PAIRWISE_DISTANCEs_H_
+
+#include "pairwise_distances_abstract.h"
+#include <cmath>
+#include <vector>
+#include "../matrix.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename EXP1,
+        typename EXP2
+        >
+    matrix<typename EXP1::type> pairwise_squared_distances (
+        const matrix_exp<EXP1>& samples1,
+        const matrix_exp<EXP2>& samples2
+    )
+    {
+        COMPILE_TIME_ASSERT((is_same_type<typename EXP1::type, typename EXP2::type>::value));
+        DLIB_ASSERT(samples1.size() > 0 && samples2.size() > 0 &&
+                    samples1.nc() == samples2.nc(),
+            "\tmatrix pairwise_squared_distances(samples1, samples2)"
+            << "\n\t Invalid inputs were given to this function "
+            << "\n\t samples1.nr(): " << samples1.nr()
+            << "\n\t samples1.nc(): " << samples1.nc()
+            << "\n\t samples2.nr(): " << samples2.nr()
+            << "\n\t samples2.nc(): " << samples2.nc()
+            );
+
+        typedef typename EXP1::type T;
+
+        // Use the identity |a-b|^2 == |a|^2 + |b|^2 - 2*dot(a,b).  Writing it this way
+        // turns the O(N*M) pairwise loop into one matrix multiply, which runs blocked
+        // and vectorized (and via BLAS when DLIB_USE_BLAS is defined) rather than a
+        // row at a time.
+        const matrix<T,0,1> norms1 = sum_cols(squared(samples1));
+        const matrix<T,0,1> norms2 = sum_cols(squared(samples2));
+
+        matrix<T> dists = samples1*trans(samples2);
+        for (long r = 0; r < dists.nr(); ++r)
+        {
+            for (long c = 0; c < dists.nc(); ++c)
+            {
+                // rounding error can drive tiny distances slightly negative
+                dists(r,c) = std::max<T>(norms1(r) + norms2(c) - 2*dists(r,c), 0);
+            }
+        }
+        return dists;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename EXP1,
+        typename EXP2
+        >
+    matrix<typename EXP1::type> pairwise_distances (
+        const matrix_exp<EXP1>& samples1,
+        const matrix_exp<EXP2>& samples2
+    )
+    {
+        matrix<typename EXP1::type> dists = pairwise_squared_distances(samples1, samples2);
+        for (long r = 0; r < dists.nr(); ++r)
+        {
+            for (long c = 0; c < dists.nc(); ++c)
+                dists(r,c) = std::sqrt(dists(r,c));
+        }
+        return dists;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        template <typename sample_type>
+        matrix<typename sample_type::type> pack_as_rows (
+            const std::vector<sample_type>& samples
+        )
+        {
+            matrix<typename sample_type::type> out(samples.size(), samples[0].size());
+            for (unsigned long i = 0; i < samples.size(); ++i)
+            {
+                DLIB_ASSERT(is_vector(samples[i]) && samples[i].size() == out.nc(),
+                    "\t pairwise_distances()"
+                    << "\n\t All the samples given to this function must be vectors with the same length."
+                    << "\n\t samples["<<i<<"].size(): " << samples[i].size()
+                    << "\n\t samples[0].size():       " << out.nc()
+                    );
+                set_rowm(out,i) = trans(reshape_to_column_vector(samples[i]));
+            }
+            return out;
+        }
+    }
+
+    template <
+        typename sample_type
+        >
+    matrix<typename sample_type::type> pairwise_squared_distances (
+        const std::vector<sample_type>& samples1,
+        const std::vector<sample_type>& samples2
+    )
+    {
+        DLIB_ASSERT(samples1.size() > 0 && samples2.size() > 0,
+            "\tmatrix pairwise_squared_distances(samples1, samples2)"
+            << "\n\t You can't give empty sets of samples to this function "
+            << "\n\t samples1.size(): " << samples1.size()
+            << "\n\t samples2.size(): " << samples2.size()
+            );
+
+        return pairwise_squared_distances(impl::pack_as_rows(samples1), impl::pack_as_rows(samples2));
+    }
+
+    template <
+        typename sample_type
+        >
+    matrix<typename sample_type::type> pairwise_distances (
+        const std::vector<sample_type>& samples1,
+        const std::vector<sample_type>& samples2
+    )
+    {
+        DLIB_ASSERT(samples1.size() > 0 && samples2.size() > 0,
+            "\tmatrix pairwise_distances(samples1, samples2)"
+            << "\n\t You can't give empty sets of samples to this function "
+            << "\n\t samples1.size(): " << samples1.size()
+            << "\n\t samples2.size(): " << samples2.size()
+            );
+
+        return pairwise_distances(impl::pack_as_rows(samples1), impl::pack_as_rows(samples2));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_PAIRWISE_DISTANCEs_H_
@@ -0,0 +1,106 @@
+// Copyright (C) 2015  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_PAIRWISE_DISTANCEs_ABSTRACT_H_
+#ifdef DLIB_PAIRWISE_DISTANCEs_ABSTRACT_H_
+
+#include <vector>
+#include "../matrix.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    const matrix_exp pairwise_squared_distances (
+        const matrix_exp& samples1,
+        const matrix_exp& samples2
+    );
+    /*!
+        requires
+            - samples1.size() > 0
+            - samples2.size() > 0
+            - samples1.nc() == samples2.nc()
+            - samples1 and samples2 contain the same type of elements.
+        ensures
+            - Interprets each row of samples1 and samples2 as a vector and computes all
+              the squared Euclidean distances between the rows of samples1 and the rows
+              of samples2.  In particular, this function returns a matrix D such that:
+                - D.nr() == samples1.nr()
+                - D.nc() == samples2.nr()
+                - for all valid r and c:
+                    - D(r,c) == length_squared(rowm(samples1,r) - rowm(samples2,c))
+            - Rather than looping over the output elements, this function computes D
+              with the identity |a-b|^2 == |a|^2 + |b|^2 - 2*dot(a,b), so the dominant
+              cost is one matrix multiply.  That makes it very much faster than naively
+              comparing every pair of rows, especially against a large gallery of
+              vectors such as the embeddings produced by a loss_metric network.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    const matrix_exp pairwise_distances (
+        const matrix_exp& samples1,
+        const matrix_exp& samples2
+    );
+    /*!
+        requires
+            - samples1.size() > 0
+            - samples2.size() > 0
+            - samples1.nc() == samples2.nc()
+            - samples1 and samples2 contain the same type of elements.
+        ensures
+            - returns sqrt(pairwise_squared_distances(samples1, samples2))
+              (i.e. the same thing but with each element being a Euclidean distance
+              rather than a squared Euclidean distance)
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sample_type
+        >
+    matrix<typename sample_type::type> pairwise_squared_distances (
+        const std::vector<sample_type>& samples1,
+        const std::vector<sample_type>& samples2
+    );
+    /*!
+        requires
+            - sample_type is a dlib::matrix capable of representing a vector
+            - samples1.size() > 0
+            - samples2.size() > 0
+            - all the vectors in samples1 and samples2 have the same length
+        ensures
+            - This function is identical to the matrix version of
+              pairwise_squared_distances() defined above except it takes its inputs as
+              ordinary vectors of samples.  In particular, it returns a matrix D such
+              that:
+                - D.nr() == samples1.size()
+                - D.nc() == samples2.size()
+                - for all valid r and c:
+                    - D(r,c) == length_squared(samples1[r] - samples2[c])
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sample_type
+        >
+    matrix<typename sample_type::type> pairwise_distances (
+        const std::vector<sample_type>& samples1,
+        const std::vector<sample_type>& samples2
+    );
+    /*!
+        requires
+            - sample_type is a dlib::matrix capable of representing a vector
+            - samples1.size() > 0
+            - samples2.size() > 0
+            - all the vectors in samples1 and samples2 have the same length
+        ensures
+            - returns sqrt(pairwise_squared_distances(samples1, samples2))
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_PAIRWISE_DISTANCEs_ABSTRACT_H_
@@ -166,6 +166,82 @@ namespace dlib
             ++count;
         }
 
+        template <typename iter_type>
+        void add (
+            iter_type begin,
+            iter_type end
+        )
+        {
+            while (begin != end)
+                add(*begin++);
+        }
+
+        void merge (
+            const random_subset_selector& item
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(max_size() == item.max_size(),
+                "\tvoid random_subset_selector::merge()"
+                << "\n\t Only selectors with equal max sizes can be merged"
+                << "\n\t max_size():      " << max_size()
+                << "\n\t item.max_size(): " << item.max_size()
+                << "\n\t this:            " << this
+                );
+
+            // Note that each of the two item lists is a uniform random sample of the
+            // stream of objects fed to its selector.  So to merge them we simulate
+            // drawing max_size() objects, without replacement, from the union of the
+            // two streams.  Each draw first picks which stream the object came from,
+            // with probability proportional to how many objects of that stream remain,
+            // and then pulls a random element out of that stream's sample.  This makes
+            // the merged result statistically identical to having fed both streams
+            // through a single selector.
+            std::vector<T> a(items), b(item.items);
+            uint64 remaining_a = count;
+            uint64 remaining_b = item.count;
+            const uint64 total = remaining_a + remaining_b;
+
+            std::vector<T> result;
+            uint64 result_size = total;
+            if (_max_size < result_size)
+                result_size = _max_size;
+            result.reserve(static_cast<size_t>(result_size));
+
+            for (uint64 i = 0; i < result_size; ++i)
+            {
+                // Make me a random 64 bit number, just like update_next_add_accepts()
+                // does, since the stream counts can be very large.
+                const unsigned long num1 = rnd.get_random_32bit_number();
+                const unsigned long num2 = rnd.get_random_32bit_number();
+                uint64 num = num1;
+                num <<= 32;
+                num |= num2;
+                num %= (remaining_a + remaining_b);
+
+                if (num < remaining_a)
+                {
+                    const unsigned long idx = rnd.get_random_32bit_number()%a.size();
+                    result.push_back(a[idx]);
+                    a[idx] = a.back();
+                    a.pop_back();
+                    --remaining_a;
+                }
+                else
+                {
+                    const unsigned long idx = rnd.get_random_32bit_number()%b.size();
+                    result.push_back(b[idx]);
+                    b[idx] = b.back();
+                    b.pop_back();
+                    --remaining_b;
+                }
+            }
+
+            items.swap(result);
+            count = total;
+            update_next_add_accepts();
+        }
+
         void swap (
             random_subset_selector& a
         )
@@ -179,6 +179,40 @@ namespace dlib
                 - This function does nothing but update the value of #next_add_accepts()
         !*/
 
+        template <typename iter_type>
+        void add (
+            iter_type begin,
+            iter_type end
+        );
+        /*!
+            requires
+                - [begin, end) is a valid range of objects of type T
+            ensures
+                - performs: for each x in the range [begin, end): add(x)
+        !*/
+
+        void merge (
+            const random_subset_selector& item
+        );
+        /*!
+            requires
+                - max_size() == item.max_size()
+            ensures
+                - Merges item into *this.  That is, #*this is statistically
+                  equivalent to a selector that sampled, in a single pass, the
+                  concatenation of the streams of objects given to *this and item.
+                  In particular, if both selectors were fed their items via add()
+                  then each object from either stream ends up in #*this with equal
+                  probability.  This allows a sampling task to be split across many
+                  selectors, each processing a shard of the data, and the results
+                  combined into one statistically correct random subset.
+                - #size() == min(max_size(), the total number of items added to both
+                  *this and item)
+                - #next_add_accepts() == The updated information about the acceptance
+                  of the next call to add()
+                - item is unmodified
+        !*/
+
         iterator begin(
         );
         /*!
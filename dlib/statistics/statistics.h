@@ -6,9 +6,12 @@
 #include "statistics_abstract.h"
 #include <limits>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include "../algs.h"
 #include "../matrix.h"
 #include "../sparse_vector.h"
+#include "../simd.h"
 
 namespace dlib
 {
@@ -62,6 +65,14 @@ namespace dlib
             ++n;
         }
 
+        void add (
+            const T* vals,
+            size_t num
+        )
+        {
+            batch_add(vals, num);
+        }
+
         T current_n (
         ) const
         {
@@ -225,6 +236,60 @@ namespace dlib
     
         T cubed  (const T& val) const {return val*val*val; }
         T quaded (const T& val) const {return val*val*val*val; }
+
+        void batch_add (
+            const float* vals,
+            size_t num
+        )
+        {
+            // Accumulate 8 samples at a time.  Note that this sums the moments in a
+            // different order than repeated calls to add(), so the results can differ
+            // from scalar accumulation by normal floating point rounding.
+            size_t i = 0;
+            if (num >= 8)
+            {
+                simd8f s = 0, s2 = 0, s3 = 0, s4 = 0;
+                simd8f mn = std::numeric_limits<float>::infinity();
+                simd8f mx = -std::numeric_limits<float>::infinity();
+                for (; i+8 <= num; i += 8)
+                {
+                    simd8f v;
+                    v.load(vals+i);
+                    const simd8f v2 = v*v;
+                    s  += v;
+                    s2 += v2;
+                    s3 += v2*v;
+                    s4 += v2*v2;
+                    mn = dlib::min(mn, v);
+                    mx = dlib::max(mx, v);
+                }
+                sum      += dlib::sum(s);
+                sum_sqr  += dlib::sum(s2);
+                sum_cub  += dlib::sum(s3);
+                sum_four += dlib::sum(s4);
+                n += i;
+
+                float temp[8];
+                mn.store(temp);
+                for (int k = 0; k < 8; ++k)
+                    min_value = std::min<T>(min_value, temp[k]);
+                mx.store(temp);
+                for (int k = 0; k < 8; ++k)
+                    max_value = std::max<T>(max_value, temp[k]);
+            }
+            for (; i < num; ++i)
+                add(vals[i]);
+        }
+
+        template <typename U>
+        void batch_add (
+            const U* vals,
+            size_t num
+        )
+        {
+            for (size_t i = 0; i < num; ++i)
+                add(vals[i]);
+        }
     };
 
     template <typename T>
@@ -265,6 +330,333 @@ namespace dlib
         deserialize(item.max_value, in);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    class running_quantile
+    {
+    public:
+
+        running_quantile()
+        {
+            COMPILE_TIME_ASSERT ((
+                    is_same_type<float,T>::value ||
+                    is_same_type<double,T>::value ||
+                    is_same_type<long double,T>::value
+            ));
+
+            prob = 0.5;
+            clear();
+        }
+
+        explicit running_quantile (
+            double quantile_,
+            unsigned long exact_window_size = 0
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(0 < quantile_ && quantile_ < 1,
+                "\trunning_quantile::running_quantile"
+                << "\n\tinvalid quantile level"
+                << "\n\tquantile_: " << quantile_
+                << "\n\tthis: " << this
+                );
+
+            COMPILE_TIME_ASSERT ((
+                    is_same_type<float,T>::value ||
+                    is_same_type<double,T>::value ||
+                    is_same_type<long double,T>::value
+            ));
+
+            prob = quantile_;
+            window.resize(exact_window_size);
+            scratch.resize(exact_window_size);
+            clear();
+        }
+
+        void clear()
+        {
+            n = 0;
+            next = 0;
+            for (int i = 0; i < 5; ++i)
+            {
+                heights[i] = 0;
+                pos[i] = i+1;
+            }
+            des[0] = 1;
+            des[1] = 1 + 2*prob;
+            des[2] = 1 + 4*prob;
+            des[3] = 3 + 2*prob;
+            des[4] = 5;
+        }
+
+        double quantile_level (
+        ) const
+        {
+            return prob;
+        }
+
+        unsigned long window_size (
+        ) const
+        {
+            return window.size();
+        }
+
+        T current_n (
+        ) const
+        {
+            return n;
+        }
+
+        void add (
+            const T& val
+        )
+        {
+            if (window.size() != 0)
+            {
+                window[next] = val;
+                next = (next+1)%window.size();
+                n += 1;
+                return;
+            }
+
+            if (n < 5)
+            {
+                // The first five samples just seed the P-squared markers.  Keep them
+                // sorted so quantile() is exact while we are still buffering.
+                long i = static_cast<long>(n);
+                heights[i] = val;
+                while (i > 0 && heights[i] < heights[i-1])
+                {
+                    std::swap(heights[i], heights[i-1]);
+                    --i;
+                }
+                n += 1;
+                return;
+            }
+
+            // Find the cell containing val and update the extreme markers.
+            long k;
+            if (val < heights[0])
+            {
+                heights[0] = val;
+                k = 0;
+            }
+            else if (val >= heights[4])
+            {
+                heights[4] = val;
+                k = 3;
+            }
+            else
+            {
+                for (k = 0; k < 3; ++k)
+                {
+                    if (val < heights[k+1])
+                        break;
+                }
+            }
+
+            for (long i = k+1; i < 5; ++i)
+                pos[i] += 1;
+            des[1] += prob/2;
+            des[2] += prob;
+            des[3] += (1+prob)/2;
+            des[4] += 1;
+            n += 1;
+
+            // Adjust the interior markers towards their desired positions using a
+            // piecewise-parabolic fit, falling back to linear interpolation whenever
+            // the parabolic prediction would break marker monotonicity.
+            for (long i = 1; i <= 3; ++i)
+            {
+                const T d = des[i] - pos[i];
+                if ((d >= 1 && pos[i+1]-pos[i] > 1) || (d <= -1 && pos[i-1]-pos[i] < -1))
+                {
+                    const long s = (d >= 0) ? 1 : -1;
+                    const T hp = heights[i] + s/(pos[i+1]-pos[i-1]) *
+                        ((pos[i]-pos[i-1]+s)*(heights[i+1]-heights[i])/(pos[i+1]-pos[i]) +
+                         (pos[i+1]-pos[i]-s)*(heights[i]-heights[i-1])/(pos[i]-pos[i-1]));
+                    if (heights[i-1] < hp && hp < heights[i+1])
+                        heights[i] = hp;
+                    else
+                        heights[i] = heights[i] + s*(heights[i+s]-heights[i])/(pos[i+s]-pos[i]);
+                    pos[i] += s;
+                }
+            }
+        }
+
+        T quantile (
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(current_n() > 0,
+                "\tT running_quantile::quantile"
+                << "\n\tyou have to add some numbers to this object first"
+                << "\n\tthis: " << this
+                );
+
+            if (window.size() != 0)
+            {
+                const unsigned long m = std::min<unsigned long>(static_cast<unsigned long>(n), window.size());
+                std::copy(window.begin(), window.begin()+m, scratch.begin());
+                const unsigned long idx = rank_index(m);
+                std::nth_element(scratch.begin(), scratch.begin()+idx, scratch.begin()+m);
+                return scratch[idx];
+            }
+
+            if (n <= 5)
+                return heights[rank_index(static_cast<unsigned long>(n))];
+
+            return heights[2];
+        }
+
+        running_quantile operator+ (
+            const running_quantile& rhs
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(quantile_level() == rhs.quantile_level() &&
+                        window_size() == rhs.window_size(),
+                "\trunning_quantile running_quantile::operator+"
+                << "\n\tyou can only merge estimators tracking the same quantile"
+                << "\n\tquantile_level():     " << quantile_level()
+                << "\n\trhs.quantile_level(): " << rhs.quantile_level()
+                << "\n\twindow_size():        " << window_size()
+                << "\n\trhs.window_size():    " << rhs.window_size()
+                << "\n\tthis: " << this
+                );
+
+            // If either side is still buffering raw samples then just replay them
+            // into the other.  This is exact.
+            if (rhs.window.size() != 0 || rhs.n < 5)
+            {
+                running_quantile temp(*this);
+                rhs.replay_into(temp);
+                return temp;
+            }
+            if (n < 5)
+            {
+                running_quantile temp(rhs);
+                replay_into(temp);
+                return temp;
+            }
+
+            // Both sides are running P-squared estimators, so merge their markers.
+            // The extreme markers combine exactly and the interior heights are
+            // averaged with weights proportional to how many samples each side saw.
+            running_quantile temp(*this);
+            temp.heights[0] = std::min(heights[0], rhs.heights[0]);
+            temp.heights[4] = std::max(heights[4], rhs.heights[4]);
+            for (int i = 1; i < 4; ++i)
+                temp.heights[i] = (heights[i]*n + rhs.heights[i]*rhs.n)/(n + rhs.n);
+            temp.n = n + rhs.n;
+            temp.pos[0] = 1;
+            for (int i = 1; i < 4; ++i)
+                temp.pos[i] = std::max(pos[i] + rhs.pos[i] - 1, temp.pos[i-1]+1);
+            temp.pos[4] = std::max(temp.n, temp.pos[3]+1);
+            temp.des[0] = 1;
+            temp.des[1] = 1 + (temp.n-1)*prob/2;
+            temp.des[2] = 1 + (temp.n-1)*prob;
+            temp.des[3] = 1 + (temp.n-1)*(1+prob)/2;
+            temp.des[4] = temp.n;
+            return temp;
+        }
+
+        template <typename U>
+        friend void serialize (
+            const running_quantile<U>& item,
+            std::ostream& out
+        );
+
+        template <typename U>
+        friend void deserialize (
+            running_quantile<U>& item,
+            std::istream& in
+        );
+
+    private:
+
+        unsigned long rank_index (
+            unsigned long m
+        ) const
+        {
+            // the nearest-rank index of the prob quantile among m sorted samples
+            unsigned long idx = static_cast<unsigned long>(std::ceil(prob*m));
+            if (idx > 0)
+                --idx;
+            if (idx >= m)
+                idx = m-1;
+            return idx;
+        }
+
+        void replay_into (
+            running_quantile& dest
+        ) const
+        {
+            const unsigned long m = window.size() != 0 ?
+                std::min<unsigned long>(static_cast<unsigned long>(n), window.size()) :
+                static_cast<unsigned long>(n);
+            for (unsigned long i = 0; i < m; ++i)
+                dest.add(window.size() != 0 ? window[i] : heights[i]);
+        }
+
+        double prob;
+        T n;
+        T heights[5];
+        T pos[5];
+        T des[5];
+        unsigned long next;
+        std::vector<T> window;
+        mutable std::vector<T> scratch;
+    };
+
+    template <typename T>
+    void serialize (
+        const running_quantile<T>& item,
+        std::ostream& out
+    )
+    {
+        int version = 1;
+        serialize(version, out);
+
+        serialize(item.prob, out);
+        serialize(item.n, out);
+        for (int i = 0; i < 5; ++i)
+            serialize(item.heights[i], out);
+        for (int i = 0; i < 5; ++i)
+            serialize(item.pos[i], out);
+        for (int i = 0; i < 5; ++i)
+            serialize(item.des[i], out);
+        serialize(item.next, out);
+        serialize(item.window, out);
+    }
+
+    template <typename T>
+    void deserialize (
+        running_quantile<T>& item,
+        std::istream& in
+    )
+    {
+        int version = 0;
+        deserialize(version, in);
+        if (version != 1)
+            throw dlib::serialization_error("Unexpected version number found while deserializing dlib::running_quantile object.");
+
+        deserialize(item.prob, in);
+        deserialize(item.n, in);
+        for (int i = 0; i < 5; ++i)
+            deserialize(item.heights[i], in);
+        for (int i = 0; i < 5; ++i)
+            deserialize(item.pos[i], in);
+        for (int i = 0; i < 5; ++i)
+            deserialize(item.des[i], in);
+        deserialize(item.next, in);
+        deserialize(item.window, in);
+        item.scratch.resize(item.window.size());
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -1113,6 +1505,173 @@ namespace dlib
         long vect_size;
     };
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename matrix_type
+        >
+    class running_covariance_welford
+    {
+        /*!
+            INITIAL VALUE
+                - vect_size == 0
+                - total_count == 0
+
+            CONVENTION
+                - vect_size == in_vector_size()
+                - total_count == current_n()
+
+                - if (total_count != 0)
+                    - running_mean == the mean of all vectors given to add()
+                    - comoment == the sum of (x-running_mean)*trans(x-running_mean) over
+                      all the vectors x given to add().  Therefore, the covariance of
+                      those vectors is comoment/(total_count-1).
+        !*/
+    public:
+
+        typedef typename matrix_type::mem_manager_type mem_manager_type;
+        typedef typename matrix_type::type scalar_type;
+        typedef typename matrix_type::layout_type layout_type;
+        typedef matrix<scalar_type,0,0,mem_manager_type,layout_type> general_matrix;
+        typedef matrix<scalar_type,0,1,mem_manager_type,layout_type> column_matrix;
+
+        running_covariance_welford(
+        )
+        {
+            clear();
+        }
+
+        void clear(
+        )
+        {
+            total_count = 0;
+
+            vect_size = 0;
+
+            running_mean.set_size(0);
+            comoment.set_size(0,0);
+        }
+
+        long in_vector_size (
+        ) const
+        {
+            return vect_size;
+        }
+
+        long current_n (
+        ) const
+        {
+            return static_cast<long>(total_count);
+        }
+
+        template <typename T>
+        void add (
+            const T& val
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(is_col_vector(val) && (in_vector_size() == 0 || val.size() == in_vector_size()),
+                "\t void running_covariance_welford::add()"
+                << "\n\t Invalid inputs were given to this function"
+                << "\n\t is_col_vector(val): " << is_col_vector(val)
+                << "\n\t in_vector_size():   " << in_vector_size()
+                << "\n\t val.size():         " << val.size()
+                << "\n\t this:               " << this
+                );
+
+            if (total_count == 0)
+            {
+                vect_size = val.size();
+                running_mean = matrix_cast<scalar_type>(val);
+                comoment.set_size(val.size(), val.size());
+                comoment = 0;
+                total_count = 1;
+            }
+            else
+            {
+                ++total_count;
+                const column_matrix delta = val - running_mean;
+                running_mean += delta/total_count;
+                comoment += delta*trans(val - running_mean);
+            }
+        }
+
+        const column_matrix mean (
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT( in_vector_size() != 0,
+                "\t running_covariance_welford::mean()"
+                << "\n\t This object can not execute this function in its current state."
+                << "\n\t in_vector_size(): " << in_vector_size()
+                << "\n\t current_n():      " << current_n()
+                << "\n\t this:             " << this
+                );
+
+            return running_mean;
+        }
+
+        const general_matrix covariance (
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT( in_vector_size() != 0 && current_n() > 1,
+                "\t running_covariance_welford::covariance()"
+                << "\n\t This object can not execute this function in its current state."
+                << "\n\t in_vector_size(): " << in_vector_size()
+                << "\n\t current_n():      " << current_n()
+                << "\n\t this:             " << this
+                );
+
+            return comoment/(total_count-1);
+        }
+
+        const running_covariance_welford operator+ (
+            const running_covariance_welford& item
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT((in_vector_size() == 0 || item.in_vector_size() == 0 || in_vector_size() == item.in_vector_size()),
+                "\t running_covariance_welford running_covariance_welford::operator+()"
+                << "\n\t The two running_covariance_welford objects being added must have compatible parameters"
+                << "\n\t in_vector_size():            " << in_vector_size()
+                << "\n\t item.in_vector_size():       " << item.in_vector_size()
+                << "\n\t this:                        " << this
+                );
+
+            running_covariance_welford temp(item);
+
+            // make sure we ignore empty accumulators
+            if (total_count != 0 && temp.total_count != 0)
+            {
+                // This is the pairwise merge of Chan, Golub, and LeVeque.
+                const scalar_type n = total_count + temp.total_count;
+                const column_matrix delta = temp.running_mean - running_mean;
+                temp.comoment += comoment + delta*trans(delta)*(total_count*temp.total_count/n);
+                temp.running_mean = (total_count*running_mean + temp.total_count*temp.running_mean)/n;
+                temp.total_count = n;
+            }
+            else if (total_count != 0)
+            {
+                temp.comoment = comoment;
+                temp.running_mean = running_mean;
+                temp.total_count = total_count;
+                temp.vect_size = vect_size;
+            }
+
+            return temp;
+        }
+
+
+    private:
+
+        general_matrix comoment;
+        column_matrix running_mean;
+        scalar_type total_count;
+
+        long vect_size;
+    };
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -1477,6 +2036,24 @@ namespace dlib
             DLIB_ASSERT(is_finite(m), "Some of the input vectors to vector_normalizer::train() have infinite or NaN values");
         }
 
+        void train (
+            const running_covariance_welford<matrix_type>& stats
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(stats.current_n() > 1,
+                "\tvoid vector_normalizer::train()"
+                << "\n\tyou have to give a statistics accumulator with at least 2 samples in it"
+                << "\n\tstats.current_n(): " << stats.current_n()
+                << "\n\tthis: " << this
+                );
+
+            m = stats.mean();
+            sd = reciprocal(sqrt(diag(stats.covariance())));
+
+            DLIB_ASSERT(is_finite(m), "Some of the input vectors given to vector_normalizer::train() have infinite or NaN values");
+        }
+
         long in_vector_size (
         ) const
         {
@@ -1519,6 +2096,29 @@ namespace dlib
             return temp_out;
         }
 
+        void normalize_rows (
+            matrix<scalar_type,0,0,mem_manager_type>& samples
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(samples.nc() == in_vector_size(),
+                "\tvoid vector_normalizer::normalize_rows()"
+                << "\n\t you have given invalid arguments to this function"
+                << "\n\t samples.nc():     " << samples.nc()
+                << "\n\t in_vector_size(): " << in_vector_size()
+                << "\n\t this:             " << this
+                );
+
+            // Normalize every row of samples in place.  Doing the whole batch with one
+            // pass over the memory is much faster than calling operator() once per
+            // sample since no temporary matrices get allocated.
+            for (long r = 0; r < samples.nr(); ++r)
+            {
+                for (long c = 0; c < samples.nc(); ++c)
+                    samples(r,c) = (samples(r,c) - m(c))*sd(c);
+            }
+        }
+
         void swap (
             vector_normalizer& item
         )
@@ -1641,6 +2241,34 @@ namespace dlib
             DLIB_ASSERT(is_finite(m), "Some of the input vectors to vector_normalizer_pca::train() have infinite or NaN values");
         }
 
+        void train (
+            const running_covariance_welford<matrix_type>& stats,
+            const double eps = 0.99
+        )
+        {
+            // You are getting an error here because you are trying to apply PCA
+            // to a vector of fixed length.  But PCA is going to try and do
+            // dimensionality reduction so you can't use a vector with a fixed dimension.
+            COMPILE_TIME_ASSERT(matrix_type::NR == 0);
+
+            // make sure requires clause is not broken
+            DLIB_ASSERT(stats.current_n() > 1,
+                "\tvoid vector_normalizer_pca::train()"
+                << "\n\tyou have to give a statistics accumulator with at least 2 samples in it"
+                << "\n\tstats.current_n(): " << stats.current_n()
+                << "\n\tthis: " << this
+                );
+            DLIB_ASSERT(0 < eps && eps <= 1,
+                "\tvoid vector_normalizer_pca::train()"
+                << "\n\tyou have given an invalid eps to this function"
+                << "\n\teps: " << eps
+                << "\n\tthis: " << this
+                );
+            train_whitening_impl(stats.mean(), stats.covariance(), eps);
+
+            DLIB_ASSERT(is_finite(m), "Some of the input vectors given to vector_normalizer_pca::train() have infinite or NaN values");
+        }
+
         long in_vector_size (
         ) const
         {
@@ -1692,6 +2320,32 @@ namespace dlib
             return temp_out;
         }
 
+        void normalize_rows (
+            const matrix<scalar_type,0,0,mem_manager_type>& samples,
+            matrix<scalar_type,0,0,mem_manager_type>& result
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(samples.nc() == in_vector_size(),
+                "\tvoid vector_normalizer_pca::normalize_rows()"
+                << "\n\t you have given invalid arguments to this function"
+                << "\n\t samples.nc():     " << samples.nc()
+                << "\n\t in_vector_size(): " << in_vector_size()
+                << "\n\t this:             " << this
+                );
+
+            // Normalize the whole batch in one pass over the memory and then apply the
+            // pca transform to every sample with a single matrix multiply, which is
+            // much faster than calling operator() once per sample.
+            matrix<scalar_type,0,0,mem_manager_type> x(samples);
+            for (long r = 0; r < x.nr(); ++r)
+            {
+                for (long c = 0; c < x.nc(); ++c)
+                    x(r,c) = (x(r,c) - m(c))*sd(c);
+            }
+            result = x*trans(pca);
+        }
+
         void swap (
             vector_normalizer_pca& item
         )
@@ -1760,13 +2414,57 @@ namespace dlib
                 x(r) = pca*x(r);
             }
 
-            // Here we just scale the output features from the pca transform so 
+            // Here we just scale the output features from the pca transform so
             // that the variance of each feature is 1.  So this doesn't really change
             // what the pca is doing, it just makes sure the output features are
             // normalized.
             pca = trans(scale_columns(trans(pca), reciprocal(sqrt(variance(x)))));
         }
 
+        void train_whitening_impl (
+            const matrix<scalar_type,0,1,mem_manager_type>& sample_mean,
+            const matrix<scalar_type,0,0,mem_manager_type>& sample_cov,
+            const double eps
+        )
+        {
+            m = sample_mean;
+            sd = reciprocal(sqrt(diag(sample_cov)));
+
+            // The covariance of the variance-normalized samples D*(x-m), where
+            // D == diag(sd), is D*sample_cov*D.
+            const matrix<scalar_type,0,0,mem_manager_type> cov_norm = pointwise_multiply(sample_cov, sd*trans(sd));
+
+            matrix<scalar_type,0,0,mem_manager_type> temp, eigen;
+            matrix<scalar_type,0,1,mem_manager_type> eigenvalues;
+
+            // Compute the svd of the covariance matrix of the normalized inputs
+            svd(cov_norm, temp, eigen, pca);
+            eigenvalues = diag(eigen);
+
+            rsort_columns(pca, eigenvalues);
+
+            // figure out how many eigenvectors we want in our pca matrix
+            const double thresh = sum(eigenvalues)*eps;
+            long num_vectors = 0;
+            double total = 0;
+            for (long r = 0; r < eigenvalues.size() && total < thresh; ++r)
+            {
+                ++num_vectors;
+                total += eigenvalues(r);
+            }
+
+            // So now we know we want to use num_vectors of the first eigenvectors.  So
+            // pull those out and discard the rest.
+            pca = trans(colm(pca,range(0,num_vectors-1)));
+
+            // Scale the output features from the pca transform so that the variance of
+            // each feature is 1, just like train_pca_impl() does.  The variance of the
+            // i-th pca output is exactly the i-th eigenvalue, so unlike that function
+            // we don't need a pass over the data here.
+            eigenvalues = rowm(eigenvalues, range(0,num_vectors-1));
+            pca = trans(scale_columns(trans(pca), reciprocal(sqrt(eigenvalues))));
+        }
+
 
         // ------------------- private data members -------------------
 
@@ -232,6 +232,22 @@ namespace dlib
                 - #current_n() == current_n() + 1
         !*/
 
+        void add (
+            const T* vals,
+            size_t num
+        );
+        /*!
+            requires
+                - vals points to an array of at least num values.
+            ensures
+                - performs: for all valid i: add(vals[i])
+                - This does the same thing as calling add() num times but goes through
+                  the array with SIMD instructions when T is float, which is a lot
+                  faster when you are feeding in bulk samples.  Note that the moments
+                  are accumulated in a different order than repeated add() calls, so
+                  the outputs can differ by normal floating point rounding.
+        !*/
+
         T mean (
         ) const;
         /*!
@@ -338,6 +354,157 @@ namespace dlib
         provides serialization support 
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    class running_quantile
+    {
+        /*!
+            REQUIREMENTS ON T
+                - T must be a float, double, or long double type
+
+            INITIAL VALUE
+                - current_n() == 0
+                - quantile_level() == 0.5
+                - window_size() == 0
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a running estimator of a single quantile of a stream of
+                real numbers.  By default it uses the P-squared algorithm of Jain and
+                Chlamtac, which tracks the quantile with five markers and therefore
+                uses O(1) memory and O(1) time per sample, regardless of how many
+                samples you feed it.  The estimate is exact until 5 samples have been
+                added and approximate thereafter.
+
+                Alternatively, you can construct it with a nonzero exact_window_size,
+                in which case it stores the most recent exact_window_size samples in a
+                preallocated circular buffer and quantile() returns the exact
+                nearest-rank quantile of that window.  No memory is allocated after
+                construction in either mode.
+        !*/
+    public:
+
+        running_quantile(
+        );
+        /*!
+            ensures
+                - this object is properly initialized
+        !*/
+
+        explicit running_quantile (
+            double quantile_,
+            unsigned long exact_window_size = 0
+        );
+        /*!
+            requires
+                - 0 < quantile_ < 1
+            ensures
+                - this object is properly initialized
+                - #quantile_level() == quantile_
+                - #window_size() == exact_window_size
+                - if (exact_window_size != 0) then
+                    - this object computes exact quantiles over a sliding window of
+                      the most recent exact_window_size samples.
+                - else
+                    - this object tracks the quantile with the P-squared algorithm.
+        !*/
+
+        void clear(
+        );
+        /*!
+            ensures
+                - this object has its initial value, except that quantile_level() and
+                  window_size() are unchanged.
+                - clears all memory of any previous data points
+        !*/
+
+        double quantile_level (
+        ) const;
+        /*!
+            ensures
+                - returns the quantile level this object is tracking.  E.g. a value of
+                  0.5 means quantile() estimates the median while 0.99 means it
+                  estimates the 99th percentile.
+        !*/
+
+        unsigned long window_size (
+        ) const;
+        /*!
+            ensures
+                - returns the size of the exact sliding window, or 0 if this object is
+                  using the P-squared algorithm.
+        !*/
+
+        T current_n (
+        ) const;
+        /*!
+            ensures
+                - returns the number of points given to this object so far.
+        !*/
+
+        void add (
+            const T& val
+        );
+        /*!
+            ensures
+                - updates the quantile estimate stored in this object so that the new
+                  value is factored into it.
+                - #current_n() == current_n() + 1
+        !*/
+
+        T quantile (
+        ) const;
+        /*!
+            requires
+                - current_n() > 0
+            ensures
+                - if (window_size() != 0) then
+                    - returns the exact nearest-rank quantile_level() quantile of the
+                      most recent min(current_n(), window_size()) samples.
+                - else
+                    - returns the current estimate of the quantile_level() quantile of
+                      all the values presented to this object so far.  The estimate is
+                      exact if current_n() <= 5.
+        !*/
+
+        running_quantile operator+ (
+            const running_quantile& rhs
+        ) const;
+        /*!
+            requires
+                - quantile_level() == rhs.quantile_level()
+                - window_size() == rhs.window_size()
+            ensures
+                - returns a new running_quantile object that represents the
+                  combination of all the values given to *this and rhs.  If both
+                  objects are running the P-squared algorithm the merge is
+                  approximate, combining their markers with weights proportional to
+                  how many samples each side saw.  If either side still holds raw
+                  samples (i.e. it is in sliding window mode or has seen fewer than 5
+                  samples) those samples are simply replayed into the result.
+        !*/
+    };
+
+    template <typename T>
+    void serialize (
+        const running_quantile<T>& item,
+        std::ostream& out
+    );
+    /*!
+        provides serialization support
+    !*/
+
+    template <typename T>
+    void deserialize (
+        running_quantile<T>& item,
+        std::istream& in
+    );
+    /*!
+        provides serialization support
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -865,13 +1032,132 @@ namespace dlib
                 - in_vector_size() == 0 || item.in_vector_size() == 0 || in_vector_size() == item.in_vector_size()
                   (i.e. the in_vector_size() of *this and item must match or one must be zero)
             ensures
-                - returns a new running_covariance object that represents the combination of all 
+                - returns a new running_covariance object that represents the combination of all
                   the vectors given to *this and item.  That is, this function returns a
                   running_covariance object, R, that is equivalent to what you would obtain if all
                   calls to this->add() and item.add() had instead been done to R.
         !*/
     };
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename matrix_type
+        >
+    class running_covariance_welford
+    {
+        /*!
+            REQUIREMENTS ON matrix_type
+                Must be some type of dlib::matrix.
+
+            INITIAL VALUE
+                - in_vector_size() == 0
+                - current_n() == 0
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a tool for computing the mean and covariance of a
+                sequence of vectors, just like running_covariance.  The difference is
+                that it uses Welford's rank-1 update internally instead of accumulating
+                raw sums of squares.  This makes it numerically stable over extremely
+                long streams of data (e.g. billions of samples), where
+                running_covariance can suffer catastrophic cancellation.  The tradeoff
+                is that each call to add() is a little more expensive.
+
+                Like running_covariance, objects of this type can be merged with
+                operator+, so separate accumulators can be filled from multiple threads
+                or machines and combined at the end.
+        !*/
+    public:
+
+        typedef typename matrix_type::mem_manager_type mem_manager_type;
+        typedef typename matrix_type::type scalar_type;
+        typedef typename matrix_type::layout_type layout_type;
+        typedef matrix<scalar_type,0,0,mem_manager_type,layout_type> general_matrix;
+        typedef matrix<scalar_type,0,1,mem_manager_type,layout_type> column_matrix;
+
+        running_covariance_welford(
+        );
+        /*!
+            ensures
+                - this object is properly initialized
+        !*/
+
+        void clear(
+        );
+        /*!
+            ensures
+                - this object has its initial value
+                - clears all memory of any previous data points
+        !*/
+
+        long current_n (
+        ) const;
+        /*!
+            ensures
+                - returns the number of samples that have been presented to this object
+        !*/
+
+        long in_vector_size (
+        ) const;
+        /*!
+            ensures
+                - if (this object has been presented with any input vectors) then
+                    - returns the dimension of the column vectors used with this object
+                - else
+                    - returns 0
+        !*/
+
+        template <typename T>
+        void add (
+            const T& val
+        );
+        /*!
+            requires
+                - val must represent a column vector.  It can be a dense matrix.
+                - val.size() == in_vector_size() || in_vector_size() == 0
+            ensures
+                - updates the mean and covariance stored in this object so that
+                  the new value is factored into them.
+                - #in_vector_size() == val.size()
+        !*/
+
+        const column_matrix mean (
+        ) const;
+        /*!
+            requires
+                - in_vector_size() != 0
+            ensures
+                - returns the mean of all the vectors presented to this object
+                  so far.
+        !*/
+
+        const general_matrix covariance (
+        ) const;
+        /*!
+            requires
+                - in_vector_size() != 0
+                - current_n() > 1
+            ensures
+                - returns the unbiased sample covariance matrix for all the vectors
+                  presented to this object so far.
+        !*/
+
+        const running_covariance_welford operator+ (
+            const running_covariance_welford& item
+        ) const;
+        /*!
+            requires
+                - in_vector_size() == 0 || item.in_vector_size() == 0 || in_vector_size() == item.in_vector_size()
+                  (i.e. the in_vector_size() of *this and item must match or one must be zero)
+            ensures
+                - returns a new running_covariance_welford object that represents the
+                  combination of all the vectors given to *this and item.  That is, this
+                  function returns a running_covariance_welford object, R, that is
+                  equivalent to what you would obtain if all calls to this->add() and
+                  item.add() had instead been done to R.
+        !*/
+    };
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -1105,6 +1391,25 @@ namespace dlib
                 - #std_devs() == reciprocal(sqrt(variance(samples)));
         !*/
 
+        void train (
+            const running_covariance_welford<matrix_type>& stats
+        );
+        /*!
+            requires
+                - stats.current_n() > 1
+                - the data given to stats did not contain any infinite or NaN values
+            ensures
+                - performs the same training as the sample based train() above, except
+                  the mean and variances are taken from the given streaming accumulator
+                  rather than computed from an in-memory set of samples.  This lets you
+                  fit a normalizer over a data stream of any length using constant
+                  memory.
+                - #in_vector_size() == stats.in_vector_size()
+                - #out_vector_size() == stats.in_vector_size()
+                - #means() == stats.mean()
+                - #std_devs() == reciprocal(sqrt(diag(stats.covariance())));
+        !*/
+
         long in_vector_size (
         ) const;
         /*!
@@ -1160,6 +1465,21 @@ namespace dlib
                     - Z == pointwise_multiply(x-means(), std_devs());
         !*/
 
+        void normalize_rows (
+            matrix<scalar_type,0,0,mem_manager_type>& samples
+        ) const;
+        /*!
+            requires
+                - samples.nc() == in_vector_size()
+            ensures
+                - interprets each row of samples as one input vector and normalizes all
+                  of them in place.  That is, for all valid r:
+                    - #rowm(samples,r) == trans((*this)(trans(rowm(samples,r))))
+                - This does the same thing as calling operator() on each sample but is
+                  much faster for large batches since it makes one pass over the memory
+                  and allocates no temporaries.
+        !*/
+
         void swap (
             vector_normalizer& item
         );
@@ -1271,6 +1591,32 @@ namespace dlib
                   rows by in_vector_size() columns.
         !*/
 
+        void train (
+            const running_covariance_welford<matrix_type>& stats,
+            const double eps = 0.99
+        );
+        /*!
+            requires
+                - 0 < eps <= 1
+                - stats.current_n() > 1
+                - the data given to stats did not contain any infinite or NaN values
+            ensures
+                - performs the same training as the sample based train() above, except
+                  the whitening transform is computed from the mean and covariance
+                  stored in the given streaming accumulator rather than from an
+                  in-memory set of samples.  This lets you fit the normalizer over a
+                  data stream of any length using constant memory.  Note that while the
+                  resulting transform is mathematically equivalent to the one the
+                  sample based train() finds, it is not guaranteed to be bit-wise
+                  identical (e.g. the signs of the rows of pca_matrix() can differ).
+                - #in_vector_size() == stats.in_vector_size()
+                - 0 < #out_vector_size() <= stats.in_vector_size()
+                - #means() == stats.mean()
+                - #std_devs() == reciprocal(sqrt(diag(stats.covariance())));
+                - #pca_matrix() == the PCA transform matrix that is out_vector_size()
+                  rows by in_vector_size() columns.
+        !*/
+
         long in_vector_size (
         ) const;
         /*!
@@ -1337,6 +1683,25 @@ namespace dlib
                     - Z == pca_matrix()*pointwise_multiply(x-means(), std_devs());
         !*/
 
+        void normalize_rows (
+            const matrix<scalar_type,0,0,mem_manager_type>& samples,
+            matrix<scalar_type,0,0,mem_manager_type>& result
+        ) const;
+        /*!
+            requires
+                - samples.nc() == in_vector_size()
+            ensures
+                - interprets each row of samples as one input vector and normalizes all
+                  of them into #result.  That is:
+                    - #result.nr() == samples.nr()
+                    - #result.nc() == out_vector_size()
+                    - for all valid r:
+                        - rowm(#result,r) == trans((*this)(trans(rowm(samples,r))))
+                - This does the same thing as calling operator() on each sample but is
+                  much faster for large batches since the pca projection of the whole
+                  batch is performed with a single matrix multiply.
+        !*/
+
         void swap (
             vector_normalizer_pca& item
         );
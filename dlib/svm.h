@@ -30,6 +30,7 @@
 #include "svm/svm_c_linear_dcd_trainer.h"
 #include "svm/svm_c_ekm_trainer.h"
 #include "svm/simplify_linear_decision_function.h"
+#include "svm/fast_sparse_linear_function.h"
 #include "svm/krr_trainer.h"
 #include "svm/sort_basis_vectors.h"
 #include "svm/svm_c_trainer.h"
@@ -109,15 +109,99 @@ namespace dlib
         bool forces_assignment (
         ) const { return force_assignment; }
 
+        struct solver_state
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is opaque scratch space for predict_assignments().  It holds
+                    the Hungarian solver, whose dual variables warm start the next
+                    solve, along with reusable cost matrix buffers.  Keep one of
+                    these around and pass it to every call when solving a sequence
+                    of similar assignment problems, such as associating detections
+                    to tracks once per video frame.
+            !*/
+            max_cost_assignment_solver<dlib::int64> solver;
+            matrix<double> cost;
+            matrix<dlib::int64> int_cost;
+        };
+
+        void predict_assignments (
+            const std::vector<lhs_element>& lhs,
+            const std::vector<rhs_element>& rhs,
+            result_type& assignment
+        ) const
+        {
+            solver_state state;
+            predict_assignments_impl(lhs, rhs, assignment, state, false, no_gate());
+        }
+
         void predict_assignments (
             const std::vector<lhs_element>& lhs,
             const std::vector<rhs_element>& rhs,
+            result_type& assignment,
+            solver_state& state
+        ) const
+        {
+            predict_assignments_impl(lhs, rhs, assignment, state, true, no_gate());
+        }
+
+        template <typename gate_funct>
+        void predict_assignments (
+            const std::vector<lhs_element>& lhs,
+            const std::vector<rhs_element>& rhs,
+            result_type& assignment,
+            solver_state& state,
+            gate_funct&& gate
+        ) const
+        {
+            predict_assignments_impl(lhs, rhs, assignment, state, true, std::forward<gate_funct>(gate));
+        }
+
+        void predict_assignments (
+            const sample_type& item,
             result_type& assignment
         ) const
+        {
+            predict_assignments(item.first, item.second, assignment);
+        }
+
+        result_type operator()(
+            const std::vector<lhs_element>& lhs,
+            const std::vector<rhs_element>& rhs 
+        ) const
+        {
+            result_type temp;
+            predict_assignments(lhs,rhs,temp);
+            return temp;
+        }
+
+        result_type operator() (
+            const sample_type& item
+        ) const
+        {
+            return (*this)(item.first, item.second);
+        }
+
+    private:
+
+        struct no_gate
+        {
+            bool operator() (const lhs_element&, const rhs_element&) const { return true; }
+        };
+
+        template <typename gate_funct>
+        void predict_assignments_impl (
+            const std::vector<lhs_element>& lhs,
+            const std::vector<rhs_element>& rhs,
+            result_type& assignment,
+            solver_state& state,
+            const bool warm_start,
+            gate_funct&& gate
+        ) const
         {
             assignment.clear();
 
-            matrix<double> cost;
+            matrix<double>& cost = state.cost;
             unsigned long size;
             if (force_assignment)
             {
@@ -132,15 +216,29 @@ namespace dlib
             typedef typename feature_extractor::feature_vector_type feature_vector_type;
             feature_vector_type feats;
 
-            // now fill out the cost assignment matrix
+            // now fill out the cost assignment matrix.  Gated pairs skip feature
+            // extraction entirely and get marked so we can fill them in once the
+            // range of the real costs is known.
+            bool any_gated = false;
+            double lowest = 0, highest = 0; // the padding entries are 0
             for (long r = 0; r < cost.nr(); ++r)
             {
                 for (long c = 0; c < cost.nc(); ++c)
                 {
                     if (r < (long)lhs.size() && c < (long)rhs.size())
                     {
-                        fe.get_features(lhs[r], rhs[c], feats);
-                        cost(r,c) = dot(weights, feats) + bias;
+                        if (gate(lhs[r], rhs[c]))
+                        {
+                            fe.get_features(lhs[r], rhs[c], feats);
+                            cost(r,c) = dot(weights, feats) + bias;
+                            lowest = std::min(lowest, cost(r,c));
+                            highest = std::max(highest, cost(r,c));
+                        }
+                        else
+                        {
+                            cost(r,c) = std::numeric_limits<double>::infinity();
+                            any_gated = true;
+                        }
                     }
                     else
                     {
@@ -149,14 +247,32 @@ namespace dlib
                 }
             }
 
+            if (any_gated)
+            {
+                // Give pruned pairs a cost so much worse than every real option that
+                // the solver always prefers leaving both elements unassociated.
+                const double gated_cost = lowest - (highest - lowest) - 1;
+                for (long r = 0; r < (long)lhs.size(); ++r)
+                {
+                    for (long c = 0; c < (long)rhs.size(); ++c)
+                    {
+                        if (cost(r,c) == std::numeric_limits<double>::infinity())
+                            cost(r,c) = gated_cost;
+                    }
+                }
+            }
+
 
             if (cost.size() != 0)
             {
                 // max_cost_assignment() only works with integer matrices, so convert from
                 // double to integer.
                 const double scale = (std::numeric_limits<dlib::int64>::max()/1000)/max(abs(cost));
-                matrix<dlib::int64> int_cost = matrix_cast<dlib::int64>(round(cost*scale));
-                assignment = max_cost_assignment(int_cost);
+                state.int_cost = matrix_cast<dlib::int64>(round(cost*scale));
+                if (warm_start)
+                    assignment = state.solver.solve_warm_started(state.int_cost);
+                else
+                    assignment = state.solver(state.int_cost);
                 assignment.resize(lhs.size());
             }
 
@@ -168,34 +284,6 @@ namespace dlib
             }
         }
 
-        void predict_assignments (
-            const sample_type& item,
-            result_type& assignment
-        ) const
-        {
-            predict_assignments(item.first, item.second, assignment);
-        }
-
-        result_type operator()(
-            const std::vector<lhs_element>& lhs,
-            const std::vector<rhs_element>& rhs 
-        ) const
-        {
-            result_type temp;
-            predict_assignments(lhs,rhs,temp);
-            return temp;
-        }
-
-        result_type operator() (
-            const sample_type& item
-        ) const
-        {
-            return (*this)(item.first, item.second);
-        }
-
-    private:
-
-
         feature_extractor fe;
         matrix<double,0,1> weights;
         double bias;
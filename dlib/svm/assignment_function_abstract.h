@@ -299,13 +299,70 @@ namespace dlib
 
         void predict_assignments (
             const std::vector<lhs_element>& lhs,
-            const std::vector<rhs_element>& rhs 
+            const std::vector<rhs_element>& rhs
             result_type& assignment
         ) const;
         /*!
             ensures
                 - #assignment == (*this)(lhs,rhs)
         !*/
+
+        struct solver_state
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is opaque scratch space for the stateful overloads of
+                    predict_assignments() below.  It holds the Hungarian solver,
+                    whose dual variables warm start the next solve, along with
+                    reusable cost matrix buffers.  Keep one of these around and pass
+                    it to every call when solving a sequence of similar assignment
+                    problems, such as associating detections to tracks once per
+                    video frame.
+            !*/
+        };
+
+        void predict_assignments (
+            const std::vector<lhs_element>& lhs,
+            const std::vector<rhs_element>& rhs,
+            result_type& assignment,
+            solver_state& state
+        ) const;
+        /*!
+            ensures
+                - #assignment == (*this)(lhs,rhs)
+                - Unlike the overload above, this version keeps its solver scratch
+                  space in state and warm starts the assignment solve from the dual
+                  variables left behind by the previous call made with the same state
+                  object.  When consecutive calls pose similar problems the warm
+                  start substantially reduces solve time while producing exactly the
+                  same assignments.
+        !*/
+
+        template <typename gate_funct>
+        void predict_assignments (
+            const std::vector<lhs_element>& lhs,
+            const std::vector<rhs_element>& rhs,
+            result_type& assignment,
+            solver_state& state,
+            gate_funct&& gate
+        ) const;
+        /*!
+            requires
+                - gate must be a function object with a signature compatible with:
+                    bool gate(const lhs_element& l, const rhs_element& r)
+                  which returns false if l should never be associated to r.
+            ensures
+                - This overload is identical to the one above except that pairs
+                  rejected by the gate are pruned: no features are extracted for them
+                  and they are given a cost bad enough that the solver always prefers
+                  leaving both elements unassociated over matching them to each
+                  other.  A cheap gate, such as thresholding the distance between a
+                  detection and a track's predicted position, therefore avoids almost
+                  all the feature extraction work for implausible pairs.
+                - Note that if forces_assignment() == true the matching must still be
+                  complete, so gated pairs can end up matched anyway when there is no
+                  alternative.
+        !*/
     };
 
 // ----------------------------------------------------------------------------------------
@@ -10,6 +10,7 @@
 #include "../geometry.h"
 #include "../image_processing/full_object_detection.h"
 #include "../image_processing/box_overlap_testing.h"
+#include "../image_processing/object_detector.h"
 #include "../statistics.h"
 
 namespace dlib
@@ -222,6 +223,140 @@ namespace dlib
         return test_object_detection_function(detector,images,truth_dets,ignore, overlap_tester, adjust_threshold);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type,
+        typename image_array_type
+        >
+    const std::vector<matrix<double,1,3> > test_object_detection_function (
+        std::vector<object_detector<image_scanner_type> >& detectors,
+        const image_array_type& images,
+        const std::vector<std::vector<full_object_detection> >& truth_dets,
+        const std::vector<std::vector<rectangle> >& ignore,
+        const test_box_overlap& overlap_tester = test_box_overlap(),
+        const double adjust_threshold = 0
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_CASSERT( is_learning_problem(images,truth_dets) == true &&
+                        ignore.size() == images.size() &&
+                        detectors.size() > 0,
+                    "\t std::vector<matrix> test_object_detection_function()"
+                    << "\n\t invalid inputs were given to this function"
+                    << "\n\t is_learning_problem(images,truth_dets): " << is_learning_problem(images,truth_dets)
+                    << "\n\t ignore.size(): " << ignore.size()
+                    << "\n\t images.size(): " << images.size()
+                    << "\n\t detectors.size(): " << detectors.size()
+                    );
+
+        std::vector<double> correct_hits(detectors.size(), 0);
+        std::vector<double> total_true_targets(detectors.size(), 0);
+        std::vector<std::vector<std::pair<double,bool> > > all_dets(detectors.size());
+        std::vector<unsigned long> missing_detections(detectors.size(), 0);
+
+        // The feature pyramid computed by the scanner depends only on the scanner
+        // configuration and the image, not on a detector's weight vectors.  So we load
+        // each image into a shared detection context once and then score every
+        // detector in the sweep against it, rather than having every detector redo
+        // the feature extraction.
+        typename object_detector<image_scanner_type>::detection_context ctx(detectors[0]);
+
+        for (unsigned long i = 0; i < images.size(); ++i)
+        {
+            detectors[0].load(ctx, images[i]);
+            for (unsigned long d = 0; d < detectors.size(); ++d)
+            {
+                std::vector<std::pair<double,rectangle> > hits;
+                detectors[d].detect(ctx, hits, adjust_threshold);
+
+                correct_hits[d] += impl::number_of_truth_hits(truth_dets[i], ignore[i], hits, overlap_tester, all_dets[d], missing_detections[d]);
+                total_true_targets[d] += truth_dets[i].size();
+            }
+        }
+
+        std::vector<matrix<double,1,3> > results(detectors.size());
+        for (unsigned long d = 0; d < detectors.size(); ++d)
+        {
+            std::sort(all_dets[d].rbegin(), all_dets[d].rend());
+
+            double precision, recall;
+
+            const double total_hits = all_dets[d].size();
+
+            if (total_hits == 0)
+                precision = 1;
+            else
+                precision = correct_hits[d] / total_hits;
+
+            if (total_true_targets[d] == 0)
+                recall = 1;
+            else
+                recall = correct_hits[d] / total_true_targets[d];
+
+            results[d] = precision, recall, average_precision(all_dets[d], missing_detections[d]);
+        }
+        return results;
+    }
+
+    template <
+        typename image_scanner_type,
+        typename image_array_type
+        >
+    const std::vector<matrix<double,1,3> > test_object_detection_function (
+        std::vector<object_detector<image_scanner_type> >& detectors,
+        const image_array_type& images,
+        const std::vector<std::vector<rectangle> >& truth_dets,
+        const std::vector<std::vector<rectangle> >& ignore,
+        const test_box_overlap& overlap_tester = test_box_overlap(),
+        const double adjust_threshold = 0
+    )
+    {
+        // convert into a list of regular rectangles.
+        std::vector<std::vector<full_object_detection> > rects(truth_dets.size());
+        for (unsigned long i = 0; i < truth_dets.size(); ++i)
+        {
+            for (unsigned long j = 0; j < truth_dets[i].size(); ++j)
+            {
+                rects[i].push_back(full_object_detection(truth_dets[i][j]));
+            }
+        }
+
+        return test_object_detection_function(detectors, images, rects, ignore, overlap_tester, adjust_threshold);
+    }
+
+    template <
+        typename image_scanner_type,
+        typename image_array_type
+        >
+    const std::vector<matrix<double,1,3> > test_object_detection_function (
+        std::vector<object_detector<image_scanner_type> >& detectors,
+        const image_array_type& images,
+        const std::vector<std::vector<rectangle> >& truth_dets,
+        const test_box_overlap& overlap_tester = test_box_overlap(),
+        const double adjust_threshold = 0
+    )
+    {
+        std::vector<std::vector<rectangle> > ignore(images.size());
+        return test_object_detection_function(detectors,images,truth_dets,ignore, overlap_tester, adjust_threshold);
+    }
+
+    template <
+        typename image_scanner_type,
+        typename image_array_type
+        >
+    const std::vector<matrix<double,1,3> > test_object_detection_function (
+        std::vector<object_detector<image_scanner_type> >& detectors,
+        const image_array_type& images,
+        const std::vector<std::vector<full_object_detection> >& truth_dets,
+        const test_box_overlap& overlap_tester = test_box_overlap(),
+        const double adjust_threshold = 0
+    )
+    {
+        std::vector<std::vector<rectangle> > ignore(images.size());
+        return test_object_detection_function(detectors,images,truth_dets,ignore, overlap_tester, adjust_threshold);
+    }
+
 // ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------
@@ -131,6 +131,107 @@ namespace dlib
               given arguments and an empty set of ignore rectangles and returns the results.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename image_scanner_type,
+        typename image_array_type
+        >
+    const std::vector<matrix<double,1,3> > test_object_detection_function (
+        std::vector<object_detector<image_scanner_type> >& detectors,
+        const image_array_type& images,
+        const std::vector<std::vector<full_object_detection> >& truth_dets,
+        const std::vector<std::vector<rectangle> >& ignore,
+        const test_box_overlap& overlap_tester = test_box_overlap(),
+        const double adjust_threshold = 0
+    );
+    /*!
+        requires
+            - is_learning_problem(images,truth_dets)
+            - images.size() == ignore.size()
+            - detectors.size() > 0
+            - All the detectors have the same scanner configuration.  That is, they
+              differ only in their weight vectors, as is the case for detectors
+              produced by a hyperparameter sweep of structural_object_detection_trainer.
+            - image_array_type must be an implementation of dlib/array/array_kernel_abstract.h
+              and it must contain objects which can be accepted by the detectors.
+        ensures
+            - Tests every detector in detectors against the supplied object detection
+              problem.  Returns a vector R such that R[i] is the precision, recall, and
+              average precision matrix you would get from calling the single detector
+              version of test_object_detection_function() defined above on detectors[i].
+            - This function computes the scanner's feature pyramid for each image only
+              once and scores all the detectors against it, rather than letting each
+              detector redo the feature extraction.  Since feature extraction dominates
+              the runtime of a detection pass this makes evaluating a sweep of N
+              candidate detectors much cheaper than N separate validation runs.
+    !*/
+
+    template <
+        typename image_scanner_type,
+        typename image_array_type
+        >
+    const std::vector<matrix<double,1,3> > test_object_detection_function (
+        std::vector<object_detector<image_scanner_type> >& detectors,
+        const image_array_type& images,
+        const std::vector<std::vector<rectangle> >& truth_dets,
+        const std::vector<std::vector<rectangle> >& ignore,
+        const test_box_overlap& overlap_tester = test_box_overlap(),
+        const double adjust_threshold = 0
+    );
+    /*!
+        requires
+            - All the requirements of the above multi-detector
+              test_object_detection_function() routine.
+        ensures
+            - converts all the rectangles in truth_dets into full_object_detection objects
+              via full_object_detection's rectangle constructor.  Then invokes the
+              multi-detector test_object_detection_function() on the
+              full_object_detections and returns the results.
+    !*/
+
+    template <
+        typename image_scanner_type,
+        typename image_array_type
+        >
+    const std::vector<matrix<double,1,3> > test_object_detection_function (
+        std::vector<object_detector<image_scanner_type> >& detectors,
+        const image_array_type& images,
+        const std::vector<std::vector<rectangle> >& truth_dets,
+        const test_box_overlap& overlap_tester = test_box_overlap(),
+        const double adjust_threshold = 0
+    );
+    /*!
+        requires
+            - All the requirements of the above multi-detector
+              test_object_detection_function() routine.
+        ensures
+            - This function simply invokes the multi-detector
+              test_object_detection_function() with all the given arguments and an empty
+              set of ignore rectangles and returns the results.
+    !*/
+
+    template <
+        typename image_scanner_type,
+        typename image_array_type
+        >
+    const std::vector<matrix<double,1,3> > test_object_detection_function (
+        std::vector<object_detector<image_scanner_type> >& detectors,
+        const image_array_type& images,
+        const std::vector<std::vector<full_object_detection> >& truth_dets,
+        const test_box_overlap& overlap_tester = test_box_overlap(),
+        const double adjust_threshold = 0
+    );
+    /*!
+        requires
+            - All the requirements of the above multi-detector
+              test_object_detection_function() routine.
+        ensures
+            - This function simply invokes the multi-detector
+              test_object_detection_function() with all the given arguments and an empty
+              set of ignore rectangles and returns the results.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -282,13 +282,61 @@ namespace dlib
 
             temp1 = kernel_matrix(kernel, basis, samp);
             temp2 = weights*temp1;
-            // This value should never be negative (it measures squared distance) but I'm putting the abs() 
+            // This value should never be negative (it measures squared distance) but I'm putting the abs()
             // here just for good measure since rounding error might push it slightly negative.
             projection_error = std::abs( kernel(samp,samp) - dot(temp2,temp2));
 
             return temp2;
         }
 
+        template <typename T>
+        const matrix<scalar_type,0,0,mem_manager_type> project_batch (
+            const T& samps_
+        ) const
+        {
+            const auto& samps = mat(samps_);
+
+            // make sure requires clause is not broken
+            DLIB_ASSERT(out_vector_size() != 0 && samps.size() > 0 && is_vector(samps),
+                "\tconst matrix empirical_kernel_map::project_batch()"
+                << "\n\t Invalid inputs to this function."
+                << "\n\t out_vector_size(): " << out_vector_size()
+                << "\n\t samps.size():      " << samps.size()
+                << "\n\t is_vector(samps):  " << is_vector(samps)
+                << "\n\t this: " << this
+                );
+
+            // Materialize the kernel products for the whole block of samples and then
+            // apply the projection with a single matrix multiply.  When the BLAS
+            // bindings are enabled this turns into one GEMM call rather than a
+            // matrix-vector product per sample, which is a lot faster for big blocks.
+            const matrix<scalar_type,0,0,mem_manager_type> K(kernel_matrix(kernel, basis, samps));
+            return weights*K;
+        }
+
+        template <typename K2>
+        void convert_to (
+            const K2& kernel_,
+            empirical_kernel_map<K2>& target
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(out_vector_size() != 0,
+                "\tvoid empirical_kernel_map::convert_to()"
+                << "\n\t You have to load this object with data before you can call this function"
+                << "\n\t this: " << this
+                );
+
+            typedef typename K2::scalar_type target_scalar_type;
+
+            target.clear();
+            target.kernel = kernel_;
+            target.weights = matrix_cast<target_scalar_type>(weights);
+            target.basis.resize(basis.size());
+            for (unsigned long i = 0; i < basis.size(); ++i)
+                target.basis[i] = matrix_cast<target_scalar_type>(basis[i]);
+        }
+
         void swap (
             empirical_kernel_map& item
         )
@@ -323,6 +371,9 @@ namespace dlib
 
     private:
 
+        // so convert_to() can fill in the members of a map with a different kernel type
+        template <typename T> friend class empirical_kernel_map;
+
         template <typename T>
         void load_impl(
             const kernel_type& kernel_,
@@ -249,6 +249,51 @@ namespace dlib
                     pow(convert_to_distance_function(project(samp))(samp),2)
         !*/
 
+        template <typename T>
+        const matrix<scalar_type,0,0,mem_manager_type> project_batch (
+            const T& samps
+        ) const;
+        /*!
+            requires
+                - out_vector_size() != 0
+                - samps == a non-empty vector of sample_type objects (e.g. a std::vector
+                  or a dlib matrix vector)
+            ensures
+                - projects every element of samps exactly as project() would and returns
+                  all the results at once.  In particular, returns a matrix M such that:
+                    - M.nr() == out_vector_size()
+                    - M.nc() == samps.size()
+                    - colm(M,i) == project(samps(i))
+                - Projecting a block of samples this way is much faster than calling
+                  project() in a loop since the whole projection is done with a single
+                  matrix multiply, which the BLAS bindings turn into one GEMM call.
+        !*/
+
+        template <typename K2>
+        void convert_to (
+            const K2& kernel,
+            empirical_kernel_map<K2>& target
+        ) const;
+        /*!
+            requires
+                - out_vector_size() != 0
+                - kernel == a kernel function object that computes the same kernel as
+                  get_kernel() but using K2::scalar_type precision (e.g. a
+                  radial_basis_kernel over matrix<float> columns with the same gamma
+                  as this object's radial_basis_kernel over matrix<double> columns)
+                - K2::sample_type and sample_type must both be dlib matrix objects with
+                  the same dimensions.
+            ensures
+                - #target == a copy of *this with its basis vectors and projection
+                  weights stored in K2::scalar_type precision.  So, for example,
+                  converting a double precision empirical_kernel_map to single
+                  precision halves its resident size at the cost of a little projection
+                  accuracy.
+                - for any sample_type object S that is within the span of the basis
+                  samples, target.project(S converted to K2::sample_type) is
+                  approximately equal to project(S).
+        !*/
+
         template <typename EXP>
         const decision_function<kernel_type> convert_to_decision_function (
             const matrix_exp<EXP>& vect
@@ -0,0 +1,166 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_FAST_SPARSE_LINEAR_FUNCTIOn_Hh_
+#define DLIB_FAST_SPARSE_LINEAR_FUNCTIOn_Hh_
+
+#include <cmath>
+#include <vector>
+#include "fast_sparse_linear_function_abstract.h"
+#include "../algs.h"
+#include "../serialize.h"
+#include "../uintn.h"
+#include "function.h"
+#include "sparse_kernel.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sample_type
+        >
+    class fast_sparse_linear_function
+    {
+        /*!
+            INITIAL VALUE
+                - bias == 0
+                - quantized == false
+                - scale == 1
+                - weights.size() == 0
+                - qweights.size() == 0
+
+            CONVENTION
+                - if (quantized) then
+                    - weights.size() == 0
+                    - the effective weight on dimension i is qweights[i]*scale
+                - else
+                    - qweights.size() == 0
+                    - the effective weight on dimension i is weights[i]
+                - dimensions at or beyond the stored weight array have weight 0.
+        !*/
+
+    public:
+        typedef typename sample_type::value_type pair_type;
+        typedef typename pair_type::first_type key_type;
+        typedef typename pair_type::second_type scalar_type;
+
+        fast_sparse_linear_function (
+        ) : bias(0), scale(1), quantized(false) {}
+
+        explicit fast_sparse_linear_function (
+            const decision_function<sparse_linear_kernel<sample_type> >& df,
+            bool quantize = false
+        ) : bias(df.b), scale(1), quantized(quantize)
+        {
+            // Collapse the alpha weighted basis vectors into one dense weight array
+            // indexed directly by dimension.
+            for (long i = 0; i < df.basis_vectors.size(); ++i)
+            {
+                for (const auto& p : df.basis_vectors(i))
+                {
+                    if (p.first >= weights.size())
+                        weights.resize(p.first+1, 0);
+                    weights[p.first] += df.alpha(i)*p.second;
+                }
+            }
+
+            if (quantized)
+            {
+                scalar_type max_abs = 0;
+                for (const auto w : weights)
+                    max_abs = std::max<scalar_type>(max_abs, std::abs(w));
+                if (max_abs != 0)
+                    scale = max_abs/32767;
+
+                qweights.resize(weights.size());
+                for (size_t i = 0; i < weights.size(); ++i)
+                    qweights[i] = static_cast<int16>(std::round(weights[i]/scale));
+
+                weights.clear();
+                weights.shrink_to_fit();
+            }
+        }
+
+        scalar_type operator() (
+            const sample_type& x
+        ) const
+        {
+            scalar_type sum = 0;
+            if (quantized)
+            {
+                scalar_type qsum = 0;
+                for (const auto& p : x)
+                {
+                    if (p.first < qweights.size())
+                        qsum += qweights[p.first]*p.second;
+                }
+                sum = qsum*scale;
+            }
+            else
+            {
+                for (const auto& p : x)
+                {
+                    if (p.first < weights.size())
+                        sum += weights[p.first]*p.second;
+                }
+            }
+            return sum - bias;
+        }
+
+        unsigned long num_dimensions (
+        ) const
+        {
+            if (quantized)
+                return qweights.size();
+            else
+                return weights.size();
+        }
+
+        bool weights_are_quantized (
+        ) const { return quantized; }
+
+        friend void serialize (
+            const fast_sparse_linear_function& item,
+            std::ostream& out
+        )
+        {
+            int version = 1;
+            dlib::serialize(version, out);
+            dlib::serialize(item.bias, out);
+            dlib::serialize(item.scale, out);
+            dlib::serialize(item.quantized, out);
+            dlib::serialize(item.weights, out);
+            dlib::serialize(item.qweights, out);
+        }
+
+        friend void deserialize (
+            fast_sparse_linear_function& item,
+            std::istream& in
+        )
+        {
+            int version = 0;
+            dlib::deserialize(version, in);
+            if (version != 1)
+                throw serialization_error("Unexpected version found while deserializing dlib::fast_sparse_linear_function.");
+            dlib::deserialize(item.bias, in);
+            dlib::deserialize(item.scale, in);
+            dlib::deserialize(item.quantized, in);
+            dlib::deserialize(item.weights, in);
+            dlib::deserialize(item.qweights, in);
+        }
+
+    private:
+
+        std::vector<scalar_type> weights;
+        std::vector<int16> qweights;
+        scalar_type bias;
+        scalar_type scale;
+        bool quantized;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_FAST_SPARSE_LINEAR_FUNCTIOn_Hh_
@@ -0,0 +1,128 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_FAST_SPARSE_LINEAR_FUNCTIOn_ABSTRACT_Hh_
+#ifdef DLIB_FAST_SPARSE_LINEAR_FUNCTIOn_ABSTRACT_Hh_
+
+#include "function_abstract.h"
+#include "sparse_kernel_abstract.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename sample_type
+        >
+    class fast_sparse_linear_function
+    {
+        /*!
+            REQUIREMENTS ON sample_type
+                Must be a sparse vector as defined in dlib/svm/sparse_vector_abstract.h
+                (e.g. std::vector<std::pair<unsigned long,double> >).
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a fast evaluator for a
+                decision_function<sparse_linear_kernel<sample_type> >.  A decision
+                function stores its hyperplane as a set of alpha weighted sparse basis
+                vectors and evaluates a query by taking a sparse dot product against
+                each of them.  This object instead collapses the basis vectors, at
+                construction time, into a single dense weight array indexed directly
+                by dimension.  Evaluating a query then costs one multiply-add per
+                nonzero element of the query, independent of both the number of basis
+                vectors and the dimensionality of the weight vector.
+
+                Optionally the weights can be stored quantized to int16.  Each weight
+                becomes round(w/scale), where scale is chosen so the largest magnitude
+                weight maps to 32767.  This shrinks the model memory by 4x for double
+                precision weights, at the cost of a relative error in the output of at
+                most about 1/32767 of the largest weight magnitude per query nonzero.
+                For typical text classification weight distributions the induced label
+                flips are rare, but you should validate the quantized function on held
+                out data before deploying it.
+
+                Note that this object represents a frozen model: it evaluates the
+                decision function it was built from but cannot be trained further.
+        !*/
+
+    public:
+        typedef typename sample_type::value_type pair_type;
+        typedef typename pair_type::first_type key_type;
+        typedef typename pair_type::second_type scalar_type;
+
+        fast_sparse_linear_function (
+        );
+        /*!
+            ensures
+                - #num_dimensions() == 0
+                - #weights_are_quantized() == false
+                - for all samples x: #(*this)(x) == 0
+        !*/
+
+        explicit fast_sparse_linear_function (
+            const decision_function<sparse_linear_kernel<sample_type> >& df,
+            bool quantize = false
+        );
+        /*!
+            ensures
+                - #*this evaluates the same function as df.  That is, for any sample
+                  x, (*this)(x) == df(x), up to rounding error (and up to the
+                  quantization error described above if quantize is true).
+                - #weights_are_quantized() == quantize
+                - #num_dimensions() == one past the largest dimension index present in
+                  df.basis_vectors.  Query elements with indices beyond this are
+                  treated as having weight 0, just like df treats them.
+        !*/
+
+        scalar_type operator() (
+            const sample_type& x
+        ) const;
+        /*!
+            requires
+                - x is a sorted sparse vector
+            ensures
+                - returns the value of this decision function at x.  Runs in
+                  O(number of nonzero elements in x) time.
+        !*/
+
+        unsigned long num_dimensions (
+        ) const;
+        /*!
+            ensures
+                - returns the length of the dense weight array held by this object.
+        !*/
+
+        bool weights_are_quantized (
+        ) const;
+        /*!
+            ensures
+                - returns true if the weights are stored as int16 values rather than
+                  scalar_type.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename sample_type>
+    void serialize (
+        const fast_sparse_linear_function<sample_type>& item,
+        std::ostream& out
+    );
+    /*!
+        provides serialization support
+    !*/
+
+    template <typename sample_type>
+    void deserialize (
+        fast_sparse_linear_function<sample_type>& item,
+        std::istream& in
+    );
+    /*!
+        provides deserialization support
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_FAST_SPARSE_LINEAR_FUNCTIOn_ABSTRACT_Hh_
@@ -10,6 +10,7 @@
 #include "kcentroid.h"
 #include "../optimization.h"
 #include "../statistics.h"
+#include "../threads.h"
 #include <iostream>
 
 namespace dlib
@@ -73,52 +74,57 @@ namespace dlib
 
         for (long i = results.nr()-1; i >= 0; --i)
         {
-            long worst_feature_idx = 0;
-            scalar_type worst_feature_score = -std::numeric_limits<scalar_type>::infinity();
-
-            // figure out which feature to remove next
-            for (long j = 0; j < mask.size(); ++j)
+            // Score each feature-removal candidate.  The candidates are completely
+            // independent of each other, each training its own private pair of
+            // kcentroids, so evaluate them in parallel.
+            std::vector<scalar_type> scores(mask.size(), -std::numeric_limits<scalar_type>::infinity());
+            parallel_for(0, mask.size(), [&](long j)
             {
                 // skip features we have already removed
                 if (mask(j) == 0)
-                    continue;
+                    return;
 
                 kcentroid<kernel_type> c1(kc);
                 kcentroid<kernel_type> c2(kc);
 
-                // temporarily remove this feature from the working set of features
-                mask(j) = 0;
+                // use a working set of features with this feature removed
+                matrix<scalar_type,sample_matrix_type::type::NR,1,mm> cand_mask(mask);
+                cand_mask(j) = 0;
 
                 // find the centers of each class
                 for (long s = 0; s < samples.size(); ++s)
                 {
                     if (labels(s) < 0)
                     {
-                        c1.train(pointwise_multiply(samples(s),mask));
+                        c1.train(pointwise_multiply(samples(s),cand_mask));
                     }
                     else
                     {
-                        c2.train(pointwise_multiply(samples(s),mask));
+                        c2.train(pointwise_multiply(samples(s),cand_mask));
                     }
 
                 }
 
                 // find the distance between the two centroids and use that
                 // as the score
-                const double score = c1(c2);
+                scores[j] = c1(c2);
+            });
 
-                if (score > worst_feature_score)
+            // figure out which feature to remove next.  This reduction is done serially
+            // so the result is identical to what the old one-candidate-at-a-time loop
+            // produced, ties and all.
+            long worst_feature_idx = 0;
+            scalar_type worst_feature_score = -std::numeric_limits<scalar_type>::infinity();
+            for (long j = 0; j < mask.size(); ++j)
+            {
+                if (mask(j) != 0 && scores[j] > worst_feature_score)
                 {
-                    worst_feature_score = score;
+                    worst_feature_score = scores[j];
                     worst_feature_idx = j;
                 }
-
-                // add this feature back to the working set of features
-                mask(j) = 1;
-
             }
 
-            // now that we know what the next worst feature is record it 
+            // now that we know what the next worst feature is record it
             mask(worst_feature_idx) = 0;
             results(i,0) = worst_feature_idx;
             results(i,1) = worst_feature_score; 
@@ -193,52 +199,55 @@ namespace dlib
 
         for (long i = 0; i < results.nr(); ++i)
         {
-            long best_feature_idx = 0;
-            scalar_type best_feature_score = -std::numeric_limits<scalar_type>::infinity();
-
-            // figure out which feature to add next
-            for (long j = 0; j < mask.size(); ++j)
+            // Score each feature-addition candidate in parallel, just like the
+            // recursive elimination version above.
+            std::vector<scalar_type> scores(mask.size(), -std::numeric_limits<scalar_type>::infinity());
+            parallel_for(0, mask.size(), [&](long j)
             {
-                // skip features we have already added 
+                // skip features we have already added
                 if (mask(j) == 1)
-                    continue;
+                    return;
 
                 kcentroid<kernel_type> c1(kc);
                 kcentroid<kernel_type> c2(kc);
 
-                // temporarily add this feature to the working set of features
-                mask(j) = 1;
+                // use a working set of features with this feature added
+                matrix<scalar_type,sample_matrix_type::type::NR,1,mm> cand_mask(mask);
+                cand_mask(j) = 1;
 
                 // find the centers of each class
                 for (long s = 0; s < samples.size(); ++s)
                 {
                     if (labels(s) < 0)
                     {
-                        c1.train(pointwise_multiply(samples(s),mask));
+                        c1.train(pointwise_multiply(samples(s),cand_mask));
                     }
                     else
                     {
-                        c2.train(pointwise_multiply(samples(s),mask));
+                        c2.train(pointwise_multiply(samples(s),cand_mask));
                     }
 
                 }
 
                 // find the distance between the two centroids and use that
                 // as the score
-                const double score = c1(c2);
+                scores[j] = c1(c2);
+            });
 
-                if (score > best_feature_score)
+            // figure out which feature to add next, serially so ties break the same
+            // way they always have.
+            long best_feature_idx = 0;
+            scalar_type best_feature_score = -std::numeric_limits<scalar_type>::infinity();
+            for (long j = 0; j < mask.size(); ++j)
+            {
+                if (mask(j) != 1 && scores[j] > best_feature_score)
                 {
-                    best_feature_score = score;
+                    best_feature_score = scores[j];
                     best_feature_idx = j;
                 }
-
-                // take this feature back out of the working set of features
-                mask(j) = 0;
-
             }
 
-            // now that we know what the next best feature is record it 
+            // now that we know what the next best feature is record it
             mask(best_feature_idx) = 1;
             results(i,0) = best_feature_idx;
             results(i,1) = best_feature_score; 
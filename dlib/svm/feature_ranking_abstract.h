@@ -44,6 +44,9 @@ namespace dlib
               Good features are then ones that result in the biggest separation between
               the two centroids of Class1 and Class2.
             - Uses the kc object to compute the centroids of the two classes
+            - The candidate features considered at each step of the ranking are scored
+              in parallel using the default thread pool.  The returned ranking is
+              deterministic and identical to what a serial evaluation would produce.
             - returns a ranking matrix R where:
                 - R.nr() == num_features
                 - r.nc() == 2
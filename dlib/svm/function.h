@@ -7,6 +7,7 @@
 #include <cmath>
 #include <limits>
 #include <sstream>
+#include <vector>
 #include "../matrix.h"
 #include "../algs.h"
 #include "../serialize.h"
@@ -113,8 +114,269 @@ namespace dlib
             deserialize(item.basis_vectors, in);
         }
         catch (serialization_error& e)
-        { 
-            throw serialization_error(e.info + "\n   while deserializing object of type decision_function"); 
+        {
+            throw serialization_error(e.info + "\n   while deserializing object of type decision_function");
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename K
+        >
+    std::vector<typename K::scalar_type> batch_evaluate (
+        const decision_function<K>& df,
+        const std::vector<typename K::sample_type>& samples
+    )
+    {
+        std::vector<typename K::scalar_type> results;
+        results.reserve(samples.size());
+        for (unsigned long i = 0; i < samples.size(); ++i)
+            results.push_back(df(samples[i]));
+        return results;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    std::vector<typename T::type> batch_evaluate (
+        const decision_function<radial_basis_kernel<T> >& df,
+        const std::vector<T>& samples
+    )
+    /*!
+        This overload exploits the fact that the radial basis kernel is a simple
+        function of the query-to-basis-vector distances.  Rather than evaluating one
+        kernel at a time it packs the samples and basis vectors into matrices and
+        computes all the squared distances with a single matrix multiply (which goes
+        through the BLAS bindings when they are enabled), then applies exp() and the
+        alpha weighted reduction to whole rows at a time.
+    !*/
+    {
+        typedef typename T::type scalar_type;
+
+        const long num_bv = df.basis_vectors.size();
+        if (samples.size() == 0 || num_bv == 0)
+        {
+            // fall back to the one at a time code since there is nothing to batch up.
+            std::vector<scalar_type> results;
+            results.reserve(samples.size());
+            for (unsigned long i = 0; i < samples.size(); ++i)
+                results.push_back(df(samples[i]));
+            return results;
+        }
+
+        const long dims = df.basis_vectors(0).size();
+        const long num_samples = static_cast<long>(samples.size());
+
+        matrix<scalar_type> B(num_bv, dims);
+        for (long i = 0; i < num_bv; ++i)
+        {
+            set_rowm(B,i) = trans(df.basis_vectors(i));
+        }
+
+        matrix<scalar_type> X(num_samples, dims);
+        for (long i = 0; i < num_samples; ++i)
+        {
+            DLIB_ASSERT(samples[i].size() == dims,
+                "\tstd::vector batch_evaluate()"
+                << "\n\t All the samples must have the same dimensionality as the basis vectors."
+                << "\n\t samples[i].size(): " << samples[i].size()
+                << "\n\t dims:              " << dims
+                << "\n\t i:                 " << i
+                );
+            set_rowm(X,i) = trans(samples[i]);
+        }
+
+        const matrix<scalar_type,0,1> b_norms = sum_cols(pointwise_multiply(B,B));
+        const matrix<scalar_type,0,1> x_norms = sum_cols(pointwise_multiply(X,X));
+
+        // D(r,c) == the squared distance between samples[r] and df.basis_vectors(c),
+        // expanded as |x|^2 + |b|^2 - 2*dot(x,b) so the cross terms come from one GEMM.
+        matrix<scalar_type> D = -2*X*trans(B);
+        for (long r = 0; r < D.nr(); ++r)
+        {
+            for (long c = 0; c < D.nc(); ++c)
+                D(r,c) += x_norms(r) + b_norms(c);
+        }
+
+        const matrix<scalar_type,0,1> temp = exp(-df.kernel_function.gamma*D)*df.alpha;
+
+        std::vector<scalar_type> results;
+        results.reserve(samples.size());
+        for (long i = 0; i < num_samples; ++i)
+            results.push_back(temp(i) - df.b);
+        return results;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename K
+        >
+    class fast_decision_function
+    {
+        /*!
+            This is the generic version.  It has no faster evaluation strategy than
+            the decision_function it wraps, so it just forwards to it.  The
+            interesting version is the radial_basis_kernel specialization below.
+        !*/
+    public:
+        typedef K kernel_type;
+        typedef typename K::scalar_type scalar_type;
+        typedef typename K::scalar_type result_type;
+        typedef typename K::sample_type sample_type;
+        typedef typename K::mem_manager_type mem_manager_type;
+
+        fast_decision_function (
+        ) {}
+
+        fast_decision_function (
+            const decision_function<K>& df_
+        ) : df(df_) {}
+
+        const decision_function<K>& get_decision_function (
+        ) const { return df; }
+
+        result_type operator() (
+            const sample_type& x
+        ) const
+        {
+            return df(x);
+        }
+
+    private:
+        decision_function<K> df;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    class fast_decision_function<radial_basis_kernel<T> >
+    {
+        /*!
+            CONVENTION
+                - if (df.basis_vectors.size() != 0) then
+                    - B.nr() == df.basis_vectors.size()
+                    - rowm(B,i) == trans(df.basis_vectors(i)).  I.e. B contains the
+                      basis vectors packed into one dense row major matrix, so a
+                      query's dot products against every basis vector come from a
+                      single matrix-vector multiply over contiguous memory.
+                    - b_norms(i) == dot(df.basis_vectors(i), df.basis_vectors(i))
+        !*/
+    public:
+        typedef radial_basis_kernel<T> kernel_type;
+        typedef typename kernel_type::scalar_type scalar_type;
+        typedef typename kernel_type::scalar_type result_type;
+        typedef typename kernel_type::sample_type sample_type;
+        typedef typename kernel_type::mem_manager_type mem_manager_type;
+
+        fast_decision_function (
+        ) {}
+
+        fast_decision_function (
+            const decision_function<kernel_type>& df_
+        ) : df(df_)
+        {
+            pack();
+        }
+
+        const decision_function<kernel_type>& get_decision_function (
+        ) const { return df; }
+
+        result_type operator() (
+            const sample_type& x
+        ) const
+        {
+            if (B.size() == 0)
+                return df(x);
+
+            DLIB_ASSERT(x.size() == B.nc(),
+                "\tresult_type fast_decision_function::operator()"
+                << "\n\t The query must have the same dimensionality as the basis vectors."
+                << "\n\t x.size(): " << x.size()
+                << "\n\t B.nc():   " << B.nc()
+                << "\n\t this:     " << this
+                );
+
+            // |x-b_i|^2 == |x|^2 + |b_i|^2 - 2*dot(x,b_i), where all the dot
+            // products come from one matrix-vector multiply against the packed
+            // basis vectors.
+            const scalar_type x_norm = dot(x,x);
+            const matrix<scalar_type,0,1,mem_manager_type> d = b_norms - 2*(B*x);
+
+            const scalar_type g = df.kernel_function.gamma;
+            result_type temp = 0;
+            for (long i = 0; i < d.size(); ++i)
+                temp += df.alpha(i)*std::exp(-g*(d(i)+x_norm));
+            return temp - df.b;
+        }
+
+    private:
+
+        void pack (
+        )
+        {
+            const long num_bv = df.basis_vectors.size();
+            if (num_bv == 0)
+            {
+                B.set_size(0,0);
+                b_norms.set_size(0);
+                return;
+            }
+
+            const long dims = df.basis_vectors(0).size();
+            B.set_size(num_bv, dims);
+            for (long i = 0; i < num_bv; ++i)
+                set_rowm(B,i) = trans(df.basis_vectors(i));
+            b_norms = sum_cols(pointwise_multiply(B,B));
+        }
+
+        decision_function<kernel_type> df;
+        matrix<scalar_type,0,0,mem_manager_type> B;
+        matrix<scalar_type,0,1,mem_manager_type> b_norms;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename K
+        >
+    void serialize (
+        const fast_decision_function<K>& item,
+        std::ostream& out
+    )
+    {
+        try
+        {
+            serialize(item.get_decision_function(), out);
+        }
+        catch (serialization_error& e)
+        {
+            throw serialization_error(e.info + "\n   while serializing object of type fast_decision_function");
+        }
+    }
+
+    template <
+        typename K
+        >
+    void deserialize (
+        fast_decision_function<K>& item,
+        std::istream& in
+    )
+    {
+        try
+        {
+            decision_function<K> df;
+            deserialize(df, in);
+            item = fast_decision_function<K>(df);
+        }
+        catch (serialization_error& e)
+        {
+            throw serialization_error(e.info + "\n   while deserializing object of type fast_decision_function");
         }
     }
 
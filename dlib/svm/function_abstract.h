@@ -117,7 +117,7 @@ namespace dlib
         >
     void deserialize (
         decision_function<K>& item,
-        std::istream& in 
+        std::istream& in
     );
     /*!
         provides serialization support for decision_function
@@ -126,9 +126,131 @@ namespace dlib
 // ----------------------------------------------------------------------------------------
 
     template <
-        typename function_type 
+        typename K
+        >
+    std::vector<typename K::scalar_type> batch_evaluate (
+        const decision_function<K>& df,
+        const std::vector<typename K::sample_type>& samples
+    );
+    /*!
+        requires
+            - all the elements of samples must be valid inputs to df, i.e. they must
+              have the same dimensionality as df.basis_vectors.
+        ensures
+            - returns a std::vector R such that:
+                - R.size() == samples.size()
+                - for all valid i: R[i] == df(samples[i])
+            - This function exists because evaluating a batch of queries at once can be
+              done much faster than calling df() in a loop.  In particular, when K is a
+              radial_basis_kernel all the query-to-basis-vector distances are computed
+              with a single matrix multiply, which uses the BLAS bindings when they are
+              enabled.  For other kernels this function is equivalent to, and no faster
+              than, the obvious loop over samples.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename K
+        >
+    class fast_decision_function
+    {
+        /*!
+            REQUIREMENTS ON K
+                K must be a kernel function object type as defined at the top of
+                dlib/svm/kernel_abstract.h
+
+            WHAT THIS OBJECT REPRESENTS
+                This object wraps a decision_function and evaluates it using a
+                storage layout better suited to answering one query at a time.  It
+                computes exactly the same function as the decision_function given to
+                its constructor (up to floating point rounding), it just computes it
+                faster when the kernel permits.
+
+                In particular, when K is a radial_basis_kernel the basis vectors are
+                packed, at construction time, into one dense row major matrix so
+                each query's distances to every basis vector come from a single
+                matrix-vector multiply over contiguous memory, followed by one exp()
+                and accumulate pass.  This is much faster than the generic
+                decision_function evaluation, which walks the basis vectors one at a
+                time, and is useful when scoring high rate streams against a fixed
+                model such as one from svm_one_class_trainer.  For other kernels
+                this object is equivalent to, and no faster than, calling the
+                wrapped decision_function directly.
+        !*/
+
+    public:
+        typedef K kernel_type;
+        typedef typename K::scalar_type scalar_type;
+        typedef typename K::scalar_type result_type;
+        typedef typename K::sample_type sample_type;
+        typedef typename K::mem_manager_type mem_manager_type;
+
+        fast_decision_function (
+        );
+        /*!
+            ensures
+                - #get_decision_function() == decision_function<K>()
+        !*/
+
+        fast_decision_function (
+            const decision_function<K>& df
+        );
+        /*!
+            ensures
+                - #get_decision_function() == df
+        !*/
+
+        const decision_function<K>& get_decision_function (
+        ) const;
+        /*!
+            ensures
+                - returns the decision_function this object evaluates
+        !*/
+
+        result_type operator() (
+            const sample_type& x
+        ) const;
+        /*!
+            requires
+                - x has the same dimensionality as the basis vectors of
+                  get_decision_function()
+            ensures
+                - returns get_decision_function()(x)
+        !*/
+    };
+
+    template <
+        typename K
+        >
+    void serialize (
+        const fast_decision_function<K>& item,
+        std::ostream& out
+    );
+    /*!
+        provides serialization support for fast_decision_function.  The saved format
+        is identical to that of the wrapped decision_function.
+    !*/
+
+    template <
+        typename K
+        >
+    void deserialize (
+        fast_decision_function<K>& item,
+        std::istream& in
+    );
+    /*!
+        provides serialization support for fast_decision_function.  Note that this
+        means you can deserialize a saved decision_function directly into a
+        fast_decision_function.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename function_type
         >
-    struct probabilistic_function 
+    struct probabilistic_function
     {
         /*!
             REQUIREMENTS ON function_type 
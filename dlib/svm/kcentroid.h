@@ -3,6 +3,7 @@
 #ifndef DLIB_KCENTROId_
 #define DLIB_KCENTROId_
 
+#include <algorithm>
 #include <vector>
 
 #include "kcentroid_abstract.h"
@@ -297,6 +298,82 @@ namespace dlib
         unsigned long dictionary_size (
         ) const { return dictionary.size(); }
 
+        matrix<scalar_type,0,1,mem_manager_type> get_dictionary_strengths (
+        ) const
+        {
+            // The projection error you would get for dictionary vector i if you removed
+            // it and then tried to add it back in is just 1/K_inv(i,i).  This follows
+            // from the block matrix inversion identity, so we can report every vector's
+            // contribution without doing any of the O(N^2) downdates that
+            // recompute_min_strength() effectively performs.
+            matrix<scalar_type,0,1,mem_manager_type> strengths(dictionary.size());
+            for (long i = 0; i < strengths.nr(); ++i)
+                strengths(i) = 1/K_inv(i,i);
+            return strengths;
+        }
+
+        void remove_dictionary_vectors (
+            std::vector<unsigned long> indices
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(indices.size() < dictionary_size(),
+                "\tvoid kcentroid::remove_dictionary_vectors()"
+                << "\n\t You can't remove every dictionary vector with this function"
+                << "\n\t this:              " << this
+                << "\n\t indices.size():    " << indices.size()
+                << "\n\t dictionary_size(): " << dictionary_size()
+                );
+
+            std::sort(indices.begin(), indices.end());
+#ifdef ENABLE_ASSERTS
+            for (unsigned long i = 0; i < indices.size(); ++i)
+            {
+                DLIB_ASSERT(indices[i] < dictionary_size() && (i == 0 || indices[i] != indices[i-1]),
+                    "\tvoid kcentroid::remove_dictionary_vectors()"
+                    << "\n\t Invalid or duplicate dictionary vector index given"
+                    << "\n\t this:              " << this
+                    << "\n\t indices[i]:        " << indices[i]
+                    << "\n\t dictionary_size(): " << dictionary_size()
+                    );
+            }
+#endif
+
+            // Remove from the back so earlier indices stay valid.  Each removal is a
+            // rank-1 downdate of K_inv rather than a from-scratch inversion.
+            for (unsigned long i = indices.size(); i > 0; --i)
+                remove_dictionary_vector(indices[i-1]);
+
+            // The cached strength info refers to the old dictionary.  Setting
+            // min_strength to 0 makes the next train() call recompute it if needed.
+            min_strength = 0;
+            min_vect_idx = 0;
+            bias_is_stale = true;
+        }
+
+        void prune_dictionary (
+            unsigned long target_size
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(target_size > 0,
+                "\tvoid kcentroid::prune_dictionary()"
+                << "\n\t You can't prune the dictionary down to nothing"
+                << "\n\t this:        " << this
+                << "\n\t target_size: " << target_size
+                );
+
+            // Repeatedly discard the most linearly dependent dictionary vector, i.e.
+            // the one with the smallest strength 1/K_inv(i,i).  Since K_inv is
+            // downdated after each removal the strengths used are always current.
+            while (dictionary.size() > target_size)
+                remove_dictionary_vector(index_of_max(diag(K_inv)));
+
+            min_strength = 0;
+            min_vect_idx = 0;
+            bias_is_stale = true;
+        }
+
         friend void serialize(const kcentroid& item, std::ostream& out)
         {
             serialize(item.min_strength, out);
@@ -127,6 +127,59 @@ namespace dlib
                   feature space.
         !*/
 
+        matrix<scalar_type,0,1,mem_manager_type> get_dictionary_strengths (
+        ) const;
+        /*!
+            ensures
+                - returns a vector S of length dictionary_size() where S(i) is the
+                  projection error (i.e. the Approximately Linearly Dependent value
+                  from the KRLS paper) you would observe for the ith dictionary vector
+                  if you removed it from the dictionary and then tried to add it back
+                  in.  So small values of S(i) mean the ith dictionary vector is
+                  nearly redundant while large values mean it contributes a lot to the
+                  dictionary's ability to represent points.
+                - This function runs in O(dictionary_size()) time since the strengths
+                  are read off the diagonal of the inverse kernel matrix this object
+                  already maintains.
+        !*/
+
+        void remove_dictionary_vectors (
+            std::vector<unsigned long> indices
+        );
+        /*!
+            requires
+                - indices.size() < dictionary_size()
+                - for all valid i: indices[i] < dictionary_size()
+                - the elements of indices are unique
+            ensures
+                - #dictionary_size() == dictionary_size() - indices.size()
+                - removes the indicated dictionary vectors and updates this object so
+                  that it still represents the best approximation of the current
+                  centroid expressible with the remaining dictionary vectors.  Each
+                  removal is performed as a rank-1 downdate of the cached inverse
+                  kernel matrix, so this is much faster than rebuilding the
+                  dictionary from scratch.
+                - #samples_trained() == samples_trained()
+                  (i.e. this function doesn't change the number of samples seen, it
+                  only shrinks the basis set used to represent the centroid)
+        !*/
+
+        void prune_dictionary (
+            unsigned long target_size
+        );
+        /*!
+            requires
+                - target_size > 0
+            ensures
+                - #dictionary_size() == min(dictionary_size(), target_size)
+                - if the dictionary contains more than target_size vectors then this
+                  function repeatedly removes the vector with the smallest strength
+                  (see get_dictionary_strengths()) until only target_size vectors
+                  remain.  The strengths are reevaluated after each removal so the
+                  vector removed is always the most redundant one at that moment.
+                - #samples_trained() == samples_trained()
+        !*/
+
         scalar_type samples_trained (
         ) const;
         /*!
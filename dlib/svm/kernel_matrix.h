@@ -4,9 +4,12 @@
 #define DLIB_SVm_KERNEL_MATRIX_
 
 #include <vector>
+#include <algorithm>
+#include <utility>
 #include "kernel_matrix_abstract.h"
 #include "../matrix.h"
 #include "../algs.h"
+#include "../threads.h"
 
 namespace dlib
 {
@@ -260,6 +263,86 @@ namespace dlib
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename K,
+        typename V
+        >
+    matrix<typename K::scalar_type,0,0,typename K::mem_manager_type> kernel_matrix_threaded (
+        const K& kern,
+        const V& v
+    )
+    {
+        impl::assert_is_vector(v);
+
+        const long n = static_cast<long>(impl::size<K>(v));
+        matrix<typename K::scalar_type,0,0,typename K::mem_manager_type> dest(n,n);
+
+        // Chop the upper triangle of the kernel matrix into square tiles and hand the
+        // tiles out to the default thread pool, mirroring each result into the lower
+        // triangle as it is computed.  Tiles touching the diagonal contain about half
+        // as much work as the others, so we keep the tiles reasonably small to get a
+        // good load balance while still amortizing the threading overhead.
+        const long block_size = 64;
+        const long num_blocks = (n+block_size-1)/block_size;
+
+        std::vector<std::pair<long,long> > tiles;
+        for (long br = 0; br < num_blocks; ++br)
+        {
+            for (long bc = br; bc < num_blocks; ++bc)
+                tiles.push_back(std::make_pair(br*block_size, bc*block_size));
+        }
+
+        parallel_for(0, tiles.size(), [&](long t)
+        {
+            const long r_begin = tiles[t].first;
+            const long c_begin = tiles[t].second;
+            const long r_end = std::min(r_begin+block_size, n);
+            const long c_end = std::min(c_begin+block_size, n);
+            for (long r = r_begin; r < r_end; ++r)
+            {
+                // stay in the upper triangle, the mirror write fills in the rest
+                for (long c = std::max(r,c_begin); c < c_end; ++c)
+                {
+                    dest(r,c) = dest(c,r) = kern(impl::access<K>(v,r), impl::access<K>(v,c));
+                }
+            }
+        });
+
+        return dest;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename K,
+        typename V1,
+        typename V2
+        >
+    matrix<typename K::scalar_type,0,0,typename K::mem_manager_type> kernel_matrix_threaded (
+        const K& kern,
+        const V1& v1,
+        const V2& v2
+    )
+    {
+        impl::assert_is_vector(v1);
+        impl::assert_is_vector(v2);
+
+        const long nr = static_cast<long>(impl::size<K>(v1));
+        const long nc = static_cast<long>(impl::size<K>(v2));
+        matrix<typename K::scalar_type,0,0,typename K::mem_manager_type> dest(nr,nc);
+
+        // No symmetry to exploit here, so just split the rows across the thread pool.
+        parallel_for(0, nr, [&](long r)
+        {
+            for (long c = 0; c < nc; ++c)
+                dest(r,c) = kern(impl::access<K>(v1,r), impl::access<K>(v2,c));
+        });
+
+        return dest;
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -107,6 +107,67 @@ namespace dlib
                 or row vector you shouldn't ever be doing it anyway.
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename kernel_type,
+        typename V
+        >
+    matrix<typename kernel_type::scalar_type> kernel_matrix_threaded (
+        const kernel_type& kernel,
+        const V& v
+    );
+    /*!
+        requires
+            - kernel == a kernel function object as defined by the file dlib/svm/kernel_abstract.h.
+              This kernel must also be capable of operating on the contents of v.
+            - kernel must be safe to call concurrently from multiple threads.
+            - V == dlib::matrix, std::vector, dlib::std_vector_c, dlib::random_subset_selector,
+              or dlib::linearly_independent_subset_finder.
+            - if (V is a dlib::matrix) then
+                - is_vector(v) == true
+        ensures
+            - returns a matrix identical to kernel_matrix(kernel, v) except that it is
+              fully evaluated into a dlib::matrix before being returned, rather than
+              being a lazy matrix expression.  The evaluation exploits the symmetry of
+              the kernel matrix, computing only the upper triangle and mirroring it,
+              and spreads the work over the default thread pool (i.e. the one returned
+              by default_thread_pool()).  So this function is useful when you need to
+              materialize a large kernel matrix and want it built as fast as possible.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename kernel_type,
+        typename V1,
+        typename V2
+        >
+    matrix<typename kernel_type::scalar_type> kernel_matrix_threaded (
+        const kernel_type& kernel,
+        const V1& v1,
+        const V2& v2
+    );
+    /*!
+        requires
+            - kernel == a kernel function object as defined by the file dlib/svm/kernel_abstract.h
+              This kernel must also be capable of operating on the contents of v1 and v2.
+            - kernel must be safe to call concurrently from multiple threads.
+            - V1 == dlib::matrix, std::vector, dlib::std_vector_c, dlib::random_subset_selector,
+              or dlib::linearly_independent_subset_finder.
+            - V2 == dlib::matrix, std::vector, dlib::std_vector_c, dlib::random_subset_selector,
+              or dlib::linearly_independent_subset_finder.
+            - if (V1 is a dlib::matrix) then
+                - is_vector(v1) == true
+            - if (V2 is a dlib::matrix) then
+                - is_vector(v2) == true
+        ensures
+            - returns a matrix identical to kernel_matrix(kernel, v1, v2) except that it
+              is fully evaluated into a dlib::matrix before being returned.  Since there
+              is no symmetry to exploit in this case the rows are simply computed in
+              parallel over the default thread pool.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
 }
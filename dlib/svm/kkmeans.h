@@ -14,6 +14,7 @@
 #include "kcentroid.h"
 #include "kkmeans_abstract.h"
 #include "../noncopyable.h"
+#include "../threads.h"
 
 namespace dlib
 {
@@ -217,9 +218,20 @@ namespace dlib
 
             assignments.resize(samples.size());
 
+            // Distances returned by kcentroid::operator() are metric distances in the
+            // kernel feature space, so we can use Hamerly style triangle inequality
+            // bounds to skip samples whose assignments provably can't change.  upper
+            // holds an upper bound on each sample's distance to its assigned center
+            // and lower holds a lower bound on its distance to every other center.
+            std::vector<scalar_type> upper(samples.size());
+            std::vector<scalar_type> lower(samples.size());
+            std::vector<scalar_type> moved(centers.size());
+            std::vector<unsigned char> sample_changed(samples.size());
+            bool bounds_are_valid = false;
+
             bool assignment_changed = true;
 
-            // loop until the centers stabilize 
+            // loop until the centers stabilize
             long count = 0;
             const unsigned long min_num_change = static_cast<unsigned long>(min_change*samples.size());
             unsigned long num_changed = min_num_change;
@@ -229,26 +241,72 @@ namespace dlib
                 assignment_changed = false;
                 num_changed = 0;
 
+                // Warm up each center's cached bias term so that the distance
+                // computations below are read-only operations and therefore safe to
+                // run from many threads at once.
+                scalar_type max_moved = 0;
+                for (unsigned long c = 0; c < centers.size(); ++c)
+                {
+                    centers[c]->squared_norm();
+                    if (bounds_are_valid)
+                        max_moved = std::max(max_moved, moved[c]);
+                }
+
                 // loop over all the samples and assign them to their closest centers
-                for (long i = 0; i < samples.size(); ++i)
+                parallel_for(0, samples.size(), [&](long i)
                 {
-                    // find the best center
+                    sample_changed[i] = 0;
+
+                    if (bounds_are_valid)
+                    {
+                        // account for how far the centers moved since the bounds were set
+                        upper[i] += moved[assignments[i]];
+                        lower[i] -= max_moved;
+                        // If the assigned center is still provably closer than any other
+                        // center then this sample can't change assignments.
+                        if (upper[i] < lower[i])
+                            return;
+                        // tighten the upper bound to the exact distance and retest
+                        upper[i] = (*centers[assignments[i]])(samples(i));
+                        if (upper[i] < lower[i])
+                            return;
+                    }
+
+                    // find the best and second best centers
                     unsigned long best_center = 0;
                     scalar_type best_score = (*centers[0])(samples(i));
+                    scalar_type second_score = std::numeric_limits<scalar_type>::max();
                     for (unsigned long c = 1; c < centers.size(); ++c)
                     {
                         scalar_type temp = (*centers[c])(samples(i));
                         if (temp < best_score)
                         {
+                            second_score = best_score;
                             best_score = temp;
                             best_center = c;
                         }
+                        else if (temp < second_score)
+                        {
+                            second_score = temp;
+                        }
                     }
+                    upper[i] = best_score;
+                    lower[i] = second_score;
 
                     // if the current sample changed centers then make note of that
                     if (assignments[i] != best_center)
                     {
                         assignments[i] = best_center;
+                        sample_changed[i] = 1;
+                    }
+                });
+
+                // Tally the changes serially so the loop termination logic behaves
+                // exactly like it did when the assignment loop above was serial.
+                for (long i = 0; i < samples.size(); ++i)
+                {
+                    if (sample_changed[i])
+                    {
                         assignment_changed = true;
                         ++num_changed;
                     }
@@ -256,13 +314,24 @@ namespace dlib
 
                 if (assignment_changed)
                 {
-                    // now clear out the old data 
+                    // Save copies of the old centers so we can measure how far each
+                    // one moves.  That movement is what loosens the bounds above.
+                    std::vector<kcentroid<kernel_type> > old_centers;
+                    old_centers.reserve(centers.size());
+                    for (unsigned long i = 0; i < centers.size(); ++i)
+                        old_centers.push_back(*centers[i]);
+
+                    // now clear out the old data
                     for (unsigned long i = 0; i < centers.size(); ++i)
                         centers[i]->clear_dictionary();
 
-                    // recalculate the cluster centers 
+                    // recalculate the cluster centers
                     for (unsigned long i = 0; i < assignments.size(); ++i)
                         centers[assignments[i]]->train(samples(i));
+
+                    for (unsigned long i = 0; i < centers.size(); ++i)
+                        moved[i] = old_centers[i](*centers[i]);
+                    bounds_are_valid = true;
                 }
 
             }
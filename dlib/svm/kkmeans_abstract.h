@@ -121,9 +121,14 @@ namespace dlib
             ensures
                 - performs k-means clustering of the given set of samples.  The initial center points
                   are taken from the initial_centers argument.
-                - loops over the data and continues to refine the clustering until either less than 
-                  get_min_change() fraction of the data points change clusters or we have done max_iter 
+                - loops over the data and continues to refine the clustering until either less than
+                  get_min_change() fraction of the data points change clusters or we have done max_iter
                   iterations over the data.
+                - The assignment step is parallelized using the default dlib thread pool
+                  and uses triangle inequality bounds (valid since kernel induced
+                  distances form a metric) to skip samples whose cluster assignments
+                  provably can't change, so most iterations touch only a small
+                  fraction of the sample/center distance pairs.
                 - After this function finishes you can call the operator() function below
                   to determine which centroid a given sample is closest to.
         !*/
@@ -8,6 +8,7 @@
 #include "linearly_independent_subset_finder_abstract.h"
 #include "../matrix.h"
 #include "function.h"
+#include "kernel_matrix.h"
 #include "../std_allocator.h"
 #include "../algs.h"
 #include "../serialize.h"
@@ -526,12 +527,129 @@ namespace dlib
         rand_type random_seed,
         const int sampling_size = 2000
     )
-    {   
+    {
         dlib::rand rnd;
         rnd.set_seed(cast_to_string(random_seed));
         impl::fill_lisf(lisf, mat(samples), rnd, sampling_size);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        template <
+            typename kernel_type,
+            typename vector_type
+            >
+        unsigned long fill_lisf_blocked (
+            linearly_independent_subset_finder<kernel_type>& lisf,
+            const vector_type& samples,
+            const unsigned long block_size
+        )
+        {
+            typedef typename kernel_type::scalar_type scalar_type;
+            typedef typename kernel_type::mem_manager_type mem_manager_type;
+
+            const kernel_type kern = lisf.get_kernel();
+            unsigned long num_added = 0;
+
+            for (long base = 0; base < samples.size(); base += block_size)
+            {
+                const long bs = std::min<long>(block_size, samples.size()-base);
+                // Note that the index vector must be a named object since block
+                // references it for the rest of this loop iteration.
+                const matrix<long,1,0> idx = range(base, base+bs-1);
+                const auto block = rowm(samples, idx);
+
+                // Compute S, the Schur complement of the current dictionary in the
+                // block's kernel matrix, with two matrix multiplies instead of
+                // evaluating candidates one at a time.  This is where the bulk of
+                // the work in basis selection goes when the sample set is large.
+                // S(j,j) is candidate j's projection error onto the dictionary.
+                matrix<scalar_type,0,0,mem_manager_type> S = kernel_matrix(kern, block);
+                if (lisf.size() != 0)
+                {
+                    const matrix<scalar_type,0,0,mem_manager_type> C = kernel_matrix(kern, mat(lisf), block);
+                    S -= trans(C)*(lisf.get_inv_kernel_marix()*C);
+                }
+                matrix<scalar_type,0,1,mem_manager_type> deltas = diag(S);
+
+                // Now greedily pull vectors out of the block in order of decreasing
+                // projection error.  Each picked pivot downdates the other
+                // candidates' errors exactly as a column-pivoted Cholesky
+                // factorization of S would, so deltas always tracks the error of
+                // each candidate against the dictionary plus the pivots picked so
+                // far.  The downdated errors are only used to pick pivots and screen
+                // candidates.  add() always recomputes the exact projection error
+                // before changing the dictionary, so they can't make us accept a
+                // bad vector.
+                std::vector<char> used(bs, false);
+                std::vector<matrix<scalar_type,0,1,mem_manager_type> > trows;
+                std::vector<scalar_type> tdeltas;
+                matrix<scalar_type,0,1,mem_manager_type> t(bs);
+                while (true)
+                {
+                    long best = -1;
+                    scalar_type best_delta = lisf.minimum_tolerance();
+                    for (long j = 0; j < bs; ++j)
+                    {
+                        if (!used[j] && deltas(j) > best_delta)
+                        {
+                            best_delta = deltas(j);
+                            best = j;
+                        }
+                    }
+                    if (best == -1)
+                        break;
+                    used[best] = true;
+
+                    if (lisf.add(samples(base+best)))
+                    {
+                        ++num_added;
+                        // The residual cross terms between the pivot and the other
+                        // candidates, i.e. the pivot's row of the Cholesky factor.
+                        for (long j = 0; j < bs; ++j)
+                        {
+                            t(j) = S(best,j);
+                            for (unsigned long k = 0; k < trows.size(); ++k)
+                                t(j) -= trows[k](best)*trows[k](j)/tdeltas[k];
+                        }
+                        for (long j = 0; j < bs; ++j)
+                        {
+                            if (!used[j])
+                                deltas(j) -= t(j)*t(j)/best_delta;
+                        }
+                        trows.push_back(t);
+                        tdeltas.push_back(best_delta);
+                    }
+                }
+            }
+
+            return num_added;
+        }
+    }
+
+    template <
+        typename kernel_type,
+        typename vector_type
+        >
+    unsigned long fill_lisf_blocked (
+        linearly_independent_subset_finder<kernel_type>& lisf,
+        const vector_type& samples,
+        const unsigned long block_size = 256
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT(is_vector(mat(samples)) && block_size > 0,
+            "\t unsigned long fill_lisf_blocked()"
+            << "\n\t invalid arguments to this function"
+            << "\n\t is_vector(mat(samples)): " << is_vector(mat(samples))
+            << "\n\t block_size: " << block_size
+            );
+
+        return impl::fill_lisf_blocked(lisf, mat(samples), block_size);
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
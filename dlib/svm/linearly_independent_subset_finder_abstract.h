@@ -319,6 +319,43 @@ namespace dlib
             - performs fill_lisf(lisf, samples, default_rand_generator, 2000)
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename kernel_type,
+        typename vector_type
+        >
+    unsigned long fill_lisf_blocked (
+        linearly_independent_subset_finder<kernel_type>& lisf,
+        const vector_type& samples,
+        const unsigned long block_size = 256
+    );
+    /*!
+        requires
+            - vector_type == a dlib::matrix or something convertible to one via
+              mat()
+            - is_vector(mat(samples)) == true
+            - block_size > 0
+        ensures
+            - The purpose of this function is to fill lisf with points from samples,
+              just like fill_lisf(), but it makes a single deterministic pass over
+              samples and screens candidates a block at a time.  The projection errors
+              of a whole block are obtained with two kernel matrix products rather
+              than one candidate at a time, and within a block candidates are picked
+              greedily in order of decreasing projection error with rank-revealing
+              (i.e. Schur complement) downdates of the remaining candidates' errors,
+              like a column-pivoted Cholesky factorization of the block's kernel
+              matrix would do.  This makes filling a large dictionary from a very
+              large sample set far faster than calling lisf.add() on each sample.
+            - The screened errors only decide which candidates get offered to
+              lisf.add(), which always verifies the exact projection error itself.
+              So the resulting dictionary satisfies exactly the same invariants as
+              one built by calling lisf.add() directly.  In particular, calling this
+              function with block_size == 1 adds exactly the same vectors as calling
+              lisf.add() on each element of samples in order.
+            - returns the number of elements of samples that were added to lisf.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -9,7 +9,10 @@
 #include "../type_safe_union.h"
 #include <sstream>
 #include <map>
+#include <utility>
+#include <vector>
 #include "../any.h"
+#include "function.h"
 #include "null_df.h"
 
 namespace dlib
@@ -128,6 +131,203 @@ namespace dlib
 
     };
 
+// ----------------------------------------------------------------------------------------
+
+    namespace impl_ova
+    {
+        // A cheap bucketing key used to find duplicate basis vectors without doing a
+        // full comparison against every vector seen so far.  Identical vectors always
+        // produce identical keys, so a full equality check is only needed within a
+        // bucket.
+        template <typename T>
+        typename enable_if<is_matrix<T>, std::pair<long,double> >::type basis_vector_key (
+            const T& s
+        )
+        {
+            return std::make_pair((long)s.size(), (double)sum(s));
+        }
+
+        template <typename T>
+        typename disable_if<is_matrix<T>, std::pair<long,double> >::type basis_vector_key (
+            const T& s
+        )
+        {
+            // sparse vectors are ranges of (index,value) pairs
+            long n = 0;
+            double total = 0;
+            for (typename T::const_iterator i = s.begin(); i != s.end(); ++i)
+            {
+                ++n;
+                total += i->second;
+            }
+            return std::make_pair(n, total);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename kernel_type,
+        typename label_type
+        >
+    class one_vs_all_shared_basis_evaluator
+    {
+        /*!
+            CONVENTION
+                - basis contains the unique basis vectors pooled from all the binary
+                  decision functions.
+                - labels.size() == weights.nr() == biases.size() == the number of classes.
+                - weights(c,u) == the total alpha weight class c places on basis[u].
+                - for any sample x, the c-th binary classifier's output is
+                  dot(rowm(weights,c), kernel row of x) - biases(c), which matches what
+                  the corresponding decision_function would have computed.
+        !*/
+    public:
+        typedef kernel_type K;
+        typedef typename K::scalar_type scalar_type;
+        typedef typename K::sample_type sample_type;
+        typedef typename K::mem_manager_type mem_manager_type;
+        typedef label_type result_type;
+
+        one_vs_all_shared_basis_evaluator (
+        ) {}
+
+        template <typename ova_df_type>
+        explicit one_vs_all_shared_basis_evaluator (
+            const ova_df_type& df
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(df.number_of_classes() != 0,
+                "\t one_vs_all_shared_basis_evaluator::one_vs_all_shared_basis_evaluator()"
+                << "\n\t You can't construct an evaluator from an empty decision function."
+                << "\n\t this: " << this
+                );
+
+            typedef typename ova_df_type::binary_function_table table_type;
+            const table_type& dfs = df.get_binary_decision_functions();
+
+            std::map<std::pair<long,double>, std::vector<unsigned long> > buckets;
+            std::vector<std::vector<std::pair<unsigned long,scalar_type> > > class_weights;
+
+            bool first = true;
+            for (typename table_type::const_iterator i = dfs.begin(); i != dfs.end(); ++i)
+            {
+                const decision_function<K>& bdf = any_cast<decision_function<K> >(i->second);
+                if (first)
+                {
+                    kernel = bdf.kernel_function;
+                    first = false;
+                }
+                else
+                {
+                    DLIB_ASSERT(kernel == bdf.kernel_function,
+                        "\t one_vs_all_shared_basis_evaluator::one_vs_all_shared_basis_evaluator()"
+                        << "\n\t All the binary decision functions must use the same kernel."
+                        << "\n\t this: " << this
+                        );
+                }
+
+                labels.push_back(i->first);
+                biases.push_back(bdf.b);
+                class_weights.push_back(std::vector<std::pair<unsigned long,scalar_type> >());
+
+                for (long j = 0; j < bdf.basis_vectors.size(); ++j)
+                {
+                    const sample_type& bv = bdf.basis_vectors(j);
+                    std::vector<unsigned long>& bucket = buckets[impl_ova::basis_vector_key(bv)];
+                    unsigned long idx = basis.size();
+                    for (unsigned long m = 0; m < bucket.size(); ++m)
+                    {
+                        if (basis[bucket[m]] == bv)
+                        {
+                            idx = bucket[m];
+                            break;
+                        }
+                    }
+                    if (idx == basis.size())
+                    {
+                        basis.push_back(bv);
+                        bucket.push_back(idx);
+                    }
+                    class_weights.back().push_back(std::make_pair(idx, bdf.alpha(j)));
+                }
+            }
+
+            // now that the full set of unique basis vectors is known, pack the per
+            // class weights into one dense matrix so prediction is a single
+            // matrix-vector product over the shared kernel row.
+            weights.set_size(labels.size(), basis.size());
+            weights = 0;
+            for (unsigned long c = 0; c < class_weights.size(); ++c)
+            {
+                for (unsigned long j = 0; j < class_weights[c].size(); ++j)
+                    weights(c, class_weights[c][j].first) += class_weights[c][j].second;
+            }
+        }
+
+        const K& get_kernel (
+        ) const { return kernel; }
+
+        unsigned long number_of_classes (
+        ) const { return labels.size(); }
+
+        unsigned long number_of_basis_vectors (
+        ) const { return basis.size(); }
+
+        std::pair<result_type, scalar_type> predict (
+            const sample_type& sample
+        ) const
+        {
+            DLIB_ASSERT(number_of_classes() != 0,
+                "\t pair<result_type,scalar_type> one_vs_all_shared_basis_evaluator::predict()"
+                << "\n\t You can't make predictions with an empty evaluator."
+                << "\n\t this: " << this
+                );
+
+            // Compute each unique kernel value exactly once, no matter how many of
+            // the binary classifiers share that basis vector.
+            matrix<scalar_type,0,1,mem_manager_type> krow(basis.size());
+            for (unsigned long u = 0; u < basis.size(); ++u)
+                krow(u) = kernel(sample, basis[u]);
+
+            const matrix<scalar_type,0,1,mem_manager_type> scores = weights*krow;
+
+            unsigned long best_idx = 0;
+            scalar_type best_score = -std::numeric_limits<scalar_type>::infinity();
+            for (unsigned long c = 0; c < labels.size(); ++c)
+            {
+                const scalar_type score = scores(c) - biases[c];
+                if (score > best_score)
+                {
+                    best_score = score;
+                    best_idx = c;
+                }
+            }
+            return std::make_pair(labels[best_idx], best_score);
+        }
+
+        result_type operator() (
+            const sample_type& sample
+        ) const
+        {
+            DLIB_ASSERT(number_of_classes() != 0,
+                "\t result_type one_vs_all_shared_basis_evaluator::operator()"
+                << "\n\t You can't make predictions with an empty evaluator."
+                << "\n\t this: " << this
+                );
+
+            return predict(sample).first;
+        }
+
+    private:
+        K kernel;
+        std::vector<sample_type> basis;
+        std::vector<result_type> labels;
+        std::vector<scalar_type> biases;
+        matrix<scalar_type,0,0,mem_manager_type> weights;
+    };
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -135,7 +335,7 @@ namespace dlib
         typename DF1, typename DF2, typename DF3,
         typename DF4, typename DF5, typename DF6,
         typename DF7, typename DF8, typename DF9,
-        typename DF10 
+        typename DF10
         >
     void serialize(
         const one_vs_all_decision_function<T,DF1,DF2,DF3,DF4,DF5,DF6,DF7,DF8,DF9,DF10>& item, 
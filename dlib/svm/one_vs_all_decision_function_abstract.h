@@ -160,6 +160,119 @@ namespace dlib
         !*/
     };
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename kernel_type,
+        typename label_type
+        >
+    class one_vs_all_shared_basis_evaluator
+    {
+        /*!
+            REQUIREMENTS ON kernel_type
+                is a kernel function object as defined in dlib/svm/kernel_abstract.h
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a faster way to evaluate a one_vs_all_decision_function
+                whose binary classifiers are all kernel decision_function objects.  The
+                component decision functions of a one-vs-all classifier usually share
+                many of their basis vectors, but evaluating them independently computes
+                a kernel value for every (classifier, basis vector) pair.  This object
+                pools the basis vectors at construction time, merging duplicates, so
+                that each unique kernel value is computed exactly once per query and
+                shared by all the classifiers that reference it.  For models with many
+                classes this reduces the number of kernel evaluations per query by
+                roughly the factor by which the basis vectors overlap.
+
+                The predictions produced are identical to those of the original
+                one_vs_all_decision_function up to floating point rounding.
+        !*/
+
+    public:
+        typedef typename kernel_type::scalar_type scalar_type;
+        typedef typename kernel_type::sample_type sample_type;
+        typedef typename kernel_type::mem_manager_type mem_manager_type;
+        typedef label_type result_type;
+
+        one_vs_all_shared_basis_evaluator (
+        );
+        /*!
+            ensures
+                - #number_of_classes() == 0
+        !*/
+
+        template <typename ova_df_type>
+        explicit one_vs_all_shared_basis_evaluator (
+            const ova_df_type& df
+        );
+        /*!
+            requires
+                - ova_df_type is an instantiation of one_vs_all_decision_function with
+                  label_type as its label type.
+                - df.number_of_classes() != 0
+                - every element of df.get_binary_decision_functions() contains a
+                  decision_function<kernel_type> object (i.e. the any_decision_function
+                  objects must hold that concrete type).
+                - all the contained decision functions use equal kernel function
+                  objects.
+            ensures
+                - #number_of_classes() == df.number_of_classes()
+                - this object will make the same predictions as df but using
+                  #number_of_basis_vectors() kernel evaluations per query rather than
+                  the total basis vector count over all the binary classifiers.
+            throws
+                - bad_any_cast if one of the binary decision functions does not
+                  contain a decision_function<kernel_type>.
+        !*/
+
+        const kernel_type& get_kernel (
+        ) const;
+        /*!
+            ensures
+                - returns the kernel shared by all the binary classifiers.
+        !*/
+
+        unsigned long number_of_classes (
+        ) const;
+        /*!
+            ensures
+                - returns the number of different labels/classes predicted by this
+                  object.
+        !*/
+
+        unsigned long number_of_basis_vectors (
+        ) const;
+        /*!
+            ensures
+                - returns the number of unique basis vectors pooled from the binary
+                  classifiers.  This is the number of kernel evaluations performed per
+                  call to predict().
+        !*/
+
+        std::pair<result_type, scalar_type> predict (
+            const sample_type& sample
+        ) const;
+        /*!
+            requires
+                - number_of_classes() != 0
+            ensures
+                - computes the kernel value between sample and each unique basis
+                  vector once, scores every class from those shared values, and
+                  returns the predicted label and its score, just like
+                  one_vs_all_decision_function::predict().
+        !*/
+
+        result_type operator() (
+            const sample_type& sample
+        ) const;
+        /*!
+            requires
+                - number_of_classes() != 0
+            ensures
+                - returns predict(sample).first
+        !*/
+    };
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -167,7 +280,7 @@ namespace dlib
         typename DF1, typename DF2, typename DF3,
         typename DF4, typename DF5, typename DF6,
         typename DF7, typename DF8, typename DF9,
-        typename DF10 
+        typename DF10
         >
     void serialize(
         const one_vs_all_decision_function<T,DF1,DF2,DF3,DF4,DF5,DF6,DF7,DF8,DF9,DF10>& item, 
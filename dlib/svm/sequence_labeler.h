@@ -7,6 +7,7 @@
 #include "../matrix.h"
 #include <vector>
 #include "../optimization/find_max_factor_graph_viterbi.h"
+#include "../threads.h"
 
 namespace dlib
 {
@@ -292,6 +293,39 @@ namespace dlib
             find_max_factor_graph_viterbi(map_prob(x,fe,weights), y);
         }
 
+        void label_sequences (
+            const std::vector<sample_sequence_type>& x,
+            std::vector<labeled_sequence_type>& y
+        ) const
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(num_labels() > 0,
+                "\t void sequence_labeler::label_sequences(x,y)"
+                << "\n\t You can't have no labels."
+                << "\n\t this: " << this
+                );
+
+            y.resize(x.size());
+            parallel_for_blocked(0, x.size(), [&](long begin, long end)
+            {
+                // Each worker reuses one contiguous trellis buffer for all the
+                // sequences in its block so we don't reallocate the DP table for
+                // every sequence.
+                std::vector<dlib::impl::viterbi_data> trellis;
+                for (long i = begin; i < end; ++i)
+                    dlib::impl::find_max_factor_graph_viterbi(map_prob(x[i],fe,weights), y[i], trellis);
+            });
+        }
+
+        std::vector<labeled_sequence_type> label_sequences (
+            const std::vector<sample_sequence_type>& x
+        ) const
+        {
+            std::vector<labeled_sequence_type> y;
+            label_sequences(x, y);
+            return y;
+        }
+
     private:
 
         feature_extractor fe;
@@ -359,6 +359,35 @@ namespace dlib
                   might be a little faster in some cases)
         !*/
 
+        void label_sequences (
+            const std::vector<sample_sequence_type>& x,
+            std::vector<labeled_sequence_type>& y
+        ) const;
+        /*!
+            requires
+                - num_labels() > 0
+            ensures
+                - #y.size() == x.size()
+                - for all valid i:
+                    - #y[i] == (*this)(x[i])
+                - This routine is much faster than labeling each sequence one at a
+                  time when there are many sequences.  The sequences are decoded in
+                  parallel using the default thread pool and each worker thread
+                  reuses a single contiguous buffer for the Viterbi dynamic
+                  programming tables rather than allocating one per sequence.
+        !*/
+
+        std::vector<labeled_sequence_type> label_sequences (
+            const std::vector<sample_sequence_type>& x
+        ) const;
+        /*!
+            requires
+                - num_labels() > 0
+            ensures
+                - returns a vector Y such that label_sequences(x, Y) would make Y
+                  contain the returned value.
+        !*/
+
     };
 
 // ----------------------------------------------------------------------------------------
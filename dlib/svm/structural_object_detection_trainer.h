@@ -10,6 +10,7 @@
 #include "../image_processing/object_detector.h"
 #include "../image_processing/box_overlap_testing.h"
 #include "../image_processing/full_object_detection.h"
+#include <memory>
 
 
 namespace dlib
@@ -184,6 +185,21 @@ namespace dlib
             return solver;
         }
 
+        typedef oca_cutting_plane_state<matrix<double,0,1> > solver_state_type;
+
+        void set_warm_start_state (
+            const std::shared_ptr<solver_state_type>& state
+        )
+        {
+            warm_start_state = state;
+        }
+
+        std::shared_ptr<solver_state_type> get_warm_start_state (
+        ) const
+        {
+            return warm_start_state;
+        }
+
         void set_c (
             scalar_type C_ 
         )
@@ -383,8 +399,12 @@ namespace dlib
             configure_nuclear_norm_regularizer(scanner, svm_prob);
             matrix<double,0,1> w;
 
-            // Run the optimizer to find the optimal w.
-            solver(svm_prob,w);
+            // Run the optimizer to find the optimal w.  If the user gave us a solver
+            // state then start from its cutting planes and update it when we finish.
+            if (warm_start_state)
+                solver(svm_prob,w,*warm_start_state);
+            else
+                solver(svm_prob,w);
 
             // report the results of the training.
             return object_detector<image_scanner_type>(scanner, svm_prob.get_overlap_tester(), w);
@@ -395,6 +415,7 @@ namespace dlib
 
         double C;
         oca solver;
+        std::shared_ptr<solver_state_type> warm_start_state;
         double eps;
         double match_eps;
         bool verbose;
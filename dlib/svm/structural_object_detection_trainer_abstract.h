@@ -211,7 +211,31 @@ namespace dlib
         ) const;
         /*!
             ensures
-                - returns a copy of the optimizer used to solve the structural SVM problem.  
+                - returns a copy of the optimizer used to solve the structural SVM problem.
+        !*/
+
+        typedef oca_cutting_plane_state<matrix<double,0,1> > solver_state_type;
+
+        void set_warm_start_state (
+            const std::shared_ptr<solver_state_type>& state
+        );
+        /*!
+            ensures
+                - #get_warm_start_state() == state
+                - Subsequent calls to train() will warm-start the OCA solver from the
+                  cutting planes in *state (if any) and will store the solver's final
+                  cutting plane set back into *state when they finish.  Since
+                  solver_state_type is serializable, this lets you persist the solver
+                  state between runs and make incremental retrains on slightly
+                  changed datasets converge in far fewer cutting plane iterations.
+        !*/
+
+        std::shared_ptr<solver_state_type> get_warm_start_state (
+        ) const;
+        /*!
+            ensures
+                - returns the solver state object used to warm-start train(), or a
+                  null pointer if warm-starting is disabled (the default).
         !*/
 
         void set_c (
@@ -9,6 +9,7 @@
 #include "../matrix.h"
 #include "../algs.h"
 #include "../rand.h"
+#include "../threads.h"
 #include "svm.h"
 
 #include "function.h"
@@ -49,7 +50,8 @@ namespace dlib
             have_bias(true),
             last_weight_1(false),
             do_shrinking(true),
-            do_svm_l2(false)
+            do_svm_l2(false),
+            batch_size(0)
         {
         }
 
@@ -64,7 +66,8 @@ namespace dlib
             have_bias(true),
             last_weight_1(false),
             do_shrinking(true),
-            do_svm_l2(false)
+            do_svm_l2(false),
+            batch_size(0)
         {
             // make sure requires clause is not broken
             DLIB_ASSERT(0 < C_,
@@ -107,6 +110,13 @@ namespace dlib
             bool enabled
         ) { do_shrinking = enabled; }
 
+        unsigned long get_batch_size (
+        ) const { return batch_size; }
+
+        void set_batch_size (
+            unsigned long batch_size_
+        ) { batch_size = batch_size_; }
+
         bool solving_svm_l2_problem (
         ) const { return do_svm_l2; }
 
@@ -532,6 +542,18 @@ namespace dlib
             const scalar_type Dii_pos = 1/(2*Cpos);
             const scalar_type Dii_neg = 1/(2*Cneg);
 
+            // When batch_size is non-zero we precompute the margins for a block of
+            // samples at a time so the dot products can be farmed out to multiple
+            // threads.  A precomputed margin is only valid until w changes, so
+            // whenever a coordinate update happens we mark the block stale and fall
+            // back to computing margins on the spot until the next block boundary.
+            // This means the batched mode always produces exactly the same solution
+            // as the plain sequential sweep.
+            std::vector<long> batch_index;
+            std::vector<scalar_type> batch_margin;
+            unsigned long batch_pos = 0;
+            bool batch_stale = false;
+
             // main loop
             for (unsigned long iter = 0; iter < max_iterations; ++iter)
             {
@@ -546,12 +568,53 @@ namespace dlib
                     std::swap(index[i], index[j]);
                 }
                 
+                batch_index.clear();
+                batch_pos = 0;
+                batch_stale = false;
+
                 // for all the active training samples
                 for (unsigned long ii = 0; ii < active_size; ++ii)
                 {
                     const long i = index[ii];
 
-                    scalar_type G = y(i)*dot(w, x(i)) - 1;
+                    scalar_type G;
+                    if (batch_size != 0)
+                    {
+                        if (batch_pos >= batch_index.size())
+                        {
+                            // compute the margins for the next block of samples
+                            const unsigned long bend = std::min<unsigned long>(ii + batch_size, active_size);
+                            batch_index.assign(index.begin()+ii, index.begin()+bend);
+                            batch_margin.resize(batch_index.size());
+                            auto compute_margin = [&](long k)
+                            {
+                                const long j = batch_index[k];
+                                batch_margin[k] = y(j)*dot(w, x(j)) - 1;
+                            };
+                            // Only spread the work over threads if there is enough of
+                            // it to make the threading overhead worthwhile.
+                            if (batch_index.size()*static_cast<unsigned long>(dims) >= 100000)
+                                parallel_for(0, static_cast<long>(batch_index.size()), compute_margin);
+                            else
+                                for (unsigned long k = 0; k < batch_index.size(); ++k)
+                                    compute_margin(k);
+                            batch_pos = 0;
+                            batch_stale = false;
+                        }
+
+                        // We can only use the precomputed margin if w hasn't changed
+                        // since it was computed and shrinking hasn't swapped a
+                        // different sample into this slot.
+                        if (!batch_stale && batch_index[batch_pos] == i)
+                            G = batch_margin[batch_pos];
+                        else
+                            G = y(i)*dot(w, x(i)) - 1;
+                        ++batch_pos;
+                    }
+                    else
+                    {
+                        G = y(i)*dot(w, x(i)) - 1;
+                    }
                     if (do_svm_l2)
                     {
                         if (y(i) > 0)
@@ -613,6 +676,9 @@ namespace dlib
 
                         if (last_weight_1)
                             w(dims-1) = 1;
+
+                        // w changed, so any remaining precomputed margins are stale.
+                        batch_stale = true;
                     }
 
                 }
@@ -699,6 +765,7 @@ namespace dlib
         bool last_weight_1;
         bool do_shrinking;
         bool do_svm_l2;
+        unsigned long batch_size;
 
     }; // end of class svm_c_linear_dcd_trainer
 
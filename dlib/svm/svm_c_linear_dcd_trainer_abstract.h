@@ -68,6 +68,7 @@ namespace dlib
                 - #includes_bias() == true
                 - #shrinking_enabled() == true
                 - #solving_svm_l2_problem() == false
+                - #get_batch_size() == 0
         !*/
 
         explicit svm_c_linear_dcd_trainer (
@@ -88,6 +89,7 @@ namespace dlib
                 - #includes_bias() == true
                 - #shrinking_enabled() == true
                 - #solving_svm_l2_problem() == false
+                - #get_batch_size() == 0
         !*/
 
         bool includes_bias (
@@ -142,6 +144,29 @@ namespace dlib
                 - #shrinking_enabled() == enabled
         !*/
 
+        unsigned long get_batch_size (
+        ) const;
+        /*!
+            ensures
+                - returns the number of margin computations this object will batch
+                  together during each optimization sweep.  When this value is
+                  non-zero the solver precomputes the margins for blocks of samples
+                  of this size, spreading the dot products over multiple threads when
+                  the block is big enough to make that worthwhile.  The batched mode
+                  produces exactly the same solution as the sequential mode, it just
+                  runs faster on large training sets, particularly during the later
+                  sweeps where few coordinates change.  A value of 0 means margins
+                  are computed one sample at a time.
+        !*/
+
+        void set_batch_size (
+            unsigned long batch_size
+        );
+        /*!
+            ensures
+                - #get_batch_size() == batch_size
+        !*/
+
         bool solving_svm_l2_problem (
         ) const; 
         /*!
@@ -7,10 +7,12 @@
 #include "../algs.h"
 #include "../optimization.h"
 #include "../matrix.h"
+#include "../threads.h"
 #include "function.h"
 #include "kernel.h"
 #include <iostream>
 #include <vector>
+#include <thread>
 #include "sparse_vector.h"
 
 namespace dlib
@@ -45,7 +47,8 @@ namespace dlib
             const bool be_verbose_,
             const scalar_type eps_,
             const unsigned long max_iter,
-            const unsigned long dims_
+            const unsigned long dims_,
+            const unsigned long num_threads_ = 1
         ) :
             samples(samples_),
             labels(labels_),
@@ -55,7 +58,8 @@ namespace dlib
             be_verbose(be_verbose_),
             eps(eps_),
             max_iterations(max_iter),
-            dims(dims_)
+            dims(dims_),
+            num_threads(num_threads_)
         {
             dot_prods.resize(samples.size());
             is_first_call = true;
@@ -124,33 +128,63 @@ namespace dlib
             subgradient = 0;
             risk = 0;
 
-
-            // loop over all the samples and compute the risk and its subgradient at the current solution point w
-            for (long i = 0; i < samples.size(); ++i)
+            // Computes the risk and subgradient contributions of the samples in the
+            // range [begin,end), accumulating them into risk_accum and subgrad_accum.
+            auto accumulate_risk = [&](long begin, long end, scalar_type& risk_accum, matrix_type& subgrad_accum)
             {
-                // multiply current SVM output for the ith sample by its label
-                const scalar_type df_val = labels(i)*dot_prods[i];
-
-                if (labels(i) > 0)
-                    risk += Cpos*std::max<scalar_type>(0.0,1 - df_val);
-                else
-                    risk += Cneg*std::max<scalar_type>(0.0,1 - df_val);
-
-                if (df_val < 1)
+                for (long i = begin; i < end; ++i)
                 {
-                    if (labels(i) > 0)
-                    {
-                        subtract_from(subgradient, samples(i), Cpos);
+                    // multiply current SVM output for the ith sample by its label
+                    const scalar_type df_val = labels(i)*dot_prods[i];
 
-                        subgradient(subgradient.size()-1) += Cpos;
-                    }
+                    if (labels(i) > 0)
+                        risk_accum += Cpos*std::max<scalar_type>(0.0,1 - df_val);
                     else
+                        risk_accum += Cneg*std::max<scalar_type>(0.0,1 - df_val);
+
+                    if (df_val < 1)
                     {
-                        add_to(subgradient, samples(i), Cneg);
+                        if (labels(i) > 0)
+                        {
+                            subtract_from(subgrad_accum, samples(i), Cpos);
 
-                        subgradient(subgradient.size()-1) -= Cneg;
+                            subgrad_accum(subgrad_accum.size()-1) += Cpos;
+                        }
+                        else
+                        {
+                            add_to(subgrad_accum, samples(i), Cneg);
+
+                            subgrad_accum(subgrad_accum.size()-1) -= Cneg;
+                        }
                     }
                 }
+            };
+
+            // loop over all the samples and compute the risk and its subgradient at the current solution point w
+            const unsigned long blocks = std::min<unsigned long>(num_threads, samples.size());
+            if (blocks <= 1)
+            {
+                accumulate_risk(0, samples.size(), risk, subgradient);
+            }
+            else
+            {
+                // Accumulate each block of samples on its own thread and then reduce
+                // the per-block results.
+                std::vector<scalar_type> block_risks(blocks, 0);
+                std::vector<matrix_type> block_subgradients(blocks);
+                parallel_for(blocks, 0, blocks, [&](long b)
+                {
+                    block_subgradients[b].set_size(w.size(),1);
+                    block_subgradients[b] = 0;
+                    const long begin = b*samples.size()/blocks;
+                    const long end = (b+1)*samples.size()/blocks;
+                    accumulate_risk(begin, end, block_risks[b], block_subgradients[b]);
+                });
+                for (unsigned long b = 0; b < blocks; ++b)
+                {
+                    risk += block_risks[b];
+                    subgradient += block_subgradients[b];
+                }
             }
 
             scalar_type scale = 1.0/samples.size();
@@ -176,8 +210,20 @@ namespace dlib
             // The reason for using w_size_m1 and not just w.size()-1 is because
             // doing it this way avoids an inane warning from gcc that can occur in some cases.
             const long w_size_m1 = w.size()-1;
-            for (long i = 0; i < samples.size(); ++i)
-                dot_prods[i] = dot(colm(w,0,w_size_m1), samples(i)) - w(w_size_m1);
+            if (num_threads <= 1)
+            {
+                for (long i = 0; i < samples.size(); ++i)
+                    dot_prods[i] = dot(colm(w,0,w_size_m1), samples(i)) - w(w_size_m1);
+            }
+            else
+            {
+                // Each dot product writes to its own slot in dot_prods, so these all
+                // run independently.
+                parallel_for(num_threads, 0, samples.size(), [&](long i)
+                {
+                    dot_prods[i] = dot(colm(w,0,w_size_m1), samples(i)) - w(w_size_m1);
+                });
+            }
 
             if (is_first_call)
             {
@@ -303,6 +349,7 @@ namespace dlib
         const scalar_type eps;
         const unsigned long max_iterations;
         const unsigned long dims;
+        const unsigned long num_threads;
     };
 
 // ----------------------------------------------------------------------------------------
@@ -321,11 +368,12 @@ namespace dlib
         const bool be_verbose,
         const scalar_type eps,
         const unsigned long max_iterations,
-        const unsigned long dims
+        const unsigned long dims,
+        const unsigned long num_threads = 1
     )
     {
         return oca_problem_c_svm<matrix_type, in_sample_vector_type, in_scalar_vector_type>(
-            C_pos, C_neg, samples, labels, be_verbose, eps, max_iterations, dims);
+            C_pos, C_neg, samples, labels, be_verbose, eps, max_iterations, dims, num_threads);
     }
 
 // ----------------------------------------------------------------------------------------
@@ -359,6 +407,7 @@ namespace dlib
             max_iterations = 10000;
             learn_nonnegative_weights = false;
             last_weight_1 = false;
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
         }
 
         explicit svm_c_linear_trainer (
@@ -380,6 +429,7 @@ namespace dlib
             max_iterations = 10000;
             learn_nonnegative_weights = false;
             last_weight_1 = false;
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
         }
 
         void set_epsilon (
@@ -422,6 +472,24 @@ namespace dlib
             verbose = false;
         }
 
+        unsigned long get_num_threads (
+        ) const { return num_threads; }
+
+        void set_num_threads (
+            unsigned long num
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(num > 0,
+                "\t void svm_c_linear_trainer::set_num_threads()"
+                << "\n\t num must be greater than 0"
+                << "\n\t num:  " << num
+                << "\n\t this: " << this
+                );
+
+            num_threads = num;
+        }
+
         void set_oca (
             const oca& item
         )
@@ -654,14 +722,14 @@ namespace dlib
                                                                          mat(prior_b));
 
                 svm_objective = solver(
-                    make_oca_problem_c_svm<w_type>(Cpos, Cneg, x, y, verbose, eps, max_iterations, dims), 
+                    make_oca_problem_c_svm<w_type>(Cpos, Cneg, x, y, verbose, eps, max_iterations, dims, num_threads),
                     w,
                     prior_temp);
             }
             else
             {
                 svm_objective = solver(
-                    make_oca_problem_c_svm<w_type>(Cpos, Cneg, x, y, verbose, eps, max_iterations, num_dims), 
+                    make_oca_problem_c_svm<w_type>(Cpos, Cneg, x, y, verbose, eps, max_iterations, num_dims, num_threads),
                     w,
                     num_nonnegative,
                     force_weight_1_idx);
@@ -693,7 +761,8 @@ namespace dlib
         bool last_weight_1;
         matrix<scalar_type,0,1> prior;
         scalar_type prior_b = 0;
-    }; 
+        unsigned long num_threads;
+    };
 
 // ----------------------------------------------------------------------------------------
 
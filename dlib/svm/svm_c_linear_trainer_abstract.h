@@ -55,6 +55,7 @@ namespace dlib
                 - #learns_nonnegative_weights() == false
                 - #force_last_weight_to_1() == false
                 - #has_prior() == false
+                - #get_num_threads() == std::thread::hardware_concurrency()
         !*/
 
         explicit svm_c_linear_trainer (
@@ -75,6 +76,7 @@ namespace dlib
                 - #learns_nonnegative_weights() == false
                 - #force_last_weight_to_1() == false
                 - #has_prior() == false
+                - #get_num_threads() == std::thread::hardware_concurrency()
         !*/
 
         void set_epsilon (
@@ -129,6 +131,28 @@ namespace dlib
                 - this object will not print anything to standard out
         !*/
 
+        unsigned long get_num_threads (
+        ) const;
+        /*!
+            ensures
+                - returns the number of threads used to evaluate the SVM risk and its
+                  subgradient during training.  The samples are partitioned into
+                  get_num_threads() blocks, each block is processed on its own thread,
+                  and the per-block results are summed.  Note that this means the order
+                  of the floating point accumulations, and therefore the exact result,
+                  can change slightly when the thread count changes.
+        !*/
+
+        void set_num_threads (
+            unsigned long num
+        );
+        /*!
+            requires
+                - num > 0
+            ensures
+                - #get_num_threads() == num
+        !*/
+
         void set_oca (
             const oca& item
         );
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -228,7 +229,7 @@ namespace dlib
         typename in_sample_vector_type,
         typename in_scalar_vector_type
         >
-    const matrix<double, 1, 2, typename trainer_type::mem_manager_type> 
+    const matrix<double, 1, 2, typename trainer_type::mem_manager_type>
     cross_validate_trainer_threaded (
         const trainer_type& trainer,
         const in_sample_vector_type& x,
@@ -244,6 +245,127 @@ namespace dlib
                                            num_threads);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename kernel_type
+        >
+    class kernel_matrix_cache
+    {
+        /*!
+            CONVENTION
+                - K == a precomputed kernel matrix over some set of samples.  Samples
+                  are referred to by their index, so (*this)(a,b) == the kernel product
+                  of samples a and b.  All the folds of a cross validation run share
+                  the same K through the shared_ptr.
+        !*/
+    public:
+        typedef typename kernel_type::scalar_type scalar_type;
+        typedef long sample_type;
+        typedef typename kernel_type::mem_manager_type mem_manager_type;
+
+        kernel_matrix_cache() {}
+
+        kernel_matrix_cache (
+            const std::shared_ptr<const matrix<scalar_type,0,0,mem_manager_type> >& K_
+        ) : K(K_) {}
+
+        scalar_type operator() (
+            const sample_type& a,
+            const sample_type& b
+        ) const { return (*K)(a,b); }
+
+        bool operator== (
+            const kernel_matrix_cache& item
+        ) const { return K == item.K; }
+
+    private:
+        std::shared_ptr<const matrix<scalar_type,0,0,mem_manager_type> > K;
+    };
+
+    template <typename kernel_type>
+    void serialize (const kernel_matrix_cache<kernel_type>&, std::ostream&)
+    {
+        throw serialization_error("Attempt to serialize a kernel_matrix_cache.  These objects only "
+                                  "make sense relative to the dataset they were built from and so "
+                                  "can't be serialized.");
+    }
+
+    template <typename kernel_type>
+    void deserialize (kernel_matrix_cache<kernel_type>&, std::istream&)
+    {
+        throw serialization_error("Attempt to deserialize a kernel_matrix_cache.");
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        template <typename> class trainer_type,
+        typename kernel_type,
+        typename in_sample_vector_type,
+        typename in_scalar_vector_type
+        >
+    const matrix<double, 1, 2, typename kernel_type::mem_manager_type>
+    cross_validate_trainer_cached (
+        trainer_type<kernel_matrix_cache<kernel_type> > trainer,
+        const kernel_type& kernel,
+        const in_sample_vector_type& x_,
+        const in_scalar_vector_type& y,
+        const long folds,
+        const long num_threads
+    )
+    {
+        typedef typename kernel_type::scalar_type scalar_type;
+        typedef typename kernel_type::mem_manager_type mem_manager_type;
+
+        const auto& x = mat(x_);
+
+        // make sure requires clause is not broken
+        DLIB_ASSERT(is_binary_classification_problem(x,mat(y)) == true &&
+                    1 < folds && folds <= std::min(sum(mat(y)>0),sum(mat(y)<0)) &&
+                    num_threads > 0,
+            "\tmatrix cross_validate_trainer_cached()"
+            << "\n\t invalid inputs were given to this function"
+            << "\n\t std::min(sum(y>0),sum(y<0)): " << std::min(sum(mat(y)>0),sum(mat(y)<0))
+            << "\n\t folds:  " << folds
+            << "\n\t num_threads:  " << num_threads
+            << "\n\t is_binary_classification_problem(x,y): " << ((is_binary_classification_problem(x,mat(y)))? "true":"false")
+            );
+
+        const long n = x.size();
+
+        // Compute the kernel matrix over the whole dataset once.  The folds of a
+        // cross validation run train on heavily overlapping subsets of x, so this
+        // saves each fold from recomputing almost all the same kernel products.
+        auto K = std::make_shared<matrix<scalar_type,0,0,mem_manager_type> >();
+        K->set_size(n,n);
+        {
+            thread_pool tp(num_threads);
+            // Only compute the upper triangle and mirror it since kernels are symmetric.
+            parallel_for(tp, 0, n, [&](long r)
+            {
+                for (long c = r; c < n; ++c)
+                {
+                    (*K)(r,c) = kernel(x(r), x(c));
+                    (*K)(c,r) = (*K)(r,c);
+                }
+            });
+        }
+
+        trainer.set_kernel(kernel_matrix_cache<kernel_type>(K));
+
+        // now cross validate over the sample indices rather than the samples themselves
+        matrix<long,0,1> idx(n);
+        for (long i = 0; i < n; ++i)
+            idx(i) = i;
+
+        return cross_validate_trainer_threaded_impl(trainer,
+                                           idx,
+                                           mat(y),
+                                           folds,
+                                           num_threads);
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -52,6 +52,79 @@ namespace dlib
             - std::bad_alloc
     !*/
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename kernel_type
+        >
+    class kernel_matrix_cache
+    {
+        /*!
+            REQUIREMENTS ON kernel_type
+                is a kernel function object as defined in dlib/svm/kernel_abstract.h
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a kernel function whose sample_type is long.  Its
+                samples are indices into a precomputed kernel matrix, so evaluating
+                it is just a table lookup.  It exists so that all the folds of a
+                cross_validate_trainer_cached() run can share one kernel matrix
+                instead of each fold recomputing mostly the same kernel products.
+                You shouldn't need to create these objects yourself, use
+                cross_validate_trainer_cached() instead.
+
+            THREAD SAFETY
+                Evaluating this kernel is a read-only operation, so it is safe for
+                many threads to use the same kernel_matrix_cache at once.
+        !*/
+    public:
+        typedef typename kernel_type::scalar_type scalar_type;
+        typedef long sample_type;
+        typedef typename kernel_type::mem_manager_type mem_manager_type;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        template <typename> class trainer_type,
+        typename kernel_type,
+        typename in_sample_vector_type,
+        typename in_scalar_vector_type
+        >
+    const matrix<double, 1, 2, typename kernel_type::mem_manager_type>
+    cross_validate_trainer_cached (
+        trainer_type<kernel_matrix_cache<kernel_type> > trainer,
+        const kernel_type& kernel,
+        const in_sample_vector_type& x,
+        const in_scalar_vector_type& y,
+        const long folds,
+        const long num_threads
+    );
+    /*!
+        requires
+            - is_binary_classification_problem(x,y) == true
+            - 1 < folds <= std::min(sum(y>0),sum(y<0))
+              (e.g. There must be at least as many examples of each class as there are folds)
+            - trainer_type == some kind of kernelized trainer template (e.g. svm_c_trainer,
+              svm_nu_trainer, or krr_trainer) instantiated with a kernel_matrix_cache.
+              Set the trainer's non-kernel parameters (e.g. the C value) before calling
+              this function, the kernel is supplied via the kernel argument.
+            - kernel == a kernel function object capable of operating on the elements of x
+            - num_threads > 0
+        ensures
+            - performs k-fold cross validation exactly like cross_validate_trainer_threaded()
+              and returns the same style of accuracy row vector.  The folds are trained and
+              tested concurrently on num_threads threads.
+            - Unlike cross_validate_trainer_threaded(), the kernel products over the whole
+              dataset are computed just once, in parallel, and shared by every fold.  Since
+              each fold trains on (folds-1)/folds of the data, the folds would otherwise
+              recompute almost all the same kernel matrix entries.  This makes this routine
+              much faster when kernel evaluations dominate the training time, at the cost
+              of O(x.size()^2) memory for the cached kernel matrix.
+        throws
+            - any exceptions thrown by trainer.train()
+            - std::bad_alloc
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
 }
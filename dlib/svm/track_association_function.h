@@ -100,6 +100,55 @@ namespace dlib
         ) const
         {
             std::vector<long> assignments = assoc(dets, tracks);
+            apply_assignments(tracks, dets, assignments);
+        }
+
+        void associate (
+            std::vector<track_type>& tracks,
+            const std::vector<detection_type>& dets
+        )
+        {
+            std::vector<long> assignments;
+            assoc.predict_assignments(dets, tracks, assignments, state);
+            apply_assignments(tracks, dets, assignments);
+        }
+
+        template <typename gate_funct>
+        void associate (
+            std::vector<track_type>& tracks,
+            const std::vector<detection_type>& dets,
+            gate_funct&& gate
+        )
+        {
+            std::vector<long> assignments;
+            assoc.predict_assignments(dets, tracks, assignments, state, std::forward<gate_funct>(gate));
+            apply_assignments(tracks, dets, assignments);
+        }
+
+        friend void serialize (const track_association_function& item, std::ostream& out)
+        {
+            int version = 1;
+            serialize(version, out);
+            serialize(item.assoc, out);
+        }
+        friend void deserialize (track_association_function& item, std::istream& in)
+        {
+            int version = 0;
+            deserialize(version, in);
+            if (version != 1)
+                throw serialization_error("Unexpected version found while deserializing dlib::track_association_function.");
+
+            deserialize(item.assoc, in);
+        }
+
+    private:
+
+        static void apply_assignments (
+            std::vector<track_type>& tracks,
+            const std::vector<detection_type>& dets,
+            const std::vector<long>& assignments
+        )
+        {
             std::vector<bool> updated_track(tracks.size(), false);
             // now update all the tracks with the detections that associated to them.
             for (unsigned long i = 0; i < assignments.size(); ++i)
@@ -125,25 +174,9 @@ namespace dlib
             }
         }
 
-        friend void serialize (const track_association_function& item, std::ostream& out)
-        {
-            int version = 1;
-            serialize(version, out);
-            serialize(item.assoc, out);
-        }
-        friend void deserialize (track_association_function& item, std::istream& in)
-        {
-            int version = 0;
-            deserialize(version, in);
-            if (version != 1)
-                throw serialization_error("Unexpected version found while deserializing dlib::track_association_function.");
-
-            deserialize(item.assoc, in);
-        }
-
-    private:
-
         assignment_function<feature_extractor_track_association<detection_type> > assoc;
+        // transient scratch for associate().  Not serialized.
+        typename association_function_type::solver_state state;
     };
 
 // ----------------------------------------------------------------------------------------
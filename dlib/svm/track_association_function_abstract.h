@@ -238,6 +238,40 @@ namespace dlib
                   propagate_track() only on tracks that do not get associated with a
                   detection.
         !*/
+
+        void associate (
+            std::vector<track_type>& tracks,
+            const std::vector<detection_type>& dets
+        );
+        /*!
+            ensures
+                - performs the same track updates as operator() and produces identical
+                  results.  However, this version keeps the assignment solver's
+                  scratch space inside this object and warm starts each solve from
+                  the previous frame's dual variables, which is much faster when
+                  called once per frame on a slowly changing set of tracks.  The
+                  scratch space is transient and is not serialized.
+        !*/
+
+        template <typename gate_funct>
+        void associate (
+            std::vector<track_type>& tracks,
+            const std::vector<detection_type>& dets,
+            gate_funct&& gate
+        );
+        /*!
+            requires
+                - gate must be a function object with a signature compatible with:
+                    bool gate(const detection_type& det, const track_type& track)
+                  which returns false if det should never be associated to track.
+            ensures
+                - identical to the associate() overload above except that
+                  detection/track pairs rejected by the gate are pruned before
+                  solving: no similarity features are computed for them and they can
+                  never associate to each other.  Use this to skip the feature
+                  extraction for pairs that are obviously incompatible, e.g. too far
+                  apart spatially.
+        !*/
     };
 
     template <
@@ -0,0 +1,188 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include <dlib/allocator_stats.h>
+#include <dlib/memory_manager.h>
+#include <dlib/memory_manager_stateless.h>
+#include <dlib/matrix.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tester.h"
+
+namespace
+{
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.allocator_stats");
+
+// ----------------------------------------------------------------------------------------
+
+    unsigned long long site_count (
+        const allocator_stats::stats_snapshot& snap,
+        const std::string& name
+    )
+    {
+        for (auto& s : snap.call_sites)
+        {
+            if (s.name == name)
+                return s.num_sampled;
+        }
+        return 0;
+    }
+
+    unsigned long long site_bytes (
+        const allocator_stats::stats_snapshot& snap,
+        const std::string& name
+    )
+    {
+        for (auto& s : snap.call_sites)
+        {
+            if (s.name == name)
+                return s.sampled_bytes;
+        }
+        return 0;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void allocator_stats_test (
+    )
+    {
+        auto& stats = allocator_stats::get();
+
+        // while disabled nothing should be recorded
+        stats.disable();
+        stats.clear();
+        {
+            memory_manager<int>::kernel_1a mm;
+            int* p = mm.allocate();
+            mm.deallocate(p);
+        }
+        auto snap = stats.get_stats();
+        DLIB_TEST(snap.num_sampled_allocations == 0);
+        DLIB_TEST(snap.estimated_current_bytes == 0);
+        DLIB_TEST(snap.estimated_peak_bytes == 0);
+
+        // With a sampling interval of 1 every allocation is recorded, so the counters
+        // are exact and we can make precise checks.
+        stats.enable(1);
+        DLIB_TEST(stats.is_enabled());
+        DLIB_TEST(stats.get_sampling_interval() == 1);
+        stats.clear();
+
+        const auto s0 = stats.get_stats();
+
+        memory_manager<int>::kernel_1a mm;
+        const unsigned long long single_allocs_before = site_count(s0, "memory_manager::allocate");
+        std::vector<int*> singles;
+        for (int i = 0; i < 5; ++i)
+            singles.push_back(mm.allocate());
+
+        auto s1 = stats.get_stats();
+        DLIB_TEST(s1.sampling_interval == 1);
+        DLIB_TEST_MSG(site_count(s1, "memory_manager::allocate") == single_allocs_before + 5,
+            site_count(s1, "memory_manager::allocate"));
+        DLIB_TEST(site_bytes(s1, "memory_manager::allocate") >= 5*sizeof(int));
+        DLIB_TEST(s1.estimated_current_bytes >= s0.estimated_current_bytes + 5*sizeof(int));
+
+        for (auto p : singles)
+            mm.deallocate(p);
+
+        // a 4000 byte array lands in the [2048,4096) size class, i.e. bucket 11
+        int* arr = mm.allocate_array(1000);
+        auto s2 = stats.get_stats();
+        DLIB_TEST(site_count(s2, "memory_manager::allocate_array") >= 1);
+        DLIB_TEST_MSG(s2.size_class_histogram[11] >= 1, s2.size_class_histogram[11]);
+        DLIB_TEST(s2.estimated_current_bytes >= s0.estimated_current_bytes + 4000);
+        DLIB_TEST(s2.estimated_peak_bytes >= s0.estimated_current_bytes + 4000);
+        mm.deallocate_array(arr);
+
+        // once everything we allocated is freed the outstanding byte estimate should
+        // drop back to where it started
+        auto s3 = stats.get_stats();
+        DLIB_TEST_MSG(s3.estimated_current_bytes == s0.estimated_current_bytes,
+            s3.estimated_current_bytes << " vs " << s0.estimated_current_bytes);
+        // and the peak must remember the arrays
+        DLIB_TEST(s3.estimated_peak_bytes >= s0.estimated_current_bytes + 4000);
+
+        // matrix draws from the default (stateless) memory manager, so allocating one
+        // should show up under the stateless call site
+        {
+            const unsigned long long bytes_before = site_bytes(s3, "memory_manager_stateless::allocate_array");
+            matrix<double> m(100,100);
+            m = 0;
+            auto s4 = stats.get_stats();
+            DLIB_TEST_MSG(site_bytes(s4, "memory_manager_stateless::allocate_array") >= bytes_before + 100*100*sizeof(double),
+                site_bytes(s4, "memory_manager_stateless::allocate_array"));
+        }
+
+        // user annotated call sites
+        {
+            char buf[128];
+            DLIB_RECORD_SAMPLED_ALLOCATION(buf, sizeof(buf), "my_test_site");
+            auto s5 = stats.get_stats();
+            DLIB_TEST(site_count(s5, "my_test_site") == 1);
+            DLIB_TEST(site_bytes(s5, "my_test_site") == sizeof(buf));
+            DLIB_RECORD_SAMPLED_DEALLOCATION(buf);
+        }
+
+        print_spinner();
+
+        // with a bigger sampling interval only about every 10th allocation is recorded
+        stats.clear();
+        stats.enable(10);
+        std::vector<int*> temp;
+        for (int i = 0; i < 100; ++i)
+            temp.push_back(mm.allocate());
+        for (auto p : temp)
+            mm.deallocate(p);
+        auto s6 = stats.get_stats();
+        dlog << LINFO << "sampled " << s6.num_sampled_allocations << " of 100 allocations at interval 10";
+        DLIB_TEST_MSG(5 <= s6.num_sampled_allocations && s6.num_sampled_allocations <= 20,
+            s6.num_sampled_allocations);
+        DLIB_TEST(s6.estimated_num_allocations == 10*s6.num_sampled_allocations);
+
+        // nothing is recorded after disable()
+        stats.disable();
+        const auto s7 = stats.get_stats();
+        int* p = mm.allocate();
+        mm.deallocate(p);
+        auto s8 = stats.get_stats();
+        DLIB_TEST(s8.num_sampled_allocations == s7.num_sampled_allocations);
+
+        // clear() zeroes everything, including the per site counters
+        stats.clear();
+        auto s9 = stats.get_stats();
+        DLIB_TEST(s9.num_sampled_allocations == 0);
+        DLIB_TEST(s9.estimated_current_bytes == 0);
+        DLIB_TEST(s9.estimated_peak_bytes == 0);
+        DLIB_TEST(site_count(s9, "memory_manager::allocate") == 0);
+        for (auto count : s9.size_class_histogram)
+            DLIB_TEST(count == 0);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class allocator_stats_tester : public tester
+    {
+    public:
+        allocator_stats_tester (
+        ) :
+            tester ("test_allocator_stats",
+                    "Runs tests on the sampled allocator statistics.")
+        {}
+
+        void perform_test (
+        )
+        {
+            print_spinner();
+            allocator_stats_test();
+        }
+    } a;
+
+}
+
@@ -108,12 +108,76 @@ namespace
         a = 1;
         b = 2;
 
-        int* a_ptr = &a.get<int>();
-        int* b_ptr = &b.get<int>();
-
+        // ints are small enough to be stored inside the any objects themselves, so
+        // swapping them moves the values rather than the storage.
         swap(a,b);
-        DLIB_TEST(a_ptr == &b.get<int>());
-        DLIB_TEST(b_ptr == &a.get<int>());
+        DLIB_TEST(a.get<int>() == 2);
+        DLIB_TEST(b.get<int>() == 1);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    // A type too big for the small-buffer storage inside any.  It counts its live
+    // instances so we can tell that the any objects construct and destroy exactly one
+    // contained object per copy, whichever storage they use.
+    struct big_counted
+    {
+        static int count;
+        int value;
+        char padding[2*DLIB_ANY_SBO_SIZE];
+
+        big_counted() : value(0) { ++count; }
+        big_counted(const big_counted& item) : value(item.value) { ++count; }
+        ~big_counted() { --count; }
+    };
+    int big_counted::count = 0;
+
+    struct small_counted
+    {
+        static int count;
+        int value;
+
+        small_counted() : value(0) { ++count; }
+        small_counted(const small_counted& item) : value(item.value) { ++count; }
+        ~small_counted() { --count; }
+    };
+    int small_counted::count = 0;
+
+    template <typename T>
+    void test_storage()
+    {
+        DLIB_TEST(T::count == 0);
+        {
+            any a;
+            a.get<T>().value = 5;
+            DLIB_TEST(T::count == 1);
+
+            // copies are deep no matter where the contents are stored
+            any b = a;
+            DLIB_TEST(T::count == 2);
+            DLIB_TEST(b.cast_to<T>().value == 5);
+            b.cast_to<T>().value = 7;
+            DLIB_TEST(a.cast_to<T>().value == 5);
+
+            any c;
+            c = b;
+            DLIB_TEST(T::count == 3);
+            DLIB_TEST(c.cast_to<T>().value == 7);
+
+            swap(a,c);
+            DLIB_TEST(T::count == 3);
+            DLIB_TEST(a.cast_to<T>().value == 7);
+            DLIB_TEST(c.cast_to<T>().value == 5);
+
+            // overwriting and clearing destroy the old contents
+            a = 4;
+            DLIB_TEST(T::count == 2);
+            DLIB_TEST(a.cast_to<int>() == 4);
+            b.clear();
+            DLIB_TEST(T::count == 1);
+        }
+        // everything any objects created has been destroyed
+        DLIB_TEST(T::count == 0);
     }
 
 // ----------------------------------------------------------------------------------------
@@ -131,6 +195,8 @@ namespace
         )
         {
             run_test();
+            test_storage<small_counted>();
+            test_storage<big_counted>();
         }
     } a;
 
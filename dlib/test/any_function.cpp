@@ -225,6 +225,41 @@ namespace
         DLIB_TEST(a==1 && b==2 && c==3 && d==4 && e==5 && f==6 && g==7 && h==8 && i==9 && j==10);
         zero_vals(a,b,c,d,e,f,g,h,i,j);
     }
+// ----------------------------------------------------------------------------------------
+
+    // a functor too big for the small-buffer storage inside any_function, to make sure
+    // the heap-stored path behaves the same as the inline one.
+    struct big_test
+    {
+        int v;
+        char padding[2*DLIB_ANY_SBO_SIZE];
+
+        big_test(int val) : v(val) {}
+        int operator()() const { return v; }
+    };
+
+    void run_test4()
+    {
+        any_function<int()> a = big_test(8);
+        DLIB_TEST(a() == 8);
+        DLIB_TEST(a.contains<big_test>() == true);
+
+        any_function<int()> b = a;
+        DLIB_TEST(b() == 8);
+        b.cast_to<big_test>().v = 9;
+        DLIB_TEST(a() == 8);
+        DLIB_TEST(b() == 9);
+
+        // swapping between inline and heap stored functions works
+        any_function<int()> c = test2(3);
+        swap(b,c);
+        DLIB_TEST(b() == 3);
+        DLIB_TEST(c() == 9);
+
+        a.clear();
+        DLIB_TEST(a.is_empty());
+    }
+
 // ----------------------------------------------------------------------------------------
 
     class test_any_function : public tester
@@ -245,6 +280,8 @@ namespace
             run_test2();
             print_spinner();
             run_test3();
+            print_spinner();
+            run_test4();
         }
     } a;
 
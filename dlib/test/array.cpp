@@ -618,6 +618,37 @@ namespace
         DLIB_TEST(dlib::is_array<array<stuff> >::value == true);
     }
 
+    void test_shrink_to_fit()
+    {
+        array<int> a;
+        a.resize(100);
+        for (unsigned int i = 0; i < a.size(); ++i)
+            a[i] = i;
+
+        // resizing within the existing allocation shouldn't move the elements
+        const int* const buf = &a[0];
+        a.resize(10);
+        DLIB_TEST(a.size() == 10);
+        DLIB_TEST(a.max_size() == 100);
+        DLIB_TEST(&a[0] == buf);
+
+        a.shrink_to_fit();
+        DLIB_TEST(a.size() == 10);
+        DLIB_TEST(a.max_size() == 10);
+        for (unsigned int i = 0; i < a.size(); ++i)
+            DLIB_TEST(a[i] == (int)i);
+
+        // shrinking an already tight array is a no-op
+        a.shrink_to_fit();
+        DLIB_TEST(a.size() == 10);
+        DLIB_TEST(a.max_size() == 10);
+
+        a.resize(0);
+        a.shrink_to_fit();
+        DLIB_TEST(a.size() == 0);
+        DLIB_TEST(a.max_size() == 0);
+    }
+
     void test_array_split()
     {
         array<int> temp(5);
@@ -659,6 +690,7 @@ namespace
 
             DLIB_TEST(dlib::is_array<int>::value == false);
             test_array_split();
+            test_shrink_to_fit();
         }
     } a;
 
@@ -554,6 +554,86 @@ namespace
         COMPILE_TIME_ASSERT(is_array2d<float>::value == false);
     }
 
+    void test_buffer_reuse()
+    {
+        array2d<int> img;
+        img.set_size(100,200);
+        const int* const buf = &img[0][0];
+
+        // shrinking or reshaping within the existing buffer shouldn't reallocate
+        img.set_size(50,60);
+        DLIB_TEST(img.nr() == 50 && img.nc() == 60);
+        DLIB_TEST(&img[0][0] == buf);
+        img.set_size(200,100);
+        DLIB_TEST(img.nr() == 200 && img.nc() == 100);
+        DLIB_TEST(&img[0][0] == buf);
+        img.set_size(0,0);
+        DLIB_TEST(img.size() == 0);
+        DLIB_TEST(img.move_next() == false);
+        img.set_size(10,10);
+        DLIB_TEST(&img[0][0] == buf);
+
+        // make sure the enumerator sees exactly the in-use elements
+        for (long r = 0; r < img.nr(); ++r)
+            for (long c = 0; c < img.nc(); ++c)
+                img[r][c] = r*img.nc() + c;
+        img.reset();
+        int count = 0;
+        while (img.move_next())
+        {
+            DLIB_TEST(img.element() == count);
+            ++count;
+        }
+        DLIB_TEST(count == 100);
+
+        // shrink_to_fit should preserve the contents while giving back the
+        // extra memory.
+        img.shrink_to_fit();
+        DLIB_TEST(img.nr() == 10 && img.nc() == 10);
+        for (long r = 0; r < img.nr(); ++r)
+            for (long c = 0; c < img.nc(); ++c)
+                DLIB_TEST(img[r][c] == r*img.nc() + c);
+
+        // and shrink_to_fit on an emptied array frees everything
+        img.set_size(0,0);
+        img.shrink_to_fit();
+        DLIB_TEST(img.size() == 0);
+
+        // moved-from/moved-to state
+        array2d<int> img2;
+        img2.set_size(3,4);
+        img2[2][3] = 42;
+        array2d<int> img3(std::move(img2));
+        DLIB_TEST(img3.nr() == 3 && img3.nc() == 4);
+        DLIB_TEST(img3[2][3] == 42);
+        DLIB_TEST(img2.size() == 0);
+    }
+
+
+    void test_row_ptr (
+    )
+    {
+        array2d<int> img;
+        img.set_size(7,13);
+        for (long r = 0; r < img.nr(); ++r)
+            for (long c = 0; c < img.nc(); ++c)
+                img[r][c] = r*img.nc() + c;
+
+        const array2d<int>& cimg = img;
+        for (long r = 0; r < img.nr(); ++r)
+        {
+            DLIB_TEST(img.row_ptr(r) == &img[r][0]);
+            DLIB_TEST(cimg.row_ptr(r) == &cimg[r][0]);
+            for (long c = 0; c < img.nc(); ++c)
+                DLIB_TEST(img.row_ptr(r)[c] == img[r][c]);
+        }
+
+        // rows are contiguous so writes through row_ptr() land in the right spot
+        img.row_ptr(3)[5] = -1;
+        DLIB_TEST(img[3][5] == -1);
+    }
+
+// ----------------------------------------------------------------------------------------
 
     class array2d_tester : public tester
     {
@@ -572,6 +652,10 @@ namespace
             print_spinner();
             test_serialization();
             print_spinner();
+            test_buffer_reuse();
+            print_spinner();
+            test_row_ptr();
+            print_spinner();
         }
     } a;
 
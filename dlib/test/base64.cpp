@@ -5,6 +5,7 @@
 #include <string>
 #include <cstdlib>
 #include <ctime>
+#include <vector>
 #include <dlib/base64.h>
 
 #include "tester.h"
@@ -171,6 +172,56 @@ LCBleGNlZWRzIHRoZSBzaG9ydCB2ZWhlbWVuY2Ugb2YgYW55IGNhcm5hbCBwbGVhc3VyZS4=";
             }
 
 
+            // make sure the buffer based encode() and decode() produce exactly
+            // the same bytes as the stream versions for every line ending style
+            const typename base64::line_ending_type eol_styles[] = {
+                base64::CR, base64::LF, base64::CRLF };
+            for (int i = 0; i < 300; ++i)
+            {
+                // use all the small sizes plus a sampling of bigger ones
+                const int size = (i < 200) ? i : rand()%4000;
+                str.clear();
+                for (int j = 0; j < size; ++j)
+                {
+                    unsigned char ch = rand()&0xFF;
+                    str += ch;
+                }
+                const std::vector<char> data(str.begin(), str.end());
+
+                for (int e = 0; e < 3; ++e)
+                {
+                    test.set_line_ending(eol_styles[e]);
+
+                    sin.clear();
+                    sin.str(str);
+                    sout.str("");
+                    test.encode(sin,sout);
+
+                    std::vector<char> encoded;
+                    test.encode(data, encoded);
+                    DLIB_TEST_MSG(string(encoded.begin(), encoded.end()) == sout.str(),
+                        "size: " << size << "  eol style: " << e);
+
+                    std::vector<char> decoded;
+                    test.decode(encoded, decoded);
+                    DLIB_TEST(string(decoded.begin(), decoded.end()) == str);
+                }
+            }
+            test.set_line_ending(base64::LF);
+
+            // decoding a truncated buffer should throw just like the stream
+            // version does
+            {
+                const std::string junk = "QUJDRO";
+                const std::vector<char> encoded(junk.begin(), junk.end());
+                std::vector<char> decoded;
+                bool threw = false;
+                try { test.decode(encoded, decoded); }
+                catch (typename base64::decode_error&) { threw = true; }
+                DLIB_TEST(threw);
+            }
+
+
 
 
         }
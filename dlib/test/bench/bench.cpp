@@ -0,0 +1,351 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+/*
+    This program times the hot kernels the library's users depend on most and
+    emits the results in a machine readable form so builds can be gated on
+    throughput.  A typical workflow looks like:
+
+        ./dbench -o baseline.csv                   # record a baseline
+        ./dbench --baseline baseline.csv           # fail if anything got slower
+
+    The output is CSV with one row per benchmark:
+
+        name,iterations,total_seconds,mean_microseconds
+
+    When --baseline is given the program compares each benchmark's mean time
+    against the baseline file and returns a non-zero exit status if any of them
+    regressed by more than --tolerance percent (10% by default).
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dlib/array2d.h>
+#include <dlib/cmd_line_parser.h>
+#include <dlib/dnn.h>
+#include <dlib/image_transforms.h>
+#include <dlib/matrix.h>
+#include <dlib/pipe.h>
+#include <dlib/pixel.h>
+#include <dlib/rand.h>
+#include <dlib/serialize.h>
+#include <dlib/string.h>
+#include <dlib/threads.h>
+#include <dlib/timing.h>
+#include <dlib/vectorstream.h>
+
+using namespace dlib;
+using namespace std;
+
+// ----------------------------------------------------------------------------------------
+
+struct bench_result
+{
+    std::string name;
+    unsigned long iterations;
+    double total_seconds;
+    double mean_microseconds;
+};
+
+// ----------------------------------------------------------------------------------------
+
+template <typename funct>
+bench_result run_benchmark (
+    const char* name,
+    int slot,
+    funct&& f
+)
+/*!
+    ensures
+        - calls f() over and over, timing it with dlib::timing, until at least
+          half a second has been spent inside f() (and f() has run at least 3
+          times).  The first call is treated as a warm up and not counted.
+        - returns the accumulated timing statistics
+!*/
+{
+    // warm up the caches, page in the data, etc.
+    f();
+
+    unsigned long iterations = 0;
+    double elapsed = 0;
+    while (iterations < 3 || elapsed < 0.5)
+    {
+        timing::start(slot, name);
+        f();
+        timing::stop(slot);
+        ++iterations;
+        // time_buf() accumulates nanoseconds
+        elapsed = timing::time_buf()[slot]/1e9;
+    }
+
+    bench_result result;
+    result.name = name;
+    result.iterations = iterations;
+    result.total_seconds = elapsed;
+    result.mean_microseconds = elapsed/iterations*1e6;
+    return result;
+}
+
+// ----------------------------------------------------------------------------------------
+
+bench_result bench_default_matrix_multiply (
+)
+{
+    dlib::rand rnd;
+    matrix<double> a = randm(128,128,rnd);
+    matrix<double> b = randm(128,128,rnd);
+    matrix<double> dest(128,128);
+    dest = 0;
+
+    return run_benchmark("default_matrix_multiply", 1, [&]()
+    {
+        default_matrix_multiply(dest, a, b);
+    });
+}
+
+// ----------------------------------------------------------------------------------------
+
+bench_result bench_extract_fhog_features (
+)
+{
+    dlib::rand rnd;
+    array2d<unsigned char> img(256,256);
+    for (long r = 0; r < img.nr(); ++r)
+        for (long c = 0; c < img.nc(); ++c)
+            img[r][c] = rnd.get_random_8bit_number();
+
+    array2d<matrix<float,31,1> > hog;
+
+    return run_benchmark("extract_fhog_features", 2, [&]()
+    {
+        extract_fhog_features(img, hog);
+    });
+}
+
+// ----------------------------------------------------------------------------------------
+
+bench_result bench_pyramid_down (
+)
+{
+    dlib::rand rnd;
+    array2d<rgb_pixel> img(512,512);
+    for (long r = 0; r < img.nr(); ++r)
+    {
+        for (long c = 0; c < img.nc(); ++c)
+        {
+            img[r][c].red   = rnd.get_random_8bit_number();
+            img[r][c].green = rnd.get_random_8bit_number();
+            img[r][c].blue  = rnd.get_random_8bit_number();
+        }
+    }
+
+    pyramid_down<2> pyr;
+    array2d<rgb_pixel> down;
+
+    return run_benchmark("pyramid_down", 3, [&]()
+    {
+        pyr(img, down);
+    });
+}
+
+// ----------------------------------------------------------------------------------------
+
+bench_result bench_tensor_conv (
+)
+{
+    dlib::rand rnd;
+    resizable_tensor data(1,16,64,64);
+    resizable_tensor filters(16,16,3,3);
+    resizable_tensor output;
+    for (auto& x : data)
+        x = rnd.get_random_float();
+    for (auto& x : filters)
+        x = rnd.get_random_float();
+
+    tt::tensor_conv conv;
+    conv.setup(data, filters, 1, 1, 1, 1);
+
+    return run_benchmark("tensor_conv", 4, [&]()
+    {
+        conv(false, output, data, filters);
+    });
+}
+
+// ----------------------------------------------------------------------------------------
+
+bench_result bench_serialize_round_trip (
+)
+{
+    dlib::rand rnd;
+    matrix<double> m = randm(100,100,rnd);
+    std::vector<float> v(10000);
+    for (auto& x : v)
+        x = rnd.get_random_float();
+
+    std::vector<char> buf;
+
+    return run_benchmark("serialize_round_trip", 5, [&]()
+    {
+        buf.clear();
+        vectorstream stream(buf);
+        serialize(m, stream);
+        serialize(v, stream);
+
+        matrix<double> m2;
+        std::vector<float> v2;
+        deserialize(m2, stream);
+        deserialize(v2, stream);
+    });
+}
+
+// ----------------------------------------------------------------------------------------
+
+bench_result bench_pipe_throughput (
+)
+{
+    const unsigned long num_messages = 100000;
+    dlib::pipe<int> p(10000);
+
+    // One benchmark iteration pushes num_messages ints through the pipe to a
+    // consumer thread, so the mean time is the time to move 100k messages.
+    return run_benchmark("pipe_throughput_100k", 6, [&]()
+    {
+        thread_function consumer([&]()
+        {
+            int val;
+            for (unsigned long i = 0; i < num_messages; ++i)
+                p.dequeue(val);
+        });
+
+        for (unsigned long i = 0; i < num_messages; ++i)
+        {
+            int val = i;
+            p.enqueue(val);
+        }
+    });
+}
+
+// ----------------------------------------------------------------------------------------
+
+void write_results (
+    const std::vector<bench_result>& results,
+    std::ostream& out
+)
+{
+    out << "name,iterations,total_seconds,mean_microseconds\n";
+    for (auto& r : results)
+        out << r.name << "," << r.iterations << "," << r.total_seconds << "," << r.mean_microseconds << "\n";
+}
+
+// ----------------------------------------------------------------------------------------
+
+std::map<std::string,double> load_baseline (
+    const std::string& filename
+)
+/*!
+    ensures
+        - reads a CSV file written by write_results() and returns a map from
+          benchmark name to mean time in microseconds
+!*/
+{
+    std::ifstream fin(filename.c_str());
+    if (!fin)
+        throw error("unable to open baseline file " + filename);
+
+    std::map<std::string,double> baseline;
+    std::string line;
+    getline(fin, line); // discard the header
+    while (getline(fin, line))
+    {
+        const std::vector<std::string> fields = split(line, ",");
+        if (fields.size() != 4)
+            continue;
+        baseline[fields[0]] = string_cast<double>(fields[3]);
+    }
+    return baseline;
+}
+
+// ----------------------------------------------------------------------------------------
+
+int main (int argc, char** argv)
+{
+    try
+    {
+        command_line_parser parser;
+        parser.add_option("h","Display this help message.");
+        parser.add_option("o","Write the results to the given CSV <file> as well as standard output.",1);
+        parser.add_option("baseline","Compare against the CSV <file> written by a previous run and "
+                                     "return a non-zero exit status if anything regressed.",1);
+        parser.add_option("tolerance","Allow benchmarks to be <percent> percent slower than the "
+                                      "baseline before calling it a regression (default: 10).",1);
+
+        parser.parse(argc, argv);
+        parser.check_option_arg_range("tolerance", 0.0, 1000.0);
+
+        if (parser.option("h"))
+        {
+            cout << "Usage: dbench [options]\n";
+            parser.print_options();
+            return EXIT_SUCCESS;
+        }
+
+        std::vector<bench_result> results;
+        results.push_back(bench_default_matrix_multiply());
+        results.push_back(bench_extract_fhog_features());
+        results.push_back(bench_pyramid_down());
+        results.push_back(bench_tensor_conv());
+        results.push_back(bench_serialize_round_trip());
+        results.push_back(bench_pipe_throughput());
+
+        write_results(results, cout);
+        if (parser.option("o"))
+        {
+            std::ofstream fout(parser.option("o").argument().c_str());
+            write_results(results, fout);
+        }
+
+        int exit_status = EXIT_SUCCESS;
+        if (parser.option("baseline"))
+        {
+            const double tolerance = get_option(parser, "tolerance", 10.0);
+            const std::map<std::string,double> baseline = load_baseline(parser.option("baseline").argument());
+
+            cout << "\nComparison against " << parser.option("baseline").argument()
+                 << " (tolerance " << tolerance << "%):\n";
+            for (auto& r : results)
+            {
+                const auto i = baseline.find(r.name);
+                if (i == baseline.end())
+                {
+                    cout << "  " << r.name << ": not in baseline\n";
+                    continue;
+                }
+
+                const double change = (r.mean_microseconds - i->second)/i->second*100;
+                if (change > tolerance)
+                {
+                    cout << "  " << r.name << ": REGRESSED, " << change << "% slower\n";
+                    exit_status = EXIT_FAILURE;
+                }
+                else
+                {
+                    cout << "  " << r.name << ": ok, " << change << "% change\n";
+                }
+            }
+        }
+
+        return exit_status;
+    }
+    catch (exception& e)
+    {
+        cerr << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+}
+
+// ----------------------------------------------------------------------------------------
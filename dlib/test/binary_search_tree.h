@@ -8,6 +8,7 @@
 #include <string>
 #include <cstdlib>
 #include <ctime>
+#include <vector>
 
 #include <dlib/memory_manager_global.h>
 #include <dlib/memory_manager_stateless.h>
@@ -878,6 +879,107 @@ namespace
         }
 
 
+        // test the add_sorted() and lookup() functions
+        {
+            const unsigned long sizes[] = {0, 1, 2, 3, 15, 16, 17, 100, 256, 1000};
+            for (unsigned long s = 0; s < sizeof(sizes)/sizeof(sizes[0]); ++s)
+            {
+                const unsigned long num = sizes[s];
+
+                std::vector<int> d(num), r(num);
+                for (unsigned long i = 0; i < num; ++i)
+                {
+                    d[i] = static_cast<int>(i);
+                    r[i] = static_cast<int>(i)+1;
+                }
+
+                test.clear();
+                test.add_sorted(d,r);
+                DLIB_TEST(test.size() == num);
+                DLIB_TEST(test.at_start() == true);
+
+                // bulk loading an empty tree should produce a perfectly balanced
+                // tree, i.e. one of height floor(log2(num))+1
+                short expected_height = 0;
+                while ((1ul << expected_height) <= num)
+                    ++expected_height;
+                DLIB_TEST_MSG(test.height() == expected_height,
+                              "num: " << num << "  height: " << test.height());
+
+                // make sure enumeration gives everything back in sorted order
+                int expected = 0;
+                test.reset();
+                while (test.move_next())
+                {
+                    DLIB_TEST(test.element().key() == expected);
+                    DLIB_TEST(test.element().value() == expected+1);
+                    ++expected;
+                }
+                DLIB_TEST(expected == static_cast<int>(num));
+
+                // check that lookup() agrees with operator[].  Note that the last
+                // query isn't present in the tree.
+                std::vector<int> q(num+1);
+                for (unsigned long i = 0; i < q.size(); ++i)
+                    q[i] = static_cast<int>(i);
+                std::vector<const int*> results;
+                test.lookup(q,results);
+                DLIB_TEST(results.size() == q.size());
+                for (unsigned long i = 0; i < num; ++i)
+                {
+                    DLIB_TEST(results[i] != 0);
+                    DLIB_TEST(*results[i] == static_cast<int>(i)+1);
+                    DLIB_TEST(results[i] == test[static_cast<int>(i)]);
+                }
+                DLIB_TEST(results[num] == 0);
+
+                // calling add_sorted() on a non-empty tree should work just like
+                // repeated calls to add()
+                std::vector<int> d2(10), r2(10);
+                for (unsigned long i = 0; i < d2.size(); ++i)
+                {
+                    d2[i] = static_cast<int>(num+i);
+                    r2[i] = static_cast<int>(num+i)+1;
+                }
+                test.add_sorted(d2,r2);
+                DLIB_TEST(test.size() == num+10);
+                for (unsigned long i = 0; i < num+10; ++i)
+                    DLIB_TEST(test.count(static_cast<int>(i)) == 1);
+
+                // now pull everything back out to make sure the balancing metadata
+                // of the bulk loaded nodes is consistent with what remove expects
+                int a = 0, b = 0, last = -1;
+                unsigned long count = 0;
+                while (test.size() > 0)
+                {
+                    test.remove_any(a,b);
+                    DLIB_TEST(a > last);
+                    DLIB_TEST(b == a+1);
+                    last = a;
+                    ++count;
+                }
+                DLIB_TEST(count == num+10);
+                DLIB_TEST(test.height() == 0);
+            }
+
+            // also make sure bulk loading duplicate keys works
+            std::vector<int> d(100, 7), r(100, 8);
+            test.clear();
+            test.add_sorted(d,r);
+            DLIB_TEST(test.size() == 100);
+            DLIB_TEST(test.count(7) == 100);
+            int a = 0, b = 0;
+            while (test.size() > 0)
+            {
+                test.remove_any(a,b);
+                DLIB_TEST(a == 7);
+                DLIB_TEST(b == 8);
+            }
+
+            test.clear();
+        }
+
+
         test.clear();
         test2.clear();
 
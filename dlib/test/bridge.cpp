@@ -220,6 +220,112 @@ namespace
         dlib::sleep(100);
     }
 
+    const std::string testing_shm_name = "dlib_test_bridge";
+
+    void do_test_shm1()
+    {
+        dlib::pipe<int> in(0), out(0);
+
+        bridge b1(connect_to_shared_memory(testing_shm_name), receive(in));
+        bridge b2(listen_on_shared_memory(testing_shm_name), transmit(out));
+
+        for (int i = 0; i < 100; ++i)
+        {
+            int val = i;
+            out.enqueue(val);
+            val = 0;
+            in.dequeue(val);
+            DLIB_TEST(val == i);
+        }
+    }
+
+    void do_test_shm2()
+    {
+        dlib::pipe<int> in(10), out(10), echo_pipe(10);
+
+        bridge b2(listen_on_shared_memory(testing_shm_name), transmit(out), receive(in));
+        bridge echo(connect_to_shared_memory(testing_shm_name), receive(echo_pipe), transmit(echo_pipe));
+
+        for (int i = 0; i < 100; ++i)
+        {
+            int val = i;
+            out.enqueue(val);
+            val = 0;
+            in.dequeue(val);
+            DLIB_TEST(val == i);
+        }
+    }
+
+    void do_test_shm3()
+    {
+        // strings aren't trivially copyable so this exercises the serialization
+        // code path over the shared memory ring.
+        dlib::pipe<std::string> in(0), out(0);
+
+        bridge b1(connect_to_shared_memory(testing_shm_name), receive(in));
+        bridge b2(listen_on_shared_memory(testing_shm_name), transmit(out));
+
+        for (int i = 0; i < 100; ++i)
+        {
+            std::string val = "message number " + cast_to_string(i);
+            std::string temp = val;
+            out.enqueue(temp);
+            temp.clear();
+            in.dequeue(temp);
+            DLIB_TEST(temp == val);
+        }
+
+        // also push something bigger than the ring buffer to make sure large
+        // messages get chopped up and reassembled correctly.
+        std::string big(3*1024*1024, 'x');
+        std::string temp = big;
+        out.enqueue(temp);
+        temp.clear();
+        in.dequeue(temp);
+        DLIB_TEST(temp == big);
+    }
+
+    void do_test_shm4()
+    {
+        typedef type_safe_union<int, bridge_status> tsu_type;
+
+        // Note that both ends of a shared memory bridge have to use pipes holding
+        // the same type, so the transmit pipe is also a tsu_type pipe here.
+        dlib::pipe<tsu_type> in(10);
+        dlib::pipe<tsu_type> out(10);
+
+        bridge b1(connect_to_shared_memory(testing_shm_name), receive(in));
+        bridge b2(listen_on_shared_memory(testing_shm_name), transmit(out));
+
+        tsu_type msg;
+        in.dequeue(msg);
+        DLIB_TEST(msg.contains<bridge_status>() == true);
+        DLIB_TEST(msg.get<bridge_status>().is_connected == true);
+        DLIB_TEST(msg.get<bridge_status>().foreign_ip == "shm://" + testing_shm_name);
+        DLIB_TEST(msg.get<bridge_status>().foreign_port == 0);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            msg = i;
+            out.enqueue(msg);
+
+            in.dequeue(msg);
+            DLIB_TEST(msg.contains<int>() == true);
+            DLIB_TEST(msg.get<int>() == i);
+        }
+
+        // b2 must have noticed the connection by now since it has been transmitting
+        // over it.
+        bridge_status bs = b2.get_bridge_status();
+        DLIB_TEST(bs.is_connected == true);
+        DLIB_TEST(bs.foreign_ip == "shm://" + testing_shm_name);
+
+        b2.clear();
+        in.dequeue(msg);
+        DLIB_TEST(msg.contains<bridge_status>() == true);
+        DLIB_TEST(msg.get<bridge_status>().is_connected == false);
+    }
+
     class test_bridge : public tester
     {
     public:
@@ -248,6 +354,14 @@ namespace
             do_test5_5(1);
             print_spinner();
             do_test6();
+            print_spinner();
+            do_test_shm1();
+            print_spinner();
+            do_test_shm2();
+            print_spinner();
+            do_test_shm3();
+            print_spinner();
+            do_test_shm4();
         }
     } a;
 
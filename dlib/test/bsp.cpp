@@ -533,6 +533,218 @@ namespace
         }
         DLIB_TEST(error_occurred == false);
     }
+// ----------------------------------------------------------------------------------------
+
+    template <typename funct>
+    struct callfunct_persistent_helper
+    {
+        callfunct_persistent_helper (
+            funct f_,
+            int port_,
+            bool& error_occurred_
+        ) :f(f_), port(port_), error_occurred(error_occurred_) {}
+
+        funct f;
+        int port;
+        bool& error_occurred;
+
+        void operator() (
+        ) const
+        {
+            try
+            {
+                bsp_listen_persistent(port, f);
+            }
+            catch (exception& e)
+            {
+                dlog << LERROR << "error calling bsp_listen_persistent(): " << e.what();
+                error_occurred = true;
+            }
+        }
+    };
+
+    template <typename funct>
+    callfunct_persistent_helper<funct> callfunct_persistent(funct f, int port, bool& error_occurred)
+    {
+        return callfunct_persistent_helper<funct>(f,port,error_occurred);
+    }
+
+    void session_sum_driver (
+        bsp_context& obj,
+        const std::vector<int>& v,
+        int& result
+    )
+    {
+        obj.enable_message_batching();
+        obj.broadcast(v);
+
+        result = 0;
+        int val;
+        while(obj.try_receive(val))
+            result += val;
+    }
+
+    void session_sum_job (
+        bsp_context& obj
+    )
+    {
+        obj.enable_message_batching();
+
+        // Everything a worker receives is a vector<int>.  The driver sends the array
+        // to sum up while the other workers send single element pings.  Note that a
+        // ping from a fast worker can arrive before the driver's array does, so we
+        // have to dispatch on the sender.
+        int num_pings = 0;
+        bool got_array = false;
+        unsigned long sender;
+        std::vector<int> data;
+        while(obj.try_receive(data, sender))
+        {
+            if (sender == 0)
+            {
+                got_array = true;
+                int sum = 0;
+                for (unsigned long i = 0; i < data.size(); ++i)
+                    sum += data[i];
+
+                obj.send(sum, 0);
+                // Also ping the other workers so batched messages cross the
+                // worker-to-worker connections too.
+                const std::vector<int> ping(1, sum);
+                for (unsigned long i = 1; i < obj.number_of_nodes(); ++i)
+                {
+                    if (i != obj.node_id())
+                        obj.send(ping, i);
+                }
+            }
+            else
+            {
+                DLIB_TEST(data.size() == 1);
+                ++num_pings;
+            }
+        }
+        DLIB_TEST(got_array);
+        DLIB_TEST(num_pings == (int)obj.number_of_nodes()-2);
+    }
+
+    void dotest7()
+    {
+        dlog << LINFO << "start dotest7()";
+        print_spinner();
+        bool error_occurred = false;
+        {
+            thread_function t1(callfunct_persistent(session_sum_job, 12355, error_occurred));
+            thread_function t2(callfunct_persistent(session_sum_job, 12356, error_occurred));
+            thread_function t3(callfunct_persistent(session_sum_job, 12357, error_occurred));
+            std::vector<int> v;
+            int true_value = 0;
+            for (int i = 0; i < 10; ++i)
+            {
+                v.push_back(i);
+                true_value += i;
+            }
+
+            // wait a little bit for the threads to start up
+            dlib::sleep(200);
+
+            try
+            {
+                std::vector<network_address> hosts;
+                hosts.push_back("127.0.0.1:12355");
+                hosts.push_back("127.0.0.1:12356");
+                hosts.push_back("127.0.0.1:12357");
+                bsp_session session(hosts);
+                DLIB_TEST(session.number_of_nodes() == 4);
+
+                // run several jobs back to back over the same connections
+                for (int i = 0; i < 3; ++i)
+                {
+                    int result = 0;
+                    session.run(session_sum_driver, dlib::ref(v), dlib::ref(result));
+
+                    dlog << LINFO << "job " << i << " result: "<< result;
+                    DLIB_TEST(result == 3*true_value);
+                }
+            }
+            catch (std::exception& e)
+            {
+                dlog << LERROR << "error during bsp_session: " << e.what();
+                DLIB_TEST(false);
+            }
+        }
+        DLIB_TEST(error_occurred == false);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void work_queue_driver (
+        bsp_context& obj,
+        long& result
+    )
+    {
+        bsp_work_queue_master(obj, 0, 1000);
+
+        // collect each worker's partial sum
+        result = 0;
+        long partial;
+        for (unsigned long i = 1; i < obj.number_of_nodes(); ++i)
+        {
+            obj.receive(partial);
+            result += partial;
+        }
+    }
+
+    void work_queue_worker_job (
+        bsp_context& obj
+    )
+    {
+        long sum = 0;
+        bsp_work_queue_worker(obj, 0, [&](long b, long e)
+        {
+            for (long i = b; i < e; ++i)
+                sum += i;
+            // make one node slower so the rate weighted chunk sizing gets exercised
+            if (obj.node_id() == 1)
+                dlib::sleep(1);
+        });
+        obj.send(sum, 0);
+    }
+
+    void dotest8()
+    {
+        dlog << LINFO << "start dotest8()";
+        print_spinner();
+        bool error_occurred = false;
+        {
+            thread_function t1(callfunct(work_queue_worker_job, 12345, error_occurred));
+            thread_function t2(callfunct(work_queue_worker_job, 12346, error_occurred));
+            thread_function t3(callfunct(work_queue_worker_job, 12347, error_occurred));
+
+            // wait a little bit for the threads to start up
+            dlib::sleep(200);
+
+            try
+            {
+                long result;
+                std::vector<network_address> hosts;
+                hosts.push_back("127.0.0.1:12345");
+                hosts.push_back("127.0.0.1:12346");
+                hosts.push_back("127.0.0.1:12347");
+                bsp_connect(hosts, work_queue_driver, dlib::ref(result));
+
+                dlog << LINFO << "work queue result: "<< result;
+                // every item in [0,1000) must have been handed out exactly once
+                DLIB_TEST(result == 999*1000/2);
+            }
+            catch (std::exception& e)
+            {
+                dlog << LERROR << "error during bsp_context: " << e.what();
+                DLIB_TEST(false);
+            }
+        }
+        DLIB_TEST(error_occurred == false);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     class bsp_tester : public tester
@@ -558,6 +770,8 @@ namespace
                 dotest4();
                 dotest5();
                 dotest6();
+                dotest7();
+                dotest8();
             }
         }
     } a;
@@ -4,6 +4,7 @@
 #include <dlib/statistics.h>
 #include <dlib/sparse_vector.h>
 #include <dlib/timing.h>
+#include <cstdio>
 #include <map>
 
 #include "tester.h"
@@ -373,6 +374,94 @@ namespace
         test_svd_fast(1, 2, 1);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_svd_fast_ondisk(
+        long rank,
+        long m,
+        long n
+    )
+    {
+        print_spinner();
+        matrix<double> A = randm(m,rank,rnd)*randm(rank,n,rnd);
+        typedef std::map<unsigned long,double> sparse_vec;
+        const std::vector<sparse_vec> rows = mat_to_sparse(A);
+
+        dlog << LINFO << "ondisk rank: "<< rank;
+        dlog << LINFO << "ondisk m: "<< m;
+        dlog << LINFO << "ondisk n: "<< n;
+
+        const std::string filename = "svd_fast_ondisk_test.dat";
+        {
+            sparse_matrix_file_writer<sparse_vec> writer(filename);
+            for (auto& row : rows)
+                writer.add_row(row);
+            DLIB_TEST(writer.size() == rows.size());
+            writer.close();
+        }
+
+        sparse_matrix_file_reader<sparse_vec> reader(filename);
+        DLIB_TEST(reader.nr() == (unsigned long)m);
+        DLIB_TEST(reader.nc() == (unsigned long)n);
+
+        // Make sure reading the rows back in small blocks reproduces the matrix we
+        // wrote out.
+        std::vector<sparse_vec> block;
+        unsigned long num = 0;
+        while (reader.read_block(block, 3))
+        {
+            for (auto& row : block)
+            {
+                DLIB_TEST(num < rows.size());
+                DLIB_TEST(row == rows[num]);
+                ++num;
+            }
+        }
+        DLIB_TEST(num == rows.size());
+
+        matrix<double> u,v;
+        matrix<double,0,1> w;
+        // Use a tiny block size so even these little test matrices get streamed in
+        // multiple blocks.
+        svd_fast(reader, u, w, v, rank, 2, 3);
+        DLIB_TEST(u.nr() == m);
+        DLIB_TEST(u.nc() == rank);
+        DLIB_TEST(w.nr() == rank);
+        DLIB_TEST(w.nc() == 1);
+        DLIB_TEST(v.nr() == n);
+        DLIB_TEST(v.nc() == rank);
+        DLIB_TEST(max(abs(trans(u)*u - identity_matrix<double>(u.nc()))) < 1e-13);
+        DLIB_TEST(max(abs(trans(v)*v - identity_matrix<double>(u.nc()))) < 1e-13);
+        DLIB_TEST(max(abs(tmp(A - u*diagm(w)*trans(v)))) < 1e-12);
+
+        // The version that doesn't compute u should give the same singular values.
+        matrix<double> v2;
+        matrix<double,0,1> w2;
+        svd_fast(reader, w2, v2, rank, 2, 3);
+        DLIB_TEST(w2.nr() == rank);
+        DLIB_TEST(v2.nr() == n);
+        DLIB_TEST(v2.nc() == rank);
+        DLIB_TEST(max(abs(trans(v2)*v2 - identity_matrix<double>(v2.nc()))) < 1e-13);
+        DLIB_TEST(max(abs(w - w2)) < 1e-12);
+
+        std::remove(filename.c_str());
+    }
+
+    void test_svd_fast_ondisk()
+    {
+        for (int iter = 0; iter < 10; ++iter)
+        {
+            const unsigned long rank = rnd.get_random_32bit_number()%10 + 1;
+            const unsigned long m = rank + rnd.get_random_32bit_number()%10;
+            const unsigned long n = rank + rnd.get_random_32bit_number()%10;
+
+            test_svd_fast_ondisk(rank, m, n);
+        }
+        test_svd_fast_ondisk(1, 1, 1);
+        test_svd_fast_ondisk(1, 2, 2);
+        test_svd_fast_ondisk(1, 2, 1);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     /*
@@ -448,6 +537,7 @@ namespace
                 test_cca3();
             }
             test_svd_fast();
+            test_svd_fast_ondisk();
         }
     } a;
 
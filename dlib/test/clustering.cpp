@@ -2,6 +2,8 @@
 // License: Boost Software License   See LICENSE.txt for the full license.
 
 #include <dlib/clustering.h>
+#include <map>
+#include <set>
 
 #include "tester.h"
 
@@ -220,6 +222,44 @@ namespace
         }
     }
 
+    void test_chinese_whispers_threaded(dlib::rand& rnd)
+    {
+        print_spinner();
+        std::vector<sample_pair> edges;
+        std::vector<unsigned long> labels;
+
+        make_test_graph(rnd, edges, labels, 5, 30, 3, 0.10);
+        if (rnd.get_random_double() < 0.5)
+            remove_duplicate_edges(edges);
+
+
+        std::vector<unsigned long> labels2;
+
+        unsigned long num_clusters;
+        if (rnd.get_random_double() < 0.5)
+            num_clusters = chinese_whispers_threaded(edges, labels2, 200, rnd);
+        else
+            num_clusters = chinese_whispers_threaded(edges, labels2);
+
+        DLIB_TEST(labels.size() == labels2.size());
+        DLIB_TEST(num_clusters == 5);
+
+        for (unsigned long i = 0; i < labels.size(); ++i)
+        {
+            for (unsigned long j = 0; j < labels.size(); ++j)
+            {
+                if (labels[i] == labels[j])
+                {
+                    DLIB_TEST(labels2[i] == labels2[j]);
+                }
+                else
+                {
+                    DLIB_TEST(labels2[i] != labels2[j]);
+                }
+            }
+        }
+    }
+
     void test_bottom_up_clustering()
     {
         std::vector<dpoint> pts;
@@ -340,6 +380,68 @@ namespace
         DLIB_TEST(-2 <= r[0].lower && r[0].lower < r[0].upper && r[0].upper <= 1);
     }
 
+    void test_approximate_spectral_cluster()
+    {
+        print_spinner();
+        dlib::rand rnd;
+
+        // three well separated gaussian blobs
+        typedef matrix<double,2,1> sample_type;
+        std::vector<sample_type> samples;
+        std::vector<unsigned long> truth;
+        const double centers_x[] = {0, 8, 0};
+        const double centers_y[] = {0, 0, 8};
+        for (int i = 0; i < 600; ++i)
+        {
+            const int g = i%3;
+            sample_type s;
+            s = centers_x[g]+rnd.get_random_gaussian(), centers_y[g]+rnd.get_random_gaussian();
+            samples.push_back(s);
+            truth.push_back(g);
+        }
+
+        typedef radial_basis_kernel<sample_type> kernel_type;
+        const std::vector<unsigned long> approx = spectral_cluster(kernel_type(0.1), samples, 3, 60);
+        DLIB_TEST(approx.size() == samples.size());
+
+        // the clustering should match the ground truth up to a relabeling
+        std::map<unsigned long,std::map<unsigned long,unsigned long> > votes;
+        for (unsigned long i = 0; i < approx.size(); ++i)
+        {
+            DLIB_TEST(approx[i] < 3);
+            votes[approx[i]][truth[i]]++;
+        }
+        unsigned long num_right = 0;
+        std::set<unsigned long> used;
+        for (auto& v : votes)
+        {
+            unsigned long best_label = 0, best_count = 0;
+            for (auto& t : v.second)
+            {
+                if (t.second > best_count)
+                {
+                    best_count = t.second;
+                    best_label = t.first;
+                }
+            }
+            // each output cluster should map to a distinct true blob
+            DLIB_TEST(used.insert(best_label).second);
+            num_right += best_count;
+        }
+        dlog << LINFO << "approximate spectral_cluster accuracy: " << num_right/(double)samples.size();
+        DLIB_TEST(num_right >= samples.size()*95/100);
+
+        // asking for more basis samples than there are samples must give the exact results
+        const std::vector<unsigned long> exact = spectral_cluster(kernel_type(0.1), samples, 3);
+        DLIB_TEST(spectral_cluster(kernel_type(0.1), samples, 3, samples.size()+10) == exact);
+
+        // degenerate case: one cluster
+        const std::vector<unsigned long> one = spectral_cluster(kernel_type(0.1), samples, 1, 60);
+        DLIB_TEST(one == std::vector<unsigned long>(samples.size(), 0));
+    }
+
+// ----------------------------------------------------------------------------------------
+
     class test_clustering : public tester
     {
     public:
@@ -354,6 +456,7 @@ namespace
         {
             test_bottom_up_clustering();
             test_segment_number_line();
+            test_approximate_spectral_cluster();
 
             dlib::rand rnd;
 
@@ -398,6 +501,14 @@ namespace
             for (int i = 0; i < 10; ++i)
                 test_chinese_whispers(rnd);
 
+            DLIB_TEST(chinese_whispers_threaded(edges, labels) == 2);
+            DLIB_TEST(labels.size() == 2);
+            edges.clear();
+            DLIB_TEST(chinese_whispers_threaded(edges, labels) == 0);
+
+            for (int i = 0; i < 10; ++i)
+                test_chinese_whispers_threaded(rnd);
+
 
         }
     } a;
@@ -6,6 +6,7 @@
 #include <string>
 #include <ctime>
 #include <cstdlib>
+#include <vector>
 
 #include <dlib/compress_stream.h>
 
@@ -255,6 +256,63 @@ namespace
 
         dlog << LTRACE << 4;
 
+        // test the vector versions of compress() and decompress()
+        {
+            print_spinner();
+
+            std::vector<char> buffer;
+            buffer.reserve(30000);
+            // use enough data to cross the 20000 symbol marker boundary
+            for (int i = 0; i < 30000; ++i)
+                buffer.push_back(static_cast<char>(::rand()&0x3f));
+
+            std::vector<char> compressed, decompressed;
+            test.compress(buffer, compressed);
+
+            print_spinner();
+
+            // the vector version must produce exactly the same bytes as the
+            // stream version
+            istringstream sin;
+            ostringstream sout;
+            sin.str(string(buffer.begin(), buffer.end()));
+            test.compress(sin,sout);
+            DLIB_TEST(sout.str() == string(compressed.begin(), compressed.end()));
+
+            test.decompress(compressed, decompressed);
+            DLIB_TEST(decompressed == buffer);
+
+            print_spinner();
+
+            // make sure trailing junk after the compressed block is ignored
+            compressed.push_back('x');
+            compressed.push_back('y');
+            decompressed.clear();
+            test.decompress(compressed, decompressed);
+            DLIB_TEST(decompressed == buffer);
+
+            // make sure corruption is detected
+            compressed[compressed.size()/2]++;
+            bool detected_error = false;
+            try {
+                test.decompress(compressed, decompressed);
+            } catch ( typename cs::decompression_error& )
+            {
+                detected_error = true;
+            }
+            DLIB_TEST(detected_error || decompressed == buffer);
+
+            // make sure the empty vector round trips
+            buffer.clear();
+            test.compress(buffer, compressed);
+            test.decompress(compressed, decompressed);
+            DLIB_TEST(decompressed.size() == 0);
+
+            print_spinner();
+        }
+
+        dlog << LTRACE << 5;
+
     }
 
 
@@ -295,6 +353,8 @@ namespace
             compress_stream_kernel_test<compress_stream::kernel_1ec>(seed);
             dlog << LINFO << "testing kernel_2a";
             compress_stream_kernel_test<compress_stream::kernel_2a>(seed);
+            dlog << LINFO << "testing kernel_2b";
+            compress_stream_kernel_test<compress_stream::kernel_2b>(seed);
             dlog << LINFO << "testing kernel_3a";
             compress_stream_kernel_test<compress_stream::kernel_3a>(seed);
             dlog << LINFO << "testing kernel_3b";
@@ -0,0 +1,185 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+
+#include <dlib/concurrent_hash_map.h>
+#include <dlib/threads.h>
+#include "tester.h"
+
+namespace
+{
+
+    using namespace test;
+    using namespace std;
+    using namespace dlib;
+
+    logger dlog("test.concurrent_hash_map");
+
+    template <
+        typename chm
+        >
+    void concurrent_hash_map_kernel_test (
+    )
+    /*!
+        requires
+            - chm is an implementation of
+              concurrent_hash_map/concurrent_hash_map_kernel_abstract.h and is
+              instantiated to map int to int
+        ensures
+            - runs tests on chm for compliance with the specs
+    !*/
+    {
+        print_spinner();
+
+        chm test, test2;
+
+        DLIB_TEST(test.size() == 0);
+        DLIB_TEST(test.is_in_domain(5) == false);
+
+        int d, r;
+        for (int i = 0; i < 1000; ++i)
+        {
+            d = i;
+            r = i*2;
+            test.add(d,r);
+        }
+        DLIB_TEST(test.size() == 1000);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            DLIB_TEST(test.is_in_domain(i));
+            r = -1;
+            DLIB_TEST(test.try_get(i,r));
+            DLIB_TEST(r == i*2);
+        }
+        DLIB_TEST(test.is_in_domain(1000) == false);
+        r = -1;
+        DLIB_TEST(test.try_get(1000,r) == false);
+        DLIB_TEST(r == -1);
+
+        // adding an existing key replaces its value
+        d = 10;
+        r = 123;
+        test.add(d,r);
+        DLIB_TEST(test.size() == 1000);
+        DLIB_TEST(test.try_get(10,r) && r == 123);
+
+        int d_copy;
+        DLIB_TEST(test.remove(10, d_copy, r));
+        DLIB_TEST(d_copy == 10);
+        DLIB_TEST(r == 123);
+        DLIB_TEST(test.size() == 999);
+        DLIB_TEST(test.remove(10, d_copy, r) == false);
+
+        DLIB_TEST(test.destroy(11));
+        DLIB_TEST(test.destroy(11) == false);
+        DLIB_TEST(test.size() == 998);
+
+        // test serialization
+        ostringstream sout;
+        serialize(test, sout);
+        istringstream sin(sout.str());
+        deserialize(test2, sin);
+        DLIB_TEST(test2.size() == test.size());
+        for (int i = 0; i < 1000; ++i)
+        {
+            DLIB_TEST(test2.is_in_domain(i) == test.is_in_domain(i));
+            int r1 = -1, r2 = -1;
+            if (test.try_get(i,r1))
+            {
+                DLIB_TEST(test2.try_get(i,r2));
+                DLIB_TEST(r1 == r2);
+            }
+        }
+
+        test.clear();
+        DLIB_TEST(test.size() == 0);
+        DLIB_TEST(test.is_in_domain(5) == false);
+
+        swap(test, test2);
+        DLIB_TEST(test.size() == 998);
+        DLIB_TEST(test2.size() == 0);
+
+        print_spinner();
+
+        // Now hammer the map from a bunch of threads at once.  Each thread owns a
+        // disjoint slice of the key space, so at the end we can check every key
+        // exactly, while lookups deliberately range over all keys to mix readers and
+        // writers on the same shards.
+        test.clear();
+        const int num_threads = 4;
+        const int keys_per_thread = 2000;
+        dlib::mutex count_mutex;
+        int num_failures = 0;
+        auto thread_proc = [&](long thread_idx)
+        {
+            bool failed = false;
+            const int offset = thread_idx*keys_per_thread;
+            for (int i = 0; i < keys_per_thread; ++i)
+            {
+                int dd = offset + i;
+                int rr = dd*3;
+                test.add(dd,rr);
+
+                // read back some key that may belong to any thread
+                int temp;
+                const int probe = (dd*7919)%(num_threads*keys_per_thread);
+                if (test.try_get(probe, temp) && temp != probe*3)
+                    failed = true;
+            }
+            // remove and re-add a few of our own keys
+            for (int i = 0; i < keys_per_thread; i += 10)
+            {
+                int dd = offset + i;
+                int dd_copy, rr;
+                if (!test.remove(dd, dd_copy, rr) || rr != dd*3)
+                    failed = true;
+                dd_copy = dd;
+                rr = dd*3;
+                test.add(dd_copy,rr);
+            }
+            if (failed)
+            {
+                auto_mutex lock(count_mutex);
+                ++num_failures;
+            }
+        };
+
+        thread_pool tp(num_threads);
+        for (long i = 0; i < num_threads; ++i)
+            tp.add_task_by_value([&thread_proc,i](){ thread_proc(i); });
+        tp.wait_for_all_tasks();
+
+        DLIB_TEST(num_failures == 0);
+        DLIB_TEST(test.size() == (size_t)(num_threads*keys_per_thread));
+        for (int i = 0; i < num_threads*keys_per_thread; ++i)
+        {
+            DLIB_TEST(test.try_get(i,r));
+            DLIB_TEST(r == i*3);
+        }
+    }
+
+
+    class concurrent_hash_map_tester : public tester
+    {
+    public:
+        concurrent_hash_map_tester (
+        ) :
+            tester ("test_concurrent_hash_map",
+                    "Runs tests on the concurrent_hash_map component.")
+        {}
+
+        void perform_test (
+        )
+        {
+            dlog << LINFO << "testing kernel_1a";
+            concurrent_hash_map_kernel_test<concurrent_hash_map<int,int,4>::kernel_1a>();
+        }
+    } a;
+
+}
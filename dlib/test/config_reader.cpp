@@ -2,6 +2,7 @@
 // License: Boost Software License   See LICENSE.txt for the full license.
 
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <cstdlib>
@@ -392,6 +393,101 @@ namespace
     }
 
 
+    void compare_config_readers (
+        const config_reader& a,
+        const config_reader& b
+    )
+    {
+        std_vector_c<string> keys_a, keys_b, blocks_a, blocks_b;
+        a.get_keys(keys_a);
+        b.get_keys(keys_b);
+        sort(keys_a.begin(), keys_a.end());
+        sort(keys_b.begin(), keys_b.end());
+        DLIB_TEST(keys_a == keys_b);
+        for (unsigned long i = 0; i < keys_a.size(); ++i)
+            DLIB_TEST_MSG(a[keys_a[i]] == b[keys_a[i]],
+                          "key: " << keys_a[i] << " '" << a[keys_a[i]] << "' vs '" << b[keys_a[i]] << "'");
+
+        a.get_blocks(blocks_a);
+        b.get_blocks(blocks_b);
+        sort(blocks_a.begin(), blocks_a.end());
+        sort(blocks_b.begin(), blocks_b.end());
+        DLIB_TEST(blocks_a == blocks_b);
+        for (unsigned long i = 0; i < blocks_a.size(); ++i)
+            compare_config_readers(a.block(blocks_a[i]), b.block(blocks_a[i]));
+    }
+
+    void test_load_from_buffer()
+    {
+        ostringstream sout;
+        sout << "all#comment { { } \n";
+        sout << "{ \n";
+        sout << "    block1 \n";
+        sout << "    { \n";
+        sout << "        name = davis king \n";
+        sout << "        age = 24 \n";
+        sout << "    } \n";
+        sout << "    block4{  # comment";
+        sout << "     \n";
+        sout << "        name = dude \n";
+        sout << "        age = 53}\n";
+        sout << "} \n";
+        sout << "global=hmm#comment \n";
+        sout << "global2=hmm2 \n";
+        sout << "escaped = a \\# b \\} c \\ d\\e \n";
+        sout << "empty = \n";
+        sout << "trailing = stuff   \t  \n";
+        sout << " # comment \n";
+        const string data = sout.str();
+
+        config_reader cr_stream, cr_buffer;
+        istringstream sin(data);
+        cr_stream.load_from(sin);
+        cr_buffer.load_from_buffer(data);
+        compare_config_readers(cr_stream, cr_buffer);
+        DLIB_TEST(cr_buffer["escaped"] == "a # b } c \\ d\\e");
+        DLIB_TEST(cr_buffer["empty"] == "");
+        DLIB_TEST(cr_buffer["trailing"] == "stuff");
+
+        // both parsers should reject the same bad inputs with the same line numbers
+        const char* bad_data[] = {
+            "a = 1 \nb { \n c = 2 \n",      // unterminated block
+            "a = 1 \n} \n",                 // stray closing brace
+            "a = 1 \na = 2 \n",             // redefined key
+            "a = 1 \n5up = 2 \n"            // identifier starting with a number
+        };
+        for (unsigned long i = 0; i < sizeof(bad_data)/sizeof(bad_data[0]); ++i)
+        {
+            unsigned long line_stream = 0, line_buffer = 0;
+            bool redef_stream = false, redef_buffer = false;
+            try
+            {
+                istringstream bad_sin(bad_data[i]);
+                cr_stream.load_from(bad_sin);
+                DLIB_TEST(false);
+            }
+            catch (config_reader::config_reader_error& e)
+            {
+                line_stream = e.line_number;
+                redef_stream = e.redefinition;
+            }
+            try
+            {
+                cr_buffer.load_from_buffer(string(bad_data[i]));
+                DLIB_TEST(false);
+            }
+            catch (config_reader::config_reader_error& e)
+            {
+                line_buffer = e.line_number;
+                redef_buffer = e.redefinition;
+            }
+            DLIB_TEST_MSG(line_stream == line_buffer,
+                          "case " << i << ": " << line_stream << " vs " << line_buffer);
+            DLIB_TEST(redef_stream == redef_buffer);
+        }
+    }
+
+
     void test_get_option()
     {
         const char* argv[100];            
@@ -498,6 +594,10 @@ namespace
             print_spinner();
             config_reader_test<config_reader_thread_safe>();
 
+            dlog << LINFO << "testing load_from_buffer()";
+            print_spinner();
+            test_load_from_buffer();
+
             dlog << LINFO << "testing get_option()";
             print_spinner();
             test_get_option();
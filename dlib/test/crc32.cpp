@@ -8,6 +8,7 @@
 #include <ctime>
 #include <cmath>
 #include <dlib/crc32.h>
+#include <dlib/rand.h>
 
 #include "tester.h"
 
@@ -66,6 +67,26 @@ namespace
             for (int i = 0; i < 4000; ++i)
                 buf.push_back(i);
             DLIB_TEST(crc32(buf) == 492662731);
+
+            // Make sure the bulk add() agrees with feeding the same bytes through
+            // the byte at a time add() for a bunch of lengths and offsets, since
+            // they take different code paths.
+            dlib::rand rnd;
+            std::vector<char> data;
+            for (int i = 0; i < 300; ++i)
+                data.push_back(static_cast<char>(rnd.get_random_8bit_number()));
+            for (unsigned long off = 0; off < 9; ++off)
+            {
+                for (unsigned long len = 0; off+len <= data.size(); len += (len < 40 ? 1 : 37))
+                {
+                    crc32 bulk, bytewise;
+                    bulk.add(&data[0]+off, len);
+                    for (unsigned long i = 0; i < len; ++i)
+                        bytewise.add(static_cast<unsigned char>(data[off+i]));
+                    DLIB_TEST_MSG(bulk.get_checksum() == bytewise.get_checksum(),
+                        "off: " << off << "  len: " << len);
+                }
+            }
         }
     } a;
 
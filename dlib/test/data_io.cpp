@@ -5,7 +5,13 @@
 #include <dlib/svm_threaded.h>
 #include <dlib/data_io.h>
 #include <dlib/sparse_vector.h>
+#include <dlib/xml_parser.h>
+#include <dlib/array.h>
+#include <dlib/array2d.h>
+#include <dlib/image_io.h>
 #include "create_iris_datafile.h"
+#include <algorithm>
+#include <cstdio>
 #include <vector>
 #include <sstream>
 
@@ -16,6 +22,63 @@ namespace
     using namespace std;
     dlib::logger dlog("test.data_io");
 
+// ----------------------------------------------------------------------------------------
+
+    class xml_event_recorder : public document_handler
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object writes every event the xml_parser generates into a log
+                string so a test can check the whole event stream at once.
+        !*/
+    public:
+        std::ostringstream log;
+
+        virtual void start_document (
+        ) { log << "start_document\n"; }
+
+        virtual void end_document (
+        ) { log << "end_document\n"; }
+
+        virtual void start_element (
+            const unsigned long,
+            const std::string& name,
+            const dlib::attribute_list& atts
+        )
+        {
+            log << "elem " << name;
+            atts.reset();
+            while (atts.move_next())
+                log << " " << atts.element().key() << "='" << atts.element().value() << "'";
+            log << "\n";
+        }
+
+        virtual void end_element (
+            const unsigned long,
+            const std::string& name
+        ) { log << "end " << name << "\n"; }
+
+        virtual void characters (
+            const std::string& data
+        ) { log << "chars " << data << "\n"; }
+
+        virtual void processing_instruction (
+            const unsigned long,
+            const std::string& target,
+            const std::string& data
+        ) { log << "pi " << target << " " << data << "\n"; }
+    };
+
+    class xml_error_recorder : public error_handler
+    {
+    public:
+        int num_errors = 0;
+        int num_fatal_errors = 0;
+        virtual void error (const unsigned long) { ++num_errors; }
+        virtual void fatal_error (const unsigned long) { ++num_fatal_errors; }
+    };
+
+// ----------------------------------------------------------------------------------------
 
     class test_data_io : public tester
     {
@@ -64,6 +127,21 @@ namespace
             fix_nonzero_indexing(samples);
             DLIB_TEST(max_index_plus_one(samples) == 4);
 
+            // make sure the binary format round trips exactly
+            {
+                save_binary_sample_data("iris.scale3", samples, labels);
+                std::vector<sample_type> samples2;
+                std::vector<scalar_type> labels2;
+                load_binary_sample_data("iris.scale3", samples2, labels2);
+                DLIB_TEST(samples2.size() == samples.size());
+                DLIB_TEST(labels2 == labels);
+                for (unsigned long i = 0; i < samples.size(); ++i)
+                {
+                    DLIB_TEST(samples2[i].size() == samples[i].size());
+                    DLIB_TEST(std::equal(samples[i].begin(), samples[i].end(), samples2[i].begin()));
+                }
+            }
+
             one_vs_one_trainer<any_trainer<sample_type,scalar_type>,scalar_type> trainer;
 
             typedef sparse_linear_kernel<sample_type> kernel_type;
@@ -205,12 +283,321 @@ namespace
         }
 
 
+        void test_xml_parsing()
+        {
+            print_spinner();
+
+            // Parse a document exercising entities, comments, CDATA, empty elements,
+            // and processing instructions and make sure the event stream is right.
+            {
+                std::istringstream sin(
+                    "<?xml version='1.0'?>\n"
+                    "<top a='1' b='two'>\n"
+                    "  <!-- a comment that should be ignored -->\n"
+                    "  <child>&lt;tag&gt; &amp; &apos;quoted&apos; &quot;text&quot;</child>\n"
+                    "  <empty x='3'/>\n"
+                    "  <data><![CDATA[raw <unparsed> & data]]></data>\n"
+                    "</top>");
+
+                xml_event_recorder rec;
+                xml_error_recorder err;
+                parse_xml(sin, rec, err);
+
+                const std::string expected =
+                    "start_document\n"
+                    "pi xml version='1.0'\n"
+                    "elem top a='1' b='two'\n"
+                    "chars \n  \n  \n"
+                    "elem child\n"
+                    "chars <tag> & 'quoted' \"text\"\n"
+                    "end child\n"
+                    "chars \n  \n"
+                    "elem empty x='3'\n"
+                    "end empty\n"
+                    "chars \n  \n"
+                    "elem data\n"
+                    "chars raw <unparsed> & data\n"
+                    "end data\n"
+                    "chars \n\n"
+                    "end top\n"
+                    "end_document\n";
+                DLIB_TEST_MSG(rec.log.str() == expected, "got:\n" << rec.log.str());
+                DLIB_TEST(err.num_errors == 0);
+                DLIB_TEST(err.num_fatal_errors == 0);
+            }
+
+            // Parse a document much bigger than the parser's internal read buffer to
+            // make sure nothing goes wrong at buffer boundaries.
+            {
+                std::ostringstream sout;
+                sout << "<top>";
+                for (int i = 0; i < 20000; ++i)
+                    sout << "<item idx='" << i << "'>value " << i << " &amp; stuff</item>";
+                sout << "</top>";
+
+                std::istringstream sin(sout.str());
+                xml_event_recorder rec;
+                xml_error_recorder err;
+                parse_xml(sin, rec, err);
+
+                std::ostringstream expected;
+                expected << "start_document\nelem top\n";
+                for (int i = 0; i < 20000; ++i)
+                {
+                    expected << "elem item idx='" << i << "'\n";
+                    expected << "chars value " << i << " & stuff\n";
+                    expected << "end item\n";
+                }
+                expected << "end top\nend_document\n";
+                DLIB_TEST(rec.log.str() == expected.str());
+                DLIB_TEST(err.num_errors == 0);
+                DLIB_TEST(err.num_fatal_errors == 0);
+            }
+        }
+
+        void test_image_dataset_metadata()
+        {
+            print_spinner();
+            using namespace dlib::image_dataset_metadata;
+
+            dataset data;
+            data.name = "round trip test dataset";
+            data.comment = "generated by the data_io unit test";
+            dlib::rand rnd;
+            for (int i = 0; i < 1500; ++i)
+            {
+                image img("images/img_" + cast_to_string(i) + ".png");
+                const int num_boxes = 1 + rnd.get_random_32bit_number()%3;
+                for (int j = 0; j < num_boxes; ++j)
+                {
+                    box b;
+                    b.rect = rectangle(j, i%100, j+10, i%100+20);
+                    b.label = "label_" + cast_to_string(j);
+                    b.difficult = ((i+j)%2 == 0);
+                    b.occluded = (i%3 == 0);
+                    b.parts["part_" + cast_to_string(j)] = point(i%50,j);
+                    img.boxes.push_back(b);
+                }
+                data.images.push_back(img);
+            }
+
+            const std::string filename = "metadata_test.xml";
+            save_image_dataset_metadata(data, filename);
+
+            dataset loaded;
+            load_image_dataset_metadata(loaded, filename);
+
+            DLIB_TEST(loaded.name == data.name);
+            DLIB_TEST(loaded.comment == data.comment);
+            DLIB_TEST(loaded.images.size() == data.images.size());
+            for (size_t i = 0; i < data.images.size(); ++i)
+            {
+                DLIB_TEST(loaded.images[i].filename == data.images[i].filename);
+                DLIB_TEST(loaded.images[i].boxes.size() == data.images[i].boxes.size());
+                for (size_t j = 0; j < data.images[i].boxes.size(); ++j)
+                {
+                    const box& b1 = data.images[i].boxes[j];
+                    const box& b2 = loaded.images[i].boxes[j];
+                    DLIB_TEST(b1.rect == b2.rect);
+                    DLIB_TEST(b1.label == b2.label);
+                    DLIB_TEST(b1.difficult == b2.difficult);
+                    DLIB_TEST(b1.occluded == b2.occluded);
+                    DLIB_TEST(b1.parts.size() == b2.parts.size());
+                    DLIB_TEST(std::equal(b1.parts.begin(), b1.parts.end(), b2.parts.begin()));
+                }
+            }
+
+            std::remove(filename.c_str());
+            std::remove("image_metadata_stylesheet.xsl");
+        }
+
+        void test_parallel_image_loading()
+        {
+            print_spinner();
+            using namespace dlib::image_dataset_metadata;
+
+            const long num_images = 25;
+            dataset data;
+            std::vector<std::string> filenames;
+            for (long i = 0; i < num_images; ++i)
+            {
+                array2d<rgb_pixel> img(20+i, 30);
+                assign_all_pixels(img, rgb_pixel(i, 255-i, 3*i));
+                const std::string name = "parallel_load_test_" + cast_to_string(i) + ".bmp";
+                save_bmp(img, name);
+                filenames.push_back(name);
+
+                image entry(name);
+                box b;
+                b.rect = rectangle(2,2,12,12);
+                entry.boxes.push_back(b);
+                data.images.push_back(entry);
+            }
+            const std::string metadata_filename = "parallel_load_test_metadata.xml";
+            save_image_dataset_metadata(data, metadata_filename);
+
+            // the parallel dataset loader must give the same images and boxes, in the
+            // same order, as reading the files one at a time.
+            dlib::array<array2d<rgb_pixel> > images;
+            std::vector<std::vector<rectangle> > boxes;
+            load_image_dataset(images, boxes, metadata_filename);
+            DLIB_TEST(images.size() == (unsigned long)num_images);
+            DLIB_TEST(boxes.size() == (unsigned long)num_images);
+            for (long i = 0; i < num_images; ++i)
+            {
+                DLIB_TEST(images[i].nr() == 20+i && images[i].nc() == 30);
+                DLIB_TEST(images[i][0][0].red == i && images[i][0][0].green == 255-i && images[i][0][0].blue == (unsigned char)(3*i));
+                DLIB_TEST(boxes[i].size() == 1 && boxes[i][0] == rectangle(2,2,12,12));
+            }
+
+            dlib::array<array2d<rgb_pixel> > images2;
+            load_images_in_parallel(images2, filenames);
+            DLIB_TEST(images2.size() == (unsigned long)num_images);
+            for (long i = 0; i < num_images; ++i)
+                DLIB_TEST(images2[i].nr() == 20+i && images2[i].nc() == 30);
+
+            // the generic loader must hand every item to consume() in order even with a
+            // small number of in flight slots
+            std::vector<unsigned long> order;
+            load_files_in_parallel<int>(100,
+                [](unsigned long i, int& v){ v = (int)(3*i); },
+                [&](unsigned long i, int& v){ DLIB_TEST(v == (int)(3*i)); order.push_back(i); },
+                3, 4);
+            DLIB_TEST(order.size() == 100);
+            DLIB_TEST(std::is_sorted(order.begin(), order.end()));
+
+            for (auto& name : filenames)
+                std::remove(name.c_str());
+            std::remove(metadata_filename.c_str());
+            std::remove("image_metadata_stylesheet.xsl");
+        }
+
+        void test_streaming_image_dataset()
+        {
+            print_spinner();
+            using namespace dlib::image_dataset_metadata;
+
+            const long num_images = 12;
+            dataset data;
+            std::vector<std::string> filenames;
+            for (long i = 0; i < num_images; ++i)
+            {
+                array2d<rgb_pixel> img(10, 10);
+                assign_all_pixels(img, rgb_pixel(i, 255-i, 3*i));
+                const std::string name = "streaming_load_test_" + cast_to_string(i) + ".bmp";
+                save_bmp(img, name);
+                filenames.push_back(name);
+
+                image entry(name);
+                box b;
+                b.rect = rectangle(1,1,5,5);
+                b.label = "obj_" + cast_to_string(i);
+                entry.boxes.push_back(b);
+                data.images.push_back(entry);
+            }
+            const std::string metadata_filename = "streaming_load_test_metadata.xml";
+            save_image_dataset_metadata(data, metadata_filename);
+
+            dlib::array<matrix<rgb_pixel> > ref_images;
+            std::vector<std::vector<mmod_rect> > ref_boxes;
+            load_image_dataset(ref_images, ref_boxes, metadata_filename);
+            DLIB_TEST(ref_images.size() == (unsigned long)num_images);
+
+            streaming_image_dataset<matrix<rgb_pixel> > ds(metadata_filename, 4);
+            DLIB_TEST(ds.size() == (unsigned long)num_images);
+
+            // One epoch of the stream must hand out every image exactly once (in some
+            // order) with the same pixels and boxes the non-streaming loader produces.
+            auto check_one_epoch = [&]()
+            {
+                std::vector<bool> seen(num_images, false);
+                matrix<rgb_pixel> img;
+                std::vector<mmod_rect> boxes;
+                for (long i = 0; i < num_images; ++i)
+                {
+                    ds.get_next_image(img, boxes);
+                    // identify which dataset image this is by its unique fill color
+                    const long idx = img(0,0).red;
+                    DLIB_TEST(0 <= idx && idx < num_images);
+                    DLIB_TEST(!seen[idx]);
+                    seen[idx] = true;
+                    DLIB_TEST(img.nr() == ref_images[idx].nr() && img.nc() == ref_images[idx].nc());
+                    bool pixels_match = true;
+                    for (long r = 0; r < img.nr(); ++r)
+                    {
+                        for (long c = 0; c < img.nc(); ++c)
+                        {
+                            if (img(r,c).red   != ref_images[idx](r,c).red ||
+                                img(r,c).green != ref_images[idx](r,c).green ||
+                                img(r,c).blue  != ref_images[idx](r,c).blue)
+                                pixels_match = false;
+                        }
+                    }
+                    DLIB_TEST(pixels_match);
+                    DLIB_TEST(boxes.size() == ref_boxes[idx].size());
+                    for (unsigned long j = 0; j < boxes.size(); ++j)
+                    {
+                        DLIB_TEST(boxes[j].rect == ref_boxes[idx][j].rect);
+                        DLIB_TEST(boxes[j].label == ref_boxes[idx][j].label);
+                        DLIB_TEST(boxes[j].ignore == ref_boxes[idx][j].ignore);
+                    }
+                }
+                for (long i = 0; i < num_images; ++i)
+                    DLIB_TEST(seen[i]);
+            };
+            check_one_epoch();
+            // the stream loops forever, so the next epoch covers the dataset again
+            check_one_epoch();
+
+            // get_next_images() is just repeated get_next_image() calls
+            {
+                dlib::array<matrix<rgb_pixel> > imgs;
+                std::vector<std::vector<mmod_rect> > all_boxes;
+                ds.get_next_images(imgs, all_boxes, 5);
+                DLIB_TEST(imgs.size() == 5);
+                DLIB_TEST(all_boxes.size() == 5);
+            }
+
+            // A dataset whose metadata points at a missing image file must surface
+            // the loader's failure as an exception from get_next_image().
+            {
+                dataset bad;
+                image entry("streaming_load_test_does_not_exist.bmp");
+                box b;
+                b.rect = rectangle(1,1,5,5);
+                entry.boxes.push_back(b);
+                bad.images.push_back(entry);
+                const std::string bad_filename = "streaming_load_test_bad_metadata.xml";
+                save_image_dataset_metadata(bad, bad_filename);
+
+                streaming_image_dataset<matrix<rgb_pixel> > bad_ds(bad_filename);
+                DLIB_TEST(bad_ds.size() == 1);
+                bool saw_error = false;
+                matrix<rgb_pixel> img;
+                std::vector<mmod_rect> boxes;
+                try { bad_ds.get_next_image(img, boxes); }
+                catch (std::exception&) { saw_error = true; }
+                DLIB_TEST(saw_error);
+                std::remove(bad_filename.c_str());
+            }
+
+            for (auto& name : filenames)
+                std::remove(name.c_str());
+            std::remove(metadata_filename.c_str());
+            std::remove("image_metadata_stylesheet.xsl");
+        }
+
         void perform_test (
         )
         {
             print_spinner();
             create_iris_datafile();
 
+            test_xml_parsing();
+            test_image_dataset_metadata();
+            test_parallel_image_loading();
+            test_streaming_image_dataset();
+
             test_sparse_to_dense();
 
             run_test<std::map<unsigned int, double> >();
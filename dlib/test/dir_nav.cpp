@@ -0,0 +1,298 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <dlib/dir_nav.h>
+#include "tester.h"
+
+namespace
+{
+
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.dir_nav");
+
+    const char sep = directory::get_separator();
+
+// ----------------------------------------------------------------------------------------
+
+    void make_dir (
+        const std::string& path
+    )
+    {
+#ifdef _WIN32
+        _mkdir(path.c_str());
+#else
+        mkdir(path.c_str(), 0755);
+#endif
+    }
+
+    void remove_dir (
+        const std::string& path
+    )
+    {
+#ifdef _WIN32
+        _rmdir(path.c_str());
+#else
+        rmdir(path.c_str());
+#endif
+    }
+
+    void make_file (
+        const std::string& path
+    )
+    {
+        ofstream fout(path.c_str());
+        fout << "some stuff";
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class test_tree
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                Builds a small directory tree for the tests to walk and tears it
+                back down when destructed.  The layout is:
+                    root/f0.txt
+                    root/a/f1.txt
+                    root/a/f2.dat
+                    root/a/b/f3.txt
+                    root/c/f4.txt
+        !*/
+    public:
+        test_tree (
+        )
+        {
+            root = "dir_nav_walker_test.dir";
+            make_dir(root);
+            make_dir(root + sep + "a");
+            make_dir(root + sep + "a" + sep + "b");
+            make_dir(root + sep + "c");
+            make_file(root + sep + "f0.txt");
+            make_file(root + sep + "a" + sep + "f1.txt");
+            make_file(root + sep + "a" + sep + "f2.dat");
+            make_file(root + sep + "a" + sep + "b" + sep + "f3.txt");
+            make_file(root + sep + "c" + sep + "f4.txt");
+        }
+
+        ~test_tree (
+        )
+        {
+            std::remove((root + sep + "f0.txt").c_str());
+            std::remove((root + sep + "a" + sep + "f1.txt").c_str());
+            std::remove((root + sep + "a" + sep + "f2.dat").c_str());
+            std::remove((root + sep + "a" + sep + "b" + sep + "f3.txt").c_str());
+            std::remove((root + sep + "c" + sep + "f4.txt").c_str());
+            remove_dir(root + sep + "a" + sep + "b");
+            remove_dir(root + sep + "a");
+            remove_dir(root + sep + "c");
+            remove_dir(root);
+        }
+
+        std::string root;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    std::set<std::string> walk_tree (
+        const directory& top,
+        const std::function<bool(const file&)>& add_file,
+        unsigned long max_depth = 30,
+        unsigned long num_threads = 4
+    )
+    /*!
+        ensures
+            - drains a directory_tree_walker over the given tree and returns the set
+              of file names it produced.
+    !*/
+    {
+        std::set<std::string> names;
+        directory_tree_walker walker(top, add_file, max_depth, num_threads);
+        file f;
+        while (walker.get_next_file(f))
+            names.insert(f.name());
+        // once the walk is over it must stay over
+        DLIB_TEST(walker.get_next_file(f) == false);
+        return names;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_walker_traversal (
+        const test_tree& tree
+    )
+    {
+        const directory top(tree.root);
+        const auto accept_all = [](const file&) { return true; };
+
+        // the walker must find exactly the same files as the serial
+        // get_files_in_directory_tree() function.
+        std::set<std::string> expected;
+        for (auto& f : get_files_in_directory_tree(top, accept_all))
+            expected.insert(f.name());
+        DLIB_TEST(expected.size() == 5);
+
+        DLIB_TEST(walk_tree(top, accept_all) == expected);
+        // a single worker thread must give the same answer
+        DLIB_TEST(walk_tree(top, accept_all, 30, 1) == expected);
+        // so must asking for zero threads, which rounds up to one
+        DLIB_TEST(walk_tree(top, accept_all, 30, 0) == expected);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_walker_filter (
+        const test_tree& tree
+    )
+    {
+        const directory top(tree.root);
+
+        // the bool returning callback prunes files it rejects
+        std::set<std::string> names = walk_tree(top, match_ending(".txt"));
+        DLIB_TEST_MSG(names.size() == 4, names.size());
+        DLIB_TEST(names.count("f2.dat") == 0);
+
+        // rejecting everything yields an empty walk
+        names = walk_tree(top, [](const file&) { return false; });
+        DLIB_TEST(names.size() == 0);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_walker_max_depth (
+        const test_tree& tree
+    )
+    {
+        const directory top(tree.root);
+        const auto accept_all = [](const file&) { return true; };
+
+        // max_depth of 0 means just the files in the top directory
+        std::set<std::string> names = walk_tree(top, accept_all, 0);
+        DLIB_TEST(names.size() == 1);
+        DLIB_TEST(names.count("f0.txt") == 1);
+
+        // max_depth of 1 reaches a and c but not a/b
+        names = walk_tree(top, accept_all, 1);
+        DLIB_TEST_MSG(names.size() == 4, names.size());
+        DLIB_TEST(names.count("f3.txt") == 0);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+#ifndef _WIN32
+    void test_walker_symlinks (
+        const test_tree& tree
+    )
+    {
+        const directory top(tree.root);
+        const auto accept_all = [](const file&) { return true; };
+
+        // a broken symlink must not abort the walk, so every real file is still
+        // delivered.  (whether the link itself is listed is up to dir_nav)
+        const std::string dangling = tree.root + sep + "c" + sep + "dangling";
+        symlink("does_not_exist_anywhere", dangling.c_str());
+
+        std::set<std::string> names = walk_tree(top, accept_all);
+        DLIB_TEST(names.count("f0.txt") == 1);
+        DLIB_TEST(names.count("f3.txt") == 1);
+        DLIB_TEST(names.count("f4.txt") == 1);
+
+        // a symlink cycle back up to the root of the tree must not hang the walk.
+        // max_depth bounds the traversal, so every real file is still found.
+        const std::string loop = tree.root + sep + "c" + sep + "loop";
+        symlink((std::string("..") + sep + "..").c_str(), loop.c_str());
+
+        names = walk_tree(top, accept_all, 4);
+        DLIB_TEST(names.count("f0.txt") == 1);
+        DLIB_TEST(names.count("f1.txt") == 1);
+        DLIB_TEST(names.count("f2.dat") == 1);
+        DLIB_TEST(names.count("f3.txt") == 1);
+        DLIB_TEST(names.count("f4.txt") == 1);
+
+        std::remove(loop.c_str());
+        std::remove(dangling.c_str());
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_walker_unreadable_dir (
+        const test_tree& tree
+    )
+    {
+        const directory top(tree.root);
+        const auto accept_all = [](const file&) { return true; };
+
+        // a directory we can't list must be skipped rather than killing the walk,
+        // and everything readable must still be delivered.
+        const std::string locked = tree.root + sep + "c" + sep + "locked";
+        make_dir(locked);
+        make_file(locked + sep + "hidden.txt");
+        chmod(locked.c_str(), 0);
+
+        std::set<std::string> names = walk_tree(top, accept_all);
+        DLIB_TEST(names.count("f0.txt") == 1);
+        DLIB_TEST(names.count("f1.txt") == 1);
+        DLIB_TEST(names.count("f2.dat") == 1);
+        DLIB_TEST(names.count("f3.txt") == 1);
+        DLIB_TEST(names.count("f4.txt") == 1);
+        // When run as root the permission bits don't stop the listing, so only
+        // require hidden.txt's absence for ordinary users.
+        if (geteuid() != 0)
+            DLIB_TEST(names.count("hidden.txt") == 0);
+
+        chmod(locked.c_str(), 0755);
+        std::remove((locked + sep + "hidden.txt").c_str());
+        remove_dir(locked);
+    }
+#endif // _WIN32
+
+// ----------------------------------------------------------------------------------------
+
+    class dir_nav_tester : public tester
+    {
+    public:
+        dir_nav_tester (
+        ) :
+            tester ("test_dir_nav",
+                    "Runs tests on the dir_nav components.")
+        {}
+
+        void perform_test (
+        )
+        {
+            test_tree tree;
+
+            print_spinner();
+            test_walker_traversal(tree);
+            print_spinner();
+            test_walker_filter(tree);
+            print_spinner();
+            test_walker_max_depth(tree);
+#ifndef _WIN32
+            print_spinner();
+            test_walker_symlinks(tree);
+            print_spinner();
+            test_walker_unreadable_dir(tree);
+#endif
+        }
+    } a;
+
+}
+
@@ -9,6 +9,8 @@
 #include <vector>
 #include <random>
 #include <numeric>
+#include <atomic>
+#include <thread>
 #include "../dnn.h"
 
 #include "tester.h"
@@ -1941,6 +1943,298 @@ namespace
         DLIB_TEST(count == pnet.num_computational_layers);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_int8_inference()
+    {
+        print_spinner();
+
+        using net_type = con<2,3,3,1,1,relu<con<4,3,3,1,1,input<matrix<float>>>>>;
+        net_type net;
+
+        matrix<float> x(8,8);
+        dlib::rand rnd;
+        for (auto& v : x)
+            v = rnd.get_random_gaussian();
+        resizable_tensor xt;
+        net.to_tensor(&x, &x+1, xt);
+
+        const resizable_tensor ref = net.forward(xt);
+
+        // The int8 path does 8 bit dynamic quantization, so its output must track
+        // the float path to within a small fraction of the output range while not
+        // being bit identical (if it were, the quantized path didn't run).
+        set_int8_inference(net, true);
+        DLIB_TEST(layer<0>(net).layer_details().int8_inference() == true);
+        DLIB_TEST(layer<2>(net).layer_details().int8_inference() == true);
+        net.clean();
+        const resizable_tensor quant = net.forward(xt);
+        DLIB_TEST(quant.size() == ref.size());
+        const float scale = max(abs(mat(ref)));
+        const float err = max(abs(mat(quant)-mat(ref)));
+        DLIB_TEST_MSG(err <= 0.05f*scale, "err: " << err << "  scale: " << scale);
+        DLIB_TEST(err > 0);
+
+        // The flag is a runtime setting, not part of the model, so serializing a
+        // net with it enabled must produce exactly the bytes of the plain model
+        // and deserializing must come back with the flag off.
+        ostringstream sout_quant;
+        serialize(net, sout_quant);
+        set_int8_inference(net, false);
+        ostringstream sout_plain;
+        serialize(net, sout_plain);
+        DLIB_TEST(sout_quant.str() == sout_plain.str());
+
+        net_type net2;
+        istringstream sin(sout_quant.str());
+        deserialize(net2, sin);
+        DLIB_TEST(layer<0>(net2).layer_details().int8_inference() == false);
+        DLIB_TEST(layer<2>(net2).layer_details().int8_inference() == false);
+        net2.to_tensor(&x, &x+1, xt);
+        DLIB_TEST(max(abs(mat(net2.forward(xt))-mat(ref))) == 0);
+
+        // Re-enabling the flag on the round tripped net must reproduce the
+        // quantized output exactly since the path is deterministic.
+        set_int8_inference(net2, true);
+        net2.clean();
+        DLIB_TEST(max(abs(mat(net2.forward(xt))-mat(quant))) == 0);
+    }
+
+    void test_input_cached()
+    {
+        print_spinner();
+
+        dlib::rand rnd;
+        std::vector<matrix<float>> raw(3);
+        std::vector<std::pair<unsigned long long, matrix<float>>> samples(3);
+        for (unsigned long i = 0; i < raw.size(); ++i)
+        {
+            raw[i].set_size(4,5);
+            for (auto& v : raw[i])
+                v = rnd.get_random_gaussian();
+            samples[i] = std::make_pair(i, raw[i]);
+        }
+
+        input<matrix<float>> plain;
+        resizable_tensor ref;
+        plain.to_tensor(raw.begin(), raw.end(), ref);
+
+        // A cold cache, a warm cache, and a mixed hit/miss batch must all produce
+        // exactly what the wrapped input layer produces.
+        input_cached<input<matrix<float>>> cached;
+        resizable_tensor out;
+        cached.to_tensor(samples.begin(), samples.end(), out);
+        DLIB_TEST(out.size() == ref.size());
+        DLIB_TEST(max(abs(mat(out)-mat(ref))) == 0);
+
+        const size_t bytes_per_sample = ref.size()/ref.num_samples()*sizeof(float);
+        DLIB_TEST(cached.get_cache_size_bytes() == 3*bytes_per_sample);
+
+        cached.to_tensor(samples.begin(), samples.end(), out);
+        DLIB_TEST(max(abs(mat(out)-mat(ref))) == 0);
+        // pure cache hits must not grow the cache
+        DLIB_TEST(cached.get_cache_size_bytes() == 3*bytes_per_sample);
+
+        std::reverse(samples.begin(), samples.end());
+        resizable_tensor ref_rev;
+        std::reverse(raw.begin(), raw.end());
+        plain.to_tensor(raw.begin(), raw.end(), ref_rev);
+        cached.to_tensor(samples.begin(), samples.end(), out);
+        DLIB_TEST(max(abs(mat(out)-mat(ref_rev))) == 0);
+
+        // Shrinking the cache budget evicts least recently used entries but always
+        // keeps at least one so the last batch stays usable.
+        cached.set_max_cache_size_bytes(0);
+        DLIB_TEST(cached.get_cache_size_bytes() == bytes_per_sample);
+
+        // the cache keeps evicting on later calls and the outputs stay correct
+        cached.to_tensor(samples.begin(), samples.end(), out);
+        DLIB_TEST(max(abs(mat(out)-mat(ref_rev))) == 0);
+        DLIB_TEST(cached.get_cache_size_bytes() == bytes_per_sample);
+
+        // clear_cache() empties it entirely and the next call repopulates
+        cached.set_max_cache_size_bytes(1024*1024);
+        cached.clear_cache();
+        DLIB_TEST(cached.get_cache_size_bytes() == 0);
+        cached.to_tensor(samples.begin(), samples.end(), out);
+        DLIB_TEST(max(abs(mat(out)-mat(ref_rev))) == 0);
+        DLIB_TEST(cached.get_cache_size_bytes() == 3*bytes_per_sample);
+
+        // serialization round trips the wrapped layer and comes back with an
+        // empty cache
+        ostringstream sout;
+        serialize(cached, sout);
+        istringstream sin(sout.str());
+        input_cached<input<matrix<float>>> cached2;
+        deserialize(cached2, sin);
+        DLIB_TEST(cached2.get_cache_size_bytes() == 0);
+        cached2.to_tensor(samples.begin(), samples.end(), out);
+        DLIB_TEST(max(abs(mat(out)-mat(ref_rev))) == 0);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    struct dense_solver_test_layer
+    {
+        resizable_tensor params;
+        const tensor& get_layer_params() const { return params; }
+    };
+
+    struct sparse_solver_test_layer
+    {
+        resizable_tensor params;
+        std::vector<unsigned long> rows;
+        const tensor& get_layer_params() const { return params; }
+        const std::vector<unsigned long>& get_sparse_gradient_rows() const { return rows; }
+    };
+
+    void test_sparse_solver_updates()
+    {
+        print_spinner();
+        const long num_rows = 6;
+        const long row_len = 4;
+        tt::tensor_rand rnd;
+
+        // With no weight decay the sparse sgd path must agree with the dense path
+        // exactly whenever every row is touched on every step.
+        {
+            dense_solver_test_layer dense;
+            sparse_solver_test_layer sparse;
+            dense.params.set_size(num_rows, row_len);
+            rnd.fill_gaussian(dense.params);
+            sparse.params.copy_size(dense.params);
+            memcpy(sparse.params, dense.params);
+            for (long r = 0; r < num_rows; ++r)
+                sparse.rows.push_back(r);
+
+            sgd dense_solver(0.0f, 0.9f);
+            sgd sparse_solver(0.0f, 0.9f);
+            resizable_tensor grad(num_rows, row_len);
+            for (int iter = 0; iter < 5; ++iter)
+            {
+                rnd.fill_gaussian(grad);
+                const tensor& dstep = dense_solver(0.01f, dense, grad);
+                const tensor& sstep = sparse_solver(0.01f, sparse, grad);
+                DLIB_TEST(max(abs(mat(dstep)-mat(sstep))) < 1e-6);
+                tt::add(dense.params, dense.params, dstep);
+                tt::add(sparse.params, sparse.params, sstep);
+            }
+        }
+
+        // Rows not reported as touched must get an exactly zero step and the
+        // momentum of a skipped row has to be caught up when it reappears.
+        {
+            sparse_solver_test_layer sparse;
+            sparse.params.set_size(num_rows, row_len);
+            rnd.fill_gaussian(sparse.params);
+
+            const float lr = 0.01f;
+            const float momentum = 0.9f;
+            sgd solver(0.0f, momentum);
+            resizable_tensor grad(num_rows, row_len);
+            matrix<float> v = zeros_matrix<float>(num_rows, row_len);
+            std::vector<unsigned long> last_seen(num_rows, 0);
+            unsigned long step_num = 0;
+
+            const std::vector<std::vector<unsigned long>> schedules = {{2}, {2,3}, {0}, {2,3}};
+            for (const auto& schedule : schedules)
+            {
+                ++step_num;
+                rnd.fill_gaussian(grad);
+                sparse.rows = schedule;
+                const tensor& step = solver(lr, sparse, grad);
+                const matrix<float> stepmat = matrix_cast<float>(reshape(mat(step), num_rows, row_len));
+                const matrix<float> gradmat = matrix_cast<float>(reshape(mat(grad), num_rows, row_len));
+                for (long r = 0; r < num_rows; ++r)
+                {
+                    if (std::find(schedule.begin(), schedule.end(), r) == schedule.end())
+                    {
+                        DLIB_TEST(max(abs(rowm(stepmat,r))) == 0);
+                    }
+                    else
+                    {
+                        const unsigned long k = step_num - last_seen[r];
+                        last_seen[r] = step_num;
+                        set_rowm(v,r) = std::pow(momentum, (float)k)*rowm(v,r) - lr*rowm(gradmat,r);
+                        DLIB_TEST(max(abs(rowm(stepmat,r)-rowm(v,r))) < 1e-6);
+                    }
+                }
+            }
+        }
+
+        // When every row is touched on every step the lazy adam path must agree
+        // with the dense adam solver, weight decay included.
+        {
+            dense_solver_test_layer dense;
+            sparse_solver_test_layer sparse;
+            dense.params.set_size(num_rows, row_len);
+            rnd.fill_gaussian(dense.params);
+            sparse.params.copy_size(dense.params);
+            memcpy(sparse.params, dense.params);
+            for (long r = 0; r < num_rows; ++r)
+                sparse.rows.push_back(r);
+
+            adam dense_solver(0.0005f, 0.9f, 0.999f);
+            adam sparse_solver(0.0005f, 0.9f, 0.999f);
+            resizable_tensor grad(num_rows, row_len);
+            for (int iter = 0; iter < 5; ++iter)
+            {
+                rnd.fill_gaussian(grad);
+                const tensor& dstep = dense_solver(0.01f, dense, grad);
+                const tensor& sstep = sparse_solver(0.01f, sparse, grad);
+                DLIB_TEST(max(abs(mat(dstep)-mat(sstep))) < 1e-6);
+                tt::add(dense.params, dense.params, dstep);
+                tt::add(sparse.params, sparse.params, sstep);
+            }
+
+            // and a partially touched step still zeroes the untouched rows
+            sparse.rows = {1, 4};
+            rnd.fill_gaussian(grad);
+            const tensor& sstep = sparse_solver(0.01f, sparse, grad);
+            const matrix<float> stepmat = matrix_cast<float>(reshape(mat(sstep), num_rows, row_len));
+            for (long r = 0; r < num_rows; ++r)
+            {
+                if (r == 1 || r == 4)
+                    DLIB_TEST(max(abs(rowm(stepmat,r))) > 0);
+                else
+                    DLIB_TEST(max(abs(rowm(stepmat,r))) == 0);
+            }
+        }
+    }
+
+    void test_net_memory_report()
+    {
+        print_spinner();
+        using net_type = loss_multiclass_log<fc<3,relu<fc<8,input<matrix<float>>>>>>;
+        net_type net;
+
+        // Only the shape of the input matters, so an uninitialized sample of the
+        // production input size is enough to get a report.
+        matrix<float> x(4, 1);
+        std::ostringstream sout;
+        net_memory_report(net, x, 5, sout);
+        const std::string report = sout.str();
+        dlog << LINFO << "memory report:\n" << report;
+
+        const auto extract = [&report](const std::string& field) -> unsigned long
+        {
+            const auto pos = report.find(field);
+            DLIB_TEST_MSG(pos != std::string::npos, field);
+            return std::strtoul(report.c_str()+pos+field.size(), nullptr, 10);
+        };
+
+        // fc<8> on 4 inputs has 4*8+8 parameters and fc<3> on 8 inputs has 8*3+3,
+        // giving 67 floats.  relu runs in place on fc<8>'s output so those two
+        // layers share one 5x8 tensor, which along with fc<3>'s 5x3 output gives
+        // 55 floats of layer outputs.
+        const unsigned long param_bytes = extract("total parameter bytes:");
+        const unsigned long output_bytes = extract("total layer output bytes:");
+        DLIB_TEST_MSG(param_bytes == 67*sizeof(float), param_bytes);
+        DLIB_TEST_MSG(output_bytes == 55*sizeof(float), output_bytes);
+        DLIB_TEST(extract("peak inference bytes:") == param_bytes+output_bytes);
+        DLIB_TEST(extract("peak training bytes:") == 2*(param_bytes+output_bytes));
+    }
+
     float tensor_read_cpu(const tensor& t, long i, long k, long r, long c)
     {
         const float* p = t.host() + t.k() * t.nr() * t.nc() * i +
@@ -3118,6 +3412,138 @@ namespace
     }
 
 
+    void test_tensor_extract_image_chips()
+    {
+        print_spinner();
+        dlib::rand rnd;
+
+        matrix<float> img0(90,110), img1(90,110);
+        for (long r = 0; r < img0.nr(); ++r)
+        {
+            for (long c = 0; c < img0.nc(); ++c)
+            {
+                img0(r,c) = rnd.get_random_float();
+                img1(r,c) = rnd.get_random_float();
+            }
+        }
+
+        // pack the two images into one tensor as two channels of a single frame
+        resizable_tensor timg(1,2,img0.nr(),img0.nc());
+        float* p = timg.host();
+        for (long r = 0; r < img0.nr(); ++r)
+            for (long c = 0; c < img0.nc(); ++c)
+                *p++ = img0(r,c);
+        for (long r = 0; r < img1.nr(); ++r)
+            for (long c = 0; c < img1.nc(); ++c)
+                *p++ = img1(r,c);
+
+        // Chips stay well inside the image and near their source resolution so the
+        // image based extract_image_chip() takes the same direct bilinear path and
+        // the results should match to float precision.
+        std::vector<chip_details> locs;
+        for (int i = 0; i < 20; ++i)
+        {
+            const rectangle rect = centered_rect(55+rnd.get_random_32bit_number()%10,
+                                                 45+rnd.get_random_32bit_number()%10,
+                                                 30+rnd.get_random_32bit_number()%10,
+                                                 30+rnd.get_random_32bit_number()%10);
+            const double angle = (rnd.get_random_double()-0.5)*2*pi;
+            locs.push_back(chip_details(rect, chip_dims(40,50), angle));
+        }
+
+        resizable_tensor chips;
+        extract_image_chips(timg, locs, chips);
+        DLIB_TEST(chips.num_samples() == (long)locs.size());
+        DLIB_TEST(chips.k() == 2);
+        DLIB_TEST(chips.nr() == 40 && chips.nc() == 50);
+
+        for (unsigned long i = 0; i < locs.size(); ++i)
+        {
+            matrix<float> chip0, chip1;
+            extract_image_chip(img0, locs[i], chip0);
+            extract_image_chip(img1, locs[i], chip1);
+            const float* c = chips.host() + i*chips.k()*chips.nr()*chips.nc();
+            matrix<float> got0 = mat(c, chips.nr(), chips.nc());
+            matrix<float> got1 = mat(c+chips.nr()*chips.nc(), chips.nr(), chips.nc());
+            DLIB_TEST_MSG(max(abs(got0-chip0)) < 1e-3, max(abs(got0-chip0)));
+            DLIB_TEST_MSG(max(abs(got1-chip1)) < 1e-3, max(abs(got1-chip1)));
+        }
+    }
+
+    void test_tensor_arena()
+    {
+        print_spinner();
+
+        // A chain of tensors where each one is consumed by the next step should pack
+        // into about two tensors worth of memory rather than ten.
+        {
+            tensor_arena arena;
+            std::vector<size_t> ids;
+            for (unsigned long i = 0; i < 10; ++i)
+                ids.push_back(arena.add_tensor(2,3,4,5, i, i+1));
+            arena.plan();
+            DLIB_TEST(arena.num_tensors() == 10);
+            DLIB_TEST(arena.slab_size() == 2*2*3*4*5);
+
+            // walk the chain like a forward pass and make sure each producer's
+            // values survive until the consuming step has read them.
+            for (unsigned long i = 0; i < 10; ++i)
+            {
+                auto t = arena[ids[i]];
+                DLIB_TEST(t.num_samples() == 2 && t.k() == 3 && t.nr() == 4 && t.nc() == 5);
+                if (i > 0)
+                {
+                    auto prev = arena[ids[i-1]];
+                    DLIB_TEST(max(abs(mat(prev)-(i-1.0f))) == 0);
+                }
+                t = (float)i;
+            }
+        }
+
+        // Random lifetimes: tensors whose lifetime intervals intersect must never
+        // overlap in memory, and the plan should never use more memory than giving
+        // every tensor its own allocation would.
+        {
+            dlib::rand rnd;
+            tensor_arena arena;
+            std::vector<std::pair<unsigned long,unsigned long> > lifetimes;
+            size_t total = 0;
+            for (int i = 0; i < 50; ++i)
+            {
+                const unsigned long first = rnd.get_random_32bit_number()%20;
+                const unsigned long last = first + rnd.get_random_32bit_number()%5;
+                const long long n = rnd.get_random_32bit_number()%3;
+                const long long k = 1+rnd.get_random_32bit_number()%4;
+                const long long nr = 1+rnd.get_random_32bit_number()%7;
+                const long long nc = 1+rnd.get_random_32bit_number()%7;
+                arena.add_tensor(n,k,nr,nc, first, last);
+                lifetimes.push_back(std::make_pair(first,last));
+                total += n*k*nr*nc;
+            }
+            arena.plan();
+            DLIB_TEST(arena.slab_size() <= total);
+            for (size_t i = 0; i < arena.num_tensors(); ++i)
+            {
+                const float* const pi = arena[i].host();
+                const size_t si = arena[i].size();
+                if (si == 0)
+                    continue;
+                for (size_t j = i+1; j < arena.num_tensors(); ++j)
+                {
+                    if (lifetimes[i].second < lifetimes[j].first || lifetimes[j].second < lifetimes[i].first)
+                        continue;
+                    const float* const pj = arena[j].host();
+                    const size_t sj = arena[j].size();
+                    if (sj == 0)
+                        continue;
+                    DLIB_TEST(pi+si <= pj || pj+sj <= pi);
+                }
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
     void test_serialization()
     {
         print_spinner();
@@ -3172,6 +3598,60 @@ namespace
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_trainer_prefetch()
+    {
+        print_spinner();
+
+        // same task as test_loss_dot() above, but feeding the trainer through the
+        // prefetching interface.
+        std::vector<matrix<float,0,1>> samples;
+        std::vector<matrix<float,0,1>> labels;
+
+        const matrix<float> proj = matrix_cast<float>(randm(2,3));
+        for (int i = 0; i < 128; ++i)
+        {
+            matrix<float,0,1> x = matrix_cast<float>(randm(3,1));
+            matrix<float,0,1> y = normalize(proj*x);
+            samples.push_back(x);
+            labels.push_back(y);
+        }
+
+        using net_type = loss_dot<
+            l2normalize<fc_no_bias<2,
+            input<matrix<float,0,1>>
+            >>>;
+
+        net_type net;
+        dnn_trainer<net_type> trainer(net, sgd(1e-4, 0.9));
+        trainer.set_learning_rate(0.01);
+        trainer.set_mini_batch_size(128);
+
+        int remaining = 3000;
+        trainer.start_prefetching([&](std::vector<matrix<float,0,1>>& data,
+                                      std::vector<matrix<float,0,1>>& labs)
+        {
+            if (remaining-- <= 0)
+                return false;
+            data = samples;
+            labs = labels;
+            return true;
+        });
+
+        unsigned long steps = 0;
+        while (trainer.train_one_step())
+            ++steps;
+        DLIB_TEST(steps == 3000);
+        DLIB_TEST(trainer.get_train_one_step_calls() == 3000);
+
+        trainer.get_net();
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            DLIB_TEST(std::abs(1-dot(net(samples[i]),labels[i])) < 0.01);
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     void test_loss_multimulticlass_log()
@@ -3312,6 +3792,470 @@ namespace
         const auto approximate_desired_det_count = (nr - 2 * margin) * (nc - 2 * margin) / 2.0;
         DLIB_TEST(dets.size() > approximate_desired_det_count * 0.45);
         DLIB_TEST(dets.size() < approximate_desired_det_count * 1.05);
+
+        // Now do the same thing but with bounding box regression enabled, so the
+        // regression outputs also get exercised.
+        mmod_options options_bbr(use_image_pyramid::no, { labels });
+        options_bbr.use_bounding_box_regression = true;
+        using net_type_bbr = loss_mmod<con<5,5,5,1,1,con<1,5,5,2,2,input<input_image_type>>>>;
+        net_type_bbr net_bbr(options_bbr);
+        dnn_trainer<net_type_bbr> trainer_bbr(net_bbr, sgd(0.1));
+        // The regression terms make this loss harder to optimize, so use a gentler
+        // learning rate than the run above.
+        trainer_bbr.set_learning_rate(0.001);
+        for (int i = 0; i < 600; ++i) {
+            if (i % 10 == 0)
+                print_spinner();
+            trainer_bbr.train_one_step({ input_image }, { labels });
+            DLIB_TEST(trainer_bbr.get_average_loss() >= 0.0);
+        }
+        // Half the truth boxes map to the same feature coordinates as a neighbor and
+        // get ignored during training, so expect about half the detections.
+        const auto dets_bbr = net_bbr(input_image);
+        DLIB_TEST(dets_bbr.size() > approximate_desired_det_count * 0.35);
+        DLIB_TEST(dets_bbr.size() < approximate_desired_det_count * 1.05);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_find_greater_than()
+    {
+        print_spinner();
+
+        resizable_tensor t(2,3,4,5);
+        tt::tensor_rand rnd;
+        rnd.fill_uniform(t);
+
+        std::vector<std::pair<size_t,float>> hits;
+        tt::find_greater_than(hits, t, 0, t.size(), 0.75);
+
+        const float* data = t.host();
+        std::vector<bool> found(t.size(), false);
+        for (auto& hit : hits)
+        {
+            DLIB_TEST(hit.first < t.size());
+            DLIB_TEST(!found[hit.first]);
+            found[hit.first] = true;
+            DLIB_TEST(data[hit.first] == hit.second);
+            DLIB_TEST(hit.second > 0.75);
+        }
+        for (size_t i = 0; i < t.size(); ++i)
+        {
+            if (!found[i])
+                DLIB_TEST(data[i] <= 0.75);
+        }
+
+        // check that the begin/end bounds are respected
+        tt::find_greater_than(hits, t, 10, 20, -1);
+        DLIB_TEST(hits.size() == 10);
+        for (auto& hit : hits)
+            DLIB_TEST(10 <= hit.first && hit.first < 20);
+
+        // nothing passes a threshold above the max value
+        tt::find_greater_than(hits, t, 0, t.size(), 2);
+        DLIB_TEST(hits.size() == 0);
+
+        std::vector<size_t> idxs = {0, 5, 3, t.size()-1, 5};
+        std::vector<float> vals;
+        tt::gather(vals, t, idxs);
+        DLIB_TEST(vals.size() == idxs.size());
+        for (size_t i = 0; i < idxs.size(); ++i)
+            DLIB_TEST(vals[i] == data[idxs[i]]);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_axis_reductions()
+    {
+        print_spinner();
+
+        resizable_tensor t(2,3,4,5);
+        tt::tensor_rand rnd;
+        rnd.fill_uniform(t);
+
+        const long dims[4] = {t.num_samples(), t.k(), t.nr(), t.nc()};
+        for (long axis = 0; axis < 4; ++axis)
+        {
+            long dsize[4] = {dims[0], dims[1], dims[2], dims[3]};
+            dsize[axis] = 1;
+            resizable_tensor dsum(dsize[0],dsize[1],dsize[2],dsize[3]);
+            resizable_tensor dmean(dsize[0],dsize[1],dsize[2],dsize[3]);
+            resizable_tensor dmax(dsize[0],dsize[1],dsize[2],dsize[3]);
+            resizable_tensor dargmax(dsize[0],dsize[1],dsize[2],dsize[3]);
+
+            tt::sum_axis(dsum, t, axis);
+            tt::mean_axis(dmean, t, axis);
+            tt::max_axis(dmax, t, axis);
+            tt::argmax_axis(dargmax, t, axis);
+
+            // compare against a naive host-side reduction
+            const float* s = t.host();
+            long outer = 1, inner = 1;
+            for (long i = 0; i < axis; ++i) outer *= dims[i];
+            for (long i = axis+1; i < 4; ++i) inner *= dims[i];
+            const long mid = dims[axis];
+            for (long o = 0; o < outer; ++o)
+            {
+                for (long i = 0; i < inner; ++i)
+                {
+                    float sum = 0, best = -10;
+                    long best_idx = 0;
+                    for (long m = 0; m < mid; ++m)
+                    {
+                        const float val = s[(o*mid + m)*inner + i];
+                        sum += val;
+                        if (val > best)
+                        {
+                            best = val;
+                            best_idx = m;
+                        }
+                    }
+                    DLIB_TEST(std::abs(dsum.host()[o*inner+i] - sum) < 1e-5);
+                    DLIB_TEST(std::abs(dmean.host()[o*inner+i] - sum/mid) < 1e-5);
+                    DLIB_TEST(dmax.host()[o*inner+i] == best);
+                    DLIB_TEST(dargmax.host()[o*inner+i] == best_idx);
+                }
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_data_augmentation()
+    {
+        print_spinner();
+        tt::tensor_rand rnd;
+        dlib::rand drnd;
+
+        resizable_tensor img(4,3,11,13);
+        float* d = img.host();
+        for (size_t i = 0; i < img.size(); ++i)
+            d[i] = drnd.get_random_double()*255;
+        const resizable_tensor orig = img;
+
+        // zero magnitudes make disturb_colors the identity transform
+        tt::disturb_colors(img, rnd, 0, 0);
+        DLIB_TEST(max(abs(mat(img)-mat(orig))) < 1e-3);
+
+        // with real magnitudes the output has to stay inside the pixel range
+        tt::disturb_colors(img, rnd);
+        DLIB_TEST(min(mat(img)) >= 0);
+        DLIB_TEST(max(mat(img)) <= 255 + 1e-3);
+
+        // check the cpu kernel against the math it is supposed to implement
+        img = orig;
+        resizable_tensor params(img.num_samples()*(img.k()+1));
+        rnd.fill_uniform(params);
+        cpu::disturb_colors(img, params, 0.5, 0.2);
+        const float* p = params.host();
+        const float* got = img.host();
+        const float* truth = orig.host();
+        for (long n = 0; n < img.num_samples(); ++n)
+        {
+            const float* pn = p + n*(img.k()+1);
+            const float gamma = std::max(0.0f, 1 + 0.5f*(pn[0]-0.5f));
+            float max_scale = 0;
+            for (long k = 0; k < img.k(); ++k)
+                max_scale = std::max(max_scale, 1 - pn[1+k]*0.2f);
+            for (long k = 0; k < img.k(); ++k)
+            {
+                const float scale = (1 - pn[1+k]*0.2f)/(255*max_scale);
+                for (long i = 0; i < img.nr()*img.nc(); ++i)
+                {
+                    const size_t idx = (n*img.k() + k)*img.nr()*img.nc() + i;
+                    const float expected = 255*std::pow(truth[idx]*scale, gamma);
+                    DLIB_TEST(std::abs(got[idx] - expected) < 1e-3);
+                }
+            }
+        }
+
+        // flipping: first and last samples should flip, the middle one shouldn't
+        resizable_tensor fimg(3,2,5,6);
+        d = fimg.host();
+        for (size_t i = 0; i < fimg.size(); ++i)
+            d[i] = drnd.get_random_double();
+        const resizable_tensor forig = fimg;
+        resizable_tensor fparams(3);
+        fparams.host()[0] = 0.0;
+        fparams.host()[1] = 0.9;
+        fparams.host()[2] = 0.2;
+        cpu::flip_images_left_right(fimg, fparams, 0.5);
+        for (long n = 0; n < fimg.num_samples(); ++n)
+        {
+            const bool flipped = (n != 1);
+            for (long k = 0; k < fimg.k(); ++k)
+            {
+                const float* a = fimg.host() + (n*fimg.k()+k)*fimg.nr()*fimg.nc();
+                const float* b = forig.host() + (n*fimg.k()+k)*fimg.nr()*fimg.nc();
+                for (long r = 0; r < fimg.nr(); ++r)
+                {
+                    for (long c = 0; c < fimg.nc(); ++c)
+                    {
+                        const long cc = flipped ? fimg.nc()-1-c : c;
+                        DLIB_TEST(a[r*fimg.nc()+c] == b[r*fimg.nc()+cc]);
+                    }
+                }
+            }
+        }
+
+        // flipping everything twice gets you back where you started, and a zero
+        // probability flips nothing.
+        fimg = forig;
+        tt::random_flip_images_left_right(fimg, rnd, 1.0);
+        tt::random_flip_images_left_right(fimg, rnd, 1.0);
+        DLIB_TEST(max(abs(mat(fimg)-mat(forig))) == 0);
+        tt::random_flip_images_left_right(fimg, rnd, 0.0);
+        DLIB_TEST(max(abs(mat(fimg)-mat(forig))) == 0);
+
+        // a crop with min_scale == 1 into an equally sized tensor is the identity
+        resizable_tensor cdest(img.num_samples(), img.k(), img.nr(), img.nc());
+        tt::random_crop_images(cdest, orig, rnd, 1.0);
+        DLIB_TEST(max(abs(mat(cdest)-mat(orig))) < 1e-4);
+
+        // check a random crop against a direct bilinear interpolation of the window
+        resizable_tensor cparams(orig.num_samples()*3);
+        rnd.fill_uniform(cparams);
+        resizable_tensor csmall(orig.num_samples(), orig.k(), 7, 8);
+        cpu::crop_images(csmall, orig, cparams, 0.6);
+        p = cparams.host();
+        for (long n = 0; n < csmall.num_samples(); ++n)
+        {
+            const float scale = 0.6f + p[n*3]*(1-0.6f);
+            const float h = scale*orig.nr();
+            const float w = scale*orig.nc();
+            const float y0 = p[n*3+1]*(orig.nr()-h);
+            const float x0 = p[n*3+2]*(orig.nc()-w);
+            const float y_scale = (h-1)/(csmall.nr()-1);
+            const float x_scale = (w-1)/(csmall.nc()-1);
+            for (long k = 0; k < csmall.k(); ++k)
+            {
+                const float* schan = orig.host() + (n*orig.k()+k)*orig.nr()*orig.nc();
+                const float* dchan = csmall.host() + (n*csmall.k()+k)*csmall.nr()*csmall.nc();
+                for (long r = 0; r < csmall.nr(); ++r)
+                {
+                    for (long c = 0; c < csmall.nc(); ++c)
+                    {
+                        const float y = y0 + r*y_scale;
+                        const float x = x0 + c*x_scale;
+                        const long top = (long)std::floor(y);
+                        const long left = (long)std::floor(x);
+                        const long bottom = std::min<long>(top+1, orig.nr()-1);
+                        const long right = std::min<long>(left+1, orig.nc()-1);
+                        const float tb = y-top;
+                        const float lr = x-left;
+                        const float expected =
+                            (1-tb)*((1-lr)*schan[top*orig.nc()+left]    + lr*schan[top*orig.nc()+right]) +
+                               tb *((1-lr)*schan[bottom*orig.nc()+left] + lr*schan[bottom*orig.nc()+right]);
+                        DLIB_TEST(std::abs(dchan[r*csmall.nc()+c] - expected) < 1e-2);
+                    }
+                }
+            }
+        }
+
+#ifdef DLIB_USE_CUDA
+        // the cuda kernels have to agree with the cpu ones
+        resizable_tensor img1 = orig, img2 = orig;
+        cpu::disturb_colors(img1, params, 0.5, 0.2);
+        cuda::disturb_colors(img2, params, 0.5, 0.2);
+        DLIB_TEST(max(abs(mat(img1)-mat(img2))) < 1e-3);
+
+        img1 = forig; img2 = forig;
+        cpu::flip_images_left_right(img1, fparams, 0.5);
+        cuda::flip_images_left_right(img2, fparams, 0.5);
+        DLIB_TEST(max(abs(mat(img1)-mat(img2))) == 0);
+
+        resizable_tensor out1(csmall), out2(csmall);
+        cpu::crop_images(out1, orig, cparams, 0.6);
+        cuda::crop_images(out2, orig, cparams, 0.6);
+        DLIB_TEST(max(abs(mat(out1)-mat(out2))) < 1e-3);
+#endif
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_fp16_tensor_serialization()
+    {
+        print_spinner();
+
+        // Every non-NaN half precision bit pattern must survive a round trip through
+        // float and back unchanged.
+        for (unsigned long i = 0; i < 65536; ++i)
+        {
+            const uint16 h = (uint16)i;
+            const bool is_nan = ((h>>10)&0x1f) == 0x1f && (h&0x3ff) != 0;
+            if (is_nan)
+            {
+                DLIB_TEST(std::isnan(fp16_to_float(h)));
+                continue;
+            }
+            DLIB_TEST(float_to_fp16(fp16_to_float(h)) == h);
+        }
+
+        // spot check the rounding and special cases
+        DLIB_TEST(fp16_to_float(float_to_fp16(1.0f)) == 1.0f);
+        DLIB_TEST(fp16_to_float(float_to_fp16(-2.25f)) == -2.25f);
+        DLIB_TEST(fp16_to_float(float_to_fp16(65504.0f)) == 65504.0f);      // largest half
+        DLIB_TEST(fp16_to_float(float_to_fp16(6.103515625e-05f)) == 6.103515625e-05f); // smallest normal half
+        DLIB_TEST(fp16_to_float(float_to_fp16(5.9604644775390625e-08f)) == 5.9604644775390625e-08f); // smallest subnormal half
+        DLIB_TEST(std::isinf(fp16_to_float(float_to_fp16(1e10f))));
+        DLIB_TEST(std::isnan(fp16_to_float(float_to_fp16(std::numeric_limits<float>::quiet_NaN()))));
+        // a tie rounds to the even neighbor
+        DLIB_TEST(fp16_to_float(float_to_fp16(1.0f + 3.0f/2048)) == 1.0f + 2.0f/1024);
+
+        // random values in the normal half range round trip to within half's epsilon
+        dlib::rand rnd;
+        for (int i = 0; i < 1000; ++i)
+        {
+            const float val = 100*(float)rnd.get_random_gaussian();
+            const float val2 = fp16_to_float(float_to_fp16(val));
+            DLIB_TEST_MSG(std::abs(val2-val) <= std::abs(val)/1024, val << " " << val2);
+        }
+
+        // half precision tensor serialization round trips with the expected accuracy
+        // and half the bytes of the regular float serialization.
+        resizable_tensor t1(4,3,5,6), t2;
+        t1 = matrix_cast<float>(gaussian_randm(t1.num_samples(), t1.k()*t1.nr()*t1.nc(), 0));
+
+        ostringstream sout, sout2;
+        serialize_fp16(t1, sout);
+        serialize(t1, sout2);
+        DLIB_TEST(sout.str().size() < sout2.str().size() - t1.size());
+
+        istringstream sin(sout.str());
+        deserialize_fp16(t2, sin);
+        DLIB_TEST(t2.num_samples() == t1.num_samples());
+        DLIB_TEST(t2.k() == t1.k());
+        DLIB_TEST(t2.nr() == t1.nr());
+        DLIB_TEST(t2.nc() == t1.nc());
+        DLIB_TEST(max(abs(mat(t1)-mat(t2))) <= max(abs(mat(t1)))/1024);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_input_yuv_image()
+    {
+        print_spinner();
+
+        const long nr = 8, nc = 10;
+        dlib::rand rnd;
+        std::vector<unsigned char> yplane(nr*nc);
+        std::vector<unsigned char> uplane((nr/2)*(nc/2));
+        std::vector<unsigned char> vplane((nr/2)*(nc/2));
+        for (auto& p : yplane) p = rnd.get_random_8bit_number();
+        for (auto& p : uplane) p = rnd.get_random_8bit_number();
+        for (auto& p : vplane) p = rnd.get_random_8bit_number();
+
+        // the same frame in NV12 layout
+        std::vector<unsigned char> uvplane((nr/2)*nc);
+        for (long i = 0; i < (long)uplane.size(); ++i)
+        {
+            uvplane[2*i] = uplane[i];
+            uvplane[2*i+1] = vplane[i];
+        }
+
+        yuv_image nv12;
+        nv12.y = yplane.data();
+        nv12.u = uvplane.data();
+        nv12.nr = nr;
+        nv12.nc = nc;
+        nv12.y_stride = nc;
+        nv12.uv_stride = nc;
+        nv12.layout = yuv_image::NV12;
+
+        yuv_image i420;
+        i420.y = yplane.data();
+        i420.u = uplane.data();
+        i420.v = vplane.data();
+        i420.nr = nr;
+        i420.nc = nc;
+        i420.y_stride = nc;
+        i420.uv_stride = nc/2;
+        i420.layout = yuv_image::I420;
+
+        input_yuv_image layer;
+        std::vector<yuv_image> frames = {nv12, i420};
+        resizable_tensor data;
+        layer.to_tensor(frames.begin(), frames.end(), data);
+        DLIB_TEST(data.num_samples() == 2);
+        DLIB_TEST(data.k() == 3);
+        DLIB_TEST(data.nr() == nr);
+        DLIB_TEST(data.nc() == nc);
+
+        // both layouts describe the same frame so they must produce the same tensor
+        const float* d = data.host();
+        const size_t frame_size = 3*nr*nc;
+        for (size_t i = 0; i < frame_size; ++i)
+            DLIB_TEST(d[i] == d[frame_size+i]);
+
+        // check against a scalar BT.601 reference
+        const size_t offset = nr*nc;
+        for (long r = 0; r < nr; ++r)
+        {
+            for (long c = 0; c < nc; ++c)
+            {
+                const float yv = yplane[r*nc+c];
+                const float u0 = uplane[(r/2)*(nc/2) + c/2] - 128.0f;
+                const float v0 = vplane[(r/2)*(nc/2) + c/2] - 128.0f;
+                const float red   = yv + 1.402f*v0;
+                const float green = yv - 0.344136f*u0 - 0.714136f*v0;
+                const float blue  = yv + 1.772f*u0;
+                DLIB_TEST(std::abs(d[r*nc+c]            - (red   - layer.get_avg_red())/256.0f) < 1e-5);
+                DLIB_TEST(std::abs(d[offset + r*nc+c]   - (green - layer.get_avg_green())/256.0f) < 1e-5);
+                DLIB_TEST(std::abs(d[2*offset + r*nc+c] - (blue  - layer.get_avg_blue())/256.0f) < 1e-5);
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_inference_batcher()
+    {
+        print_spinner();
+        typedef loss_multiclass_log<fc<3,relu<fc<8,input<matrix<float>>>>>> net_type;
+        net_type net;
+        // run one sample through to force the layers to allocate their parameters
+        matrix<float> tmp(4,1);
+        tmp = 0;
+        net(tmp);
+
+        dlib::rand rnd;
+        std::vector<matrix<float>> samples;
+        for (int i = 0; i < 200; ++i)
+        {
+            matrix<float> s(4,1);
+            for (long j = 0; j < s.size(); ++j)
+                s(j) = rnd.get_random_gaussian();
+            samples.push_back(s);
+        }
+        net_type net_copy = net;
+        const auto expected = net_copy(samples, samples.size());
+
+        dnn_inference_batcher<net_type> batcher(net, 16, 3);
+        DLIB_TEST(batcher.get_max_batch_size() == 16);
+        DLIB_TEST(batcher.get_max_latency() == 3);
+
+        // hit the batcher from several threads at once and make sure everyone gets
+        // the same answers a plain synchronous forward pass would have produced.
+        std::atomic<int> num_wrong(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&,t]()
+            {
+                for (size_t i = t; i < samples.size(); i += 4)
+                {
+                    auto fut = batcher.enqueue(samples[i]);
+                    if (fut.get() != expected[i])
+                        ++num_wrong;
+                }
+            });
+        }
+        for (auto& th : threads)
+            th.join();
+        DLIB_TEST(num_wrong == 0);
+
+        // and the blocking convenience form
+        DLIB_TEST(batcher(samples[0]) == expected[0]);
     }
 
 // ----------------------------------------------------------------------------------------
@@ -3354,6 +4298,8 @@ namespace
             test_tensor_resize_bilinear(2, 3, 6,6, 11, 11);
             test_tensor_resize_bilinear(2, 3, 6,6, 3, 4);
             test_tensor_resize_bilinear(2, 3, 5,6, 12, 21);
+            test_tensor_extract_image_chips();
+            test_tensor_arena();
             test_max_pool(1,1,2,3,0,0);
             test_max_pool(3,3,1,1,0,0);
             test_max_pool(3,3,2,2,0,0);
@@ -3387,6 +4333,10 @@ namespace
             test_basic_tensor_ops();
             test_layers();
             test_visit_functions();
+            test_int8_inference();
+            test_input_cached();
+            test_net_memory_report();
+            test_sparse_solver_updates();
             test_copy_tensor_cpu();
             test_copy_tensor_add_to_cpu();
             test_concat();
@@ -3403,8 +4353,15 @@ namespace
             test_loss_multiclass_per_pixel_weighted();
             test_serialization();
             test_loss_dot();
+            test_trainer_prefetch();
             test_loss_multimulticlass_log();
             test_loss_mmod();
+            test_find_greater_than();
+            test_axis_reductions();
+            test_data_augmentation();
+            test_input_yuv_image();
+            test_fp16_tensor_serialization();
+            test_inference_batcher();
         }
 
         void perform_test()
@@ -208,6 +208,57 @@ namespace
 
 
 
+        void test_fill_lisf_blocked()
+        {
+            typedef matrix<double,0,1> sample_type;
+            typedef radial_basis_kernel<sample_type> kernel_type;
+            const kernel_type kern(0.5);
+
+            print_spinner();
+            std::vector<sample_type> samples;
+            for (int i = 0; i < 300; ++i)
+            {
+                samples.push_back(randm(6,1,rnd));
+                // throw in duplicates so some candidates are exactly dependent
+                if (i%7 == 0)
+                    samples.push_back(samples.back());
+            }
+
+            // With block_size == 1 the blocked fill degenerates to offering every
+            // sample to add() in order, so it must build the same dictionary as
+            // doing that ourselves.
+            linearly_independent_subset_finder<kernel_type> lisf_ref(kern, 50, 1e-3);
+            unsigned long count_ref = 0;
+            for (unsigned long i = 0; i < samples.size(); ++i)
+            {
+                if (lisf_ref.add(samples[i]))
+                    ++count_ref;
+            }
+            linearly_independent_subset_finder<kernel_type> lisf1(kern, 50, 1e-3);
+            const unsigned long count1 = fill_lisf_blocked(lisf1, samples, 1);
+            DLIB_TEST(count1 == count_ref);
+            DLIB_TEST(lisf1.size() == lisf_ref.size());
+            for (unsigned long i = 0; i < lisf1.size(); ++i)
+                DLIB_TEST(equal(lisf1[i], lisf_ref[i]));
+
+            print_spinner();
+            // A bigger block must still produce a dictionary with all the usual
+            // invariants, and since the dictionary isn't capped here every sample
+            // must end up represented to within the tolerance.
+            linearly_independent_subset_finder<kernel_type> lisf2(kern, samples.size(), 1e-3);
+            const unsigned long count2 = fill_lisf_blocked(lisf2, samples, 64);
+            DLIB_TEST(count2 == lisf2.size());
+            DLIB_TEST(lisf2.size() > 0);
+            DLIB_TEST(dlib::equal(lisf2.get_kernel_matrix(), kernel_matrix(kern, lisf2), 1e-8));
+            // The kernel matrix of a few hundred RBF basis vectors is fairly ill
+            // conditioned, so check the inverse via the identity product rather than
+            // against a dense inv() at tight absolute tolerance.
+            DLIB_TEST(dlib::equal(lisf2.get_inv_kernel_marix()*lisf2.get_kernel_matrix(),
+                                  identity_matrix<double>(lisf2.size()), 1e-4));
+            for (unsigned long i = 0; i < samples.size(); ++i)
+                DLIB_TEST(lisf2.projection_error(samples[i]) <= 1e-3 + 1e-8);
+        }
+
         void perform_test (
         )
         {
@@ -291,6 +342,7 @@ namespace
 
 
             test_transformation_stuff();
+            test_fill_lisf_blocked();
 
         }
     };
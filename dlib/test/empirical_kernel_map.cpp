@@ -413,6 +413,50 @@ namespace
             }
         }
 
+        void test_batch_projection_and_float_conversion()
+        {
+            typedef matrix<double,0,1> sample_type;
+            typedef matrix<float,0,1> fsample_type;
+            typedef radial_basis_kernel<sample_type> kernel_type;
+            typedef radial_basis_kernel<fsample_type> fkernel_type;
+            const kernel_type kern(0.2);
+
+            empirical_kernel_map<kernel_type> ekm;
+
+            std::vector<sample_type> samples;
+            const int num = rnd.get_random_8bit_number()%50 + 1;
+            for (int i = 0; i < num; ++i)
+                samples.push_back(randm(5,1,rnd));
+
+            ekm.load(kern, samples);
+
+            std::vector<sample_type> test_samples;
+            for (int i = 0; i < 30; ++i)
+                test_samples.push_back(randm(5,1,rnd));
+
+            // project_batch should give exactly what project gives, just all at once
+            const matrix<double> M = ekm.project_batch(test_samples);
+            DLIB_TEST(M.nr() == ekm.out_vector_size());
+            DLIB_TEST(M.nc() == (long)test_samples.size());
+            for (unsigned long i = 0; i < test_samples.size(); ++i)
+            {
+                const double err = max(abs(colm(M,i) - ekm.project(test_samples[i])));
+                DLIB_TEST_MSG(err < 1e-10, err);
+            }
+
+            // converting to a single precision map should give nearly the same projections
+            empirical_kernel_map<fkernel_type> fekm;
+            ekm.convert_to(fkernel_type(0.2f), fekm);
+            DLIB_TEST(fekm.out_vector_size() == ekm.out_vector_size());
+            DLIB_TEST(fekm.basis_size() == ekm.basis_size());
+            for (unsigned long i = 0; i < test_samples.size(); ++i)
+            {
+                const fsample_type fsamp = matrix_cast<float>(test_samples[i]);
+                const double err = max(abs(matrix_cast<float>(ekm.project(test_samples[i])) - fekm.project(fsamp)));
+                DLIB_TEST_MSG(err < 1e-2, err);
+            }
+        }
+
         void perform_test (
         )
         {
@@ -424,6 +468,8 @@ namespace
             print_spinner();
             test_projection_error();
             print_spinner();
+            test_batch_projection_and_float_conversion();
+            print_spinner();
             dlog << LINFO << "test with linear kernel";
             test_with_kernel(linear_kernel<sample_type>());
             print_spinner();
@@ -72,10 +72,106 @@ namespace
 
             print_spinner();
 
+            // Fine-tuning an existing model should keep its cascades, append
+            // get_num_fine_tuning_cascades() new ones, and still fit the data.
+            shape_predictor sp_tuned = trainer.train(images, objects, sp);
+            DLIB_TEST(sp_tuned.get_forests().size() == sp.get_forests().size()+trainer.get_num_fine_tuning_cascades());
+            DLIB_TEST(test_shape_predictor(sp_tuned, images, objects) == 0);
+
+            print_spinner();
+
+            // Test checkpointing.  Train a small model while saving checkpoints, then
+            // deepen the cascade and train again.  The second run must resume from the
+            // checkpoint, so its first cascades have to be bit for bit identical to the
+            // small model's.
+            const std::string checkpoint_filename = "shape_predictor_checkpoint_test.dat";
+            remove(checkpoint_filename.c_str());
+            shape_predictor_trainer trainer2;
+            trainer2.set_tree_depth(2);
+            trainer2.set_nu(0.05);
+            trainer2.set_num_trees_per_cascade_level(50);
+            trainer2.set_cascade_depth(3);
+            trainer2.set_checkpoint_file(checkpoint_filename);
+            shape_predictor sp_small = trainer2.train(images, objects);
+            print_spinner();
+            trainer2.set_cascade_depth(6);
+            shape_predictor sp_deep = trainer2.train(images, objects);
+            DLIB_TEST(sp_deep.get_forests().size() == 6);
+            {
+                ostringstream sout1, sout2;
+                serialize(sp_small.get_forests(), sout1);
+                const std::vector<std::vector<dlib::impl::regression_tree> > prefix(
+                    sp_deep.get_forests().begin(), sp_deep.get_forests().begin()+3);
+                serialize(prefix, sout2);
+                DLIB_TEST(sout1.str() == sout2.str());
+            }
+            print_spinner();
+            // Resuming from the checkpoint of a finished run shouldn't redo any work
+            // and must reproduce the model exactly.
+            shape_predictor sp_deep2 = trainer2.train(images, objects);
+            {
+                ostringstream sout1, sout2;
+                serialize(sp_deep, sout1);
+                serialize(sp_deep2, sout2);
+                DLIB_TEST(sout1.str() == sout2.str());
+            }
+            remove(checkpoint_filename.c_str());
+
+            print_spinner();
+
             // While we are here, make sure the default face detector works
             std::vector<rectangle> dets = detector(images[0]);
             DLIB_TEST(dets.size() == 3);
 
+            print_spinner();
+
+            // The batched overload must give exactly the same landmarks as one call
+            // per box.
+            std::vector<full_object_detection> batched = sp(images[0], dets);
+            DLIB_TEST(batched.size() == dets.size());
+            for (unsigned long j = 0; j < dets.size(); ++j)
+            {
+                const full_object_detection ref = sp(images[0], dets[j]);
+                DLIB_TEST(batched[j].get_rect() == ref.get_rect());
+                DLIB_TEST(batched[j].num_parts() == ref.num_parts());
+                for (unsigned long k = 0; k < ref.num_parts(); ++k)
+                    DLIB_TEST(batched[j].part(k) == ref.part(k));
+            }
+
+            print_spinner();
+
+            // Saving the model in the mapped format and loading it back must give
+            // exactly the same detections as the regular shape_predictor.
+            const std::string mapped_filename = "mapped_shape_predictor_test.dat";
+            save_mapped_shape_predictor(sp, mapped_filename);
+            mapped_shape_predictor msp(mapped_filename);
+            DLIB_TEST(msp.is_loaded());
+            DLIB_TEST(msp.num_parts() == sp.num_parts());
+            for (unsigned long j = 0; j < dets.size(); ++j)
+            {
+                const full_object_detection ref = sp(images[0], dets[j]);
+                const full_object_detection mapped = msp(images[0], dets[j]);
+                DLIB_TEST(mapped.get_rect() == ref.get_rect());
+                DLIB_TEST(mapped.num_parts() == ref.num_parts());
+                for (unsigned long k = 0; k < ref.num_parts(); ++k)
+                    DLIB_TEST(mapped.part(k) == ref.part(k));
+            }
+            remove(mapped_filename.c_str());
+
+            // Loading something that isn't a mapped model must throw rather than
+            // produce a predictor.
+            {
+                const std::string bogus_filename = "mapped_shape_predictor_bogus.dat";
+                ofstream fout(bogus_filename.c_str(), ios::binary);
+                fout << "this is not a mapped shape predictor model";
+                fout.close();
+                bool saw_error = false;
+                try { mapped_shape_predictor bad(bogus_filename); }
+                catch (serialization_error&) { saw_error = true; }
+                DLIB_TEST(saw_error);
+                remove(bogus_filename.c_str());
+            }
+
 
             /*
             // visualize the detections
@@ -96,6 +96,43 @@ namespace
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_fft_plan()
+    {
+        // a single plan gets reused across many sizes and directions, so make sure its
+        // cached state always produces exactly what the global routines produce.
+        fft_plan<double> plan;
+        fft_plan<float> fplan;
+        for (int iter = 0; iter < 3; ++iter)
+        {
+            print_spinner();
+            for (int nr = 1; nr <= 64; nr*=2)
+            {
+                for (int nc = 1; nc <= 64; nc *= 2)
+                {
+                    const matrix<complex<double> > m1 = rand_complex(nr,nc);
+                    const matrix<complex<float> > fm1 = matrix_cast<complex<float> >(rand_complex(nr,nc));
+
+                    matrix<complex<double> > temp = m1, temp2 = m1;
+                    matrix<complex<float> > ftemp = fm1, ftemp2 = fm1;
+                    fft_inplace(temp);
+                    plan.fft_inplace(temp2);
+                    fft_inplace(ftemp);
+                    fplan.fft_inplace(ftemp2);
+                    DLIB_TEST(max(norm(temp-temp2)) == 0);
+                    DLIB_TEST(max(norm(ftemp-ftemp2)) == 0);
+                    ifft_inplace(temp);
+                    plan.ifft_inplace(temp2);
+                    ifft_inplace(ftemp);
+                    fplan.ifft_inplace(ftemp2);
+                    DLIB_TEST(max(norm(temp-temp2)) == 0);
+                    DLIB_TEST(max(norm(ftemp-ftemp2)) == 0);
+                }
+            }
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <long nr, long nc>
@@ -171,6 +208,7 @@ namespace
             test_against_saved_good_ffts();
             test_random_ffts();
             test_random_real_ffts();
+            test_fft_plan();
         }
     } a;
 
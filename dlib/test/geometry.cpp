@@ -11,6 +11,7 @@
 #include <dlib/matrix.h>
 #include <dlib/rand.h>
 #include <dlib/array2d.h>
+#include <dlib/image_processing/box_overlap_testing.h>
 #include <dlib/image_transforms.h>
 
 #include "tester.h"
@@ -662,6 +663,34 @@ namespace
         DLIB_TEST(max(abs(t2.get_b()-t.get_b())) < 1e-14);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_transform_points()
+    {
+        dlib::rand rnd;
+        for (int iter = 0; iter < 10; ++iter)
+        {
+            matrix<double,2,2> m = randm(2,2,rnd);
+            const point_transform_affine tform(m, dlib::vector<double,2>(rnd.get_random_gaussian(), rnd.get_random_gaussian()));
+
+            // sizes around the simd block width, including 0 and a tail
+            std::vector<dlib::vector<float,2> > pts(rnd.get_random_32bit_number()%50);
+            for (auto& p : pts)
+                p = dlib::vector<float,2>(rnd.get_random_float()*100, rnd.get_random_float()*100);
+
+            std::vector<dlib::vector<float,2> > out;
+            transform_points(tform, pts, out);
+            DLIB_TEST(out.size() == pts.size());
+            for (unsigned long i = 0; i < pts.size(); ++i)
+                DLIB_TEST(length(tform(pts[i]) - out[i]) < 1e-3);
+
+            // in-place version must match
+            transform_points(tform, pts);
+            for (unsigned long i = 0; i < pts.size(); ++i)
+                DLIB_TEST(pts[i] == out[i]);
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     double projective_transform_pass_rate(const double error_rate)
@@ -882,6 +911,71 @@ namespace
 
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_rectangle_batch()
+    {
+        print_spinner();
+        dlib::rand rnd;
+
+        // random boxes, including some empty ones, with sizes that exercise both the
+        // full SIMD chunks and the scalar tails.
+        std::vector<rectangle> a, b;
+        for (int i = 0; i < 13; ++i)
+        {
+            const long x = (long)rnd.get_random_32bit_number()%100;
+            const long y = (long)rnd.get_random_32bit_number()%100;
+            a.push_back(rectangle(x, y, x+(long)(rnd.get_random_32bit_number()%40)-3,
+                                        y+(long)(rnd.get_random_32bit_number()%40)-3));
+        }
+        for (int i = 0; i < 27; ++i)
+        {
+            const long x = (long)rnd.get_random_32bit_number()%100;
+            const long y = (long)rnd.get_random_32bit_number()%100;
+            b.push_back(rectangle(x, y, x+(long)(rnd.get_random_32bit_number()%40)-3,
+                                        y+(long)(rnd.get_random_32bit_number()%40)-3));
+        }
+
+        const rectangle_batch ba(a), bb(b);
+        DLIB_TEST(ba.size() == a.size());
+        for (size_t i = 0; i < a.size(); ++i)
+            DLIB_TEST(ba[i] == a[i]);
+
+        const matrix<float> iou = intersection_over_union_matrix(ba, bb);
+        DLIB_TEST(iou.nr() == (long)a.size());
+        DLIB_TEST(iou.nc() == (long)b.size());
+        for (long r = 0; r < iou.nr(); ++r)
+        {
+            for (long c = 0; c < iou.nc(); ++c)
+            {
+                const double truth = box_intersection_over_union(a[r], b[c]);
+                DLIB_TEST_MSG(std::abs(iou(r,c) - truth) < 1e-6,
+                    "iou: " << iou(r,c) << "  truth: " << truth);
+            }
+        }
+        const matrix<float> iou2 = box_intersection_over_union(a, b);
+        DLIB_TEST(iou2 == iou);
+
+        std::vector<float> areas;
+        batch_area(ba, areas);
+        DLIB_TEST(areas.size() == a.size());
+        for (size_t i = 0; i < a.size(); ++i)
+            DLIB_TEST(areas[i] == (float)a[i].area());
+
+        const point p(50, 50);
+        std::vector<unsigned char> hits;
+        batch_contains(bb, p, hits);
+        DLIB_TEST(hits.size() == b.size());
+        for (size_t i = 0; i < b.size(); ++i)
+            DLIB_TEST(hits[i] == (b[i].contains(p) ? 1 : 0));
+
+        // empty batches shouldn't trip anything up
+        const rectangle_batch empty;
+        DLIB_TEST(intersection_over_union_matrix(empty, bb).nr() == 0);
+        batch_area(empty, areas);
+        DLIB_TEST(areas.size() == 0);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     class geometry_tester : public tester
@@ -901,6 +995,7 @@ namespace
             geometry_test();
             test_border_enumerator();
             test_find_affine_transform();
+            test_transform_points();
             DLIB_TEST(projective_transform_pass_rate(0.1) > 0.99);
             DLIB_TEST(projective_transform_pass_rate(0.0) == 1);
 
@@ -909,6 +1004,7 @@ namespace
             test_find_similarity_transform<float>(); 
             test_find_similarity_transform2<float>(); 
             test_line();
+            test_rectangle_batch();
         }
     } a;
 
@@ -9,6 +9,8 @@
 #include <cstdlib>
 #include <ctime>
 #include <vector>
+#include <atomic>
+#include <functional>
 #include <dlib/rand.h>
 
 #include "tester.h"
@@ -274,6 +276,240 @@ namespace
         DLIB_TEST_MSG(std::abs(result.y  + 21.9210397) < 0.0001, std::abs(result.y  + 21.9210397));
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_find_max_global_concurrent(
+    )
+    {
+        print_spinner();
+
+        // Run the optimization through a thread pool and make sure it keeps multiple
+        // objective function evaluations in flight at once.  The objective sleeps a
+        // little so evaluations overlap in time even on a lightly loaded machine.
+        std::atomic<int> num_in_flight(0), max_in_flight(0);
+        auto rosen = [&](const matrix<double,0,1>& x)
+        {
+            const int cur = ++num_in_flight;
+            int prev = max_in_flight;
+            while (prev < cur && !max_in_flight.compare_exchange_weak(prev, cur))
+                ;
+            dlib::sleep(10);
+            --num_in_flight;
+            return -1*( 100*std::pow(x(1) - x(0)*x(0),2.0) + std::pow(1 - x(0),2));
+        };
+
+        thread_pool tp(4);
+        auto result = find_max_global(tp, rosen, {0.1, 0.1}, {2, 2}, max_function_calls(100), 0);
+        matrix<double,0,1> true_x = {1,1};
+
+        dlog << LINFO << "concurrent rosen: " <<  trans(result.x);
+        dlog << LINFO << "max evals in flight: " << max_in_flight;
+        // The tolerance here is looser than in the single threaded tests because points
+        // evaluated concurrently are picked without knowledge of the evaluations still in
+        // flight, so each call contributes a little less to the search.
+        DLIB_TEST_MSG(max(abs(true_x-result.x)) < 1e-2, max(abs(true_x-result.x)));
+        DLIB_TEST(num_in_flight == 0);
+        DLIB_TEST_MSG(max_in_flight > 1, max_in_flight);
+        print_spinner();
+
+        // also exercise the multi-function form with a thread pool
+        auto neg_rosen = [](const matrix<double,0,1>& x) { return +1*( 100*std::pow(x(1) - x(0)*x(0),2.0) + std::pow(1 - x(0),2)); };
+        auto quadratic = [](const matrix<double,0,1>& x) { return std::pow(x(0)-2,2.0); };
+        std::vector<std::function<double(const matrix<double,0,1>&)>> functions = {neg_rosen, quadratic};
+        std::vector<function_spec> specs;
+        specs.emplace_back(matrix<double,0,1>({0.1, 0.1}), matrix<double,0,1>({2, 2}));
+        specs.emplace_back(matrix<double,0,1>({-10.0}), matrix<double,0,1>({10.0}));
+        auto result2 = find_min_global(tp, functions, specs, max_function_calls(100), FOREVER, 0);
+
+        dlog << LINFO << "concurrent multi-function best idx: " << result2.first << "  y: " << result2.second.y;
+        DLIB_TEST(result2.second.y < 1e-5);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_serialization(
+    )
+    {
+        print_spinner();
+
+        function_spec spec{{-10,-10}, {10,10}};
+        function_spec spec2{{-10,-10, -50}, {10,10, 50}};
+        global_function_search opt({spec, spec2});
+        opt.set_pure_random_search_probability(0.1);
+        opt.set_monte_carlo_upper_bound_sample_num(1000);
+
+        auto evaluate = [](function_evaluation_request& next)
+        {
+            if (next.function_idx() == 0)
+                next.set(-complex_holder_table(next.x()(0), next.x()(1)));
+            else
+                next.set(-2*complex_holder_table(next.x()(0), next.x()(1)));
+        };
+
+        for (int i = 0; i < 40; ++i)
+        {
+            auto next = opt.get_next_x();
+            evaluate(next);
+        }
+
+        // Serialize while a request is outstanding.  The outstanding request isn't
+        // saved, so the restored search should act like it was never issued.
+        ostringstream sout;
+        {
+            auto outstanding = opt.get_next_x();
+            serialize(opt, sout);
+        }
+
+        global_function_search opt2;
+        istringstream sin(sout.str());
+        deserialize(opt2, sin);
+
+        DLIB_TEST(opt2.num_functions() == 2);
+        DLIB_TEST(opt2.get_pure_random_search_probability() == 0.1);
+        DLIB_TEST(opt2.get_monte_carlo_upper_bound_sample_num() == 1000);
+
+        // the restored search should have exactly the same function specs and
+        // evaluations as the original
+        std::vector<function_spec> specs1, specs2;
+        std::vector<std::vector<function_evaluation>> evals1, evals2;
+        opt.get_function_evaluations(specs1, evals1);
+        opt2.get_function_evaluations(specs2, evals2);
+        DLIB_TEST(specs1.size() == specs2.size());
+        for (size_t i = 0; i < specs1.size(); ++i)
+        {
+            DLIB_TEST(max(abs(specs1[i].lower - specs2[i].lower)) == 0);
+            DLIB_TEST(max(abs(specs1[i].upper - specs2[i].upper)) == 0);
+            DLIB_TEST(specs1[i].is_integer_variable == specs2[i].is_integer_variable);
+            DLIB_TEST(evals1[i].size() == evals2[i].size());
+            for (size_t j = 0; j < evals1[i].size(); ++j)
+            {
+                DLIB_TEST(max(abs(evals1[i][j].x - evals2[i][j].x)) == 0);
+                DLIB_TEST(evals1[i][j].y == evals2[i][j].y);
+            }
+        }
+
+        matrix<double,0,1> x1, x2;
+        double y1, y2;
+        size_t idx1, idx2;
+        opt.get_best_function_eval(x1,y1,idx1);
+        opt2.get_best_function_eval(x2,y2,idx2);
+        DLIB_TEST(idx1 == idx2);
+        DLIB_TEST(y1 == y2);
+        DLIB_TEST(max(abs(x1-x2)) == 0);
+
+        // most importantly, the restored search should keep optimizing just like the
+        // original would have
+        bool found_optimal_point = false;
+        for (int i = 0; i < 400 && !found_optimal_point; ++i)
+        {
+            print_spinner();
+            auto next = opt2.get_next_x();
+            evaluate(next);
+
+            opt2.get_best_function_eval(x2,y2,idx2);
+            if (std::abs(y2 - 2*21.9210397) < 0.0001)
+                found_optimal_point = true;
+        }
+        DLIB_TEST(found_optimal_point);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_distributed_search(
+    )
+    {
+        print_spinner();
+
+        // The "remote" machine's side of things.  It evaluates both functions being
+        // optimized, dispatching on the function index.
+        auto worker_funct = [](size_t function_idx, const matrix<double,0,1>& x) -> double
+        {
+            if (function_idx == 0)
+                return -1*( 100*std::pow(x(1) - x(0)*x(0),2.0) + std::pow(1 - x(0),2));
+            else
+                return 1 - std::pow(x(0)-2,2.0);
+        };
+
+        const unsigned short port1 = 41239;
+        const unsigned short port2 = 41240;
+        global_function_search_worker worker1(worker_funct, port1);
+        global_function_search_worker worker2(worker_funct, port2);
+
+        function_spec spec_rosen({0.1, 0.1}, {2, 2});
+        function_spec spec_quadratic({-10}, {10});
+        global_function_search opt({spec_rosen, spec_quadratic});
+
+        ostringstream sout;
+        {
+            global_function_search_controller controller(opt);
+            controller.add_worker(network_address("127.0.0.1", port1));
+            controller.add_worker(network_address("127.0.0.1", port2));
+            DLIB_TEST(controller.num_workers() == 2);
+
+            controller.execute(60);
+            // checkpoint the search mid-way, like a long running job would
+            serialize(opt, sout);
+        }
+        print_spinner();
+
+        // restore the checkpoint and finish the search with a fresh controller, which
+        // also makes the workers go through a disconnect/reconnect cycle.
+        global_function_search opt2;
+        istringstream sin(sout.str());
+        deserialize(opt2, sin);
+        {
+            global_function_search_controller controller(opt2);
+            controller.add_worker(network_address("127.0.0.1", port1));
+            controller.add_worker(network_address("127.0.0.1", port2));
+            controller.execute(90);
+        }
+        print_spinner();
+
+        matrix<double,0,1> x;
+        double y;
+        size_t function_idx;
+        opt2.get_best_function_eval(x,y,function_idx);
+        dlog << LINFO << "distributed search best idx: " << function_idx << "  y: " << y << "  x: " << trans(x);
+        // the quadratic has the larger maximum, 1 at x==2
+        DLIB_TEST(function_idx == 1);
+        DLIB_TEST_MSG(std::abs(y - 1) < 1e-3, y);
+        DLIB_TEST_MSG(std::abs(x(0) - 2) < 1e-1, x(0));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+#ifdef DLIB_USE_CUDA
+    // We can only test the batched device objective interface when CUDA is available.
+    void test_batched_search(
+    )
+    {
+        print_spinner();
+
+        // The objective pulls the candidate batch off the device, scores it on the host,
+        // and pushes the scores back.  A real user would run a kernel here instead, but
+        // this exercises the whole batching contract either way.
+        size_t num_batches = 0;
+        auto dev_rosen = [&](const cuda::cuda_data_ptr<const double>& xs, cuda::cuda_data_ptr<double>& ys)
+        {
+            std::vector<double> x;
+            memcpy(x, xs);
+            DLIB_TEST(x.size() == 2*ys.size());
+            std::vector<double> y(ys.size());
+            for (size_t k = 0; k < y.size(); ++k)
+                y[k] = 100*std::pow(x[2*k+1] - x[2*k]*x[2*k], 2.0) + std::pow(1 - x[2*k], 2.0);
+            memcpy(ys, y);
+            ++num_batches;
+        };
+
+        auto result = find_min_global_batched(dev_rosen, {-10, -10}, {10, 10}, max_function_calls(400), 8);
+        dlog << LINFO << "batched search found y: " << result.y << "  x: " << trans(result.x);
+        DLIB_TEST(num_batches == 400/8);
+        DLIB_TEST_MSG(std::abs(result.y) < 1e-4, result.y);
+        DLIB_TEST_MSG(std::abs(result.x(0) - 1) < 1e-2, result.x(0));
+        DLIB_TEST_MSG(std::abs(result.x(1) - 1) < 1e-2, result.x(1));
+    }
+#endif // DLIB_USE_CUDA
+
 // ----------------------------------------------------------------------------------------
 
     class global_optimization_tester : public tester
@@ -294,6 +530,12 @@ namespace
             test_global_function_search();
             test_find_max_global();
             test_find_min_global();
+            test_find_max_global_concurrent();
+            test_serialization();
+            test_distributed_search();
+#ifdef DLIB_USE_CUDA
+            test_batched_search();
+#endif
         }
     } a;
 
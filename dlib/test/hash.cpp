@@ -157,6 +157,89 @@ namespace
         }
     }
 
+    void test_murmur_hash_128_stream()
+    {
+        dlib::rand rnd;
+        for (int i = 0; i < 100; ++i)
+        {
+            const unsigned long len = rnd.get_random_32bit_number()%2000;
+            std::vector<unsigned char> buf(len);
+            for (auto& b : buf)
+                b = rnd.get_random_8bit_number();
+
+            const uint64 seed = rnd.get_random_64bit_number();
+            const std::pair<uint64,uint64> expected = murmur_hash3_128bit(buf.data(), len, seed);
+
+            // Feed the buffer to the streaming hasher in randomly sized chunks and
+            // make sure we get the same hash as the one-shot version.
+            murmur_hash3_128bit_stream hasher(seed);
+            unsigned long pos = 0;
+            while (pos < len)
+            {
+                const unsigned long chunk = std::min<unsigned long>(len-pos, rnd.get_random_32bit_number()%40);
+                hasher.add(buf.data()+pos, chunk);
+                pos += chunk;
+            }
+            DLIB_TEST(hasher.size() == len);
+            std::pair<uint64,uint64> temp = hasher.get_hash();
+            DLIB_TEST(temp.first == expected.first);
+            DLIB_TEST(temp.second == expected.second);
+
+            // get_hash() shouldn't disturb the stream, so hashing more data after
+            // calling it must work as if it was never called.
+            hasher.add(buf.data(), len);
+            std::vector<unsigned char> buf2 = buf;
+            buf2.insert(buf2.end(), buf.begin(), buf.end());
+            temp = hasher.get_hash();
+            const std::pair<uint64,uint64> expected2 = murmur_hash3_128bit(buf2.data(), 2*len, seed);
+            DLIB_TEST(temp.first == expected2.first);
+            DLIB_TEST(temp.second == expected2.second);
+
+            // clear() should put us back into the initial state.
+            hasher.clear(seed);
+            hasher.add(buf.data(), len);
+            temp = hasher.get_hash();
+            DLIB_TEST(temp.first == expected.first);
+            DLIB_TEST(temp.second == expected.second);
+        }
+    }
+
+    void test_fast_hash_128()
+    {
+        dlib::rand rnd;
+        for (int i = 0; i < 100; ++i)
+        {
+            const unsigned long len = rnd.get_random_32bit_number()%300;
+            std::vector<unsigned char> buf(len+1);
+            for (auto& b : buf)
+                b = rnd.get_random_8bit_number();
+
+            // The hash value isn't portable so all we can check is that it's a
+            // deterministic function of its inputs.
+            const std::pair<uint64,uint64> h1 = fast_hash_128bit(buf.data(), len, 0);
+            const std::pair<uint64,uint64> h2 = fast_hash_128bit(buf.data(), len, 0);
+            DLIB_TEST(h1.first == h2.first && h1.second == h2.second);
+
+            // different seeds should give different hashes
+            const std::pair<uint64,uint64> h3 = fast_hash_128bit(buf.data(), len, 1);
+            DLIB_TEST(h1.first != h3.first || h1.second != h3.second);
+
+            // flipping a byte should change the hash
+            buf[len/2] ^= 0x40;
+            const std::pair<uint64,uint64> h4 = fast_hash_128bit(buf.data(), len/2+1, 0);
+            const std::pair<uint64,uint64> h5 = fast_hash_128bit(buf.data(), len/2+1, 0);
+            DLIB_TEST(h4.first == h5.first && h4.second == h5.second);
+            buf[len/2] ^= 0x40;
+            const std::pair<uint64,uint64> h6 = fast_hash_128bit(buf.data(), len/2+1, 0);
+            DLIB_TEST(h4.first != h6.first || h4.second != h6.second);
+
+            // appending a zero byte should change the hash
+            buf[len] = 0;
+            const std::pair<uint64,uint64> h7 = fast_hash_128bit(buf.data(), len+1, 0);
+            DLIB_TEST(h1.first != h7.first || h1.second != h7.second);
+        }
+    }
+
     void test_murmur_hash_64_2()
     {
         byte_orderer bo;
@@ -356,6 +439,8 @@ namespace
 
             test_murmur_hash_128_4();
             test_murmur_hash_128_3();
+            test_murmur_hash_128_stream();
+            test_fast_hash_128();
             test_murmur_hash_64_2();
             test_murmur_hash_64_3();
         }
@@ -7,6 +7,7 @@
 #include <dlib/pixel.h>
 #include <dlib/array2d.h>
 #include <dlib/image_transforms.h>
+#include <dlib/image_processing/raw_image_view.h>
 #include <dlib/image_io.h>
 #include <dlib/matrix.h>
 #include <dlib/rand.h>
@@ -211,9 +212,103 @@ namespace
                     DLIB_TEST(img2[r][c].blue == img3[r][c].blue);
                 }
             }
+
+            // Check the region of interest version of load_image().  PNG has no
+            // native region decode so this exercises the decode-then-crop fallback.
+            array2d<rgb_alpha_pixel> img4;
+            const rectangle roi(3, 2, 11, 9);
+            load_image(img4, "test.png", roi);
+            DLIB_TEST(img4.nr() == (long)roi.height());
+            DLIB_TEST(img4.nc() == (long)roi.width());
+            for (long r = 0; r < img4.nr(); ++r)
+            {
+                for (long c = 0; c < img4.nc(); ++c)
+                {
+                    DLIB_TEST(img4[r][c].red == img[r+roi.top()][c+roi.left()].red);
+                    DLIB_TEST(img4[r][c].green == img[r+roi.top()][c+roi.left()].green);
+                    DLIB_TEST(img4[r][c].blue == img[r+roi.top()][c+roi.left()].blue);
+                    DLIB_TEST(img4[r][c].alpha == img[r+roi.top()][c+roi.left()].alpha);
+                }
+            }
         }
 #endif // DLIB_PNG_SUPPORT
 
+#ifdef DLIB_JPEG_SUPPORT
+        {
+            array2d<rgb_pixel> img;
+            img.set_size(64,71);
+            for (long r = 0; r < img.nr(); ++r)
+            {
+                for (long c = 0; c < img.nc(); ++c)
+                {
+                    img[r][c].red = static_cast<unsigned char>(r*3 + c);
+                    img[r][c].green = static_cast<unsigned char>(r + c*2);
+                    img[r][c].blue = static_cast<unsigned char>(r*2 + c*2);
+                }
+            }
+
+            save_jpeg(img, "test.jpg");
+
+            array2d<rgb_pixel> full;
+            load_jpeg(full, "test.jpg");
+            DLIB_TEST(full.nr() == img.nr());
+            DLIB_TEST(full.nc() == img.nc());
+
+            // Decoding just a region must give exactly the same pixels as decoding
+            // the whole image and cropping.
+            const rectangle roi(13, 9, 50, 40);
+            array2d<rgb_pixel> part;
+            load_jpeg(part, std::string("test.jpg"), roi);
+            DLIB_TEST(part.nr() == (long)roi.height());
+            DLIB_TEST(part.nc() == (long)roi.width());
+            for (long r = 0; r < part.nr(); ++r)
+            {
+                for (long c = 0; c < part.nc(); ++c)
+                {
+                    DLIB_TEST(part[r][c].red == full[r+roi.top()][c+roi.left()].red);
+                    DLIB_TEST(part[r][c].green == full[r+roi.top()][c+roi.left()].green);
+                    DLIB_TEST(part[r][c].blue == full[r+roi.top()][c+roi.left()].blue);
+                }
+            }
+
+            // the same through load_image()
+            array2d<rgb_pixel> part2;
+            load_image(part2, "test.jpg", roi);
+            DLIB_TEST(part2.nr() == part.nr());
+            DLIB_TEST(part2.nc() == part.nc());
+            for (long r = 0; r < part2.nr(); ++r)
+            {
+                for (long c = 0; c < part2.nc(); ++c)
+                {
+                    DLIB_TEST(part2[r][c].red == part[r][c].red);
+                    DLIB_TEST(part2[r][c].green == part[r][c].green);
+                    DLIB_TEST(part2[r][c].blue == part[r][c].blue);
+                }
+            }
+
+            // a region hanging off the edge of the image gets clipped
+            array2d<rgb_pixel> part3;
+            load_image(part3, "test.jpg", rectangle(40, 30, 1000, 1000));
+            DLIB_TEST(part3.nr() == img.nr()-30);
+            DLIB_TEST(part3.nc() == img.nc()-40);
+            for (long r = 0; r < part3.nr(); ++r)
+            {
+                for (long c = 0; c < part3.nc(); ++c)
+                {
+                    DLIB_TEST(part3[r][c].red == full[r+30][c+40].red);
+                    DLIB_TEST(part3[r][c].green == full[r+30][c+40].green);
+                    DLIB_TEST(part3[r][c].blue == full[r+30][c+40].blue);
+                }
+            }
+
+            // a region that misses the image entirely is an error
+            bool threw = false;
+            try { load_image(part3, "test.jpg", rectangle(1000, 1000, 2000, 2000)); }
+            catch (image_load_error&) { threw = true; }
+            DLIB_TEST(threw);
+        }
+#endif // DLIB_JPEG_SUPPORT
+
 
 
         {
@@ -757,6 +852,36 @@ namespace
                 DLIB_TEST(int_img.get_sum_of_area(rect) == sum(subm(matrix_cast<T>(mat(img)), rect)));
             }
 
+            // now mutate a few random regions and make sure update() gives the same
+            // integral image as a full load() would.
+            for (int j = 0; j < 5; ++j)
+            {
+                point p1(rnd.get_random_32bit_number()%img.nc(), rnd.get_random_32bit_number()%img.nr());
+                point p2(rnd.get_random_32bit_number()%img.nc(), rnd.get_random_32bit_number()%img.nr());
+                const rectangle rect(p1,p2);
+                for (long r = rect.top(); r <= rect.bottom(); ++r)
+                {
+                    for (long c = rect.left(); c <= rect.right(); ++c)
+                        img[r][c] = (int)rnd.get_random_8bit_number() - 100;
+                }
+
+                int_img.update(img, rect);
+
+                // comparing the sums over all the prefix rectangles compares every
+                // entry of the underlying tables.
+                integral_image_generic<T> int_img2;
+                int_img2.load(img);
+                for (long r = 0; r < img.nr(); ++r)
+                {
+                    for (long c = 0; c < img.nc(); ++c)
+                    {
+                        const rectangle prefix(0, 0, c, r);
+                        DLIB_TEST(int_img.get_sum_of_area(prefix) == int_img2.get_sum_of_area(prefix));
+                    }
+                }
+                DLIB_TEST(int_img.get_sum_of_area(get_rect(img)) == sum(matrix_cast<T>(mat(img))));
+            }
+
         }
 
 
@@ -849,6 +974,74 @@ namespace
 
     }
 
+    void test_threaded_filtering(int nr, int nc, dlib::rand& rnd)
+    {
+        print_spinner();
+        dlog << LINFO << "test_threaded_filtering(): " << nr << "  " << nc;
+
+        thread_pool tp(3);
+
+        array2d<float> img(71,83);
+        for (long r = 0; r < img.nr(); ++r)
+        {
+            for (long c = 0; c < img.nc(); ++c)
+            {
+                img[r][c] = rnd.get_random_gaussian();
+            }
+        }
+        matrix<float> filt = matrix_cast<float>(randm(nr,nc,rnd));
+        // make sure the filter isn't separable so the dense code path gets exercised.
+        filt(nr/2,nc/2) += 2;
+        matrix<float,0,1> row_filt, col_filt;
+        DLIB_TEST(find_separable_filter(filt, row_filt, col_filt) == false);
+
+        // The threaded overload must produce exactly the same output as the
+        // single threaded version.
+        array2d<float> out1, out2;
+        rectangle rect1 = spatially_filter_image(img, out1, filt);
+        rectangle rect2 = spatially_filter_image(tp, img, out2, filt);
+        DLIB_TEST(rect1 == rect2);
+        DLIB_TEST(max(abs(mat(out1) - mat(out2))) == 0);
+
+        assign_all_pixels(out1, 10);
+        assign_all_pixels(out2, 10);
+        spatially_filter_image(img, out1, filt, 2, true, true);
+        spatially_filter_image(tp, img, out2, filt, 2, true, true);
+        DLIB_TEST(max(abs(mat(out1) - mat(out2))) == 0);
+
+        // same deal for non-float images, which go through the grayscale code path.
+        array2d<unsigned char> cimg(61,57), cout1, cout2;
+        for (long r = 0; r < cimg.nr(); ++r)
+        {
+            for (long c = 0; c < cimg.nc(); ++c)
+            {
+                cimg[r][c] = static_cast<unsigned char>(rnd.get_random_8bit_number());
+            }
+        }
+        matrix<int> ifilt = matrix_cast<int>(round(20*randm(nr,nc,rnd))) - 10;
+        ifilt(nr/2,nc/2) += 50;
+        rect1 = spatially_filter_image(cimg, cout1, ifilt, 3, true);
+        rect2 = spatially_filter_image(tp, cimg, cout2, ifilt, 3, true);
+        DLIB_TEST(rect1 == rect2);
+        DLIB_TEST(max(abs(matrix_cast<int>(mat(cout1)) - matrix_cast<int>(mat(cout2)))) == 0);
+
+        // Now check that find_separable_filter() factorizes outer products and that the
+        // threaded overload detects them and gives the same results as calling
+        // spatially_filter_image_separable() directly.
+        const matrix<float> a = matrix_cast<float>(randm(nr,1,rnd));
+        const matrix<float> b = matrix_cast<float>(randm(nc,1,rnd));
+        const matrix<float> sep = a*trans(b);
+        DLIB_TEST(find_separable_filter(sep, row_filt, col_filt) == true);
+        DLIB_TEST(max(abs(sep - col_filt*trans(row_filt))) < 1e-5);
+
+        spatially_filter_image_separable(img, out1, row_filt, col_filt);
+        spatially_filter_image(tp, img, out2, sep);
+        DLIB_TEST(max(abs(mat(out1) - mat(out2))) == 0);
+
+        // an all zero filter isn't considered separable
+        DLIB_TEST(find_separable_filter(zeros_matrix<float>(nr,nc), row_filt, col_filt) == false);
+    }
+
     template <typename T>
     void test_filtering(bool use_abs, unsigned long scale )
     {
@@ -1092,6 +1285,100 @@ namespace
     }
 
 
+    void test_assign_image_affine(
+    )
+    {
+        print_spinner();
+        dlib::rand rnd;
+
+        // float to float exercises the simd path.  Use a width that isn't a multiple
+        // of 8 so the scalar tail gets hit as well.
+        array2d<float> fimg(37,45), fout;
+        for (long r = 0; r < fimg.nr(); ++r)
+            for (long c = 0; c < fimg.nc(); ++c)
+                fimg[r][c] = 50*(float)rnd.get_random_gaussian();
+
+        assign_image_affine(fout, fimg, 2.0, -3.0, -25.0, 60.0);
+        DLIB_TEST(fout.nr() == fimg.nr() && fout.nc() == fimg.nc());
+        for (long r = 0; r < fimg.nr(); ++r)
+        {
+            for (long c = 0; c < fimg.nc(); ++c)
+            {
+                const float expected = std::min(std::max(2.0f*fimg[r][c] + -3.0f, -25.0f), 60.0f);
+                DLIB_TEST(fout[r][c] == expected);
+            }
+        }
+
+        // transforming in place must give the same answer
+        array2d<float> fcopy;
+        assign_image(fcopy, fimg);
+        assign_image_affine(fcopy, fcopy, 2.0, -3.0, -25.0, 60.0);
+        for (long r = 0; r < fimg.nr(); ++r)
+            for (long c = 0; c < fimg.nc(); ++c)
+                DLIB_TEST(fcopy[r][c] == fout[r][c]);
+
+        // typical normalization: unsigned char frame into a zero centered float image
+        array2d<unsigned char> img(20,30);
+        for (long r = 0; r < img.nr(); ++r)
+            for (long c = 0; c < img.nc(); ++c)
+                img[r][c] = (unsigned char)(rnd.get_random_32bit_number()%256);
+
+        array2d<float> out;
+        assign_image_affine(out, img, 1.0/128.0, -1.0);
+        for (long r = 0; r < img.nr(); ++r)
+        {
+            for (long c = 0; c < img.nc(); ++c)
+            {
+                const double expected = img[r][c]/128.0 - 1.0;
+                DLIB_TEST(std::abs(out[r][c] - expected) < 1e-6);
+            }
+        }
+
+        // storing back into an unsigned char image must saturate the same way
+        // assign_pixel() does.
+        array2d<unsigned char> out2;
+        assign_image_affine(out2, img, 2.0, -10.0);
+        for (long r = 0; r < img.nr(); ++r)
+        {
+            for (long c = 0; c < img.nc(); ++c)
+            {
+                unsigned char expected;
+                assign_pixel(expected, 2.0*img[r][c] - 10.0);
+                DLIB_TEST(out2[r][c] == expected);
+            }
+        }
+
+        // color pixels get the transform applied per channel and keep their alpha
+        array2d<rgb_alpha_pixel> cimg(15,17), cout_;
+        for (long r = 0; r < cimg.nr(); ++r)
+        {
+            for (long c = 0; c < cimg.nc(); ++c)
+            {
+                cimg[r][c].red   = (unsigned char)(rnd.get_random_32bit_number()%256);
+                cimg[r][c].green = (unsigned char)(rnd.get_random_32bit_number()%256);
+                cimg[r][c].blue  = (unsigned char)(rnd.get_random_32bit_number()%256);
+                cimg[r][c].alpha = (unsigned char)(rnd.get_random_32bit_number()%256);
+            }
+        }
+        assign_image_affine(cout_, cimg, 0.5, 10.0, 0.0, 100.0);
+        for (long r = 0; r < cimg.nr(); ++r)
+        {
+            for (long c = 0; c < cimg.nc(); ++c)
+            {
+                unsigned char expected;
+                assign_pixel(expected, std::min(std::max(0.5*cimg[r][c].red + 10.0, 0.0), 100.0));
+                DLIB_TEST(cout_[r][c].red == expected);
+                assign_pixel(expected, std::min(std::max(0.5*cimg[r][c].green + 10.0, 0.0), 100.0));
+                DLIB_TEST(cout_[r][c].green == expected);
+                assign_pixel(expected, std::min(std::max(0.5*cimg[r][c].blue + 10.0, 0.0), 100.0));
+                DLIB_TEST(cout_[r][c].blue == expected);
+                DLIB_TEST(cout_[r][c].alpha == cimg[r][c].alpha);
+                DLIB_TEST(cout_[r][c].red <= 100 && cout_[r][c].red >= 10);
+            }
+        }
+    }
+
+
     void test_zero_border_pixels(
     )
     {
@@ -1308,6 +1595,115 @@ namespace
         }
     }
 
+    void test_label_connected_blobs_union_find()
+    {
+        dlib::rand rnd;
+        const long sizes[][2] = {{0,0}, {1,1}, {3,7}, {40,31}, {300,401}};
+        for (auto& size : sizes)
+        {
+            array2d<unsigned char> img(size[0], size[1]);
+            for (long r = 0; r < img.nr(); ++r)
+                for (long c = 0; c < img.nc(); ++c)
+                    img[r][c] = rnd.get_random_8bit_number()%3;
+
+            array2d<unsigned int> labels1, labels2;
+            unsigned long num1, num2;
+
+            num1 = label_connected_blobs(img,
+                                         zero_pixels_are_background(),
+                                         neighbors_8(),
+                                         connected_if_both_not_zero(),
+                                         labels1);
+            num2 = label_connected_blobs_union_find(img,
+                                                    zero_pixels_are_background(),
+                                                    neighbors_8(),
+                                                    connected_if_both_not_zero(),
+                                                    labels2);
+            DLIB_TEST(num1 == num2);
+            DLIB_TEST(mat(labels1) == mat(labels2));
+
+            num1 = label_connected_blobs(img,
+                                         nothing_is_background(),
+                                         neighbors_4(),
+                                         connected_if_equal(),
+                                         labels1);
+            num2 = label_connected_blobs_union_find(img,
+                                                    nothing_is_background(),
+                                                    neighbors_4(),
+                                                    connected_if_equal(),
+                                                    labels2);
+            DLIB_TEST(num1 == num2);
+            DLIB_TEST(mat(labels1) == mat(labels2));
+
+            num1 = label_connected_blobs(img,
+                                         zero_pixels_are_background(),
+                                         neighbors_24(),
+                                         connected_if_both_not_zero(),
+                                         labels1);
+            num2 = label_connected_blobs_union_find(img,
+                                                    zero_pixels_are_background(),
+                                                    neighbors_24(),
+                                                    connected_if_both_not_zero(),
+                                                    labels2);
+            DLIB_TEST(num1 == num2);
+            DLIB_TEST(mat(labels1) == mat(labels2));
+        }
+    }
+
+    void test_euclidean_distance_transform()
+    {
+        dlib::rand rnd;
+        const long sizes[][2] = {{0,0}, {1,1}, {1,9}, {9,1}, {25,37}, {130,120}};
+        for (auto& size : sizes)
+        {
+            array2d<unsigned char> img(size[0], size[1]);
+            for (long r = 0; r < img.nr(); ++r)
+                for (long c = 0; c < img.nc(); ++c)
+                    img[r][c] = rnd.get_random_8bit_number()%4 == 0 ? 0 : 255;
+
+            array2d<float> dist;
+            euclidean_distance_transform(img, dist);
+            DLIB_TEST(dist.nr() == img.nr());
+            DLIB_TEST(dist.nc() == img.nc());
+
+            // check against the brute force distance transform
+            for (long r = 0; r < img.nr(); ++r)
+            {
+                for (long c = 0; c < img.nc(); ++c)
+                {
+                    double best = 1e100;
+                    for (long rr = 0; rr < img.nr(); ++rr)
+                    {
+                        for (long cc = 0; cc < img.nc(); ++cc)
+                        {
+                            if (img[rr][cc] == 0)
+                                best = std::min(best, (double)(rr-r)*(rr-r) + (cc-c)*(cc-c));
+                        }
+                    }
+                    if (best == 1e100)
+                    {
+                        // no background pixels at all, so we just expect a huge value.
+                        DLIB_TEST(dist[r][c] > 1e9);
+                    }
+                    else
+                    {
+                        DLIB_TEST_MSG(std::abs(dist[r][c] - std::sqrt(best)) < 1e-5,
+                            "r: " << r << " c: " << c << " dist: " << dist[r][c] << " expected: " << std::sqrt(best));
+                    }
+                }
+            }
+        }
+
+        // Also make sure an all-foreground image doesn't produce anything weird.
+        array2d<unsigned char> img(15,20);
+        assign_all_pixels(img, 255);
+        array2d<float> dist;
+        euclidean_distance_transform(img, dist);
+        for (long r = 0; r < img.nr(); ++r)
+            for (long c = 0; c < img.nc(); ++c)
+                DLIB_TEST(dist[r][c] > 1e9);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <
@@ -1479,6 +1875,122 @@ namespace
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_parallel_pixel_edges()
+    {
+        print_spinner();
+
+        // Make the image tall enough that get_pixel_edges() takes its parallel path
+        // (it chunks by row ranges of at least 64 rows).
+        dlib::rand rnd;
+        array2d<rgb_pixel> img(300,250);
+        for (long r = 0; r < img.nr(); ++r)
+        {
+            for (long c = 0; c < img.nc(); ++c)
+            {
+                img[r][c].red = rnd.get_random_8bit_number();
+                img[r][c].green = rnd.get_random_8bit_number();
+                img[r][c].blue = rnd.get_random_8bit_number();
+            }
+        }
+
+        const_image_view<array2d<rgb_pixel> > imgv(img);
+
+        typedef dlib::impl::segment_image_edge_data_T<double> edge_type;
+        std::vector<edge_type> edges, ref_edges;
+        dlib::impl::get_pixel_edges(imgv, edges);
+
+        // The reference is the single threaded row-by-row build.
+        dlib::impl::get_pixel_edges_for_rows(imgv, 0, imgv.nr(), ref_edges);
+
+        // get_pixel_edges() only sorts by edge weight, so sort both edge sets by all
+        // their fields before comparing them element by element.
+        auto full_order = [](const edge_type& a, const edge_type& b)
+        {
+            if (a.diff != b.diff) return a.diff < b.diff;
+            if (a.idx1 != b.idx1) return a.idx1 < b.idx1;
+            return a.idx2 < b.idx2;
+        };
+        DLIB_TEST(std::is_sorted(edges.begin(), edges.end()));
+        std::sort(edges.begin(), edges.end(), full_order);
+        std::sort(ref_edges.begin(), ref_edges.end(), full_order);
+
+        DLIB_TEST(edges.size() == ref_edges.size());
+        for (unsigned long i = 0; i < edges.size(); ++i)
+        {
+            DLIB_TEST(edges[i].idx1 == ref_edges[i].idx1);
+            DLIB_TEST(edges[i].idx2 == ref_edges[i].idx2);
+            DLIB_TEST(edges[i].diff == ref_edges[i].diff);
+        }
+
+        // Also run a whole segmentation big enough to use the parallel path and make
+        // sure the obvious regions come out intact.
+        array2d<rgb_pixel> img2(300,300);
+        for (long r = 0; r < img2.nr(); ++r)
+        {
+            for (long c = 0; c < img2.nc(); ++c)
+            {
+                if (c < 150)
+                    assign_pixel(img2[r][c], rgb_pixel(255,0,0));
+                else
+                    assign_pixel(img2[r][c], rgb_pixel(0,0,255));
+            }
+        }
+        array2d<unsigned long> out;
+        segment_image(img2, out);
+        DLIB_TEST(get_rect(img2) == get_rect(out));
+        const unsigned long v1 = out[0][0];
+        const unsigned long v2 = out[299][299];
+        for (long r = 0; r < img2.nr(); ++r)
+        {
+            for (long c = 0; c < img2.nc(); ++c)
+            {
+                if (c < 150)
+                    DLIB_TEST(out[r][c] == v1);
+                else
+                    DLIB_TEST(out[r][c] == v2);
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_sobel_edge_map()
+    {
+        dlib::rand rnd;
+        // Cover the serial path, the parallel path, SIMD tails of various lengths, and
+        // images that are nothing but border pixels.
+        const long sizes[][2] = {{0,0}, {2,5}, {5,2}, {3,3}, {20,37}, {300,413}};
+        for (auto& sz : sizes)
+        {
+            print_spinner();
+            array2d<unsigned char> img(sz[0], sz[1]);
+            for (long r = 0; r < img.nr(); ++r)
+                for (long c = 0; c < img.nc(); ++c)
+                    img[r][c] = rnd.get_random_8bit_number();
+
+            // The fused single pass edge map should reproduce the two pass pipeline
+            // exactly for 8 bit pixels.
+            array2d<short> horz, vert;
+            array2d<float> ref, out;
+            sobel_edge_detector(img, horz, vert);
+            suppress_non_maximum_edges(horz, vert, ref);
+
+            sobel_edge_map(img, out);
+
+            DLIB_TEST(have_same_dimensions(ref, out));
+            for (long r = 0; r < ref.nr(); ++r)
+            {
+                for (long c = 0; c < ref.nc(); ++c)
+                {
+                    DLIB_TEST_MSG(ref[r][c] == out[r][c],
+                        "r: " << r << " c: " << c << " ref: " << ref[r][c] << " out: " << out[r][c]);
+                }
+            }
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     template <typename T>
@@ -1810,6 +2322,46 @@ namespace
             DLIB_TEST(length((line.first+line.second)/2.0 - center(get_rect(temp))) <= 1);
         }
 
+        {
+            // Extracting a batch of chips should give exactly the same results as
+            // extracting each chip by itself.
+            print_spinner();
+            array2d<unsigned char> src(400,400);
+            for (long r = 0; r < src.nr(); ++r)
+                for (long c = 0; c < src.nc(); ++c)
+                    src[r][c] = rnd.get_random_8bit_number();
+
+            std::vector<chip_details> dets;
+            for (int i = 0; i < 50; ++i)
+            {
+                const long nr = rnd.get_random_32bit_number()%200 + 10;
+                const long nc = rnd.get_random_32bit_number()%200 + 10;
+                const rectangle rect = centered_rect(rnd.get_random_32bit_number()%400,
+                                                     rnd.get_random_32bit_number()%400, nc, nr);
+                // Keep the chip size large enough that the extraction samples the input
+                // directly instead of an image pyramid level.  The pyramid is built over
+                // the bounding box of the whole batch, so its decimation grid (and hence
+                // the interpolated values) wouldn't exactly match a single chip call.
+                const unsigned long size = rect.area()/2 + rnd.get_random_32bit_number()%rect.area();
+                const double angle = (rnd.get_random_double()-0.5)*2*pi;
+                dets.push_back(chip_details(rect, size, angle));
+            }
+            // toss in some plain crops so the fast copy path gets hit too
+            dets.push_back(chip_details(rectangle(10,10,50,70)));
+            dets.push_back(chip_details(rectangle(-20,-20,30,30)));
+
+            dlib::array<array2d<unsigned char> > batch;
+            extract_image_chips(src, dets, batch);
+            DLIB_TEST(batch.size() == dets.size());
+            for (unsigned long i = 0; i < dets.size(); ++i)
+            {
+                array2d<unsigned char> chip;
+                extract_image_chip(src, dets[i], chip);
+                DLIB_TEST(batch[i].nr() == chip.nr() && batch[i].nc() == chip.nc());
+                DLIB_TEST(equal(mat(batch[i]), mat(chip)));
+            }
+        }
+
     }
 
 // ----------------------------------------------------------------------------------------
@@ -1987,6 +2539,568 @@ namespace
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_gaussian_blur_filter (
+    )
+    {
+        print_spinner();
+        dlib::rand rnd;
+
+        // For integer pixel types the fused filter must match gaussian_blur() exactly.
+        for (double sigma : {0.8, 2.5, 7.0})
+        {
+            gaussian_blur_filter blur(sigma);
+            DLIB_TEST(blur.get_sigma() == sigma);
+            // reuse one filter object across differently sized images
+            for (long size : {31, 80})
+            {
+                array2d<unsigned char> img(size, size+11);
+                for (long r = 0; r < img.nr(); ++r)
+                    for (long c = 0; c < img.nc(); ++c)
+                        img[r][c] = (unsigned char)rnd.get_random_8bit_number();
+
+                array2d<unsigned char> out1, out2;
+                const rectangle rect1 = gaussian_blur(img, out1, sigma);
+                const rectangle rect2 = blur(img, out2);
+                DLIB_TEST(rect1 == rect2);
+                DLIB_TEST(mat(out1) == mat(out2));
+            }
+        }
+
+        // color images filter each channel independently
+        {
+            const double sigma = 3;
+            gaussian_blur_filter blur(sigma);
+            array2d<rgb_pixel> img(64, 53), out1, out2;
+            for (long r = 0; r < img.nr(); ++r)
+            {
+                for (long c = 0; c < img.nc(); ++c)
+                {
+                    img[r][c].red = (unsigned char)rnd.get_random_8bit_number();
+                    img[r][c].green = (unsigned char)rnd.get_random_8bit_number();
+                    img[r][c].blue = (unsigned char)rnd.get_random_8bit_number();
+                }
+            }
+            const rectangle rect1 = gaussian_blur(img, out1, sigma);
+            const rectangle rect2 = blur(img, out2);
+            DLIB_TEST(rect1 == rect2);
+            bool all_equal = true;
+            for (long r = 0; r < out1.nr(); ++r)
+            {
+                for (long c = 0; c < out1.nc(); ++c)
+                {
+                    if (out1[r][c].red != out2[r][c].red ||
+                        out1[r][c].green != out2[r][c].green ||
+                        out1[r][c].blue != out2[r][c].blue)
+                        all_equal = false;
+                }
+            }
+            DLIB_TEST(all_equal);
+        }
+
+        // float images agree up to rounding
+        {
+            const double sigma = 2.2;
+            gaussian_blur_filter blur(sigma);
+            array2d<float> img(40, 45), out1, out2;
+            for (long r = 0; r < img.nr(); ++r)
+                for (long c = 0; c < img.nc(); ++c)
+                    img[r][c] = rnd.get_random_gaussian();
+            gaussian_blur(img, out1, sigma);
+            blur(img, out2);
+            DLIB_TEST(max(abs(mat(out1)-mat(out2))) < 1e-5);
+        }
+
+        // the high precision big sigma path agrees up to assign_pixel() rounding
+        {
+            const double sigma = 20;
+            gaussian_blur_filter blur(sigma);
+            array2d<unsigned char> img(90, 90), out1, out2;
+            for (long r = 0; r < img.nr(); ++r)
+                for (long c = 0; c < img.nc(); ++c)
+                    img[r][c] = (unsigned char)rnd.get_random_8bit_number();
+            gaussian_blur(img, out1, sigma);
+            blur(img, out2);
+            DLIB_TEST(max(abs(matrix_cast<int>(mat(out1))-matrix_cast<int>(mat(out2)))) <= 1);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T>
+    void reference_bilinear_resize (
+        const array2d<T>& in_img,
+        array2d<double>& out_img
+    )
+    // A plain double precision evaluation of the bilinear interpolation performed by
+    // resize_image().  The optimized paths must agree with this to within rounding.
+    {
+        const double x_scale = (in_img.nc()-1)/(double)std::max<long>((out_img.nc()-1),1);
+        const double y_scale = (in_img.nr()-1)/(double)std::max<long>((out_img.nr()-1),1);
+        double y = -y_scale;
+        for (long r = 0; r < out_img.nr(); ++r)
+        {
+            y += y_scale;
+            const long top    = static_cast<long>(std::floor(y));
+            const long bottom = std::min(top+1, in_img.nr()-1);
+            const double tb_frac = y - top;
+            double x = -x_scale;
+            for (long c = 0; c < out_img.nc(); ++c)
+            {
+                x += x_scale;
+                const long left   = static_cast<long>(std::floor(x));
+                const long right  = std::min(left+1, in_img.nc()-1);
+                const double lr_frac = x - left;
+
+                double tl = 0, tr = 0, bl = 0, br = 0;
+                assign_pixel(tl, in_img[top][left]);
+                assign_pixel(tr, in_img[top][right]);
+                assign_pixel(bl, in_img[bottom][left]);
+                assign_pixel(br, in_img[bottom][right]);
+
+                out_img[r][c] = (1-tb_frac)*((1-lr_frac)*tl + lr_frac*tr) +
+                    tb_frac*((1-lr_frac)*bl + lr_frac*br);
+            }
+        }
+    }
+
+    void test_resize_image (
+    )
+    {
+        print_spinner();
+        dlib::rand rnd;
+
+        // Check the optimized grayscale path against the reference on both a small
+        // output, which runs serially, and a big output, which runs tiled across the
+        // default thread pool.  Either way every pixel has to agree with the reference
+        // to within rounding.
+        for (auto out_size : {std::make_pair(48L,61L), std::make_pair(240L,320L)})
+        {
+            array2d<unsigned char> img(480, 640);
+            for (long r = 0; r < img.nr(); ++r)
+                for (long c = 0; c < img.nc(); ++c)
+                    img[r][c] = (unsigned char)rnd.get_random_8bit_number();
+
+            array2d<unsigned char> out(out_size.first, out_size.second);
+            resize_image(img, out);
+
+            array2d<double> ref(out.nr(), out.nc());
+            reference_bilinear_resize(img, ref);
+            DLIB_TEST(max(abs(matrix_cast<double>(mat(out)) - mat(ref))) <= 1.0);
+
+            // the tiled execution must also be deterministic
+            array2d<unsigned char> out2(out.nr(), out.nc());
+            resize_image(img, out2);
+            DLIB_TEST(mat(out) == mat(out2));
+        }
+
+        // same deal for float images
+        {
+            array2d<float> img(300, 200);
+            for (long r = 0; r < img.nr(); ++r)
+                for (long c = 0; c < img.nc(); ++c)
+                    img[r][c] = rnd.get_random_float();
+
+            array2d<float> out(160, 120);
+            resize_image(img, out);
+
+            array2d<double> ref(out.nr(), out.nc());
+            reference_bilinear_resize(img, ref);
+            DLIB_TEST(max(abs(matrix_cast<double>(mat(out)) - mat(ref))) < 1e-4);
+        }
+
+        // and for the RGB path.  The simd code truncates rather than rounds, so give it
+        // an extra intensity level of slack.
+        {
+            array2d<rgb_pixel> img(480, 640);
+            array2d<unsigned char> red(img.nr(), img.nc()), green(img.nr(), img.nc()), blue(img.nr(), img.nc());
+            for (long r = 0; r < img.nr(); ++r)
+            {
+                for (long c = 0; c < img.nc(); ++c)
+                {
+                    img[r][c].red   = red[r][c]   = (unsigned char)rnd.get_random_8bit_number();
+                    img[r][c].green = green[r][c] = (unsigned char)rnd.get_random_8bit_number();
+                    img[r][c].blue  = blue[r][c]  = (unsigned char)rnd.get_random_8bit_number();
+                }
+            }
+
+            array2d<rgb_pixel> out(240, 320);
+            resize_image(img, out);
+
+            array2d<double> ref(out.nr(), out.nc());
+            reference_bilinear_resize(red, ref);
+            for (long r = 0; r < out.nr(); ++r)
+                for (long c = 0; c < out.nc(); ++c)
+                    DLIB_TEST(std::abs(out[r][c].red - ref[r][c]) <= 2.0);
+            reference_bilinear_resize(green, ref);
+            for (long r = 0; r < out.nr(); ++r)
+                for (long c = 0; c < out.nc(); ++c)
+                    DLIB_TEST(std::abs(out[r][c].green - ref[r][c]) <= 2.0);
+            reference_bilinear_resize(blue, ref);
+            for (long r = 0; r < out.nr(); ++r)
+                for (long c = 0; c < out.nc(); ++c)
+                    DLIB_TEST(std::abs(out[r][c].blue - ref[r][c]) <= 2.0);
+        }
+
+        print_spinner();
+
+        // rotating a big image by 0 radians goes through the tiled transform_image()
+        // path and has to give back the input.
+        {
+            array2d<unsigned char> img(400, 400), out;
+            for (long r = 0; r < img.nr(); ++r)
+                for (long c = 0; c < img.nc(); ++c)
+                    img[r][c] = (unsigned char)rnd.get_random_8bit_number();
+
+            rotate_image(img, out, 0, interpolate_bilinear());
+            DLIB_TEST(out.nr() == img.nr() && out.nc() == img.nc());
+            // bilinear interpolation can't fill the last row and column, so only
+            // compare the interior
+            DLIB_TEST(max(abs(subm(matrix_cast<int>(mat(out)),  0,0, out.nr()-1, out.nc()-1) -
+                              subm(matrix_cast<int>(mat(img)),  0,0, out.nr()-1, out.nc()-1))) <= 1);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_raw_image_view()
+    {
+        dlib::rand rnd;
+
+        // build a BGR frame with padded rows, the way camera buffers usually arrive.
+        const long nr = 31;
+        const long nc = 45;
+        const long width_step = nc*sizeof(bgr_pixel) + 13;
+        std::vector<unsigned char> buf(nr*width_step);
+        for (auto& b : buf)
+            b = (unsigned char)rnd.get_random_8bit_number();
+
+        raw_image_view<bgr_pixel> view(buf.data(), nr, nc, width_step);
+        DLIB_TEST(view.nr() == nr);
+        DLIB_TEST(view.nc() == nc);
+        DLIB_TEST(view.width_step() == width_step);
+
+        // the view should alias the buffer exactly, respecting the stride.
+        for (long r = 0; r < nr; ++r)
+        {
+            for (long c = 0; c < nc; ++c)
+            {
+                const unsigned char* p = buf.data() + r*width_step + c*sizeof(bgr_pixel);
+                DLIB_TEST(view[r][c].blue  == p[0]);
+                DLIB_TEST(view[r][c].green == p[1]);
+                DLIB_TEST(view[r][c].red   == p[2]);
+            }
+        }
+
+        // it should plug into the normal image pipeline without any copies.
+        array2d<rgb_pixel> img;
+        assign_image(img, view);
+        DLIB_TEST(img.nr() == nr && img.nc() == nc);
+        for (long r = 0; r < nr; ++r)
+        {
+            for (long c = 0; c < nc; ++c)
+            {
+                DLIB_TEST(img[r][c].red   == view[r][c].red);
+                DLIB_TEST(img[r][c].green == view[r][c].green);
+                DLIB_TEST(img[r][c].blue  == view[r][c].blue);
+            }
+        }
+
+        array2d<rgb_pixel> small1(17,23), small2(17,23);
+        resize_image(view, small1);
+        resize_image(img, small2);
+        DLIB_TEST(small1.nr() == small2.nr() && small1.nc() == small2.nc());
+        for (long r = 0; r < small1.nr(); ++r)
+        {
+            for (long c = 0; c < small1.nc(); ++c)
+            {
+                DLIB_TEST(small1[r][c].red   == small2[r][c].red);
+                DLIB_TEST(small1[r][c].green == small2[r][c].green);
+                DLIB_TEST(small1[r][c].blue  == small2[r][c].blue);
+            }
+        }
+
+        array2d<matrix<float,31,1> > hog1, hog2;
+        extract_fhog_features(view, hog1);
+        extract_fhog_features(img, hog2);
+        DLIB_TEST(hog1.nr() == hog2.nr() && hog1.nc() == hog2.nc());
+        for (long r = 0; r < hog1.nr(); ++r)
+            for (long c = 0; c < hog1.nc(); ++c)
+                DLIB_TEST(max(abs(hog1[r][c] - hog2[r][c])) < 1e-6);
+
+        // writing through the view should land in the original buffer.
+        view[3][7] = bgr_pixel(9, 8, 7);
+        DLIB_TEST(buf[3*width_step + 7*sizeof(bgr_pixel) + 0] == 9);
+        DLIB_TEST(buf[3*width_step + 7*sizeof(bgr_pixel) + 1] == 8);
+        DLIB_TEST(buf[3*width_step + 7*sizeof(bgr_pixel) + 2] == 7);
+
+        // a tightly packed grayscale view works too.
+        std::vector<unsigned char> gray(20*30);
+        for (auto& b : gray)
+            b = (unsigned char)rnd.get_random_8bit_number();
+        raw_image_view<unsigned char> gview(gray.data(), 20, 30);
+        DLIB_TEST(gview.width_step() == 30);
+        array2d<unsigned char> gimg;
+        assign_image(gimg, gview);
+        DLIB_TEST(mat(gimg) == mat(gview));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <long M, long N>
+    void test_binary_morphology_rect(
+        const long nr,
+        const long nc,
+        dlib::rand& rnd
+    )
+    /*!
+        ensures
+            - checks that binary_dilation() and binary_erosion() with an all-on MxN
+              structuring element agree with a brute force evaluation of their
+              specs on a random nr x nc binary image.  The all-on element is what
+              triggers the sliding window fast path.
+    !*/
+    {
+        unsigned char se[M][N];
+        for (long m = 0; m < M; ++m)
+            for (long n = 0; n < N; ++n)
+                se[m][n] = on_pixel;
+
+        array2d<unsigned char> img(nr,nc);
+        for (long r = 0; r < nr; ++r)
+            for (long c = 0; c < nc; ++c)
+                img[r][c] = (rnd.get_random_8bit_number() < 60) ? on_pixel : off_pixel;
+
+        array2d<unsigned char> dilated, eroded;
+        binary_dilation(img, dilated, se);
+        binary_erosion(img, eroded, se);
+        DLIB_TEST(dilated.nr() == nr && dilated.nc() == nc);
+        DLIB_TEST(eroded.nr() == nr && eroded.nc() == nc);
+
+        for (long r = 0; r < nr; ++r)
+        {
+            for (long c = 0; c < nc; ++c)
+            {
+                unsigned char dref = off_pixel;
+                unsigned char eref = on_pixel;
+                for (long m = 0; m < M; ++m)
+                {
+                    for (long n = 0; n < N; ++n)
+                    {
+                        const long rr = r+m-M/2;
+                        const long cc = c+n-N/2;
+                        // pixels outside the image count as off_pixel
+                        const unsigned char val = (0 <= rr && rr < nr && 0 <= cc && cc < nc) ? img[rr][cc] : off_pixel;
+                        if (val == on_pixel)
+                            dref = on_pixel;
+                        else
+                            eref = off_pixel;
+                    }
+                }
+                DLIB_TEST_MSG(dilated[r][c] == dref, "r: " << r << " c: " << c << " M: " << M << " N: " << N);
+                DLIB_TEST_MSG(eroded[r][c] == eref,  "r: " << r << " c: " << c << " M: " << M << " N: " << N);
+            }
+        }
+    }
+
+    void test_binary_morphology()
+    {
+        print_spinner();
+        dlib::rand rnd;
+
+        test_binary_morphology_rect<3,3>(10, 10, rnd);
+        test_binary_morphology_rect<3,3>(25, 37, rnd);
+        test_binary_morphology_rect<5,7>(25, 37, rnd);
+        test_binary_morphology_rect<9,3>(30, 14, rnd);
+        test_binary_morphology_rect<7,7>(5, 5, rnd);
+        test_binary_morphology_rect<5,5>(1, 50, rnd);
+        test_binary_morphology_rect<5,5>(40, 1, rnd);
+        print_spinner();
+        // big enough to take the threaded code path
+        test_binary_morphology_rect<9,11>(150, 200, rnd);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_equalize_histogram_adaptive()
+    {
+        print_spinner();
+
+        // a constant image must map to a constant image since every tile computes
+        // the same transform
+        {
+            array2d<unsigned char> img(64,80), out;
+            assign_all_pixels(img, 77);
+            equalize_histogram_adaptive(img, out);
+            DLIB_TEST(out.nr() == 64 && out.nc() == 80);
+            for (long r = 0; r < out.nr(); ++r)
+                for (long c = 0; c < out.nc(); ++c)
+                    DLIB_TEST(out[r][c] == out[0][0]);
+        }
+
+        // a low contrast gradient should get stretched out to use much more of the
+        // intensity range
+        {
+            array2d<unsigned char> img(100,100), out;
+            for (long r = 0; r < img.nr(); ++r)
+                for (long c = 0; c < img.nc(); ++c)
+                    img[r][c] = static_cast<unsigned char>(100 + (r+c)%20);
+
+            equalize_histogram_adaptive(img, out, 40);
+            unsigned char minval = 255, maxval = 0;
+            for (long r = 0; r < out.nr(); ++r)
+            {
+                for (long c = 0; c < out.nc(); ++c)
+                {
+                    minval = std::min(minval, out[r][c]);
+                    maxval = std::max(maxval, out[r][c]);
+                }
+            }
+            DLIB_TEST_MSG(minval < 50 && maxval > 200,
+                          "minval: " << (int)minval << " maxval: " << (int)maxval);
+        }
+
+        // a clip limit of 1 flattens every tile's histogram to uniform, so the
+        // transform is the identity ramp and running in-place must match the
+        // two argument version
+        {
+            array2d<unsigned char> img(90,70), out;
+            dlib::rand rnd;
+            for (long r = 0; r < img.nr(); ++r)
+                for (long c = 0; c < img.nc(); ++c)
+                    img[r][c] = static_cast<unsigned char>(rnd.get_random_8bit_number());
+
+            equalize_histogram_adaptive(img, out, 2.5, 4, 4);
+            array2d<unsigned char> img2;
+            assign_image(img2, img);
+            equalize_histogram_adaptive(img2, 2.5, 4, 4);
+            DLIB_TEST(img2.nr() == out.nr() && img2.nc() == out.nc());
+            for (long r = 0; r < out.nr(); ++r)
+                for (long c = 0; c < out.nc(); ++c)
+                    DLIB_TEST(img2[r][c] == out[r][c]);
+        }
+
+        // empty input gives empty output
+        {
+            array2d<unsigned char> img, out(4,4);
+            equalize_histogram_adaptive(img, out);
+            DLIB_TEST(out.size() == 0);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    std::string crop_to_bytes (
+        const matrix<rgb_pixel>& crop
+    )
+    /*!
+        ensures
+            - returns the serialized bytes of crop, so two crops can be compared
+              for exact pixel equality.
+    !*/
+    {
+        std::ostringstream sout;
+        serialize(crop, sout);
+        return sout.str();
+    }
+
+    void test_random_cropper_cache (
+    )
+    {
+        dlib::rand rnd;
+        matrix<rgb_pixel> img(200,200);
+        for (long r = 0; r < img.nr(); ++r)
+        {
+            for (long c = 0; c < img.nc(); ++c)
+            {
+                img(r,c).red   = rnd.get_random_8bit_number();
+                img(r,c).green = rnd.get_random_8bit_number();
+                img(r,c).blue  = rnd.get_random_8bit_number();
+            }
+        }
+        std::vector<mmod_rect> rects;
+        rects.push_back(mmod_rect(rectangle(50,50,120,120)));
+
+        random_cropper cropper;
+        cropper.set_chip_dims(100,100);
+        cropper.set_min_object_size(40,20);
+        cropper.set_seed(0);
+        DLIB_TEST(cropper.crop_cache_enabled() == false);
+
+        // With a single variant per image the crop is fully determined, so a
+        // cache hit must reproduce the crop made on the miss exactly, pixels and
+        // metadata both.
+        cropper.enable_crop_cache(10, 1);
+        DLIB_TEST(cropper.crop_cache_enabled());
+        DLIB_TEST(cropper.get_crop_cache_variants_per_image() == 1);
+
+        matrix<rgb_pixel> crop1, crop2, crop3;
+        std::vector<mmod_rect> det1, det2, det3;
+        cropper(img, rects, crop1, det1);
+        DLIB_TEST(cropper.get_crop_cache_misses() == 1);
+        DLIB_TEST(cropper.get_crop_cache_hits() == 0);
+
+        cropper(img, rects, crop2, det2);
+        DLIB_TEST(cropper.get_crop_cache_misses() == 1);
+        DLIB_TEST(cropper.get_crop_cache_hits() == 1);
+        DLIB_TEST(crop_to_bytes(crop1) == crop_to_bytes(crop2));
+        DLIB_TEST(det1.size() == det2.size());
+        for (size_t i = 0; i < det1.size(); ++i)
+        {
+            DLIB_TEST(det1[i].rect == det2[i].rect);
+            DLIB_TEST(det1[i].ignore == det2[i].ignore);
+            DLIB_TEST(det1[i].label == det2[i].label);
+        }
+
+        // Recomputing the crop from scratch after the cache is cleared must give
+        // the same answer the cache was serving.
+        cropper.clear_crop_cache();
+        DLIB_TEST(cropper.get_crop_cache_misses() == 0);
+        DLIB_TEST(cropper.get_crop_cache_hits() == 0);
+        cropper(img, rects, crop3, det3);
+        DLIB_TEST(cropper.get_crop_cache_misses() == 1);
+        DLIB_TEST(crop_to_bytes(crop1) == crop_to_bytes(crop3));
+        DLIB_TEST(det1.size() == det3.size());
+
+        // With several variants per image we only ever see that many distinct
+        // crops and, once every variant has been made, everything is a hit.
+        cropper.disable_crop_cache();
+        cropper.enable_crop_cache(10, 4);
+        std::set<std::string> variants;
+        matrix<rgb_pixel> crop;
+        std::vector<mmod_rect> dets;
+        for (int i = 0; i < 40; ++i)
+        {
+            cropper(img, rects, crop, dets);
+            variants.insert(crop_to_bytes(crop));
+        }
+        DLIB_TEST_MSG(variants.size() <= 4, variants.size());
+        DLIB_TEST(cropper.get_crop_cache_hits() + cropper.get_crop_cache_misses() == 40);
+        DLIB_TEST(cropper.get_crop_cache_misses() <= 4);
+
+        // A cache too small to hold every variant keeps evicting, but evicted
+        // crops are recomputed identically so no new variants ever show up.
+        cropper.disable_crop_cache();
+        cropper.enable_crop_cache(2, 6);
+        DLIB_TEST(cropper.get_crop_cache_max_size() == 2);
+        std::set<std::string> evicted_variants;
+        for (int i = 0; i < 100; ++i)
+        {
+            cropper(img, rects, crop, dets);
+            evicted_variants.insert(crop_to_bytes(crop));
+        }
+        DLIB_TEST_MSG(evicted_variants.size() <= 6, evicted_variants.size());
+        DLIB_TEST(cropper.get_crop_cache_hits() + cropper.get_crop_cache_misses() == 100);
+
+        // and turning the cache off puts us back on the ordinary random path
+        cropper.disable_crop_cache();
+        DLIB_TEST(cropper.crop_cache_enabled() == false);
+        cropper(img, rects, crop, dets);
+        DLIB_TEST(cropper.get_crop_cache_hits() == 0);
+        DLIB_TEST(cropper.get_crop_cache_misses() == 0);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     class image_tester : public tester
@@ -2010,6 +3124,7 @@ namespace
             test_integral_image<double, float>();
 
             test_zero_border_pixels();
+            test_assign_image_affine();
 
             test_filtering<unsigned char>(false,1);
             test_filtering<unsigned char>(true,1);
@@ -2022,6 +3137,8 @@ namespace
 
             test_label_connected_blobs();
             test_label_connected_blobs2();
+            test_label_connected_blobs_union_find();
+            test_euclidean_distance_transform();
             test_downsampled_filtering();
 
             test_segment_image<unsigned char>();
@@ -2030,6 +3147,8 @@ namespace
             test_segment_image<int>();
             test_segment_image<rgb_pixel>();
             test_segment_image<rgb_alpha_pixel>();
+            test_parallel_pixel_edges();
+            test_sobel_edge_map();
 
             test_dng_floats<float>(1);
             test_dng_floats<double>(1);
@@ -2050,6 +3169,16 @@ namespace
                 test_filtering2(7,7,rnd);
             }
 
+            test_threaded_filtering(3,3,rnd);
+            test_threaded_filtering(7,5,rnd);
+            test_threaded_filtering(15,15,rnd);
+
+            test_gaussian_blur_filter();
+            test_resize_image();
+            test_raw_image_view();
+            test_binary_morphology();
+            test_equalize_histogram_adaptive();
+
             for (int i = 0; i < 100; ++i)
                 test_filtering_center<float>(rnd);
             for (int i = 0; i < 100; ++i)
@@ -2086,6 +3215,7 @@ namespace
             }
 
             test_partition_pixels();
+            test_random_cropper_cache();
         }
     } a;
 
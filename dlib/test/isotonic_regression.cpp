@@ -33,9 +33,54 @@ namespace
                     "Runs tests on the isotonic_regression object.")
         {}
 
+        void test_running_isotonic_regression (
+        )
+        {
+            print_spinner();
+            dlib::rand rnd;
+
+            // Apply a long random sequence of inserts and removes and check that the
+            // incrementally maintained fit always matches a from scratch fit.
+            running_isotonic_regression runner;
+            std::vector<double> vect;
+            for (int iter = 0; iter < 2000; ++iter)
+            {
+                if (vect.size() == 0 || rnd.get_random_double() < 0.7)
+                {
+                    const size_t idx = rnd.get_random_32bit_number()%(vect.size()+1);
+                    const double val = rnd.get_random_gaussian();
+                    vect.insert(vect.begin()+idx, val);
+                    runner.insert(idx, val);
+                }
+                else
+                {
+                    const size_t idx = rnd.get_random_32bit_number()%vect.size();
+                    vect.erase(vect.begin()+idx);
+                    runner.remove(idx);
+                }
+
+                std::vector<double> expected = vect;
+                isotonic_regression mr;
+                mr(expected);
+
+                DLIB_TEST(runner.size() == vect.size());
+                std::vector<double> fitted;
+                runner.get_fitted_values(fitted);
+                DLIB_TEST(fitted.size() == expected.size());
+                for (size_t i = 0; i < expected.size(); ++i)
+                {
+                    DLIB_TEST(std::abs(fitted[i] - expected[i]) < 1e-12);
+                    DLIB_TEST(fitted[i] == runner.fitted_value(i));
+                    DLIB_TEST(runner.raw_value(i) == vect[i]);
+                }
+            }
+        }
+
         void perform_test (
         )
         {
+            test_running_isotonic_regression();
+
             dlib::rand rnd;
 
             for (int round = 0; round < 100; ++round)
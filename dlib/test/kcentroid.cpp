@@ -651,6 +651,73 @@ namespace
         DLIB_TEST(approx_equal(test.get_distance_function()(test.get_distance_function()), 0));
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_kcentroid_dictionary_pruning (
+    )
+    {
+        typedef matrix<double,0,1> sample_type;
+        typedef radial_basis_kernel<sample_type> kernel_type;
+        const kernel_type kern(0.1);
+
+        dlib::rand rnd;
+        kcentroid<kernel_type> test(kern, 0.001, 500);
+        std::vector<sample_type> samples;
+        for (int i = 0; i < 200; ++i)
+        {
+            sample_type s(4);
+            for (long j = 0; j < s.size(); ++j)
+                s(j) = rnd.get_random_gaussian();
+            samples.push_back(s);
+            test.train(s);
+        }
+        const unsigned long num_dict = test.dictionary_size();
+        DLIB_TEST(num_dict > 20);
+
+        // check that the fast strengths match a brute force leave-one-out computation
+        const matrix<double,0,1> strengths = test.get_dictionary_strengths();
+        DLIB_TEST(strengths.size() == (long)num_dict);
+        matrix<double> K(num_dict, num_dict);
+        const distance_function<kernel_type> df = test.get_distance_function();
+        for (unsigned long r = 0; r < num_dict; ++r)
+            for (unsigned long c = 0; c < num_dict; ++c)
+                K(r,c) = kern(df.get_basis_vectors()(r), df.get_basis_vectors()(c));
+        for (unsigned long i = 0; i < num_dict; ++i)
+        {
+            const matrix<double> Ki = removerc(K,i,i);
+            const matrix<double,0,1> ki = remove_row(colm(K,i),i);
+            const double delta = K(i,i) - trans(ki)*inv(Ki)*ki;
+            DLIB_TEST_MSG(std::abs(strengths(i) - delta) < 1e-6, std::abs(strengths(i) - delta));
+        }
+
+        // removing the weakest vectors shouldn't change the centroid much
+        kcentroid<kernel_type> pruned = test;
+        pruned.prune_dictionary(num_dict/2);
+        DLIB_TEST(pruned.dictionary_size() == num_dict/2);
+        DLIB_TEST(pruned.samples_trained() == test.samples_trained());
+        for (int i = 0; i < 20; ++i)
+            DLIB_TEST_MSG(std::abs(pruned(samples[i]) - test(samples[i])) < 1e-2,
+                          std::abs(pruned(samples[i]) - test(samples[i])));
+        // and the pruned object must still train correctly
+        for (int i = 0; i < 50; ++i)
+            pruned.train(samples[i]);
+
+        // removing an explicit index set should agree with a freshly computed inverse.
+        kcentroid<kernel_type> test2 = test;
+        std::vector<unsigned long> to_remove = {3, 0, 17, num_dict-1};
+        test2.remove_dictionary_vectors(to_remove);
+        DLIB_TEST(test2.dictionary_size() == num_dict-4);
+        const matrix<double,0,1> strengths2 = test2.get_dictionary_strengths();
+        const distance_function<kernel_type> df2 = test2.get_distance_function();
+        matrix<double> K2(test2.dictionary_size(), test2.dictionary_size());
+        for (long r = 0; r < K2.nr(); ++r)
+            for (long c = 0; c < K2.nc(); ++c)
+                K2(r,c) = kern(df2.get_basis_vectors()(r), df2.get_basis_vectors()(c));
+        const matrix<double> K2_inv = inv(K2);
+        for (long i = 0; i < K2.nr(); ++i)
+            DLIB_TEST(std::abs(strengths2(i) - 1/K2_inv(i,i)) < 1e-6);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     class kcentroid_tester : public tester
@@ -676,6 +743,7 @@ namespace
             test_kcentroid_with_offset_sparse_linear_kernel<offset_kernel<sparse_linear_kernel<std::map<unsigned long,double> > > >();
             test_kcentroid_with_sparse_linear_kernel<unopt_sparse_linear_kernel<std::map<unsigned long,double> > >();
             test_kcentroid_with_offset_sparse_linear_kernel<offset_kernel<unopt_sparse_linear_kernel<std::map<unsigned long,double> > > >();
+            test_kcentroid_dictionary_pruning();
         }
     } a;
 
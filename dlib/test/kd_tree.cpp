@@ -0,0 +1,207 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include <sstream>
+#include <vector>
+
+#include <dlib/graph_utils_threaded.h>
+#include <dlib/matrix.h>
+#include <dlib/rand.h>
+
+#include "tester.h"
+
+namespace
+{
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.kd_tree");
+
+    typedef matrix<double,0,1> sample_type;
+
+// ----------------------------------------------------------------------------------------
+
+    unsigned long brute_force_nearest (
+        const std::vector<sample_type>& samples,
+        const sample_type& query
+    )
+    {
+        unsigned long best_idx = 0;
+        double best = length_squared(samples[0] - query);
+        for (unsigned long i = 1; i < samples.size(); ++i)
+        {
+            const double d = length_squared(samples[i] - query);
+            if (d < best)
+            {
+                best = d;
+                best_idx = i;
+            }
+        }
+        return best_idx;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_against_brute_force (
+        const unsigned long num_points,
+        const long dims,
+        dlib::rand& rnd
+    )
+    {
+        print_spinner();
+
+        std::vector<sample_type> samples;
+        for (unsigned long i = 0; i < num_points; ++i)
+        {
+            sample_type temp(dims);
+            for (long d = 0; d < dims; ++d)
+                temp(d) = rnd.get_double_in_range(-10, 10);
+            samples.push_back(temp);
+        }
+
+        kd_tree<sample_type> tree;
+        tree.build(samples);
+        DLIB_TEST(tree.size() == num_points);
+
+        std::vector<sample_type> queries;
+        for (int i = 0; i < 200; ++i)
+        {
+            sample_type query(dims);
+            for (long d = 0; d < dims; ++d)
+                query(d) = rnd.get_double_in_range(-12, 12);
+            queries.push_back(query);
+        }
+        // Also query at the points themselves so exact hits are exercised.
+        for (int i = 0; i < 20; ++i)
+            queries.push_back(samples[rnd.get_random_32bit_number()%samples.size()]);
+
+        for (unsigned long i = 0; i < queries.size(); ++i)
+        {
+            double dist_squared;
+            const unsigned long idx = tree.nearest_neighbor(queries[i], dist_squared);
+            const unsigned long true_idx = brute_force_nearest(samples, queries[i]);
+            // Ties can be broken differently, so compare distances rather than
+            // indices.
+            DLIB_TEST(std::abs(dist_squared - length_squared(samples[true_idx]-queries[i])) < 1e-12);
+            DLIB_TEST(std::abs(length_squared(samples[idx]-queries[i]) - dist_squared) < 1e-12);
+        }
+
+        // the batch interface must agree with the single query interface
+        std::vector<unsigned long> indices;
+        tree.nearest_neighbors(queries, indices);
+        DLIB_TEST(indices.size() == queries.size());
+        for (unsigned long i = 0; i < queries.size(); ++i)
+            DLIB_TEST(indices[i] == tree.nearest_neighbor(queries[i]));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_serialization (
+        dlib::rand& rnd
+    )
+    {
+        print_spinner();
+
+        std::vector<sample_type> samples;
+        for (int i = 0; i < 500; ++i)
+        {
+            sample_type temp(3);
+            temp = rnd.get_random_gaussian(), rnd.get_random_gaussian(), rnd.get_random_gaussian();
+            samples.push_back(temp);
+        }
+
+        kd_tree<sample_type> tree;
+        tree.build(samples);
+
+        ostringstream sout;
+        serialize(tree, sout);
+        istringstream sin(sout.str());
+        kd_tree<sample_type> tree2;
+        deserialize(tree2, sin);
+
+        DLIB_TEST(tree2.size() == tree.size());
+        for (int i = 0; i < 100; ++i)
+        {
+            sample_type query(3);
+            query = rnd.get_random_gaussian(), rnd.get_random_gaussian(), rnd.get_random_gaussian();
+            DLIB_TEST(tree2.nearest_neighbor(query) == tree.nearest_neighbor(query));
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_degenerate_cases (
+    )
+    {
+        print_spinner();
+
+        kd_tree<sample_type> tree;
+        DLIB_TEST(tree.size() == 0);
+
+        // a single point
+        std::vector<sample_type> samples;
+        sample_type temp(2);
+        temp = 1, 2;
+        samples.push_back(temp);
+        tree.build(samples);
+        DLIB_TEST(tree.size() == 1);
+        temp = -4, 9;
+        DLIB_TEST(tree.nearest_neighbor(temp) == 0);
+
+        // many identical points plus one distinct point.  The identical points
+        // can't be split apart so they end up sharing a leaf.
+        samples.clear();
+        temp = 0, 0;
+        for (int i = 0; i < 200; ++i)
+            samples.push_back(temp);
+        temp = 5, 5;
+        samples.push_back(temp);
+        tree.build(samples);
+        DLIB_TEST(tree.size() == 201);
+        temp = 4, 4;
+        DLIB_TEST(tree.nearest_neighbor(temp) == 200);
+        temp = 1, 1;
+        double dist_squared;
+        tree.nearest_neighbor(temp, dist_squared);
+        DLIB_TEST(std::abs(dist_squared - 2) < 1e-12);
+
+        tree.clear();
+        DLIB_TEST(tree.size() == 0);
+
+        // building from an empty set leaves the tree empty
+        samples.clear();
+        tree.build(samples);
+        DLIB_TEST(tree.size() == 0);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class kd_tree_tester : public tester
+    {
+    public:
+        kd_tree_tester (
+        ) :
+            tester ("test_kd_tree",
+                    "Runs tests on the kd_tree object.")
+        {}
+
+        void perform_test (
+        )
+        {
+            dlib::rand rnd;
+
+            // fewer points than a single leaf holds
+            test_against_brute_force(5, 3, rnd);
+            // one dimensional data
+            test_against_brute_force(300, 1, rnd);
+            test_against_brute_force(1000, 2, rnd);
+            test_against_brute_force(1000, 5, rnd);
+            test_against_brute_force(4096, 10, rnd);
+
+            test_serialization(rnd);
+            test_degenerate_cases();
+        }
+    } a;
+
+}
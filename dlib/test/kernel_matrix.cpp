@@ -147,6 +147,35 @@ namespace
 
             samp3 += trans(kernel_matrix(kern, samp, vect2));
             DLIB_TEST(equal(samp3, 2*trans(kernel_matrix(kern, samp, vect2))));
+
+            test_kernel_matrix_threaded();
+        }
+
+        void test_kernel_matrix_threaded (
+        )
+        {
+            print_spinner();
+
+            typedef matrix<double,0,1> sample_type;
+            typedef radial_basis_kernel<sample_type> kernel_type;
+            kernel_type kern(0.1);
+
+            dlib::rand rnd;
+            // use enough samples that the tiling in kernel_matrix_threaded gets
+            // exercised with both full and partial tiles.
+            std::vector<sample_type> vect1, vect2;
+            for (int i = 0; i < 150; ++i)
+                vect1.push_back(randm(4,1,rnd));
+            for (int i = 0; i < 73; ++i)
+                vect2.push_back(randm(4,1,rnd));
+
+            const matrix<double> K1 = kernel_matrix(kern, vect1);
+            DLIB_TEST(equal(K1, kernel_matrix_threaded(kern, vect1)));
+            DLIB_TEST(equal(K1, kernel_matrix_threaded(kern, mat(vect1))));
+
+            const matrix<double> K2 = kernel_matrix(kern, vect1, vect2);
+            DLIB_TEST(equal(K2, kernel_matrix_threaded(kern, vect1, vect2)));
+            DLIB_TEST(equal(K2, kernel_matrix_threaded(kern, mat(vect1), mat(vect2))));
         }
     };
 
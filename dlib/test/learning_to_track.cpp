@@ -264,8 +264,29 @@ namespace
         DLIB_TEST(num_zero == 3);
 
 
+        // The stateful associate() path warm starts its solver from frame to frame
+        // but must update the tracks exactly like operator() does.  An always-true
+        // gate mustn't change anything either.
+        std::vector<track> tracks1, tracks2, tracks3;
+        track_association_function<detection> assoc2 = assoc;
+        track_association_function<detection> assoc3 = assoc;
+        for (int i = 0; i < 20; ++i)
+        {
+            dets = make_random_detections<detection>(i%4 + 1);
+            assoc(tracks1, dets);
+            assoc2.associate(tracks2, dets);
+            assoc3.associate(tracks3, dets, [](const detection&, const track&) { return true; });
+            DLIB_TEST(tracks2.size() == tracks1.size());
+            DLIB_TEST(tracks3.size() == tracks1.size());
+            for (unsigned long j = 0; j < tracks1.size(); ++j)
+            {
+                DLIB_TEST(tracks2[j].time_since_last_association == tracks1[j].time_since_last_association);
+                DLIB_TEST(tracks3[j].time_since_last_association == tracks1[j].time_since_last_association);
+            }
+        }
+
 
-        ostringstream sout; 
+        ostringstream sout;
         serialize(assoc, sout);
 
         istringstream sin(sout.str());
@@ -375,6 +375,54 @@ namespace
             DLIB_TEST(edges.size() == 4*3/2);
         }
 
+        void test_knn_threaded()
+        {
+            std::vector<matrix<double,0,1> > samples;
+            matrix<double,0,1> m(3);
+            for (int i = 0; i < 150; ++i)
+            {
+                m(0) = rnd.get_random_gaussian();
+                m(1) = rnd.get_random_gaussian();
+                m(2) = rnd.get_random_gaussian();
+                samples.push_back(m);
+            }
+
+            // The threaded overload considers every pair of samples just like the
+            // serial version, so the two must produce identical edge sets.
+            const unsigned long kvals[] = {1, 3, 7, 200};
+            const unsigned long threads[] = {1, 2, 4};
+            for (unsigned long ki = 0; ki < sizeof(kvals)/sizeof(kvals[0]); ++ki)
+            {
+                for (unsigned long ti = 0; ti < sizeof(threads)/sizeof(threads[0]); ++ti)
+                {
+                    print_spinner();
+                    std::vector<sample_pair> edges1, edges2;
+                    find_k_nearest_neighbors(samples, squared_euclidean_distance(), kvals[ki], edges1);
+                    find_k_nearest_neighbors(samples, squared_euclidean_distance(), kvals[ki], threads[ti], edges2);
+
+                    std::sort(edges1.begin(), edges1.end(), &order_by_index<sample_pair>);
+                    std::sort(edges2.begin(), edges2.end(), &order_by_index<sample_pair>);
+
+                    DLIB_TEST_MSG(edges1.size() == edges2.size(), edges1.size() << "    " << edges2.size());
+                    for (unsigned long i = 0; i < edges1.size(); ++i)
+                    {
+                        DLIB_TEST(edges1[i] == edges2[i]);
+                        DLIB_TEST(edges1[i].distance() == edges2[i].distance());
+                    }
+                }
+            }
+
+            // make sure the distance threshold is honored as well
+            std::vector<sample_pair> edges1, edges2;
+            find_k_nearest_neighbors(samples, squared_euclidean_distance(0.5, 2.0), 3, edges1);
+            find_k_nearest_neighbors(samples, squared_euclidean_distance(0.5, 2.0), 3, 4, edges2);
+            std::sort(edges1.begin(), edges1.end(), &order_by_index<sample_pair>);
+            std::sort(edges2.begin(), edges2.end(), &order_by_index<sample_pair>);
+            DLIB_TEST(edges1.size() == edges2.size());
+            for (unsigned long i = 0; i < edges1.size(); ++i)
+                DLIB_TEST(edges1[i] == edges2[i]);
+        }
+
         void perform_test (
         )
         {
@@ -392,6 +440,7 @@ namespace
             test_knn_lsh_sparse<float>();
             test_knn_lsh_dense<double>();
             test_knn_lsh_dense<float>();
+            test_knn_threaded();
 
         }
     };
@@ -0,0 +1,143 @@
+// Copyright (C) 2006  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <dlib/pipe.h>
+
+#include "tester.h"
+
+namespace
+{
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.lockfree_pipe");
+
+// ----------------------------------------------------------------------------------------
+
+    void test_single_thread (
+    )
+    {
+        lockfree_pipe<int> q(10);
+        DLIB_TEST(q.max_size() == 16);  // rounded up to a power of 2
+        DLIB_TEST(q.size() == 0);
+        DLIB_TEST(q.is_enabled() == true);
+
+        int a;
+        for (int i = 0; i < 16; ++i)
+        {
+            a = i;
+            DLIB_TEST(q.enqueue(a) == true);
+        }
+        DLIB_TEST(q.size() == 16);
+        a = 99;
+        DLIB_TEST(q.enqueue_or_timeout(std::move(a), 10) == false);
+        for (int i = 0; i < 16; ++i)
+        {
+            DLIB_TEST(q.dequeue(a) == true);
+            DLIB_TEST(a == i);
+        }
+        DLIB_TEST(q.size() == 0);
+        DLIB_TEST(q.dequeue_or_timeout(a, 10) == false);
+
+        q.disable();
+        DLIB_TEST(q.is_enabled() == false);
+        a = 5;
+        DLIB_TEST(q.enqueue(a) == false);
+        DLIB_TEST(q.dequeue(a) == false);
+        q.enable();
+        DLIB_TEST(q.is_enabled() == true);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_many_threads (
+    )
+    {
+        const int num_producers = 3;
+        const int num_consumers = 3;
+        const int items_per_producer = 30000;
+
+        lockfree_pipe<int> q(64);
+        std::atomic<long long> total(0);
+        std::atomic<int> num_consumed(0);
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < num_producers; ++p)
+        {
+            threads.emplace_back([&]()
+            {
+                for (int i = 0; i < items_per_producer; ++i)
+                {
+                    int val = i;
+                    q.enqueue(val);
+                }
+            });
+        }
+        for (int c = 0; c < num_consumers; ++c)
+        {
+            threads.emplace_back([&]()
+            {
+                int val;
+                while (num_consumed.load() < num_producers*items_per_producer &&
+                       q.dequeue_or_timeout(val, 1000))
+                {
+                    total += val;
+                    ++num_consumed;
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+
+        const long long expected = (long long)num_producers*((long long)items_per_producer*(items_per_producer-1)/2);
+        DLIB_TEST(num_consumed == num_producers*items_per_producer);
+        DLIB_TEST_MSG(total == expected, "total: " << total << "  expected: " << expected);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_disable_unblocks (
+    )
+    {
+        lockfree_pipe<int> q(4);
+        std::atomic<bool> returned(false);
+        std::thread t([&]()
+        {
+            int val;
+            const bool res = q.dequeue(val);
+            DLIB_TEST(res == false);
+            returned = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        DLIB_TEST(returned == false);
+        q.disable();
+        t.join();
+        DLIB_TEST(returned == true);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class lockfree_pipe_tester : public tester
+    {
+    public:
+        lockfree_pipe_tester (
+        ) :
+            tester ("test_lockfree_pipe",
+                    "Runs tests on the lockfree_pipe component.")
+        {}
+
+        void perform_test (
+        )
+        {
+            test_single_thread();
+            test_many_threads();
+            test_disable_unblocks();
+        }
+    } a;
+
+}
@@ -0,0 +1,251 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <dlib/lsh.h>
+#include <dlib/graph_utils.h>
+#include <dlib/matrix.h>
+
+#include "tester.h"
+
+namespace
+{
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.lsh_index");
+
+// ----------------------------------------------------------------------------------------
+
+    typedef matrix<double,0,1> sample_type;
+
+    sample_type make_cluster_member (
+        long cluster,
+        long seed
+    )
+    /*!
+        ensures
+            - returns a small random perturbation of cluster's base direction.  All the
+              samples made for a cluster point in nearly the same direction, so they
+              hash to nearly identical codes, while samples from different clusters are
+              essentially random directions relative to each other.
+    !*/
+    {
+        return matrix_cast<double>(gaussian_randm(10,1,cluster))
+             + 0.01*matrix_cast<double>(gaussian_randm(10,1,10000+seed));
+    }
+
+    std::vector<std::pair<unsigned long,double> > brute_force_query (
+        const lsh_index<sample_type>& index,
+        const std::vector<unsigned long>& ids,
+        const sample_type& samp,
+        const unsigned long k
+    )
+    {
+        cosine_distance dist_funct;
+        std::vector<std::pair<unsigned long,double> > results;
+        for (auto id : ids)
+            results.push_back(make_pair(id, dist_funct(samp, index[id])));
+        std::sort(results.begin(), results.end(),
+            [](const std::pair<unsigned long,double>& a, const std::pair<unsigned long,double>& b)
+            { return a.second < b.second; });
+        if (results.size() > k)
+            results.resize(k);
+        return results;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_projection_hash_batch_and_multi_probe (
+    )
+    {
+        print_spinner();
+
+        std::vector<sample_type> samples;
+        for (long i = 0; i < 150; ++i)
+            samples.push_back(make_cluster_member(i%10, i));
+
+        const projection_hash h = create_random_projection_hash(samples, 6);
+
+        // hashing a batch of columns must give the same codes as hashing the
+        // vectors one at a time.
+        matrix<double> vects(samples[0].size(), samples.size());
+        for (unsigned long j = 0; j < samples.size(); ++j)
+            set_colm(vects, j) = samples[j];
+        std::vector<unsigned long> hashes;
+        h(vects, hashes);
+        DLIB_TEST(hashes.size() == samples.size());
+        for (unsigned long j = 0; j < samples.size(); ++j)
+            DLIB_TEST(hashes[j] == h(samples[j]));
+
+        for (long i = 0; i < 20; ++i)
+        {
+            const sample_type v = make_cluster_member(3, 1000+i);
+            const matrix<double,0,1> z = h.get_projection_matrix()*v + h.get_offset_matrix();
+            const long bits = z.size();
+
+            std::vector<unsigned long> probes;
+            h.multi_probe(v, 10, probes);
+            DLIB_TEST(probes.size() == 10);
+            DLIB_TEST(probes[0] == h(v));
+
+            // all the probes must name distinct buckets ordered from cheapest to
+            // most expensive set of bit flips.
+            double prev_cost = 0;
+            for (unsigned long j = 0; j < probes.size(); ++j)
+            {
+                DLIB_TEST(probes[j] < h.num_hash_bins());
+                for (unsigned long k = 0; k < j; ++k)
+                    DLIB_TEST(probes[j] != probes[k]);
+
+                double cost = 0;
+                const unsigned long flipped = probes[j] ^ probes[0];
+                for (long b = 0; b < bits; ++b)
+                {
+                    if (flipped & (1UL<<b))
+                        cost += std::abs(z(bits-1-b));
+                }
+                DLIB_TEST_MSG(cost >= prev_cost - 1e-12, cost - prev_cost);
+                prev_cost = cost;
+            }
+
+            // asking for every bucket enumerates the whole hash table exactly once.
+            h.multi_probe(v, h.num_hash_bins(), probes);
+            DLIB_TEST(probes.size() == h.num_hash_bins());
+            std::vector<unsigned long> sorted = probes;
+            std::sort(sorted.begin(), sorted.end());
+            for (unsigned long j = 0; j < sorted.size(); ++j)
+                DLIB_TEST(sorted[j] == j);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class test_lsh_index : public tester
+    {
+    public:
+        test_lsh_index (
+        ) :
+            tester ("test_lsh_index",
+                    "Runs tests on the lsh_index object.")
+        {}
+
+        void perform_test (
+        )
+        {
+            test_projection_hash_batch_and_multi_probe();
+
+            lsh_index<sample_type> index;
+
+            print_spinner();
+
+            // querying an empty index finds nothing
+            std::vector<std::pair<unsigned long,double> > results;
+            index.query(make_cluster_member(0,0), 3, results);
+            DLIB_TEST(results.size() == 0);
+
+            // Fill the index with 40 clusters of 5 samples each.
+            std::vector<unsigned long> ids;
+            for (long i = 0; i < 200; ++i)
+            {
+                const sample_type samp = make_cluster_member(i/5, i);
+                const unsigned long id = index.add(samp);
+                // ids are unique and the stored samples match what we put in
+                DLIB_TEST(std::find(ids.begin(), ids.end(), id) == ids.end());
+                DLIB_TEST(index.contains(id));
+                DLIB_TEST(max(abs(index[id] - samp)) == 0);
+                ids.push_back(id);
+            }
+            DLIB_TEST(index.size() == 200);
+
+            print_spinner();
+
+            // A query for a vector that is in the index has to find that exact vector
+            // first since it shares all its hash buckets, and its cluster mates give
+            // it at least 4 other candidates to return.
+            for (long i = 0; i < 200; i += 17)
+            {
+                index.query(index[ids[i]], 3, results);
+                DLIB_TEST(results.size() == 3);
+                DLIB_TEST(results[0].first == ids[i]);
+                DLIB_TEST(std::abs(results[0].second) < 1e-7);
+                // results are sorted by distance
+                DLIB_TEST(results[0].second <= results[1].second);
+                DLIB_TEST(results[1].second <= results[2].second);
+            }
+
+            print_spinner();
+
+            // The index is approximate, but queries near a cluster should almost
+            // always agree with an exhaustive search.
+            unsigned long hits = 0, total = 0;
+            for (long i = 0; i < 20; ++i)
+            {
+                const sample_type samp = make_cluster_member(2*i, 1000+i);
+                index.query(samp, 5, results, 40);
+                const auto truth = brute_force_query(index, ids, samp, 5);
+                for (auto& r : results)
+                {
+                    ++total;
+                    for (auto& t : truth)
+                    {
+                        if (r.first == t.first)
+                        {
+                            ++hits;
+                            break;
+                        }
+                    }
+                }
+                // the reported distances match the distance function
+                cosine_distance dist_funct;
+                for (auto& r : results)
+                    DLIB_TEST(std::abs(r.second - dist_funct(samp, index[r.first])) < 1e-14);
+            }
+            dlog << LINFO << "recall: " << hits/(double)total;
+            DLIB_TEST(total >= 5*20*0.8);
+            DLIB_TEST_MSG(hits/(double)total > 0.8, hits/(double)total);
+
+            print_spinner();
+
+            // removed samples must never come back from a query
+            index.query(index[ids[5]], 1, results);
+            DLIB_TEST(results[0].first == ids[5]);
+            const sample_type removed_samp = index[ids[5]];
+            index.remove(ids[5]);
+            DLIB_TEST(!index.contains(ids[5]));
+            DLIB_TEST(index.size() == 199);
+            index.query(removed_samp, 10, results);
+            for (auto& r : results)
+                DLIB_TEST(r.first != ids[5]);
+
+            // ids are not reused after a removal
+            const unsigned long new_id = index.add(removed_samp);
+            DLIB_TEST(new_id != ids[5]);
+            DLIB_TEST(index.size() == 200);
+            index.query(removed_samp, 1, results);
+            DLIB_TEST(results[0].first == new_id);
+
+            print_spinner();
+
+            // check that serialization round trips
+            stringstream ss;
+            serialize(index, ss);
+            lsh_index<sample_type> index2;
+            deserialize(index2, ss);
+            DLIB_TEST(index2.size() == index.size());
+            for (long i = 0; i < 20; ++i)
+            {
+                const sample_type samp = make_cluster_member(i, 2000+i);
+                std::vector<std::pair<unsigned long,double> > results2;
+                index.query(samp, 4, results);
+                index2.query(samp, 4, results2);
+                DLIB_TEST(results2 == results);
+            }
+        }
+    } a;
+
+}
+
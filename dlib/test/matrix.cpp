@@ -1498,7 +1498,88 @@ namespace
         }
     }
 
+// ----------------------------------------------------------------------------------------
 
+    void test_scratch_arena()
+    {
+        print_spinner();
+
+        matrix<double> a = randm(20,20);
+        matrix<double> b = randm(20,20);
+        matrix<double> c = randm(20,20);
+
+        // results computed with no matrix_scratch_context active
+        const matrix<double> r1 = a*b*c;
+        const matrix<double> r2 = (a+b)*(b+c);
+        matrix<double> r3 = a;
+        r3 = r3*b + trans(r3);
+        matrix<double> r4 = a;
+        set_colm(r4,2) = r4*colm(b,0);
+
+        {
+            matrix_scratch_context scratch;
+            DLIB_TEST(equal(a*b*c, r1));
+            DLIB_TEST(equal((a+b)*(b+c), r2));
+
+            matrix<double> temp = a;
+            temp = temp*b + trans(temp);
+            DLIB_TEST(equal(temp, r3));
+
+            temp = a;
+            set_colm(temp,2) = temp*colm(b,0);
+            DLIB_TEST(equal(temp, r4));
+
+            // nested scopes should work the same way
+            {
+                matrix_scratch_context nested;
+                DLIB_TEST(equal(a*b*c, r1));
+            }
+            DLIB_TEST(equal(a*b*c, r1));
+        }
+
+        // A context too small to hold the temporaries must fall back to the heap
+        // without changing any results.
+        {
+            matrix_scratch_context scratch(64);
+            DLIB_TEST(equal(a*b*c, r1));
+            DLIB_TEST(equal((a+b)*(b+c), r2));
+        }
+
+        // and everything should still be fine once all the contexts are gone.
+        DLIB_TEST(equal(a*b*c, r1));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_row_ptr (
+    )
+    {
+        matrix<double> m(5,9);
+        for (long r = 0; r < m.nr(); ++r)
+            for (long c = 0; c < m.nc(); ++c)
+                m(r,c) = r*m.nc() + c;
+
+        const matrix<double>& cm = m;
+        for (long r = 0; r < m.nr(); ++r)
+        {
+            DLIB_TEST(m.row_ptr(r) == &m(r,0));
+            DLIB_TEST(cm.row_ptr(r) == &cm(r,0));
+            for (long c = 0; c < m.nc(); ++c)
+                DLIB_TEST(m.row_ptr(r)[c] == m(r,c));
+        }
+
+        // writes through row_ptr() must be visible via operator()
+        m.row_ptr(2)[4] = -1;
+        DLIB_TEST(m(2,4) == -1);
+
+        // statically sized matrices use the row major layout too
+        matrix<float,3,4> ms;
+        ms = 0;
+        ms.row_ptr(1)[2] = 8;
+        DLIB_TEST(ms(1,2) == 8);
+    }
+
+// ----------------------------------------------------------------------------------------
 
 
 
@@ -1517,6 +1598,8 @@ namespace
         {
             matrix_test();
             matrix_test2();
+            test_scratch_arena();
+            test_row_ptr();
         }
     } a;
 
@@ -413,6 +413,35 @@ namespace
         DLIB_TEST_MSG(max(abs(dm7*inv(dm7) - identity_matrix<double>(7))) < 1e-12, max(abs(dm7*inv(dm7) - identity_matrix<double>(7))));
         DLIB_TEST(equal(inv(dm7),  inv(m7)));
         DLIB_TEST(abs(det(dm7) - det(m7)) < 1e-14);
+
+        // The dynamically sized matrices dispatch to the unrolled small matrix formulas
+        // at runtime, so they have to agree with the compile time sized versions.
+        {
+            matrix<double> d1 = randm(1,1,rnd), d2 = randm(2,2,rnd), d3 = randm(3,3,rnd), d4 = randm(4,4,rnd);
+            matrix<double,1,1> s1(d1);
+            matrix<double,2,2> s2(d2);
+            matrix<double,3,3> s3(d3);
+            matrix<double,4,4> s4(d4);
+
+            DLIB_TEST(equal(inv(d1), inv(s1)));
+            DLIB_TEST(equal(inv(d2), inv(s2)));
+            DLIB_TEST(equal(inv(d3), inv(s3)));
+            DLIB_TEST(equal(inv(d4), inv(s4)));
+            DLIB_TEST(abs(det(d1) - det(s1)) < 1e-14);
+            DLIB_TEST(abs(det(d2) - det(s2)) < 1e-14);
+            DLIB_TEST(abs(det(d3) - det(s3)) < 1e-14);
+            DLIB_TEST(abs(det(d4) - det(s4)) < 1e-13);
+
+            DLIB_TEST(max(abs(d3*inv(d3) - identity_matrix<double>(3))) < 1e-12);
+            DLIB_TEST(max(abs(d4*inv(d4) - identity_matrix<double>(4))) < 1e-12);
+
+            // Singular small matrices mirror the compile time sized behavior and
+            // return the identity matrix.
+            matrix<double> z(3,3);
+            z = 0;
+            DLIB_TEST(equal(inv(z), identity_matrix<double>(3)));
+            DLIB_TEST(det(z) == 0);
+        }
         DLIB_TEST(abs(min(dm7) - min(m7)) < 1e-14);
         DLIB_TEST(abs(max(dm7) - max(m7)) < 1e-14);
         DLIB_TEST_MSG(abs(sum(dm7) - sum(m7)) < 1e-13,sum(dm7) - sum(m7));
@@ -1148,6 +1177,125 @@ namespace
 
 
 
+// ----------------------------------------------------------------------------------------
+
+    template <typename type>
+    void test_transpose_assign (
+    )
+    {
+        // Exercise the blocked physical transpose kernel that matrix_assign uses for
+        // dest = trans(M) expressions.  The sizes are chosen to hit the 8x8 tiled
+        // path, the blocking boundaries, and the ragged edge code.
+        dlib::rand rnd;
+        const long sizes[] = {1, 2, 7, 8, 9, 63, 64, 65, 100, 150};
+        for (long m : sizes)
+        {
+            for (long n : sizes)
+            {
+                matrix<type> a(m,n);
+                for (long r = 0; r < m; ++r)
+                    for (long c = 0; c < n; ++c)
+                        a(r,c) = static_cast<type>(rnd.get_random_gaussian());
+
+                matrix<type> b = trans(a);
+                DLIB_TEST(b.nr() == n && b.nc() == m);
+                bool ok = true;
+                for (long r = 0; r < m; ++r)
+                    for (long c = 0; c < n; ++c)
+                        ok = ok && (b(c,r) == a(r,c));
+                DLIB_TEST_MSG(ok, "m: " << m << "  n: " << n);
+
+                // transposing into a column major matrix
+                matrix<type,0,0,default_memory_manager,column_major_layout> bc = trans(a);
+                DLIB_TEST(dlib::equal(matrix_cast<type>(bc), b, (type)0));
+
+                // in-place transpose has to give the same answer
+                matrix<type> d = a;
+                d = trans(d);
+                DLIB_TEST(dlib::equal(d, b, (type)0));
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename type>
+    void test_blocked_multiply (
+    )
+    {
+        // Exercise the blocked multiply in default_matrix_multiply, including the
+        // packed panel float GEMM.  The sizes are chosen so we hit full tiles, the
+        // blocking boundaries, and the ragged edge code.
+        dlib::rand rnd;
+        const long sizes[] = {37, 96, 97, 130, 263};
+        for (long m : sizes)
+        {
+            for (long n : sizes)
+            {
+                const long k = (m+n)/2 + 1;
+                matrix<type> a(m,k), b(k,n);
+                for (long r = 0; r < a.nr(); ++r)
+                    for (long c = 0; c < a.nc(); ++c)
+                        a(r,c) = static_cast<type>(rnd.get_random_gaussian());
+                for (long r = 0; r < b.nr(); ++r)
+                    for (long c = 0; c < b.nc(); ++c)
+                        b(r,c) = static_cast<type>(rnd.get_random_gaussian());
+
+                const matrix<type> p = a*b;
+                DLIB_TEST(p.nr() == m && p.nc() == n);
+
+                // compare against the obvious triple loop
+                bool ok = true;
+                for (long r = 0; r < m; ++r)
+                {
+                    for (long c = 0; c < n; ++c)
+                    {
+                        type sum = 0;
+                        for (long i = 0; i < k; ++i)
+                            sum += a(r,i)*b(i,c);
+                        ok = ok && (std::abs(p(r,c) - sum) < 1e-4);
+                    }
+                }
+                DLIB_TEST_MSG(ok, "m: " << m << "  n: " << n << "  k: " << k);
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_max_points_interpolated (
+    )
+    {
+        // The batched version has to give exactly the same subpixel peaks as calling
+        // max_point_interpolated() on each map.  Use shapes that hit the 2-D fit, the
+        // row and column vector fits, and peaks on the border.
+        dlib::rand rnd;
+        std::vector<matrix<double> > maps;
+        const long shapes[][2] = {{20,30}, {1,25}, {25,1}, {3,3}, {7,40}};
+        for (auto& s : shapes)
+        {
+            matrix<double> m(s[0], s[1]);
+            for (long r = 0; r < m.nr(); ++r)
+                for (long c = 0; c < m.nc(); ++c)
+                    m(r,c) = rnd.get_random_gaussian();
+            maps.push_back(m);
+        }
+        // add one with the peak pinned to a corner
+        matrix<double> m = zeros_matrix<double>(15,15);
+        m(0,14) = 10;
+        maps.push_back(m);
+
+        const std::vector<dlib::vector<double,2> > peaks = max_points_interpolated(maps);
+        DLIB_TEST(peaks.size() == maps.size());
+        for (unsigned long i = 0; i < maps.size(); ++i)
+        {
+            const dlib::vector<double,2> p = max_point_interpolated(maps[i]);
+            DLIB_TEST_MSG(p == peaks[i], "i: " << i << "  p: " << p << "  peaks[i]: " << peaks[i]);
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
     class matrix_tester : public tester
     {
     public:
@@ -1162,6 +1310,16 @@ namespace
         {
             matrix_test1();
             matrix_test2();
+            print_spinner();
+            test_transpose_assign<float>();
+            print_spinner();
+            test_transpose_assign<double>();
+            print_spinner();
+            test_blocked_multiply<float>();
+            print_spinner();
+            test_blocked_multiply<double>();
+            print_spinner();
+            test_max_points_interpolated();
         }
     } a;
 
@@ -1086,6 +1086,46 @@ namespace
 
     }
 
+    void test_big_elementwise_assign()
+    {
+        // These expressions are big enough to take the parallel path through
+        // matrix_assign_default() on multi-core machines, so make sure that path
+        // computes the same thing as an explicit elementwise loop.
+        print_spinner();
+        dlib::rand rnd;
+
+        matrix<double> A(1500, 1600), B(1500, 1600), C(1500, 1600);
+        for (long r = 0; r < A.nr(); ++r)
+        {
+            for (long c = 0; c < A.nc(); ++c)
+            {
+                A(r,c) = rnd.get_random_gaussian();
+                B(r,c) = rnd.get_random_gaussian();
+                C(r,c) = rnd.get_random_gaussian();
+            }
+        }
+
+        matrix<double> res = pointwise_multiply(A,B) + C*3.5;
+        for (long r = 0; r < A.nr(); ++r)
+            for (long c = 0; c < A.nc(); ++c)
+                DLIB_TEST(res(r,c) == A(r,c)*B(r,c) + C(r,c)*3.5);
+
+        // non-destructive aliasing of the destination is fine
+        matrix<double> expected = 2*res + 1;
+        res = 2*res + 1;
+        DLIB_TEST(dlib::equal(res, expected, 0.0));
+
+        // and the column major layout takes its own path
+        print_spinner();
+        matrix<double,0,0,default_memory_manager,column_major_layout> A2, B2, res2;
+        A2 = A;
+        B2 = B;
+        res2 = pointwise_multiply(A2,B2) - B2/2;
+        for (long r = 0; r < A.nr(); ++r)
+            for (long c = 0; c < A.nc(); ++c)
+                DLIB_TEST(res2(r,c) == A(r,c)*B(r,c) - B(r,c)/2);
+    }
+
     class matrix_tester : public tester
     {
     public:
@@ -1110,6 +1150,7 @@ namespace
 
             test_complex();
             test_linpiece();
+            test_big_elementwise_assign();
         }
     } a;
 
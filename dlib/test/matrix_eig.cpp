@@ -170,6 +170,9 @@ namespace
         test_eigenvalue(10*randm<double>(4,4));
         test_eigenvalue(10*randm<double>(15,15));
         test_eigenvalue(10*randm<double>(150,150));
+        // this one is big enough to trigger the multithreaded code path in the
+        // symmetric solver
+        test_eigenvalue(10*randm<double>(400,400));
 
         test_eigenvalue(10*randm<double,1,1>());
         test_eigenvalue(10*randm<double,2,2>());
@@ -140,6 +140,8 @@ namespace
         test_qr(10*randmat<double>(100,100));
         test_qr(10*randmat<double>(237,200));
         test_qr(10*randmat<double>(200,101));
+        // this one is big enough to trigger the multithreaded code path
+        test_qr(10*randmat<double>(600,300));
 
         test_qr(10*randmat<double,1,1>());
         test_qr(10*randmat<double,2,2>());
@@ -135,6 +135,64 @@ namespace
             DLIB_TEST(assignment_cost(cost,assign) == true_eval);
         }
 
+        void test_solver_object_and_batch()
+        {
+            print_spinner();
+
+            // A reused solver object must give the same answers as the plain function.
+            max_cost_assignment_solver<int> solver;
+            std::vector<matrix<int> > costs;
+            for (int i = 0; i < 200; ++i)
+            {
+                const long size = rnd.get_random_32bit_number()%15;
+                const long range = rnd.get_random_32bit_number()%100 + 1;
+                costs.push_back(matrix_cast<int>(randm(size,size,rnd)*range) - range/2);
+
+                const std::vector<long>& assign = solver(costs.back());
+                DLIB_TEST(assign == max_cost_assignment(costs.back()));
+            }
+
+            // and the batched overload must match as well
+            std::vector<std::vector<long> > assignments;
+            thread_pool tp(3);
+            max_cost_assignment(tp, costs, assignments);
+            DLIB_TEST(assignments.size() == costs.size());
+            for (unsigned long i = 0; i < costs.size(); ++i)
+                DLIB_TEST(assignments[i] == max_cost_assignment(costs[i]));
+        }
+
+        void test_warm_started_solves()
+        {
+            print_spinner();
+
+            // Warm starting only changes the runtime, never the cost of the returned
+            // assignment.  Simulate a slowly drifting cost matrix, like tracking
+            // produces frame to frame, and also resize it now and then.
+            max_cost_assignment_solver<int> solver;
+            matrix<int> cost = matrix_cast<int>(randm(12,12,rnd)*100);
+            for (int iter = 0; iter < 300; ++iter)
+            {
+                if ((iter%50) == 49)
+                {
+                    const long size = rnd.get_random_32bit_number()%15 + 1;
+                    cost = matrix_cast<int>(randm(size,size,rnd)*100);
+                }
+                else
+                {
+                    // drift a few entries
+                    for (int i = 0; i < 5; ++i)
+                    {
+                        const long r = rnd.get_random_32bit_number()%cost.nr();
+                        const long c = rnd.get_random_32bit_number()%cost.nc();
+                        cost(r,c) += (int)(rnd.get_random_32bit_number()%11) - 5;
+                    }
+                }
+
+                const std::vector<long>& assign = solver.solve_warm_started(cost);
+                DLIB_TEST(assignment_cost(cost, assign) == assignment_cost(cost, max_cost_assignment(cost)));
+            }
+        }
+
         void perform_test (
         )
         {
@@ -148,6 +206,9 @@ namespace
                 test_hungarian<long>();
                 test_hungarian<int64>();
             }
+
+            test_solver_object_and_batch();
+            test_warm_started_solves();
         }
     } a;
 
@@ -46,6 +46,23 @@ namespace
             DLIB_TEST(md5(temp) == md5(str));
         }
 
+        // check some inputs longer than the chunk size used by the stream version
+        DLIB_TEST(md5(std::string(4097,'a')) == "8cfc1a0bd8cd76599e76e5e721c6e62e");
+
+        std::string big;
+        for (int i = 0; i < 9000; ++i)
+            big += static_cast<char>(i%256);
+        DLIB_TEST(md5(big) == "2b8689ba436faee8874dd4b98001f9bd");
+
+        // exercise all the padding and chunking boundary cases
+        const unsigned long lengths[] = {55,56,57,63,64,65,127,128,4031,4032,4033,4095,4096,4097,8191,8192,8193};
+        for (unsigned long i = 0; i < sizeof(lengths)/sizeof(lengths[0]); ++i)
+        {
+            const std::string temp = big.substr(0,lengths[i]);
+            istringstream str(temp);
+            DLIB_TEST_MSG(md5(temp) == md5(str), "length: " << lengths[i]);
+        }
+
     }
 
 
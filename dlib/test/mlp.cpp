@@ -0,0 +1,120 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include <sstream>
+#include <string>
+
+#include <dlib/mlp.h>
+#include <dlib/rand.h>
+#include "tester.h"
+
+namespace
+{
+
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.mlp");
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename mlp_type>
+    void test_batched_evaluation (
+    )
+    {
+        dlib::rand rnd;
+
+        // a small two input, one output network trained on the xor problem, just
+        // like the mlp example program
+        mlp_type net(2, 5);
+        matrix<double,2,1> sample;
+        for (int i = 0; i < 2000; ++i)
+        {
+            sample(0) = rnd.get_random_double();
+            sample(1) = rnd.get_random_double();
+            if ((sample(0) > 0.5) != (sample(1) > 0.5))
+                net.train(sample, 1);
+            else
+                net.train(sample, 0);
+        }
+
+        // the batched operator() must produce exactly the per-sample outputs,
+        // one row per sample
+        const long batch_size = 37;
+        matrix<double> in(batch_size, 2);
+        for (long r = 0; r < in.nr(); ++r)
+            for (long c = 0; c < in.nc(); ++c)
+                in(r,c) = rnd.get_random_double();
+
+        matrix<double> out;
+        typename mlp_type::batch_context context;
+        net(in, out, context);
+        DLIB_TEST(out.nr() == batch_size);
+        DLIB_TEST(out.nc() == 1);
+        for (long r = 0; r < in.nr(); ++r)
+        {
+            const matrix<double> ref = net(trans(rowm(in,r)));
+            DLIB_TEST_MSG(max(abs(trans(rowm(out,r)) - ref)) < 1e-12,
+                          max(abs(trans(rowm(out,r)) - ref)));
+        }
+
+        // reusing the context for another batch, including one of a different
+        // size, must still match
+        matrix<double> in2(1, 2);
+        in2(0,0) = rnd.get_random_double();
+        in2(0,1) = rnd.get_random_double();
+        net(in2, out, context);
+        DLIB_TEST(out.nr() == 1 && out.nc() == 1);
+        DLIB_TEST(max(abs(trans(rowm(out,0)) - net(trans(rowm(in2,0))))) < 1e-12);
+
+        // a network with two hidden layers and several outputs works too
+        mlp_type net2(3, 6, 4, 2);
+        for (int i = 0; i < 200; ++i)
+        {
+            matrix<double,3,1> s;
+            s = rnd.get_random_double(), rnd.get_random_double(), rnd.get_random_double();
+            matrix<double,2,1> t;
+            t = rnd.get_random_double(), rnd.get_random_double();
+            net2.train(s, t);
+        }
+        matrix<double> in3(11, 3);
+        for (long r = 0; r < in3.nr(); ++r)
+            for (long c = 0; c < in3.nc(); ++c)
+                in3(r,c) = rnd.get_random_double();
+
+        typename mlp_type::batch_context context2;
+        net2(in3, out, context2);
+        DLIB_TEST(out.nr() == in3.nr());
+        DLIB_TEST(out.nc() == 2);
+        for (long r = 0; r < in3.nr(); ++r)
+        {
+            const matrix<double> ref = net2(trans(rowm(in3,r)));
+            DLIB_TEST_MSG(max(abs(trans(rowm(out,r)) - ref)) < 1e-12,
+                          max(abs(trans(rowm(out,r)) - ref)));
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class mlp_tester : public tester
+    {
+    public:
+        mlp_tester (
+        ) :
+            tester ("test_mlp",
+                    "Runs tests on the mlp component.")
+        {}
+
+        void perform_test (
+        )
+        {
+            print_spinner();
+            test_batched_evaluation<mlp::kernel_1a>();
+            print_spinner();
+            test_batched_evaluation<mlp::kernel_1a_c>();
+        }
+    } a;
+
+}
+
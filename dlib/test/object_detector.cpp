@@ -7,6 +7,7 @@
 #include <string>
 #include <cstdlib>
 #include <ctime>
+#include <thread>
 #include "tester.h"
 #include <dlib/pixel.h>
 #include <dlib/svm_threaded.h>
@@ -430,6 +431,181 @@ namespace
             DLIB_TEST(d1.size() == d2.size());
             DLIB_TEST(set_intersection_size(d1,d2) == d1.size());
         }
+
+        {
+            // One detector shared by several threads: each thread gets its own
+            // detection_context while the model weights stay shared read-only.
+            print_spinner();
+            typedef object_detector<image_scanner_type>::detection_context context_type;
+
+            std::vector<std::vector<rectangle> > expected(images.size());
+            for (unsigned long i = 0; i < images.size(); ++i)
+                expected[i] = detector(images[i]);
+
+            const object_detector<image_scanner_type>& shared = detector;
+            context_type ctx1(shared);
+            context_type ctx2(shared);
+
+            std::vector<std::vector<rectangle> > results(images.size());
+            auto run = [&](unsigned long begin, unsigned long end, context_type& ctx)
+            {
+                for (unsigned long i = begin; i < end; ++i)
+                    results[i] = shared.detect(ctx, images[i]);
+            };
+            std::thread t1(run, 0, images.size()/2, std::ref(ctx1));
+            std::thread t2(run, images.size()/2, images.size(), std::ref(ctx2));
+            t1.join();
+            t2.join();
+
+            for (unsigned long i = 0; i < images.size(); ++i)
+            {
+                DLIB_TEST(results[i].size() == expected[i].size());
+                for (unsigned long j = 0; j < results[i].size(); ++j)
+                    DLIB_TEST(results[i][j] == expected[i][j]);
+            }
+
+            // the scored variants must agree with operator() as well
+            std::vector<std::pair<double,rectangle> > sdets1, sdets2;
+            detector(images[0], sdets1);
+            shared.detect(ctx1, images[0], sdets2);
+            DLIB_TEST(sdets1.size() == sdets2.size());
+            for (unsigned long i = 0; i < sdets1.size(); ++i)
+            {
+                DLIB_TEST(sdets1[i].first == sdets2[i].first);
+                DLIB_TEST(sdets1[i].second == sdets2[i].second);
+            }
+
+            std::vector<object_detector<image_scanner_type>::full_detection> fdets1, fdets2;
+            detector(images[0], fdets1);
+            shared.detect(ctx2, images[0], fdets2);
+            DLIB_TEST(fdets1.size() == fdets2.size());
+            for (unsigned long i = 0; i < fdets1.size(); ++i)
+            {
+                DLIB_TEST(fdets1[i].detection_confidence == fdets2[i].detection_confidence);
+                DLIB_TEST(fdets1[i].rect.get_rect() == fdets2[i].rect.get_rect());
+            }
+        }
+
+        {
+            // The cached-features validation overload must reproduce the results of
+            // testing each detector individually.
+            print_spinner();
+            matrix<double,0,1> w2 = detector.get_w();
+            // lower the threshold so the second detector produces different detections
+            w2(w2.size()-1) -= 0.5;
+            object_detector<image_scanner_type> d_low(detector.get_scanner(), detector.get_overlap_tester(), w2);
+
+            std::vector<object_detector<image_scanner_type> > sweep;
+            sweep.push_back(detector);
+            sweep.push_back(d_low);
+
+            const std::vector<matrix<double,1,3> > batch = test_object_detection_function(sweep, images, object_locations);
+            DLIB_TEST(batch.size() == sweep.size());
+            for (unsigned long d = 0; d < sweep.size(); ++d)
+            {
+                matrix<double> ref = test_object_detection_function(sweep[d], images, object_locations);
+                DLIB_TEST_MSG(max(abs(batch[d]-ref)) == 0, "d: " << d << " batch: " << batch[d] << " ref: " << ref);
+            }
+        }
+
+        {
+            // batch_detect() must give exactly the same detections as calling
+            // operator() on each image in turn.
+            print_spinner();
+            typedef object_detector<image_scanner_type>::rect_detection rect_detection_type;
+            const std::vector<std::vector<rect_detection_type> > batched = detector.batch_detect(images);
+            DLIB_TEST(batched.size() == images.size());
+            unsigned long total_dets = 0;
+            for (unsigned long i = 0; i < images.size(); ++i)
+            {
+                std::vector<rect_detection_type> ref;
+                detector(images[i], ref);
+                DLIB_TEST(batched[i].size() == ref.size());
+                for (unsigned long j = 0; j < ref.size(); ++j)
+                {
+                    DLIB_TEST(batched[i][j].detection_confidence == ref[j].detection_confidence);
+                    DLIB_TEST(batched[i][j].weight_index == ref[j].weight_index);
+                    DLIB_TEST(batched[i][j].rect == ref[j].rect);
+                }
+                total_dets += ref.size();
+            }
+            DLIB_TEST(total_dets > 0);
+
+            // and the adjust_threshold argument must be honored the same way
+            const std::vector<std::vector<rect_detection_type> > batched_low = detector.batch_detect(images, -0.5);
+            for (unsigned long i = 0; i < images.size(); ++i)
+            {
+                std::vector<rect_detection_type> ref;
+                detector(images[i], ref, -0.5);
+                DLIB_TEST(batched_low[i].size() == ref.size());
+                for (unsigned long j = 0; j < ref.size(); ++j)
+                    DLIB_TEST(batched_low[i][j].rect == ref[j].rect);
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_fhog_feature_reuse (
+    )
+    {
+        print_spinner();
+        dlog << LINFO << "test_fhog_feature_reuse()";
+
+        dlib::rand rnd;
+        array2d<unsigned char> img(240,320);
+        for (long r = 0; r < img.nr(); ++r)
+        {
+            for (long c = 0; c < img.nc(); ++c)
+                img[r][c] = rnd.get_random_8bit_number();
+        }
+
+        typedef scan_fhog_pyramid<pyramid_down<2> > image_scanner_type;
+        image_scanner_type scanner;
+        scanner.set_detection_window_size(64,64);
+        scanner.load(img);
+
+        DLIB_TEST(scanner.get_num_loaded_pyramid_levels() > 1);
+
+        // the loaded pyramid levels should be exactly what extract_fhog_features()
+        // computes on the corresponding downsampled images
+        pyramid_down<2> pyr;
+        array2d<unsigned char> level_img;
+        assign_image(level_img, img);
+        for (unsigned long l = 0; l < scanner.get_num_loaded_pyramid_levels(); ++l)
+        {
+            if (l != 0)
+            {
+                array2d<unsigned char> temp;
+                pyr(level_img, temp);
+                temp.swap(level_img);
+            }
+
+            dlib::array<array2d<float> > hog;
+            extract_fhog_features(level_img, hog, scanner.get_cell_size(),
+                scanner.get_fhog_window_height(), scanner.get_fhog_window_width());
+
+            const image_scanner_type::fhog_image& cached = scanner.get_loaded_pyramid_level(l);
+            DLIB_TEST(cached.size() == hog.size());
+            for (unsigned long p = 0; p < hog.size(); ++p)
+            {
+                DLIB_TEST(cached[p].nr() == hog[p].nr());
+                DLIB_TEST(cached[p].nc() == hog[p].nc());
+                DLIB_TEST(max(abs(mat(cached[p]) - mat(hog[p]))) == 0);
+            }
+        }
+
+        // mapping a rectangle into feature space and back should land us close to
+        // where we started (to within the cell quantization at that level)
+        const rectangle rect = centered_rect(point(160,120), 50, 50);
+        for (unsigned long l = 0; l < scanner.get_num_loaded_pyramid_levels(); ++l)
+        {
+            const rectangle frect = scanner.image_to_feat_space(rect, l);
+            const rectangle back = scanner.feat_to_image_space(frect, l);
+            const double tol = scanner.get_cell_size()*std::pow(2.0, (double)l);
+            DLIB_TEST_MSG(length(center(back) - center(rect)) <= 2*tol,
+                "level: " << l << "  back: " << back << "  rect: " << rect);
+        }
     }
 
 // ----------------------------------------------------------------------------------------
@@ -993,6 +1169,53 @@ namespace
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_box_overlap_index (
+    )
+    {
+        print_spinner();
+        dlog << LINFO << "test_box_overlap_index()";
+
+        dlib::rand rnd;
+        for (int iter = 0; iter < 10; ++iter)
+        {
+            const test_box_overlap tester(0.2 + 0.6*rnd.get_random_double(),
+                                          0.5 + 0.5*rnd.get_random_double());
+            box_overlap_index index(tester);
+            DLIB_TEST(index.size() == 0);
+            DLIB_TEST(index.get_overlap_tester().get_iou_thresh() == tester.get_iou_thresh());
+
+            std::vector<rectangle> accepted;
+            for (int i = 0; i < 500; ++i)
+            {
+                // mix of scales and positions, including negative coordinates and a
+                // few boxes much bigger than the typical scale.
+                long scale = 10;
+                if (rnd.get_random_32bit_number()%10 == 0)
+                    scale = 300;
+                const long x = (long)(rnd.get_random_32bit_number()%1000) - 500;
+                const long y = (long)(rnd.get_random_32bit_number()%1000) - 500;
+                const long w = 1 + rnd.get_random_32bit_number()%scale;
+                const long h = 1 + rnd.get_random_32bit_number()%scale;
+                const rectangle rect(x, y, x+w-1, y+h-1);
+
+                DLIB_TEST(index.overlaps_any(rect) == overlaps_any_box(tester, accepted, rect));
+
+                if (!index.overlaps_any(rect))
+                {
+                    index.add(rect);
+                    accepted.push_back(rect);
+                }
+            }
+            DLIB_TEST(index.size() == accepted.size());
+
+            index.clear();
+            DLIB_TEST(index.size() == 0);
+            DLIB_TEST(index.overlaps_any(rectangle(0,0,10,10)) == false);
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     class object_detector_tester : public tester
@@ -1007,7 +1230,9 @@ namespace
         void perform_test (
         )
         {
+            test_box_overlap_index();
             test_fhog_pyramid();
+            test_fhog_feature_reuse();
             test_1_boxes();
             test_1_poly_nn_boxes();
             test_3_boxes();
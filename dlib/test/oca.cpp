@@ -234,6 +234,55 @@ namespace
             dlog << LINFO << "error: "<< max(abs(w-true_w));
             DLIB_TEST(max(abs(w-true_w)) < 1e-10);
 
+            print_spinner();
+
+            // test the warm-startable version of the solver.  Recording the
+            // cutting plane state must not change the answer, and warm-starting
+            // from that state must reproduce the cold-start solution both on the
+            // same problem and on a closely related one.
+            w_type w_cold, w_warm;
+            oca_cutting_plane_state<w_type> state;
+
+            solver(make_oca_problem_c_svm<w_type>(2.0, 3.0, mat(x), mat(y), false, 1e-12, 40, max_index_plus_one(x)), w_cold, 0);
+            solver(make_oca_problem_c_svm<w_type>(2.0, 3.0, mat(x), mat(y), false, 1e-12, 40, max_index_plus_one(x)), w_warm, state, 0);
+            dlog << LINFO << "warm vs cold error: "<< max(abs(w_warm-w_cold));
+            DLIB_TEST(max(abs(w_warm-w_cold)) < 1e-8);
+            DLIB_TEST(state.empty() == false);
+
+            // warm-start on the identical problem
+            w_warm = 0;
+            solver(make_oca_problem_c_svm<w_type>(2.0, 3.0, mat(x), mat(y), false, 1e-12, 40, max_index_plus_one(x)), w_warm, state, 0);
+            dlog << LINFO << "warm vs cold error: "<< max(abs(w_warm-w_cold));
+            DLIB_TEST(max(abs(w_warm-w_cold)) < 1e-8);
+
+            // warm-start on a perturbed problem (different C values) must match
+            // that problem's cold-start solution.
+            solver(make_oca_problem_c_svm<w_type>(5.0, 6.0, mat(x), mat(y), false, 1e-12, 40, max_index_plus_one(x)), w_cold, 0);
+            solver(make_oca_problem_c_svm<w_type>(5.0, 6.0, mat(x), mat(y), false, 1e-12, 40, max_index_plus_one(x)), w_warm, state, 0);
+            dlog << LINFO << "warm vs cold error: "<< max(abs(w_warm-w_cold));
+            DLIB_TEST(max(abs(w_warm-w_cold)) < 1e-8);
+
+            // the state round-trips through serialization
+            ostringstream sout;
+            serialize(state, sout);
+            oca_cutting_plane_state<w_type> state2;
+            istringstream sin(sout.str());
+            deserialize(state2, sin);
+            DLIB_TEST(state2.planes.size() == state.planes.size());
+            w_warm = 0;
+            solver(make_oca_problem_c_svm<w_type>(5.0, 6.0, mat(x), mat(y), false, 1e-12, 40, max_index_plus_one(x)), w_warm, state2, 0);
+            dlog << LINFO << "warm vs cold error: "<< max(abs(w_warm-w_cold));
+            DLIB_TEST(max(abs(w_warm-w_cold)) < 1e-8);
+
+            // warm-started solves honor the non-negativity constraint too
+            solver(make_oca_problem_c_svm<w_type>(2.0, 3.0, mat(x), mat(y), false, 1e-12, 40, max_index_plus_one(x)), w_cold, 9999);
+            state.clear();
+            DLIB_TEST(state.empty() == true);
+            solver(make_oca_problem_c_svm<w_type>(2.0, 3.0, mat(x), mat(y), false, 1e-12, 40, max_index_plus_one(x)), w_warm, state, 9999);
+            dlog << LINFO << "warm vs cold error: "<< max(abs(w_warm-w_cold));
+            DLIB_TEST(max(abs(w_warm-w_cold)) < 1e-8);
+            DLIB_TEST(min(w_warm) >= 0);
+
         }
 
     } a;
@@ -269,6 +269,54 @@ namespace
 
         }
 
+        void test_shared_basis_evaluator (
+        )
+        {
+            print_spinner();
+            typedef double scalar_type;
+            typedef int label_type;
+            typedef matrix<scalar_type,2,1> sample_type;
+
+            std::vector<sample_type> samples;
+            std::vector<label_type> labels;
+            generate_data(samples, labels);
+
+            typedef one_vs_all_trainer<any_trainer<sample_type,scalar_type>,label_type> ova_trainer;
+            typedef radial_basis_kernel<sample_type> rbf_kernel;
+
+            ova_trainer trainer;
+            krr_trainer<rbf_kernel> rbf_trainer;
+            rbf_trainer.set_kernel(rbf_kernel(0.1));
+            trainer.set_trainer(rbf_trainer);
+
+            one_vs_all_decision_function<ova_trainer> df = trainer.train(samples, labels);
+
+            one_vs_all_shared_basis_evaluator<rbf_kernel,label_type> eval(df);
+            DLIB_TEST(eval.number_of_classes() == df.number_of_classes());
+            DLIB_TEST(eval.get_kernel() == rbf_kernel(0.1));
+
+            // the binary classifiers all draw their basis vectors from the same
+            // training set, so pooling them should find plenty of duplicates.
+            typedef one_vs_all_decision_function<ova_trainer>::binary_function_table table_type;
+            unsigned long total_basis_vectors = 0;
+            const table_type& dfs = df.get_binary_decision_functions();
+            for (table_type::const_iterator i = dfs.begin(); i != dfs.end(); ++i)
+                total_basis_vectors += any_cast<decision_function<rbf_kernel> >(i->second).basis_vectors.size();
+            dlog << LINFO << "unique basis vectors: " << eval.number_of_basis_vectors()
+                 << " of " << total_basis_vectors << " total";
+            DLIB_TEST(eval.number_of_basis_vectors() < total_basis_vectors);
+
+            // and the pooled evaluation must reproduce the original predictions
+            for (unsigned long i = 0; i < samples.size(); ++i)
+            {
+                const std::pair<label_type,scalar_type> p1 = df.predict(samples[i]);
+                const std::pair<label_type,scalar_type> p2 = eval.predict(samples[i]);
+                DLIB_TEST(p1.first == p2.first);
+                DLIB_TEST_MSG(std::abs(p1.second - p2.second) < 1e-10, std::abs(p1.second - p2.second));
+                DLIB_TEST(eval(samples[i]) == df(samples[i]));
+            }
+        }
+
         void perform_test (
         )
         {
@@ -295,6 +343,9 @@ namespace
 
             dlog << LINFO << "run_probabilistic_test<int,float>()";
             run_probabilistic_test<int,float>();
+
+            dlog << LINFO << "test_shared_basis_evaluator()";
+            test_shared_basis_evaluator();
         }
     };
 
@@ -298,6 +298,75 @@ namespace
         }
     }
 
+    void test_pinned_thread_pool()
+    {
+        pinned_thread_pool tp(4);
+        DLIB_TEST(tp.num_threads_in_pool() == 4);
+
+        // every index gets processed exactly once
+        std::vector<int> vect(503, 0);
+        parallel_for(tp, 0, vect.size(), assign_element(vect));
+        for (unsigned long i = 0; i < vect.size(); ++i)
+            DLIB_TEST(vect[i] == (long)i);
+
+        // the chunks cover the range exactly and the partition is the same on
+        // every run.
+        std::vector<std::pair<long,long> > chunks1, chunks2;
+        dlib::mutex m;
+        const auto record1 = [&](long begin, long end) { auto_mutex lock(m); chunks1.push_back(std::make_pair(begin,end)); };
+        const auto record2 = [&](long begin, long end) { auto_mutex lock(m); chunks2.push_back(std::make_pair(begin,end)); };
+        parallel_for_blocked(tp, 10, 503, record1);
+        parallel_for_blocked(tp, 10, 503, record2);
+        std::sort(chunks1.begin(), chunks1.end());
+        std::sort(chunks2.begin(), chunks2.end());
+        DLIB_TEST(chunks1 == chunks2);
+        DLIB_TEST(chunks1.size() == 4);
+        DLIB_TEST(chunks1.front().first == 10);
+        DLIB_TEST(chunks1.back().second == 503);
+        for (unsigned long i = 1; i < chunks1.size(); ++i)
+            DLIB_TEST(chunks1[i].first == chunks1[i-1].second);
+
+        // first_touch() zero fills
+        std::vector<double> data(1000, 1.0);
+        first_touch(tp, &data[0], data.size());
+        for (unsigned long i = 0; i < data.size(); ++i)
+            DLIB_TEST(data[i] == 0);
+
+        // ranges smaller than the pool and empty ranges work
+        vect.assign(3, -1);
+        parallel_for(tp, 0, vect.size(), assign_element(vect));
+        for (unsigned long i = 0; i < vect.size(); ++i)
+            DLIB_TEST(vect[i] == (long)i);
+        parallel_for(tp, 5, 5, [](long) { DLIB_TEST(false); });
+
+        // exceptions thrown by loop bodies propagate to the caller
+        bool saw_error = false;
+        try
+        {
+            parallel_for(tp, 0, 100, [](long i) { if (i == 42) throw dlib::error("oops"); });
+        }
+        catch (dlib::error& e)
+        {
+            saw_error = true;
+            DLIB_TEST(e.info == "oops");
+        }
+        DLIB_TEST(saw_error);
+        // and the pool is still usable afterwards
+        vect.assign(100, -1);
+        parallel_for(tp, 0, vect.size(), assign_element(vect));
+        for (unsigned long i = 0; i < vect.size(); ++i)
+            DLIB_TEST(vect[i] == (long)i);
+
+        // a pool with no threads runs everything in the calling thread
+        pinned_thread_pool tp0(0);
+        vect.assign(50, -1);
+        parallel_for(tp0, 0, vect.size(), assign_element(vect));
+        for (unsigned long i = 0; i < vect.size(); ++i)
+            DLIB_TEST(vect[i] == (long)i);
+    }
+
+// ----------------------------------------------------------------------------------------
+
     class test_parallel_for_routines : public tester
     {
     public:
@@ -322,6 +391,7 @@ namespace
             test_parallel_for2(50);
 
             test_parallel_for_additional();
+            test_pinned_thread_pool();
         }
     };
 
@@ -280,6 +280,75 @@ void test_pyramid_down_grayscale2()
 
 // ----------------------------------------------------------------------------------------
 
+void test_pyramid_down_simd_parity()
+{
+    // pyramid_down<2> has a SIMD fixed point fast path for 8 bit pixels.  Make sure
+    // it computes exactly the same thing as the general purpose integer code.
+    dlib::rand rnd;
+    pyramid_down<2> pyr;
+
+    array2d<rgb_pixel> img(173,211);
+    for (long r = 0; r < img.nr(); ++r)
+    {
+        for (long c = 0; c < img.nc(); ++c)
+        {
+            img[r][c].red = rnd.get_random_8bit_number();
+            img[r][c].green = rnd.get_random_8bit_number();
+            img[r][c].blue = rnd.get_random_8bit_number();
+        }
+    }
+
+    // The 8 bit grayscale fast path must match the generic path, which is what you
+    // get when the output pixels aren't 8 bits.
+    array2d<unsigned char> gray, gray_down;
+    array2d<unsigned short> gray_down16;
+    assign_image(gray, img);
+    pyr(gray, gray_down);
+    pyr(gray, gray_down16);
+    DLIB_TEST(gray_down.nr() == gray_down16.nr());
+    DLIB_TEST(gray_down.nc() == gray_down16.nc());
+    for (long r = 0; r < gray_down.nr(); ++r)
+    {
+        for (long c = 0; c < gray_down.nc(); ++c)
+            DLIB_TEST(gray_down[r][c] == gray_down16[r][c]);
+    }
+
+    // The RGB downsampler applies the same separable filter to each channel, so
+    // downsampling the channels separately with the grayscale code must give exactly
+    // the same answer.
+    array2d<rgb_pixel> rgb_down;
+    pyr(img, rgb_down);
+    array2d<unsigned char> chan(img.nr(), img.nc()), chan_down;
+    DLIB_TEST(rgb_down.nr() == gray_down.nr());
+    DLIB_TEST(rgb_down.nc() == gray_down.nc());
+
+    for (long r = 0; r < img.nr(); ++r)
+        for (long c = 0; c < img.nc(); ++c)
+            chan[r][c] = img[r][c].red;
+    pyr(chan, chan_down);
+    for (long r = 0; r < rgb_down.nr(); ++r)
+        for (long c = 0; c < rgb_down.nc(); ++c)
+            DLIB_TEST(rgb_down[r][c].red == chan_down[r][c]);
+
+    for (long r = 0; r < img.nr(); ++r)
+        for (long c = 0; c < img.nc(); ++c)
+            chan[r][c] = img[r][c].green;
+    pyr(chan, chan_down);
+    for (long r = 0; r < rgb_down.nr(); ++r)
+        for (long c = 0; c < rgb_down.nc(); ++c)
+            DLIB_TEST(rgb_down[r][c].green == chan_down[r][c]);
+
+    for (long r = 0; r < img.nr(); ++r)
+        for (long c = 0; c < img.nc(); ++c)
+            chan[r][c] = img[r][c].blue;
+    pyr(chan, chan_down);
+    for (long r = 0; r < rgb_down.nr(); ++r)
+        for (long c = 0; c < rgb_down.nc(); ++c)
+            DLIB_TEST(rgb_down[r][c].blue == chan_down[r][c]);
+}
+
+// ----------------------------------------------------------------------------------------
+
 template <typename pyramid_down_type>
 void test_pyr_sizes()
 {
@@ -329,6 +398,81 @@ void test_pyramid_down_small_sizes()
     }
 }
 
+// ----------------------------------------------------------------------------------------
+
+template <typename pyramid_down_type>
+void test_frame_pyramid()
+{
+    print_spinner();
+    dlib::rand rnd;
+
+    array2d<unsigned char> img(123,98);
+    for (long r = 0; r < img.nr(); ++r)
+    {
+        for (long c = 0; c < img.nc(); ++c)
+            img[r][c] = rnd.get_random_8bit_number();
+    }
+
+    frame_pyramid<pyramid_down_type> fp;
+    DLIB_TEST(fp.num_levels() == 0);
+    DLIB_TEST(fp.num_levels_in_cache() == 0);
+
+    fp.load(img);
+    DLIB_TEST(fp.num_levels() > 0);
+    DLIB_TEST(fp.num_levels_in_cache() == 1);
+
+    // check that every level matches what you get by just running pyramid_down
+    // over and over, and that levels only get cached when asked for.
+    pyramid_down_type pyr;
+    array2d<unsigned char> expected, temp;
+    assign_image(expected, img);
+    for (unsigned long i = 0; i < fp.num_levels(); ++i)
+    {
+        if (i != 0)
+        {
+            pyr(expected, temp);
+            swap(expected, temp);
+        }
+        DLIB_TEST(fp.num_levels_in_cache() == std::max<unsigned long>(i,1));
+        const array2d<unsigned char>& level = fp.get_level(i);
+        DLIB_TEST(fp.num_levels_in_cache() == i+1);
+        DLIB_TEST(level.nr() == expected.nr());
+        DLIB_TEST(level.nc() == expected.nc());
+        DLIB_TEST(max(abs(matrix_cast<int>(mat(level)) - matrix_cast<int>(mat(expected)))) == 0);
+    }
+
+    // the deepest level should be where the pyramid bottoms out.
+    long next_nr = expected.nr(), next_nc = expected.nc();
+    find_pyramid_down_output_image_size(pyr, next_nr, next_nc);
+    DLIB_TEST(expected.nr() <= 8 || expected.nc() <= 8 || next_nr*next_nc == 0);
+
+    fp.clear();
+    DLIB_TEST(fp.num_levels() == 0);
+    DLIB_TEST(fp.num_levels_in_cache() == 0);
+
+    // loading an empty image gives an empty pyramid
+    array2d<unsigned char> empty_img;
+    fp.load(empty_img);
+    DLIB_TEST(fp.num_levels() == 0);
+
+    // make sure chip extraction through a shared frame_pyramid gives the same
+    // results as extracting directly from the image when no resizing is involved.
+    fp.load(img);
+    std::vector<chip_details> dets;
+    dets.push_back(chip_details(rectangle(10,15,50,60)));
+    dets.push_back(chip_details(rectangle(30,5,80,70)));
+    dlib::array<array2d<unsigned char> > chips1, chips2;
+    extract_image_chips(img, dets, chips1);
+    extract_image_chips(fp, dets, chips2);
+    DLIB_TEST(chips1.size() == chips2.size());
+    for (unsigned long i = 0; i < chips1.size(); ++i)
+    {
+        DLIB_TEST(chips1[i].nr() == chips2[i].nr());
+        DLIB_TEST(chips1[i].nc() == chips2[i].nc());
+        DLIB_TEST(max(abs(matrix_cast<int>(mat(chips1[i])) - matrix_cast<int>(mat(chips2[i])))) == 0);
+    }
+}
+
 // ----------------------------------------------------------------------------------------
 
 
@@ -348,6 +492,8 @@ void test_pyramid_down_small_sizes()
             test_pyramid_down_grayscale();
             print_spinner();
             test_pyramid_down_rgb();
+            print_spinner();
+            test_pyramid_down_simd_parity();
 
             print_spinner();
             dlog << LINFO << "call test_pyramid_down_small_sizes<pyramid_down<2> >();";
@@ -414,6 +560,14 @@ void test_pyramid_down_small_sizes()
             test_pyr_sizes<pyramid_down<7>>();
             test_pyr_sizes<pyramid_down<8>>();
             test_pyr_sizes<pyramid_down<28>>();
+
+            print_spinner();
+            dlog << LINFO << "call test_frame_pyramid<pyramid_down<2> >();";
+            test_frame_pyramid<pyramid_down<2> >();
+            dlog << LINFO << "call test_frame_pyramid<pyramid_down<3> >();";
+            test_frame_pyramid<pyramid_down<3> >();
+            dlog << LINFO << "call test_frame_pyramid<pyramid_down<6> >();";
+            test_frame_pyramid<pyramid_down<6> >();
         }
     } a;
 
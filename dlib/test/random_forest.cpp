@@ -80,9 +80,30 @@ namespace
             deserialize(df2, ss);
             DLIB_TEST(df2.get_num_trees() == 1000);
             result = test_regression_function(df2, samples, labels);
-            // train:    2.239 0.987173 0.970669   1.1399 
+            // train:    2.239 0.987173 0.970669   1.1399
             dlog << LINFO << "serialized train results: " << result;
             DLIB_TEST_MSG(result(0) < 2.3, result(0));
+
+            print_spinner();
+
+            // The batched version of operator() must give exactly the same outputs as
+            // evaluating each sample on its own, both before and after a serialization
+            // round trip (which rebuilds the breadth first node layout).
+            const std::vector<double> batched = df(samples);
+            DLIB_TEST(batched.size() == samples.size());
+            for (size_t i = 0; i < samples.size(); ++i)
+                DLIB_TEST(batched[i] == df(samples[i]));
+
+            const std::vector<double> batched2 = df2(samples);
+            for (size_t i = 0; i < samples.size(); ++i)
+                DLIB_TEST(batched2[i] == batched[i]);
+
+            // also make sure a partial batch at the end works
+            const std::vector<sample_type> small(samples.begin(), samples.begin()+3);
+            const std::vector<double> batched3 = df(small);
+            DLIB_TEST(batched3.size() == 3);
+            for (size_t i = 0; i < small.size(); ++i)
+                DLIB_TEST(batched3[i] == df(small[i]));
         }
     } a;
 
@@ -330,6 +330,17 @@ namespace
 
         DLIB_TEST(mat(labels[0]) == mat(predicted_labels));
 
+        // make sure the batched decoder gives exactly the same labelings as
+        // decoding each sequence individually.
+        std::vector<std::vector<unsigned long> > batch_labels;
+        labeler.label_sequences(samples, batch_labels);
+        DLIB_TEST(batch_labels.size() == samples.size());
+        for (unsigned long i = 0; i < samples.size(); ++i)
+        {
+            DLIB_TEST(mat(batch_labels[i]) == mat(labeler(samples[i])));
+        }
+        DLIB_TEST(labeler.label_sequences(samples).size() == samples.size());
+
 
         print_spinner();
 
@@ -961,14 +961,81 @@ namespace
 
 
         {
-            // Make sure we can still deserialize the serialization 
-            // format for array2d and matrix objects used by older versions 
+            // Make sure we can still deserialize the serialization
+            // format for array2d and matrix objects used by older versions
             // of dlib.
             istringstream sin(get_decoded_string_matarray_old());
             test_deserialize(sin);
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_block_streamed_serialization()
+    {
+        // The block streamed format used for matrices and array2ds of arithmetic
+        // types records the element encoding and storage order in its header, so
+        // readers with a different layout or element type must still get the right
+        // values back.
+        dlib::rand rnd;
+
+        matrix<float,0,0,default_memory_manager,column_major_layout> cm(123,37), cm2;
+        for (long r = 0; r < cm.nr(); ++r)
+            for (long c = 0; c < cm.nc(); ++c)
+                cm(r,c) = (float)rnd.get_random_gaussian();
+
+        ostringstream sout;
+        serialize(cm, sout);
+        {
+            istringstream sin(sout.str());
+            deserialize(cm2, sin);
+            DLIB_TEST(cm2 == cm);
+        }
+        // a column major stream read into a row major matrix and an array2d
+        matrix<float> rm;
+        {
+            istringstream sin(sout.str());
+            deserialize(rm, sin);
+            DLIB_TEST(equal(rm, cm));
+        }
+        array2d<float> af;
+        {
+            istringstream sin(sout.str());
+            deserialize(af, sin);
+            DLIB_TEST(equal(mat(af), cm));
+        }
+
+        // a double stream read into a float matrix, and int into long
+        matrix<double> md = round(10*randm(25,3,rnd));
+        matrix<float> mf;
+        sout.str("");
+        serialize(md, sout);
+        {
+            istringstream sin(sout.str());
+            deserialize(mf, sin);
+            DLIB_TEST(equal(matrix_cast<double>(mf), md));
+        }
+        matrix<int> mi = matrix_cast<int>(round(100*(randm(8,9,rnd)-0.5)));
+        matrix<long> ml;
+        sout.str("");
+        serialize(mi, sout);
+        {
+            istringstream sin(sout.str());
+            deserialize(ml, sin);
+            DLIB_TEST(equal(matrix_cast<int>(ml), mi));
+        }
+
+        // a matrix big enough to span multiple read chunks
+        matrix<float> big = matrix_cast<float>(randm(700,600,rnd)), big2;
+        sout.str("");
+        serialize(big, sout);
+        {
+            istringstream sin(sout.str());
+            deserialize(big2, sin);
+            DLIB_TEST(big2 == big);
+        }
+    }
+
 // ----------------------------------------------------------------------------------------
 
     void test_strings()
@@ -1050,6 +1117,179 @@ namespace
         }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_compressed_serialization()
+    {
+        // build something big enough to span several frames when a small chunk size is used.
+        std::vector<matrix<double> > items;
+        dlib::rand rnd;
+        for (int i = 0; i < 20; ++i)
+        {
+            matrix<double> m = randm(30,30,rnd);
+            items.push_back(m);
+        }
+        const std::string note = "some metadata stored alongside the matrices";
+
+        ostringstream sout;
+        serialize_compressed(items, sout, 4096);
+        serialize_compressed(note, sout);
+
+        // highly redundant data should actually get smaller.
+        ostringstream plain;
+        dlib::serialize(items, plain);
+        DLIB_TEST(sout.str().size() < plain.str().size() + 1000);
+
+        std::vector<matrix<double> > items2;
+        std::string note2;
+        istringstream sin(sout.str());
+        deserialize_compressed(items2, sin);
+        deserialize_compressed(note2, sin);
+
+        DLIB_TEST(items2.size() == items.size());
+        for (unsigned long i = 0; i < items.size(); ++i)
+            DLIB_TEST(equal(items[i], items2[i]));
+        DLIB_TEST(note2 == note);
+
+        // corrupting a byte in the middle of the stream should trip a CRC check.
+        std::string data = sout.str();
+        data[data.size()/2] ^= 0x45;
+        bool threw = false;
+        try
+        {
+            istringstream sin2(data);
+            deserialize_compressed(items2, sin2);
+            deserialize_compressed(note2, sin2);
+        }
+        catch (serialization_error&)
+        {
+            threw = true;
+        }
+        DLIB_TEST(threw);
+
+        // a truncated stream should also be detected rather than silently accepted.
+        threw = false;
+        try
+        {
+            istringstream sin3(sout.str().substr(0, sout.str().size()/2));
+            deserialize_compressed(items2, sin3);
+            deserialize_compressed(note2, sin3);
+        }
+        catch (serialization_error&)
+        {
+            threw = true;
+        }
+        DLIB_TEST(threw);
+
+        // streams that aren't in this format should be rejected up front.
+        threw = false;
+        try
+        {
+            istringstream sin4("definitely not a compressed stream");
+            deserialize_compressed(note2, sin4);
+        }
+        catch (serialization_error&)
+        {
+            threw = true;
+        }
+        DLIB_TEST(threw);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T>
+    void test_compressed_ints_round_trip(const std::vector<T>& vals)
+    {
+        ostringstream sout;
+        dlib::serialize(compressed_ints(vals), sout);
+        istringstream sin(sout.str());
+        std::vector<T> vals2;
+        dlib::deserialize(compressed_ints(vals2), sin);
+        DLIB_TEST(vals2 == vals);
+    }
+
+    void test_compressed_ints()
+    {
+        dlib::rand rnd;
+
+        // monotone id arrays are the motivating case, they should shrink a lot.
+        std::vector<long> ids;
+        long id = 0;
+        for (int i = 0; i < 5000; ++i)
+        {
+            id += rnd.get_random_32bit_number()%50;
+            ids.push_back(id);
+        }
+        ostringstream sout, plain;
+        dlib::serialize(compressed_ints(ids), sout);
+        dlib::serialize(ids, plain);
+        DLIB_TEST_MSG(sout.str().size() < plain.str().size()/2,
+            "compressed: " << sout.str().size() << "  plain: " << plain.str().size());
+        istringstream sin(sout.str());
+        std::vector<long> ids2;
+        dlib::deserialize(compressed_ints(ids2), sin);
+        DLIB_TEST(ids2 == ids);
+
+        // arbitrary values must still round-trip exactly, including the extremes.
+        test_compressed_ints_round_trip(std::vector<int>{});
+        test_compressed_ints_round_trip(std::vector<int>{0});
+        test_compressed_ints_round_trip(std::vector<int>{-1, 1, -2, 2, 0,
+            std::numeric_limits<int>::min(), std::numeric_limits<int>::max()});
+        test_compressed_ints_round_trip(std::vector<unsigned char>{0, 255, 17, 255, 0});
+        test_compressed_ints_round_trip(std::vector<uint64>{0, std::numeric_limits<uint64>::max(), 5});
+        test_compressed_ints_round_trip(std::vector<int64>{std::numeric_limits<int64>::min(),
+            std::numeric_limits<int64>::max(), -1, 0});
+        std::vector<short> shorts;
+        std::vector<unsigned long> ulongs;
+        for (int i = 0; i < 2000; ++i)
+        {
+            shorts.push_back(static_cast<short>(rnd.get_random_32bit_number()));
+            ulongs.push_back(rnd.get_random_64bit_number());
+        }
+        test_compressed_ints_round_trip(shorts);
+        test_compressed_ints_round_trip(ulongs);
+
+        // the file stream operators should work with the wrapper too.
+        dlib::serialize("compressed_ints.dat") << compressed_ints(ids) << compressed_ints(shorts);
+        std::vector<long> ids3;
+        std::vector<short> shorts2;
+        dlib::deserialize("compressed_ints.dat") >> compressed_ints(ids3) >> compressed_ints(shorts2);
+        DLIB_TEST(ids3 == ids);
+        DLIB_TEST(shorts2 == shorts);
+
+        // values that don't fit the destination type should be rejected, not wrapped.
+        ostringstream sout2;
+        dlib::serialize(compressed_ints(ids), sout2);
+        std::vector<char> small;
+        bool threw = false;
+        try
+        {
+            istringstream sin2(sout2.str());
+            dlib::deserialize(compressed_ints(small), sin2);
+        }
+        catch (serialization_error&)
+        {
+            threw = true;
+        }
+        DLIB_TEST(threw);
+
+        // corrupt payloads should throw rather than produce garbage.
+        std::string data = sout2.str();
+        data.resize(data.size()/2);
+        threw = false;
+        try
+        {
+            istringstream sin3(data);
+            std::vector<long> junk;
+            dlib::deserialize(compressed_ints(junk), sin3);
+        }
+        catch (serialization_error&)
+        {
+            threw = true;
+        }
+        DLIB_TEST(threw);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     class serialize_tester : public tester
@@ -1076,8 +1316,11 @@ namespace
             test_vector<int>();
             test_vector_bool();
             test_array2d_and_matrix_serialization();
+            test_block_streamed_serialization();
             test_strings();
             test_std_array();
+            test_compressed_serialization();
+            test_compressed_ints();
         }
     } a;
 
@@ -0,0 +1,215 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <dlib/server.h>
+#include <dlib/sockets.h>
+#include <dlib/misc_api.h>
+
+#include "tester.h"
+
+// the server_reactor object only exists on POSIX systems
+#ifndef _WIN32
+
+namespace
+{
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.server_reactor");
+
+    const unsigned short testing_port = 41239;
+
+    class echo_server : public server_reactor
+    {
+    public:
+        echo_server (
+        ) : num_opened(0), num_closed(0)
+        {}
+
+        ~echo_server (
+        )
+        {
+            clear();
+        }
+
+        std::atomic<int> num_opened;
+        std::atomic<int> num_closed;
+
+    private:
+
+        void on_data (
+            connection_id id,
+            std::vector<char>& data
+        ) override
+        {
+            write(id, &data[0], data.size());
+        }
+
+        void on_connection_opened (
+            connection_id ,
+            const std::string& foreign_ip,
+            unsigned short
+        ) override
+        {
+            DLIB_TEST(foreign_ip == "127.0.0.1");
+            ++num_opened;
+        }
+
+        void on_connection_closed (
+            connection_id
+        ) override
+        {
+            ++num_closed;
+        }
+    };
+
+    void send_all (
+        connection& con,
+        const std::string& data
+    )
+    {
+        DLIB_TEST(con.write(data.data(), data.size()) == (long)data.size());
+    }
+
+    std::string read_exactly (
+        connection& con,
+        size_t num
+    )
+    {
+        std::string result;
+        char buf[4096];
+        while (result.size() < num)
+        {
+            const long got = con.read(buf, std::min(sizeof(buf), num-result.size()));
+            DLIB_TEST(got > 0);
+            result.append(buf, got);
+        }
+        return result;
+    }
+
+    void wait_for_value (
+        std::atomic<int>& value,
+        int expected
+    )
+    {
+        for (int i = 0; i < 1000 && value != expected; ++i)
+            dlib::sleep(10);
+        DLIB_TEST(value == expected);
+    }
+
+    void do_test_echo (
+        echo_server& srv
+    )
+    {
+        std::unique_ptr<connection> con;
+        DLIB_TEST(create_connection(con, testing_port, "127.0.0.1") == 0);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            const std::string msg = "echo message number " + cast_to_string(i);
+            send_all(*con, msg);
+            DLIB_TEST(read_exactly(*con, msg.size()) == msg);
+        }
+
+        con.reset();
+        wait_for_value(srv.num_closed, srv.num_opened);
+    }
+
+    void do_test_concurrent_connections (
+        echo_server& srv
+    )
+    {
+        const int num_cons = 5;
+        std::vector<std::unique_ptr<connection> > cons(num_cons);
+        for (int i = 0; i < num_cons; ++i)
+            DLIB_TEST(create_connection(cons[i], testing_port, "127.0.0.1") == 0);
+
+        // interleave traffic over all the connections
+        for (int round = 0; round < 5; ++round)
+        {
+            for (int i = 0; i < num_cons; ++i)
+            {
+                const std::string msg = "round " + cast_to_string(round) + " connection " + cast_to_string(i);
+                send_all(*cons[i], msg);
+            }
+            for (int i = 0; i < num_cons; ++i)
+            {
+                const std::string msg = "round " + cast_to_string(round) + " connection " + cast_to_string(i);
+                DLIB_TEST(read_exactly(*cons[i], msg.size()) == msg);
+            }
+        }
+
+        wait_for_value(srv.num_opened, srv.num_closed + num_cons);
+        DLIB_TEST(srv.number_of_connections() == num_cons);
+
+        for (int i = 0; i < num_cons; ++i)
+            cons[i].reset();
+        wait_for_value(srv.num_closed, srv.num_opened);
+    }
+
+    void do_test_large_payload (
+        echo_server& srv
+    )
+    {
+        // Write a payload much bigger than the socket buffers before reading any
+        // of the echo back.  This forces the server to buffer the reply and finish
+        // sending it from the reactor as the socket drains.
+        std::unique_ptr<connection> con;
+        DLIB_TEST(create_connection(con, testing_port, "127.0.0.1") == 0);
+
+        std::string big;
+        big.reserve(1024*1024);
+        while (big.size() < 1024*1024)
+            big += "all work and no play makes for some dull test data. ";
+
+        send_all(*con, big);
+        DLIB_TEST(read_exactly(*con, big.size()) == big);
+
+        con.reset();
+        wait_for_value(srv.num_closed, srv.num_opened);
+    }
+
+    class test_server_reactor : public tester
+    {
+    public:
+        test_server_reactor (
+        ) :
+            tester ("test_server_reactor",
+                    "Runs tests on the server_reactor component.")
+        {}
+
+        void perform_test (
+        )
+        {
+            echo_server srv;
+            srv.set_listening_ip("127.0.0.1");
+            srv.set_listening_port(testing_port);
+            srv.set_num_threads(2);
+            srv.start_async();
+            DLIB_TEST(srv.is_running() == true);
+            DLIB_TEST(srv.get_listening_port() == testing_port);
+
+            print_spinner();
+            do_test_echo(srv);
+            print_spinner();
+            do_test_concurrent_connections(srv);
+            print_spinner();
+            do_test_large_payload(srv);
+            print_spinner();
+
+            DLIB_TEST(srv.number_of_connections() == 0);
+            srv.clear();
+            DLIB_TEST(srv.is_running() == false);
+            DLIB_TEST(srv.num_opened == srv.num_closed);
+        }
+    } a;
+
+}
+
+#endif // _WIN32
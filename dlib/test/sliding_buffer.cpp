@@ -6,8 +6,11 @@
 #include <string>
 #include <ctime>
 #include <cstdlib>
+#include <algorithm>
+#include <thread>
 
 #include <dlib/sliding_buffer.h>
+#include <dlib/rand.h>
 #include "tester.h"
 
 namespace  
@@ -414,6 +417,93 @@ namespace
 
 
 
+    void test_spsc_ring_buffer (
+    )
+    {
+        print_spinner();
+
+        // basic single threaded FIFO and wrap around behavior
+        spsc_ring_buffer ring(10);
+        DLIB_TEST(ring.capacity() == 16);
+        DLIB_TEST(ring.size() == 0);
+        DLIB_TEST(ring.space() == 16);
+
+        char out[64];
+        DLIB_TEST(ring.read(out, 10) == 0);
+
+        // push the stream through with sizes that force wrapping at every offset
+        dlib::rand rnd;
+        unsigned char next_write = 0, next_read = 0;
+        for (int iter = 0; iter < 1000; ++iter)
+        {
+            char in[7];
+            const unsigned long want = rnd.get_random_32bit_number()%7 + 1;
+            for (unsigned long i = 0; i < want; ++i)
+                in[i] = static_cast<char>(next_write+i);
+            const unsigned long wrote = ring.write(in, want);
+            DLIB_TEST(wrote <= want && ring.size() <= ring.capacity());
+            next_write += wrote;
+
+            const unsigned long got = ring.read(out, rnd.get_random_32bit_number()%9);
+            for (unsigned long i = 0; i < got; ++i)
+                DLIB_TEST(out[i] == static_cast<char>(next_read+i));
+            next_read += got;
+        }
+
+        // writes that don't fit get truncated
+        ring.clear();
+        DLIB_TEST(ring.size() == 0);
+        char big[32];
+        for (int i = 0; i < 32; ++i)
+            big[i] = static_cast<char>(i);
+        DLIB_TEST(ring.write(big, 32) == 16);
+        DLIB_TEST(ring.write(big, 1) == 0);
+        DLIB_TEST(ring.read(out, 32) == 16);
+        for (int i = 0; i < 16; ++i)
+            DLIB_TEST(out[i] == static_cast<char>(i));
+
+        ring.set_capacity(100);
+        DLIB_TEST(ring.capacity() == 128);
+        DLIB_TEST(ring.size() == 0);
+
+        print_spinner();
+
+        // now stream a few megabytes through a small ring between two threads and
+        // make sure every byte comes out in order.
+        const unsigned long total = 4*1024*1024;
+        spsc_ring_buffer ring2(256);
+        std::thread producer([&]()
+        {
+            dlib::rand prnd("producer");
+            unsigned long sent = 0;
+            char buf[61];
+            while (sent < total)
+            {
+                unsigned long num = std::min<unsigned long>(prnd.get_random_32bit_number()%61 + 1, total-sent);
+                for (unsigned long i = 0; i < num; ++i)
+                    buf[i] = static_cast<char>((sent+i)*31);
+                sent += ring2.write(buf, num);
+            }
+        });
+
+        dlib::rand crnd("consumer");
+        unsigned long received = 0;
+        bool all_in_order = true;
+        char buf[97];
+        while (received < total)
+        {
+            const unsigned long got = ring2.read(buf, crnd.get_random_32bit_number()%97 + 1);
+            for (unsigned long i = 0; i < got; ++i)
+                all_in_order = all_in_order && (buf[i] == static_cast<char>((received+i)*31));
+            received += got;
+        }
+        producer.join();
+        DLIB_TEST(all_in_order);
+        DLIB_TEST(ring2.size() == 0);
+    }
+
+// ----------------------------------------------------------------------------------------
+
     class sliding_buffer_tester : public tester
     {
     public:
@@ -432,6 +522,7 @@ namespace
             sliding_buffer_kernel_test<sliding_buffer<unsigned char>::kernel_1a_c>();
 
             test_circular_buffer();
+            test_spsc_ring_buffer();
         }
     } a;
 
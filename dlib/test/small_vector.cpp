@@ -0,0 +1,213 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <dlib/small_vector.h>
+#include <dlib/flat_map.h>
+#include <dlib/rand.h>
+
+#include "tester.h"
+
+namespace
+{
+
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.small_vector");
+
+    void test_small_vector()
+    {
+        print_spinner();
+
+        small_vector<int,4> v;
+        DLIB_TEST(v.size() == 0);
+        DLIB_TEST(v.empty());
+        DLIB_TEST(v.capacity() == 4);
+        DLIB_TEST(v.is_inline());
+
+        // stay inline while we fit
+        for (int i = 0; i < 4; ++i)
+            v.push_back(i);
+        DLIB_TEST(v.size() == 4);
+        DLIB_TEST(v.is_inline());
+
+        // spill to the heap and keep the contents
+        for (int i = 4; i < 100; ++i)
+            v.push_back(i);
+        DLIB_TEST(v.size() == 100);
+        DLIB_TEST(!v.is_inline());
+        for (int i = 0; i < 100; ++i)
+            DLIB_TEST(v[i] == i);
+        DLIB_TEST(v.front() == 0);
+        DLIB_TEST(v.back() == 99);
+
+        // clear keeps the capacity
+        const size_t cap = v.capacity();
+        v.clear();
+        DLIB_TEST(v.size() == 0);
+        DLIB_TEST(v.capacity() == cap);
+
+        // insert and erase shift elements correctly
+        small_vector<int,4> w = {1, 3, 4};
+        auto it = w.insert(w.begin()+1, 2);
+        DLIB_TEST(*it == 2);
+        DLIB_TEST((w == small_vector<int,4>{1, 2, 3, 4}));
+        it = w.erase(w.begin());
+        DLIB_TEST(*it == 2);
+        DLIB_TEST((w == small_vector<int,4>{2, 3, 4}));
+        w.insert(w.end(), 5);
+        DLIB_TEST((w == small_vector<int,4>{2, 3, 4, 5}));
+        w.pop_back();
+        DLIB_TEST((w == small_vector<int,4>{2, 3, 4}));
+
+        // copies and moves, both inline and spilled
+        small_vector<int,4> big;
+        for (int i = 0; i < 50; ++i)
+            big.push_back(i);
+        small_vector<int,4> copy_of_big(big);
+        DLIB_TEST(copy_of_big == big);
+        small_vector<int,4> moved(std::move(copy_of_big));
+        DLIB_TEST(moved == big);
+        DLIB_TEST(copy_of_big.size() == 0);
+        small_vector<int,4> copy_of_w(w);
+        DLIB_TEST(copy_of_w == w);
+        DLIB_TEST(copy_of_w.is_inline());
+        copy_of_w = big;
+        DLIB_TEST(copy_of_w == big);
+        moved = std::move(copy_of_w);
+        DLIB_TEST(moved == big);
+
+        // sorting through the iterators, including the reverse ones
+        small_vector<int,4> s = {5, 1, 4, 2, 3};
+        std::sort(s.begin(), s.end());
+        DLIB_TEST((s == small_vector<int,4>{1, 2, 3, 4, 5}));
+        std::sort(s.rbegin(), s.rend());
+        DLIB_TEST((s == small_vector<int,4>{5, 4, 3, 2, 1}));
+
+        // works with non-trivial element types
+        small_vector<std::string,2> strs;
+        for (int i = 0; i < 20; ++i)
+            strs.push_back("str" + cast_to_string(i));
+        DLIB_TEST(strs.size() == 20);
+        DLIB_TEST(strs[7] == "str7");
+
+        // serialization matches the std::vector format
+        ostringstream sout;
+        serialize(big, sout);
+        std::vector<int> as_std;
+        {
+            istringstream sin(sout.str());
+            deserialize(as_std, sin);
+        }
+        DLIB_TEST(as_std.size() == big.size());
+        for (size_t i = 0; i < big.size(); ++i)
+            DLIB_TEST(as_std[i] == big[i]);
+        small_vector<int,4> big2;
+        {
+            istringstream sin(sout.str());
+            deserialize(big2, sin);
+        }
+        DLIB_TEST(big2 == big);
+    }
+
+    void test_flat_map()
+    {
+        print_spinner();
+
+        flat_map<unsigned long, double> m;
+        DLIB_TEST(m.size() == 0);
+        DLIB_TEST(m.empty());
+        DLIB_TEST(m.find(4) == m.end());
+        DLIB_TEST(m.count(4) == 0);
+
+        m[3] = 30;
+        m[1] = 10;
+        m[2] = 20;
+        DLIB_TEST(m.size() == 3);
+        DLIB_TEST(m[1] == 10);
+        DLIB_TEST(m[2] == 20);
+        DLIB_TEST(m[3] == 30);
+
+        // elements come out in key order
+        unsigned long expected = 1;
+        for (auto& p : m)
+        {
+            DLIB_TEST(p.first == expected);
+            DLIB_TEST(p.second == expected*10);
+            ++expected;
+        }
+
+        auto res = m.insert(std::make_pair(2ul, 99.0));
+        DLIB_TEST(!res.second);
+        DLIB_TEST(m[2] == 20);
+        res = m.insert(std::make_pair(4ul, 40.0));
+        DLIB_TEST(res.second);
+        DLIB_TEST(m.size() == 4);
+
+        DLIB_TEST(m.erase(2) == 1);
+        DLIB_TEST(m.erase(2) == 0);
+        DLIB_TEST(m.count(2) == 0);
+        DLIB_TEST(m.size() == 3);
+
+        // compare against std::map under random operations, using small_vector
+        // storage so the inline spill path gets exercised too.
+        flat_map<int, int, std::less<int>, small_vector<std::pair<int,int>,8>> fm;
+        std::map<int, int> ref;
+        dlib::rand rnd;
+        for (int i = 0; i < 1000; ++i)
+        {
+            const int key = rnd.get_random_32bit_number()%50;
+            if (rnd.get_random_double() < 0.7)
+            {
+                fm[key] = i;
+                ref[key] = i;
+            }
+            else
+            {
+                DLIB_TEST(fm.erase(key) == ref.erase(key));
+            }
+            DLIB_TEST(fm.size() == ref.size());
+        }
+        auto i = fm.begin();
+        for (auto& p : ref)
+        {
+            DLIB_TEST(i->first == p.first);
+            DLIB_TEST(i->second == p.second);
+            ++i;
+        }
+
+        // serialization round trip
+        ostringstream sout;
+        serialize(m, sout);
+        istringstream sin(sout.str());
+        flat_map<unsigned long, double> m2;
+        deserialize(m2, sin);
+        DLIB_TEST(m2.size() == m.size());
+        DLIB_TEST(std::equal(m.begin(), m.end(), m2.begin()));
+    }
+
+    class tester_small_vector : public tester
+    {
+    public:
+        tester_small_vector (
+        ) :
+            tester ("test_small_vector",
+                    "Runs tests on the small_vector and flat_map components.")
+        {}
+
+        void perform_test (
+        )
+        {
+            test_small_vector();
+            test_flat_map();
+        }
+    } a;
+
+
+}
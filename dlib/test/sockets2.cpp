@@ -4,10 +4,14 @@
 #include <algorithm>
 #include <memory>
 
+#include <thread>
+
 #include "tester.h"
 #include <dlib/sockets.h>
 #include <dlib/threads.h>
 #include <dlib/array.h>
+#include <dlib/cuda/tensor_sockets.h>
+#include <dlib/rand.h>
 
 // This is called an unnamed-namespace and it has the effect of making everything 
 // inside this file "private" so that everything you declare will have static linkage.  
@@ -101,6 +105,53 @@ namespace
         {
             run_tests(0);
             run_tests(40);
+            test_tensor_serialization();
+        }
+
+        void test_tensor_serialization (
+        )
+        {
+            print_spinner();
+
+            std::unique_ptr<listener> list;
+            DLIB_TEST(create_listener(list, 0, "127.0.0.1") == 0);
+            const int port = list->get_listening_port();
+
+            dlib::rand rnd;
+            resizable_tensor sent(3,4,5,6);
+            for (auto& v : sent)
+                v = (float)rnd.get_random_gaussian();
+            const matrix<double> msent = randm(17,23);
+            const matrix<double,0,0,default_memory_manager,column_major_layout> csent = randm(9,13);
+
+            std::thread sender([&]()
+            {
+                std::unique_ptr<connection> con;
+                if (create_connection(con, port, "127.0.0.1") != 0)
+                    return;
+                serialize(sent, *con);
+                serialize(msent, *con);
+                serialize(csent, *con);
+            });
+
+            std::unique_ptr<connection> con;
+            DLIB_TEST(list->accept(con) == 0);
+
+            resizable_tensor got;
+            deserialize(got, *con);
+            DLIB_TEST(got.num_samples() == 3 && got.k() == 4 && got.nr() == 5 && got.nc() == 6);
+            DLIB_TEST(max(abs(mat(got)-mat(sent))) == 0);
+
+            matrix<double> mgot;
+            deserialize(mgot, *con);
+            DLIB_TEST(mgot == msent);
+
+            // a column major sender must deserialize correctly into a row major matrix
+            matrix<double> cgot;
+            deserialize(cgot, *con);
+            DLIB_TEST(cgot == matrix<double>(csent));
+
+            sender.join();
         }
 
         void run_tests (
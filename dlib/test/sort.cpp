@@ -0,0 +1,178 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dlib/sort.h>
+#include <dlib/rand.h>
+#include "tester.h"
+
+namespace
+{
+
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.sort");
+
+    dlib::rand rnd;
+
+// ----------------------------------------------------------------------------------------
+
+    std::vector<int> make_random_vector (
+        unsigned long size,
+        int max_value
+    )
+    /*!
+        ensures
+            - returns a vector of the given size filled with random values in the
+              range [0, max_value].  A small max_value produces lots of duplicate
+              keys.
+    !*/
+    {
+        std::vector<int> v(size);
+        for (unsigned long i = 0; i < size; ++i)
+            v[i] = static_cast<int>(rnd.get_random_32bit_number()%(max_value+1));
+        return v;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_psort_matches_serial (
+        unsigned long size,
+        int max_value,
+        unsigned long num_threads
+    )
+    /*!
+        ensures
+            - sorts a random array of the given size with psort_array() and checks
+              that the result is exactly what std::sort() and qsort_array() produce.
+    !*/
+    {
+        std::vector<int> v = make_random_vector(size, max_value);
+        std::vector<int> ref = v;
+        std::vector<int> qref = v;
+
+        std::sort(ref.begin(), ref.end());
+        if (size != 0)
+            qsort_array(qref, 0, size-1);
+        DLIB_TEST(qref == ref);
+
+        psort_array(v, 0, size-1, std::less<int>(), num_threads);
+        DLIB_TEST_MSG(v == ref, "size: " << size << "  num_threads: " << num_threads);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_psort_subrange (
+    )
+    {
+        // sorting a sub-range must leave everything outside [left,right] untouched
+        std::vector<int> v = make_random_vector(50000, 1000000);
+        std::vector<int> ref = v;
+        const unsigned long left = 123;
+        const unsigned long right = 45678;
+
+        std::sort(ref.begin()+left, ref.begin()+right+1);
+        psort_array(v, left, right, std::less<int>(), 4);
+        DLIB_TEST(v == ref);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_psort_comparators (
+    )
+    {
+        // the default comparator overload and an explicit comparator both work
+        std::vector<int> v1 = make_random_vector(30000, 1000000);
+        std::vector<int> v2 = v1;
+        std::vector<int> ref = v1;
+
+        std::sort(ref.begin(), ref.end());
+        psort_array(v1, 0, v1.size()-1);
+        DLIB_TEST(v1 == ref);
+
+        // sorting descending with std::greater
+        std::sort(ref.begin(), ref.end(), std::greater<int>());
+        psort_array(v2, 0, v2.size()-1, std::greater<int>(), 4);
+        DLIB_TEST(v2 == ref);
+
+        // a non-trivially-copyable element type works too
+        std::vector<std::string> s1, sref;
+        for (int i = 0; i < 20000; ++i)
+        {
+            std::ostringstream sout;
+            sout << rnd.get_random_32bit_number()%1000;
+            s1.push_back(sout.str());
+        }
+        sref = s1;
+        std::sort(sref.begin(), sref.end());
+        psort_array(s1, 0, s1.size()-1, std::less<std::string>(), 4);
+        DLIB_TEST(s1 == sref);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_psort_stability_of_result (
+    )
+    {
+        // already sorted and reverse sorted inputs must come out sorted
+        std::vector<int> v(40000);
+        for (unsigned long i = 0; i < v.size(); ++i)
+            v[i] = static_cast<int>(i);
+        std::vector<int> ref = v;
+        psort_array(v, 0, v.size()-1, std::less<int>(), 4);
+        DLIB_TEST(v == ref);
+
+        std::reverse(v.begin(), v.end());
+        psort_array(v, 0, v.size()-1, std::less<int>(), 4);
+        DLIB_TEST(v == ref);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class sort_tester : public tester
+    {
+    public:
+        sort_tester (
+        ) :
+            tester ("test_sort",
+                    "Runs tests on the sorting functions.")
+        {}
+
+        void perform_test (
+        )
+        {
+            // Small arrays take the serial qsort_array() fallback inside
+            // psort_array() while arrays of 10000 or more elements exercise the
+            // threaded merge path, so test sizes on both sides of that threshold.
+            const unsigned long sizes[] = {1, 2, 10, 100, 9999, 10001, 100000};
+            const unsigned long thread_counts[] = {0, 1, 2, 4, 7};
+            for (unsigned long s : sizes)
+            {
+                for (unsigned long t : thread_counts)
+                {
+                    print_spinner();
+                    // lots of duplicate keys
+                    test_psort_matches_serial(s, 10, t);
+                    // mostly distinct keys
+                    test_psort_matches_serial(s, 100000000, t);
+                }
+            }
+
+            print_spinner();
+            test_psort_subrange();
+            print_spinner();
+            test_psort_comparators();
+            print_spinner();
+            test_psort_stability_of_result();
+        }
+    } a;
+
+}
+
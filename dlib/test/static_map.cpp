@@ -4,6 +4,7 @@
 
 #include <sstream>
 #include <string>
+#include <cstdio>
 #include <cstdlib>
 #include <ctime>
 
@@ -296,8 +297,86 @@ namespace
 
     }
 
+// ----------------------------------------------------------------------------------------
 
+    void mapped_static_map_test (
+    )
+    /*!
+        ensures
+            - runs tests on save_mapped_static_map() and mapped_static_map for
+              compliance with the specs
+    !*/
+    {
+        print_spinner();
+
+        typedef binary_search_tree<int,int>::kernel_2a_c bst;
+        const std::string filename = "mapped_static_map_test.dat";
+
+        bst tree;
+        while (tree.size() < 10000)
+        {
+            int key = ::rand();
+            int value = ::rand();
+            if (tree[key] == 0)
+                tree.add(key,value);
+        }
+
+        bst tree_copy;
+        tree.reset();
+        while (tree.move_next())
+        {
+            int key = tree.element().key();
+            int value = tree.element().value();
+            tree_copy.add(key,value);
+        }
 
+        static_map<int,int>::kernel_1a_c smap;
+        smap.load(tree);
+        save_mapped_static_map(smap, filename);
+
+        mapped_static_map<int,int> mmap;
+        DLIB_TEST(mmap.is_loaded() == false);
+        DLIB_TEST(mmap.size() == 0);
+        mmap.load(filename);
+        DLIB_TEST(mmap.is_loaded() == true);
+        DLIB_TEST(mmap.size() == smap.size());
+
+        // the mapped view should agree with the static_map on every key
+        smap.reset();
+        size_t idx = 0;
+        while (smap.move_next())
+        {
+            const int key = smap.element().key();
+            DLIB_TEST(mmap.key(idx) == key);
+            DLIB_TEST(mmap.value(idx) == smap.element().value());
+            DLIB_TEST(mmap[key] != 0);
+            DLIB_TEST(*mmap[key] == smap.element().value());
+            ++idx;
+        }
+
+        // and report misses for keys that aren't present
+        for (int i = 0; i < 1000; ++i)
+        {
+            int key = ::rand();
+            DLIB_TEST((mmap[key] != 0) == (tree_copy[key] != 0));
+        }
+
+        // the open-by-filename constructor should work too
+        mapped_static_map<int,int> mmap2(filename);
+        DLIB_TEST(mmap2.size() == smap.size());
+
+        // an empty map should round-trip as well
+        bst empty_tree;
+        static_map<int,int>::kernel_1a_c empty_map;
+        empty_map.load(empty_tree);
+        save_mapped_static_map(empty_map, filename);
+        mmap.load(filename);
+        DLIB_TEST(mmap.is_loaded() == true);
+        DLIB_TEST(mmap.size() == 0);
+        DLIB_TEST(mmap[42] == 0);
+
+        std::remove(filename.c_str());
+    }
 
 
     class static_map_tester : public tester
@@ -316,6 +395,8 @@ namespace
             static_map_kernel_test<static_map<int,int>::kernel_1a>  ();
             dlog << LINFO << "testing kernel_1a_c";
             static_map_kernel_test<static_map<int,int>::kernel_1a_c>();
+            dlog << LINFO << "testing mapped_static_map";
+            mapped_static_map_test();
         }
     } a;
 
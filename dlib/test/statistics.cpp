@@ -94,6 +94,78 @@ namespace
             }
         }
 
+        void test_random_subset_selector_merge ()
+        {
+            // merging sharded selectors should be statistically the same as feeding
+            // everything through a single selector.
+            for (int j = 0; j < 10; ++j)
+            {
+                print_spinner();
+
+                running_stats<double> rs, rs2;
+
+                std::vector<random_subset_selector<double> > shards(8);
+                for (size_t s = 0; s < shards.size(); ++s)
+                {
+                    shards[s].set_max_size(500);
+                    shards[s].set_seed(cast_to_string(j*100+s));
+                }
+
+                std::vector<double> block;
+                for (double i = 0; i < 100000; ++i)
+                {
+                    rs.add(i);
+                    block.push_back(i);
+                    if (block.size() == 1000)
+                    {
+                        // exercise the batch add as well
+                        shards[(static_cast<unsigned long>(i)/1000)%shards.size()].add(block.begin(), block.end());
+                        block.clear();
+                    }
+                }
+
+                random_subset_selector<double> merged;
+                merged.set_max_size(500);
+                merged.set_seed(cast_to_string(j));
+                for (size_t s = 0; s < shards.size(); ++s)
+                    merged.merge(shards[s]);
+
+                DLIB_TEST(merged.size() == 500);
+                DLIB_TEST(merged.next_add_accepts() == false);
+
+                for (unsigned long i = 0; i < merged.size(); ++i)
+                    rs2.add(merged[i]);
+
+                dlog << LDEBUG << "true mean:    " << rs.mean();
+                dlog << LDEBUG << "merged sampled: " << rs2.mean();
+                double ratio = rs.mean()/rs2.mean();
+                DLIB_TEST_MSG(0.93 < ratio  && ratio < 1.07, " ratio: " << ratio);
+            }
+
+            // merging into an empty selector should just give a random subset of the
+            // other selector's stream.
+            {
+                random_subset_selector<int> a, b;
+                a.set_max_size(10);
+                b.set_max_size(10);
+                for (int i = 0; i < 5; ++i)
+                    b.add(i);
+                a.merge(b);
+                DLIB_TEST(a.size() == 5);
+                // all 5 items must be present since fewer than max_size were added
+                std::vector<int> v(a.begin(), a.end());
+                std::sort(v.begin(), v.end());
+                for (int i = 0; i < 5; ++i)
+                    DLIB_TEST(v[i] == i);
+
+                // and merging an empty selector changes nothing
+                random_subset_selector<int> c;
+                c.set_max_size(10);
+                a.merge(c);
+                DLIB_TEST(a.size() == 5);
+            }
+        }
+
         void test_random_subset_selector2 ()
         {
             random_subset_selector<double> rand_set;
@@ -305,6 +377,166 @@ namespace
 
         }
 
+        void test_running_covariance_welford (
+        )
+        {
+            print_spinner();
+            dlib::rand rnd;
+            std::vector<matrix<double,0,1> > vects;
+
+            running_covariance_welford<matrix<double,0,1> > cov, cov2, cov3;
+            DLIB_TEST(cov.in_vector_size() == 0);
+
+            for (unsigned long dims = 1; dims < 5; ++dims)
+            {
+                for (unsigned long samps = 2; samps < 10; ++samps)
+                {
+                    vects.clear();
+                    cov.clear();
+                    DLIB_TEST(cov.in_vector_size() == 0);
+                    for (unsigned long i = 0; i < samps; ++i)
+                    {
+                        vects.push_back(randm(dims,1,rnd));
+                        cov.add(vects.back());
+                    }
+                    DLIB_TEST(cov.in_vector_size() == (long)dims);
+                    DLIB_TEST(cov.current_n() == (long)samps);
+
+                    DLIB_TEST(max(abs(mean(mat(vects)) - cov.mean())) < 1e-12);
+                    DLIB_TEST_MSG(max(abs(covariance(mat(vects)) - cov.covariance())) < 1e-12,
+                              max(abs(covariance(mat(vects)) - cov.covariance()))
+                              << "   dims = " << dims << "   samps = " << samps
+                              );
+                }
+            }
+
+            // merging accumulators must behave as if all the samples had been
+            // given to a single accumulator.
+            for (unsigned long dims = 1; dims < 5; ++dims)
+            {
+                for (unsigned long samps = 2; samps < 10; ++samps)
+                {
+                    vects.clear();
+                    cov.clear();
+                    cov2.clear();
+                    cov3.clear();
+                    for (unsigned long i = 0; i < samps; ++i)
+                    {
+                        vects.push_back(randm(dims,1,rnd));
+                        if ((i%3) == 0)
+                            cov.add(vects.back());
+                        else if ((i%3) == 1)
+                            cov2.add(vects.back());
+                        else
+                            cov3.add(vects.back());
+                    }
+                    const running_covariance_welford<matrix<double,0,1> > merged = cov + cov2 + cov3;
+                    DLIB_TEST(merged.in_vector_size() == (long)dims);
+                    DLIB_TEST(merged.current_n() == (long)samps);
+
+                    DLIB_TEST(max(abs(mean(mat(vects)) - merged.mean())) < 1e-12);
+                    DLIB_TEST_MSG(max(abs(covariance(mat(vects)) - merged.covariance())) < 1e-12,
+                              max(abs(covariance(mat(vects)) - merged.covariance()))
+                              << "   dims = " << dims << "   samps = " << samps
+                              );
+                }
+            }
+        }
+
+        void test_normalizer_from_welford_stats (
+        )
+        {
+            print_spinner();
+            dlib::rand rnd;
+
+            typedef matrix<double,0,1> sample_type;
+            std::vector<sample_type> samples;
+            running_covariance_welford<sample_type> stats;
+            for (int i = 0; i < 300; ++i)
+            {
+                sample_type s(6);
+                for (long j = 0; j < s.size(); ++j)
+                    s(j) = rnd.get_random_gaussian()*(j+1) + j;
+                samples.push_back(s);
+                stats.add(s);
+            }
+
+            // training from the streaming stats must match training from the samples
+            vector_normalizer<sample_type> normalizer, normalizer2;
+            normalizer.train(samples);
+            normalizer2.train(stats);
+            DLIB_TEST(max(abs(normalizer.means() - normalizer2.means())) < 1e-10);
+            DLIB_TEST(max(abs(normalizer.std_devs() - normalizer2.std_devs())) < 1e-10);
+
+            vector_normalizer_pca<sample_type> pca_normalizer, pca_normalizer2;
+            pca_normalizer.train(samples, 1.0);
+            pca_normalizer2.train(stats, 1.0);
+            DLIB_TEST(max(abs(pca_normalizer.means() - pca_normalizer2.means())) < 1e-10);
+            DLIB_TEST(max(abs(pca_normalizer.std_devs() - pca_normalizer2.std_devs())) < 1e-10);
+            DLIB_TEST(pca_normalizer.in_vector_size() == pca_normalizer2.in_vector_size());
+            DLIB_TEST(pca_normalizer.out_vector_size() == pca_normalizer2.out_vector_size());
+
+            // The two pca matrices can differ by the signs of their rows, so instead
+            // of comparing them directly check that the transform whitens the data:
+            // the outputs should have zero mean and identity covariance.
+            running_covariance_welford<sample_type> out_stats;
+            for (auto& s : samples)
+                out_stats.add(pca_normalizer2(s));
+            DLIB_TEST(max(abs(out_stats.mean())) < 1e-10);
+            DLIB_TEST_MSG(max(abs(out_stats.covariance() - identity_matrix<double>(out_stats.in_vector_size()))) < 1e-6,
+                max(abs(out_stats.covariance() - identity_matrix<double>(out_stats.in_vector_size()))));
+        }
+
+        template <typename T>
+        void test_running_stats_batch_add()
+        {
+            print_spinner();
+            dlib::rand rnd;
+
+            // lengths chosen to hit the simd main loop, the scalar tail, and the
+            // all-tail case
+            const size_t lengths[] = {0, 1, 7, 8, 9, 100, 1003};
+            for (auto len : lengths)
+            {
+                std::vector<T> vals(len);
+                for (auto& v : vals)
+                    v = static_cast<T>(rnd.get_random_gaussian());
+
+                running_stats<T> scalar, batch;
+                for (auto v : vals)
+                    scalar.add(v);
+                batch.add(vals.data(), vals.size());
+
+                DLIB_TEST(batch.current_n() == scalar.current_n());
+                if (len > 0)
+                {
+                    DLIB_TEST(batch.min() == scalar.min());
+                    DLIB_TEST(batch.max() == scalar.max());
+                    DLIB_TEST(std::abs(batch.mean() - scalar.mean()) < 1e-5);
+                }
+                if (len > 3)
+                {
+                    DLIB_TEST(std::abs(batch.variance() - scalar.variance()) < 1e-4);
+                    DLIB_TEST(std::abs(batch.skewness() - scalar.skewness()) < 1e-3);
+                    DLIB_TEST(std::abs(batch.ex_kurtosis() - scalar.ex_kurtosis()) < 1e-2);
+                }
+
+                // merging per-thread style partial stats must match doing it all in one
+                if (len > 8)
+                {
+                    running_stats<T> part1, part2;
+                    part1.add(vals.data(), len/2);
+                    part2.add(vals.data()+len/2, len-len/2);
+                    running_stats<T> merged = part1 + part2;
+                    DLIB_TEST(merged.current_n() == batch.current_n());
+                    DLIB_TEST(merged.min() == batch.min());
+                    DLIB_TEST(merged.max() == batch.max());
+                    DLIB_TEST(std::abs(merged.mean() - batch.mean()) < 1e-5);
+                    DLIB_TEST(std::abs(merged.variance() - batch.variance()) < 1e-4);
+                }
+            }
+        }
+
         void test_running_stats()
         {
             print_spinner();
@@ -376,6 +608,61 @@ namespace
             DLIB_TEST(std::abs(rsc1.covariance() - -0.3) < 1e-10);
         }
 
+        void test_running_quantile()
+        {
+            print_spinner();
+
+            dlib::rand rnd;
+
+            // The P-squared estimate of the median of uniform noise should land
+            // close to 0.5.
+            running_quantile<double> med(0.5);
+            std::vector<double> samples;
+            for (int i = 0; i < 10000; ++i)
+            {
+                const double val = rnd.get_random_double();
+                med.add(val);
+                samples.push_back(val);
+            }
+            DLIB_TEST(med.current_n() == 10000);
+            DLIB_TEST_MSG(std::abs(med.quantile() - 0.5) < 0.02, med.quantile());
+
+            // exact for the first few samples
+            running_quantile<double> small(0.5);
+            small.add(3); small.add(1); small.add(2);
+            DLIB_TEST(small.quantile() == 2);
+
+            // The sliding window mode should agree exactly with sorting the window
+            // ourselves.
+            running_quantile<double> win(0.9, 100);
+            for (int i = 0; i < 250; ++i)
+                win.add(samples[i]);
+            std::vector<double> last(samples.begin()+150, samples.begin()+250);
+            std::sort(last.begin(), last.end());
+            DLIB_TEST(win.quantile() == last[89]);
+
+            // merging two estimators should give about the same answer as feeding
+            // everything into one.
+            running_quantile<double> part1(0.5), part2(0.5);
+            for (int i = 0; i < 5000; ++i)
+                part1.add(samples[i]);
+            for (int i = 5000; i < 10000; ++i)
+                part2.add(samples[i]);
+            running_quantile<double> merged = part1 + part2;
+            DLIB_TEST(merged.current_n() == 10000);
+            DLIB_TEST_MSG(std::abs(merged.quantile() - med.quantile()) < 0.02, merged.quantile());
+
+            // test serialization of running_quantile
+            ostringstream sout;
+            serialize(med, sout);
+            istringstream sin(sout.str());
+            running_quantile<double> med2;
+            deserialize(med2, sin);
+            DLIB_TEST(med2.current_n() == med.current_n());
+            DLIB_TEST(med2.quantile_level() == med.quantile_level());
+            DLIB_TEST(med2.quantile() == med.quantile());
+        }
+
         void test_skewness_and_kurtosis_1()
         {
 
@@ -867,6 +1154,55 @@ namespace
         }
 
 
+        void test_pairwise_distances()
+        {
+            print_spinner();
+            dlib::rand rnd;
+            for (int iter = 0; iter < 10; ++iter)
+            {
+                const long dims = rnd.get_random_32bit_number()%10 + 1;
+                const long num1 = rnd.get_random_32bit_number()%20 + 1;
+                const long num2 = rnd.get_random_32bit_number()%20 + 1;
+                matrix<double> A = randm(num1, dims, rnd);
+                matrix<double> B = randm(num2, dims, rnd);
+
+                const matrix<double> D2 = pairwise_squared_distances(A, B);
+                const matrix<double> D = pairwise_distances(A, B);
+                DLIB_TEST(D2.nr() == num1 && D2.nc() == num2);
+                for (long r = 0; r < num1; ++r)
+                {
+                    for (long c = 0; c < num2; ++c)
+                    {
+                        const double truth = length_squared(rowm(A,r) - rowm(B,c));
+                        DLIB_TEST(std::abs(D2(r,c) - truth) < 1e-12);
+                        DLIB_TEST(std::abs(D(r,c) - std::sqrt(truth)) < 1e-12);
+                    }
+                }
+
+                // The std::vector overloads should give the same answers.
+                std::vector<matrix<double,0,1>> sampsA, sampsB;
+                for (long r = 0; r < num1; ++r)
+                    sampsA.push_back(trans(rowm(A,r)));
+                for (long r = 0; r < num2; ++r)
+                    sampsB.push_back(trans(rowm(B,r)));
+                DLIB_TEST(max(abs(pairwise_squared_distances(sampsA, sampsB) - D2)) < 1e-12);
+                DLIB_TEST(max(abs(pairwise_distances(sampsA, sampsB) - D)) < 1e-12);
+
+                // also check float since loss_metric embeddings are floats
+                const matrix<float> Af = matrix_cast<float>(A);
+                const matrix<float> Bf = matrix_cast<float>(B);
+                const matrix<float> D2f = pairwise_squared_distances(Af, Bf);
+                for (long r = 0; r < num1; ++r)
+                {
+                    for (long c = 0; c < num2; ++c)
+                    {
+                        const float truth = length_squared(rowm(Af,r) - rowm(Bf,c));
+                        DLIB_TEST(std::abs(D2f(r,c) - truth) < 1e-4);
+                    }
+                }
+            }
+        }
+
         void test_event_corr()
         {
             print_spinner();
@@ -883,6 +1219,44 @@ namespace
             DLIB_TEST(std::abs(event_correlation(10,1000,9,2000) - 3.69672251700842) < 1e-11);
         }
 
+        void test_normalize_rows()
+        {
+            print_spinner();
+            dlib::rand rnd;
+
+            typedef matrix<double,0,1> sample_type;
+            std::vector<sample_type> samples;
+            for (int i = 0; i < 200; ++i)
+            {
+                sample_type s(7);
+                for (long j = 0; j < s.size(); ++j)
+                    s(j) = rnd.get_random_gaussian()*3 + j;
+                samples.push_back(s);
+            }
+
+            matrix<double> batch(samples.size(), samples[0].size());
+            for (long r = 0; r < batch.nr(); ++r)
+                set_rowm(batch,r) = trans(samples[r]);
+
+            // the in-place batched normalize must match the per-sample one
+            vector_normalizer<sample_type> normalizer;
+            normalizer.train(samples);
+            matrix<double> normed = batch;
+            normalizer.normalize_rows(normed);
+            for (long r = 0; r < normed.nr(); ++r)
+                DLIB_TEST(max(abs(trans(rowm(normed,r)) - normalizer(samples[r]))) < 1e-12);
+
+            // and likewise for the pca version
+            vector_normalizer_pca<sample_type> pca_normalizer;
+            pca_normalizer.train(samples, 0.9);
+            matrix<double> projected;
+            pca_normalizer.normalize_rows(batch, projected);
+            DLIB_TEST(projected.nr() == batch.nr());
+            DLIB_TEST(projected.nc() == pca_normalizer.out_vector_size());
+            for (long r = 0; r < projected.nr(); ++r)
+                DLIB_TEST(max(abs(trans(rowm(projected,r)) - pca_normalizer(samples[r]))) < 1e-12);
+        }
+
         void perform_test (
         )
         {
@@ -892,11 +1266,17 @@ namespace
                 test_vector_normalizer_frobmetric(rnd);
 
             test_random_subset_selector();
+            test_random_subset_selector_merge();
             test_random_subset_selector2();
             test_running_covariance();
+            test_running_covariance_welford();
+            test_normalizer_from_welford_stats();
             test_running_cross_covariance();
             test_running_cross_covariance_sparse();
             test_running_stats();
+            test_running_stats_batch_add<float>();
+            test_running_stats_batch_add<double>();
+            test_running_quantile();
             test_skewness_and_kurtosis_1();
             test_skewness_and_kurtosis_2();
             test_randomize_samples();
@@ -904,9 +1284,11 @@ namespace
             another_test();
             test_average_precision();
             test_lda();
+            test_pairwise_distances();
             test_event_corr();
             test_running_stats_decayed();
             test_running_scalar_covariance_decayed();
+            test_normalize_rows();
         }
     } a;
 
@@ -243,6 +243,16 @@ namespace
         m(0) = -4;  dlog << LDEBUG << "svr: " << sinc(m(0)) << "   " << test5(m); DLIB_TEST(abs(sinc(m(0)) - test5(m)) < 0.01);
         m(0) = 5.0; dlog << LDEBUG << "svr: " << sinc(m(0)) << "   " << test5(m); DLIB_TEST(abs(sinc(m(0)) - test5(m)) < 0.01);
 
+        // make sure the batched evaluation path for RBF decision functions agrees
+        // with calling the decision function one sample at a time.
+        const std::vector<double> batch = batch_evaluate(test4, samples);
+        DLIB_TEST(batch.size() == samples.size());
+        for (unsigned long i = 0; i < samples.size(); ++i)
+        {
+            DLIB_TEST_MSG(abs(batch[i] - test4(samples[i])) < 1e-10,
+                abs(batch[i] - test4(samples[i])));
+        }
+
 
         randomize_samples(samples, labels);
         dlog << LINFO << "KRR MSE and R-squared: "<< cross_validate_regression_trainer(krr_test, samples, labels, 6);
@@ -378,11 +388,31 @@ namespace
         DLIB_TEST_MSG(rs.scale(test(m)) > 6, rs.scale(test(m)));
         DLIB_TEST_MSG(df(m) + thresh < 0, df(m));
 
-        m(0) = -0.5; m(1) = sinc(m(0))+1;   
+        m(0) = -0.5; m(1) = sinc(m(0))+1;
         dlog << LDEBUG << "   " << test(m) << " is " << rs.scale(test(m)) << " standard deviations from sinc.";
         DLIB_TEST_MSG(rs.scale(test(m)) > 6, rs.scale(test(m)));
         DLIB_TEST_MSG(df(m) + thresh < 0, df(m));
 
+        // The fast_decision_function must score streams exactly like the decision
+        // function it wraps.
+        fast_decision_function<kernel_type> fdf(df);
+        dlib::rand rnd;
+        for (int i = 0; i < 200; ++i)
+        {
+            m(0) = rnd.get_random_double()*30 - 15;
+            m(1) = rnd.get_random_double()*10 - 5;
+            DLIB_TEST_MSG(std::abs(fdf(m) - df(m)) < 1e-12, std::abs(fdf(m) - df(m)));
+        }
+
+        // and it should survive a round trip through serialization
+        ostringstream sout;
+        serialize(fdf, sout);
+        istringstream sin(sout.str());
+        fast_decision_function<kernel_type> fdf2;
+        deserialize(fdf2, sin);
+        m(0) = -1.5; m(1) = sinc(m(0));
+        DLIB_TEST(std::abs(fdf2(m) - df(m)) < 1e-12);
+
         dlog << LINFO << "   end test_anomaly_detection()";
     }
 
@@ -439,6 +469,9 @@ namespace
         c_trainer.set_kernel(kernel_type(gamma));
         c_trainer.set_c(100);
 
+        svm_c_trainer<kernel_matrix_cache<kernel_type> > c_cached_trainer;
+        c_cached_trainer.set_c(100);
+
         svm_c_linear_trainer<linear_kernel<matrix<double,0,1> > > lin_trainer;
         lin_trainer.set_c(100000);
         // use an ekm to linearize this dataset so we can use it with the lin_trainer
@@ -457,6 +490,10 @@ namespace
         print_spinner();
         matrix<scalar_type> svm_c_cv = cross_validate_trainer(c_trainer, x,y, 4);
         print_spinner();
+        matrix<scalar_type> svm_c_threaded_cv = cross_validate_trainer_threaded(c_trainer, x,y, 4, 2);
+        print_spinner();
+        matrix<scalar_type> svm_c_cached_cv = cross_validate_trainer_cached(c_cached_trainer, kernel_type(gamma), x,y, 4, 2);
+        print_spinner();
         matrix<scalar_type> rbf_cv = cross_validate_trainer_threaded(rbf_trainer, x,y, 10, 2);
         print_spinner();
         matrix<scalar_type> lin_cv = cross_validate_trainer_threaded(lin_trainer, x_linearized, y, 4, 2);
@@ -475,6 +512,7 @@ namespace
         dlog << LDEBUG << "krr cv:        " << krr_cv;
         dlog << LDEBUG << "nu-svm cv:     " << svm_cv;
         dlog << LDEBUG << "C-svm cv:      " << svm_c_cv;
+        dlog << LDEBUG << "C-svm cached cv: " << svm_c_cached_cv;
         dlog << LDEBUG << "rbf cv:        " << rbf_cv;
         dlog << LDEBUG << "lin cv:        " << lin_cv;
         dlog << LDEBUG << "ocas_ekm cv:   " << ocas_ekm_cv;
@@ -490,6 +528,10 @@ namespace
         DLIB_TEST_MSG(mean(krr_cv) > 0.9, krr_cv);
         DLIB_TEST_MSG(mean(svm_cv) > 0.9, svm_cv);
         DLIB_TEST_MSG(mean(svm_c_cv) > 0.9, svm_c_cv);
+        // the cached version uses the same fold splitting as the threaded version so it
+        // should produce exactly the same result, just without recomputing kernel products.
+        DLIB_TEST_MSG(sum(abs(svm_c_cached_cv - svm_c_threaded_cv)) < 1e-12,
+                      svm_c_cached_cv << "   \n" << svm_c_threaded_cv);
         DLIB_TEST_MSG(mean(rbf_cv) > 0.9, rbf_cv);
         DLIB_TEST_MSG(mean(lin_cv) > 0.9, lin_cv);
         DLIB_TEST_MSG(mean(peg_cv) > 0.9, peg_cv);
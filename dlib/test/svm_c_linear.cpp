@@ -169,6 +169,81 @@ namespace
         labels.push_back(+1);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_fast_sparse_linear_function (
+    )
+    {
+        print_spinner();
+        dlog << LINFO << "test fast_sparse_linear_function";
+
+        // Train on high dimensional sparse data where each sample only touches a few
+        // dimensions, like a bag-of-words text problem.
+        dlib::rand rnd;
+        std::vector<sparse_sample_type> samples;
+        std::vector<double> labels;
+        const unsigned int dims = 10000;
+        for (int i = 0; i < 200; ++i)
+        {
+            sparse_sample_type samp;
+            const double label = (i%2 == 0) ? +1 : -1;
+            // a few informative features plus random noise features
+            samp.push_back(make_pair(label > 0 ? 3u : 7u, 1.0 + rnd.get_random_double()));
+            for (int j = 0; j < 10; ++j)
+                samp.push_back(make_pair(10 + rnd.get_random_32bit_number()%(dims-10), rnd.get_random_double()));
+            std::sort(samp.begin(), samp.end());
+            samp.erase(std::unique(samp.begin(), samp.end(),
+                [](const std::pair<unsigned int,double>& a, const std::pair<unsigned int,double>& b)
+                { return a.first == b.first; }), samp.end());
+            samples.push_back(samp);
+            labels.push_back(label);
+        }
+
+        svm_c_linear_trainer<sparse_linear_kernel<sparse_sample_type> > trainer;
+        trainer.set_c(10);
+        decision_function<sparse_linear_kernel<sparse_sample_type> > df = trainer.train(samples, labels);
+
+        fast_sparse_linear_function<sparse_sample_type> ff(df);
+        DLIB_TEST(ff.weights_are_quantized() == false);
+        for (const auto& samp : samples)
+            DLIB_TEST(std::abs(ff(samp) - df(samp)) < 1e-10);
+
+        // queries touching dimensions the model never saw just contribute 0
+        sparse_sample_type samp;
+        samp.push_back(make_pair(3u, 1.0));
+        samp.push_back(make_pair(2*dims, 100.0));
+        DLIB_TEST(std::abs(ff(samp) - df(samp)) < 1e-10);
+
+        // quantized weights give nearly the same outputs and identical labels here
+        fast_sparse_linear_function<sparse_sample_type> qf(df, true);
+        DLIB_TEST(qf.weights_are_quantized() == true);
+        DLIB_TEST(qf.num_dimensions() == ff.num_dimensions());
+        for (const auto& s : samples)
+        {
+            DLIB_TEST(std::abs(qf(s) - df(s)) < 1e-3);
+            DLIB_TEST((qf(s) > 0) == (df(s) > 0));
+        }
+
+        // serialization round trips
+        ostringstream sout;
+        serialize(qf, sout);
+        serialize(ff, sout);
+        istringstream sin(sout.str());
+        fast_sparse_linear_function<sparse_sample_type> qf2, ff2;
+        deserialize(qf2, sin);
+        deserialize(ff2, sin);
+        for (const auto& s : samples)
+        {
+            DLIB_TEST(qf2(s) == qf(s));
+            DLIB_TEST(ff2(s) == ff(s));
+        }
+
+        // a default constructed function is the zero function
+        fast_sparse_linear_function<sparse_sample_type> empty;
+        DLIB_TEST(empty(samples[0]) == 0);
+        DLIB_TEST(empty.num_dimensions() == 0);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     void test_sparse (
@@ -276,6 +351,48 @@ namespace
         DLIB_TEST(abs(df(samples[3]) - (1)) < 1e-6);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    void test_multithreaded (
+    )
+    {
+        print_spinner();
+        dlog << LINFO << "test multithreaded risk evaluation";
+
+        dlib::rand rnd;
+        std::vector<sample_type> samples;
+        std::vector<double> labels;
+        sample_type samp(5);
+        for (int i = 0; i < 150; ++i)
+        {
+            for (long j = 0; j < samp.size(); ++j)
+                samp(j) = rnd.get_random_gaussian();
+            samples.push_back(samp);
+            labels.push_back(samp(0) + samp(1) > 0 ? +1 : -1);
+        }
+
+        svm_c_linear_trainer<linear_kernel<sample_type> > trainer;
+        trainer.set_c(10);
+        trainer.set_epsilon(1e-10);
+
+        trainer.set_num_threads(1);
+        DLIB_TEST(trainer.get_num_threads() == 1);
+        double obj1;
+        decision_function<linear_kernel<sample_type> > df1 = trainer.train(samples, labels, obj1);
+
+        trainer.set_num_threads(4);
+        DLIB_TEST(trainer.get_num_threads() == 4);
+        double obj4;
+        decision_function<linear_kernel<sample_type> > df4 = trainer.train(samples, labels, obj4);
+
+        // The parallel version changes the order of the floating point sums, so the
+        // results can differ slightly, but both should arrive at the same solution.
+        dlog << LINFO << "obj1: " << obj1 << "  obj4: " << obj4;
+        DLIB_TEST_MSG(abs(obj1 - obj4) < 1e-6, abs(obj1 - obj4));
+        DLIB_TEST(max(abs(df1.basis_vectors(0) - df4.basis_vectors(0))) < 1e-6);
+        DLIB_TEST(abs(df1.b - df4.b) < 1e-6);
+    }
+
 // ----------------------------------------------------------------------------------------
 
     class tester_svm_c_linear : public tester
@@ -292,6 +409,8 @@ namespace
         {
             test_dense();
             test_sparse();
+            test_fast_sparse_linear_function();
+            test_multithreaded();
             run_prior_test();
             run_prior_sparse_test();
 
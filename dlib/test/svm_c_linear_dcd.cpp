@@ -499,6 +499,62 @@ namespace
         DLIB_TEST(df(sample) < 0);
     }
 
+    void test_batched_mode()
+    {
+        typedef matrix<double,10,1> sample_type;
+        typedef linear_kernel<sample_type> kernel_type;
+
+        std::vector<sample_type> samples;
+        std::vector<double> labels;
+
+        sample_type sample;
+        dlib::rand rnd;
+        double label = +1;
+        for (int i = 0; i < 200; ++i)
+        {
+            label *= -1;
+            sample = 0;
+            for (int j = 0; j < 5; ++j)
+            {
+                int idx = rnd.get_random_32bit_number()%10;
+                sample(idx) = label*rnd.get_random_double();
+            }
+            samples.push_back(sample);
+            labels.push_back(label);
+        }
+
+        // The batched mode is just a different way of scheduling the same
+        // computations, so it must produce exactly the same decision function as
+        // the sequential mode.
+        for (int do_l2 = 0; do_l2 <= 1; ++do_l2)
+        {
+            for (int shrinking = 0; shrinking <= 1; ++shrinking)
+            {
+                svm_c_linear_dcd_trainer<kernel_type> linear_trainer;
+                linear_trainer.set_c(5);
+                linear_trainer.set_epsilon(1e-10);
+                linear_trainer.solve_svm_l2_problem(do_l2 != 0);
+                linear_trainer.enable_shrinking(shrinking != 0);
+
+                const decision_function<kernel_type> df = linear_trainer.train(samples, labels);
+
+                const unsigned long batch_sizes[] = {1, 7, 64, 5000};
+                for (unsigned long b : batch_sizes)
+                {
+                    linear_trainer.set_batch_size(b);
+                    DLIB_TEST(linear_trainer.get_batch_size() == b);
+                    const decision_function<kernel_type> df2 = linear_trainer.train(samples, labels);
+                    DLIB_TEST_MSG(max(abs(df.basis_vectors(0) - df2.basis_vectors(0))) == 0,
+                        "b: " << b << "  do_l2: " << do_l2 << "  shrinking: " << shrinking);
+                    DLIB_TEST(df.b == df2.b);
+                }
+                print_spinner();
+            }
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
     class tester_svm_c_linear_dcd : public tester
     {
     public:
@@ -535,6 +591,9 @@ namespace
             print_spinner();
 
             test_l2_version();
+            print_spinner();
+
+            test_batched_mode();
         }
     } a;
 
@@ -150,40 +150,41 @@ namespace
     // -----------------------------------
 
         void test_stuff (
-            long csize 
+            long csize,
+            bool disk_backed
         )
         {
             print_spinner();
-            dlog << LINFO << "csize: "<< csize;
+            dlog << LINFO << "csize: "<< csize << "  disk_backed: " << disk_backed;
             matrix<double> m = randm(10,10,rnd);
 
             m = make_symmetric(m);
 
-            DLIB_TEST(equal(symmetric_matrix_cache<float>(m, csize), matrix_cast<float>(m)));
-            DLIB_TEST(equal(symmetric_matrix_cache<double>(m, csize), matrix_cast<double>(m)));
+            DLIB_TEST(equal(symmetric_matrix_cache<float>(m, csize, disk_backed), matrix_cast<float>(m)));
+            DLIB_TEST(equal(symmetric_matrix_cache<double>(m, csize, disk_backed), matrix_cast<double>(m)));
 
             dlog << LINFO << "test colm/rowm";
 
 
             for (long i = 0; i < m.nr(); ++i)
             {
-                DLIB_TEST(equal(colm(symmetric_matrix_cache<float>(m, csize),i), colm(matrix_cast<float>(m),i)));
-                DLIB_TEST(equal(rowm(symmetric_matrix_cache<float>(m, csize),i), rowm(matrix_cast<float>(m),i)));
+                DLIB_TEST(equal(colm(symmetric_matrix_cache<float>(m, csize, disk_backed),i), colm(matrix_cast<float>(m),i)));
+                DLIB_TEST(equal(rowm(symmetric_matrix_cache<float>(m, csize, disk_backed),i), rowm(matrix_cast<float>(m),i)));
                 // things are supposed to be symmetric
-                DLIB_TEST(equal(colm(symmetric_matrix_cache<float>(m, csize),i), trans(rowm(matrix_cast<float>(m),i))));
-                DLIB_TEST(equal(rowm(symmetric_matrix_cache<float>(m, csize),i), trans(colm(matrix_cast<float>(m),i))));
+                DLIB_TEST(equal(colm(symmetric_matrix_cache<float>(m, csize, disk_backed),i), trans(rowm(matrix_cast<float>(m),i))));
+                DLIB_TEST(equal(rowm(symmetric_matrix_cache<float>(m, csize, disk_backed),i), trans(colm(matrix_cast<float>(m),i))));
             }
 
             dlog << LINFO << "test diag";
-            DLIB_TEST(equal(diag(symmetric_matrix_cache<float>(m,csize)), diag(matrix_cast<float>(m))));
+            DLIB_TEST(equal(diag(symmetric_matrix_cache<float>(m,csize,disk_backed)), diag(matrix_cast<float>(m))));
 
-            test_colm_exp(symmetric_matrix_cache<float>(m,csize), matrix_cast<float>(m));
-            test_rowm_exp(symmetric_matrix_cache<float>(m,csize), matrix_cast<float>(m));
-            test_diag_exp(symmetric_matrix_cache<float>(m,csize), matrix_cast<float>(m));
+            test_colm_exp(symmetric_matrix_cache<float>(m,csize,disk_backed), matrix_cast<float>(m));
+            test_rowm_exp(symmetric_matrix_cache<float>(m,csize,disk_backed), matrix_cast<float>(m));
+            test_diag_exp(symmetric_matrix_cache<float>(m,csize,disk_backed), matrix_cast<float>(m));
 
-            test_colm_exp(tmp(symmetric_matrix_cache<float>(m,csize)), tmp(matrix_cast<float>(m)));
-            test_rowm_exp(symmetric_matrix_cache<float>(m,csize), tmp(matrix_cast<float>(m)));
-            test_diag_exp(tmp(symmetric_matrix_cache<float>(m,csize)), tmp(matrix_cast<float>(m)));
+            test_colm_exp(tmp(symmetric_matrix_cache<float>(m,csize,disk_backed)), tmp(matrix_cast<float>(m)));
+            test_rowm_exp(symmetric_matrix_cache<float>(m,csize,disk_backed), tmp(matrix_cast<float>(m)));
+            test_diag_exp(tmp(symmetric_matrix_cache<float>(m,csize,disk_backed)), tmp(matrix_cast<float>(m)));
         }
 
 
@@ -193,9 +194,12 @@ namespace
 
             for (int itr = 0; itr < 5; ++itr)
             {
-                test_stuff(0);
-                test_stuff(1);
-                test_stuff(2);
+                for (int disk_backed = 0; disk_backed < 2; ++disk_backed)
+                {
+                    test_stuff(0, disk_backed != 0);
+                    test_stuff(1, disk_backed != 0);
+                    test_stuff(2, disk_backed != 0);
+                }
             }
 
         }
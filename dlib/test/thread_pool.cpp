@@ -85,12 +85,27 @@ namespace
         )
         {
             add_functor f;
+            // run everything against both the normal and work stealing schedulers
+            for (int enable_work_stealing = 0; enable_work_stealing < 2; ++enable_work_stealing)
             for (int num_threads= 0; num_threads < 4; ++num_threads)
             {
                 dlib::future<int> a, b, c, res, d;
-                thread_pool tp(num_threads);
+                thread_pool tp(num_threads, enable_work_stealing != 0);
                 print_spinner();
 
+                // Run the tests against the whole range of spin settings: park
+                // immediately, the default, and a long spin phase.
+                if (num_threads == 1)
+                {
+                    tp.set_max_spin_count(0);
+                    DLIB_TEST(tp.get_max_spin_count() == 0);
+                }
+                else if (num_threads == 2)
+                {
+                    tp.set_max_spin_count(200000);
+                    DLIB_TEST(tp.get_max_spin_count() == 200000);
+                }
+
                 dlib::future<some_struct> obj;
 
 
@@ -8,6 +8,7 @@
 #include <ctime>
 #include <dlib/misc_api.h>
 #include <dlib/threads.h>
+#include <dlib/pipeline.h>
 
 #include "tester.h"
 
@@ -21,7 +22,7 @@ namespace
 
     void test_async()
     {
-#if __cplusplus >= 201103
+#if __cplusplus >= 201103
         print_spinner();
         auto v1 = dlib::async([]() { dlib::sleep(500); return 1; }).share();
         auto v2 = dlib::async([v1]() { dlib::sleep(400); return v1.get()+1; }).share();
@@ -46,6 +47,185 @@ namespace
 #endif
     }
 
+    void test_continuation_futures()
+    {
+#if __cplusplus >= 201103
+        print_spinner();
+        // a simple then() chain, hopping between lanes along the way
+        auto f1 = dlib::async_continuable([]() { dlib::sleep(200); return 1; });
+        auto f2 = f1.then([](int a) { return a+1; });
+        auto f3 = f2.then(task_priority::background, [](int a) { return a*10; });
+        DLIB_TEST(f3.get() == 20);
+
+        // get() has shared semantics so both chains above still work, and a
+        // continuation attached after the future is ready runs as well.
+        DLIB_TEST(f1.get() == 1);
+        DLIB_TEST(f2.get() == 2);
+        auto f4 = f1.then([](int a) { return a-1; });
+        DLIB_TEST(f4.get() == 0);
+
+        print_spinner();
+        // fan out then join with when_all()
+        std::vector<continuation_future<int>> parts;
+        for (int i = 0; i < 10; ++i)
+            parts.push_back(dlib::async_continuable([i]() { dlib::sleep(10*(10-i)); return i; }));
+        auto total = when_all(parts).then([](const std::vector<int>& vals)
+        {
+            DLIB_TEST(vals.size() == 10);
+            int sum = 0;
+            for (size_t i = 0; i < vals.size(); ++i)
+            {
+                DLIB_TEST(vals[i] == (int)i);
+                sum += vals[i];
+            }
+            return sum;
+        });
+        DLIB_TEST(total.get() == 45);
+        DLIB_TEST(when_all(std::vector<continuation_future<int>>()).get().size() == 0);
+
+        print_spinner();
+        // exceptions skip the continuation and propagate down the chain
+        bool ran = false;
+        auto bad = dlib::async_continuable([]() -> int { throw error("oops"); })
+                       .then([&ran](int a) { ran = true; return a; });
+        bool got_exception = false;
+        try
+        {
+            bad.get();
+        }
+        catch (error& e)
+        {
+            got_exception = true;
+            DLIB_TEST(e.what() == string("oops"));
+        }
+        DLIB_TEST(got_exception);
+        DLIB_TEST(!ran);
+
+        // void futures chain too
+        int side_effect = 0;
+        auto v1 = dlib::async_continuable([&side_effect]() { side_effect = 1; });
+        auto v2 = v1.then([&side_effect]() { ++side_effect; });
+        std::vector<continuation_future<void>> voids;
+        voids.push_back(v1);
+        voids.push_back(v2);
+        when_all(voids).get();
+        DLIB_TEST(side_effect == 2);
+
+        continuation_future<int> invalid;
+        DLIB_TEST(!invalid.valid());
+        DLIB_TEST(!invalid.is_ready());
+#endif
+    }
+
+    void test_pipeline()
+    {
+#if __cplusplus >= 201103
+        print_spinner();
+        // Single threaded stages preserve order, so the results must come out the
+        // other end transformed and in order.
+        {
+            dlib::pipeline<int> pl;
+            pl.add_stage([](int& v) { v *= 2; }, 1, 4);
+            pl.add_stage([](int& v) { v += 3; }, 1, 4);
+            pl.enable_output(200);
+            pl.start();
+            DLIB_TEST(pl.is_running());
+            for (int i = 0; i < 100; ++i)
+                DLIB_TEST(pl.enqueue(int(i)));
+            pl.drain();
+            pl.stop();
+            DLIB_TEST(!pl.is_running());
+            int v;
+            for (int i = 0; i < 100; ++i)
+            {
+                DLIB_TEST(pl.dequeue(v));
+                DLIB_TEST(v == 2*i+3);
+            }
+            DLIB_TEST(!pl.dequeue(v));
+            DLIB_TEST(pl.num_dropped() == 0);
+            DLIB_TEST(!pl.enqueue(v));
+        }
+
+        print_spinner();
+        // A stage with several workers may reorder items but must not lose any.
+        {
+            dlib::pipeline<int> pl;
+            pl.add_stage([](int& v) { v += 1; }, 4, 8);
+            pl.enable_output(200);
+            pl.start();
+            for (int i = 0; i < 100; ++i)
+                pl.enqueue(int(i));
+            pl.drain();
+            pl.stop();
+            int v, sum = 0, count = 0;
+            while (pl.dequeue(v))
+            {
+                sum += v;
+                ++count;
+            }
+            DLIB_TEST(count == 100);
+            DLIB_TEST(sum == 100*99/2 + 100);
+        }
+
+        print_spinner();
+        // With a slow stage behind a drop-oldest queue the producer never blocks
+        // and every item is either processed or counted as dropped.
+        {
+            dlib::pipeline<int> pl;
+            pl.add_stage([](int&) { dlib::sleep(20); }, 1, 2, true);
+            pl.enable_output(1000);
+            pl.start();
+            const unsigned long num = 50;
+            for (unsigned long i = 0; i < num; ++i)
+                pl.enqueue(int(i));
+            pl.drain();
+            pl.stop();
+            int v;
+            unsigned long processed = 0;
+            while (pl.dequeue(v))
+                ++processed;
+            dlog << LINFO << "pipeline processed: " << processed << "  dropped: " << pl.num_dropped();
+            DLIB_TEST(pl.num_dropped() > 0);
+            DLIB_TEST(processed + pl.num_dropped() == num);
+        }
+#endif
+    }
+
+    void test_pool_lanes()
+    {
+#if __cplusplus >= 201103
+        print_spinner();
+        // Each priority lane should be its own pool and the no-argument version should
+        // be the normal lane.
+        thread_pool& normal = default_thread_pool();
+        DLIB_TEST(&normal == &default_thread_pool(task_priority::normal));
+        DLIB_TEST(&normal != &default_thread_pool(task_priority::background));
+        DLIB_TEST(&normal != &default_thread_pool(task_priority::latency_critical));
+        DLIB_TEST(default_thread_pool(task_priority::latency_critical).num_threads_in_pool() >= 1);
+
+        set_default_thread_pool_size(task_priority::background, 2);
+        thread_pool& old_background = default_thread_pool(task_priority::background);
+        DLIB_TEST(old_background.num_threads_in_pool() == 2);
+
+        // Resizing to the current size shouldn't replace the pool.
+        set_default_thread_pool_size(task_priority::background, 2);
+        DLIB_TEST(&old_background == &default_thread_pool(task_priority::background));
+
+        set_default_thread_pool_size(task_priority::background, 3);
+        DLIB_TEST(&old_background != &default_thread_pool(task_priority::background));
+        DLIB_TEST(default_thread_pool(task_priority::background).num_threads_in_pool() == 3);
+
+        // The old pool must stay alive and usable after a resize so references handed
+        // out earlier don't dangle.
+        auto v1 = dlib::async(old_background, []() { return 1; });
+        auto v2 = dlib::async(task_priority::background, [](int a) { return a+1; }, 1);
+        auto v3 = dlib::async(task_priority::latency_critical, []() { return 3; });
+        DLIB_TEST(v1.get() == 1);
+        DLIB_TEST(v2.get() == 2);
+        DLIB_TEST(v3.get() == 3);
+#endif
+    }
+
     class threads_tester : public tester
     {
     public:
@@ -95,6 +275,9 @@ namespace
             DLIB_TEST(!failure);
 
             test_async();
+            test_continuation_futures();
+            test_pipeline();
+            test_pool_lanes();
         }
 
         void thread_end_handler (
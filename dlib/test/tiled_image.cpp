@@ -0,0 +1,202 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include <dlib/array2d.h>
+#include <dlib/dir_nav.h>
+#include <dlib/image_transforms.h>
+#include <dlib/matrix.h>
+#include <dlib/rand.h>
+#include "tester.h"
+
+namespace
+{
+
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.tiled_image");
+
+// ----------------------------------------------------------------------------------------
+
+    void test_block_io (
+    )
+    {
+        dlib::rand rnd;
+        array2d<unsigned char> ref(237, 181);
+        for (long r = 0; r < ref.nr(); ++r)
+        {
+            for (long c = 0; c < ref.nc(); ++c)
+                ref[r][c] = rnd.get_random_8bit_number();
+        }
+
+        tiled_image<unsigned char> img;
+        img.set_size(ref.nr(), ref.nc());
+        DLIB_TEST(img.nr() == ref.nr());
+        DLIB_TEST(img.nc() == ref.nc());
+
+        // everything reads back as zero before we write anything
+        array2d<unsigned char> block;
+        img.load_block(get_rect(img), block);
+        DLIB_TEST(max(matrix_cast<int>(mat(block))) == 0);
+
+        // whole image round trip
+        img.save_block(get_rect(img), ref);
+        img.load_block(get_rect(img), block);
+        DLIB_TEST(mat(block) == mat(ref));
+
+        // random sub-block round trips
+        for (int i = 0; i < 100; ++i)
+        {
+            const long r1 = rnd.get_random_32bit_number()%ref.nr();
+            const long r2 = rnd.get_random_32bit_number()%ref.nr();
+            const long c1 = rnd.get_random_32bit_number()%ref.nc();
+            const long c2 = rnd.get_random_32bit_number()%ref.nc();
+            const rectangle rect(std::min(c1,c2), std::min(r1,r2),
+                                 std::max(c1,c2), std::max(r1,r2));
+            img.load_block(rect, block);
+            DLIB_TEST(mat(block) == subm(mat(ref), rect.top(), rect.left(),
+                                         rect.height(), rect.width()));
+        }
+
+        // writing a sub-block only changes that sub-block
+        const rectangle rect(20, 30, 80, 90);
+        array2d<unsigned char> patch(rect.height(), rect.width());
+        assign_all_pixels(patch, 7);
+        img.save_block(rect, patch);
+        for (long r = rect.top(); r <= rect.bottom(); ++r)
+        {
+            for (long c = rect.left(); c <= rect.right(); ++c)
+                ref[r][c] = 7;
+        }
+        img.load_block(get_rect(img), block);
+        DLIB_TEST(mat(block) == mat(ref));
+
+        // empty blocks are a no-op
+        img.load_block(rectangle(), block);
+        DLIB_TEST(block.size() == 0);
+
+        // pixel types get converted via assign_pixel()
+        array2d<int> iblock;
+        img.load_block(rect, iblock);
+        DLIB_TEST(min(mat(iblock)) == 7 && max(mat(iblock)) == 7);
+
+        img.clear();
+        DLIB_TEST(img.nr() == 0);
+        DLIB_TEST(img.nc() == 0);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_named_backing_file (
+    )
+    {
+        const std::string filename = "tiled_image.test.tmp";
+        {
+            tiled_image<unsigned char> img;
+            img.set_size(10, 10, filename);
+            array2d<unsigned char> block(10, 10);
+            assign_all_pixels(block, 42);
+            img.save_block(get_rect(img), block);
+        }
+        // unlike the temporary backed variant, the named file stays on disk
+        DLIB_TEST(file_exists(filename));
+        std::remove(filename.c_str());
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    struct threshold_op
+    {
+        void operator() (
+            const array2d<unsigned char>& in,
+            array2d<unsigned char>& out
+        ) const
+        {
+            threshold_image(in, out, 100);
+        }
+    };
+
+    struct filter_op
+    {
+        void operator() (
+            const array2d<unsigned char>& in,
+            array2d<unsigned char>& out
+        ) const
+        {
+            spatially_filter_image(in, out, ones_matrix<int>(7,7), 49);
+        }
+    };
+
+    template <typename funct_type>
+    void test_process_tiles (
+        const funct_type& funct,
+        long tile_size,
+        long halo
+    )
+    {
+        dlib::rand rnd;
+        array2d<unsigned char> ref(237, 181);
+        for (long r = 0; r < ref.nr(); ++r)
+        {
+            for (long c = 0; c < ref.nc(); ++c)
+                ref[r][c] = rnd.get_random_8bit_number();
+        }
+
+        // what the result should be if the image fit in memory all at once
+        array2d<unsigned char> expected;
+        funct(ref, expected);
+
+        tiled_image<unsigned char> src, dest;
+        src.set_size(ref.nr(), ref.nc());
+        dest.set_size(ref.nr(), ref.nc());
+        src.save_block(get_rect(src), ref);
+
+        process_tiles(src, dest, funct, tile_size, halo);
+
+        array2d<unsigned char> result;
+        dest.load_block(get_rect(dest), result);
+        DLIB_TEST(mat(result) == mat(expected));
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class tiled_image_tester : public tester
+    {
+    public:
+        tiled_image_tester (
+        ) :
+            tester ("test_tiled_image",
+                    "Runs tests on the tiled_image component.")
+        {}
+
+        void perform_test (
+        )
+        {
+            print_spinner();
+            test_block_io();
+
+            print_spinner();
+            test_named_backing_file();
+
+            // A point operation needs no halo at all.
+            print_spinner();
+            test_process_tiles(threshold_op(), 64, 0);
+
+            // A 7x7 filter needs its 3 pixel radius as halo.  Also make sure
+            // tile sizes that do and don't evenly divide the image both work.
+            print_spinner();
+            test_process_tiles(filter_op(), 64, 3);
+            print_spinner();
+            test_process_tiles(filter_op(), 100, 3);
+            print_spinner();
+            test_process_tiles(filter_op(), 1000, 3);
+        }
+    } a;
+
+}
+
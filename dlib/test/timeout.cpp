@@ -0,0 +1,169 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <dlib/timeout.h>
+#include "tester.h"
+
+namespace
+{
+
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.timeout");
+
+// ----------------------------------------------------------------------------------------
+
+    struct counter_callback
+    {
+        std::atomic<int> count{0};
+        void hit() { ++count; }
+        void hit_with_arg(int amount) { count += amount; }
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    void test_shared_timeout_fires (
+    )
+    {
+        // A timeout that is allowed to expire must run its callback exactly once,
+        // and not before the requested delay.
+        counter_callback cb;
+        const auto start = chrono::steady_clock::now();
+        {
+            shared_timeout t(cb, &counter_callback::hit, 60);
+            while (cb.count == 0 &&
+                   chrono::steady_clock::now()-start < chrono::seconds(10))
+                this_thread::sleep_for(chrono::milliseconds(5));
+        }
+        DLIB_TEST(cb.count == 1);
+        DLIB_TEST(chrono::steady_clock::now()-start >= chrono::milliseconds(60));
+
+        // the member-function-with-argument form works too
+        counter_callback cb2;
+        {
+            shared_timeout t(cb2, &counter_callback::hit_with_arg, 30, 5);
+            while (cb2.count == 0 &&
+                   chrono::steady_clock::now()-start < chrono::seconds(10))
+                this_thread::sleep_for(chrono::milliseconds(5));
+        }
+        DLIB_TEST(cb2.count == 5);
+
+        // and so does the plain function object form
+        std::atomic<int> lambda_count(0);
+        {
+            shared_timeout t([&](){ ++lambda_count; }, 30);
+            const auto lstart = chrono::steady_clock::now();
+            while (lambda_count == 0 &&
+                   chrono::steady_clock::now()-lstart < chrono::seconds(10))
+                this_thread::sleep_for(chrono::milliseconds(5));
+        }
+        DLIB_TEST(lambda_count == 1);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_shared_timeout_cancel (
+    )
+    {
+        // Destructing a shared_timeout before its deadline must stop the callback
+        // from ever running.
+        counter_callback cb;
+        {
+            shared_timeout t(cb, &counter_callback::hit, 10000);
+        }
+        this_thread::sleep_for(chrono::milliseconds(100));
+        DLIB_TEST(cb.count == 0);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_shared_timeout_many (
+    )
+    {
+        // Many timeouts outstanding at once: every expired one fires exactly once
+        // and every canceled one doesn't fire at all, including when the deadlines
+        // hash into the same wheel slots.
+        counter_callback fired;
+        counter_callback canceled;
+        std::vector<std::unique_ptr<shared_timeout> > keep, drop;
+        for (int i = 0; i < 100; ++i)
+        {
+            keep.push_back(std::unique_ptr<shared_timeout>(
+                new shared_timeout(fired, &counter_callback::hit, 50 + i%7)));
+            drop.push_back(std::unique_ptr<shared_timeout>(
+                new shared_timeout(canceled, &counter_callback::hit, 50 + i%7)));
+        }
+        drop.clear();
+
+        const auto start = chrono::steady_clock::now();
+        while (fired.count < 100 &&
+               chrono::steady_clock::now()-start < chrono::seconds(10))
+            this_thread::sleep_for(chrono::milliseconds(5));
+        keep.clear();
+        DLIB_TEST_MSG(fired.count == 100, fired.count);
+        DLIB_TEST(canceled.count == 0);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void test_shared_timeout_destructor_waits (
+    )
+    {
+        // If the callback is running when the shared_timeout is destructed then the
+        // destructor must block until the callback has finished.
+        std::atomic<bool> in_callback(false);
+        std::atomic<bool> finished(false);
+        {
+            shared_timeout t([&]()
+            {
+                in_callback = true;
+                this_thread::sleep_for(chrono::milliseconds(200));
+                finished = true;
+            }, 20);
+
+            const auto start = chrono::steady_clock::now();
+            while (!in_callback &&
+                   chrono::steady_clock::now()-start < chrono::seconds(10))
+                this_thread::sleep_for(chrono::milliseconds(1));
+            DLIB_TEST(in_callback);
+        }
+        // the destructor has returned, so the callback must be done
+        DLIB_TEST(finished);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class timeout_tester : public tester
+    {
+    public:
+        timeout_tester (
+        ) :
+            tester ("test_timeout",
+                    "Runs tests on the timeout components.")
+        {}
+
+        void perform_test (
+        )
+        {
+            print_spinner();
+            test_shared_timeout_fires();
+            print_spinner();
+            test_shared_timeout_cancel();
+            print_spinner();
+            test_shared_timeout_many();
+            print_spinner();
+            test_shared_timeout_destructor_waits();
+        }
+    } a;
+
+}
+
@@ -0,0 +1,131 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dlib/timing.h>
+
+#include "tester.h"
+
+namespace
+{
+    using namespace test;
+    using namespace dlib;
+    using namespace std;
+
+    logger dlog("test.timing");
+
+    // use high slot numbers so we don't collide with any other test that might
+    // use the timing tools
+    const int slot_single = 470;
+    const int slot_threads = 471;
+    const int slot_scoped = 472;
+
+    const timing::stat* find_slot (
+        const std::vector<timing::stat>& stats,
+        int slot
+    )
+    {
+        for (unsigned long i = 0; i < stats.size(); ++i)
+        {
+            if (stats[i].slot == slot)
+                return &stats[i];
+        }
+        return 0;
+    }
+
+    void test_single_thread_stats()
+    {
+        // record the values 1 to 1000, once each
+        for (uint64_t i = 1; i <= 1000; ++i)
+            timing::record(slot_single, "single thread samples", i);
+
+        const std::vector<timing::stat> stats = timing::get_stats();
+        const timing::stat* s = find_slot(stats, slot_single);
+        DLIB_TEST(s != 0);
+        DLIB_TEST(s->name == "single thread samples");
+        DLIB_TEST(s->count == 1000);
+        DLIB_TEST(s->total_time == 1000*1001/2);
+        DLIB_TEST(s->min_time == 1);
+        DLIB_TEST(s->max_time == 1000);
+        DLIB_TEST(std::abs(s->mean() - 500.5) < 1e-10);
+
+        // the percentiles come from a log scaled histogram so they are
+        // estimates, but they must be monotonic and inside the observed range.
+        const double p50 = s->percentile(50);
+        const double p90 = s->percentile(90);
+        const double p99 = s->percentile(99);
+        dlog << LINFO << "p50: " << p50 << "  p90: " << p90 << "  p99: " << p99;
+        DLIB_TEST(s->min_time <= p50 && p50 <= s->max_time);
+        DLIB_TEST(p50 <= p90);
+        DLIB_TEST(p90 <= p99);
+        DLIB_TEST(p99 <= s->max_time);
+    }
+
+    void test_multi_thread_stats()
+    {
+        // have 4 threads record 1000 samples each, all with the same value, and
+        // make sure they all show up in the merged results
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([]()
+            {
+                for (int i = 0; i < 1000; ++i)
+                    timing::record(slot_threads, "multi thread samples", 5000);
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+
+        const std::vector<timing::stat> stats = timing::get_stats();
+        const timing::stat* s = find_slot(stats, slot_threads);
+        DLIB_TEST(s != 0);
+        DLIB_TEST(s->count == 4000);
+        DLIB_TEST(s->total_time == 4000ull*5000);
+        DLIB_TEST(s->min_time == 5000);
+        DLIB_TEST(s->max_time == 5000);
+        // every sample has the same value so every percentile must be that value
+        DLIB_TEST(s->percentile(50) == 5000);
+        DLIB_TEST(s->percentile(99) == 5000);
+    }
+
+    void test_scoped_timer()
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            timing::scoped_timer t(slot_scoped, "scoped timer");
+        }
+
+        const std::vector<timing::stat> stats = timing::get_stats();
+        const timing::stat* s = find_slot(stats, slot_scoped);
+        DLIB_TEST(s != 0);
+        DLIB_TEST(s->name == "scoped timer");
+        DLIB_TEST(s->count == 10);
+        DLIB_TEST(s->max_time >= s->min_time);
+        DLIB_TEST(s->total_time >= s->max_time);
+    }
+
+    class test_timing : public tester
+    {
+    public:
+        test_timing (
+        ) :
+            tester ("test_timing",
+                    "Runs tests on the timing instrumentation tools.")
+        {}
+
+        void perform_test (
+        )
+        {
+            test_single_thread_stats();
+            print_spinner();
+            test_multi_thread_stats();
+            print_spinner();
+            test_scoped_timer();
+        }
+    } a;
+
+}
@@ -1,15 +1,19 @@
 // Copyright (C) 2016  Davis E. King (davis@dlib.net)
 // License: Boost Software License   See LICENSE.txt for the full license.
 #ifndef DLIB_AsYNC_CPP_
-#define DLIB_AsYNC_CPP_ 
+#define DLIB_AsYNC_CPP_
 
-// C++11 things don't work in old versions of visual studio 
+// C++11 things don't work in old versions of visual studio
 #if !defined( _MSC_VER) ||  _MSC_VER >= 1900
 
 #include "async.h"
 #include <stdlib.h>
 #include "../string.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace dlib
 {
@@ -28,14 +32,81 @@ namespace dlib
             } catch(string_cast_error&) {}
             return std::thread::hardware_concurrency();
         }
+
+        unsigned long default_num_threads(
+            task_priority priority
+        )
+        {
+            // The latency critical lane defaults to a small dedicated pool so that
+            // real-time tasks never queue behind machine-wide batch work running in the
+            // other lanes.  The other lanes default to using the whole machine.
+            if (priority == task_priority::latency_critical)
+                return std::max(1u, std::thread::hardware_concurrency()/4);
+            return default_num_threads();
+        }
+
+        struct default_pool_lanes
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This holds the global thread pools returned by default_thread_pool().
+                    Each task_priority gets its own lazily constructed pool so tasks in
+                    one lane never wait in line behind tasks from another lane.
+            !*/
+            std::mutex m;
+            std::shared_ptr<thread_pool> pools[3];
+
+            // Pools replaced by set_default_thread_pool_size() get parked here rather
+            // than destructed.  This keeps thread_pool references previously handed out
+            // by default_thread_pool() valid and lets any tasks still queued on the old
+            // pool run to completion.  Everything is torn down at program exit.
+            std::vector<std::shared_ptr<thread_pool>> retired;
+        };
+
+        default_pool_lanes& get_default_pool_lanes()
+        {
+            static default_pool_lanes lanes;
+            return lanes;
+        }
     }
 
 // ----------------------------------------------------------------------------------------
 
+    thread_pool& default_thread_pool(task_priority priority)
+    {
+        auto& lanes = impl::get_default_pool_lanes();
+        std::lock_guard<std::mutex> lock(lanes.m);
+        auto& pool = lanes.pools[static_cast<int>(priority)];
+        // Use the work stealing scheduler since the default pools mostly run lots of
+        // small tasks from dlib::async() and parallel_for() and the per-worker deques
+        // scale much better than the shared task list on high core count machines.
+        if (!pool)
+            pool = std::make_shared<thread_pool>(impl::default_num_threads(priority), true);
+        return *pool;
+    }
+
     thread_pool& default_thread_pool()
     {
-        static thread_pool tp(impl::default_num_threads());
-        return tp;
+        return default_thread_pool(task_priority::normal);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void set_default_thread_pool_size(task_priority priority, unsigned long num_threads)
+    {
+        auto& lanes = impl::get_default_pool_lanes();
+        std::lock_guard<std::mutex> lock(lanes.m);
+        auto& pool = lanes.pools[static_cast<int>(priority)];
+        if (pool && pool->num_threads_in_pool() == num_threads)
+            return;
+        if (pool)
+            lanes.retired.push_back(pool);
+        pool = std::make_shared<thread_pool>(num_threads, true);
+    }
+
+    void set_default_thread_pool_size(unsigned long num_threads)
+    {
+        set_default_thread_pool_size(task_priority::normal, num_threads);
     }
 }
 
@@ -45,4 +116,3 @@ namespace dlib
 
 #endif // DLIB_AsYNC_CPP_
 
-
@@ -10,6 +10,11 @@
 #include "thread_pool_extension.h"
 #include <future>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
 
 namespace dlib
 {
@@ -40,11 +45,184 @@ namespace dlib
             fun();
             prom.set_value();
         }
+
+    // ------------------------------------------------------------------------------------
+
+        template <typename T>
+        struct cf_state
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is the shared state behind a continuation_future.  It is like the
+                    state behind a std::future except that callbacks can be attached to
+                    it.  They run as soon as the state becomes ready, which is what lets
+                    then() chain work without ever parking a thread in a blocking wait.
+            !*/
+
+            std::mutex m;
+            std::condition_variable cv;
+            bool ready = false;
+            std::exception_ptr eptr;
+            std::unique_ptr<T> value;
+            std::vector<std::function<void()>> continuations;
+
+            void set_value(T v)
+            {
+                std::vector<std::function<void()>> conts;
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    value.reset(new T(std::move(v)));
+                    ready = true;
+                    conts.swap(continuations);
+                }
+                cv.notify_all();
+                for (auto& c : conts)
+                    c();
+            }
+
+            void set_exception(std::exception_ptr e)
+            {
+                std::vector<std::function<void()>> conts;
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    eptr = e;
+                    ready = true;
+                    conts.swap(continuations);
+                }
+                cv.notify_all();
+                for (auto& c : conts)
+                    c();
+            }
+
+            void add_continuation(std::function<void()> cont)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    if (!ready)
+                    {
+                        continuations.push_back(std::move(cont));
+                        return;
+                    }
+                }
+                // The state was already ready, so just run the continuation now.
+                cont();
+            }
+
+            bool is_ready()
+            {
+                std::lock_guard<std::mutex> lock(m);
+                return ready;
+            }
+
+            void wait()
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [&]{ return ready; });
+            }
+        };
+
+        template <>
+        struct cf_state<void>
+        {
+            std::mutex m;
+            std::condition_variable cv;
+            bool ready = false;
+            std::exception_ptr eptr;
+            std::vector<std::function<void()>> continuations;
+
+            void set_value()
+            {
+                std::vector<std::function<void()>> conts;
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    ready = true;
+                    conts.swap(continuations);
+                }
+                cv.notify_all();
+                for (auto& c : conts)
+                    c();
+            }
+
+            void set_exception(std::exception_ptr e)
+            {
+                std::vector<std::function<void()>> conts;
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    eptr = e;
+                    ready = true;
+                    conts.swap(continuations);
+                }
+                cv.notify_all();
+                for (auto& c : conts)
+                    c();
+            }
+
+            void add_continuation(std::function<void()> cont)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    if (!ready)
+                    {
+                        continuations.push_back(std::move(cont));
+                        return;
+                    }
+                }
+                cont();
+            }
+
+            bool is_ready()
+            {
+                std::lock_guard<std::mutex> lock(m);
+                return ready;
+            }
+
+            void wait()
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [&]{ return ready; });
+            }
+        };
+
+    // ------------------------------------------------------------------------------------
+
+        template <typename S, typename U, typename V>
+        void call_state_set_value(
+            S& st,
+            U& fun,
+            selector<V>
+        )
+        {
+            st.set_value(fun());
+        }
+
+        template <typename S, typename U>
+        void call_state_set_value(
+            S& st,
+            U& fun,
+            selector<void>
+        )
+        {
+            fun();
+            st.set_value();
+        }
     }
 
+// ----------------------------------------------------------------------------------------
+
+    enum class task_priority
+    {
+        background,
+        normal,
+        latency_critical
+    };
+
 // ----------------------------------------------------------------------------------------
 
     thread_pool& default_thread_pool();
+    thread_pool& default_thread_pool(task_priority priority);
+
+    void set_default_thread_pool_size(unsigned long num_threads);
+    void set_default_thread_pool_size(task_priority priority, unsigned long num_threads);
 
 // ----------------------------------------------------------------------------------------
 
@@ -90,6 +268,408 @@ namespace dlib
         return async(default_thread_pool(), std::forward<Function>(f), std::forward<Args>(args)...);
     }
 
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename Function,
+        typename ...Args
+        >
+    std::future<typename std::result_of<Function(Args...)>::type> async(
+        task_priority priority,
+        Function&& f,
+        Args&&... args
+    )
+    {
+        return async(default_thread_pool(priority), std::forward<Function>(f), std::forward<Args>(args)...);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T> class continuation_future;
+
+    template <
+        typename Function,
+        typename ...Args
+        >
+    continuation_future<typename std::result_of<Function(Args...)>::type> async_continuable(
+        thread_pool& tp,
+        Function&& f,
+        Args&&... args
+    );
+
+    template <typename T>
+    continuation_future<std::vector<T>> when_all(
+        std::vector<continuation_future<T>> futures
+    );
+
+    continuation_future<void> when_all(
+        std::vector<continuation_future<void>> futures
+    );
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T>
+    class continuation_future
+    {
+    public:
+
+        continuation_future() = default;
+
+        bool valid() const { return state != nullptr; }
+
+        bool is_ready() const { return valid() && state->is_ready(); }
+
+        void wait() const
+        {
+            DLIB_ASSERT(valid(),
+                "\t void continuation_future::wait()"
+                << "\n\t You can't wait on an invalid future."
+                );
+            state->wait();
+        }
+
+        const T& get() const
+        {
+            wait();
+            if (state->eptr)
+                std::rethrow_exception(state->eptr);
+            return *state->value;
+        }
+
+        template <typename Function>
+        continuation_future<typename std::result_of<Function(const T&)>::type> then(
+            thread_pool& tp,
+            Function&& f
+        )
+        {
+            typedef typename std::result_of<Function(const T&)>::type result_type;
+            DLIB_ASSERT(valid(),
+                "\t continuation_future continuation_future::then()"
+                << "\n\t You can't attach a continuation to an invalid future."
+                );
+
+            auto prev = state;
+            auto next = std::make_shared<impl::cf_state<result_type>>();
+            auto fun = std::make_shared<typename std::decay<Function>::type>(std::forward<Function>(f));
+            thread_pool* pool = &tp;
+            // Once this future becomes ready the continuation gets queued on the pool
+            // like any other task.  No thread ever blocks waiting for the handoff.
+            prev->add_continuation([prev, next, fun, pool]()
+            {
+                pool->add_task_by_value([prev, next, fun]()
+                {
+                    if (prev->eptr)
+                    {
+                        next->set_exception(prev->eptr);
+                        return;
+                    }
+                    try
+                    {
+                        const T& val = *prev->value;
+                        auto call = [&]() { return (*fun)(val); };
+                        impl::call_state_set_value(*next, call, impl::selector<result_type>());
+                    }
+                    catch(...)
+                    {
+                        next->set_exception(std::current_exception());
+                    }
+                });
+            });
+            return continuation_future<result_type>(next);
+        }
+
+        template <typename Function>
+        continuation_future<typename std::result_of<Function(const T&)>::type> then(
+            Function&& f
+        )
+        {
+            return then(default_thread_pool(), std::forward<Function>(f));
+        }
+
+        template <typename Function>
+        continuation_future<typename std::result_of<Function(const T&)>::type> then(
+            task_priority priority,
+            Function&& f
+        )
+        {
+            return then(default_thread_pool(priority), std::forward<Function>(f));
+        }
+
+    private:
+
+        template <typename U> friend class continuation_future;
+
+        template <typename Function, typename ...Args>
+        friend continuation_future<typename std::result_of<Function(Args...)>::type> async_continuable(
+            thread_pool& tp, Function&& f, Args&&... args);
+
+        template <typename U>
+        friend continuation_future<std::vector<U>> when_all(std::vector<continuation_future<U>> futures);
+
+        friend continuation_future<void> when_all(std::vector<continuation_future<void>> futures);
+
+        explicit continuation_future(std::shared_ptr<impl::cf_state<T>> state_) : state(std::move(state_)) {}
+
+        std::shared_ptr<impl::cf_state<T>> state;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <>
+    class continuation_future<void>
+    {
+    public:
+
+        continuation_future() = default;
+
+        bool valid() const { return state != nullptr; }
+
+        bool is_ready() const { return valid() && state->is_ready(); }
+
+        void wait() const
+        {
+            DLIB_ASSERT(valid(),
+                "\t void continuation_future::wait()"
+                << "\n\t You can't wait on an invalid future."
+                );
+            state->wait();
+        }
+
+        void get() const
+        {
+            wait();
+            if (state->eptr)
+                std::rethrow_exception(state->eptr);
+        }
+
+        template <typename Function>
+        continuation_future<typename std::result_of<Function()>::type> then(
+            thread_pool& tp,
+            Function&& f
+        )
+        {
+            typedef typename std::result_of<Function()>::type result_type;
+            DLIB_ASSERT(valid(),
+                "\t continuation_future continuation_future::then()"
+                << "\n\t You can't attach a continuation to an invalid future."
+                );
+
+            auto prev = state;
+            auto next = std::make_shared<impl::cf_state<result_type>>();
+            auto fun = std::make_shared<typename std::decay<Function>::type>(std::forward<Function>(f));
+            thread_pool* pool = &tp;
+            prev->add_continuation([prev, next, fun, pool]()
+            {
+                pool->add_task_by_value([prev, next, fun]()
+                {
+                    if (prev->eptr)
+                    {
+                        next->set_exception(prev->eptr);
+                        return;
+                    }
+                    try
+                    {
+                        impl::call_state_set_value(*next, *fun, impl::selector<result_type>());
+                    }
+                    catch(...)
+                    {
+                        next->set_exception(std::current_exception());
+                    }
+                });
+            });
+            return continuation_future<result_type>(next);
+        }
+
+        template <typename Function>
+        continuation_future<typename std::result_of<Function()>::type> then(
+            Function&& f
+        )
+        {
+            return then(default_thread_pool(), std::forward<Function>(f));
+        }
+
+        template <typename Function>
+        continuation_future<typename std::result_of<Function()>::type> then(
+            task_priority priority,
+            Function&& f
+        )
+        {
+            return then(default_thread_pool(priority), std::forward<Function>(f));
+        }
+
+    private:
+
+        template <typename U> friend class continuation_future;
+
+        template <typename Function, typename ...Args>
+        friend continuation_future<typename std::result_of<Function(Args...)>::type> async_continuable(
+            thread_pool& tp, Function&& f, Args&&... args);
+
+        template <typename U>
+        friend continuation_future<std::vector<U>> when_all(std::vector<continuation_future<U>> futures);
+
+        friend continuation_future<void> when_all(std::vector<continuation_future<void>> futures);
+
+        explicit continuation_future(std::shared_ptr<impl::cf_state<void>> state_) : state(std::move(state_)) {}
+
+        std::shared_ptr<impl::cf_state<void>> state;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename Function,
+        typename ...Args
+        >
+    continuation_future<typename std::result_of<Function(Args...)>::type> async_continuable(
+        thread_pool& tp,
+        Function&& f,
+        Args&&... args
+    )
+    {
+        typedef typename std::result_of<Function(Args...)>::type result_type;
+        auto st = std::make_shared<impl::cf_state<result_type>>();
+        using bind_t = decltype(std::bind(std::forward<Function>(f), std::forward<Args>(args)...));
+        auto fun = std::make_shared<bind_t>(std::bind(std::forward<Function>(f), std::forward<Args>(args)...));
+        tp.add_task_by_value([fun, st]()
+        {
+            try
+            {
+                impl::call_state_set_value(*st, *fun, impl::selector<result_type>());
+            }
+            catch(...)
+            {
+                st->set_exception(std::current_exception());
+            }
+        });
+        return continuation_future<result_type>(st);
+    }
+
+    template <
+        typename Function,
+        typename ...Args
+        >
+    continuation_future<typename std::result_of<Function(Args...)>::type> async_continuable(
+        Function&& f,
+        Args&&... args
+    )
+    {
+        return async_continuable(default_thread_pool(), std::forward<Function>(f), std::forward<Args>(args)...);
+    }
+
+    template <
+        typename Function,
+        typename ...Args
+        >
+    continuation_future<typename std::result_of<Function(Args...)>::type> async_continuable(
+        task_priority priority,
+        Function&& f,
+        Args&&... args
+    )
+    {
+        return async_continuable(default_thread_pool(priority), std::forward<Function>(f), std::forward<Args>(args)...);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T>
+    continuation_future<std::vector<T>> when_all(
+        std::vector<continuation_future<T>> futures
+    )
+    {
+        auto next = std::make_shared<impl::cf_state<std::vector<T>>>();
+        auto states = std::make_shared<std::vector<std::shared_ptr<impl::cf_state<T>>>>();
+        states->reserve(futures.size());
+        for (auto& f : futures)
+        {
+            DLIB_ASSERT(f.valid(),
+                "\t continuation_future when_all()"
+                << "\n\t All the given futures must be valid."
+                );
+            states->push_back(f.state);
+        }
+
+        if (states->empty())
+        {
+            next->set_value(std::vector<T>());
+            return continuation_future<std::vector<T>>(next);
+        }
+
+        // The last future to become ready gathers all the results.  Nothing blocks.
+        auto remaining = std::make_shared<std::atomic<long>>((long)states->size());
+        auto finish = [states, next]()
+        {
+            for (auto& st : *states)
+            {
+                if (st->eptr)
+                {
+                    next->set_exception(st->eptr);
+                    return;
+                }
+            }
+            std::vector<T> vals;
+            vals.reserve(states->size());
+            for (auto& st : *states)
+                vals.push_back(*st->value);
+            next->set_value(std::move(vals));
+        };
+        for (auto& st : *states)
+        {
+            st->add_continuation([remaining, finish]()
+            {
+                if (--(*remaining) == 0)
+                    finish();
+            });
+        }
+        return continuation_future<std::vector<T>>(next);
+    }
+
+    inline continuation_future<void> when_all(
+        std::vector<continuation_future<void>> futures
+    )
+    {
+        auto next = std::make_shared<impl::cf_state<void>>();
+        auto states = std::make_shared<std::vector<std::shared_ptr<impl::cf_state<void>>>>();
+        states->reserve(futures.size());
+        for (auto& f : futures)
+        {
+            DLIB_ASSERT(f.valid(),
+                "\t continuation_future when_all()"
+                << "\n\t All the given futures must be valid."
+                );
+            states->push_back(f.state);
+        }
+
+        if (states->empty())
+        {
+            next->set_value();
+            return continuation_future<void>(next);
+        }
+
+        auto remaining = std::make_shared<std::atomic<long>>((long)states->size());
+        auto finish = [states, next]()
+        {
+            for (auto& st : *states)
+            {
+                if (st->eptr)
+                {
+                    next->set_exception(st->eptr);
+                    return;
+                }
+            }
+            next->set_value();
+        };
+        for (auto& st : *states)
+        {
+            st->add_continuation([remaining, finish]()
+            {
+                if (--(*remaining) == 0)
+                    finish();
+            });
+        }
+        return continuation_future<void>(next);
+    }
+
 }
 
 // ----------------------------------------------------------------------------------------
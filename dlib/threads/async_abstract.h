@@ -10,16 +10,81 @@
 namespace dlib
 {
 
+// ----------------------------------------------------------------------------------------
+
+    enum class task_priority
+    {
+        background,
+        normal,
+        latency_critical
+    };
+    /*!
+        WHAT THIS OBJECT REPRESENTS
+            This enum names the lanes of global thread pools used by dlib::async().
+            Each lane is an independent thread_pool, so queuing a lot of long running
+            work on the background lane can't delay tasks submitted to the
+            latency_critical lane.  Use background for batch jobs like training steps,
+            normal for everything else, and latency_critical for small tasks that must
+            start promptly, e.g. running a detector on a live video frame.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
     thread_pool& default_thread_pool(
     );
     /*!
         ensures
-            - returns a reference to a global thread_pool.  If the DLIB_NUM_THREADS
-              environment variable is set to an integer then the thread pool will contain
-              DLIB_NUM_THREADS threads, otherwise it will contain
-              std::thread::hardware_concurrency() threads.
+            - returns default_thread_pool(task_priority::normal)
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    thread_pool& default_thread_pool(
+        task_priority priority
+    );
+    /*!
+        ensures
+            - returns a reference to the global thread_pool for the given priority lane.
+              Each lane's pool is created the first time it is asked for.
+            - For the normal and background lanes: if the DLIB_NUM_THREADS environment
+              variable is set to an integer then the pool will contain DLIB_NUM_THREADS
+              threads, otherwise it will contain std::thread::hardware_concurrency()
+              threads.
+            - For the latency_critical lane: the pool will contain
+              max(1,std::thread::hardware_concurrency()/4) threads.  The idea is that
+              this lane is a small reserve of workers that stays responsive even when
+              the other lanes have saturated the machine.
+            - In all cases you can override these defaults by calling
+              set_default_thread_pool_size().
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    void set_default_thread_pool_size(
+        unsigned long num_threads
+    );
+    /*!
+        ensures
+            - performs set_default_thread_pool_size(task_priority::normal, num_threads)
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    void set_default_thread_pool_size(
+        task_priority priority,
+        unsigned long num_threads
+    );
+    /*!
+        ensures
+            - #default_thread_pool(priority).num_threads_in_pool() == num_threads
+            - If the lane's pool already exists and has a different number of threads
+              then it is replaced by a new pool.  This call does not block on work
+              queued in the old pool.  Instead, the old pool is kept alive until
+              program exit, so tasks already submitted to it still run to completion
+              and thread_pool references previously returned by default_thread_pool()
+              remain valid.  Only tasks submitted after this call see the new size.
+            - Note that a num_threads of 0 is allowed and causes tasks sent to that
+              lane to simply run in the calling thread.
     !*/
 
 // ----------------------------------------------------------------------------------------
@@ -59,6 +124,231 @@ namespace dlib
         ensures
             - Calling this function is equivalent to directly calling async(default_thread_pool(), f, args...)
     !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename Function,
+        typename ...Args
+        >
+    std::future<typename std::result_of<Function(Args...)>::type> async(
+        task_priority priority,
+        Function&& f,
+        Args&&... args
+    );
+    /*!
+        ensures
+            - Calling this function is equivalent to directly calling async(default_thread_pool(priority), f, args...)
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    class continuation_future
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object is a future, like std::future, except that additional work
+                can be chained onto it with then().  A continuation submitted via
+                then() is queued onto a thread_pool the moment the future becomes
+                ready, so a pipeline of dependent stages (e.g. decode, then build a
+                pyramid, then run a detector) executes entirely on the pool without
+                any thread ever blocking in get() between stages.
+
+                Unlike std::future, this future has shared semantics.  get() returns a
+                const reference to the stored value, it can be called any number of
+                times, and any number of continuations can be attached to the same
+                future.  Copies of a continuation_future all refer to the same shared
+                state.
+
+                THREAD SAFETY
+                    It is safe for multiple threads to call get(), wait(), is_ready(),
+                    and then() on the same underlying state concurrently, e.g. via
+                    copies of the same future.
+
+            SPECIALIZATIONS
+                continuation_future<void> works the same way except that get() returns
+                nothing and continuations take no argument.
+        !*/
+    public:
+
+        continuation_future(
+        ) = default;
+        /*!
+            ensures
+                - #valid() == false
+        !*/
+
+        bool valid(
+        ) const;
+        /*!
+            ensures
+                - returns true if this future refers to a shared state, i.e. if it was
+                  produced by async_continuable(), then(), or when_all().  Otherwise
+                  returns false.
+        !*/
+
+        bool is_ready(
+        ) const;
+        /*!
+            ensures
+                - returns true if valid() and the result (or an exception) is already
+                  available, i.e. if get() would return without blocking.
+        !*/
+
+        void wait(
+        ) const;
+        /*!
+            requires
+                - valid() == true
+            ensures
+                - blocks until is_ready() == true.
+        !*/
+
+        const T& get(
+        ) const;
+        /*!
+            requires
+                - valid() == true
+            ensures
+                - performs wait() and then returns a const reference to the stored
+                  result.  The reference stays valid for the lifetime of the shared
+                  state, i.e. as long as any future or continuation refers to it.
+            throws
+                - If the task that computes this future's value threw an exception
+                  then that exception is rethrown here.
+        !*/
+
+        template <typename Function>
+        continuation_future<typename std::result_of<Function(const T&)>::type> then(
+            thread_pool& tp,
+            Function&& f
+        );
+        /*!
+            requires
+                - valid() == true
+                - f(get()) must be a valid expression.
+                - tp must remain alive until the continuation has run.
+            ensures
+                - returns a future representing the result of calling f on this
+                  future's value.  The call f(get()) is submitted to tp as a normal
+                  thread_pool task as soon as this future becomes ready (immediately,
+                  if it is ready already).  No thread blocks waiting for the handoff.
+                - If this future finishes with an exception then f is never called and
+                  the exception propagates to the returned future instead.  Likewise,
+                  if f itself throws then the exception is stored in the returned
+                  future and rethrown by its get().
+        !*/
+
+        template <typename Function>
+        continuation_future<typename std::result_of<Function(const T&)>::type> then(
+            Function&& f
+        );
+        /*!
+            ensures
+                - Calling this function is equivalent to directly calling
+                  then(default_thread_pool(), f)
+        !*/
+
+        template <typename Function>
+        continuation_future<typename std::result_of<Function(const T&)>::type> then(
+            task_priority priority,
+            Function&& f
+        );
+        /*!
+            ensures
+                - Calling this function is equivalent to directly calling
+                  then(default_thread_pool(priority), f)
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename Function,
+        typename ...Args
+        >
+    continuation_future<typename std::result_of<Function(Args...)>::type> async_continuable(
+        thread_pool& tp,
+        Function&& f,
+        Args&&... args
+    );
+    /*!
+        requires
+            - f must be a function and f(args...) must be a valid expression.
+        ensures
+            - This function behaves just like async(tp, f, args...) except that it
+              returns a continuation_future instead of a std::future, so further
+              stages can be chained onto the result with then() rather than having to
+              block in get() between them.  The task is an ordinary thread_pool task,
+              so tp.wait_for_all_tasks() accounts for it just like tasks submitted any
+              other way.
+    !*/
+
+    template <
+        typename Function,
+        typename ...Args
+        >
+    continuation_future<typename std::result_of<Function(Args...)>::type> async_continuable(
+        Function&& f,
+        Args&&... args
+    );
+    /*!
+        ensures
+            - Calling this function is equivalent to directly calling
+              async_continuable(default_thread_pool(), f, args...)
+    !*/
+
+    template <
+        typename Function,
+        typename ...Args
+        >
+    continuation_future<typename std::result_of<Function(Args...)>::type> async_continuable(
+        task_priority priority,
+        Function&& f,
+        Args&&... args
+    );
+    /*!
+        ensures
+            - Calling this function is equivalent to directly calling
+              async_continuable(default_thread_pool(priority), f, args...)
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename T
+        >
+    continuation_future<std::vector<T>> when_all(
+        std::vector<continuation_future<T>> futures
+    );
+    /*!
+        requires
+            - for all valid i: futures[i].valid() == true
+        ensures
+            - returns a future that becomes ready once all the given futures are
+              ready.  Its value is a std::vector containing the values of the given
+              futures, in the same order they were given.  The bookkeeping is done by
+              the tasks that complete the given futures, so no thread blocks waiting
+              for stragglers.
+            - If any of the given futures finishes with an exception then the first
+              such exception (in the order the futures were given) propagates to the
+              returned future instead of a value.
+            - An empty futures vector yields a future that is immediately ready with
+              an empty vector.
+    !*/
+
+    continuation_future<void> when_all(
+        std::vector<continuation_future<void>> futures
+    );
+    /*!
+        ensures
+            - Identical to the when_all() overload above except that the given futures
+              carry no values, so the returned future is simply a void future that
+              becomes ready once all of them are ready.
+    !*/
 }
 
 // ----------------------------------------------------------------------------------------
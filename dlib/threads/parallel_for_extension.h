@@ -8,6 +8,18 @@
 #include "../console_progress_indicator.h"
 #include "async.h"
 
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if !defined(WIN32) && defined(__linux__)
+#include <pthread.h>
+#endif
+
 namespace dlib
 {
 
@@ -668,6 +680,264 @@ namespace dlib
         parallel_for_blocked(begin, end, helper, chunks_per_thread);
     }
 
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+
+    namespace impl
+    {
+        inline void bind_current_thread_to_core (
+            unsigned long core
+        )
+        /*!
+            ensures
+                - if the platform supports thread affinity then the calling thread is
+                  bound to the given cpu core, otherwise this function does nothing.
+        !*/
+        {
+#ifdef WIN32
+            SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << (core%64));
+#elif defined(__linux__)
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(core % CPU_SETSIZE, &cpus);
+            pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#else
+            (void)core;
+#endif
+        }
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class pinned_thread_pool : noncopyable
+    {
+        /*!
+            INITIAL VALUE
+                - workers.size() == the number of threads given to the constructor
+                - shutting_down == false
+                - epoch == 0
+                - num_running == 0
+
+            CONVENTION
+                - num_threads_in_pool() == workers.size()
+                - worker i is bound to cpu core i%hardware_concurrency and, for every
+                  job, always processes the i-th contiguous chunk of the given range.
+                - epoch is incremented each time a new job is posted.  Workers run the
+                  current job exactly once by comparing epoch against the last value
+                  they saw.  num_running counts the workers that haven't finished the
+                  current job yet.
+                - all the shared job state (job, job_begin, job_end, epoch,
+                  num_running, eptr, shutting_down) is protected by m.
+        !*/
+    public:
+
+        explicit pinned_thread_pool (
+            unsigned long num_threads = std::thread::hardware_concurrency()
+        ) :
+            thread_count(num_threads),
+            shutting_down(false),
+            job_begin(0),
+            job_end(0),
+            epoch(0),
+            num_running(0)
+        {
+            workers.reserve(num_threads);
+            for (unsigned long i = 0; i < num_threads; ++i)
+                workers.emplace_back(&pinned_thread_pool::thread_proc, this, i);
+        }
+
+        ~pinned_thread_pool (
+        )
+        {
+            {
+                std::lock_guard<std::mutex> lock(m);
+                shutting_down = true;
+            }
+            job_ready.notify_all();
+            for (auto& t : workers)
+                t.join();
+        }
+
+        unsigned long num_threads_in_pool (
+        ) const { return thread_count; }
+
+        template <typename T>
+        void run_blocked (
+            long begin,
+            long end,
+            const T& funct
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(begin <= end,
+                "\t void pinned_thread_pool::run_blocked()"
+                << "\n\t Invalid inputs were given to this function"
+                << "\n\t begin: " << begin
+                << "\n\t end:   " << end
+                );
+
+            if (begin == end)
+                return;
+
+            // Like the other parallel for routines, having no threads in the pool
+            // means we just run the function directly.
+            if (thread_count == 0)
+            {
+                funct(begin, end);
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(m);
+            job = [&funct](long b, long e) { funct(b,e); };
+            job_begin = begin;
+            job_end = end;
+            num_running = thread_count;
+            ++epoch;
+            job_ready.notify_all();
+            job_done.wait(lock, [&]{ return num_running == 0; });
+            job = nullptr;
+            if (eptr)
+            {
+                std::exception_ptr e = eptr;
+                eptr = nullptr;
+                std::rethrow_exception(e);
+            }
+        }
+
+    private:
+
+        void thread_proc (
+            unsigned long index
+        )
+        {
+            const unsigned long num_cores = std::max(1u, std::thread::hardware_concurrency());
+            impl::bind_current_thread_to_core(index%num_cores);
+
+            unsigned long last_epoch = 0;
+            while (true)
+            {
+                std::unique_lock<std::mutex> lock(m);
+                job_ready.wait(lock, [&]{ return shutting_down || epoch != last_epoch; });
+                if (shutting_down)
+                    return;
+                last_epoch = epoch;
+                const long begin = job_begin;
+                const long end = job_end;
+                std::function<void(long,long)> f = job;
+                lock.unlock();
+
+                // This worker always handles the index-th contiguous chunk of the
+                // range, so repeated passes over the same data see the same threads,
+                // and therefore the same cores, touching the same elements.
+                const long num = end-begin;
+                const long num_workers = thread_count;
+                const long chunk_begin = begin + (num*(long)index)/num_workers;
+                const long chunk_end   = begin + (num*(long)(index+1))/num_workers;
+                try
+                {
+                    if (chunk_begin < chunk_end)
+                        f(chunk_begin, chunk_end);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> elock(m);
+                    if (!eptr)
+                        eptr = std::current_exception();
+                }
+
+                lock.lock();
+                if (--num_running == 0)
+                    job_done.notify_all();
+            }
+        }
+
+        const unsigned long thread_count;
+        std::vector<std::thread> workers;
+        std::mutex m;
+        std::condition_variable job_ready;
+        std::condition_variable job_done;
+        std::function<void(long,long)> job;
+        bool shutting_down;
+        long job_begin;
+        long job_end;
+        unsigned long epoch;
+        unsigned long num_running;
+        std::exception_ptr eptr;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T>
+    void parallel_for_blocked (
+        pinned_thread_pool& tp,
+        long begin,
+        long end,
+        const T& funct
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT(begin <= end,
+            "\t void parallel_for_blocked()"
+            << "\n\t Invalid inputs were given to this function"
+            << "\n\t begin: " << begin
+            << "\n\t end:   " << end
+            );
+
+        tp.run_blocked(begin, end, funct);
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T>
+    void parallel_for (
+        pinned_thread_pool& tp,
+        long begin,
+        long end,
+        const T& funct
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT(begin <= end,
+            "\t void parallel_for()"
+            << "\n\t Invalid inputs were given to this function"
+            << "\n\t begin: " << begin
+            << "\n\t end:   " << end
+            );
+
+        tp.run_blocked(begin, end, [&funct](long b, long e)
+        {
+            for (long i = b; i < e; ++i)
+                funct(i);
+        });
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T>
+    void first_touch (
+        pinned_thread_pool& tp,
+        T* data,
+        long num
+    )
+    {
+        // make sure requires clause is not broken
+        DLIB_ASSERT(num >= 0 && (data != 0 || num == 0),
+            "\t void first_touch()"
+            << "\n\t Invalid inputs were given to this function"
+            << "\n\t data: " << data
+            << "\n\t num:  " << num
+            );
+
+        // Zero fill the array using the same partitioning parallel_for() with this
+        // pool uses.  On NUMA machines the OS places each page on the node of the
+        // core that first writes to it, so doing this right after allocation puts
+        // each chunk of the array next to the pinned worker that will process it.
+        tp.run_blocked(0, num, [data](long b, long e)
+        {
+            std::memset(data+b, 0, sizeof(T)*static_cast<unsigned long>(e-b));
+        });
+    }
+
 // ----------------------------------------------------------------------------------------
 
 }
@@ -460,6 +460,142 @@ namespace dlib
             - It will also use the default_thread_pool()
     !*/
 
+// ----------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------
+
+    class pinned_thread_pool : noncopyable
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This is a fixed partition thread pool for the parallel_for() and
+                parallel_for_blocked() overloads below.  Unlike the normal
+                thread_pool, which hands chunks of a loop to whichever worker happens
+                to be free, this pool binds each worker to a cpu core and always
+                gives worker i the i-th contiguous chunk of the loop's range.  So
+                when the same range is processed repeatedly, the same cores touch the
+                same elements every time.  On NUMA machines this keeps each chunk of
+                a big array in the memory node local to the core working on it,
+                which matters for bandwidth bound passes over arrays too big for
+                cache (see also first_touch() below).
+
+                On platforms without thread affinity support the workers are not
+                bound to cores but the fixed range partitioning still applies.
+
+            THREAD SAFETY
+                Only one thread may call run_blocked() (or the parallel_for()
+                overloads that use this pool) at a time.
+        !*/
+
+    public:
+
+        explicit pinned_thread_pool (
+            unsigned long num_threads = std::thread::hardware_concurrency()
+        );
+        /*!
+            ensures
+                - #num_threads_in_pool() == num_threads
+                - Worker i is bound to cpu core i%std::thread::hardware_concurrency().
+        !*/
+
+        ~pinned_thread_pool (
+        );
+        /*!
+            ensures
+                - blocks until the current job, if any, is finished and then destroys
+                  all the worker threads.
+        !*/
+
+        unsigned long num_threads_in_pool (
+        ) const;
+        /*!
+            ensures
+                - returns the number of worker threads in this pool.
+        !*/
+
+        template <typename T>
+        void run_blocked (
+            long begin,
+            long end,
+            const T& funct
+        );
+        /*!
+            requires
+                - begin <= end
+                - funct may be invoked as funct(a,b) where a and b are longs
+            ensures
+                - splits the range [begin, end) into num_threads_in_pool() contiguous
+                  chunks and has worker i call funct(a,b) on the i-th chunk, where
+                  [a,b) is that chunk's subrange.  Empty chunks are skipped.
+                - The chunk boundaries depend only on begin, end, and
+                  num_threads_in_pool(), so repeated calls over the same range always
+                  give the same elements to the same workers.
+                - if (num_threads_in_pool() == 0) then
+                    - simply calls funct(begin, end) in the calling thread.
+                - does not return until all the chunks have been processed.
+                - if one of the funct() calls throws then the first exception thrown
+                  is rethrown in the calling thread once all workers have finished.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T>
+    void parallel_for_blocked (
+        pinned_thread_pool& tp,
+        long begin,
+        long end,
+        const T& funct
+    );
+    /*!
+        requires
+            - begin <= end
+            - funct may be invoked as funct(a,b) where a and b are longs
+        ensures
+            - this is equivalent to calling tp.run_blocked(begin, end, funct).
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T>
+    void parallel_for (
+        pinned_thread_pool& tp,
+        long begin,
+        long end,
+        const T& funct
+    );
+    /*!
+        requires
+            - begin <= end
+            - funct may be invoked as funct(i) where i is a long
+        ensures
+            - calls funct(i) for all i in the range [begin, end), with the range
+              partitioned over tp's workers the way run_blocked() partitions it.
+            - does not return until all the iterations are finished.
+    !*/
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename T>
+    void first_touch (
+        pinned_thread_pool& tp,
+        T* data,
+        long num
+    );
+    /*!
+        requires
+            - T is trivially copyable
+            - data == a pointer to an array of at least num elements, or num == 0
+            - num >= 0
+        ensures
+            - zero fills data[0] through data[num-1], with the work partitioned over
+              tp's workers exactly the way parallel_for(tp, 0, num, ...) would
+              partition it.
+            - Call this on freshly allocated memory before processing it with tp.
+              Operating systems place each memory page on the NUMA node of the core
+              that first writes to it, so this puts every chunk of the array on the
+              node local to the pinned worker that will later process that chunk.
+    !*/
+
 // ----------------------------------------------------------------------------------------
 
 }
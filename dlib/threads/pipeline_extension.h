@@ -0,0 +1,292 @@
+// Copyright (C) 2016  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_PIPELINe_EXTENSION_
+#define DLIB_PIPELINe_EXTENSION_
+
+// C++11 things don't work in old versions of visual studio
+#if !defined( _MSC_VER) ||  _MSC_VER >= 1900
+
+#include "pipeline_extension_abstract.h"
+#include "../pipe.h"
+#include "../algs.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <typename item_type>
+    class pipeline : noncopyable
+    {
+        /*!
+            CONVENTION
+                - stages holds the configuration given by add_stage(), in order.
+                - if (running) then
+                    - pipes.size() == stages.size() and pipes[i] is stage i's input
+                      queue.
+                    - if (output_enabled) then out_pipe is the queue dequeue() reads
+                      and the last stage writes.  Otherwise the last stage discards
+                      its results.
+                    - threads holds one std::thread per stage worker, i.e.
+                      sum of stages[i].num_threads threads total.
+                - dropped_count == num_dropped()
+        !*/
+
+    public:
+
+        pipeline (
+        ) :
+            running(false),
+            output_enabled(false),
+            output_max_queue_size(0),
+            output_drop_oldest(false),
+            dropped_count(0)
+        {
+        }
+
+        ~pipeline (
+        )
+        {
+            stop();
+        }
+
+        void add_stage (
+            std::function<void(item_type&)> funct,
+            unsigned long num_threads = 1,
+            unsigned long max_queue_size = 1,
+            bool drop_oldest = false
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(!is_running() && num_threads > 0 && max_queue_size > 0,
+                "\t void pipeline::add_stage()"
+                << "\n\t invalid arguments to this function"
+                << "\n\t is_running():   " << is_running()
+                << "\n\t num_threads:    " << num_threads
+                << "\n\t max_queue_size: " << max_queue_size
+                );
+
+            stage_config temp;
+            temp.funct = std::move(funct);
+            temp.num_threads = num_threads;
+            temp.max_queue_size = max_queue_size;
+            temp.drop_oldest = drop_oldest;
+            stages.push_back(std::move(temp));
+        }
+
+        void enable_output (
+            unsigned long max_queue_size = 1,
+            bool drop_oldest = false
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(!is_running() && max_queue_size > 0,
+                "\t void pipeline::enable_output()"
+                << "\n\t invalid arguments to this function"
+                << "\n\t is_running():   " << is_running()
+                << "\n\t max_queue_size: " << max_queue_size
+                );
+
+            output_enabled = true;
+            output_max_queue_size = max_queue_size;
+            output_drop_oldest = drop_oldest;
+        }
+
+        unsigned long num_stages (
+        ) const { return stages.size(); }
+
+        bool is_running (
+        ) const { return running; }
+
+        unsigned long num_dropped (
+        ) const { return dropped_count; }
+
+        void start (
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(!is_running() && num_stages() > 0,
+                "\t void pipeline::start()"
+                << "\n\t invalid arguments to this function"
+                << "\n\t is_running(): " << is_running()
+                << "\n\t num_stages(): " << num_stages()
+                );
+
+            pipes.clear();
+            for (unsigned long i = 0; i < stages.size(); ++i)
+                pipes.push_back(std::unique_ptr<pipe_type>(new pipe_type(stages[i].max_queue_size)));
+            if (output_enabled)
+                out_pipe.reset(new pipe_type(output_max_queue_size));
+
+            running = true;
+            for (unsigned long i = 0; i < stages.size(); ++i)
+            {
+                for (unsigned long t = 0; t < stages[i].num_threads; ++t)
+                    threads.emplace_back([this,i]() { stage_worker(i); });
+            }
+        }
+
+        bool enqueue (
+            item_type& item
+        )
+        {
+            if (!running)
+                return false;
+            push(*pipes[0], stages[0].drop_oldest, item);
+            return true;
+        }
+
+        bool enqueue (
+            item_type&& item
+        )
+        {
+            return enqueue(item);
+        }
+
+        bool dequeue (
+            item_type& item
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(output_enabled,
+                "\t bool pipeline::dequeue()"
+                << "\n\t You can't read results from a pipeline without calling enable_output() first."
+                );
+
+            if (!out_pipe)
+                return false;
+            if (running)
+                return out_pipe->dequeue(item);
+            // After stop() we just hand out whatever finished results are left.
+            return out_pipe->dequeue_or_timeout(item, 0);
+        }
+
+        bool dequeue_or_timeout (
+            item_type& item,
+            unsigned long timeout
+        )
+        {
+            // make sure requires clause is not broken
+            DLIB_ASSERT(output_enabled,
+                "\t bool pipeline::dequeue_or_timeout()"
+                << "\n\t You can't read results from a pipeline without calling enable_output() first."
+                );
+
+            if (!out_pipe)
+                return false;
+            return out_pipe->dequeue_or_timeout(item, running ? timeout : 0);
+        }
+
+        void drain (
+        )
+        {
+            if (!running)
+                return;
+            // Wait for each stage, front to back, to finish everything that has been
+            // enqueued so far.  A stage is done once its input queue is empty and all
+            // its workers are parked in dequeue() again, which means every item it
+            // dequeued has already been handed to the next stage.
+            for (unsigned long i = 0; i < stages.size(); ++i)
+            {
+                pipes[i]->wait_until_empty();
+                pipes[i]->wait_for_num_blocked_dequeues(stages[i].num_threads);
+            }
+        }
+
+        void stop (
+        )
+        {
+            if (!running)
+                return;
+            running = false;
+            // Wake everything up.  Workers see their input queues go disabled and
+            // exit.  Items still sitting in the inter-stage queues are discarded,
+            // but anything already in the output queue stays available to dequeue().
+            for (unsigned long i = 0; i < pipes.size(); ++i)
+                pipes[i]->disable();
+            if (out_pipe)
+                out_pipe->disable_enqueue();
+            for (unsigned long i = 0; i < threads.size(); ++i)
+                threads[i].join();
+            threads.clear();
+            pipes.clear();
+        }
+
+    private:
+
+        typedef dlib::pipe<item_type> pipe_type;
+
+        struct stage_config
+        {
+            std::function<void(item_type&)> funct;
+            unsigned long num_threads;
+            unsigned long max_queue_size;
+            bool drop_oldest;
+        };
+
+        void push (
+            pipe_type& dest,
+            bool drop_oldest,
+            item_type& item
+        )
+        /*!
+            ensures
+                - moves item into dest.  If drop_oldest is false this blocks until
+                  there is room (i.e. normal backpressure).  Otherwise it makes room
+                  by throwing away the oldest queued item, counting each one thrown
+                  away in dropped_count.
+        !*/
+        {
+            if (!drop_oldest)
+            {
+                dest.enqueue(item);
+                return;
+            }
+            while (dest.is_enqueue_enabled())
+            {
+                if (dest.enqueue_or_timeout(item, 0))
+                    return;
+                item_type junk;
+                if (dest.dequeue_or_timeout(junk, 0))
+                    ++dropped_count;
+            }
+        }
+
+        void stage_worker (
+            unsigned long i
+        )
+        {
+            item_type item;
+            while (pipes[i]->dequeue(item))
+            {
+                stages[i].funct(item);
+                if (i+1 < stages.size())
+                    push(*pipes[i+1], stages[i+1].drop_oldest, item);
+                else if (out_pipe)
+                    push(*out_pipe, output_drop_oldest, item);
+            }
+        }
+
+        std::vector<stage_config> stages;
+        std::vector<std::unique_ptr<pipe_type>> pipes;
+        std::unique_ptr<pipe_type> out_pipe;
+        std::vector<std::thread> threads;
+
+        std::atomic<bool> running;
+        bool output_enabled;
+        unsigned long output_max_queue_size;
+        bool output_drop_oldest;
+        std::atomic<unsigned long> dropped_count;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif
+#endif // DLIB_PIPELINe_EXTENSION_
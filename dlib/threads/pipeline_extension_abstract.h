@@ -0,0 +1,225 @@
+// Copyright (C) 2016  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_PIPELINe_EXTENSION_ABSTRACT_
+#ifdef DLIB_PIPELINe_EXTENSION_ABSTRACT_
+
+#include "../pipe/pipe_kernel_abstract.h"
+#include <functional>
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    template <
+        typename item_type
+        >
+    class pipeline : noncopyable
+    {
+        /*!
+            REQUIREMENTS ON item_type
+                item_type must be default constructable and swappable by the global
+                swap(), just like the type stored in a dlib::pipe.
+
+            INITIAL VALUE
+                - num_stages() == 0
+                - is_running() == false
+                - num_dropped() == 0
+
+            WHAT THIS OBJECT REPRESENTS
+                This object is a multi-stage processing pipeline for streams of items,
+                e.g. video frames.  You describe the pipeline as a sequence of stages,
+                each a callable that transforms an item in place, and this object wires
+                them together with bounded dlib::pipe queues and a configurable number
+                of worker threads per stage.  Items enqueued at the front flow through
+                the stages in order and, if you enabled an output queue, come out the
+                back via dequeue().
+
+                The queue between stages is bounded, so a slow stage naturally applies
+                backpressure to the stages before it.  Alternatively, any queue can be
+                put into drop-oldest mode, in which case writers never block on it.
+                Instead the oldest queued item is thrown away to make room, which is
+                usually what you want for real-time flows where a stale frame is worth
+                less than a fresh one.
+
+                Note that when a stage has more than one worker thread the relative
+                order of items leaving that stage is unspecified.
+
+                THREAD SAFETY
+                    Any number of threads may call enqueue(), dequeue(), and
+                    dequeue_or_timeout() concurrently once the pipeline is running.
+                    However, start(), stop(), drain(), and the configuration routines
+                    must not be called concurrently with any other member function.
+        !*/
+
+    public:
+
+        pipeline (
+        );
+        /*!
+            ensures
+                - this object is properly initialized
+        !*/
+
+        ~pipeline (
+        );
+        /*!
+            ensures
+                - performs stop()
+        !*/
+
+        void add_stage (
+            std::function<void(item_type&)> funct,
+            unsigned long num_threads = 1,
+            unsigned long max_queue_size = 1,
+            bool drop_oldest = false
+        );
+        /*!
+            requires
+                - is_running() == false
+                - num_threads > 0
+                - max_queue_size > 0
+            ensures
+                - Appends a stage to the back of the pipeline.  Once running, items
+                  entering this stage are processed by calling funct(item), with up to
+                  num_threads calls in flight at a time.
+                - #num_stages() == num_stages() + 1
+                - The stage's input queue holds at most max_queue_size items.  If
+                  drop_oldest == false then whoever feeds this stage blocks while the
+                  queue is full.  If drop_oldest == true then the feeder never blocks
+                  and the oldest queued item is discarded to make room, with each
+                  discarded item counted by num_dropped().
+        !*/
+
+        void enable_output (
+            unsigned long max_queue_size = 1,
+            bool drop_oldest = false
+        );
+        /*!
+            requires
+                - is_running() == false
+                - max_queue_size > 0
+            ensures
+                - Items leaving the last stage are placed into an output queue that
+                  dequeue() and dequeue_or_timeout() read, rather than being
+                  discarded.  max_queue_size and drop_oldest configure that queue just
+                  like the add_stage() arguments of the same names.  In particular, if
+                  drop_oldest == false then you must keep calling dequeue() or the
+                  whole pipeline will eventually stall on the full output queue.
+        !*/
+
+        unsigned long num_stages (
+        ) const;
+        /*!
+            ensures
+                - returns the number of stages added by add_stage()
+        !*/
+
+        bool is_running (
+        ) const;
+        /*!
+            ensures
+                - returns true if start() has been called and stop() hasn't been
+                  called since.
+        !*/
+
+        unsigned long num_dropped (
+        ) const;
+        /*!
+            ensures
+                - returns the total number of items discarded so far by queues in
+                  drop-oldest mode.
+        !*/
+
+        void start (
+        );
+        /*!
+            requires
+                - is_running() == false
+                - num_stages() > 0
+            ensures
+                - #is_running() == true
+                - creates the inter-stage queues and launches the worker threads.
+                  The pipeline now accepts items via enqueue().
+        !*/
+
+        bool enqueue (
+            item_type& item
+        );
+        /*!
+            ensures
+                - if (is_running()) then
+                    - moves item into the first stage's queue, leaving item in an
+                      unspecified (i.e. swapped-out) state, and returns true.  Blocks
+                      while that queue is full unless it is in drop-oldest mode.
+                - else
+                    - returns false and item is unmodified.
+        !*/
+
+        bool enqueue (
+            item_type&& item
+        );
+        /*!
+            ensures
+                - performs enqueue(item), i.e. the same as the overload above.
+        !*/
+
+        bool dequeue (
+            item_type& item
+        );
+        /*!
+            requires
+                - enable_output() has been called
+            ensures
+                - if (is_running()) then
+                    - blocks until a finished item is available, swaps it into item,
+                      and returns true.  Returns false if stop() is called while
+                      blocked.
+                - else
+                    - if any finished results are still sitting in the output queue
+                      then swaps the oldest one into item and returns true, otherwise
+                      returns false immediately.
+        !*/
+
+        bool dequeue_or_timeout (
+            item_type& item,
+            unsigned long timeout
+        );
+        /*!
+            requires
+                - enable_output() has been called
+            ensures
+                - same as dequeue() except that while running it waits at most
+                  timeout milliseconds for an item before returning false.
+        !*/
+
+        void drain (
+        );
+        /*!
+            ensures
+                - if (is_running()) then
+                    - blocks until every item accepted by enqueue() so far has been
+                      processed by every stage, i.e. has either reached the output
+                      queue or been discarded by a drop-oldest queue.  Note that if
+                      the output queue is full and not in drop-oldest mode this can
+                      block until someone calls dequeue().
+        !*/
+
+        void stop (
+        );
+        /*!
+            ensures
+                - #is_running() == false
+                - All worker threads have terminated.  Items still waiting in the
+                  inter-stage queues are discarded (call drain() first if you need
+                  them processed), but finished results already in the output queue
+                  remain available to dequeue().
+                - blocks until all of the above is finished.
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_PIPELINe_EXTENSION_ABSTRACT_
@@ -4,6 +4,7 @@
 #define DLIB_THREAD_POOl_CPPh_ 
 
 #include "thread_pool_extension.h"
+#include <algorithm>
 #include <memory>
 
 namespace dlib
@@ -13,13 +14,26 @@ namespace dlib
 
     thread_pool_implementation::
     thread_pool_implementation (
-        unsigned long num_threads
-    ) : 
+        unsigned long num_threads,
+        bool enable_work_stealing
+    ) :
         task_done_signaler(m),
         task_ready_signaler(m),
-        we_are_destructing(false)
+        we_are_destructing(false),
+        max_spin_count(10000),
+        ready_epoch(0),
+        work_stealing_enabled(enable_work_stealing),
+        ws_num_queued(0),
+        ws_next_task_id(2),
+        ws_next_push_queue(0)
     {
         tasks.resize(num_threads);
+        if (work_stealing_enabled)
+        {
+            ws_queues.resize(num_threads);
+            for (unsigned long i = 0; i < num_threads; ++i)
+                ws_queues[i].reset(new ws_queue_type);
+        }
         threads.resize(num_threads);
         for (unsigned long i = 0; i < num_threads; ++i)
         {
@@ -35,28 +49,37 @@ namespace dlib
     {
         {
             auto_mutex M(m);
-            
+
             // first wait for all pending tasks to finish
-            bool found_task = true;
-            while (found_task)
+            if (work_stealing_enabled)
             {
-                found_task = false;
-                for (unsigned long i = 0; i < tasks.size(); ++i)
+                while (ws_pending_ids.size() != 0)
+                    task_done_signaler.wait();
+            }
+            else
+            {
+                bool found_task = true;
+                while (found_task)
                 {
-                    // If task bucket i has a task that is currently supposed to be processed
-                    if (tasks[i].is_empty() == false)
+                    found_task = false;
+                    for (unsigned long i = 0; i < tasks.size(); ++i)
                     {
-                        found_task = true;
-                        break;
+                        // If task bucket i has a task that is currently supposed to be processed
+                        if (tasks[i].is_empty() == false)
+                        {
+                            found_task = true;
+                            break;
+                        }
                     }
-                }
 
-                if (found_task)
-                    task_done_signaler.wait();
+                    if (found_task)
+                        task_done_signaler.wait();
+                }
             }
 
             // now tell the threads to kill themselves
             we_are_destructing = true;
+            ++ready_epoch;
             task_ready_signaler.broadcast();
         }
 
@@ -69,6 +92,12 @@ namespace dlib
         // destructor this will kill the program.
         for (auto&& task : tasks)
             task.propagate_exception();
+        if (ws_exceptions.size() != 0)
+        {
+            auto tmp = ws_exceptions.back();
+            ws_exceptions.pop_back();
+            std::rethrow_exception(tmp);
+        }
     }
 
 // ----------------------------------------------------------------------------------------
@@ -89,6 +118,75 @@ namespace dlib
         return tasks.size();
     }
 
+// ----------------------------------------------------------------------------------------
+
+    unsigned long thread_pool_implementation::
+    get_max_spin_count (
+    ) const
+    {
+        return max_spin_count;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void thread_pool_implementation::
+    set_max_spin_count (
+        unsigned long count
+    )
+    {
+        max_spin_count = count;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    namespace
+    {
+        template <typename condition_type>
+        bool spin_until (
+            const condition_type& is_ready,
+            const unsigned long budget
+        )
+        /*!
+            ensures
+                - busy waits until is_ready() == true, spending at most about budget
+                  iterations of backoff in total.  The pause between checks grows
+                  exponentially so short waits poll the condition quickly while longer
+                  ones don't hammer the cache line being watched.
+                - returns is_ready()
+        !*/
+        {
+            unsigned long delay = 1;
+            unsigned long spent = 0;
+            while (spent < budget)
+            {
+                if (is_ready())
+                    return true;
+                for (volatile unsigned long i = 0; i < delay; ++i)
+                    ;
+                spent += delay;
+                delay = std::min(delay*2, budget/8 + 1);
+            }
+            return is_ready();
+        }
+    }
+
+    bool thread_pool_implementation::
+    spin_for_epoch_change (
+        uint64 epoch
+    ) const
+    {
+        return spin_until([&]() { return ready_epoch.load(std::memory_order_relaxed) != epoch; },
+                          max_spin_count.load(std::memory_order_relaxed));
+    }
+
+    bool thread_pool_implementation::
+    spin_for_queued_task (
+    ) const
+    {
+        return spin_until([&]() { return ws_num_queued.load(std::memory_order_relaxed) > 0; },
+                          max_spin_count.load(std::memory_order_relaxed));
+    }
+
 // ----------------------------------------------------------------------------------------
 
     void thread_pool_implementation::
@@ -96,6 +194,42 @@ namespace dlib
         uint64 task_id
     ) const
     {
+        if (work_stealing_enabled)
+        {
+            long my_index;
+            {
+                auto_mutex M(m);
+                my_index = ws_worker_index(get_thread_id());
+            }
+
+            std::exception_ptr eptr = nullptr;
+            m.lock();
+            while (ws_pending_ids.count(task_id) != 0)
+            {
+                if (ws_num_queued > 0)
+                {
+                    // Rather than idle, help drain the deques.  This also prevents
+                    // deadlock when a worker thread waits on tasks it just spawned.
+                    m.unlock();
+                    ws_run_one_task(my_index);
+                    m.lock();
+                }
+                else
+                {
+                    task_done_signaler.wait();
+                }
+            }
+            if (ws_exceptions.size() != 0)
+            {
+                eptr = ws_exceptions.back();
+                ws_exceptions.pop_back();
+            }
+            m.unlock();
+            if (eptr)
+                std::rethrow_exception(eptr);
+            return;
+        }
+
         auto_mutex M(m);
         if (tasks.size() != 0)
         {
@@ -116,6 +250,64 @@ namespace dlib
     {
         const thread_id_type thread_id = get_thread_id();
 
+        if (work_stealing_enabled)
+        {
+            long my_index;
+            {
+                auto_mutex M(m);
+                my_index = ws_worker_index(thread_id);
+            }
+
+            auto tasks_from_me_pending = [&]()
+            {
+                long count = 0;
+                for (unsigned long i = 0; i < ws_submitter_counts.size(); ++i)
+                {
+                    if (ws_submitter_counts[i].first == thread_id)
+                    {
+                        count = ws_submitter_counts[i].second;
+                        break;
+                    }
+                }
+                // Don't count tasks we submitted that are executing on our own stack
+                // right now (i.e. tasks this very call is running while it waits), or
+                // we would deadlock waiting on ourselves.
+                for (unsigned long i = 0; i < ws_executing.size(); ++i)
+                {
+                    if (ws_executing[i].first == thread_id && ws_executing[i].second == thread_id)
+                        --count;
+                }
+                return count > 0;
+            };
+
+            std::exception_ptr eptr = nullptr;
+            m.lock();
+            while (tasks_from_me_pending())
+            {
+                if (ws_num_queued > 0)
+                {
+                    // Rather than idle, help drain the deques.  This also prevents
+                    // deadlock when a worker thread waits on tasks it just spawned.
+                    m.unlock();
+                    ws_run_one_task(my_index);
+                    m.lock();
+                }
+                else
+                {
+                    task_done_signaler.wait();
+                }
+            }
+            if (ws_exceptions.size() != 0)
+            {
+                eptr = ws_exceptions.back();
+                ws_exceptions.pop_back();
+            }
+            m.unlock();
+            if (eptr)
+                std::rethrow_exception(eptr);
+            return;
+        }
+
         auto_mutex M(m);
         bool found_task = true;
         while (found_task)
@@ -168,11 +360,37 @@ namespace dlib
     thread (
     )
     {
+        long my_index;
         {
             // save the id of this worker thread into worker_thread_ids
             auto_mutex M(m);
             thread_id_type id = get_thread_id();
             worker_thread_ids.push_back(id);
+            my_index = worker_thread_ids.size()-1;
+        }
+
+        if (work_stealing_enabled)
+        {
+            while (true)
+            {
+                // keep draining the deques for as long as there is anything to do
+                if (ws_run_one_task(my_index))
+                    continue;
+
+                // The deques look empty.  Spin briefly before parking since fine
+                // grained fork/join workloads usually queue the next task within
+                // microseconds, while a park and unpark costs a kernel round trip
+                // on both sides.
+                if (spin_for_queued_task())
+                    continue;
+
+                auto_mutex M(m);
+                if (we_are_destructing)
+                    break;
+                if (ws_num_queued <= 0)
+                    task_ready_signaler.wait();
+            }
+            return;
         }
 
         task_state_type task;
@@ -180,18 +398,36 @@ namespace dlib
         {
             long idx = 0;
 
-            // wait for a task to do 
-            { auto_mutex M(m);
-                while ( (idx = find_ready_task()) == -1 && we_are_destructing == false)
+            // wait for a task to do
+            m.lock();
+            while ( (idx = find_ready_task()) == -1 && we_are_destructing == false)
+            {
+                // Spin briefly before parking on the signaler.  ready_epoch ticks
+                // every time a task becomes ready, so we can watch for new work
+                // without holding the mutex.
+                const uint64 epoch = ready_epoch;
+                m.unlock();
+                const bool saw_new_task = spin_for_epoch_change(epoch);
+                m.lock();
+
+                // If the spin budget ran out then park like we always used to.  The
+                // loop condition re-checks for ready tasks while holding the mutex
+                // before the wait happens, so a task announced in the meantime can't
+                // be missed.
+                if (!saw_new_task && find_ready_task() == -1 && we_are_destructing == false)
                     task_ready_signaler.wait();
+            }
 
-                if (we_are_destructing)
-                    break;
-
-                tasks[idx].is_being_processed = true;
-                task = tasks[idx];
+            if (we_are_destructing)
+            {
+                m.unlock();
+                break;
             }
 
+            tasks[idx].is_being_processed = true;
+            task = tasks[idx];
+            m.unlock();
+
             std::exception_ptr eptr = nullptr;
             try
             {
@@ -283,6 +519,210 @@ namespace dlib
         return static_cast<unsigned long>(id%tasks.size());
     }
 
+// ----------------------------------------------------------------------------------------
+
+    uint64 thread_pool_implementation::
+    ws_add_task (
+        ws_task_type& task
+    )
+    {
+        uint64 id;
+        {
+            auto_mutex M(m);
+
+            // throw any exceptions generated by tasks that have already finished
+            if (ws_exceptions.size() != 0)
+            {
+                auto tmp = ws_exceptions.back();
+                ws_exceptions.pop_back();
+                std::rethrow_exception(tmp);
+            }
+
+            // If there aren't any worker threads then just perform the task right here.
+            if (ws_queues.size() == 0)
+            {
+                M.unlock();
+                if (task.bfp)
+                    task.bfp();
+                else if (task.mfp0)
+                    task.mfp0();
+                else if (task.mfp1)
+                    task.mfp1(task.arg1);
+                else if (task.mfp2)
+                    task.mfp2(task.arg1, task.arg2);
+
+                // return a task id that is both non-zero and also one
+                // that is never normally returned.  This way calls
+                // to wait_for_task() will never block given this id.
+                return 1;
+            }
+
+            const thread_id_type my_thread_id = get_thread_id();
+            id = ws_next_task_id++;
+            task.task_id = id;
+            task.thread_id = my_thread_id;
+            ws_pending_ids.insert(id);
+
+            bool found_count = false;
+            for (unsigned long i = 0; i < ws_submitter_counts.size(); ++i)
+            {
+                if (ws_submitter_counts[i].first == my_thread_id)
+                {
+                    ws_submitter_counts[i].second += 1;
+                    found_count = true;
+                    break;
+                }
+            }
+            if (!found_count)
+                ws_submitter_counts.push_back(std::make_pair(my_thread_id, 1));
+
+            // Push onto the submitting worker's own deque when possible so related
+            // tasks stay hot in its cache, otherwise spread tasks round robin.
+            long idx = ws_worker_index(my_thread_id);
+            if (idx == -1)
+                idx = (ws_next_push_queue++)%ws_queues.size();
+
+            {
+                auto_mutex Q(ws_queues[idx]->m);
+                ws_queues[idx]->q.push_back(task);
+            }
+            ++ws_num_queued;
+            ++ready_epoch;
+            task_ready_signaler.signal();
+        }
+
+        return id;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    bool thread_pool_implementation::
+    ws_run_one_task (
+        long my_index
+    ) const
+    {
+        ws_task_type task;
+        bool got_task = false;
+
+        // Pop the oldest task from our own deque first.  It is important that tasks
+        // execute in roughly the order they were submitted because a task is allowed
+        // to block on the result of an earlier task (e.g. the future chaining done by
+        // dlib::async()).  If we popped the newest task instead then on a pool with
+        // few threads a late task could start first, block waiting on an earlier task
+        // that is still sitting in the deque behind it, and deadlock the pool.
+        if (my_index != -1)
+        {
+            ws_queue_type& q = *ws_queues[my_index];
+            auto_mutex Q(q.m);
+            if (q.q.size() != 0)
+            {
+                task = q.q.front();
+                q.q.pop_front();
+                got_task = true;
+            }
+        }
+
+        // Otherwise steal the oldest task from someone else's deque.
+        for (unsigned long i = 0; i < ws_queues.size() && !got_task; ++i)
+        {
+            const unsigned long victim = (static_cast<unsigned long>(my_index+1)+i)%ws_queues.size();
+            ws_queue_type& q = *ws_queues[victim];
+            auto_mutex Q(q.m);
+            if (q.q.size() != 0)
+            {
+                task = q.q.front();
+                q.q.pop_front();
+                got_task = true;
+            }
+        }
+
+        if (!got_task)
+            return false;
+
+        --ws_num_queued;
+        ws_execute_task(task);
+        return true;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    void thread_pool_implementation::
+    ws_execute_task (
+        ws_task_type& task
+    ) const
+    {
+        const thread_id_type my_thread_id = get_thread_id();
+
+        // Note which task is running on this thread's stack.  wait_for_all_tasks()
+        // needs this so a task that waits on tasks it just spawned doesn't end up
+        // waiting on itself when it was submitted from the same thread that is now
+        // executing it (which happens when threads blocked in the wait functions help
+        // drain the deques).
+        {
+            auto_mutex M(m);
+            ws_executing.push_back(std::make_pair(my_thread_id, task.thread_id));
+        }
+
+        std::exception_ptr eptr = nullptr;
+        try
+        {
+            if (task.bfp)
+                task.bfp();
+            else if (task.mfp0)
+                task.mfp0();
+            else if (task.mfp1)
+                task.mfp1(task.arg1);
+            else if (task.mfp2)
+                task.mfp2(task.arg1, task.arg2);
+        }
+        catch(...)
+        {
+            eptr = std::current_exception();
+        }
+
+        // Now let others know that we finished the task.
+        auto_mutex M(m);
+        for (unsigned long i = ws_executing.size(); i > 0; --i)
+        {
+            if (ws_executing[i-1].first == my_thread_id && ws_executing[i-1].second == task.thread_id)
+            {
+                ws_executing.erase(ws_executing.begin()+(i-1));
+                break;
+            }
+        }
+        ws_pending_ids.erase(task.task_id);
+        for (unsigned long i = 0; i < ws_submitter_counts.size(); ++i)
+        {
+            if (ws_submitter_counts[i].first == task.thread_id)
+            {
+                if (--ws_submitter_counts[i].second <= 0)
+                {
+                    std::swap(ws_submitter_counts[i], ws_submitter_counts.back());
+                    ws_submitter_counts.pop_back();
+                }
+                break;
+            }
+        }
+        if (eptr)
+            ws_exceptions.push_back(eptr);
+        task_done_signaler.broadcast();
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    long thread_pool_implementation::
+    ws_worker_index (
+        const thread_id_type id
+    ) const
+    {
+        for (unsigned long i = 0; i < worker_thread_ids.size(); ++i)
+        {
+            if (worker_thread_ids[i] == id)
+                return i;
+        }
+        return -1;
+    }
+
 // ----------------------------------------------------------------------------------------
 
     uint64 thread_pool_implementation::
@@ -291,6 +731,14 @@ namespace dlib
         std::shared_ptr<function_object_copy>& item
     )
     {
+        if (work_stealing_enabled)
+        {
+            ws_task_type task;
+            task.bfp = bfp;
+            task.function_copy.swap(item);
+            return ws_add_task(task);
+        }
+
         auto_mutex M(m);
         const thread_id_type my_thread_id = get_thread_id();
 
@@ -323,6 +771,7 @@ namespace dlib
         tasks[idx].bfp = bfp;
         tasks[idx].function_copy.swap(item);
 
+        ++ready_epoch;
         task_ready_signaler.signal();
 
         return tasks[idx].task_id;
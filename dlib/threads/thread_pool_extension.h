@@ -3,9 +3,14 @@
 #ifndef DLIB_THREAD_POOl_Hh_
 #define DLIB_THREAD_POOl_Hh_ 
 
+#include <atomic>
+#include <deque>
 #include <exception>
 #include <memory>
 #include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "thread_pool_extension_abstract.h"
 #include "multithreaded_object_extension.h"
@@ -147,7 +152,8 @@ namespace dlib
 
         friend class thread_pool;
         explicit thread_pool_implementation (
-            unsigned long num_threads
+            unsigned long num_threads,
+            bool enable_work_stealing = false
         );
 
     public:
@@ -161,6 +167,13 @@ namespace dlib
         unsigned long num_threads_in_pool (
         ) const;
 
+        unsigned long get_max_spin_count (
+        ) const;
+
+        void set_max_spin_count (
+            unsigned long count
+        );
+
         void wait_for_all_tasks (
         ) const;
 
@@ -173,6 +186,13 @@ namespace dlib
             void (T::*funct)()
         )
         {
+            if (work_stealing_enabled)
+            {
+                ws_task_type task;
+                task.mfp0.set(obj,funct);
+                return ws_add_task(task);
+            }
+
             auto_mutex M(m);
             const thread_id_type my_thread_id = get_thread_id();
 
@@ -204,6 +224,7 @@ namespace dlib
             tasks[idx].task_id = make_next_task_id(idx);
             tasks[idx].mfp0.set(obj,funct);
 
+            ++ready_epoch;
             task_ready_signaler.signal();
 
             return tasks[idx].task_id;
@@ -216,6 +237,14 @@ namespace dlib
             long arg1
         )
         {
+            if (work_stealing_enabled)
+            {
+                ws_task_type task;
+                task.mfp1.set(obj,funct);
+                task.arg1 = arg1;
+                return ws_add_task(task);
+            }
+
             auto_mutex M(m);
             const thread_id_type my_thread_id = get_thread_id();
 
@@ -248,6 +277,7 @@ namespace dlib
             tasks[idx].mfp1.set(obj,funct);
             tasks[idx].arg1 = arg1;
 
+            ++ready_epoch;
             task_ready_signaler.signal();
 
             return tasks[idx].task_id;
@@ -261,6 +291,15 @@ namespace dlib
             long arg2
         )
         {
+            if (work_stealing_enabled)
+            {
+                ws_task_type task;
+                task.mfp2.set(obj,funct);
+                task.arg1 = arg1;
+                task.arg2 = arg2;
+                return ws_add_task(task);
+            }
+
             auto_mutex M(m);
             const thread_id_type my_thread_id = get_thread_id();
 
@@ -294,6 +333,7 @@ namespace dlib
             tasks[idx].arg1 = arg1;
             tasks[idx].arg2 = arg2;
 
+            ++ready_epoch;
             task_ready_signaler.signal();
 
             return tasks[idx].task_id;
@@ -467,6 +507,113 @@ namespace dlib
 
         };
 
+        struct ws_task_type
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is a task waiting in one of the per-worker deques used when
+                    work stealing is enabled.  Unlike task_state_type, there can be any
+                    number of these queued up at once.
+            !*/
+            ws_task_type() : task_id(0), arg1(0), arg2(0) {}
+
+            uint64 task_id; // the id of this task.  0 means this task is empty
+            thread_id_type thread_id; // the id of the thread that requested this task
+
+            long arg1;
+            long arg2;
+
+            member_function_pointer<> mfp0;
+            member_function_pointer<long> mfp1;
+            member_function_pointer<long,long> mfp2;
+            bfp_type bfp;
+
+            std::shared_ptr<function_object_copy> function_copy;
+        };
+
+        struct ws_queue_type
+        {
+            mutex m;
+            std::deque<ws_task_type> q;
+        };
+
+        uint64 ws_add_task (
+            ws_task_type& task
+        );
+        /*!
+            requires
+                - work_stealing_enabled == true
+                - exactly one of task.bfp, task.mfp0, task.mfp1, or task.mfp2 is set
+            ensures
+                - pushes the task onto one of the worker deques (or runs it inline if
+                  the pool has no threads) and returns its task id.
+        !*/
+
+        bool ws_run_one_task (
+            long my_index
+        ) const;
+        /*!
+            requires
+                - work_stealing_enabled == true
+                - m is not locked by the calling thread
+                - my_index == the index of the calling worker thread's deque or -1 if
+                  the caller isn't one of the pool's worker threads
+            ensures
+                - if (a queued task could be popped from our own deque or stolen from
+                  another worker's deque) then
+                    - executes that task and records its completion
+                    - returns true
+                - else
+                    - returns false
+        !*/
+
+        void ws_execute_task (
+            ws_task_type& task
+        ) const;
+        /*!
+            requires
+                - work_stealing_enabled == true
+                - m is not locked by the calling thread
+            ensures
+                - runs the given task, then removes it from the pending bookkeeping and
+                  broadcasts task_done_signaler.  Any exception it throws is saved into
+                  ws_exceptions rather than propagated.
+        !*/
+
+        bool spin_for_epoch_change (
+            uint64 epoch
+        ) const;
+        /*!
+            ensures
+                - busy waits until ready_epoch != epoch, but never for more than
+                  roughly max_spin_count iterations of exponential backoff.
+                - returns (ready_epoch != epoch)
+        !*/
+
+        bool spin_for_queued_task (
+        ) const;
+        /*!
+            requires
+                - work_stealing_enabled == true
+            ensures
+                - busy waits until ws_num_queued > 0, but never for more than roughly
+                  max_spin_count iterations of exponential backoff.
+                - returns (ws_num_queued > 0)
+        !*/
+
+        long ws_worker_index (
+            const thread_id_type id
+        ) const;
+        /*!
+            requires
+                - m is locked
+            ensures
+                - if (the thread with the given id is one of the pool's worker threads) then
+                    - returns the index of its deque in ws_queues
+                - else
+                    - returns -1
+        !*/
+
         array<task_state_type> tasks;
         array<thread_id_type> worker_thread_ids;
 
@@ -475,6 +622,27 @@ namespace dlib
         signaler task_ready_signaler;
         bool we_are_destructing;
 
+        // See set_max_spin_count().  This is how long an idle worker busy waits for a
+        // new task before parking on task_ready_signaler.
+        std::atomic<unsigned long> max_spin_count;
+        // Incremented every time a task becomes ready to run.  It lets idle workers
+        // notice new work while spinning without having to take the mutex.
+        mutable std::atomic<uint64> ready_epoch;
+
+        // The following fields are only used when work_stealing_enabled == true.  In
+        // that mode tasks go into the per-worker deques in ws_queues instead of the
+        // fixed task slots above.  They are mutable because threads blocked in the
+        // const wait functions help drain the deques rather than just idling.
+        const bool work_stealing_enabled;
+        mutable std::vector<std::shared_ptr<ws_queue_type> > ws_queues;
+        mutable std::unordered_set<uint64> ws_pending_ids; // ids of tasks queued or running
+        mutable std::vector<std::pair<thread_id_type,long> > ws_submitter_counts; // per submitting thread count of unfinished tasks
+        mutable std::vector<std::pair<thread_id_type,thread_id_type> > ws_executing; // (executing thread, submitting thread) for each task currently running
+        mutable std::vector<std::exception_ptr> ws_exceptions; // exceptions thrown by tasks
+        mutable std::atomic<long> ws_num_queued; // number of tasks sitting in deques
+        uint64 ws_next_task_id;
+        unsigned long ws_next_push_queue;
+
         std::vector<std::thread> threads;
 
         // restricted functions
@@ -500,11 +668,19 @@ namespace dlib
     public:
         explicit thread_pool (
             unsigned long num_threads
-        ) 
+        )
         {
             impl.reset(new thread_pool_implementation(num_threads));
         }
 
+        thread_pool (
+            unsigned long num_threads,
+            bool enable_work_stealing
+        )
+        {
+            impl.reset(new thread_pool_implementation(num_threads, enable_work_stealing));
+        }
+
         ~thread_pool (
         )
         {
@@ -536,6 +712,13 @@ namespace dlib
         unsigned long num_threads_in_pool (
         ) const { return impl->num_threads_in_pool(); }
 
+        unsigned long get_max_spin_count (
+        ) const { return impl->get_max_spin_count(); }
+
+        void set_max_spin_count (
+            unsigned long count
+        ) { impl->set_max_spin_count(count); }
+
         void wait_for_all_tasks (
         ) const { impl->wait_for_all_tasks(); }
 
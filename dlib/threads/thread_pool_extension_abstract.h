@@ -218,11 +218,11 @@ namespace dlib
                 mode any thread that calls add_task() is considered to be
                 a thread_pool thread capable of executing tasks.
 
-                This object is also implemented such that no memory allocations occur 
-                after the thread_pool has been constructed so long as the user doesn't 
-                call any of the add_task_by_value() routines.  The future object also 
-                doesn't perform any memory allocations or contain any system resources 
-                such as mutex objects. 
+                This object is also implemented such that no memory allocations occur
+                after the thread_pool has been constructed so long as the user doesn't
+                call any of the add_task_by_value() routines and work stealing is
+                disabled.  The future object also doesn't perform any memory
+                allocations or contain any system resources such as mutex objects.
 
             EXCEPTIONS
                 Note that if an exception is thrown inside a task thread and is not caught
@@ -242,7 +242,36 @@ namespace dlib
             throws
                 - std::bad_alloc
                 - dlib::thread_error
-                    the constructor may throw this exception if there is a problem 
+                    the constructor may throw this exception if there is a problem
+                    gathering resources to create threading objects.
+        !*/
+
+        thread_pool (
+            unsigned long num_threads,
+            bool enable_work_stealing
+        );
+        /*!
+            ensures
+                - #num_threads_in_pool() == num_threads
+                - if (enable_work_stealing == true) then
+                    - Tasks are scheduled with a work stealing scheduler instead of the
+                      default shared task list.  Each worker thread gets its own deque
+                      of tasks, runs the most recently submitted task from its own
+                      deque, and steals the oldest task from another worker's deque
+                      when its own is empty.  Threads blocked in one of the wait
+                      functions also help run queued tasks while they wait.  This mode
+                      scales much better when many small tasks are submitted from many
+                      threads at once, e.g. fine-grained parallel_for() loops on high
+                      core count machines.  It is therefore what the pool returned by
+                      default_thread_pool() uses.  The observable behavior of the
+                      thread_pool is the same in both modes, except that in this mode
+                      add_task() never runs a task inline in the submitting thread just
+                      because all the workers happen to be busy (tasks queue up
+                      instead) and task submission can allocate memory.
+            throws
+                - std::bad_alloc
+                - dlib::thread_error
+                    the constructor may throw this exception if there is a problem
                     gathering resources to create threading objects.
         !*/
 
@@ -276,6 +305,30 @@ namespace dlib
                   the maximum number of tasks that this object will process concurrently.
         !*/
 
+        unsigned long get_max_spin_count (
+        ) const;
+        /*!
+            ensures
+                - returns the number of busy wait iterations an idle worker thread
+                  performs, watching for a new task, before it goes to sleep on a
+                  condition variable.  Going to sleep and being woken back up costs a
+                  kernel round trip on both sides, which can dominate the runtime of
+                  workloads made of many very short tasks, so a worker first spins for
+                  up to this long with exponentially growing pauses between checks.
+        !*/
+
+        void set_max_spin_count (
+            unsigned long count
+        );
+        /*!
+            ensures
+                - #get_max_spin_count() == count
+                - A value of 0 disables spinning entirely, making idle workers park
+                  immediately.  This minimizes the CPU used by an idle pool at the
+                  cost of higher task startup latency.  Larger values trade idle CPU
+                  time for faster handoff of tasks to workers.
+        !*/
+
         template <typename F>
         uint64 add_task_by_value (
             const F& function_object
@@ -28,6 +28,11 @@ namespace dlib
 
         bool thread_pool_has_been_destroyed = false;
 
+        // This flag lets the no-argument version of is_dlib_thread() answer without
+        // taking any locks at all.  It is set by thread_starter() before a new thread
+        // does anything else and threads dlib didn't spawn never touch it.
+        thread_local bool this_thread_was_spawned_by_dlib = false;
+
 // ----------------------------------------------------------------------------------------
 
         struct threader_destruct_helper
@@ -57,8 +62,9 @@ namespace dlib
             thread_id_type id
         )
         {
-            auto_mutex M(data_mutex);
-            return thread_ids.is_member(id);
+            id_shard_type& shard = id_shards[shard_index(id)];
+            auto_mutex M(shard.m);
+            return shard.ids.count((size_t)id) != 0;
         }
 
 // ----------------------------------------------------------------------------------------
@@ -73,7 +79,8 @@ namespace dlib
             data_empty(data_mutex),
             destruct(false),
             destructed(data_mutex),
-            do_not_ever_destruct(false)
+            do_not_ever_destruct(false),
+            num_registered_handlers(0)
         {
 #ifdef WIN32
             // Trying to destroy the global thread pool when we are part of a DLL and the
@@ -147,21 +154,29 @@ namespace dlib
         call_end_handlers (
         )
         {
-            reg.m.lock();
+            // Almost no threads ever register an end handler, so don't touch the
+            // registry, or any of its mutexes, unless something is actually in it.
+            if (num_registered_handlers.load(std::memory_order_acquire) == 0)
+                return;
+
             const thread_id_type id = get_thread_id();
+            registry_type& shard = reg_shards[shard_index(id)];
+
+            shard.m.lock();
             thread_id_type id_copy;
             member_function_pointer<> mfp;
 
-            // Remove all the member function pointers for this thread from the tree 
+            // Remove all the member function pointers for this thread from the tree
             // and call them.
-            while (reg.reg[id] != 0)
+            while (shard.reg[id] != 0)
             {
-                reg.reg.remove(id,id_copy,mfp);
-                reg.m.unlock();
+                shard.reg.remove(id,id_copy,mfp);
+                num_registered_handlers.fetch_sub(1, std::memory_order_release);
+                shard.m.unlock();
                 mfp();
-                reg.m.lock();
+                shard.m.lock();
             }
-            reg.m.unlock();
+            shard.m.unlock();
         }
 
     // ------------------------------------------------------------------------------------
@@ -226,13 +241,17 @@ namespace dlib
             // get a reference to the calling threader object
             threader& self = *static_cast<threader*>(object);
 
+            this_thread_was_spawned_by_dlib = true;
 
+            // add this thread id
+            const thread_id_type thread_id = get_thread_id();
             {
-            auto_mutex M(self.data_mutex);
+                auto_mutex M(self.id_shards[threader::shard_index(thread_id)].m);
+                self.id_shards[threader::shard_index(thread_id)].ids.insert((size_t)thread_id);
+            }
 
-            // add this thread id
-            thread_id_type thread_id = get_thread_id();
-            self.thread_ids.add(thread_id);
+            {
+            auto_mutex M(self.data_mutex);
 
             // indicate that this thread is now in the thread pool
             ++self.pool_count;
@@ -278,9 +297,13 @@ namespace dlib
 
             }
 
-            // remove this thread id from thread_ids
-            thread_id = get_thread_id();
-            self.thread_ids.destroy(thread_id);
+            // remove this thread id from its shard.  Note that this must happen
+            // before total_count is decremented since once that hits zero the
+            // destructor is free to delete self out from under us.
+            {
+                auto_mutex M2(self.id_shards[threader::shard_index(thread_id)].m);
+                self.id_shards[threader::shard_index(thread_id)].ids.erase((size_t)thread_id);
+            }
 
             // indicate that this thread is now out of the thread pool
             --self.pool_count;
@@ -307,7 +330,7 @@ namespace dlib
     bool is_dlib_thread (
     )
     {
-        return is_dlib_thread(get_thread_id());
+        return threads_kernel_shared::this_thread_was_spawned_by_dlib;
     }
 
 // ----------------------------------------------------------------------------------------
@@ -13,6 +13,9 @@
 #include "../queue.h"
 #include "../set.h"
 #include "../test_for_odr_violations.h"
+#include <atomic>
+#include <cstddef>
+#include <unordered_set>
 
 
 
@@ -42,6 +45,7 @@ namespace dlib
                     - total_count == 0
                     - function_pointer == 0
                     - do_not_ever_destruct == false
+                    - num_registered_handlers == 0
 
                 CONVENTION
                     - data_ready is associated with the mutex data_mutex 
@@ -63,9 +67,17 @@ namespace dlib
                     - else
                         - destruct == false
 
-                    - thread_ids is locked by the data_mutex
-                    - thread_ids == a set that contains the thread id for each thread spawned by this
-                      object.
+                    - The set of thread ids spawned by this object is sharded across
+                      id_shards by shard_index().  Each shard's ids set is locked by
+                      that shard's own mutex, never by data_mutex, so thread id
+                      lookups don't contend with the pool bookkeeping.
+                    - The thread end handler registry is likewise sharded across
+                      reg_shards by the registering thread's id, each shard locked by
+                      its own mutex.
+                    - num_registered_handlers == the total number of end handlers
+                      currently registered across all of reg_shards.  It lets
+                      call_end_handlers() skip the registry without locking anything
+                      in the common case where no handlers exist.
             !*/
 
 
@@ -105,14 +117,19 @@ namespace dlib
                 thread_id_type junk_id;
 
                 // find any member function pointers in the registry that point to the same
-                // thing as mfp and remove them
-                auto_mutex M(reg.m);
-                reg.reg.reset();
-                while (reg.reg.move_next())
+                // thing as mfp and remove them.  Unregistering is rare so it is fine that
+                // it has to visit every shard.
+                for (unsigned long i = 0; i < num_shards; ++i)
                 {
-                    while (reg.reg.current_element_valid() && reg.reg.element().value() == mfp)
+                    auto_mutex M(reg_shards[i].m);
+                    reg_shards[i].reg.reset();
+                    while (reg_shards[i].reg.move_next())
                     {
-                        reg.reg.remove_current_element(junk_id, junk_mfp);
+                        while (reg_shards[i].reg.current_element_valid() && reg_shards[i].reg.element().value() == mfp)
+                        {
+                            reg_shards[i].reg.remove_current_element(junk_id, junk_mfp);
+                            num_registered_handlers.fetch_sub(1, std::memory_order_release);
+                        }
                     }
                 }
             }
@@ -129,8 +146,10 @@ namespace dlib
                 member_function_pointer<> mfp;
                 mfp.set(obj,handler);
 
-                auto_mutex M(reg.m);
-                reg.reg.add(id,mfp);
+                registry_type& shard = reg_shards[shard_index(id)];
+                auto_mutex M(shard.m);
+                shard.reg.add(id,mfp);
+                num_registered_handlers.fetch_add(1, std::memory_order_release);
             }
 
             bool is_dlib_thread (
@@ -148,12 +167,30 @@ namespace dlib
             /*!
                 ensures
                     - calls the registered end handlers for the calling thread and
-                      then removes them from reg.reg
+                      then removes them from the calling thread's registry shard
             !*/
 
 
+            const static unsigned long num_shards = 16;
+
+            static unsigned long shard_index (
+                thread_id_type id
+            )
+            {
+                // Thread ids are often pointers or aligned integers whose low bits
+                // carry no entropy, so fold in the higher bits before reducing.
+                const size_t v = (size_t)id;
+                return static_cast<unsigned long>((v ^ (v>>12)) >> 4) % num_shards;
+            }
+
+            struct id_shard_type
+            {
+                mutex m;
+                std::unordered_set<size_t> ids;
+            };
+
             // private data
-            set<thread_id_type,memory_manager<char>::kernel_2b>::kernel_1b_c thread_ids;
+            id_shard_type id_shards[num_shards];
             unsigned long total_count;
             void* parameter;
             void (*function_pointer)(void*);
@@ -175,8 +212,9 @@ namespace dlib
                     >::kernel_2a_c reg;
             };
 
-            // stuff for the register_thread_end_handler 
-            registry_type reg;
+            // stuff for the register_thread_end_handler
+            registry_type reg_shards[num_shards];
+            std::atomic<unsigned long> num_registered_handlers;
 
 
             // restricted functions
@@ -4,6 +4,7 @@
 #define DLIB_TIMEOUt_
 
 #include "timeout/timeout.h"
+#include "timeout/shared_timeout.h"
 
 #endif // DLIB_TIMEOUt_
 
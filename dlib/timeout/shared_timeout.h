@@ -0,0 +1,261 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_SHARED_TIMEOUt_Hh_
+#define DLIB_SHARED_TIMEOUt_Hh_
+
+#include "shared_timeout_abstract.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../uintn.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class timeout_wheel
+    {
+        /*!
+            CONVENTION
+                - This is a hashed timer wheel.  Time is divided into ticks of
+                  tick_ms milliseconds and an armed entry with deadline D (in ticks)
+                  lives in slots[D % slots.size()].  The service thread advances
+                  processed_tick one slot per tick and fires the entries in that slot
+                  whose deadlines have passed; entries further in the future just stay
+                  put until the wheel comes around again.  This makes arming and
+                  canceling a timeout O(1) no matter how many are outstanding, and all
+                  the callbacks run on the one service thread.
+                - num_armed == the number of entries with armed == true
+                - everything is protected by m
+        !*/
+    public:
+
+        struct entry
+        {
+            uint64 deadline = 0;
+            std::function<void()> action;
+            bool armed = true;
+            bool running = false;
+        };
+
+        timeout_wheel (
+        ) :
+            slots(512),
+            start_time(std::chrono::steady_clock::now())
+        {
+            worker = std::thread(&timeout_wheel::service_loop, this);
+        }
+
+        ~timeout_wheel (
+        )
+        {
+            {
+                std::lock_guard<std::mutex> lock(m);
+                shutdown = true;
+            }
+            wakeup.notify_all();
+            worker.join();
+        }
+
+        std::shared_ptr<entry> add (
+            std::function<void()> action,
+            unsigned long ms_to_timeout
+        )
+        {
+            auto e = std::make_shared<entry>();
+            e->action = std::move(action);
+            std::lock_guard<std::mutex> lock(m);
+            // Round up and add one tick so the timeout never fires early.
+            e->deadline = now_tick() + (ms_to_timeout + tick_ms - 1)/tick_ms + 1;
+            slots[e->deadline % slots.size()].push_back(e);
+            ++num_armed;
+            wakeup.notify_all();
+            return e;
+        }
+
+        void remove (
+            const std::shared_ptr<entry>& e
+        )
+        {
+            std::unique_lock<std::mutex> lock(m);
+            if (e->armed)
+            {
+                e->armed = false;
+                --num_armed;
+            }
+            // If the action is being run right now then wait for it to finish so the
+            // caller knows it can't touch anything after remove() returns.
+            while (e->running)
+                action_done.wait(lock);
+        }
+
+    private:
+
+        // An enum rather than a static const member so that passing it to
+        // functions taking a const reference (e.g. the chrono constructors)
+        // never odr-uses it and therefore never needs an out-of-class
+        // definition.
+        enum { tick_ms = 10 };
+
+        uint64 now_tick (
+        ) const
+        {
+            using namespace std::chrono;
+            return duration_cast<milliseconds>(steady_clock::now()-start_time).count()/tick_ms;
+        }
+
+        void service_loop (
+        )
+        {
+            std::unique_lock<std::mutex> lock(m);
+            uint64 processed = now_tick();
+            std::vector<std::shared_ptr<entry>> due;
+            while (!shutdown)
+            {
+                if (num_armed == 0)
+                {
+                    // Nothing is pending, so sleep until something is armed.  Any
+                    // entry added while we slept gets a deadline after the time of
+                    // its add() call, so restarting the scan from now is safe.
+                    wakeup.wait(lock);
+                    processed = now_tick();
+                    continue;
+                }
+
+                while (processed < now_tick() && !shutdown)
+                {
+                    ++processed;
+                    auto& slot = slots[processed % slots.size()];
+                    for (auto i = slot.begin(); i != slot.end();)
+                    {
+                        if (!(*i)->armed)
+                        {
+                            i = slot.erase(i);
+                        }
+                        else if ((*i)->deadline <= processed)
+                        {
+                            (*i)->armed = false;
+                            (*i)->running = true;
+                            --num_armed;
+                            due.push_back(*i);
+                            i = slot.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+
+                    if (due.size() != 0)
+                    {
+                        lock.unlock();
+                        for (auto& e : due)
+                            e->action();
+                        lock.lock();
+                        for (auto& e : due)
+                            e->running = false;
+                        due.clear();
+                        action_done.notify_all();
+                    }
+                }
+
+                if (!shutdown)
+                    wakeup.wait_for(lock, std::chrono::milliseconds(tick_ms));
+            }
+        }
+
+        std::mutex m;
+        std::condition_variable wakeup;
+        std::condition_variable action_done;
+        std::vector<std::list<std::shared_ptr<entry>>> slots;
+        const std::chrono::steady_clock::time_point start_time;
+        uint64 num_armed = 0;
+        bool shutdown = false;
+        std::thread worker;
+    };
+
+// ----------------------------------------------------------------------------------------
+
+    inline std::shared_ptr<timeout_wheel> get_timeout_wheel (
+    )
+    {
+        static std::shared_ptr<timeout_wheel> wheel(new timeout_wheel);
+        return wheel;
+    }
+
+// ----------------------------------------------------------------------------------------
+
+    class shared_timeout
+    {
+    public:
+
+        template <
+            typename T
+            >
+        shared_timeout (
+            T callback_function,
+            unsigned long ms_to_timeout
+        )
+        {
+            tok = wheel->add(callback_function, ms_to_timeout);
+        }
+
+        template <
+            typename T,
+            typename R
+            >
+        shared_timeout (
+            T& object,
+            R (T::*callback_function)(),
+            unsigned long ms_to_timeout
+        )
+        {
+            T* const obj = &object;
+            tok = wheel->add([obj,callback_function](){ (obj->*callback_function)(); }, ms_to_timeout);
+        }
+
+        template <
+            typename T,
+            typename R,
+            typename U
+            >
+        shared_timeout (
+            T& object,
+            R (T::*callback_function)(U callback_function_argument),
+            unsigned long ms_to_timeout,
+            U callback_function_argument
+        )
+        {
+            T* const obj = &object;
+            tok = wheel->add([obj,callback_function,callback_function_argument]()
+                             { (obj->*callback_function)(callback_function_argument); }, ms_to_timeout);
+        }
+
+        ~shared_timeout (
+        )
+        {
+            wheel->remove(tok);
+        }
+
+    private:
+
+        // Hold a reference to the wheel so it can't be destructed while we are using it.
+        std::shared_ptr<timeout_wheel> wheel = get_timeout_wheel();
+        std::shared_ptr<timeout_wheel::entry> tok;
+
+        // restricted functions
+        shared_timeout(const shared_timeout&);        // copy constructor
+        shared_timeout& operator=(const shared_timeout&);    // assignment operator
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_SHARED_TIMEOUt_Hh_
@@ -0,0 +1,106 @@
+// Copyright (C) 2026  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#undef DLIB_SHARED_TIMEOUt_ABSTRACT_
+#ifdef DLIB_SHARED_TIMEOUt_ABSTRACT_
+
+#include "timeout_abstract.h"
+
+namespace dlib
+{
+
+// ----------------------------------------------------------------------------------------
+
+    class shared_timeout
+    {
+        /*!
+            WHAT THIS OBJECT REPRESENTS
+                This object does the same thing as dlib::timeout: it arms a callback
+                that fires if the shared_timeout isn't destructed within a certain
+                amount of time.  The difference is how the timeouts are tracked.  Each
+                dlib::timeout is its own timer and runs its callback on its own
+                thread, while all the shared_timeout objects in a process share one
+                timer wheel serviced by a single thread, making each of them O(1) to
+                arm and cancel.  That makes shared_timeout the right tool when you
+                have thousands of timeouts outstanding at once, such as one per
+                network connection.
+
+                Because every callback runs on the one service thread, callbacks
+                should be quick and must not block, or they will delay every other
+                timeout in the process.  Things like calling shutdown() on a
+                connection are fine.
+
+                The timer wheel has a granularity of a few tens of milliseconds, so a
+                timeout may fire slightly later than requested, but never earlier.
+
+            THREAD SAFETY
+                It is not safe to create or destruct a shared_timeout from inside a
+                shared_timeout callback.
+        !*/
+    public:
+
+        template <
+            typename T
+            >
+        shared_timeout (
+            T callback_function,
+            unsigned long ms_to_timeout
+        );
+        /*!
+            requires
+                - callback_function() is a valid expression
+            ensures
+                - if this object isn't destructed within ms_to_timeout milliseconds of
+                  this constructor running then callback_function() will be called on
+                  the shared timeout service thread.
+        !*/
+
+        template <
+            typename T
+            >
+        shared_timeout (
+            T& object,
+            void (T::*callback_function)(),
+            unsigned long ms_to_timeout
+        );
+        /*!
+            ensures
+                - if this object isn't destructed within ms_to_timeout milliseconds of
+                  this constructor running then (object.*callback_function)() will be
+                  called on the shared timeout service thread.
+        !*/
+
+        template <
+            typename T,
+            typename U
+            >
+        shared_timeout (
+            T& object,
+            void (T::*callback_function)(U callback_function_argument),
+            unsigned long ms_to_timeout,
+            U callback_function_argument
+        );
+        /*!
+            ensures
+                - if this object isn't destructed within ms_to_timeout milliseconds of
+                  this constructor running then
+                  (object.*callback_function)(callback_function_argument) will be
+                  called on the shared timeout service thread.
+        !*/
+
+        ~shared_timeout (
+        );
+        /*!
+            ensures
+                - any resources associated with *this have been released
+                - if (the callback hasn't started running yet) then
+                    - it never will
+                - else
+                    - blocks until the callback has finished
+        !*/
+    };
+
+// ----------------------------------------------------------------------------------------
+
+}
+
+#endif // DLIB_SHARED_TIMEOUt_ABSTRACT_
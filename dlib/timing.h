@@ -3,9 +3,14 @@
 #ifndef DLIB_TImING_Hh_
 #define DLIB_TImING_Hh_
 
-#include <chrono> 
-#include <atomic> 
+#include <chrono>
+#include <atomic>
+#include <cmath>
 #include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "string.h"
 
 #include <iostream>
@@ -63,9 +68,16 @@
     }
 
     This program would output:
-        Timing report: 
+        Timing report:
             block main loop: 15.0 seconds
 
+
+
+    If you need more than aggregate totals there is also a sample based API
+    further down in this file.  A scoped_timer records each measured duration as
+    an individual sample in a per-thread table, and get_stats() merges the
+    tables into per-slot counts, means, min/max, and latency percentiles that
+    you can feed into whatever monitoring system you use.
 !*/
 
 // ----------------------------------------------------------------------------------------
@@ -188,6 +200,297 @@ namespace dlib
             ~block() { stop(idx); }
             const int idx;
         };
+
+// ----------------------------------------------------------------------------------------
+
+        /*
+            Everything below this point is a richer instrumentation API that sits
+            alongside the start()/stop() tools above.  Instead of one global
+            accumulator per slot it records individual latency samples into
+            per-thread tables, so threads never contend with each other on the hot
+            path.  The per-thread tables are merged whenever you ask for the
+            results, which gives you counts, totals, min/max, and latency
+            percentiles from a log scaled histogram.  Use it like this:
+
+                void process_request()
+                {
+                    dlib::timing::scoped_timer t(1, "process_request");
+                    // do the work
+                }
+
+                // then, in your metrics exporter:
+                for (auto& s : dlib::timing::get_stats())
+                    export_to_monitoring(s.name, s.count, s.mean(), s.percentile(99));
+        */
+
+        const int HISTOGRAM_BUCKETS = 64;
+
+        struct stat
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This object holds the merged timing statistics for one slot, as
+                    returned by get_stats().  All times are in nanoseconds.  The
+                    histogram is log scaled: histogram[i] counts the samples whose
+                    duration d satisfies floor(log2(d)) == i.
+            !*/
+
+            stat() : slot(0), count(0), total_time(0), min_time(0), max_time(0)
+            {
+                for (int i = 0; i < HISTOGRAM_BUCKETS; ++i)
+                    histogram[i] = 0;
+            }
+
+            std::string name;
+            int slot;
+            uint64_t count;
+            uint64_t total_time;
+            uint64_t min_time;
+            uint64_t max_time;
+            uint64_t histogram[HISTOGRAM_BUCKETS];
+
+            double mean() const
+            /*!
+                ensures
+                    - returns the mean sample duration in nanoseconds
+            !*/
+            {
+                if (count == 0)
+                    return 0;
+                return static_cast<double>(total_time)/count;
+            }
+
+            double percentile(double p) const
+            /*!
+                requires
+                    - 0 <= p <= 100
+                ensures
+                    - returns an estimate of the p-th percentile sample duration in
+                      nanoseconds, computed from the log scaled histogram by linear
+                      interpolation within the containing bucket.
+            !*/
+            {
+                if (count == 0)
+                    return 0;
+
+                const double target = p/100.0*count;
+                double seen = 0;
+                for (int i = 0; i < HISTOGRAM_BUCKETS; ++i)
+                {
+                    if (histogram[i] == 0)
+                        continue;
+                    if (seen + histogram[i] >= target)
+                    {
+                        // interpolate between the bucket's bounds, [2^i, 2^(i+1))
+                        const double low = (i==0) ? 0 : std::pow(2.0, i);
+                        const double high = std::pow(2.0, i+1);
+                        const double frac = (target - seen)/histogram[i];
+                        const double result = low + frac*(high-low);
+                        // the histogram buckets are coarse, so don't let rounding
+                        // push the estimate outside the observed range
+                        return std::max<double>(min_time, std::min<double>(max_time, result));
+                    }
+                    seen += histogram[i];
+                }
+                return max_time;
+            }
+        };
+
+        namespace impl
+        {
+            struct thread_stats
+            {
+                /*!
+                    WHAT THIS OBJECT REPRESENTS
+                        The sample table for one thread.  The owning thread adds
+                        samples under the mutex, which is uncontended unless
+                        get_stats() happens to be merging at the same time.
+                !*/
+
+                struct slot_data
+                {
+                    slot_data() : count(0), total(0), min(0), max(0)
+                    {
+                        for (int i = 0; i < HISTOGRAM_BUCKETS; ++i)
+                            hist[i] = 0;
+                    }
+
+                    uint64_t count;
+                    uint64_t total;
+                    uint64_t min;
+                    uint64_t max;
+                    uint64_t hist[HISTOGRAM_BUCKETS];
+                };
+
+                std::mutex m;
+                std::map<int,slot_data> slots;
+            };
+
+            struct stats_registry
+            {
+                /*!
+                    WHAT THIS OBJECT REPRESENTS
+                        The global list of every thread's sample table.  Tables are
+                        kept alive by shared_ptr even after their thread exits so
+                        the samples still show up in get_stats().
+                !*/
+
+                std::mutex m;
+                std::vector<std::shared_ptr<thread_stats> > threads;
+
+                static stats_registry& get()
+                {
+                    static stats_registry r;
+                    return r;
+                }
+            };
+
+            inline thread_stats& get_thread_stats()
+            {
+                struct holder
+                {
+                    holder() : ts(std::make_shared<thread_stats>())
+                    {
+                        stats_registry& r = stats_registry::get();
+                        std::lock_guard<std::mutex> lock(r.m);
+                        r.threads.push_back(ts);
+                    }
+                    std::shared_ptr<thread_stats> ts;
+                };
+                thread_local holder h;
+                return *h.ts;
+            }
+
+            inline int histogram_bucket(uint64_t ns)
+            {
+                int i = 0;
+                while (ns >>= 1)
+                    ++i;
+                return i;
+            }
+        }
+
+        inline void record(int i, uint64_t elapsed_ns)
+        /*!
+            requires
+                - 0 <= i < TIME_SLOTS
+            ensures
+                - adds a sample of elapsed_ns nanoseconds to slot i's statistics for
+                  the calling thread.  This is the low level routine underneath
+                  scoped_timer, useful when you measure a duration yourself.
+        !*/
+        {
+            impl::thread_stats& ts = impl::get_thread_stats();
+            std::lock_guard<std::mutex> lock(ts.m);
+            impl::thread_stats::slot_data& s = ts.slots[i];
+            if (s.count == 0 || elapsed_ns < s.min)
+                s.min = elapsed_ns;
+            if (elapsed_ns > s.max)
+                s.max = elapsed_ns;
+            ++s.count;
+            s.total += elapsed_ns;
+            ++s.hist[impl::histogram_bucket(elapsed_ns)];
+        }
+
+        inline void record(int i, const char* name, uint64_t elapsed_ns)
+        /*!
+            requires
+                - 0 <= i < TIME_SLOTS
+            ensures
+                - same as record(i,elapsed_ns) but also names slot i
+        !*/
+        {
+            name_buf(i,name);
+            record(i, elapsed_ns);
+        }
+
+        struct scoped_timer
+        {
+            /*!
+                WHAT THIS OBJECT REPRESENTS
+                    This is an RAII tool that measures how long it exists and calls
+                    record() with that duration when it is destructed.  Unlike the
+                    block object above, each use contributes an individual sample to
+                    the histogram rather than just adding to a global total.
+            !*/
+
+            scoped_timer(int i) : idx(i), t(ts()) {}
+            scoped_timer(int i, const char* str) : idx(i), t(ts()) { name_buf(i,str); }
+            ~scoped_timer() { record(idx, ts()-t); }
+
+            const int idx;
+            const uint64_t t;
+        };
+
+        inline std::vector<stat> get_stats()
+        /*!
+            ensures
+                - merges the sample tables of every thread that has called record()
+                  (or used a scoped_timer) and returns one stat per active slot,
+                  ordered by slot number.  This is the programmatic export hook: it
+                  can be called at any time, from any thread, while other threads
+                  keep recording.
+        !*/
+        {
+            std::map<int,stat> merged;
+            impl::stats_registry& r = impl::stats_registry::get();
+            std::lock_guard<std::mutex> lock(r.m);
+            for (unsigned long t = 0; t < r.threads.size(); ++t)
+            {
+                impl::thread_stats& ts = *r.threads[t];
+                std::lock_guard<std::mutex> lock2(ts.m);
+                for (std::map<int,impl::thread_stats::slot_data>::const_iterator i = ts.slots.begin();
+                     i != ts.slots.end(); ++i)
+                {
+                    stat& s = merged[i->first];
+                    const impl::thread_stats::slot_data& d = i->second;
+                    if (s.count == 0 || d.min < s.min_time)
+                        s.min_time = d.min;
+                    if (d.max > s.max_time)
+                        s.max_time = d.max;
+                    s.count += d.count;
+                    s.total_time += d.total;
+                    for (int b = 0; b < HISTOGRAM_BUCKETS; ++b)
+                        s.histogram[b] += d.hist[b];
+                }
+            }
+
+            std::vector<stat> result;
+            for (std::map<int,stat>::iterator i = merged.begin(); i != merged.end(); ++i)
+            {
+                i->second.slot = i->first;
+                i->second.name = name_buf(i->first,"");
+                result.push_back(i->second);
+            }
+            return result;
+        }
+
+        inline void print_stats()
+        /*!
+            ensures
+                - prints a human readable summary of get_stats() to std::cout,
+                  including mean, min, max, and latency percentiles for each slot.
+        !*/
+        {
+            using namespace std;
+            const std::vector<stat> stats = get_stats();
+            cout << "Instrumentation report: " << endl;
+            for (unsigned long i = 0; i < stats.size(); ++i)
+            {
+                const stat& s = stats[i];
+                string name = cast_to_string(s.slot);
+                if (s.name.size() != 0)
+                    name += ": " + s.name;
+                cout << "  " << name
+                     << ": count " << s.count
+                     << ", mean " << s.mean()/1e6 << " ms"
+                     << ", min " << s.min_time/1e6 << " ms"
+                     << ", p50 " << s.percentile(50)/1e6 << " ms"
+                     << ", p90 " << s.percentile(90)/1e6 << " ms"
+                     << ", p99 " << s.percentile(99)/1e6 << " ms"
+                     << ", max " << s.max_time/1e6 << " ms" << endl;
+            }
+        }
     }
 }
 
@@ -132,6 +132,57 @@ namespace dlib
             };
 
             
+            // -----------------------------------
+
+            class buffered_input
+            {
+                /*!
+                    WHAT THIS OBJECT REPRESENTS
+                        This is a simple replacement for reading an istream one character
+                        at a time with get() and peek().  Those calls each construct a
+                        sentry object and go through the stream's virtual interface, which
+                        completely dominates the runtime of the tokenizer on big
+                        documents.  This object reads the stream in large blocks and then
+                        hands out characters from its buffer, giving the same get()/peek()
+                        interface (including returning EOF at end of input).
+                !*/
+            public:
+                explicit buffered_input (
+                    std::istream& in_
+                ) : in(in_), pos(0), len(0) {}
+
+                int peek (
+                )
+                {
+                    if (pos == len && !fill())
+                        return EOF;
+                    return static_cast<unsigned char>(buf[pos]);
+                }
+
+                int get (
+                )
+                {
+                    if (pos == len && !fill())
+                        return EOF;
+                    return static_cast<unsigned char>(buf[pos++]);
+                }
+
+            private:
+                bool fill (
+                )
+                {
+                    in.read(buf, sizeof(buf));
+                    len = static_cast<size_t>(in.gcount());
+                    pos = 0;
+                    return len != 0;
+                }
+
+                std::istream& in;
+                char buf[16*1024];
+                size_t pos;
+                size_t len;
+            };
+
             // -----------------------------------
 
             enum token_type
@@ -166,7 +217,7 @@ namespace dlib
 
             // private member functions
             inline void get_next_token(
-                std::istream& in,
+                buffered_input& in,
                 std::string& token_text,
                 int& token_kind,
                 unsigned long& line_number
@@ -227,7 +278,7 @@ namespace dlib
             !*/
 
             inline int change_entity (
-                std::istream& in
+                buffered_input& in
             );
             /*!
                 ensures
@@ -284,25 +335,29 @@ namespace dlib
         
     void xml_parser::
     parse (
-        std::istream& in
+        std::istream& stream
     )
     {
-        DLIB_CASSERT ( in.fail() == false ,
+        DLIB_CASSERT ( stream.fail() == false ,
             "\tvoid xml_parser::parse"
             << "\n\tthe input stream must not be in the fail state"
             << "\n\tthis: " << this
             );
 
 
-        // save which exceptions in will throw and make it so it won't throw any
+        // save which exceptions stream will throw and make it so it won't throw any
         // for the life of this function
-        std::ios::iostate old_exceptions = in.exceptions();
+        std::ios::iostate old_exceptions = stream.exceptions();
         // set it to not throw anything
-        in.exceptions(std::ios::goodbit);
+        stream.exceptions(std::ios::goodbit);
 
 
-        try 
+        try
         {
+            // All the reading below goes through this buffer rather than pulling
+            // characters from the stream one at a time.
+            buffered_input in(stream);
+
             unsigned long line_number = 1;
 
             // skip any whitespace before the start of the document
@@ -572,15 +627,15 @@ namespace dlib
                 dh_list[i]->end_document();
             }
 
-            // restore the old exception settings to in
-            in.exceptions(old_exceptions);
+            // restore the old exception settings to stream
+            stream.exceptions(old_exceptions);
 
             // don't forget to rethrow the exception
             throw;
         }
 
-        // restore the old exception settings to in
-        in.exceptions(old_exceptions);
+        // restore the old exception settings to stream
+        stream.exceptions(old_exceptions);
 
     }
 
@@ -625,7 +680,7 @@ namespace dlib
         
     void xml_parser::
     get_next_token(
-        std::istream& in,
+        buffered_input& in,
         std::string& token_text,
         int& token_kind,
         unsigned long& line_number
@@ -1267,7 +1322,7 @@ namespace dlib
         
     int xml_parser::
     change_entity (
-        std::istream& in
+        buffered_input& in
     )
     {
         
@@ -10,6 +10,7 @@
 #include <dlib/dir_nav.h>
 #include <dlib/clustering.h>
 #include <dlib/svm.h>
+#include <map>
 
 // ----------------------------------------------------------------------------------------
 
@@ -144,10 +145,15 @@ int cluster_dataset(
 
     const double aspect_ratio = mean_aspect_ratio(data);
 
-    dlib::array<array2d<rgb_pixel> > images;
     std::vector<matrix<double,0,1> > feats;
+    // chip_sources[k] tells us what image and what chip within that image produced
+    // feats[k].  We use it to re-extract chips later when writing the cluster tilings
+    // rather than holding every chip in the dataset in RAM at once.
+    std::vector<std::pair<unsigned long,chip_details> > chip_sources;
     console_progress_indicator pbar(data.images.size());
-    // extract all the object chips and HOG features.
+    // extract all the object HOG features.  Note that we stream the images, loading
+    // one at a time and keeping only the HOG features, so the memory usage is bounded
+    // by the number of object boxes rather than the number of pixels in the dataset.
     cout << "Loading image data..." << endl;
     for (unsigned long i = 0; i < data.images.size(); ++i)
     {
@@ -164,9 +170,10 @@ int cluster_dataset(
                 continue;
             drectangle rect = data.images[i].boxes[j].rect;
             rect = set_aspect_ratio(rect, aspect_ratio);
-            extract_image_chip(img, chip_details(rect, chip_size), chip);
+            const chip_details details(rect, chip_size);
+            extract_image_chip(img, details, chip);
             feats.push_back(extract_fhog_features(chip));
-            images.push_back(chip);
+            chip_sources.push_back(std::make_pair(i, details));
         }
     }
 
@@ -240,11 +247,37 @@ int cluster_dataset(
     std::sort(assignments.begin(), assignments.end());
     for (unsigned long c = 0; c < num_clusters; ++c)
     {
-        dlib::array<array2d<rgb_pixel> > temp;
+        // Figure out which chips go into this cluster's tiling and where in the
+        // tiling each one belongs (best chips first, since assignments is sorted by
+        // distance).  We group the extractions by source image so each image is
+        // decoded just once per cluster and we never hold more than one cluster's
+        // worth of chips in memory.
+        std::map<unsigned long, std::vector<std::pair<unsigned long,chip_details> > > chips_by_image;
+        unsigned long num_chips = 0;
         for (unsigned long i = 0; i < assignments.size(); ++i)
         {
             if (assignments[i].c == c)
-                temp.push_back(images[assignments[i].idx]);
+            {
+                const std::pair<unsigned long,chip_details>& src = chip_sources[assignments[i].idx];
+                chips_by_image[src.first].push_back(std::make_pair(num_chips++, src.second));
+            }
+        }
+
+        dlib::array<array2d<rgb_pixel> > temp;
+        temp.resize(num_chips);
+        for (auto& entry : chips_by_image)
+        {
+            array2d<rgb_pixel> img;
+            load_image(img, data.images[entry.first].filename);
+
+            std::vector<chip_details> dets;
+            for (auto& chip : entry.second)
+                dets.push_back(chip.second);
+
+            dlib::array<array2d<rgb_pixel> > chips;
+            extract_image_chips(img, dets, chips);
+            for (unsigned long j = 0; j < chips.size(); ++j)
+                temp[entry.second[j].first].swap(chips[j]);
         }
 
         string outfile = "cluster_"+pad_int_with_zeros(c+1, 3) + ".jpg";
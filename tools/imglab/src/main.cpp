@@ -7,6 +7,7 @@
 #include "convert_idl.h"
 #include "cluster.h"
 #include "flip_dataset.h"
+#include "server.h"
 #include <dlib/cmd_line_parser.h>
 #include <dlib/image_transforms.h>
 #include <dlib/svm.h>
@@ -605,6 +606,12 @@ int main(int argc, char** argv)
         parser.add_option("crop-size", "When doing --resample, the entire cropped image will be <arg> times wider than the object (default 2.5).",1); 
         parser.add_option("one-object-per-image", "When doing --resample, only include one non-ignored object per image (i.e. the central object).");
 
+        parser.set_group_name("Running as a server");
+        parser.add_option("server", "Run imglab as a persistent annotation server listening on port <arg>.  Detectors "
+                                    "and datasets loaded by clients stay resident between commands, so batch scripts "
+                                    "can annotate many datasets without reloading models each time.  Connect with any "
+                                    "line based client (e.g. telnet) and send 'help' for the list of commands.",1);
+
 
 
         parser.parse(argc, argv);
@@ -612,7 +619,7 @@ int main(int argc, char** argv)
         const char* singles[] = {"h","c","r","l","files","convert","parts","rmdiff", "rmtrunc", "rmdupes", "seed", "shuffle", "split", "add", 
                                  "flip-basic", "flip", "rotate", "tile", "size", "cluster", "resample", "min-object-size", "rmempty",
                                  "crop-size", "cropped-object-size", "rmlabel", "rm-other-labels", "rm-if-overlaps", "sort-num-objects", 
-                                 "one-object-per-image", "jpg", "rmignore", "sort", "split-train-test", "box-images"};
+                                 "one-object-per-image", "jpg", "rmignore", "sort", "split-train-test", "box-images", "server"};
         parser.check_one_time_options(singles);
         const char* c_sub_ops[] = {"r", "convert"};
         parser.check_sub_options("c", c_sub_ops);
@@ -711,6 +718,7 @@ int main(int argc, char** argv)
         parser.check_option_arg_range("cropped-object-size", 4, 10000*10000);
         parser.check_option_arg_range("crop-size", 1.0, 100.0);
         parser.check_option_arg_range("split-train-test", 0.0, 1.0);
+        parser.check_option_arg_range("server", 1, 65535);
 
         if (parser.option("h"))
         {
@@ -720,6 +728,11 @@ int main(int argc, char** argv)
             return EXIT_SUCCESS;
         }
 
+        if (parser.option("server"))
+        {
+            return run_server(parser);
+        }
+
         if (parser.option("add"))
         {
             merge_metadata_files(parser);
@@ -0,0 +1,298 @@
+// Copyright (C) 2016  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+
+#include "server.h"
+
+#include <dlib/server.h>
+#include <dlib/data_io.h>
+#include <dlib/image_io.h>
+#include <dlib/image_processing.h>
+#include <dlib/dir_nav.h>
+
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+// ----------------------------------------------------------------------------------------
+
+using namespace std;
+using namespace dlib;
+
+typedef object_detector<scan_fhog_pyramid<pyramid_down<6> > > fhog_detector;
+
+// ----------------------------------------------------------------------------------------
+
+static bool is_absolute_path (
+    const std::string& filename
+)
+{
+    if (filename.size() == 0)
+        return false;
+    if (filename[0] == '/' || filename[0] == '\\')
+        return true;
+    if (filename.size() >= 2 && filename[1] == ':')
+        return true;
+    return false;
+}
+
+// ----------------------------------------------------------------------------------------
+
+class annotation_server : public server_iostream
+{
+    /*!
+        CONVENTION
+            - detectors[name] == a loaded fhog_detector
+            - datasets[name].first == a loaded dataset
+            - datasets[name].second == the directory of the XML file the dataset was
+              loaded from.  Image filenames in the dataset are interpreted relative
+              to it, since a long-running server can't just chdir to the dataset's
+              directory the way the one-shot imglab commands do.
+            - state_mutex protects all the members of this object.  Commands from concurrent
+              connections are serialized.
+            - shutdown_requested == true if a client has sent the shutdown command.
+              wait_for_shutdown() blocks until that happens.
+    !*/
+
+public:
+
+    annotation_server() : shutdown_signaler(state_mutex), shutdown_requested(false) {}
+
+    void wait_for_shutdown (
+    )
+    {
+        auto_mutex lock(state_mutex);
+        while (!shutdown_requested)
+            shutdown_signaler.wait();
+    }
+
+private:
+
+    void on_connect (
+        std::istream& in,
+        std::ostream& out,
+        const std::string& ,
+        const std::string& ,
+        unsigned short ,
+        unsigned short ,
+        uint64
+    )
+    {
+        out << "imglab server ready" << endl;
+        string line;
+        while (getline(in, line))
+        {
+            // strip any trailing carriage return so telnet style clients work
+            if (line.size() != 0 && line[line.size()-1] == '\r')
+                line.erase(line.size()-1);
+
+            istringstream sin(line);
+            string cmd;
+            sin >> cmd;
+            if (cmd.size() == 0)
+                continue;
+
+            try
+            {
+                if (cmd == "bye")
+                {
+                    out << "ok" << endl;
+                    break;
+                }
+                else if (cmd == "shutdown")
+                {
+                    out << "ok" << endl;
+                    // We can't call clear() here since it would wait for this very
+                    // connection thread to terminate.  So just wake up run_server()
+                    // and let it shut the server down.
+                    auto_mutex lock(state_mutex);
+                    shutdown_requested = true;
+                    shutdown_signaler.broadcast();
+                    break;
+                }
+                else if (cmd == "help")
+                {
+                    print_help(out);
+                    out << "ok" << endl;
+                }
+                else if (cmd == "load_detector")
+                {
+                    string name, filename;
+                    sin >> name >> filename;
+                    require_args(name.size() != 0 && filename.size() != 0, "usage: load_detector <name> <file>");
+                    fhog_detector det;
+                    deserialize(filename) >> det;
+                    auto_mutex lock(state_mutex);
+                    detectors[name] = det;
+                    out << "ok" << endl;
+                }
+                else if (cmd == "unload_detector")
+                {
+                    string name;
+                    sin >> name;
+                    auto_mutex lock(state_mutex);
+                    require_args(detectors.erase(name) == 1, "no detector named " + name);
+                    out << "ok" << endl;
+                }
+                else if (cmd == "list_detectors")
+                {
+                    auto_mutex lock(state_mutex);
+                    for (auto&& d : detectors)
+                        out << d.first << endl;
+                    out << "ok" << endl;
+                }
+                else if (cmd == "load_dataset")
+                {
+                    string name, filename;
+                    sin >> name >> filename;
+                    require_args(name.size() != 0 && filename.size() != 0, "usage: load_dataset <name> <file.xml>");
+                    image_dataset_metadata::dataset data;
+                    image_dataset_metadata::load_image_dataset_metadata(data, filename);
+                    auto_mutex lock(state_mutex);
+                    datasets[name] = make_pair(data, get_parent_directory(file(filename)).full_name());
+                    out << "ok" << endl;
+                }
+                else if (cmd == "save_dataset")
+                {
+                    string name, filename;
+                    sin >> name >> filename;
+                    require_args(name.size() != 0 && filename.size() != 0, "usage: save_dataset <name> <file.xml>");
+                    auto_mutex lock(state_mutex);
+                    require_args(datasets.count(name) == 1, "no dataset named " + name);
+                    image_dataset_metadata::save_image_dataset_metadata(datasets[name].first, filename);
+                    out << "ok" << endl;
+                }
+                else if (cmd == "unload_dataset")
+                {
+                    string name;
+                    sin >> name;
+                    auto_mutex lock(state_mutex);
+                    require_args(datasets.erase(name) == 1, "no dataset named " + name);
+                    out << "ok" << endl;
+                }
+                else if (cmd == "list_datasets")
+                {
+                    auto_mutex lock(state_mutex);
+                    for (auto&& d : datasets)
+                        out << d.first << " (" << d.second.first.images.size() << " images)" << endl;
+                    out << "ok" << endl;
+                }
+                else if (cmd == "annotate")
+                {
+                    string dataset_name, detector_name, label;
+                    sin >> dataset_name >> detector_name >> label;
+                    require_args(dataset_name.size() != 0 && detector_name.size() != 0,
+                        "usage: annotate <dataset> <detector> [label]");
+                    if (label.size() == 0)
+                        label = detector_name;
+                    auto_mutex lock(state_mutex);
+                    require_args(datasets.count(dataset_name) == 1, "no dataset named " + dataset_name);
+                    require_args(detectors.count(detector_name) == 1, "no detector named " + detector_name);
+                    const unsigned long num_dets = annotate_dataset(datasets[dataset_name].first,
+                        datasets[dataset_name].second, detectors[detector_name], label);
+                    out << "added " << num_dets << " boxes" << endl;
+                    out << "ok" << endl;
+                }
+                else
+                {
+                    out << "error: unknown command '" << cmd << "', try help" << endl;
+                }
+            }
+            catch (std::exception& e)
+            {
+                // turn the what() message into a single line so clients can keep
+                // parsing responses line by line.
+                string msg = e.what();
+                for (auto& ch : msg)
+                {
+                    if (ch == '\n' || ch == '\r')
+                        ch = ' ';
+                }
+                out << "error: " << msg << endl;
+            }
+        }
+    }
+
+    static void require_args (
+        bool ok,
+        const std::string& msg
+    )
+    {
+        if (!ok)
+            throw error(msg);
+    }
+
+    static void print_help (
+        std::ostream& out
+    )
+    {
+        out << "commands:\n";
+        out << "  load_detector <name> <file>        load a fhog object detector and keep it resident\n";
+        out << "  unload_detector <name>             drop a loaded detector\n";
+        out << "  list_detectors                     list the loaded detectors\n";
+        out << "  load_dataset <name> <file.xml>     load an imglab XML dataset and keep it resident\n";
+        out << "  save_dataset <name> <file.xml>     write a loaded dataset back out as XML\n";
+        out << "  unload_dataset <name>              drop a loaded dataset\n";
+        out << "  list_datasets                      list the loaded datasets\n";
+        out << "  annotate <dataset> <detector> [label]\n";
+        out << "                                     run the detector over every image in the dataset and\n";
+        out << "                                     add the detections as boxes labeled <label> (the\n";
+        out << "                                     detector's name if no label is given)\n";
+        out << "  bye                                close this connection\n";
+        out << "  shutdown                           stop the server\n";
+    }
+
+    static unsigned long annotate_dataset (
+        image_dataset_metadata::dataset& data,
+        const std::string& dataset_dir,
+        fhog_detector& det,
+        const std::string& label
+    )
+    {
+        unsigned long num_dets = 0;
+        for (auto&& image : data.images)
+        {
+            string filename = image.filename;
+            if (!is_absolute_path(filename))
+                filename = dataset_dir + directory::get_separator() + filename;
+
+            array2d<rgb_pixel> img;
+            load_image(img, filename);
+            for (auto&& rect : det(img))
+            {
+                image_dataset_metadata::box b;
+                b.rect = rect;
+                b.label = label;
+                image.boxes.push_back(b);
+                ++num_dets;
+            }
+        }
+        return num_dets;
+    }
+
+    std::map<std::string, fhog_detector> detectors;
+    std::map<std::string, std::pair<image_dataset_metadata::dataset, std::string> > datasets;
+    dlib::mutex state_mutex;
+    signaler shutdown_signaler;
+    bool shutdown_requested;
+};
+
+// ----------------------------------------------------------------------------------------
+
+int run_server (
+    const dlib::command_line_parser& parser
+)
+{
+    const int port = get_option(parser, "server", 8000);
+
+    annotation_server our_server;
+    our_server.set_listening_port(port);
+    our_server.start_async();
+    cout << "imglab server listening on port " << port << endl;
+    // Block until a client sends the shutdown command.  The server's destructor
+    // takes care of closing down any remaining connections.
+    our_server.wait_for_shutdown();
+    return EXIT_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------------------
@@ -0,0 +1,18 @@
+// Copyright (C) 2016  Davis E. King (davis@dlib.net)
+// License: Boost Software License   See LICENSE.txt for the full license.
+#ifndef DLIB_IMGLAB_SeRVER_H_
+#define DLIB_IMGLAB_SeRVER_H_
+
+#include <dlib/cmd_line_parser.h>
+
+int run_server(const dlib::command_line_parser& parser);
+/*!
+    ensures
+        - Runs imglab as a long-lived annotation server on the port given by the
+          --server option.  Loaded detectors and datasets stay resident between
+          commands, so batch scripts can annotate many shards without paying the
+          model loading and XML parsing cost on every invocation.  Returns when a
+          client sends the shutdown command.
+!*/
+
+#endif // DLIB_IMGLAB_SeRVER_H_